@@ -21,7 +21,10 @@
 
 #include "audio/chip.h"
 #include "audio/mixer.h"
+#include "audio/render_ahead.h"
 
+#include "common/config-manager.h"
+#include "common/system.h"
 #include "common/timer.h"
 
 namespace Audio {
@@ -142,11 +145,24 @@ int EmulatedChip::getRate() const {
 
 void EmulatedChip::startCallbacks(int timerFrequency) {
 	setCallbackFrequency(timerFrequency);
-	g_system->getMixer()->playStream(Audio::Mixer::kPlainSoundType, _handle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
+
+	Audio::AudioStream *renderAhead = nullptr;
+	if (allowRenderAhead() && ConfMan.hasKey("synth_render_ahead"))
+		renderAhead = makeRenderAheadStream(this, ConfMan.getInt("synth_render_ahead"), DisposeAfterUse::NO, &_renderAheadGroup);
+
+	// The mixer deletes the render ahead stream in stopCallbacks(), which
+	// then waits for its jobs before the chip can go away
+	if (renderAhead)
+		g_system->getMixer()->playStream(Audio::Mixer::kPlainSoundType, _handle, renderAhead, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::YES, true);
+	else
+		g_system->getMixer()->playStream(Audio::Mixer::kPlainSoundType, _handle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
 }
 
 void EmulatedChip::stopCallbacks() {
 	g_system->getMixer()->stopHandle(*_handle);
+	// Outside of the mixer mutex, which the callbacks of a render ahead job
+	// may be waiting for
+	g_system->getJobSystem()->wait(_renderAheadGroup);
 }
 
 void EmulatedChip::setCallbackFrequency(int timerFrequency) {
@@ -23,6 +23,7 @@
 #define AUDIO_CHIP_H
 
 #include "common/func.h"
+#include "common/jobs.h"
 #include "common/ptr.h"
 
 #include "audio/audiostream.h"
@@ -142,6 +143,13 @@ protected:
 	 */
 	virtual void generateSamples(int16 *buffer, int numSamples) = 0;
 
+	/**
+	 * Return true if the emulation is expensive enough to be rendered ahead
+	 * on a worker thread, see RenderAheadStream. It then is when the
+	 * synth_render_ahead config key is set to a non-zero duration.
+	 */
+	virtual bool allowRenderAhead() const { return false; }
+
 private:
 	int _baseFreq;
 
@@ -149,6 +157,7 @@ private:
 	int _samplesPerTick;
 
 	Audio::SoundHandle *_handle;
+	Common::JobGroup _renderAheadGroup;
 };
 
 } // End of namespace Audio
@@ -0,0 +1,141 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "audio/decoded_sample_cache.h"
+#include "audio/audiostream.h"
+#include "audio/decoders/raw.h"
+
+#include "common/array.h"
+#include "common/memstream.h"
+
+namespace Audio {
+
+DecodedSampleCache::DecodedSampleCache(uint32 maxSize) :
+	_size(0), _maxSize(maxSize), _accessCounter(0) {
+}
+
+DecodedSampleCache::~DecodedSampleCache() {
+	clear();
+}
+
+SeekableAudioStream *DecodedSampleCache::createStream(const Key &key) {
+	Common::StackLock lock(_mutex);
+
+	EntryMap::iterator it = _entries.find(key);
+	if (it == _entries.end())
+		return nullptr;
+
+	it->_value.lastAccess = _accessCounter++;
+	return makeStream(it->_value);
+}
+
+SeekableAudioStream *DecodedSampleCache::decodeAndStore(const Key &key, AudioStream *stream) {
+	if (!stream)
+		return nullptr;
+
+	Entry entry;
+	entry.rate = stream->getRate();
+	entry.stereo = stream->isStereo();
+
+	// Decode outside of the lock, so other sounds can be looked up meanwhile
+	Common::Array<int16> samples;
+	int16 buffer[2048];
+	int read;
+	while ((read = stream->readBuffer(buffer, ARRAYSIZE(buffer))) > 0) {
+		const uint pos = samples.size();
+		samples.resize(pos + read);
+		memcpy(&samples[pos], buffer, read * sizeof(int16));
+		if (stream->endOfData())
+			break;
+	}
+	delete stream;
+
+	if (read < 0 || samples.empty())
+		return nullptr;
+
+	entry.size = samples.size() * sizeof(int16);
+	byte *data = new byte[entry.size];
+	memcpy(data, samples.begin(), entry.size);
+	entry.data = Common::SharedPtr<byte>(data, Common::ArrayDeleter<byte>(), Common::kRefCountThreadSafe);
+
+	Common::StackLock lock(_mutex);
+
+	EntryMap::iterator it = _entries.find(key);
+	if (it != _entries.end())
+		remove(it);
+
+	if (entry.size <= _maxSize) {
+		while (_size + entry.size > _maxSize && dropOldest()) {
+		}
+
+		entry.lastAccess = _accessCounter++;
+		_entries[key] = entry;
+		_size += entry.size;
+	}
+
+	return makeStream(entry);
+}
+
+void DecodedSampleCache::clear() {
+	Common::StackLock lock(_mutex);
+
+	_entries.clear();
+	_size = 0;
+}
+
+uint32 DecodedSampleCache::getSize() const {
+	Common::StackLock lock(_mutex);
+
+	return _size;
+}
+
+SeekableAudioStream *DecodedSampleCache::makeStream(const Entry &entry) {
+	byte flags = FLAG_16BITS;
+#ifdef SCUMM_LITTLE_ENDIAN
+	flags |= FLAG_LITTLE_ENDIAN;
+#endif
+	if (entry.stereo)
+		flags |= FLAG_STEREO;
+
+	return makeRawStream(new Common::MemoryReadStream(entry.data, entry.size), entry.rate, flags, DisposeAfterUse::YES);
+}
+
+void DecodedSampleCache::remove(EntryMap::iterator it) {
+	_size -= it->_value.size;
+	_entries.erase(it);
+}
+
+bool DecodedSampleCache::dropOldest() {
+	EntryMap::iterator oldest = _entries.end();
+	for (EntryMap::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		if (oldest == _entries.end() || it->_value.lastAccess < oldest->_value.lastAccess)
+			oldest = it;
+	}
+
+	if (oldest == _entries.end())
+		return false;
+
+	remove(oldest);
+	return true;
+}
+
+} // End of namespace Audio
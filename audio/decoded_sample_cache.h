@@ -0,0 +1,130 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef AUDIO_DECODED_SAMPLE_CACHE_H
+#define AUDIO_DECODED_SAMPLE_CACHE_H
+
+#include "common/hashmap.h"
+#include "common/mutex.h"
+#include "common/ptr.h"
+#include "common/str.h"
+
+namespace Audio {
+
+class AudioStream;
+class SeekableAudioStream;
+
+/**
+ * Memory-budgeted cache of completely decoded sounds.
+ *
+ * Engines playing the same short effect over and over, e.g. gunfire or
+ * footsteps, would otherwise decode it from the resource data every time.
+ * The cache keeps the decoded 16-bit samples and hands out raw streams
+ * playing them, which only wrap the shared buffer.
+ *
+ * Sounds are identified by their source, e.g. the name of the archive or
+ * resource file, their offset in it and an engine defined format value, to
+ * distinguish different decodings of the same data.
+ *
+ * When the budget is exceeded, the least recently used sounds are dropped.
+ * Streams created from a dropped sound keep playing, as they share its
+ * buffer. The cache may be used from several threads.
+ */
+class DecodedSampleCache {
+public:
+	struct Key {
+		Common::String source;
+		uint32 offset;
+		uint32 format;
+
+		Key() : offset(0), format(0) {}
+		Key(const Common::String &s, uint32 o, uint32 f = 0) : source(s), offset(o), format(f) {}
+
+		bool operator==(const Key &other) const {
+			return offset == other.offset && format == other.format && source == other.source;
+		}
+	};
+
+	/**
+	 * @param maxSize Maximum number of bytes of decoded samples to keep.
+	 */
+	explicit DecodedSampleCache(uint32 maxSize);
+	~DecodedSampleCache();
+
+	/**
+	 * Create a stream playing the sound cached under the given key.
+	 *
+	 * @return The new stream, or nullptr if the sound is not cached.
+	 */
+	SeekableAudioStream *createStream(const Key &key);
+
+	/**
+	 * Decode the given stream completely, cache the result and return a
+	 * stream playing it. The stream must end, so looping streams can't be
+	 * cached.
+	 *
+	 * Sounds larger than the budget are not cached, but still returned.
+	 *
+	 * @param key    Key to cache the sound under. Replaces a cached sound
+	 *               with the same key.
+	 * @param stream Stream to decode. It is deleted afterwards.
+	 * @return The new stream, or nullptr if decoding failed.
+	 */
+	SeekableAudioStream *decodeAndStore(const Key &key, AudioStream *stream);
+
+	/** Drop all cached sounds. */
+	void clear();
+
+	/** Return the number of bytes used by the cached sounds. */
+	uint32 getSize() const;
+
+private:
+	struct Entry {
+		Common::SharedPtr<byte> data;
+		uint32 size;
+		int rate;
+		bool stereo;
+		uint32 lastAccess;
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const {
+			return key.source.hash() ^ (key.offset * 2654435761u) ^ (key.format << 16);
+		}
+	};
+
+	typedef Common::HashMap<Key, Entry, KeyHash> EntryMap;
+
+	static SeekableAudioStream *makeStream(const Entry &entry);
+	void remove(EntryMap::iterator it);
+	bool dropOldest();
+
+	mutable Common::Mutex _mutex;
+	EntryMap _entries;
+	uint32 _size;
+	uint32 _maxSize;
+	uint32 _accessCounter;
+};
+
+} // End of namespace Audio
+
+#endif
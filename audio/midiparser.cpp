@@ -49,11 +49,16 @@ _numTracks(0),
 _activeTrack(255),
 _abortParse(false),
 _jumpingToTick(false),
+_flattenTracks(false),
+_flatteningTrack(false),
+_flatTrackSeekable(false),
+_flatTrack(255),
 _doParse(true),
 _pause(false) {
 	memset(_activeNotes, 0, sizeof(_activeNotes));
 	memset(_tracks, 0, sizeof(_tracks));
 	memset(_numSubtracks, 1, sizeof(_numSubtracks));
+	memset(_flatEventIndex, 0, sizeof(_flatEventIndex));
 	for (int i = 0; i < MAXIMUM_SUBTRACKS; i++) {
 		_nextSubtrackEvents[i].clear();
 		_nextSubtrackEvents[i].subtrack = i;
@@ -81,6 +86,11 @@ void MidiParser::property(int prop, int value) {
 	case mpDisableAutoStartPlayback:
 		_disableAutoStartPlayback = (value != 0);
 		break;
+	case mpFlattenTracks:
+		_flattenTracks = (value != 0);
+		if (!_flattenTracks)
+			clearFlattenedTrack();
+		break;
 	default:
 		break;
 	}
@@ -473,6 +483,7 @@ bool MidiParser::setTrack(int track) {
 	onTrackStart(track);
 
 	_activeTrack = track;
+	flattenActiveTrack();
 	for (int i = 0; i < _numSubtracks[_activeTrack]; i++) {
 		_position._subtracks[i]._playPos = _tracks[_activeTrack][i];
 		parseNextEvent(_nextSubtrackEvents[i]);
@@ -497,6 +508,7 @@ bool MidiParser::startPlaying() {
 			_nextSubtrackEvents[i].clear();
 		}
 		_nextEvent = &_nextSubtrackEvents[0];
+		flattenActiveTrack();
 		for (int i = 0; i < _numSubtracks[_activeTrack]; i++) {
 			_position._subtracks[i]._playPos = _tracks[_activeTrack][i];
 			parseNextEvent(_nextSubtrackEvents[i]);
@@ -583,12 +595,23 @@ bool MidiParser::jumpToTick(uint32 tick, bool fireEvents, bool stopNotes, bool d
 	}
 
 	resetTracking();
-	for (int i = 0; i < _numSubtracks[_activeTrack]; i++) {
-		_position._subtracks[i]._playPos = _tracks[_activeTrack][i];
-		parseNextEvent(_nextSubtrackEvents[i]);
+	flattenActiveTrack();
+
+	// Skipping events without firing them only changes the tempo, so
+	// the flattened track can be used to find the target
+	const bool seekFlattened = tick > 0 && !fireEvents && _flatTrackSeekable;
+	bool found = true;
+	if (seekFlattened) {
+		found = seekFlattenedTrack(tick);
+	} else {
+		for (int i = 0; i < _numSubtracks[_activeTrack]; i++) {
+			_position._subtracks[i]._playPos = _tracks[_activeTrack][i];
+			parseNextEvent(_nextSubtrackEvents[i]);
+		}
+		determineNextEvent();
 	}
-	determineNextEvent();
-	if (tick > 0) {
+
+	if (tick > 0 && !seekFlattened) {
 		while (true) {
 			EventInfo &info = *_nextEvent;
 			uint8 subtrack = info.subtrack;
@@ -608,13 +631,8 @@ bool MidiParser::jumpToTick(uint32 tick, bool fireEvents, bool stopNotes, bool d
 				_position.stopTracking(info.subtrack);
 				if (!_position.isTracking()) {
 					// This means that we failed to find the right tick.
-					_position = currentPos;
-					_nextEvent = currentEvent;
-					for (int i = 0; i < _numSubtracks[_activeTrack]; i++) {
-						_nextSubtrackEvents[i]  = currentSubtrackEvents[i];
-					}
-					_jumpingToTick = false;
-					return false;
+					found = false;
+					break;
 				}
 			} else {
 				processEvent(info, fireEvents);
@@ -636,6 +654,16 @@ bool MidiParser::jumpToTick(uint32 tick, bool fireEvents, bool stopNotes, bool d
 		}
 	}
 
+	if (!found) {
+		_position = currentPos;
+		_nextEvent = currentEvent;
+		for (int i = 0; i < _numSubtracks[_activeTrack]; i++) {
+			_nextSubtrackEvents[i]  = currentSubtrackEvents[i];
+		}
+		_jumpingToTick = false;
+		return false;
+	}
+
 	if (stopNotes) {
 		if (!_smartJump || !currentPos.isTracking()) {
 			allNotesOff();
@@ -676,6 +704,7 @@ void MidiParser::unloadMusic() {
 	_numTracks = 0;
 	_activeTrack = 255;
 	_abortParse = true;
+	clearFlattenedTrack();
 	memset(_tracks, 0, sizeof(_tracks));
 	memset(_numSubtracks, 1, sizeof(_numSubtracks));
 	for (int i = 0; i < MAXIMUM_SUBTRACKS; i++) {
@@ -697,3 +726,173 @@ void MidiParser::unloadMusic() {
 		}
 	}
 }
+
+void MidiParser::flattenActiveTrack() {
+	if (!_flattenTracks || _activeTrack >= _numTracks || _flatTrack == _activeTrack)
+		return;
+
+	clearFlattenedTrack();
+
+	// Parse each subtrack from the start. The parser must not have any
+	// side effects while doing this, see _flatteningTrack.
+	Tracker currentPos(_position);
+	_flatteningTrack = true;
+	_flatTrackSeekable = true;
+	for (int i = 0; i < _numSubtracks[_activeTrack]; i++) {
+		Tracker::SubtrackStatus &status = _position._subtracks[i];
+		status._playPos = _tracks[_activeTrack][i];
+		status._runningStatus = 0;
+
+		// Reuse the event like playback does, so fields which are not
+		// set by some events keep the same values
+		EventInfo info;
+		info.subtrack = i;
+		FlattenedEvent flatEvent;
+		flatEvent.tick = 0;
+		while (true) {
+			parseNextEvent(info);
+			flatEvent.info = info;
+			flatEvent.tick += info.delta;
+			flatEvent.next = status._playPos;
+			flatEvent.runningStatus = status._runningStatus;
+			_flatEvents[i].push_back(flatEvent);
+
+			if (info.event == 0xFF && info.ext.type == 0x2F)
+				break;
+
+			if (info.event == 0xFF && info.ext.type == 0x51 && info.length >= 3) {
+				// Keep the tempo changes sorted by tick, and by subtrack
+				// for changes on the same tick
+				FlattenedTempoChange change;
+				change.tick = flatEvent.tick;
+				change.tempo = info.ext.data[0] << 16 | info.ext.data[1] << 8 | info.ext.data[2];
+				uint j = _flatTempoChanges.size();
+				while (j > 0 && _flatTempoChanges[j - 1].tick > change.tick)
+					j--;
+				_flatTempoChanges.insert_at(j, change);
+			}
+
+			if (info.event < 0x80 || _flatEvents[i].size() >= 0x100000) {
+				// Without an End of Track the subtrack might continue
+				// differently during playback, so it can't be used to jump
+				_flatTrackSeekable = false;
+				break;
+			}
+		}
+	}
+	_flatteningTrack = false;
+	_position = currentPos;
+	_flatTrack = _activeTrack;
+}
+
+void MidiParser::clearFlattenedTrack() {
+	for (int i = 0; i < MAXIMUM_SUBTRACKS; i++) {
+		_flatEvents[i].clear();
+		_flatEventIndex[i] = 0;
+	}
+	_flatTempoChanges.clear();
+	_flatTrackSeekable = false;
+	_flatTrack = 255;
+}
+
+bool MidiParser::readFlattenedEvent(EventInfo &info) {
+	if (_flatteningTrack || _flatTrack != _activeTrack)
+		return false;
+
+	uint8 subtrack = info.subtrack;
+	const Common::Array<FlattenedEvent> &events = _flatEvents[subtrack];
+	byte *playPos = _position._subtracks[subtrack]._playPos;
+
+	// Usually the next event follows the previous one, but after a jump
+	// or a loop the event at the new position has to be looked up
+	uint32 index = _flatEventIndex[subtrack];
+	if (index >= events.size() || events[index].info.start != playPos) {
+		uint32 low = 0;
+		uint32 high = events.size();
+		while (low < high) {
+			uint32 mid = (low + high) / 2;
+			if (events[mid].info.start < playPos)
+				low = mid + 1;
+			else
+				high = mid;
+		}
+		index = low;
+		if (index >= events.size() || events[index].info.start != playPos)
+			return false;
+	}
+
+	info = events[index].info;
+	_position._subtracks[subtrack]._playPos = events[index].next;
+	_position._subtracks[subtrack]._runningStatus = events[index].runningStatus;
+	_flatEventIndex[subtrack] = index + 1;
+	return true;
+}
+
+uint32 MidiParser::getFlattenedTickTime(uint32 tick, uint32 &psecPerTick) const {
+	// Playing the track from the start begins with the current tempo
+	uint32 time = 0;
+	uint32 lastTick = 0;
+	psecPerTick = _psecPerTick;
+	for (uint i = 0; i < _flatTempoChanges.size() && _flatTempoChanges[i].tick <= tick; i++) {
+		time += (_flatTempoChanges[i].tick - lastTick) * psecPerTick;
+		lastTick = _flatTempoChanges[i].tick;
+		if (_ppqn)
+			psecPerTick = (_flatTempoChanges[i].tempo + (_ppqn >> 2)) / _ppqn;
+	}
+	return time + (tick - lastTick) * psecPerTick;
+}
+
+bool MidiParser::seekFlattenedTrack(uint32 tick) {
+	uint32 psecPerTick;
+	for (int i = 0; i < _numSubtracks[_activeTrack]; i++) {
+		const Common::Array<FlattenedEvent> &events = _flatEvents[i];
+		Tracker::SubtrackStatus &status = _position._subtracks[i];
+
+		// Find the first event at or after the tick
+		uint32 low = 0;
+		uint32 high = events.size();
+		while (low < high) {
+			uint32 mid = (low + high) / 2;
+			if (events[mid].tick < tick)
+				low = mid + 1;
+			else
+				high = mid;
+		}
+
+		if (low > 0) {
+			status._lastEventTick = events[low - 1].tick;
+			status._lastEventTime = getFlattenedTickTime(status._lastEventTick, psecPerTick);
+			if (status._lastEventTick >= _position._lastEventTick) {
+				_position._lastEventTick = status._lastEventTick;
+				_position._lastEventTime = status._lastEventTime;
+			}
+		}
+
+		if (low >= events.size()) {
+			// The subtrack ended before the tick
+			status.stopTracking();
+			continue;
+		}
+
+		_nextSubtrackEvents[i] = events[low].info;
+		status._playPos = events[low].next;
+		status._runningStatus = events[low].runningStatus;
+		_flatEventIndex[i] = low + 1;
+	}
+
+	if (!_position.isTracking())
+		return false;
+
+	_position._playTime = getFlattenedTickTime(tick, psecPerTick);
+	_position._playTick = tick;
+
+	// Apply the last tempo change before the tick, like processing it would
+	uint changes = 0;
+	while (changes < _flatTempoChanges.size() && _flatTempoChanges[changes].tick < tick)
+		changes++;
+	if (changes > 0)
+		setTempo(_flatTempoChanges[changes - 1].tempo);
+
+	determineNextEvent();
+	return true;
+}
@@ -25,6 +25,7 @@
 #define AUDIO_MIDIPARSER_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/endian.h"
 #include "common/stream.h"
 
@@ -190,6 +191,17 @@ struct NoteTimer {
 	NoteTimer() : channel(0), note(0), timeLeft(0) {}
 };
 
+/**
+ * An event of a flattened subtrack, as parsed from the start of the subtrack.
+ * See the mpFlattenTracks property.
+ */
+struct FlattenedEvent {
+	EventInfo info;       ///< The event as it was parsed.
+	uint32 tick;          ///< The tick of the event, counted from the start of the subtrack.
+	byte * next;          ///< The position of the next event in the MIDI stream.
+	byte   runningStatus; ///< The running status after the event.
+};
+
 
 
 
@@ -350,6 +362,18 @@ struct NoteTimer {
  * MidiParser::unloadMusic to permanently stop the music. (This
  * method resets everything and detaches the MidiParser from the
  * memory block containing the music data.)
+ *
+ * <b>Flattened tracks.</b>
+ * By setting the mpFlattenTracks property, the subtracks of the
+ * active track are parsed once when it is set, and the parsed
+ * events are stored in an array. Parsers which support this, like
+ * MidiParser_SMF and MidiParser_XMIDI, then take their events from
+ * the array instead of parsing them again in the timer callback,
+ * and jumpToTick can find its target without parsing the track
+ * from the start when it doesn't fire events. A parser supports
+ * flattened tracks by calling readFlattenedEvent at the start of
+ * parseNextEvent, and by keeping side effects of parsing out of
+ * parseNextEvent while _flatteningTrack is set.
  */
 class MidiParser {
 protected:
@@ -388,6 +412,18 @@ protected:
 													  ///< simulated events in certain formats.
 	bool   _abortParse;    ///< If a jump or other operation interrupts parsing, flag to abort.
 	bool   _jumpingToTick; ///< True if currently inside jumpToTick
+	bool   _flattenTracks; ///< True if the subtracks of the active track should be flattened
+	bool   _flatteningTrack; ///< True while the subtracks of the active track are being flattened
+	bool   _flatTrackSeekable; ///< True if jumpToTick can use the flattened subtracks to find its target
+	byte   _flatTrack;     ///< The track which was flattened, or 255 if there is none
+	Common::Array<FlattenedEvent> _flatEvents[MAXIMUM_SUBTRACKS]; ///< The flattened subtracks of _flatTrack
+
+	struct FlattenedTempoChange {
+		uint32 tick;
+		uint32 tempo;
+	};
+	Common::Array<FlattenedTempoChange> _flatTempoChanges; ///< The tempo events of _flatTrack, in the order they are played
+	uint32 _flatEventIndex[MAXIMUM_SUBTRACKS]; ///< The flattened event which most likely comes next for each subtrack
 	bool   _doParse;       ///< True if the parser should be parsing; false if it should not be active
 	bool   _pause;		   ///< True if the parser has paused parsing
 
@@ -430,6 +466,31 @@ protected:
 	 */
 	virtual void onTrackStart(uint8 track) { };
 
+	/**
+	 * Parses the subtracks of the active track into _flatEvents, if the
+	 * mpFlattenTracks property is set and this wasn't done yet.
+	 */
+	void flattenActiveTrack();
+	void clearFlattenedTrack();
+	/**
+	 * Copies the flattened event at the current position of the subtrack
+	 * of info into info, and advances the position past it. Returns false
+	 * if there is no such event, in which case the event should be parsed.
+	 */
+	bool readFlattenedEvent(EventInfo &info);
+	/**
+	 * Sets the position to the specified tick using the flattened subtracks,
+	 * without processing the skipped events. Returns false if the track ends
+	 * before the tick.
+	 */
+	bool seekFlattenedTrack(uint32 tick);
+	/**
+	 * Returns the time of the specified tick in the flattened track, as if
+	 * it was played from the start with the current tempo, and the time per
+	 * tick after the tempo changes up to that tick.
+	 */
+	uint32 getFlattenedTickTime(uint32 tick, uint32 &psecPerTick) const;
+
 	virtual void sendToDriver(uint32 b);
 	void sendToDriver(byte status, byte firstOp, byte secondOp) {
 		sendToDriver(status | ((uint32)firstOp << 8) | ((uint32)secondOp << 16));
@@ -506,7 +567,14 @@ public:
 		  * or setting the track. Use startPlaying to start playback.
 		  * Note that not every parser implementation might support this.
 		  */
-		 mpDisableAutoStartPlayback = 7
+		 mpDisableAutoStartPlayback = 7,
+
+		 /**
+		  * Parses the active track once when it is set, so that playback
+		  * and jumps don't need to parse it again. Only the MIDI formats
+		  * which support this are affected, see MidiParser.
+		  */
+		 mpFlattenTracks = 8
 	};
 
 public:
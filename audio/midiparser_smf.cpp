@@ -32,6 +32,9 @@ MidiParser_SMF::MidiParser_SMF(int8 source) : MidiParser(source) {
 }
 
 void MidiParser_SMF::parseNextEvent(EventInfo &info) {
+	if (readFlattenedEvent(info))
+		return;
+
 	uint8 subtrack = info.subtrack;
 	byte *playPos = _position._subtracks[subtrack]._playPos;
 	info.start = playPos;
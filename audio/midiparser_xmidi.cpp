@@ -73,6 +73,8 @@ protected:
 	uint32 read4low(byte *&data);
 
 	void parseNextEvent(EventInfo &info) override;
+	void decodeNextEvent(EventInfo &info);
+	void processController(EventInfo &info);
 
 	void resetTracking() override {
 		MidiParser::resetTracking();
@@ -153,6 +155,16 @@ bool MidiParser_XMIDI::jumpToIndex(uint8 index, bool stopNotes) {
 }
 
 void MidiParser_XMIDI::parseNextEvent(EventInfo &info) {
+	if (!readFlattenedEvent(info))
+		decodeNextEvent(info);
+
+	// The XMIDI controllers are handled when the event is needed, as
+	// flattening the track decodes all events in advance
+	if (info.command() == 0xB)
+		processController(info);
+}
+
+void MidiParser_XMIDI::decodeNextEvent(EventInfo &info) {
 	byte *playPos = _position._subtracks[0]._playPos;
 	info.start = playPos;
 	info.delta = readVLQ2(playPos);
@@ -187,90 +199,12 @@ void MidiParser_XMIDI::parseNextEvent(EventInfo &info) {
 
 	case 0x8:
 	case 0xA:
+	case 0xB:
 	case 0xE:
 		info.basic.param1 = *(playPos++);
 		info.basic.param2 = *(playPos++);
 		break;
 
-	case 0xB:
-		info.basic.param1 = *(playPos++);
-		info.basic.param2 = *(playPos++);
-
-		// This isn't a full XMIDI implementation, but it should
-		// hopefully be "good enough" for most things.
-
-		switch (info.basic.param1) {
-		// Simplified XMIDI looping.
-		case 0x74: {	// XMIDI_CONTROLLER_FOR_LOOP
-				byte *pos = playPos;
-				if (_loopCount < ARRAYSIZE(_loop) - 1)
-					_loopCount++;
-				else
-					warning("XMIDI: Exceeding maximum loop count %d", ARRAYSIZE(_loop));
-
-				_loop[_loopCount].pos = pos;
-				_loop[_loopCount].repeat = info.basic.param2;
-				break;
-			}
-
-		case 0x75:	// XMIDI_CONTROLLER_NEXT_BREAK
-			if (_loopCount >= 0) {
-				if (info.basic.param2 < 64) {
-					// End the current loop.
-					_loopCount--;
-				} else {
-					// Repeat 0 means "loop forever".
-					if (_loop[_loopCount].repeat) {
-						if (--_loop[_loopCount].repeat == 0) {
-							_loopCount--;
-						} else {
-							playPos = _loop[_loopCount].pos;
-							info.loop = true;
-						}
-					} else {
-						playPos = _loop[_loopCount].pos;
-						info.loop = true;
-					}
-				}
-			}
-			break;
-
-		case 0x77:	// XMIDI_CONTROLLER_CALLBACK_TRIG
-			if (_callbackProc)
-				_callbackProc(info.basic.param2, _callbackData);
-			break;
-
-		case 0x78:	// XMIDI_CONTROLLER_SEQ_BRANCH_INDEX
-			// This controller marks a branch point. It is converted
-			// to an entry in the RBRN header by the XMIDI conversion
-			// tool. For playback it is unnecessary.
-			break;
-
-		case 0x6e:	// XMIDI_CONTROLLER_CHAN_LOCK
-		case 0x6f:	// XMIDI_CONTROLLER_CHAN_LOCK_PROT
-		case 0x70:	// XMIDI_CONTROLLER_VOICE_PROT
-		case 0x71:	// XMIDI_CONTROLLER_TIMBRE_PROT
-		case 0x72:	// XMIDI_CONTROLLER_BANK_CHANGE
-			// These controllers are handled in the Miles drivers
-			break;
-
-		case 0x73:	// XMIDI_CONTROLLER_IND_CTRL_PREFIX
-		case 0x76:	// XMIDI_CONTROLLER_CLEAR_BB_COUNT
-		default:
-			if (info.basic.param1 >= 0x73 && info.basic.param1 <= 0x76) {
-				warning("Unsupported XMIDI controller %d (0x%2x)",
-					info.basic.param1, info.basic.param1);
-			}
-			break;
-		}
-
-		// Should we really keep passing the XMIDI controller events to
-		// the MIDI driver, or should we turn them into some kind of
-		// NOP events? (Dummy meta events, perhaps?) Ah well, it has
-		// worked so far, so it shouldn't cause any damage...
-
-		break;
-
 	case 0xF: // Meta or SysEx event
 		switch (info.event & 0x0F) {
 		case 0x2: // Song Position Pointer
@@ -324,6 +258,89 @@ void MidiParser_XMIDI::parseNextEvent(EventInfo &info) {
 	_position._subtracks[0]._playPos = playPos;
 }
 
+void MidiParser_XMIDI::processController(EventInfo &info) {
+	if (_flatteningTrack) {
+		// Loops and callbacks happen during playback, which jumps can't
+		// skip over without parsing the track
+		if (info.basic.param1 >= 0x74 && info.basic.param1 <= 0x77)
+			_flatTrackSeekable = false;
+		return;
+	}
+
+	// This isn't a full XMIDI implementation, but it should
+	// hopefully be "good enough" for most things.
+
+	switch (info.basic.param1) {
+	// Simplified XMIDI looping.
+	case 0x74: {	// XMIDI_CONTROLLER_FOR_LOOP
+			byte *pos = _position._subtracks[0]._playPos;
+			if (_loopCount < ARRAYSIZE(_loop) - 1)
+				_loopCount++;
+			else
+				warning("XMIDI: Exceeding maximum loop count %d", ARRAYSIZE(_loop));
+
+			_loop[_loopCount].pos = pos;
+			_loop[_loopCount].repeat = info.basic.param2;
+			break;
+		}
+
+	case 0x75:	// XMIDI_CONTROLLER_NEXT_BREAK
+		if (_loopCount >= 0) {
+			if (info.basic.param2 < 64) {
+				// End the current loop.
+				_loopCount--;
+			} else {
+				// Repeat 0 means "loop forever".
+				if (_loop[_loopCount].repeat) {
+					if (--_loop[_loopCount].repeat == 0) {
+						_loopCount--;
+					} else {
+						_position._subtracks[0]._playPos = _loop[_loopCount].pos;
+						info.loop = true;
+					}
+				} else {
+					_position._subtracks[0]._playPos = _loop[_loopCount].pos;
+					info.loop = true;
+				}
+			}
+		}
+		break;
+
+	case 0x77:	// XMIDI_CONTROLLER_CALLBACK_TRIG
+		if (_callbackProc)
+			_callbackProc(info.basic.param2, _callbackData);
+		break;
+
+	case 0x78:	// XMIDI_CONTROLLER_SEQ_BRANCH_INDEX
+		// This controller marks a branch point. It is converted
+		// to an entry in the RBRN header by the XMIDI conversion
+		// tool. For playback it is unnecessary.
+		break;
+
+	case 0x6e:	// XMIDI_CONTROLLER_CHAN_LOCK
+	case 0x6f:	// XMIDI_CONTROLLER_CHAN_LOCK_PROT
+	case 0x70:	// XMIDI_CONTROLLER_VOICE_PROT
+	case 0x71:	// XMIDI_CONTROLLER_TIMBRE_PROT
+	case 0x72:	// XMIDI_CONTROLLER_BANK_CHANGE
+		// These controllers are handled in the Miles drivers
+		break;
+
+	case 0x73:	// XMIDI_CONTROLLER_IND_CTRL_PREFIX
+	case 0x76:	// XMIDI_CONTROLLER_CLEAR_BB_COUNT
+	default:
+		if (info.basic.param1 >= 0x73 && info.basic.param1 <= 0x76) {
+			warning("Unsupported XMIDI controller %d (0x%2x)",
+				info.basic.param1, info.basic.param1);
+		}
+		break;
+	}
+
+	// Should we really keep passing the XMIDI controller events to
+	// the MIDI driver, or should we turn them into some kind of
+	// NOP events? (Dummy meta events, perhaps?) Ah well, it has
+	// worked so far, so it shouldn't cause any damage...
+}
+
 void MidiParser_XMIDI::setMidiDriver(MidiDriver_BASE *driver) {
 	MidiParser::setMidiDriver(driver);
 	_newTimbreListDriver = dynamic_cast<Audio::MidiDriver_Miles_Xmidi_Timbres *>(driver);
@@ -21,11 +21,14 @@
 
 #include "gui/EventRecorder.h"
 
+#include "common/jobs.h"
+#include "common/profiler.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 
 #include "audio/mixer_intern.h"
 #include "audio/rate.h"
+#include "audio/rate_intern.h"
 #include "audio/audiostream.h"
 #include "audio/timestamp.h"
 
@@ -42,7 +45,8 @@ namespace Audio {
  */
 class Channel {
 public:
-	Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream, DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent);
+	Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream, DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent,
+	        RateConverterQuality quality, SincFilterCache *sincFilterCache);
 	~Channel();
 
 	/**
@@ -52,9 +56,10 @@ public:
 	 * @param len  number of sample *pairs*. So a value of
 	 *             10 means that the buffer contains twice 10 sample, each
 	 *             16 bits, for a total of 40 bytes.
+	 * @param time The current time in milliseconds, for timing bookkeeping.
 	 * @return number of sample pairs processed (which can still be silence!)
 	 */
-	int mix(int16 *data, uint len);
+	int mix(int32 *data, uint len, uint32 time);
 
 	/**
 	 * Queries whether the channel is still playing or not.
@@ -78,8 +83,9 @@ public:
 	 *
 	 * @param paused true, when the channel should be paused.
 	 *               false when it should be unpaused.
+	 * @param time   The time of the request, in milliseconds.
 	 */
-	void pause(bool paused);
+	void pause(bool paused, uint32 time);
 
 	/**
 	 * Queries whether the channel is currently paused.
@@ -134,6 +140,11 @@ public:
 	*/
 	void resetRate();
 
+	/**
+	 * Get the native sample rate of the channel's AudioStream.
+	 */
+	uint32 getNativeRate() const { return _stream->getRate(); }
+
 	/**
 	 * Notifies the channel that the global sound type
 	 * volume settings changed.
@@ -141,9 +152,13 @@ public:
 	void notifyGlobalVolChange() { updateChannelVolumes(); }
 
 	/**
-	 * Queries how long the channel has been playing.
+	 * Queries the bookkeeping needed to compute how long the channel has
+	 * been playing.
 	 */
-	Timestamp getElapsedTime();
+	uint32 getSamplesConsumed() const { return _samplesConsumed; }
+	uint32 getMixerTimeStamp() const { return _mixerTimeStamp; }
+	uint32 getPauseStartTime() const { return _pauseStartTime; }
+	uint32 getPauseTime() const { return _pauseTime; }
 
 	/**
 	 * Replaces the channel's stream with a version that loops indefinitely.
@@ -197,7 +212,9 @@ private:
 #pragma mark -
 
 MixerImpl::MixerImpl(uint sampleRate, bool stereo, uint outBufSize)
-	: _mutex(), _sampleRate(sampleRate), _stereo(stereo), _outBufSize(outBufSize), _mixerReady(false), _handleSeed(0), _soundTypeSettings() {
+	: _mutex(), _sampleRate(sampleRate), _stereo(stereo), _outBufSize(outBufSize), _mixerReady(false), _handleSeed(0), _soundTypeSettings(),
+	  _rateConverterQuality(kRateConverterLinear), _sincFilterCache(new SincFilterCache()), _parallelMixing(false),
+	  _lastCallbackTime(0), _timeBalance(0) {
 
 	assert(sampleRate > 0);
 
@@ -208,12 +225,25 @@ MixerImpl::MixerImpl(uint sampleRate, bool stereo, uint outBufSize)
 MixerImpl::~MixerImpl() {
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		delete _channels[i];
+
+	// The channels' converters refer to the cached filters
+	delete _sincFilterCache;
 }
 
 void MixerImpl::setReady(bool ready) {
+	_mixerReady.store(ready);
+}
+
+void MixerImpl::setRateConverterQuality(RateConverterQuality quality) {
+	Common::StackLock lock(_mutex);
+
+	_rateConverterQuality = quality;
+}
+
+void MixerImpl::setParallelMixing(bool enable) {
 	Common::StackLock lock(_mutex);
 
-	_mixerReady = ready;
+	_parallelMixing = enable;
 }
 
 uint MixerImpl::getOutputRate() const {
@@ -225,7 +255,61 @@ bool MixerImpl::getOutputStereo() const {
 }
 
 uint MixerImpl::getOutputBufSize() const {
-	return _outBufSize;
+	return _outBufSize.load();
+}
+
+void MixerImpl::setOutputBufSize(uint outBufSize) {
+	_outBufSize.store(outBufSize);
+}
+
+void MixerImpl::getOutputStats(OutputStats &stats) const {
+	stats.callbacks = _statCallbacks.load();
+	stats.underruns = _statUnderruns.load();
+	stats.bufferTime = _statBufferTime.load();
+	stats.lastMixTime = _statLastMixTime.load();
+	stats.maxMixTime = _statMaxMixTime.load();
+}
+
+void MixerImpl::resetOutputStats() {
+	_statCallbacks.store(0);
+	_statUnderruns.store(0);
+	_statMaxMixTime.store(0);
+}
+
+void MixerImpl::updateOutputStats(uint64 start, uint64 end, uint frames) {
+	const int64 bufferTime = (int64)frames * 1000000 / _sampleRate;
+	const uint32 mixTime = (uint32)(end - start);
+
+	// Mixing slower than real time always starves the device
+	bool underrun = mixTime > bufferTime;
+
+	// Devices may request several buffers in a burst and then pause, so
+	// instead of checking each interval, the audio produced is compared
+	// with the time passed. Running more than a buffer short means that
+	// the device ran dry.
+	if (_lastCallbackTime) {
+		const uint64 interval = start - _lastCallbackTime;
+		if (interval > 1000000) {
+			// The output was paused rather than starved
+			_timeBalance = 0;
+		} else {
+			_timeBalance -= (int64)interval;
+			if (_timeBalance < -bufferTime) {
+				underrun = true;
+				_timeBalance = 0;
+			}
+		}
+	}
+	_timeBalance = MIN<int64>(_timeBalance + bufferTime, bufferTime * 2);
+	_lastCallbackTime = start;
+
+	_statCallbacks.fetchAdd(1);
+	if (underrun)
+		_statUnderruns.fetchAdd(1);
+	_statBufferTime.store((uint32)bufferTime);
+	_statLastMixTime.store(mixTime);
+	if (mixTime > _statMaxMixTime.loadRelaxed())
+		_statMaxMixTime.store(mixTime);
 }
 
 void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
@@ -251,6 +335,151 @@ void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
 	_handleSeed++;
 	if (handle)
 		*handle = chanHandle;
+
+	// Reset the requested settings along with the handle, so that control
+	// functions racing with us can't apply the settings of the old channel
+	Common::StackLock lock(_commandMutex);
+	publishChannel(index, true);
+}
+
+void MixerImpl::deleteChannel(int index) {
+	delete _channels[index];
+	_channels[index] = nullptr;
+
+	publishChannel(index);
+}
+
+void MixerImpl::publishChannel(int index, bool inserted) {
+	ChannelState &state = _channelStates[index];
+	Channel *chan = _channels[index];
+
+	state.beginWrite();
+	if (!chan) {
+		state.handle.storeRelaxed(SoundHandle()._val);
+	} else {
+		if (inserted) {
+			state.id.storeRelaxed(chan->getId());
+			state.type.storeRelaxed(chan->getType());
+			state.nativeRate.storeRelaxed(chan->getNativeRate());
+			state.volume.storeRelaxed(chan->getVolume());
+			state.balance.storeRelaxed(chan->getBalance());
+			state.rate.storeRelaxed(chan->getRate());
+		}
+
+		state.handle.storeRelaxed(chan->getHandle()._val);
+		state.samplesConsumed.storeRelaxed(chan->getSamplesConsumed());
+		state.mixerTimeStamp.storeRelaxed(chan->getMixerTimeStamp());
+		state.pauseStartTime.storeRelaxed(chan->getPauseStartTime());
+		state.pauseTime.storeRelaxed(chan->getPauseTime());
+		state.paused.storeRelaxed(chan->isPaused());
+	}
+	state.endWrite();
+}
+
+void MixerImpl::pushCommand(const Command &command) {
+	{
+		Common::StackLock lock(_commandMutex);
+
+		// Record the requested settings right away, so that the getters
+		// return them before the mixer applied them
+		ChannelState &state = _channelStates[command.target % NUM_CHANNELS];
+		switch (command.type) {
+		case Command::kSetVolume:
+		case Command::kSetBalance:
+		case Command::kSetRate:
+		case Command::kResetRate:
+		case Command::kPauseHandle:
+			// Simply ignore requests for handles of sounds that already terminated
+			if (state.handle.loadRelaxed() != command.target)
+				return;
+			break;
+		default:
+			break;
+		}
+
+		if (command.type == Command::kSetVolume)
+			state.volume.storeRelaxed(command.value);
+		else if (command.type == Command::kSetBalance)
+			state.balance.storeRelaxed(command.value);
+		else if (command.type == Command::kSetRate)
+			state.rate.storeRelaxed(command.value);
+		else if (command.type == Command::kResetRate)
+			state.rate.storeRelaxed(state.nativeRate.loadRelaxed());
+
+		if (_commands.push(command))
+			return;
+	}
+
+	// The mixer did not keep up, e.g. because the audio output is paused.
+	// Catch up on its behalf.
+	Common::StackLock lock(_mutex);
+	processCommands();
+	applyCommand(command);
+}
+
+void MixerImpl::processCommands() {
+	Command command;
+	while (_commands.pop(command))
+		applyCommand(command);
+}
+
+void MixerImpl::applyCommand(const Command &command) {
+	switch (command.type) {
+	case Command::kPauseAll:
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			if (_channels[i] != nullptr) {
+				_channels[i]->pause(command.value, command.time);
+				publishChannel(i);
+			}
+		}
+		return;
+
+	case Command::kPauseID:
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			if (_channels[i] != nullptr && _channels[i]->getId() == (int)command.target) {
+				_channels[i]->pause(command.value, command.time);
+				publishChannel(i);
+				return;
+			}
+		}
+		return;
+
+	case Command::kUpdateSoundType:
+		for (int i = 0; i != NUM_CHANNELS; ++i) {
+			if (_channels[i] && _channels[i]->getType() == (SoundType)command.target)
+				_channels[i]->notifyGlobalVolChange();
+		}
+		return;
+
+	default:
+		break;
+	}
+
+	const int index = command.target % NUM_CHANNELS;
+	Channel *chan = _channels[index];
+	if (!chan || chan->getHandle()._val != command.target)
+		return;
+
+	switch (command.type) {
+	case Command::kSetVolume:
+		chan->setVolume(command.value);
+		break;
+	case Command::kSetBalance:
+		chan->setBalance(command.value);
+		break;
+	case Command::kSetRate:
+		chan->setRate(command.value);
+		break;
+	case Command::kResetRate:
+		chan->resetRate();
+		break;
+	case Command::kPauseHandle:
+		chan->pause(command.value, command.time);
+		publishChannel(index);
+		break;
+	default:
+		break;
+	}
 }
 
 void MixerImpl::playStream(
@@ -263,13 +492,16 @@ void MixerImpl::playStream(
 			bool reverseStereo) {
 	Common::StackLock lock(_mutex);
 
+	// Queued pause requests must not affect the new channel
+	processCommands();
+
 	if (stream == nullptr) {
 		warning("stream is 0");
 		return;
 	}
 
 
-	assert(_mixerReady);
+	assert(_mixerReady.load());
 
 	// Prevent duplicate sounds
 	if (id != -1) {
@@ -292,26 +524,34 @@ void MixerImpl::playStream(
 #endif
 
 	// Create the channel
-	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent);
+	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent, _rateConverterQuality, _sincFilterCache);
 	chan->setVolume(volume);
 	chan->setBalance(balance);
 	insertChannel(handle, chan);
 }
 
 int MixerImpl::mixCallback(byte *samples, uint len) {
+	PROFILE_ZONE("MixerImpl::mixCallback");
 	assert(samples);
 
-	Common::StackLock lock(_mutex);
+	const uint64 start = g_system->getMicros();
 
-	int16 *buf = (int16 *)samples;
+	// Never wait for a game thread starting or stopping a sound, or reading
+	// from a stream under mutex(). The buffer is silent instead, and the
+	// commands are applied by the next callback.
+	if (!_mutex.tryLock()) {
+		memset(samples, 0, len);
+		updateOutputStats(start, g_system->getMicros(), _stereo ? len >> 2 : len >> 1);
+		return 0;
+	}
 
-	// Since the mixer callback has been called, the mixer must be ready...
-	_mixerReady = true;
+	processCommands();
 
-	//  zero the buf
-	memset(buf, 0, len);
+	// Since the mixer callback has been called, the mixer must be ready...
+	_mixerReady.store(true);
 
 	// we store 16-bit samples
+	const uint samplesCount = len >> 1;
 	if (_stereo) {
 		assert(len % 4 == 0);
 		len >>= 2;
@@ -320,41 +560,127 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 		len >>= 1;
 	}
 
-	// mix all channels
-	int res = 0, tmp;
+	// The channels are summed on a 32-bit bus, which is only clamped once
+	if (_mixBus.size() < samplesCount)
+		_mixBus.resize(samplesCount);
+	int32 *bus = _mixBus.data();
+	memset(bus, 0, samplesCount * sizeof(int32));
+
+	// Reading the time once also keeps the jobs from calling into OSystem
+	const uint32 time = g_system->getMillis(true);
+
+	// collect the channels to mix
+	int active[NUM_CHANNELS];
+	int numActive = 0;
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		if (_channels[i]) {
-			if (_channels[i]->isFinished()) {
-				delete _channels[i];
-				_channels[i] = nullptr;
-			} else if (!_channels[i]->isPaused()) {
-				tmp = _channels[i]->mix(buf, len);
-
-				if (tmp > res)
-					res = tmp;
-			}
+			if (_channels[i]->isFinished())
+				deleteChannel(i);
+			else if (!_channels[i]->isPaused())
+				active[numActive++] = i;
+		}
+
+	int res = 0, tmp;
+	if (_parallelMixing && numActive > 1 && g_system->getJobSystem()->getThreadCount() > 1) {
+		res = mixParallel(bus, len, active, numActive, time);
+	} else {
+		// mix all channels
+		for (int i = 0; i != numActive; i++) {
+			tmp = _channels[active[i]]->mix(bus, len, time);
+			publishChannel(active[i]);
+
+			if (tmp > res)
+				res = tmp;
 		}
+	}
+
+	getMixBusClampFunc()((int16 *)samples, bus, samplesCount);
+
+	updateOutputStats(start, g_system->getMicros(), len);
+
+	_mutex.unlock();
+	return res;
+}
+
+namespace {
+
+struct ParallelMix {
+	Channel *const *channels;
+	const int *active;
+	int32 *buffers;
+	uint len;
+	uint samples;
+	uint32 time;
+	int results[32];
+};
+
+} // End of anonymous namespace
+
+void MixerImpl::mixChannelRange(uint begin, uint end, void *refCon) {
+	ParallelMix *mix = (ParallelMix *)refCon;
+
+	for (uint i = begin; i < end; i++) {
+		int32 *buf = &mix->buffers[i * mix->samples];
+		memset(buf, 0, mix->samples * sizeof(int32));
+		mix->results[i] = mix->channels[mix->active[i]]->mix(buf, mix->len, mix->time);
+	}
+}
+
+int MixerImpl::mixParallel(int32 *bus, uint len, const int *channels, int numChannels, uint32 time) {
+	// Every channel gets its own buffer, which is added to the bus
+	// afterwards. Nothing saturates before the bus is clamped, so this
+	// yields exactly the same output as mixing sequentially.
+	const uint samples = _stereo ? len * 2 : len;
+	if (_parallelBuffers.size() < numChannels * samples)
+		_parallelBuffers.resize(numChannels * samples);
+
+	ParallelMix mix;
+	STATIC_ASSERT(ARRAYSIZE(mix.results) == NUM_CHANNELS, results_must_cover_all_channels);
+	mix.channels = _channels;
+	mix.active = channels;
+	mix.buffers = _parallelBuffers.data();
+	mix.len = len;
+	mix.samples = samples;
+	mix.time = time;
+
+	g_system->getJobSystem()->parallelFor(numChannels, mixChannelRange, &mix);
+
+	int res = 0;
+	for (int i = 0; i != numChannels; i++) {
+		const int32 *src = &_parallelBuffers[i * samples];
+		const uint count = mix.results[i] * (_stereo ? 2 : 1);
+
+		for (uint j = 0; j < count; j++)
+			bus[j] += src[j];
+
+		publishChannel(channels[i]);
+
+		if (mix.results[i] > res)
+			res = mix.results[i];
+	}
 
 	return res;
 }
 
 void MixerImpl::stopAll() {
 	Common::StackLock lock(_mutex);
+	processCommands();
+
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != nullptr && !_channels[i]->isPermanent()) {
-			delete _channels[i];
-			_channels[i] = nullptr;
-		}
+		if (_channels[i] != nullptr && !_channels[i]->isPermanent())
+			deleteChannel(i);
 	}
 }
 
 void MixerImpl::stopID(int id) {
 	Common::StackLock lock(_mutex);
+
+	// Queued requests for the id must not affect a later sound reusing it
+	processCommands();
+
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != nullptr && _channels[i]->getId() == id) {
-			delete _channels[i];
-			_channels[i] = nullptr;
-		}
+		if (_channels[i] != nullptr && _channels[i]->getId() == id)
+			deleteChannel(i);
 	}
 }
 
@@ -366,87 +692,87 @@ void MixerImpl::stopHandle(SoundHandle handle) {
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
 		return;
 
-	delete _channels[index];
-	_channels[index] = nullptr;
+	deleteChannel(index);
 }
 
 void MixerImpl::muteSoundType(SoundType type, bool mute) {
 	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
-	_soundTypeSettings[type].mute = mute;
+	_soundTypeSettings[type].mute.store(mute);
 
-	for (int i = 0; i != NUM_CHANNELS; ++i) {
-		if (_channels[i] && _channels[i]->getType() == type)
-			_channels[i]->notifyGlobalVolChange();
-	}
+	Command command = { Command::kUpdateSoundType, (uint32)type, 0, 0 };
+	pushCommand(command);
 }
 
 bool MixerImpl::isSoundTypeMuted(SoundType type) const {
 	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
-	return _soundTypeSettings[type].mute;
+	return _soundTypeSettings[type].mute.load();
 }
 
 void MixerImpl::setChannelVolume(SoundHandle handle, byte volume) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-
-	_channels[index]->setVolume(volume);
+	Command command = { Command::kSetVolume, handle._val, volume, 0 };
+	pushCommand(command);
 }
 
 byte MixerImpl::getChannelVolume(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return 0;
+	const ChannelState &state = _channelStates[handle._val % NUM_CHANNELS];
+
+	uint32 seq;
+	byte volume;
+	do {
+		seq = state.beginRead();
+		volume = state.handle.loadRelaxed() == handle._val ? state.volume.loadRelaxed() : 0;
+	} while (!state.endRead(seq));
 
-	return _channels[index]->getVolume();
+	return volume;
 }
 
 void MixerImpl::setChannelBalance(SoundHandle handle, int8 balance) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-
-	_channels[index]->setBalance(balance);
+	Command command = { Command::kSetBalance, handle._val, balance, 0 };
+	pushCommand(command);
 }
 
 int8 MixerImpl::getChannelBalance(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return 0;
+	const ChannelState &state = _channelStates[handle._val % NUM_CHANNELS];
 
-	return _channels[index]->getBalance();
-}
+	uint32 seq;
+	int8 balance;
+	do {
+		seq = state.beginRead();
+		balance = state.handle.loadRelaxed() == handle._val ? state.balance.loadRelaxed() : 0;
+	} while (!state.endRead(seq));
 
-void MixerImpl::setChannelRate(SoundHandle handle, uint32 rate) {
-	Common::StackLock lock(_mutex);
+	return balance;
+}
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
+void MixerImpl::prepareFilterBank(uint32 rate) {
+	// Computing the bank takes a while, so the audio thread should only have
+	// to look it up
+	if (_rateConverterQuality == kRateConverterSinc && rate && rate != _sampleRate)
+		_sincFilterCache->getFilterBank(rate, _sampleRate);
+}
 
-	_channels[index]->setRate(rate);
+void MixerImpl::setChannelRate(SoundHandle handle, uint32 rate) {
+	prepareFilterBank(rate);
+	Command command = { Command::kSetRate, handle._val, (int32)rate, 0 };
+	pushCommand(command);
 }
 
 uint32 MixerImpl::getChannelRate(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return 0;
-	
-	return _channels[index]->getRate();
+	const ChannelState &state = _channelStates[handle._val % NUM_CHANNELS];
+
+	uint32 seq, rate;
+	do {
+		seq = state.beginRead();
+		rate = state.handle.loadRelaxed() == handle._val ? state.rate.loadRelaxed() : 0;
+	} while (!state.endRead(seq));
+
+	return rate;
 }
 
 void MixerImpl::resetChannelRate(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-	
-	_channels[index]->resetRate();
+	prepareFilterBank(_channelStates[handle._val % NUM_CHANNELS].nativeRate.loadRelaxed());
+	Command command = { Command::kResetRate, handle._val, 0, 0 };
+	pushCommand(command);
 }
 
 uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
@@ -454,13 +780,43 @@ uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
 }
 
 Timestamp MixerImpl::getElapsedTime(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
+	const ChannelState &state = _channelStates[handle._val % NUM_CHANNELS];
+
+	uint32 seq, samplesConsumed, mixerTimeStamp, pauseStartTime, pauseTime;
+	bool valid, paused;
+	do {
+		seq = state.beginRead();
+		valid = state.handle.loadRelaxed() == handle._val;
+		samplesConsumed = state.samplesConsumed.loadRelaxed();
+		mixerTimeStamp = state.mixerTimeStamp.loadRelaxed();
+		pauseStartTime = state.pauseStartTime.loadRelaxed();
+		pauseTime = state.pauseTime.loadRelaxed();
+		paused = state.paused.loadRelaxed();
+	} while (!state.endRead(seq));
+
+	Audio::Timestamp ts(0, _sampleRate);
+
+	if (!valid || mixerTimeStamp == 0)
+		return ts;
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return Timestamp(0, _sampleRate);
+	uint32 delta;
+	if (paused)
+		delta = pauseStartTime - mixerTimeStamp;
+	else
+		delta = g_system->getMillis(true) - mixerTimeStamp - pauseTime;
+
+	// Convert the number of samples into a time duration.
+
+	ts = ts.addFrames(samplesConsumed);
+	ts = ts.addMsecs(delta);
+
+	// In theory it would seem like a good idea to limit the approximation
+	// so that it never exceeds the theoretical upper bound set by
+	// the number of decoded samples. Meanwhile, back in the real world,
+	// doing so makes the Broken Sword cutscenes noticeably jerkier. I guess
+	// the mixer isn't invoked at the regular intervals that I first imagined.
 
-	return _channels[index]->getElapsedTime();
+	return ts;
 }
 
 void MixerImpl::loopChannel(SoundHandle handle) {
@@ -474,72 +830,77 @@ void MixerImpl::loopChannel(SoundHandle handle) {
 }
 
 void MixerImpl::pauseAll(bool paused) {
-	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != nullptr) {
-			_channels[i]->pause(paused);
-		}
-	}
+	Command command = { Command::kPauseAll, 0, paused, g_system->getMillis(true) };
+	pushCommand(command);
 }
 
 void MixerImpl::pauseID(int id, bool paused) {
-	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != nullptr && _channels[i]->getId() == id) {
-			_channels[i]->pause(paused);
-			return;
-		}
-	}
+	Command command = { Command::kPauseID, (uint32)id, paused, g_system->getMillis(true) };
+	pushCommand(command);
 }
 
 void MixerImpl::pauseHandle(SoundHandle handle, bool paused) {
-	Common::StackLock lock(_mutex);
-
-	// Simply ignore (un)pause requests for sounds that already terminated
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-
-	_channels[index]->pause(paused);
+	Command command = { Command::kPauseHandle, handle._val, paused, g_system->getMillis(true) };
+	pushCommand(command);
 }
 
 bool MixerImpl::isSoundIDActive(int id) {
-	Common::StackLock lock(_mutex);
-
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.updateSubsystems();
 #endif
 
-	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i] && _channels[i]->getId() == id)
+	for (int i = 0; i != NUM_CHANNELS; i++) {
+		const ChannelState &state = _channelStates[i];
+
+		uint32 seq;
+		bool active;
+		do {
+			seq = state.beginRead();
+			active = state.handle.loadRelaxed() != SoundHandle()._val && state.id.loadRelaxed() == id;
+		} while (!state.endRead(seq));
+
+		if (active)
 			return true;
+	}
 	return false;
 }
 
 int MixerImpl::getSoundID(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-	const int index = handle._val % NUM_CHANNELS;
-	if (_channels[index] && _channels[index]->getHandle()._val == handle._val)
-		return _channels[index]->getId();
-	return 0;
+	const ChannelState &state = _channelStates[handle._val % NUM_CHANNELS];
+
+	uint32 seq;
+	int id;
+	do {
+		seq = state.beginRead();
+		id = state.handle.loadRelaxed() == handle._val ? state.id.loadRelaxed() : 0;
+	} while (!state.endRead(seq));
+
+	return id;
 }
 
 bool MixerImpl::isSoundHandleActive(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.updateSubsystems();
 #endif
 
 	const int index = handle._val % NUM_CHANNELS;
-	return _channels[index] && _channels[index]->getHandle()._val == handle._val;
+	return _channelStates[index].handle.load() == handle._val;
 }
 
 bool MixerImpl::hasActiveChannelOfType(SoundType type) {
-	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i] && _channels[i]->getType() == type)
+	for (int i = 0; i != NUM_CHANNELS; i++) {
+		const ChannelState &state = _channelStates[i];
+
+		uint32 seq;
+		bool active;
+		do {
+			seq = state.beginRead();
+			active = state.handle.loadRelaxed() != SoundHandle()._val && state.type.loadRelaxed() == (int)type;
+		} while (!state.endRead(seq));
+
+		if (active)
 			return true;
+	}
 	return false;
 }
 
@@ -552,19 +913,16 @@ void MixerImpl::setVolumeForSoundType(SoundType type, int volume) {
 	// TODO: Maybe we should do logarithmic (not linear) volume
 	// scaling? See also Player_V2::setMasterVolume
 
-	Common::StackLock lock(_mutex);
-	_soundTypeSettings[type].volume = volume;
+	_soundTypeSettings[type].volume.store(volume);
 
-	for (int i = 0; i != NUM_CHANNELS; ++i) {
-		if (_channels[i] && _channels[i]->getType() == type)
-			_channels[i]->notifyGlobalVolChange();
-	}
+	Command command = { Command::kUpdateSoundType, (uint32)type, 0, 0 };
+	pushCommand(command);
 }
 
 int MixerImpl::getVolumeForSoundType(SoundType type) const {
 	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
 
-	return _soundTypeSettings[type].volume;
+	return _soundTypeSettings[type].volume.load();
 }
 
 
@@ -573,7 +931,8 @@ int MixerImpl::getVolumeForSoundType(SoundType type) const {
 #pragma mark -
 
 Channel::Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream,
-				 DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent)
+				 DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent,
+				 RateConverterQuality quality, SincFilterCache *sincFilterCache)
 	: _type(type), _mixer(mixer), _id(id), _permanent(permanent), _volume(Mixer::kMaxChannelVolume),
 	  _balance(0), _pauseLevel(0), _samplesConsumed(0), _samplesDecoded(0), _mixerTimeStamp(0),
 	  _pauseStartTime(0), _pauseTime(0), _converter(nullptr), _volL(0), _volR(0),
@@ -582,7 +941,8 @@ Channel::Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream,
 	assert(stream);
 
 	// Get a rate converter instance
-	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), mixer->getOutputStereo(), reverseStereo);
+	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), mixer->getOutputStereo(), reverseStereo,
+	                               quality, sincFilterCache);
 }
 
 Channel::~Channel() {
@@ -652,52 +1012,24 @@ void Channel::updateChannelVolumes() {
 	}
 }
 
-void Channel::pause(bool paused) {
+void Channel::pause(bool paused, uint32 time) {
 	//assert((paused && _pauseLevel >= 0) || (!paused && _pauseLevel));
 
 	if (paused) {
 		_pauseLevel++;
 
 		if (_pauseLevel == 1)
-			_pauseStartTime = g_system->getMillis(true);
+			_pauseStartTime = time;
 	} else if (_pauseLevel > 0) {
 		_pauseLevel--;
 
 		if (!_pauseLevel) {
-			_pauseTime = (g_system->getMillis(true) - _pauseStartTime);
+			_pauseTime = (time - _pauseStartTime);
 			_pauseStartTime = 0;
 		}
 	}
 }
 
-Timestamp Channel::getElapsedTime() {
-	const uint32 rate = _mixer->getOutputRate();
-	uint32 delta = 0;
-
-	Audio::Timestamp ts(0, rate);
-
-	if (_mixerTimeStamp == 0)
-		return ts;
-
-	if (isPaused())
-		delta = _pauseStartTime - _mixerTimeStamp;
-	else
-		delta = g_system->getMillis(true) - _mixerTimeStamp - _pauseTime;
-
-	// Convert the number of samples into a time duration.
-
-	ts = ts.addFrames(_samplesConsumed);
-	ts = ts.addMsecs(delta);
-
-	// In theory it would seem like a good idea to limit the approximation
-	// so that it never exceeds the theoretical upper bound set by
-	// _samplesDecoded. Meanwhile, back in the real world, doing so makes
-	// the Broken Sword cutscenes noticeably jerkier. I guess the mixer
-	// isn't invoked at the regular intervals that I first imagined.
-
-	return ts;
-}
-
 void Channel::loop() {
 	assert(_stream);
 
@@ -707,14 +1039,14 @@ void Channel::loop() {
 	}
 }
 
-int Channel::mix(int16 *data, uint len) {
+int Channel::mix(int32 *data, uint len, uint32 time) {
 	assert(_stream);
 	assert(_converter);
 
 	int res = 0;
 	if (!_stream->endOfData() || _converter->needsDraining()) {
 		_samplesConsumed = _samplesDecoded;
-		_mixerTimeStamp = g_system->getMillis(true);
+		_mixerTimeStamp = time;
 		_pauseTime = 0;
 		res = _converter->convert(*_stream, data, len, _volL, _volR);
 		_samplesDecoded += res;
@@ -94,6 +94,9 @@ public:
 
 	/**
 	 * Return the mixer's internal mutex so that audio players can use it.
+	 *
+	 * The mixer outputs silence rather than wait while it is held, so it
+	 * should only be held briefly.
 	 */
 	virtual Common::Mutex &mutex() = 0;
 
@@ -345,6 +348,24 @@ public:
 	 * @return The number of samples processed at each audio callback.
 	 */
 	virtual uint getOutputBufSize() const = 0;
+
+	/** Timing statistics of the audio output, see getOutputStats(). */
+	struct OutputStats {
+		uint32 callbacks;   ///< Number of buffers mixed so far.
+		uint32 underruns;   ///< Number of buffers which were requested too late or took too long to mix.
+		uint32 bufferTime;  ///< Duration of the last buffer, in microseconds.
+		uint32 lastMixTime; ///< Time spent mixing the last buffer, in microseconds.
+		uint32 maxMixTime;  ///< Longest time spent mixing a buffer since the last reset, in microseconds.
+	};
+
+	/**
+	 * Return the timing statistics of the audio callback, which are used to
+	 * detect audio dropouts.
+	 */
+	virtual void getOutputStats(OutputStats &stats) const = 0;
+
+	/** Reset the counters and the peak returned by getOutputStats(). */
+	virtual void resetOutputStats() = 0;
 };
 
 /** @} */
@@ -23,8 +23,12 @@
 #define AUDIO_MIXER_INTERN_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
+#include "common/atomic.h"
 #include "common/mutex.h"
+#include "common/spscqueue.h"
 #include "audio/mixer.h"
+#include "audio/rate.h"
 
 namespace Audio {
 
@@ -61,31 +65,141 @@ private:
 		NUM_CHANNELS = 32
 	};
 
+	/**
+	 * Protects the channels and their streams. It is held by mixCallback(),
+	 * so game threads only take it for operations which need to be
+	 * synchronous, like starting and stopping sounds. mixCallback() never
+	 * waits for it, and outputs silence while a game thread holds it.
+	 */
 	Common::Mutex _mutex;
 
 	const uint _sampleRate;
 	const bool _stereo;
-	const uint _outBufSize;
-	bool _mixerReady;
+	Common::Atomic<uint> _outBufSize;
+	Common::Atomic<bool> _mixerReady;
 	uint32 _handleSeed;
 
 	struct SoundTypeSettings {
 		SoundTypeSettings() : mute(false), volume(kMaxMixerVolume) {}
 
-		bool mute;
-		int volume;
+		Common::Atomic<bool> mute;
+		Common::Atomic<int> volume;
 	};
 
 	SoundTypeSettings _soundTypeSettings[4];
 	Channel *_channels[NUM_CHANNELS];
 
+	/**
+	 * Channel control request, queued by the game threads and applied by
+	 * the next mixCallback().
+	 */
+	struct Command {
+		enum Type {
+			kSetVolume,
+			kSetBalance,
+			kSetRate,
+			kResetRate,
+			kPauseAll,
+			kPauseID,
+			kPauseHandle,
+			kUpdateSoundType
+		};
+
+		Type type;
+		uint32 target; ///< Sound handle, sound ID or sound type, depending on the type.
+		int32 value;
+		uint32 time;   ///< Time of the request, for pausing.
+	};
+
+	Common::SPSCQueue<Command, 256> _commands;
+	/** Serializes the game threads pushing into _commands. Never take _mutex while holding it. */
+	Common::Mutex _commandMutex;
+
+	/**
+	 * Copy of the channel state answering the queries, so that those
+	 * don't need _mutex.
+	 *
+	 * The identity and timing fields are only written while holding _mutex.
+	 * Writers make the sequence number odd while they update them; readers
+	 * retry if it was odd or has changed. The requested settings are written
+	 * by the control functions, while holding _commandMutex, and take effect
+	 * once the corresponding command is applied.
+	 */
+	struct ChannelState {
+		ChannelState() : sequence(0), handle(0xffffffff), id(-1), type(0), nativeRate(0), samplesConsumed(0), mixerTimeStamp(0),
+		                 pauseStartTime(0), pauseTime(0), paused(false), volume(0), balance(0), rate(0) {}
+
+		Common::Atomic<uint32> sequence;
+
+		Common::Atomic<uint32> handle; ///< Handle of the channel, or an invalid handle if the slot is empty.
+		Common::Atomic<int> id;
+		Common::Atomic<int> type;
+		Common::Atomic<uint32> nativeRate;
+
+		Common::Atomic<uint32> samplesConsumed;
+		Common::Atomic<uint32> mixerTimeStamp;
+		Common::Atomic<uint32> pauseStartTime;
+		Common::Atomic<uint32> pauseTime;
+		Common::Atomic<bool> paused;
+
+		Common::Atomic<int> volume;
+		Common::Atomic<int> balance;
+		Common::Atomic<uint32> rate;
+
+		void beginWrite() {
+			sequence.storeRelaxed(sequence.loadRelaxed() + 1);
+			Common::atomicFence();
+		}
+
+		void endWrite() {
+			sequence.store(sequence.loadRelaxed() + 1);
+		}
+
+		uint32 beginRead() const {
+			uint32 seq;
+			while ((seq = sequence.load()) & 1)
+				;
+			return seq;
+		}
+
+		bool endRead(uint32 seq) const {
+			Common::atomicFence();
+			return sequence.loadRelaxed() == seq;
+		}
+	};
+
+	ChannelState _channelStates[NUM_CHANNELS];
+
+	RateConverterQuality _rateConverterQuality;
+	SincFilterCache *_sincFilterCache;
+
+	bool _parallelMixing;
+	/** Separate buffer for each channel mixed in parallel. */
+	Common::Array<int32> _parallelBuffers;
+	/** 32-bit bus the channels are mixed into, before it is clamped to the output. */
+	Common::Array<int32> _mixBus;
+
+	/**
+	 * Output timing, written by mixCallback() and read by other threads.
+	 * @see getOutputStats()
+	 */
+	Common::Atomic<uint32> _statCallbacks;
+	Common::Atomic<uint32> _statUnderruns;
+	Common::Atomic<uint32> _statBufferTime;
+	Common::Atomic<uint32> _statLastMixTime;
+	Common::Atomic<uint32> _statMaxMixTime;
+	/** Time mixCallback() was last entered, or 0 before the first call. */
+	uint64 _lastCallbackTime;
+	/** Audio produced minus time passed since the first callback, in microseconds. */
+	int64 _timeBalance;
+
 
 public:
 
 	MixerImpl(uint sampleRate, bool stereo = true, uint outBufSize = 0);
 	~MixerImpl();
 
-	virtual bool isReady() const { Common::StackLock lock(_mutex); return _mixerReady; }
+	virtual bool isReady() const { return _mixerReady.load(); }
 
 	virtual Common::Mutex &mutex() { return _mutex; }
 
@@ -136,8 +250,42 @@ public:
 	virtual bool getOutputStereo() const;
 	virtual uint getOutputBufSize() const;
 
+	/** Update the size returned by getOutputBufSize(), after the backend reconfigured its output. */
+	void setOutputBufSize(uint outBufSize);
+
+	virtual void getOutputStats(OutputStats &stats) const;
+	virtual void resetOutputStats();
+
 protected:
 	void insertChannel(SoundHandle *handle, Channel *chan);
+	void deleteChannel(int index);
+
+private:
+	/**
+	 * Update the state of the given slot from its channel. Requires _mutex,
+	 * and also _commandMutex for newly inserted channels.
+	 */
+	void publishChannel(int index, bool inserted = false);
+
+	/**
+	 * Queue a command. If the queue is full, this waits for the mixer and
+	 * applies the command immediately.
+	 */
+	void pushCommand(const Command &command);
+	/** Create the filter bank for a rate change on the calling thread, if the converters need one. */
+	void prepareFilterBank(uint32 rate);
+	/** Apply all queued commands. Requires _mutex. */
+	void processCommands();
+	void applyCommand(const Command &command);
+
+	/**
+	 * Mix the given channels on the job system and add them to the
+	 * mix bus. Requires _mutex.
+	 */
+	int mixParallel(int32 *bus, uint len, const int *channels, int numChannels, uint32 time);
+	/** Update the output statistics for a buffer of @p frames frames. */
+	void updateOutputStats(uint64 start, uint64 end, uint frames);
+	static void mixChannelRange(uint begin, uint end, void *refCon);
 
 public:
 	/**
@@ -157,6 +305,22 @@ public:
 	 * their audio system has been completed.
 	 */
 	void setReady(bool ready);
+
+	/**
+	 * Set the resampling algorithm used for channels which are started
+	 * afterwards. The default is kRateConverterLinear.
+	 */
+	void setRateConverterQuality(RateConverterQuality quality);
+
+	/**
+	 * Enable or disable decoding and resampling channels in parallel, using
+	 * the job system from OSystem::getJobSystem(). The output is identical
+	 * to the one of sequential mixing. The default is off.
+	 *
+	 * This requires the streams of different channels not to share any state,
+	 * as they are read concurrently.
+	 */
+	void setParallelMixing(bool enable);
 };
 
 /** @} */
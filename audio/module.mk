@@ -7,6 +7,7 @@ MODULE_OBJS := \
 	casio.o \
 	chip.o \
 	cms.o \
+	decoded_sample_cache.o \
 	fmopl.o \
 	mac_plugin.o \
 	mididrv.o \
@@ -23,7 +24,10 @@ MODULE_OBJS := \
 	mt32gm.o \
 	musicplugin.o \
 	null.o \
+	prebuffer.o \
 	rate.o \
+	rate_sinc.o \
+	render_ahead.o \
 	timestamp.o \
 	decoders/3do.o \
 	decoders/aac.o \
@@ -132,5 +136,14 @@ MODULE_OBJS += \
 	soundfont/vab/vab.o
 endif
 
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	rate-neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	rate-sse2.o
+endif
+
 # Include common rules
 include $(srcdir)/rules.mk
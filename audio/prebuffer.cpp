@@ -0,0 +1,175 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "audio/prebuffer.h"
+#include "audio/audiostream.h"
+
+#include "common/array.h"
+#include "common/jobs.h"
+#include "common/mutex.h"
+#include "common/ptr.h"
+#include "common/system.h"
+
+namespace Audio {
+
+/**
+ * State shared with the decoding job. Whoever of the job and the stream is
+ * done last deletes it, so that neither has to wait for the other.
+ */
+struct PrebufferState {
+	PrebufferState(AudioStream *p) : parent(p), decoded(0), done(false), released(false) {}
+
+	Common::ScopedPtr<AudioStream> parent;
+	Common::Array<int16> buffer;
+	uint decoded; ///< Number of samples in buffer, written by the job.
+
+	Common::Mutex mutex;
+	bool done;     ///< Set by the job once it has finished decoding.
+	bool released; ///< Set by the stream when it is deleted before that.
+};
+
+class PrebufferedAudioStream : public AudioStream {
+public:
+	PrebufferedAudioStream(AudioStream *parent, uint ms);
+	~PrebufferedAudioStream() override;
+
+	int readBuffer(int16 *buffer, const int numSamples) override;
+	bool isStereo() const override { return _stereo; }
+	int getRate() const override { return _rate; }
+	bool endOfData() const override;
+	bool endOfStream() const override;
+
+private:
+	static void decodeJob(void *refCon);
+	bool isDecodingDone() const;
+
+	PrebufferState *_state;
+	const bool _stereo;
+	const int _rate;
+
+	uint _pos;
+	mutable bool _decodingDone; ///< Only accessed by the thread reading the stream.
+};
+
+PrebufferedAudioStream::PrebufferedAudioStream(AudioStream *parent, uint ms) :
+	_state(new PrebufferState(parent)), _stereo(parent->isStereo()), _rate(parent->getRate()),
+	_pos(0), _decodingDone(false) {
+
+	const uint channels = _stereo ? 2 : 1;
+	_state->buffer.resize((uint)((uint64)_rate * ms / 1000) * channels);
+
+	g_system->getJobSystem()->submit(decodeJob, _state);
+}
+
+PrebufferedAudioStream::~PrebufferedAudioStream() {
+	// Streams are often deleted by the mixer, which must not wait for the
+	// job. In that case the job deletes the state once it is done.
+	{
+		Common::StackLock lock(_state->mutex);
+		if (!_state->done) {
+			_state->released = true;
+			return;
+		}
+	}
+
+	delete _state;
+}
+
+void PrebufferedAudioStream::decodeJob(void *refCon) {
+	PrebufferState *state = static_cast<PrebufferState *>(refCon);
+
+	if (!state->buffer.empty()) {
+		const int samples = state->parent->readBuffer(state->buffer.begin(), state->buffer.size());
+		state->decoded = MAX(samples, 0);
+	}
+
+	bool released;
+	{
+		Common::StackLock lock(state->mutex);
+		state->done = true;
+		released = state->released;
+	}
+
+	if (released)
+		delete state;
+}
+
+bool PrebufferedAudioStream::isDecodingDone() const {
+	if (!_decodingDone) {
+		Common::StackLock lock(_state->mutex);
+		_decodingDone = _state->done;
+	}
+
+	return _decodingDone;
+}
+
+int PrebufferedAudioStream::readBuffer(int16 *buffer, const int numSamples) {
+	// Reads come from the mixer thread, which must not block. Until the
+	// job is done, the sound simply starts a little later.
+	if (!isDecodingDone())
+		return 0;
+
+	int samples = MIN<int>(numSamples, _state->decoded - _pos);
+	if (samples > 0) {
+		memcpy(buffer, &_state->buffer[_pos], samples * sizeof(int16));
+		_pos += samples;
+	} else {
+		samples = 0;
+	}
+
+	if (samples < numSamples) {
+		// Drop the prebuffered samples once they have been played
+		if (!_state->buffer.empty())
+			_state->buffer.clear();
+
+		const int read = _state->parent->readBuffer(buffer + samples, numSamples - samples);
+		if (read < 0)
+			return samples ? samples : read;
+		samples += read;
+	}
+
+	return samples;
+}
+
+bool PrebufferedAudioStream::endOfData() const {
+	// The parent must not be accessed while the job is decoding it
+	if (!isDecodingDone())
+		return false;
+
+	return _pos >= _state->decoded && _state->parent->endOfData();
+}
+
+bool PrebufferedAudioStream::endOfStream() const {
+	if (!isDecodingDone())
+		return false;
+
+	return _pos >= _state->decoded && _state->parent->endOfStream();
+}
+
+AudioStream *makePrebufferedStream(AudioStream *stream, uint ms) {
+	if (!stream || !ms)
+		return stream;
+
+	return new PrebufferedAudioStream(stream, ms);
+}
+
+} // End of namespace Audio
@@ -0,0 +1,54 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef AUDIO_PREBUFFER_H
+#define AUDIO_PREBUFFER_H
+
+#include "common/types.h"
+
+namespace Audio {
+
+class AudioStream;
+
+/**
+ * Start decoding the first @p ms milliseconds of a stream on the backend's
+ * job system, and return a stream playing the decoded samples followed by
+ * the rest of the source.
+ *
+ * This is meant for compressed speech and similar sounds, where decoding
+ * the first frames delays the start of playback. Engines which know the
+ * next sound in advance can create the stream early, so it is ready when it
+ * is played. The source must not be accessed by anybody else afterwards.
+ *
+ * Reads never wait for the prebuffering job. While it is still running,
+ * they return no samples, so playback starts once it is done. Without worker
+ * threads, the samples are decoded right away.
+ *
+ * @param stream The stream to prebuffer. It is always disposed of by the
+ *               returned stream.
+ * @param ms     Duration to decode ahead, in milliseconds.
+ */
+AudioStream *makePrebufferedStream(AudioStream *stream, uint ms);
+
+} // End of namespace Audio
+
+#endif
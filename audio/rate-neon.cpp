@@ -0,0 +1,129 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "audio/mixer.h"
+#include "audio/rate_intern.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Audio {
+
+STATIC_ASSERT(Mixer::kMaxMixerVolume == 256, Volume_scaling_assumes_8_bit_shift);
+
+static inline int32x4_t neon_scaleVolumeWide(int16x4_t in, int16x4_t vol) {
+	int32x4_t product = vmull_s16(in, vol);
+	// Round towards zero, like the division in the generic code does
+	product = vaddq_s32(product, vandq_s32(vshrq_n_s32(product, 31), vdupq_n_s32(Mixer::kMaxMixerVolume - 1)));
+	return vshrq_n_s32(product, 8);
+}
+
+static inline int16x4_t neon_scaleVolume(int16x4_t in, int16x4_t vol) {
+	return vqmovn_s32(neon_scaleVolumeWide(in, vol));
+}
+
+void mixStereoNEON(st_sample_t *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR) {
+	const int16 volumes[4] = { (int16)volL, (int16)volR, (int16)volL, (int16)volR };
+	const int16x4_t vol = vld1_s16(volumes);
+
+	for (; numFrames >= 4; numFrames -= 4) {
+		int16x8_t in = vld1q_s16(src);
+		int16x8_t scaled = vcombine_s16(neon_scaleVolume(vget_low_s16(in), vol),
+		                                neon_scaleVolume(vget_high_s16(in), vol));
+
+		vst1q_s16(dst, vqaddq_s16(vld1q_s16(dst), scaled));
+
+		dst += 8;
+		src += 8;
+	}
+
+	mixStereoGeneric(dst, src, numFrames, volL, volR);
+}
+
+void mixStereoBusNEON(int32 *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR) {
+	const int16 volumes[4] = { (int16)volL, (int16)volR, (int16)volL, (int16)volR };
+	const int16x4_t vol = vld1_s16(volumes);
+
+	for (; numFrames >= 4; numFrames -= 4) {
+		int16x8_t in = vld1q_s16(src);
+
+		vst1q_s32(dst, vaddq_s32(vld1q_s32(dst), neon_scaleVolumeWide(vget_low_s16(in), vol)));
+		vst1q_s32(dst + 4, vaddq_s32(vld1q_s32(dst + 4), neon_scaleVolumeWide(vget_high_s16(in), vol)));
+
+		dst += 8;
+		src += 8;
+	}
+
+	mixStereoBusGeneric(dst, src, numFrames, volL, volR);
+}
+
+void clampMixBusNEON(int16 *dst, const int32 *src, uint count) {
+	for (; count >= 8; count -= 8) {
+		vst1q_s16(dst, vcombine_s16(vqmovn_s32(vld1q_s32(src)), vqmovn_s32(vld1q_s32(src + 4))));
+
+		dst += 8;
+		src += 8;
+	}
+
+	clampMixBusGeneric(dst, src, count);
+}
+
+int32 dotProductNEON(const int16 *a, const int16 *b, uint count) {
+	int32x4_t sum = vdupq_n_s32(0);
+
+	for (uint i = 0; i < count; i += 8) {
+		int16x8_t va = vld1q_s16(a + i);
+		int16x8_t vb = vld1q_s16(b + i);
+		sum = vmlal_s16(sum, vget_low_s16(va), vget_low_s16(vb));
+		sum = vmlal_s16(sum, vget_high_s16(va), vget_high_s16(vb));
+	}
+
+	int32x2_t pair = vadd_s32(vget_low_s32(sum), vget_high_s32(sum));
+	return vget_lane_s32(vpadd_s32(pair, pair), 0);
+}
+
+} // End of namespace Audio
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
@@ -0,0 +1,132 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_SSE2
+
+#include "audio/mixer.h"
+#include "audio/rate_intern.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Audio {
+
+STATIC_ASSERT(Mixer::kMaxMixerVolume == 256, Volume_scaling_assumes_8_bit_shift);
+
+static FORCEINLINE __m128i sse2_scaleVolume(__m128i product) {
+	// Round towards zero, like the division in the generic code does
+	product = _mm_add_epi32(product, _mm_and_si128(_mm_srai_epi32(product, 31), _mm_set1_epi32(Mixer::kMaxMixerVolume - 1)));
+	return _mm_srai_epi32(product, 8);
+}
+
+void mixStereoSSE2(st_sample_t *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR) {
+	const __m128i vol = _mm_set_epi16(volR, volL, volR, volL, volR, volL, volR, volL);
+
+	for (; numFrames >= 4; numFrames -= 4) {
+		__m128i in = _mm_loadu_si128((const __m128i *)src);
+		__m128i lo = _mm_mullo_epi16(in, vol);
+		__m128i hi = _mm_mulhi_epi16(in, vol);
+
+		__m128i scaled = _mm_packs_epi32(sse2_scaleVolume(_mm_unpacklo_epi16(lo, hi)),
+		                                 sse2_scaleVolume(_mm_unpackhi_epi16(lo, hi)));
+
+		__m128i out = _mm_loadu_si128((const __m128i *)dst);
+		_mm_storeu_si128((__m128i *)dst, _mm_adds_epi16(out, scaled));
+
+		dst += 8;
+		src += 8;
+	}
+
+	mixStereoGeneric(dst, src, numFrames, volL, volR);
+}
+
+void mixStereoBusSSE2(int32 *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR) {
+	const __m128i vol = _mm_set_epi16(volR, volL, volR, volL, volR, volL, volR, volL);
+
+	for (; numFrames >= 4; numFrames -= 4) {
+		__m128i in = _mm_loadu_si128((const __m128i *)src);
+		__m128i lo = _mm_mullo_epi16(in, vol);
+		__m128i hi = _mm_mulhi_epi16(in, vol);
+
+		__m128i out0 = _mm_loadu_si128((const __m128i *)dst);
+		__m128i out1 = _mm_loadu_si128((const __m128i *)(dst + 4));
+		_mm_storeu_si128((__m128i *)dst, _mm_add_epi32(out0, sse2_scaleVolume(_mm_unpacklo_epi16(lo, hi))));
+		_mm_storeu_si128((__m128i *)(dst + 4), _mm_add_epi32(out1, sse2_scaleVolume(_mm_unpackhi_epi16(lo, hi))));
+
+		dst += 8;
+		src += 8;
+	}
+
+	mixStereoBusGeneric(dst, src, numFrames, volL, volR);
+}
+
+void clampMixBusSSE2(int16 *dst, const int32 *src, uint count) {
+	for (; count >= 8; count -= 8) {
+		__m128i lo = _mm_loadu_si128((const __m128i *)src);
+		__m128i hi = _mm_loadu_si128((const __m128i *)(src + 4));
+		_mm_storeu_si128((__m128i *)dst, _mm_packs_epi32(lo, hi));
+
+		dst += 8;
+		src += 8;
+	}
+
+	clampMixBusGeneric(dst, src, count);
+}
+
+int32 dotProductSSE2(const int16 *a, const int16 *b, uint count) {
+	__m128i sum = _mm_setzero_si128();
+
+	for (uint i = 0; i < count; i += 8) {
+		__m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+		__m128i vb = _mm_loadu_si128((const __m128i *)(b + i));
+		sum = _mm_add_epi32(sum, _mm_madd_epi16(va, vb));
+	}
+
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(sum);
+}
+
+} // End of namespace Audio
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
+
+#endif // SCUMMVM_SSE2
@@ -29,24 +29,15 @@
 
 #include "audio/audiostream.h"
 #include "audio/rate.h"
+#include "audio/rate_intern.h"
 #include "audio/mixer.h"
+#include "common/system.h"
 #include "common/util.h"
 
 namespace Audio {
 
-/**
- * The default fractional type in frac.h (with 16 fractional bits) limits
- * the rate conversion code to 65536Hz audio: we need to able to handle
- * 96kHz audio, so we use fewer fractional bits in this code.
- */
-enum {
-	FRAC_BITS_LOW = 15,
-	FRAC_ONE_LOW = (1L << FRAC_BITS_LOW),
-	FRAC_HALF_LOW = (1L << (FRAC_BITS_LOW-1))
-};
-
 template<bool inStereo, bool outStereo, bool reverseStereo>
-class RateConverter_Impl : public RateConverter {
+class RateConverter_Impl : public StagedRateConverter<outStereo, reverseStereo> {
 private:
 	/** Input and output rates */
 	st_rate_t _inRate, _outRate;
@@ -76,16 +67,19 @@ private:
 	/** Current sample(s) in the input stream (left/right channel) */
 	st_sample_t _inCurL, _inCurR;
 
-	int copyConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
-	int simpleConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
-	int interpolateConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
+	int copyConvert(AudioStream &input, st_sample_t *stage, st_size_t numFrames);
+	int simpleConvert(AudioStream &input, st_sample_t *stage, st_size_t numFrames);
+	int interpolateConvert(AudioStream &input, st_sample_t *stage, st_size_t numFrames);
+
+	using StagedRateConverter<outStereo, reverseStereo>::stageFrame;
+
+protected:
+	int convertToStage(AudioStream &input, st_sample_t *stage, st_size_t numFrames) override;
 
 public:
 	RateConverter_Impl(st_rate_t inputRate, st_rate_t outputRate);
 	virtual ~RateConverter_Impl() {}
 
-	int convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) override;
-
 	void setInputRate(st_rate_t inputRate) override { _inRate = inputRate; }
 	void setOutputRate(st_rate_t outputRate) override { _outRate = outputRate; }
 
@@ -96,62 +90,45 @@ public:
 };
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
-	st_sample_t *outStart, *outEnd;
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStream &input, st_sample_t *stage, st_size_t numFrames) {
+	st_sample_t *stageStart, *stageEnd;
 
-	outStart = outBuffer;
-	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
+	stageStart = stage;
+	stageEnd = stage + numFrames * 2;
 
-	while (outBuffer < outEnd) {
+	while (stage < stageEnd) {
 		// Check if we have to refill the buffer
 		if (_bufferSize == 0) {
 			_bufferPos = _buffer;
 			_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
 
 			if (_bufferSize <= 0)
-				return (outBuffer - outStart) / (outStereo ? 2 : 1);
+				return (stage - stageStart) / 2;
 		}
 
-		// Mix the data into the output buffer
+		// Copy the data into the stage buffer
 		st_sample_t inL, inR;
 		inL = *_bufferPos++;
 		inR = (inStereo ? *_bufferPos++ : inL);
 		_bufferSize -= (inStereo ? 2 : 1);
 
-		st_sample_t outL, outR;
-		outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
-		outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
-
-		if (outStereo) {
-			// Output left channel
-			clampedAdd(outBuffer[reverseStereo    ], outL);
-
-			// Output right channel
-			clampedAdd(outBuffer[reverseStereo ^ 1], outR);
-
-			outBuffer += 2;
-		} else {
-			// Output mono channel
-			clampedAdd(outBuffer[0], (outL + outR) / 2);
-
-			outBuffer += 1;
-		}
+		stageFrame(stage, inL, inR);
 	}
 
-	return (outBuffer - outStart) / (outStereo ? 2 : 1);
+	return (stage - stageStart) / 2;
 }
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioStream &input, st_sample_t *stage, st_size_t numFrames) {
 	// How much to increment _outPos by
 	frac_t outPos_inc = _inRate / _outRate;
 
-	st_sample_t *outStart, *outEnd;
+	st_sample_t *stageStart, *stageEnd;
 
-	outStart = outBuffer;
-	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
+	stageStart = stage;
+	stageEnd = stage + numFrames * 2;
 
-	while (outBuffer < outEnd) {
+	while (stage < stageEnd) {
 		// Read enough input samples so that _outPos >= 0
 		do {
 			// Check if we have to refill the buffer
@@ -160,7 +137,7 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioS
 				_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
 
 				if (_bufferSize <= 0)
-					return (outBuffer - outStart) / (outStereo ? 2 : 1);
+					return (stage - stageStart) / 2;
 			}
 
 			_bufferSize -= (inStereo ? 2 : 1);
@@ -178,38 +155,21 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioS
 		// Increment output position
 		_outPos += outPos_inc;
 
-		st_sample_t outL, outR;
-		outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
-		outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
-
-		if (outStereo) {
-			// output left channel
-			clampedAdd(outBuffer[reverseStereo    ], outL);
-
-			// output right channel
-			clampedAdd(outBuffer[reverseStereo ^ 1], outR);
-
-			outBuffer += 2;
-		} else {
-			// output mono channel
-			clampedAdd(outBuffer[0], (outL + outR) / 2);
-
-			outBuffer += 1;
-		}
+		stageFrame(stage, inL, inR);
 	}
-	return (outBuffer - outStart) / (outStereo ? 2 : 1);
+	return (stage - stageStart) / 2;
 }
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(AudioStream &input, st_sample_t *stage, st_size_t numFrames) {
 	// How much to increment _outPosFrac by
 	frac_t outPos_inc = (_inRate << FRAC_BITS_LOW) / _outRate;
 
-	st_sample_t *outStart, *outEnd;
-	outStart = outBuffer;
-	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
+	st_sample_t *stageStart, *stageEnd;
+	stageStart = stage;
+	stageEnd = stage + numFrames * 2;
 
-	while (outBuffer < outEnd) {
+	while (stage < stageEnd) {
 		// Read enough input samples so that _outPosFrac < 0
 		while ((frac_t)FRAC_ONE_LOW <= _outPosFrac) {
 			// Check if we have to refill the buffer
@@ -218,7 +178,7 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(A
 				_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
 
 				if (_bufferSize <= 0)
-					return (outBuffer - outStart) / (outStereo ? 2 : 1);
+					return (stage - stageStart) / 2;
 			}
 
 			_bufferSize -= (inStereo ? 2 : 1);
@@ -234,8 +194,8 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(A
 		}
 
 		// Loop as long as the _outPos trails behind, and as long as there is
-		// still space in the output buffer.
-		while (_outPosFrac < (frac_t)FRAC_ONE_LOW && outBuffer < outEnd) {
+		// still space in the stage buffer.
+		while (_outPosFrac < (frac_t)FRAC_ONE_LOW && stage < stageEnd) {
 			// Interpolate
 			st_sample_t inL, inR;
 			inL = (st_sample_t)(_inLastL + (((_inCurL - _inLastL) * _outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
@@ -243,30 +203,13 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(A
 						(st_sample_t)(_inLastR + (((_inCurR - _inLastR) * _outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW)) :
 						inL);
 
-			st_sample_t outL, outR;
-			outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
-			outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
-
-			if (outStereo) {
-				// Output left channel
-				clampedAdd(outBuffer[reverseStereo    ], outL);
-
-				// Output right channel
-				clampedAdd(outBuffer[reverseStereo ^ 1], outR);
-
-				outBuffer += 2;
-			} else {
-				// Output mono channel
-				clampedAdd(outBuffer[0], (outL + outR) / 2);
-
-				outBuffer += 1;
-			}
+			stageFrame(stage, inL, inR);
 
 			// Increment output position
 			_outPosFrac += outPos_inc;
 		}
 	}
-	return (outBuffer - outStart) / (outStereo ? 2 : 1);
+	return (stage - stageStart) / 2;
 }
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
@@ -283,21 +226,136 @@ RateConverter_Impl<inStereo, outStereo, reverseStereo>::RateConverter_Impl(st_ra
 	_bufferPos(nullptr) {}
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-int RateConverter_Impl<inStereo, outStereo, reverseStereo>::convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::convertToStage(AudioStream &input, st_sample_t *stage, st_size_t numFrames) {
 	assert(input.isStereo() == inStereo);
 
 	if (_inRate == _outRate) {
-		return copyConvert(input, outBuffer, numSamples, volL, volR);
+		return copyConvert(input, stage, numFrames);
 	} else {
 		if ((_inRate % _outRate) == 0 && (_inRate < 65536)) {
-			return simpleConvert(input, outBuffer, numSamples, volL, volR);
+			return simpleConvert(input, stage, numFrames);
 		} else {
-			return interpolateConvert(input, outBuffer, numSamples, volL, volR);
+			return interpolateConvert(input, stage, numFrames);
 		}
 	}
 }
 
-RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo) {
+void mixStereoGeneric(st_sample_t *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR) {
+	for (st_size_t i = 0; i < numFrames; i++) {
+		// Output left channel
+		clampedAdd(dst[0], (src[0] * (int)volL) / Audio::Mixer::kMaxMixerVolume);
+
+		// Output right channel
+		clampedAdd(dst[1], (src[1] * (int)volR) / Audio::Mixer::kMaxMixerVolume);
+
+		dst += 2;
+		src += 2;
+	}
+}
+
+void mixStereoBusGeneric(int32 *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR) {
+	for (st_size_t i = 0; i < numFrames; i++) {
+		dst[0] += (src[0] * (int)volL) / Audio::Mixer::kMaxMixerVolume;
+		dst[1] += (src[1] * (int)volR) / Audio::Mixer::kMaxMixerVolume;
+
+		dst += 2;
+		src += 2;
+	}
+}
+
+void clampMixBusGeneric(int16 *dst, const int32 *src, uint count) {
+	for (uint i = 0; i < count; i++) {
+		const int16 val = (int16)CLIP<int32>(src[i], ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+#ifdef OUTPUT_UNSIGNED_AUDIO
+		dst[i] = val ^ 0x8000;
+#else
+		dst[i] = val;
+#endif
+	}
+}
+
+int32 dotProductGeneric(const int16 *a, const int16 *b, uint count) {
+	int32 sum = 0;
+	for (uint i = 0; i < count; i++)
+		sum += a[i] * b[i];
+	return sum;
+}
+
+// Initialize these to nullptr at the start
+StereoMixFunc g_stereoMixFunc = nullptr;
+StereoBusMixFunc g_stereoBusMixFunc = nullptr;
+MixBusClampFunc g_mixBusClampFunc = nullptr;
+DotProductFunc g_dotProductFunc = nullptr;
+
+StereoMixFunc getStereoMixFunc() {
+	// If no function has been selected yet, detect and select
+	if (!g_stereoMixFunc) {
+		g_stereoMixFunc = mixStereoGeneric;
+#ifndef OUTPUT_UNSIGNED_AUDIO
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) g_stereoMixFunc = mixStereoNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) g_stereoMixFunc = mixStereoSSE2;
+#endif
+#endif
+	}
+
+	return g_stereoMixFunc;
+}
+
+StereoBusMixFunc getStereoBusMixFunc() {
+	// If no function has been selected yet, detect and select
+	if (!g_stereoBusMixFunc) {
+		g_stereoBusMixFunc = mixStereoBusGeneric;
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) g_stereoBusMixFunc = mixStereoBusNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) g_stereoBusMixFunc = mixStereoBusSSE2;
+#endif
+	}
+
+	return g_stereoBusMixFunc;
+}
+
+MixBusClampFunc getMixBusClampFunc() {
+	// If no function has been selected yet, detect and select
+	if (!g_mixBusClampFunc) {
+		g_mixBusClampFunc = clampMixBusGeneric;
+#ifndef OUTPUT_UNSIGNED_AUDIO
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) g_mixBusClampFunc = clampMixBusNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) g_mixBusClampFunc = clampMixBusSSE2;
+#endif
+#endif
+	}
+
+	return g_mixBusClampFunc;
+}
+
+DotProductFunc getDotProductFunc() {
+	// If no function has been selected yet, detect and select
+	if (!g_dotProductFunc) {
+		g_dotProductFunc = dotProductGeneric;
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) g_dotProductFunc = dotProductNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) g_dotProductFunc = dotProductSSE2;
+#endif
+	}
+
+	return g_dotProductFunc;
+}
+
+RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo,
+                                 RateConverterQuality quality, SincFilterCache *cache) {
+	if (quality == kRateConverterSinc)
+		return makeSincRateConverter(inRate, outRate, inStereo, outStereo, reverseStereo, cache);
+
 	if (inStereo) {
 		if (outStereo) {
 			if (reverseStereo)
@@ -34,6 +34,7 @@ namespace Audio {
  */
 
 class AudioStream;
+class SincFilterCache;
 
 typedef int16 st_sample_t;
 typedef uint16 st_volume_t;
@@ -90,6 +91,13 @@ public:
 	 */
 	virtual int convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) = 0;
 
+	/**
+	 * Convert the provided AudioStream like above, but add the scaled samples
+	 * to a 32-bit mix bus without clamping them. Used by the mixer, which
+	 * clamps the bus only once after all channels were mixed into it.
+	 */
+	virtual int convert(AudioStream &input, int32 *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) = 0;
+
 	virtual void setInputRate(st_rate_t inputRate) = 0;
 	virtual void setOutputRate(st_rate_t outputRate) = 0;
 
@@ -104,7 +112,24 @@ public:
 	virtual bool needsDraining() const = 0;
 };
 
-RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo);
+/**
+ * Resampling algorithms offered by makeRateConverter(). Converting between
+ * equal rates is always a plain copy.
+ */
+enum RateConverterQuality {
+	kRateConverterLinear, /*!< Linear interpolation, or dropping samples for integer downsampling ratios. */
+	kRateConverterSinc    /*!< Polyphase windowed-sinc filter. */
+};
+
+/**
+ * Create a rate converter.
+ *
+ * @param cache  Optional cache of filter tables to be shared with other
+ *               converters, see SincFilterCache. Only used for
+ *               kRateConverterSinc.
+ */
+RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo,
+                                 RateConverterQuality quality = kRateConverterLinear, SincFilterCache *cache = nullptr);
 
 /** @} */
 } // End of namespace Audio
@@ -0,0 +1,281 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_RATE_INTERN_H
+#define AUDIO_RATE_INTERN_H
+
+#include "audio/mixer.h"
+#include "audio/rate.h"
+#include "common/array.h"
+#include "common/atomic.h"
+#include "common/util.h"
+
+namespace Audio {
+
+/**
+ * The default fractional type in frac.h (with 16 fractional bits) limits
+ * the rate conversion code to 65536Hz audio: we need to able to handle
+ * 96kHz audio, so we use fewer fractional bits in this code.
+ */
+enum {
+	FRAC_BITS_LOW = 15,
+	FRAC_ONE_LOW = (1L << FRAC_BITS_LOW),
+	FRAC_HALF_LOW = (1L << (FRAC_BITS_LOW-1))
+};
+
+/**
+ * Scale interleaved stereo frames by the given channel volumes (in the range
+ * 0 - Mixer::kMaxMixerVolume) and add them to @p dst with saturation.
+ */
+typedef void (*StereoMixFunc)(st_sample_t *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR);
+
+/**
+ * Scale interleaved stereo frames like StereoMixFunc, but add them to the
+ * 32-bit mix bus @p dst without saturation.
+ */
+typedef void (*StereoBusMixFunc)(int32 *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR);
+
+/**
+ * Clamp @p count samples of a 32-bit mix bus to 16 bits and store them in
+ * @p dst, in the output format of the mixer.
+ */
+typedef void (*MixBusClampFunc)(int16 *dst, const int32 *src, uint count);
+
+/**
+ * Return the sum of the products of @p count elements of @p a and @p b.
+ * @p count must be a multiple of 8.
+ */
+typedef int32 (*DotProductFunc)(const int16 *a, const int16 *b, uint count);
+
+void mixStereoGeneric(st_sample_t *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR);
+void mixStereoBusGeneric(int32 *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR);
+void clampMixBusGeneric(int16 *dst, const int32 *src, uint count);
+int32 dotProductGeneric(const int16 *a, const int16 *b, uint count);
+#ifdef SCUMMVM_NEON
+void mixStereoNEON(st_sample_t *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR);
+void mixStereoBusNEON(int32 *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR);
+void clampMixBusNEON(int16 *dst, const int32 *src, uint count);
+int32 dotProductNEON(const int16 *a, const int16 *b, uint count);
+#endif
+#ifdef SCUMMVM_SSE2
+void mixStereoSSE2(st_sample_t *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR);
+void mixStereoBusSSE2(int32 *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR);
+void clampMixBusSSE2(int16 *dst, const int32 *src, uint count);
+int32 dotProductSSE2(const int16 *a, const int16 *b, uint count);
+#endif
+
+/** The routines picked by the getters below, or nullptr if none were picked yet. */
+extern StereoMixFunc g_stereoMixFunc;
+extern StereoBusMixFunc g_stereoBusMixFunc;
+extern MixBusClampFunc g_mixBusClampFunc;
+extern DotProductFunc g_dotProductFunc;
+
+/**
+ * Return the fastest mixing routine supported by the CPU. The SIMD variants
+ * produce exactly the same output as mixStereoGeneric().
+ */
+StereoMixFunc getStereoMixFunc();
+
+/**
+ * Return the fastest routines for mixing into and clamping the 32-bit mix
+ * bus. The SIMD variants produce exactly the same output as the generic ones.
+ */
+StereoBusMixFunc getStereoBusMixFunc();
+MixBusClampFunc getMixBusClampFunc();
+
+/** Return the fastest dot product routine supported by the CPU. */
+DotProductFunc getDotProductFunc();
+
+/**
+ * Base class of the rate converters.
+ *
+ * Subclasses convert the input into a stage buffer of unscaled stereo frames,
+ * which is then scaled by the channel volume and mixed into the output
+ * buffer in one go.
+ */
+template<bool outStereo, bool reverseStereo>
+class StagedRateConverter : public RateConverter {
+public:
+	enum {
+		/**
+		 * Number of sample frames that are converted in one go, before they
+		 * are scaled by the channel volume and mixed into the output buffer.
+		 */
+		kStageFrames = 256
+	};
+
+	StagedRateConverter() : _mixFunc(getStereoMixFunc()), _busMixFunc(getStereoBusMixFunc()) {}
+
+	int convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) override {
+		return convertAndMix(input, outBuffer, numSamples, volL, volR);
+	}
+
+	int convert(AudioStream &input, int32 *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) override {
+		return convertAndMix(input, outBuffer, numSamples, volL, volR);
+	}
+
+protected:
+	/**
+	 * Write up to @p numFrames unscaled stereo frames into @p stage, using
+	 * stageFrame().
+	 *
+	 * @return The number of frames written.
+	 */
+	virtual int convertToStage(AudioStream &input, st_sample_t *stage, st_size_t numFrames) = 0;
+
+	/** Append a frame to the stage buffer, with the channels in output order. */
+	static inline void stageFrame(st_sample_t *&stage, st_sample_t inL, st_sample_t inR) {
+		stage[reverseStereo    ] = inL;
+		stage[reverseStereo ^ 1] = inR;
+		stage += 2;
+	}
+
+private:
+	template<typename T>
+	int convertAndMix(AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+		st_sample_t stage[kStageFrames * 2];
+		st_size_t written = 0;
+
+		while (written < numSamples) {
+			const st_size_t numFrames = MIN<st_size_t>(numSamples - written, kStageFrames);
+			const int converted = convertToStage(input, stage, numFrames);
+
+			mixFrames(outBuffer + written * (outStereo ? 2 : 1), stage, converted, volL, volR);
+			written += converted;
+
+			if ((st_size_t)converted < numFrames)
+				break;
+		}
+
+		return written;
+	}
+
+	void mixFrames(st_sample_t *outBuffer, const st_sample_t *stage, st_size_t numFrames, st_volume_t volL, st_volume_t volR) {
+		if (outStereo) {
+			// The stage buffer already has the channels in output order
+			if (reverseStereo)
+				_mixFunc(outBuffer, stage, numFrames, volR, volL);
+			else
+				_mixFunc(outBuffer, stage, numFrames, volL, volR);
+			return;
+		}
+
+		for (st_size_t i = 0; i < numFrames; i++) {
+			// Output mono channel
+			clampedAdd(outBuffer[i], mixMono(stage, volL, volR));
+			stage += 2;
+		}
+	}
+
+	void mixFrames(int32 *outBuffer, const st_sample_t *stage, st_size_t numFrames, st_volume_t volL, st_volume_t volR) {
+		if (outStereo) {
+			if (reverseStereo)
+				_busMixFunc(outBuffer, stage, numFrames, volR, volL);
+			else
+				_busMixFunc(outBuffer, stage, numFrames, volL, volR);
+			return;
+		}
+
+		for (st_size_t i = 0; i < numFrames; i++) {
+			outBuffer[i] += mixMono(stage, volL, volR);
+			stage += 2;
+		}
+	}
+
+	static inline int mixMono(const st_sample_t *frame, st_volume_t volL, st_volume_t volR) {
+		st_sample_t outL, outR;
+		outL = (frame[0] * (int)volL) / Audio::Mixer::kMaxMixerVolume;
+		outR = (frame[1] * (int)volR) / Audio::Mixer::kMaxMixerVolume;
+		return (outL + outR) / 2;
+	}
+
+	/** Routine scaling and mixing the converted frames into stereo output */
+	StereoMixFunc _mixFunc;
+	StereoBusMixFunc _busMixFunc;
+};
+
+/**
+ * Windowed-sinc low-pass filter for one pair of input and output rates, split
+ * into kPhases polyphase components of getTaps() coefficients each.
+ */
+class SincFilterBank {
+public:
+	enum {
+		kPhaseBits = 8,
+		kPhases = 1 << kPhaseBits,
+		/** The coefficients are fixed point values with this many fractional bits. */
+		kCoeffBits = 14,
+		/** Number of taps when upsampling; downsampling needs more. */
+		kBaseTaps = 16,
+		kMaxTaps = 128
+	};
+
+	SincFilterBank(st_rate_t inRate, st_rate_t outRate);
+
+	st_rate_t getInputRate() const { return _inRate; }
+	st_rate_t getOutputRate() const { return _outRate; }
+
+	/** Return the number of taps per phase, which is a multiple of 8. */
+	uint getTaps() const { return _taps; }
+
+	/** Return the coefficients for the given phase, with the oldest sample's one first. */
+	const int16 *getPhase(uint phase) const { return &_coeffs[phase * _taps]; }
+
+private:
+	st_rate_t _inRate, _outRate;
+	uint _taps;
+	Common::Array<int16> _coeffs;
+};
+
+/**
+ * Owner of the filter banks used by the windowed-sinc converters. Converters
+ * created with the same cache share the banks for identical rate pairs.
+ *
+ * The cache can be used from several threads at once. Banks are only added,
+ * so looking up one which exists never waits or allocates. Computing a bank is
+ * expensive, so MixerImpl gets the banks needed for rate changes before
+ * queuing them to the audio thread. The cache must outlive all of its
+ * converters.
+ */
+class SincFilterCache {
+public:
+	SincFilterCache() : _head(nullptr) {}
+	~SincFilterCache();
+
+	/** Return the bank for the given rates, creating it if necessary. */
+	const SincFilterBank *getFilterBank(st_rate_t inRate, st_rate_t outRate);
+
+private:
+	struct Entry {
+		SincFilterBank *bank;
+		Entry *next;
+	};
+
+	static const SincFilterBank *findFilterBank(const Entry *entry, st_rate_t inRate, st_rate_t outRate);
+
+	Common::Atomic<Entry *> _head;
+};
+
+RateConverter *makeSincRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo, SincFilterCache *cache);
+
+} // End of namespace Audio
+
+#endif
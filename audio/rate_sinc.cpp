@@ -0,0 +1,349 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/audiostream.h"
+#include "audio/rate_intern.h"
+
+namespace Audio {
+
+namespace {
+
+/** Zeroth order modified Bessel function of the first kind. */
+double besselI0(double x) {
+	double sum = 1.0, term = 1.0;
+	for (int k = 1; k < 32; k++) {
+		term *= (x / (2 * k)) * (x / (2 * k));
+		sum += term;
+		if (term < sum * 1e-12)
+			break;
+	}
+	return sum;
+}
+
+double sinc(double x) {
+	if (fabs(x) < 1e-9)
+		return 1.0;
+	return sin(M_PI * x) / (M_PI * x);
+}
+
+} // End of anonymous namespace
+
+SincFilterBank::SincFilterBank(st_rate_t inRate, st_rate_t outRate) : _inRate(inRate), _outRate(outRate) {
+	// Cutoff frequency relative to the input Nyquist frequency. It has to
+	// move below the output one when downsampling, and stays a bit below
+	// the limit to leave room for the transition band.
+	double cutoff = 0.9;
+	if (outRate < inRate)
+		cutoff *= (double)outRate / inRate;
+
+	// A lower cutoff needs a proportionally longer filter for the same
+	// transition band steepness
+	_taps = (uint)ceil(kBaseTaps * 0.9 / cutoff);
+	_taps = MIN<uint>((_taps + 7) & ~7, kMaxTaps);
+
+	const double beta = 7.0;
+	const double halfWidth = _taps / 2.0;
+	const double windowScale = 1.0 / besselI0(beta);
+	const int one = 1 << kCoeffBits;
+
+	_coeffs.resize(kPhases * _taps);
+
+	double weights[kMaxTaps];
+	for (uint phase = 0; phase < kPhases; phase++) {
+		const double frac = (double)phase / kPhases;
+
+		// Tap k is applied to the input sample at distance k - taps / 2 + 1 - frac
+		// from the output position
+		double sum = 0.0;
+		for (uint k = 0; k < _taps; k++) {
+			const double dist = k - halfWidth + 1 - frac;
+			const double ratio = dist / halfWidth;
+			const double window = (ratio <= -1.0 || ratio >= 1.0) ? 0.0 : besselI0(beta * sqrt(1.0 - ratio * ratio)) * windowScale;
+			weights[k] = cutoff * sinc(cutoff * dist) * window;
+			sum += weights[k];
+		}
+
+		// Normalize for unity gain, and put the rounding error into the
+		// biggest coefficient
+		int16 *coeffs = &_coeffs[phase * _taps];
+		int total = 0;
+		uint peak = 0;
+		for (uint k = 0; k < _taps; k++) {
+			coeffs[k] = (int16)floor(weights[k] / sum * one + 0.5);
+			total += coeffs[k];
+			if (coeffs[k] > coeffs[peak])
+				peak = k;
+		}
+		coeffs[peak] += one - total;
+	}
+}
+
+SincFilterCache::~SincFilterCache() {
+	Entry *entry = _head.load();
+	while (entry) {
+		Entry *next = entry->next;
+		delete entry->bank;
+		delete entry;
+		entry = next;
+	}
+}
+
+const SincFilterBank *SincFilterCache::findFilterBank(const Entry *entry, st_rate_t inRate, st_rate_t outRate) {
+	for (; entry; entry = entry->next) {
+		if (entry->bank->getInputRate() == inRate && entry->bank->getOutputRate() == outRate)
+			return entry->bank;
+	}
+	return nullptr;
+}
+
+const SincFilterBank *SincFilterCache::getFilterBank(st_rate_t inRate, st_rate_t outRate) {
+	Entry *head = _head.load();
+	const SincFilterBank *found = findFilterBank(head, inRate, outRate);
+	if (found)
+		return found;
+
+	Entry *entry = new Entry;
+	entry->bank = new SincFilterBank(inRate, outRate);
+
+	// Another thread may have added the same bank in the meantime
+	do {
+		found = findFilterBank(head, inRate, outRate);
+		if (found) {
+			delete entry->bank;
+			delete entry;
+			return found;
+		}
+		entry->next = head;
+	} while (!_head.compareExchange(head, entry));
+
+	return entry->bank;
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+class SincRateConverter : public StagedRateConverter<outStereo, reverseStereo> {
+private:
+	/** Input and output rates */
+	st_rate_t _inRate, _outRate;
+
+	/** Cache to get the filter banks from, if any */
+	SincFilterCache *_cache;
+
+	/** The filter bank for the current rates */
+	const SincFilterBank *_bank;
+
+	/** The filter bank owned by this converter, used if there is no cache */
+	SincFilterBank *_ownBank;
+
+	/** Number of taps of the current filter bank */
+	uint _taps;
+
+	DotProductFunc _dotProduct;
+
+	/** The intermediate input cache */
+	st_sample_t _buffer[512];
+
+	/** Current position inside the buffer */
+	const st_sample_t *_bufferPos;
+
+	/** Size of data currently loaded into the buffer */
+	int _bufferSize;
+
+	/** Fractional position of the output stream in input stream unit */
+	frac_t _outPosFrac;
+
+	/**
+	 * Last input samples of each channel. Every sample is stored twice, _taps
+	 * entries apart, so that the most recent _taps samples are always
+	 * available in order starting at _historyPos.
+	 */
+	int16 _history[2][SincFilterBank::kMaxTaps * 2];
+	uint _historyPos;
+
+	using StagedRateConverter<outStereo, reverseStereo>::stageFrame;
+
+	void updateFilterBank();
+
+	int copyConvert(AudioStream &input, st_sample_t *stage, st_size_t numFrames);
+
+	inline st_sample_t filter(int channel, const int16 *coeffs) const {
+		int32 sum = _dotProduct(&_history[channel][_historyPos], coeffs, _taps);
+		sum = (sum + (1 << (SincFilterBank::kCoeffBits - 1))) >> SincFilterBank::kCoeffBits;
+		return (st_sample_t)CLIP<int32>(sum, ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+	}
+
+protected:
+	int convertToStage(AudioStream &input, st_sample_t *stage, st_size_t numFrames) override;
+
+public:
+	SincRateConverter(st_rate_t inputRate, st_rate_t outputRate, SincFilterCache *cache);
+	~SincRateConverter() override { delete _ownBank; }
+
+	void setInputRate(st_rate_t inputRate) override { _inRate = inputRate; updateFilterBank(); }
+	void setOutputRate(st_rate_t outputRate) override { _outRate = outputRate; updateFilterBank(); }
+
+	st_rate_t getInputRate() const override { return _inRate; }
+	st_rate_t getOutputRate() const override { return _outRate; }
+
+	bool needsDraining() const override { return _bufferSize != 0; }
+};
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+SincRateConverter<inStereo, outStereo, reverseStereo>::SincRateConverter(st_rate_t inputRate, st_rate_t outputRate, SincFilterCache *cache) :
+	_inRate(inputRate),
+	_outRate(outputRate),
+	_cache(cache),
+	_bank(nullptr),
+	_ownBank(nullptr),
+	_taps(0),
+	_dotProduct(getDotProductFunc()),
+	_bufferPos(nullptr),
+	_bufferSize(0),
+	_outPosFrac(FRAC_ONE_LOW),
+	_historyPos(0) {
+	memset(_history, 0, sizeof(_history));
+	updateFilterBank();
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+void SincRateConverter<inStereo, outStereo, reverseStereo>::updateFilterBank() {
+	// The bank is fetched whenever the rates change, so that converting
+	// never touches the cache. Equal rates are simply copied.
+	if (_inRate == _outRate)
+		return;
+	if (_bank && _bank->getInputRate() == _inRate && _bank->getOutputRate() == _outRate)
+		return;
+
+	if (_cache) {
+		_bank = _cache->getFilterBank(_inRate, _outRate);
+	} else {
+		delete _ownBank;
+		_ownBank = new SincFilterBank(_inRate, _outRate);
+		_bank = _ownBank;
+	}
+
+	if (_bank->getTaps() != _taps) {
+		_taps = _bank->getTaps();
+		memset(_history, 0, sizeof(_history));
+		_historyPos = 0;
+	}
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+int SincRateConverter<inStereo, outStereo, reverseStereo>::copyConvert(AudioStream &input, st_sample_t *stage, st_size_t numFrames) {
+	st_sample_t *stageStart, *stageEnd;
+	stageStart = stage;
+	stageEnd = stage + numFrames * 2;
+
+	while (stage < stageEnd) {
+		// Check if we have to refill the buffer
+		if (_bufferSize == 0) {
+			_bufferPos = _buffer;
+			_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
+
+			if (_bufferSize <= 0)
+				return (stage - stageStart) / 2;
+		}
+
+		st_sample_t inL, inR;
+		inL = *_bufferPos++;
+		inR = (inStereo ? *_bufferPos++ : inL);
+		_bufferSize -= (inStereo ? 2 : 1);
+
+		stageFrame(stage, inL, inR);
+	}
+
+	return (stage - stageStart) / 2;
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+int SincRateConverter<inStereo, outStereo, reverseStereo>::convertToStage(AudioStream &input, st_sample_t *stage, st_size_t numFrames) {
+	assert(input.isStereo() == inStereo);
+
+	if (_inRate == _outRate)
+		return copyConvert(input, stage, numFrames);
+
+	assert(_bank);
+
+	// How much to increment _outPosFrac by
+	const frac_t outPosInc = (_inRate << FRAC_BITS_LOW) / _outRate;
+
+	st_sample_t *stageStart, *stageEnd;
+	stageStart = stage;
+	stageEnd = stage + numFrames * 2;
+
+	while (stage < stageEnd) {
+		// Read enough input samples so that _outPosFrac < FRAC_ONE_LOW
+		while ((frac_t)FRAC_ONE_LOW <= _outPosFrac) {
+			// Check if we have to refill the buffer
+			if (_bufferSize == 0) {
+				_bufferPos = _buffer;
+				_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
+
+				if (_bufferSize <= 0)
+					return (stage - stageStart) / 2;
+			}
+
+			_bufferSize -= (inStereo ? 2 : 1);
+
+			_history[0][_historyPos] = _history[0][_historyPos + _taps] = *_bufferPos++;
+			if (inStereo)
+				_history[1][_historyPos] = _history[1][_historyPos + _taps] = *_bufferPos++;
+
+			_historyPos = (_historyPos + 1) % _taps;
+			_outPosFrac -= FRAC_ONE_LOW;
+		}
+
+		// Loop as long as the _outPos trails behind, and as long as there is
+		// still space in the stage buffer.
+		while (_outPosFrac < (frac_t)FRAC_ONE_LOW && stage < stageEnd) {
+			const int16 *coeffs = _bank->getPhase(_outPosFrac >> (FRAC_BITS_LOW - SincFilterBank::kPhaseBits));
+
+			st_sample_t inL, inR;
+			inL = filter(0, coeffs);
+			inR = (inStereo ? filter(1, coeffs) : inL);
+
+			stageFrame(stage, inL, inR);
+
+			// Increment output position
+			_outPosFrac += outPosInc;
+		}
+	}
+	return (stage - stageStart) / 2;
+}
+
+RateConverter *makeSincRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo, SincFilterCache *cache) {
+	if (inStereo) {
+		if (outStereo) {
+			if (reverseStereo)
+				return new SincRateConverter<true, true, true>(inRate, outRate, cache);
+			else
+				return new SincRateConverter<true, true, false>(inRate, outRate, cache);
+		} else
+			return new SincRateConverter<true, false, false>(inRate, outRate, cache);
+	} else {
+		if (outStereo) {
+			return new SincRateConverter<false, true, false>(inRate, outRate, cache);
+		} else
+			return new SincRateConverter<false, false, false>(inRate, outRate, cache);
+	}
+}
+
+} // End of namespace Audio
@@ -0,0 +1,210 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "audio/render_ahead.h"
+
+#include "common/algorithm.h"
+#include "common/array.h"
+#include "common/atomic.h"
+#include "common/jobs.h"
+#include "common/system.h"
+#include "common/util.h"
+
+namespace Audio {
+
+namespace {
+// Frames rendered by the worker in one go. Small enough that events sent by
+// the game never wait long for the source's mutex.
+const uint32 kChunkFrames = 256;
+} // End of anonymous namespace
+
+/**
+ * State shared by the stream and its render jobs. Each of them holds a
+ * reference, and the last one to let go deletes it, so that the stream
+ * never has to wait for a job.
+ */
+struct RenderAheadState {
+	RenderAheadState(AudioStream *s, DisposeAfterUse::Flag dispose, Common::JobGroup *group) :
+		source(s), disposeAfterUse(dispose), renderGroup(group), chunkSamples(0),
+		readPos(0), writePos(0), sourceEnded(0), stopping(0), rendering(0), jobQueued(0), refCount(1) {}
+
+	~RenderAheadState() {
+		if (disposeAfterUse == DisposeAfterUse::YES)
+			delete source;
+	}
+
+	void release() {
+		if (refCount.fetchSub(1) == 1)
+			delete this;
+	}
+
+	// The source is rendered by whoever sets the flag, either a job or
+	// readBuffer(). Neither ever waits for the other.
+	bool tryBeginRender() {
+		uint32 expected = 0;
+		return rendering.compareExchange(expected, 1);
+	}
+
+	void endRender() { rendering.store(0); }
+
+	static void renderJob(void *refCon);
+	void renderAhead();
+	int renderSource(int16 *buffer, int numSamples);
+	int consume(int16 *buffer, int numSamples);
+
+	AudioStream *source;
+	const DisposeAfterUse::Flag disposeAfterUse;
+	Common::JobGroup *renderGroup;
+
+	Common::Array<int16> ring;
+	uint32 chunkSamples;
+	Common::Atomic<uint32> readPos;  ///< Only written by readBuffer().
+	Common::Atomic<uint32> writePos; ///< Only written while rendering is set.
+	Common::Atomic<uint32> sourceEnded;
+	Common::Atomic<uint32> stopping;
+	Common::Atomic<uint32> rendering;
+	Common::Atomic<uint32> jobQueued;
+	Common::Atomic<uint32> refCount;
+};
+
+void RenderAheadState::renderJob(void *refCon) {
+	RenderAheadState *state = static_cast<RenderAheadState *>(refCon);
+	state->renderAhead();
+	state->jobQueued.store(0);
+	state->release();
+}
+
+void RenderAheadState::renderAhead() {
+	const uint32 size = ring.size();
+
+	// If readBuffer() is rendering, it schedules another job once it is done
+	while (!stopping.load() && tryBeginRender()) {
+		const uint32 pos = writePos.loadRelaxed();
+		const uint32 offset = pos & (size - 1);
+		const uint32 space = size - (pos - readPos.load());
+
+		// Only render full chunks, which never straddle the end of the ring
+		// since its size is a multiple of the chunk size
+		if (sourceEnded.load() || space < chunkSamples) {
+			endRender();
+			break;
+		}
+
+		const int rendered = renderSource(&ring[offset], chunkSamples);
+		writePos.store(pos + rendered);
+		endRender();
+	}
+}
+
+int RenderAheadState::renderSource(int16 *buffer, int numSamples) {
+	const int samples = source->readBuffer(buffer, numSamples);
+	if (samples < numSamples) {
+		sourceEnded.store(1);
+		return MAX(samples, 0);
+	}
+	return samples;
+}
+
+int RenderAheadState::consume(int16 *buffer, int numSamples) {
+	const uint32 size = ring.size();
+	const uint32 pos = readPos.loadRelaxed();
+	const uint32 available = writePos.load() - pos;
+	const uint32 samples = MIN<uint32>(available, numSamples);
+
+	const uint32 offset = pos & (size - 1);
+	const uint32 first = MIN(samples, size - offset);
+	memcpy(buffer, &ring[offset], first * sizeof(int16));
+	memcpy(buffer + first, &ring[0], (samples - first) * sizeof(int16));
+
+	readPos.store(pos + samples);
+	return samples;
+}
+
+RenderAheadStream::RenderAheadStream(AudioStream *source, uint ms, DisposeAfterUse::Flag disposeAfterUse, Common::JobGroup *renderGroup) :
+	_state(new RenderAheadState(source, disposeAfterUse, renderGroup)), _stereo(source->isStereo()), _rate(source->getRate()) {
+
+	const uint32 channels = _stereo ? 2 : 1;
+	_state->chunkSamples = kChunkFrames * channels;
+
+	// The positions wrap around at 2^32, so the ring size has to divide that
+	uint32 samples = (uint32)((uint64)_rate * ms / 1000) * channels;
+	samples = MAX<uint32>(samples, _state->chunkSamples * 2);
+	_state->ring.resize(Common::nextHigher2(samples));
+
+	scheduleRender();
+}
+
+RenderAheadStream::~RenderAheadStream() {
+	// The stream is usually deleted by the mixer, which must not wait for a
+	// job; a job still running deletes the state once it is done
+	_state->stopping.store(1);
+	_state->release();
+}
+
+int RenderAheadStream::readBuffer(int16 *buffer, const int numSamples) {
+	int samples = _state->consume(buffer, numSamples);
+
+	if (samples < numSamples && !_state->sourceEnded.load()) {
+		if (_state->tryBeginRender()) {
+			// The worker fell behind, render whatever is missing right here
+			samples += _state->consume(buffer + samples, numSamples - samples);
+			if (samples < numSamples)
+				samples += _state->renderSource(buffer + samples, numSamples - samples);
+			_state->endRender();
+		} else {
+			// The worker is rendering a chunk. Waiting for it could deadlock,
+			// as the source's timer callbacks may need the mixer mutex.
+			memset(buffer + samples, 0, (numSamples - samples) * sizeof(int16));
+			samples = numSamples;
+		}
+	}
+
+	scheduleRender();
+	return samples;
+}
+
+bool RenderAheadStream::endOfData() const {
+	return _state->sourceEnded.load() && _state->writePos.load() == _state->readPos.loadRelaxed();
+}
+
+void RenderAheadStream::scheduleRender() {
+	// Refill once half of the ring has been played, with one job at a time
+	const uint32 queued = _state->writePos.load() - _state->readPos.loadRelaxed();
+	if (queued > _state->ring.size() / 2 || _state->sourceEnded.load())
+		return;
+
+	uint32 expected = 0;
+	if (!_state->jobQueued.compareExchange(expected, 1))
+		return;
+
+	_state->refCount.fetchAdd(1);
+	g_system->getJobSystem()->submit(RenderAheadState::renderJob, _state, _state->renderGroup);
+}
+
+AudioStream *makeRenderAheadStream(AudioStream *source, uint ms, DisposeAfterUse::Flag disposeAfterUse, Common::JobGroup *renderGroup) {
+	if (!ms || g_system->getJobSystem()->getThreadCount() < 2)
+		return nullptr;
+
+	return new RenderAheadStream(source, ms, disposeAfterUse, renderGroup);
+}
+
+} // End of namespace Audio
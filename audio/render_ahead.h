@@ -0,0 +1,106 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef AUDIO_RENDER_AHEAD_H
+#define AUDIO_RENDER_AHEAD_H
+
+#include "common/types.h"
+
+#include "audio/audiostream.h"
+
+namespace Common {
+class JobGroup;
+}
+
+namespace Audio {
+
+struct RenderAheadState;
+
+/**
+ * Audio stream which renders its source ahead of playback on the backend's
+ * job system.
+ *
+ * This is meant for expensive synthesizer emulations, which would otherwise
+ * render synchronously in the mixer callback. A worker keeps a ring buffer
+ * filled by calling the source's readBuffer(), in chunks of a few hundred
+ * samples, and readBuffer() only copies from it. If the worker falls
+ * behind, the missing samples are rendered synchronously. If the worker is
+ * rendering a chunk at that very moment, they are silent instead, since
+ * readBuffer() never waits for the worker.
+ *
+ * Sources which invoke timer callbacks from their readBuffer(), like
+ * EmulatedChip and MidiDriver_Emulated, keep their sample accurate timing,
+ * since the callbacks still run at the right positions of the rendered
+ * output. They do, however, run on a worker thread without the mixer mutex
+ * being held. Events sent from other threads are applied at the current
+ * render position, thus become audible up to the buffered duration later.
+ *
+ * The source must serialize its readBuffer() with any calls made to it from
+ * other threads, just as it has to when played directly by the mixer.
+ *
+ * Neither reading nor deleting the stream waits for the worker, because the
+ * worker may be waiting for the mixer mutex in a timer callback of the
+ * source while the mixer thread holds it. A source which is not disposed of
+ * with the stream must therefore only be deleted once the render group
+ * passed to makeRenderAheadStream() is done, which has to be waited for
+ * without holding the mixer mutex, e.g. after Mixer::stopHandle().
+ */
+class RenderAheadStream : public AudioStream {
+public:
+	/**
+	 * @param source    The stream to render ahead.
+	 * @param ms        Duration to buffer ahead, in milliseconds.
+	 * @param disposeAfterUse Whether to delete the source with this stream.
+	 * @param renderGroup The group to add the render jobs to, or nullptr.
+	 */
+	RenderAheadStream(AudioStream *source, uint ms, DisposeAfterUse::Flag disposeAfterUse, Common::JobGroup *renderGroup);
+	~RenderAheadStream() override;
+
+	int readBuffer(int16 *buffer, const int numSamples) override;
+	bool isStereo() const override { return _stereo; }
+	int getRate() const override { return _rate; }
+	bool endOfData() const override;
+
+private:
+	void scheduleRender();
+
+	/** Shared with the render jobs, and deleted by whoever is done last. */
+	RenderAheadState *_state;
+	const bool _stereo;
+	const int _rate;
+};
+
+/**
+ * Create a RenderAheadStream for the given source.
+ *
+ * @param renderGroup The group to add the render jobs to. It must be waited
+ *                    for before a source which is not disposed of with the
+ *                    stream is deleted, see RenderAheadStream.
+ * @return The new stream, or nullptr if @p ms is 0 or the job system can't
+ *         run jobs concurrently to the mixer. In that case the source is not
+ *         disposed of, regardless of @p disposeAfterUse.
+ */
+AudioStream *makeRenderAheadStream(AudioStream *source, uint ms, DisposeAfterUse::Flag disposeAfterUse, Common::JobGroup *renderGroup = nullptr);
+
+} // End of namespace Audio
+
+#endif
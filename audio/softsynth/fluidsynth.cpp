@@ -40,6 +40,8 @@
 #include "common/scummsys.h"
 #include "common/config-manager.h"
 #include "common/error.h"
+#include "common/fs.h"
+#include "common/jobs.h"
 #include "common/stream.h"
 #include "common/system.h"
 #include "common/archive.h"
@@ -101,6 +103,10 @@ private:
 	int _soundFont;
 	int _outputRate;
 	Common::SeekableReadStream *_engineSoundFontData;
+#ifdef FS_HAS_SOUNDFONT_CACHE
+	CachedSoundFont *_cachedSoundFont;
+	bool _cachedSoundFontAdded;
+#endif
 
 protected:
 	// Because GCC complains about casting from const to non-const...
@@ -134,6 +140,10 @@ public:
 
 MidiDriver_FluidSynth::MidiDriver_FluidSynth(Audio::Mixer *mixer)
 	: MidiDriver_Emulated(mixer), _engineSoundFontData(nullptr) {
+#ifdef FS_HAS_SOUNDFONT_CACHE
+	_cachedSoundFont = nullptr;
+	_cachedSoundFontAdded = false;
+#endif
 
 	for (int i = 0; i < ARRAYSIZE(_midiChannels); i++) {
 		_midiChannels[i].init(this, i);
@@ -280,6 +290,105 @@ static long SoundFontMemLoader_tell(void *handle) {
 
 #endif // USE_FLUIDLITE
 
+#if !defined(USE_FLUIDLITE) && FS_API_VERSION >= 0x0200
+
+#define FS_HAS_SOUNDFONT_CACHE
+
+// Parsing a large SoundFont takes seconds, so the most recently used one is
+// kept loaded, and shared by all drivers using it. This way reopening the
+// driver, e.g. when starting the next game, reuses the parsed font.
+//
+// The font is loaded into a synth of its own, which owns it, by a job on the
+// job system. Drivers add it to their synth once that job is done, so opening
+// the driver doesn't wait for it. FluidSynth resets the programs of all
+// channels when a font is added, so the music plays with the right
+// instruments from that point on.
+struct CachedSoundFont {
+	Common::String path;
+	Common::String fileName; ///< Name passed to FluidSynth, may refer to a mapped stream.
+	fluid_settings_t *settings;
+	fluid_synth_t *synth;
+	fluid_sfont_t *font; ///< Set by the load job, nullptr if loading failed.
+	Common::JobGroup loadGroup;
+	uint users;
+};
+
+static CachedSoundFont *g_cachedSoundFont = nullptr;
+
+static void loadCachedSoundFont(void *refCon) {
+	CachedSoundFont *entry = (CachedSoundFont *)refCon;
+
+	const int id = fluid_synth_sfload(entry->synth, entry->fileName.c_str(), 0);
+	entry->font = (id != FLUID_FAILED) ? fluid_synth_get_sfont_by_id(entry->synth, id) : nullptr;
+}
+
+static void freeCachedSoundFont() {
+	if (!g_cachedSoundFont)
+		return;
+
+	g_system->getJobSystem()->wait(g_cachedSoundFont->loadGroup);
+	delete_fluid_synth(g_cachedSoundFont->synth);
+	delete_fluid_settings(g_cachedSoundFont->settings);
+	delete g_cachedSoundFont;
+	g_cachedSoundFont = nullptr;
+}
+
+/**
+ * Return the cache entry for the given SoundFont, starting to load it if it
+ * isn't cached yet. Returns nullptr if another SoundFont is cached and still
+ * in use, in which case the caller has to load its SoundFont itself.
+ */
+static CachedSoundFont *acquireCachedSoundFont(const Common::String &path) {
+	if (g_cachedSoundFont && g_cachedSoundFont->path != path) {
+		if (g_cachedSoundFont->users)
+			return nullptr;
+		freeCachedSoundFont();
+	}
+
+	if (!g_cachedSoundFont) {
+		CachedSoundFont *entry = new CachedSoundFont();
+		entry->path = path;
+		entry->settings = new_fluid_settings();
+		// The mapped file is closed after loading, so samples can't be
+		// loaded on demand
+		fluid_settings_setint(entry->settings, "synth.dynamic-sample-loading", 0);
+		entry->synth = new_fluid_synth(entry->settings);
+		entry->font = nullptr;
+		entry->users = 0;
+
+		// Read the file through a memory mapping, if the backend supports
+		// them. The loader deletes the stream once it is done.
+		entry->fileName = path;
+		Common::SeekableReadStream *mapped = Common::FSNode(Common::Path(path, Common::Path::kNativeSeparator)).createMappedReadStream();
+		if (mapped) {
+			fluid_sfloader_t *mappedLoader = new_fluid_defsfloader(entry->settings);
+			fluid_sfloader_set_callbacks(mappedLoader,
+										 SoundFontMemLoader_open,
+										 SoundFontMemLoader_read,
+										 SoundFontMemLoader_seek,
+										 SoundFontMemLoader_tell,
+										 SoundFontMemLoader_close);
+			fluid_synth_add_sfloader(entry->synth, mappedLoader);
+
+			entry->fileName = Common::String::format("&%p", (void *)mapped);
+		}
+
+		g_cachedSoundFont = entry;
+
+		g_system->getJobSystem()->submit(loadCachedSoundFont, entry, &entry->loadGroup);
+	}
+
+	g_cachedSoundFont->users++;
+	return g_cachedSoundFont;
+}
+
+static void releaseCachedSoundFont(CachedSoundFont *entry) {
+	assert(entry == g_cachedSoundFont && entry->users > 0);
+	entry->users--;
+}
+
+#endif // FS_HAS_SOUNDFONT_CACHE
+
 Common::Path MidiDriver_FluidSynth::getSoundFontPath(bool *exists) {
 	Common::Path path = ConfMan.getPath("soundfont");
 	if (path.empty()) {
@@ -375,6 +484,10 @@ int MidiDriver_FluidSynth::open() {
 
 	setNum("synth.gain", gain);
 	setNum("synth.sample-rate", _outputRate);
+#ifndef USE_FLUIDLITE
+	// FluidSynth renders the voices on this many threads of its own
+	setInt("synth.cpu-cores", MAX(ConfMan.getInt("fluidsynth_misc_cpu_cores"), 1));
+#endif
 
 	_synth = new_fluid_synth(_settings);
 
@@ -489,12 +602,31 @@ int MidiDriver_FluidSynth::open() {
 #endif // FS_HAS_STREAM_SUPPORT
 	{
 //		soundfont = ConfMan.get("soundfont");
-		soundfont = getSoundFontPath().toString(Common::Path::kNativeSeparator);
+		bool exists = false;
+		soundfont = getSoundFontPath(&exists).toString(Common::Path::kNativeSeparator);
+
+#ifdef FS_HAS_SOUNDFONT_CACHE
+		// Missing files are loaded directly, to report the error below
+		if (exists)
+			_cachedSoundFont = acquireCachedSoundFont(soundfont);
+#endif
 	}
 
-	_soundFont = fluid_synth_sfload(_synth, soundfont.c_str(), 1);
+#ifdef FS_HAS_SOUNDFONT_CACHE
+	if (_cachedSoundFont) {
+		_soundFont = -1;
+		_cachedSoundFontAdded = false;
+	} else
+#endif
+	{
+		_soundFont = fluid_synth_sfload(_synth, soundfont.c_str(), 1);
+	}
 
+#ifdef FS_HAS_SOUNDFONT_CACHE
+	if (_soundFont == -1 && !_cachedSoundFont) {
+#else
 	if (_soundFont == -1) {
+#endif
 		GUI::MessageDialog dialog(Common::U32String::format(_("FluidSynth: Failed loading custom SoundFont '%s'. Music is off."), soundfont.c_str()));
 		dialog.runModal();
 		return MERR_DEVICE_NOT_AVAILABLE;
@@ -517,6 +649,16 @@ void MidiDriver_FluidSynth::close() {
 	if (_soundFont != -1)
 		fluid_synth_sfunload(_synth, _soundFont, 1);
 
+#ifdef FS_HAS_SOUNDFONT_CACHE
+	if (_cachedSoundFont) {
+		// The font is owned by the cache, so only detach it
+		if (_cachedSoundFontAdded && _cachedSoundFont->font)
+			fluid_synth_remove_sfont(_synth, _cachedSoundFont->font);
+		releaseCachedSoundFont(_cachedSoundFont);
+		_cachedSoundFont = nullptr;
+	}
+#endif
+
 	delete_fluid_synth(_synth);
 	delete_fluid_settings(_settings);
 }
@@ -577,6 +719,16 @@ MidiChannel *MidiDriver_FluidSynth::getPercussionChannel() {
 }
 
 void MidiDriver_FluidSynth::generateSamples(int16 *data, int len) {
+#ifdef FS_HAS_SOUNDFONT_CACHE
+	if (_cachedSoundFont && !_cachedSoundFontAdded && _cachedSoundFont->loadGroup.isDone()) {
+		if (_cachedSoundFont->font)
+			fluid_synth_add_sfont(_synth, _cachedSoundFont->font);
+		else
+			warning("FluidSynth: Failed loading SoundFont '%s'", _cachedSoundFont->path.c_str());
+		_cachedSoundFontAdded = true;
+	}
+#endif
+
 	fluid_synth_write_s16(_synth, len, data, 0, 2, data, 1, 2);
 }
 
@@ -596,6 +748,12 @@ bool MidiDriver_FluidSynth::acceptsSoundFontData() {
 
 class FluidSynthMusicPlugin : public MusicPluginObject {
 public:
+#ifdef FS_HAS_SOUNDFONT_CACHE
+	~FluidSynthMusicPlugin() override {
+		freeCachedSoundFont();
+	}
+#endif
+
 	const char *getName() const override {
 		return "FluidSynth";
 	}
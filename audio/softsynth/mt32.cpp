@@ -27,12 +27,14 @@
 #include "audio/softsynth/emumidi.h"
 #include "audio/musicplugin.h"
 #include "audio/mpu401.h"
+#include "audio/render_ahead.h"
 
 #include "common/config-manager.h"
 #include "common/debug.h"
 #include "common/error.h"
 #include "common/events.h"
 #include "common/file.h"
+#include "common/jobs.h"
 #include "common/system.h"
 #include "common/util.h"
 #include "common/archive.h"
@@ -115,6 +117,7 @@ private:
 	MT32Emu::ScummVMReportHandler _reportHandler;
 	byte *_controlData, *_pcmData;
 	Common::Mutex _mutex;
+	Common::JobGroup _renderAheadGroup;
 
 	int _outputRate;
 
@@ -220,7 +223,16 @@ int MidiDriver_MT32::open() {
 
 	MidiDriver_Emulated::open();
 
-	_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
+	// Rendering ahead keeps MIDI events sent from the timer callback sample
+	// accurate, since the callback is still invoked from readBuffer().
+	Audio::AudioStream *renderAhead = nullptr;
+	if (ConfMan.hasKey("synth_render_ahead"))
+		renderAhead = Audio::makeRenderAheadStream(this, ConfMan.getInt("synth_render_ahead"), DisposeAfterUse::NO, &_renderAheadGroup);
+
+	if (renderAhead)
+		_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, renderAhead, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::YES, true);
+	else
+		_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
 
 	return 0;
 }
@@ -272,6 +284,9 @@ void MidiDriver_MT32::close() {
 	setTimerCallback(nullptr, nullptr);
 	// Detach the mixer callback handler
 	_mixer->stopHandle(_mixerSoundHandle);
+	// Outside of the mixer mutex, which the timer callback of a render ahead
+	// job may be waiting for
+	g_system->getJobSystem()->wait(_renderAheadGroup);
 
 	Common::StackLock lock(_mutex);
 	_service.closeSynth();
@@ -297,56 +297,43 @@ void OPL::dualWrite(uint8 index, uint8 reg, uint8 val) {
 	_emulator->WriteReg(fullReg, val);
 }
 
+static void convertSamples(int16 *dst, const int32 *src, uint count) {
+	// Kept branch free so the compiler can vectorize the clamp. Several loud
+	// channels can sum past the 16-bit range; wrapping would be audible.
+	for (uint i = 0; i < count; ++i)
+		dst[i] = (int16)CLIP<int32>(src[i], -32768, 32767);
+}
+
 void OPL::generateSamples(int16 *buffer, int length) {
-	const uint bufferLength = 512;
-	int32 tempBuffer[bufferLength * 2];
+	if (length <= 0)
+		return;
 
 	if (isStereo()) {
 		// For stereo OPL cards, we divide the sample count by 2,
 		// to match stereo AudioStream behavior.
-		length >>= 1;
-		if (_emulator->opl3Active) {
-			// DUAL_OPL2 or OPL3 in OPL3 mode (stereo)
-			while (length > 0) {
-				const uint readSamples = MIN<uint>(length, bufferLength);
-				const uint readSamples2 = (readSamples << 1);
-
-				_emulator->GenerateBlock3(readSamples, tempBuffer);
+		const uint frames = length >> 1;
 
-				for (uint i = 0; i < readSamples2; ++i)
-					buffer[i] = tempBuffer[i];
+		if (_tempBuffer.size() < frames * 2)
+			_tempBuffer.resize(frames * 2);
 
-				buffer += readSamples2;
-				length -= readSamples;
-			}
+		if (_emulator->opl3Active) {
+			// DUAL_OPL2 or OPL3 in OPL3 mode (stereo)
+			_emulator->GenerateBlock3(frames, _tempBuffer.begin());
+			convertSamples(buffer, _tempBuffer.begin(), frames * 2);
 		} else {
 			// OPL3 (stereo) in OPL2 compatibility mode (mono)
-			while (length > 0) {
-				const uint readSamples = MIN<uint>(length, bufferLength);
-				const uint readSamples2 = (readSamples << 1);
-
-				_emulator->GenerateBlock2(readSamples, tempBuffer);
-
-				for (uint i = 0, j = 0; i < readSamples; ++i, j += 2)
-					buffer[j] = buffer[j + 1] = tempBuffer[i];
-
-				buffer += readSamples2;
-				length -= readSamples;
-			}
+			_emulator->GenerateBlock2(frames, _tempBuffer.begin());
+			const int32 *src = _tempBuffer.begin();
+			for (uint i = 0; i < frames; ++i)
+				buffer[i * 2] = buffer[i * 2 + 1] = (int16)CLIP<int32>(src[i], -32768, 32767);
 		}
 	} else {
 		// OPL2
-		while (length > 0) {
-			const uint readSamples = MIN<uint>(length, bufferLength << 1);
-
-			_emulator->GenerateBlock2(readSamples, tempBuffer);
+		if (_tempBuffer.size() < (uint)length)
+			_tempBuffer.resize(length);
 
-			for (uint i = 0; i < readSamples; ++i)
-				buffer[i] = tempBuffer[i];
-
-			buffer += readSamples;
-			length -= readSamples;
-		}
+		_emulator->GenerateBlock2(length, _tempBuffer.begin());
+		convertSamples(buffer, _tempBuffer.begin(), length);
 	}
 }
 
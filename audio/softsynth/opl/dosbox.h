@@ -32,6 +32,7 @@
 #ifndef DISABLE_DOSBOX_OPL
 
 #include "audio/fmopl.h"
+#include "common/array.h"
 
 namespace OPL {
 namespace DOSBox {
@@ -80,6 +81,10 @@ private:
 		uint8 dual[2];
 	} _reg;
 
+	// Scratch buffer holding the emulator's 32-bit output. It grows to the
+	// largest request seen, so a whole mixer period is rendered in one pass.
+	Common::Array<int32> _tempBuffer;
+
 	void free();
 	void dualWrite(uint8 index, uint8 reg, uint8 val);
 public:
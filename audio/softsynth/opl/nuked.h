@@ -187,6 +187,7 @@ public:
 
 protected:
 	void generateSamples(int16 *buffer, int length);
+	bool allowRenderAhead() const { return true; }
 };
 
 }
@@ -21,10 +21,13 @@
 
 #include "backends/audiocd/default/default-audiocd.h"
 #include "audio/audiostream.h"
+#include "audio/decoders/raw.h"
 #include "common/config-manager.h"
 #include "common/file.h"
+#include "common/fs.h"
 #include "common/system.h"
 #include "common/util.h"
+#include "common/formats/cdimage.h"
 #include "common/formats/cue.h"
 
 DefaultAudioCDManager::DefaultAudioCDManager() {
@@ -54,6 +57,7 @@ bool DefaultAudioCDManager::open() {
 void DefaultAudioCDManager::close() {
 	// Only need to stop for emulation
 	stop();
+	_cdImage.reset();
 }
 
 void DefaultAudioCDManager::fillPotentialTrackNames(Common::Array<Common::String> &trackNames, int track) const {
@@ -92,7 +96,32 @@ bool DefaultAudioCDManager::existExtractedCDAudioFiles(uint track) {
 			}
 		}
 	}
-	return false;
+	return openCDImage() && _cdImage->hasAudioTrack(track);
+}
+
+bool DefaultAudioCDManager::openCDImage() {
+	if (!ConfMan.hasKey("cdimage"))
+		return false;
+
+	// A failed attempt leaves an empty image, so it is not repeated
+	if (!_cdImage) {
+		_cdImage.reset(new Common::CDImage());
+		if (!_cdImage->open(Common::FSNode(ConfMan.getPath("cdimage"))))
+			warning("DefaultAudioCDManager: Could not open the CD image");
+	}
+
+	return true;
+}
+
+Audio::SeekableAudioStream *DefaultAudioCDManager::openCDImageTrack(int track) {
+	if (!openCDImage())
+		return nullptr;
+
+	Common::SeekableReadStream *stream = _cdImage->createAudioTrackStream(track);
+	if (!stream)
+		return nullptr;
+
+	return Audio::makeRawStream(stream, 44100, Audio::FLAG_16BITS | Audio::FLAG_STEREO | Audio::FLAG_LITTLE_ENDIAN);
 }
 
 bool DefaultAudioCDManager::play(int track, int numLoops, int startFrame, int duration, bool onlyEmulate,
@@ -116,6 +145,10 @@ bool DefaultAudioCDManager::play(int track, int numLoops, int startFrame, int du
 			stream = Audio::SeekableAudioStream::openStreamFile(Common::Path(*i, '/'));
 		}
 
+		// Then try the track in a CD image
+		if (!stream)
+			stream = openCDImageTrack(track);
+
 		if (stream != nullptr) {
 			Audio::Timestamp start = Audio::Timestamp(0, startFrame, 75);
 			Audio::Timestamp end = duration ? Audio::Timestamp(0, startFrame + duration, 75) : stream->getLength();
@@ -24,11 +24,17 @@
 
 #include "backends/audiocd/audiocd.h"
 #include "audio/mixer.h"
+#include "common/ptr.h"
 
 namespace Common {
+class CDImage;
 class String;
 } // End of namespace Common
 
+namespace Audio {
+class SeekableAudioStream;
+} // End of namespace Audio
+
 /**
  * The default audio cd manager. Implements emulation of audio cd playback.
  */
@@ -55,6 +61,15 @@ public:
 private:
 	void fillPotentialTrackNames(Common::Array<Common::String> &trackNames, int track) const;
 
+	/**
+	 * Open the CD image set with the cdimage config variable, if any
+	 * @return true if the image could be opened
+	 */
+	bool openCDImage();
+	Audio::SeekableAudioStream *openCDImageTrack(int track);
+
+	Common::ScopedPtr<Common::CDImage> _cdImage;
+
 protected:
 	/**
 	 * Open a CD using the cdrom config variable
@@ -59,6 +59,7 @@ void DropboxListDirectoryRequest::start() {
 	Networking::JsonCallback callback = new Common::Callback<DropboxListDirectoryRequest, const Networking::JsonResponse &>(this, &DropboxListDirectoryRequest::responseCallback);
 	Networking::ErrorCallback failureCallback = new Common::Callback<DropboxListDirectoryRequest, const Networking::ErrorResponse &>(this, &DropboxListDirectoryRequest::errorCallback);
 	Networking::CurlJsonRequest *request = new DropboxTokenRefresher(_storage, callback, failureCallback, DROPBOX_API_LIST_FOLDER);
+	request->setJsonReaderCallback(new Common::Callback<DropboxListDirectoryRequest, const Networking::JsonReaderResponse &>(this, &DropboxListDirectoryRequest::responseReaderCallback));
 	request->addHeader("Authorization: Bearer " + _storage->accessToken());
 	request->addHeader("Content-Type: application/json");
 
@@ -129,32 +130,9 @@ void DropboxListDirectoryRequest::responseCallback(const Networking::JsonRespons
 			return;
 		}
 
-		Common::JSONArray items = responseObject.getVal("entries")->asArray();
-		for (uint32 i = 0; i < items.size(); ++i) {
-			if (!Networking::CurlJsonRequest::jsonIsObject(items[i], "DropboxListDirectoryRequest"))
-				continue;
-
-			Common::JSONObject item = items[i]->asObject();
-
-			if (!Networking::CurlJsonRequest::jsonContainsString(item, "path_lower", "DropboxListDirectoryRequest"))
-				continue;
-			if (!Networking::CurlJsonRequest::jsonContainsString(item, ".tag", "DropboxListDirectoryRequest"))
-				continue;
-
-			Common::String path = item.getVal("path_lower")->asString();
-			bool isDirectory = (item.getVal(".tag")->asString() == "folder");
-			uint32 size = 0, timestamp = 0;
-			if (!isDirectory) {
-				if (!Networking::CurlJsonRequest::jsonContainsString(item, "server_modified", "DropboxListDirectoryRequest"))
-					continue;
-				if (!Networking::CurlJsonRequest::jsonContainsIntegerNumber(item, "size", "DropboxListDirectoryRequest"))
-					continue;
-
-				size = item.getVal("size")->asIntegerNumber();
-				timestamp = ISO8601::convertToTimestamp(item.getVal("server_modified")->asString());
-			}
-			_files.push_back(StorageFile(path, size, timestamp, isDirectory));
-		}
+		const Common::JSONArray &items = responseObject.getVal("entries")->asArray();
+		for (uint32 i = 0; i < items.size(); ++i)
+			addEntry(items[i]);
 	}
 
 	bool hasMore = false;
@@ -179,24 +157,134 @@ void DropboxListDirectoryRequest::responseCallback(const Networking::JsonRespons
 			return;
 		}
 
-		Networking::JsonCallback callback = new Common::Callback<DropboxListDirectoryRequest, const Networking::JsonResponse &>(this, &DropboxListDirectoryRequest::responseCallback);
-		Networking::ErrorCallback failureCallback = new Common::Callback<DropboxListDirectoryRequest, const Networking::ErrorResponse &>(this, &DropboxListDirectoryRequest::errorCallback);
-		Networking::CurlJsonRequest *request = new DropboxTokenRefresher(_storage, callback, failureCallback, DROPBOX_API_LIST_FOLDER_CONTINUE);
-		request->addHeader("Authorization: Bearer " + _storage->accessToken());
-		request->addHeader("Content-Type: application/json");
+		continueListing(responseObject.getVal("cursor")->asString());
+	} else {
+		finishListing(_files);
+	}
 
-		Common::JSONObject jsonRequestParameters;
-		jsonRequestParameters.setVal("cursor", new Common::JSONValue(responseObject.getVal("cursor")->asString()));
+	delete json;
+}
 
-		Common::JSONValue value(jsonRequestParameters);
-		request->addPostField(Common::JSON::stringify(&value));
+void DropboxListDirectoryRequest::responseReaderCallback(const Networking::JsonReaderResponse &response) {
+	_workingRequest = nullptr;
+	if (_ignoreCallback)
+		return;
+
+	if (response.request)
+		_date = response.request->date();
 
-		_workingRequest = ConnMan.addRequest(request);
+	Networking::ErrorResponse error(this, "DropboxListDirectoryRequest::responseReaderCallback: unknown error");
+	error.httpResponseCode = 200;
+
+	//the listing is read entry by entry, so that large (recursive) listings are never held as a whole tree
+	Common::JSONReader &reader = *response.value;
+	Common::String key, cursor;
+	bool hasMore = false;
+
+	if (!reader.enterObject()) {
+		error.response = "Passed JSON is not an object!";
+		finishError(error);
+		return;
+	}
+
+	while (reader.nextKey(key)) {
+		if (key == "entries") {
+			if (!reader.enterArray()) {
+				error.response = "\"entries\" found, but that's not an array!";
+				finishError(error);
+				return;
+			}
+
+			while (reader.nextElement()) {
+				Common::JSONValue *item = reader.readValue();
+				if (!item)
+					break;
+				addEntry(item);
+				delete item;
+			}
+		} else if (key == "has_more") {
+			Common::JSONValue *value = reader.readValue();
+			if (value && !value->isBool()) {
+				warning("DropboxListDirectoryRequest: \"has_more\" is not a boolean");
+				error.response = "\"has_more\" is not a boolean!";
+				finishError(error);
+				delete value;
+				return;
+			}
+			hasMore = value && value->asBool();
+			delete value;
+		} else if (key == "cursor" && reader.peekType() == Common::JSONType_String) {
+			reader.readString(cursor);
+		} else if (key == "error" || key == "error_summary") {
+			error.failed = true;
+			error.response = "Dropbox returned error: " + key;
+			finishError(error);
+			return;
+		} else {
+			reader.skipValue();
+		}
+	}
+
+	if (reader.hasError()) {
+		error.response = "Failed to parse JSON!";
+		finishError(error);
+		return;
+	}
+
+	if (hasMore) {
+		if (cursor.empty()) {
+			error.response = "\"has_more\" found, but \"cursor\" is not (or it's not a string)!";
+			finishError(error);
+			return;
+		}
+
+		continueListing(cursor);
 	} else {
 		finishListing(_files);
 	}
+}
 
-	delete json;
+void DropboxListDirectoryRequest::addEntry(const Common::JSONValue *entry) {
+	if (!Networking::CurlJsonRequest::jsonIsObject(entry, "DropboxListDirectoryRequest"))
+		return;
+
+	const Common::JSONObject &item = entry->asObject();
+
+	if (!Networking::CurlJsonRequest::jsonContainsString(item, "path_lower", "DropboxListDirectoryRequest"))
+		return;
+	if (!Networking::CurlJsonRequest::jsonContainsString(item, ".tag", "DropboxListDirectoryRequest"))
+		return;
+
+	Common::String path = item.getVal("path_lower")->asString();
+	bool isDirectory = (item.getVal(".tag")->asString() == "folder");
+	uint32 size = 0, timestamp = 0;
+	if (!isDirectory) {
+		if (!Networking::CurlJsonRequest::jsonContainsString(item, "server_modified", "DropboxListDirectoryRequest"))
+			return;
+		if (!Networking::CurlJsonRequest::jsonContainsIntegerNumber(item, "size", "DropboxListDirectoryRequest"))
+			return;
+
+		size = item.getVal("size")->asIntegerNumber();
+		timestamp = ISO8601::convertToTimestamp(item.getVal("server_modified")->asString());
+	}
+	_files.push_back(StorageFile(path, size, timestamp, isDirectory));
+}
+
+void DropboxListDirectoryRequest::continueListing(const Common::String &cursor) {
+	Networking::JsonCallback callback = new Common::Callback<DropboxListDirectoryRequest, const Networking::JsonResponse &>(this, &DropboxListDirectoryRequest::responseCallback);
+	Networking::ErrorCallback failureCallback = new Common::Callback<DropboxListDirectoryRequest, const Networking::ErrorResponse &>(this, &DropboxListDirectoryRequest::errorCallback);
+	Networking::CurlJsonRequest *request = new DropboxTokenRefresher(_storage, callback, failureCallback, DROPBOX_API_LIST_FOLDER_CONTINUE);
+	request->setJsonReaderCallback(new Common::Callback<DropboxListDirectoryRequest, const Networking::JsonReaderResponse &>(this, &DropboxListDirectoryRequest::responseReaderCallback));
+	request->addHeader("Authorization: Bearer " + _storage->accessToken());
+	request->addHeader("Content-Type: application/json");
+
+	Common::JSONObject jsonRequestParameters;
+	jsonRequestParameters.setVal("cursor", new Common::JSONValue(cursor));
+
+	Common::JSONValue value(jsonRequestParameters);
+	request->addPostField(Common::JSON::stringify(&value));
+
+	_workingRequest = ConnMan.addRequest(request);
 }
 
 void DropboxListDirectoryRequest::errorCallback(const Networking::ErrorResponse &error) {
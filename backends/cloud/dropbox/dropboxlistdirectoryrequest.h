@@ -45,6 +45,9 @@ class DropboxListDirectoryRequest: public Networking::Request {
 
 	void start();
 	void responseCallback(const Networking::JsonResponse &response);
+	void responseReaderCallback(const Networking::JsonReaderResponse &response);
+	void addEntry(const Common::JSONValue *entry);
+	void continueListing(const Common::String &cursor);
 	void errorCallback(const Networking::ErrorResponse &error);
 	void finishListing(const Common::Array<StorageFile> &files);
 public:
@@ -29,6 +29,7 @@
 #include "common/debug.h"
 #include "common/file.h"
 #include "common/formats/json.h"
+#include "common/md5.h"
 #include "common/savefile.h"
 #include "common/system.h"
 #include "gui/saveload-dialog.h"
@@ -55,14 +56,17 @@ void SavesSyncRequest::start() {
 		_workingRequest->finish();
 	_currentDownloadingFile = StorageFile();
 	_currentUploadingFile = "";
+	_currentUploadingHash = "";
 	_filesToDownload.clear();
 	_filesToUpload.clear();
 	_localFilesTimestamps.clear();
+	_localFilesHashes.clear();
 	_totalFilesToHandle = 0;
 	_ignoreCallback = false;
 
 	//load timestamps
 	_localFilesTimestamps = DefaultSaveFileManager::loadTimestamps();
+	_localFilesHashes = DefaultSaveFileManager::loadHashes();
 
 	//list saves directory
 	Common::String dir = _storage->savesDirectoryPath();
@@ -91,13 +95,14 @@ void SavesSyncRequest::directoryListedCallback(const Storage::ListDirectoryRespo
 	//determine which files to download and which files to upload
 	const Common::Array<StorageFile> &remoteFiles = response.value;
 	uint64 totalSize = 0;
+	bool timestampsChanged = false;
 	debug(9, "SavesSyncRequest decisions:");
 	for (uint32 i = 0; i < remoteFiles.size(); ++i) {
 		const StorageFile &file = remoteFiles[i];
 		if (file.isDirectory())
 			continue;
 		totalSize += file.size();
-		if (file.name() == DefaultSaveFileManager::TIMESTAMPS_FILENAME || !CloudMan.canSyncFilename(file.name()))
+		if (file.name() == DefaultSaveFileManager::TIMESTAMPS_FILENAME || file.name() == DefaultSaveFileManager::HASHES_FILENAME || !CloudMan.canSyncFilename(file.name()))
 			continue;
 
 		Common::String name = file.name();
@@ -110,6 +115,16 @@ void SavesSyncRequest::directoryListedCallback(const Storage::ListDirectoryRespo
 			if (_localFilesTimestamps[name] == file.timestamp())
 				continue;
 
+			//a file which was saved again with the same contents it had on the last sync doesn't need a transfer,
+			//unless the remote file has changed since then
+			if (_localFilesTimestamps[name] == DefaultSaveFileManager::INVALID_TIMESTAMP && _localFilesHashes.contains(name) &&
+				_localFilesHashes[name].timestamp == file.timestamp() && _localFilesHashes[name].hash == computeLocalFileHash(name)) {
+				_localFilesTimestamps[name] = file.timestamp();
+				timestampsChanged = true;
+				debug(9, "- skipping file %s, because its contents didn't change since the last sync", name.c_str());
+				continue;
+			}
+
 			//we actually can have some files not only with timestamp < remote
 			//but also with timestamp > remote (when we have been using ANOTHER CLOUD and then switched back)
 			if (_localFilesTimestamps[name] > file.timestamp() || _localFilesTimestamps[name] == DefaultSaveFileManager::INVALID_TIMESTAMP)
@@ -126,11 +141,14 @@ void SavesSyncRequest::directoryListedCallback(const Storage::ListDirectoryRespo
 		}
 	}
 
+	if (timestampsChanged)
+		DefaultSaveFileManager::saveTimestamps(_localFilesTimestamps);
+
 	CloudMan.setStorageUsedSpace(CloudMan.getStorageIndex(), totalSize);
 
 	//upload files which are unavailable in cloud
 	for (Common::HashMap<Common::String, bool>::iterator i = localFileNotAvailableInCloud.begin(); i != localFileNotAvailableInCloud.end(); ++i) {
-		if (i->_key == DefaultSaveFileManager::TIMESTAMPS_FILENAME || !CloudMan.canSyncFilename(i->_key))
+		if (i->_key == DefaultSaveFileManager::TIMESTAMPS_FILENAME || i->_key == DefaultSaveFileManager::HASHES_FILENAME || !CloudMan.canSyncFilename(i->_key))
 			continue;
 		if (i->_value) {
 			_filesToUpload.push_back(i->_key);
@@ -308,6 +326,8 @@ void SavesSyncRequest::fileDownloadedCallback(const Storage::BoolResponse &respo
 	//update local timestamp for downloaded file
 	_localFilesTimestamps[_currentDownloadingFile.name()] = _currentDownloadingFile.timestamp();
 	DefaultSaveFileManager::saveTimestamps(_localFilesTimestamps);
+	_localFilesHashes[_currentDownloadingFile.name()] = DefaultSaveFileManager::SyncedFileHash(computeLocalFileHash(_currentDownloadingFile.name()), _currentDownloadingFile.timestamp());
+	DefaultSaveFileManager::saveHashes(_localFilesHashes);
 	_bytesDownloaded += _currentDownloadingFile.size();
 
 	//continue downloading files
@@ -331,6 +351,7 @@ void SavesSyncRequest::uploadNextFile() {
 
 	_currentUploadingFile = _filesToUpload.back();
 	_filesToUpload.pop_back();
+	_currentUploadingHash = computeLocalFileHash(_currentUploadingFile);
 
 	debug(9, "\nSavesSyncRequest: uploading %s (%d %%)", _currentUploadingFile.c_str(), (int)(getProgress() * 100));
 	if (_storage->uploadStreamSupported()) {
@@ -359,6 +380,8 @@ void SavesSyncRequest::fileUploadedCallback(const Storage::UploadResponse &respo
 	//update local timestamp for the uploaded file
 	_localFilesTimestamps[_currentUploadingFile] = response.value.timestamp();
 	DefaultSaveFileManager::saveTimestamps(_localFilesTimestamps);
+	_localFilesHashes[_currentUploadingFile] = DefaultSaveFileManager::SyncedFileHash(_currentUploadingHash, response.value.timestamp());
+	DefaultSaveFileManager::saveHashes(_localFilesHashes);
 
 	//continue uploading files
 	uploadNextFile();
@@ -476,4 +499,15 @@ void SavesSyncRequest::finishSync(bool success) {
 		(*_boolCallback)(Storage::BoolResponse(this, success));
 }
 
+Common::String SavesSyncRequest::computeLocalFileHash(const Common::String &name) {
+	Common::FSNode node(DefaultSaveFileManager::concatWithSavesPath(name));
+	Common::SeekableReadStream *stream = node.createReadStream();
+	if (!stream)
+		return "";
+
+	Common::String hash = Common::computeStreamMD5AsString(*stream);
+	delete stream;
+	return hash;
+}
+
 } // End of namespace Cloud
@@ -24,6 +24,7 @@
 
 #include "backends/networking/curl/request.h"
 #include "backends/cloud/storage.h"
+#include "backends/saves/default/default-saves.h"
 #include "common/hashmap.h"
 #include "common/hash-str.h"
 
@@ -33,10 +34,12 @@ class SavesSyncRequest: public Networking::Request {
 	Storage *_storage;
 	Storage::BoolCallback _boolCallback;
 	Common::HashMap<Common::String, uint32> _localFilesTimestamps;
+	Common::HashMap<Common::String, DefaultSaveFileManager::SyncedFileHash> _localFilesHashes;
 	Common::Array<StorageFile> _filesToDownload;
 	Common::Array<Common::String> _filesToUpload;
 	StorageFile _currentDownloadingFile;
 	Common::String _currentUploadingFile;
+	Common::String _currentUploadingHash;
 	Request *_workingRequest;
 	bool _ignoreCallback;
 	uint32 _totalFilesToHandle;
@@ -57,6 +60,9 @@ class SavesSyncRequest: public Networking::Request {
 	void finishError(const Networking::ErrorResponse &error, Networking::RequestState state = Networking::FINISHED) override;
 	void finishSync(bool success);
 
+	/** Returns the MD5 hash of the given local save file, or an empty string. */
+	static Common::String computeLocalFileHash(const Common::String &name);
+
 	uint32 getDownloadedBytes() const;
 	uint32 getBytesToDownload() const;
 
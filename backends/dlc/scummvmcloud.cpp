@@ -44,39 +44,72 @@
 namespace DLC {
 namespace ScummVMCloud {
 
+void ScummVMCloud::addDLC(const Common::JSONValue *entry, uint32 idx) {
+	if (!Networking::CurlJsonRequest::jsonIsObject(entry, "ScummVMCloud"))
+		return;
+	const Common::JSONObject &item = entry->asObject();
+
+	DLC::DLCDesc *dlc = new DLC::DLCDesc();
+	dlc->id = item.getVal("id")->asString();
+	dlc->name = item.getVal("name")->asString();
+	dlc->url = item.getVal("url")->asString();
+	dlc->platform = item.getVal("platform")->asString();
+	dlc->gameid = item.getVal("gameid")->asString();
+	dlc->description = item.getVal("description")->asString();
+	dlc->language = item.getVal("language")->asString();
+	dlc->extra = item.getVal("extra")->asString();
+	dlc->engineid = item.getVal("engineid")->asString();
+	dlc->guioptions = item.getVal("guioptions")->asString();
+	if (item.getVal("size")->isString()) {
+		dlc->size = item.getVal("size")->asString().asUint64();
+	} else {
+		dlc->size = item.getVal("size")->asIntegerNumber();
+	}
+	dlc->idx = idx;
+	DLCMan._dlcs.push_back(dlc);
+}
+
 void ScummVMCloud::jsonCallbackGetAllDLCs(const Networking::JsonResponse &response) {
 	const Common::JSONValue *json = response.value;
 	if (json == nullptr || !json->isObject()) {
 		return;
 	}
-	debug(1, "DLC list JSON response: %s", json->stringify(true).c_str());
-	Common::JSONObject result = json->asObject();
+	if (gDebugLevel >= 1)
+		debug(1, "DLC list JSON response: %s", json->stringify(true).c_str());
+	const Common::JSONObject &result = json->asObject();
 	if (result.contains("entries")) {
-		Common::JSONArray items = result.getVal("entries")->asArray();
-		for (uint32 i = 0; i < items.size(); ++i) {
-			if (!Networking::CurlJsonRequest::jsonIsObject(items[i], "ScummVMCloud")) continue;
-			Common::JSONObject item = items[i]->asObject();
-
-			DLC::DLCDesc *dlc = new DLC::DLCDesc();
-			dlc->id = item.getVal("id")->asString();
-			dlc->name = item.getVal("name")->asString();
-			dlc->url = item.getVal("url")->asString();
-			dlc->platform = item.getVal("platform")->asString();
-			dlc->gameid = item.getVal("gameid")->asString();
-			dlc->description = item.getVal("description")->asString();
-			dlc->language = item.getVal("language")->asString();
-			dlc->extra = item.getVal("extra")->asString();
-			dlc->engineid = item.getVal("engineid")->asString();
-			dlc->guioptions = item.getVal("guioptions")->asString();
-			if (item.getVal("size")->isString()) {
-				dlc->size = item.getVal("size")->asString().asUint64();
-			} else {
-				dlc->size = item.getVal("size")->asIntegerNumber();
-			}
-			dlc->idx = i;
-			DLCMan._dlcs.push_back(dlc);
+		const Common::JSONArray &items = result.getVal("entries")->asArray();
+		for (uint32 i = 0; i < items.size(); ++i)
+			addDLC(items[i], i);
+	}
+	// send refresh DLC list command to GUI
+	DLCMan.refreshDLCList();
+}
+
+void ScummVMCloud::jsonReaderCallbackGetAllDLCs(const Networking::JsonReaderResponse &response) {
+	Common::JSONReader &reader = *response.value;
+	Common::String key;
+	if (!reader.enterObject())
+		return;
+
+	// Only the entries are built into trees, one at a time
+	while (reader.nextKey(key)) {
+		if (key != "entries" || !reader.enterArray()) {
+			reader.skipValue();
+			continue;
+		}
+
+		for (uint32 i = 0; reader.nextElement(); ++i) {
+			Common::JSONValue *item = reader.readValue();
+			if (!item)
+				break;
+			addDLC(item, i);
+			delete item;
 		}
 	}
+	if (reader.hasError())
+		warning("ScummVMCloud: DLC list is not valid JSON");
+
 	// send refresh DLC list command to GUI
 	DLCMan.refreshDLCList();
 }
@@ -91,6 +124,7 @@ void ScummVMCloud::getAllDLCs() {
 	Networking::ErrorCallback failureCallback = new Common::Callback<ScummVMCloud, const Networking::ErrorResponse &>(this, &ScummVMCloud::errorCallbackGetAllDLCs);
 	Networking::CurlJsonRequest *request = new Networking::CurlJsonRequest(
 		callback, failureCallback, url);
+	request->setJsonReaderCallback(new Common::Callback<ScummVMCloud, const Networking::JsonReaderResponse &>(this, &ScummVMCloud::jsonReaderCallbackGetAllDLCs));
 
 	request->execute();
 }
@@ -57,6 +57,8 @@ public:
 
 	// callback functions
 	void jsonCallbackGetAllDLCs(const Networking::JsonResponse &response);
+	void jsonReaderCallbackGetAllDLCs(const Networking::JsonReaderResponse &response);
+	void addDLC(const Common::JSONValue *entry, uint32 idx);
 
 	void errorCallbackGetAllDLCs(const Networking::ErrorResponse &error);
 
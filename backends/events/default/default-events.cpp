@@ -79,6 +79,13 @@ void DefaultEventManager::init() {
 #endif
 }
 
+bool DefaultEventManager::notifyEvent(const Common::Event &ev) {
+	_eventQueue.push(ev);
+	if (!_eventQueue.back().timestamp)
+		_eventQueue.back().timestamp = g_system->getMillis();
+	return true;
+}
+
 bool DefaultEventManager::pollEvent(Common::Event &event) {
 	_dispatcher.dispatch();
 
@@ -93,6 +100,14 @@ bool DefaultEventManager::pollEvent(Common::Event &event) {
 	event = _eventQueue.pop();
 	bool forwardEvent = true;
 
+	// Only report the latest of several queued mouse movements, so engines
+	// handling one event per frame do not lag behind the pointer
+	while (event.type == Common::EVENT_MOUSEMOVE && !_eventQueue.empty() && _eventQueue.front().type == Common::EVENT_MOUSEMOVE) {
+		Common::Point relMouse = event.relMouse;
+		event = _eventQueue.pop();
+		event.relMouse += relMouse;
+	}
+
 	// If the backend has the kFeatureNoQuit or the "Return to Launcher at Exit" option is enabled,
 	// replace "Quit" event with "Return to Launcher". This is also handled in scummvm_main, but
 	// doing it here allows getting the correct confirmation dialog if the "confirm_exit" setting
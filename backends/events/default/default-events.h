@@ -46,10 +46,7 @@ class DefaultEventManager : public Common::EventManager, Common::EventObserver {
 	Common::ArtificialEventSource _artificialEventSource;
 
 	Common::Queue<Common::Event> _eventQueue;
-	bool notifyEvent(const Common::Event &ev) override {
-		_eventQueue.push(ev);
-		return true;
-	}
+	bool notifyEvent(const Common::Event &ev) override;
 
 	Common::Point _mousePos;
 	int _buttonState;
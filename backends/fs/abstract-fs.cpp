@@ -39,3 +39,15 @@ const char *AbstractFSNode::lastPathComponent(const Common::String &str, const c
 Common::SeekableReadStream *AbstractFSNode::createReadStreamForAltStream(Common::AltStreamType altStreamType) {
 	return nullptr;
 }
+
+AbstractFSNode *AbstractFSNode::getListedChild(const Common::String &name, bool isDirectory) const {
+	return getChild(name);
+}
+
+bool AbstractFSNode::getFileInfo(int64 &size, int64 &modificationTime) const {
+	return false;
+}
+
+Common::MappedReadStream *AbstractFSNode::createMappedReadStream() {
+	return nullptr;
+}
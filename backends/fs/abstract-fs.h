@@ -41,6 +41,7 @@ typedef Common::Array<AbstractFSNode *>	AbstractFSList;
 class AbstractFSNode {
 protected:
 	friend class Common::FSNode;
+	friend class Common::FSDirectory;
 	typedef Common::FSNode::ListMode ListMode;
 
 	/**
@@ -62,6 +63,17 @@ protected:
 	 */
 	virtual AbstractFSNode *getChild(const Common::String &name) const = 0;
 
+	/**
+	 * Returns a child node whose type is already known, e.g. from a stored
+	 * directory listing, so that it doesn't need to be queried again.
+	 *
+	 * The default implementation calls getChild().
+	 *
+	 * @param name String containing the name of the child to create a new node.
+	 * @param isDirectory Whether the child is a directory.
+	 */
+	virtual AbstractFSNode *getListedChild(const Common::String &name, bool isDirectory) const;
+
 	/**
 	 * The parent node of this directory.
 	 * The parent of the root is the root itself.
@@ -192,6 +204,26 @@ public:
 	 */
 	virtual Common::SeekableReadStream *createReadStreamForAltStream(Common::AltStreamType altStreamType);
 
+	/**
+	 * Queries the size and the last modification time of the file referred
+	 * by this node, without opening it. The time is only meant to be compared
+	 * with other values returned by this method for the same file.
+	 *
+	 * The default implementation does not support this.
+	 *
+	 * @return true if the information could be retrieved
+	 */
+	virtual bool getFileInfo(int64 &size, int64 &modificationTime) const;
+
+	/**
+	 * Maps the file referred by this node into memory, read-only.
+	 *
+	 * The default implementation does not support this.
+	 *
+	 * @return pointer to the stream object, 0 if the file can't be mapped
+	 */
+	virtual Common::MappedReadStream *createMappedReadStream();
+
 	/**
 	 * Creates a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -34,6 +34,7 @@
 #include "backends/fs/posix/posix-fs.h"
 #include "backends/fs/posix/posix-iostream.h"
 #include "common/algorithm.h"
+#include "common/memstream.h"
 
 #include <sys/param.h>
 #include <sys/stat.h>
@@ -49,6 +50,9 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <unistd.h>
+#ifdef HAS_MMAP
+#include <sys/mman.h>
+#endif
 
 #ifdef __OS2__
 #define INCL_DOS
@@ -67,6 +71,16 @@ bool POSIXFilesystemNode::isWritable() const {
 	return access(_path.c_str(), W_OK) == 0;
 }
 
+bool POSIXFilesystemNode::getFileInfo(int64 &size, int64 &modificationTime) const {
+	struct stat st;
+	if (stat(_path.c_str(), &st) != 0)
+		return false;
+
+	size = st.st_size;
+	modificationTime = st.st_mtime;
+	return true;
+}
+
 void POSIXFilesystemNode::setFlags() {
 	struct stat st;
 
@@ -137,6 +151,22 @@ AbstractFSNode *POSIXFilesystemNode::getChild(const Common::String &n) const {
 	return makeNode(newPath);
 }
 
+AbstractFSNode *POSIXFilesystemNode::getListedChild(const Common::String &n, bool isDirectory) const {
+	assert(_isDirectory);
+	assert(!n.contains('/'));
+
+	// Like getChildren(), start with a clone of this node and skip stat()
+	POSIXFilesystemNode *entry = new POSIXFilesystemNode(*this);
+	entry->_displayName = n;
+	if (_path.lastChar() != '/')
+		entry->_path += '/';
+	entry->_path += n;
+	entry->_isDirectory = isDirectory;
+	entry->_isValid = true;
+
+	return entry;
+}
+
 bool POSIXFilesystemNode::getChildren(AbstractFSList &myList, ListMode mode, bool hidden) const {
 	assert(_isDirectory);
 
@@ -280,6 +310,39 @@ Common::SeekableReadStream *POSIXFilesystemNode::createReadStreamForAltStream(Co
 	return nullptr;
 }
 
+#ifdef HAS_MMAP
+namespace {
+
+class PosixFileMapping final : public Common::FileMapping {
+public:
+	PosixFileMapping(void *data, uint32 size) : FileMapping((const byte *)data, size) {}
+	~PosixFileMapping() override { munmap(const_cast<byte *>(_data), _size); }
+};
+
+} // End of anonymous namespace
+
+Common::MappedReadStream *POSIXFilesystemNode::createMappedReadStream() {
+	const int fd = open(_path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return nullptr;
+
+	struct stat st;
+	void *data = MAP_FAILED;
+	// Empty files can't be mapped
+	if (fstat(fd, &st) == 0 && st.st_size > 0 && (uint64)st.st_size < 0xFFFFFFFFULL)
+		data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// The mapping stays valid after closing the file
+	close(fd);
+
+	if (data == MAP_FAILED)
+		return nullptr;
+
+	Common::SharedPtr<Common::FileMapping> mapping(new PosixFileMapping(data, st.st_size));
+	return new Common::MappedReadStream(mapping, 0, st.st_size);
+}
+#endif
+
 Common::SeekableWriteStream *POSIXFilesystemNode::createWriteStream(bool atomic) {
 	return PosixIoStream::makeFromPath(getPath(), atomic ?
 			StdioStream::WriteMode_WriteAtomic : StdioStream::WriteMode_Write);
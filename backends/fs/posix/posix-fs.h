@@ -62,11 +62,16 @@ public:
 	bool isWritable() const override;
 
 	AbstractFSNode *getChild(const Common::String &n) const override;
+	AbstractFSNode *getListedChild(const Common::String &n, bool isDirectory) const override;
 	bool getChildren(AbstractFSList &list, ListMode mode, bool hidden) const override;
 	AbstractFSNode *getParent() const override;
 
 	Common::SeekableReadStream *createReadStream() override;
 	Common::SeekableReadStream *createReadStreamForAltStream(Common::AltStreamType altStreamType) override;
+	bool getFileInfo(int64 &size, int64 &modificationTime) const override;
+#ifdef HAS_MMAP
+	Common::MappedReadStream *createMappedReadStream() override;
+#endif
 	Common::SeekableWriteStream *createWriteStream(bool atomic) override;
 	bool createDirectory() override;
 
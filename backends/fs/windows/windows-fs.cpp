@@ -26,6 +26,7 @@
 
 #include "backends/fs/windows/windows-fs.h"
 #include "backends/fs/stdiostream.h"
+#include "common/memstream.h"
 
 bool WindowsFilesystemNode::exists() const {
 	// Check whether the file actually exists
@@ -44,6 +45,52 @@ bool WindowsFilesystemNode::isWritable() const {
 	return ((fileAttribs != INVALID_FILE_ATTRIBUTES) && (!(fileAttribs & FILE_ATTRIBUTE_READONLY)));
 }
 
+bool WindowsFilesystemNode::getFileInfo(int64 &size, int64 &modificationTime) const {
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (!GetFileAttributesEx(charToTchar(_path.c_str()), GetFileExInfoStandard, &data))
+		return false;
+
+	size = ((int64)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+	modificationTime = ((int64)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+	return true;
+}
+
+namespace {
+
+class WindowsFileMapping final : public Common::FileMapping {
+public:
+	WindowsFileMapping(const void *data, uint32 size) : FileMapping((const byte *)data, size) {}
+	~WindowsFileMapping() override { UnmapViewOfFile(_data); }
+};
+
+} // End of anonymous namespace
+
+Common::MappedReadStream *WindowsFilesystemNode::createMappedReadStream() {
+	HANDLE file = CreateFile(charToTchar(_path.c_str()), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	// Empty files can't be mapped
+	LARGE_INTEGER size;
+	HANDLE fileMapping = nullptr;
+	if (GetFileSizeEx(file, &size) && size.QuadPart > 0 && size.QuadPart < 0xFFFFFFFFLL)
+		fileMapping = CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	const void *data = nullptr;
+	if (fileMapping) {
+		data = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+		// The view keeps the mapping and the file open
+		CloseHandle(fileMapping);
+	}
+	CloseHandle(file);
+
+	if (!data)
+		return nullptr;
+
+	Common::SharedPtr<Common::FileMapping> mapping(new WindowsFileMapping(data, (uint32)size.QuadPart));
+	return new Common::MappedReadStream(mapping, 0, (uint32)size.QuadPart);
+}
+
 void WindowsFilesystemNode::addFile(AbstractFSList &list, ListMode mode, const char *base, bool hidden, WIN32_FIND_DATA* find_data) {
 	// Skip local directory (.) and parent (..)
 	if (!_tcscmp(find_data->cFileName, TEXT(".")) ||
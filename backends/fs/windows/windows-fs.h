@@ -78,6 +78,8 @@ public:
 	AbstractFSNode *getParent() const override;
 
 	Common::SeekableReadStream *createReadStream() override;
+	bool getFileInfo(int64 &size, int64 &modificationTime) const override;
+	Common::MappedReadStream *createMappedReadStream() override;
 	Common::SeekableWriteStream *createWriteStream(bool atomic) override;
 	bool createDirectory() override;
 
@@ -89,6 +89,8 @@ public:
 	virtual void unlockScreen() = 0;
 	virtual void fillScreen(uint32 col) = 0;
 	virtual void fillScreen(const Common::Rect &r, uint32 col) = 0;
+	virtual void showYUVOverlay(const Graphics::YUVImage &image, int x, int y) {}
+	virtual void hideYUVOverlay() {}
 	virtual void updateScreen() = 0;
 	virtual void setShakePos(int shakeXOffset, int shakeYOffset) = 0;
 	virtual void setFocusRectangle(const Common::Rect& rect) = 0;
@@ -54,11 +54,6 @@
 #include "graphics/scalerplugin.h"
 #endif
 
-#ifdef USE_PNG
-#include "image/png.h"
-#else
-#include "image/bmp.h"
-#endif
 
 #include "common/text-to-speech.h"
 
@@ -78,8 +73,9 @@ OpenGLGraphicsManager::OpenGLGraphicsManager()
 	  _cursorHotspotXScaled(0), _cursorHotspotYScaled(0), _cursorWidthScaled(0), _cursorHeightScaled(0),
 	  _cursorKeyColor(0), _cursorUseKey(true), _cursorDontScale(false), _cursorPaletteEnabled(false), _shakeOffsetScaled()
 #if !USE_FORCED_GLES
-	  , _libretroPipeline(nullptr)
+	  , _libretroPipeline(nullptr), _yuvOverlay(nullptr)
 #endif
+	  , _yuvOverlayVisible(false), _yuvOverlayPos()
 #ifdef USE_OSD
 	  , _osdMessageChangeRequest(false), _osdMessageAlpha(0), _osdMessageFadeStartTime(0), _osdMessageSurface(nullptr),
 	  _osdIconSurface(nullptr)
@@ -102,6 +98,7 @@ OpenGLGraphicsManager::~OpenGLGraphicsManager() {
 	delete _osdIconSurface;
 #endif
 #if !USE_FORCED_GLES
+	delete _yuvOverlay;
 	ShaderManager::destroy();
 #endif
 	delete _pipeline;
@@ -125,6 +122,9 @@ bool OpenGLGraphicsManager::hasFeature(OSystem::Feature f) const {
 #if !USE_FORCED_GLES
 	case OSystem::kFeatureShaders:
 		return LibRetroPipeline::isSupportedByContext();
+
+	case OSystem::kFeatureYUVOverlay:
+		return TextureYUVGPU::isSupportedByContext();
 #endif
 
 	case OSystem::kFeatureOverlaySupportsAlpha:
@@ -519,6 +519,8 @@ OSystem::TransactionError OpenGLGraphicsManager::endGFXTransaction() {
 		_gameScreen = createSurface(Graphics::PixelFormat::createFormatCLUT8(), false, wantScaler);
 #endif
 		assert(_gameScreen);
+		// The game screen usually changes every frame.
+		_gameScreen->enableStreamingUpload(true);
 		if (_gameScreen->hasPalette()) {
 			_gameScreen->setPalette(0, 256, _gamePalette);
 		}
@@ -597,6 +599,31 @@ void OpenGLGraphicsManager::fillScreen(const Common::Rect &r, uint32 col) {
 	_gameScreen->fill(r, col);
 }
 
+void OpenGLGraphicsManager::showYUVOverlay(const Graphics::YUVImage &image, int x, int y) {
+#if !USE_FORCED_GLES
+	if (!TextureYUVGPU::isSupportedByContext()) {
+		return;
+	}
+
+	if (!_yuvOverlay) {
+		_yuvOverlay = new TextureYUVGPU();
+		_yuvOverlay->enableLinearFiltering(_currentState.filtering);
+	}
+
+	_yuvOverlay->setImage(image);
+	_yuvOverlayPos = Common::Point(x, y);
+	_yuvOverlayVisible = true;
+	_forceRedraw = true;
+#endif
+}
+
+void OpenGLGraphicsManager::hideYUVOverlay() {
+	if (_yuvOverlayVisible) {
+		_yuvOverlayVisible = false;
+		_forceRedraw = true;
+	}
+}
+
 void OpenGLGraphicsManager::renderCursor() {
 	/*
 	Windows and Mac cursor XOR works by drawing the cursor to the screen with the formula (Destination AND Mask XOR Color)
@@ -677,6 +704,15 @@ void OpenGLGraphicsManager::updateScreen() {
 		return;
 	}
 
+#if !USE_FORCED_GLES
+	// The libretro passes only need to be rendered again when what is drawn
+	// through them changed, and not for overlay or OSD updates
+	const bool scaledInputChanged = _forceRedraw
+	    || _gameScreen->isDirty()
+	    || (!_overlayInGUI && (_cursorNeedsRedraw
+	        || (_cursorVisible && ((_cursor && _cursor->isDirty()) || (_cursorMask && _cursorMask->isDirty())))));
+#endif
+
 	// Update changes to textures.
 	_gameScreen->updateGLTexture();
 	if (_cursorVisible && _cursor) {
@@ -689,7 +725,7 @@ void OpenGLGraphicsManager::updateScreen() {
 
 #if !USE_FORCED_GLES
 	if (_libretroPipeline) {
-		_libretroPipeline->beginScaling();
+		_libretroPipeline->beginScaling(scaledInputChanged);
 	}
 #endif
 
@@ -714,6 +750,20 @@ void OpenGLGraphicsManager::updateScreen() {
 	// First step: Draw the (virtual) game screen.
 	_pipeline->drawTexture(_gameScreen->getGLTexture(), _gameDrawRect.left, _gameDrawRect.top, _gameDrawRect.width(), _gameDrawRect.height());
 
+#if !USE_FORCED_GLES
+	// Video frames converted on the GPU are placed on top of the game screen.
+	if (_yuvOverlayVisible) {
+		const int gameWidth = _gameScreen->getWidth();
+		const int gameHeight = _gameScreen->getHeight();
+		const int dstX = _gameDrawRect.left + _yuvOverlayPos.x * _gameDrawRect.width() / gameWidth;
+		const int dstY = _gameDrawRect.top + _yuvOverlayPos.y * _gameDrawRect.height() / gameHeight;
+		const int dstW = (int)_yuvOverlay->getWidth() * _gameDrawRect.width() / gameWidth;
+		const int dstH = (int)_yuvOverlay->getHeight() * _gameDrawRect.height() / gameHeight;
+
+		_pipeline->drawTexture(_yuvOverlay->getGLTexture(), dstX, dstY, dstW, dstH);
+	}
+#endif
+
 	// Second step: Draw the cursor if necessary and we are not in GUI and it
 #if !USE_FORCED_GLES
 	if (_libretroPipeline) {
@@ -1257,6 +1307,21 @@ void OpenGLGraphicsManager::displayActivityIconOnOSD(const Graphics::Surface *ic
 void OpenGLGraphicsManager::setPalette(const byte *colors, uint start, uint num) {
 	assert(_gameScreen->hasPalette());
 
+	// Palette fades often set the whole palette several times per frame,
+	// but only touch a few entries each time. Skip the unchanged ones, as
+	// every change makes the game screen be converted or looked up again.
+	while (num > 0 && !memcmp(_gamePalette + start * 3, colors, 3)) {
+		++start;
+		--num;
+		colors += 3;
+	}
+	while (num > 0 && !memcmp(_gamePalette + (start + num - 1) * 3, colors + (num - 1) * 3, 3)) {
+		--num;
+	}
+	if (num == 0) {
+		return;
+	}
+
 	memcpy(_gamePalette + start * 3, colors, num * 3);
 	_gameScreen->setPalette(start, num, colors);
 
@@ -1424,6 +1489,12 @@ void OpenGLGraphicsManager::notifyContextCreate(ContextType type,
 		_cursorMask->recreate();
 	}
 
+#if !USE_FORCED_GLES
+	if (_yuvOverlay) {
+		_yuvOverlay->recreate();
+	}
+#endif
+
 #ifdef USE_OSD
 	if (_osdMessageSurface) {
 		_osdMessageSurface->recreate();
@@ -1452,6 +1523,15 @@ void OpenGLGraphicsManager::notifyContextDestroy() {
 		_cursorMask->destroy();
 	}
 
+#if !USE_FORCED_GLES
+	// The converted image is gone with the context, so there's nothing left
+	// to show until the next one is set.
+	if (_yuvOverlay) {
+		_yuvOverlay->destroy();
+	}
+	_yuvOverlayVisible = false;
+#endif
+
 #ifdef USE_OSD
 	if (_osdMessageSurface) {
 		_osdMessageSurface->destroy();
@@ -1490,6 +1570,14 @@ Surface *OpenGLGraphicsManager::createSurface(const Graphics::PixelFormat &forma
 
 #ifdef USE_SCALERS
 	if (wantScaler) {
+#if !USE_FORCED_GLES
+		// Some scalers can be done on the GPU, as part of the palette look up.
+		if (format.bytesPerPixel == 1 && !wantMask && TextureSurfaceCLUT8GPU::isSupportedByContext() &&
+		    TextureSurfaceCLUT8GPU::hasScaler(_currentState.scalerIndex, _currentState.scaleFactor)) {
+			return new TextureSurfaceCLUT8GPU();
+		}
+#endif
+
 		// TODO: Ensure that the requested pixel format is supported by the scaler
 		if (getGLPixelFormat(format, glIntFormat, glFormat, glType)) {
 			return new ScaledTextureSurface(glIntFormat, glFormat, glType, format, format);
@@ -1753,6 +1841,12 @@ void OpenGLGraphicsManager::updateLinearFiltering() {
 		_cursorMask->enableLinearFiltering(_currentState.filtering);
 	}
 
+#if !USE_FORCED_GLES
+	if (_yuvOverlay) {
+		_yuvOverlay->enableLinearFiltering(_currentState.filtering);
+	}
+#endif
+
 	// The overlay UI should also obey the filtering choice (managed via the Filter Graphics checkbox in Graphics Tab).
 	// Thus, when overlay filtering is disabled, scaling in OPENGL is done with GL_NEAREST (nearest neighbor scaling).
 	// It may look crude, but it should be crispier and it's left to user choice to enable filtering.
@@ -1781,11 +1875,6 @@ bool OpenGLGraphicsManager::saveScreenshot(const Common::Path &filename) const {
 	const uint lineSize        = (width * 3 + 3) & ~3;
 #endif
 
-	Common::DumpFile out;
-	if (!out.open(filename)) {
-		return false;
-	}
-
 	Common::Array<uint8> pixels;
 	pixels.resize(lineSize * height);
 #ifdef EMSCRIPTEN
@@ -1808,11 +1897,7 @@ bool OpenGLGraphicsManager::saveScreenshot(const Common::Path &filename) const {
 	data.init(width, height, lineSize, &pixels.front(), format);
 	data.flipVertical(Common::Rect(width, height));
 
-#ifdef USE_PNG
-	return Image::writePNG(out, data);
-#else
-	return Image::writeBMP(out, data);
-#endif
+	return _screenshotWriter.write(filename, data);
 }
 
 } // End of namespace OpenGL
@@ -33,6 +33,8 @@
 
 #include "graphics/surface.h"
 
+#include "image/screenshot.h"
+
 namespace Graphics {
 class Font;
 } // End of namespace Graphics
@@ -48,6 +50,7 @@ class Surface;
 class Pipeline;
 #if !USE_FORCED_GLES
 class LibRetroPipeline;
+class TextureYUVGPU;
 #endif
 
 enum {
@@ -105,6 +108,9 @@ public:
 	void fillScreen(uint32 col) override;
 	void fillScreen(const Common::Rect &r, uint32 col) override;
 
+	void showYUVOverlay(const Graphics::YUVImage &image, int x, int y) override;
+	void hideYUVOverlay() override;
+
 	void updateScreen() override;
 
 	Graphics::Surface *lockScreen() override;
@@ -293,6 +299,11 @@ protected:
 	// Do not hide the argument-less saveScreenshot from the base class
 	using WindowedGraphicsManager::saveScreenshot;
 
+	/**
+	 * Encodes and writes screenshots, on a worker thread when possible.
+	 */
+	mutable Image::ScreenshotWriter _screenshotWriter;
+
 private:
 	//
 	// OpenGL utilities
@@ -366,6 +377,27 @@ protected:
 	 */
 	Surface *_overlay;
 
+	//
+	// YUV overlay
+	//
+
+#if !USE_FORCED_GLES
+	/**
+	 * The converted image set by showYUVOverlay(), created on first use.
+	 */
+	TextureYUVGPU *_yuvOverlay;
+#endif
+
+	/**
+	 * Whether the YUV overlay is drawn above the game screen.
+	 */
+	bool _yuvOverlayVisible;
+
+	/**
+	 * Position of the YUV overlay in game screen coordinates.
+	 */
+	Common::Point _yuvOverlayPos;
+
 	//
 	// Cursor
 	//
@@ -23,12 +23,13 @@
 #include "backends/graphics/opengl/shader.h"
 #include "backends/graphics/opengl/framebuffer.h"
 #include "graphics/opengl/debug.h"
+#include "graphics/opengl/shader.h"
 
 namespace OpenGL {
 
 #if !USE_FORCED_GLES
-CLUT8LookUpPipeline::CLUT8LookUpPipeline()
-	: ShaderPipeline(ShaderMan.query(ShaderManager::kCLUT8LookUp)), _paletteTexture(nullptr) {
+CLUT8LookUpPipeline::CLUT8LookUpPipeline(ShaderManager::ShaderUsage shader)
+	: ShaderPipeline(ShaderMan.query(shader)), _paletteTexture(nullptr) {
 }
 
 void CLUT8LookUpPipeline::drawTextureInternal(const Texture &texture, const GLfloat *coordinates, const GLfloat *texcoords) {
@@ -40,6 +41,10 @@ void CLUT8LookUpPipeline::drawTextureInternal(const Texture &texture, const GLfl
 		_paletteTexture->bind();
 	}
 
+	// The scaler shaders need to know where the source pixels are.
+	_activeShader->setUniform("textureSize", Math::Vector2d(texture.getWidth(), texture.getHeight()));
+	_activeShader->setUniform("sourceSize", Math::Vector2d(texture.getLogicalWidth(), texture.getLogicalHeight()));
+
 	GL_CALL(glActiveTexture(GL_TEXTURE0));
 	ShaderPipeline::drawTextureInternal(texture, coordinates, texcoords);
 }
@@ -23,13 +23,18 @@
 #define BACKENDS_GRAPHICS_OPENGL_PIPELINES_CLUT8_H
 
 #include "backends/graphics/opengl/pipelines/shader.h"
+#include "backends/graphics/opengl/shader.h"
 
 namespace OpenGL {
 
 #if !USE_FORCED_GLES
 class CLUT8LookUpPipeline : public ShaderPipeline {
 public:
-	CLUT8LookUpPipeline();
+	/**
+	 * @param shader The CLUT8 shader to use, which may also scale the image
+	 *               when drawing it bigger than the source texture.
+	 */
+	CLUT8LookUpPipeline(ShaderManager::ShaderUsage shader = ShaderManager::kCLUT8LookUp);
 
 	void setPaletteTexture(const Texture *paletteTexture) { _paletteTexture = paletteTexture; }
 
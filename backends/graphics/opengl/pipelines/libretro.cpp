@@ -202,7 +202,8 @@ protected:
 LibRetroPipeline::LibRetroPipeline()
 	: _inputPipeline(ShaderMan.query(ShaderManager::kDefault)),
 	  _outputPipeline(ShaderMan.query(ShaderManager::kDefault)),
-	  _needsScaling(false), _shaderPreset(nullptr), _linearFiltering(false),
+	  _needsScaling(false), _reuseOutput(false), _hasOutput(false),
+	  _shaderPreset(nullptr), _linearFiltering(false),
 	  _currentTarget(uint(-1)), _inputWidth(0), _inputHeight(0),
 	  _isAnimated(false), _frameCount(0) {
 }
@@ -234,6 +235,11 @@ void LibRetroPipeline::drawTextureInternal(const Texture &texture, const GLfloat
 		return;
 	}
 
+	// Nothing to draw: the input would be the same as the last time
+	if (_reuseOutput) {
+		return;
+	}
+
 	// Disable linear filtering: we apply it after merging all to be scaled surfaces
 	setLinearFiltering(texture.getGLTexture(), false);
 
@@ -254,9 +260,11 @@ void LibRetroPipeline::drawTextureInternal(const Texture &texture, const GLfloat
 	}
 }
 
-void LibRetroPipeline::beginScaling() {
+void LibRetroPipeline::beginScaling(bool inputChanged) {
 	if (_shaderPreset != nullptr) {
 		_needsScaling = true;
+		// Animated presets change their output even with the same input
+		_reuseOutput = !inputChanged && !_isAnimated && _hasOutput;
 		_inputTargets[_currentTarget].getTexture()->enableLinearFiltering(_linearFiltering);
 	}
 }
@@ -269,19 +277,22 @@ void LibRetroPipeline::finishScaling() {
 	/* As we have now finished to render everything in the input pipeline
 	 * we can do the render through all libretro passes */
 
-	// Now we can actually draw the texture with the setup passes.
-	for (PassArray::const_iterator i = _passes.begin(), end = _passes.end(); i != end; ++i) {
-		renderPass(*i);
-	}
+	if (!_reuseOutput) {
+		// Now we can actually draw the texture with the setup passes.
+		for (PassArray::const_iterator i = _passes.begin(), end = _passes.end(); i != end; ++i) {
+			renderPass(*i);
+		}
+		_hasOutput = true;
 
-	// Prepare for the next frame
-	_frameCount++;
+		// Prepare for the next frame
+		_frameCount++;
 
-	_currentTarget++;
-	if (_currentTarget >= _inputTargets.size()) {
-		_currentTarget = 0;
+		_currentTarget++;
+		if (_currentTarget >= _inputTargets.size()) {
+			_currentTarget = 0;
+		}
+		_passes[0].inputTexture = _inputTargets[_currentTarget].getTexture();
 	}
-	_passes[0].inputTexture = _inputTargets[_currentTarget].getTexture();
 
 	// Clear the output buffer.
 	_activeFramebuffer->activate(this);
@@ -312,6 +323,7 @@ void LibRetroPipeline::finishScaling() {
 	_outputPipeline.drawTexture(*_passes[_passes.size() - 1].target->getTexture(), coordinates);
 
 	_needsScaling = false;
+	_reuseOutput = false;
 }
 
 void LibRetroPipeline::setDisplaySizes(uint inputWidth, uint inputHeight, const Common::Rect &outputRect) {
@@ -388,6 +400,8 @@ void LibRetroPipeline::close() {
 
 	_isAnimated = false;
 	_needsScaling = false;
+	_reuseOutput = false;
+	_hasOutput = false;
 
 	_inputTargets.resize(0);
 	_currentTarget = uint(-1);
@@ -632,6 +646,9 @@ bool LibRetroPipeline::loadPasses(Common::SearchSet &archSet) {
 }
 
 void LibRetroPipeline::setPipelineState() {
+	// The passes need to be rendered again at the new sizes
+	_hasOutput = false;
+
 	// Setup FBO sizes, we require this to be able to set all uniform values.
 	setupFBOs();
 
@@ -59,11 +59,18 @@ public:
 	void close();
 
 	/* Called by OpenGLGraphicsManager */
-	void enableLinearFiltering(bool enabled) { _linearFiltering = enabled; }
+	void enableLinearFiltering(bool enabled) {
+		if (enabled != _linearFiltering) {
+			_hasOutput = false;
+		}
+		_linearFiltering = enabled;
+	}
 	/* Called by OpenGLGraphicsManager to setup the internal objects sizes */
 	void setDisplaySizes(uint inputWidth, uint inputHeight, const Common::Rect &outputRect);
-	/* Called by OpenGLGraphicsManager to indicate that next draws need to be scaled. */
-	void beginScaling();
+	/* Called by OpenGLGraphicsManager to indicate that next draws need to be scaled.
+	 * When inputChanged is false, the next draws are the same as the previous ones
+	 * and the output of the last scaling may be used again instead. */
+	void beginScaling(bool inputChanged = true);
 	/* Called by OpenGLGraphicsManager to indicate that next draws don't need to be scaled.
 	 * This must be called to execute scaling. */
 	void finishScaling();
@@ -93,6 +100,10 @@ private:
 	ShaderPipeline _inputPipeline;
 	ShaderPipeline _outputPipeline;
 	bool _needsScaling;
+	/* Whether the passes output from the previous frame is used for this one */
+	bool _reuseOutput;
+	/* Whether the last pass target holds a frame for the current sizes */
+	bool _hasOutput;
 
 	const LibRetro::ShaderPreset *_shaderPreset;
 
@@ -0,0 +1,69 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "backends/graphics/opengl/pipelines/yuv.h"
+#include "backends/graphics/opengl/shader.h"
+#include "graphics/opengl/debug.h"
+#include "graphics/opengl/shader.h"
+#include "graphics/opengl/texture.h"
+
+namespace OpenGL {
+
+#if !USE_FORCED_GLES
+YUVToRGBPipeline::YUVToRGBPipeline()
+	: ShaderPipeline(ShaderMan.query(ShaderManager::kYUVToRGB)), _uTexture(nullptr), _vTexture(nullptr),
+	  _shiftX(1), _shiftY(1), _itu(true) {
+}
+
+void YUVToRGBPipeline::setChromaLayout(int shiftX, int shiftY, bool itu) {
+	_shiftX = shiftX;
+	_shiftY = shiftY;
+	_itu = itu;
+}
+
+void YUVToRGBPipeline::drawTextureInternal(const Texture &texture, const GLfloat *coordinates, const GLfloat *texcoords) {
+	assert(isActive() && _uTexture && _vTexture);
+
+	GL_CALL(glActiveTexture(GL_TEXTURE1));
+	_uTexture->bind();
+	GL_CALL(glActiveTexture(GL_TEXTURE2));
+	_vTexture->bind();
+
+	// The textures may be padded differently, so map the luminance texture
+	// coordinates to the chroma ones.
+	_activeShader->setUniform("chromaScale", Math::Vector2d(
+		(float)texture.getWidth() / ((1 << _shiftX) * _uTexture->getWidth()),
+		(float)texture.getHeight() / ((1 << _shiftY) * _uTexture->getHeight())));
+
+	if (_itu) {
+		_activeShader->setUniform1f("lumaMin", 16.0f / 255.0f);
+		_activeShader->setUniform1f("lumaMax", 235.0f / 255.0f);
+	} else {
+		_activeShader->setUniform1f("lumaMin", 0.0f);
+		_activeShader->setUniform1f("lumaMax", 1.0f);
+	}
+
+	GL_CALL(glActiveTexture(GL_TEXTURE0));
+	ShaderPipeline::drawTextureInternal(texture, coordinates, texcoords);
+}
+#endif // !USE_FORCED_GLES
+
+} // End of namespace OpenGL
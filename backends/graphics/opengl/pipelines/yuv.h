@@ -0,0 +1,61 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BACKENDS_GRAPHICS_OPENGL_PIPELINES_YUV_H
+#define BACKENDS_GRAPHICS_OPENGL_PIPELINES_YUV_H
+
+#include "backends/graphics/opengl/pipelines/shader.h"
+
+namespace OpenGL {
+
+#if !USE_FORCED_GLES
+/**
+ * Converts a luminance texture and two chroma textures to RGB. The chroma
+ * textures are bound to texture units 1 and 2 while drawing the luminance
+ * texture.
+ */
+class YUVToRGBPipeline : public ShaderPipeline {
+public:
+	YUVToRGBPipeline();
+
+	void setChromaTextures(const Texture *uTexture, const Texture *vTexture) { _uTexture = uTexture; _vTexture = vTexture; }
+
+	/**
+	 * @param shiftX, shiftY The subsampling of the chroma planes.
+	 * @param itu            Whether the luminance values range from [16, 235].
+	 */
+	void setChromaLayout(int shiftX, int shiftY, bool itu);
+
+protected:
+	void drawTextureInternal(const Texture &texture, const GLfloat *coordinates, const GLfloat *texcoords) override;
+
+private:
+	const Texture *_uTexture;
+	const Texture *_vTexture;
+
+	int _shiftX, _shiftY;
+	bool _itu;
+};
+#endif // !USE_FORCED_GLES
+
+} // End of namespace OpenGL
+
+#endif
@@ -78,6 +78,165 @@ const char *const g_lookUpFragmentShader =
 	"\tgl_FragColor = blendColor * texture2D(palette, vec2(index.a * adjustFactor, 0.0));\n"
 	"}\n";
 
+// Shared part of the CLUT8 scaler shaders. srcPos is the source pixel being
+// scaled, neighbors are clamped to the edges of the image.
+#define CLUT8_SCALER_FRAGMENT_HEADER \
+	"varying vec2 texCoord;\n" \
+	"varying vec4 blendColor;\n" \
+	"\n" \
+	"uniform sampler2D shaderTexture;\n" \
+	"uniform sampler2D palette;\n" \
+	"uniform vec2 textureSize;\n" \
+	"uniform vec2 sourceSize;\n" \
+	"\n" \
+	"const float adjustFactor = 255.0 / 256.0 + 1.0 / (2.0 * 256.0);\n" \
+	"\n" \
+	"vec2 srcPos;\n" \
+	"\n" \
+	"vec4 fetch(float dx, float dy) {\n" \
+	"\tvec2 pos = clamp(srcPos + vec2(dx, dy), vec2(0.0), sourceSize - 1.0);\n" \
+	"\tfloat index = texture2D(shaderTexture, (pos + 0.5) / textureSize).a;\n" \
+	"\treturn texture2D(palette, vec2(index * adjustFactor, 0.0));\n" \
+	"}\n" \
+	"\n"
+
+const char *const g_scale2xFragmentShader =
+	CLUT8_SCALER_FRAGMENT_HEADER
+	"void main(void) {\n"
+	"\tvec2 pos = texCoord * textureSize;\n"
+	"\tsrcPos = floor(pos);\n"
+	"\tvec2 sub = floor(fract(pos) * 2.0);\n"
+	"\n"
+	"\tvec4 B = fetch( 0.0, -1.0);\n"
+	"\tvec4 D = fetch(-1.0,  0.0);\n"
+	"\tvec4 E = fetch( 0.0,  0.0);\n"
+	"\tvec4 F = fetch( 1.0,  0.0);\n"
+	"\tvec4 H = fetch( 0.0,  1.0);\n"
+	"\n"
+	"\tvec4 color = E;\n"
+	"\tif (B != H && D != F) {\n"
+	"\t\tvec4 horizontal = sub.x < 0.5 ? D : F;\n"
+	"\t\tvec4 vertical = sub.y < 0.5 ? B : H;\n"
+	"\t\tif (horizontal == vertical)\n"
+	"\t\t\tcolor = horizontal;\n"
+	"\t}\n"
+	"\tgl_FragColor = blendColor * color;\n"
+	"}\n";
+
+const char *const g_scale3xFragmentShader =
+	CLUT8_SCALER_FRAGMENT_HEADER
+	"void main(void) {\n"
+	"\tvec2 pos = texCoord * textureSize;\n"
+	"\tsrcPos = floor(pos);\n"
+	"\tvec2 sub = floor(fract(pos) * 3.0);\n"
+	"\n"
+	"\tvec4 A = fetch(-1.0, -1.0);\n"
+	"\tvec4 B = fetch( 0.0, -1.0);\n"
+	"\tvec4 C = fetch( 1.0, -1.0);\n"
+	"\tvec4 D = fetch(-1.0,  0.0);\n"
+	"\tvec4 E = fetch( 0.0,  0.0);\n"
+	"\tvec4 F = fetch( 1.0,  0.0);\n"
+	"\tvec4 G = fetch(-1.0,  1.0);\n"
+	"\tvec4 H = fetch( 0.0,  1.0);\n"
+	"\tvec4 I = fetch( 1.0,  1.0);\n"
+	"\n"
+	"\tvec4 color = E;\n"
+	"\tif (B != H && D != F) {\n"
+	"\t\tif (sub.y < 0.5) {\n"
+	"\t\t\tif (sub.x < 0.5) {\n"
+	"\t\t\t\tif (D == B) color = D;\n"
+	"\t\t\t} else if (sub.x < 1.5) {\n"
+	"\t\t\t\tif ((D == B && E != C) || (F == B && E != A)) color = B;\n"
+	"\t\t\t} else {\n"
+	"\t\t\t\tif (F == B) color = F;\n"
+	"\t\t\t}\n"
+	"\t\t} else if (sub.y < 1.5) {\n"
+	"\t\t\tif (sub.x < 0.5) {\n"
+	"\t\t\t\tif ((D == B && E != G) || (D == H && E != A)) color = D;\n"
+	"\t\t\t} else if (sub.x > 1.5) {\n"
+	"\t\t\t\tif ((F == B && E != I) || (F == H && E != C)) color = F;\n"
+	"\t\t\t}\n"
+	"\t\t} else {\n"
+	"\t\t\tif (sub.x < 0.5) {\n"
+	"\t\t\t\tif (D == H) color = D;\n"
+	"\t\t\t} else if (sub.x < 1.5) {\n"
+	"\t\t\t\tif ((D == H && E != I) || (F == H && E != G)) color = H;\n"
+	"\t\t\t} else {\n"
+	"\t\t\t\tif (F == H) color = F;\n"
+	"\t\t\t}\n"
+	"\t\t}\n"
+	"\t}\n"
+	"\tgl_FragColor = blendColor * color;\n"
+	"}\n";
+
+// Every second line is darkened to 7/8 of the original color.
+const char *const g_tvFragmentShader =
+	CLUT8_SCALER_FRAGMENT_HEADER
+	"void main(void) {\n"
+	"\tvec2 pos = texCoord * textureSize;\n"
+	"\tsrcPos = floor(pos);\n"
+	"\n"
+	"\tvec4 color = fetch(0.0, 0.0);\n"
+	"\tif (fract(pos.y) >= 0.5)\n"
+	"\t\tcolor.rgb = floor(floor(color.rgb * 255.0 + 0.5) * 7.0 / 8.0) / 255.0;\n"
+	"\tgl_FragColor = blendColor * color;\n"
+	"}\n";
+
+// Channels selected by a 4x4 pattern over the output pixels lose a quarter
+// of their intensity.
+const char *const g_dotMatrixFragmentShader =
+	CLUT8_SCALER_FRAGMENT_HEADER
+	"void main(void) {\n"
+	"\tvec2 pos = texCoord * textureSize;\n"
+	"\tsrcPos = floor(pos);\n"
+	"\tvec2 dst = mod(srcPos * 2.0 + floor(fract(pos) * 2.0), 4.0);\n"
+	"\tfloat cell = dst.y * 4.0 + dst.x;\n"
+	"\n"
+	"\tvec3 mask = vec3(0.0);\n"
+	"\tif (cell == 0.0 || cell == 10.0)\n"
+	"\t\tmask = vec3(0.0, 1.0, 0.0);\n"
+	"\telse if (cell == 1.0 || cell == 11.0)\n"
+	"\t\tmask = vec3(0.0, 0.0, 1.0);\n"
+	"\telse if (cell == 2.0 || cell == 8.0)\n"
+	"\t\tmask = vec3(1.0, 0.0, 0.0);\n"
+	"\telse if (cell == 4.0 || cell == 6.0 || cell == 12.0 || cell == 14.0)\n"
+	"\t\tmask = vec3(1.0);\n"
+	"\n"
+	"\tvec4 color = fetch(0.0, 0.0);\n"
+	"\tvec3 value = floor(color.rgb * 255.0 + 0.5);\n"
+	"\tcolor.rgb = (value - floor(value / 4.0) * mask) / 255.0;\n"
+	"\tgl_FragColor = blendColor * color;\n"
+	"}\n";
+
+#undef CLUT8_SCALER_FRAGMENT_HEADER
+
+// Same conversion as Graphics::YUVToRGBManager. ITU-R luminance values are
+// clipped and stretched to the full range after adding the chroma.
+const char *const g_yuvToRGBFragmentShader =
+	"varying vec2 texCoord;\n"
+	"varying vec4 blendColor;\n"
+	"\n"
+	"uniform sampler2D shaderTexture;\n"
+	"uniform sampler2D uTexture;\n"
+	"uniform sampler2D vTexture;\n"
+	"uniform vec2 chromaScale;\n"
+	"uniform float lumaMin;\n"
+	"uniform float lumaMax;\n"
+	"\n"
+	"const float chromaOffset = 128.0 / 255.0;\n"
+	"\n"
+	"void main(void) {\n"
+	"\tfloat y = texture2D(shaderTexture, texCoord).a;\n"
+	"\tfloat u = texture2D(uTexture, texCoord * chromaScale).a - chromaOffset;\n"
+	"\tfloat v = texture2D(vTexture, texCoord * chromaScale).a - chromaOffset;\n"
+	"\n"
+	"\tvec3 rgb = vec3(y + 1.4013377926 * v,\n"
+	"\t                y - 0.7136038186 * v - 0.3444108761 * u,\n"
+	"\t                y + 1.7734138973 * u);\n"
+	"\trgb = (clamp(rgb, lumaMin, lumaMax) - lumaMin) / (lumaMax - lumaMin);\n"
+	"\tgl_FragColor = blendColor * vec4(rgb, 1.0);\n"
+	"}\n";
+
 } // End of anonymous namespace
 
 ShaderManager::ShaderManager() {
@@ -106,6 +265,17 @@ void ShaderManager::notifyCreate() {
 	_builtIn[kDefault] = Shader::fromStrings("default", g_defaultVertexShader, g_defaultFragmentShader, g_defaultShaderAttributes, 110);
 	_builtIn[kCLUT8LookUp] = Shader::fromStrings("clut8lookup", g_defaultVertexShader, g_lookUpFragmentShader, g_defaultShaderAttributes, 110);
 	_builtIn[kCLUT8LookUp]->setUniform("palette", 1);
+	_builtIn[kCLUT8Scale2x] = Shader::fromStrings("clut8scale2x", g_defaultVertexShader, g_scale2xFragmentShader, g_defaultShaderAttributes, 110);
+	_builtIn[kCLUT8Scale2x]->setUniform("palette", 1);
+	_builtIn[kCLUT8Scale3x] = Shader::fromStrings("clut8scale3x", g_defaultVertexShader, g_scale3xFragmentShader, g_defaultShaderAttributes, 110);
+	_builtIn[kCLUT8Scale3x]->setUniform("palette", 1);
+	_builtIn[kCLUT8TV] = Shader::fromStrings("clut8tv", g_defaultVertexShader, g_tvFragmentShader, g_defaultShaderAttributes, 110);
+	_builtIn[kCLUT8TV]->setUniform("palette", 1);
+	_builtIn[kCLUT8DotMatrix] = Shader::fromStrings("clut8dotmatrix", g_defaultVertexShader, g_dotMatrixFragmentShader, g_defaultShaderAttributes, 110);
+	_builtIn[kCLUT8DotMatrix]->setUniform("palette", 1);
+	_builtIn[kYUVToRGB] = Shader::fromStrings("yuvtorgb", g_defaultVertexShader, g_yuvToRGBFragmentShader, g_defaultShaderAttributes, 110);
+	_builtIn[kYUVToRGB]->setUniform("uTexture", 1);
+	_builtIn[kYUVToRGB]->setUniform("vTexture", 2);
 
 	for (uint i = 0; i < kMaxUsages; ++i) {
 		_builtIn[i]->setUniform("shaderTexture", 0);
@@ -41,6 +41,15 @@ public:
 		/** CLUT8 look up shader. */
 		kCLUT8LookUp,
 
+		/** CLUT8 look up shaders which also scale, like the scaler plugins. */
+		kCLUT8Scale2x,
+		kCLUT8Scale3x,
+		kCLUT8TV,
+		kCLUT8DotMatrix,
+
+		/** YUV to RGB conversion shader. */
+		kYUVToRGB,
+
 		/** Number of built-in shaders. Should not be used for query. */
 		kMaxUsages
 	};
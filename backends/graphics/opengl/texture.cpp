@@ -23,6 +23,7 @@
 #include "backends/graphics/opengl/shader.h"
 #include "backends/graphics/opengl/pipelines/pipeline.h"
 #include "backends/graphics/opengl/pipelines/clut8.h"
+#include "backends/graphics/opengl/pipelines/yuv.h"
 #include "backends/graphics/opengl/framebuffer.h"
 #include "graphics/opengl/debug.h"
 
@@ -32,6 +33,7 @@
 #include "common/textconsole.h"
 
 #include "graphics/blit.h"
+#include "graphics/yuv_to_rgb.h"
 
 #ifdef USE_SCALERS
 #include "graphics/scalerplugin.h"
@@ -44,7 +46,7 @@ namespace OpenGL {
 //
 
 Surface::Surface()
-	: _allDirty(false), _dirtyArea() {
+	: _allDirty(false), _dirtyAreas() {
 }
 
 void Surface::copyRectToTexture(uint x, uint y, uint w, uint h, const void *srcPtr, uint srcPitch) {
@@ -85,23 +87,77 @@ void Surface::fill(const Common::Rect &r, uint32 color) {
 }
 
 void Surface::addDirtyArea(const Common::Rect &r) {
-	// *sigh* Common::Rect::extend behaves unexpected whenever one of the two
-	// parameters is an empty rect. Thus, we check whether the current dirty
-	// area is valid. In case it is not we simply use the parameters as new
-	// dirty area. Otherwise, we simply call extend.
-	if (_dirtyArea.isEmpty()) {
-		_dirtyArea = r;
-	} else {
-		_dirtyArea.extend(r);
+	if (_allDirty || r.isEmpty()) {
+		return;
+	}
+
+	// Absorb all areas which are cheaper to upload together with the new
+	// one. The grown area may now be worth merging with areas already
+	// checked, so start over in that case.
+	Common::Rect area = r;
+	for (uint i = 0; i < _dirtyAreas.size();) {
+		if (getMergeCost(area, _dirtyAreas[i]) <= kDirtyAreaUploadCost) {
+			area.extend(_dirtyAreas[i]);
+			_dirtyAreas.remove_at(i);
+			i = 0;
+		} else {
+			++i;
+		}
+	}
+
+	_dirtyAreas.push_back(area);
+
+	if (_dirtyAreas.size() <= kMaxDirtyAreas) {
+		return;
+	}
+
+	// Too many areas, merge the two which waste the fewest pixels.
+	uint best1 = 0, best2 = 1;
+	int bestCost = getMergeCost(_dirtyAreas[0], _dirtyAreas[1]);
+	for (uint i = 0; i < _dirtyAreas.size(); ++i) {
+		for (uint j = i + 1; j < _dirtyAreas.size(); ++j) {
+			const int cost = getMergeCost(_dirtyAreas[i], _dirtyAreas[j]);
+			if (cost < bestCost) {
+				bestCost = cost;
+				best1 = i;
+				best2 = j;
+			}
+		}
+	}
+
+	_dirtyAreas[best1].extend(_dirtyAreas[best2]);
+	_dirtyAreas.remove_at(best2);
+}
+
+int Surface::getMergeCost(const Common::Rect &r1, const Common::Rect &r2) const {
+	// Without sub-image uploads whole texture lines are uploaded, so areas
+	// sharing a line are always worth merging.
+	if (!OpenGLContext.unpackSubImageSupported) {
+		if (r1.top < r2.bottom && r2.top < r1.bottom) {
+			return 0;
+		}
+
+		return (MAX(r1.bottom, r2.bottom) - MIN(r1.top, r2.top) - r1.height() - r2.height()) * getWidth();
+	}
+
+	// Overlapping areas are always merged, so that the same pixels never
+	// get converted and uploaded twice.
+	if (r1.intersects(r2)) {
+		return 0;
 	}
+
+	Common::Rect merged = r1;
+	merged.extend(r2);
+
+	return merged.width() * merged.height() - r1.width() * r1.height() - r2.width() * r2.height();
 }
 
-Common::Rect Surface::getDirtyArea() const {
+Common::Array<Common::Rect> Surface::getDirtyAreas() const {
 	if (_allDirty) {
-		return Common::Rect(getWidth(), getHeight());
-	} else {
-		return _dirtyArea;
+		return Common::Array<Common::Rect>(1, Common::Rect(getWidth(), getHeight()));
 	}
+
+	return _dirtyAreas;
 }
 
 //
@@ -161,12 +217,16 @@ void TextureSurface::updateGLTexture() {
 		return;
 	}
 
-	Common::Rect dirtyArea = getDirtyArea();
+	Common::Array<Common::Rect> dirtyAreas = getDirtyAreas();
+	for (uint i = 0; i < dirtyAreas.size(); ++i) {
+		updateGLTextureArea(dirtyAreas[i]);
+	}
 
-	updateGLTexture(dirtyArea);
+	// We should have handled everything, thus not dirty anymore.
+	clearDirty();
 }
 
-void TextureSurface::updateGLTexture(Common::Rect &dirtyArea) {
+void TextureSurface::updateGLTextureArea(Common::Rect &dirtyArea) {
 	// In case we use linear filtering we might need to duplicate the last
 	// pixel row/column to avoid glitches with filtering.
 	if (_glTexture.isLinearFilteringEnabled()) {
@@ -197,9 +257,6 @@ void TextureSurface::updateGLTexture(Common::Rect &dirtyArea) {
 	}
 
 	_glTexture.updateArea(dirtyArea, _textureData);
-
-	// We should have handled everything, thus not dirty anymore.
-	clearDirty();
 }
 
 FakeTextureSurface::FakeTextureSurface(GLenum glIntFormat, GLenum glFormat, GLenum glType, const Graphics::PixelFormat &format, const Graphics::PixelFormat &fakeFormat)
@@ -281,12 +338,15 @@ void FakeTextureSurface::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = TextureSurface::getSurface();
 
-	const Common::Rect dirtyArea = getDirtyArea();
+	const Common::Array<Common::Rect> dirtyAreas = getDirtyAreas();
+	for (uint i = 0; i < dirtyAreas.size(); ++i) {
+		const Common::Rect &dirtyArea = dirtyAreas[i];
 
-	byte *dst = (byte *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
-	const byte *src = (const byte *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+		byte *dst = (byte *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
+		const byte *src = (const byte *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
 
-	applyPaletteAndMask(dst, src, outSurf->pitch, _rgbData.pitch, _rgbData.w, dirtyArea, outSurf->format, _rgbData.format);
+		applyPaletteAndMask(dst, src, outSurf->pitch, _rgbData.pitch, _rgbData.w, dirtyArea, outSurf->format, _rgbData.format);
+	}
 
 	// Do generic handling of updating the texture.
 	TextureSurface::updateGLTexture();
@@ -338,25 +398,28 @@ void TextureSurfaceRGB555::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = TextureSurface::getSurface();
 
-	const Common::Rect dirtyArea = getDirtyArea();
+	const Common::Array<Common::Rect> dirtyAreas = getDirtyAreas();
+	for (uint i = 0; i < dirtyAreas.size(); ++i) {
+		const Common::Rect &dirtyArea = dirtyAreas[i];
 
-	uint16 *dst = (uint16 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint dstAdd = outSurf->pitch - 2 * dirtyArea.width();
+		uint16 *dst = (uint16 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint dstAdd = outSurf->pitch - 2 * dirtyArea.width();
 
-	const uint16 *src = (const uint16 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint srcAdd = _rgbData.pitch - 2 * dirtyArea.width();
+		const uint16 *src = (const uint16 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint srcAdd = _rgbData.pitch - 2 * dirtyArea.width();
 
-	for (int height = dirtyArea.height(); height > 0; --height) {
-		for (int width = dirtyArea.width(); width > 0; --width) {
-			const uint16 color = *src++;
+		for (int height = dirtyArea.height(); height > 0; --height) {
+			for (int width = dirtyArea.width(); width > 0; --width) {
+				const uint16 color = *src++;
 
-			*dst++ =   ((color & 0x7C00) << 1)                             // R
-			         | (((color & 0x03E0) << 1) | ((color & 0x0200) >> 4)) // G
-			         | (color & 0x001F);                                   // B
-		}
+				*dst++ =   ((color & 0x7C00) << 1)                             // R
+				         | (((color & 0x03E0) << 1) | ((color & 0x0200) >> 4)) // G
+				         | (color & 0x001F);                                   // B
+			}
 
-		src = (const uint16 *)((const byte *)src + srcAdd);
-		dst = (uint16 *)((byte *)dst + dstAdd);
+			src = (const uint16 *)((const byte *)src + srcAdd);
+			dst = (uint16 *)((byte *)dst + dstAdd);
+		}
 	}
 
 	// Do generic handling of updating the texture.
@@ -380,23 +443,26 @@ void TextureSurfaceRGBA8888Swap::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = TextureSurface::getSurface();
 
-	const Common::Rect dirtyArea = getDirtyArea();
+	const Common::Array<Common::Rect> dirtyAreas = getDirtyAreas();
+	for (uint i = 0; i < dirtyAreas.size(); ++i) {
+		const Common::Rect &dirtyArea = dirtyAreas[i];
 
-	uint32 *dst = (uint32 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint dstAdd = outSurf->pitch - 4 * dirtyArea.width();
+		uint32 *dst = (uint32 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint dstAdd = outSurf->pitch - 4 * dirtyArea.width();
 
-	const uint32 *src = (const uint32 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint srcAdd = _rgbData.pitch - 4 * dirtyArea.width();
+		const uint32 *src = (const uint32 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint srcAdd = _rgbData.pitch - 4 * dirtyArea.width();
 
-	for (int height = dirtyArea.height(); height > 0; --height) {
-		for (int width = dirtyArea.width(); width > 0; --width) {
-			const uint32 color = *src++;
+		for (int height = dirtyArea.height(); height > 0; --height) {
+			for (int width = dirtyArea.width(); width > 0; --width) {
+				const uint32 color = *src++;
 
-			*dst++ = SWAP_BYTES_32(color);
-		}
+				*dst++ = SWAP_BYTES_32(color);
+			}
 
-		src = (const uint32 *)((const byte *)src + srcAdd);
-		dst = (uint32 *)((byte *)dst + dstAdd);
+			src = (const uint32 *)((const byte *)src + srcAdd);
+			dst = (uint32 *)((byte *)dst + dstAdd);
+		}
 	}
 
 	// Do generic handling of updating the texture.
@@ -444,11 +510,19 @@ void ScaledTextureSurface::updateGLTexture() {
 		return;
 	}
 
+	Common::Array<Common::Rect> dirtyAreas = getDirtyAreas();
+	for (uint i = 0; i < dirtyAreas.size(); ++i) {
+		updateScaledArea(dirtyAreas[i]);
+	}
+
+	// We should have handled everything, thus not dirty anymore.
+	clearDirty();
+}
+
+void ScaledTextureSurface::updateScaledArea(Common::Rect &dirtyArea) {
 	// Convert color space.
 	Graphics::Surface *outSurf = TextureSurface::getSurface();
 
-	Common::Rect dirtyArea = getDirtyArea();
-
 	// Extend the dirty region for scalers
 	// that "smear" the screen, e.g. 2xSAI
 	dirtyArea.grow(_extraPixels);
@@ -486,7 +560,7 @@ void ScaledTextureSurface::updateGLTexture() {
 	dirtyArea.bottom *= _scaleFactor;
 
 	// Do generic handling of updating the texture.
-	TextureSurface::updateGLTexture(dirtyArea);
+	TextureSurface::updateGLTextureArea(dirtyArea);
 }
 
 void ScaledTextureSurface::setScaler(uint scalerIndex, int scaleFactor) {
@@ -520,16 +594,13 @@ void ScaledTextureSurface::setScaler(uint scalerIndex, int scaleFactor) {
 TextureSurfaceCLUT8GPU::TextureSurfaceCLUT8GPU()
 	: _clut8Texture(GL_ALPHA, GL_ALPHA, GL_UNSIGNED_BYTE),
 	  _paletteTexture(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE),
-	  _target(new TextureTarget()), _clut8Pipeline(new CLUT8LookUpPipeline()),
+	  _target(new TextureTarget()), _clut8Pipeline(nullptr),
 	  _clut8Vertices(), _clut8Data(), _userPixelData(), _palette(),
-	  _paletteDirty(false) {
+	  _paletteDirty(false), _scalerShader(ShaderManager::kCLUT8LookUp), _scaleFactor(1) {
 	// Allocate space for 256 colors.
 	_paletteTexture.setSize(256, 1);
 
-	// Setup pipeline.
-	_clut8Pipeline->setFramebuffer(_target);
-	_clut8Pipeline->setPaletteTexture(&_paletteTexture);
-	_clut8Pipeline->setColor(1.0f, 1.0f, 1.0f, 1.0f);
+	createPipeline();
 }
 
 TextureSurfaceCLUT8GPU::~TextureSurfaceCLUT8GPU() {
@@ -559,14 +630,18 @@ void TextureSurfaceCLUT8GPU::recreate() {
 	}
 
 	if (_clut8Pipeline == nullptr) {
-		_clut8Pipeline = new CLUT8LookUpPipeline();
-		// Setup pipeline.
-		_clut8Pipeline->setFramebuffer(_target);
-		_clut8Pipeline->setPaletteTexture(&_paletteTexture);
-		_clut8Pipeline->setColor(1.0f, 1.0f, 1.0f, 1.0f);
+		createPipeline();
 	}
 }
 
+void TextureSurfaceCLUT8GPU::createPipeline() {
+	_clut8Pipeline = new CLUT8LookUpPipeline(_scalerShader);
+	// Setup pipeline.
+	_clut8Pipeline->setFramebuffer(_target);
+	_clut8Pipeline->setPaletteTexture(&_paletteTexture);
+	_clut8Pipeline->setColor(1.0f, 1.0f, 1.0f, 1.0f);
+}
+
 void TextureSurfaceCLUT8GPU::enableLinearFiltering(bool enable) {
 	_target->getTexture()->enableLinearFiltering(enable);
 }
@@ -574,7 +649,7 @@ void TextureSurfaceCLUT8GPU::enableLinearFiltering(bool enable) {
 void TextureSurfaceCLUT8GPU::allocate(uint width, uint height) {
 	// Assure the texture can contain our user data.
 	_clut8Texture.setSize(width, height);
-	_target->setSize(width, height, Common::kRotationNormal);
+	_target->setSize(width * _scaleFactor, height * _scaleFactor, Common::kRotationNormal);
 
 	// In case the needed texture dimension changed we will reinitialize the
 	// texture data buffer.
@@ -590,14 +665,14 @@ void TextureSurfaceCLUT8GPU::allocate(uint width, uint height) {
 	_clut8Vertices[0] = 0;
 	_clut8Vertices[1] = 0;
 
-	_clut8Vertices[2] = width;
+	_clut8Vertices[2] = width * _scaleFactor;
 	_clut8Vertices[3] = 0;
 
 	_clut8Vertices[4] = 0;
-	_clut8Vertices[5] = height;
+	_clut8Vertices[5] = height * _scaleFactor;
 
-	_clut8Vertices[6] = width;
-	_clut8Vertices[7] = height;
+	_clut8Vertices[6] = width * _scaleFactor;
+	_clut8Vertices[7] = height * _scaleFactor;
 
 	// The whole texture is dirty after we changed the size. This fixes
 	// multiple texture size changes without any actual update in between.
@@ -646,7 +721,10 @@ void TextureSurfaceCLUT8GPU::updateGLTexture() {
 
 	// Update CLUT8 texture if necessary.
 	if (Surface::isDirty()) {
-		_clut8Texture.updateArea(getDirtyArea(), _clut8Data);
+		const Common::Array<Common::Rect> dirtyAreas = getDirtyAreas();
+		for (uint i = 0; i < dirtyAreas.size(); ++i) {
+			_clut8Texture.updateArea(dirtyAreas[i], _clut8Data);
+		}
 		clearDirty();
 	}
 
@@ -671,6 +749,46 @@ void TextureSurfaceCLUT8GPU::updateGLTexture() {
 	}
 }
 
+#ifdef USE_SCALERS
+bool TextureSurfaceCLUT8GPU::getScalerShader(uint scalerIndex, int scaleFactor, ShaderManager::ShaderUsage &shader) {
+	const ScalerPluginObject &scalerPlugin = ScalerMan.getPlugins()[scalerIndex]->get<ScalerPluginObject>();
+	const Common::String name = scalerPlugin.getName();
+
+	if (name == "normal") {
+		// Drawing to the bigger target with nearest filtering does the job
+		shader = ShaderManager::kCLUT8LookUp;
+	} else if (name == "advmame" && scaleFactor == 2) {
+		shader = ShaderManager::kCLUT8Scale2x;
+	} else if (name == "advmame" && scaleFactor == 3) {
+		shader = ShaderManager::kCLUT8Scale3x;
+	} else if (name == "tv" && scaleFactor == 2) {
+		shader = ShaderManager::kCLUT8TV;
+	} else if (name == "dotmatrix" && scaleFactor == 2) {
+		shader = ShaderManager::kCLUT8DotMatrix;
+	} else {
+		return false;
+	}
+
+	return true;
+}
+
+bool TextureSurfaceCLUT8GPU::hasScaler(uint scalerIndex, int scaleFactor) {
+	ShaderManager::ShaderUsage shader;
+	return getScalerShader(scalerIndex, scaleFactor, shader);
+}
+
+void TextureSurfaceCLUT8GPU::setScaler(uint scalerIndex, int scaleFactor) {
+	if (!getScalerShader(scalerIndex, scaleFactor, _scalerShader)) {
+		warning("OpenGL: Scaler %d is not available for CLUT8 look up", scalerIndex);
+		_scalerShader = ShaderManager::kCLUT8LookUp;
+	}
+	_scaleFactor = scaleFactor;
+
+	delete _clut8Pipeline;
+	createPipeline();
+}
+#endif
+
 void TextureSurfaceCLUT8GPU::lookUpColors() {
 	// Setup pipeline to do color look up.
 	_clut8Pipeline->activate();
@@ -680,6 +798,105 @@ void TextureSurfaceCLUT8GPU::lookUpColors() {
 
 	_clut8Pipeline->deactivate();
 }
+
+TextureYUVGPU::TextureYUVGPU()
+	: _yTexture(GL_ALPHA, GL_ALPHA, GL_UNSIGNED_BYTE),
+	  _uTexture(GL_ALPHA, GL_ALPHA, GL_UNSIGNED_BYTE),
+	  _vTexture(GL_ALPHA, GL_ALPHA, GL_UNSIGNED_BYTE),
+	  _target(new TextureTarget()), _pipeline(nullptr), _width(0), _height(0) {
+	// A new image is uploaded for every frame.
+	_yTexture.enableStreamingUpload(true);
+	_uTexture.enableStreamingUpload(true);
+	_vTexture.enableStreamingUpload(true);
+
+	createPipeline();
+}
+
+TextureYUVGPU::~TextureYUVGPU() {
+	delete _pipeline;
+	delete _target;
+}
+
+void TextureYUVGPU::destroy() {
+	_yTexture.destroy();
+	_uTexture.destroy();
+	_vTexture.destroy();
+	_target->destroy();
+	delete _pipeline;
+	_pipeline = nullptr;
+}
+
+void TextureYUVGPU::recreate() {
+	_yTexture.create();
+	_uTexture.create();
+	_vTexture.create();
+	_target->create();
+
+	if (_pipeline == nullptr) {
+		createPipeline();
+	}
+}
+
+void TextureYUVGPU::createPipeline() {
+	_pipeline = new YUVToRGBPipeline();
+	_pipeline->setFramebuffer(_target);
+	_pipeline->setChromaTextures(&_uTexture, &_vTexture);
+	_pipeline->setColor(1.0f, 1.0f, 1.0f, 1.0f);
+}
+
+void TextureYUVGPU::enableLinearFiltering(bool enable) {
+	_target->getTexture()->enableLinearFiltering(enable);
+}
+
+const Texture &TextureYUVGPU::getGLTexture() const {
+	return *_target->getTexture();
+}
+
+void TextureYUVGPU::setImage(const Graphics::YUVImage &image) {
+	assert(image.chromaShiftX <= 1 && image.chromaShiftY <= 1);
+
+	const uint uvHeight = (image.height + (1 << image.chromaShiftY) - 1) >> image.chromaShiftY;
+
+	// Upload the planes including the padding at the end of their rows, so
+	// that they can always be uploaded in one go.
+	Graphics::Surface plane;
+	_yTexture.setSize(image.yPitch, image.height);
+	plane.init(image.yPitch, image.height, image.yPitch, const_cast<byte *>(image.y), Graphics::PixelFormat::createFormatCLUT8());
+	_yTexture.updateArea(Common::Rect(image.yPitch, image.height), plane);
+
+	_uTexture.setSize(image.uvPitch, uvHeight);
+	plane.init(image.uvPitch, uvHeight, image.uvPitch, const_cast<byte *>(image.u), Graphics::PixelFormat::createFormatCLUT8());
+	_uTexture.updateArea(Common::Rect(image.uvPitch, uvHeight), plane);
+
+	_vTexture.setSize(image.uvPitch, uvHeight);
+	plane.init(image.uvPitch, uvHeight, image.uvPitch, const_cast<byte *>(image.v), Graphics::PixelFormat::createFormatCLUT8());
+	_vTexture.updateArea(Common::Rect(image.uvPitch, uvHeight), plane);
+
+	_width = image.width;
+	_height = image.height;
+	_target->setSize(_width, _height, Common::kRotationNormal);
+
+	// Only draw the image itself, without the padding.
+	const GLfloat texWidth = (GLfloat)_width / _yTexture.getWidth();
+	const GLfloat texHeight = (GLfloat)_height / _yTexture.getHeight();
+	const GLfloat texcoords[4*2] = {
+		0,        0,
+		texWidth, 0,
+		0,        texHeight,
+		texWidth, texHeight
+	};
+	const GLfloat vertices[4*2] = {
+		0,               0,
+		(GLfloat)_width, 0,
+		0,               (GLfloat)_height,
+		(GLfloat)_width, (GLfloat)_height
+	};
+
+	_pipeline->setChromaLayout(image.chromaShiftX, image.chromaShiftY, image.scale == Graphics::YUVToRGBManager::kScaleITU);
+	_pipeline->activate();
+	_pipeline->drawTexture(_yTexture, vertices, texcoords);
+	_pipeline->deactivate();
+}
 #endif // !USE_FORCED_GLES
 
 } // End of namespace OpenGL
@@ -22,6 +22,8 @@
 #ifndef BACKENDS_GRAPHICS_OPENGL_TEXTURE_H
 #define BACKENDS_GRAPHICS_OPENGL_TEXTURE_H
 
+#include "backends/graphics/opengl/shader.h"
+
 #include "graphics/opengl/system_headers.h"
 #include "graphics/opengl/context.h"
 #include "graphics/opengl/texture.h"
@@ -29,10 +31,15 @@
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
+#include "common/array.h"
 #include "common/rect.h"
 
 class Scaler;
 
+namespace Graphics {
+struct YUVImage;
+}
+
 namespace OpenGL {
 
 /**
@@ -60,6 +67,13 @@ public:
 	 */
 	virtual void enableLinearFiltering(bool enable) = 0;
 
+	/**
+	 * Enable or disable streaming uploads, for surfaces updated every frame.
+	 *
+	 * @param enable true to enable and false to disable.
+	 */
+	virtual void enableStreamingUpload(bool enable) {}
+
 	/**
 	 * Allocate storage for surface.
 	 *
@@ -99,7 +113,7 @@ public:
 	void fill(const Common::Rect &r, uint32 color);
 
 	void flagDirty() { _allDirty = true; }
-	virtual bool isDirty() const { return _allDirty || !_dirtyArea.isEmpty(); }
+	virtual bool isDirty() const { return _allDirty || !_dirtyAreas.empty(); }
 
 	virtual uint getWidth() const = 0;
 	virtual uint getHeight() const = 0;
@@ -139,13 +153,32 @@ public:
 	 */
 	virtual const Texture &getGLTexture() const = 0;
 protected:
-	void clearDirty() { _allDirty = false; _dirtyArea = Common::Rect(); }
+	void clearDirty() { _allDirty = false; _dirtyAreas.clear(); }
 
 	void addDirtyArea(const Common::Rect &r);
-	Common::Rect getDirtyArea() const;
+
+	/**
+	 * @return The areas which need to be updated. They do not overlap
+	 *         unless there were more than kMaxDirtyAreas changes.
+	 */
+	Common::Array<Common::Rect> getDirtyAreas() const;
 private:
+	/**
+	 * Maximum number of dirty areas tracked before the closest ones get
+	 * merged.
+	 */
+	static const uint kMaxDirtyAreas = 8;
+
+	/**
+	 * Approximate cost of an additional texture upload, as a number of
+	 * pixels. Areas are merged when that uploads fewer extra pixels.
+	 */
+	static const int kDirtyAreaUploadCost = 64 * 64;
+
+	int getMergeCost(const Common::Rect &r1, const Common::Rect &r2) const;
+
 	bool _allDirty;
-	Common::Rect _dirtyArea;
+	Common::Array<Common::Rect> _dirtyAreas;
 };
 
 /**
@@ -171,6 +204,8 @@ public:
 
 	void enableLinearFiltering(bool enable) override;
 
+	void enableStreamingUpload(bool enable) override { _glTexture.enableStreamingUpload(enable); }
+
 	void allocate(uint width, uint height) override;
 
 	uint getWidth() const override { return _userPixelData.w; }
@@ -189,7 +224,10 @@ public:
 protected:
 	const Graphics::PixelFormat _format;
 
-	void updateGLTexture(Common::Rect &dirtyArea);
+	/**
+	 * Upload an area of the texture data, without clearing the dirty state.
+	 */
+	void updateGLTextureArea(Common::Rect &dirtyArea);
 
 private:
 	Texture _glTexture;
@@ -263,6 +301,8 @@ public:
 
 	void setScaler(uint scalerIndex, int scaleFactor) override;
 protected:
+	void updateScaledArea(Common::Rect &dirtyArea);
+
 	Graphics::Surface *_convData;
 	Scaler *_scaler;
 	uint _scalerIndex;
@@ -286,6 +326,8 @@ public:
 
 	void enableLinearFiltering(bool enable) override;
 
+	void enableStreamingUpload(bool enable) override { _clut8Texture.enableStreamingUpload(enable); }
+
 	void allocate(uint width, uint height) override;
 
 	bool isDirty() const override { return _paletteDirty || Surface::isDirty(); }
@@ -306,14 +348,29 @@ public:
 	void updateGLTexture() override;
 	const Texture &getGLTexture() const override;
 
+#ifdef USE_SCALERS
+	void setScaler(uint scalerIndex, int scaleFactor) override;
+
+	/**
+	 * Whether the given scaler is implemented as part of the color look
+	 * up, so that no CPU scaling is needed.
+	 */
+	static bool hasScaler(uint scalerIndex, int scaleFactor);
+#endif
+
 	static bool isSupportedByContext() {
 		return OpenGLContext.shadersSupported
 		    && OpenGLContext.multitextureSupported
 		    && OpenGLContext.framebufferObjectSupported;
 	}
 private:
+	void createPipeline();
 	void lookUpColors();
 
+#ifdef USE_SCALERS
+	static bool getScalerShader(uint scalerIndex, int scaleFactor, ShaderManager::ShaderUsage &shader);
+#endif
+
 	Texture _clut8Texture;
 	Texture _paletteTexture;
 
@@ -327,6 +384,54 @@ private:
 
 	byte _palette[4 * 256];
 	bool _paletteDirty;
+
+	ShaderManager::ShaderUsage _scalerShader;
+	uint _scaleFactor;
+};
+
+class YUVToRGBPipeline;
+
+/**
+ * Converts YUV images to an RGB texture with a shader.
+ *
+ * Unlike the surfaces, this does not keep a copy of the image data. The
+ * image needs to be set again after the context was recreated.
+ */
+class TextureYUVGPU {
+public:
+	TextureYUVGPU();
+	~TextureYUVGPU();
+
+	void destroy();
+
+	void recreate();
+
+	void enableLinearFiltering(bool enable);
+
+	/**
+	 * Upload the planes of the image and convert them to RGB.
+	 */
+	void setImage(const Graphics::YUVImage &image);
+
+	uint getWidth() const { return _width; }
+	uint getHeight() const { return _height; }
+
+	const Texture &getGLTexture() const;
+
+	static bool isSupportedByContext() {
+		return TextureSurfaceCLUT8GPU::isSupportedByContext();
+	}
+private:
+	void createPipeline();
+
+	Texture _yTexture;
+	Texture _uTexture;
+	Texture _vTexture;
+
+	TextureTarget *_target;
+	YUVToRGBPipeline *_pipeline;
+
+	uint _width, _height;
 };
 #endif // !USE_FORCED_GLES
 
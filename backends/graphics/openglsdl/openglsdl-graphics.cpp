@@ -364,7 +364,7 @@ void OpenGLSdlGraphicsManager::updateScreen() {
 	}
 
 #if defined(USE_IMGUI) && SDL_VERSION_ATLEAST(2, 0, 0)
-	if (_imGuiCallbacks.render) {
+	if (isImGuiVisible()) {
 		_forceRedraw = true;
 	}
 #endif
@@ -495,6 +495,12 @@ bool SdlGraphicsManager::notifyEvent(const Common::Event &event) {
 		saveScreenshot();
 		return true;
 
+#if defined(USE_IMGUI) && SDL_VERSION_ATLEAST(2, 0, 0)
+	case kActionTogglePerfHud:
+		_perfHudVisible = !_perfHudVisible;
+		return true;
+#endif
+
 	default:
 		return false;
 	}
@@ -552,6 +558,13 @@ Common::Keymap *SdlGraphicsManager::getKeymap() {
 	act->setCustomBackendActionEvent(kActionSaveScreenshot);
 	keymap->addAction(act);
 
+#if defined(USE_IMGUI) && SDL_VERSION_ATLEAST(2, 0, 0)
+	act = new Action("PHUD", _("Toggle performance overlay"));
+	act->addDefaultInputMapping("C+A+p");
+	act->setCustomBackendActionEvent(kActionTogglePerfHud);
+	keymap->addAction(act);
+#endif
+
 	if (hasFeature(OSystem::kFeatureAspectRatioCorrection)) {
 		act = new Action("ASPT", _("Toggle aspect ratio correction"));
 		act->addDefaultInputMapping("C+A+a");
@@ -724,7 +737,7 @@ void SdlGraphicsManager::initImGui(SDL_Renderer *renderer, void *glContext) {
 }
 
 void SdlGraphicsManager::renderImGui() {
-	if (!_imGuiReady || !_imGuiCallbacks.render) {
+	if (!_imGuiReady || !isImGuiVisible()) {
 		return;
 	}
 
@@ -757,7 +770,10 @@ void SdlGraphicsManager::renderImGui() {
 #endif
 
 	ImGui::NewFrame();
-	_imGuiCallbacks.render();
+	if (_imGuiCallbacks.render)
+		_imGuiCallbacks.render();
+	if (_perfHudVisible)
+		_perfHud.draw("Performance", &_perfHudVisible);
 	ImGui::Render();
 #ifdef USE_IMGUI_SDLRENDERER3
 	if (_imGuiSDLRenderer) {
@@ -28,6 +28,10 @@
 #include "common/events.h"
 #include "common/rect.h"
 
+#ifdef USE_IMGUI
+#include "backends/imgui/components/imgui_perfhud.h"
+#endif
+
 class SdlEventSource;
 
 #define USE_OSD	1
@@ -149,7 +153,8 @@ protected:
 		kActionIncreaseScaleFactor,
 		kActionDecreaseScaleFactor,
 		kActionNextScaleFilter,
-		kActionPreviousScaleFilter
+		kActionPreviousScaleFilter,
+		kActionTogglePerfHud
 	};
 
 	/** Obtain the user configured fullscreen resolution, or default to the desktop resolution */
@@ -222,6 +227,12 @@ protected:
 	bool _imGuiInited = false;
 	SDL_Renderer *_imGuiSDLRenderer = nullptr;
 
+	ImGuiEx::ImGuiPerfHud _perfHud;
+	bool _perfHudVisible = false;
+
+	/** Whether ImGui draws anything, which needs the screen to be redrawn every frame. */
+	bool isImGuiVisible() const { return _imGuiCallbacks.render || _perfHudVisible; }
+
 	void initImGui(SDL_Renderer *renderer, void *glContext);
 	void renderImGui();
 	void destroyImGui();
@@ -25,7 +25,9 @@
 #include "backends/graphics/surfacesdl/surfacesdl-graphics.h"
 #include "backends/events/sdl/sdl-events.h"
 #include "common/config-manager.h"
+#include "common/jobs.h"
 #include "common/mutex.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 #include "common/util.h"
@@ -42,11 +44,6 @@
 #include "graphics/surface.h"
 #include "gui/debugger.h"
 #include "gui/EventRecorder.h"
-#ifdef USE_PNG
-#include "image/png.h"
-#else
-#include "image/bmp.h"
-#endif
 #include "common/text-to-speech.h"
 
 #ifdef USE_OSD
@@ -62,6 +59,28 @@
 #define SDL_FULLSCREEN  0x40000000
 #endif
 
+// Rects with fewer rows are always scaled on the calling thread
+static const uint kMinScaleBandHeight = 16;
+
+struct ScaleBands {
+	Scaler *scaler;
+	const byte *src;
+	uint32 srcPitch;
+	byte *dst;
+	uint32 dstPitch;
+	int width;
+	int x, y;
+};
+
+static void scaleBands(uint begin, uint end, void *refCon) {
+	const ScaleBands *bands = (const ScaleBands *)refCon;
+	const uint factor = bands->scaler->getFactor();
+
+	bands->scaler->scale(bands->src + begin * bands->srcPitch, bands->srcPitch,
+	                     bands->dst + begin * factor * bands->dstPitch, bands->dstPitch,
+	                     bands->width, end - begin, bands->x, bands->y + begin);
+}
+
 static void destroySurface(SDL_Surface *surface) {
 #if SDL_VERSION_ATLEAST(3, 0, 0)
 	SDL_DestroySurface(surface);
@@ -169,7 +188,7 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 	_osdIconSurface(nullptr),
 #endif
 #if SDL_VERSION_ATLEAST(2, 0, 0)
-	_renderer(nullptr), _screenTexture(nullptr),
+	_renderer(nullptr), _screenTexture(nullptr), _mouseTexture(nullptr),
 #endif
 #if defined(WIN32) && !SDL_VERSION_ATLEAST(2, 0, 0)
 	_originalBitsPerPixel(0),
@@ -212,6 +231,9 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 
 	_mouseLastRect.x = _mouseLastRect.y = _mouseLastRect.w = _mouseLastRect.h = 0;
 	_mouseNextRect.x = _mouseNextRect.y = _mouseNextRect.w = _mouseNextRect.h = 0;
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	_mouseTextureRect.x = _mouseTextureRect.y = _mouseTextureRect.w = _mouseTextureRect.h = 0;
+#endif
 
 #ifdef USE_SDL_DEBUG_FOCUSRECT
 	if (ConfMan.hasKey("use_sdl_debug_focusrect"))
@@ -1354,6 +1376,7 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 				       _paletteDirtyStart,
 				       _paletteDirtyEnd - _paletteDirtyStart);
 
+		_paletteDirtyStart = 256;
 		_paletteDirtyEnd = 0;
 
 		_forceRedraw = true;
@@ -1411,7 +1434,7 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 		_forceRedraw = true;
 
 #if defined(USE_IMGUI) && (defined(USE_IMGUI_SDLRENDERER2) || defined(USE_IMGUI_SDLRENDERER3))
-	if (_imGuiCallbacks.render) {
+	if (isImGuiVisible()) {
 		_forceRedraw = true;
 	}
 #endif
@@ -1514,8 +1537,24 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 				if (_videoMode.aspectRatioCorrection && !_overlayInGUI)
 					dst_y = real2Aspect(dst_y);
 
-				_scaler->scale((byte *)srcSurf->pixels + (src_x + _maxExtraPixels) * bpp + (src_y + _maxExtraPixels) * srcPitch, srcPitch,
-						(byte *)_hwScreen->pixels + dst_x * bpp + dst_y * dstPitch, dstPitch, dst_w, dst_h, src_x, src_y);
+				ScaleBands bands;
+				bands.scaler = _scaler;
+				bands.src = (byte *)srcSurf->pixels + (src_x + _maxExtraPixels) * bpp + (src_y + _maxExtraPixels) * srcPitch;
+				bands.srcPitch = srcPitch;
+				bands.dst = (byte *)_hwScreen->pixels + dst_x * bpp + dst_y * dstPitch;
+				bands.dstPitch = dstPitch;
+				bands.width = dst_w;
+				bands.x = src_x;
+				bands.y = src_y;
+
+				// Every band reads the rows around it from the source, so the
+				// result is the same as when scaling the whole rect at once.
+				// Aspect ratio correction works in place on the destination
+				// and is left to happen afterwards.
+				if (_scaler->canScaleConcurrently())
+					g_system->getJobSystem()->parallelFor(dst_h, scaleBands, &bands, kMinScaleBandHeight);
+				else
+					scaleBands(0, dst_h, &bands);
 
 				r->x = dst_x;
 				r->y = dst_y;
@@ -1670,11 +1709,6 @@ bool SurfaceSdlGraphicsManager::saveScreenshot(const Common::Path &filename) con
 
 	Common::StackLock lock(_graphicsMutex);
 
-	Common::DumpFile out;
-	if (!out.open(filename)) {
-		return false;
-	}
-
 	if (!lockSurface(_hwScreen)) {
 		warning("Could not lock RGB surface");
 		return false;
@@ -1699,17 +1733,9 @@ bool SurfaceSdlGraphicsManager::saveScreenshot(const Common::Path &filename) con
 			palette[(i * 3) + 2] = sdlPalette->colors[i].b;
 		}
 
-#ifdef USE_PNG
-		success = Image::writePNG(out, data, palette);
-#else
-		success = Image::writeBMP(out, data, palette);
-#endif
+		success = _screenshotWriter.write(filename, data, palette);
 	} else {
-#ifdef USE_PNG
-		success = Image::writePNG(out, data);
-#else
-		success = Image::writeBMP(out, data);
-#endif
+		success = _screenshotWriter.write(filename, data);
 	}
 
 	SDL_UnlockSurface(_hwScreen);
@@ -1949,23 +1975,41 @@ void SurfaceSdlGraphicsManager::setPalette(const byte *colors, uint start, uint
 	if (!_screen)
 		warning("SurfaceSdlGraphicsManager::setPalette: _screen == NULL");
 
+	// Only the entries which actually change make the screen dirty, so
+	// that setting the same palette again doesn't redraw everything.
 	const byte *b = colors;
 	uint i;
+	uint changedStart = num, changedEnd = 0;
 	SDL_Color *base = _currentPalette + start;
 	for (i = 0; i < num; i++, b += 3) {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+		if (base[i].r == b[0] && base[i].g == b[1] && base[i].b == b[2] && base[i].a == 255)
+			continue;
+#else
+		if (base[i].r == b[0] && base[i].g == b[1] && base[i].b == b[2])
+			continue;
+#endif
+
 		base[i].r = b[0];
 		base[i].g = b[1];
 		base[i].b = b[2];
 #if SDL_VERSION_ATLEAST(2, 0, 0)
 		base[i].a = 255;
 #endif
+
+		if (i < changedStart)
+			changedStart = i;
+		changedEnd = i + 1;
 	}
 
-	if (start < _paletteDirtyStart)
-		_paletteDirtyStart = start;
+	if (changedEnd == 0)
+		return;
+
+	if (start + changedStart < _paletteDirtyStart)
+		_paletteDirtyStart = start + changedStart;
 
-	if (start + num > _paletteDirtyEnd)
-		_paletteDirtyEnd = start + num;
+	if (start + changedEnd > _paletteDirtyEnd)
+		_paletteDirtyEnd = start + changedEnd;
 
 	// Some games blink cursors with palette
 	if (_cursorPaletteDisabled)
@@ -2583,6 +2627,10 @@ void SurfaceSdlGraphicsManager::blitCursor() {
 
 	SDL_UnlockSurface(_mouseSurface);
 	SDL_UnlockSurface(_mouseOrigSurface);
+
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	recreateMouseTexture();
+#endif
 }
 
 void SurfaceSdlGraphicsManager::undrawMouse() {
@@ -2612,6 +2660,12 @@ void SurfaceSdlGraphicsManager::undrawMouse() {
 		_mouseNextRect.x = _mouseNextRect.y = _mouseNextRect.w = _mouseNextRect.h = 0;
 	}
 
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	// The composited cursor never touches the screen surface
+	if (useMouseTexture())
+		return;
+#endif
+
 	// Add the area covered by the mouse cursor to the list of dirty rects if
 	// we have to redraw the mouse, or if the cursor is alpha-blended since
 	// alpha-blended cursors will happily blend into themselves if the surface
@@ -2628,6 +2682,10 @@ void SurfaceSdlGraphicsManager::undrawMouse() {
 }
 
 void SurfaceSdlGraphicsManager::drawMouse() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	_mouseTextureRect.w = _mouseTextureRect.h = 0;
+#endif
+
 	if (!_cursorVisible || !_mouseSurface || !_mouseCurState.w || !_mouseCurState.h) {
 		return;
 	}
@@ -2652,6 +2710,13 @@ void SurfaceSdlGraphicsManager::drawMouse() {
 	dst.w = _mouseCurState.rW;
 	dst.h = _mouseCurState.rH;
 
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	if (useMouseTexture()) {
+		_mouseTextureRect = dst;
+		return;
+	}
+#endif
+
 	// Note that SDL_BlitSurface() and addDirtyRect() will both perform any
 	// clipping necessary
 
@@ -3084,6 +3149,10 @@ void SurfaceSdlGraphicsManager::deinitializeRenderer() {
 	destroyImGui();
 #endif
 
+	if (_mouseTexture)
+		SDL_DestroyTexture(_mouseTexture);
+	_mouseTexture = nullptr;
+
 	if (_screenTexture)
 		SDL_DestroyTexture(_screenTexture);
 	_screenTexture = nullptr;
@@ -3221,8 +3290,74 @@ SDL_Surface *SurfaceSdlGraphicsManager::SDL_SetVideoMode(int width, int height,
 	return screen;
 }
 
+void SurfaceSdlGraphicsManager::recreateMouseTexture() {
+	const bool hadTexture = _mouseTexture != nullptr;
+
+	if (_mouseTexture)
+		SDL_DestroyTexture(_mouseTexture);
+	_mouseTexture = nullptr;
+
+	if (!_renderer || !_mouseSurface)
+		return;
+
+	// The color key, if any, becomes transparency in the texture
+	_mouseTexture = SDL_CreateTextureFromSurface(_renderer, _mouseSurface);
+	if (!_mouseTexture) {
+		warning("Creating the cursor texture failed: %s", SDL_GetError());
+		return;
+	}
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+	SDL_SetTextureScaleMode(_mouseTexture, _videoMode.filtering ? SDL_SCALEMODE_LINEAR : SDL_SCALEMODE_NEAREST);
+#endif
+
+	// A cursor blitted before is still in the screen surface
+	if (!hadTexture)
+		_forceRedraw = true;
+}
+
+bool SurfaceSdlGraphicsManager::useMouseTexture() const {
+	return _mouseTexture && getRotationMode() == Common::kRotationNormal;
+}
+
+void SurfaceSdlGraphicsManager::renderMouseTexture(const SDL_Surface *screen, const SDL_Rect &viewport) {
+	if (_mouseTextureRect.w <= 0 || _mouseTextureRect.h <= 0 || screen->w <= 0 || screen->h <= 0)
+		return;
+
+	// Clip the cursor to the screen, like blitting it would
+	const int left = MAX<int>(_mouseTextureRect.x, 0);
+	const int top = MAX<int>(_mouseTextureRect.y, 0);
+	const int right = MIN<int>(_mouseTextureRect.x + _mouseTextureRect.w, screen->w);
+	const int bottom = MIN<int>(_mouseTextureRect.y + _mouseTextureRect.h, screen->h);
+	if (left >= right || top >= bottom)
+		return;
+
+	SDL_Rect src;
+	src.x = left - _mouseTextureRect.x;
+	src.y = top - _mouseTextureRect.y;
+	src.w = right - left;
+	src.h = bottom - top;
+
+	SDL_Rect dst;
+	dst.x = viewport.x + left * viewport.w / screen->w;
+	dst.y = viewport.y + top * viewport.h / screen->h;
+	dst.w = viewport.x + right * viewport.w / screen->w - dst.x;
+	dst.h = viewport.y + bottom * viewport.h / screen->h - dst.y;
+
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+	SDL_FRect fSrc, fDst;
+	SDL_RectToFRect(&src, &fSrc);
+	SDL_RectToFRect(&dst, &fDst);
+	SDL_RenderTexture(_renderer, _mouseTexture, &fSrc, &fDst);
+#else
+	SDL_RenderCopy(_renderer, _mouseTexture, &src, &dst);
+#endif
+}
+
 void SurfaceSdlGraphicsManager::SDL_UpdateRects(SDL_Surface *screen, int numrects, SDL_Rect *rects) {
-	SDL_UpdateTexture(_screenTexture, nullptr, screen->pixels, screen->pitch);
+	// With the cursor composited, a frame where only the cursor moved leaves
+	// the screen texture as it is
+	if (numrects > 0 || !useMouseTexture())
+		SDL_UpdateTexture(_screenTexture, nullptr, screen->pixels, screen->pitch);
 
 	SDL_Rect viewport;
 
@@ -3261,6 +3396,9 @@ void SurfaceSdlGraphicsManager::SDL_UpdateRects(SDL_Surface *screen, int numrect
 		SDL_RenderCopy(_renderer, _screenTexture, nullptr, &viewport);
 #endif
 	}
+
+	if (useMouseTexture())
+		renderMouseTexture(screen, viewport);
 }
 
 int SurfaceSdlGraphicsManager::SDL_SetColors(SDL_Surface *surface, SDL_Color *colors, int firstcolor, int ncolors) {
@@ -27,6 +27,7 @@
 #include "graphics/pixelformat.h"
 #include "graphics/scaler.h"
 #include "graphics/scalerplugin.h"
+#include "image/screenshot.h"
 #include "common/events.h"
 #include "common/mutex.h"
 
@@ -200,6 +201,18 @@ protected:
 	void deinitializeRenderer();
 	void recreateScreenTexture();
 
+	/**
+	 * The cursor, composited by the renderer on top of the screen texture
+	 * instead of being blitted into _hwScreen. This way moving the cursor
+	 * neither dirties nor rescales the game screen.
+	 */
+	SDL_Texture *_mouseTexture;
+	/** Where the cursor goes, in _hwScreen coordinates. */
+	SDL_Rect _mouseTextureRect;
+	void recreateMouseTexture();
+	bool useMouseTexture() const;
+	void renderMouseTexture(const SDL_Surface *screen, const SDL_Rect &viewport);
+
 	virtual SDL_Surface *SDL_SetVideoMode(int width, int height, int bpp, Uint32 flags);
 	virtual void SDL_UpdateRects(SDL_Surface *screen, int numrects, SDL_Rect *rects);
 	int SDL_SetColors(SDL_Surface *surface, SDL_Color *colors, int firstcolor, int ncolors);
@@ -422,6 +435,11 @@ protected:
 	 */
 	Common::Mutex _graphicsMutex;
 
+	/**
+	 * Encodes and writes screenshots, on a worker thread when possible.
+	 */
+	mutable Image::ScreenshotWriter _screenshotWriter;
+
 #ifdef USE_SDL_DEBUG_FOCUSRECT
 	bool _enableFocusRectDebugCode;
 	bool _enableFocusRect;
@@ -0,0 +1,166 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "backends/imgui/imgui_utils.h"
+#include "audio/mixer.h"
+#include "common/memtracker.h"
+#include "common/system.h"
+
+#include "backends/imgui/components/imgui_perfhud.h"
+
+namespace ImGuiEx {
+
+void ImGuiPerfHud::draw(const char *title, bool *p_open) {
+	const uint64 now = g_system->getMicros();
+	if (_lastFrame) {
+		_frameTimes[_frameIndex] = (now - _lastFrame) / 1000.0f;
+		_frameIndex = (_frameIndex + 1) % kFrameHistory;
+	}
+	_lastFrame = now;
+
+	ImGui::SetNextWindowPos(ImVec2(10.0f, 10.0f), ImGuiCond_FirstUseEver);
+	ImGui::SetNextWindowBgAlpha(0.7f);
+	if (!ImGui::Begin(title, p_open, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing)) {
+		ImGui::End();
+		return;
+	}
+
+	// The counters are sampled once per second, which keeps them readable
+	const uint32 millis = g_system->getMillis(true);
+	const bool update = millis - _lastUpdate >= 1000;
+	if (update)
+		_lastUpdate = millis;
+
+	drawFrameTimes();
+	drawAudio(update);
+	drawAllocations();
+	drawProfiler(update);
+
+	ImGui::End();
+}
+
+void ImGuiPerfHud::drawFrameTimes() {
+	float total = 0.0f, longest = 0.0f;
+	int frames = 0;
+	for (int i = 0; i < kFrameHistory; i++) {
+		if (_frameTimes[i] <= 0.0f)
+			continue;
+		total += _frameTimes[i];
+		longest = MAX(longest, _frameTimes[i]);
+		frames++;
+	}
+
+	const float average = frames ? total / frames : 0.0f;
+	ImGui::Text("Frame %.2f ms (%.1f fps), max %.2f ms", average, average > 0.0f ? 1000.0f / average : 0.0f, longest);
+
+	// Scale the graph to the longest frame, but at least to 60 fps
+	ImGui::PlotLines("##frametimes", _frameTimes, kFrameHistory, _frameIndex, nullptr, 0.0f, MAX(longest, 1000.0f / 60.0f), ImVec2(300.0f, 60.0f));
+}
+
+void ImGuiPerfHud::drawAudio(bool update) {
+	Audio::Mixer *mixer = g_system->getMixer();
+	if (!mixer || !mixer->isReady())
+		return;
+
+	Audio::Mixer::OutputStats stats;
+	mixer->getOutputStats(stats);
+
+	if (update) {
+		_mixerCallbacksPerSecond = stats.callbacks - _mixerCallbacks;
+		_mixerUnderrunsPerSecond = stats.underruns - _mixerUnderruns;
+		_mixerCallbacks = stats.callbacks;
+		_mixerUnderruns = stats.underruns;
+	}
+
+	if (!ImGui::CollapsingHeader("Audio", ImGuiTreeNodeFlags_DefaultOpen))
+		return;
+
+	ImGui::Text("Mixing %u us of %u us per buffer, max %u us", stats.lastMixTime, stats.bufferTime, stats.maxMixTime);
+	const float load = stats.bufferTime ? (float)stats.lastMixTime / stats.bufferTime : 0.0f;
+	ImGui::ProgressBar(MIN(load, 1.0f), ImVec2(300.0f, 0.0f));
+
+	if (_mixerUnderrunsPerSecond)
+		ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%u buffers/s, %u underruns/s", _mixerCallbacksPerSecond, _mixerUnderrunsPerSecond);
+	else
+		ImGui::Text("%u buffers/s, no underruns", _mixerCallbacksPerSecond);
+	ImGui::Text("%u underruns in total", stats.underruns);
+	ImGui::SameLine();
+	if (ImGui::SmallButton("Reset")) {
+		mixer->resetOutputStats();
+		_mixerCallbacks = _mixerUnderruns = 0;
+	}
+}
+
+void ImGuiPerfHud::drawAllocations() {
+#ifdef USE_MEMORY_TRACKING
+	size_t allocations = 0, current = 0;
+	for (int i = 0; i < Common::kMemoryTagCount; i++) {
+		Common::MemoryTracker::Stats stats;
+		Common::MemoryTracker::getStats((Common::MemoryTag)i, stats);
+		allocations += stats.allocations;
+		current += stats.current;
+	}
+
+	// Smoothed, since most frames don't allocate at all
+	if (_lastAllocations)
+		_allocationsPerFrame += ((float)(allocations - _lastAllocations) - _allocationsPerFrame) * 0.05f;
+	_lastAllocations = allocations;
+
+	if (!ImGui::CollapsingHeader("Memory", ImGuiTreeNodeFlags_DefaultOpen))
+		return;
+
+	ImGui::Text("%.1f tracked allocations/frame, %u KiB in use", _allocationsPerFrame, (uint)(current / 1024));
+#endif
+}
+
+void ImGuiPerfHud::drawProfiler(bool update) {
+#ifdef USE_PROFILER
+	if (!ImGui::CollapsingHeader("Threads", ImGuiTreeNodeFlags_DefaultOpen))
+		return;
+
+	Common::Profiler &profiler = Common::Profiler::instance();
+	bool enabled = profiler.isEnabled();
+	if (ImGui::Checkbox("Record zones", &enabled))
+		profiler.setEnabled(enabled);
+	if (!enabled)
+		return;
+
+	if (update) {
+		const uint64 now = Common::Profiler::getTime();
+		const uint64 since = now > 1000000 ? now - 1000000 : 0;
+		profiler.getThreadStats(_threadStats, since);
+		profiler.getZoneStats(_zoneStats, since);
+	}
+
+	// The load is the share of the last second each thread spent in zones
+	for (uint i = 0; i < _threadStats.size(); i++) {
+		const float load = MIN(_threadStats[i].busyTime / 1000000.0f, 1.0f);
+		ImGui::ProgressBar(load, ImVec2(200.0f, 0.0f));
+		ImGui::SameLine();
+		ImGui::TextUnformatted(_threadStats[i].name.c_str());
+	}
+
+	for (uint i = 0; i < _zoneStats.size() && i < 5; i++)
+		ImGui::Text("%6.2f ms/s  %s", _zoneStats[i].totalTime / 1000.0, _zoneStats[i].zone->name);
+#endif
+}
+
+} // namespace ImGuiEx
@@ -0,0 +1,73 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BACKENDS_IMGUI_COMPONENTS_IMGUI_PERFHUD_H
+#define BACKENDS_IMGUI_COMPONENTS_IMGUI_PERFHUD_H
+
+#include "common/array.h"
+#include "common/profiler.h"
+
+namespace ImGuiEx {
+
+/**
+ * A small overlay with the frame times, the audio mixing load and, when
+ * they are enabled, the tracked allocations and the thread load from the
+ * profiler. It doesn't depend on the engine, so the backend can show it
+ * over any game.
+ *
+ * draw() is meant to be called once per frame, which is what the frame
+ * times are measured from.
+ */
+class ImGuiPerfHud {
+	enum {
+		kFrameHistory = 240
+	};
+
+	float _frameTimes[kFrameHistory] = {};
+	int _frameIndex = 0;
+	uint64 _lastFrame = 0;
+
+	uint32 _lastUpdate = 0;
+	uint32 _mixerCallbacks = 0;
+	uint32 _mixerUnderruns = 0;
+	uint32 _mixerCallbacksPerSecond = 0;
+	uint32 _mixerUnderrunsPerSecond = 0;
+
+	size_t _lastAllocations = 0;
+	float _allocationsPerFrame = 0.0f;
+
+#ifdef USE_PROFILER
+	Common::Array<Common::Profiler::ThreadStats> _threadStats;
+	Common::Array<Common::Profiler::ZoneStats> _zoneStats;
+#endif
+
+	void drawFrameTimes();
+	void drawAudio(bool update);
+	void drawAllocations();
+	void drawProfiler(bool update);
+
+public:
+	void draw(const char *title, bool *p_open);
+};
+
+} // namespace ImGuiEx
+
+#endif
@@ -0,0 +1,140 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "backends/imgui/imgui_utils.h"
+#include "common/file.h"
+#include "common/memtracker.h"
+#include "common/system.h"
+
+#include "backends/imgui/components/imgui_profiler.h"
+
+namespace ImGuiEx {
+
+void ImGuiProfiler::draw(const char *title, bool *p_open) {
+	if (!ImGui::Begin(title, p_open)) {
+		ImGui::End();
+		return;
+	}
+
+	Common::Profiler &profiler = Common::Profiler::instance();
+
+	bool enabled = profiler.isEnabled();
+	if (ImGui::Checkbox("Record", &enabled))
+		profiler.setEnabled(enabled);
+	ImGui::SameLine();
+	ImGui::Checkbox("Pause", &_paused);
+	ImGui::SameLine();
+	if (ImGui::Button("Clear")) {
+		profiler.clear();
+		_stats.clear();
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Export trace")) {
+		Common::DumpFile file;
+		if (file.open("scummvm-trace.json") && profiler.exportChromeTrace(file))
+			_exportStatus = "Saved scummvm-trace.json";
+		else
+			_exportStatus = "Could not write scummvm-trace.json";
+	}
+	if (!_exportStatus.empty())
+		ImGui::TextUnformatted(_exportStatus.c_str());
+
+	// Refreshing a few times per second keeps the numbers readable
+	const uint32 millis = g_system->getMillis(true);
+	if (!_paused && millis - _lastUpdate >= 250) {
+		_lastUpdate = millis;
+		const uint64 now = Common::Profiler::getTime();
+		profiler.getZoneStats(_stats, now > 1000000 ? now - 1000000 : 0);
+	}
+
+#ifdef USE_MEMORY_TRACKING
+	if (ImGui::CollapsingHeader("Memory")) {
+		if (ImGui::Button("Reset peaks"))
+			Common::MemoryTracker::resetPeaks();
+
+		if (ImGui::BeginTable("memory", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+			ImGui::TableSetupColumn("Tag", ImGuiTableColumnFlags_WidthStretch);
+			ImGui::TableSetupColumn("In use KiB", ImGuiTableColumnFlags_WidthFixed);
+			ImGui::TableSetupColumn("Peak KiB", ImGuiTableColumnFlags_WidthFixed);
+			ImGui::TableSetupColumn("Budget KiB", ImGuiTableColumnFlags_WidthFixed);
+			ImGui::TableHeadersRow();
+
+			for (int i = 0; i < Common::kMemoryTagCount; i++) {
+				Common::MemoryTracker::Stats stats;
+				Common::MemoryTracker::getStats((Common::MemoryTag)i, stats);
+
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(Common::MemoryTracker::getTagName((Common::MemoryTag)i));
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", (uint)(stats.current / 1024));
+				ImGui::TableNextColumn();
+				if (stats.budget && stats.peak > stats.budget)
+					ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%u", (uint)(stats.peak / 1024));
+				else
+					ImGui::Text("%u", (uint)(stats.peak / 1024));
+				ImGui::TableNextColumn();
+				if (stats.budget)
+					ImGui::Text("%u", (uint)(stats.budget / 1024));
+				else
+					ImGui::TextUnformatted("-");
+			}
+
+			ImGui::EndTable();
+		}
+	}
+#endif
+
+	const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+	if (ImGui::BeginTable("zones", 5, flags)) {
+		ImGui::TableSetupScrollFreeze(0, 1);
+		ImGui::TableSetupColumn("Zone", ImGuiTableColumnFlags_WidthStretch);
+		ImGui::TableSetupColumn("ms/s", ImGuiTableColumnFlags_WidthFixed);
+		ImGui::TableSetupColumn("Calls/s", ImGuiTableColumnFlags_WidthFixed);
+		ImGui::TableSetupColumn("Avg us", ImGuiTableColumnFlags_WidthFixed);
+		ImGui::TableSetupColumn("Max us", ImGuiTableColumnFlags_WidthFixed);
+		ImGui::TableHeadersRow();
+
+		for (uint i = 0; i < _stats.size(); i++) {
+			const Common::Profiler::ZoneStats &stats = _stats[i];
+
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(stats.zone->name);
+			if (ImGui::IsItemHovered())
+				ImGui::SetTooltip("%s:%d", stats.zone->file, stats.zone->line);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.2f", stats.totalTime / 1000.0);
+			ImGui::TableNextColumn();
+			ImGui::Text("%u", stats.count);
+			ImGui::TableNextColumn();
+			ImGui::Text("%u", (uint)(stats.totalTime / stats.count));
+			ImGui::TableNextColumn();
+			ImGui::Text("%u", (uint)stats.maxTime);
+		}
+
+		ImGui::EndTable();
+	}
+
+	ImGui::End();
+}
+
+} // namespace ImGuiEx
@@ -0,0 +1,154 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#if defined(SDL_BACKEND)
+
+#include "backends/jobs/sdl/sdl-jobs.h"
+#include "backends/platform/sdl/sdl-sys.h"
+
+#include "common/debug.h"
+#include "common/textconsole.h"
+
+/**
+ * SDL thread pool job system
+ */
+class SdlJobSystem final : public Common::ThreadedJobSystem {
+public:
+	explicit SdlJobSystem(uint numWorkers);
+	~SdlJobSystem() override;
+
+	/** Start the worker threads. Returns the number of threads started. */
+	uint start();
+
+protected:
+	void notifyWorkers(uint count) override;
+	void waitForWork() override;
+	void yield() override { SDL_Delay(0); }
+
+private:
+	struct Worker {
+		SdlJobSystem *owner;
+		uint index;
+		SDL_Thread *thread;
+	};
+
+	static int workerMain(void *data);
+
+	Common::Array<Worker> _workers;
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+	SDL_Semaphore *_semaphore;
+#else
+	SDL_sem *_semaphore;
+#endif
+};
+
+SdlJobSystem::SdlJobSystem(uint numWorkers) : ThreadedJobSystem(numWorkers) {
+	_semaphore = SDL_CreateSemaphore(0);
+	_workers.resize(numWorkers);
+	for (uint i = 0; i < numWorkers; i++) {
+		_workers[i].owner = this;
+		_workers[i].index = i;
+		_workers[i].thread = nullptr;
+	}
+}
+
+SdlJobSystem::~SdlJobSystem() {
+	stopWorkers();
+
+	for (uint i = 0; i < _workers.size(); i++) {
+		if (_workers[i].thread)
+			SDL_WaitThread(_workers[i].thread, nullptr);
+	}
+
+	if (_semaphore)
+		SDL_DestroySemaphore(_semaphore);
+}
+
+uint SdlJobSystem::start() {
+	if (!_semaphore)
+		return 0;
+
+	for (uint i = 0; i < _workers.size(); i++) {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+		_workers[i].thread = SDL_CreateThread(workerMain, "ScummVM job worker", &_workers[i]);
+#else
+		_workers[i].thread = SDL_CreateThread(workerMain, &_workers[i]);
+#endif
+		if (!_workers[i].thread) {
+			warning("Could not create job worker thread: %s", SDL_GetError());
+			return i;
+		}
+	}
+
+	return _workers.size();
+}
+
+void SdlJobSystem::notifyWorkers(uint count) {
+	while (count--) {
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+		SDL_SignalSemaphore(_semaphore);
+#else
+		SDL_SemPost(_semaphore);
+#endif
+	}
+}
+
+void SdlJobSystem::waitForWork() {
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+	SDL_WaitSemaphore(_semaphore);
+#else
+	SDL_SemWait(_semaphore);
+#endif
+}
+
+int SdlJobSystem::workerMain(void *data) {
+	Worker *worker = (Worker *)data;
+	worker->owner->workerLoop(worker->index);
+	return 0;
+}
+
+Common::JobSystem *createSdlJobSystem() {
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+	const int cores = SDL_GetNumLogicalCPUCores();
+#elif SDL_VERSION_ATLEAST(2, 0, 0)
+	const int cores = SDL_GetCPUCount();
+#else
+	const int cores = 1;
+#endif
+
+	if (cores > 1) {
+		// The thread waiting on the jobs helps running them, so it counts
+		// as one of the cores.
+		SdlJobSystem *jobSystem = new SdlJobSystem(cores - 1);
+		if (jobSystem->start() == (uint)(cores - 1)) {
+			debug(1, "Using %d job worker threads", cores - 1);
+			return jobSystem;
+		}
+
+		delete jobSystem;
+	}
+
+	return new Common::JobSystem();
+}
+
+#endif
@@ -24,6 +24,7 @@
 #if defined(SDL_BACKEND)
 
 #include "backends/mixer/sdl/sdl-mixer.h"
+#include "common/atomic.h"
 #include "common/debug.h"
 #include "common/system.h"
 #include "common/config-manager.h"
@@ -37,10 +38,42 @@
 #define SAMPLES_PER_SEC 44100
 #endif
 
+enum {
+	// Range of the device buffer sizes used by the adaptive mode; 32768 is
+	// the largest power-of-two value representable with uint16
+	kMinBufferSamples = 256,
+	kMaxBufferSamples = 32768,
+
+	// Interval of the adaptation, in milliseconds
+	kAdaptInterval = 1000,
+	// Seconds without underruns before the buffer is shrunk again
+	kShrinkDelay = 30
+};
+
+// The manager adapted by the timer, and the number of timer callbacks using
+// it. SDL_RemoveTimer() doesn't wait for a callback which is running, so they
+// are kept outside of the manager, which then waits for the callbacks.
+static Common::Atomic<SdlMixerManager *> g_adaptManager;
+static Common::Atomic<int> g_adaptCallbacks;
+
 SdlMixerManager::SdlMixerManager() : _isSubsystemInitialized(false), _isAudioOpen(false) {
 }
 
 SdlMixerManager::~SdlMixerManager() {
+	if (_adaptTimer) {
+		SDL_RemoveTimer(_adaptTimer);
+
+		// Wait for a running adaptation to finish
+		g_adaptManager.exchange(nullptr);
+		Common::atomicFence();
+		while (g_adaptCallbacks.load())
+			SDL_Delay(1);
+		_adaptTimer = 0;
+#if !SDL_VERSION_ATLEAST(3, 0, 0)
+		SDL_QuitSubSystem(SDL_INIT_TIMER);
+#endif
+	}
+
 	if (_mixer)
 		_mixer->setReady(false);
 
@@ -142,11 +175,34 @@ void SdlMixerManager::init() {
 	desiredSamples = desired.samples;
 #endif
 
+	_bufferSamples = desiredSamples;
 	_mixer = new Audio::MixerImpl(_obtained.freq, _obtained.channels >= 2, desiredSamples);
 	assert(_mixer);
+
+	if (ConfMan.hasKey("audio_resampler") && ConfMan.get("audio_resampler") == "sinc")
+		_mixer->setRateConverterQuality(Audio::kRateConverterSinc);
+	if (ConfMan.hasKey("audio_parallel_mixing"))
+		_mixer->setParallelMixing(ConfMan.getBool("audio_parallel_mixing"));
+
 	_mixer->setReady(true);
 
 	startAudio();
+
+	if (ConfMan.hasKey("audio_buffer_adaptive") && ConfMan.getBool("audio_buffer_adaptive")) {
+		g_adaptManager.store(this);
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+		_adaptTimer = SDL_AddTimer(kAdaptInterval, &adaptTimerCallback, this);
+#else
+		if (SDL_InitSubSystem(SDL_INIT_TIMER) == -1)
+			warning("Could not initialize SDL timer subsystem: %s", SDL_GetError());
+		else if (!(_adaptTimer = SDL_AddTimer(kAdaptInterval, &adaptTimerCallback, this)))
+			SDL_QuitSubSystem(SDL_INIT_TIMER);
+#endif
+		if (!_adaptTimer) {
+			warning("Could not enable the adaptive audio buffer: %s", SDL_GetError());
+			g_adaptManager.store(nullptr);
+		}
+	}
 }
 
 #if !SDL_VERSION_ATLEAST(3, 0, 0)
@@ -259,7 +315,104 @@ void SdlMixerManager::sdl3Callback(void *userdata, SDL_AudioStream *stream, int
 }
 #endif
 
+void SdlMixerManager::runAdaptTimer() {
+	g_adaptCallbacks.fetchAdd(1);
+	Common::atomicFence();
+
+	SdlMixerManager *manager = g_adaptManager.load();
+	if (manager)
+		manager->adaptBufferSize();
+
+	g_adaptCallbacks.fetchSub(1);
+}
+
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+Uint32 SdlMixerManager::adaptTimerCallback(void *userdata, SDL_TimerID timerID, Uint32 interval) {
+	runAdaptTimer();
+	return interval;
+}
+#else
+Uint32 SdlMixerManager::adaptTimerCallback(Uint32 interval, void *param) {
+	runAdaptTimer();
+	return interval;
+}
+#endif
+
+void SdlMixerManager::adaptBufferSize() {
+	Common::StackLock lock(_deviceMutex);
+
+	if (!_adaptTimer || _audioSuspended)
+		return;
+
+	Audio::Mixer::OutputStats stats;
+	_mixer->getOutputStats(stats);
+
+	// The counters may have been reset from the debugger
+	const uint32 underruns = stats.underruns >= _lastUnderruns ? stats.underruns - _lastUnderruns : stats.underruns;
+	_lastUnderruns = stats.underruns;
+
+	uint32 samples = _bufferSamples;
+	if (underruns) {
+		// Don't shrink to this size again later
+		_unstableSamples = MAX(_unstableSamples, _bufferSamples);
+		_stableTime = 0;
+
+		if (_bufferSamples >= kMaxBufferSamples)
+			return;
+		samples = _bufferSamples * 2;
+	} else {
+		if (++_stableTime < kShrinkDelay || _bufferSamples <= kMinBufferSamples || _bufferSamples / 2 <= _unstableSamples)
+			return;
+		samples = _bufferSamples / 2;
+	}
+
+	debug(1, "SDL mixer: %u underruns with %u samples, changing the output buffer size to %u samples", underruns, _bufferSamples, samples);
+
+	if (!setBufferSize(samples)) {
+		warning("Could not change the audio buffer size: %s", SDL_GetError());
+
+		// Fall back to the previous size, which worked
+		if (!setBufferSize(_bufferSamples))
+			warning("Could not reopen audio device: %s", SDL_GetError());
+		return;
+	}
+
+	_bufferSamples = samples;
+	_mixer->setOutputBufSize(samples);
+	_stableTime = 0;
+
+	// Ignore the gap caused by reopening the device
+	_mixer->getOutputStats(stats);
+	_lastUnderruns = stats.underruns;
+}
+
+bool SdlMixerManager::setBufferSize(uint32 samples) {
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+	SDL_CloseAudioDevice(SDL_GetAudioStreamDevice(_stream));
+	SDL_DestroyAudioStream(_stream);
+
+	SDL_SetHint(SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES, Common::String::format("%u", samples).c_str());
+	_stream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &_obtained, sdl3Callback, this);
+	if (!_stream)
+		return false;
+	return SDL_ResumeAudioDevice(SDL_GetAudioStreamDevice(_stream));
+#else
+	SDL_CloseAudio();
+
+	SDL_AudioSpec fmt = _obtained;
+	fmt.samples = samples;
+	if (SDL_OpenAudio(&fmt, nullptr) != 0)
+		return false;
+
+	_obtained.samples = samples;
+	SDL_PauseAudio(0);
+	return true;
+#endif
+}
+
 void SdlMixerManager::suspendAudio() {
+	Common::StackLock lock(_deviceMutex);
+
 #if SDL_VERSION_ATLEAST(3, 0, 0)
 	SDL_CloseAudioDevice(SDL_GetAudioStreamDevice(_stream));
 	SDL_DestroyAudioStream(_stream);
@@ -270,6 +423,8 @@ void SdlMixerManager::suspendAudio() {
 }
 
 int SdlMixerManager::resumeAudio() {
+	Common::StackLock lock(_deviceMutex);
+
 	if (!_audioSuspended)
 		return -2;
 #if SDL_VERSION_ATLEAST(3, 0, 0)
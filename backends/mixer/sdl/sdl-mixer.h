@@ -24,6 +24,7 @@
 
 #include "backends/platform/sdl/sdl-sys.h"
 #include "backends/mixer/mixer.h"
+#include "common/mutex.h"
 
 /**
  * SDL mixer manager. It wraps the actual implementation
@@ -84,9 +85,41 @@ protected:
 	static void sdl3Callback(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount);
 #endif
 
+	/**
+	 * Reopen the audio device with a buffer of the given number of sample
+	 * frames. Requires _deviceMutex.
+	 */
+	virtual bool setBufferSize(uint32 samples);
+
+	/**
+	 * Grow the device buffer when the mixer reported underruns, and shrink
+	 * it again after a while without any. Called once a second from an SDL
+	 * timer if the audio_buffer_adaptive option is set.
+	 */
+	void adaptBufferSize();
+
+	/** Run adaptBufferSize() for the current manager, if it still exists. */
+	static void runAdaptTimer();
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+	static Uint32 adaptTimerCallback(void *userdata, SDL_TimerID timerID, Uint32 interval);
+#else
+	static Uint32 adaptTimerCallback(Uint32 interval, void *param);
+#endif
+
 	bool _isSubsystemInitialized;
 	bool _isAudioOpen;
 
+	/** Serializes reopening the device with suspending and resuming it. */
+	Common::Mutex _deviceMutex;
+	SDL_TimerID _adaptTimer = 0;
+	/** Current size of the device buffer, in sample frames. */
+	uint32 _bufferSamples = 0;
+	/** Largest buffer size which had underruns, or 0 if there were none. */
+	uint32 _unstableSamples = 0;
+	uint32 _lastUnderruns = 0;
+	/** Seconds since the last underrun or buffer size change. */
+	uint _stableTime = 0;
+
 #if SDL_VERSION_ATLEAST(3, 0, 0)
 	SDL_AudioStream *_stream = nullptr;
 #endif
@@ -26,6 +26,7 @@
 #include "backends/mixer/mixer.h"
 #include "gui/EventRecorder.h"
 
+#include "common/profiler.h"
 #include "common/timer.h"
 #include "graphics/pixelformat.h"
 
@@ -189,7 +190,17 @@ void ModularGraphicsBackend::fillScreen(const Common::Rect &r, uint32 col) {
 	_graphicsManager->fillScreen(r, col);
 }
 
+void ModularGraphicsBackend::showYUVOverlay(const Graphics::YUVImage &image, int x, int y) {
+	_graphicsManager->showYUVOverlay(image, x, y);
+}
+
+void ModularGraphicsBackend::hideYUVOverlay() {
+	_graphicsManager->hideYUVOverlay();
+}
+
 void ModularGraphicsBackend::updateScreen() {
+	PROFILE_ZONE("OSystem::updateScreen");
+
 #ifdef ENABLE_EVENTRECORDER
 	g_system->getMillis();		// force event recorder to update the tick count
 	g_eventRec.processScreenUpdate();
@@ -102,6 +102,8 @@ public:
 	void unlockScreen() override final;
 	void fillScreen(uint32 col) override final;
 	void fillScreen(const Common::Rect &r, uint32 col) override final;
+	void showYUVOverlay(const Graphics::YUVImage &image, int x, int y) override final;
+	void hideYUVOverlay() override final;
 	void updateScreen() override final;
 	void setShakePos(int shakeXOffset, int shakeYOffset) override final;
 	void setFocusRectangle(const Common::Rect& rect) override final;
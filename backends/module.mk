@@ -177,7 +177,8 @@ MODULE_OBJS += \
 	graphics/opengl/pipelines/pipeline.o \
 	graphics/opengl/pipelines/libretro.o \
 	graphics/opengl/pipelines/libretro/parser.o \
-	graphics/opengl/pipelines/shader.o
+	graphics/opengl/pipelines/shader.o \
+	graphics/opengl/pipelines/yuv.o
 endif
 
 # SDL specific source files.
@@ -188,6 +189,7 @@ MODULE_OBJS += \
 	events/sdl/sdl-common-events.o \
 	graphics/sdl/sdl-graphics.o \
 	graphics/surfacesdl/surfacesdl-graphics.o \
+	jobs/sdl/sdl-jobs.o \
 	mixer/sdl/sdl-mixer.o \
 	mixer/null/null-mixer.o \
 	mutex/sdl/sdl-mutex.o \
@@ -509,7 +511,13 @@ MODULE_OBJS += \
 	imgui/imgui_widgets.o \
 	imgui/imgui_utils.o \
 	imgui/components/imgui_logger.o \
+	imgui/components/imgui_perfhud.o \
 	imgui/misc/freetype/imgui_freetype.o
+
+ifdef USE_PROFILER
+MODULE_OBJS += \
+	imgui/components/imgui_profiler.o
+endif
 endif
 
 ifdef USE_SDL2
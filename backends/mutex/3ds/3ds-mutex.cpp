@@ -41,6 +41,7 @@ public:
 
 	bool lock() override { RecursiveLock_Lock(&_mutex); return true; }
 	bool unlock() override { RecursiveLock_Unlock(&_mutex); return true; }
+	bool tryLock() override { return RecursiveLock_TryLock(&_mutex) == 0; }
 
 private:
 	RecursiveLock _mutex;
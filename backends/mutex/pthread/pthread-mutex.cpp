@@ -35,6 +35,7 @@ public:
 
 	bool lock() override;
 	bool unlock() override;
+	bool tryLock() override;
 
 private:
 	pthread_mutex_t _mutex;
@@ -75,6 +76,10 @@ bool PthreadMutexInternal::unlock() {
 	}
 }
 
+bool PthreadMutexInternal::tryLock() {
+	return pthread_mutex_trylock(&_mutex) == 0;
+}
+
 Common::MutexInternal *createPthreadMutexInternal() {
 	return new PthreadMutexInternal();
 }
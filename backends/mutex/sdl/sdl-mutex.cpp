@@ -50,6 +50,15 @@ public:
 		return (SDL_mutexV(_mutex) == 0);
 #endif
 	}
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	bool tryLock() override {
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+		return SDL_TryLockMutex(_mutex);
+#else
+		return (SDL_TryLockMutex(_mutex) == 0);
+#endif
+	}
+#endif
 
 private:
 #if SDL_VERSION_ATLEAST(3, 0, 0)
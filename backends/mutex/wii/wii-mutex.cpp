@@ -39,6 +39,7 @@ public:
 
 	bool lock() override;
 	bool unlock() override;
+	bool tryLock() override;
 
 private:
 	mutex_t _mutex;
@@ -82,6 +83,10 @@ bool WiiMutexInternal::unlock() {
 	}
 }
 
+bool WiiMutexInternal::tryLock() {
+	return LWP_MutexTryLock(_mutex) == 0;
+}
+
 Common::MutexInternal *createWiiMutexInternal() {
 	return new WiiMutexInternal();
 }
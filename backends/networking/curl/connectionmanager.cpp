@@ -41,9 +41,32 @@ DECLARE_SINGLETON(Networking::ConnectionManager);
 
 namespace Networking {
 
-ConnectionManager::ConnectionManager(): _multi(nullptr), _timerStarted(false), _frame(0) {
+static void lockShare(CURL *handle, curl_lock_data data, curl_lock_access access, void *userptr) {
+	((Common::Mutex *)userptr)->lock();
+}
+
+static void unlockShare(CURL *handle, curl_lock_data data, void *userptr) {
+	((Common::Mutex *)userptr)->unlock();
+}
+
+ConnectionManager::ConnectionManager(): _multi(nullptr), _share(nullptr), _timerStarted(false), _frame(0) {
 	curl_global_init(CURL_GLOBAL_ALL);
 	_multi = curl_multi_init();
+#if LIBCURL_VERSION_NUM >= 0x072B00
+	// Added in libcurl 7.43.0
+	curl_multi_setopt(_multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+#endif
+
+	//easy handles are created and destroyed per request, so keep resolved
+	//hosts and TLS sessions around for the next request to the same server
+	_share = curl_share_init();
+	if (_share) {
+		curl_share_setopt(_share, CURLSHOPT_LOCKFUNC, lockShare);
+		curl_share_setopt(_share, CURLSHOPT_UNLOCKFUNC, unlockShare);
+		curl_share_setopt(_share, CURLSHOPT_USERDATA, &_shareMutex);
+		curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+		curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+	}
 }
 
 ConnectionManager::~ConnectionManager() {
@@ -82,12 +105,25 @@ ConnectionManager::~ConnectionManager() {
 
 	//cleanup
 	curl_multi_cleanup(_multi);
+	if (_share)
+		curl_share_cleanup(_share);
 	curl_global_cleanup();
 	_multi = nullptr;
+	_share = nullptr;
 	_handleMutex.unlock();
 }
 
 void ConnectionManager::registerEasyHandle(CURL *easy) const {
+	if (_share)
+		curl_easy_setopt(easy, CURLOPT_SHARE, _share);
+#if LIBCURL_VERSION_NUM >= 0x072F00
+	// Added in libcurl 7.47.0
+	curl_easy_setopt(easy, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+#endif
+#if LIBCURL_VERSION_NUM >= 0x072B00
+	// Added in libcurl 7.43.0, prefer waiting for a connection to multiplex on over opening a new one
+	curl_easy_setopt(easy, CURLOPT_PIPEWAIT, 1L);
+#endif
 	curl_multi_add_handle(_multi, easy);
 }
 
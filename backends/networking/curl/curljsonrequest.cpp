@@ -31,11 +31,12 @@
 namespace Networking {
 
 CurlJsonRequest::CurlJsonRequest(JsonCallback cb, ErrorCallback ecb, const Common::String &url) :
-	CurlRequest(nullptr, ecb, url), _jsonCallback(cb), _contentsStream(DisposeAfterUse::YES),
+	CurlRequest(nullptr, ecb, url), _jsonCallback(cb), _jsonReaderCallback(nullptr), _contentsStream(DisposeAfterUse::YES),
 	_buffer(new byte[CURL_JSON_REQUEST_BUFFER_SIZE]) {}
 
 CurlJsonRequest::~CurlJsonRequest() {
 	delete _jsonCallback;
+	delete _jsonReaderCallback;
 	delete[] _buffer;
 }
 
@@ -50,6 +51,14 @@ void CurlJsonRequest::handle() {
 
 		if (_stream->eos()) {
 			char *contents = Common::JSON::untaintContents(_contentsStream);
+
+			if (_jsonReaderCallback && _stream->httpResponseCode() == 200) {
+				Common::JSONReader reader(contents);
+				Request::finishSuccess();
+				(*_jsonReaderCallback)(JsonReaderResponse(this, &reader));
+				return;
+			}
+
 			Common::JSONValue *json = Common::JSON::parse(contents);
 			if (json) {
 				finishJson(json); //it's JSON even if's not 200 OK? That's fine!..
@@ -71,6 +80,11 @@ void CurlJsonRequest::restart() {
 	//with no stream available next handle() will create another one
 }
 
+void CurlJsonRequest::setJsonReaderCallback(JsonReaderCallback cb) {
+	delete _jsonReaderCallback;
+	_jsonReaderCallback = cb;
+}
+
 void CurlJsonRequest::finishJson(const Common::JSONValue *json) {
 	Request::finishSuccess();
 	if (_jsonCallback)
@@ -31,12 +31,15 @@ namespace Networking {
 typedef Response<const Common::JSONValue *> JsonResponse;
 typedef Common::BaseCallback<const JsonResponse &> *JsonCallback;
 typedef Common::BaseCallback<const Common::JSONValue *> *JSONValueCallback;
+typedef Response<Common::JSONReader *> JsonReaderResponse;
+typedef Common::BaseCallback<const JsonReaderResponse &> *JsonReaderCallback;
 
 #define CURL_JSON_REQUEST_BUFFER_SIZE 512 * 1024
 
 class CurlJsonRequest: public CurlRequest {
 protected:
 	JsonCallback _jsonCallback;
+	JsonReaderCallback _jsonReaderCallback;
 	Common::MemoryWriteStreamDynamic _contentsStream;
 	byte *_buffer;
 
@@ -50,6 +53,13 @@ public:
 	void handle() override;
 	void restart() override;
 
+	/**
+	 * Read successful (200 OK) responses with a Common::JSONReader in the given
+	 * callback, instead of parsing them into a tree for the JSON callback.
+	 * Other responses are still passed to the JSON callback.
+	 */
+	void setJsonReaderCallback(JsonReaderCallback cb);
+
 	static bool jsonIsObject(const Common::JSONValue *item, const char *warningPrefix);
 	static bool jsonContainsObject(const Common::JSONObject &item, const char *key, const char *warningPrefix, bool isOptional = false);
 	static bool jsonContainsString(const Common::JSONObject &item, const char *key, const char *warningPrefix, bool isOptional = false);
@@ -34,7 +34,8 @@ namespace Networking {
 SessionRequest::SessionRequest(const Common::String &url, const Common::Path &localFile, DataCallback cb, ErrorCallback ecb, bool binary):
 	CurlRequest(cb, ecb, url), _contentsStream(DisposeAfterUse::YES),
 	_buffer(new byte[CURL_SESSION_REQUEST_BUFFER_SIZE]), _text(nullptr), _localFile(nullptr),
-	_started(false), _complete(false), _success(false), _binary(binary) {
+	_started(false), _complete(false), _success(false), _binary(binary),
+	_bytesWritten(0), _resumeOffset(0), _resumeAttempts(0) {
 
 	openLocalFile(localFile);
 
@@ -64,9 +65,35 @@ void SessionRequest::openLocalFile(const Common::Path &localFile) {
 
 	debug(5, "SessionRequest: opened localfile %s", localFile.toString(Common::Path::kNativeSeparator).c_str());
 
+	_bytesWritten = _resumeOffset = 0;
+	_resumeAttempts = 0;
+
 	_binary = true; // Enforce binary
 }
 
+bool SessionRequest::resumeDownload() {
+	if (!_localFile || _bytesWritten == 0 || _resumeAttempts >= CURL_SESSION_REQUEST_MAX_RESUMES)
+		return false;
+
+	++_resumeAttempts;
+	_resumeOffset = _bytesWritten;
+	debug(5, "SessionRequest: resuming download at %llu bytes (attempt %u)", (unsigned long long)_resumeOffset, _resumeAttempts);
+
+	//the following stream would ask for the remaining bytes only
+	curl_slist *headers = nullptr;
+	for (curl_slist *i = _headersList; i; i = i->next) {
+		if (!Common::String(i->data).hasPrefixIgnoreCase("Range:"))
+			headers = curl_slist_append(headers, i->data);
+	}
+	headers = curl_slist_append(headers, Common::String::format("Range: bytes=%llu-", (unsigned long long)_resumeOffset).c_str());
+
+	delete _stream;
+	_stream = nullptr;
+	curl_slist_free_all(_headersList);
+	_headersList = headers;
+	return true;
+}
+
 bool SessionRequest::reuseStream() {
 	if (!_stream) {
 		return false;
@@ -158,9 +185,14 @@ void SessionRequest::handle() {
 	if (!_stream) _stream = makeStream();
 
 	if (_stream) {
-		if (_stream->httpResponseCode() != 200 && _stream->httpResponseCode() != 0) {
-			warning("SessionRequest: HTTP response code is not 200 OK (it's %ld)", _stream->httpResponseCode());
-			ErrorResponse error(this, false, true, "HTTP response code is not 200 OK", _stream->httpResponseCode());
+		long responseCode = _stream->httpResponseCode();
+		if (responseCode == 200 && _resumeOffset > 0) {
+			//server doesn't support ranges and sends the whole file again
+			_localFile->seek(0, SEEK_SET);
+			_bytesWritten = _resumeOffset = 0;
+		} else if (responseCode != 200 && responseCode != 0 && !(responseCode == 206 && _resumeOffset > 0)) {
+			warning("SessionRequest: HTTP response code is not 200 OK (it's %ld)", responseCode);
+			ErrorResponse error(this, false, true, "HTTP response code is not 200 OK", responseCode);
 			finishError(error);
 			return;
 		}
@@ -172,13 +204,14 @@ void SessionRequest::handle() {
 			} else {
 				_response.buffer = _buffer;
 				_response.len = readBytes;
-				_response.eos = _stream->eos();
+				_response.eos = _stream->eos() && !_stream->hasError();
 
 				if (_localFile->write(_buffer, readBytes) != readBytes) {
 					warning("DownloadRequest: unable to write all received bytes into output file");
 					finishError(Networking::ErrorResponse(this, false, true, "DownloadRequest::handle: failed to write all bytes into a file", -1));
 					return;
 				}
+				_bytesWritten += readBytes;
 
 				if (_callback)
 					(*_callback)(DataResponse(this, &_response));
@@ -187,6 +220,10 @@ void SessionRequest::handle() {
 
 		if (_stream->eos()) {
 			if (_stream->hasError()) {
+				//a dropped connection shouldn't throw away what was already downloaded
+				if (resumeDownload())
+					return;
+
 				ErrorResponse error(this, false, true, Common::String::format("TLS stream response code is not CURLE_OK OK: %s", _stream->getError()), _stream->getErrorCode());
 				finishError(error);
 				return;
@@ -34,6 +34,7 @@ class Path;
 namespace Networking {
 
 #define CURL_SESSION_REQUEST_BUFFER_SIZE 512 * 1024
+#define CURL_SESSION_REQUEST_MAX_RESUMES 3
 
 struct SessionFileResponse {
 	byte *buffer;
@@ -56,9 +57,17 @@ protected:
 	bool _binary;
 	Common::DumpFile *_localFile;
 	SessionFileResponse _response;
+	uint64 _bytesWritten, _resumeOffset;
+	uint32 _resumeAttempts;
 
 	bool reuseStream();
 
+	/**
+	 * Continues an interrupted download into the local file by requesting
+	 * the remaining bytes only. Returns false if it shouldn't be retried.
+	 */
+	bool resumeDownload();
+
 	/** Prepares raw bytes from _contentsStream. */
 	char *getPreparedContents();
 
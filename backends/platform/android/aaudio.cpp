@@ -0,0 +1,231 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Allow use of stuff in <time.h>
+#define FORBIDDEN_SYMBOL_EXCEPTION_time_h
+
+// Disable printf override in common/forbidden.h to avoid
+// clashes with log.h from the Android SDK.
+#define FORBIDDEN_SYMBOL_EXCEPTION_printf
+
+#include <dlfcn.h>
+
+#include "backends/platform/android/aaudio.h"
+#include "backends/platform/android/android.h"
+
+#include "audio/mixer_intern.h"
+
+// The parts of the AAudio API we use. They are declared here instead of
+// including <aaudio/AAudio.h>, which hides them below API level 26.
+typedef struct AAudioStreamBuilderStruct AAudioStreamBuilder;
+typedef AAudioStreamStruct AAudioStream;
+
+typedef int32 (*AAudioStream_dataCallback)(AAudioStream *stream, void *userData, void *audioData, int32 numFrames);
+typedef void (*AAudioStream_errorCallback)(AAudioStream *stream, void *userData, int32 error);
+
+enum {
+	AAUDIO_OK = 0,
+	AAUDIO_ERROR_DISCONNECTED = -899,
+	AAUDIO_FORMAT_PCM_I16 = 1,
+	AAUDIO_PERFORMANCE_MODE_LOW_LATENCY = 12,
+	AAUDIO_CALLBACK_RESULT_CONTINUE = 0
+};
+
+struct AAudioFunctions {
+	int32 (*createStreamBuilder)(AAudioStreamBuilder **builder);
+	void (*setFormat)(AAudioStreamBuilder *builder, int32 format);
+	void (*setChannelCount)(AAudioStreamBuilder *builder, int32 channelCount);
+	void (*setSampleRate)(AAudioStreamBuilder *builder, int32 sampleRate);
+	void (*setPerformanceMode)(AAudioStreamBuilder *builder, int32 mode);
+	void (*setDataCallback)(AAudioStreamBuilder *builder, AAudioStream_dataCallback callback, void *userData);
+	void (*setErrorCallback)(AAudioStreamBuilder *builder, AAudioStream_errorCallback callback, void *userData);
+	int32 (*openStream)(AAudioStreamBuilder *builder, AAudioStream **stream);
+	int32 (*deleteBuilder)(AAudioStreamBuilder *builder);
+
+	int32 (*requestStart)(AAudioStream *stream);
+	int32 (*requestPause)(AAudioStream *stream);
+	int32 (*requestStop)(AAudioStream *stream);
+	int32 (*closeStream)(AAudioStream *stream);
+	int32 (*getSampleRate)(AAudioStream *stream);
+	int32 (*getFramesPerBurst)(AAudioStream *stream);
+	int32 (*setBufferSizeInFrames)(AAudioStream *stream, int32 numFrames);
+
+	const char *(*convertResultToText)(int32 result);
+};
+
+AndroidAAudioOutput::AndroidAAudioOutput() :
+	_functions(loadFunctions()),
+	_stream(nullptr),
+	_mixer(nullptr),
+	_sampleRate(0),
+	_disconnected(false) {
+}
+
+AndroidAAudioOutput::~AndroidAAudioOutput() {
+	close();
+}
+
+const AAudioFunctions *AndroidAAudioOutput::loadFunctions() {
+	static AAudioFunctions functions;
+	static bool loaded = false;
+	static bool available = false;
+
+	if (loaded)
+		return available ? &functions : nullptr;
+	loaded = true;
+
+	// The library is never unloaded, like the system libraries we link to
+	void *library = dlopen("libaaudio.so", RTLD_NOW | RTLD_LOCAL);
+	if (!library) {
+		LOGD("AAudio is not available");
+		return nullptr;
+	}
+
+#define LOAD_AAUDIO_FUNCTION(member, name) \
+	*(void **)&functions.member = dlsym(library, name); \
+	if (!functions.member) { \
+		LOGW("AAudio: missing %s", name); \
+		return nullptr; \
+	}
+
+	LOAD_AAUDIO_FUNCTION(createStreamBuilder, "AAudio_createStreamBuilder");
+	LOAD_AAUDIO_FUNCTION(setFormat, "AAudioStreamBuilder_setFormat");
+	LOAD_AAUDIO_FUNCTION(setChannelCount, "AAudioStreamBuilder_setChannelCount");
+	LOAD_AAUDIO_FUNCTION(setSampleRate, "AAudioStreamBuilder_setSampleRate");
+	LOAD_AAUDIO_FUNCTION(setPerformanceMode, "AAudioStreamBuilder_setPerformanceMode");
+	LOAD_AAUDIO_FUNCTION(setDataCallback, "AAudioStreamBuilder_setDataCallback");
+	LOAD_AAUDIO_FUNCTION(setErrorCallback, "AAudioStreamBuilder_setErrorCallback");
+	LOAD_AAUDIO_FUNCTION(openStream, "AAudioStreamBuilder_openStream");
+	LOAD_AAUDIO_FUNCTION(deleteBuilder, "AAudioStreamBuilder_delete");
+	LOAD_AAUDIO_FUNCTION(requestStart, "AAudioStream_requestStart");
+	LOAD_AAUDIO_FUNCTION(requestPause, "AAudioStream_requestPause");
+	LOAD_AAUDIO_FUNCTION(requestStop, "AAudioStream_requestStop");
+	LOAD_AAUDIO_FUNCTION(closeStream, "AAudioStream_close");
+	LOAD_AAUDIO_FUNCTION(getSampleRate, "AAudioStream_getSampleRate");
+	LOAD_AAUDIO_FUNCTION(getFramesPerBurst, "AAudioStream_getFramesPerBurst");
+	LOAD_AAUDIO_FUNCTION(setBufferSizeInFrames, "AAudioStream_setBufferSizeInFrames");
+	LOAD_AAUDIO_FUNCTION(convertResultToText, "AAudio_convertResultToText");
+
+#undef LOAD_AAUDIO_FUNCTION
+
+	available = true;
+	return &functions;
+}
+
+bool AndroidAAudioOutput::open(int sampleRate) {
+	close();
+
+	if (!_functions)
+		return false;
+
+	AAudioStreamBuilder *builder;
+	int32 result = _functions->createStreamBuilder(&builder);
+	if (result != AAUDIO_OK) {
+		LOGW("AAudio: can't create a stream builder: %s", _functions->convertResultToText(result));
+		return false;
+	}
+
+	_functions->setFormat(builder, AAUDIO_FORMAT_PCM_I16);
+	_functions->setChannelCount(builder, 2);
+	_functions->setSampleRate(builder, sampleRate);
+	_functions->setPerformanceMode(builder, AAUDIO_PERFORMANCE_MODE_LOW_LATENCY);
+	_functions->setDataCallback(builder, dataCallback, this);
+	_functions->setErrorCallback(builder, errorCallback, this);
+
+	result = _functions->openStream(builder, &_stream);
+	_functions->deleteBuilder(builder);
+
+	if (result != AAUDIO_OK) {
+		LOGW("AAudio: can't open a stream: %s", _functions->convertResultToText(result));
+		_stream = nullptr;
+		return false;
+	}
+
+	// The mixer runs at a fixed rate, so the stream has to match it
+	if (_functions->getSampleRate(_stream) != sampleRate) {
+		LOGW("AAudio: stream opened at %d Hz instead of %d Hz", _functions->getSampleRate(_stream), sampleRate);
+		close();
+		return false;
+	}
+
+	// A buffer of two bursts keeps the latency low while still tolerating
+	// one late callback
+	const int32 burst = _functions->getFramesPerBurst(_stream);
+	if (burst > 0)
+		_functions->setBufferSizeInFrames(_stream, burst * 2);
+
+	_sampleRate = sampleRate;
+	_disconnected.store(false);
+
+	LOGD("AAudio: opened a stream at %d Hz, with bursts of %d frames", sampleRate, burst);
+	return true;
+}
+
+void AndroidAAudioOutput::close() {
+	if (!_stream)
+		return;
+
+	_functions->requestStop(_stream);
+	_functions->closeStream(_stream);
+	_stream = nullptr;
+}
+
+bool AndroidAAudioOutput::start() {
+	if (_disconnected.load()) {
+		LOGD("AAudio: reopening the stream");
+		if (!open(_sampleRate))
+			return false;
+	}
+
+	if (!_stream)
+		return false;
+
+	const int32 result = _functions->requestStart(_stream);
+	if (result != AAUDIO_OK) {
+		LOGW("AAudio: can't start the stream: %s", _functions->convertResultToText(result));
+		return false;
+	}
+	return true;
+}
+
+bool AndroidAAudioOutput::pause() {
+	if (!_stream)
+		return false;
+
+	return _functions->requestPause(_stream) == AAUDIO_OK;
+}
+
+int32 AndroidAAudioOutput::dataCallback(AAudioStream *stream, void *userData, void *audioData, int32 numFrames) {
+	AndroidAAudioOutput *output = (AndroidAAudioOutput *)userData;
+
+	// Frames of 16-bit stereo samples
+	output->_mixer->mixCallback((byte *)audioData, numFrames * 4);
+	return AAUDIO_CALLBACK_RESULT_CONTINUE;
+}
+
+void AndroidAAudioOutput::errorCallback(AAudioStream *stream, void *userData, int32 error) {
+	AndroidAAudioOutput *output = (AndroidAAudioOutput *)userData;
+
+	// The stream may not be closed from its own callbacks, so leave that to
+	// the audio thread
+	if (error == AAUDIO_ERROR_DISCONNECTED)
+		output->_disconnected.store(true);
+}
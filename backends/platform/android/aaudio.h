@@ -0,0 +1,79 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ANDROID_AAUDIO_H_
+#define ANDROID_AAUDIO_H_
+
+#include "common/atomic.h"
+
+namespace Audio {
+class MixerImpl;
+}
+
+struct AAudioFunctions;
+struct AAudioStreamStruct;
+
+/**
+ * Audio output through AAudio, which is available since Android 8.0.
+ *
+ * The stream runs in low latency mode and pulls the samples straight from
+ * the mixer in its callback, instead of having them pushed through the
+ * Java AudioTrack. libaaudio is loaded at runtime, so that the port still
+ * runs on older versions, which keep using the AudioTrack.
+ */
+class AndroidAAudioOutput {
+public:
+	AndroidAAudioOutput();
+	~AndroidAAudioOutput();
+
+	/**
+	 * Open a 16-bit stereo stream at the given rate. This fails when AAudio
+	 * is not available or can't play at that rate.
+	 */
+	bool open(int sampleRate);
+	void close();
+
+	/** Start pulling samples from the mixer, which must be set by then. */
+	bool start();
+	bool pause();
+
+	void setMixer(Audio::MixerImpl *mixer) { _mixer = mixer; }
+
+	/**
+	 * Whether the stream lost its device, e.g. because headphones were
+	 * plugged in. It then needs to be opened again.
+	 */
+	bool isDisconnected() const { return _disconnected.load(); }
+
+private:
+	static int32 dataCallback(AAudioStreamStruct *stream, void *userData, void *audioData, int32 numFrames);
+	static void errorCallback(AAudioStreamStruct *stream, void *userData, int32 error);
+
+	static const AAudioFunctions *loadFunctions();
+
+	const AAudioFunctions *_functions;
+	AAudioStreamStruct *_stream;
+	Audio::MixerImpl *_mixer;
+	int _sampleRate;
+	Common::Atomic<bool> _disconnected;
+};
+
+#endif
@@ -170,6 +170,7 @@ OSystem_Android::OSystem_Android(int audio_sample_rate, int audio_buffer_size) :
 	_audio_sample_rate(audio_sample_rate),
 	_audio_buffer_size(audio_buffer_size),
 	_screen_changeid(0),
+	_aaudio_enabled(false),
 	_mixer(0),
 	_event_queue_lock(0),
 	_touch_pt_down(),
@@ -412,6 +413,41 @@ void *OSystem_Android::audioThreadFunc(void *arg) {
 	return 0;
 }
 
+void *OSystem_Android::aaudioThreadFunc(void *arg) {
+	OSystem_Android *system = (OSystem_Android *)arg;
+	AndroidAAudioOutput &output = system->_aaudio;
+
+	// The stream pulls the samples from its own thread. This one only
+	// follows the pause state of the activity, and restarts the stream
+	// when it lost its device.
+	struct timespec tv;
+	tv.tv_sec = 0;
+	tv.tv_nsec = 50 * 1000 * 1000;
+
+	output.start();
+
+	while (!system->_audio_thread_exit) {
+		if (JNI::pause) {
+			output.pause();
+
+			LOGD("audio thread going to sleep");
+			sem_wait(&JNI::pause_sem);
+			LOGD("audio thread woke up");
+
+			output.start();
+		}
+
+		if (output.isDisconnected())
+			output.start();
+
+		nanosleep(&tv, 0);
+	}
+
+	output.close();
+
+	return 0;
+}
+
 //
 // When launching ScummVM (from ScummVMActivity) order of business is as follows:
 // 1. scummvm_main() (base/main.cpp)
@@ -549,11 +585,14 @@ void OSystem_Android::initBackend() {
 	_mixer = new Audio::MixerImpl(_audio_sample_rate, true, _audio_buffer_size / 4);
 	_mixer->setReady(true);
 
+	_aaudio.setMixer(_mixer);
+	_aaudio_enabled = _aaudio.open(_audio_sample_rate);
+
 	_timer_thread_exit = false;
 	pthread_create(&_timer_thread, 0, timerThreadFunc, this);
 
 	_audio_thread_exit = false;
-	pthread_create(&_audio_thread, 0, audioThreadFunc, this);
+	pthread_create(&_audio_thread, 0, _aaudio_enabled ? aaudioThreadFunc : audioThreadFunc, this);
 
 	JNI::DPIValues dpi;
 	JNI::getDPI(dpi);
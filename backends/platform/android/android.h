@@ -33,6 +33,7 @@
 #include "backends/fs/posix/posix-fs-factory.h"
 #include "backends/fs/posix/posix-fs-factory.h"
 #include "backends/log/log.h"
+#include "backends/platform/android/aaudio.h"
 #include "backends/platform/android/touchcontrols.h"
 
 #include <pthread.h>
@@ -142,6 +143,10 @@ private:
 	bool _audio_thread_exit;
 	pthread_t _audio_thread;
 
+	// Used instead of the Java AudioTrack when it could be opened
+	AndroidAAudioOutput _aaudio;
+	bool _aaudio_enabled;
+
 	bool _virtkeybd_on;
 
 	Audio::MixerImpl *_mixer;
@@ -183,6 +188,7 @@ private:
 
 	static void *timerThreadFunc(void *arg);
 	static void *audioThreadFunc(void *arg);
+	static void *aaudioThreadFunc(void *arg);
 	Common::String getSystemProperty(const char *name) const;
 
 	Common::WriteStream *createLogFileForAppending();
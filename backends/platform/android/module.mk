@@ -4,6 +4,7 @@ MODULE_OBJS := \
 	jni-android.o \
 	asset-archive.o \
 	android.o \
+	aaudio.o \
 	events.o \
 	options.o \
 	snprintf.o \
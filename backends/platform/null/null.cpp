@@ -82,10 +82,16 @@ public:
 
 	virtual void initBackend();
 
+#ifdef NULL_DRIVER_USE_FOR_TEST
+	// The tests run without a graphics manager to ask
+	virtual bool hasFeature(Feature f) { return false; }
+#endif
+
 	virtual bool pollEvent(Common::Event &event);
 
 	virtual Common::MutexInternal *createMutex();
 	virtual uint32 getMillis(bool skipRecord = false);
+	virtual uint64 getMicros();
 	virtual void delayMillis(uint msecs);
 	virtual void getTimeAndDate(TimeDate &td, bool skipRecord = false) const;
 
@@ -119,6 +125,13 @@ OSystem_NULL::OSystem_NULL(bool silenceLogs) :
 	#else
 		#error Unknown and unsupported FS backend
 	#endif
+
+	// Start the clock here already, as it is read before initBackend()
+#ifdef POSIX
+	gettimeofday(&_startTime, 0);
+#elif defined(WIN32)
+	_startTime = GetTickCount();
+#endif
 }
 
 OSystem_NULL::~OSystem_NULL() {
@@ -136,12 +149,6 @@ void intHandler(int dummy) {
 #endif
 
 void OSystem_NULL::initBackend() {
-#ifdef POSIX
-	gettimeofday(&_startTime, 0);
-#elif defined(WIN32)
-	_startTime = GetTickCount();
-#endif
-
 #ifndef NULL_DRIVER_USE_FOR_TEST
 #ifdef POSIX
 	last_handler = signal(SIGINT, intHandler);
@@ -205,6 +212,18 @@ uint32 OSystem_NULL::getMillis(bool skipRecord) {
 #endif
 }
 
+uint64 OSystem_NULL::getMicros() {
+#ifdef POSIX
+	timeval curTime;
+
+	gettimeofday(&curTime, 0);
+
+	return (uint64)(curTime.tv_sec - _startTime.tv_sec) * 1000000 + (curTime.tv_usec - _startTime.tv_usec);
+#else
+	return (uint64)getMillis(true) * 1000;
+#endif
+}
+
 void OSystem_NULL::delayMillis(uint msecs) {
 #ifdef POSIX
 	usleep(msecs * 1000);
@@ -255,7 +274,7 @@ OSystem *OSystem_NULL_create(bool silenceLogs) {
 	return new OSystem_NULL(silenceLogs);
 }
 
-#ifndef NULL_DRIVER_USE_FOR_TEST
+#if !defined(NULL_DRIVER_USE_FOR_TEST) && !defined(NULL_DRIVER_USE_FOR_BENCH)
 int main(int argc, char *argv[]) {
 	g_system = OSystem_NULL_create(false);
 	assert(g_system);
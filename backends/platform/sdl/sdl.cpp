@@ -45,6 +45,7 @@
 #include "backends/mixer/null/null-mixer.h"
 #include "backends/events/default/default-events.h"
 #include "backends/keymapper/hardware-input.h"
+#include "backends/jobs/sdl/sdl-jobs.h"
 #include "backends/mutex/sdl/sdl-mutex.h"
 #include "backends/timer/sdl/sdl-timer.h"
 #include "backends/graphics/surfacesdl/surfacesdl-graphics.h"
@@ -154,6 +155,14 @@ OSystem_SDL::~OSystem_SDL() {
 
 	_timerManager = nullptr;
 
+	// The configuration file may still be written by a job
+	if (Common::ConfigManager::hasInstance())
+		ConfMan.waitForFlush();
+
+	// The job system owns SDL threads, so it must go before SDL_Quit() too.
+	delete _jobSystem;
+	_jobSystem = nullptr;
+
 	delete _logger;
 	_logger = nullptr;
 
@@ -209,6 +218,11 @@ bool OSystem_SDL::hasFeature(Feature f) {
 #if SDL_VERSION_ATLEAST(2, 0, 4)
 	if (f == kFeatureCpuAVX2) return SDL_HasAVX2();
 #endif
+#if defined(SCUMMVM_AVX512) && defined(__GNUC__)
+	// SDL only reports AVX-512F, but byte and word support is needed as well.
+	// This also checks that the OS saves the AVX-512 state.
+	if (f == kFeatureCpuAVX512BW) return __builtin_cpu_supports("avx512bw");
+#endif
 #if SDL_VERSION_ATLEAST(2, 0, 6)
 	if (f == kFeatureCpuNEON) return SDL_HasNEON();
 #endif
@@ -374,6 +388,9 @@ void OSystem_SDL::initBackend() {
 		_timerManager = new SdlTimerManager();
 #endif
 
+	if (_jobSystem == nullptr)
+		_jobSystem = createSdlJobSystem();
+
 	_audiocdManager = createAudioCDManager();
 
 	// Setup a custom program icon.
@@ -853,6 +870,15 @@ uint32 OSystem_SDL::getMillis(bool skipRecord) {
 	return millis;
 }
 
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+uint64 OSystem_SDL::getMicros() {
+	const uint64 frequency = SDL_GetPerformanceFrequency();
+	const uint64 counter = SDL_GetPerformanceCounter();
+	// Split the conversion so that it can't overflow
+	return counter / frequency * 1000000 + counter % frequency * 1000000 / frequency;
+}
+#endif
+
 void OSystem_SDL::delayMillis(uint msecs) {
 #ifdef ENABLE_EVENTRECORDER
 	if (!g_eventRec.processDelayMillis())
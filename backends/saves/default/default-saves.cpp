@@ -37,11 +37,13 @@
 #include "common/archive.h"
 #include "common/config-manager.h"
 #include "common/compression/deflate.h"
+#include "common/memstream.h"
 
 #include <errno.h>	// for removeSavefile()
 
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
 const char *const DefaultSaveFileManager::TIMESTAMPS_FILENAME = "timestamps";
+const char *const DefaultSaveFileManager::HASHES_FILENAME = "hashes";
 #endif
 
 DefaultSaveFileManager::DefaultSaveFileManager() {
@@ -51,6 +53,83 @@ DefaultSaveFileManager::DefaultSaveFileManager(const Common::Path &defaultSavepa
 	ConfMan.registerDefault("savepath", defaultSavepath);
 }
 
+DefaultSaveFileManager::~DefaultSaveFileManager() {
+	// Do not lose savefiles which are still being written on shutdown
+	waitForPendingSaves();
+}
+
+/**
+ * Collects the savefile data in memory while the engine serializes its
+ * state. Once the stream is finalized, compressing the data and writing it
+ * to disk is left to a worker thread so the game does not stall.
+ */
+class DeferredSaveStream : public Common::MemoryWriteStreamDynamic {
+public:
+	DeferredSaveStream(DefaultSaveFileManager *manager, const Common::String &filename, Common::WriteStream *target) :
+		Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES), _manager(manager), _filename(filename), _target(target) {}
+
+	~DeferredSaveStream() override {
+		finalize();
+	}
+
+	void finalize() override {
+		if (!_target)
+			return;
+
+		// Hand the buffer over to the manager
+		_manager->queueSave(_filename, _target, _data, _size);
+		_target = nullptr;
+		_data = _ptr = nullptr;
+		_capacity = _size = _pos = 0;
+	}
+
+private:
+	DefaultSaveFileManager *_manager;
+	Common::String _filename;
+	Common::WriteStream *_target;
+};
+
+void DefaultSaveFileManager::queueSave(const Common::String &filename, Common::WriteStream *stream, byte *data, uint32 size) {
+	PendingSave *save = new PendingSave();
+	save->filename = filename;
+	save->stream = stream;
+	save->data = data;
+	save->size = size;
+	save->failed = false;
+	_pendingSaves.push_back(save);
+
+	g_system->getJobSystem()->submit(writePendingSave, save, &_pendingSaveGroup);
+}
+
+void DefaultSaveFileManager::writePendingSave(void *refCon) {
+	PendingSave *save = (PendingSave *)refCon;
+
+	// This runs on a worker thread, so only touch the save itself
+	if (save->size)
+		save->stream->write(save->data, save->size);
+	save->stream->finalize();
+	save->failed = save->stream->err();
+
+	delete save->stream;
+	save->stream = nullptr;
+	free(save->data);
+	save->data = nullptr;
+}
+
+void DefaultSaveFileManager::waitForPendingSaves() {
+	if (_pendingSaves.empty())
+		return;
+
+	g_system->getJobSystem()->wait(_pendingSaveGroup);
+
+	for (uint i = 0; i < _pendingSaves.size(); ++i) {
+		if (_pendingSaves[i]->failed)
+			warning("Failed to write savefile '%s'", _pendingSaves[i]->filename.c_str());
+		delete _pendingSaves[i];
+	}
+	_pendingSaves.clear();
+}
+
 
 void DefaultSaveFileManager::checkPath(const Common::FSNode &dir) {
 	clearError();
@@ -92,6 +171,8 @@ Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &filename) {
+	waitForPendingSaves();
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -108,6 +189,8 @@ Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &fi
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String &filename) {
+	waitForPendingSaves();
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -130,6 +213,8 @@ Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String
 }
 
 Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String &filename, bool compress) {
+	waitForPendingSaves();
+
 	// Assure the savefile name cache is up-to-date.
 	const Common::Path savePathName = getSavePath();
 	assureCached(savePathName);
@@ -165,7 +250,14 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 	Common::SeekableWriteStream *const sf = fileNode.createWriteStream();
 	if (!sf)
 		return nullptr;
-	Common::OutSaveFile *const result = new Common::OutSaveFile(compress ? Common::wrapCompressedWriteStream(sf) : sf);
+	Common::WriteStream *stream = compress ? Common::wrapCompressedWriteStream(sf) : sf;
+
+	// With worker threads available, let them compress and write the data
+	Common::JobSystem *jobSystem = g_system->getJobSystem();
+	if (jobSystem && jobSystem->getThreadCount() > 1)
+		stream = new DeferredSaveStream(this, filename, stream);
+
+	Common::OutSaveFile *const result = new Common::OutSaveFile(stream);
 
 	// Add file to cache now that it exists.
 	_saveFileCache[filename] = Common::FSNode(fileNode.getPath());
@@ -174,6 +266,8 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 }
 
 bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
+	waitForPendingSaves();
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -382,6 +476,62 @@ void DefaultSaveFileManager::saveTimestamps(Common::HashMap<Common::String, uint
 	f.close();
 }
 
+Common::HashMap<Common::String, DefaultSaveFileManager::SyncedFileHash> DefaultSaveFileManager::loadHashes() {
+	Common::HashMap<Common::String, SyncedFileHash> hashes;
+
+	Common::StringArray localFiles = g_system->getSavefileManager()->listSavefiles("*");
+	Common::HashMap<Common::String, bool> present;
+	for (uint32 i = 0; i < localFiles.size(); ++i)
+		present[localFiles[i]] = true;
+
+	Common::InSaveFile *file = g_system->getSavefileManager()->openRawFile(HASHES_FILENAME);
+	if (!file)
+		return hashes;
+
+	//every line is a 32 characters long MD5 hash, the remote timestamp and the filename, separated by spaces
+	while (!file->eos() && !file->err()) {
+		Common::String line = file->readLine();
+		if (line.size() < 34 || line[32] != ' ')
+			continue;
+
+		size_t separator = line.findFirstOf(' ', 33);
+		if (separator == Common::String::npos)
+			continue;
+
+		uint32 timestamp = line.substr(33, separator - 33).asUint64();
+		Common::String filename = line.substr(separator + 1);
+		if (timestamp != 0 && present.contains(filename))
+			hashes[filename] = SyncedFileHash(line.substr(0, 32), timestamp);
+	}
+
+	delete file;
+	return hashes;
+}
+
+void DefaultSaveFileManager::saveHashes(Common::HashMap<Common::String, SyncedFileHash> &hashes) {
+	Common::DumpFile f;
+	Common::Path filename = concatWithSavesPath(HASHES_FILENAME);
+	if (!f.open(filename, true)) {
+		warning("DefaultSaveFileManager: failed to open '%s' file to save hashes", filename.toString(Common::Path::kNativeSeparator).c_str());
+		return;
+	}
+
+	for (Common::HashMap<Common::String, SyncedFileHash>::iterator i = hashes.begin(); i != hashes.end(); ++i) {
+		if (i->_value.hash.empty())
+			continue;
+
+		Common::String data = i->_value.hash + Common::String::format(" %u ", i->_value.timestamp) + i->_key + "\n";
+		if (f.write(data.c_str(), data.size()) != data.size()) {
+			warning("DefaultSaveFileManager: failed to write hashes data into '%s'", filename.toString(Common::Path::kNativeSeparator).c_str());
+			return;
+		}
+	}
+
+	f.flush();
+	f.finalize();
+	f.close();
+}
+
 #endif // ifdef USE_LIBCURL
 
 Common::Path DefaultSaveFileManager::concatWithSavesPath(Common::String name) {
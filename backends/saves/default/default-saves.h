@@ -27,6 +27,7 @@
 #include "common/str.h"
 #include "common/fs.h"
 #include "common/hash-str.h"
+#include "common/jobs.h"
 
 /**
  * Provides a default savefile manager implementation for common platforms.
@@ -35,6 +36,7 @@ class DefaultSaveFileManager : public Common::SaveFileManager {
 public:
 	DefaultSaveFileManager();
 	DefaultSaveFileManager(const Common::Path &defaultSavepath);
+	~DefaultSaveFileManager() override;
 
 	void updateSavefilesList(Common::StringArray &lockedFiles) override;
 	Common::StringArray listSavefiles(const Common::String &pattern) override;
@@ -48,9 +50,26 @@ public:
 
 	static const uint32 INVALID_TIMESTAMP = UINT_MAX;
 	static const char *const TIMESTAMPS_FILENAME;
+	static const char *const HASHES_FILENAME;
 
 	static Common::HashMap<Common::String, uint32> loadTimestamps();
 	static void saveTimestamps(Common::HashMap<Common::String, uint32> &timestamps);
+
+	/** The content hash of a file when it was last synced, and its remote timestamp then. */
+	struct SyncedFileHash {
+		Common::String hash;
+		uint32 timestamp;
+
+		SyncedFileHash() : timestamp(INVALID_TIMESTAMP) {}
+		SyncedFileHash(const Common::String &h, uint32 t) : hash(h), timestamp(t) {}
+	};
+
+	/**
+	 * Load the content hashes the files had when they were last synced.
+	 * Files which are not present anymore are skipped.
+	 */
+	static Common::HashMap<Common::String, SyncedFileHash> loadHashes();
+	static void saveHashes(Common::HashMap<Common::String, SyncedFileHash> &hashes);
 #endif
 
 	static Common::Path concatWithSavesPath(Common::String name);
@@ -82,6 +101,12 @@ protected:
 	 */
 	void assureCached(const Common::Path &savePathName);
 
+	/**
+	 * Wait until all savefiles handed over to worker threads have been
+	 * written. Failed writes are reported as warnings.
+	 */
+	void waitForPendingSaves();
+
 	typedef Common::HashMap<Common::String, Common::FSNode, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SaveFileCache;
 
 	/**
@@ -100,10 +125,35 @@ protected:
 	Common::StringArray _lockedFiles;
 
 private:
+	friend class DeferredSaveStream;
+
+	/**
+	 * A savefile that was serialized into memory and is being compressed
+	 * and written by a worker thread.
+	 */
+	struct PendingSave {
+		Common::String filename;
+		Common::WriteStream *stream;
+		byte *data;
+		uint32 size;
+		bool failed;
+	};
+
+	/**
+	 * Queue writing the buffered savefile data to the given stream.
+	 * Takes ownership of both the stream and the data.
+	 */
+	void queueSave(const Common::String &filename, Common::WriteStream *stream, byte *data, uint32 size);
+
+	static void writePendingSave(void *refCon);
+
 	/**
 	 * The currently cached directory.
 	 */
 	Common::Path _cachedDirectory;
+
+	Common::Array<PendingSave *> _pendingSaves;
+	Common::JobGroup _pendingSaveGroup;
 };
 
 #endif
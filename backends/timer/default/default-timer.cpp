@@ -30,88 +30,83 @@ struct TimerSlot {
 	Common::String id;
 	uint32 interval;	// in microseconds
 
-	uint32 nextFireTime;	// in milliseconds
-	uint32 nextFireTimeMicro;	// microseconds part of nextFire
+	uint64 nextFireTime;	// in microseconds
 
-	TimerSlot *next;
-
-	TimerSlot() : callback(nullptr), refCon(nullptr), interval(0), nextFireTime(0), nextFireTimeMicro(0), next(nullptr) {}
+	TimerSlot() : callback(nullptr), refCon(nullptr), interval(0), nextFireTime(0) {}
 };
 
-void insertPrioQueue(TimerSlot *head, TimerSlot *newSlot) {
-	// The head points to a fake anchor TimerSlot; this common
-	// trick allows us to get rid of many special cases.
-
-	const uint32 nextFireTime = newSlot->nextFireTime;
-	TimerSlot *slot = head;
-	newSlot->next = nullptr;
-
-	// Insert the new slot into the sorted list of already scheduled
-	// timers in such a way that the list stays sorted...
-	while (true) {
-		assert(slot);
-		if (slot->next == nullptr || nextFireTime < slot->next->nextFireTime) {
-			newSlot->next = slot->next;
-			slot->next = newSlot;
-			return;
-		}
-		slot = slot->next;
-	}
-}
-
 
 DefaultTimerManager::DefaultTimerManager() :
-	_timerCallbackNext(0),
-	_head(nullptr) {
-
-	_head = new TimerSlot();
+	_timerCallbackNext(0) {
 }
 
 DefaultTimerManager::~DefaultTimerManager() {
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
-	while (slot) {
-		TimerSlot *next = slot->next;
-		delete slot;
-		slot = next;
+	for (uint i = 0; i < _slots.size(); ++i)
+		delete _slots[i];
+	_slots.clear();
+}
+
+void DefaultTimerManager::siftUp(uint index) {
+	TimerSlot *slot = _slots[index];
+	while (index > 0) {
+		const uint parent = (index - 1) / 2;
+		if (_slots[parent]->nextFireTime <= slot->nextFireTime)
+			break;
+		_slots[index] = _slots[parent];
+		index = parent;
 	}
-	_head = nullptr;
+	_slots[index] = slot;
 }
 
-void DefaultTimerManager::handler() {
-	Common::StackLock lock(_mutex);
+void DefaultTimerManager::siftDown(uint index) {
+	TimerSlot *slot = _slots[index];
+	const uint size = _slots.size();
+	while (true) {
+		uint child = index * 2 + 1;
+		if (child >= size)
+			break;
+		if (child + 1 < size && _slots[child + 1]->nextFireTime < _slots[child]->nextFireTime)
+			++child;
+		if (slot->nextFireTime <= _slots[child]->nextFireTime)
+			break;
+		_slots[index] = _slots[child];
+		index = child;
+	}
+	_slots[index] = slot;
+}
 
-	uint32 curTime = g_system->getMillis(true);
+uint32 DefaultTimerManager::handler() {
+	Common::StackLock lock(_mutex);
 
-	// On slow systems this could still be run after destructor
-	if (!_head)
-		return;
+	uint64 curTime = (uint64)g_system->getMillis(true) * 1000;
 
 	// Repeat as long as there is a TimerSlot that is scheduled to fire.
-	TimerSlot *slot = _head->next;
-	while (slot && slot->nextFireTime < curTime) {
-		// Remove the slot from the priority queue
-		_head->next = slot->next;
+	// The slots are kept in a binary min-heap, ordered by their fire time.
+	while (!_slots.empty() && _slots[0]->nextFireTime <= curTime) {
+		TimerSlot *slot = _slots[0];
 
-		// Update the fire time and reinsert the TimerSlot into the priority
-		// queue.
+		// Update the fire time and move the TimerSlot to its new place
+		// in the heap. This has to happen before invoking the callback,
+		// which is allowed to remove its own timer.
 		assert(slot->interval > 0);
-		slot->nextFireTime += (slot->interval / 1000);
-		slot->nextFireTimeMicro += (slot->interval % 1000);
-		if (slot->nextFireTimeMicro > 1000) {
-			slot->nextFireTime += slot->nextFireTimeMicro / 1000;
-			slot->nextFireTimeMicro %= 1000;
-		}
-		insertPrioQueue(_head, slot);
+		slot->nextFireTime += slot->interval;
+		siftDown(0);
 
 		// Invoke the timer callback
 		assert(slot->callback);
 		slot->callback(slot->refCon);
-
-		// Look at the next scheduled timer
-		slot = _head->next;
 	}
+
+	if (_slots.empty())
+		return UINT_MAX;
+
+	// Tell the backend how long it may wait, rounded up to milliseconds
+	curTime = (uint64)g_system->getMillis(true) * 1000;
+	if (_slots[0]->nextFireTime <= curTime)
+		return 0;
+	return (uint32)MIN<uint64>((_slots[0]->nextFireTime - curTime + 999) / 1000, UINT_MAX);
 }
 
 void DefaultTimerManager::checkTimers(uint32 interval) {
@@ -147,11 +142,10 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 	slot->refCon = refCon;
 	slot->id = id;
 	slot->interval = interval;
-	slot->nextFireTime = g_system->getMillis() + interval / 1000;
-	slot->nextFireTimeMicro = interval % 1000;
-	slot->next = nullptr;
+	slot->nextFireTime = (uint64)g_system->getMillis() * 1000 + interval;
 
-	insertPrioQueue(_head, slot);
+	_slots.push_back(slot);
+	siftUp(_slots.size() - 1);
 
 	return true;
 }
@@ -159,16 +153,19 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 void DefaultTimerManager::removeTimerProc(TimerProc callback) {
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
+	uint kept = 0;
+	for (uint i = 0; i < _slots.size(); ++i) {
+		if (_slots[i]->callback == callback)
+			delete _slots[i];
+		else
+			_slots[kept++] = _slots[i];
+	}
 
-	while (slot->next) {
-		if (slot->next->callback == callback) {
-			TimerSlot *next = slot->next->next;
-			delete slot->next;
-			slot->next = next;
-		} else {
-			slot = slot->next;
-		}
+	// Restore the heap order if any slot was removed
+	if (kept != _slots.size()) {
+		_slots.resize(kept);
+		for (uint i = kept / 2; i-- > 0;)
+			siftDown(i);
 	}
 
 	// We need to remove all names referencing the timer proc here.
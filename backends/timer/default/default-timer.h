@@ -22,6 +22,7 @@
 #ifndef BACKENDS_TIMER_DEFAULT_H
 #define BACKENDS_TIMER_DEFAULT_H
 
+#include "common/array.h"
 #include "common/str.h"
 #include "common/hash-str.h"
 #include "common/timer.h"
@@ -34,11 +35,14 @@ private:
 	typedef Common::HashMap<Common::String, TimerProc, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TimerSlotMap;
 
 	Common::Mutex _mutex;
-	TimerSlot *_head;
+	Common::Array<TimerSlot *> _slots;
 	TimerSlotMap _callbacks;
 
 	uint32 _timerCallbackNext;
 
+	void siftUp(uint index);
+	void siftDown(uint index);
+
 public:
 	DefaultTimerManager();
 	virtual ~DefaultTimerManager();
@@ -47,8 +51,11 @@ public:
 
 	/**
 	 * Timer callback, to be invoked at regular time intervals by the backend.
+	 *
+	 * @return The number of milliseconds until the next timer is due, which
+	 *         backends may use to schedule the following invocation.
 	 */
-	void handler();
+	uint32 handler();
 
 	/*
 	 * Ensure that the callback is called at regular time intervals.
@@ -27,16 +27,18 @@
 #include "backends/timer/sdl/sdl-timer.h"
 
 #include "common/textconsole.h"
+#include "common/util.h"
+
+// Wake up when the next timer is due, but at least every 10 ms as before
+static const Uint32 kMaxTimerDelay = 10;
 
 #if SDL_VERSION_ATLEAST(3, 0, 0)
 static Uint32 timer_handler(void *userdata, SDL_TimerID timerID, Uint32 interval) {
-	((DefaultTimerManager *)userdata)->handler();
-	return interval;
+	return CLIP<uint32>(((DefaultTimerManager *)userdata)->handler(), 1, kMaxTimerDelay);
 }
 #else
 static Uint32 timer_handler(Uint32 interval, void *param) {
-	((DefaultTimerManager *)param)->handler();
-	return interval;
+	return CLIP<uint32>(((DefaultTimerManager *)param)->handler(), 1, kMaxTimerDelay);
 }
 #endif
 
@@ -49,7 +51,7 @@ SdlTimerManager::SdlTimerManager() {
 #endif
 
 	// Creates the timer callback
-	_timerID = SDL_AddTimer(10, &timer_handler, this);
+	_timerID = SDL_AddTimer(kMaxTimerDelay, &timer_handler, this);
 }
 
 SdlTimerManager::~SdlTimerManager() {
@@ -156,6 +156,7 @@ static const char HELP_STRING4[] =
 	"  --debugflags=FLAGS       Enable engine specific debug flags\n"
 	"                           (separated by commas)\n"
 	"  --debug-channels-only    Show only the specified debug channels\n"
+	"  --profile-startup        Print how long each stage of the startup takes\n"
 	"  -u, --dump-scripts       Enable script dumping if a directory called 'dumps'\n"
 	"                           exists in the current directory\n"
 	"\n"
@@ -198,8 +199,13 @@ static const char HELP_STRING4[] =
 	"                           atari, macintosh, macintoshbw, vgaGray)\n"
 #ifdef ENABLE_EVENTRECORDER
 	"  --record-mode=MODE       Specify record mode for event recorder (record, playback,\n"
-	"                           info, update, passthrough [default])\n"
+	"                           trace, info, update, passthrough [default])\n"
 	"  --record-file-name=FILE  Specify record file name\n"
+	"  --record-trace-file=FILE\n"
+	"                           When tracing, write the frame timings and screen hashes\n"
+	"                           to FILE (default: the record file name with .trace)\n"
+	"  --record-trace-reference=FILE\n"
+	"                           When tracing, compare the trace to the one in FILE\n"
 	"  --disable-display        Disable any gfx output. Used for headless events\n"
 	"                           playback by Event Recorder\n"
 	"  --screenshot-period=NUM  When recording, trigger a screenshot every NUM milliseconds\n"
@@ -410,6 +416,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("fluidsynth_reverb_level", 90);
 
 	ConfMan.registerDefault("fluidsynth_misc_interpolation", "4th");
+	ConfMan.registerDefault("fluidsynth_misc_cpu_cores", 1);
 #endif
 #ifdef USE_DISCORD
 	ConfMan.registerDefault("discord_rpc", true);
@@ -757,6 +764,9 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			DO_LONG_OPTION_BOOL("debug-channels-only")
 			END_OPTION
 
+			DO_LONG_OPTION_BOOL("profile-startup")
+			END_OPTION
+
 			DO_OPTION('e', "music-driver")
 			END_OPTION
 
@@ -804,6 +814,12 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			DO_LONG_OPTION("record-file-name")
 			END_OPTION
 
+			DO_LONG_OPTION("record-trace-file")
+			END_OPTION
+
+			DO_LONG_OPTION("record-trace-reference")
+			END_OPTION
+
 			DO_LONG_COMMAND("list-records")
 			END_COMMAND
 
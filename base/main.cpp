@@ -52,6 +52,7 @@
 #include "common/translation.h"
 #include "common/text-to-speech.h"
 #include "common/osd_message_queue.h"
+#include "common/profiler.h"
 
 #include "gui/gui-manager.h"
 #include "gui/error.h"
@@ -98,7 +99,44 @@
 
 #include "gui/dump-all-dialogs.h"
 
+// Startup profiling, see --profile-startup
+static bool profileStartup = false;
+static uint64 startupBegin = 0;
+static uint64 startupStageBegin = 0;
+
+static void startupStageDone(const char *stage) {
+	if (!profileStartup)
+		return;
+
+	const uint64 now = g_system->getMicros();
+	debug("Startup: %-30s %8.2f ms (total %8.2f ms)", stage, (now - startupStageBegin) / 1000.0, (now - startupBegin) / 1000.0);
+	startupStageBegin = now;
+}
+
+// Things only needed by the launcher. When a game is started directly, e.g.
+// on a kiosk, they are postponed until the launcher is shown, if ever, so the
+// game does not wait for them.
+static void initLauncherServices() {
+	static bool initialized = false;
+	if (initialized)
+		return;
+	initialized = true;
+
+#ifdef USE_UPDATES
+	if (!ConfMan.hasKey("updates_check") && g_system->getUpdateManager()) {
+		GUI::UpdatesDialog dlg;
+		dlg.runModal();
+	}
+#endif
+
+#if defined(USE_CLOUD) && defined(USE_LIBCURL)
+	// The saves are synced again whenever the save/load dialog is opened
+	CloudMan.syncSaves();
+#endif
+}
+
 static bool launcherDialog() {
+	initLauncherServices();
 
 	// Discard any command line options. Those that affect the graphics
 	// mode and the others (like bootparam etc.) should not
@@ -307,8 +345,16 @@ static Common::Error runGame(const Plugin *enginePlugin, OSystem &system, const
 	system.getEventManager()->purgeKeyboardEvents();
 	system.getEventManager()->purgeMouseEvents();
 
+	startupStageDone("engine instance");
+	profileStartup = false;
+
 	// Run the engine
-	Common::Error result = engine->run();
+	PROFILE_THREAD_NAME("Main");
+	Common::Error result;
+	{
+		PROFILE_ZONE("Engine::run");
+		result = engine->run();
+	}
 
 	// Make sure we do not return to the launcher if this is not possible.
 	if (!engine->hasFeature(Engine::kSupportsReturnToLauncher))
@@ -404,6 +450,8 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	assert(g_system);
 	OSystem &system = *g_system;
 
+	startupBegin = startupStageBegin = system.getMicros();
+
 	// Register config manager defaults
 	Base::registerDefaults();
 	system.registerDefaultSettings(Common::ConfigManager::kApplicationDomain);
@@ -484,6 +532,10 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	if (settings.contains("debug-channels-only"))
 		gDebugChannelsOnly = true;
 
+	if (settings.contains("profile-startup")) {
+		profileStartup = (settings["profile-startup"] == "true");
+		settings.erase("profile-startup"); // This option should not be passed to ConfMan.
+	}
 
 	// Now we want to enable global flags if any
 	Common::StringTokenizer tokenizer(specialDebug, " ,");
@@ -495,11 +547,15 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 			DebugMan.enableDebugChannel(token);
 	}
 
+	startupStageDone("command line and config");
+
 	ConfMan.registerDefault("always_run_fallback_detection_extern", true);
 	PluginManager::instance().init();
  	PluginManager::instance().loadAllPlugins(); // load plugins for cached plugin manager
 	PluginManager::instance().loadDetectionPlugin(); // load detection plugin for uncached plugin manager
 
+	startupStageDone("plugins");
+
 	// If we received an invalid music parameter via command line we check this here.
 	// We can't check this before loading the music plugins.
 	// On the other hand we cannot load the plugins before we know the file paths (in case of external plugins).
@@ -553,6 +609,8 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	// the command line params) was read.
 	system.initBackend();
 
+	startupStageDone("backend");
+
 	// If we received an invalid graphics mode parameter via command line
 	// we check this here. We can't do it until after the backend is inited,
 	// or there won't be a graphics manager to ask for the supported modes.
@@ -581,6 +639,8 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	}
 	setupGraphics(system);
 
+	startupStageDone("graphics");
+
 	if (!configLoadStatus) {
 		GUI::MessageDialog alert(_("Bad config file format. overwrite?"), _("Yes"), _("Cancel"));
 		if (alert.runModal() != GUI::kMessageOK)
@@ -611,12 +671,7 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	// Now as the event manager is created, setup the keymapper
 	setupKeymapper(system);
 
-#ifdef USE_UPDATES
-	if (!ConfMan.hasKey("updates_check") && g_system->getUpdateManager()) {
-		GUI::UpdatesDialog dlg;
-		dlg.runModal();
-	}
-#endif
+	startupStageDone("event manager and keymapper");
 
 #ifdef ANDROID_BACKEND
 	// This early popup message for Android, informing the users about important
@@ -688,8 +743,10 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 #endif
 
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
+	// Needed while playing too, for uploading saves
 	CloudMan.init();
-	CloudMan.syncSaves();
+
+	startupStageDone("cloud");
 #endif
 
 #if 0
@@ -703,6 +760,7 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 
 		byte sse2Support = 0;
 		byte avx2Support = 0;
+		byte avx512Support = 0;
 		byte neonSupport = 0;
 
 #ifdef SCUMMVM_SSE2
@@ -715,6 +773,11 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 		if (g_system->hasFeature(OSystem::kFeatureCpuAVX2))
 			++avx2Support;
 #endif
+#ifdef SCUMMVM_AVX512
+		++avx512Support;
+		if (g_system->hasFeature(OSystem::kFeatureCpuAVX512BW))
+			++avx512Support;
+#endif
 #ifdef SCUMMVM_NEON
 		++neonSupport;
 		if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
@@ -722,15 +785,20 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 #endif
 
 		debug(0, "CPU extensions:");
-		debug(0, "SSE2(%s) AVX2(%s) NEON(%s)",
+		debug(0, "SSE2(%s) AVX2(%s) AVX-512BW(%s) NEON(%s)",
 			extensionSupportString[sse2Support].c_str(),
 			extensionSupportString[avx2Support].c_str(),
+			extensionSupportString[avx512Support].c_str(),
 			extensionSupportString[neonSupport].c_str());
 	}
 
 	// Unless a game was specified, show the launcher dialog
-	if (nullptr == ConfMan.getActiveDomain())
+	if (nullptr == ConfMan.getActiveDomain()) {
+		startupStageDone("launcher");
+		profileStartup = false;
+
 		launcherDialog();
+	}
 
 	// FIXME: We're now looping the launcher. This, of course, doesn't
 	// work as well as it should. In theory everything should be destroyed
@@ -747,6 +815,8 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 		const void *meDescriptor = nullptr;
 		Common::Error result = identifyGame(specialDebug, &plugin, game, &meDescriptor);
 
+		startupStageDone("game detection");
+
 		if (result.getCode() == Common::kNoError) {
 			Common::String engineId = plugin->getName();
 #if defined(UNCACHED_PLUGINS) && defined(DYNAMIC_MODULES) && !defined(DETECTION_STATIC)
@@ -759,6 +829,8 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 			if (enginePlugin == nullptr) {
 				result = Common::kEnginePluginNotFound;
 			}
+
+			startupStageDone("engine plugin");
 		}
 
 		if (result.getCode() == Common::kNoError) {
@@ -779,6 +851,8 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 				g_eventRec.init(recordFileName, GUI::EventRecorder::kRecorderUpdate);
 			} else if (recordMode == "playback") {
 				g_eventRec.init(recordFileName, GUI::EventRecorder::kRecorderPlayback);
+			} else if (recordMode == "trace") {
+				g_eventRec.init(recordFileName, GUI::EventRecorder::kRecorderPlayback, true);
 			} else if ((recordMode == "info") && (!recordFileName.empty())) {
 				Common::PlaybackFile record;
 				record.openRead(recordFileName);
@@ -25,10 +25,7 @@
 #include "common/debug.h"
 #include "common/debug-channels.h"
 #include "common/config-manager.h"
-
-#ifdef DYNAMIC_MODULES
 #include "common/fs.h"
-#endif
 
 #include "base/detection/detection.h"
 
@@ -354,6 +351,115 @@ void PluginManagerUncached::init() {
 			}
  		}
  	}
+
+	validatePluginIndex();
+}
+
+/**
+ * Return a string identifying the current version of a plugin file, or an
+ * empty string if the file can't be inspected.
+ **/
+Common::String PluginManagerUncached::getPluginFileStamp(const Common::Path &filename) {
+	int64 size, modificationTime;
+	if (filename.empty() || !Common::FSNode(filename).getFileInfo(size, modificationTime))
+		return Common::String();
+
+	return Common::String::format("%lld:%lld", (long long)size, (long long)modificationTime);
+}
+
+/**
+ * Drop the entries of the plugin index whose plugin file has disappeared or
+ * was changed since the entry was recorded.
+ **/
+void PluginManagerUncached::validatePluginIndex() {
+	Common::ConfigManager::Domain *files = ConfMan.getDomain("engine_plugin_files");
+	if (!files)
+		return;
+
+	Common::ConfigManager::Domain *stamps = ConfMan.getDomain("engine_plugin_stamps");
+
+	Common::StringArray staleEngines;
+	for (Common::ConfigManager::Domain::const_iterator i = files->begin(); i != files->end(); ++i) {
+		Common::Path filename(Common::Path::fromConfig(i->_value));
+
+		bool found = false;
+		for (PluginList::iterator p = _allEnginePlugins.begin(); p != _allEnginePlugins.end(); ++p) {
+			if ((*p)->getFileName() == filename) {
+				found = true;
+				break;
+			}
+		}
+
+		// Entries without a stamp come from older versions. They are kept,
+		// as they are checked when loading the plugin anyway.
+		if (!found || (stamps && stamps->contains(i->_key) && (*stamps)[i->_key] != getPluginFileStamp(filename)))
+			staleEngines.push_back(i->_key);
+	}
+
+	for (uint i = 0; i < staleEngines.size(); i++) {
+		debug(9, "Dropping outdated plugin index entry for '%s'", staleEngines[i].c_str());
+		files->erase(staleEngines[i]);
+		if (stamps)
+			stamps->erase(staleEngines[i]);
+	}
+}
+
+/**
+ * Record in the ConfigManager which plugin file contains an engine.
+ **/
+void PluginManagerUncached::addToPluginIndex(const Common::String &engineId, const Common::Path &filename) {
+	if (!ConfMan.hasMiscDomain("engine_plugin_files"))
+		ConfMan.addMiscDomain("engine_plugin_files");
+	if (!ConfMan.hasMiscDomain("engine_plugin_stamps"))
+		ConfMan.addMiscDomain("engine_plugin_stamps");
+
+	ConfMan.getDomain("engine_plugin_files")->setVal(engineId, filename.toConfig());
+
+	Common::String stamp = getPluginFileStamp(filename);
+	if (!stamp.empty())
+		ConfMan.getDomain("engine_plugin_stamps")->setVal(engineId, stamp);
+	else
+		ConfMan.getDomain("engine_plugin_stamps")->erase(engineId);
+}
+
+/**
+ * Load every plugin file that isn't in the plugin index yet, once per
+ * session, and record the engine it contains. Afterwards, finding the plugin
+ * of any engine only needs to load that plugin.
+ *
+ * @return True if new entries were added to the index.
+ **/
+bool PluginManagerUncached::updatePluginIndex() {
+	if (_isPluginIndexUpdated)
+		return false;
+	_isPluginIndexUpdated = true;
+
+	// Plugin files which are already in the index
+	Common::StringMap indexedFiles;
+	const Common::ConfigManager::Domain *files = ConfMan.getDomain("engine_plugin_files");
+	if (files) {
+		for (Common::ConfigManager::Domain::const_iterator i = files->begin(); i != files->end(); ++i)
+			indexedFiles.setVal(i->_value, i->_key);
+	}
+
+	bool updated = false;
+	for (PluginList::iterator p = _allEnginePlugins.begin(); p != _allEnginePlugins.end(); ++p) {
+		Common::Path filename = (*p)->getFileName();
+		if (filename.empty() || indexedFiles.contains(filename.toConfig()) || !loadPluginByFileName(filename))
+			continue;
+
+		const PluginList &plugins = getPlugins(PLUGIN_TYPE_ENGINE);
+		for (PluginList::const_iterator i = plugins.begin(); i != plugins.end(); ++i) {
+			addToPluginIndex((*i)->get<MetaEngine>().getName(), filename);
+			updated = true;
+		}
+	}
+
+	unloadPluginsExcept(PLUGIN_TYPE_ENGINE, nullptr, false);
+
+	if (updated)
+		ConfMan.flushToDisk();
+	return updated;
 }
 
 /**
@@ -416,13 +522,7 @@ bool PluginManagerUncached::loadPluginByFileName(const Common::Path &filename) {
 void PluginManagerUncached::updateConfigWithFileName(const Common::String &engineId) {
 	// Check if we have a filename for the current plugin
 	if (!(*_currentPlugin)->getFileName().empty()) {
-		if (!ConfMan.hasMiscDomain("engine_plugin_files"))
-			ConfMan.addMiscDomain("engine_plugin_files");
-
-		Common::ConfigManager::Domain *domain = ConfMan.getDomain("engine_plugin_files");
-		assert(domain);
-		(*domain).setVal(engineId, (*_currentPlugin)->getFileName().toConfig());
-
+		addToPluginIndex(engineId, (*_currentPlugin)->getFileName());
 		ConfMan.flushToDisk();
 	}
 }
@@ -709,6 +809,8 @@ DetectionResults EngineManager::detectGames(const Common::FSList &fslist, uint32
 
 	// Close all archives that were opened during detection
 	ADCacheMan.clearArchives();
+	// Mass adds detect many directories in a row, so don't save every time
+	ADCacheMan.savePersistentCache(false);
 
 	return DetectionResults(candidates);
 }
@@ -811,6 +913,14 @@ const Plugin *PluginManager::findEnginePlugin(const Common::String &engineId) {
 			return plugin;
 	}
 
+	// The plugin index may be incomplete, e.g. on the first run or after new
+	// plugins were installed. Complete it and try again.
+	if (updatePluginIndex() && loadPluginFromEngineId(engineId)) {
+		plugin = findLoadedPlugin(engineId);
+		if (plugin)
+			return plugin;
+	}
+
 	// We failed to find it using the engine ID. Scan the list of plugins
 	PluginMan.loadFirstPlugin();
 	do {
@@ -321,6 +321,7 @@ public:
 	virtual bool loadNextPlugin() { return false; }
 	virtual bool loadPluginFromEngineId(const Common::String &engineId) { return false; }
 	virtual void updateConfigWithFileName(const Common::String &engineId) {}
+	virtual bool updatePluginIndex() { return false; }
 	virtual void loadDetectionPlugin() {}
 	virtual void unloadDetectionPlugin() {}
 
@@ -345,9 +346,13 @@ protected:
 	PluginList::iterator _currentPlugin;
 
 	bool _isDetectionLoaded;
+	bool _isPluginIndexUpdated;
 
-	PluginManagerUncached() : _detectionPlugin(nullptr), _currentPlugin(nullptr), _isDetectionLoaded(false) {}
+	PluginManagerUncached() : _detectionPlugin(nullptr), _currentPlugin(nullptr), _isDetectionLoaded(false), _isPluginIndexUpdated(false) {}
 	bool loadPluginByFileName(const Common::Path &filename);
+	void addToPluginIndex(const Common::String &engineId, const Common::Path &filename);
+	void validatePluginIndex();
+	static Common::String getPluginFileStamp(const Common::Path &filename);
 
 public:
 	virtual ~PluginManagerUncached();
@@ -356,6 +361,7 @@ public:
 	bool loadNextPlugin() override;
 	bool loadPluginFromEngineId(const Common::String &engineId) override;
 	void updateConfigWithFileName(const Common::String &engineId) override;
+	bool updatePluginIndex() override;
 #ifndef DETECTION_STATIC
 	void loadDetectionPlugin() override;
 	void unloadDetectionPlugin() override;
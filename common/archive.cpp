@@ -120,6 +120,22 @@ int Archive::listMatchingMembers(ArchiveMemberList &list, const Path &pattern, b
 	return matches;
 }
 
+ArchiveReadRequest::~ArchiveReadRequest() {
+	delete getStream();
+}
+
+SeekableReadStream *ArchiveReadRequest::getStream() {
+	wait();
+
+	SeekableReadStream *stream = _stream;
+	_stream = nullptr;
+	return stream;
+}
+
+ArchiveReadRequest *Archive::requestReadStream(const Path &path) const {
+	return new ArchiveReadRequest(createReadStreamForMember(path));
+}
+
 SeekableReadStream *Archive::createReadStreamForMemberAltStream(const Path &path, AltStreamType altStreamType) const {
 	return nullptr;
 }
@@ -624,6 +640,45 @@ SeekableReadStream *SearchSet::createReadStreamForMemberNext(const Path &path, c
 	return nullptr;
 }
 
+ArchiveReadRequest *SearchSet::requestReadStream(const Path &path) const {
+	if (!path.empty()) {
+		for (ArchiveNodeList::const_iterator it = _list.begin(); it != _list.end(); ++it) {
+			if (it->_arc->hasFile(path))
+				return it->_arc->requestReadStream(path);
+		}
+	}
+
+	return new ArchiveReadRequest(nullptr);
+}
+
+void SearchSet::prefetchMembers(const Array<Path> &paths) const {
+	// Find the archive responsible for each name
+	Array<const Archive *> owners(paths.size(), nullptr);
+	for (uint i = 0; i < paths.size(); i++) {
+		if (paths[i].empty())
+			continue;
+
+		for (ArchiveNodeList::const_iterator it = _list.begin(); it != _list.end(); ++it) {
+			if (it->_arc->hasFile(paths[i])) {
+				owners[i] = it->_arc;
+				break;
+			}
+		}
+	}
+
+	// Then hand each archive all of its names at once
+	for (ArchiveNodeList::const_iterator it = _list.begin(); it != _list.end(); ++it) {
+		Array<Path> members;
+		for (uint i = 0; i < paths.size(); i++) {
+			if (owners[i] == it->_arc)
+				members.push_back(paths[i]);
+		}
+
+		if (!members.empty())
+			it->_arc->prefetchMembers(members);
+	}
+}
+
 SearchManager::SearchManager() {
 	clear(); // Force a reset
 }
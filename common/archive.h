@@ -22,10 +22,12 @@
 #ifndef COMMON_ARCHIVE_H
 #define COMMON_ARCHIVE_H
 
+#include "common/array.h"
 #include "common/error.h"
 #include "common/hashmap.h"
 #include "common/hash-str.h"
 #include "common/list.h"
+#include "common/noncopyable.h"
 #include "common/path.h"
 #include "common/ptr.h"
 #include "common/singleton.h"
@@ -133,6 +135,38 @@ private:
 };
 
 
+/**
+ * Handle on a member stream requested with Archive::requestReadStream().
+ *
+ * The stream may be opened on a worker thread. Deleting the request waits
+ * for it to complete, and also deletes the stream if nobody took it.
+ */
+class ArchiveReadRequest : NonCopyable {
+public:
+	/** Create a request which has already completed with @p stream. */
+	explicit ArchiveReadRequest(SeekableReadStream *stream) : _stream(stream) {}
+	virtual ~ArchiveReadRequest();
+
+	/** Return true if getStream() won't block. */
+	virtual bool isReady() const { return true; }
+
+	/**
+	 * Wait for the request to complete and take ownership of its stream.
+	 * Later calls return nullptr.
+	 *
+	 * @return The stream, or nullptr if the member could not be opened.
+	 */
+	SeekableReadStream *getStream();
+
+protected:
+	ArchiveReadRequest() : _stream(nullptr) {}
+
+	/** Block until @ref _stream has been set. */
+	virtual void wait() {}
+
+	SeekableReadStream *_stream;
+};
+
 /**
  * The Archive class allows for managing the members of arbitrary containers in a uniform
  * fashion, allowing lookup by (file) names.
@@ -204,6 +238,26 @@ public:
 		return createReadStreamForMember(path);
 	}
 
+	/**
+	 * Request a stream for the member with the specified name, without
+	 * blocking if the archive supports opening it in the background.
+	 *
+	 * The default implementation opens the stream right away.
+	 *
+	 * @return A request which must be deleted by the caller, never nullptr.
+	 */
+	virtual ArchiveReadRequest *requestReadStream(const Path &path) const;
+
+	/**
+	 * Hint that the members with the specified names are likely to be
+	 * opened soon, e.g. because the engine is about to enter a new room.
+	 *
+	 * Archives on slow media may start loading them in the background, so
+	 * that a later createReadStreamForMember() call returns faster. The
+	 * default implementation does nothing.
+	 */
+	virtual void prefetchMembers(const Array<Path> &paths) const {}
+
 	/**
 	 * Dump all files from the archive to the given directory
 	 */
@@ -471,11 +525,24 @@ public:
 	 */
 	SeekableReadStream *createReadStreamForMemberNext(const Path &path, const Archive *starting) const override;
 
+	/**
+	 * Implement requestReadStream from the Archive base class, by forwarding
+	 * the request to the first archive which has a file with that name.
+	 */
+	ArchiveReadRequest *requestReadStream(const Path &path) const override;
+
+	/**
+	 * Implement prefetchMembers from the Archive base class, by forwarding
+	 * every name to the first archive which has a file with that name.
+	 */
+	void prefetchMembers(const Array<Path> &paths) const override;
+
 	/**
 	 * Ignore clashes when adding directories. For more details, see the corresponding parameter
 	 * in @ref FSDirectory documentation.
 	 */
 	void setIgnoreClashes(bool ignoreClashes) { _ignoreClashes = ignoreClashes; }
+	bool getIgnoreClashes() const { return _ignoreClashes; }
 
 	bool getChildren(const Common::Path &path, Common::Array<Common::String> &list, ListMode mode = kListDirectoriesOnly, bool hidden = true) const override;
 };
@@ -0,0 +1,125 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/arena.h"
+#include "common/str.h"
+#include "common/textconsole.h"
+
+namespace Common {
+
+Arena::Arena(size_t chunkSize) : _chunkSize(chunkSize), _first(nullptr), _current(nullptr),
+		_next(nullptr), _end(nullptr), _destructors(nullptr) {
+	assert(chunkSize > kChunkHeaderSize);
+}
+
+Arena::~Arena() {
+	release();
+}
+
+void Arena::setCurrent(Chunk *chunk) {
+	_current = chunk;
+	_next = getData(chunk);
+	_end = _next + chunk->size;
+}
+
+void *Arena::allocateSlow(size_t size, size_t alignment) {
+	assert((alignment & (alignment - 1)) == 0);
+
+	// The data of a chunk is only aligned like malloc aligns
+	const size_t needed = size + (alignment > kDefaultAlignment ? alignment - 1 : 0);
+
+	// Reuse the chunks kept from before the last reset, unless the
+	// allocation doesn't fit
+	Chunk *next = _current ? _current->next : _first;
+	if (!next || next->size < needed) {
+		const size_t dataSize = MAX<size_t>(_chunkSize - kChunkHeaderSize, needed);
+		Chunk *chunk = (Chunk *)malloc(kChunkHeaderSize + dataSize);
+		if (!chunk)
+			error("Arena: Couldn't allocate %u bytes", (uint)(kChunkHeaderSize + dataSize));
+
+		chunk->size = dataSize;
+		chunk->next = next;
+		if (_current)
+			_current->next = chunk;
+		else
+			_first = chunk;
+		next = chunk;
+	}
+
+	setCurrent(next);
+	return allocate(size, alignment);
+}
+
+char *Arena::copyString(const char *str) {
+	const size_t size = strlen(str) + 1;
+	char *copy = (char *)allocate(size, 1);
+	memcpy(copy, str, size);
+	return copy;
+}
+
+char *Arena::copyString(const String &str) {
+	char *copy = (char *)allocate(str.size() + 1, 1);
+	memcpy(copy, str.c_str(), str.size() + 1);
+	return copy;
+}
+
+void Arena::runDestructors(Destructor *until) {
+	while (_destructors != until) {
+		Destructor *destructor = _destructors;
+		_destructors = destructor->next;
+		destructor->func(destructor->object);
+	}
+}
+
+void Arena::rewind(const Marker &marker) {
+	runDestructors(marker.destructors);
+
+	_current = marker.chunk;
+	_next = marker.next;
+	_end = _current ? getData(_current) + _current->size : nullptr;
+}
+
+void Arena::reset() {
+	runDestructors(nullptr);
+
+	// The next allocation starts over with the first chunk
+	_current = nullptr;
+	_next = _end = nullptr;
+}
+
+void Arena::release() {
+	reset();
+
+	while (_first) {
+		Chunk *next = _first->next;
+		free(_first);
+		_first = next;
+	}
+}
+
+size_t Arena::getCapacity() const {
+	size_t capacity = 0;
+	for (const Chunk *chunk = _first; chunk; chunk = chunk->next)
+		capacity += kChunkHeaderSize + chunk->size;
+	return capacity;
+}
+
+} // End of namespace Common
@@ -0,0 +1,238 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_ARENA_H
+#define COMMON_ARENA_H
+
+#include "common/scummsys.h"
+#include "common/noncopyable.h"
+#include "common/util.h"
+
+namespace Common {
+
+class String;
+
+/**
+ * @defgroup common_arena Arena allocator
+ * @ingroup common_memory
+ *
+ * @brief Allocator for data which is all freed at once.
+ * @{
+ */
+
+/**
+ * An arena hands out memory by bumping a pointer through large chunks, and
+ * frees all of it at once on reset(). This suits data which lives for a
+ * frame or a room, like render lists, without calling malloc for each of
+ * its parts.
+ *
+ * The chunks are kept across resets, so an arena used once per frame stops
+ * allocating from the system once it has grown to the size of a frame.
+ * Allocations larger than a chunk get a chunk of their own.
+ *
+ * Memory from raw allocations is never initialized or destructed. Objects
+ * made with create() on the other hand get their destructor called when the
+ * arena is reset or rewound past them.
+ *
+ * An arena must not be used from several threads at once.
+ */
+class Arena : NonCopyable {
+	struct Chunk;
+	struct Destructor;
+
+public:
+	enum {
+		kDefaultChunkSize = 64 * 1024,
+		kDefaultAlignment = 2 * sizeof(void *)
+	};
+
+	/** A position in the arena, to rewind to later. */
+	struct Marker {
+		Chunk *chunk;
+		byte *next;
+		Destructor *destructors;
+	};
+
+	/** @param chunkSize  The size of the chunks the arena allocates from the system. */
+	explicit Arena(size_t chunkSize = kDefaultChunkSize);
+	~Arena();
+
+	/**
+	 * Allocate memory, which stays valid until the arena is reset or rewound.
+	 *
+	 * @param size       Number of bytes; 0 returns a unique pointer, too.
+	 * @param alignment  Alignment of the memory, which must be a power of two.
+	 */
+	void *allocate(size_t size, size_t alignment = kDefaultAlignment) {
+		const uintptr pos = ((uintptr)_next + alignment - 1) & ~(uintptr)(alignment - 1);
+		if (_current && pos + size <= (uintptr)_end) {
+			_next = (byte *)pos + size;
+			return (byte *)pos;
+		}
+		return allocateSlow(size, alignment);
+	}
+
+	/** Allocate uninitialized memory for @p count objects of type T. */
+	template<class T>
+	T *allocateArray(size_t count) {
+		return (T *)allocate(count * sizeof(T), alignof(T));
+	}
+
+	/**
+	 * Construct an object in the arena. Its destructor is called when the
+	 * arena is reset or rewound past it, so it must not be deleted.
+	 */
+	template<class T, class... TArgs>
+	T *create(TArgs &&...args) {
+		Destructor *destructor = (Destructor *)allocate(sizeof(Destructor), alignof(Destructor));
+		T *object = new (allocate(sizeof(T), alignof(T))) T(Common::forward<TArgs>(args)...);
+		destructor->func = &destroy<T>;
+		destructor->object = object;
+		destructor->next = _destructors;
+		_destructors = destructor;
+		return object;
+	}
+
+	/** Copy a nul-terminated string into the arena. */
+	char *copyString(const char *str);
+	/** @overload */
+	char *copyString(const String &str);
+
+	/** Change the size of the chunks allocated from now on. */
+	void setChunkSize(size_t chunkSize) {
+		assert(chunkSize > kChunkHeaderSize);
+		_chunkSize = chunkSize;
+	}
+
+	/** Return the current position, to rewind to later. */
+	Marker getMarker() const {
+		Marker marker = { _current, _next, _destructors };
+		return marker;
+	}
+
+	/**
+	 * Free everything allocated since the marker was taken. Markers taken
+	 * in between become invalid.
+	 */
+	void rewind(const Marker &marker);
+
+	/** Free everything allocated from the arena, but keep its chunks for reuse. */
+	void reset();
+
+	/** Free everything allocated from the arena, including its chunks. */
+	void release();
+
+	/** Return the number of bytes allocated from the system. */
+	size_t getCapacity() const;
+
+private:
+	struct Chunk {
+		Chunk *next;
+		size_t size;
+	};
+
+	struct Destructor {
+		void (*func)(void *object);
+		void *object;
+		Destructor *next;
+	};
+
+	template<class T>
+	static void destroy(void *object) {
+		((T *)object)->~T();
+	}
+
+	static byte *getData(Chunk *chunk) { return (byte *)chunk + kChunkHeaderSize; }
+
+	void *allocateSlow(size_t size, size_t alignment);
+	void runDestructors(Destructor *until);
+	void setCurrent(Chunk *chunk);
+
+	enum {
+		// Keep the data of a chunk aligned like malloc does
+		kChunkHeaderSize = (sizeof(Chunk) + kDefaultAlignment - 1) & ~(kDefaultAlignment - 1)
+	};
+
+	size_t _chunkSize;
+	Chunk *_first;           ///< All the chunks, in the order they are used in.
+	Chunk *_current;         ///< The chunk allocations are made from, or nullptr before the first one.
+	byte *_next;             ///< Start of the free memory in the current chunk.
+	byte *_end;              ///< End of the current chunk.
+	Destructor *_destructors; ///< Objects to destruct, most recently created first.
+};
+
+/**
+ * Rewinds an arena to where it was when the scope was entered, e.g. for
+ * scratch memory needed by a single function.
+ */
+class ArenaScope : NonCopyable {
+public:
+	explicit ArenaScope(Arena &arena) : _arena(arena), _marker(arena.getMarker()) {}
+	~ArenaScope() { _arena.rewind(_marker); }
+
+private:
+	Arena &_arena;
+	const Arena::Marker _marker;
+};
+
+/**
+ * Allocator with the interface of the C++ standard library, handing out
+ * memory from an arena. Deallocation is a no-op; the memory is reclaimed
+ * when the arena is reset.
+ */
+template<class T>
+class ArenaAllocator {
+	template<class U> friend class ArenaAllocator;
+
+public:
+	typedef T value_type;
+	typedef T *pointer;
+	typedef const T *const_pointer;
+	typedef size_t size_type;
+
+	template<class U>
+	struct rebind {
+		typedef ArenaAllocator<U> other;
+	};
+
+	explicit ArenaAllocator(Arena &arena) : _arena(&arena) {}
+	template<class U>
+	ArenaAllocator(const ArenaAllocator<U> &other) : _arena(other._arena) {}
+
+	T *allocate(size_t count) { return _arena->allocateArray<T>(count); }
+	void deallocate(T *, size_t) {}
+
+	Arena &getArena() const { return *_arena; }
+
+	template<class U>
+	bool operator==(const ArenaAllocator<U> &other) const { return _arena == other._arena; }
+	template<class U>
+	bool operator!=(const ArenaAllocator<U> &other) const { return _arena != other._arena; }
+
+private:
+	Arena *_arena;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
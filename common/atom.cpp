@@ -0,0 +1,92 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/atom.h"
+
+namespace Common {
+
+// String::hash() returns 0 for the empty string
+const Atom::EmptyEntry Atom::_emptyEntry = { { 0, 0 }, 0 };
+
+AtomTable::AtomTable() : _arena(4096) {
+}
+
+AtomTable::~AtomTable() {
+}
+
+AtomTable::Key AtomTable::makeKey(const char *str, uint32 size) {
+	// The same hash as String::hash()
+	uint hash = (byte)*str << 7;
+	for (uint32 i = 0; i < size; i++)
+		hash = (1000003 * hash) ^ (byte)str[i];
+
+	Key key = { str, size, hash ^ size };
+	return key;
+}
+
+Atom AtomTable::intern(const char *str, uint32 size) {
+	if (!size)
+		return Atom();
+
+	const Key key = makeKey(str, size);
+	EntryMap::const_iterator it = _atoms.find(key);
+	if (it != _atoms.end())
+		return Atom(it->_value);
+
+	Atom::Entry *entry = (Atom::Entry *)_arena.allocate(sizeof(Atom::Entry) + size + 1, alignof(Atom::Entry));
+	char *name = (char *)(entry + 1);
+	memcpy(name, str, size);
+	name[size] = 0;
+
+	entry->hash = key.hash;
+	entry->size = size;
+
+	const Key storedKey = { name, size, key.hash };
+	_atoms[storedKey] = entry;
+
+	return Atom(entry);
+}
+
+bool AtomTable::find(const char *str, uint32 size, Atom &atom) const {
+	if (!size) {
+		atom = Atom();
+		return true;
+	}
+
+	EntryMap::const_iterator it = _atoms.find(makeKey(str, size));
+	if (it == _atoms.end())
+		return false;
+
+	atom = Atom(it->_value);
+	return true;
+}
+
+void AtomTable::clear() {
+	_atoms.clear();
+	_arena.reset();
+}
+
+AtomTable &AtomTable::getGlobal() {
+	static AtomTable table;
+	return table;
+}
+
+} // End of namespace Common
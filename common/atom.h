@@ -0,0 +1,190 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_ATOM_H
+#define COMMON_ATOM_H
+
+#include "common/scummsys.h"
+#include "common/arena.h"
+#include "common/func.h"
+#include "common/hashmap.h"
+#include "common/str.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_atom Atoms
+ * @ingroup common_str
+ *
+ * @brief Interned strings which compare in constant time.
+ * @{
+ */
+
+class AtomTable;
+
+/**
+ * A handle to a string stored once in an AtomTable. Atoms of the same table
+ * are equal if and only if their strings are, so comparing and hashing them
+ * doesn't look at the characters. This suits identifiers like property or
+ * selector names, which can be resolved to atoms once when a script is loaded
+ * instead of being hashed on every access.
+ *
+ * An atom is the size of a pointer and stays valid as long as its table is
+ * neither cleared nor destroyed. Atoms of different tables must not be
+ * compared. The default atom is the empty string, which is equal in all
+ * tables.
+ */
+class Atom {
+public:
+	/** The empty atom. */
+	Atom() : _entry(&_emptyEntry.entry) {}
+
+	/** Intern a string in the global table. */
+	explicit Atom(const char *str);
+	/** @overload */
+	explicit Atom(const String &str);
+
+	const char *c_str() const { return (const char *)(_entry + 1); }
+	uint32 size() const { return _entry->size; }
+	bool empty() const { return _entry->size == 0; }
+	String toString() const { return String(c_str(), _entry->size); }
+
+	/** Return the hash of the string, which is the same as the one of the String. */
+	uint hash() const { return _entry->hash; }
+
+	bool operator==(const Atom &x) const { return _entry == x._entry; }
+	bool operator!=(const Atom &x) const { return _entry != x._entry; }
+
+	/**
+	 * Order atoms, e.g. for sorting them into a binary search table. This is
+	 * not the alphabetical order and changes from one run to the next.
+	 */
+	bool operator<(const Atom &x) const { return _entry < x._entry; }
+
+	/** Compare the string with another one, which doesn't need interning. */
+	bool equals(const char *x) const { return strcmp(c_str(), x) == 0; }
+
+private:
+	friend class AtomTable;
+
+	/** The header of an interned string, which follows it in memory. */
+	struct Entry {
+		uint hash;
+		uint32 size;
+	};
+
+	explicit Atom(const Entry *entry) : _entry(entry) {}
+
+	const Entry *_entry;
+
+	struct EmptyEntry {
+		Entry entry;
+		char terminator;
+	};
+	static const EmptyEntry _emptyEntry;
+};
+
+/**
+ * A table of interned strings. Engines should use a table of their own for
+ * the names of their scripts, so that these go away with the engine, while
+ * the global table used by the Atom constructors lives until the end of the
+ * program.
+ *
+ * Interning is case-sensitive. Users with case-insensitive names should
+ * convert them to lowercase first.
+ *
+ * Tables, including the global one, must not be used from several threads
+ * at once.
+ */
+class AtomTable : NonCopyable {
+public:
+	typedef uint size_type;
+
+	AtomTable();
+	~AtomTable();
+
+	/** Return the atom for a string, adding it to the table if needed. */
+	Atom intern(const char *str, uint32 size);
+	/** @overload */
+	Atom intern(const char *str) { return intern(str, strlen(str)); }
+	/** @overload */
+	Atom intern(const String &str) { return intern(str.c_str(), str.size()); }
+
+	/**
+	 * Look up an atom without adding the string to the table.
+	 *
+	 * @return False if the string hasn't been interned.
+	 */
+	bool find(const char *str, uint32 size, Atom &atom) const;
+	/** @overload */
+	bool find(const char *str, Atom &atom) const { return find(str, strlen(str), atom); }
+	/** @overload */
+	bool find(const String &str, Atom &atom) const { return find(str.c_str(), str.size(), atom); }
+
+	/** Return the number of interned strings, not counting the empty one. */
+	size_type size() const { return _atoms.size(); }
+
+	/** Remove all strings from the table, which invalidates all its atoms. */
+	void clear();
+
+	/** Return the table used by the Atom constructors. */
+	static AtomTable &getGlobal();
+
+private:
+	/** A string which doesn't need to be nul-terminated. */
+	struct Key {
+		const char *str;
+		uint32 size;
+		uint hash;
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &x) const { return x.hash; }
+	};
+
+	struct KeyEqualTo {
+		bool operator()(const Key &x, const Key &y) const { return x.size == y.size && memcmp(x.str, y.str, x.size) == 0; }
+	};
+
+	static Key makeKey(const char *str, uint32 size);
+
+	// The keys point to the strings stored after the entries
+	typedef HashMap<Key, const Atom::Entry *, KeyHash, KeyEqualTo> EntryMap;
+
+	EntryMap _atoms;
+	Arena _arena;
+};
+
+inline Atom::Atom(const char *str) : _entry(AtomTable::getGlobal().intern(str)._entry) {}
+inline Atom::Atom(const String &str) : _entry(AtomTable::getGlobal().intern(str)._entry) {}
+
+template<>
+struct Hash<Atom> {
+	uint operator()(const Atom &atom) const {
+		return atom.hash();
+	}
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -0,0 +1,163 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_ATOMIC_H
+#define COMMON_ATOMIC_H
+
+#include "common/scummsys.h"
+#include "common/noncopyable.h"
+
+#if !defined(__GNUC__)
+#include <atomic>
+#endif
+
+namespace Common {
+
+/**
+ * @defgroup common_atomic Atomic variables
+ * @ingroup common
+ *
+ * @brief API for variables shared between threads without a mutex.
+ *
+ * Only use these for simple flags, counters and lock-free hand-offs. Anything
+ * more involved should be protected by a Common::Mutex instead.
+ * @{
+ */
+
+/**
+ * An integer or pointer variable which can be accessed from several threads
+ * concurrently.
+ *
+ * load() has acquire semantics and store() has release semantics, so data
+ * written before a store() is visible to a thread once its load() returns
+ * the stored value. The read-modify-write operations are sequentially
+ * consistent. The relaxed variants only guarantee atomicity.
+ */
+template<typename T>
+class Atomic : NonCopyable {
+public:
+	explicit Atomic(T value = T()) : _value(value) {}
+
+#if defined(__GNUC__)
+	T load() const { return __atomic_load_n(&_value, __ATOMIC_ACQUIRE); }
+	T loadRelaxed() const { return __atomic_load_n(&_value, __ATOMIC_RELAXED); }
+	void store(T value) { __atomic_store_n(&_value, value, __ATOMIC_RELEASE); }
+	void storeRelaxed(T value) { __atomic_store_n(&_value, value, __ATOMIC_RELAXED); }
+
+	/** Replace the value and return the previous one. */
+	T exchange(T value) { return __atomic_exchange_n(&_value, value, __ATOMIC_SEQ_CST); }
+
+	/** Add to the value and return the previous one. */
+	T fetchAdd(T delta) { return __atomic_fetch_add(&_value, delta, __ATOMIC_SEQ_CST); }
+
+	/** Subtract from the value and return the previous one. */
+	T fetchSub(T delta) { return __atomic_fetch_sub(&_value, delta, __ATOMIC_SEQ_CST); }
+
+	/**
+	 * Replace the value with @p desired if it equals @p expected. Otherwise,
+	 * @p expected is updated with the current value.
+	 *
+	 * @return True if the value was replaced.
+	 */
+	bool compareExchange(T &expected, T desired) {
+		return __atomic_compare_exchange_n(&_value, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+	}
+
+private:
+	T _value;
+#else
+	T load() const { return _value.load(std::memory_order_acquire); }
+	T loadRelaxed() const { return _value.load(std::memory_order_relaxed); }
+	void store(T value) { _value.store(value, std::memory_order_release); }
+	void storeRelaxed(T value) { _value.store(value, std::memory_order_relaxed); }
+
+	T exchange(T value) { return _value.exchange(value); }
+	T fetchAdd(T delta) { return _value.fetch_add(delta); }
+	T fetchSub(T delta) { return _value.fetch_sub(delta); }
+	bool compareExchange(T &expected, T desired) { return _value.compare_exchange_strong(expected, desired); }
+
+private:
+	std::atomic<T> _value;
+#endif
+};
+
+/**
+ * Full memory barrier. Needed to order relaxed accesses, e.g. for readers
+ * checking a sequence counter after copying the data it protects.
+ */
+inline void atomicFence() {
+#if defined(__GNUC__)
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+#else
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+#endif
+}
+
+/**
+ * @name Atomic operations on plain variables
+ *
+ * For variables which can't be an Atomic, e.g. because they are part of a
+ * union or only need to be accessed atomically in some cases. The memory
+ * orders are the same as for Atomic.
+ * @{
+ */
+
+#if defined(__GNUC__)
+template<typename T>
+inline T atomicLoad(const T *ptr) { return __atomic_load_n(ptr, __ATOMIC_ACQUIRE); }
+
+template<typename T>
+inline T atomicFetchAdd(T *ptr, T delta) { return __atomic_fetch_add(ptr, delta, __ATOMIC_SEQ_CST); }
+
+template<typename T>
+inline T atomicFetchSub(T *ptr, T delta) { return __atomic_fetch_sub(ptr, delta, __ATOMIC_SEQ_CST); }
+
+template<typename T>
+inline bool atomicCompareExchange(T *ptr, T &expected, T desired) {
+	return __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+#else
+// std::atomic has the same layout as the type it wraps on all supported compilers
+template<typename T>
+inline T atomicLoad(const T *ptr) {
+	STATIC_ASSERT(sizeof(std::atomic<T>) == sizeof(T), atomic_must_have_the_size_of_the_type);
+	return reinterpret_cast<const std::atomic<T> *>(ptr)->load(std::memory_order_acquire);
+}
+
+template<typename T>
+inline T atomicFetchAdd(T *ptr, T delta) { return reinterpret_cast<std::atomic<T> *>(ptr)->fetch_add(delta); }
+
+template<typename T>
+inline T atomicFetchSub(T *ptr, T delta) { return reinterpret_cast<std::atomic<T> *>(ptr)->fetch_sub(delta); }
+
+template<typename T>
+inline bool atomicCompareExchange(T *ptr, T &expected, T desired) {
+	return reinterpret_cast<std::atomic<T> *>(ptr)->compare_exchange_strong(expected, desired);
+}
+#endif
+
+/** @} */
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
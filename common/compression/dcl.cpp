@@ -20,76 +20,99 @@
  */
 
 #include "common/compression/dcl.h"
-#include "common/debug.h"
+#include "common/endian.h"
 #include "common/memstream.h"
 #include "common/stream.h"
 #include "common/textconsole.h"
+#include "common/util.h"
 
 namespace Common {
 
 class DecompressorDCL {
 public:
-	bool unpack(SeekableReadStream *sourceStream, WriteStream *targetStream, uint32 targetSize, bool targetFixedSize);
+	/**
+	 * Decompress a buffer. With a fixed target size, exactly targetSize
+	 * bytes are written to target. Otherwise target is (re)allocated with
+	 * malloc() as needed, and targetSize set to the size of the output.
+	 */
+	bool unpack(const byte *source, uint32 sourceSize, byte *&target, uint32 &targetSize, bool targetFixedSize);
 
 protected:
 	/**
 	 * Initialize decompressor.
-	 * @param sourceStream	source stream to read from
-	 * @param targetStream	target memory stream to write to
+	 * @param source	source buffer to read from
+	 * @param target	target buffer to write to
 	 */
-	void init(SeekableReadStream *sourceStream, WriteStream *targetStream, uint32 targetSize, bool targetFixedSize);
+	void init(const byte *source, uint32 sourceSize, byte *target, uint32 targetSize, bool targetFixedSize);
 
 	/**
-	 * Get a number of bits from _src stream, starting with the least
-	 * significant unread bit of the current four byte block.
+	 * Get a number of bits from the source, starting with the least
+	 * significant unread bit of the bits buffer.
 	 * @param n		number of bits to get
 	 * @return n-bits number
 	 */
 	uint32 getBitsLSB(int n);
 
 	/**
-	 * Get one byte from _src stream.
+	 * Get one byte from the source.
 	 * @return byte
 	 */
 	byte getByteLSB();
 
+	/**
+	 * Fill the bits buffer with at least 56 bits. Past the end of the
+	 * source, zero bits are read.
+	 */
 	void fetchBitsLSB();
 
 	/**
-	 * Write one byte into _dest stream
-	 * @param b byte to put
+	 * Make room for a number of bytes in a target of dynamic size.
 	 */
-	void putByte(byte b);
+	bool reserve(uint32 size);
 
-	int huffman_lookup(const int *tree);
+	/**
+	 * Decode a Huffman code through one of the lookup tables.
+	 * @param table		lookup table, see DCLLookupTables
+	 * @param tableBits	number of bits indexing the table
+	 */
+	int huffman_lookup(const uint16 *table, int tableBits);
 
-	uint32 _dwBits;			///< bits buffer
+	uint64 _dwBits;			///< bits buffer
 	byte _nBits;			///< number of unread bits in _dwBits
-	uint32 _sourceSize;		///< size of the source stream
-	uint32 _targetSize;		///< size of the target stream (if fixed)
-	bool _targetFixedSize;  ///< if target stream is fixed size or dynamic size
-	uint32 _bytesRead;		///< number of bytes read from _sourceStream
-	uint32 _bytesWritten;	///< number of bytes written to _targetStream
-	SeekableReadStream *_sourceStream;
-	WriteStream *_targetStream;
+	const byte *_source;	///< next byte to read into _dwBits
+	const byte *_sourceEnd;	///< end of the source buffer
+	byte *_target;			///< target buffer
+	uint32 _targetSize;		///< size of the target buffer
+	bool _targetFixedSize;  ///< if target buffer is fixed size or dynamic size
+	uint32 _bytesWritten;	///< number of bytes written to _target
 };
 
-void DecompressorDCL::init(SeekableReadStream *sourceStream, WriteStream *targetStream, uint32 targetSize, bool targetFixedSize) {
-	_sourceStream = sourceStream;
-	_targetStream = targetStream;
-	_sourceSize = sourceStream->size();
+void DecompressorDCL::init(const byte *source, uint32 sourceSize, byte *target, uint32 targetSize, bool targetFixedSize) {
+	_source = source;
+	_sourceEnd = source + sourceSize;
+	_target = target;
 	_targetSize = targetSize;
 	_targetFixedSize = targetFixedSize;
 	_nBits = 0;
-	_bytesRead = _bytesWritten = 0;
+	_bytesWritten = 0;
 	_dwBits = 0;
 }
 
 void DecompressorDCL::fetchBitsLSB() {
-	while (_nBits <= 24) {
-		_dwBits |= ((uint32)_sourceStream->readByte()) << _nBits;
+	if (_sourceEnd - _source >= 8) {
+		// Load as many whole bytes as fit. Any bits above _nBits are
+		// those of the following bytes, which OR in again unchanged
+		// on the next fetch.
+		_dwBits |= READ_LE_UINT64(_source) << _nBits;
+		_source += (63 - _nBits) >> 3;
+		_nBits |= 56;
+		return;
+	}
+
+	while (_nBits <= 56) {
+		if (_source < _sourceEnd)
+			_dwBits |= ((uint64)*_source++) << _nBits;
 		_nBits += 8;
-		_bytesRead++;
 	}
 }
 
@@ -97,7 +120,7 @@ uint32 DecompressorDCL::getBitsLSB(int n) {
 	// Fetching more data to buffer if needed
 	if (_nBits < n)
 		fetchBitsLSB();
-	uint32 ret = (_dwBits & ~(~0UL << n));
+	uint32 ret = (uint32)(_dwBits & ((1ULL << n) - 1));
 	_dwBits >>= n;
 	_nBits -= n;
 	return ret;
@@ -107,9 +130,17 @@ byte DecompressorDCL::getByteLSB() {
 	return getBitsLSB(8);
 }
 
-void DecompressorDCL::putByte(byte b) {
-	_targetStream->writeByte(b);
-	_bytesWritten++;
+bool DecompressorDCL::reserve(uint32 size) {
+	if (_bytesWritten + size <= _targetSize)
+		return true;
+
+	uint32 newSize = MAX<uint32>(_targetSize * 2, _bytesWritten + size);
+	byte *newTarget = (byte *)realloc(_target, newSize);
+	if (!newTarget)
+		return false;
+	_target = newTarget;
+	_targetSize = newSize;
+	return true;
 }
 
 #define HUFFMAN_LEAF 0x40000000
@@ -315,34 +346,67 @@ static const int ascii_tree[] = {
 	LN(509, 128)      LN(510, 26)
 };
 
-int DecompressorDCL::huffman_lookup(const int *tree) {
-	int pos = 0;
+/**
+ * Lookup tables for the Huffman trees above, indexed by the next bits of
+ * input, least significant bit first. Each entry holds the decoded value in
+ * its low byte and the length of the code in its high byte.
+ */
+struct DCLLookupTables {
+	enum {
+		kLengthBits = 7,
+		kDistanceBits = 8,
+		kAsciiBits = 13
+	};
+
+	uint16 length[1 << kLengthBits];
+	uint16 distance[1 << kDistanceBits];
+	uint16 ascii[1 << kAsciiBits];
+
+	DCLLookupTables() {
+		fill(length, kLengthBits, length_tree, 0, 0, 0);
+		fill(distance, kDistanceBits, distance_tree, 0, 0, 0);
+		fill(ascii, kAsciiBits, ascii_tree, 0, 0, 0);
+	}
+
+	static void fill(uint16 *table, int tableBits, const int *tree, int pos, uint32 code, int codeBits) {
+		if (tree[pos] & HUFFMAN_LEAF) {
+			// Every index starting with this code decodes to the leaf
+			for (uint32 i = code; i < (1u << tableBits); i += 1 << codeBits)
+				table[i] = (tree[pos] & 0xFF) | (codeBits << 8);
+			return;
+		}
 
-	while (!(tree[pos] & HUFFMAN_LEAF)) {
-		int bit = getBitsLSB(1);
-		debug(8, "[%d]:%d->", pos, bit);
-		pos = bit ? tree[pos] & 0xFFF : tree[pos] >> 12;
+		fill(table, tableBits, tree, tree[pos] >> 12, code, codeBits + 1);
+		fill(table, tableBits, tree, tree[pos] & 0xFFF, code | (1 << codeBits), codeBits + 1);
 	}
+};
 
-	debug(8, "=%02x\n", tree[pos] & 0xffff);
-	return tree[pos] & 0xFFFF;
+static const DCLLookupTables &getLookupTables() {
+	static const DCLLookupTables tables;
+	return tables;
+}
+
+int DecompressorDCL::huffman_lookup(const uint16 *table, int tableBits) {
+	if (_nBits < tableBits)
+		fetchBitsLSB();
+
+	const uint16 entry = table[_dwBits & ((1 << tableBits) - 1)];
+	_dwBits >>= entry >> 8;
+	_nBits -= entry >> 8;
+	return entry & 0xFF;
 }
 
 #define DCL_BINARY_MODE 0
 #define DCL_ASCII_MODE 1
 
-#define MIDI_SETUP_BUNDLE_FILE_MAXIMUM_DICTIONARY_SIZE 4096
-
-bool DecompressorDCL::unpack(SeekableReadStream *sourceStream, WriteStream *targetStream, uint32 targetSize, bool targetFixedSize) {
-	byte   dictionary[MIDI_SETUP_BUNDLE_FILE_MAXIMUM_DICTIONARY_SIZE];
-	uint16 dictionaryPos = 0;
-	uint16 dictionarySize = 0;
-	uint16 dictionaryMask = 0;
+bool DecompressorDCL::unpack(const byte *source, uint32 sourceSize, byte *&target, uint32 &targetSize, bool targetFixedSize) {
 	int value;
 	uint16 tokenOffset = 0;
 	uint16 tokenLength = 0;
 
-	init(sourceStream, targetStream, targetSize, targetFixedSize);
+	const DCLLookupTables &tables = getLookupTables();
+
+	init(source, sourceSize, target, targetSize, targetFixedSize);
 
 	byte mode = getByteLSB();
 	byte dictionaryType = getByteLSB();
@@ -355,25 +419,22 @@ bool DecompressorDCL::unpack(SeekableReadStream *sourceStream, WriteStream *targ
 	// TODO: original code supported 3 as well???
 	// Was this an accident or on purpose? And the original code did just give out a warning
 	// and didn't error out at all
+	// The output itself serves as the dictionary of 1024, 2048 or 4096
+	// bytes, as the distances can't reach back any further
 	switch (dictionaryType) {
 	case 4:
-		dictionarySize = 1024;
-		break;
 	case 5:
-		dictionarySize = 2048;
-		break;
 	case 6:
-		dictionarySize = 4096;
 		break;
 	default:
 		warning("DCL-INFLATE: Error: unsupported dictionary type %02x", dictionaryType);
 		return false;
 	}
-	dictionaryMask = dictionarySize - 1;
 
-	while ((!targetFixedSize) || (_bytesWritten < _targetSize)) {
+	bool success = true;
+	while ((!_targetFixedSize) || (_bytesWritten < _targetSize)) {
 		if (getBitsLSB(1)) { // (length,distance) pair
-			value = huffman_lookup(length_tree);
+			value = huffman_lookup(tables.length, DCLLookupTables::kLengthBits);
 
 			if (value < 8)
 				tokenLength = value + 2;
@@ -383,9 +444,7 @@ bool DecompressorDCL::unpack(SeekableReadStream *sourceStream, WriteStream *targ
 			if (tokenLength == 519)
 				break; // End of stream signal
 
-			debug(8, " | ");
-
-			value = huffman_lookup(distance_tree);
+			value = huffman_lookup(tables.distance, DCLLookupTables::kDistanceBits);
 
 			if (tokenLength == 2)
 				tokenOffset = (value << 2) | getBitsLSB(2);
@@ -393,65 +452,58 @@ bool DecompressorDCL::unpack(SeekableReadStream *sourceStream, WriteStream *targ
 				tokenOffset = (value << dictionaryType) | getBitsLSB(dictionaryType);
 			tokenOffset++;
 
-			debug(8, "\nCOPY(%d from %d)\n", tokenLength, tokenOffset);
-
 			if (_targetFixedSize) {
 				if (tokenLength + _bytesWritten > _targetSize) {
 					warning("DCL-INFLATE Error: Write out of bounds while copying %d bytes (declared unpacked size is %d bytes, current is %d + %d bytes)",
 							tokenLength, _targetSize, _bytesWritten, tokenLength);
-					return false;
+					success = false;
+					break;
 				}
+			} else if (!reserve(tokenLength)) {
+				success = false;
+				break;
 			}
 
 			if (_bytesWritten < tokenOffset) {
 				warning("DCL-INFLATE Error: Attempt to copy from before beginning of input stream (declared unpacked size is %d bytes, current is %d bytes)",
 						_targetSize, _bytesWritten);
-				return false;
+				success = false;
+				break;
 			}
 
-			uint16 dictionaryBaseIndex = (dictionaryPos - tokenOffset) & dictionaryMask;
-			uint16 dictionaryIndex = dictionaryBaseIndex;
-			uint16 dictionaryNextIndex = dictionaryPos;
-
-			while (tokenLength) {
-				// Write byte from dictionary
-				putByte(dictionary[dictionaryIndex]);
-				debug(9, "\33[32;31m%02x\33[37;37m ", dictionary[dictionaryIndex]);
-
-				dictionary[dictionaryNextIndex] = dictionary[dictionaryIndex];
+			byte *dest = _target + _bytesWritten;
+			const byte *src = dest - tokenOffset;
+			_bytesWritten += tokenLength;
 
-				dictionaryNextIndex = (dictionaryNextIndex + 1) & dictionaryMask;
-				dictionaryIndex = (dictionaryIndex + 1) & dictionaryMask;
-
-				if (dictionaryIndex == dictionaryPos)
-					dictionaryIndex = dictionaryBaseIndex;
-				if (dictionaryNextIndex == dictionarySize)
-					dictionaryNextIndex = 0;
-
-				tokenLength--;
+			// Overlapping copies repeat the last tokenOffset bytes
+			if (tokenOffset >= tokenLength) {
+				memcpy(dest, src, tokenLength);
+			} else {
+				while (tokenLength--)
+					*dest++ = *src++;
 			}
-			dictionaryPos = dictionaryNextIndex;
-			debug(9, "\n");
-
 		} else { // Copy byte verbatim
-			value = (mode == DCL_ASCII_MODE) ? huffman_lookup(ascii_tree) : getByteLSB();
-			putByte(value);
-
-			// Also remember it inside dictionary
-			dictionary[dictionaryPos] = value;
-			dictionaryPos++;
-			if (dictionaryPos >= dictionarySize)
-				dictionaryPos = 0;
+			if (!_targetFixedSize && !reserve(1)) {
+				success = false;
+				break;
+			}
 
-			debug(9, "\33[32;31m%02x \33[37;37m", value);
+			value = (mode == DCL_ASCII_MODE) ? huffman_lookup(tables.ascii, DCLLookupTables::kAsciiBits) : getByteLSB();
+			_target[_bytesWritten++] = value;
 		}
 	}
 
+	target = _target;
+	if (!success)
+		return false;
+
 	if (_targetFixedSize) {
 		if (_bytesWritten != _targetSize)
 			warning("DCL-INFLATE Error: Inconsistent bytes written (%d) and target buffer size (%d)", _bytesWritten, _targetSize);
 		return _bytesWritten == _targetSize;
 	}
+
+	targetSize = _bytesWritten;
 	return true; // For targets featuring dynamic size we always succeed
 }
 
@@ -469,29 +521,30 @@ bool decompressDCL(ReadStream *src, byte *dest, uint32 packedSize, uint32 unpack
 	// Read source into memory
 	src->read(sourceBufferPtr, packedSize);
 
-	Common::MemoryReadStream  *sourceStream = new MemoryReadStream(sourceBufferPtr, packedSize, DisposeAfterUse::YES);
-	Common::MemoryWriteStream *targetStream = new MemoryWriteStream(dest, unpackedSize);
-
-	success = dcl.unpack(sourceStream, targetStream, unpackedSize, true);
-	delete sourceStream;
-	delete targetStream;
+	success = dcl.unpack(sourceBufferPtr, packedSize, dest, unpackedSize, true);
+	free(sourceBufferPtr);
 	return success;
 }
 
 SeekableReadStream *decompressDCL(SeekableReadStream *sourceStream, uint32 packedSize, uint32 unpackedSize) {
-	bool success = false;
 	byte *targetPtr = nullptr;
-	Common::MemoryWriteStream *targetStream;
 	DecompressorDCL dcl;
 
 	targetPtr = (byte *)malloc(unpackedSize);
 	if (!targetPtr)
 		return nullptr;
 
-	targetStream = new MemoryWriteStream(targetPtr, unpackedSize);
+	byte *sourceBufferPtr = (byte *)malloc(packedSize);
+	if (!sourceBufferPtr) {
+		free(targetPtr);
+		return nullptr;
+	}
 
-	success = dcl.unpack(sourceStream, targetStream, unpackedSize, true);
-	delete targetStream;
+	// Read source into memory
+	packedSize = sourceStream->read(sourceBufferPtr, packedSize);
+
+	bool success = dcl.unpack(sourceBufferPtr, packedSize, targetPtr, unpackedSize, true);
+	free(sourceBufferPtr);
 
 	if (!success) {
 		free(targetPtr);
@@ -503,19 +556,26 @@ SeekableReadStream *decompressDCL(SeekableReadStream *sourceStream, uint32 packe
 // This one figures out the unpacked size by itself
 // Needed for at least Simon 2, because the unpacked size is not stored anywhere
 SeekableReadStream *decompressDCL(SeekableReadStream *sourceStream) {
-	Common::MemoryWriteStreamDynamic *targetStream;
 	DecompressorDCL dcl;
 
-	targetStream = new MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+	uint32 packedSize = sourceStream->size() - sourceStream->pos();
+	byte *sourceBufferPtr = (byte *)malloc(packedSize);
+	if (!sourceBufferPtr)
+		return nullptr;
+
+	// Read source into memory
+	packedSize = sourceStream->read(sourceBufferPtr, packedSize);
 
-	if (dcl.unpack(sourceStream, targetStream, 0, false)) {
-		byte *targetPtr = targetStream->getData();
-		uint32 unpackedSize = targetStream->size();
-		delete targetStream;
-		return new MemoryReadStream(targetPtr, unpackedSize, DisposeAfterUse::YES);
+	byte *targetPtr = nullptr;
+	uint32 unpackedSize = 0;
+	bool success = dcl.unpack(sourceBufferPtr, packedSize, targetPtr, unpackedSize, false);
+	free(sourceBufferPtr);
+
+	if (!success) {
+		free(targetPtr);
+		return nullptr;
 	}
-	delete targetStream;
-	return nullptr;
+	return new MemoryReadStream(targetPtr, unpackedSize, DisposeAfterUse::YES);
 }
 
 } // End of namespace Common
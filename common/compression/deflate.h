@@ -151,6 +151,26 @@ SeekableReadStream *wrapDeflateReadStream(SeekableReadStream *toBeWrapped,
 		DisposeAfterUse::Flag disposeParent = DisposeAfterUse::YES, uint64 knownSize = 0,
 		const byte *dict = nullptr, uint dictLen = 0);
 
+/**
+ * Take an arbitrary SeekableReadStream and wrap it in a custom stream which
+ * provides transparent on-the-fly decompression of raw deflate data, as
+ * found in ZIP archives. Unlike wrapDeflateReadStream(), the returned stream
+ * remembers a checkpoint every checkpointInterval bytes of output, so seeking
+ * backwards does not have to restart decompression from the beginning.
+ * Its inflate state is taken from a small pool shared by all such streams.
+ *
+ * Without ZLIB support, this is the same as wrapDeflateReadStream().
+ *
+ * It is safe to call this with a NULL parameter (in this case, NULL is
+ * returned).
+ *
+ * @param toBeWrapped	the stream to be wrapped
+ * @param knownSize	the length of the uncompressed data
+ * @param checkpointInterval	the minimal distance in bytes between two checkpoints, 0 to disable them
+ */
+SeekableReadStream *wrapSeekableDeflateReadStream(SeekableReadStream *toBeWrapped,
+		DisposeAfterUse::Flag disposeParent, uint64 knownSize, uint32 checkpointInterval = 1024 * 1024);
+
 /**
  * Take an arbitrary SeekableReadStream and wrap it in a custom stream which
  * provides transparent on-the-fly decompression. Assumes the data it
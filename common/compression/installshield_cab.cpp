@@ -43,10 +43,12 @@
 // SOFTWARE.
 
 #include "common/archive.h"
+#include "common/config-manager.h"
 #include "common/debug.h"
 #include "common/hash-str.h"
 #include "common/compression/installshield_cab.h"
 #include "common/memstream.h"
+#include "common/mutex.h"
 #include "common/substream.h"
 #include "common/ptr.h"
 #include "common/compression/deflate.h"
@@ -83,6 +85,124 @@ bool inflateZlibInstallShield(byte *dst, uint dstLen, const byte *src, uint srcL
 	return true;
 }
 
+/**
+ * Stream decompressing data which is made of deflate chunks, each prefixed
+ * by its 2-byte size, one chunk at a time. The start of every chunk is
+ * remembered once it is found, so seeking only has to decompress the chunk
+ * holding the new position.
+ */
+class InstallShieldChunkedStream : public SeekableReadStream {
+public:
+	InstallShieldChunkedStream(SeekableReadStream *compressed, uint32 size) :
+		_compressed(compressed), _size(size), _chunkStart(0), _pos(0), _eos(false), _err(false) {
+		_chunkIn.push_back(0);
+		_chunkOut.push_back(0);
+	}
+
+	bool err() const override { return _err; }
+	void clearErr() override { _eos = false; }
+	bool eos() const override { return _eos; }
+	int64 pos() const override { return _pos; }
+	int64 size() const override { return _size; }
+
+	bool seek(int64 offset, int whence = SEEK_SET) override {
+		if (whence == SEEK_CUR)
+			offset += _pos;
+		else if (whence == SEEK_END)
+			offset += _size;
+
+		if (offset < 0 || offset > _size)
+			return false;
+
+		_pos = offset;
+		_eos = false;
+		return true;
+	}
+
+	uint32 read(void *dataPtr, uint32 dataSize) override {
+		byte *dst = (byte *)dataPtr;
+		uint32 total = 0;
+
+		while (total < dataSize && _pos < _size) {
+			if (_pos < _chunkStart || _pos >= _chunkStart + _chunk.size()) {
+				if (!findChunk())
+					break;
+			}
+
+			const uint32 count = MIN<uint32>(dataSize - total, _chunkStart + _chunk.size() - _pos);
+			memcpy(dst + total, &_chunk[_pos - _chunkStart], count);
+			_pos += count;
+			total += count;
+		}
+
+		if (total < dataSize)
+			_eos = true;
+
+		return total;
+	}
+
+private:
+	// Every chunk is decompressed into a buffer of this size
+	static const uint32 kMaxChunkSize = 64 * 1024;
+
+	bool findChunk() {
+		// Start from the last chunk known to begin before the position
+		uint index = _chunkOut.size() - 1;
+		while (_chunkOut[index] > _pos)
+			--index;
+
+		for (;;) {
+			if (!loadChunk(index))
+				return false;
+			if (_pos < _chunkStart + _chunk.size())
+				return true;
+			++index;
+		}
+	}
+
+	bool loadChunk(uint index) {
+		_compressed->seek(_chunkIn[index]);
+		const uint16 chunkSize = _compressed->readUint16LE();
+		_input.resize(chunkSize);
+		if (_compressed->err() || _compressed->eos() || _compressed->read(_input.data(), chunkSize) != chunkSize) {
+			_err = true;
+			return false;
+		}
+
+		uint outSize = MIN(kMaxChunkSize, _size - _chunkOut[index]);
+		_chunk.resize(outSize);
+		if (!inflateZlibHeaderless(_chunk.data(), &outSize, _input.data(), chunkSize) || outSize == 0) {
+			_chunk.clear();
+			_err = true;
+			return false;
+		}
+		_chunk.resize(outSize);
+		_chunkStart = _chunkOut[index];
+
+		if (index + 1 == _chunkIn.size()) {
+			_chunkIn.push_back(_chunkIn[index] + 2 + chunkSize);
+			_chunkOut.push_back(_chunkStart + outSize);
+		}
+
+		return true;
+	}
+
+	ScopedPtr<SeekableReadStream> _compressed;
+	uint32 _size;
+
+	// Compressed and uncompressed offsets of the chunks found so far
+	Array<uint32> _chunkIn;
+	Array<uint32> _chunkOut;
+
+	Array<byte> _input;
+	Array<byte> _chunk;
+	uint32 _chunkStart;
+
+	uint32 _pos;
+	bool _eos;
+	bool _err;
+};
+
 class InstallShieldCabinet : public Archive {
 public:
 	InstallShieldCabinet();
@@ -122,17 +242,55 @@ private:
 		uint32 lastFileSizeCompressed;
 	};
 
+	/**
+	 * An open volume, shared by the cabinet and all member streams reading
+	 * from it. It is mapped into memory when possible.
+	 */
+	struct Volume {
+		ScopedPtr<SeekableReadStream> stream;
+		MappedReadStream *mapped;
+		Mutex mutex;
+
+		Volume() : mapped(nullptr) {}
+	};
+
+	class VolumeSubReadStream : public SafeMutexedSeekableSubReadStream {
+	public:
+		VolumeSubReadStream(const SharedPtr<Volume> &volume, uint32 begin, uint32 end) :
+			SafeMutexedSeekableSubReadStream(volume->stream.get(), begin, end, DisposeAfterUse::NO, volume->mutex),
+			_volume(volume) {}
+
+	private:
+		SharedPtr<Volume> _volume;
+	};
+
+	// Compressed members at least this big are decompressed while they are read
+	static const uint32 kStreamingThreshold = 256 * 1024;
+
 	int _version;
 	typedef HashMap<Path, FileEntry, Path::IgnoreCase_Hash, Path::IgnoreCase_EqualTo> FileMap;
 	FileMap _map;
 	Path _baseName;
 	Common::Array<VolumeHeader> _volumeHeaders;
+	Common::Array<SharedPtr<Volume> > _volumes;
 	Common::Archive *_archive;
+	FSNode _cacheDir;
+	String _cachePrefix;
 
 	static bool readVolumeHeader(SeekableReadStream *volumeStream, VolumeHeader &inVolumeHeader);
 
 	Path getHeaderName() const;
 	Path getVolumeName(uint volume) const;
+
+	SharedPtr<Volume> openVolume(uint volume) const;
+	SeekableReadStream *createVolumeStream(uint volume, uint32 offset, uint32 size) const;
+	bool readVolume(uint volume, uint32 offset, byte *dst, uint32 size) const;
+
+	byte *readCompressed(const Path &path, const FileEntry &entry) const;
+	SeekableReadStream *createStreamingReadStream(const FileEntry &entry) const;
+
+	FSNode getCacheNode(const Path &path, const FileEntry &entry) const;
+	void writeCache(const Path &path, const FileEntry &entry, const byte *data) const;
 };
 
 InstallShieldCabinet::InstallShieldCabinet() : _version(0), _archive(nullptr) {
@@ -159,23 +317,16 @@ bool InstallShieldCabinet::open(const Path *baseName, Common::Archive *archive,
 	uint fileIndex = 0;
 	ScopedPtr<SeekableReadStream> file;
 
-	// First, open all the .cab files and read their headers
-	uint volume = 1;
+	// First, open all the .cab files and read their headers. They are kept
+	// open, so that reading members does not have to find them again.
 	for (;;) {
-		if (_archive) {
-			file.reset(_archive->createReadStreamForMember(getVolumeName(volume++)));
-			if (!file.get()) {
-				break;
-			}
-		} else {
-			file.reset(new Common::File());
-			if (!((Common::File *)file.get())->open(Common::FSNode(getVolumeName(volume++)))) {
-				break;
-			}
-		}
+		SharedPtr<Volume> volume = openVolume(_volumes.size() + 1);
+		if (!volume)
+			break;
 
+		_volumes.push_back(volume);
 		_volumeHeaders.push_back(VolumeHeader());
-		readVolumeHeader(file.get(), _volumeHeaders.back());
+		readVolumeHeader(volume->stream.get(), _volumeHeaders.back());
 	}
 
 	// Try to open a header (.hdr) file to get the file list
@@ -322,6 +473,17 @@ bool InstallShieldCabinet::open(const Path *baseName, Common::Archive *archive,
 		}
 	}
 
+	// Decompressed members can be kept on disk, when a directory is set
+	// up for them and a game is running
+	const String &domain = ConfMan.getActiveDomainName();
+	if (ConfMan.hasKey("installercachepath") && !domain.empty()) {
+		FSNode cacheDir(ConfMan.getPath("installercachepath"));
+		if (cacheDir.isDirectory() && cacheDir.isWritable()) {
+			_cacheDir = cacheDir;
+			_cachePrefix = domain + "-" + _baseName.baseName();
+		}
+	}
+
 	return true;
 }
 
@@ -329,6 +491,9 @@ void InstallShieldCabinet::close() {
 	_baseName.clear();
 	_map.clear();
 	_volumeHeaders.clear();
+	_volumes.clear();
+	_cacheDir = FSNode();
+	_cachePrefix.clear();
 	_version = 0;
 }
 
@@ -358,86 +523,185 @@ SeekableReadStream *InstallShieldCabinet::createReadStreamForMember(const Path &
 		return nullptr;
 	}
 
-	ScopedPtr<SeekableReadStream> stream;
-	if (_archive) {
-		stream.reset(_archive->createReadStreamForMember(getVolumeName((entry.volume))));
-	} else {
-		stream.reset(new Common::File());
-		if (!((Common::File *)stream.get())->open(Common::FSNode(getVolumeName((entry.volume))))) {
-			stream.reset(nullptr);
+	// Uncompressed file, not split: return a substream
+	if (!(entry.flags & (kCompressed | kSplit))) {
+		SeekableReadStream *stream = createVolumeStream(entry.volume, entry.offset, entry.uncompressedSize);
+		if (!stream)
+			warning("Failed to open volume for file '%s'", path.toString().c_str());
+		return stream;
+	}
+
+	// Entries with size 0 are valid, and do not need to be inflated
+	if (entry.uncompressedSize == 0)
+		return new MemoryReadStream(nullptr, 0);
+
+	if (!_cachePrefix.empty()) {
+		FSNode cacheNode = getCacheNode(path, entry);
+		if (cacheNode.exists()) {
+			SeekableReadStream *stream = cacheNode.createMappedReadStream();
+			if (!stream)
+				stream = cacheNode.createReadStream();
+			if (stream && stream->size() == entry.uncompressedSize)
+				return stream;
+			delete stream;
 		}
+	} else if (!(entry.flags & kSplit) && entry.uncompressedSize >= kStreamingThreshold) {
+		// Large files are decompressed while reading them
+		return createStreamingReadStream(entry);
 	}
 
-	if (!stream) {
-		warning("Failed to open volume for file '%s'", path.toString().c_str());
+	byte *src = readCompressed(path, entry);
+	if (!src)
 		return nullptr;
+
+	// Uncompressed split file, return the assembled data
+	if (!(entry.flags & kCompressed)) {
+		writeCache(path, entry, src);
+		return new MemoryReadStream(src, entry.uncompressedSize, DisposeAfterUse::YES);
 	}
 
-	byte *src = nullptr;
-	if (entry.flags & kSplit) {
-		// File is split across volumes
-		src = (byte *)malloc(entry.compressedSize);
-		uint bytesRead = 0;
-		uint volume = entry.volume;
-
-		// Read the first part of the split file
-		stream->seek(entry.offset);
-		stream->read(src, _volumeHeaders[volume - 1].lastFileSizeCompressed);
-		bytesRead += _volumeHeaders[volume - 1].lastFileSizeCompressed;
-
-		// Then, iterate through the next volumes until we've read all the data for the file
-		while (bytesRead < entry.compressedSize) {
-			if (_archive) {
-				stream.reset(_archive->createReadStreamForMember(getVolumeName((++volume))));
-			} else {
-				if (!((Common::File *)stream.get())->open(Common::FSNode(getVolumeName((++volume))))) {
-					stream.reset(nullptr);
-				}
-			}
-			
-			if (!stream.get()) {
-				warning("Failed to read split file %s", path.toString().c_str());
-				free(src);
-				return nullptr;
-			}
-			stream->seek(_volumeHeaders[volume - 1].firstFileOffset);
-			stream->read(src + bytesRead, _volumeHeaders[volume - 1].firstFileSizeCompressed);
-			bytesRead += _volumeHeaders[volume - 1].firstFileSizeCompressed;
-		}
+	byte *dst = (byte *)malloc(entry.uncompressedSize);
+	if (!dst || (entry.compressedSize != 0 && !inflateZlibInstallShield(dst, entry.uncompressedSize, src, entry.compressedSize))) {
+		warning("failed to inflate CAB file '%s'", path.toString().c_str());
+		free(dst);
+		free(src);
+		return nullptr;
 	}
 
-	// Uncompressed file
-	if (!(entry.flags & kCompressed)) {
-		if (src == nullptr) {
-			// File not split, return a substream
-			return new SeekableSubReadStream(stream.release(), entry.offset, entry.offset + entry.uncompressedSize, DisposeAfterUse::YES);
+	free(src);
+
+	writeCache(path, entry, dst);
+	return new MemoryReadStream(dst, entry.uncompressedSize, DisposeAfterUse::YES);
+}
+
+SharedPtr<InstallShieldCabinet::Volume> InstallShieldCabinet::openVolume(uint volume) const {
+	SharedPtr<Volume> result(new Volume());
+
+	if (_archive) {
+		result->stream.reset(_archive->createReadStreamForMember(getVolumeName(volume)));
+	} else {
+		// Without copying, when the volume can be mapped into memory
+		FSNode node(getVolumeName(volume));
+		result->mapped = node.createMappedReadStream();
+		if (result->mapped) {
+			result->stream.reset(result->mapped);
 		} else {
-			// File split, return the assembled data
-			return new MemoryReadStream(src, entry.uncompressedSize, DisposeAfterUse::YES);
-		}		
+			File *file = new File();
+			result->stream.reset(file);
+			if (!file->open(node))
+				result->stream.reset();
+		}
 	}
 
-	byte *dst = (byte *)malloc(entry.uncompressedSize);
+	if (!result->stream)
+		return SharedPtr<Volume>();
 
-	if (!src) {
-		src = (byte *)malloc(entry.compressedSize);
-		stream->seek(entry.offset);
-		stream->read(src, entry.compressedSize);
-	}
+	return result;
+}
 
-	// Entries with size 0 are valid, and do not need to be inflated
-	if (entry.compressedSize != 0) {
-		if (!inflateZlibInstallShield(dst, entry.uncompressedSize, src, entry.compressedSize)) {
-			warning("failed to inflate CAB file '%s'", path.toString().c_str());
-			free(dst);
+SeekableReadStream *InstallShieldCabinet::createVolumeStream(uint volume, uint32 offset, uint32 size) const {
+	if (volume == 0 || volume > _volumes.size())
+		return nullptr;
+
+	const SharedPtr<Volume> &vol = _volumes[volume - 1];
+	if (offset > vol->stream->size() || size > vol->stream->size() - offset)
+		return nullptr;
+
+	if (vol->mapped)
+		return vol->mapped->createSubView(offset, size);
+
+	return new VolumeSubReadStream(vol, offset, offset + size);
+}
+
+bool InstallShieldCabinet::readVolume(uint volume, uint32 offset, byte *dst, uint32 size) const {
+	if (volume == 0 || volume > _volumes.size())
+		return false;
+
+	Volume &vol = *_volumes[volume - 1];
+	StackLock lock(vol.mutex);
+	return vol.stream->seek(offset) && vol.stream->read(dst, size) == size;
+}
+
+byte *InstallShieldCabinet::readCompressed(const Path &path, const FileEntry &entry) const {
+	byte *src = (byte *)malloc(entry.compressedSize ? entry.compressedSize : 1);
+	if (!src)
+		return nullptr;
+
+	if (!(entry.flags & kSplit)) {
+		if (!readVolume(entry.volume, entry.offset, src, entry.compressedSize)) {
+			warning("Failed to read CAB file '%s'", path.toString().c_str());
 			free(src);
 			return nullptr;
 		}
+		return src;
 	}
 
-	free(src);
+	// File is split across volumes
+	uint volume = entry.volume;
 
-	return new MemoryReadStream(dst, entry.uncompressedSize, DisposeAfterUse::YES);
+	// Read the first part of the split file
+	uint32 bytesRead = _volumeHeaders[volume - 1].lastFileSizeCompressed;
+	bool success = bytesRead <= entry.compressedSize && readVolume(volume, entry.offset, src, bytesRead);
+
+	// Then, iterate through the next volumes until we've read all the data for the file
+	while (success && bytesRead < entry.compressedSize) {
+		if (++volume > _volumes.size()) {
+			success = false;
+			break;
+		}
+
+		const VolumeHeader &header = _volumeHeaders[volume - 1];
+		const uint32 size = MIN(header.firstFileSizeCompressed, entry.compressedSize - bytesRead);
+		success = size != 0 && readVolume(volume, header.firstFileOffset, src + bytesRead, size);
+		bytesRead += size;
+	}
+
+	if (!success) {
+		warning("Failed to read split file %s", path.toString().c_str());
+		free(src);
+		return nullptr;
+	}
+
+	return src;
+}
+
+SeekableReadStream *InstallShieldCabinet::createStreamingReadStream(const FileEntry &entry) const {
+	SeekableReadStream *compressed = createVolumeStream(entry.volume, entry.offset, entry.compressedSize);
+	if (!compressed)
+		return nullptr;
+
+	// See if we have sync bytes, which mark a single deflate stream
+	if (entry.compressedSize >= 4) {
+		compressed->seek(entry.compressedSize - 4);
+		const bool sync = compressed->readUint32BE() == 0xFFFF;
+		compressed->seek(0);
+
+		if (sync)
+			return wrapSeekableDeflateReadStream(compressed, DisposeAfterUse::YES, entry.uncompressedSize);
+	}
+
+	return new InstallShieldChunkedStream(compressed, entry.uncompressedSize);
+}
+
+FSNode InstallShieldCabinet::getCacheNode(const Path &path, const FileEntry &entry) const {
+	// The position in the cabinet tells apart different releases
+	return _cacheDir.getChild(String::format("%s-%u-%08x-%08x.bin", _cachePrefix.c_str(), entry.volume, entry.offset, path.hashIgnoreCase()));
+}
+
+void InstallShieldCabinet::writeCache(const Path &path, const FileEntry &entry, const byte *data) const {
+	if (_cachePrefix.empty())
+		return;
+
+	SeekableWriteStream *stream = getCacheNode(path, entry).createWriteStream();
+	if (!stream) {
+		warning("InstallShieldCabinet: Can't store '%s' in the cache", path.toString().c_str());
+		return;
+	}
+
+	stream->write(data, entry.uncompressedSize);
+	if (!stream->flush() || stream->err())
+		warning("InstallShieldCabinet: Can't store '%s' in the cache", path.toString().c_str());
+	delete stream;
 }
 
 bool InstallShieldCabinet::readVolumeHeader(SeekableReadStream *volumeStream, InstallShieldCabinet::VolumeHeader &inVolumeHeader) {
@@ -38,12 +38,12 @@ namespace Common {
 RncDecoder::RncDecoder() {
 	initCrc();
 
+	_bitBuffer = 0;
 	_bitBuffl = 0;
-	_bitBuffh = 0;
 	_bitCount = 0;
 	_srcPtr = nullptr;
+	_srcEnd = nullptr;
 	_dstPtr = nullptr;
-	_inputByteLeft = 0;
 }
 
 RncDecoder::~RncDecoder() { }
@@ -69,63 +69,51 @@ void RncDecoder::initCrc() {
 //calculate 16 bit crc of a block of memory
 uint16 RncDecoder::crcBlock(const uint8 *block, uint32 size) {
 	uint16 crc = 0;
-	uint8 *crcTable8 = (uint8 *)_crcTable; //make a uint8* to crc_table
-	uint8 tmp;
-	uint32 i;
-
-	for (i = 0; i < size; i++) {
-		tmp = *block++;
-		crc ^= tmp;
-		tmp = (uint8)((crc >> 8) & 0x00FF);
-		crc &= 0x00FF;
-		crc = *(uint16 *)&crcTable8[crc << 1];
-		crc ^= tmp;
-	}
+
+	for (uint32 i = 0; i < size; i++)
+		crc = (crc >> 8) ^ _crcTable[(crc ^ *block++) & 0xFF];
 
 	return crc;
 }
 
-uint16 RncDecoder::inputBits(uint8 amount) {
-	// Although we are manipulating 16 bits values, use 32 bits variables
-	// This avoids triggering UB when shifting an amount of 0 or 16.
-	uint32 newBitBuffh = _bitBuffh;
-	uint32 newBitBuffl = _bitBuffl;
-	int16 newBitCount = _bitCount;
-	uint32 remBits;
-	uint16 returnVal;
-
-	returnVal = ((1 << amount) - 1) & newBitBuffl;
-	newBitCount -= amount;
-
-	if (newBitCount < 0) {
-		newBitCount += amount;
-		remBits = (newBitBuffh << (16 - newBitCount)) & 0xffff;
-		newBitBuffh >>= newBitCount;
-		newBitBuffl >>= newBitCount;
-		newBitBuffl |= remBits;
-		_srcPtr += 2;
+// Method 1 reads its bits from 16-bit little endian words, so the bit
+// buffer is only ever filled with whole words
+void RncDecoder::fetchBits() {
+	if (_srcEnd - _srcPtr >= 8) {
+		// Any bits above _bitCount belong to the following words and
+		// are ORed in again unchanged by the next fetch
+		const int words = (63 - _bitCount) >> 4;
+		_bitBuffer |= READ_LE_UINT64(_srcPtr) << _bitCount;
+		_srcPtr += words * 2;
+		_bitCount += words * 16;
+		return;
+	}
 
-		// added some more check here to prevent reading in the buffer
-		// if there are no bytes anymore.
-		_inputByteLeft -= 2;
-		if (_inputByteLeft <= 0)
-			newBitBuffh = 0;
-		else if (_inputByteLeft == 1)
-			newBitBuffh = *_srcPtr;
-		else
-			newBitBuffh = READ_LE_UINT16(_srcPtr);
-		amount -= newBitCount;
-		newBitCount = 16 - amount;
+	// Past the end of the input, zero bits are read
+	while (_bitCount <= 47) {
+		uint64 word = 0;
+		if (_srcEnd - _srcPtr >= 2)
+			word = READ_LE_UINT16(_srcPtr);
+		else if (_srcEnd - _srcPtr == 1)
+			word = *_srcPtr;
+		_bitBuffer |= word << _bitCount;
+		_srcPtr += 2;
+		_bitCount += 16;
 	}
-	remBits = (newBitBuffh << (16 - amount)) & 0xffff;
-	_bitBuffh = newBitBuffh >> amount;
-	_bitBuffl = (newBitBuffl >> amount) | remBits;
-	_bitCount = (uint8)newBitCount;
+}
+
+uint16 RncDecoder::inputBits(uint8 amount) {
+	if (_bitCount < amount)
+		fetchBits();
+
+	uint16 returnVal = _bitBuffer & ((1 << amount) - 1);
+	_bitBuffer >>= amount;
+	_bitCount -= amount;
 
 	return returnVal;
 }
 
-void RncDecoder::makeHufftable(uint16 *table) {
+void RncDecoder::makeHufftable(uint16 *table, uint16 *lookup) {
 	uint16 bitLength, i, j;
 	uint16 numCodes = inputBits(5);
 
@@ -138,6 +126,8 @@ void RncDecoder::makeHufftable(uint16 *table) {
 
 	uint16 huffCode = 0;
 
+	memset(lookup, 0, sizeof(uint16) << kLookupBits);
+
 	for (bitLength = 1; bitLength < 17; bitLength++) {
 		for (i = 0; i < numCodes; i++) {
 			if (huffLength[i] == bitLength) {
@@ -152,22 +142,39 @@ void RncDecoder::makeHufftable(uint16 *table) {
 
 				*(table + 0x1e) = (huffLength[i] << 8) | (i & 0x00FF);
 				huffCode += 1 << (16 - bitLength);
+
+				// Every index starting with the code decodes to it
+				if (bitLength <= kLookupBits) {
+					for (j = a; j < (1 << kLookupBits); j += 1 << bitLength)
+						lookup[j] = (huffLength[i] << 8) | (i & 0x00FF);
+				}
 			}
 		}
 	}
 }
 
-uint16 RncDecoder::inputValue(uint16 *table) {
-	uint16 valOne, valTwo, value = _bitBuffl;
+uint16 RncDecoder::inputValue(const uint16 *table, const uint16 *lookup) {
+	// Enough for the longest code and its extra bits
+	if (_bitCount < 32)
+		fetchBits();
 
-	do {
-		valTwo = (*table++) & value;
-		valOne = *table++;
+	uint16 valOne, valTwo, value = lookup[_bitBuffer & ((1 << kLookupBits) - 1)];
+
+	if (!value) {
+		// Longer codes are searched in the table
+		const uint16 bits = _bitBuffer & 0xFFFF;
+		do {
+			valTwo = (*table++) & bits;
+			valOne = *table++;
 
-	} while (valOne != valTwo);
+		} while (valOne != valTwo);
 
-	value = *(table + 0x1e);
-	inputBits((uint8)((value>>8) & 0x00FF));
+		value = *(table + 0x1e);
+	}
+
+	const uint8 length = (value >> 8) & 0x00FF;
+	_bitBuffer >>= length;
+	_bitCount -= length;
 	value &= 0x00FF;
 
 	if (value >= 2) {
@@ -202,9 +209,7 @@ int32 RncDecoder::unpackM1(const void *input, uint inputSize, void *output) {
 	uint16 crcPacked = 0;
 
 
-	_inputByteLeft = inputSize;
-	_bitBuffl = 0;
-	_bitBuffh = 0;
+	_bitBuffer = 0;
 	_bitCount = 0;
 
 	//Check for "RNC "
@@ -241,62 +246,52 @@ int32 RncDecoder::unpackM1(const void *input, uint inputSize, void *output) {
 		_srcPtr = (_dstPtr-packLen);
 	}
 
-	_inputByteLeft -= HEADER_LEN;
+	_srcEnd = _srcPtr + (int32)(inputSize - HEADER_LEN);
 
 	_dstPtr = (uint8 *)output;
 	_bitCount = 0;
 
-	_bitBuffl = READ_LE_UINT16(_srcPtr);
 	inputBits(2);
 
 	do {
-		makeHufftable(_rawTable);
-		makeHufftable(_posTable);
-		makeHufftable(_lenTable);
+		makeHufftable(_rawTable, _rawLookup);
+		makeHufftable(_posTable, _posLookup);
+		makeHufftable(_lenTable, _lenLookup);
 
 		counts = inputBits(16);
 
 		do {
-			uint32 inputLength = inputValue(_rawTable);
+			uint32 inputLength = inputValue(_rawTable, _rawLookup);
 			uint32 inputOffset;
 
 			if (inputLength) {
-				if (_inputByteLeft < (int32) inputLength || inputLength > 0xff000000) {
+				// The literal bytes follow the word holding the next bits,
+				// drop any whole words already fetched beyond it
+				const uint8 *literal = _srcPtr - 2 * (_bitCount >> 4);
+				if (_srcEnd - literal < (int32) inputLength || inputLength > 0xff000000) {
 					return NOT_PACKED;
 				}
-				memcpy(_dstPtr, _srcPtr, inputLength); //memcpy is allowed here
+				memcpy(_dstPtr, literal, inputLength); //memcpy is allowed here
 				_dstPtr += inputLength;
-				_srcPtr += inputLength;
-				_inputByteLeft -= inputLength;
-				uint16 a;
-				if (_inputByteLeft <= 0)
-					a = 0;
-				else if (_inputByteLeft == 1)
-					a = *_srcPtr;
-				else
-					a = READ_LE_UINT16(_srcPtr);
-
-				uint16 b;
-				if (_inputByteLeft <= 2)
-					b = 0;
-				else if (_inputByteLeft == 3)
-					b = *(_srcPtr + 2);
-				else
-					b = READ_LE_UINT16(_srcPtr + 2);
-
-				_bitBuffl &= ((1 << _bitCount) - 1);
-				_bitBuffl |= (a << _bitCount);
-				_bitBuffh = (a >> (16 - _bitCount)) | (b << _bitCount);
+				_srcPtr = literal + inputLength;
+
+				_bitCount &= 15;
+				_bitBuffer &= ((1 << _bitCount) - 1);
 			}
 
 			if (counts > 1) {
-				inputOffset = inputValue(_posTable) + 1;
-				inputLength = inputValue(_lenTable) + MIN_LENGTH;
+				inputOffset = inputValue(_posTable, _posLookup) + 1;
+				inputLength = inputValue(_lenTable, _lenLookup) + MIN_LENGTH;
 
-				// Don't use memcpy here! because input and output overlap.
+				// Don't use memcpy here if input and output overlap.
 				uint8 *tmpPtr = (_dstPtr-inputOffset);
-				while (inputLength--)
-					*_dstPtr++ = *tmpPtr++;
+				if (inputOffset >= inputLength) {
+					memcpy(_dstPtr, tmpPtr, inputLength);
+					_dstPtr += inputLength;
+				} else {
+					while (inputLength--)
+						*_dstPtr++ = *tmpPtr++;
+				}
 			}
 		} while (--counts);
 	} while (--blocks);
@@ -29,20 +29,28 @@ namespace Common {
 class RncDecoder {
 
 protected:
+	enum {
+		kLookupBits = 9
+	};
+
 	uint16 _rawTable[64];
 	uint16 _posTable[64];
 	uint16 _lenTable[64];
+	// Huffman codes of up to kLookupBits bits are decoded through these,
+	// indexed by the next bits of input
+	uint16 _rawLookup[1 << kLookupBits];
+	uint16 _posLookup[1 << kLookupBits];
+	uint16 _lenLookup[1 << kLookupBits];
 	uint16 _crcTable[256];
 
+	uint64 _bitBuffer;
 	uint16 _bitBuffl;
-	uint16 _bitBuffh;
 	uint8 _bitCount;
 
 	const uint8 *_srcPtr;
+	const uint8 *_srcEnd;
 	uint8 *_dstPtr;
 
-	int32 _inputByteLeft;
-
 public:
 	RncDecoder();
 	~RncDecoder();
@@ -55,9 +63,10 @@ public:
 protected:
 	void initCrc();
 	uint16 crcBlock(const uint8 *block, uint32 size);
+	void fetchBits();
 	uint16 inputBits(uint8 amount);
-	void makeHufftable(uint16 *table);
-	uint16 inputValue(uint16 *table);
+	void makeHufftable(uint16 *table, uint16 *lookup);
+	uint16 inputValue(const uint16 *table, const uint16 *lookup);
 	int getbit();
 };
 
@@ -95,6 +95,9 @@ typedef Byte Bytef;
 #include "common/compression/deflate.h"
 #include "common/compression/unzip.h"
 #include "common/memstream.h"
+#include "common/mutex.h"
+#include "common/ptr.h"
+#include "common/substream.h"
 
 #include "common/hashmap.h"
 #include "common/hash-str.h"
@@ -1024,6 +1027,69 @@ Common::SharedArchiveContents unzOpenCurrentFile (unzFile file
 	return Common::SharedArchiveContents(uncompressedBuffer, s->cur_file_info.uncompressed_size);
 }
 
+/*
+  The stream of a zipfile, along with the mutex serializing access to it.
+  It is shared by the archive and its streamed members, so that the members
+  stay readable after the archive has been deleted.
+*/
+struct ZipSharedStream {
+	Common::SeekableReadStream *_stream;
+	Common::Mutex _mutex;
+
+	ZipSharedStream(Common::SeekableReadStream *stream) : _stream(stream) {}
+	~ZipSharedStream() { delete _stream; }
+};
+
+class ZipMemberReadStream : public Common::SafeSeekableSubReadStream {
+public:
+	ZipMemberReadStream(const Common::SharedPtr<ZipSharedStream> &shared, uint32 begin, uint32 end)
+		: Common::SafeSeekableSubReadStream(shared->_stream, begin, end, DisposeAfterUse::NO), _shared(shared) {
+	}
+
+	uint32 read(void *dataPtr, uint32 dataSize) override {
+		Common::StackLock lock(_shared->_mutex);
+		return Common::SafeSeekableSubReadStream::read(dataPtr, dataSize);
+	}
+
+private:
+	Common::SharedPtr<ZipSharedStream> _shared;
+};
+
+/*
+  Open the current file in the zipfile as a stream reading straight from the
+  archive. Deflated data is inflated on the fly while it is being read.
+  The CRC is not checked, as the data is never available as a whole.
+*/
+Common::SeekableReadStream *unzOpenCurrentFileStream(unzFile file, const Common::SharedPtr<ZipSharedStream> &shared) {
+	uInt iSizeVar;
+	unz_s *s;
+	uLong offset_local_extrafield;  /* offset of the local extra field */
+	uInt  size_local_extrafield;    /* size of the local extra field */
+
+	if (file == nullptr)
+		return nullptr;
+	s = (unz_s *)file;
+	if (!s->current_file_ok)
+		return nullptr;
+
+	if (unzlocal_CheckCurrentFileCoherencyHeader(s, &iSizeVar,
+				&offset_local_extrafield, &size_local_extrafield) != UNZ_OK)
+		return nullptr;
+
+	uint32 begin = s->cur_file_info_internal.offset_curfile + SIZEZIPLOCALHEADER + iSizeVar;
+	Common::SeekableReadStream *stream = new ZipMemberReadStream(shared, begin, begin + s->cur_file_info.compressed_size);
+
+	switch (s->cur_file_info.compression_method) {
+	case 0: // Store
+		return stream;
+	case Z_DEFLATED:
+		return Common::wrapSeekableDeflateReadStream(stream, DisposeAfterUse::YES, s->cur_file_info.uncompressed_size);
+	default:
+		warning("Unknown compression algoritthm %d", (int)s->cur_file_info.compression_method);
+		delete stream;
+		return nullptr;
+	}
+}
 
 namespace Common {
 
@@ -1034,9 +1100,12 @@ class ZipArchive : public MemcachingCaseInsensitiveArchive {
 	Common::CRC32 _crc;
 #endif
 	bool _flattenTree;
+	uint32 _streamingThreshold;
+	// The archive stream, which is shared by the streamed members
+	SharedPtr<ZipSharedStream> _sharedStream;
 
 public:
-	ZipArchive(unzFile zipFile, bool flattenTree);
+	ZipArchive(unzFile zipFile, bool flattenTree, uint32 streamingThreshold);
 
 
 	~ZipArchive();
@@ -1069,11 +1138,15 @@ public:
 };
 */
 
-ZipArchive::ZipArchive(unzFile zipFile, bool flattenTree) : _zipFile(zipFile), _flattenTree(flattenTree) {
+ZipArchive::ZipArchive(unzFile zipFile, bool flattenTree, uint32 streamingThreshold) :
+	_zipFile(zipFile), _flattenTree(flattenTree), _streamingThreshold(streamingThreshold) {
 	assert(_zipFile);
+	_sharedStream.reset(new ZipSharedStream(((unz_s *)_zipFile)->_stream));
 }
 
 ZipArchive::~ZipArchive() {
+	// The stream is deleted along with the last streamed member instead
+	((unz_s *)_zipFile)->_stream = nullptr;
 	unzClose(_zipFile);
 }
 
@@ -1115,6 +1188,19 @@ const ArchiveMemberPtr ZipArchive::getMember(const Path &path) const {
 Common::SharedArchiveContents ZipArchive::readContentsForPath(const Common::Path &path) const {
 	if (unzLocateFile(_zipFile, path, 2) != UNZ_OK)
 		return Common::SharedArchiveContents();
+
+	StackLock lock(_sharedStream->_mutex);
+
+	// Large members are read straight from the archive instead of being
+	// decompressed into memory in one go
+	const unz_s *const archive = (const unz_s *)_zipFile;
+	if (_streamingThreshold && archive->cur_file_info.uncompressed_size >= _streamingThreshold) {
+		SeekableReadStream *stream = unzOpenCurrentFileStream(_zipFile, _sharedStream);
+		if (stream)
+			return Common::SharedArchiveContents::bypass(stream);
+		return Common::SharedArchiveContents();
+	}
+
 #ifndef USE_ZLIB
 	return unzOpenCurrentFile(_zipFile, _crc);
 #else
@@ -1122,15 +1208,15 @@ Common::SharedArchiveContents ZipArchive::readContentsForPath(const Common::Path
 #endif
 }
 
-Archive *makeZipArchive(const Path &name, bool flattenTree) {
-	return makeZipArchive(SearchMan.createReadStreamForMember(name), flattenTree);
+Archive *makeZipArchive(const Path &name, bool flattenTree, uint32 streamingThreshold) {
+	return makeZipArchive(SearchMan.createReadStreamForMember(name), flattenTree, streamingThreshold);
 }
 
-Archive *makeZipArchive(const FSNode &node, bool flattenTree) {
-	return makeZipArchive(node.createReadStream(), flattenTree);
+Archive *makeZipArchive(const FSNode &node, bool flattenTree, uint32 streamingThreshold) {
+	return makeZipArchive(node.createReadStream(), flattenTree, streamingThreshold);
 }
 
-Archive *makeZipArchive(SeekableReadStream *stream, bool flattenTree) {
+Archive *makeZipArchive(SeekableReadStream *stream, bool flattenTree, uint32 streamingThreshold) {
 	if (!stream)
 		return nullptr;
 	unzFile zipFile = unzOpen(stream, flattenTree);
@@ -1139,7 +1225,7 @@ Archive *makeZipArchive(SeekableReadStream *stream, bool flattenTree) {
 		// goes wrong.
 		return nullptr;
 	}
-	return new ZipArchive(zipFile, flattenTree);
+	return new ZipArchive(zipFile, flattenTree, streamingThreshold);
 }
 
 } // End of namespace Common
@@ -39,13 +39,24 @@ class Archive;
 class FSNode;
 class SeekableReadStream;
 
+/**
+ * Members of ZIP archives with at least this many bytes of uncompressed data
+ * are decompressed on the fly while being read. Smaller ones are decompressed
+ * into memory when opened and shared between all streams opened on them.
+ * Either way, the streams stay valid after the archive has been deleted.
+ */
+static const uint32 kZipStreamingThreshold = 256 * 1024;
+
 /**
  * This factory method creates an Archive instance corresponding to the content
  * of the ZIP compressed file with the given name.
  *
+ * Members at least streamingThreshold bytes large are streamed, see
+ * kZipStreamingThreshold. Pass 0 to always decompress them into memory.
+ *
  * May return 0 in case of a failure.
  */
-Archive *makeZipArchive(const Path &name, bool flattenTree = false);
+Archive *makeZipArchive(const Path &name, bool flattenTree = false, uint32 streamingThreshold = kZipStreamingThreshold);
 
 /**
  * This factory method creates an Archive instance corresponding to the content
@@ -53,7 +64,7 @@ Archive *makeZipArchive(const Path &name, bool flattenTree = false);
  *
  * May return 0 in case of a failure.
  */
-Archive *makeZipArchive(const FSNode &node, bool flattenTree = false);
+Archive *makeZipArchive(const FSNode &node, bool flattenTree = false, uint32 streamingThreshold = kZipStreamingThreshold);
 
 /**
  * This factory method creates an Archive instance corresponding to the content
@@ -63,7 +74,7 @@ Archive *makeZipArchive(const FSNode &node, bool flattenTree = false);
  *
  * May return 0 in case of a failure. In this case stream will still be deleted.
  */
-Archive *makeZipArchive(SeekableReadStream *stream, bool flattenTree = false);
+Archive *makeZipArchive(SeekableReadStream *stream, bool flattenTree = false, uint32 streamingThreshold = kZipStreamingThreshold);
 
 /** @} */
 
@@ -21,6 +21,7 @@
 
 #include "common/compression/vise.h"
 
+#include "common/hashmap.h"
 #include "common/macresman.h"
 #include "common/memstream.h"
 #include "common/compression/deflate.h"
@@ -102,6 +103,9 @@ private:
 	Common::SeekableReadStream *_archiveStream;
 	Common::Array<FileDesc> _fileDescs;
 	Common::Array<DirectoryDesc> _directoryDescs;
+
+	typedef Common::HashMap<Common::Path, uint, Common::Path::Hash, Common::Path::EqualTo> FileDescIndexMap;
+	FileDescIndexMap _fileDescIndex;
 };
 
 MacVISEArchive::ArchiveMember::ArchiveMember(Common::SeekableReadStream *archiveStream, const FileDesc *fileDesc)
@@ -352,16 +356,21 @@ bool MacVISEArchive::loadCatalog() {
 		}
 	}
 
+	// Index the files by path, keeping the first of any duplicates
+	for (uint descIndex = 0; descIndex < _fileDescs.size(); descIndex++) {
+		if (!_fileDescIndex.contains(_fileDescs[descIndex].fullPath))
+			_fileDescIndex[_fileDescs[descIndex].fullPath] = descIndex;
+	}
+
 	return true;
 }
 
 const MacVISEArchive::FileDesc *MacVISEArchive::getFileDesc(const Common::Path &path) const {
-	for (const FileDesc &desc : _fileDescs) {
-		if (desc.fullPath == path)
-			return &desc;
-	}
+	uint descIndex = 0;
+	if (!getFileDescIndex(path, descIndex))
+		return nullptr;
 
-	return nullptr;
+	return &_fileDescs[descIndex];
 }
 
 bool MacVISEArchive::hasFile(const Common::Path &path) const {
@@ -409,16 +418,12 @@ char MacVISEArchive::getPathSeparator() const {
 }
 
 bool MacVISEArchive::getFileDescIndex(const Common::Path &path, uint &outIndex) const {
-	for (uint descIndex = 0; descIndex < _fileDescs.size(); descIndex++) {
-		const FileDesc &desc = _fileDescs[descIndex];
-
-		if (desc.fullPath == path) {
-			outIndex = descIndex;
-			return true;
-		}
-	}
+	FileDescIndexMap::const_iterator it = _fileDescIndex.find(path);
+	if (it == _fileDescIndex.end())
+		return false;
 
-	return false;
+	outIndex = it->_value;
+	return true;
 }
 
 Common::Archive *createMacVISEArchive(Common::SeekableReadStream *stream) {
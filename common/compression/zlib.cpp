@@ -33,6 +33,8 @@
 
 #include "common/compression/deflate.h"
 
+#include "common/array.h"
+#include "common/atomic.h"
 #include "common/ptr.h"
 #include "common/util.h"
 #include "common/stream.h"
@@ -273,6 +275,327 @@ public:
 	}
 };
 
+/**
+ * A small pool of raw inflate states. Every inflate state carries a 32 KiB
+ * window besides its own bookkeeping, so reusing them saves an allocation
+ * and a full initialization each time an archive member is opened.
+ */
+class InflateStatePool {
+	enum {
+		kPoolSize = 4
+	};
+
+	Atomic<z_stream *> _states[kPoolSize];
+
+public:
+	~InflateStatePool() {
+		for (int i = 0; i < kPoolSize; ++i) {
+			z_stream *stream = _states[i].exchange(nullptr);
+			if (stream) {
+				inflateEnd(stream);
+				delete stream;
+			}
+		}
+	}
+
+	z_stream *acquire() {
+		for (int i = 0; i < kPoolSize; ++i) {
+			z_stream *stream = _states[i].exchange(nullptr);
+			if (!stream)
+				continue;
+			if (inflateReset(stream) == Z_OK)
+				return stream;
+			inflateEnd(stream);
+			delete stream;
+		}
+
+		z_stream *stream = new z_stream();
+		// Negative MAX_WBITS tells zlib there's no zlib header
+		if (inflateInit2(stream, -MAX_WBITS) != Z_OK) {
+			delete stream;
+			return nullptr;
+		}
+		return stream;
+	}
+
+	void release(z_stream *stream) {
+		for (int i = 0; i < kPoolSize; ++i) {
+			z_stream *expected = nullptr;
+			if (_states[i].compareExchange(expected, stream))
+				return;
+		}
+		inflateEnd(stream);
+		delete stream;
+	}
+};
+
+static InflateStatePool &getInflateStatePool() {
+	static InflateStatePool pool;
+	return pool;
+}
+
+/**
+ * A wrapper around a SeekableReadStream holding raw deflate data, which
+ * decompresses it on the fly. While decompressing it records sparse
+ * checkpoints (input position and the preceding 32 KiB of output) at deflate
+ * block boundaries, so that seeking backwards or far ahead only has to
+ * inflate from the closest checkpoint instead of from the start.
+ */
+class SeekableInflateStream : public SeekableReadStream {
+protected:
+	enum {
+		BUFSIZE = 16384,
+		WINSIZE = 32768		// 1 << MAX_WBITS
+	};
+
+	struct Checkpoint {
+		uint32 outPos;
+		uint32 inPos;
+		byte bits;
+		byte prevByte;
+		uint32 windowSize;
+		byte *window;
+	};
+
+	byte _buf[BUFSIZE];
+	// Output is inflated into this circular window before being handed
+	// out, so that the last 32 KiB are always at hand for a checkpoint.
+	byte _window[WINSIZE];
+	uint32 _winRead;
+	uint32 _winEnd;
+	bool _winFull;
+
+	DisposablePtr<SeekableReadStream> _wrapped;
+	z_stream *_stream;
+	int _zlibErr;
+	uint64 _parentPos;
+	uint32 _inPos;
+	uint32 _outPos;
+	uint32 _pos;
+	uint32 _origSize;
+	bool _eos;
+
+	Array<Checkpoint> _checkpoints;
+	uint32 _checkpointInterval;
+	uint32 _nextCheckpoint;
+
+	void addCheckpoint() {
+		Checkpoint checkpoint;
+		checkpoint.bits = _stream->data_type & 7;
+		if (checkpoint.bits && _stream->next_in == _buf) {
+			// The partially consumed byte was in the previous input
+			// buffer, just wait for the next block boundary.
+			return;
+		}
+		checkpoint.prevByte = checkpoint.bits ? _stream->next_in[-1] : 0;
+		checkpoint.outPos = _outPos;
+		checkpoint.inPos = _inPos - _stream->avail_in;
+		checkpoint.windowSize = _winFull ? (uint32)WINSIZE : _winEnd;
+		checkpoint.window = (byte *)malloc(checkpoint.windowSize);
+		if (!checkpoint.window)
+			return;
+
+		if (_winFull) {
+			memcpy(checkpoint.window, _window + _winEnd, WINSIZE - _winEnd);
+			memcpy(checkpoint.window + WINSIZE - _winEnd, _window, _winEnd);
+		} else {
+			memcpy(checkpoint.window, _window, _winEnd);
+		}
+
+		_checkpoints.push_back(checkpoint);
+		_nextCheckpoint = _outPos + _checkpointInterval;
+	}
+
+	bool restart(const Checkpoint *checkpoint) {
+		_zlibErr = inflateReset(_stream);
+		if (_zlibErr != Z_OK)
+			return false;
+
+		_inPos = 0;
+		_outPos = 0;
+		_winRead = _winEnd = 0;
+		_winFull = false;
+		if (checkpoint) {
+			_inPos = checkpoint->inPos;
+			_outPos = checkpoint->outPos;
+			if (checkpoint->bits)
+				_zlibErr = inflatePrime(_stream, checkpoint->bits, checkpoint->prevByte >> (8 - checkpoint->bits));
+			if (_zlibErr == Z_OK)
+				_zlibErr = inflateSetDictionary(_stream, checkpoint->window, checkpoint->windowSize);
+			if (_zlibErr != Z_OK)
+				return false;
+			memcpy(_window, checkpoint->window, checkpoint->windowSize);
+			_winRead = _winEnd = checkpoint->windowSize;
+		}
+
+		_wrapped->seek(_parentPos + _inPos, SEEK_SET);
+		_stream->next_in = _buf;
+		_stream->avail_in = 0;
+		_pos = _outPos;
+		return true;
+	}
+
+	void fillWindow() {
+		if (_winEnd == WINSIZE) {
+			_winRead = _winEnd = 0;
+			_winFull = true;
+		}
+
+		// Stop at the known size, so that data which is not terminated by
+		// a final block (as flushed with Z_SYNC_FLUSH) does not end in an error
+		while (_zlibErr == Z_OK && _winEnd < WINSIZE && _outPos < _origSize) {
+			if (_stream->avail_in == 0 && !_wrapped->eos()) {
+				// If we are out of input data: Read more data, if available.
+				_stream->next_in = _buf;
+				_stream->avail_in = _wrapped->read(_buf, BUFSIZE);
+				_inPos += _stream->avail_in;
+			}
+
+			// Only stop at block boundaries once a checkpoint is due
+			const bool wantCheckpoint = _checkpointInterval && _outPos >= _nextCheckpoint;
+			_stream->next_out = _window + _winEnd;
+			_stream->avail_out = WINSIZE - _winEnd;
+			_zlibErr = inflate(_stream, wantCheckpoint ? Z_BLOCK : Z_NO_FLUSH);
+
+			const uint32 produced = WINSIZE - _winEnd - _stream->avail_out;
+			_winEnd += produced;
+			_outPos += produced;
+
+			// Bit 7 marks a block boundary, bit 6 the last block
+			if (wantCheckpoint && _zlibErr == Z_OK && (_stream->data_type & 0xC0) == 0x80)
+				addCheckpoint();
+		}
+	}
+
+public:
+	SeekableInflateStream(SeekableReadStream *w, DisposeAfterUse::Flag disposeParent, uint32 knownSize, uint32 checkpointInterval)
+		: _winRead(0), _winEnd(0), _winFull(false),
+		  _wrapped(w, disposeParent), _stream(getInflateStatePool().acquire()), _zlibErr(Z_OK),
+		  _inPos(0), _outPos(0), _pos(0), _origSize(knownSize), _eos(false),
+		  _checkpointInterval(checkpointInterval), _nextCheckpoint(checkpointInterval) {
+		assert(w != nullptr);
+
+		_parentPos = w->pos();
+		if (!_stream) {
+			_zlibErr = Z_MEM_ERROR;
+			return;
+		}
+
+		// Setup input buffer
+		_stream->next_in = _buf;
+		_stream->avail_in = 0;
+	}
+
+	~SeekableInflateStream() {
+		if (_stream)
+			getInflateStatePool().release(_stream);
+		for (uint i = 0; i < _checkpoints.size(); ++i)
+			free(_checkpoints[i].window);
+	}
+
+	bool err() const override { return (_zlibErr != Z_OK) && (_zlibErr != Z_STREAM_END); }
+	void clearErr() override {
+		// only reset _eos; I/O errors are not recoverable
+		_eos = false;
+	}
+
+	uint32 read(void *dataPtr, uint32 dataSize) override {
+		byte *dst = (byte *)dataPtr;
+		uint32 total = 0;
+
+		while (total < dataSize) {
+			if (_winRead == _winEnd) {
+				if (_zlibErr != Z_OK)
+					break;
+				fillWindow();
+				if (_winRead == _winEnd)
+					break;
+			}
+
+			const uint32 count = MIN(dataSize - total, _winEnd - _winRead);
+			memcpy(dst + total, _window + _winRead, count);
+			_winRead += count;
+			total += count;
+		}
+
+		_pos += total;
+		if (total < dataSize)
+			_eos = true;
+
+		return total;
+	}
+
+	bool eos() const override {
+		return _eos;
+	}
+	int64 pos() const override {
+		return _pos;
+	}
+	int64 size() const override {
+		return _origSize;
+	}
+	bool seek(int64 offset, int whence = SEEK_SET) override {
+		int64 newPos = 0;
+		switch (whence) {
+		default:
+			// fallthrough intended
+		case SEEK_SET:
+			newPos = offset;
+			break;
+		case SEEK_CUR:
+			newPos = _pos + offset;
+			break;
+		case SEEK_END:
+			newPos = size() + offset;
+			break;
+		}
+
+		if (newPos < 0)
+			return false;
+
+		_eos = false;
+
+		// Short backward seeks can often be served from the window
+		if ((uint64)newPos <= _pos && _pos - newPos <= _winRead) {
+			_winRead -= _pos - newPos;
+			_pos = newPos;
+			return true;
+		}
+
+		// Find the closest checkpoint before the target
+		const Checkpoint *checkpoint = nullptr;
+		for (uint i = _checkpoints.size(); i > 0; --i) {
+			if (_checkpoints[i - 1].outPos <= newPos) {
+				checkpoint = &_checkpoints[i - 1];
+				break;
+			}
+		}
+
+		const uint32 checkpointPos = checkpoint ? checkpoint->outPos : 0;
+		if ((uint64)newPos < _pos || checkpointPos > _pos) {
+			if (!restart(checkpoint))
+				return false;
+		}
+
+		// Skip forward, without copying the data anywhere
+		while (_pos < newPos) {
+			if (_winRead == _winEnd) {
+				if (_zlibErr != Z_OK)
+					break;
+				fillWindow();
+				if (_winRead == _winEnd)
+					break;
+			}
+
+			const uint32 count = MIN<int64>(newPos - _pos, _winEnd - _winRead);
+			_winRead += count;
+			_pos += count;
+		}
+
+		return !err();
+	}
+};
+
 /**
  * A simple wrapper class which can be used to wrap around an arbitrary
  * other WriteStream and will then provide on-the-fly compression support.
@@ -420,6 +743,20 @@ SeekableReadStream *wrapDeflateReadStream(SeekableReadStream *toBeWrapped, Dispo
 	return new GZipReadStream(toBeWrapped, disposeParent, knownSize, dict, dictLen);
 }
 
+SeekableReadStream *wrapSeekableDeflateReadStream(SeekableReadStream *toBeWrapped, DisposeAfterUse::Flag disposeParent, uint64 knownSize, uint32 checkpointInterval) {
+	if (!toBeWrapped) {
+		return nullptr;
+	}
+
+	if (toBeWrapped->eos() || toBeWrapped->err()) {
+		if (disposeParent == DisposeAfterUse::YES) {
+			delete toBeWrapped;
+		}
+		return nullptr;
+	}
+	return new SeekableInflateStream(toBeWrapped, disposeParent, knownSize, checkpointInterval);
+}
+
 WriteStream *wrapCompressedWriteStream(WriteStream *toBeWrapped) {
 	if (!toBeWrapped)
 		return nullptr;
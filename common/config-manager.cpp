@@ -23,6 +23,8 @@
 #include "common/debug.h"
 #include "common/file.h"
 #include "common/fs.h"
+#include "common/jobs.h"
+#include "common/memstream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 
@@ -33,6 +35,26 @@ static bool isValidDomainName(const Common::String &domName) {
 	return *p == 0;
 }
 
+/**
+ * Find the end of the line starting at @p p. Lines end with LF, CR or CR LF,
+ * as with SeekableReadStream::readLine(). @p next is set to the start of the
+ * following line.
+ */
+static const char *findLineEnd(const char *p, const char *end, const char *&next) {
+	while (p < end && *p != '\n' && *p != '\r')
+		p++;
+
+	next = p;
+	if (next < end && *next++ == '\r' && next < end && *next == '\n')
+		next++;
+	return p;
+}
+
+static bool keyEquals(const char *key, const char *keyEnd, const char *name) {
+	const uint size = keyEnd - key;
+	return size == strlen(name) && scumm_strnicmp(key, name, size) == 0;
+}
+
 namespace Common {
 
 DECLARE_SINGLETON(ConfigManager);
@@ -50,7 +72,11 @@ char const *const ConfigManager::kCloudDomain = "cloud";
 #pragma mark -
 
 
-ConfigManager::ConfigManager() : _activeDomain(nullptr) {
+ConfigManager::ConfigManager() : _activeDomain(nullptr), _flushStream(nullptr), _flushFailed(false) {
+}
+
+ConfigManager::~ConfigManager() {
+	waitForFlush();
 }
 
 void ConfigManager::defragment() {
@@ -75,6 +101,7 @@ void ConfigManager::copyFrom(ConfigManager &source) {
 	_activeDomainName = source._activeDomainName;
 	_activeDomain = &_gameDomains[_activeDomainName];
 	_filename = source._filename;
+	_flushedConfig = source._flushedConfig;
 }
 
 
@@ -135,19 +162,21 @@ bool ConfigManager::loadFallbackConfigFile(const Path &filename) {
  * Add a ready-made domain based on its name and contents
  * The domain name should not already exist in the ConfigManager.
  **/
-void ConfigManager::addDomain(const String &domainName, const ConfigManager::Domain &domain) {
+void ConfigManager::addDomain(const String &domainName, const ConfigManager::Domain &domain, bool isGameDomain) {
 	if (domainName.empty())
 		return;
 	if (domainName == kApplicationDomain) {
 		_appDomain = domain;
+		_appDomain.ensureParsed();
 	} else if (domainName == kKeymapperDomain) {
 		_keymapperDomain = domain;
+		_keymapperDomain.ensureParsed();
 #ifdef USE_CLOUD
 	} else if (domainName == kCloudDomain) {
 		_cloudDomain = domain;
+		_cloudDomain.ensureParsed();
 #endif
-	} else if (domain.contains("gameid")) {
-		// If the domain contains "gameid" we assume it's a game domain
+	} else if (isGameDomain) {
 		if (_gameDomains.contains(domainName))
 			warning("Game domain %s already exists in ConfigManager", domainName.c_str());
 
@@ -175,6 +204,10 @@ bool ConfigManager::loadFromStream(SeekableReadStream &stream) {
 	String domainName;
 	String comment;
 	Domain domain;
+	const char *linesBegin = nullptr;
+	const char *linesEnd = nullptr;
+	bool canonical = true;
+	bool isGameDomain = false;
 	int lineno = 0;
 
 	_appDomain.clear();
@@ -189,41 +222,55 @@ bool ConfigManager::loadFromStream(SeekableReadStream &stream) {
 	_cloudDomain.clear();
 #endif
 
+	// Read the whole file at once. It is only checked and split into domains
+	// here, the key/value pairs of most domains are parsed when first used.
+	Array<char> text;
+	if (stream.size() > stream.pos())
+		text.reserve(stream.size() - stream.pos());
+	while (!stream.eos() && !stream.err()) {
+		const uint size = text.size();
+		text.resize(size + 16384);
+		text.resize(size + stream.read(&text[size], 16384));
+	}
+
+	const char *end = text.data() + text.size();
+	const char *line = text.data();
+
+	// Skip UTF-8 byte-order mark if added by a text editor.
+	if (text.size() >= 3 && memcmp(line, UTF8_BOM, 3) == 0)
+		line += 3;
+
 	// TODO: Detect if a domain occurs multiple times (or likewise, if
 	// a key occurs multiple times inside one domain).
 
-	while (!stream.eos() && !stream.err()) {
+	const char *next;
+	for (; line < end; line = next) {
 		lineno++;
 
-		// Read a line
-		String line = stream.readLine();
+		const char *lineEnd = findLineEnd(line, end, next);
 
-		// Skip UTF-8 byte-order mark if added by a text editor.
-		if (lineno == 1 && memcmp(line.c_str(), UTF8_BOM, 3) == 0) {
-			line.erase(0, 3);
-		}
-
-		if (line.size() == 0) {
+		if (line == lineEnd) {
 			// Do nothing
-		} else if (line[0] == '#') {
+		} else if (*line == '#') {
 			// Accumulate comments here. Once we encounter either the start
 			// of a new domain, or a key-value-pair, we associate the value
 			// of the 'comment' variable with that entity.
-			comment += line;
+			comment += String(line, lineEnd);
 			comment += "\n";
-		} else if (line[0] == '[') {
+		} else if (*line == '[') {
 			// It's a new domain which begins here.
 			// Determine where the previously accumulated domain goes, if we accumulated anything.
-			addDomain(domainName, domain);
+			domain.setLines(linesBegin, linesEnd, canonical);
+			addDomain(domainName, domain, isGameDomain);
 			domain.clear();
-			const char *p = line.c_str() + 1;
+			const char *p = line + 1;
 			// Get the domain name, and check whether it's valid (that
 			// is, verify that it only consists of alphanumerics,
 			// dashes and underscores).
-			while (*p && (isAlnum(*p) || *p == '-' || *p == '_'))
+			while (p < lineEnd && (isAlnum(*p) || *p == '-' || *p == '_'))
 				p++;
 
-			if (*p == '\0') {
+			if (p == lineEnd) {
 				warning("Config file buggy: missing ] in line %d", lineno);
 				return false;
 			} else if (*p != ']') {
@@ -231,21 +278,24 @@ bool ConfigManager::loadFromStream(SeekableReadStream &stream) {
 				return false;
 			}
 
-			domainName = String(line.c_str() + 1, p);
+			domainName = String(line + 1, p);
 
 			domain.setDomainComment(comment);
 			comment.clear();
 
+			linesBegin = linesEnd = next;
+			canonical = true;
+			isGameDomain = false;
 		} else {
 			// This line should be a line with a 'key=value' pair, or an empty one.
 
 			// Skip leading whitespaces
-			const char *t = line.c_str();
-			while (isSpace(*t))
+			const char *t = line;
+			while (t < lineEnd && isSpace(*t))
 				t++;
 
 			// Skip empty lines / lines with only whitespace
-			if (*t == 0)
+			if (t == lineEnd)
 				continue;
 
 			// If no domain has been set, this config file is invalid!
@@ -255,72 +305,58 @@ bool ConfigManager::loadFromStream(SeekableReadStream &stream) {
 			}
 
 			// Split string at '=' into 'key' and 'value'. First, find the "=" delimeter.
-			const char *p = strchr(t, '=');
+			const char *p = (const char *)memchr(t, '=', lineEnd - t);
 			if (!p) {
-				warning("Config file buggy: Junk found in line %d: '%s'", lineno, t);
+				warning("Config file buggy: Junk found in line %d: '%s'", lineno, String(t, lineEnd).c_str());
 				return false;
 			}
 
-			// Extract the key/value pair
-			String key(t, p);
-			String value(p + 1);
+			const char *keyEnd = p;
+			while (keyEnd > t && isSpace(keyEnd[-1]))
+				keyEnd--;
 
-			// Trim of spaces
-			key.trim();
-			value.trim();
+			// If the domain contains "gameid" we assume it's a game domain
+			if (keyEquals(t, keyEnd, "gameid"))
+				isGameDomain = true;
 
-			// Finally, store the key/value pair in the active domain
-			domain.setVal(key, value);
+			// Domains are only written back as they are if writeDomain() would
+			// write them the same way.
+			if (t != line || keyEnd != p || p + 1 == lineEnd || isSpace(p[1]) || isSpace(lineEnd[-1]) ||
+			    keyEquals(t, keyEnd, "id_came_from_command_line"))
+				canonical = false;
 
-			// Store comment
-			domain.setKVComment(key, comment);
+			// The comment is kept with the lines of the domain
 			comment.clear();
+			linesEnd = next;
 		}
 	}
 
-	addDomain(domainName, domain); // Add the last domain found
+	// Add the last domain found
+	domain.setLines(linesBegin, linesEnd, canonical);
+	addDomain(domainName, domain, isGameDomain);
 
 	return true;
 }
 
 void ConfigManager::flushToDisk() {
 #ifndef __DC__
-	WriteStream *stream;
-
-	if (_filename.empty()) {
-		// Write to the default config file
-		assert(g_system);
-		stream = g_system->createConfigWriteStream();
-		if (!stream)    // If writing to the config file is not possible, do nothing
-			return;
-	} else {
-		DumpFile *dump = new DumpFile();
-		assert(dump);
-
-		if (!dump->open(_filename)) {
-			warning("Unable to write configuration file: %s", _filename.toString(Common::Path::kNativeSeparator).c_str());
-			delete dump;
-			return;
-		}
-
-		stream = dump;
-	}
+	MemoryWriteStreamDynamic config(DisposeAfterUse::YES);
 
 	// Write the application domain
-	writeDomain(*stream, kApplicationDomain, _appDomain);
+	writeDomain(config, kApplicationDomain, _appDomain);
 
 	// Write the keymapper domain
-	writeDomain(*stream, kKeymapperDomain, _keymapperDomain);
+	writeDomain(config, kKeymapperDomain, _keymapperDomain);
 #ifdef USE_CLOUD
 	// Write the cloud domain
-	writeDomain(*stream, kCloudDomain, _cloudDomain);
+	writeDomain(config, kCloudDomain, _cloudDomain);
 #endif
 
 	DomainMap::const_iterator d;
 
 	// Write the miscellaneous domains next
 	for (d = _miscDomains.begin(); d != _miscDomains.end(); ++d) {
-		writeDomain(*stream, d->_key, d->_value);
+		writeDomain(config, d->_key, d->_value);
 	}
 
 	// First write the domains in _domainSaveOrder, in that order.
@@ -329,29 +365,93 @@ void ConfigManager::flushToDisk() {
 	Array<String>::const_iterator i;
 	for (i = _domainSaveOrder.begin(); i != _domainSaveOrder.end(); ++i) {
 		if (_gameDomains.contains(*i)) {
-			writeDomain(*stream, *i, _gameDomains[*i]);
+			writeDomain(config, *i, _gameDomains[*i]);
 		}
 	}
 
 	// Now write the domains which haven't been written yet
 	for (d = _gameDomains.begin(); d != _gameDomains.end(); ++d) {
 		if (find(_domainSaveOrder.begin(), _domainSaveOrder.end(), d->_key) == _domainSaveOrder.end())
-			writeDomain(*stream, d->_key, d->_value);
+			writeDomain(config, d->_key, d->_value);
 	}
 
-	delete stream;
+	// The previous flush must be complete before the file is opened again
+	waitForFlush();
+
+	// Don't write the file again if nothing changed
+	if (!_flushedConfig.empty() && _flushedConfig.size() == config.size() &&
+	    memcmp(_flushedConfig.data(), config.getData(), config.size()) == 0)
+		return;
+
+	WriteStream *stream;
+
+	if (_filename.empty()) {
+		// Write to the default config file
+		assert(g_system);
+		stream = g_system->createConfigWriteStream();
+		if (!stream)    // If writing to the config file is not possible, do nothing
+			return;
+	} else {
+		stream = FSNode(_filename).createWriteStream();
+		if (!stream) {
+			warning("Unable to write configuration file: %s", _filename.toString(Common::Path::kNativeSeparator).c_str());
+			return;
+		}
+	}
+
+	_flushedConfig.resize(config.size());
+	if (config.size())
+		memcpy(_flushedConfig.data(), config.getData(), config.size());
+
+	// Write the file in the background. The stream is finished and deleted
+	// by the job, so that its data is not left half written. The job system
+	// does not exist yet when the configuration is first loaded.
+	_flushStream = stream;
+	JobSystem *jobSystem = g_system->getJobSystem();
+	if (!jobSystem) {
+		writeConfigProc(this);
+		waitForFlush();
+		return;
+	}
+
+	_flushGroup.reset(new JobGroup());
+	jobSystem->submit(writeConfigProc, this, _flushGroup.get());
 
 #endif // !__DC__
 }
 
+void ConfigManager::writeConfigProc(void *refCon) {
+	ConfigManager *configManager = (ConfigManager *)refCon;
+	WriteStream *stream = configManager->_flushStream;
+
+	stream->write(configManager->_flushedConfig.data(), configManager->_flushedConfig.size());
+	configManager->_flushFailed = !stream->flush() || stream->err();
+	delete stream;
+	configManager->_flushStream = nullptr;
+}
+
+void ConfigManager::waitForFlush() {
+	if (_flushGroup) {
+		assert(g_system);
+		g_system->getJobSystem()->wait(*_flushGroup);
+		_flushGroup.reset();
+	}
+
+	if (_flushFailed) {
+		warning("Unable to write configuration file");
+		_flushFailed = false;
+		_flushedConfig.clear();
+	}
+}
+
 void ConfigManager::writeDomain(WriteStream &stream, const String &name, const Domain &domain) {
 	if (domain.empty())
 		return; // Don't bother writing empty domains.
 
 	// WORKAROUND: Fix for bug #3746 "ALL: On-the-fly targets are
 	// written to the config file": Do not save domains that came from
-	// the command line
-	if (domain.contains("id_came_from_command_line"))
+	// the command line. Domains which were never parsed don't have that key.
+	if (domain._unparsed.empty() && domain.contains("id_came_from_command_line"))
 		return;
 
 	String comment;
@@ -367,6 +467,15 @@ void ConfigManager::writeDomain(WriteStream &stream, const String &name, const D
 	stream.writeByte(']');
 	stream.writeByte('\n');
 
+	// Domains which were not used since they were loaded are written as they were read
+	if (!domain._unparsed.empty()) {
+		stream.writeString(domain._unparsed);
+		if (domain._unparsed.lastChar() != '\n')
+			stream.writeByte('\n');
+		stream.writeByte('\n');
+		return;
+	}
+
 	// Write all key/value pairs in this domain, including comments
 	Domain::const_iterator x;
 	for (x = domain.begin(); x != domain.end(); ++x) {
@@ -818,13 +927,69 @@ const String &ConfigManager::Domain::getDomainComment() const {
 }
 
 void ConfigManager::Domain::setKVComment(const String &key, const String &comment) {
+	ensureParsed();
 	_keyValueComments[key] = comment;
 }
 const String &ConfigManager::Domain::getKVComment(const String &key) const {
+	ensureParsed();
 	return _keyValueComments[key];
 }
 bool ConfigManager::Domain::hasKVComment(const String &key) const {
+	ensureParsed();
 	return _keyValueComments.contains(key);
 }
 
+void ConfigManager::Domain::setLines(const char *begin, const char *end, bool canonical) {
+	if (begin == end)
+		return;
+
+	_unparsed = String(begin, end);
+
+	// Line ends are only kept as written by writeDomain()
+	if (!canonical || memchr(begin, '\r', end - begin))
+		parse();
+}
+
+void ConfigManager::Domain::parse() {
+	// The lines have been checked by loadFromStream() already
+	String comment;
+	const char *end = _unparsed.c_str() + _unparsed.size();
+	const char *next;
+	for (const char *line = _unparsed.c_str(); line < end; line = next) {
+		const char *lineEnd = findLineEnd(line, end, next);
+
+		if (line == lineEnd)
+			continue;
+
+		if (*line == '#') {
+			comment += String(line, lineEnd);
+			comment += "\n";
+			continue;
+		}
+
+		const char *t = line;
+		while (t < lineEnd && isSpace(*t))
+			t++;
+		if (t == lineEnd)
+			continue;
+
+		const char *p = (const char *)memchr(t, '=', lineEnd - t);
+		assert(p);
+
+		// Extract the key/value pair
+		String key(t, p);
+		String value(p + 1, lineEnd);
+
+		// Trim of spaces
+		key.trim();
+		value.trim();
+
+		_entries.setVal(key, value);
+		_keyValueComments.setVal(key, comment);
+		comment.clear();
+	}
+
+	_unparsed.clear();
+}
+
 } // End of namespace Common
@@ -25,6 +25,7 @@
 #include "common/array.h"
 #include "common/hashmap.h"
 #include "common/path.h"
+#include "common/ptr.h"
 #include "common/singleton.h"
 #include "common/str.h"
 #include "common/hash-str.h"
@@ -41,6 +42,7 @@ namespace Common {
  * @{
  */
 
+class JobGroup;
 class WriteStream;
 class SeekableReadStream;
 
@@ -58,18 +60,32 @@ public:
 
 	class Domain {
 	private:
+		friend class ConfigManager;
+
 		StringMap _entries;
 		StringMap _keyValueComments;
 		String _domainComment;
 
+		/**
+		 * The lines of the domain in the configuration file, until they are
+		 * first needed. Only domains which hold at least one key/value pair,
+		 * all in the form written by flushToDisk(), are kept that way, so
+		 * that they can be written back unchanged.
+		 */
+		String _unparsed;
+
+		void ensureParsed() const { if (!_unparsed.empty()) const_cast<Domain *>(this)->parse(); }
+		void parse();
+		void setLines(const char *begin, const char *end, bool canonical);
+
 	public:
 		typedef StringMap::const_iterator const_iterator;
-		const_iterator begin() const { return _entries.begin(); } /*!< Return the beginning position of configuration entries. */
-		const_iterator end()   const { return _entries.end(); }   /*!< Return the ending position of configuration entries. */
+		const_iterator begin() const { ensureParsed(); return _entries.begin(); } /*!< Return the beginning position of configuration entries. */
+		const_iterator end()   const { ensureParsed(); return _entries.end(); }   /*!< Return the ending position of configuration entries. */
 
-		bool           empty() const { return _entries.empty(); } /*!< Return true if the configuration is empty, i.e. has no [key, value] pairs, and false otherwise. */
+		bool           empty() const { return _entries.empty() && _unparsed.empty(); } /*!< Return true if the configuration is empty, i.e. has no [key, value] pairs, and false otherwise. */
 
-		bool           contains(const String &key) const { return _entries.contains(key); } /*!< Check whether the domain contains a @p key. */
+		bool           contains(const String &key) const { ensureParsed(); return _entries.contains(key); } /*!< Check whether the domain contains a @p key. */
 		/** Return the configuration value for the given key.
 		 *  If no entry exists for the given key in the configuration, it is created.
 		 */
@@ -77,24 +93,24 @@ public:
 		 *  @note This function does *not* create a configuration entry
 		 *  for the given key if it does not exist.
 		 */
-		const String &operator[](const String &key) const { return _entries[key]; }
+		const String &operator[](const String &key) const { ensureParsed(); return _entries[key]; }
 
-		void           setVal(const String &key, const String &value) { _entries.setVal(key, value); } /*!< Assign a @p value to a @p key. */
+		void           setVal(const String &key, const String &value) { ensureParsed(); _entries.setVal(key, value); } /*!< Assign a @p value to a @p key. */
 
-		String &getOrCreateVal(const String &key) { return _entries.getOrCreateVal(key); }
-		String        &getVal(const String &key) { return _entries.getVal(key); } /*!< Retrieve the value of a @p key. */
-		const String  &getVal(const String &key) const { return _entries.getVal(key); } /*!< @overload */
+		String &getOrCreateVal(const String &key) { ensureParsed(); return _entries.getOrCreateVal(key); }
+		String        &getVal(const String &key) { ensureParsed(); return _entries.getVal(key); } /*!< Retrieve the value of a @p key. */
+		const String  &getVal(const String &key) const { ensureParsed(); return _entries.getVal(key); } /*!< @overload */
 		 /**
 		  * Retrieve the value of @p key if it exists and leave the referenced variable unchanged if the key does not exist.
 		  * @return True if the key exists, false otherwise.
 		  * You can use this method if you frequently attempt to access keys that do not exist.
 		  */
-		const String &getValOrDefault(const String &key) const { return _entries.getValOrDefault(key); }
-		bool tryGetVal(const String &key, String &out) const { return _entries.tryGetVal(key, out); }
+		const String &getValOrDefault(const String &key) const { ensureParsed(); return _entries.getValOrDefault(key); }
+		bool tryGetVal(const String &key, String &out) const { ensureParsed(); return _entries.tryGetVal(key, out); }
 
-		void           clear() { _entries.clear(); } /*!< Clear all configuration entries in the domain. */
+		void           clear() { _entries.clear(); _unparsed.clear(); } /*!< Clear all configuration entries in the domain. */
 
-		void           erase(const String &key) { _entries.erase(key); } /*!< Remove a key from the domain. */
+		void           erase(const String &key) { ensureParsed(); _entries.erase(key); } /*!< Remove a key from the domain. */
 
 		void           setDomainComment(const String &comment); /*!< Add a @p comment for this configuration domain. */
 		const String  &getDomainComment() const; /*!< Retrieve the comment of this configuration domain. */
@@ -200,7 +216,8 @@ public:
 	void                     registerDefault(const String &key, bool value); /*!< @overload */
 	void                     registerDefault(const String &key, const Path &value); /*!< @overload */
 
-	void                     flushToDisk(); /*!< Flush configuration to disk. */
+	void                     flushToDisk(); /*!< Flush configuration to disk. The file is written in the background. */
+	void                     waitForFlush(); /*!< Wait until the file written by the last flushToDisk() is complete. */
 
 	void                     setActiveDomain(const String &domName); /*!< Set the given domain as active. */
 	Domain                  *getActiveDomain() { return _activeDomain; } /*!< Get the active domain. */
@@ -232,11 +249,13 @@ public:
 private:
 	friend class Singleton<SingletonBaseType>;
 	ConfigManager();
+	~ConfigManager();
 
 	bool			loadFallbackConfigFile(const Path &filename);
 	bool			loadFromStream(SeekableReadStream &stream);
-	void			addDomain(const String &domainName, const Domain &domain);
+	void			addDomain(const String &domainName, const Domain &domain, bool isGameDomain);
 	void			writeDomain(WriteStream &stream, const String &name, const Domain &domain);
+	static void		writeConfigProc(void *refCon);
 	void			renameDomain(const String &oldName, const String &newName, DomainMap &map);
 
 	Domain			_transientDomain;
@@ -259,6 +278,16 @@ private:
 	Domain *		_activeDomain;
 
 	Path			_filename;
+
+	/**
+	 * The configuration file is written by a job. The contents of the last
+	 * flush are kept, so that flushing an unchanged configuration does not
+	 * write the file again.
+	 */
+	Array<byte>		_flushedConfig;
+	WriteStream *	_flushStream;
+	bool			_flushFailed;
+	ScopedPtr<JobGroup>	_flushGroup;
 };
 
 /** @} */
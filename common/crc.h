@@ -38,6 +38,11 @@
 #define COMMON_CRC_H
 
 #include "common/system.h" // For types.
+#include "common/endian.h"
+
+#ifdef __ARM_FEATURE_CRC32
+#include <arm_acle.h>
+#endif
 
 namespace Common {
 
@@ -58,6 +63,10 @@ private:
   	T _crcTable[256];
 };
 
+/**
+ * CRC with reflected input and output. T must not be wider than 32 bits, as
+ * messages are processed four bytes at a time.
+ */
 template <typename T>
 class CRCReflected {
 public:
@@ -69,7 +78,8 @@ public:
 	T finalize(T remainder) const { return remainder ^ _final_xor; }
 
 private:
-  	T _crcTable[256];
+	/** _crcTable[n][b] is the remainder of byte b followed by n zero bytes */
+	T _crcTable[4][256];
 	const T _reflected_init_remainder;
 	const T _final_xor;
 };
@@ -137,8 +147,18 @@ CRCReflected<T>::CRCReflected(T reflected_poly, T reflected_init_remainder, T fi
 		/*
 		 * Store the result into the table.
 		 */
-		_crcTable[dividend] = remainder;
-	}	
+		_crcTable[0][dividend] = remainder;
+	}
+
+	/*
+	 * Each further zero byte divides the remainder once more.
+	 */
+	for (int n = 1; n < 4; ++n) {
+		for (int dividend = 0; dividend < 256; ++dividend) {
+			T remainder = _crcTable[n - 1][dividend];
+			_crcTable[n][dividend] = _crcTable[0][remainder & 0xFF] ^ (remainder >> 8);
+		}
+	}
 }
 
 /*********************************************************************
@@ -184,13 +204,24 @@ T CRCNormal<T>::crcFast(byte const message[], int nBytes) const {
 template<typename T>
 T CRCReflected<T>::crcFast(byte const message[], int nBytes) const {
 	T remainder = _reflected_init_remainder;
+	int b = 0;
 
 	/*
-	 * Divide the message by the polynomial, a byte at a time.
+	 * Divide the message by the polynomial, four bytes at a time. The
+	 * remainder is entirely shifted out by the four bytes.
 	 */
-	for (int b = 0; b < nBytes; ++b) {
+	for (; b + 4 <= nBytes; b += 4) {
+		uint32 data = READ_LE_UINT32(message + b) ^ remainder;
+		remainder = _crcTable[3][data & 0xFF] ^ _crcTable[2][(data >> 8) & 0xFF] ^
+		            _crcTable[1][(data >> 16) & 0xFF] ^ _crcTable[0][data >> 24];
+	}
+
+	/*
+	 * Then a byte at a time.
+	 */
+	for (; b < nBytes; ++b) {
 		byte data = message[b] ^ remainder;
-		remainder = _crcTable[data] ^ (remainder >> 8);
+		remainder = _crcTable[0][data] ^ (remainder >> 8);
 	}
 
 	/*
@@ -210,7 +241,7 @@ template<typename T>
 T CRCReflected<T>::processByte(byte byteVal, T remainder) const {
 	byte data = byteVal ^ remainder;
 
-	return _crcTable[data] ^ (remainder >> 8);
+	return _crcTable[0][data] ^ (remainder >> 8);
 }
 
 class CRC_CCITT : public CRCNormal<uint16> {
@@ -231,6 +262,21 @@ public:
 class CRC32 : public CRCReflected<uint32> {
 public:
 	CRC32() : CRCReflected<uint32>(0xEDB88320, 0xFFFFFFFF, 0xFFFFFFFF) {}
+
+#ifdef __ARM_FEATURE_CRC32
+	/** Compute the CRC of a given message with the CRC32 instructions of ARMv8. */
+	uint32 crcFast(byte const message[], int nBytes) const {
+		uint32 remainder = getInitRemainder();
+		int b = 0;
+
+		for (; b + 8 <= nBytes; b += 8)
+			remainder = __crc32d(remainder, READ_LE_UINT64(message + b));
+		for (; b < nBytes; ++b)
+			remainder = __crc32b(remainder, message[b]);
+
+		return finalize(remainder);
+	}
+#endif
 };
 
 } // End of namespace Common
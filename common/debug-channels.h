@@ -172,6 +172,9 @@ private:
 	EnabledChannelsMap _debugChannelsEnabled;
 	uint32 _globalChannelsMask;
 
+	/** Recompute gDebugChannelFilter from the enabled channels. */
+	void updateChannelFilter();
+
 	friend class Singleton<SingletonBaseType>;
 
 	DebugManager();
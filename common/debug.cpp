@@ -30,6 +30,7 @@
 // TODO: Move gDebugLevel into namespace Common.
 int gDebugLevel = -1;
 bool gDebugChannelsOnly = false;
+uint64 gDebugChannelFilter = 0;
 
 const DebugChannelDef gDebugChannels[] = {
 	{ kDebugLevelEventRec,   "eventrec",  "Event recorder debug level" },
@@ -100,6 +101,8 @@ void DebugManager::removeAllDebugChannels() {
 	for (DebugChannelMap::iterator i = _debugChannels.begin(); i != _debugChannels.end(); ++i)
 		if (oldMap.contains(i->_value.channel))
 			_debugChannelsEnabled[i->_value.channel] = oldMap[i->_value.channel];
+
+	updateChannelFilter();
 }
 
 bool DebugManager::enableDebugChannel(const String &name) {
@@ -107,6 +110,7 @@ bool DebugManager::enableDebugChannel(const String &name) {
 
 	if (i != _debugChannels.end()) {
 		_debugChannelsEnabled[i->_value.channel] = true;
+		updateChannelFilter();
 
 		return true;
 	} else {
@@ -116,6 +120,7 @@ bool DebugManager::enableDebugChannel(const String &name) {
 
 bool DebugManager::enableDebugChannel(uint32 channel) {
 	_debugChannelsEnabled[channel] = true;
+	updateChannelFilter();
 	return true;
 }
 
@@ -124,6 +129,7 @@ bool DebugManager::disableDebugChannel(const String &name) {
 
 	if (i != _debugChannels.end()) {
 		_debugChannelsEnabled[i->_value.channel] = false;
+		updateChannelFilter();
 
 		return true;
 	} else {
@@ -133,6 +139,7 @@ bool DebugManager::disableDebugChannel(const String &name) {
 
 bool DebugManager::disableDebugChannel(uint32 channel) {
 	_debugChannelsEnabled[channel] = false;
+	updateChannelFilter();
 	return true;
 }
 
@@ -163,6 +170,13 @@ bool DebugManager::isDebugChannelEnabled(uint32 channel, bool enforce) {
 		return (_debugChannelsEnabled.contains(channel) && _debugChannelsEnabled[channel] == true);
 }
 
+void DebugManager::updateChannelFilter() {
+	gDebugChannelFilter = 0;
+	for (EnabledChannelsMap::const_iterator i = _debugChannelsEnabled.begin(); i != _debugChannelsEnabled.end(); ++i)
+		if (i->_value)
+			gDebugChannelFilter |= (uint64)1 << (i->_key & 63);
+}
+
 void DebugManager::addDebugChannels(const DebugChannelDef *channels) {
 	int added = 0;
 	for (uint i = 0; channels[i].channel != 0; ++i) {
@@ -157,6 +157,101 @@ extern int gDebugLevel;
  */
 extern bool gDebugChannelsOnly;
 
+/**
+ * Filter of the enabled debug channels, with bit (channel % 64) set if an
+ * enabled channel maps to it. This lets the DEBUG_C macros rule out disabled
+ * channels without a call. It is maintained by DebugManager.
+ */
+extern uint64 gDebugChannelFilter;
+
+#ifndef SCUMMVM_MAX_DEBUG_LEVEL
+/**
+ * Messages of the DEBUG_C macros above this level are compiled out. It is set
+ * with the --with-max-debug-level configure option.
+ */
+#define SCUMMVM_MAX_DEBUG_LEVEL 0x7FFFFFFF
+#endif
+
+/**
+ * Check whether a debugC(level, debugChannel, ...) message would be printed.
+ * Unlike debugChannelSet, the common case of debugging being off is checked
+ * inline.
+ */
+inline bool debugChannelActive(int level, uint32 debugChannel) {
+	// Debug level 11 turns on all special debug level messages
+	if (gDebugLevel == 11)
+		return true;
+	if (level > gDebugLevel || !(gDebugChannelFilter & ((uint64)1 << (debugChannel & 63))))
+		return false;
+	return debugChannelSet(level, debugChannel);
+}
+
+/**
+ * Check whether a debugC(debugChannel, ...) message would be printed.
+ */
+inline bool debugChannelActive(uint32 debugChannel) {
+	if (gDebugLevel == 11)
+		return true;
+	if (!(gDebugChannelFilter & ((uint64)1 << (debugChannel & 63))))
+		return false;
+	return debugChannelSet(-1, debugChannel);
+}
+
+/**
+ * @name Debug macros
+ *
+ * These print the same messages as the debugC and debugCN functions, but
+ * only evaluate the message arguments if the message is printed. Use them
+ * where building the arguments is costly, e.g. in script interpreter loops.
+ * The level and channel may be evaluated more than once.
+ *
+ * Messages above SCUMMVM_MAX_DEBUG_LEVEL and all messages of builds without
+ * a text console are compiled out.
+ * @{
+ */
+
+#ifdef DISABLE_TEXT_CONSOLE
+
+// Still compile the messages, so that their arguments don't become unused
+#define DEBUG_C(level, debugChannel, ...) do { if (0) debugC(level, debugChannel, __VA_ARGS__); } while (0)
+#define DEBUG_CN(level, debugChannel, ...) do { if (0) debugCN(level, debugChannel, __VA_ARGS__); } while (0)
+#define DEBUG_C_CHANNEL(debugChannel, ...) do { if (0) debugC(debugChannel, __VA_ARGS__); } while (0)
+#define DEBUG_CN_CHANNEL(debugChannel, ...) do { if (0) debugCN(debugChannel, __VA_ARGS__); } while (0)
+
+#else
+
+/** Like debugC(level, debugChannel, ...). */
+#define DEBUG_C(level, debugChannel, ...) \
+	do { \
+		if ((level) <= SCUMMVM_MAX_DEBUG_LEVEL && debugChannelActive((level), (debugChannel))) \
+			debugC((level), (debugChannel), __VA_ARGS__); \
+	} while (0)
+
+/** Like debugCN(level, debugChannel, ...). */
+#define DEBUG_CN(level, debugChannel, ...) \
+	do { \
+		if ((level) <= SCUMMVM_MAX_DEBUG_LEVEL && debugChannelActive((level), (debugChannel))) \
+			debugCN((level), (debugChannel), __VA_ARGS__); \
+	} while (0)
+
+/** Like debugC(debugChannel, ...). */
+#define DEBUG_C_CHANNEL(debugChannel, ...) \
+	do { \
+		if (debugChannelActive((uint32)(debugChannel))) \
+			debugC((uint32)(debugChannel), __VA_ARGS__); \
+	} while (0)
+
+/** Like debugCN(debugChannel, ...). */
+#define DEBUG_CN_CHANNEL(debugChannel, ...) \
+	do { \
+		if (debugChannelActive((uint32)(debugChannel))) \
+			debugCN((uint32)(debugChannel), __VA_ARGS__); \
+	} while (0)
+
+#endif
+
+/** @} */
+
 /** Global constant for EventRecorder debug channel. */
 enum GlobalDebugLevels {
 	kDebugGlobalDetection = 100000,
@@ -583,6 +583,56 @@ inline void WRITE_BE_UINT24(void *ptr, uint32 value) {
 #define WRITE_UINT24(a,b) WRITE_BE_UINT24(a,b)
 #endif
 
+/** @name  Functions for swapping the bytes of integer arrays in place
+ *  @brief The loops are simple enough for compilers to vectorize them.
+ * @{
+ */
+
+inline void SWAP_BYTES_ARRAY(uint8 *, uint32) {
+}
+
+inline void SWAP_BYTES_ARRAY(uint16 *data, uint32 count) {
+	for (uint32 i = 0; i < count; i++)
+		data[i] = SWAP_BYTES_16(data[i]);
+}
+
+inline void SWAP_BYTES_ARRAY(uint32 *data, uint32 count) {
+	for (uint32 i = 0; i < count; i++)
+		data[i] = SWAP_BYTES_32(data[i]);
+}
+
+inline void SWAP_BYTES_ARRAY(uint64 *data, uint32 count) {
+	for (uint32 i = 0; i < count; i++)
+		data[i] = SWAP_BYTES_64(data[i]);
+}
+
+inline void SWAP_BYTES_ARRAY(int8 *, uint32) {
+}
+
+inline void SWAP_BYTES_ARRAY(int16 *data, uint32 count) {
+	SWAP_BYTES_ARRAY((uint16 *)data, count);
+}
+
+inline void SWAP_BYTES_ARRAY(int32 *data, uint32 count) {
+	SWAP_BYTES_ARRAY((uint32 *)data, count);
+}
+
+inline void SWAP_BYTES_ARRAY(int64 *data, uint32 count) {
+	SWAP_BYTES_ARRAY((uint64 *)data, count);
+}
+
+#if defined(SCUMM_LITTLE_ENDIAN)
+	#define FROM_LE_ARRAY(a, n) ((void)0)
+	#define FROM_BE_ARRAY(a, n) SWAP_BYTES_ARRAY(a, n)
+#else
+	#define FROM_LE_ARRAY(a, n) SWAP_BYTES_ARRAY(a, n)
+	#define FROM_BE_ARRAY(a, n) ((void)0)
+#endif
+
+#define TO_LE_ARRAY(a, n) FROM_LE_ARRAY(a, n)
+#define TO_BE_ARRAY(a, n) FROM_BE_ARRAY(a, n)
+/** @} */
+
 union SwapFloat {
 	float f;
 	uint32 u32;
@@ -239,7 +239,13 @@ struct Event {
 	 */
 	JoystickState joystick;
 
-	Event() : type(EVENT_INVALID), kbdRepeat(false), customType(0) {
+	/**
+	 * The time the event was received, as returned by OSystem::getMillis().
+	 * This is 0 for events which were not queued by the event manager yet.
+	 */
+	uint32 timestamp;
+
+	Event() : type(EVENT_INVALID), kbdRepeat(false), customType(0), timestamp(0) {
 	}
 };
 
@@ -0,0 +1,662 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// The flat hash map implementation in this file follows the design of the
+// "Swiss tables" of Abseil.
+
+#ifndef COMMON_FLATHASHMAP_H
+#define COMMON_FLATHASHMAP_H
+
+#include "common/endian.h"
+#include "common/hashmap.h"
+#include "common/intrinsics.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COMMON_FLATHASHMAP_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Common {
+
+/**
+ * @defgroup common_flathashmap Flat hash table (FlatHashMap)
+ * @ingroup common
+ *
+ * @brief API for operations on a hash table storing its entries inline.
+ *
+ * @{
+ */
+
+/**
+ * A group of control bytes of a FlatHashMap, which are all matched at once.
+ *
+ * Each slot of the map has one control byte. It is either kEmpty, kDeleted
+ * or the low 7 bits of the hash of the key stored in the slot. The match
+ * functions return a mask with bit i set if the control byte i matches.
+ */
+struct FlatHashMapGroup {
+	enum {
+		kEmpty = -128,
+		kDeleted = -2
+	};
+
+#ifdef COMMON_FLATHASHMAP_SSE2
+	enum {
+		kWidth = 16
+	};
+
+	explicit FlatHashMapGroup(const int8 *ctrl) : _ctrl(_mm_loadu_si128((const __m128i *)ctrl)) {}
+
+	uint32 match(int8 h2) const { return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), _ctrl)); }
+	uint32 matchEmpty() const { return match(kEmpty); }
+	/** Match empty and deleted slots, which are the only ones with the sign bit set. */
+	uint32 matchFree() const { return _mm_movemask_epi8(_ctrl); }
+
+private:
+	__m128i _ctrl;
+#else
+	enum {
+		kWidth = 8
+	};
+
+	explicit FlatHashMapGroup(const int8 *ctrl) : _ctrl(READ_LE_UINT64(ctrl)) {}
+
+	/**
+	 * May also report full slots right after a matching one, which is fine
+	 * as the keys are compared anyway.
+	 */
+	uint32 match(int8 h2) const {
+		const uint64 x = _ctrl ^ (kLsbs * (uint8)h2);
+		return compress((x - kLsbs) & ~x & kMsbs);
+	}
+
+	/** Bit 1 tells kEmpty apart from kDeleted. */
+	uint32 matchEmpty() const { return compress(_ctrl & ~(_ctrl << 6) & kMsbs); }
+	uint32 matchFree() const { return compress(_ctrl & kMsbs); }
+
+private:
+	static const uint64 kLsbs = 0x0101010101010101ULL;
+	static const uint64 kMsbs = 0x8080808080808080ULL;
+
+	/** Gather the top bit of every byte into the low 8 bits. */
+	static uint32 compress(uint64 mask) { return (uint32)(((mask >> 7) * 0x0102040810204080ULL) >> 56); }
+
+	uint64 _ctrl;
+#endif
+};
+
+/**
+ * FlatHashMap<Key,Val> maps objects of type Key to objects of type Val,
+ * just like HashMap and with the same interface, so that the two can be
+ * exchanged freely.
+ *
+ * Instead of allocating a node for every entry, the entries are stored
+ * inline in an open addressed table. A separate array of one control byte
+ * per entry lets a lookup check a whole group of entries at once for a
+ * matching hash, so only entries which most likely hold the key are ever
+ * touched. This saves most key comparisons and allows a load factor of 7/8,
+ * which pays off most for keys like strings. For integer keys, HashMap is
+ * often just as fast, so measure before switching.
+ *
+ * In exchange, growing the map moves the entries, so references to keys and
+ * values are only valid until the next insertion. Erasing never moves
+ * entries, so iterators other than the erased one remain valid.
+ */
+template<class Key, class Val, class HashFunc = Hash<Key>, class EqualFunc = EqualTo<Key> >
+class FlatHashMap {
+public:
+	typedef uint size_type;
+
+	struct Node {
+		Val _value;
+		const Key _key;
+		explicit Node(const Key &key) : _value(), _key(key) {}
+	};
+
+private:
+	typedef FlatHashMap<Key, Val, HashFunc, EqualFunc> FHM_t;
+	typedef FlatHashMapGroup Group;
+
+	enum {
+		FLATHASHMAP_MIN_CAPACITY = 16
+	};
+
+	STATIC_ASSERT((int)FLATHASHMAP_MIN_CAPACITY >= (int)Group::kWidth, FlatHashMap_capacity_must_cover_a_group);
+
+	static const size_type kNotFound = (size_type)-1;
+
+	/** Default value, returned by the const getVal. */
+	Val _defaultVal;
+
+	/**
+	 * The control bytes. The first Group::kWidth are repeated at the end,
+	 * so that a group can be loaded from any slot without wrapping around.
+	 */
+	int8 *_ctrl;
+	Node *_slots;       ///< Uninitialized storage for the entries.
+	size_type _mask;    ///< Capacity of the FlatHashMap minus one; the capacity is a power of two.
+	size_type _size;
+	size_type _growthLeft; ///< Number of empty slots which can be used before rehashing.
+
+	HashFunc _hash;
+	EqualFunc _equal;
+
+	/**
+	 * Mix the bits of the hash. The hash functors for integers return the
+	 * value unchanged, which would leave both the position and the control
+	 * byte depending on the low bits only.
+	 */
+	static uint mixHash(uint hash) {
+		return (uint)(((uint64)hash * 0x9E3779B97F4A7C15ULL) >> 32);
+	}
+
+	static int8 h2(uint hash) { return hash & 0x7F; }
+	static size_type maxLoad(size_type capacity) { return capacity - capacity / 8; }
+
+	bool isFull(size_type idx) const { return _ctrl[idx] >= 0; }
+
+	void setCtrl(size_type idx, int8 value) {
+		_ctrl[idx] = value;
+		if (idx < Group::kWidth)
+			_ctrl[_mask + 1 + idx] = value;
+	}
+
+	void allocStorage(size_type capacity) {
+		_mask = capacity - 1;
+		_ctrl = new int8[capacity + Group::kWidth];
+		memset(_ctrl, Group::kEmpty, capacity + Group::kWidth);
+		_slots = (Node *)malloc(capacity * sizeof(Node));
+		assert(_slots != nullptr);
+		_growthLeft = maxLoad(capacity);
+	}
+
+	void freeStorage() {
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (isFull(ctr))
+				_slots[ctr].~Node();
+		}
+		delete[] _ctrl;
+		free(_slots);
+	}
+
+	void assign(const FHM_t &map);
+	size_type lookup(const Key &key) const { return lookup(key, mixHash(_hash(key))); }
+	FORCEINLINE size_type lookup(const Key &key, uint hash) const;
+	size_type lookupAndCreateIfMissing(const Key &key);
+	size_type findFreeSlot(uint hash) const;
+	void resize(size_type newCapacity);
+	void eraseSlot(size_type idx);
+
+	/**
+	 * Simple FlatHashMap iterator implementation.
+	 */
+	template<class NodeType>
+	class IteratorImpl {
+		friend class FlatHashMap;
+		template<class T> friend class IteratorImpl;
+	protected:
+		typedef const FlatHashMap hashmap_t;
+
+		size_type _idx;
+		hashmap_t *_hashmap;
+
+	protected:
+		IteratorImpl(size_type idx, hashmap_t *hashmap) : _idx(idx), _hashmap(hashmap) {}
+
+		NodeType *deref() const {
+			assert(_hashmap != nullptr);
+			assert(_idx <= _hashmap->_mask);
+			assert(_hashmap->isFull(_idx));
+			return &_hashmap->_slots[_idx];
+		}
+
+	public:
+		IteratorImpl() : _idx(0), _hashmap(nullptr) {}
+		template<class T>
+		IteratorImpl(const IteratorImpl<T> &c) : _idx(c._idx), _hashmap(c._hashmap) {}
+
+		NodeType &operator*() const { return *deref(); }
+		NodeType *operator->() const { return deref(); }
+
+		bool operator==(const IteratorImpl &iter) const { return _idx == iter._idx && _hashmap == iter._hashmap; }
+		bool operator!=(const IteratorImpl &iter) const { return !(*this == iter); }
+
+		IteratorImpl &operator++() {
+			assert(_hashmap);
+			do {
+				_idx++;
+			} while (_idx <= _hashmap->_mask && !_hashmap->isFull(_idx));
+			if (_idx > _hashmap->_mask)
+				_idx = (size_type)-1;
+
+			return *this;
+		}
+
+		IteratorImpl operator++(int) {
+			IteratorImpl old = *this;
+			operator ++();
+			return old;
+		}
+	};
+
+public:
+	typedef IteratorImpl<Node> iterator;
+	typedef IteratorImpl<const Node> const_iterator;
+
+	FlatHashMap() : _defaultVal(), _size(0) {
+		allocStorage(FLATHASHMAP_MIN_CAPACITY);
+	}
+
+	FlatHashMap(const FHM_t &map) : _defaultVal() {
+		assign(map);
+	}
+
+	~FlatHashMap() {
+		freeStorage();
+	}
+
+	FHM_t &operator=(const FHM_t &map) {
+		if (this == &map)
+			return *this;
+
+		freeStorage();
+		assign(map);
+		return *this;
+	}
+
+	bool contains(const Key &key) const;
+
+	Val &operator[](const Key &key);
+	const Val &operator[](const Key &key) const;
+
+	Val &getOrCreateVal(const Key &key);
+	Val &getVal(const Key &key);
+	const Val &getVal(const Key &key) const;
+	const Val &getValOrDefault(const Key &key) const;
+	const Val &getValOrDefault(const Key &key, const Val &defaultVal) const;
+	bool tryGetVal(const Key &key, Val &out) const;
+	void setVal(const Key &key, const Val &val);
+
+	void clear(bool shrinkArray = 0);
+
+	/**
+	 * Make room for @p count entries, so that inserting them does not
+	 * rehash the map several times.
+	 */
+	void reserve(size_type count);
+
+	void erase(iterator entry);
+	void erase(const Key &key);
+
+	size_type size() const { return _size; }
+
+	iterator	begin() {
+		// Find and return the first non-empty entry
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (isFull(ctr))
+				return iterator(ctr, this);
+		}
+		return end();
+	}
+	iterator	end() {
+		return iterator((size_type)-1, this);
+	}
+
+	const_iterator	begin() const {
+		// Find and return the first non-empty entry
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (isFull(ctr))
+				return const_iterator(ctr, this);
+		}
+		return end();
+	}
+	const_iterator	end() const {
+		return const_iterator((size_type)-1, this);
+	}
+
+	iterator	find(const Key &key) {
+		return iterator(lookup(key), this);
+	}
+
+	const_iterator	find(const Key &key) const {
+		return const_iterator(lookup(key), this);
+	}
+
+	/** Return true if hashmap is empty. */
+	bool empty() const {
+		return (_size == 0);
+	}
+};
+
+//-------------------------------------------------------
+// FlatHashMap functions
+
+/**
+ * Internal method for assigning the content of another FlatHashMap
+ * to this one.
+ *
+ * @note The previous storage is *not* deallocated here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::assign(const FHM_t &map) {
+	allocStorage(map._mask + 1);
+
+	// The slots don't depend on anything but the hash, so they can be kept
+	memcpy(_ctrl, map._ctrl, _mask + 1 + Group::kWidth);
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isFull(ctr)) {
+			Node *node = new (&_slots[ctr]) Node(map._slots[ctr]._key);
+			node->_value = map._slots[ctr]._value;
+		}
+	}
+
+	_size = map._size;
+	_growthLeft = map._growthLeft;
+}
+
+/**
+ * Clear all values in the hashmap.
+ */
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::clear(bool shrinkArray) {
+	if (shrinkArray && _mask >= FLATHASHMAP_MIN_CAPACITY) {
+		freeStorage();
+		allocStorage(FLATHASHMAP_MIN_CAPACITY);
+	} else {
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (isFull(ctr))
+				_slots[ctr].~Node();
+		}
+		memset(_ctrl, Group::kEmpty, _mask + 1 + Group::kWidth);
+		_growthLeft = maxLoad(_mask + 1);
+	}
+
+	_size = 0;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::reserve(size_type count) {
+	size_type capacity = _mask + 1;
+	while (maxLoad(capacity) < count)
+		capacity *= 2;
+
+	if (capacity > _mask + 1)
+		resize(capacity);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::resize(size_type newCapacity) {
+	assert(maxLoad(newCapacity) > _size);
+
+	int8 *oldCtrl = _ctrl;
+	Node *oldSlots = _slots;
+	const size_type oldMask = _mask;
+
+	allocStorage(newCapacity);
+
+	// Rehash all the old elements. Since we know that no key exists twice
+	// in the old table, there is no need to call _equal().
+	for (size_type ctr = 0; ctr <= oldMask; ++ctr) {
+		if (oldCtrl[ctr] < 0)
+			continue;
+
+		Node &oldNode = oldSlots[ctr];
+		const uint hash = mixHash(_hash(oldNode._key));
+		const size_type idx = findFreeSlot(hash);
+		setCtrl(idx, h2(hash));
+
+		Node *node = new (&_slots[idx]) Node(oldNode._key);
+		node->_value = Common::move(oldNode._value);
+		oldNode.~Node();
+	}
+
+	_growthLeft -= _size;
+
+	delete[] oldCtrl;
+	free(oldSlots);
+}
+
+/**
+ * Return the index of the first empty or deleted slot on the probe
+ * sequence of @p hash.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::findFreeSlot(uint hash) const {
+	// Triangular probing visits every group once, as the number of groups
+	// is a power of two. There is always an empty slot thanks to the load
+	// factor, so this terminates.
+	size_type pos = (hash >> 7) & _mask;
+	for (size_type step = Group::kWidth; ; step += Group::kWidth) {
+		const uint32 mask = Group(_ctrl + pos).matchFree();
+		if (mask)
+			return (pos + countTrailingZeros(mask)) & _mask;
+
+		pos = (pos + step) & _mask;
+	}
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookup(const Key &key, uint hash) const {
+	const int8 ctrl = h2(hash);
+	size_type pos = (hash >> 7) & _mask;
+
+	for (size_type step = Group::kWidth; ; step += Group::kWidth) {
+		const Group group(_ctrl + pos);
+		for (uint32 mask = group.match(ctrl); mask; mask &= mask - 1) {
+			const size_type idx = (pos + countTrailingZeros(mask)) & _mask;
+			if (_equal(_slots[idx]._key, key))
+				return idx;
+		}
+
+		// An empty slot would have been used by the key, had it been inserted
+		if (group.matchEmpty())
+			return kNotFound;
+
+		pos = (pos + step) & _mask;
+	}
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookupAndCreateIfMissing(const Key &key) {
+	const uint hash = mixHash(_hash(key));
+	size_type idx = lookup(key, hash);
+	if (idx != kNotFound)
+		return idx;
+
+	idx = findFreeSlot(hash);
+
+	// Deleted slots can be reused without affecting the load factor
+	if (_ctrl[idx] == Group::kEmpty && _growthLeft == 0) {
+		// Grow, unless most of the load is made of deleted slots
+		const size_type capacity = _mask + 1;
+		resize(_size >= maxLoad(capacity) / 2 ? capacity * 2 : capacity);
+		idx = findFreeSlot(hash);
+	}
+
+	if (_ctrl[idx] == Group::kEmpty)
+		_growthLeft--;
+	setCtrl(idx, h2(hash));
+	new (&_slots[idx]) Node(key);
+	_size++;
+
+	return idx;
+}
+
+/**
+ * Check whether the hashmap contains the given key.
+ */
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::contains(const Key &key) const {
+	return lookup(key) != kNotFound;
+}
+
+/**
+ * Get a value from the hashmap.
+ */
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) {
+	return getOrCreateVal(key);
+}
+
+/**
+ * @overload
+ */
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) const {
+	return getVal(key);
+}
+
+/**
+ * Get a value from the hashmap.
+ */
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getOrCreateVal(const Key &key) {
+	// Insertion might reallocate the slots
+	const size_type ctr = lookupAndCreateIfMissing(key);
+	return _slots[ctr]._value;
+}
+
+/**
+ * @overload
+ */
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr != kNotFound)
+		return _slots[ctr]._value;
+	else
+		// See the comment in HashMap::getVal().
+#ifdef RELEASE_BUILD
+		return _defaultVal;
+#else
+		unknownKeyError(key);
+#endif
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) const {
+	size_type ctr = lookup(key);
+	if (ctr != kNotFound)
+		return _slots[ctr]._value;
+	else
+		// See the comment in HashMap::getVal().
+#ifdef RELEASE_BUILD
+		return _defaultVal;
+#else
+		unknownKeyError(key);
+#endif
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getValOrDefault(const Key &key) const {
+	return getValOrDefault(key, _defaultVal);
+}
+
+/**
+ * Get a value from the hashmap. If the key is not present, then return @p defaultVal.
+ */
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getValOrDefault(const Key &key, const Val &defaultVal) const {
+	size_type ctr = lookup(key);
+	if (ctr != kNotFound)
+		return _slots[ctr]._value;
+	else
+		return defaultVal;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::tryGetVal(const Key &key, Val &out) const {
+	size_type ctr = lookup(key);
+	if (ctr != kNotFound) {
+		out = _slots[ctr]._value;
+		return true;
+	} else {
+		return false;
+	}
+}
+
+/**
+ * Assign an element specified by @p key to a value @p val.
+ */
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::setVal(const Key &key, const Val &val) {
+	const size_type ctr = lookupAndCreateIfMissing(key);
+	_slots[ctr]._value = val;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::eraseSlot(size_type idx) {
+	assert(idx <= _mask);
+	assert(isFull(idx));
+
+	_slots[idx].~Node();
+	_size--;
+
+	// The slot can only be marked as empty again if no lookup ever went
+	// past it, i.e. if there is no window of a group width around it without
+	// an empty slot. Otherwise lookups need to continue past it.
+	const uint32 emptyAfter = Group(_ctrl + idx).matchEmpty();
+	const uint32 emptyBefore = Group(_ctrl + ((idx - Group::kWidth) & _mask)).matchEmpty();
+	if (emptyAfter && emptyBefore &&
+	        countTrailingZeros(emptyAfter) + countLeadingZeros(emptyBefore) - (32 - Group::kWidth) < Group::kWidth) {
+		setCtrl(idx, Group::kEmpty);
+		_growthLeft++;
+	} else {
+		setCtrl(idx, Group::kDeleted);
+	}
+}
+
+/**
+ * Erase an element referred to by an iterator.
+ */
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(iterator entry) {
+	// Check whether we have a valid iterator
+	assert(entry._hashmap == this);
+	eraseSlot(entry._idx);
+}
+
+/**
+ * Erase an element specified by a key.
+ */
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr != kNotFound)
+		eraseSlot(ctr);
+}
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -0,0 +1,622 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/formats/cdimage.h"
+#include "common/formats/cue.h"
+
+#include "common/archive.h"
+#include "common/debug.h"
+#include "common/endian.h"
+#include "common/fs.h"
+#include "common/hashmap.h"
+#include "common/path.h"
+#include "common/substream.h"
+#include "common/ustr.h"
+
+namespace Common {
+
+struct CDImage::ImageFile {
+	ImageFile(SeekableReadStream *s, DisposeAfterUse::Flag disposeAfterUse) : stream(s, disposeAfterUse) {}
+
+	DisposablePtr<SeekableReadStream> stream;
+	Mutex mutex;
+};
+
+struct CDImage::Track {
+	int number;
+	bool audio;
+	SharedPtr<ImageFile> file;
+	uint64 offset;		// Of the first sector in the file, in bytes
+	uint32 sectorSize;
+	int dataOffset;		// Of the user data in a sector, or -1 for unsupported data sectors
+	uint32 start;		// Of the track in the file, in sectors
+	uint32 length;		// In sectors
+};
+
+/**
+ * Stream of a part of an image file, which keeps the file open.
+ */
+class CDImage::TrackReadStream : public SafeMutexedSeekableSubReadStream {
+public:
+	TrackReadStream(const SharedPtr<ImageFile> &file, uint32 begin, uint32 end) :
+		SafeMutexedSeekableSubReadStream(file->stream.get(), begin, end, DisposeAfterUse::NO, file->mutex),
+		_file(file) {}
+
+private:
+	SharedPtr<ImageFile> _file;
+};
+
+namespace {
+
+// Offset of the user data in the sectors of a track, -1 if it has no usable data
+int getDataOffset(CueSheet::TrackType type) {
+	switch (type) {
+	case CueSheet::kTrackTypeMode1_2048:
+	case CueSheet::kTrackTypeMode2_2048:
+		return 0;
+	case CueSheet::kTrackTypeMode1_Raw:
+	case CueSheet::kTrackTypeMode1_2352:
+		return 16;
+	case CueSheet::kTrackTypeMode2_Raw:
+	case CueSheet::kTrackTypeMode2_2352:
+	case CueSheet::kTrackTypeCDI_2352:
+		return 24;
+	case CueSheet::kTrackTypeMode2_2366:
+	case CueSheet::kTrackTypeCDI_2336:
+		return 8;
+	default:
+		return -1;
+	}
+}
+
+} // End of anonymous namespace
+
+CDImage::CDImage() : _dataTrack(-1), _useCounter(0), _lastMiss(0xFFFFFFFF) {
+}
+
+CDImage::~CDImage() {
+	close();
+}
+
+bool CDImage::open(const FSNode &node) {
+	close();
+
+	if (node.getName().hasSuffixIgnoreCase(".cue"))
+		return openCue(node);
+
+	SeekableReadStream *stream = node.createReadStream();
+	if (!stream)
+		return false;
+
+	return open(stream);
+}
+
+bool CDImage::open(SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse) {
+	close();
+
+	if (!stream)
+		return false;
+
+	return addSingleTrack(SharedPtr<ImageFile>(new ImageFile(stream, disposeAfterUse)));
+}
+
+void CDImage::close() {
+	_tracks.clear();
+	_dataTrack = -1;
+
+	for (uint i = 0; i < _cache.size(); ++i)
+		free(_cache[i].data);
+	_cache.clear();
+	_useCounter = 0;
+	_lastMiss = 0xFFFFFFFF;
+	_rawBuffer.clear();
+}
+
+bool CDImage::addSingleTrack(const SharedPtr<ImageFile> &file) {
+	static const byte syncPattern[12] = { 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00 };
+
+	SeekableReadStream &stream = *file->stream;
+	const uint64 size = stream.size();
+
+	Track track;
+	track.number = 1;
+	track.audio = false;
+	track.file = file;
+	track.offset = 0;
+	track.start = 0;
+	track.sectorSize = kSectorSize;
+	track.dataOffset = 0;
+
+	// Raw images are told apart by the sync pattern of the first volume descriptor
+	byte header[16];
+	if (size % kRawSectorSize == 0 && size >= 17 * kRawSectorSize && stream.seek(16 * kRawSectorSize) &&
+		stream.read(header, sizeof(header)) == sizeof(header) && !memcmp(header, syncPattern, sizeof(syncPattern))) {
+		track.sectorSize = kRawSectorSize;
+		track.dataOffset = header[15] == 2 ? 24 : 16;
+	}
+
+	track.length = size / track.sectorSize;
+	if (track.length == 0)
+		return false;
+
+	_tracks.push_back(track);
+	_dataTrack = 0;
+	return true;
+}
+
+bool CDImage::openCue(const FSNode &node) {
+	ScopedPtr<SeekableReadStream> stream(node.createReadStream());
+	if (!stream)
+		return false;
+
+	CueSheet cue(stream.get());
+	const Array<CueSheet::CueTrack> cueTracks = cue.tracks();
+	const FSNode dir = node.getParent();
+
+	String fileName;
+	SharedPtr<ImageFile> file;
+
+	for (uint i = 0; i < cueTracks.size(); ++i) {
+		const CueSheet::CueTrack &cueTrack = cueTracks[i];
+		if (cueTrack.file.type != CueSheet::kFileTypeBinary) {
+			warning("CDImage: Track %d is not in a binary file", cueTrack.number);
+			continue;
+		}
+
+		if (cueTrack.indices.size() < 2 || cueTrack.indices[1] < 0) {
+			warning("CDImage: Track %d has no start", cueTrack.number);
+			continue;
+		}
+
+		if (!file || cueTrack.file.name != fileName) {
+			fileName = cueTrack.file.name;
+			SeekableReadStream *fileStream = dir.getChild(fileName).createReadStream();
+			if (!fileStream) {
+				warning("CDImage: Could not open '%s'", fileName.c_str());
+				close();
+				return false;
+			}
+			file.reset(new ImageFile(fileStream, DisposeAfterUse::YES));
+		}
+
+		Track track;
+		track.number = cueTrack.number;
+		track.audio = cueTrack.type == CueSheet::kTrackTypeAudio;
+		track.file = file;
+		track.sectorSize = cueTrack.size;
+		track.dataOffset = track.audio ? -1 : getDataOffset(cueTrack.type);
+		track.start = cueTrack.indices[1];
+		track.offset = (uint64)track.start * track.sectorSize;
+		track.length = 0;
+
+		// Tracks in the same file may have different sector sizes
+		if (!_tracks.empty() && _tracks.back().file == file) {
+			const Track &prev = _tracks.back();
+			track.offset = prev.offset + (uint64)(track.start - prev.start) * prev.sectorSize;
+		}
+
+		_tracks.push_back(track);
+	}
+
+	// A track ends where the pregap of the next one in its file starts,
+	// or at the end of the file
+	for (uint i = 0; i < _tracks.size(); ++i) {
+		Track &track = _tracks[i];
+		if (i + 1 < _tracks.size() && _tracks[i + 1].file == track.file) {
+			const CueSheet::CueTrack *next = cue.getTrack(_tracks[i + 1].number);
+			const uint32 nextStart = next->indices[0] >= 0 ? next->indices[0] : next->indices[1];
+			track.length = nextStart > track.start ? nextStart - track.start : 0;
+		} else {
+			const uint64 fileSize = track.file->stream->size();
+			track.length = fileSize > track.offset ? (fileSize - track.offset) / track.sectorSize : 0;
+		}
+
+		if (_dataTrack < 0 && !track.audio && track.dataOffset >= 0)
+			_dataTrack = i;
+	}
+
+	return !_tracks.empty();
+}
+
+uint32 CDImage::getDataSectorCount() const {
+	return _dataTrack >= 0 ? _tracks[_dataTrack].length : 0;
+}
+
+bool CDImage::readBlocks(uint32 index, uint32 count, byte *dst) {
+	const Track &track = _tracks[_dataTrack];
+	const uint32 first = index * kSectorsPerBlock;
+	const uint32 sectors = MIN<uint32>(count * kSectorsPerBlock, track.length - first);
+
+	// The last block can be short
+	memset(dst + sectors * kSectorSize, 0, (count * kSectorsPerBlock - sectors) * kSectorSize);
+
+	StackLock lock(track.file->mutex);
+	SeekableReadStream &stream = *track.file->stream;
+	if (!stream.seek(track.offset + (uint64)first * track.sectorSize))
+		return false;
+
+	if (track.sectorSize == kSectorSize)
+		return stream.read(dst, sectors * kSectorSize) == sectors * kSectorSize;
+
+	// Only copy the user data out of raw sectors
+	_rawBuffer.resize(sectors * track.sectorSize);
+	if (stream.read(_rawBuffer.data(), _rawBuffer.size()) != _rawBuffer.size())
+		return false;
+
+	for (uint32 i = 0; i < sectors; ++i)
+		memcpy(dst + i * kSectorSize, &_rawBuffer[i * track.sectorSize + track.dataOffset], kSectorSize);
+
+	return true;
+}
+
+const CDImage::CacheBlock *CDImage::getBlock(uint32 index) {
+	for (uint i = 0; i < _cache.size(); ++i) {
+		if (_cache[i].index == index) {
+			_cache[i].lastUse = ++_useCounter;
+			return &_cache[i];
+		}
+	}
+
+	// Read ahead when the previous miss was for the block before
+	const uint32 blockCount = (getDataSectorCount() + kSectorsPerBlock - 1) / kSectorsPerBlock;
+	uint32 count = index == _lastMiss + 1 ? (uint32)kReadAheadBlocks : 1;
+	count = MIN(count, blockCount - index);
+	for (uint32 i = 1; i < count; ++i) {
+		for (uint j = 0; j < _cache.size(); ++j) {
+			if (_cache[j].index == index + i)
+				count = i;
+		}
+	}
+	_lastMiss = index + count - 1;
+
+	byte *buffer = (byte *)malloc(count * kBlockSize);
+	if (!buffer || !readBlocks(index, count, buffer)) {
+		free(buffer);
+		return nullptr;
+	}
+
+	// Put the blocks in the least recently used slots
+	for (uint32 i = 0; i < count; ++i) {
+		CacheBlock *slot = nullptr;
+		if (_cache.size() < kCacheBlocks) {
+			CacheBlock newBlock;
+			newBlock.data = (byte *)malloc(kBlockSize);
+			if (newBlock.data) {
+				_cache.push_back(newBlock);
+				slot = &_cache.back();
+			}
+		}
+		if (!slot) {
+			slot = &_cache[0];
+			for (uint j = 1; j < _cache.size(); ++j) {
+				if (_cache[j].lastUse < slot->lastUse)
+					slot = &_cache[j];
+			}
+		}
+
+		slot->index = index + i;
+		slot->lastUse = i == 0 ? ++_useCounter : _useCounter;
+		memcpy(slot->data, buffer + i * kBlockSize, kBlockSize);
+	}
+
+	free(buffer);
+
+	// Adding slots may have moved the others, so look it up again
+	for (uint i = 0; i < _cache.size(); ++i) {
+		if (_cache[i].index == index)
+			return &_cache[i];
+	}
+
+	return nullptr;
+}
+
+uint32 CDImage::readData(uint64 offset, void *dst, uint32 size) {
+	if (_dataTrack < 0)
+		return 0;
+
+	const uint64 dataSize = (uint64)getDataSectorCount() * kSectorSize;
+	if (offset >= dataSize)
+		return 0;
+	size = MIN<uint64>(size, dataSize - offset);
+
+	StackLock lock(_cacheMutex);
+	byte *out = (byte *)dst;
+	uint32 total = 0;
+	while (total < size) {
+		const CacheBlock *block = getBlock((offset + total) / kBlockSize);
+		if (!block)
+			break;
+
+		const uint32 blockOffset = (offset + total) % kBlockSize;
+		const uint32 count = MIN<uint32>(size - total, kBlockSize - blockOffset);
+		memcpy(out + total, block->data + blockOffset, count);
+		total += count;
+	}
+
+	return total;
+}
+
+bool CDImage::hasAudioTrack(int track) const {
+	for (uint i = 0; i < _tracks.size(); ++i) {
+		if (_tracks[i].number == track)
+			return _tracks[i].audio;
+	}
+
+	return false;
+}
+
+SeekableReadStream *CDImage::createAudioTrackStream(int track) const {
+	for (uint i = 0; i < _tracks.size(); ++i) {
+		const Track &t = _tracks[i];
+		if (t.number == track && t.audio)
+			return new TrackReadStream(t.file, (uint32)t.offset, (uint32)(t.offset + (uint64)t.length * t.sectorSize));
+	}
+
+	return nullptr;
+}
+
+namespace {
+
+class ISO9660FileStream : public SeekableReadStream {
+public:
+	ISO9660FileStream(const SharedPtr<CDImage> &image, uint64 start, uint32 size) :
+		_image(image), _start(start), _size(size), _pos(0), _eos(false), _err(false) {}
+
+	bool err() const override { return _err; }
+	void clearErr() override { _eos = false; _err = false; }
+	bool eos() const override { return _eos; }
+	int64 pos() const override { return _pos; }
+	int64 size() const override { return _size; }
+
+	bool seek(int64 offset, int whence = SEEK_SET) override {
+		if (whence == SEEK_CUR)
+			offset += _pos;
+		else if (whence == SEEK_END)
+			offset += _size;
+
+		if (offset < 0 || offset > _size)
+			return false;
+
+		_pos = offset;
+		_eos = false;
+		return true;
+	}
+
+	uint32 read(void *dataPtr, uint32 dataSize) override {
+		if (dataSize > _size - _pos) {
+			dataSize = _size - _pos;
+			_eos = true;
+		}
+
+		const uint32 count = _image->readData(_start + _pos, dataPtr, dataSize);
+		if (count < dataSize)
+			_err = true;
+		_pos += count;
+		return count;
+	}
+
+private:
+	SharedPtr<CDImage> _image;
+	uint64 _start;
+	uint32 _size;
+	uint32 _pos;
+	bool _eos;
+	bool _err;
+};
+
+class ISO9660Archive : public Archive {
+public:
+	ISO9660Archive(const SharedPtr<CDImage> &image) : _image(image) {}
+
+	bool open();
+
+	// Archive API implementation
+	bool hasFile(const Path &path) const override;
+	int listMembers(ArchiveMemberList &list) const override;
+	const ArchiveMemberPtr getMember(const Path &path) const override;
+	SeekableReadStream *createReadStreamForMember(const Path &path) const override;
+
+private:
+	enum {
+		kFirstDescriptor = 16,
+		kMaxDescriptors = 32,
+		kMaxDepth = 32,
+		kMaxDirectorySize = 16 * 1024 * 1024,
+		kFlagDirectory = 2,
+		kFlagMultiExtent = 0x80
+	};
+
+	struct FileEntry {
+		uint32 lba;
+		uint32 size;
+	};
+
+	bool readDirectory(const Path &path, uint32 lba, uint32 size, bool joliet, uint depth);
+
+	SharedPtr<CDImage> _image;
+
+	typedef HashMap<Path, FileEntry, Path::IgnoreCase_Hash, Path::IgnoreCase_EqualTo> FileMap;
+	FileMap _map;
+};
+
+bool ISO9660Archive::open() {
+	byte descriptor[CDImage::kSectorSize];
+	uint32 rootLBA = 0, rootSize = 0;
+	bool joliet = false;
+
+	for (uint32 sector = kFirstDescriptor; sector < kFirstDescriptor + kMaxDescriptors; ++sector) {
+		if (_image->readData((uint64)sector * CDImage::kSectorSize, descriptor, sizeof(descriptor)) != sizeof(descriptor) ||
+			memcmp(descriptor + 1, "CD001", 5))
+			break;
+
+		// Terminator
+		if (descriptor[0] == 255)
+			break;
+
+		// Primary descriptor, or Joliet supplementary descriptor
+		const bool isJoliet = descriptor[0] == 2 && descriptor[88] == '%' && descriptor[89] == '/' &&
+			(descriptor[90] == '@' || descriptor[90] == 'C' || descriptor[90] == 'E');
+		if ((descriptor[0] == 1 && !joliet && rootSize == 0) || isJoliet) {
+			rootLBA = READ_LE_UINT32(descriptor + 156 + 2);
+			rootSize = READ_LE_UINT32(descriptor + 156 + 10);
+			joliet = isJoliet;
+		}
+	}
+
+	if (rootSize == 0) {
+		debug(1, "ISO9660Archive: No volume descriptor found");
+		return false;
+	}
+
+	debug(3, "ISO9660Archive: Reading %s file system", joliet ? "Joliet" : "ISO 9660");
+	return readDirectory(Path(), rootLBA, rootSize, joliet, 0);
+}
+
+bool ISO9660Archive::readDirectory(const Path &path, uint32 lba, uint32 size, bool joliet, uint depth) {
+	if (depth > kMaxDepth || size > kMaxDirectorySize) {
+		warning("ISO9660Archive: Skipping directory '%s'", path.toString().c_str());
+		return true;
+	}
+
+	Array<byte> data;
+	data.resize(size);
+	if (_image->readData((uint64)lba * CDImage::kSectorSize, data.data(), size) != size)
+		return false;
+
+	Path prevPath;
+	bool prevMultiExtent = false;
+
+	uint32 pos = 0;
+	while (pos < size) {
+		const byte *record = &data[pos];
+		const byte recordSize = record[0];
+
+		// Records do not cross sector boundaries
+		if (recordSize == 0) {
+			pos = (pos / CDImage::kSectorSize + 1) * CDImage::kSectorSize;
+			continue;
+		}
+
+		if (recordSize < 34 || pos + recordSize > size)
+			break;
+		pos += recordSize;
+
+		const uint32 extent = READ_LE_UINT32(record + 2);
+		const uint32 dataSize = READ_LE_UINT32(record + 10);
+		const byte flags = record[25];
+		const byte nameSize = MIN<byte>(record[32], recordSize - 33);
+		const byte *name = record + 33;
+
+		// Skip the entries for the directory itself and its parent
+		if (nameSize == 1 && (name[0] == 0 || name[0] == 1))
+			continue;
+
+		String fileName;
+		if (joliet) {
+			U32String unicodeName;
+			for (uint i = 0; i + 1 < nameSize; i += 2)
+				unicodeName += (u32char_type_t)READ_BE_UINT16(name + i);
+			fileName = unicodeName.encode();
+		} else {
+			fileName = String((const char *)name, nameSize);
+		}
+
+		// Drop the version, and the dot of names without an extension
+		const size_t versionPos = fileName.findLastOf(';');
+		if (versionPos != String::npos)
+			fileName.erase(versionPos);
+		if (!(flags & kFlagDirectory) && fileName.hasSuffix("."))
+			fileName.deleteLastChar();
+
+		if (fileName.empty())
+			continue;
+
+		const Path entryPath = path.appendComponent(fileName);
+		if (flags & kFlagDirectory) {
+			if (!readDirectory(entryPath, extent, dataSize, joliet, depth + 1))
+				return false;
+			continue;
+		}
+
+		// The extents of a file split into several are consecutive
+		if (prevMultiExtent && entryPath == prevPath) {
+			_map[entryPath].size += dataSize;
+		} else if (!_map.contains(entryPath)) {
+			FileEntry entry;
+			entry.lba = extent;
+			entry.size = dataSize;
+			_map[entryPath] = entry;
+		}
+
+		prevPath = entryPath;
+		prevMultiExtent = (flags & kFlagMultiExtent) != 0;
+	}
+
+	return true;
+}
+
+bool ISO9660Archive::hasFile(const Path &path) const {
+	return _map.contains(path);
+}
+
+int ISO9660Archive::listMembers(ArchiveMemberList &list) const {
+	for (FileMap::const_iterator it = _map.begin(); it != _map.end(); ++it)
+		list.push_back(getMember(it->_key));
+
+	return _map.size();
+}
+
+const ArchiveMemberPtr ISO9660Archive::getMember(const Path &path) const {
+	return ArchiveMemberPtr(new GenericArchiveMember(path, *this));
+}
+
+SeekableReadStream *ISO9660Archive::createReadStreamForMember(const Path &path) const {
+	FileMap::const_iterator it = _map.find(path);
+	if (it == _map.end())
+		return nullptr;
+
+	return new ISO9660FileStream(_image, (uint64)it->_value.lba * CDImage::kSectorSize, it->_value.size);
+}
+
+} // End of anonymous namespace
+
+Archive *makeISO9660Archive(const SharedPtr<CDImage> &image) {
+	if (!image || !image->hasData())
+		return nullptr;
+
+	ISO9660Archive *archive = new ISO9660Archive(image);
+	if (!archive->open()) {
+		delete archive;
+		return nullptr;
+	}
+
+	return archive;
+}
+
+Archive *makeCDImageArchive(const FSNode &node) {
+	SharedPtr<CDImage> image(new CDImage());
+	if (!image->open(node))
+		return nullptr;
+
+	return makeISO9660Archive(image);
+}
+
+} // End of namespace Common
@@ -0,0 +1,161 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_FORMATS_CDIMAGE_H
+#define COMMON_FORMATS_CDIMAGE_H
+
+#include "common/array.h"
+#include "common/mutex.h"
+#include "common/ptr.h"
+#include "common/types.h"
+
+namespace Common {
+
+class Archive;
+class FSNode;
+class SeekableReadStream;
+
+/**
+ * @defgroup common_cdimage CD images
+ * @ingroup common
+ *
+ * @brief API for reading CD images without extracting them.
+ *
+ * @{
+ */
+
+/**
+ * A CD image, which is one of:
+ *  - a plain ISO image of 2048 byte sectors,
+ *  - a raw BIN image of 2352 byte sectors, holding a single data track,
+ *  - a cue sheet, with the BIN files it lists. Those can also hold audio tracks.
+ *
+ * The user data of the first data track is read through a cache of blocks
+ * of consecutive sectors. Sequential reads which miss the cache read ahead
+ * several blocks at once. Audio tracks are read directly from the image.
+ *
+ * Reading is thread-safe, so that audio tracks can be played while data is
+ * read. Streams created from the image stay valid after it is deleted.
+ */
+class CDImage {
+public:
+	enum {
+		kSectorSize = 2048,		// User data in a data sector
+		kRawSectorSize = 2352,	// Whole sector, as used by raw images and audio tracks
+		kFramesPerSecond = 75
+	};
+
+	CDImage();
+	~CDImage();
+
+	/**
+	 * Open an image. Files listed in a cue sheet are looked up next to it.
+	 *
+	 * @param node  the .cue, .bin or .iso file
+	 */
+	bool open(const FSNode &node);
+
+	/**
+	 * Open an image made of a single data track, in 2048 or 2352 byte sectors.
+	 */
+	bool open(SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES);
+
+	void close();
+
+	/** Return whether the image has a data track. */
+	bool hasData() const { return _dataTrack >= 0; }
+
+	/** Return the number of sectors in the first data track. */
+	uint32 getDataSectorCount() const;
+
+	/**
+	 * Read user data of the first data track.
+	 *
+	 * @param offset  offset of the data, in bytes from the start of the track
+	 * @return        the number of bytes read
+	 */
+	uint32 readData(uint64 offset, void *dst, uint32 size);
+
+	/** Return whether the image holds the audio track with the given number. */
+	bool hasAudioTrack(int track) const;
+
+	/**
+	 * Create a stream of an audio track. It returns the samples of the track as
+	 * 16-bit signed little endian stereo PCM, at 44100 Hz.
+	 */
+	SeekableReadStream *createAudioTrackStream(int track) const;
+
+private:
+	struct ImageFile;
+	struct Track;
+	class TrackReadStream;
+
+	struct CacheBlock {
+		uint32 index;
+		uint32 lastUse;
+		byte *data;
+	};
+
+	enum {
+		kSectorsPerBlock = 16,
+		kBlockSize = kSectorsPerBlock * kSectorSize,
+		kCacheBlocks = 32,
+		kReadAheadBlocks = 4
+	};
+
+	bool openCue(const FSNode &node);
+	bool addSingleTrack(const SharedPtr<ImageFile> &file);
+
+	const CacheBlock *getBlock(uint32 index);
+	bool readBlocks(uint32 index, uint32 count, byte *dst);
+
+	Array<Track> _tracks;
+	int _dataTrack;
+
+	Array<CacheBlock> _cache;
+	uint32 _useCounter;
+	uint32 _lastMiss;
+	Array<byte> _rawBuffer;
+	Mutex _cacheMutex;
+};
+
+/**
+ * Create an archive of the ISO 9660 file system on a CD image. Joliet names
+ * are used when the image has them.
+ *
+ * May return nullptr in case of a failure.
+ */
+Archive *makeISO9660Archive(const SharedPtr<CDImage> &image);
+
+/**
+ * Open a CD image, and create an archive of the ISO 9660 file system on it.
+ *
+ * May return nullptr in case of a failure.
+ *
+ * @param node  the .cue, .bin or .iso file
+ */
+Archive *makeCDImageArchive(const FSNode &node);
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
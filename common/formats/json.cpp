@@ -49,10 +49,6 @@
 #define wcsncasecmp wcsnicmp
 #endif
 
-// Macros to free an array/object
-#define FREE_ARRAY(x) { JSONArray::iterator iter; for (iter = x.begin(); iter != x.end(); iter++) { delete *iter; } }
-#define FREE_OBJECT(x) { JSONObject::iterator iter; for (iter = x.begin(); iter != x.end(); iter++) { delete (*iter)._value; } }
-
 namespace Common {
 
 /**
@@ -441,75 +437,77 @@ JSONValue *JSONValue::parse(const char **data) {
 
 	// An object?
 	else if (**data == '{') {
-		JSONObject object;
+		// The children are added in place, a failure deletes them with the value
+		JSONValue *result = new JSONValue(JSONObject());
+		JSONObject &object = *result->_objectValue;
 
 		(*data)++;
 
 		while (**data != 0) {
 			// Whitespace at the start?
 			if (!JSON::skipWhitespace(data)) {
-				FREE_OBJECT(object);
+				delete result;
 				return nullptr;
 			}
 
 			// Special case - empty object
 			if (object.size() == 0 && **data == '}') {
 				(*data)++;
-				return new JSONValue(object);
+				return result;
 			}
 
 			// We want a string now...
 			String name;
 			if (!JSON::extractString(&(++(*data)), name)) {
-				FREE_OBJECT(object);
+				delete result;
 				return nullptr;
 			}
 
 			// More whitespace?
 			if (!JSON::skipWhitespace(data)) {
-				FREE_OBJECT(object);
+				delete result;
 				return nullptr;
 			}
 
 			// Need a : now
 			if (*((*data)++) != ':') {
-				FREE_OBJECT(object);
+				delete result;
 				return nullptr;
 			}
 
 			// More whitespace?
 			if (!JSON::skipWhitespace(data)) {
-				FREE_OBJECT(object);
+				delete result;
 				return nullptr;
 			}
 
 			// The value is here
 			JSONValue *value = parse(data);
 			if (value == nullptr) {
-				FREE_OBJECT(object);
+				delete result;
 				return nullptr;
 			}
 
 			// Add the name:value
-			if (object.find(name) != object.end())
-				delete object[name];
-			object[name] = value;
+			JSONValue *&entry = object.getOrCreateVal(name);
+			delete entry;
+			entry = value;
 
 			// More whitespace?
 			if (!JSON::skipWhitespace(data)) {
-				FREE_OBJECT(object);
+				delete result;
 				return nullptr;
 			}
 
 			// End of object?
 			if (**data == '}') {
 				(*data)++;
-				return new JSONValue(object);
+				return result;
 			}
 
 			// Want a , now
 			if (**data != ',') {
-				FREE_OBJECT(object);
+				delete result;
 				return nullptr;
 			}
 
@@ -517,33 +515,34 @@ JSONValue *JSONValue::parse(const char **data) {
 		}
 
 		// Only here if we ran out of data
-		FREE_OBJECT(object);
+		delete result;
 		return nullptr;
 	}
 
 	// An array?
 	else if (**data == '[') {
-		JSONArray array;
+		JSONValue *result = new JSONValue(JSONArray());
+		JSONArray &array = *result->_arrayValue;
 
 		(*data)++;
 
 		while (**data != 0) {
 			// Whitespace at the start?
 			if (!JSON::skipWhitespace(data)) {
-				FREE_ARRAY(array);
+				delete result;
 				return nullptr;
 			}
 
 			// Special case - empty array
 			if (array.size() == 0 && **data == ']') {
 				(*data)++;
-				return new JSONValue(array);
+				return result;
 			}
 
 			// Get the value
 			JSONValue *value = parse(data);
 			if (value == nullptr) {
-				FREE_ARRAY(array);
+				delete result;
 				return nullptr;
 			}
 
@@ -552,19 +551,19 @@ JSONValue *JSONValue::parse(const char **data) {
 
 			// More whitespace?
 			if (!JSON::skipWhitespace(data)) {
-				FREE_ARRAY(array);
+				delete result;
 				return nullptr;
 			}
 
 			// End of array?
 			if (**data == ']') {
 				(*data)++;
-				return new JSONValue(array);
+				return result;
 			}
 
 			// Want a , now
 			if (**data != ',') {
-				FREE_ARRAY(array);
+				delete result;
 				return nullptr;
 			}
 
@@ -572,7 +571,7 @@ JSONValue *JSONValue::parse(const char **data) {
 		}
 
 		// Only here if we ran out of data
-		FREE_ARRAY(array);
+		delete result;
 		return nullptr;
 	}
 
@@ -1251,4 +1250,202 @@ String JSONValue::indent(size_t depth) {
 	return indentStr;
 }
 
+JSONReader::JSONReader(const char *data) : _data(data), _first(false), _error(data == nullptr) {
+}
+
+bool JSONReader::fail() {
+	_error = true;
+	return false;
+}
+
+bool JSONReader::isAtEnd() {
+	return !_error && !JSON::skipWhitespace(&_data);
+}
+
+JSONType JSONReader::peekType() {
+	if (_error || !JSON::skipWhitespace(&_data))
+		return JSONType_Null;
+
+	switch (*_data) {
+	case '"':
+		return JSONType_String;
+	case '{':
+		return JSONType_Object;
+	case '[':
+		return JSONType_Array;
+	case 't':
+	case 'T':
+	case 'f':
+	case 'F':
+		return JSONType_Bool;
+	default:
+		break;
+	}
+
+	if (*_data != '-' && !(*_data >= '0' && *_data <= '9'))
+		return JSONType_Null;
+
+	const char *end = _data + 1;
+	while (*end >= '0' && *end <= '9')
+		end++;
+
+	return (*end == '.' || *end == 'e' || *end == 'E') ? JSONType_Number : JSONType_IntegerNumber;
+}
+
+bool JSONReader::enterObject() {
+	if (_error || !JSON::skipWhitespace(&_data) || *_data != '{')
+		return fail();
+
+	_data++;
+	_first = true;
+	return true;
+}
+
+bool JSONReader::enterArray() {
+	if (_error || !JSON::skipWhitespace(&_data) || *_data != '[')
+		return fail();
+
+	_data++;
+	_first = true;
+	return true;
+}
+
+/**
+* Moves to the next member of the current object or array
+*
+* @access private
+*
+* @param char close The character which ends the object or array
+*
+* @return bool Returns true if there is a member, or false at the end or on error
+*/
+bool JSONReader::nextMember(char close) {
+	if (_error || !JSON::skipWhitespace(&_data))
+		return fail();
+
+	if (*_data == close) {
+		// The enclosing object or array has at least this member
+		_data++;
+		_first = false;
+		return false;
+	}
+
+	if (!_first) {
+		if (*_data != ',')
+			return fail();
+
+		_data++;
+		if (!JSON::skipWhitespace(&_data))
+			return fail();
+	}
+
+	_first = false;
+	return true;
+}
+
+bool JSONReader::nextKey(String &name) {
+	if (!nextMember('}'))
+		return false;
+
+	if (*_data != '"')
+		return fail();
+
+	_data++;
+	if (!JSON::extractString(&_data, name) || !JSON::skipWhitespace(&_data) || *_data != ':')
+		return fail();
+
+	_data++;
+	return true;
+}
+
+bool JSONReader::nextElement() {
+	return nextMember(']');
+}
+
+bool JSONReader::readString(String &str) {
+	if (_error || !JSON::skipWhitespace(&_data) || *_data != '"')
+		return fail();
+
+	_data++;
+	return JSON::extractString(&_data, str) || fail();
+}
+
+JSONValue *JSONReader::readValue() {
+	if (_error || !JSON::skipWhitespace(&_data)) {
+		fail();
+		return nullptr;
+	}
+
+	JSONValue *value = JSONValue::parse(&_data);
+	if (!value)
+		fail();
+
+	return value;
+}
+
+/**
+* Skips the next value. The contents of skipped objects and arrays are not
+* checked, apart from their nesting and their strings.
+*
+* @access public
+*
+* @return bool Returns true on success, false on failure
+*/
+bool JSONReader::skipValue() {
+	if (_error || !JSON::skipWhitespace(&_data))
+		return fail();
+
+	// Numbers, booleans and null
+	if (*_data != '"' && *_data != '{' && *_data != '[') {
+		const char *start = _data;
+		while (isAlnum(*_data) || *_data == '-' || *_data == '+' || *_data == '.')
+			_data++;
+
+		return _data != start || fail();
+	}
+
+	uint depth = 0;
+	do {
+		switch (*_data) {
+		case '"':
+			if (!skipString())
+				return fail();
+			continue;
+		case '{':
+		case '[':
+			depth++;
+			break;
+		case '}':
+		case ']':
+			depth--;
+			break;
+		case 0:
+			return fail();
+		default:
+			break;
+		}
+
+		_data++;
+	} while (depth > 0);
+
+	return true;
+}
+
+bool JSONReader::skipString() {
+	// Skip the opening quote
+	_data++;
+
+	while (*_data != 0 && *_data != '"') {
+		if (*_data == '\\' && *++_data == 0)
+			return false;
+		_data++;
+	}
+
+	if (*_data == 0)
+		return false;
+
+	_data++;
+	return true;
+}
+
 } // End of namespace Common
@@ -89,6 +89,7 @@ enum JSONType { JSONType_Null, JSONType_String, JSONType_Bool, JSONType_Number,
 
 class JSONValue {
 	friend class JSON;
+	friend class JSONReader;
 
 public:
 	JSONValue(/*NULL*/);
@@ -150,6 +151,7 @@ private:
 
 class JSON {
 	friend class JSONValue;
+	friend class JSONReader;
 
 public:
 	/** Prepares raw bytes in a given stream to be parsed with Common::JSON::parse(). */
@@ -167,6 +169,88 @@ private:
 	JSON();
 };
 
+/**
+ * Pull parser for JSON text, which reads it one value at a time instead of
+ * building a tree of the whole document. Values which are not needed are
+ * skipped without allocating anything, and trees are only built for the
+ * values passed to readValue().
+ *
+ * A failure sets the reader in an error state, in which all further calls
+ * fail. For example, the "name" of each entry of a listing is read with:
+ *
+ * @code
+ * Common::JSONReader reader(data);
+ * Common::String key;
+ * if (reader.enterObject()) {
+ *     while (reader.nextKey(key)) {
+ *         if (key != "entries") {
+ *             reader.skipValue();
+ *             continue;
+ *         }
+ *         if (reader.enterArray()) {
+ *             while (reader.nextElement()) {
+ *                 Common::JSONValue *entry = reader.readValue();
+ *                 ... use entry->child("name") ...
+ *                 delete entry;
+ *             }
+ *         }
+ *     }
+ * }
+ * if (reader.hasError() || !reader.isAtEnd())
+ *     ... not valid JSON ...
+ * @endcode
+ */
+class JSONReader {
+public:
+	/** Read the given zero-terminated JSON text, which must outlive the reader. */
+	explicit JSONReader(const char *data);
+
+	/** Return true if the text was not valid where it has been read so far. */
+	bool hasError() const { return _error; }
+
+	/** Return true if the text was read completely, and without errors. */
+	bool isAtEnd();
+
+	/** Return the type of the next value, or JSONType_Null if it isn't valid. */
+	JSONType peekType();
+
+	/** Start reading an object. Its members are then read with nextKey(). */
+	bool enterObject();
+
+	/**
+	 * Move to the next member of the current object, whose value must then be
+	 * read or skipped. Return false at the end of the object.
+	 */
+	bool nextKey(String &name);
+
+	/** Start reading an array. Its elements are then read with nextElement(). */
+	bool enterArray();
+
+	/**
+	 * Move to the next element of the current array, which must then be read
+	 * or skipped. Return false at the end of the array.
+	 */
+	bool nextElement();
+
+	/** Read the next value, which must be a string. */
+	bool readString(String &str);
+
+	/** Read the next value into a tree. Return nullptr in case of an error. */
+	JSONValue *readValue();
+
+	/** Skip the next value, including all of its children. */
+	bool skipValue();
+
+private:
+	bool fail();
+	bool skipString();
+	bool nextMember(char close);
+
+	const char *_data;
+	bool _first; /** No member of the current object or array has been read yet */
+	bool _error;
+};
+
 } // End of namespace Common
 
 #endif
@@ -1,6 +1,7 @@
 MODULE := common/formats
 
 MODULE_OBJS := \
+	cdimage.o \
 	cue.o \
 	disk_image.o \
 	formatinfo.o \
@@ -181,6 +181,39 @@ void QuickTimeParser::init() {
 				_tracks[i]->editList[0].mediaTime = 0;
 				_tracks[i]->editList[0].mediaRate = 1;
 			}
+
+			if (_tracks[i]->codecType == CODEC_TYPE_VIDEO)
+				buildSampleIndex(_tracks[i]);
+		}
+	}
+}
+
+void QuickTimeParser::buildSampleIndex(Track *track) {
+	// With a constant sample size, there is no sample size table to count
+	const uint32 sampleCount = track->sampleSize ? track->frameCount : track->sampleCount;
+	uint32 sampleToChunkIndex = 0;
+
+	track->sampleIndex.clear();
+	track->sampleIndex.reserve(sampleCount);
+
+	for (uint32 i = 0; i < track->chunkCount && track->sampleIndex.size() < sampleCount; i++) {
+		if (sampleToChunkIndex < track->sampleToChunkCount && i >= track->sampleToChunk[sampleToChunkIndex].first)
+			sampleToChunkIndex++;
+
+		if (sampleToChunkIndex == 0)
+			continue;
+
+		const SampleToChunkEntry &chunk = track->sampleToChunk[sampleToChunkIndex - 1];
+		uint32 offset = track->chunkOffsets[i];
+
+		for (uint32 j = 0; j < chunk.count && track->sampleIndex.size() < sampleCount; j++) {
+			SampleIndexEntry sample;
+			sample.offset = offset;
+			sample.size = track->sampleSize ? track->sampleSize : track->sampleSizes[track->sampleIndex.size()];
+			sample.descId = chunk.id;
+			track->sampleIndex.push_back(sample);
+
+			offset += sample.size;
 		}
 	}
 }
@@ -120,6 +120,13 @@ protected:
 		uint32 id;
 	};
 
+	/** Location of a sample, resolved from the chunk tables at load time. */
+	struct SampleIndexEntry {
+		uint32 offset;
+		uint32 size;
+		uint32 descId;
+	};
+
 	struct EditListEntry {
 		uint32 trackDuration; // movie time
 		uint32 timeOffset;    // movie time
@@ -312,6 +319,8 @@ public:
 		uint32 *keyframes;
 		int32 timeScale; // media time
 
+		Array<SampleIndexEntry> sampleIndex; // video tracks only
+
 		uint16 width;
 		uint16 height;
 		CodecType codecType;
@@ -408,6 +417,7 @@ private:
 	void initParseTable();
 
 	bool parsePanoramaAtoms();
+	void buildSampleIndex(Track *track);
 
 	int readDefault(Atom atom);
 	int readLeaf(Atom atom);
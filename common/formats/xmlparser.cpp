@@ -27,10 +27,22 @@
 
 namespace Common {
 
+static bool isDeclaredProperty(const XMLParser::XMLKeyLayout *layout, const String &name) {
+	for (List<XMLParser::XMLKeyLayout::XMLKeyProperty>::const_iterator i = layout->properties.begin(); i != layout->properties.end(); ++i) {
+		if (i->name.equalsIgnoreCase(name))
+			return true;
+	}
+
+	return false;
+}
+
 XMLParser::~XMLParser() {
 	while (!_activeKey.empty())
 		freeNode(_activeKey.pop());
 
+	while (!_freeNodes.empty())
+		_nodePool.deleteChunk(_freeNodes.pop());
+
 	delete _XMLkeys;
 	delete _stream;
 
@@ -42,6 +54,7 @@ XMLParser::~XMLParser() {
 }
 
 bool XMLParser::loadFile(const Path &filename) {
+	_buffer = nullptr;
 	_stream = SearchMan.createReadStreamForMember(filename);
 	if (!_stream)
 		return false;
@@ -51,6 +64,7 @@ bool XMLParser::loadFile(const Path &filename) {
 }
 
 bool XMLParser::loadFile(const FSNode &node) {
+	_buffer = nullptr;
 	_stream = node.createReadStream();
 	if (!_stream)
 		return false;
@@ -61,11 +75,14 @@ bool XMLParser::loadFile(const FSNode &node) {
 
 bool XMLParser::loadBuffer(const byte *buffer, uint32 size, DisposeAfterUse::Flag disposable) {
 	_stream = new MemoryReadStream(buffer, size, disposable);
+	_buffer = buffer;
+	_bufferSize = size;
 	_fileName = "Memory Stream";
 	return true;
 }
 
 bool XMLParser::loadStream(SeekableReadStream *stream, const String &name) {
+	_buffer = nullptr;
 	_stream = stream;
 	_fileName = name;
 	return _stream != nullptr;
@@ -74,58 +91,40 @@ bool XMLParser::loadStream(SeekableReadStream *stream, const String &name) {
 void XMLParser::close() {
 	delete _stream;
 	_stream = nullptr;
+
+	_buffer = nullptr;
+	_textBuffer.clear();
+	_text = _textEnd = _pos = nullptr;
 }
 
 bool XMLParser::parserError(const String &errStr) {
 	_state = kParserError;
 
-	const int startPosition = _stream->pos();
-	int currentPosition = startPosition;
+	const char *position = _pos ? _pos : _text;
 	int lineCount = 1;
-	char c = 0;
-
-	_stream->seek(0, SEEK_SET);
 
-	while (currentPosition--) {
-		c = _stream->readByte();
-
-		if (c == '\n' || c == '\r')
+	for (const char *p = _text; p < position; p++) {
+		if (*p == '\n' || *p == '\r')
 			lineCount++;
 	}
 
-	assert(_stream->pos() == startPosition);
-	currentPosition = startPosition;
-
 	Common::String errorMessage = Common::String::format("\n  File <%s>, line %d:\n", _fileName.toString().c_str(), lineCount);
 
-	if (startPosition > 1) {
-		int keyOpening = 0;
-		int keyClosing = 0;
-
-		while (currentPosition-- && keyOpening == 0) {
-			_stream->seek(-2, SEEK_CUR);
-			c = _stream->readByte();
-
-			if (c == '<')
-				keyOpening = currentPosition - 1;
-			else if (c == '>')
-				keyClosing = currentPosition;
-		}
-
-		_stream->seek(startPosition, SEEK_SET);
-		currentPosition = startPosition;
-		while (keyClosing == 0 && c && currentPosition++) {
-			c = _stream->readByte();
-
-			if (c == '>')
-				keyClosing = currentPosition;
-		}
-
-		currentPosition = (keyClosing - keyOpening);
-		_stream->seek(keyOpening, SEEK_SET);
-
-		while (currentPosition--)
-			errorMessage += (char)_stream->readByte();
+	if (position - _text > 1) {
+		// Show the key around the error
+		const char *keyOpening = position;
+		while (keyOpening > _text && keyOpening[-1] != '<')
+			keyOpening--;
+		if (keyOpening > _text)
+			keyOpening--;
+
+		const char *keyClosing = position;
+		while (keyClosing < _textEnd && *keyClosing && *keyClosing != '>')
+			keyClosing++;
+		if (keyClosing < _textEnd && *keyClosing)
+			keyClosing++;
+
+		errorMessage += String(keyOpening, keyClosing);
 	}
 
 	errorMessage += "\n\nParser error: ";
@@ -163,28 +162,34 @@ bool XMLParser::parseActiveKey(bool closed) {
 		return parseXMLHeader(key) && closeKey();
 	}
 
+	// Keys inside an ignored key are only checked for syntax errors
+	if (_inIgnoredKey)
+		return closed ? closeKey() : true;
+
 	XMLKeyLayout *layout = (_activeKey.size() == 1) ? _XMLkeys : getParentNode(key)->layout;
 
 	if (layout->children.contains(key->name)) {
 		key->layout = layout->children[key->name];
 
-		StringMap localMap = key->values;
-		int keyCount = localMap.size();
+		uint handledCount = 0;
 
 		for (List<XMLKeyLayout::XMLKeyProperty>::const_iterator i = key->layout->properties.begin(); i != key->layout->properties.end(); ++i) {
-			if (i->required && !localMap.contains(i->name))
+			if (key->values.contains(i->name))
+				handledCount++;
+			else if (i->required)
 				return parserError("Missing required property '" + i->name + "' inside key '" + key->name + "'");
-			else if (localMap.contains(i->name)) {
-				keyCount--;
-				localMap.erase(i->name);
-			}
 		}
 
-		if (keyCount > 0) {
+		if (handledCount < key->values.size()) {
 			Common::String missingKeys;
+			int keyCount = 0;
 
-			for (auto i = localMap.begin(); i != localMap.end(); ++i)
-				missingKeys += i->_key + ' ';
+			for (StringMap::const_iterator i = key->values.begin(); i != key->values.end(); ++i) {
+				if (!isDeclaredProperty(key->layout, i->_key)) {
+					missingKeys += i->_key + ' ';
+					keyCount++;
+				}
+			}
 
 			return parserError(Common::String::format("Unhandled property inside key '%s' (%s, %d items).", key->name.c_str(), missingKeys.c_str(), keyCount));
 		}
@@ -218,34 +223,40 @@ bool XMLParser::parseActiveKey(bool closed) {
 	return true;
 }
 
-bool XMLParser::parseKeyValue(String keyName) {
+bool XMLParser::parseKeyValue(const String &keyName) {
 	assert(_activeKey.empty() == false);
 
-	if (_activeKey.top()->values.contains(keyName))
+	if (!_inIgnoredKey && _activeKey.top()->values.contains(keyName))
 		return false;
 
-	_token.clear();
-	char stringStart;
+	const char *valueStart = _pos;
 
 	if (_char == '"' || _char == '\'') {
-		stringStart = _char;
-		_char = _stream->readByte();
+		const char stringStart = _char;
+		nextChar();
+		valueStart = _pos;
 
-		while (_char && _char != stringStart) {
-			_token += _char;
-			_char = _stream->readByte();
-		}
+		while (_char && _char != stringStart)
+			nextChar();
 
 		if (_char == 0)
 			return false;
 
-		_char = _stream->readByte();
+		if (!_inIgnoredKey)
+			_activeKey.top()->values.setVal(keyName, String(valueStart, _pos));
 
-	} else if (!parseToken()) {
-		return false;
+		nextChar();
+		return true;
 	}
 
-	_activeKey.top()->values[keyName] = _token;
+	while (isValidNameChar(_char))
+		nextChar();
+
+	if (!isSpace(_char) && _char != '>' && _char != '=' && _char != '/')
+		return false;
+
+	if (!_inIgnoredKey)
+		_activeKey.top()->values.setVal(keyName, String(valueStart, _pos));
 	return true;
 }
 
@@ -311,8 +322,17 @@ bool XMLParser::parse() {
 	if (_stream == nullptr)
 		return false;
 
-	// Make sure we are at the start of the stream.
-	_stream->seek(0, SEEK_SET);
+	// Parse the whole text from memory
+	if (_buffer) {
+		_text = (const char *)_buffer;
+		_textEnd = _text + _bufferSize;
+	} else {
+		_stream->seek(0, SEEK_SET);
+		_textBuffer.resize(_stream->size());
+		_textBuffer.resize(_stream->read(_textBuffer.data(), _textBuffer.size()));
+		_text = _textBuffer.data();
+		_textEnd = _text + _textBuffer.size();
+	}
 
 	if (_XMLkeys == nullptr)
 		buildLayout();
@@ -328,8 +348,10 @@ bool XMLParser::parse() {
 
 	_state = kParserNeedHeader;
 	_activeKey.clear();
+	_inIgnoredKey = false;
 
-	_char = _stream->readByte();
+	_pos = _text;
+	_char = (_pos < _textEnd) ? *_pos : 0;
 
 	while (_char && _state != kParserError) {
 		if (skipSpaces())
@@ -343,16 +365,15 @@ bool XMLParser::parse() {
 		case kParserNeedKey:
 			if (_char != '<') {
 				if (_allowText) {
-					Common::String text;
+					const char *textStart = _pos;
 					do {
-						text += _char;
-						_char = _stream->readByte();
+						nextChar();
 					} while (_char != '<' && _char);
 					if (!_char) {
 						parserError("Unexpected end of file.");
 						break;
 					}
-					if (!textCallback(text)) {
+					if (!textCallback(String(textStart, _pos))) {
 						parserError("Failed to process text segment.");
 						break;
 					}
@@ -362,7 +383,8 @@ bool XMLParser::parse() {
 				}
 			}
 
-			if ((_char = _stream->readByte()) == 0) {
+			nextChar();
+			if (_char == 0) {
 				parserError("Unexpected end of file.");
 				break;
 			}
@@ -373,10 +395,10 @@ bool XMLParser::parse() {
 					break;
 				}
 
-				_char = _stream->readByte();
+				nextChar();
 				activeHeader = true;
 			} else if (_char == '/') {
-				_char = _stream->readByte();
+				nextChar();
 				activeClosure = true;
 			} else if (_char == '?') {
 				parserError("Unexpected header. There may only be one XML header per file.");
@@ -398,6 +420,13 @@ bool XMLParser::parse() {
 					break;
 				}
 			} else {
+				// Values inside ignored keys are not needed
+				_inIgnoredKey = false;
+				for (uint i = 0; i < _activeKey.size(); ++i) {
+					if (_activeKey[i]->ignore)
+						_inIgnoredKey = true;
+				}
+
 				ParserNode *node = allocNode(); // new ParserNode;
 				node->name = _token;
 				node->ignore = false;
@@ -424,7 +453,7 @@ bool XMLParser::parse() {
 				else
 					_state = kParserNeedKey;
 
-				_char = _stream->readByte();
+				nextChar();
 				break;
 			}
 
@@ -432,14 +461,14 @@ bool XMLParser::parse() {
 
 			if (_char == '/' || (_char == '?' && activeHeader)) {
 				selfClosure = true;
-				_char = _stream->readByte();
+				nextChar();
 			}
 
 			if (_char == '>') {
 				if (activeHeader && !selfClosure) {
 					parserError("XML Header must be self-closed.");
 				} else if (parseActiveKey(selfClosure)) {
-					_char = _stream->readByte();
+					nextChar();
 					_state = kParserNeedKey;
 				}
 
@@ -462,7 +491,7 @@ bool XMLParser::parse() {
 			else
 				_state = kParserNeedPropertyValue;
 
-			_char = _stream->readByte();
+			nextChar();
 			break;
 
 		case kParserNeedPropertyValue:
@@ -492,39 +521,40 @@ bool XMLParser::skipSpaces() {
 		return false;
 
 	while (_char && isSpace(_char))
-		_char = _stream->readByte();
+		nextChar();
 
 	return true;
 }
 
 bool XMLParser::skipComments() {
 	if (_char == '<') {
-		_char = _stream->readByte();
-
-		if (_char != '!') {
-			_stream->seek(-1, SEEK_CUR);
-			_char = '<';
+		if (_pos + 1 >= _textEnd || _pos[1] != '!')
 			return false;
-		}
 
-		if (_stream->readByte() != '-' || _stream->readByte() != '-')
+		nextChar();
+		nextChar();
+		if (_char != '-')
+			return parserError("Malformed comment syntax.");
+		nextChar();
+		if (_char != '-')
 			return parserError("Malformed comment syntax.");
 
-		_char = _stream->readByte();
+		nextChar();
 
 		while (_char) {
 			if (_char == '-') {
-				if (_stream->readByte() == '-') {
-
-					if (_stream->readByte() != '>')
+				nextChar();
+				if (_char == '-') {
+					nextChar();
+					if (_char != '>')
 						return parserError("Malformed comment (double-hyphen inside comment body).");
 
-					_char = _stream->readByte();
+					nextChar();
 					return true;
 				}
 			}
 
-			_char = _stream->readByte();
+			nextChar();
 		}
 
 		return parserError("Comment has no closure.");
@@ -534,12 +564,12 @@ bool XMLParser::skipComments() {
 }
 
 bool XMLParser::parseToken() {
-	_token.clear();
+	const char *tokenStart = _pos;
 
-	while (isValidNameChar(_char)) {
-		_token += _char;
-		_char = _stream->readByte();
-	}
+	while (isValidNameChar(_char))
+		nextChar();
+
+	_token = String(tokenStart, _pos);
 
 	return isSpace(_char) != 0 || _char == '>' || _char == '=' || _char == '/';
 }
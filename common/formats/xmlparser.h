@@ -25,6 +25,7 @@
 #include "common/scummsys.h"
 #include "common/types.h"
 
+#include "common/array.h"
 #include "common/fs.h"
 #include "common/list.h"
 #include "common/hashmap.h"
@@ -100,7 +101,8 @@ public:
 	/**
 	 * Parser constructor.
 	 */
-	XMLParser() : _XMLkeys(nullptr), _stream(nullptr), _allowText(false), _char(0) {}
+	XMLParser() : _XMLkeys(nullptr), _stream(nullptr), _allowText(false), _char(0),
+		_buffer(nullptr), _bufferSize(0), _text(nullptr), _textEnd(nullptr), _pos(nullptr), _inIgnoredKey(false) {}
 
 	virtual ~XMLParser();
 
@@ -153,12 +155,21 @@ public:
 
 	ObjectPool<ParserNode, MAX_XML_DEPTH> _nodePool;
 
+	/**
+	 * Nodes are reused once they have been freed, so that their maps of
+	 * values keep their storage.
+	 */
 	ParserNode *allocNode() {
-		return new (_nodePool) ParserNode;
+		if (_freeNodes.empty())
+			return new (_nodePool) ParserNode;
+
+		ParserNode *node = _freeNodes.pop();
+		node->values.clear();
+		return node;
 	}
 
 	void freeNode(ParserNode *node) {
-		_nodePool.deleteChunk(node);
+		_freeNodes.push(node);
 	}
 
 	/**
@@ -246,7 +257,8 @@ protected:
 	 * When parsing a key in such function, one may chose to skip it, e.g. because it's not needed
 	 * on the current configuration. In order to ignore a key, you must set
 	 * the "ignore" field of its KeyNode struct to "true": The key and all its children
-	 * will then be automatically ignored by the parser.
+	 * will then be automatically ignored by the parser. The children are only checked
+	 * for syntax errors, their values are not stored and their layout is not verified.
 	 *
 	 * The callback function must return true if the key was properly handled (this includes the case when the
 	 * key is being ignored). False otherwise. The return of keyCallback() is the same as
@@ -290,7 +302,7 @@ protected:
 	/**
 	 * Parses the value of a given key. There's no reason to overload this.
 	 */
-	bool parseKeyValue(String keyName);
+	bool parseKeyValue(const String &keyName);
 
 	/**
 	 * Called once a key has been parsed. It handles the closing/cleanup of the
@@ -374,11 +386,33 @@ protected:
 	List<XMLKeyLayout *> _layoutList;
 
 private:
+	/** Move to the next character of the text, or set _char to 0 at its end. */
+	void nextChar() {
+		if (_pos < _textEnd)
+			_pos++;
+		_char = (_pos < _textEnd) ? *_pos : 0;
+	}
+
 	char _char;
 	bool _allowText; /** Allow text nodes in the doc (default false) */
 	SeekableReadStream *_stream;
 	Path _fileName;
 
+	/**
+	 * The whole text is parsed from memory. Buffers given to loadBuffer()
+	 * are used directly, other streams are read into _textBuffer first.
+	 */
+	const byte *_buffer;
+	uint32 _bufferSize;
+	Array<char> _textBuffer;
+	const char *_text;
+	const char *_textEnd;
+	const char *_pos; /** Position of _char in the text */
+
+	bool _inIgnoredKey; /** The active key is inside an ignored key */
+
+	Stack<ParserNode *> _freeNodes; /** Freed nodes, ready for reuse */
+
 	ParserState _state; /** Internal state of the parser */
 
 	String _error; /** Current error message */
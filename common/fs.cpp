@@ -20,7 +20,10 @@
  */
 
 #include "common/system.h"
+#include "common/atomic.h"
 #include "common/debug.h"
+#include "common/jobs.h"
+#include "common/memstream.h"
 #include "common/punycode.h"
 #include "common/textconsole.h"
 #include "backends/fs/abstract-fs.h"
@@ -229,6 +232,10 @@ bool FSNode::isReadable() const {
 	return _realNode && _realNode->isReadable();
 }
 
+bool FSNode::getFileInfo(int64 &size, int64 &modificationTime) const {
+	return _realNode && !_realNode->isDirectory() && _realNode->getFileInfo(size, modificationTime);
+}
+
 bool FSNode::isWritable() const {
 	return _realNode && _realNode->isWritable();
 }
@@ -263,6 +270,13 @@ SeekableReadStream *FSNode::createReadStreamForAltStream(AltStreamType altStream
 	return _realNode->createReadStreamForAltStream(altStreamType);
 }
 
+MappedReadStream *FSNode::createMappedReadStream() const {
+	if (_realNode == nullptr || !_realNode->exists() || _realNode->isDirectory())
+		return nullptr;
+
+	return _realNode->createMappedReadStream();
+}
+
 SeekableWriteStream *FSNode::createWriteStream(bool atomic) const {
 	if (_realNode == nullptr)
 		return nullptr;
@@ -291,33 +305,89 @@ bool FSNode::createDirectory() const {
 	return _realNode->createDirectory();
 }
 
+/**
+ * Request for a file stream which is opened by a job.
+ */
+class FSDirectory::FileReadRequest : public ArchiveReadRequest {
+public:
+	/**
+	 * Largest file which is read into memory when prefetching. Only the
+	 * stream is opened for bigger ones.
+	 */
+	static const int64 kMaxReadAheadSize = 1024 * 1024;
+
+	FileReadRequest(const FSNode &node, bool readAhead) : _node(node), _readAhead(readAhead), _jobSystem(g_system->getJobSystem()) {
+		_jobSystem->submit(openStream, this, &_group);
+	}
+
+	~FileReadRequest() override {
+		// The job must not outlive the request
+		wait();
+	}
+
+	bool isReady() const override { return _group.isDone(); }
+
+protected:
+	void wait() override { _jobSystem->wait(_group); }
+
+private:
+	static void openStream(void *refCon);
+
+	const FSNode _node;
+	const bool _readAhead;
+	JobSystem *_jobSystem;
+	JobGroup _group;
+};
+
+void FSDirectory::FileReadRequest::openStream(void *refCon) {
+	FileReadRequest *request = (FileReadRequest *)refCon;
+	SeekableReadStream *stream = request->_node.createReadStream();
+
+	if (stream && request->_readAhead && stream->size() > 0 && stream->size() <= kMaxReadAheadSize) {
+		const uint32 size = stream->size();
+		byte *data = (byte *)malloc(size);
+
+		if (data && stream->read(data, size) == size) {
+			delete stream;
+			stream = new MemoryReadStream(data, size, DisposeAfterUse::YES);
+		} else {
+			free(data);
+			stream->seek(0);
+		}
+	}
+
+	request->_stream = stream;
+}
+
 FSDirectory::FSDirectory(const FSNode &node, int depth, bool flat, bool ignoreClashes, bool includeDirectories)
-  : _node(node), _cached(false), _depth(depth), _flat(flat), _ignoreClashes(ignoreClashes),
+  : _node(node), _cached(false), _useListingCache(false), _depth(depth), _flat(flat), _ignoreClashes(ignoreClashes),
 	_includeDirectories(includeDirectories) {
 }
 
 FSDirectory::FSDirectory(const Path &prefix, const FSNode &node, int depth, bool flat,
 						 bool ignoreClashes, bool includeDirectories)
-  : _node(node), _cached(false), _depth(depth), _flat(flat), _ignoreClashes(ignoreClashes),
+  : _node(node), _cached(false), _useListingCache(false), _depth(depth), _flat(flat), _ignoreClashes(ignoreClashes),
 	_includeDirectories(includeDirectories) {
 
 	setPrefix(prefix);
 }
 
 FSDirectory::FSDirectory(const Path &name, int depth, bool flat, bool ignoreClashes, bool includeDirectories)
-  : _node(name), _cached(false), _depth(depth), _flat(flat), _ignoreClashes(ignoreClashes),
+  : _node(name), _cached(false), _useListingCache(false), _depth(depth), _flat(flat), _ignoreClashes(ignoreClashes),
 	_includeDirectories(includeDirectories) {
 }
 
 FSDirectory::FSDirectory(const Path &prefix, const Path &name, int depth, bool flat,
 						 bool ignoreClashes, bool includeDirectories)
-  : _node(name), _cached(false), _depth(depth), _flat(flat), _ignoreClashes(ignoreClashes),
+  : _node(name), _cached(false), _useListingCache(false), _depth(depth), _flat(flat), _ignoreClashes(ignoreClashes),
 	_includeDirectories(includeDirectories) {
 
 	setPrefix(prefix);
 }
 
 FSDirectory::~FSDirectory() {
+	for (PrefetchMap::iterator it = _prefetched.begin(); it != _prefetched.end(); ++it)
+		delete it->_value;
 }
 
 void FSDirectory::setPrefix(const Path &prefix) {
@@ -328,6 +398,11 @@ FSNode FSDirectory::getFSNode() const {
 	return _node;
 }
 
+void FSDirectory::setListingCacheFile(const FSNode &file) {
+	_listingCacheFile = file;
+	_useListingCache = true;
+}
+
 FSNode *FSDirectory::lookupCache(NodeCache &cache, const Path &name) const {
 	// make caching as lazy as possible
 	if (!name.empty()) {
@@ -377,6 +452,17 @@ SeekableReadStream *FSDirectory::createReadStreamForMember(const Path &path) con
 	if (path.empty() || !_node.isDirectory())
 		return nullptr;
 
+	PrefetchMap::iterator prefetched = _prefetched.find(path);
+	if (prefetched != _prefetched.end()) {
+		FileReadRequest *request = prefetched->_value;
+		_prefetched.erase(prefetched);
+
+		SeekableReadStream *stream = request->getStream();
+		delete request;
+		if (stream)
+			return stream;
+	}
+
 	FSNode *node = lookupCache(_fileCache, path);
 	if (!node)
 		return nullptr;
@@ -407,6 +493,41 @@ SeekableReadStream *FSDirectory::createReadStreamForMemberAltStream(const Path &
 	return stream;
 }
 
+ArchiveReadRequest *FSDirectory::requestReadStream(const Path &path) const {
+	if (path.empty() || !_node.isDirectory())
+		return new ArchiveReadRequest(nullptr);
+
+	PrefetchMap::iterator prefetched = _prefetched.find(path);
+	if (prefetched != _prefetched.end()) {
+		ArchiveReadRequest *request = prefetched->_value;
+		_prefetched.erase(prefetched);
+		return request;
+	}
+
+	FSNode *node = lookupCache(_fileCache, path);
+	if (!node)
+		return new ArchiveReadRequest(nullptr);
+
+	return new FileReadRequest(*node, false);
+}
+
+void FSDirectory::prefetchMembers(const Array<Path> &paths) const {
+	// Bound the memory used by files which may never be opened
+	const uint kMaxPrefetchedFiles = 32;
+
+	if (!_node.isDirectory())
+		return;
+
+	for (uint i = 0; i < paths.size() && _prefetched.size() < kMaxPrefetchedFiles; i++) {
+		if (paths[i].empty() || _prefetched.contains(paths[i]))
+			continue;
+
+		FSNode *node = lookupCache(_fileCache, paths[i]);
+		if (node)
+			_prefetched.setVal(paths[i], new FileReadRequest(*node, true));
+	}
+}
+
 FSDirectory *FSDirectory::getSubDirectory(const Path &name, int depth, bool flat, bool ignoreClashes) {
 	return getSubDirectory(Path(), name, depth, flat, ignoreClashes);
 }
@@ -423,19 +544,222 @@ FSDirectory *FSDirectory::getSubDirectory(const Path &prefix, const Path &name,
 	return new FSDirectory(prefix, *node, depth, flat, ignoreClashes);
 }
 
-void FSDirectory::cacheDirectoryRecursive(FSNode node, int depth, const Path& prefix) const {
-	if (depth <= 0)
+/**
+ * Entries of a directory and, up to the depth of the FSDirectory, of its
+ * subdirectories.
+ */
+struct FSDirectory::Listing {
+	explicit Listing(const FSNode &n) : node(n), modificationTime(0) {}
+	~Listing() { clear(); }
+
+	void clear() {
+		for (uint i = 0; i < subDirs.size(); i++)
+			delete subDirs[i];
+		subDirs.clear();
+		children.clear();
+	}
+
+	FSNode node;
+	/** As returned by getFileInfo(), or -1 if the backend doesn't support it. */
+	int64 modificationTime;
+	FSList children;
+	/** Listings of the directories in children, in the same order. */
+	Array<Listing *> subDirs;
+};
+
+struct FSDirectory::ListingJob {
+	Listing *const *listings;
+	bool getTimes;
+	Atomic<bool> changed;
+};
+
+static const uint32 kListingCacheVersion = 1;
+
+// The job system isn't there before the backend was initialized
+static void runParallel(uint count, JobRangeProc proc, void *refCon) {
+	JobSystem *jobSystem = g_system->getJobSystem();
+	if (jobSystem)
+		jobSystem->parallelFor(count, proc, refCon);
+	else if (count)
+		proc(0, count, refCon);
+}
+
+void FSDirectory::listDirectories(uint begin, uint end, void *refCon) {
+	ListingJob *job = (ListingJob *)refCon;
+
+	for (uint i = begin; i < end; i++) {
+		Listing *listing = job->listings[i];
+
+		// Taken before listing, so that a concurrent change invalidates the stored listing
+		int64 size;
+		if (job->getTimes && (!listing->node._realNode || !listing->node._realNode->getFileInfo(size, listing->modificationTime)))
+			listing->modificationTime = -1;
+
+		listing->node.getChildren(listing->children, FSNode::kListAll);
+	}
+}
+
+void FSDirectory::checkDirectories(uint begin, uint end, void *refCon) {
+	ListingJob *job = (ListingJob *)refCon;
+
+	for (uint i = begin; i < end && !job->changed.loadRelaxed(); i++) {
+		const Listing *listing = job->listings[i];
+
+		int64 size, modificationTime;
+		if (!listing->node._realNode->getFileInfo(size, modificationTime) || modificationTime != listing->modificationTime)
+			job->changed.store(true);
+	}
+}
+
+void FSDirectory::listTree(Listing &root) const {
+	Array<Listing *> level, nextLevel;
+	level.push_back(&root);
+
+	// Directories are listed one level at a time, as a listing may need a
+	// round trip on network filesystems
+	for (int depth = _depth; depth > 0 && !level.empty(); depth--) {
+		ListingJob job;
+		job.listings = level.data();
+		job.getTimes = _useListingCache;
+		runParallel(level.size(), listDirectories, &job);
+
+		nextLevel.clear();
+		if (depth > 1) {
+			for (uint i = 0; i < level.size(); i++) {
+				for (FSList::const_iterator it = level[i]->children.begin(); it != level[i]->children.end(); ++it) {
+					if (it->isDirectory()) {
+						level[i]->subDirs.push_back(new Listing(*it));
+						nextLevel.push_back(level[i]->subDirs.back());
+					}
+				}
+			}
+		}
+		level.swap(nextLevel);
+	}
+}
+
+bool FSDirectory::loadListing(Listing &root) const {
+	if (!_node.isDirectory() || !_listingCacheFile.exists())
+		return false;
+
+	SeekableReadStream *stream = _listingCacheFile.createReadStream();
+	if (!stream)
+		return false;
+
+	Array<Listing *> listings;
+	bool valid = stream->readUint32BE() == MKTAG('F', 'S', 'L', 'C') &&
+	             stream->readUint32LE() == kListingCacheVersion &&
+	             stream->readSint32LE() == _depth;
+	if (valid) {
+		const uint32 pathLength = stream->readUint32LE();
+		valid = stream->readString(0, pathLength) == _node.getPath().toString() &&
+		        readListing(*stream, root, _depth, listings);
+	}
+	delete stream;
+
+	if (valid) {
+		ListingJob job;
+		job.listings = listings.data();
+		runParallel(listings.size(), checkDirectories, &job);
+		valid = !job.changed.load();
+	}
+
+	if (!valid) {
+		debug(2, "FSDirectory: Stored listing of '%s' is outdated", _node.getPath().toString(Common::Path::kNativeSeparator).c_str());
+		root.clear();
+	}
+	return valid;
+}
+
+bool FSDirectory::readListing(SeekableReadStream &stream, Listing &listing, int depth, Array<Listing *> &listings) const {
+	listings.push_back(&listing);
+	listing.modificationTime = stream.readSint64LE();
+
+	const uint32 count = stream.readUint32LE();
+	for (uint32 i = 0; i < count && !stream.eos(); i++) {
+		const bool isDirectory = stream.readByte() != 0;
+		const uint16 nameLength = stream.readUint16LE();
+		const String name = stream.readString(0, nameLength);
+		listing.children.push_back(FSNode(listing.node._realNode->getListedChild(name, isDirectory)));
+	}
+
+	if (stream.err() || stream.eos())
+		return false;
+
+	if (depth > 1) {
+		for (FSList::const_iterator it = listing.children.begin(); it != listing.children.end(); ++it) {
+			if (it->isDirectory()) {
+				listing.subDirs.push_back(new Listing(*it));
+				if (!readListing(stream, *listing.subDirs.back(), depth - 1, listings))
+					return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+void FSDirectory::saveListing(const Listing &root) const {
+	// Without modification times the listing can't be validated
+	Array<const Listing *> pending;
+	pending.push_back(&root);
+	while (!pending.empty()) {
+		const Listing *listing = pending.back();
+		pending.pop_back();
+		if (listing->modificationTime < 0)
+			return;
+		for (uint i = 0; i < listing->subDirs.size(); i++)
+			pending.push_back(listing->subDirs[i]);
+	}
+
+	SeekableWriteStream *stream = _listingCacheFile.createWriteStream();
+	if (!stream) {
+		warning("FSDirectory: Can't store the listing of '%s'", Common::toPrintable(_node.getPath().toString(Common::Path::kNativeSeparator)).c_str());
 		return;
+	}
 
-	FSList list;
-	node.getChildren(list, FSNode::kListAll);
+	const String path = _node.getPath().toString();
+	stream->writeUint32BE(MKTAG('F', 'S', 'L', 'C'));
+	stream->writeUint32LE(kListingCacheVersion);
+	stream->writeSint32LE(_depth);
+	stream->writeUint32LE(path.size());
+	stream->writeString(path);
+	writeListing(*stream, root);
 
-	FSList::iterator it = list.begin();
-	for ( ; it != list.end(); ++it) {
+	if (!stream->flush() || stream->err())
+		warning("FSDirectory: Can't store the listing of '%s'", Common::toPrintable(_node.getPath().toString(Common::Path::kNativeSeparator)).c_str());
+	delete stream;
+}
+
+void FSDirectory::writeListing(WriteStream &stream, const Listing &listing) const {
+	stream.writeSint64LE(listing.modificationTime);
+
+	stream.writeUint32LE(listing.children.size());
+	for (FSList::const_iterator it = listing.children.begin(); it != listing.children.end(); ++it) {
+		const String name = it->getRealName();
+		stream.writeByte(it->isDirectory() ? 1 : 0);
+		stream.writeUint16LE(name.size());
+		stream.writeString(name);
+	}
+
+	for (uint i = 0; i < listing.subDirs.size(); i++)
+		writeListing(stream, *listing.subDirs[i]);
+}
+
+void FSDirectory::cacheDirectoryRecursive(const Listing &listing, int depth, const Path& prefix) const {
+	if (depth <= 0)
+		return;
+
+	uint subDir = 0;
+	FSList::const_iterator it = listing.children.begin();
+	for ( ; it != listing.children.end(); ++it) {
 		Path name = prefix.appendComponent(it->getRealName());
 
 		// since the hashmap is case insensitive, we need to check for clashes when caching
 		if (it->isDirectory()) {
+			const Listing *subListing = subDir < listing.subDirs.size() ? listing.subDirs[subDir] : nullptr;
+			subDir++;
+
 			if (!_flat && _subDirCache.contains(name)) {
 				// Always warn in this case as it's when there are 2 directories at the same place with different case
 				// That means a problem in user installation as lookups are always done case insensitive
@@ -448,7 +772,8 @@ void FSDirectory::cacheDirectoryRecursive(FSNode node, int depth, const Path& pr
 						        Common::toPrintable(name.toString(Common::Path::kNativeSeparator)).c_str());
 					}
 				}
-				cacheDirectoryRecursive(*it, depth - 1, _flat ? prefix : name);
+				if (subListing)
+					cacheDirectoryRecursive(*subListing, depth - 1, _flat ? prefix : name);
 				_subDirCache[name] = *it;
 				_dirMapCache[prefix].push_back(it->getRealName());
 			}
@@ -470,7 +795,15 @@ void FSDirectory::cacheDirectoryRecursive(FSNode node, int depth, const Path& pr
 void FSDirectory::ensureCached() const  {
 	if (_cached)
 		return;
-	cacheDirectoryRecursive(_node, _depth, _prefix);
+
+	Listing root(_node);
+	if (!_useListingCache || !loadListing(root)) {
+		listTree(root);
+		if (_useListingCache)
+			saveListing(root);
+	}
+
+	cacheDirectoryRecursive(root, _depth, _prefix);
 	_cached = true;
 }
 
@@ -46,6 +46,7 @@ namespace Common {
 class FSNode;
 class FSDirectory;
 class SeekableReadStream;
+class MappedReadStream;
 class WriteStream;
 class SeekableWriteStream;
 
@@ -239,6 +240,17 @@ public:
 	 */
 	bool isReadable() const;
 
+	/**
+	 * Get the size and the last modification time of the file referred by
+	 * this node, without opening it. This is not supported by all backends.
+	 *
+	 * The modification time is in a backend specific unit and is only
+	 * meant to detect whether the file changed.
+	 *
+	 * @return True if the information could be retrieved, false otherwise.
+	 */
+	bool getFileInfo(int64 &size, int64 &modificationTime) const;
+
 	/**
 	 * Indicate whether the object referred by this node can be written to or not.
 	 *
@@ -271,6 +283,18 @@ public:
 	 */
 	SeekableReadStream *createReadStreamForAltStream(AltStreamType altStreamType) const override;
 
+	/**
+	 * Map the file referred by this node into memory, read-only. Unlike a
+	 * stream created by createReadStream(), its data can be accessed directly
+	 * and sub-views on it can be created without copying.
+	 *
+	 * This is not supported by all backends, and files of 4 GB or more are
+	 * never mapped. Callers should fall back to createReadStream().
+	 *
+	 * @return Pointer to the stream object, nullptr if the file can't be mapped.
+	 */
+	MappedReadStream *createMappedReadStream() const;
+
 	/**
 	 * Create a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -359,12 +383,33 @@ class FSDirectory : public Archive {
 	// look for a match
 	FSNode *lookupCache(NodeCache &cache, const Path &name) const;
 
+	// persistent listing of the directory tree, see setListingCacheFile()
+	FSNode _listingCacheFile;
+	bool _useListingCache;
+
+	// directory tree as listed by the filesystem, with all directories
+	// of a level being listed in parallel
+	struct Listing;
+	struct ListingJob;
+	static void listDirectories(uint begin, uint end, void *refCon);
+	static void checkDirectories(uint begin, uint end, void *refCon);
+	void listTree(Listing &root) const;
+	bool loadListing(Listing &root) const;
+	bool readListing(SeekableReadStream &stream, Listing &listing, int depth, Array<Listing *> &listings) const;
+	void saveListing(const Listing &root) const;
+	void writeListing(WriteStream &stream, const Listing &listing) const;
+
 	// cache management
-	void cacheDirectoryRecursive(FSNode node, int depth, const Path& prefix) const;
+	void cacheDirectoryRecursive(const Listing &listing, int depth, const Path& prefix) const;
 
 	// fill cache if not already cached
 	void ensureCached() const;
 
+	// streams opened in the background by prefetchMembers()
+	class FileReadRequest;
+	typedef HashMap<Path, FileReadRequest *, Path::IgnoreCaseAndMac_Hash, Path::IgnoreCaseAndMac_EqualTo> PrefetchMap;
+	mutable PrefetchMap _prefetched;
+
 public:
 	/**
 	 * Create a FSDirectory representing a tree with the specified depth. Will result in an
@@ -398,6 +443,16 @@ public:
 	 */
 	FSNode getFSNode() const;
 
+	/**
+	 * Keep the listing of the directory tree in @p file across runs. The
+	 * stored listing is used as long as the modification times of all
+	 * listed directories are unchanged, which saves listing them again on
+	 * slow filesystems. Must be called before the directory is accessed,
+	 * and only works with backends supporting FSNode::getFileInfo() for
+	 * directories.
+	 */
+	void setListingCacheFile(const FSNode &file);
+
 	/**
 	 * Create a new FSDirectory pointing to a subdirectory of the instance.
 	 * @return A new FSDirectory instance.
@@ -452,6 +507,19 @@ public:
 	 * for success.
 	 */
 	SeekableReadStream *createReadStreamForMemberAltStream(const Path &path, AltStreamType altStreamType) const override;
+
+	/**
+	 * Open the specified file on a worker thread of the job system.
+	 */
+	ArchiveReadRequest *requestReadStream(const Path &path) const override;
+
+	/**
+	 * Start reading the specified files into memory on worker threads of the
+	 * job system. Large files are only opened. Later calls to
+	 * createReadStreamForMember() or requestReadStream() for these files
+	 * use the prefetched streams.
+	 */
+	void prefetchMembers(const Array<Path> &paths) const override;
 };
 
 /** @} */
@@ -94,6 +94,30 @@ inline int intLog2(uint32 v) {
 }
 #endif
 
+/**
+ * Return the number of trailing zero bits of @p v, which must not be zero.
+ */
+inline int countTrailingZeros(uint32 v) {
+	assert(v != 0);
+#if defined(__GNUC__)
+	return __builtin_ctz(v);
+#elif defined(_MSC_VER)
+	unsigned long result = 0;
+	_BitScanForward(&result, v);
+	return result;
+#else
+	return intLog2(v & (~v + 1));
+#endif
+}
+
+/**
+ * Return the number of leading zero bits of @p v, which must not be zero.
+ */
+inline int countLeadingZeros(uint32 v) {
+	assert(v != 0);
+	return 31 - intLog2(v);
+}
+
 } // End of namespace Common
 
 #endif // COMMON_INTRINSICS_H
@@ -0,0 +1,223 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/jobs.h"
+
+namespace Common {
+
+bool JobGroup::isDone() const {
+	StackLock lock(_mutex);
+	return _pending == 0;
+}
+
+void JobGroup::add() {
+	StackLock lock(_mutex);
+	_pending++;
+}
+
+void JobGroup::finish() {
+	StackLock lock(_mutex);
+	assert(_pending > 0);
+	_pending--;
+}
+
+void JobSystem::submit(JobProc proc, void *refCon, JobGroup *group) {
+	assert(proc);
+
+	Job job;
+	job.proc = proc;
+	job.refCon = refCon;
+	job.group = group;
+
+	if (group)
+		group->add();
+
+	enqueue(job);
+}
+
+void JobSystem::wait(JobGroup &group) {
+	while (!group.isDone()) {
+		if (!runPendingJob())
+			idle();
+	}
+}
+
+namespace {
+
+struct RangeJob {
+	JobRangeProc proc;
+	void *refCon;
+	uint begin;
+	uint end;
+};
+
+void runRangeJob(void *refCon) {
+	const RangeJob *job = (const RangeJob *)refCon;
+	job->proc(job->begin, job->end, job->refCon);
+}
+
+} // End of anonymous namespace
+
+void JobSystem::parallelFor(uint count, JobRangeProc proc, void *refCon, uint minBatch) {
+	assert(proc);
+
+	if (minBatch == 0)
+		minBatch = 1;
+
+	const uint threads = getThreadCount();
+	if (threads <= 1 || count <= minBatch) {
+		if (count)
+			proc(0, count, refCon);
+		return;
+	}
+
+	// Use a few batches per thread so that uneven batches still balance out.
+	const uint batches = MIN<uint>(threads * 4, (count + minBatch - 1) / minBatch);
+	const uint batchSize = (count + batches - 1) / batches;
+
+	Array<RangeJob> jobs;
+	jobs.reserve(batches);
+	for (uint begin = 0; begin < count; begin += batchSize) {
+		RangeJob job;
+		job.proc = proc;
+		job.refCon = refCon;
+		job.begin = begin;
+		job.end = MIN(begin + batchSize, count);
+		jobs.push_back(job);
+	}
+
+	JobGroup group;
+	for (uint i = 1; i < jobs.size(); i++)
+		submit(runRangeJob, &jobs[i], &group);
+
+	runRangeJob(&jobs[0]);
+	wait(group);
+}
+
+void JobSystem::run(const Job &job) {
+	job.proc(job.refCon);
+	if (job.group)
+		job.group->finish();
+}
+
+ThreadedJobSystem::ThreadedJobSystem(uint numWorkers) : _nextQueue(0), _stopping(false) {
+	_queues.resize(numWorkers);
+	for (uint i = 0; i < numWorkers; i++)
+		_queues[i] = new Queue();
+}
+
+ThreadedJobSystem::~ThreadedJobSystem() {
+	for (uint i = 0; i < _queues.size(); i++) {
+		// Jobs left behind belong to groups nobody waited for; drop them.
+		delete _queues[i];
+	}
+}
+
+void ThreadedJobSystem::workerLoop(uint index) {
+	assert(index < _queues.size());
+
+	Job job;
+	while (!isStopping()) {
+		if (popJob(index, job) || stealJob(index, job))
+			run(job);
+		else
+			waitForWork();
+	}
+}
+
+void ThreadedJobSystem::stopWorkers() {
+	{
+		StackLock lock(_mutex);
+		_stopping = true;
+	}
+
+	notifyWorkers(_queues.size());
+}
+
+void ThreadedJobSystem::enqueue(const Job &job) {
+	if (_queues.empty()) {
+		run(job);
+		return;
+	}
+
+	uint index;
+	{
+		StackLock lock(_mutex);
+		index = _nextQueue;
+		_nextQueue = (_nextQueue + 1) % _queues.size();
+	}
+
+	{
+		StackLock lock(_queues[index]->mutex);
+		_queues[index]->jobs.push_back(job);
+	}
+
+	notifyWorkers(1);
+}
+
+bool ThreadedJobSystem::runPendingJob() {
+	// The caller is not a worker, so it can only steal.
+	Job job;
+	if (!stealJob(_queues.size(), job))
+		return false;
+
+	run(job);
+	return true;
+}
+
+bool ThreadedJobSystem::popJob(uint index, Job &job) {
+	Queue *queue = _queues[index];
+	StackLock lock(queue->mutex);
+	if (queue->jobs.empty())
+		return false;
+
+	job = queue->jobs.back();
+	queue->jobs.pop_back();
+	return true;
+}
+
+bool ThreadedJobSystem::stealJob(uint index, Job &job) {
+	// Start with the queue after our own one; an out of range index
+	// (used by non-worker threads) thus starts at the first queue.
+	for (uint i = 1; i <= _queues.size(); i++) {
+		const uint victim = (index + i) % (_queues.size() + 1);
+		if (victim == index || victim == _queues.size())
+			continue;
+
+		Queue *queue = _queues[victim];
+		StackLock lock(queue->mutex);
+		if (queue->jobs.empty())
+			continue;
+
+		job = queue->jobs.front();
+		queue->jobs.pop_front();
+		return true;
+	}
+
+	return false;
+}
+
+bool ThreadedJobSystem::isStopping() const {
+	StackLock lock(_mutex);
+	return _stopping;
+}
+
+} // End of namespace Common
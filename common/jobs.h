@@ -0,0 +1,215 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_JOBS_H
+#define COMMON_JOBS_H
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/list.h"
+#include "common/mutex.h"
+#include "common/noncopyable.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_jobs Job system
+ * @ingroup common
+ *
+ * @brief API for running independent pieces of work on worker threads.
+ *
+ * The job system is owned by the backend and can be obtained through
+ * OSystem::getJobSystem(). On ports without threading support, jobs are
+ * simply executed inline by the submitting thread, so code using this API
+ * does not need a separate single-threaded code path.
+ *
+ * Jobs may run on a different thread than the one that submitted them.
+ * Hence they must not call into OSystem (except for the mutex functions)
+ * and must only touch data that is not accessed concurrently by other jobs
+ * or by the submitting thread until the job has been waited for.
+ *
+ * @{
+ */
+
+typedef void (*JobProc)(void *refCon); /*!< Type definition of a single job. */
+typedef void (*JobRangeProc)(uint begin, uint end, void *refCon); /*!< Type definition of a ranged job, see JobSystem::parallelFor(). */
+
+/**
+ * A set of submitted jobs that can be waited for as a whole.
+ *
+ * A group must outlive all jobs submitted into it. In other words,
+ * JobSystem::wait() must be called before the group is destroyed.
+ */
+class JobGroup : NonCopyable {
+	friend class JobSystem;
+
+public:
+	JobGroup() : _pending(0) {}
+
+	/** Return true if all jobs submitted into this group have completed. */
+	bool isDone() const;
+
+private:
+	void add();
+	void finish();
+
+	mutable Mutex _mutex;
+	uint _pending;
+};
+
+/**
+ * Basic job system which executes all jobs inline.
+ *
+ * This is the fallback used by backends that do not support threads.
+ * Backends that do should provide a subclass of ThreadedJobSystem instead.
+ */
+class JobSystem : NonCopyable {
+public:
+	virtual ~JobSystem() {}
+
+	/**
+	 * Return the number of threads that may execute jobs concurrently,
+	 * including the calling thread. This is 1 if jobs are run inline.
+	 */
+	virtual uint getThreadCount() const { return 1; }
+
+	/**
+	 * Submit a job for execution.
+	 *
+	 * @param proc   Callback to run.
+	 * @param refCon Arbitrary void pointer passed to the callback.
+	 * @param group  Optional group to add the job to, for use with wait().
+	 */
+	void submit(JobProc proc, void *refCon, JobGroup *group = nullptr);
+
+	/**
+	 * Wait until all jobs in the given group have completed.
+	 *
+	 * While waiting, the calling thread helps executing pending jobs.
+	 */
+	void wait(JobGroup &group);
+
+	/**
+	 * Split the range [0, count) into batches, run @p proc on each batch and
+	 * wait for all of them to complete. The calling thread processes one of
+	 * the batches itself.
+	 *
+	 * @param count    Number of items to process.
+	 * @param proc     Callback invoked with the bounds of each batch.
+	 * @param refCon   Arbitrary void pointer passed to the callback.
+	 * @param minBatch Minimum number of items per batch.
+	 */
+	void parallelFor(uint count, JobRangeProc proc, void *refCon, uint minBatch = 1);
+
+protected:
+	struct Job {
+		JobProc proc;
+		void *refCon;
+		JobGroup *group;
+	};
+
+	/** Queue a job. The default implementation runs it immediately. */
+	virtual void enqueue(const Job &job) { run(job); }
+
+	/**
+	 * Execute one pending job on the calling thread, if there is one.
+	 *
+	 * @return True if a job was executed.
+	 */
+	virtual bool runPendingJob() { return false; }
+
+	/** Called by wait() when there is no pending job the caller could help with. */
+	virtual void idle() {}
+
+	static void run(const Job &job);
+};
+
+/**
+ * Job system backed by a pool of worker threads.
+ *
+ * Every worker owns a job queue. Submitted jobs are distributed over the
+ * queues in a round-robin fashion. A worker takes the most recently queued
+ * job from its own queue and, once that is empty, steals the oldest job from
+ * the queue of another worker.
+ *
+ * This class implements the scheduling only. Subclasses provide the actual
+ * threads, by calling workerLoop() from each of them, and the primitives used
+ * to put idle workers to sleep.
+ */
+class ThreadedJobSystem : public JobSystem {
+public:
+	~ThreadedJobSystem() override;
+
+	uint getThreadCount() const override { return _queues.size() + 1; }
+
+protected:
+	/**
+	 * Create the job queues for the given number of workers. This does not
+	 * start any threads.
+	 */
+	explicit ThreadedJobSystem(uint numWorkers);
+
+	/**
+	 * Main loop of the worker with the given index. Returns once
+	 * stopWorkers() has been called.
+	 */
+	void workerLoop(uint index);
+
+	/**
+	 * Ask all workers to exit their loop. Subclasses must call this, and
+	 * then join their threads, before they are destroyed.
+	 */
+	void stopWorkers();
+
+	/** Wake up to @p count sleeping workers. */
+	virtual void notifyWorkers(uint count) = 0;
+
+	/** Put the calling worker to sleep until notifyWorkers() is called. */
+	virtual void waitForWork() = 0;
+
+	/** Give up the remainder of the calling thread's time slice. */
+	virtual void yield() = 0;
+
+	void enqueue(const Job &job) override;
+	bool runPendingJob() override;
+	void idle() override { yield(); }
+
+private:
+	struct Queue {
+		Mutex mutex;
+		List<Job> jobs;
+	};
+
+	bool popJob(uint index, Job &job);
+	bool stealJob(uint index, Job &job);
+	bool isStopping() const;
+
+	Array<Queue *> _queues;
+	mutable Mutex _mutex;
+	uint _nextQueue;
+	bool _stopping;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -23,6 +23,7 @@
 
 #include "lauxlib.h"
 #include "scummvm_file.h"
+#include "common/memorypool.h"
 #include "common/textconsole.h"
 
 #define FREELIST_REF	0	/* free list of references */
@@ -630,15 +631,76 @@ LUALIB_API int (luaL_loadstring) (lua_State *L, const char *s) {
 /* }====================================================== */
 
 
+/*
+** Small blocks (strings, tables, closures, upvalues and short arrays) are
+** taken from pools with one size class for every 16 bytes, since scripts
+** create and collect them all the time. Larger blocks use the system
+** allocator. The pools belong to a state, and are freed along with the
+** last block of that state.
+*/
+#define POOL_GRANULARITY	16
+#define POOL_CLASSES		16
+
+struct l_Pools {
+  Common::MemoryPool *pools[POOL_CLASSES];
+  size_t blocks;  /* number of blocks in use, and one while the state is created */
+};
+
+static size_t l_sizeclass (size_t size) {
+  return (size + POOL_GRANULARITY - 1) / POOL_GRANULARITY - 1;
+}
+
+static void *l_poolalloc (l_Pools *p, size_t size) {
+  size_t c = l_sizeclass(size);
+  if (c >= POOL_CLASSES)
+    return malloc(size);
+  if (!p->pools[c])
+    p->pools[c] = new Common::MemoryPool((c + 1) * POOL_GRANULARITY);
+  return p->pools[c]->allocChunk();
+}
+
+static void l_poolfree (l_Pools *p, void *ptr, size_t size) {
+  size_t c = l_sizeclass(size);
+  if (c >= POOL_CLASSES)
+    free(ptr);
+  else
+    p->pools[c]->freeChunk(ptr);
+}
+
+static void l_release (l_Pools *p) {
+  if (--p->blocks == 0) {
+    for (int i = 0; i < POOL_CLASSES; i++)
+      delete p->pools[i];
+    delete p;
+  }
+}
+
 static void *l_alloc (void *ud, void *ptr, size_t osize, size_t nsize) {
-  (void)ud;
-  (void)osize;
+  l_Pools *p = (l_Pools *)ud;
   if (nsize == 0) {
-    free(ptr);
+    if (ptr) {
+      l_poolfree(p, ptr, osize);
+      l_release(p);
+    }
     return NULL;
   }
-  else
+  if (ptr == NULL) {
+    void *block = l_poolalloc(p, nsize);
+    if (block)
+      p->blocks++;
+    return block;
+  }
+  size_t oc = l_sizeclass(osize), nc = l_sizeclass(nsize);
+  if (oc >= POOL_CLASSES && nc >= POOL_CLASSES)
     return realloc(ptr, nsize);
+  if (oc == nc)
+    return ptr;
+  void *block = l_poolalloc(p, nsize);
+  if (block) {
+    memcpy(block, ptr, osize < nsize ? osize : nsize);
+    l_poolfree(p, ptr, osize);
+  }
+  return block;
 }
 
 
@@ -651,7 +713,10 @@ static int panic (lua_State *L) {
 
 
 LUALIB_API lua_State *luaL_newstate (void) {
-  lua_State *L = lua_newstate(l_alloc, NULL);
+  l_Pools *p = new l_Pools();
+  p->blocks = 1;
+  lua_State *L = lua_newstate(l_alloc, p);
   if (L) lua_atpanic(L, &panic);
+  l_release(p);  /* from now on, the pools go with the last block */
   return L;
 }
@@ -95,6 +95,11 @@ MacFinderExtendedInfoData MacFinderExtendedInfo::toData() const {
 #define MBI_FLAGSLOW 101
 #define MAXNAMELEN 63
 
+// Number of files whose resource fork location is remembered
+#define MAX_CACHED_FORKS 1024
+
+MacResManager::ForkCache *MacResManager::_forkCache = nullptr;
+
 MacResManager::MacResManager() {
 	_stream = nullptr;
 	// _baseFileName cleared by String constructor
@@ -108,9 +113,6 @@ MacResManager::MacResManager() {
 	_dataLength = 0;
 	_mapOffset = 0;
 	_mapLength = 0;
-	_resMap.reset();
-	_resTypes = nullptr;
-	_resLists = nullptr;
 }
 
 MacResManager::~MacResManager() {
@@ -121,18 +123,8 @@ void MacResManager::close() {
 	_resForkOffset = -1;
 	_mode = kResForkNone;
 
-	for (int i = 0; i < _resMap.numTypes; i++) {
-		for (int j = 0; j < _resTypes[i].items; j++)
-			if (_resLists[i][j].nameOffset != -1)
-				delete[] _resLists[i][j].name;
-
-		delete[] _resLists[i];
-	}
-
-	delete[] _resLists; _resLists = nullptr;
-	delete[] _resTypes; _resTypes = nullptr;
+	_map.reset();
 	delete _stream; _stream = nullptr;
-	_resMap.numTypes = 0;
 }
 
 bool MacResManager::hasResFork() const {
@@ -172,7 +164,10 @@ bool MacResManager::open(const Path &fileName) {
 	return open(fileName, SearchMan);
 }
 
-SeekableReadStream *MacResManager::openAppleDoubleWithAppleOrOSXNaming(Archive& archive, const Path &fileName) {
+SeekableReadStream *MacResManager::openAppleDoubleWithAppleOrOSXNaming(Archive& archive, const Path &fileName, Path *foundPath) {
+	if (foundPath)
+		*foundPath = constructAppleDoubleName(fileName);
+
 	SeekableReadStream *stream = archive.createReadStreamForMember(constructAppleDoubleName(fileName));
 	if (stream)
 		return stream;
@@ -207,8 +202,14 @@ SeekableReadStream *MacResManager::openAppleDoubleWithAppleOrOSXNaming(Archive&
 
 		Common::Path newPath = Common::Path::joinComponents(newComponents);
 		stream = archive.createReadStreamForMember(newPath);
+		if (foundPath)
+			*foundPath = newPath;
 
 		if (!stream) {
+			// Not in the archive, so it can't be opened from there again
+			if (foundPath)
+				foundPath->clear();
+
 			Common::FSNode fsn(newPath);
 			if (fsn.exists()) {
 				stream = fsn.createReadStream();
@@ -232,6 +233,11 @@ SeekableReadStream *MacResManager::openAppleDoubleWithAppleOrOSXNaming(Archive&
 bool MacResManager::open(const Path &fileName, Archive &archive) {
 	close();
 
+	// Reopen the fork where it was found before, if it didn't change since
+	const String cacheKey = String::format("%p:", (void *)&archive) + fileName.toString();
+	if (openCachedFork(fileName, archive, cacheKey))
+		return true;
+
 	SeekableReadStream *stream = nullptr;
 
 	// Our preference is as following:
@@ -242,8 +248,6 @@ bool MacResManager::open(const Path &fileName, Archive &archive) {
 
 	// If this is in a Mac archive, then the resource fork will always be in the alt stream
 	if (archiveMember && archiveMember->isInMacArchive()) {
-		_baseFileName = fileName;
-
 		stream = archive.createReadStreamForMemberAltStream(fileName, AltStreamType::MacResourceFork);
 		if (stream && !loadFromRawFork(stream)) {
 			delete stream;
@@ -251,7 +255,7 @@ bool MacResManager::open(const Path &fileName, Archive &archive) {
 		}
 
 		// If the archive member exists, then the file exists, but has no res fork, so we should return true
-		return true;
+		return finishOpen(fileName, cacheKey, fileName, true);
 	}
 
 	// Prefer standalone files first, starting with raw forks
@@ -262,24 +266,18 @@ bool MacResManager::open(const Path &fileName, Archive &archive) {
 		bool appleDouble = (stream->readUint32BE() == 0x00051607);
 		stream->seek(0);
 
-		if (appleDouble && loadFromAppleDouble(stream)) {
-			_baseFileName = fileName;
-			return true;
-		}
+		if (appleDouble && loadFromAppleDouble(stream))
+			return finishOpen(fileName, cacheKey, fileName.append(".rsrc"), false);
 
-		if (loadFromRawFork(stream)) {
-			_baseFileName = fileName;
-			return true;
-		}
+		if (loadFromRawFork(stream))
+			return finishOpen(fileName, cacheKey, fileName.append(".rsrc"), false);
 	}
 	delete stream;
 
 	// Check .bin for MacBinary next
 	stream = archive.createReadStreamForMember(fileName.append(".bin"));
-	if (stream && loadFromMacBinary(stream)) {
-		_baseFileName = fileName;
-		return true;
-	}
+	if (stream && loadFromMacBinary(stream))
+		return finishOpen(fileName, cacheKey, fileName.append(".bin"), false);
 	delete stream;
 
 	// Maybe file is in MacBinary but without .bin extension?
@@ -288,10 +286,8 @@ bool MacResManager::open(const Path &fileName, Archive &archive) {
 		stream = archiveMember->createReadStream();
 		if (stream && isMacBinary(*stream)) {
 			stream->seek(0);
-			if (loadFromMacBinary(stream)) {
-				_baseFileName = fileName;
-				return true;
-			}
+			if (loadFromMacBinary(stream))
+				return finishOpen(fileName, cacheKey, fileName, false);
 		}
 	} else
 		stream = nullptr;
@@ -302,19 +298,16 @@ bool MacResManager::open(const Path &fileName, Archive &archive) {
 
 	// Then try for AppleDouble using Apple's naming
 	// As they are created silently from plain files (e.g. from a macbinary) they are pretty low quality often.
-	stream = openAppleDoubleWithAppleOrOSXNaming(archive, fileName);
-	if (stream && loadFromAppleDouble(stream)) {
-		_baseFileName = fileName;
-		return true;
-	}
+	Path appleDoublePath;
+	stream = openAppleDoubleWithAppleOrOSXNaming(archive, fileName, &appleDoublePath);
+	if (stream && loadFromAppleDouble(stream))
+		return finishOpen(fileName, cacheKey, appleDoublePath, false);
 	delete stream;
 
 	// Try alternate stream
 	stream = archive.createReadStreamForMemberAltStream(fileName, AltStreamType::MacResourceFork);
-	if (stream && loadFromRawFork(stream)) {
-		_baseFileName = fileName;
-		return true;
-	}
+	if (stream && loadFromRawFork(stream))
+		return finishOpen(fileName, cacheKey, fileName, true);
 	delete stream;
 
 
@@ -334,10 +327,8 @@ bool MacResManager::open(const Path &fileName, Archive &archive) {
 
 		Path fullPath = archiveMember.get()->getPathInArchive().join("/..namedfork/rsrc");
 		SeekableReadStream *macResForkRawStream = archive.createReadStreamForMember(fullPath);
-		if (!isMacBinaryFile && macResForkRawStream && loadFromRawFork(macResForkRawStream)) {
-			_baseFileName = fileName;
-			return true;
-		}
+		if (!isMacBinaryFile && macResForkRawStream && loadFromRawFork(macResForkRawStream))
+			return finishOpen(fileName, cacheKey, fullPath, false);
 
 		delete macResForkRawStream;
 	}
@@ -353,6 +344,85 @@ bool MacResManager::open(const Path &fileName, Archive &archive) {
 	return false;
 }
 
+bool MacResManager::openCachedFork(const Path &fileName, Archive &archive, const String &cacheKey) {
+	if (!_forkCache)
+		return false;
+
+	ForkCache::iterator it = _forkCache->find(cacheKey);
+	if (it == _forkCache->end())
+		return false;
+
+	const ForkLocation &location = it->_value;
+	SeekableReadStream *stream;
+	if (location.altStream)
+		stream = archive.createReadStreamForMemberAltStream(location.path, AltStreamType::MacResourceFork);
+	else
+		stream = archive.createReadStreamForMember(location.path);
+
+	// Check that the fork is still the one which was found
+	bool unchanged = stream && stream->size() == location.streamSize && stream->seek(location.resForkOffset);
+	if (unchanged) {
+		const uint32 dataOffset = stream->readUint32BE() + location.resForkOffset;
+		const uint32 mapOffset = stream->readUint32BE() + location.resForkOffset;
+		const uint32 dataLength = stream->readUint32BE();
+		const uint32 mapLength = stream->readUint32BE();
+
+		unchanged = !stream->eos() && !stream->err() &&
+			dataOffset == location.dataOffset && mapOffset == location.mapOffset &&
+			dataLength == location.dataLength && mapLength == location.mapLength;
+	}
+
+	if (!unchanged) {
+		delete stream;
+		_forkCache->erase(it);
+		return false;
+	}
+
+	_stream = stream;
+	_baseFileName = fileName;
+	_mode = location.mode;
+	_resForkOffset = location.resForkOffset;
+	_resForkSize = location.resForkSize;
+	_dataOffset = location.dataOffset;
+	_dataLength = location.dataLength;
+	_mapOffset = location.mapOffset;
+	_mapLength = location.mapLength;
+	_map = location.map;
+	return true;
+}
+
+bool MacResManager::finishOpen(const Path &fileName, const String &cacheKey, const Path &forkPath, bool altStream) {
+	_baseFileName = fileName;
+
+	// Only forks which can be opened again from the archive are remembered
+	if (!hasResFork() || !_map || forkPath.empty())
+		return true;
+
+	if (!_forkCache)
+		_forkCache = new ForkCache();
+	else if (_forkCache->size() >= MAX_CACHED_FORKS)
+		_forkCache->clear();
+
+	ForkLocation &location = (*_forkCache)[cacheKey];
+	location.path = forkPath;
+	location.altStream = altStream;
+	location.mode = _mode;
+	location.resForkOffset = _resForkOffset;
+	location.resForkSize = _resForkSize;
+	location.streamSize = _stream->size();
+	location.dataOffset = _dataOffset;
+	location.dataLength = _dataLength;
+	location.mapOffset = _mapOffset;
+	location.mapLength = _mapLength;
+	location.map = _map;
+	return true;
+}
+
+void MacResManager::clearForkCache() {
+	delete _forkCache;
+	_forkCache = nullptr;
+}
+
 SeekableReadStream * MacResManager::openFileOrDataFork(const Path &fileName) {
 	return openFileOrDataFork(fileName, SearchMan);
 }
@@ -836,23 +906,36 @@ bool MacResManager::load(SeekableReadStream *stream) {
 	return true;
 }
 
+int MacResManager::findResource(uint32 typeID, uint16 resID) const {
+	if (!_map)
+		return -1;
+
+	HashMap<uint32, uint>::const_iterator type = _map->typeIndices.find(typeID);
+	if (type == _map->typeIndices.end())
+		return -1;
+
+	HashMap<uint32, uint>::const_iterator res = _map->resourceIndices.find(type->_value << 16 | resID);
+	if (res == _map->resourceIndices.end())
+		return -1;
+
+	return res->_value;
+}
+
 MacResIDArray MacResManager::getResIDArray(uint32 typeID) {
-	int typeNum = -1;
 	MacResIDArray res;
 
-	for (int i = 0; i < _resMap.numTypes; i++)
-		if (_resTypes[i].id == typeID) {
-			typeNum = i;
-			break;
-		}
+	if (!_map)
+		return res;
 
-	if (typeNum == -1)
+	HashMap<uint32, uint>::const_iterator typeNum = _map->typeIndices.find(typeID);
+	if (typeNum == _map->typeIndices.end())
 		return res;
 
-	res.resize(_resTypes[typeNum].items);
+	const ResType &type = _map->types[typeNum->_value];
+	res.resize(type.items);
 
-	for (int i = 0; i < _resTypes[typeNum].items; i++)
-		res[i] = _resLists[typeNum][i].id;
+	for (int i = 0; i < type.items; i++)
+		res[i] = _map->resources[type.first + i].id;
 
 	return res;
 }
@@ -860,59 +943,31 @@ MacResIDArray MacResManager::getResIDArray(uint32 typeID) {
 MacResTagArray MacResManager::getResTagArray() {
 	MacResTagArray tagArray;
 
-	if (!hasResFork())
+	if (!hasResFork() || !_map)
 		return tagArray;
 
-	tagArray.resize(_resMap.numTypes);
+	tagArray.resize(_map->types.size());
 
-	for (uint32 i = 0; i < _resMap.numTypes; i++)
-		tagArray[i] = _resTypes[i].id;
+	for (uint32 i = 0; i < _map->types.size(); i++)
+		tagArray[i] = _map->types[i].id;
 
 	return tagArray;
 }
 
 String MacResManager::getResName(uint32 typeID, uint16 resID) const {
-	int typeNum = -1;
-
-	for (int i = 0; i < _resMap.numTypes; i++)
-		if (_resTypes[i].id == typeID) {
-			typeNum = i;
-			break;
-		}
-
-	if (typeNum == -1)
+	int resNum = findResource(typeID, resID);
+	if (resNum == -1)
 		return "";
 
-	for (int i = 0; i < _resTypes[typeNum].items; i++)
-		if (_resLists[typeNum][i].id == resID)
-			return _resLists[typeNum][i].name;
-
-	return "";
+	return _map->resources[resNum].name;
 }
 
 SeekableReadStream *MacResManager::getResource(uint32 typeID, uint16 resID) {
-	int typeNum = -1;
-	int resNum = -1;
-
-	for (int i = 0; i < _resMap.numTypes; i++)
-		if (_resTypes[i].id == typeID) {
-			typeNum = i;
-			break;
-		}
-
-	if (typeNum == -1)
-		return nullptr;
-
-	for (int i = 0; i < _resTypes[typeNum].items; i++)
-		if (_resLists[typeNum][i].id == resID) {
-			resNum = i;
-			break;
-		}
-
+	int resNum = findResource(typeID, resID);
 	if (resNum == -1)
 		return nullptr;
 
-	_stream->seek(_dataOffset + _resLists[typeNum][resNum].dataOffset);
+	_stream->seek(_dataOffset + _map->resources[resNum].dataOffset);
 	uint32 len = _stream->readUint32BE();
 
 	// Ignore resources with 0 length
@@ -923,18 +978,20 @@ SeekableReadStream *MacResManager::getResource(uint32 typeID, uint16 resID) {
 }
 
 SeekableReadStream *MacResManager::getResource(const String &fileName) {
-	for (uint32 i = 0; i < _resMap.numTypes; i++) {
-		for (uint32 j = 0; j < _resTypes[i].items; j++) {
-			if (_resLists[i][j].nameOffset != -1 && fileName.equalsIgnoreCase(_resLists[i][j].name)) {
-				_stream->seek(_dataOffset + _resLists[i][j].dataOffset);
-				uint32 len = _stream->readUint32BE();
+	if (!_map)
+		return nullptr;
 
-				// Ignore resources with 0 length
-				if (!len)
-					return nullptr;
+	for (uint32 i = 0; i < _map->resources.size(); i++) {
+		const Resource &res = _map->resources[i];
+		if (res.nameOffset != -1 && fileName.equalsIgnoreCase(res.name)) {
+			_stream->seek(_dataOffset + res.dataOffset);
+			uint32 len = _stream->readUint32BE();
 
-				return _stream->readStream(len);
-			}
+			// Ignore resources with 0 length
+			if (!len)
+				return nullptr;
+
+			return _stream->readStream(len);
 		}
 	}
 
@@ -942,13 +999,18 @@ SeekableReadStream *MacResManager::getResource(const String &fileName) {
 }
 
 SeekableReadStream *MacResManager::getResource(uint32 typeID, const String &fileName) {
-	for (uint32 i = 0; i < _resMap.numTypes; i++) {
-		if (_resTypes[i].id != typeID)
+	if (!_map)
+		return nullptr;
+
+	for (uint32 i = 0; i < _map->types.size(); i++) {
+		const ResType &type = _map->types[i];
+		if (type.id != typeID)
 			continue;
 
-		for (uint32 j = 0; j < _resTypes[i].items; j++) {
-			if (_resLists[i][j].nameOffset != -1 && fileName.equalsIgnoreCase(_resLists[i][j].name)) {
-				_stream->seek(_dataOffset + _resLists[i][j].dataOffset);
+		for (uint32 j = type.first; j < type.first + type.items; j++) {
+			const Resource &res = _map->resources[j];
+			if (res.nameOffset != -1 && fileName.equalsIgnoreCase(res.name)) {
+				_stream->seek(_dataOffset + res.dataOffset);
 				uint32 len = _stream->readUint32BE();
 
 				// Ignore resources with 0 length
@@ -964,93 +1026,85 @@ SeekableReadStream *MacResManager::getResource(uint32 typeID, const String &file
 }
 
 uint32 MacResManager::getResLength(uint32 typeID, uint16 resID) {
-	int typeNum = -1;
-	int resNum = -1;
-
-	for (int i = 0; i < _resMap.numTypes; i++)
-		if (_resTypes[i].id == typeID) {
-			typeNum = i;
-			break;
-		}
-
-	if (typeNum == -1)
-		return 0;
-
-	for (int i = 0; i < _resTypes[typeNum].items; i++)
-		if (_resLists[typeNum][i].id == resID) {
-			resNum = i;
-			break;
-		}
-
+	int resNum = findResource(typeID, resID);
 	if (resNum == -1)
 		return 0;
 
-	_stream->seek(_dataOffset + _resLists[typeNum][resNum].dataOffset);
+	_stream->seek(_dataOffset + _map->resources[resNum].dataOffset);
 	uint32 len = _stream->readUint32BE();
 
 	return len;
 }
 
 void MacResManager::readMap() {
+	_map.reset(new ResourceMap());
+	ResMap &header = _map->header;
+
 	_stream->seek(_mapOffset + 22);
 
-	_resMap.resAttr = _stream->readUint16BE();
-	_resMap.typeOffset = _stream->readUint16BE();
-	_resMap.nameOffset = _stream->readUint16BE();
-	_resMap.numTypes = _stream->readUint16BE();
-	_resMap.numTypes++;
+	header.resAttr = _stream->readUint16BE();
+	header.typeOffset = _stream->readUint16BE();
+	header.nameOffset = _stream->readUint16BE();
+	header.numTypes = _stream->readUint16BE();
+	header.numTypes++;
+
+	_stream->seek(_mapOffset + header.typeOffset + 2);
 
-	_stream->seek(_mapOffset + _resMap.typeOffset + 2);
-	_resTypes = new ResType[_resMap.numTypes];
+	debug(8, "numResTypes: %d total size: %u", header.numTypes, unsigned(_stream->size()));
 
-	debug(8, "numResTypes: %d total size: %u", _resMap.numTypes, unsigned(_stream->size()));
+	if (_stream->pos() + header.numTypes * 8 > _stream->size())
+		error("MacResManager::readMap(): incorrect resource map, too big, %d types", header.numTypes);
 
-	if (_stream->pos() + _resMap.numTypes * 8 > _stream->size())
-		error("MacResManager::readMap(): incorrect resource map, too big, %d types", _resMap.numTypes);
+	_map->types.resize(header.numTypes);
+	uint32 totalItems = 0;
 
-	int totalItems = 0;
+	for (uint i = 0; i < header.numTypes; i++) {
+		ResType &type = _map->types[i];
+		type.id = _stream->readUint32BE();
+		type.items = _stream->readUint16BE();
+		type.offset = _stream->readUint16BE();
+		type.items++;
+		type.first = totalItems;
 
-	for (int i = 0; i < _resMap.numTypes; i++) {
-		_resTypes[i].id = _stream->readUint32BE();
-		_resTypes[i].items = _stream->readUint16BE();
-		_resTypes[i].offset = _stream->readUint16BE();
-		_resTypes[i].items++;
+		totalItems += type.items;
 
-		totalItems += _resTypes[i].items;
+		// Lookups find the first type with an ID, like a search would
+		if (!_map->typeIndices.contains(type.id))
+			_map->typeIndices[type.id] = i;
 
-		debug(8, "resType: <%s> items: %d offset: %d (0x%x)", tag2str(_resTypes[i].id), _resTypes[i].items,  _resTypes[i].offset, _resTypes[i].offset);
+		debug(8, "resType: <%s> items: %d offset: %d (0x%x)", tag2str(type.id), type.items, type.offset, type.offset);
 	}
 
 	if (totalItems * 4 > _stream->size())
 		error("MacResManager::readMap(): incorrect resource map, too big, %d total items", totalItems);
 
-	_resLists = new ResPtr[_resMap.numTypes];
+	_map->resources.resize(totalItems);
 
-	for (int i = 0; i < _resMap.numTypes; i++) {
-		_resLists[i] = new Resource[_resTypes[i].items];
-		_stream->seek(_resTypes[i].offset + _mapOffset + _resMap.typeOffset);
+	for (uint i = 0; i < header.numTypes; i++) {
+		const ResType &type = _map->types[i];
+		_stream->seek(type.offset + _mapOffset + header.typeOffset);
 
-		for (int j = 0; j < _resTypes[i].items; j++) {
-			ResPtr resPtr = _resLists[i] + j;
+		for (uint j = type.first; j < type.first + type.items; j++) {
+			Resource &res = _map->resources[j];
 
-			resPtr->id = _stream->readUint16BE();
-			resPtr->nameOffset = _stream->readUint16BE();
-			resPtr->dataOffset = _stream->readUint32BE();
+			res.id = _stream->readUint16BE();
+			res.nameOffset = _stream->readUint16BE();
+			res.dataOffset = _stream->readUint32BE();
 			_stream->readUint32BE();
-			resPtr->name = nullptr;
 
-			resPtr->attr = resPtr->dataOffset >> 24;
-			resPtr->dataOffset &= 0xFFFFFF;
-		}
+			res.attr = res.dataOffset >> 24;
+			res.dataOffset &= 0xFFFFFF;
 
-		for (int j = 0; j < _resTypes[i].items; j++) {
-			if (_resLists[i][j].nameOffset != -1) {
-				_stream->seek(_resLists[i][j].nameOffset + _mapOffset + _resMap.nameOffset);
+			const uint32 key = i << 16 | res.id;
+			if (!_map->resourceIndices.contains(key))
+				_map->resourceIndices[key] = j;
+		}
 
-				byte len = _stream->readByte();
-				_resLists[i][j].name = new char[len + 1];
-				_resLists[i][j].name[len] = 0;
-				_stream->read(_resLists[i][j].name, len);
+		for (uint j = type.first; j < type.first + type.items; j++) {
+			Resource &res = _map->resources[j];
+			if (res.nameOffset != -1) {
+				_stream->seek(res.nameOffset + _mapOffset + header.nameOffset);
+				res.name = _stream->readPascalString(false);
 			}
 		}
 	}
@@ -1085,9 +1139,13 @@ void MacResManager::dumpRaw() {
 	uint dataSize = 0;
 	Common::DumpFile out;
 
-	for (int i = 0; i < _resMap.numTypes; i++) {
-		for (int j = 0; j < _resTypes[i].items; j++) {
-			_stream->seek(_dataOffset + _resLists[i][j].dataOffset);
+	if (!_map)
+		return;
+
+	for (uint i = 0; i < _map->types.size(); i++) {
+		const ResType &type = _map->types[i];
+		for (int j = 0; j < type.items; j++) {
+			_stream->seek(_dataOffset + _map->resources[type.first + j].dataOffset);
 			uint32 len = _stream->readUint32BE();
 
 			if (dataSize < len) {
@@ -1096,7 +1154,7 @@ void MacResManager::dumpRaw() {
 				dataSize = len;
 			}
 
-			Common::String filename = Common::String::format("./dumps/%s-%s-%d", _baseFileName.baseName().c_str(), tag2str(_resTypes[i].id), j);
+			Common::String filename = Common::String::format("./dumps/%s-%s-%d", _baseFileName.baseName().c_str(), tag2str(type.id), j);
 			_stream->read(data, len);
 
 			if (!out.open(Common::Path(filename, '/'))) {
@@ -26,6 +26,9 @@
 
 #include "common/array.h"
 #include "common/fs.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/ptr.h"
 #include "common/rect.h"
 #include "common/str.h"
 #include "common/str-array.h"
@@ -314,6 +317,16 @@ public:
 	};
 	static MacVers *parseVers(SeekableReadStream *vvers);
 
+	/**
+	 * Forget where the resource forks of files were found.
+	 *
+	 * Opening a file remembers where its resource fork was found, and its
+	 * parsed resource map, for all managers. They are checked against the
+	 * fork when a file is opened again, but files which gained a resource
+	 * fork of higher preference in the meantime need the cache to be cleared.
+	 */
+	static void clearForkCache();
+
 private:
 	SeekableReadStream *_stream;
 	Path _baseFileName;
@@ -338,7 +351,7 @@ private:
 	static Path constructAppleDoubleName(const Path &name);
 	static Path disassembleAppleDoubleName(const Path &name, bool *isAppleDouble);
 
-	static SeekableReadStream *openAppleDoubleWithAppleOrOSXNaming(Archive& archive, const Path &fileName);
+	static SeekableReadStream *openAppleDoubleWithAppleOrOSXNaming(Archive& archive, const Path &fileName, Path *foundPath = nullptr);
 
 	/**
 	 * Do a sanity check whether the given stream is a raw resource fork.
@@ -347,7 +360,7 @@ private:
 	 */
 	static bool isRawFork(SeekableReadStream &stream);
 
-	enum {
+	enum ForkMode {
 		kResForkNone = 0,
 		kResForkRaw,
 		kResForkMacBinary,
@@ -356,6 +369,10 @@ private:
 
 	void readMap();
 
+	bool openCachedFork(const Path &fileName, Archive &archive, const String &cacheKey);
+	bool finishOpen(const Path &fileName, const String &cacheKey, const Path &forkPath, bool altStream);
+	int findResource(uint32 typeID, uint16 resID) const;
+
 	struct ResMap {
 		uint16 resAttr;
 		uint16 typeOffset;
@@ -376,6 +393,7 @@ private:
 		uint32 id;
 		uint16 items;
 		uint16 offset;
+		uint32 first; ///< Index of the first resource of this type
 	};
 
 	struct Resource {
@@ -383,10 +401,35 @@ private:
 		int16 nameOffset;
 		byte attr;
 		uint32 dataOffset;
-		char *name;
+		String name;
+	};
+
+	/** A parsed resource map, which is shared by all managers which opened its fork. */
+	struct ResourceMap {
+		ResMap header;
+		Array<ResType> types;
+		Array<Resource> resources; ///< Resources of all types, in the order of the types
+		HashMap<uint32, uint> typeIndices; ///< Type ID to index in types
+		HashMap<uint32, uint> resourceIndices; ///< Type index << 16 | resource ID to index in resources
+	};
+
+	/** Where the resource fork of a file was found. */
+	struct ForkLocation {
+		Path path;
+		bool altStream;
+		ForkMode mode;
+		int32 resForkOffset;
+		uint32 resForkSize;
+		int64 streamSize;
+		uint32 dataOffset;
+		uint32 dataLength;
+		uint32 mapOffset;
+		uint32 mapLength;
+		SharedPtr<ResourceMap> map;
 	};
 
-	typedef Resource *ResPtr;
+	typedef HashMap<String, ForkLocation, IgnoreCase_Hash, IgnoreCase_EqualTo> ForkCache;
+	static ForkCache *_forkCache;
 
 	int32 _resForkOffset;
 	uint32 _resForkSize;
@@ -395,9 +438,7 @@ private:
 	uint32 _dataLength;
 	uint32 _mapOffset;
 	uint32 _mapLength;
-	ResMap _resMap;
-	ResType *_resTypes;
-	ResPtr  *_resLists;
+	SharedPtr<ResourceMap> _map;
 };
 
 /** @} */
@@ -26,6 +26,7 @@
  */
 
 #include "common/md5.h"
+#include "common/array.h"
 #include "common/endian.h"
 #include "common/str.h"
 #include "common/stream.h"
@@ -243,38 +244,58 @@ void md5_finish(md5_context *ctx, uint8 digest[16]) {
 }
 
 
+// Size of the blocks in which streams are read
+#define MD5_READ_SIZE 65536
+
 bool computeStreamMD5(ReadStream &stream, uint8 digest[16], uint32 length) {
+	return computeStreamMD5s(stream, (uint8 (*)[16])digest, &length, 1);
+}
+
+bool computeStreamMD5s(ReadStream &stream, uint8 (*digests)[16], const uint32 *lengths, uint count) {
 
 #ifdef DISABLE_MD5
-	memset(digest, 0, 16);
+	memset(digests, 0, count * 16);
 #else
-	md5_context ctx;
-	int i;
-	unsigned char buf[1000];
-	bool restricted = (length != 0);
-	uint32 readlen;
-
-	if (!restricted || sizeof(buf) <= length)
-		readlen = sizeof(buf);
-	else
-		readlen = length;
-
-	md5_starts(&ctx);
-
-	while ((i = stream.read(buf, readlen)) > 0) {
-		md5_update(&ctx, buf, i);
-
-		if (restricted) {
-			length -= i;
-			if (length == 0)
-				break;
+	Array<md5_context> ctx;
+	ctx.resize(count);
+
+	bool restricted = true;
+	uint32 longest = 0;
+	for (uint n = 0; n < count; n++) {
+		md5_starts(&ctx[n]);
+
+		if (lengths[n] == 0)
+			restricted = false;
+		else
+			longest = MAX(longest, lengths[n]);
+	}
 
-			if (sizeof(buf) > length)
-				readlen = length;
+	// Short checksums, as used by the detection, don't need a large buffer
+	Array<uint8> buf;
+	buf.resize(restricted ? MIN<uint32>(longest, MD5_READ_SIZE) : MD5_READ_SIZE);
+
+	uint64 pos = 0;
+	while (!restricted || pos < longest) {
+		uint32 readlen = buf.size();
+		if (restricted && longest - pos < readlen)
+			readlen = longest - pos;
+
+		uint32 i = stream.read(buf.data(), readlen);
+		if (i == 0)
+			break;
+
+		for (uint n = 0; n < count; n++) {
+			if (lengths[n] == 0)
+				md5_update(&ctx[n], buf.data(), i);
+			else if (pos < lengths[n])
+				md5_update(&ctx[n], buf.data(), (uint32)MIN<uint64>(i, lengths[n] - pos));
 		}
+
+		pos += i;
 	}
 
-	md5_finish(&ctx, digest);
+	for (uint n = 0; n < count; n++)
+		md5_finish(&ctx[n], digests[n]);
 #endif
 	return true;
 }
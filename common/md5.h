@@ -50,6 +50,17 @@ class String;
  */
 bool computeStreamMD5(ReadStream &stream, uint8 digest[16], uint32 length = 0);
 
+/**
+ * Compute the MD5 checksums of several leading parts of the content of the
+ * given ReadStream, while reading it only once.
+ * @param[in] stream	the stream of whose data the MD5s are computed
+ * @param[out] digests	the computed MD5 checksums, one for each length
+ * @param[in] lengths	the number of bytes for which to compute each checksum; 0 means all
+ * @param[in] count	the number of checksums to compute
+ * @return true on success, false if an error occurred
+ */
+bool computeStreamMD5s(ReadStream &stream, uint8 (*digests)[16], const uint32 *lengths, uint count);
+
 /**
  * Compute the MD5 checksum of the content of the given ReadStream.
  * The 128 bit MD5 checksum is converted to a human readable
@@ -22,6 +22,8 @@
 #ifndef COMMON_MEMSTREAM_H
 #define COMMON_MEMSTREAM_H
 
+#include "common/noncopyable.h"
+#include "common/ptr.h"
 #include "common/stream.h"
 #include "common/types.h"
 #include "common/util.h"
@@ -96,6 +98,60 @@ public:
 };
 
 
+/**
+ * A read-only memory mapping of a file. The file system backends derive from
+ * this, and release the mapping in their destructor.
+ */
+class FileMapping : NonCopyable {
+public:
+	virtual ~FileMapping() {}
+
+	const byte *getData() const { return _data; }
+	uint32 getSize() const { return _size; }
+
+protected:
+	FileMapping(const byte *data, uint32 size) : _data(data), _size(size) {}
+
+	const byte *_data;
+	uint32 _size;
+};
+
+/**
+ * A MemoryReadStream on a file mapped into memory, as returned by
+ * FSNode::createMappedReadStream().
+ *
+ * Reading from it does not involve any copying, and its data can be accessed
+ * directly. The mapping is kept alive for as long as a stream or a sub-view
+ * on it exists.
+ */
+class MappedReadStream : public MemoryReadStream {
+public:
+	MappedReadStream(const SharedPtr<FileMapping> &mapping, uint32 offset, uint32 size) :
+		MemoryReadStream(mapping->getData() + offset, size),
+		_mapping(mapping),
+		_offset(offset) {
+		assert(offset <= mapping->getSize() && size <= mapping->getSize() - offset);
+	}
+
+	/** Return the data of the stream, which stays valid during the whole lifetime of the stream. */
+	const byte *getMappedData() const { return _mapping->getData() + _offset; }
+
+	/**
+	 * Create a stream on part of this one, sharing the same mapping.
+	 *
+	 * @return The new stream, or nullptr if the range is outside of this stream.
+	 */
+	MappedReadStream *createSubView(uint32 offset, uint32 size) const {
+		if (offset > this->size() || size > this->size() - offset)
+			return nullptr;
+		return new MappedReadStream(_mapping, _offset + offset, size);
+	}
+
+private:
+	SharedPtr<FileMapping> _mapping;
+	uint32 _offset;
+};
+
 /**
  * This is a MemoryReadStream subclass which adds non-endian
  * read methods whose endianness is set on the stream creation.
@@ -0,0 +1,163 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef USE_MEMORY_TRACKING
+
+#include "common/memtracker.h"
+#include "common/atomic.h"
+#include "common/textconsole.h"
+#include "common/str.h"
+
+namespace Common {
+
+namespace {
+
+// Plain variables, so that they are ready before any global constructor runs
+size_t g_current[kMemoryTagCount];
+size_t g_peak[kMemoryTagCount];
+size_t g_allocations[kMemoryTagCount];
+size_t g_budget[kMemoryTagCount];
+
+const char *const g_tagNames[kMemoryTagCount] = {
+	"untagged",
+	"resources",
+	"audio",
+	"video",
+	"gui",
+	"fonts",
+	"tinygl"
+};
+
+/** Stored in front of the memory returned by trackedMalloc(). */
+struct AllocationHeader {
+	size_t size;
+	MemoryTag tag;
+};
+
+// Keeps the memory after the header aligned for any type
+const size_t kHeaderSize = 16;
+
+} // End of anonymous namespace
+
+void MemoryTracker::add(MemoryTag tag, size_t size) {
+	assert(tag < kMemoryTagCount);
+
+	atomicFetchAdd<size_t>(&g_allocations[tag], 1);
+	const size_t current = atomicFetchAdd(&g_current[tag], size) + size;
+
+	size_t peak = atomicLoad(&g_peak[tag]);
+	while (current > peak && !atomicCompareExchange(&g_peak[tag], peak, current)) {
+	}
+
+	const size_t budget = atomicLoad(&g_budget[tag]);
+	if (budget && current > budget && current - size <= budget)
+		warning("Memory budget of %s exceeded: %u KiB in use, %u KiB allowed",
+		        g_tagNames[tag], (uint)(current / 1024), (uint)(budget / 1024));
+}
+
+void MemoryTracker::remove(MemoryTag tag, size_t size) {
+	assert(tag < kMemoryTagCount);
+	atomicFetchSub(&g_current[tag], size);
+}
+
+void MemoryTracker::getStats(MemoryTag tag, Stats &stats) {
+	assert(tag < kMemoryTagCount);
+	stats.current = atomicLoad(&g_current[tag]);
+	stats.peak = atomicLoad(&g_peak[tag]);
+	stats.allocations = atomicLoad(&g_allocations[tag]);
+	stats.budget = atomicLoad(&g_budget[tag]);
+}
+
+void MemoryTracker::setBudget(MemoryTag tag, size_t budget) {
+	assert(tag < kMemoryTagCount);
+	size_t expected = atomicLoad(&g_budget[tag]);
+	while (!atomicCompareExchange(&g_budget[tag], expected, budget)) {
+	}
+}
+
+void MemoryTracker::resetPeaks() {
+	for (int tag = 0; tag < kMemoryTagCount; tag++) {
+		size_t peak = atomicLoad(&g_peak[tag]);
+		while (!atomicCompareExchange(&g_peak[tag], peak, atomicLoad(&g_current[tag]))) {
+		}
+	}
+}
+
+const char *MemoryTracker::getTagName(MemoryTag tag) {
+	assert(tag < kMemoryTagCount);
+	return g_tagNames[tag];
+}
+
+MemoryTag MemoryTracker::findTag(const char *name) {
+	for (int tag = 0; tag < kMemoryTagCount; tag++) {
+		if (!scumm_stricmp(name, g_tagNames[tag]))
+			return (MemoryTag)tag;
+	}
+	return kMemoryTagCount;
+}
+
+void *trackedMalloc(size_t size, MemoryTag tag) {
+	STATIC_ASSERT(sizeof(AllocationHeader) <= kHeaderSize, AllocationHeader_must_fit_into_kHeaderSize);
+
+	byte *ptr = (byte *)malloc(kHeaderSize + size);
+	if (!ptr)
+		return nullptr;
+
+	AllocationHeader *header = (AllocationHeader *)ptr;
+	header->size = size;
+	header->tag = tag;
+	MemoryTracker::add(tag, size);
+	return ptr + kHeaderSize;
+}
+
+void *trackedRealloc(void *ptr, size_t size, MemoryTag tag) {
+	if (!ptr)
+		return trackedMalloc(size, tag);
+
+	byte *block = (byte *)ptr - kHeaderSize;
+	const AllocationHeader oldHeader = *(AllocationHeader *)block;
+
+	block = (byte *)realloc(block, kHeaderSize + size);
+	if (!block)
+		return nullptr;
+
+	AllocationHeader *header = (AllocationHeader *)block;
+	header->size = size;
+	MemoryTracker::remove(oldHeader.tag, oldHeader.size);
+	MemoryTracker::add(oldHeader.tag, size);
+	return block + kHeaderSize;
+}
+
+void trackedFree(void *ptr) {
+	if (!ptr)
+		return;
+
+	byte *block = (byte *)ptr - kHeaderSize;
+	const AllocationHeader *header = (const AllocationHeader *)block;
+	MemoryTracker::remove(header->tag, header->size);
+	free(block);
+}
+
+} // End of namespace Common
+
+#endif
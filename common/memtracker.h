@@ -0,0 +1,130 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_MEMTRACKER_H
+#define COMMON_MEMTRACKER_H
+
+#include "common/scummsys.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_memtracker Memory tracking
+ * @ingroup common
+ *
+ * @brief Accounting of the memory used per subsystem.
+ *
+ * Memory is counted against a tag, either by allocating it with
+ * trackedMalloc(), or by reporting what a cache holds with MEMORY_TRACK_ADD
+ * and MEMORY_TRACK_REMOVE. Nothing is counted unless memory tracking is
+ * enabled with the --enable-memory-tracking configure option, in which case
+ * the numbers can be seen with the "memory" debugger command.
+ * @{
+ */
+
+/** The subsystems memory can be counted against. */
+enum MemoryTag {
+	kMemoryUntagged,
+	kMemoryEngineResources, ///< Resource managers and caches of the engines.
+	kMemoryAudio,           ///< Audio streams and their buffers.
+	kMemoryVideo,           ///< Decoded video frames.
+	kMemoryGUI,             ///< The launcher, dialogs and the theme.
+	kMemoryFonts,           ///< Font data and glyph caches.
+	kMemoryTinyGL,          ///< The framebuffers and textures of TinyGL.
+	kMemoryTagCount
+};
+
+#ifdef USE_MEMORY_TRACKING
+
+/**
+ * Counts the bytes in use per tag, and the most which were in use at once.
+ * The counters can be updated from any thread without taking a lock.
+ */
+class MemoryTracker {
+public:
+	struct Stats {
+		size_t current;     ///< Bytes in use.
+		size_t peak;        ///< Most bytes in use at once, since the last resetPeaks().
+		size_t allocations; ///< Number of additions so far.
+		size_t budget;      ///< Bytes which may be in use before a warning is printed, 0 for no limit.
+	};
+
+	/** Count @p size more bytes as used by @p tag. */
+	static void add(MemoryTag tag, size_t size);
+
+	/** Count @p size bytes less as used by @p tag. */
+	static void remove(MemoryTag tag, size_t size);
+
+	static void getStats(MemoryTag tag, Stats &stats);
+
+	/**
+	 * Print a warning whenever @p tag starts using more than @p budget
+	 * bytes. A budget of 0 removes the limit.
+	 */
+	static void setBudget(MemoryTag tag, size_t budget);
+
+	/** Make the peaks of all tags start over from their current values. */
+	static void resetPeaks();
+
+	static const char *getTagName(MemoryTag tag);
+
+	/**
+	 * Look up a tag by its name, ignoring the case.
+	 *
+	 * @return The tag, or kMemoryTagCount if there is none with that name.
+	 */
+	static MemoryTag findTag(const char *name);
+};
+
+/** Count @p size more bytes as used by @p tag. */
+#define MEMORY_TRACK_ADD(tag, size) Common::MemoryTracker::add(tag, size)
+
+/** Count @p size bytes less as used by @p tag. */
+#define MEMORY_TRACK_REMOVE(tag, size) Common::MemoryTracker::remove(tag, size)
+
+/**
+ * Allocate memory which is counted against @p tag until it is released
+ * with trackedFree().
+ */
+void *trackedMalloc(size_t size, MemoryTag tag);
+
+/** Resize memory from trackedMalloc(), keeping its tag. @p tag is only used if @p ptr is null. */
+void *trackedRealloc(void *ptr, size_t size, MemoryTag tag);
+
+/** Release memory from trackedMalloc() or trackedRealloc(). */
+void trackedFree(void *ptr);
+
+#else
+
+#define MEMORY_TRACK_ADD(tag, size) do {} while (0)
+#define MEMORY_TRACK_REMOVE(tag, size) do {} while (0)
+
+inline void *trackedMalloc(size_t size, MemoryTag tag) { return malloc(size); }
+inline void *trackedRealloc(void *ptr, size_t size, MemoryTag tag) { return realloc(ptr, size); }
+inline void trackedFree(void *ptr) { free(ptr); }
+
+#endif
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
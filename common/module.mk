@@ -2,6 +2,8 @@ MODULE := common
 
 MODULE_OBJS := \
 	archive.o \
+	arena.o \
+	atom.o \
 	base64.o \
 	btea.o \
 	concatstream.o \
@@ -16,6 +18,7 @@ MODULE_OBJS := \
 	fs.o \
 	gui_options.o \
 	hashmap.o \
+	jobs.o \
 	language.o \
 	localization.o \
 	macresman.o \
@@ -30,11 +33,13 @@ MODULE_OBJS := \
 	random.o \
 	rational.o \
 	rendermode.o \
+	resource_loader.o \
 	rotationmode.o \
 	str.o \
 	stream.o \
 	streamdebug.o \
 	str-base.o \
+	str-builder.o \
 	str-enc.o \
 	encodings/singlebyte.o \
 	system.o \
@@ -59,5 +64,15 @@ MODULE_OBJS += \
 	updates.o
 endif
 
+ifdef USE_PROFILER
+MODULE_OBJS += \
+	profiler.o
+endif
+
+ifdef USE_MEMORY_TRACKING
+MODULE_OBJS += \
+	memtracker.o
+endif
+
 # Include common rules
 include $(srcdir)/rules.mk
@@ -42,6 +42,10 @@ bool Mutex::unlock() {
 	return _mutex->unlock();
 }
 
+bool Mutex::tryLock() {
+	return _mutex->tryLock();
+}
+
 
 #pragma mark -
 
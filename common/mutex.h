@@ -43,6 +43,14 @@ public:
 
 	virtual bool lock() = 0;
 	virtual bool unlock() = 0;
+
+	/**
+	 * Lock the mutex only if that doesn't require waiting for another
+	 * thread. Backends without such a primitive wait, as lock() does.
+	 *
+	 * @return true if the mutex was locked.
+	 */
+	virtual bool tryLock() { return lock(); }
 };
 
 /**
@@ -75,6 +83,8 @@ public:
 
 	bool lock();
 	bool unlock();
+	/** @see MutexInternal::tryLock() */
+	bool tryLock();
 };
 
 /** @} */
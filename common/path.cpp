@@ -433,8 +433,11 @@ Path &Path::appendInPlace(const Path &x) {
 
 	if (_str.empty()) {
 		_str = x._str;
+		copyHashes(x);
 		return *this;
 	}
+
+	invalidateHashes();
 	// From here both paths have data
 
 	if (isEscaped() == x.isEscaped()) {
@@ -480,6 +483,8 @@ Path &Path::appendInPlace(const char *str, char separator) {
 	if (!*str) {
 		return *this;
 	}
+
+	invalidateHashes();
 	if (_str.empty()) {
 		set(str, separator);
 		return *this;
@@ -536,6 +541,7 @@ Path Path::appendComponent(const char *str) const {
 	if (isEscaped()) {
 		// We are escaped, escape str as well
 		Path ret(*this);
+		ret.invalidateHashes();
 		if (addSeparator) {
 			ret._str += SEPARATOR;
 		}
@@ -556,6 +562,7 @@ Path Path::appendComponent(const char *str) const {
 	} else {
 		// No need to escape anything
 		Path ret(*this);
+		ret.invalidateHashes();
 		if (addSeparator) {
 			ret._str += SEPARATOR;
 		}
@@ -570,6 +577,7 @@ Path &Path::joinInPlace(const Path &x) {
 	}
 	if (_str.empty()) {
 		_str = x._str;
+		copyHashes(x);
 		return *this;
 	}
 
@@ -606,6 +614,7 @@ Path &Path::joinInPlace(const char *str, char separator) {
 Path &Path::removeTrailingSeparators() {
 	while (_str.size() > 1 && _str.lastChar() == SEPARATOR) {
 		_str.deleteLastChar();
+		invalidateHashes();
 	}
 	return *this;
 }
@@ -1055,11 +1064,17 @@ static String getIdentifierComponent(const String &in) {
 }
 
 uint Path::hash() const {
-	return hashit(_str.c_str());
+	if (!_hash) {
+		_hash = hashit(_str.c_str());
+	}
+	return _hash;
 }
 
 uint Path::hashIgnoreCase() const {
-	return hashit_lower(_str);
+	if (!_hashIgnoreCase) {
+		_hashIgnoreCase = hashit_lower(_str);
+	}
+	return _hashIgnoreCase;
 }
 
 // This hash algorithm is inspired by a Python proposal to hash for tuples
@@ -1072,6 +1087,10 @@ struct hasher {
 };
 
 uint Path::hashIgnoreCaseAndMac() const {
+	if (_hashIgnoreCaseAndMac) {
+		return _hashIgnoreCaseAndMac;
+	}
+
 	hasher v = { 0x345678, 1000003 };
 	reduceComponents<hasher &>(
 		[](hasher &value, const String &in, bool last) -> hasher & {
@@ -1081,6 +1100,7 @@ uint Path::hashIgnoreCaseAndMac() const {
 			value.mult = (value.mult * 69069);
 			return value;
 		}, v);
+	_hashIgnoreCaseAndMac = v.result;
 	return v.result;
 }
 
@@ -1092,10 +1112,21 @@ bool Path::matchPattern(const Path &pattern) const {
 }
 
 bool Path::equalsIgnoreCase(const Path &other) const {
+	if (hashesDiffer(_hashIgnoreCase, other._hashIgnoreCase)) {
+		return false;
+	}
 	return _str.equalsIgnoreCase(other._str);
 }
 
 bool Path::equalsIgnoreCaseAndMac(const Path &other) const {
+	// Comparing the components normalizes both paths, which the hashes of
+	// map keys have usually already done
+	if (hashesDiffer(_hashIgnoreCaseAndMac, other._hashIgnoreCaseAndMac)) {
+		return false;
+	}
+	if (_str.equals(other._str)) {
+		return true;
+	}
 	return compareComponents(
 		[](const String &x, const String &y) {
 			return getIdentifierComponent(x).equalsIgnoreCase(getIdentifierComponent(y));
@@ -1183,6 +1214,7 @@ String Path::toConfig() const {
 		// If we are escaped, we have forbidden characters which must be encoded
 		// Try to replace all : by SEPARATOR and check if we need puny encoding: if we don't, we are safe
 		Path tmp(*this);
+		tmp.invalidateHashes();
 		tmp._str.replace(':', SEPARATOR);
 #if defined(RISCOS)
 		// RiscOS uses these characters everywhere
@@ -70,6 +70,31 @@ private:
 
 	String _str;
 
+	/**
+	 * The hashes of _str, computed on first use and copied along with it.
+	 * 0 means that a hash isn't known yet, so a hash which really is 0 is
+	 * just never cached. Threads hashing the same path can only store the
+	 * same values. Every change to _str must call invalidateHashes().
+	 */
+	mutable uint _hash;
+	mutable uint _hashIgnoreCase;
+	mutable uint _hashIgnoreCaseAndMac;
+
+	void invalidateHashes() {
+		_hash = _hashIgnoreCase = _hashIgnoreCaseAndMac = 0;
+	}
+
+	void copyHashes(const Path &x) {
+		_hash = x._hash;
+		_hashIgnoreCase = x._hashIgnoreCase;
+		_hashIgnoreCaseAndMac = x._hashIgnoreCaseAndMac;
+	}
+
+	/** Return true if both hashes are known and differ. */
+	static bool hashesDiffer(uint x, uint y) {
+		return x && y && x != y;
+	}
+
 	/**
 	 * Escapes a path:
 	 * - all ESCAPE are encoded to ESCAPE ESCAPED_ESCAPE
@@ -234,10 +259,11 @@ public:
 	};
 
 	/** Construct a new empty path. */
-	Path() {}
+	Path() : _hash(0), _hashIgnoreCase(0), _hashIgnoreCaseAndMac(0) {}
 
 	/** Construct a copy of the given path. */
-	Path(const Path &path) : _str(path._str) { }
+	Path(const Path &path) : _str(path._str), _hash(path._hash),
+		_hashIgnoreCase(path._hashIgnoreCase), _hashIgnoreCaseAndMac(path._hashIgnoreCaseAndMac) { }
 
 	/**
 	 * Construct a new path from the given NULL-terminated C string.
@@ -249,7 +275,8 @@ public:
 	 *                  Defaults to '/'.
 	 */
 	Path(const char *str, char separator = '/') :
-		_str(needsEncoding(str, separator) ? encode(str, separator) : str) { }
+		_str(needsEncoding(str, separator) ? encode(str, separator) : str),
+		_hash(0), _hashIgnoreCase(0), _hashIgnoreCaseAndMac(0) { }
 
 	/**
 	 * Construct a new path from the given String.
@@ -261,7 +288,8 @@ public:
 	 *                  Defaults to '/'.
 	 */
 	explicit Path(const String &str, char separator = '/') :
-		_str(needsEncoding(str.c_str(), separator) ? encode(str.c_str(), separator) : str) { }
+		_str(needsEncoding(str.c_str(), separator) ? encode(str.c_str(), separator) : str),
+		_hash(0), _hashIgnoreCase(0), _hashIgnoreCaseAndMac(0) { }
 
 	/**
 	 * Converts a path to a string using the given directory separator.
@@ -276,7 +304,10 @@ public:
 	/**
 	 * Clears the path object
 	 */
-	void clear() { _str.clear(); }
+	void clear() {
+		_str.clear();
+		invalidateHashes();
+	}
 
 	/**
 	 * Returns the Path for the parent directory of this path.
@@ -308,19 +339,21 @@ public:
 
 	/** Check whether this path is identical to path @p x. */
 	bool operator==(const Path &x) const {
+		if (hashesDiffer(_hash, x._hash))
+			return false;
 		return _str == x._str;
 	}
 
 	/** Check whether this path is different than path @p x. */
 	bool operator!=(const Path &x) const {
-		return _str != x._str;
+		return !(*this == x);
 	}
 
 	/**
 	 * Check whether this path is identical to path @p x.
 	 */
 	bool equals(const Path &x) const {
-		return _str.equals(x._str);
+		return *this == x;
 	}
 	/**
 	 * Check whether this path is identical to path @p x.
@@ -334,7 +367,8 @@ public:
 	bool equalsIgnoreCaseAndMac(const Path &x) const;
 
 	/**
-	 * Calculate a case sensitive hash of path
+	 * Calculate a case sensitive hash of path.
+	 * The hashes are cached in the path, so only the first call computes them.
 	 */
 	uint hash() const;
 	/**
@@ -357,6 +391,7 @@ public:
 	/** Assign a given path to this path. */
 	Path &operator=(const Path &path) {
 		_str = path._str;
+		copyHashes(path);
 		return *this;
 	}
 
@@ -378,6 +413,7 @@ public:
 		} else {
 			_str = str;
 		}
+		invalidateHashes();
 	}
 
 	/**
@@ -509,6 +545,7 @@ public:
 	void toLowercase() {
 		// Escapism is not changed by changing case
 		_str.toLowercase();
+		invalidateHashes();
 	}
 
 	/**
@@ -520,6 +557,7 @@ public:
 	void toUppercase() {
 		// Escapism is not changed by changing case
 		_str.toUppercase();
+		invalidateHashes();
 	}
 
 	/**
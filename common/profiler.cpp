@@ -0,0 +1,237 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/profiler.h"
+#include "common/algorithm.h"
+#include "common/hashmap.h"
+#include "common/memtracker.h"
+#include "common/stream.h"
+#include "common/system.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(Profiler);
+
+namespace {
+
+// The buffer of the calling thread, registered on its first event
+thread_local void *t_profilerBuffer = nullptr;
+
+struct ZoneHash {
+	uint operator()(const ProfilerZone *zone) const { return (uint)((uintptr)zone >> 3); }
+};
+
+struct ZoneStatsGreater {
+	bool operator()(const Profiler::ZoneStats &a, const Profiler::ZoneStats &b) const {
+		return a.totalTime > b.totalTime;
+	}
+};
+
+struct EventStartLess {
+	bool operator()(const Profiler::Event &a, const Profiler::Event &b) const {
+		return a.start < b.start;
+	}
+};
+
+String escapeJSON(const char *str) {
+	String result;
+	for (; *str; str++) {
+		if (*str == '"' || *str == '\\')
+			result += '\\';
+		if ((byte)*str >= 0x20)
+			result += *str;
+	}
+	return result;
+}
+
+} // End of anonymous namespace
+
+Profiler::Profiler() : _enabled(0) {
+}
+
+Profiler::~Profiler() {
+	for (uint i = 0; i < _threads.size(); i++)
+		delete _threads[i];
+}
+
+uint64 Profiler::getTime() {
+	return g_system->getMicros();
+}
+
+Profiler::ThreadBuffer *Profiler::getThreadBuffer() {
+	ThreadBuffer *buffer = (ThreadBuffer *)t_profilerBuffer;
+	if (buffer)
+		return buffer;
+
+	buffer = new ThreadBuffer();
+	StackLock lock(_mutex);
+	buffer->id = _threads.size() + 1;
+	buffer->name = String::format("Thread %u", buffer->id);
+	_threads.push_back(buffer);
+
+	t_profilerBuffer = buffer;
+	return buffer;
+}
+
+void Profiler::setThreadName(const char *name) {
+	ThreadBuffer *buffer = getThreadBuffer();
+	StackLock lock(_mutex);
+	buffer->name = name;
+}
+
+void Profiler::record(const ProfilerZone &zone, uint64 start, uint64 end) {
+	ThreadBuffer *buffer = getThreadBuffer();
+
+	const uint32 written = buffer->written.loadRelaxed();
+	Event &event = buffer->events[written & (kEventsPerThread - 1)];
+	event.zone = &zone;
+	event.start = start;
+	event.end = end;
+
+	buffer->written.store(written + 1);
+}
+
+void Profiler::clear() {
+	StackLock lock(_mutex);
+	for (uint i = 0; i < _threads.size(); i++)
+		_threads[i]->written.store(0);
+}
+
+void Profiler::copyEvents(const ThreadBuffer &buffer, Array<Event> &events) const {
+	const uint32 written = buffer.written.load();
+	const uint32 first = written > kEventsPerThread ? written - kEventsPerThread : 0;
+	const uint offset = events.size();
+
+	events.reserve(offset + written - first);
+	for (uint32 i = first; i != written; i++)
+		events.push_back(buffer.events[i & (kEventsPerThread - 1)]);
+
+	// Drop the events which the thread overwrote while they were copied
+	atomicFence();
+	const uint32 overwritten = buffer.written.loadRelaxed() - first;
+	if (overwritten > kEventsPerThread) {
+		const uint dropped = MIN<uint32>(overwritten - kEventsPerThread, written - first);
+		events.erase(events.begin() + offset, events.begin() + offset + dropped);
+	}
+}
+
+void Profiler::getEvents(Array<Event> &events) const {
+	StackLock lock(_mutex);
+	for (uint i = 0; i < _threads.size(); i++)
+		copyEvents(*_threads[i], events);
+}
+
+void Profiler::getZoneStats(Array<ZoneStats> &stats, uint64 since) const {
+	Array<Event> events;
+	getEvents(events);
+
+	HashMap<const ProfilerZone *, uint, ZoneHash> indices;
+	stats.clear();
+
+	for (uint i = 0; i < events.size(); i++) {
+		const Event &event = events[i];
+		if (event.end < since)
+			continue;
+
+		uint index;
+		if (!indices.tryGetVal(event.zone, index)) {
+			index = stats.size();
+			indices[event.zone] = index;
+
+			ZoneStats zoneStats = { event.zone, 0, 0, 0 };
+			stats.push_back(zoneStats);
+		}
+
+		ZoneStats &zoneStats = stats[index];
+		const uint64 time = event.end - event.start;
+		zoneStats.count++;
+		zoneStats.totalTime += time;
+		zoneStats.maxTime = MAX(zoneStats.maxTime, time);
+	}
+
+	sort(stats.begin(), stats.end(), ZoneStatsGreater());
+}
+
+void Profiler::getThreadStats(Array<ThreadStats> &stats, uint64 since) const {
+	stats.clear();
+
+	StackLock lock(_mutex);
+	for (uint i = 0; i < _threads.size(); i++) {
+		Array<Event> events;
+		copyEvents(*_threads[i], events);
+		sort(events.begin(), events.end(), EventStartLess());
+
+		// Zones nest, so only the time not covered by an earlier zone counts
+		uint64 busyTime = 0;
+		uint64 coveredUntil = since;
+		for (uint j = 0; j < events.size(); j++) {
+			const uint64 start = MAX(events[j].start, coveredUntil);
+			if (events[j].end > start) {
+				busyTime += events[j].end - start;
+				coveredUntil = events[j].end;
+			}
+		}
+
+		ThreadStats threadStats = { _threads[i]->name, busyTime };
+		stats.push_back(threadStats);
+	}
+}
+
+bool Profiler::exportChromeTrace(WriteStream &stream) const {
+	stream.writeString("{\"traceEvents\":[\n");
+
+	bool first = true;
+	StackLock lock(_mutex);
+	for (uint i = 0; i < _threads.size(); i++) {
+		const ThreadBuffer &buffer = *_threads[i];
+
+		stream.writeString(String::format("%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+		                                  first ? "" : ",\n", buffer.id, escapeJSON(buffer.name.c_str()).c_str()));
+		first = false;
+
+		Array<Event> events;
+		copyEvents(buffer, events);
+		for (uint j = 0; j < events.size(); j++) {
+			const Event &event = events[j];
+			stream.writeString(String::format(",\n{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%llu,\"pid\":1,\"tid\":%u,\"args\":{\"file\":\"%s\",\"line\":%d}}",
+			                                  escapeJSON(event.zone->name).c_str(), (unsigned long long)event.start,
+			                                  (unsigned long long)(event.end - event.start), buffer.id,
+			                                  escapeJSON(event.zone->file).c_str(), event.zone->line));
+		}
+	}
+
+#ifdef USE_MEMORY_TRACKING
+	// The memory in use when the trace was taken, as a counter track
+	String counters;
+	for (int i = 0; i < kMemoryTagCount; i++) {
+		MemoryTracker::Stats stats;
+		MemoryTracker::getStats((MemoryTag)i, stats);
+		counters += String::format("%s\"%s\":%u", i ? "," : "", MemoryTracker::getTagName((MemoryTag)i), (uint)stats.current);
+	}
+	stream.writeString(String::format("%s{\"name\":\"Memory\",\"ph\":\"C\",\"ts\":%llu,\"pid\":1,\"args\":{%s}}",
+	                                  first ? "" : ",\n", (unsigned long long)getTime(), counters.c_str()));
+#endif
+
+	stream.writeString("\n]}\n");
+	return !stream.err();
+}
+
+} // End of namespace Common
@@ -0,0 +1,200 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_PROFILER_H
+#define COMMON_PROFILER_H
+
+#include "common/scummsys.h"
+
+#ifdef USE_PROFILER
+
+#include "common/array.h"
+#include "common/atomic.h"
+#include "common/mutex.h"
+#include "common/singleton.h"
+#include "common/str.h"
+
+namespace Common {
+
+class WriteStream;
+
+/**
+ * @defgroup common_profiler Profiler
+ * @ingroup common
+ *
+ * @brief Instrumentation for measuring where the time of a frame goes.
+ *
+ * Code to be measured is marked with PROFILE_ZONE, which records the time
+ * spent in the enclosing scope. The macros compile to nothing unless the
+ * zone profiler is enabled with the --enable-zone-profiler configure option.
+ * @{
+ */
+
+/** The static description of a zone, made by the PROFILE_ZONE macro. */
+struct ProfilerZone {
+	const char *name;
+	const char *file;
+	int line;
+};
+
+/**
+ * Records the zones run by all threads into a ring buffer per thread. The
+ * buffers can be exported in the Chrome trace event format, which can be
+ * loaded into chrome://tracing or https://ui.perfetto.dev, or summed up per
+ * zone for a live view.
+ *
+ * Recording is off until setEnabled() is called. Each thread only writes
+ * to its own buffer, so recording a zone doesn't take a lock.
+ */
+class Profiler : public Singleton<Profiler> {
+public:
+	/** A finished run of a zone. Times are in microseconds, from OSystem::getMicros(). */
+	struct Event {
+		const ProfilerZone *zone;
+		uint64 start;
+		uint64 end;
+	};
+
+	/** The time spent in a zone, summed up over all threads. */
+	struct ZoneStats {
+		const ProfilerZone *zone;
+		uint32 count;
+		uint64 totalTime;
+		uint64 maxTime;
+	};
+
+	/** How long a thread spent in zones. */
+	struct ThreadStats {
+		String name;
+		uint64 busyTime; ///< Time covered by zones, counting nested zones once.
+	};
+
+	enum {
+		kEventsPerThread = 16384 ///< Size of the ring buffers, which must be a power of two.
+	};
+
+	~Profiler();
+
+	bool isEnabled() const { return _enabled.loadRelaxed() != 0; }
+
+	/** Start or stop recording. The recorded events are kept until clear() is called. */
+	void setEnabled(bool enabled) { _enabled.store(enabled ? 1 : 0); }
+
+	/** Name the calling thread in exported traces. */
+	void setThreadName(const char *name);
+
+	/** Record a finished zone for the calling thread. */
+	void record(const ProfilerZone &zone, uint64 start, uint64 end);
+
+	/** Drop the events recorded so far. Must not be called while other threads record. */
+	void clear();
+
+	/** Return a copy of the events of all threads which are still in their buffers. */
+	void getEvents(Array<Event> &events) const;
+
+	/**
+	 * Sum up the events which ended after @p since, per zone. Zones are
+	 * sorted by their total time, longest first.
+	 */
+	void getZoneStats(Array<ZoneStats> &stats, uint64 since) const;
+
+	/**
+	 * Sum up the time each thread spent in zones since @p since, for
+	 * seeing how busy the threads are.
+	 */
+	void getThreadStats(Array<ThreadStats> &stats, uint64 since) const;
+
+	/**
+	 * Write all buffered events as a Chrome trace.
+	 *
+	 * @return False if writing to the stream failed.
+	 */
+	bool exportChromeTrace(WriteStream &stream) const;
+
+	/** Return the current time as used by the events. */
+	static uint64 getTime();
+
+private:
+	friend class Singleton<SingletonBaseType>;
+
+	struct ThreadBuffer {
+		String name;
+		uint id;
+		Atomic<uint32> written; ///< Number of events written since the last clear().
+		Event events[kEventsPerThread];
+	};
+
+	Profiler();
+
+	ThreadBuffer *getThreadBuffer();
+	void copyEvents(const ThreadBuffer &buffer, Array<Event> &events) const;
+
+	Atomic<int> _enabled;
+	mutable Mutex _mutex; ///< Protects _threads.
+	Array<ThreadBuffer *> _threads;
+};
+
+/** Records the time spent in its scope. Used through PROFILE_ZONE. */
+class ProfilerScope {
+public:
+	explicit ProfilerScope(const ProfilerZone &zone) : _zone(zone), _active(Profiler::instance().isEnabled()), _start(0) {
+		if (_active)
+			_start = Profiler::getTime();
+	}
+
+	~ProfilerScope() {
+		if (_active)
+			Profiler::instance().record(_zone, _start, Profiler::getTime());
+	}
+
+private:
+	const ProfilerZone &_zone;
+	bool _active;
+	uint64 _start;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#define PROFILE_CONCAT_INTERN(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INTERN(a, b)
+
+/** Record the time spent from here to the end of the scope as a zone with the given name. */
+#define PROFILE_ZONE(name) \
+	static const Common::ProfilerZone PROFILE_CONCAT(profilerZone, __LINE__) = { name, __FILE__, __LINE__ }; \
+	Common::ProfilerScope PROFILE_CONCAT(profilerScope, __LINE__)(PROFILE_CONCAT(profilerZone, __LINE__))
+
+/** Record the time spent in the rest of the function as a zone named after it. */
+#define PROFILE_FUNCTION() PROFILE_ZONE(__FUNCTION__)
+
+/** Name the calling thread in exported traces. */
+#define PROFILE_THREAD_NAME(name) Common::Profiler::instance().setThreadName(name)
+
+#else
+
+#define PROFILE_ZONE(name) do {} while (0)
+#define PROFILE_FUNCTION() do {} while (0)
+#define PROFILE_THREAD_NAME(name) do {} while (0)
+
+#endif
+
+#endif
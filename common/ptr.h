@@ -23,6 +23,7 @@
 #define COMMON_PTR_H
 
 #include "common/scummsys.h"
+#include "common/atomic.h"
 #include "common/noncopyable.h"
 #include "common/safe-bool.h"
 #include "common/types.h"
@@ -40,53 +41,105 @@ namespace Common {
  * @{
  */
 
+/**
+ * How the reference counts of a SharedPtr are updated.
+ */
+enum RefCountMode {
+	/** Only share the SharedPtr, its copies and WeakPtrs on one thread at a time. */
+	kRefCountSingleThreaded,
+	/**
+	 * Update the reference counts atomically, so that copies of the SharedPtr
+	 * may be made and destroyed on several threads at once.
+	 */
+	kRefCountThreadSafe
+};
+
 class BasePtrTrackerInternal {
 public:
 	typedef int RefValue;
 
-	BasePtrTrackerInternal() : _weakRefCount(1), _strongRefCount(1) {}
+	BasePtrTrackerInternal(RefCountMode mode = kRefCountSingleThreaded) : _weakRefCount(1), _strongRefCount(1), _mode(mode) {}
 	virtual ~BasePtrTrackerInternal() {}
 
 	void incWeak() {
-		_weakRefCount++;
+		increment(_weakRefCount);
 	}
 
 	void decWeak() {
-		if (--_weakRefCount == 0)
+		if (decrement(_weakRefCount) == 0)
 			delete this;
 	}
 
 	void incStrong() {
-		_strongRefCount++;
+		increment(_strongRefCount);
+	}
+
+	/**
+	 * Add a strong reference, unless the object is gone already. This is
+	 * needed for WeakPtrs, as another thread might drop the last strong
+	 * reference in the meantime.
+	 */
+	bool tryIncStrong() {
+		if (_mode == kRefCountSingleThreaded) {
+			if (_strongRefCount == 0)
+				return false;
+			_strongRefCount++;
+			return true;
+		}
+
+		RefValue count = atomicLoad(&_strongRefCount);
+		while (count > 0) {
+			if (atomicCompareExchange(&_strongRefCount, count, count + 1))
+				return true;
+		}
+		return false;
 	}
 
 	void decStrong() {
-		if (--_strongRefCount == 0) {
+		if (decrement(_strongRefCount) == 0) {
 			destructObject();
 			decWeak();
 		}
 	}
 
 	bool isAlive() const {
-		return _strongRefCount > 0;
+		return getStrongCount() > 0;
 	}
 
 	RefValue getStrongCount() const {
-		return _strongRefCount;
+		return _mode == kRefCountThreadSafe ? atomicLoad(&_strongRefCount) : _strongRefCount;
+	}
+
+	RefCountMode getMode() const {
+		return _mode;
 	}
 
 protected:
 	virtual void destructObject() = 0;
 
 private:
+	void increment(RefValue &count) {
+		if (_mode == kRefCountThreadSafe)
+			atomicFetchAdd<RefValue>(&count, 1);
+		else
+			count++;
+	}
+
+	RefValue decrement(RefValue &count) {
+		if (_mode == kRefCountThreadSafe)
+			return atomicFetchSub<RefValue>(&count, 1) - 1;
+		return --count;
+	}
+
 	RefValue _weakRefCount; // Weak ref count + 1 if object ref count > 0
 	RefValue _strongRefCount;
+	const RefCountMode _mode;
 };
 
 template<class T>
 class BasePtrTrackerImpl : public BasePtrTrackerInternal {
 public:
-	BasePtrTrackerImpl(T *ptr) : _ptr(ptr) {}
+	BasePtrTrackerImpl(T *ptr, RefCountMode mode = kRefCountSingleThreaded) : BasePtrTrackerInternal(mode), _ptr(ptr) {}
 
 protected:
 	void destructObject() override {
@@ -100,7 +153,7 @@ protected:
 template<class T, class DL>
 class BasePtrTrackerDeletionImpl : public BasePtrTrackerInternal {
 public:
-	BasePtrTrackerDeletionImpl(T *ptr, DL d) : _ptr(ptr), _deleter(d) {}
+	BasePtrTrackerDeletionImpl(T *ptr, DL d, RefCountMode mode = kRefCountSingleThreaded) : BasePtrTrackerInternal(mode), _ptr(ptr), _deleter(d) {}
 
 private:
 	void destructObject() override {
@@ -154,6 +207,12 @@ class WeakPtr;
  * There are also operators != and == to compare two SharedPtr objects
  * with compatible pointers. Comparison between a SharedPtr object and
  * a plain pointer is only possible via SharedPtr::get.
+ *
+ * By default, the reference counts are not updated atomically. To share an
+ * object across threads, create the SharedPtr with kRefCountThreadSafe; its
+ * copies and WeakPtrs may then be made and destroyed on any thread. A
+ * single SharedPtr object still must not be modified by one thread while
+ * being used by another.
  */
 template<class T>
 class SharedPtr : public SafeBool<SharedPtr<T> > {
@@ -182,10 +241,18 @@ public:
 	explicit SharedPtr(T2 *p) : _pointer(p), _tracker(p ? (new BasePtrTrackerImpl<T2>(p)) : nullptr) {
 	}
 
+	template<class T2>
+	SharedPtr(T2 *p, RefCountMode mode) : _pointer(p), _tracker(p ? (new BasePtrTrackerImpl<T2>(p, mode)) : nullptr) {
+	}
+
 	template<class T2, class DL>
 	SharedPtr(T2 *p, DL d) : _pointer(p), _tracker(p ? (new BasePtrTrackerDeletionImpl<T2, DL>(p, d)) : nullptr) {
 	}
 
+	template<class T2, class DL>
+	SharedPtr(T2 *p, DL d, RefCountMode mode) : _pointer(p), _tracker(p ? (new BasePtrTrackerDeletionImpl<T2, DL>(p, d, mode)) : nullptr) {
+	}
+
 	SharedPtr(const SharedPtr<T> &r) : _pointer(r._pointer), _tracker(r._tracker) {
 		if (_tracker)
 			_tracker->incStrong();
@@ -199,10 +266,9 @@ public:
 
 	template<class T2>
 	explicit SharedPtr(const WeakPtr<T2> &r) : _pointer(nullptr), _tracker(nullptr) {
-		if (r._tracker && r._tracker->isAlive()) {
+		if (r._tracker && r._tracker->tryIncStrong()) {
 			_pointer = r._pointer;
 			_tracker = r._tracker;
-			_tracker->incStrong();
 		}
 	}
 
@@ -305,10 +371,9 @@ public:
 	void reset(const WeakPtr<T2> &r) {
 		BasePtrTrackerInternal *oldTracker = _tracker;
 
-		if (r._tracker && r._tracker->isAlive()) {
+		if (r._tracker && r._tracker->tryIncStrong()) {
 			_tracker = r._tracker;
 			_pointer = r._pointer;
-			_tracker->incStrong();
 		} else {
 			_tracker = nullptr;
 			_pointer = nullptr;
@@ -321,12 +386,20 @@ public:
 	/**
 	 * Resets the object to the specified pointer
 	 */
-	void reset(T *ptr) {
+	void reset(T *ptr, RefCountMode mode = kRefCountSingleThreaded) {
 		if (_tracker)
 			_tracker->decStrong();
 
 		_pointer = ptr;
-		_tracker = new BasePtrTrackerImpl<T>(ptr);
+		_tracker = new BasePtrTrackerImpl<T>(ptr, mode);
+	}
+
+	/**
+	 * Returns whether copies of this pointer may be made on several
+	 * threads at once.
+	 */
+	bool isThreadSafe() const {
+		return _tracker && _tracker->getMode() == kRefCountThreadSafe;
 	}
 
 	/**
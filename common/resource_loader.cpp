@@ -0,0 +1,279 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/resource_loader.h"
+#include "common/archive.h"
+#include "common/stream.h"
+#include "common/system.h"
+
+namespace Common {
+
+ResourceLoader::ResourceLoader(JobSystem *jobSystem) :
+	_jobSystem(jobSystem ? jobSystem : g_system->getJobSystem()), _nextId(1),
+	_memoryBudget(32 * 1024 * 1024), _memoryUsage(0), _readBudget(1024 * 1024) {
+}
+
+ResourceLoader::~ResourceLoader() {
+	cancelAll();
+	while (!_requests.empty())
+		wait(_requests.front()->result.id);
+}
+
+ResourceLoader::RequestId ResourceLoader::load(const Request &request) {
+	Pending *pending = new Pending();
+	pending->request = request;
+	pending->result.id = _nextId++;
+	pending->result.path = request.path;
+	if (_nextId == kInvalidRequest)
+		_nextId++;
+
+	_requests.push_back(pending);
+	return pending->result.id;
+}
+
+bool ResourceLoader::setPriority(RequestId id, Priority priority) {
+	PendingList::iterator it = find(id);
+	if (it == _requests.end())
+		return false;
+
+	(*it)->request.priority = priority;
+	return true;
+}
+
+bool ResourceLoader::cancel(RequestId id) {
+	PendingList::iterator it = find(id);
+	if (it == _requests.end())
+		return false;
+
+	Pending *pending = *it;
+	pending->cancelled = true;
+	if (pending->state == kStateQueued || pending->state == kStateReading)
+		finish(pending, kStatusCancelled);
+	else if (pending->state == kStateDone)
+		pending->result.status = kStatusCancelled;
+	return true;
+}
+
+void ResourceLoader::cancelAll(Priority priority) {
+	for (PendingList::iterator it = _requests.begin(); it != _requests.end(); ++it) {
+		if ((*it)->request.priority >= priority)
+			cancel((*it)->result.id);
+	}
+}
+
+bool ResourceLoader::isPending(RequestId id) const {
+	return find(id) != _requests.end();
+}
+
+void ResourceLoader::update() {
+	uint32 readBudget = _readBudget;
+	Pending *pending;
+	while ((pending = nextToRead()) != nullptr) {
+		const bool urgent = pending->request.priority == kPriorityNow;
+		if (!urgent && readBudget == 0)
+			break;
+
+		if (pending->state == kStateQueued) {
+			const uint32 usage = _memoryUsage;
+			if (!open(pending))
+				continue;
+
+			// Always allow one resource in flight, so that resources larger
+			// than the budget are still loaded eventually
+			if (!urgent && usage > 0 && _memoryUsage > _memoryBudget) {
+				delete pending->stream;
+				pending->stream = nullptr;
+				delete[] pending->result.data;
+				pending->result.data = nullptr;
+				_memoryUsage -= pending->charged;
+				pending->charged = 0;
+				pending->state = kStateQueued;
+				break;
+			}
+		}
+
+		const uint32 read = this->read(pending, urgent ? 0xFFFFFFFF : readBudget);
+		if (!urgent)
+			readBudget -= MIN(read, readBudget);
+	}
+
+	for (PendingList::iterator it = _requests.begin(); it != _requests.end(); ++it) {
+		Pending *pending = *it;
+		if (pending->state == kStateDecoding && pending->group.isDone()) {
+			pending->state = kStateDone;
+			if (pending->cancelled)
+				pending->result.status = kStatusCancelled;
+		}
+	}
+
+	// Deliver in the order of priority. Callbacks may queue, cancel or wait
+	// for requests, so search again after each one.
+	for (;;) {
+		PendingList::iterator next = _requests.end();
+		for (PendingList::iterator it = _requests.begin(); it != _requests.end(); ++it) {
+			if ((*it)->state == kStateDone && (next == _requests.end() || (*it)->request.priority < (*next)->request.priority))
+				next = it;
+		}
+
+		if (next == _requests.end())
+			break;
+		deliver(next);
+	}
+}
+
+bool ResourceLoader::wait(RequestId id) {
+	PendingList::iterator it = find(id);
+	if (it == _requests.end())
+		return false;
+
+	Pending *pending = *it;
+	if (pending->state == kStateQueued)
+		open(pending);
+	if (pending->state == kStateReading)
+		read(pending, 0xFFFFFFFF);
+
+	if (pending->state == kStateDecoding) {
+		_jobSystem->wait(pending->group);
+		pending->state = kStateDone;
+		if (pending->cancelled)
+			pending->result.status = kStatusCancelled;
+	}
+
+	deliver(it);
+	return true;
+}
+
+ResourceLoader::PendingList::iterator ResourceLoader::find(RequestId id) {
+	PendingList::iterator it;
+	for (it = _requests.begin(); it != _requests.end(); ++it) {
+		if ((*it)->result.id == id)
+			break;
+	}
+	return it;
+}
+
+ResourceLoader::PendingList::const_iterator ResourceLoader::find(RequestId id) const {
+	PendingList::const_iterator it;
+	for (it = _requests.begin(); it != _requests.end(); ++it) {
+		if ((*it)->result.id == id)
+			break;
+	}
+	return it;
+}
+
+ResourceLoader::Pending *ResourceLoader::nextToRead() {
+	Pending *next = nullptr;
+	for (PendingList::iterator it = _requests.begin(); it != _requests.end(); ++it) {
+		Pending *pending = *it;
+		if (pending->state != kStateQueued && pending->state != kStateReading)
+			continue;
+
+		// Finish a resource which is being read before starting another one
+		// of the same priority
+		if (!next || pending->request.priority < next->request.priority ||
+				(pending->request.priority == next->request.priority && pending->state == kStateReading && next->state == kStateQueued))
+			next = pending;
+	}
+	return next;
+}
+
+bool ResourceLoader::open(Pending *pending) {
+	if (pending->request.open)
+		pending->stream = pending->request.open(pending->request.path, pending->request.refCon);
+	else
+		pending->stream = SearchMan.createReadStreamForMember(pending->request.path);
+
+	if (!pending->stream) {
+		finish(pending, kStatusFailed);
+		return false;
+	}
+
+	const int64 size = pending->stream->size();
+	if (size < 0 || size > 0x7FFFFFFF) {
+		finish(pending, kStatusFailed);
+		return false;
+	}
+
+	pending->result.size = (uint32)size;
+	pending->result.data = new byte[pending->result.size];
+	pending->charged = pending->result.size;
+	_memoryUsage += pending->charged;
+	pending->state = kStateReading;
+	return true;
+}
+
+uint32 ResourceLoader::read(Pending *pending, uint32 maxBytes) {
+	const uint32 count = MIN(pending->result.size - pending->bytesRead, maxBytes);
+	if (count > 0) {
+		if (pending->stream->read(pending->result.data + pending->bytesRead, count) != count) {
+			finish(pending, kStatusFailed);
+			return count;
+		}
+		pending->bytesRead += count;
+	}
+
+	if (pending->bytesRead == pending->result.size)
+		finishReading(pending);
+	return count;
+}
+
+void ResourceLoader::finishReading(Pending *pending) {
+	delete pending->stream;
+	pending->stream = nullptr;
+	pending->result.status = kStatusLoaded;
+
+	if (pending->request.decode) {
+		pending->state = kStateDecoding;
+		_jobSystem->submit(decodeJob, pending, &pending->group);
+	} else {
+		pending->state = kStateDone;
+	}
+}
+
+void ResourceLoader::finish(Pending *pending, Status status) {
+	delete pending->stream;
+	pending->stream = nullptr;
+	delete[] pending->result.data;
+	pending->result.data = nullptr;
+	pending->result.size = 0;
+	pending->result.status = status;
+	pending->state = kStateDone;
+}
+
+void ResourceLoader::deliver(PendingList::iterator it) {
+	Pending *pending = *it;
+	_requests.erase(it);
+	_memoryUsage -= pending->charged;
+
+	if (pending->request.complete)
+		pending->request.complete(pending->result, pending->request.refCon);
+
+	delete[] pending->result.data;
+	delete pending;
+}
+
+void ResourceLoader::decodeJob(void *refCon) {
+	Pending *pending = (Pending *)refCon;
+	pending->request.decode(pending->result, pending->request.refCon);
+}
+
+} // End of namespace Common
@@ -0,0 +1,228 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef COMMON_RESOURCE_LOADER_H
+#define COMMON_RESOURCE_LOADER_H
+
+#include "common/scummsys.h"
+#include "common/jobs.h"
+#include "common/list.h"
+#include "common/noncopyable.h"
+#include "common/path.h"
+
+namespace Common {
+
+class SeekableReadStream;
+
+/**
+ * @defgroup common_resource_loader Resource loader
+ * @ingroup common
+ *
+ * @brief Background loading of resources which will be needed soon.
+ *
+ * @{
+ */
+
+/**
+ * Loader for resources an engine knows it will need soon, e.g. those of
+ * the room the player is about to enter.
+ *
+ * Requests are served in the order of their priority. As archives can't be
+ * accessed concurrently, the data is read on the engine thread from
+ * update(), only a limited number of bytes per call for background
+ * requests so that reading is spread over several frames. An optional
+ * decode step then runs on the job system. Completion callbacks are
+ * delivered on the engine thread from update() and wait().
+ *
+ * Every request gets its completion callback called exactly once, also
+ * when it failed or was cancelled, so that it can release what the decode
+ * step produced.
+ */
+class ResourceLoader : NonCopyable {
+public:
+	enum Priority {
+		kPriorityNow,         ///< Needed right away, read regardless of the budgets.
+		kPriorityNextRoom,    ///< Needed once the next room is entered.
+		kPrioritySpeculative, ///< Might be needed later.
+		kPriorityCount
+	};
+
+	enum Status {
+		kStatusLoaded,
+		kStatusFailed,
+		kStatusCancelled
+	};
+
+	typedef uint32 RequestId;
+	static const RequestId kInvalidRequest = 0;
+
+	/** Outcome of a request, as handed to the decode and completion callbacks. */
+	struct Result {
+		RequestId id;
+		Status status;
+		Path path;
+		/**
+		 * The data of the resource, allocated with new[]. The decode step
+		 * may replace it. It is deleted after the completion callback,
+		 * unless the callback takes it and sets this to nullptr.
+		 */
+		byte *data;
+		uint32 size;
+		/** Engine defined result of the decode step, owned by the completion callback. */
+		void *decoded;
+
+		Result() : id(kInvalidRequest), status(kStatusFailed), data(nullptr), size(0), decoded(nullptr) {}
+	};
+
+	/** Open the resource. Runs on the engine thread. */
+	typedef SeekableReadStream *(*OpenProc)(const Path &path, void *refCon);
+	/** Process the data of a successfully read resource. Runs on a worker thread. */
+	typedef void (*DecodeProc)(Result &result, void *refCon);
+	/** Receive the outcome of a request. Runs on the engine thread. */
+	typedef void (*CompletionProc)(Result &result, void *refCon);
+
+	struct Request {
+		Path path;
+		Priority priority;
+		/** Optional, by default the resource is opened through SearchMan. */
+		OpenProc open;
+		/** Optional. */
+		DecodeProc decode;
+		CompletionProc complete;
+		void *refCon;
+
+		Request() : priority(kPrioritySpeculative), open(nullptr), decode(nullptr), complete(nullptr), refCon(nullptr) {}
+		Request(const Path &p, Priority prio, CompletionProc c, void *r) :
+			path(p), priority(prio), open(nullptr), decode(nullptr), complete(c), refCon(r) {}
+	};
+
+	/**
+	 * @param jobSystem Job system to decode on, by default the one of
+	 *                  g_system.
+	 */
+	explicit ResourceLoader(JobSystem *jobSystem = nullptr);
+
+	/** Cancel all requests, still calling their completion callbacks. */
+	~ResourceLoader();
+
+	/**
+	 * Set the maximum number of bytes held by requests which have been
+	 * read but not delivered yet. Background requests are not started
+	 * while that would exceed the budget.
+	 */
+	void setMemoryBudget(uint32 bytes) { _memoryBudget = bytes; }
+
+	/** Set the maximum number of bytes read for background requests per update(). */
+	void setReadBudget(uint32 bytes) { _readBudget = bytes; }
+
+	/** Queue a request. */
+	RequestId load(const Request &request);
+
+	/**
+	 * Change the priority of a pending request, e.g. when a speculatively
+	 * loaded resource is needed now.
+	 *
+	 * @return False if the request is not pending.
+	 */
+	bool setPriority(RequestId id, Priority priority);
+
+	/**
+	 * Cancel a pending request. Its completion callback is called with
+	 * kStatusCancelled from the next update() or wait().
+	 *
+	 * @return False if the request is not pending.
+	 */
+	bool cancel(RequestId id);
+
+	/** Cancel all pending requests of the given or a lower priority. */
+	void cancelAll(Priority priority = kPriorityNow);
+
+	/** Return true if the request has not been delivered yet. */
+	bool isPending(RequestId id) const;
+
+	/** Return the number of requests which have not been delivered yet. */
+	uint getPendingCount() const { return _requests.size(); }
+
+	/** Return the number of bytes held by requests which have been read. */
+	uint32 getMemoryUsage() const { return _memoryUsage; }
+
+	/**
+	 * Read queued resources within the budgets and deliver the completed
+	 * requests. Engines should call this once per frame.
+	 */
+	void update();
+
+	/**
+	 * Complete the given request right away, reading and decoding it if
+	 * necessary, and deliver it.
+	 *
+	 * @return False if the request is not pending.
+	 */
+	bool wait(RequestId id);
+
+private:
+	enum State {
+		kStateQueued,
+		kStateReading,
+		kStateDecoding,
+		kStateDone
+	};
+
+	struct Pending {
+		Request request;
+		Result result;
+		State state;
+		SeekableReadStream *stream;
+		uint32 bytesRead;
+		uint32 charged;
+		bool cancelled;
+		JobGroup group;
+
+		Pending() : state(kStateQueued), stream(nullptr), bytesRead(0), charged(0), cancelled(false) {}
+	};
+
+	typedef List<Pending *> PendingList;
+
+	PendingList::iterator find(RequestId id);
+	PendingList::const_iterator find(RequestId id) const;
+	Pending *nextToRead();
+	bool open(Pending *pending);
+	uint32 read(Pending *pending, uint32 maxBytes);
+	void finishReading(Pending *pending);
+	void finish(Pending *pending, Status status);
+	void deliver(PendingList::iterator it);
+
+	static void decodeJob(void *refCon);
+
+	JobSystem *_jobSystem;
+	PendingList _requests;
+	RequestId _nextId;
+	uint32 _memoryBudget;
+	uint32 _memoryUsage;
+	uint32 _readBudget;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -288,6 +288,38 @@ public:
 		}
 	}
 
+	/**
+	 * Sync an array of integers stored in little endian order, with a single
+	 * stream access instead of one per entry.
+	 */
+	template <typename T>
+	void syncArrayLE(T *arr, uint32 entries, Version minVersion = 0, Version maxVersion = kLastVersion) {
+		if (_version < minVersion || _version > maxVersion)
+			return;
+
+		if (_loadStream)
+			_loadStream->readArrayLE(arr, entries);
+		else
+			_saveStream->writeArrayLE(arr, entries);
+		_bytesSynced += entries * sizeof(T);
+	}
+
+	/**
+	 * Sync an array of integers stored in big endian order, with a single
+	 * stream access instead of one per entry.
+	 */
+	template <typename T>
+	void syncArrayBE(T *arr, uint32 entries, Version minVersion = 0, Version maxVersion = kLastVersion) {
+		if (_version < minVersion || _version > maxVersion)
+			return;
+
+		if (_loadStream)
+			_loadStream->readArrayBE(arr, entries);
+		else
+			_saveStream->writeArrayBE(arr, entries);
+		_bytesSynced += entries * sizeof(T);
+	}
+
 	template <typename T>
 	void syncArray(T *arr, size_t entries, void (*serializer)(Serializer &, T &), Version minVersion = 0, Version maxVersion = kLastVersion) {
 		if (_version < minVersion || _version > maxVersion)
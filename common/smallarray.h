@@ -0,0 +1,453 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_SMALLARRAY_H
+#define COMMON_SMALLARRAY_H
+
+#include "common/scummsys.h"
+#include "common/algorithm.h"
+#include "common/textconsole.h" // For error()
+#include "common/memory.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_smallarray Small arrays
+ * @ingroup common_array
+ *
+ * @brief  Arrays keeping their first elements inline.
+ * @{
+ */
+
+/**
+ * An array which keeps up to N elements within itself and only allocates
+ * memory from the heap once it grows beyond that. This avoids the malloc and
+ * free pairs of a Common::Array for the short lists which are built and
+ * thrown away all the time, like the points of a polygon or the arguments of
+ * a script call.
+ *
+ * The interface is the same as the one of Common::Array. Unlike there,
+ * moving a small array which still stores its elements inline moves the
+ * elements one by one, so iterators into the source don't stay valid.
+ *
+ * Since the inline storage is part of the object, N should be kept small. It
+ * must be at least 1.
+ */
+template<class T, uint N>
+class SmallArray {
+public:
+	typedef T *iterator; /*!< Array iterator. */
+	typedef const T *const_iterator; /*!< Const-qualified array iterator. */
+
+	typedef T value_type; /*!< Value type of the array. */
+
+	typedef uint size_type; /*!< Size type of the array. */
+
+protected:
+	size_type _capacity; /*!< Maximum number of elements the array can hold. */
+	size_type _size; /*!< How many elements the array holds. */
+	T *_storage; /*!< Memory used for element storage, either inline or from the heap. */
+	alignas(T) byte _inlineStorage[N * sizeof(T)]; /*!< Storage for the first N elements. */
+
+public:
+	SmallArray() : _capacity(N), _size(0), _storage(inlineStorage()) {}
+
+	/**
+	 * Construct an array with @p count default-inserted instances of @p T.
+	 */
+	explicit SmallArray(size_type count) : _capacity(N), _size(0), _storage(inlineStorage()) {
+		resize(count);
+	}
+
+	/**
+	 * Construct an array with @p count copies of elements with value @p value.
+	 */
+	SmallArray(size_type count, const T &value) : _capacity(N), _size(0), _storage(inlineStorage()) {
+		resize(count, value);
+	}
+
+	/**
+	 * Construct an array as a copy of the given @p array.
+	 */
+	SmallArray(const SmallArray &array) : _capacity(N), _size(0), _storage(inlineStorage()) {
+		reserve(array._size);
+		uninitialized_copy(array._storage, array._storage + array._size, _storage);
+		_size = array._size;
+	}
+
+	/**
+	 * Construct an array from the given array using the C++11 move semantic.
+	 */
+	SmallArray(SmallArray &&old) : _capacity(N), _size(0), _storage(inlineStorage()) {
+		takeFrom(old);
+	}
+
+	/**
+	 * Construct an array using list initialization.
+	 */
+	SmallArray(std::initializer_list<T> list) : _capacity(N), _size(0), _storage(inlineStorage()) {
+		reserve(list.size());
+		uninitialized_copy(list.begin(), list.end(), _storage);
+		_size = list.size();
+	}
+
+	/**
+	 * Construct an array by copying data from a regular array.
+	 */
+	template<class T2>
+	SmallArray(const T2 *array, size_type n) : _capacity(N), _size(0), _storage(inlineStorage()) {
+		reserve(n);
+		uninitialized_copy(array, array + n, _storage);
+		_size = n;
+	}
+
+	~SmallArray() {
+		destroy(_storage, _size);
+		freeStorage();
+	}
+
+	/** Assign the given @p array to this array. */
+	SmallArray &operator=(const SmallArray &array) {
+		if (this == &array)
+			return *this;
+
+		destroy(_storage, _size);
+		_size = 0;
+		reserve(array._size);
+		uninitialized_copy(array._storage, array._storage + array._size, _storage);
+		_size = array._size;
+
+		return *this;
+	}
+
+	/** Assign the given array to this array using the C++11 move semantic. */
+	SmallArray &operator=(SmallArray &&old) {
+		if (this == &old)
+			return *this;
+
+		clear();
+		takeFrom(old);
+
+		return *this;
+	}
+
+	/** Construct an element into a position in the array. */
+	template<class... TArgs>
+	void emplace(const_iterator pos, TArgs &&...args) {
+		assert(pos >= _storage && pos <= _storage + _size);
+
+		const size_type index = static_cast<size_type>(pos - _storage);
+
+		if (_size == _capacity) {
+			// The parameters may refer to the current storage, so the new
+			// element is constructed before the old ones are moved away
+			T *oldStorage = _storage;
+			T *newStorage = allocStorage(_capacity * 2);
+
+			new ((void *)(newStorage + index)) T(Common::forward<TArgs>(args)...);
+			uninitialized_move(oldStorage, oldStorage + index, newStorage);
+			uninitialized_move(oldStorage + index, oldStorage + _size, newStorage + index + 1);
+
+			destroy(oldStorage, _size);
+			freeStorage();
+			_storage = newStorage;
+			_capacity *= 2;
+		} else if (index == _size) {
+			new ((void *)(_storage + index)) T(Common::forward<TArgs>(args)...);
+		} else {
+			T tmp(Common::forward<TArgs>(args)...);
+			new ((void *)(_storage + _size)) T(Common::move(_storage[_size - 1]));
+			move_backward(_storage + index, _storage + _size - 1, _storage + _size);
+			_storage[index] = Common::move(tmp);
+		}
+
+		_size++;
+	}
+
+	/** Construct an element to the end of the array. */
+	template<class... TArgs>
+	void emplace_back(TArgs &&...args) {
+		emplace(_storage + _size, Common::forward<TArgs>(args)...);
+	}
+
+	/** Append an element to the end of the array. */
+	void push_back(const T &element) {
+		emplace_back(element);
+	}
+
+	/** Append an element to the end of the array. */
+	void push_back(T &&element) {
+		emplace_back(Common::move(element));
+	}
+
+	/** Remove the last element of the array. */
+	void pop_back() {
+		assert(_size > 0);
+		_size--;
+		_storage[_size].~T();
+	}
+
+	/** Return a pointer to the underlying memory serving as element storage. */
+	const T *data() const {
+		return _storage;
+	}
+
+	/** Return a pointer to the underlying memory serving as element storage. */
+	T *data() {
+		return _storage;
+	}
+
+	/** Return a reference to the first element of the array. */
+	T &front() {
+		assert(_size > 0);
+		return _storage[0];
+	}
+
+	/** Return a reference to the first element of the array. */
+	const T &front() const {
+		assert(_size > 0);
+		return _storage[0];
+	}
+
+	/** Return a reference to the last element of the array. */
+	T &back() {
+		assert(_size > 0);
+		return _storage[_size - 1];
+	}
+
+	/** Return a reference to the last element of the array. */
+	const T &back() const {
+		assert(_size > 0);
+		return _storage[_size - 1];
+	}
+
+	/** Insert an element into the array at the given position. */
+	void insert_at(size_type idx, const T &element) {
+		assert(idx <= _size);
+		emplace(_storage + idx, element);
+	}
+
+	/** Insert an element before @p pos. */
+	void insert(iterator pos, const T &element) {
+		emplace(pos, element);
+	}
+
+	/** Remove an element at the given position from the array and return the value of that element. */
+	T remove_at(size_type idx) {
+		assert(idx < _size);
+		T tmp = Common::move(_storage[idx]);
+		erase(_storage + idx);
+		return tmp;
+	}
+
+	/** Return a reference to the element at the given position in the array. */
+	T &operator[](size_type idx) {
+		assert(idx < _size);
+		return _storage[idx];
+	}
+
+	/** Return a const reference to the element at the given position in the array. */
+	const T &operator[](size_type idx) const {
+		assert(idx < _size);
+		return _storage[idx];
+	}
+
+	/** Return the size of the array. */
+	size_type size() const {
+		return _size;
+	}
+
+	/** Return the number of elements the array can hold without allocating. */
+	size_type capacity() const {
+		return _capacity;
+	}
+
+	/** Check whether the elements are still stored within the array itself. */
+	bool isInline() const {
+		return _storage == inlineStorage();
+	}
+
+	/** Clear the array of all its elements and go back to the inline storage. */
+	void clear() {
+		destroy(_storage, _size);
+		freeStorage();
+		_storage = inlineStorage();
+		_size = 0;
+		_capacity = N;
+	}
+
+	/** Erase the element at @p pos position and return an iterator pointing to the next element in the array. */
+	iterator erase(iterator pos) {
+		return erase(pos, pos + 1);
+	}
+
+	/** Erase the elements from @p first to @p last and return an iterator pointing to the next element in the array. */
+	iterator erase(iterator first, iterator last) {
+		assert(_storage <= first && first <= last && last <= _storage + _size);
+		move(last, _storage + _size, first);
+
+		const size_type count = static_cast<size_type>(last - first);
+		destroy(_storage + _size - count, count);
+		_size -= count;
+
+		return first;
+	}
+
+	/** Check whether the array is empty. */
+	bool empty() const {
+		return (_size == 0);
+	}
+
+	/** Check whether two arrays are identical. */
+	bool operator==(const SmallArray &other) const {
+		if (this == &other)
+			return true;
+		if (_size != other._size)
+			return false;
+		for (size_type i = 0; i < _size; ++i) {
+			if (_storage[i] != other._storage[i])
+				return false;
+		}
+		return true;
+	}
+
+	/** Check if two arrays are different. */
+	bool operator!=(const SmallArray &other) const {
+		return !(*this == other);
+	}
+
+	/** Return an iterator pointing to the first element in the array. */
+	iterator       begin() {
+		return _storage;
+	}
+
+	/** Return an iterator pointing past the last element in the array. */
+	iterator       end() {
+		return _storage + _size;
+	}
+
+	/** Return a const iterator pointing to the first element in the array. */
+	const_iterator begin() const {
+		return _storage;
+	}
+
+	/** Return a const iterator pointing past the last element in the array. */
+	const_iterator end() const {
+		return _storage + _size;
+	}
+
+	/** Reserve enough memory in the array so that it can store at least the given number of elements.
+	 *  The current content of the array is not modified.
+	 */
+	void reserve(size_type newCapacity) {
+		if (newCapacity <= _capacity)
+			return;
+
+		T *newStorage = allocStorage(newCapacity);
+		uninitialized_move(_storage, _storage + _size, newStorage);
+		destroy(_storage, _size);
+		freeStorage();
+
+		_storage = newStorage;
+		_capacity = newCapacity;
+	}
+
+	/** Change the size of the array. */
+	void resize(size_type newSize) {
+		reserve(newSize);
+
+		for (size_type i = newSize; i < _size; ++i)
+			_storage[i].~T();
+		for (size_type i = _size; i < newSize; ++i)
+			new ((void *)&_storage[i]) T();
+
+		_size = newSize;
+	}
+
+	/** Change the size of the array and initialize new elements that exceed the
+	 *  current array's size with copies of value. */
+	void resize(size_type newSize, const T value) {
+		reserve(newSize);
+
+		for (size_type i = newSize; i < _size; ++i)
+			_storage[i].~T();
+		if (newSize > _size)
+			uninitialized_fill_n(_storage + _size, newSize - _size, value);
+
+		_size = newSize;
+	}
+
+	void swap(SmallArray &arr) {
+		SmallArray tmp(Common::move(arr));
+		arr = Common::move(*this);
+		*this = Common::move(tmp);
+	}
+
+protected:
+	T *inlineStorage() {
+		return (T *)_inlineStorage;
+	}
+
+	const T *inlineStorage() const {
+		return (const T *)_inlineStorage;
+	}
+
+	static T *allocStorage(size_type capacity) {
+		T *storage = (T *)malloc(sizeof(T) * capacity);
+		if (!storage)
+			::error("Common::SmallArray: failure to allocate %u bytes", capacity * (size_type)sizeof(T));
+		return storage;
+	}
+
+	/** Free the heap storage, if any. The elements must have been destroyed already. */
+	void freeStorage() {
+		if (!isInline())
+			free(_storage);
+	}
+
+	static void destroy(T *first, size_type count) {
+		for (size_type i = 0; i < count; ++i)
+			first[i].~T();
+	}
+
+	/** Take over the elements of @p old, which must be empty and inline here. */
+	void takeFrom(SmallArray &old) {
+		if (old.isInline()) {
+			uninitialized_move(old._storage, old._storage + old._size, _storage);
+			_size = old._size;
+			old.clear();
+		} else {
+			_storage = old._storage;
+			_capacity = old._capacity;
+			_size = old._size;
+
+			old._storage = old.inlineStorage();
+			old._capacity = N;
+			old._size = 0;
+		}
+	}
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
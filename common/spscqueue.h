@@ -0,0 +1,117 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_SPSCQUEUE_H
+#define COMMON_SPSCQUEUE_H
+
+#include "common/scummsys.h"
+#include "common/atomic.h"
+#include "common/noncopyable.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_spscqueue Lock-free queue
+ * @ingroup common
+ *
+ * @brief Fixed-size queue for handing items from one thread to another.
+ *
+ * @{
+ */
+
+/**
+ * Fixed size, lock-free single-producer/single-consumer queue.
+ *
+ * One thread may push() while another one concurrently pop()s, without
+ * either of them ever blocking. If several threads need to push (or pop),
+ * they have to serialize among themselves, e.g. with a mutex only they use.
+ *
+ * SIZE must be a power of two.
+ */
+template<class T, uint SIZE = 256>
+class SPSCQueue : NonCopyable {
+public:
+	typedef uint size_type;
+
+	SPSCQueue() : _head(0), _tail(0) {}
+
+	/**
+	 * Append an item to the queue. Must only be called by the producer.
+	 *
+	 * @return False if the queue is full, in which case nothing is added.
+	 */
+	bool push(const T &item) {
+		STATIC_ASSERT((SIZE & (SIZE - 1)) == 0, SPSCQueue_size_must_be_a_power_of_two);
+
+		const uint32 tail = _tail.loadRelaxed();
+		if (tail - _head.load() == SIZE)
+			return false;
+
+		_items[tail % SIZE] = item;
+		_tail.store(tail + 1);
+		return true;
+	}
+
+	/**
+	 * Remove the oldest item from the queue. Must only be called by the
+	 * consumer.
+	 *
+	 * @return False if the queue is empty.
+	 */
+	bool pop(T &item) {
+		const uint32 head = _head.loadRelaxed();
+		if (head == _tail.load())
+			return false;
+
+		item = _items[head % SIZE];
+		_head.store(head + 1);
+		return true;
+	}
+
+	/**
+	 * Return the number of queued items. When called by neither the producer
+	 * nor the consumer, this is only a snapshot.
+	 */
+	size_type size() const {
+		// Read the head first, so that it can't overtake the tail
+		const uint32 head = _head.load();
+		return _tail.load() - head;
+	}
+
+	bool empty() const {
+		return size() == 0;
+	}
+
+	static size_type capacity() {
+		return SIZE;
+	}
+
+private:
+	T _items[SIZE];
+	Atomic<uint32> _head; ///< Index of the next item to pop, only written by the consumer.
+	Atomic<uint32> _tail; ///< Index of the next item to push, only written by the producer.
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -20,6 +20,7 @@
  */
 
 #include "common/str-base.h"
+#include "common/atomic.h"
 #include "common/hash-str.h"
 #include "common/list.h"
 #include "common/memorypool.h"
@@ -133,7 +134,7 @@ TEMPLATE void BASESTRING::ensureCapacity(uint32 new_size, bool keep_old) {
 		isShared = false;
 		curCapacity = _builtinCapacity;
 	} else {
-		isShared = (oldRefCount && *oldRefCount > 1);
+		isShared = (oldRefCount && atomicLoad(oldRefCount) > 1);
 		curCapacity = _extern._capacity;
 	}
 
@@ -188,7 +189,11 @@ TEMPLATE void BASESTRING::ensureCapacity(uint32 new_size, bool keep_old) {
 TEMPLATE
 void BASESTRING::incRefCount() const {
 	assert(!isStorageIntern());
-	if (_extern._refCount == nullptr) {
+
+	// Several threads may copy the same string at once, so the ref count
+	// is updated atomically
+	int *refCount = atomicLoad(&_extern._refCount);
+	if (refCount == nullptr) {
 #ifndef SCUMMVM_UTIL
 		lockMemoryPoolMutex();
 #endif
@@ -197,14 +202,22 @@ void BASESTRING::incRefCount() const {
 			assert(g_refCountPool);
 		}
 
-		_extern._refCount = (int *)g_refCountPool->allocChunk();
+		int *newRefCount = (int *)g_refCountPool->allocChunk();
+		*newRefCount = 2;
+
+		// Another thread might have shared the storage in the meantime
+		if (atomicCompareExchange(&_extern._refCount, refCount, newRefCount)) {
+			refCount = nullptr;
+		} else {
+			g_refCountPool->freeChunk(newRefCount);
+		}
 #ifndef SCUMMVM_UTIL
 		unlockMemoryPoolMutex();
 #endif
-		*_extern._refCount = 2;
-	} else {
-		++(*_extern._refCount);
 	}
+
+	if (refCount)
+		atomicFetchAdd(refCount, 1);
 }
 
 TEMPLATE
@@ -212,10 +225,7 @@ void BASESTRING::decRefCount(int *oldRefCount) {
 	if (isStorageIntern())
 		return;
 
-	if (oldRefCount) {
-		--(*oldRefCount);
-	}
-	if (!oldRefCount || *oldRefCount <= 0) {
+	if (!oldRefCount || atomicFetchSub(oldRefCount, 1) <= 1) {
 		// The ref count reached zero, so we free the string storage
 		// and the ref count storage.
 		if (oldRefCount) {
@@ -0,0 +1,161 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/str-builder.h"
+#include "common/util.h"
+
+namespace Common {
+
+void StringBuilder::grow(uint32 size) {
+	uint32 capacity = _capacity;
+	while (size >= capacity)
+		capacity *= 2;
+
+	char *str = new char[capacity];
+	memcpy(str, _str, _size + 1);
+	if (_str != _storage)
+		delete[] _str;
+
+	_str = str;
+	_capacity = capacity;
+}
+
+void StringBuilder::appendDigits(const char *digits, uint32 count, bool negative, uint width, char pad) {
+	const uint32 length = count + (negative ? 1 : 0);
+	const uint32 padding = (width > length) ? width - length : 0;
+	char *dst = reserve(length + padding);
+
+	if (pad == '0') {
+		if (negative)
+			*dst++ = '-';
+		memset(dst, '0', padding);
+		dst += padding;
+	} else {
+		memset(dst, pad, padding);
+		dst += padding;
+		if (negative)
+			*dst++ = '-';
+	}
+	memcpy(dst, digits, count);
+
+	commit(length + padding);
+}
+
+StringBuilder &StringBuilder::appendInt(int64 value, uint width, char pad) {
+	// Negate as unsigned, which also works for the smallest value
+	const bool negative = value < 0;
+	uint64 magnitude = negative ? 0 - (uint64)value : (uint64)value;
+
+	char digits[20];
+	char *end = digits + sizeof(digits), *p = end;
+	do {
+		*--p = '0' + (char)(magnitude % 10);
+		magnitude /= 10;
+	} while (magnitude);
+
+	appendDigits(p, end - p, negative, width, pad);
+	return *this;
+}
+
+StringBuilder &StringBuilder::appendUint(uint64 value, uint width, char pad) {
+	char digits[20];
+	char *end = digits + sizeof(digits), *p = end;
+	do {
+		*--p = '0' + (char)(value % 10);
+		value /= 10;
+	} while (value);
+
+	appendDigits(p, end - p, false, width, pad);
+	return *this;
+}
+
+StringBuilder &StringBuilder::appendHex(uint64 value, uint width, bool upperCase) {
+	const char *hexDigits = upperCase ? "0123456789ABCDEF" : "0123456789abcdef";
+
+	char digits[16];
+	char *end = digits + sizeof(digits), *p = end;
+	do {
+		*--p = hexDigits[value & 0xF];
+		value >>= 4;
+	} while (value);
+
+	appendDigits(p, end - p, false, width, '0');
+	return *this;
+}
+
+StringBuilder &StringBuilder::appendFloat(double value, uint precision) {
+	static const uint64 scales[] = {
+		1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+	};
+
+	const bool negative = value < 0 || (value == 0 && 1 / value < 0);
+	const double magnitude = negative ? -value : value;
+
+	// Also false for NaNs
+	if (precision >= ARRAYSIZE(scales) || !(magnitude * scales[precision] < 9.0e18))
+		return appendFormat("%.*f", (int)precision, value);
+
+	const uint64 scale = scales[precision];
+	const uint64 scaled = (uint64)(magnitude * scale + 0.5);
+
+	if (negative)
+		append('-');
+	appendUint(scaled / scale);
+	if (precision) {
+		append('.');
+		appendUint(scaled % scale, precision, '0');
+	}
+	return *this;
+}
+
+StringBuilder &StringBuilder::appendFormat(const char *fmt, ...) {
+	va_list va;
+	va_start(va, fmt);
+	appendVFormat(fmt, va);
+	va_end(va);
+	return *this;
+}
+
+StringBuilder &StringBuilder::appendVFormat(const char *fmt, va_list args) {
+	va_list va;
+	scumm_va_copy(va, args);
+	int len = vsnprintf(_str + _size, _capacity - _size, fmt, va);
+	va_end(va);
+
+	if (len < 0) {
+		// Some C libraries don't return the size the full string would take
+		// up. Let String::vformat() deal with them.
+		_str[_size] = 0;
+		return append(String::vformat(fmt, args));
+	}
+
+	if ((uint32)len >= _capacity - _size) {
+		reserve(len);
+		scumm_va_copy(va, args);
+		vsnprintf(_str + _size, len + 1, fmt, va);
+		va_end(va);
+	}
+
+	_size += len;
+	return *this;
+}
+
+} // End of namespace Common
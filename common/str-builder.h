@@ -0,0 +1,167 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_STRING_BUILDER_H
+#define COMMON_STRING_BUILDER_H
+
+#include "common/scummsys.h"
+#include "common/noncopyable.h"
+#include "common/str.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_str_builder String builder
+ * @ingroup common_str
+ *
+ * @brief API for building strings piece by piece.
+ * @{
+ */
+
+/**
+ * Builds a string by appending text and numbers to it.
+ *
+ * The text is kept in a buffer inside the builder, so building strings of
+ * up to kInlineCapacity - 1 characters makes no heap allocation, and
+ * clear() keeps the buffer for the next string. Integers and floats are
+ * formatted directly, without going through vsnprintf().
+ *
+ * This is meant for text built in hot paths, e.g. once per frame:
+ *
+ * @code
+ * _hudText.clear();
+ * _hudText.append("Score: ").appendInt(_score, 6, '0');
+ * drawString(_hudText.c_str());
+ * @endcode
+ */
+class StringBuilder : NonCopyable {
+public:
+	static const uint32 kInlineCapacity = 256;
+
+	StringBuilder() : _str(_storage), _size(0), _capacity(kInlineCapacity) {
+		_storage[0] = 0;
+	}
+
+	~StringBuilder() {
+		if (_str != _storage)
+			delete[] _str;
+	}
+
+	/** Return the text built so far, as a NULL-terminated C string. */
+	const char *c_str() const { return _str; }
+
+	/** Return the length of the text built so far. */
+	uint32 size() const { return _size; }
+
+	bool empty() const { return _size == 0; }
+
+	/** Empty the text, keeping the buffer for the next one. */
+	void clear() {
+		_size = 0;
+		_str[0] = 0;
+	}
+
+	/** Return a copy of the text as a String. */
+	String toString() const { return String(_str, _size); }
+
+	StringBuilder &append(char c) {
+		reserve(1)[0] = c;
+		commit(1);
+		return *this;
+	}
+
+	StringBuilder &append(const char *str, uint32 len) {
+		memcpy(reserve(len), str, len);
+		commit(len);
+		return *this;
+	}
+
+	StringBuilder &append(const char *str) {
+		return append(str, strlen(str));
+	}
+
+	StringBuilder &append(const String &str) {
+		return append(str.c_str(), str.size());
+	}
+
+	/**
+	 * Append a signed decimal integer, like "%d" does.
+	 *
+	 * @param width Minimum number of characters, including the sign.
+	 * @param pad   Character to pad to the width with. With '0', the zeros
+	 *              follow the sign.
+	 */
+	StringBuilder &appendInt(int64 value, uint width = 0, char pad = ' ');
+
+	/** Append an unsigned decimal integer, like "%u" does. @see appendInt() */
+	StringBuilder &appendUint(uint64 value, uint width = 0, char pad = ' ');
+
+	/**
+	 * Append an integer in hexadecimal, like "%x" or "%X" do.
+	 *
+	 * @param width Minimum number of digits, padded with zeros.
+	 */
+	StringBuilder &appendHex(uint64 value, uint width = 0, bool upperCase = false);
+
+	/**
+	 * Append a float with a fixed number of decimals, like "%.*f" does.
+	 *
+	 * The value is rounded half away from zero, so on ties the last digit
+	 * may differ from vsnprintf(), which rounds the exact binary value.
+	 * Values too large for the direct conversion, infinities and NaNs go
+	 * through vsnprintf().
+	 */
+	StringBuilder &appendFloat(double value, uint precision = 6);
+
+	/** Append formatted data, like String::format(). */
+	StringBuilder &appendFormat(MSVC_PRINTF const char *fmt, ...) GCC_PRINTF(2, 3);
+
+	/** Append formatted data, like String::vformat(). */
+	StringBuilder &appendVFormat(const char *fmt, va_list args);
+
+private:
+	/** Make room for @p count more characters and return where they go. */
+	char *reserve(uint32 count) {
+		if (_size + count >= _capacity)
+			grow(_size + count);
+		return _str + _size;
+	}
+
+	/** Add @p count characters written after reserve() to the text. */
+	void commit(uint32 count) {
+		_size += count;
+		_str[_size] = 0;
+	}
+
+	void grow(uint32 size);
+	void appendDigits(const char *digits, uint32 count, bool negative, uint width, char pad);
+
+	char *_str;
+	uint32 _size;
+	uint32 _capacity;
+	char _storage[kInlineCapacity];
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
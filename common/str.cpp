@@ -230,6 +230,37 @@ String String::vformat(const char *fmt, va_list args) {
 	return output;
 }
 
+// static
+void String::formatTo(String &output, const char *fmt, ...) {
+	va_list va;
+	va_start(va, fmt);
+	vformatTo(output, fmt, va);
+	va_end(va);
+}
+
+// static
+void String::vformatTo(String &output, const char *fmt, va_list args) {
+	// The arguments may point into the output, e.g. when appending to it,
+	// so the text is formatted into a local buffer before the output is
+	// touched. Longer texts are rare enough to take the allocating path.
+	char buffer[256];
+	va_list va;
+	scumm_va_copy(va, args);
+	const int len = vsnprintf(buffer, sizeof(buffer), fmt, va);
+	va_end(va);
+
+	// See vformat() for the return values of MSVC and IRIX
+	if (len < 0 || len >= (int)sizeof(buffer) - 1) {
+		output = vformat(fmt, args);
+		return;
+	}
+
+	// Keep the storage of the output unless it is shared with other strings
+	output.ensureCapacity(len, false);
+	memcpy(output._str, buffer, len + 1);
+	output._size = len;
+}
+
 String String::substr(size_t pos, size_t len) const {
 	if (pos >= _size)
 		return String();
@@ -161,6 +161,21 @@ public:
 	 */
 	static String vformat(const char *fmt, va_list args);
 
+	/**
+	 * Print formatted data into an existing String object, like format().
+	 * The storage of @p output is reused when it is large enough, so a
+	 * string formatted over and over, e.g. once per frame, is not
+	 * reallocated each time. The arguments may point into @p output, e.g.
+	 * formatTo(s, "%s!", s.c_str()).
+	 */
+	static void formatTo(String &output, MSVC_PRINTF const char *fmt, ...) GCC_PRINTF(2, 3);
+
+	/**
+	 * Print formatted data into an existing String object, like vformat().
+	 * The storage of @p output is reused when it is large enough.
+	 */
+	static void vformatTo(String &output, const char *fmt, va_list args);
+
 	/** Return a substring of this string */
 	String substr(size_t pos = 0, size_t len = npos) const;
 
@@ -322,6 +322,38 @@ public:
 		return this->writeMultiple<EndianStorageFormat, T...>(EndianStorageFormat::Big, values...);
 	}
 
+	/**
+	 * Write an array of integers in little endian order into the stream.
+	 * The array is written with a single call to write() on little endian
+	 * hosts, and in byte swapped chunks otherwise.
+	 *
+	 * @return The number of array elements written into the stream.
+	 */
+	template<class T>
+	uint32 writeArrayLE(const T *values, uint32 count) {
+#ifdef SCUMM_LITTLE_ENDIAN
+		return write(values, count * sizeof(T)) / sizeof(T);
+#else
+		return writeArraySwapped(values, count);
+#endif
+	}
+
+	/**
+	 * Write an array of integers in big endian order into the stream.
+	 * The array is written with a single call to write() on big endian
+	 * hosts, and in byte swapped chunks otherwise.
+	 *
+	 * @return The number of array elements written into the stream.
+	 */
+	template<class T>
+	uint32 writeArrayBE(const T *values, uint32 count) {
+#ifdef SCUMM_BIG_ENDIAN
+		return write(values, count * sizeof(T)) / sizeof(T);
+#else
+		return writeArraySwapped(values, count);
+#endif
+	}
+
 	/**
 	 * Write at most @p dataSize of data from another stream into this one,
 	 * starting from the current stream position.
@@ -343,6 +375,27 @@ public:
 	 */
 	void writeString(const String &str);
 	/** @} */
+
+private:
+	template<class T>
+	uint32 writeArraySwapped(const T *values, uint32 count) {
+		const uint32 kBufferCount = 256 / sizeof(T);
+		T buffer[kBufferCount];
+		uint32 written = 0;
+
+		while (written < count) {
+			const uint32 chunk = (count - written < kBufferCount) ? count - written : kBufferCount;
+			memcpy(buffer, values + written, chunk * sizeof(T));
+			SWAP_BYTES_ARRAY(buffer, chunk);
+
+			const uint32 chunkWritten = write(buffer, chunk * sizeof(T)) / sizeof(T);
+			written += chunkWritten;
+			if (chunkWritten != chunk)
+				break;
+		}
+
+		return written;
+	}
 };
 
 /**
@@ -706,6 +759,34 @@ public:
 		return this->readMultiple<EndianStorageFormat, T...>(EndianStorageFormat::Big, values...);
 	}
 
+	/**
+	 * Read an array of integers stored in little endian order from the
+	 * stream. The array is read with a single call to read(), and its bytes
+	 * are only swapped on big endian hosts.
+	 *
+	 * @return The number of array elements that were completely read.
+	 */
+	template<class T>
+	uint32 readArrayLE(T *values, uint32 count) {
+		const uint32 n = read(values, count * sizeof(T)) / sizeof(T);
+		FROM_LE_ARRAY(values, n);
+		return n;
+	}
+
+	/**
+	 * Read an array of integers stored in big endian order from the
+	 * stream. The array is read with a single call to read(), and its bytes
+	 * are only swapped on little endian hosts.
+	 *
+	 * @return The number of array elements that were completely read.
+	 */
+	template<class T>
+	uint32 readArrayBE(T *values, uint32 count) {
+		const uint32 n = read(values, count * sizeof(T)) / sizeof(T);
+		FROM_BE_ARRAY(values, n);
+		return n;
+	}
+
 	/**
 	 * Read the specified amount of data into a malloc'ed buffer
 	 * which is then wrapped into a MemoryReadStream.
@@ -22,11 +22,13 @@
 #define FORBIDDEN_SYMBOL_EXCEPTION_exit
 
 #include "common/system.h"
+#include "common/config-manager.h"
 #include "common/events.h"
 #include "common/fs.h"
 #include "common/file.h"
 #include "common/savefile.h"
 #include "common/str.h"
+#include "common/jobs.h"
 #include "common/taskbar.h"
 #include "common/updates.h"
 #include "common/dialogs.h"
@@ -45,6 +47,7 @@ OSystem::OSystem() {
 	_audiocdManager = nullptr;
 	_eventManager = nullptr;
 	_timerManager = nullptr;
+	_jobSystem = nullptr;
 	_savefileManager = nullptr;
 #if defined(USE_TASKBAR)
 	_taskbarManager = nullptr;
@@ -89,9 +92,17 @@ OSystem::~OSystem() {
 	_dialogManager = nullptr;
 #endif
 
+	// The savefile manager may still wait for savefiles written by jobs
 	delete _savefileManager;
 	_savefileManager = nullptr;
 
+	// The configuration file may still be written by a job
+	if (Common::ConfigManager::hasInstance())
+		ConfMan.waitForFlush();
+
+	delete _jobSystem;
+	_jobSystem = nullptr;
+
 	delete _fsFactory;
 	_fsFactory = nullptr;
 
@@ -108,6 +119,10 @@ void OSystem::initBackend() {
 	if (!getTimerManager())
 		error("Backend failed to instantiate timer manager");
 
+	// Fall back to running jobs inline
+	if (!_jobSystem)
+		_jobSystem = new Common::JobSystem();
+
 	if (!_savefileManager)
 		error("Backend failed to instantiate savefile manager");
 
@@ -41,6 +41,7 @@ class Mixer;
 
 namespace Graphics {
 struct Surface;
+struct YUVImage;
 }
 
 namespace GUI {
@@ -52,8 +53,14 @@ namespace DLC {
 class Store;
 }
 
+namespace Video {
+class HardwareVideoDecoder;
+struct HardwareVideoDecoderDesc;
+}
+
 namespace Common {
 class EventManager;
+class JobSystem;
 class MutexInternal;
 struct Rect;
 class SaveFileManager;
@@ -210,6 +217,17 @@ protected:
 	 */
 	Common::TimerManager *_timerManager;
 
+	/**
+	 * No default value is provided for _jobSystem by OSystem.
+	 * However, OSystem::initBackend() does set a default value, which runs
+	 * all jobs inline, if none has been set before.
+	 *
+	 * @note _jobSystem is deleted by the OSystem destructor. Backends running
+	 *       the jobs on threads which need to be shut down explicitly should
+	 *       delete it on their own.
+	 */
+	Common::JobSystem *_jobSystem;
+
 	/**
 	 * No default value is provided for _savefileManager by OSystem.
 	 *
@@ -623,6 +641,11 @@ public:
 		*/
 		kFeatureCpuAVX2,
 
+		/**
+		* For x86_64 platforms that have AVX-512 Foundation and Byte and Word support
+		*/
+		kFeatureCpuAVX512BW,
+
 		/**
 		* For PowerPC platforms that have the altivec standard as of 1999.
 		* Covers a wide range of platforms, Apple Macs, XBox 360, PS3, and more
@@ -633,6 +656,16 @@ public:
 		* Graphics code is able to rotate the screen
 		*/
 		kFeatureRotationMode,
+
+		/**
+		* The backend can present YUV images on top of the game screen,
+		* converting them to RGB itself, usually on the GPU.
+		*
+		* This feature has no associated state.
+		*
+		* @see showYUVOverlay
+		*/
+		kFeatureYUVOverlay,
 	};
 
 	/**
@@ -1271,6 +1304,54 @@ public:
 	 */
 	virtual void fillScreen(const Common::Rect &r, uint32 col) = 0;
 
+	/**
+	 * Show a YUV image on top of the game screen, e.g. a video frame.
+	 *
+	 * The image is converted to RGB by the backend and drawn like it was
+	 * part of the game screen, with its upper left corner at the given
+	 * coordinates. It hides the game screen below it until
+	 * hideYUVOverlay() is called or another image is shown. The GUI overlay
+	 * and the mouse cursor are drawn above it.
+	 *
+	 * The planes are uploaded before this returns, so the caller may reuse
+	 * them right away. Like copyRectToScreen(), the change only becomes
+	 * visible with the next updateScreen() call.
+	 *
+	 * Only 444, 422 and 420 images are supported. The image may be lost when
+	 * the backend recreates its graphics context, so it should be shown
+	 * again for every frame.
+	 *
+	 * This is only supported if hasFeature(kFeatureYUVOverlay) returns true.
+	 *
+	 * @param image  The planes of the image.
+	 * @param x      x coordinate of the destination rectangle.
+	 * @param y      y coordinate of the destination rectangle.
+	 *
+	 * @note The destination rectangle must be contained in the game screen.
+	 */
+	virtual void showYUVOverlay(const Graphics::YUVImage &image, int x, int y) {}
+
+	/**
+	 * Stop showing the image set by showYUVOverlay().
+	 */
+	virtual void hideYUVOverlay() {}
+
+	/**
+	 * Create a decoder for compressed video which runs on the video
+	 * hardware, e.g. to save battery on mobile devices.
+	 *
+	 * The caller owns the returned decoder. Backends only need to support
+	 * the codecs and sizes their hardware can actually decode.
+	 *
+	 * @param desc  The codec and dimensions of the video.
+	 *
+	 * @return The decoder, or nullptr if the video can't be decoded in
+	 *         hardware. The caller then decodes it in software.
+	 *
+	 * @see Video::HardwareVideoDecoder
+	 */
+	virtual Video::HardwareVideoDecoder *createHardwareVideoDecoder(const Video::HardwareVideoDecoderDesc &desc) { return nullptr; }
+
 	/**
 	 * Flush the whole screen, i.e. render the current content of the screen
 	 * framebuffer to the display.
@@ -1531,6 +1612,15 @@ public:
 	 */
 	virtual uint32 getMillis(bool skipRecord = false) = 0;
 
+	/**
+	 * Get a timestamp in microseconds, for measuring short durations like
+	 * the ones of profiler zones. Its origin is unspecified, and it is never
+	 * recorded by the event recorder.
+	 *
+	 * The default implementation only has the precision of getMillis().
+	 */
+	virtual uint64 getMicros() { return (uint64)getMillis(true) * 1000; }
+
 	/** Delay/sleep for the specified amount of milliseconds. */
 	virtual void delayMillis(uint msecs) = 0;
 
@@ -1549,6 +1639,15 @@ public:
 	 */
 	virtual Common::TimerManager *getTimerManager();
 
+	/**
+	 * Return the job system singleton.
+	 *
+	 * For more information, see @ref JobSystem.
+	 */
+	inline Common::JobSystem *getJobSystem() {
+		return _jobSystem;
+	}
+
 	/**
 	 * Return the event manager singleton.
 	 *
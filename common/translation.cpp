@@ -30,6 +30,7 @@
 #include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
+#include "common/hash-str.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "common/unicode-bidi.h"
@@ -116,51 +117,46 @@ U32String TranslationManager::getTranslation(const char *message, const char *co
 	if (_currentTranslationMessages.empty() || *message == '\0')
 		return U32String(message);
 
-	// Binary-search for the msgid
-	int leftIndex = 0;
-	int rightIndex = _currentTranslationMessages.size() - 1;
+	const int msgid = findMessageId(message);
+	if (msgid < 0 || !_firstTranslation[msgid])
+		return U32String(message);
 
-	while (rightIndex >= leftIndex) {
-		const int midIndex = (leftIndex + rightIndex) / 2;
-		const PoMessageEntry *const m = &_currentTranslationMessages[midIndex];
+	// Get the range of messages with the same ID (but different context)
+	const int leftIndex = _firstTranslation[msgid] - 1;
+	int rightIndex = leftIndex;
+	while (
+	    rightIndex < (int)_currentTranslationMessages.size() - 1 &&
+	    _currentTranslationMessages[rightIndex + 1].msgid == msgid
+	) {
+		++rightIndex;
+	}
+	// Find the context we want
+	if (context == nullptr || *context == '\0' || leftIndex == rightIndex)
+		return U32String(_currentTranslationMessages[leftIndex].msgstr);
+	// We could use again binary search, but there should be only a small number of contexts.
+	while (rightIndex > leftIndex) {
+		const int compareResult = strcmp(context, _currentTranslationMessages[rightIndex].msgctxt);
+		if (compareResult == 0)
+			return U32String(_currentTranslationMessages[rightIndex].msgstr);
+		else if (compareResult > 0)
+			break;
+		--rightIndex;
+	}
+	return U32String(_currentTranslationMessages[leftIndex].msgstr);
+}
 
-		int compareResult = strcmp(message, _messageIds[m->msgid].c_str());
+int TranslationManager::findMessageId(const char *message) const {
+	if (_messageIdIndex.empty())
+		return -1;
 
-		if (compareResult == 0) {
-			// Get the range of messages with the same ID (but different context)
-			leftIndex = rightIndex = midIndex;
-			while (
-			    leftIndex > 0 &&
-			    _currentTranslationMessages[leftIndex - 1].msgid == m->msgid
-			) {
-				--leftIndex;
-			}
-			while (
-			    rightIndex < (int)_currentTranslationMessages.size() - 1 &&
-			    _currentTranslationMessages[rightIndex + 1].msgid == m->msgid
-			) {
-				++rightIndex;
-			}
-			// Find the context we want
-			if (context == nullptr || *context == '\0' || leftIndex == rightIndex)
-				return _currentTranslationMessages[leftIndex].msgstr.decode();
-			// We could use again binary search, but there should be only a small number of contexts.
-			while (rightIndex > leftIndex) {
-				compareResult = strcmp(context, _currentTranslationMessages[rightIndex].msgctxt.c_str());
-				if (compareResult == 0)
-					return _currentTranslationMessages[rightIndex].msgstr.decode();
-				else if (compareResult > 0)
-					break;
-				--rightIndex;
-			}
-			return _currentTranslationMessages[leftIndex].msgstr.decode();
-		} else if (compareResult < 0)
-			rightIndex = midIndex - 1;
-		else
-			leftIndex = midIndex + 1;
+	const uint mask = _messageIdIndex.size() - 1;
+	for (uint slot = hashit(message) & mask; _messageIdIndex[slot]; slot = (slot + 1) & mask) {
+		const int msgid = _messageIdIndex[slot] - 1;
+		if (strcmp(message, _messageIds[msgid]) == 0)
+			return msgid;
 	}
 
-	return U32String(message);
+	return -1;
 }
 
 String TranslationManager::getCurrentLanguage() const {
@@ -275,6 +271,43 @@ bool TranslationManager::openTranslationsFile(const FSNode &node, File &inFile,
 	return false;
 }
 
+/**
+ * Read a string of a block, stored as its size followed by its characters
+ * including the terminating zero, and return a pointer to it in the block.
+ * Return nullptr if the string doesn't fit in the block.
+ */
+static const char *readBlockString(const char *&pos, const char *end) {
+	if (end - pos < 2)
+		return nullptr;
+
+	const uint16 len = READ_BE_UINT16(pos);
+	pos += 2;
+	if (len == 0)
+		return "";
+	if (end - pos < len || pos[len - 1] != '\0')
+		return nullptr;
+
+	const char *str = pos;
+	pos += len;
+	return str;
+}
+
+/**
+ * Read a block of the given size from the file, and the number of strings
+ * or messages it starts with.
+ */
+static bool readBlock(File &in, uint32 size, Array<char> &data, uint &count) {
+	if (size < 2)
+		return false;
+
+	data.resize(size);
+	if (in.read(data.data(), size) != size)
+		return false;
+
+	count = READ_BE_UINT16(data.data());
+	return true;
+}
+
 void TranslationManager::loadTranslationsInfoDat(const Common::String &name) {
 	File in;
 	_translationsFileName = name;
@@ -291,7 +324,9 @@ void TranslationManager::loadTranslationsInfoDat(const Common::String &name) {
 
 	// Skip translation description & size for the original language (english) block
 	// Also skip size of each translation block. Each block is written in Uint32BE.
-	for (int i = 0; i < nbTranslations + 2; i++) {
+	in.readUint32BE();
+	const uint32 messageIdsSize = in.readUint32BE();
+	for (int i = 0; i < nbTranslations; i++) {
 		in.readUint32BE();
 	}
 
@@ -308,22 +343,50 @@ void TranslationManager::loadTranslationsInfoDat(const Common::String &name) {
 	}
 
 	// Read messages
-	int numMessages = in.readUint16BE();
+	uint numMessages;
+	if (!readBlock(in, messageIdsSize, _messageIdData, numMessages)) {
+		warning("The '%s' file is truncated. GUI translation will not be available", name.c_str());
+		_langs.clear();
+		_langNames.clear();
+		return;
+	}
+
+	const char *pos = _messageIdData.data() + 2;
+	const char *end = _messageIdData.data() + _messageIdData.size();
 	_messageIds.resize(numMessages);
-	for (int i = 0; i < numMessages; ++i) {
-		len = in.readUint16BE();
-		String msg;
-		while (len > 0) {
-			in.read(buf, len > 256 ? 256 : len);
-			msg += String(buf, len > 256 ? 256 : len - 1);
-			len -= 256;
+	for (uint i = 0; i < numMessages; ++i) {
+		_messageIds[i] = readBlockString(pos, end);
+		if (!_messageIds[i]) {
+			warning("The '%s' file is corrupted. GUI translation will not be available", name.c_str());
+			_langs.clear();
+			_langNames.clear();
+			_messageIds.clear();
+			_messageIdData.clear();
+			return;
 		}
-		_messageIds[i] = msg;
+	}
+
+	// Index the messages in a hash table at most half full
+	uint indexSize = 16;
+	while (indexSize < numMessages * 2)
+		indexSize *= 2;
+	_messageIdIndex.resize(indexSize);
+	for (uint i = 0; i < indexSize; ++i)
+		_messageIdIndex[i] = 0;
+
+	const uint mask = indexSize - 1;
+	for (uint i = 0; i < numMessages; ++i) {
+		uint slot = hashit(_messageIds[i]) & mask;
+		while (_messageIdIndex[slot])
+			slot = (slot + 1) & mask;
+		_messageIdIndex[slot] = i + 1;
 	}
 }
 
 void TranslationManager::loadLanguageDat(int index) {
 	_currentTranslationMessages.clear();
+	_currentTranslationData.clear();
+	_firstTranslation.clear();
 	// Sanity check
 	if (index < 0 || index >= (int)_langs.size()) {
 		if (index != -1)
@@ -335,9 +398,6 @@ void TranslationManager::loadLanguageDat(int index) {
 	if (!openTranslationsFile(in))
 		return;
 
-	char buf[1024];
-	int len;
-
 	// Get number of translations
 	int nbTranslations = in.readUint16BE();
 	if (nbTranslations != (int)_langs.size()) {
@@ -353,32 +413,52 @@ void TranslationManager::loadLanguageDat(int index) {
 	for (int i = 0; i < index + 2; ++i)
 		skipSize += in.readUint32BE();
 
+	const uint32 blockSize = in.readUint32BE();
+
 	// We also need to skip the remaining block sizes
-	skipSize += 4 * (nbTranslations - index);	// 4 because block sizes are written in Uint32BE in the .dat file.
+	skipSize += 4 * (nbTranslations - index - 1);	// 4 because block sizes are written in Uint32BE in the .dat file.
 
 	// Seek to start of block we want to read
 	in.seek(skipSize, SEEK_CUR);
 
-	// Read number of translated messages
-	int nbMessages = in.readUint16BE();
+	// Read the whole block, the messages are used from there
+	uint nbMessages;
+	if (!readBlock(in, blockSize, _currentTranslationData, nbMessages)) {
+		warning("The 'translations.dat' file is truncated. GUI translation will not be available");
+		_currentTranslationData.clear();
+		return;
+	}
+
+	const char *pos = _currentTranslationData.data() + 2;
+	const char *end = _currentTranslationData.data() + _currentTranslationData.size();
 	_currentTranslationMessages.resize(nbMessages);
+	_firstTranslation.resize(_messageIds.size());
+	for (uint i = 0; i < _messageIds.size(); ++i)
+		_firstTranslation[i] = 0;
 
 	// Read messages
-	for (int i = 0; i < nbMessages; ++i) {
-		_currentTranslationMessages[i].msgid = in.readUint16BE();
-		len = in.readUint16BE();
-		String msg;
-		while (len > 0) {
-			in.read(buf, len > 256 ? 256 : len);
-			msg += String(buf, len > 256 ? 256 : len - 1);
-			len -= 256;
+	for (uint i = 0; i < nbMessages; ++i) {
+		PoMessageEntry &entry = _currentTranslationMessages[i];
+		entry.msgid = -1;
+		entry.msgstr = entry.msgctxt = nullptr;
+		if (end - pos >= 2) {
+			entry.msgid = READ_BE_UINT16(pos);
+			pos += 2;
+			entry.msgstr = readBlockString(pos, end);
+			if (entry.msgstr)
+				entry.msgctxt = readBlockString(pos, end);
 		}
-		_currentTranslationMessages[i].msgstr = msg;
-		len = in.readUint16BE();
-		if (len > 0) {
-			in.read(buf, len);
-			_currentTranslationMessages[i].msgctxt = String(buf, len - 1);
+
+		if (entry.msgid < 0 || entry.msgid >= (int)_messageIds.size() || !entry.msgctxt) {
+			warning("The 'translations.dat' file is corrupted. GUI translation will not be available");
+			_currentTranslationMessages.clear();
+			_currentTranslationData.clear();
+			_firstTranslation.clear();
+			return;
 		}
+
+		if (!_firstTranslation[entry.msgid])
+			_firstTranslation[entry.msgid] = i + 1;
 	}
 }
 
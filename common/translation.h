@@ -75,10 +75,10 @@ typedef Array<TLanguage> TLangArray;
  * Structure describing a translated message.
  */
 struct PoMessageEntry {
-	int msgid;         /*!< ID of the message. */
-	String msgctxt;    /*!< Context of the message. It can be empty.
-							Can be used to solve ambiguities. */
-	String msgstr;     /*!< Message string. */
+	int msgid;               /*!< ID of the message. */
+	const char *msgctxt;     /*!< Context of the message. It can be empty.
+								  Can be used to solve ambiguities. */
+	const char *msgstr;      /*!< Message string, in UTF-8. */
 };
 
 /**
@@ -239,11 +239,29 @@ private:
 	 */
 	bool checkHeader(File &in);
 
+	/**
+	 * Return the ID of the given original message, or -1 if it isn't in
+	 * the translations.dat file.
+	 */
+	int findMessageId(const char *message) const;
+
 	StringArray _langs;
 	StringArray _langNames;
 
-	StringArray _messageIds;
+	/**
+	 * The blocks of original and translated messages are kept as they are
+	 * stored in the file, the strings point into them. Messages are only
+	 * decoded when they are looked up.
+	 */
+	Array<char> _messageIdData;
+	Array<const char *> _messageIds;
+	/** Hash table of the message IDs plus one, 0 marks an empty slot. */
+	Array<uint16> _messageIdIndex;
+
+	Array<char> _currentTranslationData;
 	Array<PoMessageEntry> _currentTranslationMessages;
+	/** For each message ID, the index plus one of its first translation, or 0. */
+	Array<uint16> _firstTranslation;
 	int _currentLang;
 	Common::String _translationsFileName;
 };
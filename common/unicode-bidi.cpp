@@ -150,4 +150,18 @@ UnicodeBiDiText convertBiDiU32String(const U32String &input, BiDiParagraph dir)
 	return UnicodeBiDiText(input, dir);
 }
 
+const U32String &BiDiCache::convert(const U32String &input, BiDiParagraph dir) {
+	HashMap<U32String, Entry>::iterator i = _entries.find(input);
+	if (i != _entries.end() && i->_value.dir == dir)
+		return i->_value.visual;
+
+	if (i == _entries.end() && _entries.size() >= _maxEntries)
+		_entries.clear();
+
+	Entry &entry = _entries[input];
+	entry.dir = dir;
+	entry.visual = UnicodeBiDiText(input, dir).visual;
+	return entry.visual;
+}
+
 } // End of namespace Common
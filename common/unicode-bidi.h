@@ -24,6 +24,8 @@
 
 #include "common/str.h"
 #include "common/ustr.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
 #include "common/language.h"
 
 namespace Common {
@@ -63,6 +65,33 @@ public:
 	uint32 size() const { return logical.size(); }
 };
 
+/**
+ * A cache of the visual order of recently converted strings, for code which
+ * draws the same strings each time it redraws. It is emptied whenever it
+ * grows past its size limit.
+ */
+class BiDiCache {
+public:
+	BiDiCache(uint maxEntries = 256) : _maxEntries(maxEntries) {}
+
+	/**
+	 * Return the visual order of @p input, converting it if it isn't cached.
+	 * The reference is valid until the next call.
+	 */
+	const U32String &convert(const U32String &input, BiDiParagraph dir = BIDI_PAR_ON);
+
+	void clear() { _entries.clear(); }
+
+private:
+	struct Entry {
+		BiDiParagraph dir;
+		U32String visual;
+	};
+
+	HashMap<U32String, Entry> _entries;
+	uint _maxEntries;
+};
+
 /* just call the constructor for convenience */
 UnicodeBiDiText convertBiDiU32String(const U32String &input, BiDiParagraph dir = BIDI_PAR_ON);
 String convertBiDiString(const String &input, const Common::Language lang, BiDiParagraph dir = BIDI_PAR_ON);
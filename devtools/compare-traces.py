@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+
+# This script compares two event recorder traces, written with
+# --record-mode=trace by two builds playing back the same recording.
+# It reports the first frame where the builds diverged, and how their
+# frame times compare.
+# Return with exit code 1 if the traces differ, 0 otherwise
+
+import argparse
+import sys
+
+parser = argparse.ArgumentParser(description="Compare two event recorder traces")
+parser.add_argument('reference', help="The trace of the reference build")
+parser.add_argument('trace', help="The trace of the build to check")
+parser.add_argument('-s', '--show', type=int, default=10, metavar='N', help="Show up to N differing frames (default: 10)")
+args = parser.parse_args()
+
+def read_trace(file_name):
+	frames = []
+	with open(file_name, 'r') as f:
+		for line in f:
+			line = line.strip()
+			if not line or line.startswith('#'):
+				continue
+			index, time, duration, screen_hash = line.split()
+			frames.append((int(index), int(time), int(duration), screen_hash))
+	return frames
+
+def percentile(durations, percent):
+	if not durations:
+		return 0
+	return sorted(durations)[(len(durations) - 1) * percent // 100]
+
+def print_stats(name, frames):
+	durations = [frame[2] for frame in frames]
+	print('{0:10} frames={1} time_ms={2:.1f} p50_ms={3:.3f} p95_ms={4:.3f} max_ms={5:.3f}'.format(
+		name, len(frames), sum(durations) / 1000.0, percentile(durations, 50) / 1000.0,
+		percentile(durations, 95) / 1000.0, max(durations, default=0) / 1000.0))
+
+reference = read_trace(args.reference)
+trace = read_trace(args.trace)
+
+print_stats('reference', reference)
+print_stats('trace', trace)
+
+# Only the frames both traces have are compared for speed
+common = min(len(reference), len(trace))
+reference_time = sum(frame[2] for frame in reference[:common])
+trace_time = sum(frame[2] for frame in trace[:common])
+if trace_time:
+	print('speedup over {0} frames: {1:.3f}'.format(common, reference_time / trace_time))
+
+different = []
+for i in range(common):
+	if reference[i][1] != trace[i][1] or reference[i][3] != trace[i][3]:
+		different.append(i)
+
+if different:
+	print('{0} frames differ, the first one is frame {1}'.format(len(different), different[0]))
+	for i in different[:args.show]:
+		print('  frame {0}: time_ms {1} / {2}, hash {3} / {4}'.format(
+			i, reference[i][1], trace[i][1], reference[i][3], trace[i][3]))
+
+if len(reference) != len(trace):
+	print('the traces have a different number of frames')
+
+if different or len(reference) != len(trace):
+	sys.exit(1)
+print('the traces match')
@@ -407,6 +407,7 @@ Common::Error AdvancedMetaEngineDetectionBase::identifyGame(DetectedGame &game,
 
 	// Detection is done, no need to keep archives in memory anymore
 	ADCacheMan.clearArchives();
+	ADCacheMan.savePersistentCache();
 
 	if (!agdDesc.desc)
 		return Common::kNoGameDataFoundError;
@@ -468,6 +469,97 @@ namespace Common {
 	DECLARE_SINGLETON(AdvancedDetectorCacheManager);
 }
 
+#define DETECTION_CACHE_HEADER "# ScummVM detection cache v1"
+
+Common::FSNode AdvancedDetectorCacheManager::getPersistentCacheFile() {
+	// Keep the cache next to the configuration file
+	Common::Path configFile = ConfMan.getCustomConfigFileName();
+	if (configFile.empty())
+		configFile = g_system->getDefaultConfigFileName();
+
+	return Common::FSNode(configFile).getParent().getChild("detection-cache.txt");
+}
+
+void AdvancedDetectorCacheManager::loadPersistentCache() {
+	persistentLoaded = true;
+
+	Common::FSNode file = getPersistentCacheFile();
+	if (!file.exists())
+		return;
+
+	Common::ScopedPtr<Common::SeekableReadStream> stream(file.createReadStream());
+	if (!stream || stream->readLine() != DETECTION_CACHE_HEADER)
+		return;
+
+	// Every line is: md5 <tab> size <tab> modification time <tab> key
+	while (!stream->eos() && !stream->err()) {
+		Common::String line = stream->readLine();
+
+		const size_t sizePos = line.findFirstOf('\t');
+		const size_t timePos = sizePos == Common::String::npos ? sizePos : line.findFirstOf('\t', sizePos + 1);
+		const size_t keyPos = timePos == Common::String::npos ? timePos : line.findFirstOf('\t', timePos + 1);
+		if (sizePos != 32 || keyPos == Common::String::npos || keyPos + 1 == line.size())
+			continue;
+
+		PersistentEntry entry;
+		entry.md5 = line.substr(0, sizePos);
+		entry.size = line.substr(sizePos + 1, timePos - sizePos - 1).asUint64();
+		entry.modificationTime = line.substr(timePos + 1, keyPos - timePos - 1).asUint64();
+		persistentHashMap.setVal(line.substr(keyPos + 1), entry);
+	}
+
+	debugC(2, kDebugGlobalDetection, "Loaded %d entries from the detection cache", persistentHashMap.size());
+}
+
+bool AdvancedDetectorCacheManager::getPersistentMD5(const Common::String &key, int64 size, int64 modificationTime, Common::String &md5) {
+	if (!persistentLoaded)
+		loadPersistentCache();
+
+	PersistentHashMap::const_iterator entry = persistentHashMap.find(key);
+	if (entry == persistentHashMap.end() || entry->_value.size != size || entry->_value.modificationTime != modificationTime)
+		return false;
+
+	md5 = entry->_value.md5;
+	return true;
+}
+
+void AdvancedDetectorCacheManager::setPersistentMD5(const Common::String &key, int64 size, int64 modificationTime, const Common::String &md5) {
+	if (!persistentLoaded)
+		loadPersistentCache();
+
+	PersistentEntry &entry = persistentHashMap.getOrCreateVal(key);
+	entry.size = size;
+	entry.modificationTime = modificationTime;
+	entry.md5 = md5;
+	persistentDirty = true;
+}
+
+void AdvancedDetectorCacheManager::savePersistentCache(bool force) {
+	if (!persistentDirty)
+		return;
+
+	const uint32 now = g_system->getMillis();
+	if (!force && persistentSaveTime && now - persistentSaveTime < 5000)
+		return;
+
+	Common::ScopedPtr<Common::WriteStream> stream(getPersistentCacheFile().createWriteStream(true));
+	if (!stream) {
+		warning("Could not write the detection cache");
+		persistentDirty = false;
+		return;
+	}
+
+	stream->writeString(DETECTION_CACHE_HEADER "\n");
+	for (PersistentHashMap::const_iterator entry = persistentHashMap.begin(); entry != persistentHashMap.end(); ++entry) {
+		stream->writeString(Common::String::format("%s\t%llu\t%llu\t%s\n", entry->_value.md5.c_str(),
+			(unsigned long long)entry->_value.size, (unsigned long long)entry->_value.modificationTime, entry->_key.c_str()));
+	}
+	stream->finalize();
+
+	persistentDirty = false;
+	persistentSaveTime = now;
+}
+
 
 static MD5Properties gameFileToMD5Props(const ADGameFileDescription *fileEntry, uint32 gameFlags) {
 	MD5Properties ret = kMD5Head;
@@ -545,11 +637,34 @@ bool AdvancedMetaEngineDetectionBase::getFileProperties(const FileMap &allFiles,
 		return true;
 	}
 
+	// Plain files can also be found in the persistent cache, keyed by their
+	// full path. Files in archives and Mac forks are always hashed.
+	Common::String persistentKey;
+	int64 fileSize, fileTime;
+	if (!(md5prop & (kMD5MacMask | kMD5Archive)) && allFiles.contains(fname) && allFiles[fname].getFileInfo(fileSize, fileTime)) {
+		persistentKey = md5PropToCachePrefix(md5prop);
+		persistentKey += ':';
+		persistentKey += allFiles[fname].getPath().toString(Common::Path::kNativeSeparator);
+		persistentKey += ':';
+		persistentKey += Common::String::format("%d", _md5Bytes);
+
+		if (ADCacheMan.getPersistentMD5(persistentKey, fileSize, fileTime, fileProps.md5)) {
+			fileProps.size = fileSize;
+			fileProps.md5prop = (MD5Properties)(md5prop & kMD5Tail);
+			ADCacheMan.setMD5(hashname, fileProps.md5);
+			ADCacheMan.setSize(hashname, fileProps.size);
+			return true;
+		}
+	}
+
 	bool res = getFilePropertiesIntern(_md5Bytes, allFiles, md5prop, fname, fileProps);
 
 	if (res) {
 		ADCacheMan.setMD5(hashname, fileProps.md5);
 		ADCacheMan.setSize(hashname, fileProps.size);
+
+		if (!persistentKey.empty())
+			ADCacheMan.setPersistentMD5(persistentKey, fileSize, fileTime, fileProps.md5);
 	}
 
 	return res;
@@ -754,6 +754,23 @@ public:
 		return (md5HashMap.contains(fname) && sizeHashMap.contains(fname));
 	}
 
+	/**
+	 * Look up an MD5 in the persistent cache, which survives detection runs
+	 * and sessions. The entry is only returned if the size and modification
+	 * time of the file are still the same as when it was stored.
+	 *
+	 * @param key  Key identifying the file by its full path and the hashed range.
+	 */
+	bool getPersistentMD5(const Common::String &key, int64 size, int64 modificationTime, Common::String &md5);
+	void setPersistentMD5(const Common::String &key, int64 size, int64 modificationTime, const Common::String &md5);
+
+	/**
+	 * Write the persistent cache to disk if it has changed. Unless @p force
+	 * is set, this is skipped if the cache was saved only a moment ago, so
+	 * that scanning many directories doesn't rewrite it all the time.
+	 */
+	void savePersistentCache(bool force = true);
+
 	void addArchive(const Common::FSNode &node, Common::Archive *archivePtr) {
 		if (!archivePtr)
 			return;
@@ -771,7 +788,7 @@ public:
 		return archiveHashMap.getValOrDefault(node.getPath(), nullptr);
 	}
 
-	AdvancedDetectorCacheManager() {
+	AdvancedDetectorCacheManager() : persistentLoaded(false), persistentDirty(false), persistentSaveTime(0) {
 		clear();
 	}
 
@@ -797,6 +814,21 @@ private:
 	FileHashMap md5HashMap;
 	SizeHashMap sizeHashMap;
 	ArchiveHashMap archiveHashMap;
+
+	struct PersistentEntry {
+		int64 size;
+		int64 modificationTime;
+		Common::String md5;
+	};
+
+	typedef Common::HashMap<Common::String, PersistentEntry> PersistentHashMap;
+	PersistentHashMap persistentHashMap;
+	bool persistentLoaded;
+	bool persistentDirty;
+	uint32 persistentSaveTime;
+
+	void loadPersistentCache();
+	static Common::FSNode getPersistentCacheFile();
 };
 
 /** Convenience shortcut for accessing the MD5CacheManager. */
@@ -198,6 +198,7 @@ void AgiEngine::agiDeinit() {
 	_words->clearEgoWords(); // remove all words from memory
 	unloadResources();    // unload resources in memory
 	unloadResource(RESOURCETYPE_LOGIC, 0);
+	clearViewCache();
 	_objects.clear();
 	_words->unloadDictionary();
 
@@ -272,6 +273,8 @@ int AgiEngine::loadResource(int16 resourceType, int16 resourceNr) {
 		// the time?
 		if (~_game.dirView[resourceNr].flags & RES_LOADED) {
 			unloadResource(RESOURCETYPE_VIEW, resourceNr);
+			if (restoreCachedView(resourceNr))
+				break;
 			data = _loader->loadVolumeResource(&_game.dirView[resourceNr]);
 			if (data) {
 				_game.dirView[resourceNr].flags |= RES_LOADED;
@@ -433,6 +436,9 @@ AgiEngine::AgiEngine(OSystem *syst, const AGIGameDescription *gameDesc) : AgiBas
 
 	_intobj = nullptr;
 
+	_viewCacheSize = 0;
+	_viewCacheUseCounter = 0;
+
 	_restartGame = false;
 
 	_firstSlot = 0;
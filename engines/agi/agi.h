@@ -873,6 +873,30 @@ public:
 	int decodeView(byte *resourceData, uint16 resourceSize, int16 viewNr);
 
 private:
+	/**
+	 * Decoded view, which was unloaded and can be loaded again without
+	 * reading and decoding its resource.
+	 */
+	struct CachedView {
+		int16 viewNr;
+		uint32 size;
+		uint32 lastUse;
+		AgiView view;
+	};
+
+	enum {
+		kViewCacheSize = 256 * 1024
+	};
+
+	Common::Array<CachedView> _viewCache;
+	uint32 _viewCacheSize;
+	uint32 _viewCacheUseCounter;
+
+	bool restoreCachedView(int16 viewNr);
+	void cacheView(int16 viewNr);
+	void clearViewCache();
+	static void freeView(AgiView &viewData);
+
 	void unpackViewCelData(AgiViewCel *celData, byte *compressedData, uint16 compressedSize, int16 viewNr);
 	void unpackViewCelDataAGI256(AgiViewCel *celData, byte *compressedData, uint16 compressedSize, int16 viewNr);
 
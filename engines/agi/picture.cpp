@@ -65,6 +65,12 @@ PictureMgr::PictureMgr(AgiBase *agi, GfxMgr *gfx) {
 
 	_width = 0;
 	_height = 0;
+
+	_pictureCacheUseCounter = 0;
+}
+
+PictureMgr::~PictureMgr() {
+	clearPictureCache();
 }
 
 /**
@@ -768,14 +774,28 @@ void PictureMgr::decodePicture(int16 resourceNr, bool clearScreen, bool agi256,
 	_width = width;
 	_height = height;
 
-	if (clearScreen) {
-		_gfx->clear(15, getInitialPriorityColor()); // white, priority 4 or 1
-	}
-
-	if (!agi256) {
-		drawPicture();
+	// A picture drawn onto cleared screens always gives the same result,
+	// so rooms which are entered again don't need to be drawn again
+	if (clearScreen && width == _DEFAULT_WIDTH && height == _DEFAULT_HEIGHT) {
+		if (!restoreCachedPicture(resourceNr, agi256)) {
+			_gfx->clear(15, getInitialPriorityColor()); // white, priority 4 or 1
+			if (!agi256) {
+				drawPicture();
+			} else {
+				drawPicture_AGI256();
+			}
+			cachePicture(resourceNr, agi256);
+		}
 	} else {
-		drawPicture_AGI256();
+		if (clearScreen) {
+			_gfx->clear(15, getInitialPriorityColor()); // white, priority 4 or 1
+		}
+
+		if (!agi256) {
+			drawPicture();
+		} else {
+			drawPicture_AGI256();
+		}
 	}
 
 	if (clearScreen) {
@@ -784,6 +804,54 @@ void PictureMgr::decodePicture(int16 resourceNr, bool clearScreen, bool agi256,
 	_vm->recordImageStackCall(ADD_PIC, resourceNr, clearScreen, agi256, 0, 0, 0, 0);
 }
 
+/**
+ * Copies the screens of a cached picture to the visual and priority screens.
+ * Returns false if the picture isn't cached.
+ */
+bool PictureMgr::restoreCachedPicture(int16 resourceNr, bool agi256) {
+	for (uint i = 0; i < _pictureCache.size(); i++) {
+		CachedPicture &cached = _pictureCache[i];
+		if (cached.resourceNr == resourceNr && cached.agi256 == agi256) {
+			debugC(kDebugLevelPictures, "Restoring cached picture %d", resourceNr);
+			cached.lastUse = ++_pictureCacheUseCounter;
+			_gfx->block_restore(0, 0, SCRIPT_WIDTH, SCRIPT_HEIGHT, cached.screens);
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Saves the visual and priority screens of a freshly drawn picture,
+ * replacing the least recently used one when the cache is full.
+ */
+void PictureMgr::cachePicture(int16 resourceNr, bool agi256) {
+	uint slot = _pictureCache.size();
+	if (slot < kPictureCacheSize) {
+		CachedPicture cached;
+		cached.screens = new byte[SCRIPT_WIDTH * SCRIPT_HEIGHT * 2];
+		_pictureCache.push_back(cached);
+	} else {
+		slot = 0;
+		for (uint i = 1; i < _pictureCache.size(); i++) {
+			if (_pictureCache[i].lastUse < _pictureCache[slot].lastUse)
+				slot = i;
+		}
+	}
+
+	CachedPicture &cached = _pictureCache[slot];
+	cached.resourceNr = resourceNr;
+	cached.agi256 = agi256;
+	cached.lastUse = ++_pictureCacheUseCounter;
+	_gfx->block_save(0, 0, SCRIPT_WIDTH, SCRIPT_HEIGHT, cached.screens);
+}
+
+void PictureMgr::clearPictureCache() {
+	for (uint i = 0; i < _pictureCache.size(); i++)
+		delete[] _pictureCache[i].screens;
+	_pictureCache.clear();
+}
+
 /**
  * Draws a picture from a buffer to the visual and control screens.
  * This interface is used by PreAGI games.
@@ -22,6 +22,8 @@
 #ifndef AGI_PICTURE_H
 #define AGI_PICTURE_H
 
+#include "common/array.h"
+
 namespace Agi {
 
 #define _DEFAULT_WIDTH      160
@@ -48,7 +50,7 @@ class GfxMgr;
 class PictureMgr {
 public:
 	PictureMgr(AgiBase *agi, GfxMgr *gfx);
-	virtual ~PictureMgr() { }
+	virtual ~PictureMgr();
 
 	int16 getResourceNr() const { return _resourceNr; };
 
@@ -75,6 +77,8 @@ public:
 	void decodePicture(int16 resourceNr, bool clearScreen, bool agi256 = false, int16 width = _DEFAULT_WIDTH, int16 height = _DEFAULT_HEIGHT);
 	void decodePictureFromBuffer(byte *data, uint32 length, bool clearScreen, int16 width = _DEFAULT_WIDTH, int16 height = _DEFAULT_HEIGHT);
 
+	void clearPictureCache();
+
 protected:
 	virtual void drawPicture();
 	void drawPicture_AGI256();
@@ -117,6 +121,28 @@ protected:
 
 	int16 _width;
 	int16 _height;
+
+private:
+	/**
+	 * Visual and priority screens of a picture drawn onto cleared screens,
+	 * as saved by GfxMgr::block_save().
+	 */
+	struct CachedPicture {
+		int16 resourceNr;
+		bool agi256;
+		uint32 lastUse;
+		byte *screens;
+	};
+
+	enum {
+		kPictureCacheSize = 4
+	};
+
+	bool restoreCachedPicture(int16 resourceNr, bool agi256);
+	void cachePicture(int16 resourceNr, bool agi256);
+
+	Common::Array<CachedPicture> _pictureCache;
+	uint32 _pictureCacheUseCounter;
 };
 
 } // End of namespace Agi
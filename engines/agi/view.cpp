@@ -443,9 +443,24 @@ void AgiEngine::unloadView(int16 viewNr) {
 	// Rebuild sprite list, see Sarien bug #779302
 	_sprites->eraseSprites();
 
-	// free data
-	for (int16 loopNr = 0; loopNr < viewData->loopCount; loopNr++) {
-		AgiViewLoop *loopData = &viewData->loop[loopNr];
+	// keep the decoded data around, rooms are often entered again
+	cacheView(viewNr);
+	viewData->reset();
+
+	// Mark this view as not loaded anymore
+	_game.dirView[viewNr].flags &= ~RES_LOADED;
+
+	_sprites->buildAllSpriteLists();
+	_sprites->drawAllSpriteLists();
+}
+
+/**
+ * Frees all data of a decoded view
+ * @param viewData decoded view
+ */
+void AgiEngine::freeView(AgiView &viewData) {
+	for (int16 loopNr = 0; loopNr < viewData.loopCount; loopNr++) {
+		AgiViewLoop *loopData = &viewData.loop[loopNr];
 		for (int16 celNr = 0; celNr < loopData->celCount; celNr++) {
 			AgiViewCel *celData = &loopData->cel[celNr];
 
@@ -453,20 +468,83 @@ void AgiEngine::unloadView(int16 viewNr) {
 		}
 		delete[] loopData->cel;
 	}
-	delete[] viewData->loop;
-	delete[] viewData->description;
+	delete[] viewData.loop;
+	delete[] viewData.description;
 
-	viewData->headerCycleTime = 0;
-	viewData->headerStepSize = 0;
-	viewData->description = nullptr;
-	viewData->loop = nullptr;
-	viewData->loopCount = 0;
+	viewData.reset();
+}
 
-	// Mark this view as not loaded anymore
-	_game.dirView[viewNr].flags &= ~RES_LOADED;
+/**
+ * Moves the decoded data of a view, which is being unloaded, into the view
+ * cache. The least recently used views are freed to keep the cache within
+ * its size.
+ * @param viewNr number of view resource
+ */
+void AgiEngine::cacheView(int16 viewNr) {
+	AgiView &viewData = _game.views[viewNr];
 
-	_sprites->buildAllSpriteLists();
-	_sprites->drawAllSpriteLists();
+	uint32 size = sizeof(AgiView);
+	if (viewData.description)
+		size += strlen((const char *)viewData.description) + 1;
+	for (int16 loopNr = 0; loopNr < viewData.loopCount; loopNr++) {
+		const AgiViewLoop &loopData = viewData.loop[loopNr];
+		size += sizeof(AgiViewLoop) + loopData.celCount * sizeof(AgiViewCel);
+		for (int16 celNr = 0; celNr < loopData.celCount; celNr++)
+			size += loopData.cel[celNr].width * loopData.cel[celNr].height;
+	}
+
+	if (size > kViewCacheSize) {
+		freeView(viewData);
+		return;
+	}
+
+	while (_viewCacheSize + size > kViewCacheSize) {
+		uint oldest = 0;
+		for (uint i = 1; i < _viewCache.size(); i++) {
+			if (_viewCache[i].lastUse < _viewCache[oldest].lastUse)
+				oldest = i;
+		}
+		_viewCacheSize -= _viewCache[oldest].size;
+		freeView(_viewCache[oldest].view);
+		_viewCache.remove_at(oldest);
+	}
+
+	CachedView cached;
+	cached.viewNr = viewNr;
+	cached.size = size;
+	cached.lastUse = ++_viewCacheUseCounter;
+	cached.view = viewData;
+	_viewCache.push_back(cached);
+	_viewCacheSize += size;
+}
+
+/**
+ * Loads a view from the view cache.
+ * @param viewNr number of view resource
+ * @return false if the view isn't cached
+ */
+bool AgiEngine::restoreCachedView(int16 viewNr) {
+	for (uint i = 0; i < _viewCache.size(); i++) {
+		if (_viewCache[i].viewNr == viewNr) {
+			debugC(5, kDebugLevelResources, "restore cached view %d", viewNr);
+			_game.views[viewNr] = _viewCache[i].view;
+			_game.dirView[viewNr].flags |= RES_LOADED;
+			_viewCacheSize -= _viewCache[i].size;
+			_viewCache.remove_at(i);
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Frees all views in the view cache.
+ */
+void AgiEngine::clearViewCache() {
+	for (uint i = 0; i < _viewCache.size(); i++)
+		freeView(_viewCache[i].view);
+	_viewCache.clear();
+	_viewCacheSize = 0;
 }
 
 /**
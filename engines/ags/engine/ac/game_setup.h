@@ -61,6 +61,7 @@ using AGS::Shared::String;
 struct GameSetup {
 	static const size_t DefSpriteCacheSize = (128 * 1024); // 128 MB
 	static const size_t DefTexCacheSize = (128 * 1024);    // 128 MB
+	static const size_t DefCompressedSpriteCacheSize = (16 * 1024); // 16 MB
 
 	bool  audio_enabled;
 	String audio_driver;
@@ -92,6 +93,7 @@ struct GameSetup {
 	bool  RenderAtScreenRes; // render sprites at screen resolution, as opposed to native one
 	size_t SpriteCacheSize = DefSpriteCacheSize;  // in KB
 	size_t TextureCacheSize = DefTexCacheSize;  // in KB
+	size_t CompressedSpriteCacheSize = DefCompressedSpriteCacheSize;  // in KB, 0 to disable
 	bool  clear_cache_on_room_change; // for low-end devices: clear resource caches on room change
 	bool  load_latest_save; // load latest saved game on launch
 	ScreenRotation rotation;
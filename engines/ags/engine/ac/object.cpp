@@ -39,6 +39,7 @@
 #include "ags/engine/main/game_run.h"
 #include "ags/engine/ac/route_finder.h"
 #include "ags/engine/gfx/graphics_driver.h"
+#include "ags/shared/ac/sprite_cache.h"
 #include "ags/shared/ac/view.h"
 #include "ags/engine/ac/view_frame.h"
 #include "ags/shared/gfx/bitmap.h"
@@ -710,6 +711,13 @@ bool CycleViewAnim(int view, uint16_t &o_loop, uint16_t &o_frame, bool forwards,
 			frame--;
 	}
 
+	// Start decoding the frame which is going to be shown next
+	if (!done) {
+		const int next_frame = forwards ? frame + 1 : frame - 1;
+		if ((next_frame >= 0) && (next_frame < aview->loops[loop].numFrames))
+			_GP(spriteset).PrefetchSprite(aview->loops[loop].frames[next_frame].pic);
+	}
+
 	// Update object values
 	o_loop = loop;
 	o_frame = frame;
@@ -21,6 +21,8 @@
 
 #include "ags/engine/gfx/gfxfilter_scummvm_renderer.h"
 #include "ags/engine/gfx/ali_3d_scummvm.h"
+#include "common/jobs.h"
+#include "common/system.h"
 #include "common/std/algorithm.h"
 #include "ags/engine/ac/sys_events.h"
 #include "ags/engine/gfx/gfxfilter_scummvm_renderer.h"
@@ -40,6 +42,115 @@ using namespace Shared;
 
 static RGB faded_out_palette[256];
 
+// Sprites covering fewer pixels are not worth splitting between the threads
+static const int kMinBandedArea = 64 * 1024;
+static const int kMinBandHeight = 16;
+
+// Frames are compared with the last presented one in bands of this many rows
+static const int kChangedBandHeight = 16;
+
+// Kinds of sprite drawing which may be done in horizontal bands
+enum BandDrawOp {
+	kBandDraw_Copy,       // Blit
+	kBandDraw_Masked,     // Blit with kBitmap_Transparency
+	kBandDraw_TransBlend, // TransBlendBlt, using the current blender
+	kBandDraw_LitBlend    // LitBlendBlt of the surface onto itself
+};
+
+// Band of a surface which is drawn upon by a worker thread. The whole banded
+// area is marked dirty in the parent surface before the bands are created, so
+// drawing upon them does not have to touch the parent.
+class BandSurface : public Graphics::ManagedSurface, public BITMAP {
+public:
+	BandSurface(Graphics::ManagedSurface &surf, const Common::Rect &bounds) :
+		Graphics::ManagedSurface(surf, bounds), BITMAP(this) {
+		// Allegro uses 255, 0, 255 RGB as the transparent color
+		if (surf.format.bytesPerPixel == 2 || surf.format.bytesPerPixel == 4)
+			setTransparentColor(surf.format.RGBToColor(255, 0, 255));
+	}
+
+	void addDirtyRect(const Common::Rect &) override {}
+};
+
+struct BandDrawJob {
+	BandDrawOp Op;
+	Bitmap *Src;
+	int X, Y;
+	int LightAmount;
+	std::vector<std::unique_ptr<Bitmap>> Bands;
+	std::vector<Point> BandPos;
+};
+
+static void DrawBandsProc(uint begin, uint end, void *refCon) {
+	const BandDrawJob &job = *(const BandDrawJob *)refCon;
+	for (uint i = begin; i < end; ++i) {
+		Bitmap *band = job.Bands[i].get();
+		const int x = job.X - job.BandPos[i].X;
+		const int y = job.Y - job.BandPos[i].Y;
+		switch (job.Op) {
+		case kBandDraw_Copy:
+			band->Blit(job.Src, 0, 0, x, y, job.Src->GetWidth(), job.Src->GetHeight());
+			break;
+		case kBandDraw_Masked:
+			band->Blit(job.Src, x, y, kBitmap_Transparency);
+			break;
+		case kBandDraw_TransBlend:
+			band->TransBlendBlt(job.Src, x, y);
+			break;
+		case kBandDraw_LitBlend:
+			band->LitBlendBlt(band, 0, 0, job.LightAmount);
+			break;
+		}
+	}
+}
+
+// Draws a large sprite by splitting the destination area in horizontal bands
+// and drawing these on the worker threads. The blender has to be set up
+// beforehand, as it's shared by all the threads.
+// Returns false if the sprite should be drawn the usual way instead.
+static bool DrawSpriteInBands(Bitmap *surface, Bitmap *src, int x, int y, BandDrawOp op, int light_amount = 0) {
+	Common::JobSystem *jobs = g_system->getJobSystem();
+	const int threads = jobs->getThreadCount();
+	if (threads <= 1)
+		return false;
+
+	const Rect area = IntersectRects(surface->GetClip(), RectWH(x, y, src->GetWidth(), src->GetHeight()));
+	if (area.IsEmpty() || area.GetWidth() * area.GetHeight() < kMinBandedArea)
+		return false;
+	const int count = MIN(threads, area.GetHeight() / kMinBandHeight);
+	if (count < 2)
+		return false;
+
+	BandDrawJob job;
+	job.Op = op;
+	job.Src = src;
+	job.X = x;
+	job.Y = y;
+	job.LightAmount = light_amount;
+	Graphics::ManagedSurface &parent = **surface->GetAllegroBitmap();
+	parent.addDirtyRect(Common::Rect(area.Left, area.Top, area.Right + 1, area.Bottom + 1));
+	for (int i = 0; i < count; ++i) {
+		const int top = area.Top + area.GetHeight() * i / count;
+		const int bottom = area.Top + area.GetHeight() * (i + 1) / count;
+		BandSurface *band = new BandSurface(parent, Common::Rect(area.Left, top, area.Right + 1, bottom));
+		job.Bands.push_back(std::unique_ptr<Bitmap>(new Bitmap(band, false)));
+		job.BandPos.push_back(Point(area.Left, top));
+	}
+	jobs->parallelFor(count, DrawBandsProc, &job);
+	return true;
+}
+
+// Same as GfxUtil::DrawSpriteWithTransparency, for the sprites which don't need a conversion
+static bool DrawSpriteWithTransparencyInBands(Bitmap *ds, Bitmap *sprite, int x, int y, int alpha) {
+	if ((alpha <= 0) || (ds->GetColorDepth() != sprite->GetColorDepth()))
+		return false;
+	if ((alpha < 0xFF) && (ds->GetColorDepth() > 8)) {
+		set_trans_blender(0, 0, 0, alpha);
+		return DrawSpriteInBands(ds, sprite, x, y, kBandDraw_TransBlend);
+	}
+	return DrawSpriteInBands(ds, sprite, x, y, kBandDraw_Masked);
+}
+
 
 // ----------------------------------------------------------------------------
 // ScummVMRendererGraphicsDriver
@@ -54,6 +165,7 @@ ScummVMRendererGraphicsDriver::ScummVMRendererGraphicsDriver() {
 }
 
 ScummVMRendererGraphicsDriver::~ScummVMRendererGraphicsDriver() {
+	InvalidateLastFrame();
 	delete _screen;
 	ScummVMRendererGraphicsDriver::UnInit();
 }
@@ -171,6 +283,7 @@ void ScummVMRendererGraphicsDriver::DestroyVirtualScreen() {
 }
 
 void ScummVMRendererGraphicsDriver::ReleaseDisplayMode() {
+	InvalidateLastFrame();
 	OnModeReleased();
 	ClearDrawLists();
 }
@@ -469,7 +582,8 @@ size_t ScummVMRendererGraphicsDriver::RenderSpriteBatch(const ALSpriteBatch &bat
 		} else if (sprite.ddb == reinterpret_cast<ALSoftwareBitmap *>(DRAWENTRY_TINT)) {
 			// draw screen tint fx
 			set_trans_blender(_tint_red, _tint_green, _tint_blue, 0);
-			surface->LitBlendBlt(surface, 0, 0, 128);
+			if (!DrawSpriteInBands(surface, surface, 0, 0, kBandDraw_LitBlend, 128))
+				surface->LitBlendBlt(surface, 0, 0, 128);
 			continue;
 		}
 
@@ -481,7 +595,8 @@ size_t ScummVMRendererGraphicsDriver::RenderSpriteBatch(const ALSpriteBatch &bat
 		} // fully transparent, do nothing
 		else if ((bitmap->_opaque) && (bitmap->_bmp == surface) && (bitmap->_alpha == 255)) {
 		} else if (bitmap->_opaque) {
-			surface->Blit(bitmap->_bmp, 0, 0, drawAtX, drawAtY, bitmap->_bmp->GetWidth(), bitmap->_bmp->GetHeight());
+			if (!DrawSpriteInBands(surface, bitmap->_bmp, drawAtX, drawAtY, kBandDraw_Copy))
+				surface->Blit(bitmap->_bmp, 0, 0, drawAtX, drawAtY, bitmap->_bmp->GetWidth(), bitmap->_bmp->GetHeight());
 			// TODO: we need to also support non-masked translucent blend, but...
 			// Allegro 4 **does not have such function ready** :( (only masked blends, where it skips magenta pixels);
 			// I am leaving this problem for the future, as coincidentally software mode does not need this atm.
@@ -491,46 +606,102 @@ size_t ScummVMRendererGraphicsDriver::RenderSpriteBatch(const ALSpriteBatch &bat
 			else
 				set_blender_mode(kArgbToRgbBlender, 0, 0, 0, bitmap->_alpha);
 
-			surface->TransBlendBlt(bitmap->_bmp, drawAtX, drawAtY);
+			if (!DrawSpriteInBands(surface, bitmap->_bmp, drawAtX, drawAtY, kBandDraw_TransBlend))
+				surface->TransBlendBlt(bitmap->_bmp, drawAtX, drawAtY);
 		} else {
 			// here _transparency is used as alpha (between 1 and 254), but 0 means opaque!
-			GfxUtil::DrawSpriteWithTransparency(surface, bitmap->_bmp, drawAtX, drawAtY,
-				bitmap->_alpha);
+			if (!DrawSpriteWithTransparencyInBands(surface, bitmap->_bmp, drawAtX, drawAtY, bitmap->_alpha))
+				GfxUtil::DrawSpriteWithTransparency(surface, bitmap->_bmp, drawAtX, drawAtY,
+					bitmap->_alpha);
 		}
 	}
 	return from;
 }
 
-void ScummVMRendererGraphicsDriver::copySurface(const Graphics::Surface &src, bool mode) {
-	assert(src.w == _screen->w && src.h == _screen->h && src.pitch == _screen->pitch);
-	const uint32 *srcP = (const uint32 *)src.getPixels();
-	uint32 *destP = (uint32 *)_screen->getPixels();
-	uint32 pixel;
-	int x1 = 9999, y1 = 9999, x2 = -1, y2 = -1;
-
-	for (int y = 0; y < src.h; ++y) {
-		for (int x = 0; x < src.w; ++x, ++srcP, ++destP) {
-			if (!mode) {
-				pixel = (*srcP & 0xff00ff00) |
-					((*srcP & 0xff) << 16) |
-					((*srcP >> 16) & 0xff);
-			} else {
-				pixel = ((*srcP & 0xffffff) << 8) |
-					((*srcP >> 24) & 0xff);
-			}
+void ScummVMRendererGraphicsDriver::InvalidateLastFrame() {
+	_lastFrame.free();
+	_changedRects.clear();
+}
+
+void ScummVMRendererGraphicsDriver::FindChangedRects(const Graphics::Surface &src, const Graphics::PixelFormat &screen_format) {
+	_changedRects.clear();
+	if (_lastFrame.w != src.w || _lastFrame.h != src.h || _lastFrame.format != src.format ||
+		_lastFrameScreenFormat != screen_format) {
+		_lastFrame.free();
+		_lastFrame.copyFrom(src);
+		_lastFrameScreenFormat = screen_format;
+		_changedRects.push_back(Common::Rect(src.w, src.h));
+		return;
+	}
+
+	// Find the changed columns in each band of rows, and merge the adjacent
+	// bands unless this would make the area much larger than what changed
+	const int bpp = src.format.bytesPerPixel;
+	const int row_size = src.w * bpp;
+	Common::Rect run;
+	int run_area = 0;
+	for (int top = 0; top < src.h; top += kChangedBandHeight) {
+		const int bottom = MIN<int>(top + kChangedBandHeight, src.h);
+		int x1 = src.w, x2 = 0;
+		for (int y = top; y < bottom; ++y) {
+			const byte *s = (const byte *)src.getBasePtr(0, y);
+			byte *d = (byte *)_lastFrame.getBasePtr(0, y);
+			if (memcmp(s, d, row_size) == 0)
+				continue;
+			int l = 0, r = src.w;
+			while (l < x1 && memcmp(s + l * bpp, d + l * bpp, bpp) == 0)
+				++l;
+			while (r > x2 && memcmp(s + (r - 1) * bpp, d + (r - 1) * bpp, bpp) == 0)
+				--r;
+			x1 = MIN(x1, l);
+			x2 = MAX(x2, r);
+			memcpy(d, s, row_size);
+		}
 
-			if (*destP != pixel) {
-				*destP = pixel;
-				x1 = MIN(x1, x);
-				y1 = MIN(y1, y);
-				x2 = MAX(x2, x);
-				y2 = MAX(y2, y);
+		if (x1 >= x2) {
+			if (run_area > 0)
+				_changedRects.push_back(run);
+			run_area = 0;
+			continue;
+		}
+		const Common::Rect band(x1, top, x2, bottom);
+		const int band_area = band.width() * band.height();
+		if (run_area > 0) {
+			Common::Rect merged = run;
+			merged.extend(band);
+			if (merged.width() * merged.height() <= 2 * (run_area + band_area)) {
+				run = merged;
+				run_area += band_area;
+				continue;
 			}
+			_changedRects.push_back(run);
 		}
+		run = band;
+		run_area = band_area;
 	}
+	if (run_area > 0)
+		_changedRects.push_back(run);
+}
 
-	if (x2 != -1)
-		_screen->addDirtyRect(Common::Rect(x1, y1, x2 + 1, y2 + 1));
+void ScummVMRendererGraphicsDriver::copySurface(const Graphics::Surface &src, bool mode) {
+	assert(src.w == _screen->w && src.h == _screen->h && src.pitch == _screen->pitch);
+	for (const Common::Rect &r : _changedRects) {
+		for (int y = r.top; y < r.bottom; ++y) {
+			const uint32 *srcP = (const uint32 *)src.getBasePtr(r.left, y);
+			uint32 *destP = (uint32 *)_screen->getBasePtr(r.left, y);
+			for (int x = r.left; x < r.right; ++x, ++srcP, ++destP) {
+				if (!mode) {
+					*destP = (*srcP & 0xff00ff00) |
+						((*srcP & 0xff) << 16) |
+						((*srcP >> 16) & 0xff);
+				} else {
+					*destP = ((*srcP & 0xffffff) << 8) |
+						((*srcP >> 24) & 0xff);
+				}
+			}
+		}
+		_screen->addDirtyRect(r);
+	}
 }
 
 void ScummVMRendererGraphicsDriver::Present(int xoff, int yoff, Shared::GraphicFlip flip) {
@@ -583,8 +754,13 @@ void ScummVMRendererGraphicsDriver::Present(int xoff, int yoff, Shared::GraphicF
 		renderMode = kRenderOther;
 	}
 
-	if (renderMode != kRenderDirect && !_screen)
+	if (renderMode != kRenderDirect && !_screen) {
 		_screen = new Graphics::Screen();
+		InvalidateLastFrame();
+	}
+
+	// Only the regions which changed since the last frame are presented
+	FindChangedRects(src, screenFormat);
 
 	switch (renderMode) {
 	case kRenderToABGR:
@@ -603,14 +779,16 @@ void ScummVMRendererGraphicsDriver::Present(int xoff, int yoff, Shared::GraphicF
 		Graphics::Surface srcCopy = src;
 		srcCopy.format.aLoss = 8;
 
-		_screen->blitFrom(srcCopy);
+		for (const Common::Rect &r : _changedRects)
+			_screen->blitFrom(srcCopy, r, Common::Point(r.left, r.top));
 		break;
 	}
 
 	case kRenderDirect:
 		// Blit the virtual surface directly to the screen
-		g_system->copyRectToScreen(src.getPixels(), src.pitch,
-			0, 0, src.w, src.h);
+		for (const Common::Rect &r : _changedRects)
+			g_system->copyRectToScreen(src.getBasePtr(r.left, r.top), src.pitch,
+				r.left, r.top, r.width(), r.height());
 		g_system->updateScreen();
 		if (srcTransformed) {
 			srcTransformed->free();
@@ -34,8 +34,11 @@
 #ifndef AGS_ENGINE_GFX_ALI_3D_SCUMMVM_H
 #define AGS_ENGINE_GFX_ALI_3D_SCUMMVM_H
 
+#include "common/array.h"
+#include "common/rect.h"
 #include "common/std/memory.h"
 #include "common/std/vector.h"
+#include "graphics/surface.h"
 #include "ags/shared/core/platform.h"
 #include "ags/shared/gfx/bitmap.h"
 #include "ags/engine/gfx/ddb.h"
@@ -251,6 +254,12 @@ private:
 	Graphics::Screen *_screen = nullptr;
 	PSDLRenderFilter _filter;
 
+	// Copy of the last presented frame, used to find the regions that changed
+	Graphics::Surface _lastFrame;
+	Graphics::PixelFormat _lastFrameScreenFormat;
+	// Regions of the current frame which differ from the last presented one
+	Common::Array<Common::Rect> _changedRects;
+
 	bool _hasGamma = false;
 #ifdef TODO
 	uint16 _defaultGammaRed[256] {};
@@ -298,7 +307,11 @@ private:
 	void highcolor_fade_out(Bitmap *vs, void(*draw_callback)(), int speed, int targetColourRed, int targetColourGreen, int targetColourBlue);
 	void __fade_from_range(PALETTE source, PALETTE dest, int speed, int from, int to);
 	void __fade_out_range(int speed, int from, int to, int targetColourRed, int targetColourGreen, int targetColourBlue);
-	// Copy raw screen bitmap pixels to the screen
+	// Compares the frame with the last presented one and fills _changedRects
+	void FindChangedRects(const Graphics::Surface &src, const Graphics::PixelFormat &screen_format);
+	// Forgets the last presented frame, so that the next one is presented whole
+	void InvalidateLastFrame();
+	// Copy raw screen bitmap pixels of the changed regions to the screen
 	void copySurface(const Graphics::Surface &src, bool mode);
 	// Render bitmap on screen
 	void Present(int xoff = 0, int yoff = 0, Shared::GraphicFlip flip = Shared::kFlip_None);
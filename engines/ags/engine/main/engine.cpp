@@ -511,6 +511,8 @@ int engine_init_sprites() {
 	if (_GP(usetup).SpriteCacheSize > 0)
 		_GP(spriteset).SetMaxCacheSize(_GP(usetup).SpriteCacheSize * 1024);
 	Debug::Printf("Sprite cache set: %zu KB", _GP(spriteset).GetMaxCacheSize() / 1024);
+	_GP(spriteset).SetMaxCompressedCacheSize(_GP(usetup).CompressedSpriteCacheSize * 1024);
+	Debug::Printf("Compressed sprite cache set: %zu KB", _GP(usetup).CompressedSpriteCacheSize);
 	return 0;
 }
 
@@ -209,6 +209,9 @@ void quit_free() {
 
 	set_our_eip(9901);
 
+	const SpriteCache::Stats &spr_stats = _GP(spriteset).GetStats();
+	Debug::Printf("Sprite cache: %u hits, %u misses, %u compressed hits, %u prefetched, %u evictions",
+		spr_stats.Hits, spr_stats.Misses, spr_stats.CompressedHits, spr_stats.Prefetched, spr_stats.Evictions);
 	_GP(spriteset).Reset();
 
 	set_our_eip(9908);
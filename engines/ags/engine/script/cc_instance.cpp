@@ -253,6 +253,7 @@ ccInstance::ccInstance() {
 	numimports = 0;
 	resolved_imports = nullptr;
 	code_fixups         = nullptr;
+	prepared_code       = nullptr;
 
 	memset(callStackLineNumber, 0, sizeof(callStackLineNumber));
 	memset(callStackAddr, 0, sizeof(callStackAddr));
@@ -560,6 +561,7 @@ int ccInstance::Run(int32_t curpc) {
 	thisbase[0] = 0;
 	funcstart[0] = pc;
 	ccInstance *codeInst = runningInst;
+	const ScriptPreparedOp *prep_code = codeInst->prepared_code;
 	ScriptOperation codeOp;
 	FunctionCallStack func_callstack;
 #if DEBUG_CC_EXEC
@@ -583,33 +585,60 @@ int ccInstance::Run(int32_t curpc) {
 		//
 		/* Read operation */
 		//=====================================================================
-		codeOp.Instruction.Code         = codeInst->code[pc];
-		codeOp.Instruction.InstanceId   = (codeOp.Instruction.Code >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
-		codeOp.Instruction.Code        &= INSTANCE_ID_REMOVEMASK; // now this is pure instruction code
+		const ScriptPreparedOp *prepared_op = prep_code ? &prep_code[pc] : nullptr;
+		if (prepared_op && prepared_op->Code >= 0) {
+			codeOp.Instruction.Code         = prepared_op->Code;
+			codeOp.Instruction.InstanceId   = prepared_op->InstanceId;
+			codeOp.ArgCount                 = prepared_op->ArgCount;
+
+			// Most instructions merely read the integer value of their arguments
+			if (prepared_op->WholeArgs) {
+				for (int i = 0; i < prepared_op->NumArgs; i++)
+					codeOp.Args[i].SetInt32(prepared_op->Args[i]);
+			} else {
+				switch (prepared_op->NumArgs) {
+				case 3:
+					codeOp.Args[2].IValue = prepared_op->Args[2];
+					/* fall-through */
+				case 2:
+					codeOp.Args[1].IValue = prepared_op->Args[1];
+					/* fall-through */
+				case 1:
+					codeOp.Args[0].IValue = prepared_op->Args[0];
+					break;
+				default:
+					break;
+				}
+			}
+		} else {
+			codeOp.Instruction.Code         = codeInst->code[pc];
+			codeOp.Instruction.InstanceId   = (codeOp.Instruction.Code >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
+			codeOp.Instruction.Code        &= INSTANCE_ID_REMOVEMASK; // now this is pure instruction code
 
-		CC_ERROR_IF_RETCODE((codeOp.Instruction.Code < 0 || codeOp.Instruction.Code >= CC_NUM_SCCMDS),
-							"invalid instruction %d found in code stream", codeOp.Instruction.Code);
+			CC_ERROR_IF_RETCODE((codeOp.Instruction.Code < 0 || codeOp.Instruction.Code >= CC_NUM_SCCMDS),
+								"invalid instruction %d found in code stream", codeOp.Instruction.Code);
 
-		codeOp.ArgCount = (*g_commands)[codeOp.Instruction.Code].ArgCount;
+			codeOp.ArgCount = (*g_commands)[codeOp.Instruction.Code].ArgCount;
 
-		CC_ERROR_IF_RETCODE(pc + codeOp.ArgCount >= codeInst->codesize,
-							"unexpected end of code data (%d; %d)", pc + codeOp.ArgCount, codeInst->codesize);
+			CC_ERROR_IF_RETCODE(pc + codeOp.ArgCount >= codeInst->codesize,
+								"unexpected end of code data (%d; %d)", pc + codeOp.ArgCount, codeInst->codesize);
 
 
-		// Read arguments; use switch as it proved to be faster than the loop
+			// Read arguments; use switch as it proved to be faster than the loop
 
-		switch (codeOp.ArgCount) {
-		case 3:
-			codeOp.Args[2].SetInt32(static_cast<int32_t>(codeInst->code[pc + 3]));
-			/* fall-through */
-		case 2:
-			codeOp.Args[1].SetInt32(static_cast<int32_t>(codeInst->code[pc + 2]));
-			/* fall-through */
-		case 1:
-			codeOp.Args[0].SetInt32(static_cast<int32_t>(codeInst->code[pc + 1]));
-			break;
-		default:
-			break;
+			switch (codeOp.ArgCount) {
+			case 3:
+				codeOp.Args[2].SetInt32(static_cast<int32_t>(codeInst->code[pc + 3]));
+				/* fall-through */
+			case 2:
+				codeOp.Args[1].SetInt32(static_cast<int32_t>(codeInst->code[pc + 2]));
+				/* fall-through */
+			case 1:
+				codeOp.Args[0].SetInt32(static_cast<int32_t>(codeInst->code[pc + 1]));
+				break;
+			default:
+				break;
+			}
 		}
 		//---------------------------------------------------------------------
 		/* End read operation */
@@ -1457,6 +1486,45 @@ int ccInstance::Run(int32_t curpc) {
 			if (loopIterationCheckDisabled == 0)
 				loopIterationCheckDisabled++;
 			break;
+		case kScFusedPushLiteral: {
+			auto &reg1 = registers[codeOp.Arg1i()];
+			reg1.SetInt32(codeOp.Arg2i());
+			ASSERT_STACK_SPACE_VALS(1);
+			PushValueToStack(reg1);
+			break;
+		}
+		case kScFusedLoadLocal: {
+			registers[SREG_MAR] = GetStackPtrOffsetRw(codeOp.Arg1i());
+			ASSERT_CC_ERROR();
+			auto &reg1 = registers[codeOp.Arg2i()];
+			reg1 = registers[SREG_MAR].ReadValue();
+			break;
+		}
+		case kScFusedStoreLocal: {
+			registers[SREG_MAR] = GetStackPtrOffsetRw(codeOp.Arg1i());
+			ASSERT_CC_ERROR();
+			const auto &reg1 = registers[codeOp.Arg2i()];
+			registers[SREG_MAR].WriteValue(reg1);
+			break;
+		}
+		// The jump offset is relative to the end of the JZ, which is also
+		// where the fused instruction ends
+#define FUSED_COMPARE_JZ(CMD, COND) \
+		case CMD: { \
+			auto &reg1 = registers[codeOp.Arg1i()]; \
+			const auto &reg2 = registers[codeOp.Arg2i()]; \
+			reg1.SetInt32AsBool(COND); \
+			if (reg1.IsNull()) \
+				pc += codeOp.Arg3i(); \
+			break; \
+		}
+		FUSED_COMPARE_JZ(kScFusedIsEqualJz, reg1 == reg2)
+		FUSED_COMPARE_JZ(kScFusedNotEqualJz, reg1 != reg2)
+		FUSED_COMPARE_JZ(kScFusedGreaterJz, reg1.IValue > reg2.IValue)
+		FUSED_COMPARE_JZ(kScFusedLessThanJz, reg1.IValue < reg2.IValue)
+		FUSED_COMPARE_JZ(kScFusedGteJz, reg1.IValue >= reg2.IValue)
+		FUSED_COMPARE_JZ(kScFusedLteJz, reg1.IValue <= reg2.IValue)
+#undef FUSED_COMPARE_JZ
 		default:
 			cc_error("instruction %d is not implemented", codeOp.Instruction.Code);
 			return -1;
@@ -1651,6 +1719,7 @@ bool ccInstance::_Create(PScript scri, const ccInstance *joined) {
 	if (joined) {
 		resolved_imports = joined->resolved_imports;
 		code_fixups = joined->code_fixups;
+		prepared_code = joined->prepared_code;
 	} else {
 		if (!CreateGlobalVars(scri.get())) {
 			return false;
@@ -1737,9 +1806,11 @@ void ccInstance::Free() {
 	if ((flags & INSTF_SHAREDATA) == 0) {
 		delete[] resolved_imports;
 		delete[] code_fixups;
+		delete[] prepared_code;
 	}
 	resolved_imports = nullptr;
 	code_fixups = nullptr;
+	prepared_code = nullptr;
 }
 
 bool ccInstance::ResolveScriptImports(const ccScript *scri) {
@@ -1950,9 +2021,109 @@ bool ccInstance::ResolveImportFixups(const ccScript *scri) {
 		if (import->InstancePtr != nullptr && (code[fixup + 1] & INSTANCE_ID_REMOVEMASK) == SCMD_CALLEXT)
 			code[fixup + 1] = SCMD_CALLAS | (import->InstancePtr->loadedInstanceId << INSTANCE_ID_SHIFT);
 	}
+
+	// The code won't change anymore
+	PrepareCode();
 	return true;
 }
 
+void ccInstance::PrepareCode() {
+	delete[] prepared_code;
+	prepared_code = new ScriptPreparedOp[codesize];
+
+	// Decode the instructions the same way Run() does. Positions which are
+	// not reached by walking the code stick to the generic decoding.
+	for (int32_t at = 0; at < codesize;) {
+		const int32_t code_word = static_cast<int32_t>(code[at]);
+		const int32_t instr = code_word & INSTANCE_ID_REMOVEMASK;
+		if (instr < 0 || instr >= CC_NUM_SCCMDS) {
+			at++;
+			continue;
+		}
+
+		const int arg_count = (*g_commands)[instr].ArgCount;
+		if (at + arg_count >= codesize)
+			break;
+
+		ScriptPreparedOp &op = prepared_code[at];
+		op.Code = instr;
+		op.InstanceId = (code_word >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
+		op.NumArgs = arg_count;
+		op.ArgCount = arg_count;
+		for (int i = 0; i < arg_count; i++)
+			op.Args[i] = static_cast<int32_t>(code[at + 1 + i]);
+		// These may have their argument fixed up
+		op.WholeArgs = (instr == SCMD_LITTOREG || instr == SCMD_WRITELIT);
+		at += arg_count + 1;
+	}
+
+#if !DEBUG_CC_EXEC
+	// Fuse instruction pairs; the second instruction keeps its own entry,
+	// in case it is a jump target. Dumping opcodes needs them unfused.
+	for (int32_t at = 0; at < codesize; at++) {
+		ScriptPreparedOp &op = prepared_code[at];
+		const int32_t next_at = at + op.ArgCount + 1;
+		if (op.Code < 0 || next_at >= codesize)
+			continue;
+
+		const ScriptPreparedOp &next = prepared_code[next_at];
+		if (next.Code < 0)
+			continue;
+
+		int fused = -1;
+		int32_t args[MAX_SCMD_ARGS] = {};
+		switch (op.Code) {
+		case SCMD_LITTOREG:
+			if (code_fixups[at + 2] == FIXUP_NOFIXUP && next.Code == SCMD_PUSHREG && next.Args[0] == op.Args[0]) {
+				fused = kScFusedPushLiteral;
+				args[0] = op.Args[0];
+				args[1] = op.Args[1];
+			}
+			break;
+		case SCMD_LOADSPOFFS:
+			if (next.Code == SCMD_MEMREAD || next.Code == SCMD_MEMWRITE) {
+				fused = (next.Code == SCMD_MEMREAD) ? kScFusedLoadLocal : kScFusedStoreLocal;
+				args[0] = op.Args[0];
+				args[1] = next.Args[0];
+			}
+			break;
+		case SCMD_ISEQUAL:
+		case SCMD_NOTEQUAL:
+		case SCMD_GREATER:
+		case SCMD_LESSTHAN:
+		case SCMD_GTE:
+		case SCMD_LTE:
+			// JZ tests AX, so the comparison has to store its result there
+			if (next.Code == SCMD_JZ && op.Args[0] == SREG_AX) {
+				switch (op.Code) {
+				case SCMD_ISEQUAL: fused = kScFusedIsEqualJz; break;
+				case SCMD_NOTEQUAL: fused = kScFusedNotEqualJz; break;
+				case SCMD_GREATER: fused = kScFusedGreaterJz; break;
+				case SCMD_LESSTHAN: fused = kScFusedLessThanJz; break;
+				case SCMD_GTE: fused = kScFusedGteJz; break;
+				default: fused = kScFusedLteJz; break;
+				}
+				args[0] = op.Args[0];
+				args[1] = op.Args[1];
+				args[2] = next.Args[0];
+			}
+			break;
+		default:
+			break;
+		}
+
+		if (fused < 0)
+			continue;
+
+		op.Code = fused;
+		op.NumArgs = MAX_SCMD_ARGS;
+		op.WholeArgs = false;
+		op.ArgCount += next.ArgCount + 1;
+		memcpy(op.Args, args, sizeof(args));
+	}
+#endif
+}
+
 void ccInstance::PushValueToStack(const RuntimeScriptValue &rval) {
 	// Write value to the stack tail and advance stack ptr
 	registers[SREG_SP].WriteValue(rval);
@@ -83,6 +83,31 @@ struct ScriptOperation {
 	inline int Arg3i() const { return Args[2].IValue; }
 };
 
+// Internal instructions, which stand for a pair of SCMD_* instructions
+// commonly found together in the compiled code
+enum ScriptFusedCommand {
+	kScFusedPushLiteral = CC_NUM_SCCMDS, // LITTOREG reg, lit; PUSHREG reg
+	kScFusedLoadLocal,                   // LOADSPOFFS off; MEMREAD reg
+	kScFusedStoreLocal,                  // LOADSPOFFS off; MEMWRITE reg
+	kScFusedIsEqualJz,                   // ISEQUAL ax, reg; JZ lit
+	kScFusedNotEqualJz,                  // NOTEQUAL ax, reg; JZ lit
+	kScFusedGreaterJz,                   // GREATER ax, reg; JZ lit
+	kScFusedLessThanJz,                  // LESSTHAN ax, reg; JZ lit
+	kScFusedGteJz,                       // GTE ax, reg; JZ lit
+	kScFusedLteJz                        // LTE ax, reg; JZ lit
+};
+
+// An instruction decoded ahead of time, so that the executor does not have
+// to unpack the code stream over and over again
+struct ScriptPreparedOp {
+	int16_t Code = -1;      // SCMD_* or ScriptFusedCommand; -1 if not prepared
+	uint8_t InstanceId = 0;
+	uint8_t NumArgs = 0;    // number of Args used
+	int32_t ArgCount = 0;   // number of code words following the instruction
+	int32_t Args[MAX_SCMD_ARGS] = {};
+	bool    WholeArgs = false; // arguments are used as values, not only as integers
+};
+
 struct ScriptVariable {
 	ScriptVariable() {
 		ScAddress = -1; // address = 0 is valid one, -1 means undefined
@@ -154,6 +179,8 @@ public:
 	int  numimports;
 
 	char *code_fixups;
+	// Pre-decoded instructions, indexed by code position
+	ScriptPreparedOp *prepared_code;
 
 	// returns the currently executing instance, or NULL if none
 	static ccInstance *GetCurrentInstance(void);
@@ -208,6 +235,8 @@ private:
 	bool    AddGlobalVar(const ScriptVariable &glvar);
 	ScriptVariable *FindGlobalVar(int32_t var_addr);
 	bool    CreateRuntimeCodeFixups(const ccScript *scri);
+	// Decode the code into prepared_code, fusing common instruction pairs
+	void    PrepareCode();
 
 	// Begin executing script starting from the given bytecode index
 	int     Run(int32_t curpc);
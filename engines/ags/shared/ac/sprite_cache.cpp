@@ -25,6 +25,7 @@
 //
 //=============================================================================
 
+#include "common/memtracker.h"
 #include "common/system.h"
 #include "ags/shared/core/platform.h"
 #include "ags/shared/util/stream.h"
@@ -70,6 +71,11 @@ SpriteCache::SpriteCache(std::vector<SpriteInfo> &sprInfos, const Callbacks &cal
 	_placeholder.reset(BitmapHelper::CreateTransparentBitmap(1, 1, 8));
 }
 
+SpriteCache::~SpriteCache() {
+	CancelPrefetch();
+	MEMORY_TRACK_REMOVE(Common::kMemoryEngineResources, _cacheSize);
+}
+
 size_t SpriteCache::GetCacheSize() const {
 	return _cacheSize;
 }
@@ -91,6 +97,14 @@ void SpriteCache::SetMaxCacheSize(size_t size) {
 	_maxCacheSize = size;
 }
 
+void SpriteCache::SetMaxCompressedCacheSize(size_t size) {
+	_compressedCache.SetMaxCacheSize(size);
+}
+
+size_t SpriteCache::GetCompressedCacheSize() const {
+	return _compressedCache.GetCacheSize();
+}
+
 bool SpriteCache::HasFreeSlots() const {
 	return !((_spriteData.size() == SIZE_MAX) || (_spriteData.size() > MAX_SPRITE_INDEX));
 }
@@ -101,9 +115,12 @@ bool SpriteCache::IsAssetSprite(sprkey_t index) const {
 }
 
 void SpriteCache::Reset() {
+	CancelPrefetch();
+	_compressedCache.Clear();
 	_file.Close();
 	_spriteData.clear();
 	_mru.clear();
+	MEMORY_TRACK_REMOVE(Common::kMemoryEngineResources, _cacheSize);
 	_cacheSize = 0;
 	_lockedSize = 0;
 }
@@ -227,6 +244,7 @@ Bitmap *SpriteCache::operator[](sprkey_t index) {
 		return _spriteData[index].Image.get();
 	// Either use ready image, or load one from assets
 	if (_spriteData[index].Image) {
+		_stats.Hits++;
 		// Move to the beginning of the MRU list
 		_mru.splice(_mru.begin(), _mru, _spriteData[index].MruIt);
 		return _spriteData[index].Image.get();
@@ -275,7 +293,11 @@ void SpriteCache::DisposeOldest() {
 	// NOTE: locked sprites may still occur in MRU list
 	if (!_spriteData[sprnum].IsLocked()) {
 		_cacheSize -= _spriteData[sprnum].Size;
+		MEMORY_TRACK_REMOVE(Common::kMemoryEngineResources, _spriteData[sprnum].Size);
 		_spriteData[sprnum].Image.reset();
+		_stats.Evictions++;
+		// Keep the compressed data of the evicted sprite around for longer
+		_compressedCache.Get(sprnum);
 		SprCacheLog("DisposeOldest: disposed %d, size now %d KB", sprnum, _cacheSize / 1024);
 	}
 	// Remove from the mru list
@@ -293,6 +315,7 @@ void SpriteCache::DisposeAllCached() {
 			_spriteData[i].Image.reset();
 		}
 	}
+	MEMORY_TRACK_REMOVE(Common::kMemoryEngineResources, _cacheSize - _lockedSize);
 	_cacheSize = _lockedSize;
 	_mru.clear();
 }
@@ -356,8 +379,19 @@ size_t SpriteCache::LoadSprite(sprkey_t index, bool lock) {
 		return 0;
 	assert((_spriteData[index].Flags & SPRCACHEFLAG_ISASSET) != 0);
 
-	Bitmap *image;
-	HError err = _file.LoadSprite(index, image);
+	Bitmap *image = nullptr;
+	HError err = HError::None();
+	if (TakePrefetched(index, image, err)) {
+		_stats.Prefetched++;
+	} else if (_compressedCache.GetMaxCacheSize() > 0 && _file.GetSpriteCompression() != kSprCompress_None) {
+		std::shared_ptr<const RawSpriteData> raw;
+		err = LoadRawSprite(index, raw);
+		if (err && raw)
+			err = _file.DecodeRawData(index, raw->Hdr, raw->Data, image);
+	} else {
+		_stats.Misses++;
+		err = _file.LoadSprite(index, image);
+	}
 	if (!image) {
 		Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Warn,
 			"LoadSprite: failed to load sprite %d:\n%s\n - remapping to placeholder", index,
@@ -365,7 +399,29 @@ size_t SpriteCache::LoadSprite(sprkey_t index, bool lock) {
 		RemapSpriteToPlaceholder(index);
 		return 0;
 	}
+	return AddLoadedSprite(index, image, lock);
+}
+
+HError SpriteCache::LoadRawSprite(sprkey_t index, std::shared_ptr<const RawSpriteData> &raw) {
+	raw = _compressedCache.Get(index);
+	if (raw) {
+		_stats.CompressedHits++;
+		return HError::None();
+	}
 
+	_stats.Misses++;
+	std::shared_ptr<RawSpriteData> data(new RawSpriteData());
+	HError err = _file.LoadRawData(index, data->Hdr, data->Data);
+	if (!err)
+		return err;
+	raw = data;
+	// Uncompressed data would not take less space than the bitmap
+	if (data->Hdr.Compress != kSprCompress_None)
+		_compressedCache.Put(index, raw);
+	return HError::None();
+}
+
+size_t SpriteCache::AddLoadedSprite(sprkey_t index, Bitmap *image, bool lock) {
 	// Let the external user convert this sprite's image for their needs
 	image = _callbacks.InitSprite(index, image, _sprInfos[index].Flags);
 	if (!image) {
@@ -386,6 +442,7 @@ size_t SpriteCache::LoadSprite(sprkey_t index, bool lock) {
 	_spriteData[index] = SpriteData(image, size, SPRCACHEFLAG_ISASSET);
 	_spriteData[index].Flags |= (SPRCACHEFLAG_LOCKED * should_lock);
 	_cacheSize += size;
+	MEMORY_TRACK_ADD(Common::kMemoryEngineResources, size);
 	SprCacheLog("Loaded %d, size now %zu KB", index, _cacheSize / 1024);
 
 	// Let the external user to react to the new sprite;
@@ -407,6 +464,85 @@ void SpriteCache::InitNullSprite(sprkey_t index) {
 	assert(index >= 0);
 	_sprInfos[index] = SpriteInfo();
 	_spriteData[index] = SpriteData();
+	_compressedCache.Dispose(index);
+}
+
+void SpriteCache::PrefetchSprite(sprkey_t index) {
+	if (index < 0 || (size_t)index >= _spriteData.size())
+		return;
+	Common::JobSystem *jobs = g_system->getJobSystem();
+	if (jobs->getThreadCount() <= 1)
+		return;
+
+	CollectPrefetched();
+	const SpriteData &spr = _spriteData[index];
+	if (!spr.IsAssetSprite() || spr.IsError() || spr.Image)
+		return; // nothing to load
+	if (_prefetch.size() >= MAX_PREFETCH)
+		return;
+	for (const auto &item : _prefetch) {
+		if (item->Index == index)
+			return; // already decoding
+	}
+
+	// The file is read right away, only the decoding is done in background
+	std::unique_ptr<PrefetchItem> item(new PrefetchItem());
+	HError err = LoadRawSprite(index, item->Raw);
+	if (!err || !item->Raw || item->Raw->Hdr.BPP == 0)
+		return; // let LoadSprite report the problem
+	item->Index = index;
+	item->File = &_file;
+	PrefetchItem *job = item.get();
+	_prefetch.push_back(std::move(item));
+	jobs->submit(DecodePrefetchedProc, job, &job->Group);
+	SprCacheLog("Prefetching %d", index);
+}
+
+void SpriteCache::DecodePrefetchedProc(void *refCon) {
+	PrefetchItem *item = (PrefetchItem *)refCon;
+	item->Error = item->File->DecodeRawData(item->Index, item->Raw->Hdr, item->Raw->Data, item->Image);
+}
+
+bool SpriteCache::TakePrefetched(sprkey_t index, Bitmap *&image, HError &err) {
+	for (auto it = _prefetch.begin(); it != _prefetch.end(); ++it) {
+		if ((*it)->Index != index)
+			continue;
+		g_system->getJobSystem()->wait((*it)->Group);
+		image = (*it)->Image;
+		err = (*it)->Error;
+		_prefetch.erase(it);
+		return true;
+	}
+	return false;
+}
+
+void SpriteCache::CollectPrefetched() {
+	for (size_t i = 0; i < _prefetch.size();) {
+		if (!_prefetch[i]->Group.isDone()) {
+			++i;
+			continue;
+		}
+		const sprkey_t index = _prefetch[i]->Index;
+		std::unique_ptr<Bitmap> image(_prefetch[i]->Image);
+		_prefetch.erase(_prefetch.begin() + i);
+
+		// The slot might have been assigned or loaded meanwhile
+		if (!image || (size_t)index >= _spriteData.size() || !_spriteData[index].IsAssetSprite() ||
+			_spriteData[index].IsError() || _spriteData[index].Image)
+			continue;
+		if (AddLoadedSprite(index, image.release(), false)) {
+			_spriteData[index].MruIt = _mru.insert(_mru.begin(), index);
+			_stats.Prefetched++;
+		}
+	}
+}
+
+void SpriteCache::CancelPrefetch() {
+	for (const auto &item : _prefetch) {
+		g_system->getJobSystem()->wait(item->Group);
+		delete item->Image;
+	}
+	_prefetch.clear();
 }
 
 int SpriteCache::SaveToFile(const String &filename, int store_flags, SpriteCompression compress, SpriteFileIndex &index) {
@@ -447,6 +583,7 @@ HError SpriteCache::InitFile(const String &filename, const String &sprindex_file
 }
 
 void SpriteCache::DetachFile() {
+	CancelPrefetch();
 	_file.Close();
 }
 
@@ -24,7 +24,10 @@
 //
 // SpriteFile handles sprite serialization and streaming.
 // SpriteCache provides bitmaps by demand; it uses SpriteFile to load sprites
-// and does MRU (most-recent-use) caching.
+// and does MRU (most-recent-use) caching. Optionally it keeps the compressed
+// data of the recently used sprites in memory, so that these may be restored
+// without reading the file again, and may decode the sprites which are about
+// to be used on the worker threads.
 //
 // TODO: store sprite data in a specialized container type that is optimized
 // for having most keys allocated in large continious sequences by default.
@@ -44,11 +47,13 @@
 #include "common/std/memory.h"
 #include "common/std/vector.h"
 #include "common/std/list.h"
+#include "common/jobs.h"
 #include "ags/shared/ac/sprite_file.h"
 #include "ags/shared/core/platform.h"
 #include "ags/shared/gfx/bitmap.h"
 #include "ags/shared/util/error.h"
 #include "ags/shared/util/geometry.h"
+#include "ags/shared/util/resource_cache.h"
 
 namespace AGS3 {
 
@@ -95,8 +100,17 @@ public:
 		PfnPrewriteSprite PrewriteSprite;
 	};
 
+	// Cache usage statistics
+	struct Stats {
+		uint32_t Hits = 0u;           // requested sprites which were in memory
+		uint32_t Misses = 0u;         // sprites which had to be read from the file
+		uint32_t CompressedHits = 0u; // sprites restored from the compressed data in memory
+		uint32_t Prefetched = 0u;     // sprites decoded in background before being requested
+		uint32_t Evictions = 0u;      // sprites disposed to free the cache space
+	};
+
 	SpriteCache(std::vector<SpriteInfo> &sprInfos, const Callbacks &callbacks);
-	~SpriteCache() = default;
+	~SpriteCache();
 
 	// Loads sprite reference information and inits sprite stream
 	HError      InitFile(const String &filename, const String &sprindex_filename);
@@ -169,13 +183,43 @@ public:
 	void        SetEmptySprite(sprkey_t index, bool as_asset);
 	// Sets max cache size in bytes
 	void        SetMaxCacheSize(size_t size);
+	// Sets max size of the compressed sprite data kept in memory, in bytes;
+	// 0 disables keeping the compressed data
+	void        SetMaxCompressedCacheSize(size_t size);
+	// Returns current size of the compressed sprite data kept in memory, in bytes
+	size_t      GetCompressedCacheSize() const;
+	// Starts decoding the asset sprite in background, if it's not in memory yet;
+	// the sprite will be added to the cache when requested, or on the next prefetch.
+	// Does nothing if there are no worker threads.
+	void        PrefetchSprite(sprkey_t index);
+	// Returns cache usage statistics
+	const Stats &GetStats() const { return _stats; }
+	// Resets cache usage statistics
+	void        ResetStats() { _stats = Stats(); }
 
 	// Loads (if it's not in cache yet) and returns bitmap by the sprite index
 	Bitmap *operator[](sprkey_t index);
 
 private:
+	// Sprite data as stored in the file
+	struct RawSpriteData {
+		SpriteDatHeader Hdr;
+		std::vector<uint8_t> Data;
+	};
+
 	// Load sprite from game resource
 	size_t      LoadSprite(sprkey_t index, bool lock = false);
+	// Reads raw sprite data, either from the compressed cache or the file
+	HError      LoadRawSprite(sprkey_t index, std::shared_ptr<const RawSpriteData> &raw);
+	// Initializes the loaded sprite's image and adds it to the cache
+	size_t      AddLoadedSprite(sprkey_t index, Bitmap *image, bool lock);
+	// Takes the image decoded by a background job, if there's one for this sprite
+	bool        TakePrefetched(sprkey_t index, Bitmap *&image, HError &err);
+	// Adds images of all the finished background jobs to the cache
+	void        CollectPrefetched();
+	// Waits for all background jobs and discards their results
+	void        CancelPrefetch();
+	static void DecodePrefetchedProc(void *refCon);
 	// Remap the given index to the placeholder
 	void        RemapSpriteToPlaceholder(sprkey_t index);
 	// Delete the oldest (least recently used) image in cache
@@ -235,6 +279,30 @@ private:
 	size_t _lockedSize;    // size in bytes of currently locked images
 	size_t _cacheSize;     // size in bytes of currently cached images
 
+	// Compressed data of the recently loaded sprites
+	class CompressedCache : public ResourceCache<sprkey_t, std::shared_ptr<const RawSpriteData>, size_t, Common::Hash<sprkey_t> > {
+	protected:
+		size_t CalcSize(const std::shared_ptr<const RawSpriteData> &item) override {
+			return item ? item->Data.size() : 0u;
+		}
+	};
+	CompressedCache _compressedCache;
+
+	// Sprite being decoded by a background job
+	struct PrefetchItem {
+		sprkey_t Index = -1;
+		const SpriteFile *File = nullptr;
+		std::shared_ptr<const RawSpriteData> Raw;
+		Bitmap *Image = nullptr;
+		HError Error;
+		Common::JobGroup Group;
+	};
+	// Max number of sprites decoded in background at once
+	static const size_t MAX_PREFETCH = 8;
+	std::vector<std::unique_ptr<PrefetchItem> > _prefetch;
+
+	Stats _stats;
+
 	// MRU list: the way to track which sprites were used recently.
 	// When clearing up space for new sprites, cache first deletes the sprites
 	// that were last time used long ago.
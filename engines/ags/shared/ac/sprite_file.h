@@ -154,6 +154,9 @@ public:
 	HError      LoadSprite(sprkey_t index, Bitmap *&sprite);
 	// Loads a raw sprite element data into the buffer, stores header info separately
 	HError      LoadRawData(sprkey_t index, SpriteDatHeader &hdr, std::vector<uint8_t> &data);
+	// Creates a ready bitmap from the data returned by LoadRawData;
+	// does not access the stream, so may be called from any thread
+	HError      DecodeRawData(sprkey_t index, const SpriteDatHeader &hdr, const std::vector<uint8_t> &data, Bitmap *&sprite) const;
 
 private:
 	// Seek stream to sprite
@@ -207,8 +207,10 @@ bool lzwexpand(const uint8_t *src, size_t src_sz, uint8_t *dst, size_t dst_sz) {
 	if (dst_sz == 0)
 		return false; // nowhere to expand to
 
-	_G(lzbuffer) = (uint8_t *)malloc(N);
-	if (_G(lzbuffer) == nullptr) {
+	// Uses its own window rather than the global one, so that sprites may be
+	// decompressed from the worker threads
+	uint8_t *lzbuffer = (uint8_t *)malloc(N);
+	if (lzbuffer == nullptr) {
 		return false;  // not enough memory
 	}
 	i = N - F;
@@ -234,13 +236,13 @@ bool lzwexpand(const uint8_t *src, size_t src_sz, uint8_t *dst, size_t dst_sz) {
 					break; // not enough dest buffer
 
 				while (len--) {
-					*(dst_ptr++) = (_G(lzbuffer)[i] = _G(lzbuffer)[j]);
+					*(dst_ptr++) = (lzbuffer[i] = lzbuffer[j]);
 					j = (j + 1) & (N - 1);
 					i = (i + 1) & (N - 1);
 				}
 			} else {
 				ch = *(src_ptr++);
-				*(dst_ptr++) = (_G(lzbuffer)[i] = static_cast<uint8_t>(ch));
+				*(dst_ptr++) = (lzbuffer[i] = static_cast<uint8_t>(ch));
 				i = (i + 1) & (N - 1);
 			}
 
@@ -252,7 +254,7 @@ bool lzwexpand(const uint8_t *src, size_t src_sz, uint8_t *dst, size_t dst_sz) {
 
 	}
 
-	free(_G(lzbuffer));
+	free(lzbuffer);
 	return static_cast<size_t>(src_ptr - src) == src_sz;
 }
 
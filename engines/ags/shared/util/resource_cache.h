@@ -58,6 +58,7 @@
 #ifndef AGS_SHARED_UTIL_RESOURCE_CACHE_H
 #define AGS_SHARED_UTIL_RESOURCE_CACHE_H
 
+#include "common/std/algorithm.h"
 #include "common/std/list.h"
 #include "common/std/map.h"
 #include "ags/shared/util/string.h"
@@ -67,7 +68,7 @@ namespace AGS {
 namespace Shared {
 
 template<typename TKey, typename TValue,
-		 typename TSize = size_t, typename HashFn = std::hash<TKey> >
+		 typename TSize = size_t, typename HashFn = Common::Hash<TKey> >
 class ResourceCache {
 public:
 	// Flags determine management rules for the particular item
@@ -113,7 +114,7 @@ public:
 			return _dummy; // no such key
 
 		// Unless locked, move the item ref to the beginning of the MRU list
-		const auto &item = it->second;
+		const auto &item = it->_value;
 		if ((item.Flags & kCacheItem_Locked) == 0)
 			_mru.splice(_mru.begin(), _mru, item.MruIt);
 		return item.Value;
@@ -150,7 +151,7 @@ public:
 		auto it = _storage.find(key);
 		if (it == _storage.end())
 			return; // no such key
-		auto &item = it->second;
+		auto &item = it->_value;
 		if ((item.Flags & kCacheItem_Locked) != 0)
 			return; // already locked
 
@@ -168,7 +169,7 @@ public:
 		if (it == _storage.end())
 			return; // no such key
 
-		auto &item = it->second;
+		auto &item = it->_value;
 		if ((item.Flags & kCacheItem_External) != 0)
 			return; // never release external data, must be removed by user
 		if ((item.Flags & kCacheItem_Locked) == 0)
@@ -195,7 +196,7 @@ public:
 		auto it = _storage.find(key);
 		if (it == _storage.end())
 			return TValue(); // no such key
-		TValue value = std::move(it->second.Value);
+		TValue value = std::move(it->_value.Value);
 		RemoveImpl(it);
 		return value;
 	}
@@ -205,7 +206,7 @@ public:
 		for (auto mru_it = _sectionLocked; mru_it != _mru.end(); ++mru_it) {
 			auto it = _storage.find(*mru_it);
 			assert(it != _storage.end());
-			auto &item = it->second;
+			auto &item = it->_value;
 			_cacheSize -= item.Size;
 			_storage.erase(it);
 			_mru.erase(mru_it);
@@ -292,7 +293,7 @@ private:
 	}
 	// Removes the item from the container
 	void RemoveImpl(typename TStorage::iterator it) {
-		auto &item = it->second;
+		auto &item = it->_value;
 		// normal items are removed from MRU, and discounted from cache size
 		if ((item.Flags & kCacheItem_External) == 0) {
 			TMruIt mru_it = item.MruIt;
@@ -316,7 +317,7 @@ private:
 		auto mru_it = std::prev(_sectionLocked);
 		auto it = _storage.find(*mru_it);
 		assert(it != _storage.end());
-		auto &item = it->second;
+		auto &item = it->_value;
 		assert((item.Flags & (kCacheItem_Locked | kCacheItem_External)) == 0);
 		_cacheSize -= item.Size;
 		_storage.erase(it);
@@ -53,6 +53,9 @@ public:
 	int getMaximumSaveSlot() const override { return 24; }
 	int getAutosaveSlot()    const override { return getMaximumSaveSlot(); }
 	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveListInfos(const char *target, int slot) const override {
+		return querySaveMetaInfos(target, slot);
+	}
 	void getSavegameThumbnail(Graphics::Surface &thumb) override;
 	Common::Error createInstance(OSystem *syst, Engine **engine, const ADGameDescription *gd) const override;
 	Common::KeymapArray initKeymaps(const char *target) const override;
@@ -62,7 +62,7 @@ namespace Bagel {
 BagelEngine *g_engine;
 
 BagelEngine::BagelEngine(OSystem *syst, const ADGameDescription *gameDesc) : Engine(syst),
-	_gameDescription(gameDesc), _randomSource("Bagel") {
+	_gameDescription(gameDesc), _randomSource("Bagel"), _imageCache(32 * 1024 * 1024) {
 	g_engine = this;
 
 	// baglib/ class statics initializations
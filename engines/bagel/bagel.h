@@ -23,6 +23,7 @@
 #define BAGEL_H
 
 #include "common/random.h"
+#include "graphics/decoded_image_cache.h"
 
 #include "bagel/detection.h"
 #include "bagel/music.h"
@@ -42,6 +43,7 @@ private:
 
 public:
 	Graphics::Screen *_screen = nullptr;
+	Graphics::DecodedImageCache _imageCache;
 	MusicPlayer *_midi = nullptr;
 	bool _useOriginalSaveLoad = false;
 	CBagMasterWin *_masterWin = nullptr;
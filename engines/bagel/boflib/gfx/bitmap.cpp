@@ -25,6 +25,7 @@
 #include "image/png.h"
 
 #include "bagel/boflib/gfx/bitmap.h"
+#include "bagel/bagel.h"
 #include "bagel/boflib/app.h"
 #include "bagel/boflib/file.h"
 #include "bagel/boflib/file_functions.h"
@@ -161,34 +162,44 @@ ErrorCode CBofBitmap::loadBitmap(const char *pszFileName, CBofPalette *pPalette)
 	releaseBitmap();
 
 	if (_errCode == ERR_NONE) {
-		CBofFile *pFile = new CBofFile(pszFileName, CBOFFILE_READONLY);
-
-		// Open bitmap
 		// filename must fit into our buffer
 		assert(strlen(pszFileName) < MAX_FNAME);
 
 		// Keep track of this filename
 		Common::strcpy_s(_szFileName, pszFileName);
 
-		// Decode the bitmap
-		Image::BitmapDecoder decoder;
-		Common::SeekableReadStream *rs = *pFile;
-		if (!rs || !decoder.loadStream(*rs))
-			error("Could not load bitmap %s", pszFileName);
+		// Bitmaps are loaded again whenever a room is revisited, so keep
+		// the decoded images around
+		const Graphics::DecodedImageCache::Key key(pszFileName, 0);
+		Graphics::DecodedImageCache::ImagePtr image = g_engine->_imageCache.get(key);
+
+		if (!image) {
+			// Open bitmap
+			CBofFile *pFile = new CBofFile(pszFileName, CBOFFILE_READONLY);
+
+			// Decode the bitmap
+			Image::BitmapDecoder decoder;
+			Common::SeekableReadStream *rs = *pFile;
+			if (!rs || !decoder.loadStream(*rs))
+				error("Could not load bitmap %s", pszFileName);
 
-		// Load up the decoded bitmap
-		_bitmap.copyFrom(*decoder.getSurface());
+			Graphics::ManagedSurface *decoded = new Graphics::ManagedSurface();
+			decoded->copyFrom(*decoder.getSurface());
+			decoded->setPalette(decoder.getPalette(), 0, Graphics::PALETTE_COUNT);
+			image = g_engine->_imageCache.store(key, decoded);
 
-		// Load the bitmap palette
-		_bitmap.setPalette(decoder.getPalette(), 0, Graphics::PALETTE_COUNT);
+			// Close bitmap file
+			delete pFile;
+		}
+
+		// Load up the decoded bitmap and its palette. Bitmaps may be drawn
+		// into, so each one gets its own copy
+		_bitmap.copyFrom(*image);
 
 		_nDX = _bitmap.w;
 		_nDY = _bitmap.h;
 		_nScanDX = _bitmap.pitch;
 		_pBits = (byte*)_bitmap.getBasePtr(0, 0);
-
-		// Close bitmap file
-		delete pFile;
 	}
 
 	return _errCode;
@@ -27,12 +27,17 @@
 #include "bladerunner/set_effects.h"
 #include "bladerunner/slice_animations.h"
 
+#include "common/jobs.h"
 #include "common/memstream.h"
 #include "common/rect.h"
+#include "common/system.h"
 #include "common/util.h"
 
 namespace BladeRunner {
 
+// Minimum number of scanlines drawn by a single job
+static const uint kMinThreadedSliceLines = 32;
+
 SliceRenderer::SliceRenderer(BladeRunnerEngine *vm) {
 	_vm = vm;
 	_pixelFormat = screenPixelFormat();
@@ -58,8 +63,8 @@ SliceRenderer::SliceRenderer(BladeRunnerEngine *vm) {
 	_frameSliceCount   = 0;
 	_startSlice        = 0.0f;
 	_endSlice          = 0.0f;
-	_m13               = 0;
-	_m23               = 0;
+	_sliceLinesSurface = nullptr;
+	_sliceLinesZbuffer = nullptr;
 
 	_shadowPolygonDefault[ 0] = Vector3( 16.0f,  96.0f, 0.0f);
 	_shadowPolygonDefault[ 1] = Vector3( 16.0f, 160.0f, 0.0f);
@@ -411,20 +416,10 @@ void SliceRenderer::drawInWorld(int animationId, int animationFrame, Vector3 pos
 		&setEffectsColorCoeficient,
 		&setEffectColor);
 
-	_lightsColor.r = setEffectsColorCoeficient * sliceRendererLights._finalColor.r * 65536.0f;
-	_lightsColor.g = setEffectsColorCoeficient * sliceRendererLights._finalColor.g * 65536.0f;
-	_lightsColor.b = setEffectsColorCoeficient * sliceRendererLights._finalColor.b * 65536.0f;
-
-	_setEffectColor.r = setEffectColor.r * 31.0f * 65536.0f;
-	_setEffectColor.g = setEffectColor.g * 31.0f * 65536.0f;
-	_setEffectColor.b = setEffectColor.b * 31.0f * 65536.0f;
-
 	setupLookupTable(_m12lookup, sliceLineIterator._sliceMatrix(0, 1));
 	setupLookupTable(_m11lookup, sliceLineIterator._sliceMatrix(0, 0));
-	_m13 = sliceLineIterator._sliceMatrix(0, 2);
 	setupLookupTable(_m21lookup, sliceLineIterator._sliceMatrix(1, 0));
 	setupLookupTable(_m22lookup, sliceLineIterator._sliceMatrix(1, 1));
-	_m23 = sliceLineIterator._sliceMatrix(1, 2);
 
 	if (_animationsShadowEnabled[_animation]) {
 		float coeficientShadow;
@@ -442,11 +437,16 @@ void SliceRenderer::drawInWorld(int animationId, int animationFrame, Vector3 pos
 
 	int frameY = sliceLineIterator._startY;
 
-	uint16 *zBufferLinePtr = zbuffer + BladeRunnerEngine::kOriginalGameWidth * frameY;
+	// The lights and set effects are evaluated incrementally from line to line,
+	// so the parameters of all lines are gathered first. Every line then writes
+	// its own row of the surface and the z-buffer, which lets the job system
+	// draw them in parallel.
+	_sliceLines.resize(0);
 
 	while (sliceLineIterator._currentY <= sliceLineIterator._endY) {
-		_m13 = sliceLineIterator._sliceMatrix(0, 2);
-		_m23 = sliceLineIterator._sliceMatrix(1, 2);
+		SliceLine line;
+		line.m13 = sliceLineIterator._sliceMatrix(0, 2);
+		line.m23 = sliceLineIterator._sliceMatrix(1, 2);
 		sliceLine = sliceLineIterator.line();
 
 		sliceRendererLights.calculateColorSlice(Vector3(_position.x, _position.y, _position.z + _frameBottomZ + sliceLine * _frameSliceHeight));
@@ -459,21 +459,36 @@ void SliceRenderer::drawInWorld(int animationId, int animationFrame, Vector3 pos
 				&setEffectColor);
 		}
 
-		_lightsColor.r = setEffectsColorCoeficient * sliceRendererLights._finalColor.r * 65536.0f;
-		_lightsColor.g = setEffectsColorCoeficient * sliceRendererLights._finalColor.g * 65536.0f;
-		_lightsColor.b = setEffectsColorCoeficient * sliceRendererLights._finalColor.b * 65536.0f;
+		line.lightsColor.r = setEffectsColorCoeficient * sliceRendererLights._finalColor.r * 65536.0f;
+		line.lightsColor.g = setEffectsColorCoeficient * sliceRendererLights._finalColor.g * 65536.0f;
+		line.lightsColor.b = setEffectsColorCoeficient * sliceRendererLights._finalColor.b * 65536.0f;
 
-		_setEffectColor.r = setEffectColor.r * 31.0f * 65536.0f;
-		_setEffectColor.g = setEffectColor.g * 31.0f * 65536.0f;
-		_setEffectColor.b = setEffectColor.b * 31.0f * 65536.0f;
+		line.setEffectColor.r = setEffectColor.r * 31.0f * 65536.0f;
+		line.setEffectColor.g = setEffectColor.g * 31.0f * 65536.0f;
+		line.setEffectColor.b = setEffectColor.b * 31.0f * 65536.0f;
 
 		if (frameY >= 0 && frameY < surface.h) {
-			drawSlice((int)sliceLine, true, frameY, surface, zBufferLinePtr);
+			line.slice = (int)sliceLine;
+			line.y = frameY;
+			_sliceLines.push_back(line);
 		}
 
 		sliceLineIterator.advance();
 		++frameY;
-		zBufferLinePtr += BladeRunnerEngine::kOriginalGameWidth;
+	}
+
+	_sliceLinesSurface = &surface;
+	_sliceLinesZbuffer = zbuffer;
+	g_system->getJobSystem()->parallelFor(_sliceLines.size(), drawSliceLinesProc, this, kMinThreadedSliceLines);
+}
+
+void SliceRenderer::drawSliceLinesProc(uint begin, uint end, void *refCon) {
+	SliceRenderer *renderer = (SliceRenderer *)refCon;
+
+	for (uint i = begin; i < end; ++i) {
+		const SliceLine &line = renderer->_sliceLines[i];
+		uint16 *zBufferLinePtr = renderer->_sliceLinesZbuffer + BladeRunnerEngine::kOriginalGameWidth * line.y;
+		renderer->drawSlice(line, true, *renderer->_sliceLinesSurface, zBufferLinePtr);
 	}
 }
 
@@ -514,10 +529,12 @@ void SliceRenderer::drawOnScreen(int animationId, int animationFrame, int screen
 
 	setupLookupTable(_m11lookup, m(0, 0));
 	setupLookupTable(_m12lookup, m(0, 1));
-	_m13 = m(0, 2);
 	setupLookupTable(_m21lookup, m(1, 0));
 	setupLookupTable(_m22lookup, m(1, 1));
-	_m23 = m(1, 2);
+
+	SliceLine line;
+	line.m13 = m(0, 2);
+	line.m23 = m(1, 2);
 
 	int frameY = screenY + (size / 2.0f * frameHeight);
 	int currentY = frameY;
@@ -530,14 +547,19 @@ void SliceRenderer::drawOnScreen(int animationId, int animationFrame, int screen
 	while (currentSlice < _frameSliceCount) {
 		if (currentY >= 0 && currentY < surface.h) {
 			memset(lineZbuffer, 0xFF, BladeRunnerEngine::kOriginalGameWidth * 2);
-			drawSlice(currentSlice, false, currentY, surface, lineZbuffer);
+			line.slice = currentSlice;
+			line.y = currentY;
+			drawSlice(line, false, surface, lineZbuffer);
 			currentSlice += sliceStep;
 			--currentY;
 		}
 	}
 }
 
-void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface &surface, uint16 *zbufferLine) {
+void SliceRenderer::drawSlice(const SliceLine &line, bool advanced, Graphics::Surface &surface, uint16 *zbufferLine) {
+	int slice = line.slice;
+	int y = line.y;
+
 	if (slice < 0 || (uint32)slice >= _frameSliceCount) {
 		return;
 	}
@@ -561,15 +583,15 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 			continue;
 
 		uint32 lastVertex = vertexCount - 1;
-		int lastVertexX = MAX((_m11lookup[p[3 * lastVertex]] + _m12lookup[p[3 * lastVertex + 1]] + _m13) / 65536, 0);
+		int lastVertexX = MAX((_m11lookup[p[3 * lastVertex]] + _m12lookup[p[3 * lastVertex + 1]] + line.m13) / 65536, 0);
 
 		int previousVertexX = lastVertexX;
 
 		while (vertexCount--) {
-			int vertexX = CLIP<int32>((_m11lookup[p[0]] + _m12lookup[p[1]] + _m13) / 65536, 0, BladeRunnerEngine::kOriginalGameWidth);
+			int vertexX = CLIP<int32>((_m11lookup[p[0]] + _m12lookup[p[1]] + line.m13) / 65536, 0, BladeRunnerEngine::kOriginalGameWidth);
 
 			if (vertexX > previousVertexX) {
-				int vertexZ = (_m21lookup[p[0]] + _m22lookup[p[1]] + _m23) / 64;
+				int vertexZ = (_m21lookup[p[0]] + _m22lookup[p[1]] + line.m23) / 64;
 
 				if (vertexZ >= 0 && vertexZ < 65536) {
 					uint32 outColor = palette.value[p[2]];
@@ -578,9 +600,9 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 						_screenEffects->getColor(&aescColor, vertexX, y, vertexZ);
 
 						Color256 color = palette.color[p[2]];
-						color.r = ((int)(_setEffectColor.r + _lightsColor.r * color.r) / 65536) + aescColor.r;
-						color.g = ((int)(_setEffectColor.g + _lightsColor.g * color.g) / 65536) + aescColor.g;
-						color.b = ((int)(_setEffectColor.b + _lightsColor.b * color.b) / 65536) + aescColor.b;
+						color.r = ((int)(line.setEffectColor.r + line.lightsColor.r * color.r) / 65536) + aescColor.r;
+						color.g = ((int)(line.setEffectColor.g + line.lightsColor.g * color.g) / 65536) + aescColor.g;
+						color.b = ((int)(line.setEffectColor.b + line.lightsColor.b * color.b) / 65536) + aescColor.b;
 						// We need to convert from 5 bits per channel (r,g,b) to 8 bits
 						outColor = _pixelFormat.RGBToColor(Color::get8BitColorFrom5Bit(color.r), Color::get8BitColorFrom5Bit(color.g), Color::get8BitColorFrom5Bit(color.b));
 					}
@@ -27,6 +27,7 @@
 #include "bladerunner/view.h"
 #include "bladerunner/matrix.h"
 
+#include "common/array.h"
 #include "common/rect.h"
 
 #include "graphics/surface.h"
@@ -75,19 +76,28 @@ class SliceRenderer {
 
 	int _m11lookup[256];
 	int _m12lookup[256];
-	int _m13;
 	int _m21lookup[256];
 	int _m22lookup[256];
-	int _m23;
+
+	// Everything needed to draw one scanline, so lines can be drawn in any order
+	struct SliceLine {
+		int   slice;
+		int   y;
+		int   m13;
+		int   m23;
+		Color setEffectColor;
+		Color lightsColor;
+	};
+
+	Common::Array<SliceLine> _sliceLines;
+	Graphics::Surface       *_sliceLinesSurface;
+	uint16                  *_sliceLinesZbuffer;
 
 	bool _animationsShadowEnabled[997];
 
 	Vector3 _shadowPolygonDefault[12];
 	Vector3 _shadowPolygonCurrent[12];
 
-	Color _setEffectColor;
-	Color _lightsColor;
-
 	Graphics::PixelFormat _pixelFormat;
 
 public:
@@ -113,7 +123,8 @@ private:
 	Matrix3x2 calculateFacingRotationMatrix();
 	void loadFrame(int animation, int frame);
 
-	void drawSlice(int slice, bool advanced, int y, Graphics::Surface &surface, uint16 *zbufferLine);
+	void drawSlice(const SliceLine &line, bool advanced, Graphics::Surface &surface, uint16 *zbufferLine);
+	static void drawSliceLinesProc(uint begin, uint end, void *refCon);
 	void drawShadowInWorld(int transparency, Graphics::Surface &surface, uint16 *zbuffer);
 	void drawShadowPolygon(int transparency, Graphics::Surface &surface, uint16 *zbuffer);
 };
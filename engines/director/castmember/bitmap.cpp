@@ -477,6 +477,14 @@ void BitmapCastMember::createMatte(Common::Rect &bbox) {
 
 	if (!colorFound) {
 		debugC(1, kDebugImages, "BitmapCastMember::createMatte(): No white color for matte image");
+
+		// Drop a matte made for another size, so that it isn't recreated
+		// on every lookup
+		if (_matte) {
+			_matte->free();
+			delete _matte;
+			_matte = nullptr;
+		}
 	} else {
 		if (_matte) {
 			_matte->free();
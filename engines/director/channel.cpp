@@ -49,6 +49,8 @@ Channel::Channel(Score *sc, Sprite *sp, int priority) {
 	_widget = nullptr;
 	_constraint = 0;
 	_mask = nullptr;
+	_maskCast = nullptr;
+	_maskPicture = nullptr;
 
 	_priority = priority;
 
@@ -61,6 +63,7 @@ Channel::Channel(Score *sc, Sprite *sp, int priority) {
 
 	_visible = true;
 	_dirty = true;
+	_hasRenderedState = false;
 
 	if (_sprite)
 		_sprite->updateEditable();
@@ -77,6 +80,8 @@ Channel& Channel::operator=(const Channel &channel) {
 	_widget = nullptr;
 	_constraint = channel._constraint;
 	_mask = nullptr;
+	_maskCast = nullptr;
+	_maskPicture = nullptr;
 
 	_priority = channel._priority;
 
@@ -89,6 +94,7 @@ Channel& Channel::operator=(const Channel &channel) {
 
 	_visible = channel._visible;
 	_dirty = channel._dirty;
+	_hasRenderedState = false;
 
 	return *this;
 }
@@ -193,14 +199,21 @@ const Graphics::Surface *Channel::getMask(bool forceMatte) {
 				return nullptr;
 			}
 
-			if (_mask) {
-				delete _mask;
-				_mask = nullptr;
-			}
 			if (bitmap->_picture) {
 				// reposition channel bounding box, so origin is at registration offset
 				Common::Point originPos = getPosition();
 				bbox.translate(-originPos.x, -originPos.y);
+
+				// the mask only depends on the mask image and the bounding box
+				// relative to the registration offset, so reuse it while they stay the same
+				if (_mask && _maskCast == bitmap && _maskPicture == bitmap->_picture && _maskBbox == bbox && !bitmap->isModified())
+					return &_mask->rawSurface();
+
+				delete _mask;
+				_maskCast = bitmap;
+				_maskPicture = bitmap->_picture;
+				_maskBbox = bbox;
+
 				// create new mask surface, with the exact dimensions of the channel.
 				_mask = new Graphics::ManagedSurface(bbox.width(), bbox.height());
 				// get the bounding box of the mask image (origin at registration offset)
@@ -265,6 +278,28 @@ bool Channel::isDirty(Sprite *nextSprite) {
 	return isDirtyFlag;
 }
 
+bool Channel::RenderState::operator==(const RenderState &s) const {
+	return castId == s.castId && cast == s.cast && bbox == s.bbox && ink == s.ink &&
+		foreColor == s.foreColor && backColor == s.backColor && blendAmount == s.blendAmount &&
+		thickness == s.thickness && spriteType == s.spriteType && trails == s.trails && visible == s.visible;
+}
+
+Channel::RenderState Channel::getRenderState() {
+	RenderState state;
+	state.castId = _sprite->_castId;
+	state.cast = _sprite->_cast;
+	state.bbox = getBbox();
+	state.ink = _sprite->_ink;
+	state.foreColor = _sprite->_foreColor;
+	state.backColor = _sprite->_backColor;
+	state.blendAmount = _sprite->_blendAmount;
+	state.thickness = _sprite->_thickness;
+	state.spriteType = _sprite->_spriteType;
+	state.trails = _sprite->_trails;
+	state.visible = _visible;
+	return state;
+}
+
 bool Channel::isStretched() {
 	return _sprite->_stretch;
 }
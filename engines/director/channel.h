@@ -35,10 +35,29 @@ namespace Director {
 
 class Sprite;
 class Cursor;
+class Picture;
 class Score;
 
 class Channel {
 public:
+	// The sprite properties which affect how the channel looks on screen
+	struct RenderState {
+		CastMemberID castId;
+		CastMember *cast;
+		Common::Rect bbox;
+		InkType ink;
+		uint32 foreColor;
+		uint32 backColor;
+		byte blendAmount;
+		byte thickness;
+		SpriteType spriteType;
+		bool trails;
+		bool visible;
+
+		bool operator==(const RenderState &s) const;
+		bool operator!=(const RenderState &s) const { return !(*this == s); }
+	};
+
 	Channel(Score *sc, Sprite *sp, int priority = 0);
 	Channel(const Channel &channel);
 	Channel& operator=(const Channel &channel);
@@ -79,6 +98,13 @@ public:
 
 	bool isTrail();
 
+	RenderState getRenderState();
+	// Whether the screen is known to show the channel as it is now
+	bool isRendered(const RenderState &state) { return _hasRenderedState && _renderedState == state; }
+	void setRendered(const RenderState &state) { _renderedState = state; _hasRenderedState = true; }
+	void invalidateRendered() { _hasRenderedState = false; }
+	Common::Rect getRenderedBbox() { return _renderedState.bbox; }
+
 	void updateGlobalAttr();
 
 	bool canKeepWidget(CastMemberID castId);
@@ -119,6 +145,15 @@ public:
 private:
 	Graphics::ManagedSurface *getSurface();
 	Score *_score;
+
+	// What _mask was created from, for the mask ink
+	CastMember *_maskCast;
+	Picture *_maskPicture;
+	Common::Rect _maskBbox;
+
+	// State of the sprite as it was last queued for drawing
+	RenderState _renderedState;
+	bool _hasRenderedState;
 };
 
 } // End of namespace Director
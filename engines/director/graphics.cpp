@@ -689,6 +689,195 @@ void DirectorPlotData::inkBlitShape(Common::Rect &srcRect) {
 	}
 }
 
+// Blits a span of a sprite surface with one ink, avoiding the per pixel
+// dispatch of InkPrimitives::drawPoint(). COLORED selects the variant which
+// reduces the image to the fore and back colors.
+template <typename T, InkType INK, bool COLORED>
+static void inkBlitSpan(const DirectorPlotData *p, T *dst, const T *src, const byte *msk, int width) {
+	Graphics::MacWindowManager *wm = p->d->_wm;
+
+	for (int i = 0; i < width; i++) {
+		if (msk && !msk[i])
+			continue;
+
+		const uint32 s = src[i];
+		const uint32 d = dst[i];
+
+		switch (INK) {
+		case kInkTypeBackgndTrans:
+			if (COLORED)
+				dst[i] = (s == p->colorBlack) ? p->foreColor : d;
+			else if (s != p->backColor)
+				dst[i] = s;
+			break;
+		case kInkTypeCopy:
+			// Only used for 8 bpp when colored
+			if (COLORED)
+				dst[i] = (s == 0xff) ? p->foreColor : ((s == 0x00) ? p->backColor : d);
+			else
+				dst[i] = s;
+			break;
+		case kInkTypeNotCopy:
+			// Only used for 8 bpp, and always colored
+			dst[i] = (s == 0xff) ? p->backColor : ((s == 0x00) ? p->foreColor : s);
+			break;
+		case kInkTypeTransparent:
+			if (COLORED)
+				dst[i] = (s == p->colorBlack) ? p->foreColor : d;
+			else
+				dst[i] = d | s;
+			break;
+		case kInkTypeNotTrans:
+			if (COLORED)
+				dst[i] = (s == p->colorWhite) ? p->foreColor : d;
+			else
+				dst[i] = d | ~s;
+			break;
+		case kInkTypeReverse:
+			dst[i] = d ^ s;
+			break;
+		case kInkTypeNotReverse:
+			dst[i] = d ^ ~s;
+			break;
+		case kInkTypeGhost:
+			if (COLORED)
+				dst[i] = (s == p->colorBlack) ? p->backColor : d;
+			else
+				dst[i] = d & ~s;
+			break;
+		case kInkTypeNotGhost:
+			if (COLORED)
+				dst[i] = (s == p->colorWhite) ? p->backColor : d;
+			else
+				dst[i] = d & s;
+			break;
+		default: {
+			byte rSrc, gSrc, bSrc;
+			byte rDst, gDst, bDst;
+
+			wm->decomposeColor<T>(s, rSrc, gSrc, bSrc);
+			wm->decomposeColor<T>(d, rDst, gDst, bDst);
+
+			switch (INK) {
+			case kInkTypeAddPin:
+				dst[i] = wm->findBestColor(rDst + MIN(0xff - rDst, (int)rSrc), gDst + MIN(0xff - gDst, (int)gSrc), bDst + MIN(0xff - bDst, (int)bSrc));
+				break;
+			case kInkTypeAdd:
+				dst[i] = wm->findBestColor(rDst + rSrc, gDst + gSrc, bDst + bSrc);
+				break;
+			case kInkTypeSubPin:
+				dst[i] = wm->findBestColor(MAX(rDst - rSrc, 1) - 1, MAX(gDst - gSrc, 1) - 1, MAX(bDst - bSrc, 1) - 1);
+				break;
+			case kInkTypeLight:
+				dst[i] = wm->findBestColor(MAX(rSrc, rDst), MAX(gSrc, gDst), MAX(bSrc, bDst));
+				break;
+			case kInkTypeSub:
+				dst[i] = wm->findBestColor(rDst - rSrc, gDst - gSrc, bDst - bSrc);
+				break;
+			case kInkTypeDark:
+				dst[i] = wm->findBestColor(MIN(rSrc, rDst), MIN(gSrc, gDst), MIN(bSrc, bDst));
+				break;
+			default:
+				break;
+			}
+		}
+		}
+	}
+}
+
+template <typename T>
+struct InkSpan {
+	typedef void (*Proc)(const DirectorPlotData *p, T *dst, const T *src, const byte *msk, int width);
+
+	// Returns the span blitter matching what InkPrimitives::drawPoint() would
+	// do for the plot data, or nullptr if it has to be drawn per pixel.
+	static Proc get(const DirectorPlotData *p) {
+		if (p->alpha || p->ms)
+			return nullptr;
+
+		// These are recolored by preprocessColor()
+		if (p->sprite == kTextSprite) {
+			switch (p->ink) {
+			case kInkTypeMask:
+			case kInkTypeReverse:
+			case kInkTypeNotReverse:
+			case kInkTypeNotGhost:
+			case kInkTypeNotCopy:
+			case kInkTypeNotTrans:
+				return nullptr;
+			default:
+				break;
+			}
+		}
+
+		const bool colored = p->oneBitImage || p->applyColor;
+
+		switch (p->ink) {
+		case kInkTypeBackgndTrans:
+			return p->oneBitImage ? &inkBlitSpan<T, kInkTypeBackgndTrans, true> : &inkBlitSpan<T, kInkTypeBackgndTrans, false>;
+		case kInkTypeMatte:
+		case kInkTypeMask:
+		case kInkTypeBlend:
+		case kInkTypeCopy:
+			if (!p->applyColor)
+				return &inkBlitSpan<T, kInkTypeCopy, false>;
+			return sizeof(T) == 1 ? &inkBlitSpan<T, kInkTypeCopy, true> : nullptr;
+		case kInkTypeNotCopy:
+			return (p->applyColor && sizeof(T) == 1) ? &inkBlitSpan<T, kInkTypeNotCopy, true> : nullptr;
+		case kInkTypeTransparent:
+			return colored ? &inkBlitSpan<T, kInkTypeTransparent, true> : &inkBlitSpan<T, kInkTypeTransparent, false>;
+		case kInkTypeNotTrans:
+			return colored ? &inkBlitSpan<T, kInkTypeNotTrans, true> : &inkBlitSpan<T, kInkTypeNotTrans, false>;
+		case kInkTypeReverse:
+			return &inkBlitSpan<T, kInkTypeReverse, false>;
+		case kInkTypeNotReverse:
+			return &inkBlitSpan<T, kInkTypeNotReverse, false>;
+		case kInkTypeGhost:
+			return colored ? &inkBlitSpan<T, kInkTypeGhost, true> : &inkBlitSpan<T, kInkTypeGhost, false>;
+		case kInkTypeNotGhost:
+			return colored ? &inkBlitSpan<T, kInkTypeNotGhost, true> : &inkBlitSpan<T, kInkTypeNotGhost, false>;
+		case kInkTypeAddPin:
+			return &inkBlitSpan<T, kInkTypeAddPin, false>;
+		case kInkTypeAdd:
+			return &inkBlitSpan<T, kInkTypeAdd, false>;
+		case kInkTypeSubPin:
+			return &inkBlitSpan<T, kInkTypeSubPin, false>;
+		case kInkTypeLight:
+			return &inkBlitSpan<T, kInkTypeLight, false>;
+		case kInkTypeSub:
+			return &inkBlitSpan<T, kInkTypeSub, false>;
+		case kInkTypeDark:
+			return &inkBlitSpan<T, kInkTypeDark, false>;
+		default:
+			return nullptr;
+		}
+	}
+};
+
+template <typename T>
+static bool inkBlitSpans(DirectorPlotData *p, const Common::Rect &srcRect, const Graphics::Surface *mask) {
+	typename InkSpan<T>::Proc proc = InkSpan<T>::get(p);
+	if (!proc || p->srf->format.bytesPerPixel != sizeof(T))
+		return false;
+
+	// Sprites reaching outside of their surface are left to the per pixel
+	// code, which reports them
+	Common::Rect area(p->destRect);
+	area.translate(-srcRect.left, -srcRect.top);
+	if (!p->srf->getBounds().contains(area) || (mask && !Common::Rect(mask->w, mask->h).contains(area)))
+		return false;
+
+	for (int i = 0; i < area.height(); i++) {
+		T *dst = (T *)p->dst->getBasePtr(p->destRect.left, p->destRect.top + i);
+		const T *src = (const T *)p->srf->getBasePtr(area.left, area.top + i);
+		const byte *msk = mask ? (const byte *)mask->getBasePtr(area.left, area.top + i) : nullptr;
+
+		proc(p, dst, src, msk, area.width());
+	}
+
+	return true;
+}
+
 void DirectorPlotData::inkBlitSurface(Common::Rect &srcRect, const Graphics::Surface *mask) {
 	if (!srf)
 		return;
@@ -723,6 +912,14 @@ void DirectorPlotData::inkBlitSurface(Common::Rect &srcRect, const Graphics::Sur
 	// format as the window manager. Most of the time this is
 	// the job of BitmapCastMember::createWidget.
 
+	if (d->_wm->_pixelformat.bytesPerPixel == 1) {
+		if (inkBlitSpans<byte>(this, srcRect, mask))
+			return;
+	} else {
+		if (inkBlitSpans<uint32>(this, srcRect, mask))
+			return;
+	}
+
 	Graphics::Primitives *primitives = g_director->getInkPrimitives();
 
 	srcPoint.y = abs(srcRect.top - destRect.top);
@@ -184,10 +184,14 @@ void Lingo::cleanupFuncs() {
 		delete it._value;
 }
 
-void Lingo::push(Datum d) {
+void Lingo::push(const Datum &d) {
 	_state->stack.push_back(d);
 }
 
+void Lingo::push(Datum &&d) {
+	_state->stack.push_back(Common::move(d));
+}
+
 Datum Lingo::getVoid() {
 	Datum d;
 	d.u.s = nullptr;
@@ -196,14 +200,13 @@ Datum Lingo::getVoid() {
 }
 
 void Lingo::pushVoid() {
-	Datum d = getVoid();
-	push(d);
+	push(getVoid());
 }
 
 Datum Lingo::pop() {
 	assert (_state->stack.size() != 0);
 
-	Datum ret = _state->stack.back();
+	Datum ret = Common::move(_state->stack.back());
 	_state->stack.pop_back();
 
 	return ret;
@@ -1591,7 +1594,7 @@ void LC::call(const Common::String &name, int nargs, bool allowRetVal) {
 			objName.type = VARREF;
 			Datum obj = g_lingo->varFetch(objName, true);
 			if (obj.type == OBJECT && (obj.u.obj->getObjType() & (kFactoryObj | kXObj))) {
-				debugC(3, kDebugLingoExec, "Factory/XObject method called on object: <%s>", obj.asString(true).c_str());
+				DEBUG_C(3, kDebugLingoExec, "Factory/XObject method called on object: <%s>", obj.asString(true).c_str());
 				AbstractObject *target = obj.u.obj;
 				if (firstArg.u.s->equalsIgnoreCase("mNew")) {
 					target = target->clone();
@@ -1610,7 +1613,7 @@ void LC::call(const Common::String &name, int nargs, bool allowRetVal) {
 
 		// Script/Xtra method call
 		if (firstArg.type == OBJECT && !(firstArg.u.obj->getObjType() & (kFactoryObj | kXObj))) {
-			debugC(3, kDebugLingoExec, "Script/Xtra method called on object: <%s>", firstArg.asString(true).c_str());
+			DEBUG_C(3, kDebugLingoExec, "Script/Xtra method called on object: <%s>", firstArg.asString(true).c_str());
 			AbstractObject *target = firstArg.u.obj;
 			if (name.equalsIgnoreCase("birth") || name.equalsIgnoreCase("new")) {
 				target = target->clone();
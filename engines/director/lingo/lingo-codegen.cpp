@@ -119,13 +119,44 @@ LingoCompiler::LingoCompiler() {
 	_refMode = false;
 
 	_hadError = false;
+	_cacheable = true;
+}
+
+LingoCompiler::~LingoCompiler() {
+	clearAnonymousCache();
 }
 
 ScriptContext *LingoCompiler::compileAnonymous(const Common::U32String &code, uint32 preprocFlags) {
+	// The code is compiled differently when outdated Lingo is allowed
+	bool outdatedLingo = g_director->getCurrentMovie() && g_director->getCurrentMovie()->_allowOutdatedLingo;
+	Common::String key = Common::String::format("%d:%d:", preprocFlags, outdatedLingo) + code.encode();
+
+	ScriptContext *sc = nullptr;
+	if (_anonymousCache.tryGetVal(key, sc)) {
+		debugC(3, kDebugCompile, "Reusing compiled anonymous lingo");
+		return sc;
+	}
+
 	debugC(1, kDebugCompile, "Compiling anonymous lingo\n"
 			"***********\n%s\n\n***********", code.encode().c_str());
 
-	return compileLingo(code, nullptr, kNoneScript, CastMemberID(0, 0), "[anonymous]", true, preprocFlags);
+	sc = compileLingo(code, nullptr, kNoneScript, CastMemberID(0, 0), "[anonymous]", true, preprocFlags);
+
+	// The contexts are freed once they have been run, so keep a reference
+	if (sc && _cacheable) {
+		if (_anonymousCache.size() >= 256)
+			clearAnonymousCache();
+		sc->incRefCount();
+		_anonymousCache[key] = sc;
+	}
+
+	return sc;
+}
+
+void LingoCompiler::clearAnonymousCache() {
+	for (auto &it : _anonymousCache)
+		it._value->decRefCount();
+	_anonymousCache.clear();
 }
 
 ScriptContext *LingoCompiler::compileLingo(const Common::U32String &code, LingoArchive *archive, ScriptType type, CastMemberID id, const Common::String &scriptName, bool anonymous, uint32 preprocFlags) {
@@ -138,6 +169,7 @@ ScriptContext *LingoCompiler::compileLingo(const Common::U32String &code, LingoA
 	_methodVars = new VarTypeHash;
 	_linenumber = _colnumber = 1;
 	_hadError = false;
+	_cacheable = true;
 
 	// Preprocess the code for ease of the parser
 	Common::U32String codePrep = codePreprocessor(code, archive, type, id, preprocFlags);
@@ -403,6 +435,9 @@ void LingoCompiler::registerMethodVar(const Common::String &name, VarType type)
 			type = kVarLocal;
 		}
 		(*_methodVars)[name] = type;
+		if (type == kVarProperty || type == kVarInstance || type == kVarGlobal)
+			_cacheable = false;
+
 		if (type == kVarProperty || type == kVarInstance) {
 			if (!_assemblyContext->hasProp(name))
 				_assemblyContext->setProp(name, Datum(), true);
@@ -417,6 +452,7 @@ void LingoCompiler::registerFactory(Common::String &name) {
 	_assemblyContext->setName(name);
 	_assemblyContext->setFactory(true);
 	g_lingo->_globalvars[name] = _assemblyContext;
+	_cacheable = false;
 	// Add the factory to the list in the archive
 	if (_assemblyArchive) {
 		if (!_assemblyArchive->factoryContexts.contains(_assemblyId)) {
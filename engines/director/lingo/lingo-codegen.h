@@ -30,9 +30,10 @@ namespace Director {
 class LingoCompiler : NodeVisitor {
 public:
 	LingoCompiler();
-	virtual ~LingoCompiler() {}
+	virtual ~LingoCompiler();
 
 	ScriptContext *compileAnonymous(const Common::U32String &code, uint32 preprocFlags = 0);
+	void clearAnonymousCache();
 	ScriptContext *compileLingo(const Common::U32String &code, LingoArchive *archive, ScriptType type, CastMemberID id, const Common::String &scriptName, bool anonyomous = false, uint32 preprocFlags = kLPPNone);
 	ScriptContext *compileLingoV4(Common::SeekableReadStreamEndian &stream, uint16 lctxIndex, LingoArchive *archive, const Common::String &archName, uint16 version);
 
@@ -70,6 +71,12 @@ public:
 	Common::HashMap<Common::String, VarType, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> *_methodVars;
 
 	bool _hadError;
+	// False if compiling the script changed state outside of its context
+	bool _cacheable;
+
+private:
+	// Compiled do and value() expressions, which are often run repeatedly
+	Common::HashMap<Common::String, ScriptContext *> _anonymousCache;
 
 public:
 	virtual bool visitScriptNode(ScriptNode *node);
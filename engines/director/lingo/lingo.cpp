@@ -20,6 +20,7 @@
  */
 
 #include "common/file.h"
+#include "common/str-builder.h"
 
 #include "graphics/macgui/macwindowmanager.h"
 
@@ -879,17 +880,46 @@ Datum::Datum(const Datum &d) {
 	type = d.type;
 	u = d.u;
 	refCount = d.refCount;
-	*refCount += 1;
+	if (refCount)
+		*refCount += 1;
 	ignoreGlobal = false;
 }
 
+// Moving takes over the reference, leaving a void Datum without a refCount behind
+Datum::Datum(Datum &&d) {
+	type = d.type;
+	u = d.u;
+	refCount = d.refCount;
+	ignoreGlobal = false;
+
+	d.type = VOID;
+	d.u.s = nullptr;
+	d.refCount = nullptr;
+}
+
 Datum& Datum::operator=(const Datum &d) {
 	if (this != &d && refCount != d.refCount) {
 		reset();
 		type = d.type;
 		u = d.u;
 		refCount = d.refCount;
-		*refCount += 1;
+		if (refCount)
+			*refCount += 1;
+	}
+	ignoreGlobal = false;
+	return *this;
+}
+
+Datum& Datum::operator=(Datum &&d) {
+	if (this != &d) {
+		reset();
+		type = d.type;
+		u = d.u;
+		refCount = d.refCount;
+
+		d.type = VOID;
+		d.u.s = nullptr;
+		d.refCount = nullptr;
 	}
 	ignoreGlobal = false;
 	return *this;
@@ -1117,9 +1147,13 @@ double Datum::asFloat() const {
 Common::String Datum::asString(bool printonly) const {
 	Common::String s;
 	switch (type) {
-	case INT:
-		s = Common::String::format("%d", u.i);
+	case INT: {
+		// Integers are converted all the time, skip the vsnprintf() parsing
+		Common::StringBuilder sb;
+		sb.appendInt(u.i);
+		s = sb.toString();
 		break;
+	}
 	case ARGC:
 		s = Common::String::format("argc: %d", u.i);
 		break;
@@ -1566,7 +1600,7 @@ void Lingo::executePerFrameHook(int frame, int subframe) {
 	if (_perFrameHook.type == OBJECT) {
 		Symbol method = _perFrameHook.u.obj->getMethod("mAtFrame");
 		if (method.type != VOIDSYM) {
-			debugC(1, kDebugLingoExec, "Executing perFrameHook : <%s>(mAtFrame, %d, %d)", _perFrameHook.asString(true).c_str(), frame, subframe);
+			DEBUG_C(1, kDebugLingoExec, "Executing perFrameHook : <%s>(mAtFrame, %d, %d)", _perFrameHook.asString(true).c_str(), frame, subframe);
 			push(_perFrameHook);
 			push(frame);
 			push(subframe);
@@ -1581,7 +1615,7 @@ void Lingo::executePerFrameHook(int frame, int subframe) {
 				Datum actor = _actorList.u.farr->arr[i];
 				Symbol method = actor.u.obj->getMethod("stepFrame");
 				if (method.type != VOIDSYM) {
-					debugC(1, kDebugLingoExec, "Executing perFrameHook : <%s>, frame %d, subframe %d", actor.asString(true).c_str(), frame, subframe);
+					DEBUG_C(1, kDebugLingoExec, "Executing perFrameHook : <%s>, frame %d, subframe %d", actor.asString(true).c_str(), frame, subframe);
 					if (method.nargs == 1)
 						push(actor);
 					LC::call(method, method.nargs, false);
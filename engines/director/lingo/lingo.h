@@ -149,7 +149,9 @@ struct Datum {	/* interpreter stack type */
 
 	Datum();
 	Datum(const Datum &d);
+	Datum(Datum &&d);
 	Datum& operator=(const Datum &d);
+	Datum& operator=(Datum &&d);
 	Datum(int val);
 	Datum(double val);
 	Datum(const Common::String &val);
@@ -533,7 +535,8 @@ public:
 	Common::String _floatPrecisionFormat;
 
 public:
-	void push(Datum d);
+	void push(const Datum &d);
+	void push(Datum &&d);
 	Datum pop();
 	Datum peek(uint offset);
 
@@ -807,8 +807,12 @@ void Score::updateSprites(RenderMode mode, bool withClean) {
 
 		if (channel->isDirty(nextSprite) || widgetRedrawn || mode == kRenderForceUpdate) {
 			bool invalidCastMember = currentSprite && currentSprite->_spriteType == kCastMemberSprite && currentSprite->_cast == nullptr;
-			if (currentSprite && !invalidCastMember && !currentSprite->_trails)
-				_window->addDirtyRect(channel->getBbox());
+			bool addPreviousBbox = currentSprite && !invalidCastMember && !currentSprite->_trails;
+			Common::Rect previousBbox = channel->getBbox();
+
+			// Changes to the cast member itself can't be told from the sprite state
+			bool stateOnly = currentSprite && !widgetRedrawn && mode != kRenderForceUpdate &&
+				!(currentSprite->_cast && (currentSprite->_cast->isModified() || currentSprite->_cast->_erase));
 
 			if (currentSprite && currentSprite->_cast && currentSprite->_cast->_erase) {
 				currentSprite->_cast->_erase = false;
@@ -826,8 +830,19 @@ void Score::updateSprites(RenderMode mode, bool withClean) {
 			if (channel->isActiveVideo())
 				_movie->_videoPlayback = true;
 
-			if (!invalidCastMember)
-				_window->addDirtyRect(channel->getBbox());
+			// Channels which were only flagged dirty, e.g. when a puppet has
+			// been set to what it already showed, don't need to be redrawn.
+			// Videos and film loops change without the sprite changing.
+			Channel::RenderState state = channel->getRenderState();
+			if (stateOnly && !channel->isActiveVideo() && !channel->hasSubChannels() && channel->isRendered(state)) {
+				debugC(5, kDebugImages, "Score::updateSprites(): CH: %-3d unchanged, skipping", i);
+			} else {
+				if (addPreviousBbox)
+					_window->addDirtyRect(previousBbox);
+				if (!invalidCastMember)
+					_window->addDirtyRect(state.bbox);
+			}
+			channel->setRendered(state);
 
 			if (currentSprite) {
 				Common::Rect bbox = channel->getBbox();
@@ -1492,6 +1507,23 @@ bool Score::checkSpriteIntersection(uint16 spriteId, Common::Point pos) {
 	return false;
 }
 
+void Score::invalidateRenderedChannels(const Common::List<Common::Rect> &rects) {
+	for (auto &channel : _channels) {
+		Channel::RenderState state = channel->getRenderState();
+		if (channel->isRendered(state))
+			continue;
+
+		// The screen will show the channel as it is now, so only the channels
+		// which were queued in another state need invalidating
+		for (auto &r : rects) {
+			if (r.intersects(state.bbox) || r.intersects(channel->getRenderedBbox())) {
+				channel->invalidateRendered();
+				break;
+			}
+		}
+	}
+}
+
 Common::List<Channel *> Score::getSpriteIntersections(const Common::Rect &r) {
 	Common::List<Channel *> intersections;
 	Common::List<Channel *> appendix;
@@ -114,6 +114,7 @@ public:
 	uint16 getActiveSpriteIDFromPos(Common::Point pos);
 	bool checkSpriteIntersection(uint16 spriteId, Common::Point pos);
 	Common::List<Channel *> getSpriteIntersections(const Common::Rect &r);
+	void invalidateRenderedChannels(const Common::List<Common::Rect> &rects);
 	uint16 getSpriteIdByMemberId(CastMemberID id);
 	bool refreshPointersForCastMemberID(CastMemberID id);
 
@@ -135,6 +135,41 @@ void Window::drawFrameCounter(Graphics::ManagedSurface *blitTo) {
 	font->drawString(blitTo, msg, blitTo->w - 2 - width, 2, width, _wm->_colorWhite);
 }
 
+static bool isTrailRect(const Common::Array<Channel *> &channels, const Common::Rect &r) {
+	for (auto &ch : channels) {
+		if (ch->_visible && ch->isTrail() && r == ch->getBbox())
+			return true;
+	}
+	return false;
+}
+
+void Window::coalesceDirtyRects() {
+	// Every rect drawn costs a pass over the sprites intersecting it, so join
+	// nearby rects as long as that doesn't draw more than twice the area.
+	// Rects matching a trail sprite are left alone, as they aren't cleared.
+	const int maxOverdraw = 2;
+	const Common::Array<Channel *> &channels = _currentMovie->getScore()->_channels;
+
+	for (auto rOuter = _dirtyRects.begin(); rOuter != _dirtyRects.end(); ++rOuter) {
+		if (isTrailRect(channels, *rOuter))
+			continue;
+
+		auto rInner = rOuter;
+		while (++rInner != _dirtyRects.end()) {
+			Common::Rect merged = *rOuter;
+			merged.extend(*rInner);
+
+			int64 area = (int64)rOuter->width() * rOuter->height() + (int64)rInner->width() * rInner->height();
+			if ((int64)merged.width() * merged.height() > area * maxOverdraw || isTrailRect(channels, *rInner))
+				continue;
+
+			*rOuter = merged;
+			_dirtyRects.erase(rInner);
+			rInner = rOuter;
+		}
+	}
+}
+
 bool Window::render(bool forceRedraw, Graphics::ManagedSurface *blitTo) {
 	if (!_currentMovie)
 		return false;
@@ -157,8 +192,11 @@ bool Window::render(bool forceRedraw, Graphics::ManagedSurface *blitTo) {
 		}
 
 		mergeDirtyRects();
+		coalesceDirtyRects();
 	}
 
+	_currentMovie->getScore()->invalidateRenderedChannels(_dirtyRects);
+
 	Channel *hiliteChannel = _currentMovie->getScore()->getChannelById(_currentMovie->_currentHiliteChannelId);
 
 	uint32 renderStartTime = g_system->getMillis();
@@ -228,6 +228,7 @@ private:
 private:
 	void inkBlitFrom(Channel *channel, Common::Rect destRect, Graphics::ManagedSurface *blitTo = nullptr);
 	void drawFrameCounter(Graphics::ManagedSurface *blitTo);
+	void coalesceDirtyRects();
 
 
 };
@@ -27,6 +27,7 @@
 #include "common/config-manager.h"
 #include "common/events.h"
 #include "common/file.h"
+#include "common/fs.h"
 #include "common/system.h"
 #include "common/str.h"
 #include "common/ustr.h"
@@ -39,6 +40,7 @@
 #include "common/textconsole.h"
 #include "common/translation.h"
 #include "common/singleton.h"
+#include "common/formats/cdimage.h"
 
 #include "backends/audiocd/audiocd.h"
 #include "backends/keymapper/action.h"
@@ -223,8 +225,40 @@ Engine::~Engine() {
 	CursorMan.popCursorPalette();
 }
 
+static void addCDImage() {
+	if (!ConfMan.hasKey("cdimage"))
+		return;
+
+	// Files in the game directory take precedence over those in the image
+	const Common::Path imagePath = ConfMan.getPath("cdimage");
+	Common::Archive *image = Common::makeCDImageArchive(Common::FSNode(imagePath));
+	if (image)
+		SearchMan.add("cdimage", image, -1);
+	else
+		warning("Could not read the CD image '%s'", imagePath.toString(Common::Path::kNativeSeparator).c_str());
+}
+
 void Engine::initializePath(const Common::FSNode &gamePath) {
-	SearchMan.addDirectory(gamePath, 0, 4);
+	if (!ConfMan.hasKey("fscachepath")) {
+		SearchMan.addDirectory(gamePath, 0, 4);
+		addCDImage();
+		return;
+	}
+
+	if (!gamePath.exists() || !gamePath.isDirectory()) {
+		addCDImage();
+		return;
+	}
+
+	// Reuse the listing of the game directory from earlier runs
+	const Common::String path = gamePath.getPath().toString();
+	Common::FSDirectory *dir = new Common::FSDirectory(gamePath, 4, false, SearchMan.getIgnoreClashes());
+	Common::FSNode cacheDir(ConfMan.getPath("fscachepath"));
+	if (cacheDir.isDirectory())
+		dir->setListingCacheFile(cacheDir.getChild(Common::String::format("%08x.fsl", Common::hashit(path.c_str()))));
+
+	SearchMan.add(path, dir, 0);
+	addCDImage();
 }
 
 bool Engine::enhancementEnabled(int32 cls) {
@@ -336,7 +336,8 @@ public:
 	 * Initialize SearchMan according to the game path.
 	 *
 	 * By default, this adds the directory in non-flat mode with a depth of 4 as
-	 * priority 0 to SearchMan.
+	 * priority 0 to SearchMan, and the CD image set with the cdimage option
+	 * as priority -1.
 	 *
 	 * @param gamePath The base directory of the game data.
 	 */
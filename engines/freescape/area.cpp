@@ -364,16 +364,26 @@ void Area::draw(Freescape::Renderer *gfx, uint32 animationTicks, Math::Vector3d
 	// triggers a bug in TinyGL where certain objects such as lines,
 	// are not rendered correctly. This is a workaround for that issue.
 	for (auto &obj : nonPlanarObjects) {
-		obj->draw(gfx);
+		if (isVisible(gfx, obj))
+			obj->draw(gfx);
 	}
 
 	for (auto &pair : offsetMap) {
-		pair._key->draw(gfx, pair._value);
+		if (isVisible(gfx, pair._key))
+			pair._key->draw(gfx, pair._value);
 	}
 
 	_lastTick = animationTicks;
 }
 
+bool Area::isVisible(Freescape::Renderer *gfx, Object *obj) {
+	// Objects without a bounding box (e.g. sensors) are always drawn
+	if (!obj->_boundingBox.isValid())
+		return true;
+
+	return gfx->isInsideFrustum(obj->_boundingBox);
+}
+
 void Area::drawGroup(Freescape::Renderer *gfx, Group* group, bool runAnimation) {
 	if (runAnimation) {
 		group->run();
@@ -54,6 +54,7 @@ public:
 	void unremapColor(int index);
 	void draw(Renderer *gfx, uint32 animationTicks, Math::Vector3d camera, Math::Vector3d direction);
 	void drawGroup(Renderer *gfx, Group *group, bool runAnimation);
+	bool isVisible(Renderer *gfx, Object *obj);
 	void show();
 
 	Object *checkCollisionRay(const Math::Ray &ray, int raySize);
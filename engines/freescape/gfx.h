@@ -278,6 +278,11 @@ public:
 	virtual void updateProjectionMatrix(float fov, float aspectRatio, float nearClipPlane, float farClipPlane) = 0;
 
 	Math::Matrix4 getMvpMatrix() const { return _mvpMatrix; }
+	/**
+	 * Check if a bounding box is inside the view frustum set by the last
+	 * positionCamera() call
+	 */
+	bool isInsideFrustum(const Math::AABB &aabb) const { return _frustum.isInside(aabb); }
 	virtual Graphics::Surface *getScreenshot() = 0;
 	void flipVertical(Graphics::Surface *s);
 
@@ -222,6 +222,13 @@ void OpenGLRenderer::positionCamera(const Math::Vector3d &pos, const Math::Vecto
 	glMultMatrixf(lookMatrix.getData());
 	glTranslatef(-pos.x(), -pos.y(), -pos.z());
 	glTranslatef(_shakeOffset.x, _shakeOffset.y, 0);
+
+	Math::Matrix4 projection, modelView;
+	glGetFloatv(GL_PROJECTION_MATRIX, projection.getData());
+	glGetFloatv(GL_MODELVIEW_MATRIX, modelView.getData());
+	projection.transpose();
+	modelView.transpose();
+	_frustum.setup(projection * modelView);
 }
 
 void OpenGLRenderer::renderSensorShoot(byte color, const Math::Vector3d sensor, const Math::Vector3d target, const Common::Rect viewArea) {
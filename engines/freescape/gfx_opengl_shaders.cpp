@@ -218,6 +218,7 @@ void OpenGLShaderRenderer::positionCamera(const Math::Vector3d &pos, const Math:
 	proj.transpose();
 	model.transpose();
 	_mvpMatrix = proj * model;
+	_frustum.setup(_mvpMatrix);
 	_mvpMatrix.transpose();
 }
 void OpenGLShaderRenderer::renderSensorShoot(byte color, const Math::Vector3d sensor, const Math::Vector3d target, const Common::Rect viewArea) {
@@ -168,6 +168,13 @@ void TinyGLRenderer::positionCamera(const Math::Vector3d &pos, const Math::Vecto
 	Math::Matrix4 lookMatrix = Math::makeLookAtMatrix(pos, interest, up_vec);
 	tglMultMatrixf(lookMatrix.getData());
 	tglTranslatef(-pos.x(), -pos.y(), -pos.z());
+
+	Math::Matrix4 projection, modelView;
+	tglGetFloatv(TGL_PROJECTION_MATRIX, projection.getData());
+	tglGetFloatv(TGL_MODELVIEW_MATRIX, modelView.getData());
+	projection.transpose();
+	modelView.transpose();
+	_frustum.setup(projection * modelView);
 }
 
 void TinyGLRenderer::renderSensorShoot(byte color, const Math::Vector3d sensor, const Math::Vector3d player, const Common::Rect viewArea) {
@@ -598,16 +605,7 @@ void TinyGLRenderer::drawFloor(uint8 color) {
 void TinyGLRenderer::flipBuffer() {
 	Common::List<Common::Rect> dirtyAreas;
 	TinyGL::presentBuffer(dirtyAreas);
-
-	Graphics::Surface glBuffer;
-	TinyGL::getSurfaceRef(glBuffer);
-
-	if (!dirtyAreas.empty()) {
-		for (auto &it : dirtyAreas) {
-			g_system->copyRectToScreen(glBuffer.getBasePtr(it.left, it.top), glBuffer.pitch,
-			                           it.left, it.top, it.width(), it.height());
-		}
-	}
+	TinyGL::copyToScreen(dirtyAreas);
 }
 
 Graphics::Surface *TinyGLRenderer::getScreenshot() {
@@ -145,6 +145,12 @@ private:
 	 */
 	const operandlist_t *fast_operandlist[0x80];
 
+	/**
+	 * Instructions in ROM, decoded the first time they were executed. ROM can't be written to,
+	 * so these never go stale; code in RAM, which may modify itself, is decoded every time.
+	 */
+	decodedinst_t *decode_cache;
+
 	/**@}*/
 
 	/**
@@ -551,6 +557,29 @@ public:
 	*/
 	void parse_operands(oparg_t *opargs, const operandlist_t *oplist);
 
+	/**
+	 * Read the operand modes of an instruction, starting at the operand mode list at addr, into
+	 * inst. Constants are read, and addresses computed, but nothing is loaded. Returns the
+	 * address of the next instruction.
+	 */
+	uint decode_operands(decodedinst_t *inst, uint addr);
+
+	/**
+	 * Load the operand values of a decoded instruction into args, as parse_operands() does.
+	 */
+	void load_operands(oparg_t *args, const decodedinst_t *inst);
+
+	/**
+	 * Return the decoded instruction at addr, which must be in ROM, decoding it if it isn't
+	 * in the cache yet.
+	 */
+	const decodedinst_t *decode_rom_instruction(uint addr);
+
+	/**
+	 * Free the cache of decoded instructions.
+	 */
+	void final_operands();
+
 	/**
 	 * Store a result value, according to the desttype and destaddress given. This is usually used to store
 	 * the result of an opcode, but it's also used by any code that pulls a call-stub off the stack.
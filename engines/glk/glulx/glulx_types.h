@@ -351,6 +351,37 @@ typedef oparg_struct oparg_t;
 
 #define MAX_OPERANDS (8)
 
+/**
+ * Where a load operand of a decoded instruction comes from.
+ */
+enum operandsource {
+	opsource_Const = 0,     ///< value is the operand itself
+	opsource_Pop = 1,       ///< popped off the stack
+	opsource_Memory = 2,    ///< value is an address in main memory
+	opsource_Locals = 3     ///< value is an address in the locals segment
+};
+
+/**
+ * An instruction whose opcode and operand modes have been decoded, so executing it again
+ * doesn't have to parse it. For load operands, source is one of the operandsource values;
+ * for store operands it is the desttype passed to store_operand().
+ */
+struct decodedinst_struct {
+	uint addr;                      ///< Address of the instruction, or 0 for an unused entry
+	uint opcode;
+	uint nextpc;                    ///< Address of the following instruction
+	const operandlist_t *oplist;
+	byte source[MAX_OPERANDS];
+	uint value[MAX_OPERANDS];
+};
+typedef decodedinst_struct decodedinst_t;
+
+/**
+ * Number of entries in the cache of decoded instructions. Instructions are cached by their
+ * address, so code in a loop shorter than this many bytes never evicts itself.
+ */
+#define DECODECACHE_SIZE (2048)
+
 typedef uint(Glulx::*acceleration_func)(uint argc, uint *argv);
 
 struct accelentry_struct {
@@ -66,6 +66,19 @@ static const operandlist_t list_LLSS = { 4, 4, &array_LLSS[0] };
 void Glulx::init_operands() {
 	for (int ix = 0; ix < 0x80; ix++)
 		fast_operandlist[ix] = lookup_operandlist(ix);
+
+	decode_cache = (decodedinst_t *)glulx_malloc(sizeof(decodedinst_t) * DECODECACHE_SIZE);
+	if (!decode_cache)
+		fatal_error("Unable to allocate instruction cache.");
+	for (int ix = 0; ix < DECODECACHE_SIZE; ix++)
+		decode_cache[ix].addr = 0;
+}
+
+void Glulx::final_operands() {
+	if (decode_cache) {
+		glulx_free(decode_cache);
+		decode_cache = nullptr;
+	}
 }
 
 const operandlist_t *Glulx::lookup_operandlist(uint opcode) {
@@ -280,21 +293,67 @@ const operandlist_t *Glulx::lookup_operandlist(uint opcode) {
 }
 
 void Glulx::parse_operands(oparg_t *args, const operandlist_t *oplist) {
+	decodedinst_t inst;
+
+	inst.oplist = oplist;
+	pc = decode_operands(&inst, pc);
+	load_operands(args, &inst);
+}
+
+const decodedinst_t *Glulx::decode_rom_instruction(uint addr) {
+	/* The header is at address 0, so no instruction is ever there. */
+	decodedinst_t *inst = &decode_cache[addr & (DECODECACHE_SIZE - 1)];
+	if (inst->addr == addr)
+		return inst;
+
+	uint opcode = Mem1(addr);
+	uint opaddr = addr + 1;
+	if (opcode & 0x80) {
+		/* More than one-byte opcode. */
+		if (opcode & 0x40) {
+			/* Four-byte opcode */
+			opcode = ((opcode & 0x3F) << 24) | (Mem1(opaddr) << 16) | (Mem1(opaddr + 1) << 8) | Mem1(opaddr + 2);
+			opaddr += 3;
+		} else {
+			/* Two-byte opcode */
+			opcode = ((opcode & 0x7F) << 8) | Mem1(opaddr);
+			opaddr++;
+		}
+	}
+
+	const operandlist_t *oplist;
+	if (opcode < 0x80)
+		oplist = fast_operandlist[opcode];
+	else
+		oplist = lookup_operandlist(opcode);
+
+	if (!oplist)
+		fatal_error_i("Encountered unknown opcode.", opcode);
+
+	/* Only mark the entry as used once it is complete, in case decoding fails. An
+	   instruction running past the end of ROM isn't cached at all. */
+	inst->addr = 0;
+	inst->opcode = opcode;
+	inst->oplist = oplist;
+	inst->nextpc = decode_operands(inst, opaddr);
+	if (inst->nextpc <= ramstart)
+		inst->addr = addr;
+	return inst;
+}
+
+uint Glulx::decode_operands(decodedinst_t *inst, uint addr) {
 	int ix;
-	oparg_t *curarg;
+	const operandlist_t *oplist = inst->oplist;
 	int numops = oplist->num_ops;
-	int argsize = oplist->arg_size;
-	uint modeaddr = pc;
+	uint modeaddr = addr;
 	int modeval = 0;
 
-	pc += (numops + 1) / 2;
+	addr += (numops + 1) / 2;
 
-	for (ix = 0, curarg = args; ix < numops; ix++, curarg++) {
+	for (ix = 0; ix < numops; ix++) {
 		int mode;
-		uint value;
-		uint addr;
-
-		curarg->desttype = 0;
+		uint value = 0;
+		int source = opsource_Const;
 
 		if ((ix & 1) == 0) {
 			modeval = Mem1(modeaddr);
@@ -304,215 +363,184 @@ void Glulx::parse_operands(oparg_t *args, const operandlist_t *oplist) {
 			modeaddr++;
 		}
 
-		if (oplist->formlist[ix] == modeform_Load) {
+		/* Both operand forms share the encoding of their addresses. */
+		switch (mode) {
+
+		case 15: /* main memory RAM, four-byte address */
+			value = Mem4(addr) + ramstart;
+			addr += 4;
+			source = opsource_Memory;
+			break;
+
+		case 14: /* main memory RAM, two-byte address */
+			value = (uint)Mem2(addr) + ramstart;
+			addr += 2;
+			source = opsource_Memory;
+			break;
+
+		case 13: /* main memory RAM, one-byte address */
+			value = (uint)(Mem1(addr)) + ramstart;
+			addr++;
+			source = opsource_Memory;
+			break;
+
+		case 7: /* main memory, four-byte address */
+			value = Mem4(addr);
+			addr += 4;
+			source = opsource_Memory;
+			break;
+
+		case 6: /* main memory, two-byte address */
+			value = (uint)Mem2(addr);
+			addr += 2;
+			source = opsource_Memory;
+			break;
+
+		case 5: /* main memory, one-byte address */
+			value = (uint)(Mem1(addr));
+			addr++;
+			source = opsource_Memory;
+			break;
+
+		case 11: /* locals, four-byte address */
+			value = Mem4(addr);
+			addr += 4;
+			source = opsource_Locals;
+			break;
+
+		case 10: /* locals, two-byte address */
+			value = (uint)Mem2(addr);
+			addr += 2;
+			source = opsource_Locals;
+			break;
+
+		case 9: /* locals, one-byte address */
+			value = (uint)(Mem1(addr));
+			addr++;
+			/* It's illegal for the address to not be four-byte aligned, or to be
+			   outside the locals segment, but we don't check this explicitly.
+			   A "strict mode" interpreter probably should. */
+			source = opsource_Locals;
+			break;
+
+		case 8: /* pop off stack, or push on stack */
+			source = opsource_Pop;
+			break;
+
+		case 0: /* constant zero, or discard value */
+			break;
+
+		case 1: /* one-byte constant */
+			/* Sign-extend from 8 bits to 32 */
+			value = (int)(signed char)(Mem1(addr));
+			addr++;
+			break;
+
+		case 2: /* two-byte constant */
+			/* Sign-extend the first byte from 8 bits to 32; the subsequent
+			   byte must not be sign-extended. */
+			value = (int)(signed char)(Mem1(addr));
+			value = (value << 8) | (uint)(Mem1(addr + 1));
+			addr += 2;
+			break;
+
+		case 3: /* four-byte constant */
+			/* Bytes must not be sign-extended. */
+			value = Mem4(addr);
+			addr += 4;
+			break;
+
+		default:
+			if (oplist->formlist[ix] == modeform_Load)
+				fatal_error("Unknown addressing mode in load operand.");
+			else
+				fatal_error("Unknown addressing mode in store operand.");
+		}
 
+		if (oplist->formlist[ix] == modeform_Store) {
+			/* Store operands keep the desttype for store_operand(). We don't add
+			   localsbase to their addresses; the store address for desttype 2 is
+			   relative to the current locals segment, not an absolute stack position. */
 			switch (mode) {
-
-			case 8: /* pop off stack */
-				if (stackptr < valstackbase + 4) {
-					fatal_error("Stack underflow in operand.");
-				}
-				stackptr -= 4;
-				value = Stk4(stackptr);
-				break;
-
-			case 0: /* constant zero */
-				value = 0;
-				break;
-
-			case 1: /* one-byte constant */
-				/* Sign-extend from 8 bits to 32 */
-				value = (int)(signed char)(Mem1(pc));
-				pc++;
-				break;
-
-			case 2: /* two-byte constant */
-				/* Sign-extend the first byte from 8 bits to 32; the subsequent
-				   byte must not be sign-extended. */
-				value = (int)(signed char)(Mem1(pc));
-				pc++;
-				value = (value << 8) | (uint)(Mem1(pc));
-				pc++;
-				break;
-
-			case 3: /* four-byte constant */
-				/* Bytes must not be sign-extended. */
-				value = Mem4(pc);
-				pc += 4;
+			case 0: /* discard value */
+				source = 0;
 				break;
-
-			case 15: /* main memory RAM, four-byte address */
-				addr = Mem4(pc);
-				addr += ramstart;
-				pc += 4;
-				goto MainMemAddr;
-
-			case 14: /* main memory RAM, two-byte address */
-				addr = (uint)Mem2(pc);
-				addr += ramstart;
-				pc += 2;
-				goto MainMemAddr;
-
-			case 13: /* main memory RAM, one-byte address */
-				addr = (uint)(Mem1(pc));
-				addr += ramstart;
-				pc++;
-				goto MainMemAddr;
-
-			case 7: /* main memory, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto MainMemAddr;
-
-			case 6: /* main memory, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto MainMemAddr;
-
-			case 5: /* main memory, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-MainMemAddr:
-				/* cases 5, 6, 7, 13, 14, 15 all wind up here. */
-				if (argsize == 4) {
-					value = Mem4(addr);
-				} else if (argsize == 2) {
-					value = Mem2(addr);
-				} else {
-					value = Mem1(addr);
-				}
+			case 8: /* push on stack */
+				source = 3;
 				break;
-
-			case 11: /* locals, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto LocalsAddr;
-
-			case 10: /* locals, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto LocalsAddr;
-
-			case 9: /* locals, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-LocalsAddr:
-				/* cases 9, 10, 11 all wind up here. It's illegal for addr to not
-				   be four-byte aligned, but we don't check this explicitly.
-				   A "strict mode" interpreter probably should. It's also illegal
-				   for addr to be less than zero or greater than the size of
-				   the locals segment. */
-				addr += localsbase;
-				if (argsize == 4) {
-					value = Stk4(addr);
-				} else if (argsize == 2) {
-					value = Stk2(addr);
-				} else {
-					value = Stk1(addr);
-				}
+			case 1:
+			case 2:
+			case 3:
+				fatal_error("Constant addressing mode in store operand.");
 				break;
-
 			default:
-				value = 0;
-				fatal_error("Unknown addressing mode in load operand.");
+				source = (source == opsource_Memory) ? 1 : 2;
+				break;
 			}
+		}
 
-			curarg->value = value;
-
-		} else { /* modeform_Store */
-			switch (mode) {
+		inst->source[ix] = source;
+		inst->value[ix] = value;
+	}
 
-			case 0: /* discard value */
-				curarg->desttype = 0;
-				curarg->value = 0;
-				break;
+	return addr;
+}
 
-			case 8: /* push on stack */
-				curarg->desttype = 3;
-				curarg->value = 0;
-				break;
+void Glulx::load_operands(oparg_t *args, const decodedinst_t *inst) {
+	int ix;
+	oparg_t *curarg;
+	const operandlist_t *oplist = inst->oplist;
+	int numops = oplist->num_ops;
+	int argsize = oplist->arg_size;
 
-			case 15: /* main memory RAM, four-byte address */
-				addr = Mem4(pc);
-				addr += ramstart;
-				pc += 4;
-				goto WrMainMemAddr;
-
-			case 14: /* main memory RAM, two-byte address */
-				addr = (uint)Mem2(pc);
-				addr += ramstart;
-				pc += 2;
-				goto WrMainMemAddr;
-
-			case 13: /* main memory RAM, one-byte address */
-				addr = (uint)(Mem1(pc));
-				addr += ramstart;
-				pc++;
-				goto WrMainMemAddr;
-
-			case 7: /* main memory, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto WrMainMemAddr;
-
-			case 6: /* main memory, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto WrMainMemAddr;
-
-			case 5: /* main memory, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-WrMainMemAddr:
-				/* cases 5, 6, 7 all wind up here. */
-				curarg->desttype = 1;
-				curarg->value = addr;
-				break;
+	for (ix = 0, curarg = args; ix < numops; ix++, curarg++) {
+		uint addr = inst->value[ix];
+		uint value;
 
-			case 11: /* locals, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto WrLocalsAddr;
-
-			case 10: /* locals, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto WrLocalsAddr;
-
-			case 9: /* locals, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-WrLocalsAddr:
-				/* cases 9, 10, 11 all wind up here. It's illegal for addr to not
-				   be four-byte aligned, but we don't check this explicitly.
-				   A "strict mode" interpreter probably should. It's also illegal
-				   for addr to be less than zero or greater than the size of
-				   the locals segment. */
-				curarg->desttype = 2;
-				/* We don't add localsbase here; the store address for desttype 2
-				   is relative to the current locals segment, not an absolute
-				   stack position. */
-				curarg->value = addr;
-				break;
+		if (oplist->formlist[ix] == modeform_Store) {
+			curarg->desttype = inst->source[ix];
+			curarg->value = addr;
+			continue;
+		}
 
-			case 1:
-			case 2:
-			case 3:
-				fatal_error("Constant addressing mode in store operand.");
-				break;
+		switch (inst->source[ix]) {
 
-			default:
-				fatal_error("Unknown addressing mode in store operand.");
+		case opsource_Pop:
+			if (stackptr < valstackbase + 4) {
+				fatal_error("Stack underflow in operand.");
+			}
+			stackptr -= 4;
+			value = Stk4(stackptr);
+			break;
+
+		case opsource_Memory:
+			if (argsize == 4) {
+				value = Mem4(addr);
+			} else if (argsize == 2) {
+				value = Mem2(addr);
+			} else {
+				value = Mem1(addr);
 			}
+			break;
+
+		case opsource_Locals:
+			addr += localsbase;
+			if (argsize == 4) {
+				value = Stk4(addr);
+			} else if (argsize == 2) {
+				value = Stk2(addr);
+			} else {
+				value = Stk1(addr);
+			}
+			break;
+
+		default: /* constant */
+			value = addr;
+			break;
 		}
+
+		curarg->desttype = 0;
+		curarg->value = value;
 	}
 }
 
@@ -132,6 +132,15 @@ public:
 	 * @returns         Width of string multiplied by GLI_SUBPIX
 	 */
 	size_t stringWidthUni(int fontIdx, const Common::U32String &text, int spw = 0);
+
+	/**
+	 * Get the width a character adds to a unicode string, as counted by stringWidthUni()
+	 * @param fontIdx   Which font to use
+	 * @param prevCh    Preceding character in the string, or 0 for the first one
+	 * @param ch        Character to get the width of
+	 * @returns         Width of character multiplied by GLI_SUBPIX
+	 */
+	int charWidthUni(int fontIdx, uint32 prevCh, uint32 ch);
 };
 
 } // End of namespace Glk
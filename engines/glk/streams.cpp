@@ -139,8 +139,14 @@ void WindowStream::putBuffer(const char *buf, size_t len) {
 		}
 	}
 
-	for (size_t lx = 0; lx < len; lx++, buf++)
-		_window->putCharUni(*buf);
+	// Characters are passed on as putCharUni() would get them, in chunks
+	uint32 chunk[256];
+	for (size_t lx = 0; lx < len; lx += ARRAYSIZE(chunk)) {
+		size_t count = MIN<size_t>(len - lx, ARRAYSIZE(chunk));
+		for (size_t cx = 0; cx < count; cx++)
+			chunk[cx] = buf[lx + cx];
+		_window->putBufferUni(chunk, count);
+	}
 	if (_window->_echoStream)
 		_window->_echoStream->putBuffer(buf, len);
 }
@@ -159,8 +165,7 @@ void WindowStream::putBufferUni(const uint32 *buf, size_t len) {
 		}
 	}
 
-	for (size_t lx = 0; lx < len; lx++, buf++)
-		_window->putCharUni(*buf);
+	_window->putBufferUni(buf, len);
 	if (_window->_echoStream)
 		_window->_echoStream->putBufferUni(buf, len);
 }
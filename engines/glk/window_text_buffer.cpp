@@ -37,14 +37,15 @@ namespace Glk {
 
 TextBufferWindow::TextBufferWindow(Windows *windows, uint rock) : TextWindow(windows, rock),
 		_font(g_conf->_propInfo), _historyPos(0), _historyFirst(0), _historyPresent(0),
-		_lastSeen(0), _scrollPos(0), _scrollMax(0), _scrollBack(SCROLLBACK), _width(-1), _height(-1),
+		_lastSeen(0), _scrollPos(0), _scrollMax(0), _scrollBack(SCROLLBACK_MAX), _width(-1), _height(-1),
 		_inBuf(nullptr), _lineTerminators(nullptr), _echoLineInput(true), _ladjw(0), _radjw(0),
-		_ladjn(0), _radjn(0), _numChars(0), _chars(nullptr), _attrs(nullptr), _spaced(0), _dashed(0),
-		_copyBuf(nullptr), _copyPos(0) {
+		_ladjn(0), _radjn(0), _numChars(0), _chars(nullptr), _attrs(nullptr), _lineWidthsValid(0),
+		_spaced(0), _dashed(0), _copyBuf(nullptr), _copyPos(0) {
 	_type = wintype_TextBuffer;
 	_history.resize(HISTORYLEN);
 
-	_lines.resize(SCROLLBACK);
+	_lines.reset(SCROLLBACK, SCROLLBACK_MAX - SCROLLBACK);
+	_lineWidths[0] = 0;
 	_chars = _lines[0]._chars;
 	_attrs = _lines[0]._attrs;
 
@@ -67,7 +68,8 @@ TextBufferWindow::~TextBufferWindow() {
 	delete[] _copyBuf;
 	delete[] _lineTerminators;
 
-	for (int i = 0; i < _scrollBack; i++) {
+	// Packed rows have no pictures
+	for (uint i = 0; i < _lines.ringSize(); i++) {
 		if (_lines[i]._lPic)
 			_lines[i]._lPic->decrement();
 		if (_lines[i]._rPic)
@@ -155,7 +157,9 @@ void TextBufferWindow::reflow() {
 
 	x = 0;
 	p = 0;
-	s = _scrollMax < SCROLLBACK ? _scrollMax : SCROLLBACK - 1;
+	// Only the rows of the ring are laid out again. Packed rows are older,
+	// and keep the layout they had
+	s = _lines.ringSize() - 1;
 
 	for (k = s; k >= 0; k--) {
 		if (k == 0 && _lineRequest)
@@ -196,7 +200,7 @@ void TextBufferWindow::reflow() {
 	offsetbuf[x] = -1;
 
 	// clear window
-	clear();
+	clearRows(true);
 
 	// and dump text back
 	x = 0;
@@ -210,7 +214,7 @@ void TextBufferWindow::reflow() {
 			x++;
 		}
 
-		putCharUni(charbuf[i]);
+		putChar(charbuf[i]);
 	}
 
 	// terribly sorry about this...
@@ -240,7 +244,10 @@ void TextBufferWindow::touchScroll() {
 	g_vm->_selection->clearSelection();
 	_windows->repaint(_bbox);
 
-	for (int i = 0; i < _scrollMax; i++)
+	// Lines scrolled out of view are only redrawn once they are scrolled back in, which
+	// touches them again. This keeps long scrollbacks from slowing down output
+	int lastLine = MIN(_scrollMax, _scrollPos + _height);
+	for (int i = 0; i < lastLine; i++)
 		_lines[i]._dirty = true;
 }
 
@@ -309,6 +316,8 @@ void TextBufferWindow::putText(const char *buf, int len, int pos, int oldlen) {
 	if (_numChars + diff >= TBLINELEN)
 		return;
 
+	_lineWidthsValid = MIN(_lineWidthsValid, pos);
+
 	if (diff != 0 && pos + oldlen < _numChars) {
 		memmove(_chars + pos + len,
 				_chars + pos + oldlen,
@@ -341,6 +350,8 @@ void TextBufferWindow::putTextUni(const uint32 *buf, int len, int pos, int oldle
 	if (_numChars + diff >= TBLINELEN)
 		return;
 
+	_lineWidthsValid = MIN(_lineWidthsValid, pos);
+
 	if (diff != 0 && pos + oldlen < _numChars) {
 		memmove(_chars + pos + len,
 				_chars + pos + oldlen,
@@ -380,6 +391,21 @@ uint TextBufferWindow::getSplit(uint size, bool vertical) const {
 }
 
 void TextBufferWindow::putCharUni(uint32 ch) {
+	gli_tts_speak(&ch, 1);
+	putChar(ch);
+	touch(0);
+}
+
+void TextBufferWindow::putBufferUni(const uint32 *buf, size_t len) {
+	gli_tts_speak(buf, len);
+
+	// The characters are laid out one by one, but the line is only touched once
+	for (size_t i = 0; i < len; ++i)
+		putChar(buf[i]);
+	touch(0);
+}
+
+void TextBufferWindow::putChar(uint32 ch) {
 	uint bchars[TBLINELEN];
 	Attributes battrs[TBLINELEN];
 	int pw;
@@ -389,8 +415,6 @@ void TextBufferWindow::putCharUni(uint32 ch) {
 	int linelen;
 	uint color;
 
-	gli_tts_speak(&ch, 1);
-
 	pw = (_bbox.right - _bbox.left - g_conf->_tMarginX * 2 - g_conf->_scrollWidth) * GLI_SUBPIX;
 	pw = pw - 2 * SLOP - _radjw - _ladjw;
 
@@ -471,13 +495,14 @@ void TextBufferWindow::putCharUni(uint32 ch) {
 				_spaced = 2;
 			else if (ch != ' ' && _spaced == 2) {
 				_spaced = 0;
-				putCharUni(' ');
+				putChar(' ');
 			} else {
 				_spaced = 0;
 			}
 		}
 	}
 
+	_lineWidthsValid = MIN(_lineWidthsValid, _numChars);
 	_chars[_numChars] = ch;
 	_attrs[_numChars] = _attr;
 	_numChars++;
@@ -489,7 +514,7 @@ void TextBufferWindow::putCharUni(uint32 ch) {
 			&& !_styles[_attrs[linelen - 1].style].reverse)
 		linelen--;
 
-	if (calcWidth(_chars, _attrs, 0, linelen, -1) >= pw) {
+	if (lineWidth(linelen) >= pw) {
 		bpoint = _numChars;
 
 		for (i = _numChars - 1; i > 0; i--) {
@@ -511,8 +536,6 @@ void TextBufferWindow::putCharUni(uint32 ch) {
 		memcpy(_attrs, battrs, saved * sizeof(Attributes));
 		_numChars = saved;
 	}
-
-	touch(0);
 }
 
 bool TextBufferWindow::unputCharUni(uint32 ch) {
@@ -526,6 +549,10 @@ bool TextBufferWindow::unputCharUni(uint32 ch) {
 }
 
 void TextBufferWindow::clear() {
+	clearRows(false);
+}
+
+void TextBufferWindow::clearRows(bool keepPacked) {
 	int i;
 
 	_attr.fgset = Windows::_overrideFgSet;
@@ -542,26 +569,29 @@ void TextBufferWindow::clear() {
 
 	_numChars = 0;
 
-	for (i = 0; i < _scrollBack; i++) {
-		_lines[i]._len = 0;
-
-		if (_lines[i]._lPic) _lines[i]._lPic->decrement();
-		_lines[i]._lPic = nullptr;
-		if (_lines[i]._rPic) _lines[i]._rPic->decrement();
-		_lines[i]._rPic = nullptr;
-
-		_lines[i]._lHyper = 0;
-		_lines[i]._rHyper = 0;
-		_lines[i]._lm = 0;
-		_lines[i]._rm = 0;
-		_lines[i]._newLine = 0;
-		_lines[i]._dirty = true;
-		_lines[i]._repaint = false;
+	for (i = 0; i < SCROLLBACK; i++) {
+		TextBufferRow &ln = _lines.ringRow(i);
+		ln._len = 0;
+
+		if (ln._lPic) ln._lPic->decrement();
+		ln._lPic = nullptr;
+		if (ln._rPic) ln._rPic->decrement();
+		ln._rPic = nullptr;
+
+		ln._lHyper = 0;
+		ln._rHyper = 0;
+		ln._lm = 0;
+		ln._rm = 0;
+		ln._newLine = 0;
+		ln._dirty = true;
+		ln._repaint = false;
 	}
 
+	_lines.clear(keepPacked);
+
 	_lastSeen = 0;
 	_scrollPos = 0;
-	_scrollMax = 0;
+	_scrollMax = _lines.size() - 1;
 
 	for (i = 0; i < _height; i++)
 		touch(i);
@@ -1086,8 +1116,9 @@ void TextBufferWindow::redraw() {
 	/*
 	 * draw the images
 	 */
-	for (i = 0; i < _scrollBack; i++) {
-		TextBufferRow ln(_lines[i]);
+	// Only rows of the ring have pictures, and those below the view can't reach into it
+	for (i = _scrollPos; i < (int)_lines.ringSize(); i++) {
+		const TextBufferRow &ln = _lines[i];
 
 		y = y0 + (_height - (i - _scrollPos) - 1) * _font._leading;
 
@@ -1530,9 +1561,11 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 	_lastSeen++;
 	_scrollMax++;
 
-	if (_scrollMax > _scrollBack - 1
-			|| _lastSeen > _scrollBack - 1)
-		scrollResize();
+	// Once the scrollback is full, its oldest lines are dropped
+	if (_scrollMax > _scrollBack - 1)
+		_scrollMax = _scrollBack - 1;
+	if (_lastSeen > _scrollBack - 1)
+		_lastSeen = _scrollBack - 1;
 
 	if (_lastSeen >= _height)
 		_scrollPos++;
@@ -1549,11 +1582,15 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 	_lines[0]._len = _numChars;
 	_lines[0]._newLine = forced;
 
-	for (int i = _scrollBack - 1; i > 0; i--) {
-		memcpy(&_lines[i], &_lines[i - 1], sizeof(TextBufferRow));
-		if (i < _height)
-			touch(i);
-	}
+	// The oldest row is reused for the new line
+	_lines.rotate();
+	_lines[0]._repaint = _lines[1]._repaint;
+	_chars = _lines[0]._chars;
+	_attrs = _lines[0]._attrs;
+	_lineWidthsValid = 0;
+
+	for (int i = 1; i < _height && i < SCROLLBACK; i++)
+		touch(i);
 
 	if (_radjn)
 		_radjn--;
@@ -1585,33 +1622,6 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 
 }
 
-void TextBufferWindow::scrollResize() {
-	int i;
-
-	_lines.clear();
-	_lines.resize(_scrollBack + SCROLLBACK);
-
-	_chars = _lines[0]._chars;
-	_attrs = _lines[0]._attrs;
-
-	for (i = _scrollBack; i < (_scrollBack + SCROLLBACK); i++) {
-		_lines[i]._dirty = false;
-		_lines[i]._repaint = false;
-		_lines[i]._lm = 0;
-		_lines[i]._rm = 0;
-		_lines[i]._lPic = nullptr;
-		_lines[i]._rPic = nullptr;
-		_lines[i]._lHyper = 0;
-		_lines[i]._rHyper = 0;
-		_lines[i]._len = 0;
-		_lines[i]._newLine = 0;
-		*(_lines[i]._chars) = 0;
-		_lines[i]._attrs->clear();
-	}
-
-	_scrollBack += SCROLLBACK;
-}
-
 int TextBufferWindow::calcWidth(const uint32 *chars, const Attributes *attrs, int startchar, int numChars, int spw) {
 	Screen &screen = *g_vm->_screen;
 	int w = 0;
@@ -1631,6 +1641,19 @@ int TextBufferWindow::calcWidth(const uint32 *chars, const Attributes *attrs, in
 	return w;
 }
 
+int TextBufferWindow::lineWidth(int numChars) {
+	Screen &screen = *g_vm->_screen;
+
+	for (int i = _lineWidthsValid; i < numChars; i++) {
+		// Kerning only applies within runs of the same attributes, which calcWidth() measures separately
+		uint32 prevCh = (i > 0 && _attrs[i - 1] == _attrs[i]) ? _chars[i - 1] : 0;
+		_lineWidths[i + 1] = _lineWidths[i] + screen.charWidthUni(_attrs[i].attrFont(_styles), prevCh, _chars[i]);
+	}
+
+	_lineWidthsValid = MAX(_lineWidthsValid, numChars);
+	return _lineWidths[numChars];
+}
+
 void TextBufferWindow::getSize(uint *width, uint *height) const {
 	if (width)
 		*width = (_bbox.width() - g_conf->_tMarginX * 2) / _font._cellW;
@@ -1651,4 +1674,120 @@ TextBufferWindow::TextBufferRow::TextBufferRow() : _len(0), _newLine(0), _dirty(
 	Common::fill(&_chars[0], &_chars[TBLINELEN], 0);
 }
 
+/*--------------------------------------------------------------------------*/
+
+TextBufferWindow::TextBufferRows::TextBufferRows() : _first(0), _count(1),
+		_packedMax(0), _packedStart(0), _packedCount(0), _nextUnpacked(0) {
+	_unpackedIdx[0] = _unpackedIdx[1] = 0;
+}
+
+void TextBufferWindow::TextBufferRows::reset(uint ringSize, uint packedSize) {
+	_rows.clear();
+	_rows.resize(ringSize);
+	_packedMax = packedSize;
+	clear(false);
+}
+
+void TextBufferWindow::TextBufferRows::clear(bool keepPacked) {
+	_count = 1;
+	if (!keepPacked) {
+		_packed.clear();
+		_packedStart = 0;
+		_packedCount = 0;
+	}
+
+	// Index 0 is always in the ring, so it marks the copies as unused
+	_unpackedIdx[0] = _unpackedIdx[1] = 0;
+}
+
+void TextBufferWindow::TextBufferRows::rotate() {
+	if (_count < _rows.size())
+		_count++;
+	else if (_packedMax)
+		pack(ringRow(_rows.size() - 1));
+
+	_first = (_first + _rows.size() - 1) % _rows.size();
+	_unpackedIdx[0] = _unpackedIdx[1] = 0;
+}
+
+void TextBufferWindow::TextBufferRows::pack(TextBufferRow &row) {
+	PackedRow *packed;
+	if (_packed.size() < _packedMax) {
+		_packed.push_back(PackedRow());
+		packed = &_packed.back();
+		_packedCount++;
+	} else {
+		// Replace the oldest one
+		packed = &_packed[_packedStart];
+		_packedStart = (_packedStart + 1) % _packed.size();
+	}
+
+	packed->_chars.resize(row._len);
+	packed->_runs.clear();
+	for (int i = 0; i < row._len; i++) {
+		packed->_chars[i] = row._chars[i];
+		if (i == 0 || row._attrs[i] != row._attrs[i - 1]) {
+			AttributeRun run;
+			run._start = i;
+			run._attrs = row._attrs[i];
+			packed->_runs.push_back(run);
+		}
+	}
+	packed->_newLine = row._newLine;
+	packed->_lm = row._lm;
+	packed->_rm = row._rm;
+
+	// Pictures aren't kept beyond the ring
+	if (row._lPic)
+		row._lPic->decrement();
+	row._lPic = nullptr;
+	if (row._rPic)
+		row._rPic->decrement();
+	row._rPic = nullptr;
+}
+
+TextBufferWindow::TextBufferRow &TextBufferWindow::TextBufferRows::unpack(uint idx) {
+	for (int i = 0; i < 2; i++) {
+		if (_unpackedIdx[i] == idx)
+			return _unpacked[i];
+	}
+
+	TextBufferRow &row = _unpacked[_nextUnpacked];
+	_unpackedIdx[_nextUnpacked] = idx;
+	_nextUnpacked ^= 1;
+
+	row._dirty = true;
+	row._repaint = false;
+	row._lPic = row._rPic = nullptr;
+	row._lHyper = row._rHyper = 0;
+
+	uint packedIdx = idx - _count;
+	if (packedIdx >= _packedCount) {
+		// Beyond the last row
+		row._len = 0;
+		row._newLine = 0;
+		row._lm = row._rm = 0;
+		return row;
+	}
+
+	// Packed rows are stored oldest first, while indexes count from the newest one
+	const PackedRow &packed = _packed[(_packedStart + _packedCount - 1 - packedIdx) % _packed.size()];
+	row._len = packed._chars.size();
+	row._newLine = packed._newLine;
+	row._lm = packed._lm;
+	row._rm = packed._rm;
+
+	Common::copy(packed._chars.begin(), packed._chars.end(), row._chars);
+	Common::fill(row._chars + row._len, row._chars + TBLINELEN, ' ');
+	for (uint r = 0; r < packed._runs.size(); r++) {
+		int end = (r + 1 < packed._runs.size()) ? packed._runs[r + 1]._start : row._len;
+		for (int i = packed._runs[r]._start; i < end; i++)
+			row._attrs[i] = packed._runs[r]._attrs;
+	}
+	for (int i = row._len; i < TBLINELEN; i++)
+		row._attrs[i].clear();
+
+	return row;
+}
+
 } // End of namespace Glk
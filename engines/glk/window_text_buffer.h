@@ -52,7 +52,86 @@ class TextBufferWindow : public TextWindow, Speech {
 		 */
 		TextBufferRow();
 	};
-	typedef Common::Array<TextBufferRow> TextBufferRows;
+
+	/**
+	 * The rows of the window, the newest one first. The newest rows are kept in a
+	 * ring, which is rotated when a line is scrolled in rather than moving every
+	 * row down. Rows leaving a full ring are packed, keeping only their text with
+	 * one set of attributes per run, and are unpacked again to be drawn.
+	 */
+	class TextBufferRows {
+	private:
+		struct AttributeRun {
+			int _start;
+			Attributes _attrs;
+		};
+
+		struct PackedRow {
+			Common::Array<uint32> _chars;
+			Common::Array<AttributeRun> _runs;
+			int _newLine;
+			int _lm, _rm;
+		};
+
+		Common::Array<TextBufferRow> _rows;
+		uint _first, _count;
+
+		Common::Array<PackedRow> _packed;   ///< oldest first, from _packedStart on
+		uint _packedMax, _packedStart, _packedCount;
+
+		TextBufferRow _unpacked[2];
+		uint _unpackedIdx[2];
+		uint _nextUnpacked;
+
+		void pack(TextBufferRow &row);
+		TextBufferRow &unpack(uint idx);
+	public:
+		TextBufferRows();
+
+		/**
+		 * Return a row. Changes to packed rows are not kept
+		 */
+		TextBufferRow &operator[](uint idx) {
+			if (idx < _count)
+				return _rows[(_first + idx) % _rows.size()];
+			return unpack(idx);
+		}
+
+		/**
+		 * Return a row of the ring, whether it is in use or not
+		 */
+		TextBufferRow &ringRow(uint idx) {
+			return _rows[(_first + idx) % _rows.size()];
+		}
+
+		/**
+		 * Get the number of rows in use, packed ones included
+		 */
+		uint size() const { return _count + _packedCount; }
+
+		/**
+		 * Get the number of rows in the ring which are in use
+		 */
+		uint ringSize() const { return _count; }
+
+		/**
+		 * Remove all the rows, and set the size of the ring and how many
+		 * rows beyond it are kept packed
+		 */
+		void reset(uint ringSize, uint packedSize);
+
+		/**
+		 * Only keep the first row of the ring in use. Packed rows are dropped
+		 * unless keepPacked is set
+		 */
+		void clear(bool keepPacked);
+
+		/**
+		 * Make the oldest row of the ring the first one, moving all the others
+		 * down. If the ring is full, the row is packed first
+		 */
+		void rotate();
+	};
 private:
 	PropFontInfo &_font;
 private:
@@ -88,9 +167,25 @@ private:
 	 */
 	void touch(int line);
 
+	/**
+	 * Add a character to the last line, breaking it if it gets too long
+	 */
+	void putChar(uint32 ch);
+
+	/**
+	 * Clear the window. Rows which have been packed are dropped unless keepPacked is set
+	 */
+	void clearRows(bool keepPacked);
+
 	void scrollOneLine(bool forced);
-	void scrollResize();
 	int calcWidth(const uint32 *chars, const Attributes *attrs, int startchar, int numchars, int spw);
+
+	/**
+	 * Return the width of the first characters of the last line, as calcWidth()
+	 * does. The widths are kept for as long as the characters don't change, so
+	 * that appending a character doesn't measure the whole line again.
+	 */
+	int lineWidth(int numChars);
 public:
 	int _width, _height;
 	int _spaced;
@@ -103,6 +198,9 @@ public:
 	uint32 *_chars;       ///< alias to lines[0].chars
 	Attributes *_attrs;   ///< alias to lines[0].attrs
 
+	int _lineWidths[TBLINELEN + 1];   ///< widths of the first chars of lines[0], for lineWidth()
+	int _lineWidthsValid;             ///< number of chars _lineWidths is up to date for
+
 	///< adjust margins temporarily for images
 	int _ladjw;
 	int _ladjn;
@@ -171,6 +269,11 @@ public:
 	 */
 	void putCharUni(uint32 ch) override;
 
+	/**
+	 * Write a buffer of unicode characters
+	 */
+	void putBufferUni(const uint32 *buf, size_t len) override;
+
 	/**
 	 * Unput a unicode character
 	 */
@@ -40,6 +40,7 @@ class PairWindow;
 
 #define HISTORYLEN 100
 #define SCROLLBACK 512
+#define SCROLLBACK_MAX 10000
 #define TBLINELEN 300
 #define GLI_SUBPIX 8
 
@@ -478,6 +479,14 @@ public:
 	 */
 	virtual void putCharUni(uint32 ch) {}
 
+	/**
+	 * Write a buffer of unicode characters
+	 */
+	virtual void putBufferUni(const uint32 *buf, size_t len) {
+		for (size_t i = 0; i < len; ++i)
+			putCharUni(buf[i]);
+	}
+
 	/**
 	 * Unput a unicode character
 	 */
@@ -184,14 +184,29 @@ void Processor::screen_new_line() {
 }
 
 void Processor::screen_word(const zchar *s) {
+	uint32 run[TEXT_BUFFER_SIZE];
 	zchar c;
 	while ((c = *s++) != 0) {
 		if (c == ZC_NEW_FONT)
 			s++;
 		else if (c == ZC_NEW_STYLE)
 			s++;
-		else
+		else {
 			screen_char(c);
+
+			// Once the first character has set up the window, the plain characters
+			// following it in the lower window are written to it in one go
+			if (h_version != V6 && _wp.currWin() == _wp._lower && _wp._lower._currFont != GRAPHICS_FONT) {
+				uint len = 0;
+				while ((c = s[len]) != 0 && c != ZC_RETURN && c != ZC_NEW_FONT && c != ZC_NEW_STYLE)
+					run[len++] = c;
+
+				if (len > 0) {
+					glk_put_buffer_uni(run, len);
+					s += len;
+				}
+			}
+		}
 	}
 }
 
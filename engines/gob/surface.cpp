@@ -345,6 +345,56 @@ bool Surface::clipBlitRect(int16 &left, int16 &top, int16 &right, int16 &bottom,
 	return true;
 }
 
+/** Copy a row of pixels, skipping over runs of the transparent color. */
+template<typename T>
+static void blitRowTransparent(T *dst, const T *src, uint16 width, T transp) {
+	const T *srcEnd = src + width;
+
+	while (src < srcEnd) {
+		while ((src < srcEnd) && (*src == transp)) {
+			src++;
+			dst++;
+		}
+
+		const T *run = src;
+		while ((src < srcEnd) && (*src != transp))
+			src++;
+
+		memmove(dst, run, (src - run) * sizeof(T));
+		dst += src - run;
+	}
+}
+
+/** Copy a row of pixels mirrored, leaving out the transparent color. */
+template<typename T>
+static void blitRowTransparentReflected(T *dst, const T *src, uint16 width, T transp, bool keyed) {
+	src += width - 1;
+
+	for (uint16 i = 0; i < width; i++, dst++, src--)
+		if (!keyed || (*src != transp))
+			*dst = *src;
+}
+
+template<typename T>
+static void blitTransparent(byte *dst, const byte *src, uint16 width, uint16 height,
+		uint32 dstPitch, uint32 srcPitch, uint32 transp, bool yAxisReflection) {
+
+	// A transparent color the pixels can't hold never matches
+	const bool keyed = transp <= (T)~0;
+
+	while (height-- > 0) {
+		if (yAxisReflection)
+			blitRowTransparentReflected<T>((T *)dst, (const T *)src, width, (T)transp, keyed);
+		else if (keyed)
+			blitRowTransparent<T>((T *)dst, (const T *)src, width, (T)transp);
+		else
+			memmove(dst, src, width * sizeof(T));
+
+		dst += dstPitch;
+		src += srcPitch;
+	}
+}
+
 void Surface::blit(const Surface &from, int16 left, int16 top, int16 right, int16 bottom,
 		int16 x, int16 y, int32 transp, bool yAxisReflection) {
 
@@ -391,31 +441,21 @@ void Surface::blit(const Surface &from, int16 left, int16 top, int16 right, int1
 		return;
 	}
 
-	// Otherwise, we have to copy by pixel
+	// Otherwise, we have to copy the runs of opaque pixels
 
 	// Pointers to the blit destination and source start points
-	     Pixel dst =      get(x   , y);
-	ConstPixel src = from.get(left, top);
+	      byte *dst =      getData(x   , y);
+	const byte *src = from.getData(left, top);
 
-	while (height-- > 0) {
-		     Pixel dstRow = dst;
-		ConstPixel srcRow = src;
-
-		if (yAxisReflection) {
-			srcRow += width - 1;
-			for (uint16 i = 0; i < width; i++, ++dstRow, --srcRow)
-				if (srcRow.get() != ((uint32) transp))
-					dstRow.set(srcRow.get());
-		}
-		else {
-			for (uint16 i = 0; i < width; i++, ++dstRow, ++srcRow)
-				if (srcRow.get() != ((uint32) transp))
-					dstRow.set(srcRow.get());
-		}
+	const uint32 dstPitch =      _width *      _bpp;
+	const uint32 srcPitch = from._width * from._bpp;
 
-		dst +=      _width;
-		src += from._width;
-	}
+	if (_bpp == 1)
+		blitTransparent<uint8 >(dst, src, width, height, dstPitch, srcPitch, transp, yAxisReflection);
+	else if (_bpp == 2)
+		blitTransparent<uint16>(dst, src, width, height, dstPitch, srcPitch, transp, yAxisReflection);
+	else if (_bpp == 4)
+		blitTransparent<uint32>(dst, src, width, height, dstPitch, srcPitch, transp, yAxisReflection);
 }
 
 void Surface::blit(const Surface &from, int16 x, int16 y, int32 transp) {
@@ -447,7 +447,44 @@ void Video::dirtyRectsAdd(int16 left, int16 top, int16 right, int16 bottom) {
 	if (_dirtyAll)
 		return;
 
-	_dirtyRects.push_back(Common::Rect(left, top, right + 1, bottom + 1));
+	Common::Rect rect(left, top, right + 1, bottom + 1);
+	if (rect.isEmpty())
+		return;
+
+	// Drop rectangles covered by others and merge overlapping ones, as long as
+	// the merged one isn't larger than both together, so that no area is
+	// blitted to the screen more than once
+	Common::List<Common::Rect>::iterator it = _dirtyRects.begin();
+	while (it != _dirtyRects.end()) {
+		if (it->contains(rect))
+			return;
+
+		if (rect.contains(*it)) {
+			it = _dirtyRects.erase(it);
+			continue;
+		}
+
+		if (rect.intersects(*it)) {
+			Common::Rect merged(rect);
+			merged.extend(*it);
+
+			if (merged.width() * merged.height() <= rect.width() * rect.height() + it->width() * it->height()) {
+				rect = merged;
+				_dirtyRects.erase(it);
+				it = _dirtyRects.begin();
+				continue;
+			}
+		}
+
+		++it;
+	}
+
+	if (_dirtyRects.size() >= kMaxDirtyRects) {
+		dirtyRectsAll();
+		return;
+	}
+
+	_dirtyRects.push_back(rect);
 }
 
 void Video::dirtyRectsApply(int left, int top, int width, int height, int x, int y) {
@@ -155,6 +155,9 @@ public:
 	virtual ~Video();
 
 protected:
+	/** Number of dirty rectangles beyond which the whole screen is redrawn. */
+	static const uint kMaxDirtyRects = 64;
+
 	bool _dirtyAll;
 	Common::List<Common::Rect> _dirtyRects;
 
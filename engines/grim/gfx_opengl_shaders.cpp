@@ -121,6 +121,7 @@ struct EMIModelUserData {
 	uint32 _colorMapVBO;
 	uint32 _verticesVBO;
 	uint32 _normalsVBO;
+	uint32 _indicesEBO;
 };
 
 struct ModelUserData {
@@ -1076,9 +1077,9 @@ void GfxOpenGLS::drawEMIModelFace(const EMIModel* model, const EMIMeshFace* face
 	actorShader->setUniform("useVertexAlpha", _selectedTexture->_hasAlpha);
 	actorShader->setUniform1f("meshAlpha", (model->_meshAlphaMode == Actor::AlphaReplace) ? model->_meshAlpha : 1.0f);
 
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, face->_indicesEBO);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mud->_indicesEBO);
 
-	glDrawElements(GL_TRIANGLES, 3 * face->_faceLength, GL_UNSIGNED_SHORT, nullptr);
+	glDrawElements(GL_TRIANGLES, 3 * face->_faceLength, GL_UNSIGNED_SHORT, (void *)(uintptr)face->_indicesOffset);
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
@@ -1444,11 +1445,23 @@ void GfxOpenGLS::drawBitmap(const Bitmap *bitmap, int dx, int dy, uint32 layer)
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _quadEBO);
 		assert(layer < data->_numLayers);
 		uint32 offset = data->_layers[layer]._offset;
-		for (uint32 i = offset; i < offset + data->_layers[layer]._numImages; ++i) {
-			glBindTexture(GL_TEXTURE_2D, textures[data->_verts[i]._texid]);
+		uint32 end = offset + data->_layers[layer]._numImages;
+		for (uint32 i = offset; i < end;) {
+			uint32 texId = data->_verts[i]._texid;
+			glBindTexture(GL_TEXTURE_2D, textures[texId]);
+
+			// Tiles which sample the same texture and follow each other in the
+			// vertex buffer are drawn with a single call, in their original order
+			uint32 startPos = data->_verts[i]._pos;
+			uint32 endPos = startPos + data->_verts[i]._verts;
+			for (++i; i < end; ++i) {
+				if (data->_verts[i]._texid != texId || data->_verts[i]._pos != endPos)
+					break;
+				endPos += data->_verts[i]._verts;
+			}
 
-			unsigned short startVertex = data->_verts[i]._pos / 4 * 6;
-			unsigned short numVertices = data->_verts[i]._verts / 4 * 6;
+			uint32 startVertex = startPos / 4 * 6;
+			uint32 numVertices = (endPos - startPos) / 4 * 6;
 			glDrawElements(GL_TRIANGLES, numVertices, GL_UNSIGNED_SHORT, (void *)(startVertex * sizeof(unsigned short)));
 		}
 		return;
@@ -2113,20 +2126,29 @@ void GfxOpenGLS::createEMIModel(EMIModel *model) {
 	actorShader->enableVertexAttribute("color", mud->_colorMapVBO, 4, GL_UNSIGNED_BYTE, GL_TRUE, 4 * sizeof(byte), 0);
 	mud->_shaderLights = actorShader;
 
+	// All faces share a single index buffer, each face drawing its own range of it
+	uint32 numIndices = 0;
+	for (uint32 i = 0; i < model->_numFaces; ++i)
+		numIndices += model->_faces[i]._faceLength * 3;
+
+	uint16 *indices = new uint16[numIndices];
+	uint32 offset = 0;
 	for (uint32 i = 0; i < model->_numFaces; ++i) {
-		EMIMeshFace * face = &model->_faces[i];
-		face->_indicesEBO = OpenGL::Shader::createBuffer(GL_ELEMENT_ARRAY_BUFFER, face->_faceLength * 3 * sizeof(uint16), face->_indexes, GL_STATIC_DRAW);
+		EMIMeshFace *face = &model->_faces[i];
+		uint32 faceIndices = face->_faceLength * 3;
+		memcpy(indices + offset, face->_indexes, faceIndices * sizeof(uint16));
+		face->_indicesOffset = offset * sizeof(uint16);
+		offset += faceIndices;
 	}
+	mud->_indicesEBO = OpenGL::Shader::createBuffer(GL_ELEMENT_ARRAY_BUFFER, numIndices * sizeof(uint16), indices, GL_STATIC_DRAW);
+	delete[] indices;
 
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
 void GfxOpenGLS::destroyEMIModel(EMIModel *model) {
-	for (uint32 i = 0; i < model->_numFaces; ++i) {
-		EMIMeshFace *face = &model->_faces[i];
-		OpenGL::Shader::freeBuffer(face->_indicesEBO);
-		face->_indicesEBO = 0;
-	}
+	for (uint32 i = 0; i < model->_numFaces; ++i)
+		model->_faces[i]._indicesOffset = 0;
 
 	EMIModelUserData *mud = static_cast<EMIModelUserData *>(model->_userData);
 
@@ -2135,6 +2157,7 @@ void GfxOpenGLS::destroyEMIModel(EMIModel *model) {
 		OpenGL::Shader::freeBuffer(mud->_normalsVBO);
 		OpenGL::Shader::freeBuffer(mud->_texCoordsVBO);
 		OpenGL::Shader::freeBuffer(mud->_colorMapVBO);
+		OpenGL::Shader::freeBuffer(mud->_indicesEBO);
 
 		delete mud->_shader;
 		delete mud;
@@ -183,16 +183,7 @@ void GfxTinyGL::flipBuffer(bool opportunistic) {
 
 	Common::List<Common::Rect> dirtyAreas;
 	TinyGL::presentBuffer(dirtyAreas);
-
-	Graphics::Surface glBuffer;
-	TinyGL::getSurfaceRef(glBuffer);
-
-	if (!dirtyAreas.empty()) {
-		for (Common::List<Common::Rect>::iterator itRect = dirtyAreas.begin(); itRect != dirtyAreas.end(); ++itRect) {
-			g_system->copyRectToScreen(glBuffer.getBasePtr((*itRect).left, (*itRect).top), glBuffer.pitch,
-			                           (*itRect).left, (*itRect).top, (*itRect).width(), (*itRect).height());
-		}
-	}
+	TinyGL::copyToScreen(dirtyAreas);
 
 	g_system->updateScreen();
 }
@@ -990,10 +981,12 @@ void GfxTinyGL::drawBitmap(const Bitmap *bitmap, int x, int y, uint32 layer) {
 		if (bitmap->getHasTransparency()) {
 			tglEnable(TGL_BLEND);
 			tglBlendFunc(TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA);
-		}
-		tglBlit(b[num], x, y);
-		if (bitmap->getHasTransparency()) {
+			tglBlit(b[num], x, y);
 			tglDisable(TGL_BLEND);
+		} else {
+			// Backgrounds without a color keyed pixel are copied row by row,
+			// regardless of the blend function left behind by earlier draws
+			tglBlitFast(b[num], x, y);
 		}
 	} else {
 		tglBlitZBuffer(b[num], x, y);
@@ -1052,6 +1052,7 @@ void GrimEngine::mainLoop() {
 			setMode(mode);
 		}
 
+		g_resourceloader->update();
 		g_sound->flushTracks();
 		if (g_imuse) {
 			g_imuse->refreshScripts();
@@ -1557,6 +1558,10 @@ void GrimEngine::setSet(Set *scene) {
 	Set *lastSet = _currSet;
 	_currSet = scene;
 	_currSet->setSoundParameters(20, 127);
+
+	// Files prefetched for the previous set are most likely not needed anymore
+	g_resourceloader->clearPrefetched();
+	_currSet->prefetchBackgrounds();
 	// should delete the old scene after setting the new one
 	if (lastSet && !lastSet->_locked) {
 		delete lastSet;
@@ -230,6 +230,7 @@ void clearList(Common::List<T> &list) {
 }
 
 ResourceLoader::~ResourceLoader() {
+	clearPrefetched();
 	for (Common::Array<ResourceCache>::iterator i = _cache.begin(); i != _cache.end(); ++i) {
 		ResourceCache &r = *i;
 		delete[] r.fname;
@@ -287,27 +288,120 @@ Common::SeekableReadStream *ResourceLoader::openNewStreamFile(const Common::Stri
 	Common::Path path(fname, '/');
 	path.toLowercase();
 
+	uint32 size;
 	if (cache) {
 		s = getFileFromCache(path);
 		if (!s) {
-			s = loadFile(path);
-			if (!s)
-				return nullptr;
-
-			uint32 size = s->size();
-			byte *buf = new byte[size];
-			s->read(buf, size);
+			byte *buf = takePrefetched(path, size);
+			if (!buf) {
+				s = loadFile(path);
+				if (!s)
+					return nullptr;
+
+				size = s->size();
+				buf = new byte[size];
+				s->read(buf, size);
+				delete s;
+			}
 			putIntoCache(path, buf, size);
-			delete s;
 			s = new Common::MemoryReadStream(buf, size);
 		}
 	} else {
-		s = loadFile(path);
+		byte *buf = takePrefetched(path, size);
+		if (buf)
+			s = new Common::MemoryReadStream(buf, size, DisposeAfterUse::YES);
+		else
+			s = loadFile(path);
 	}
 	// This will only have an effect if the stream is actually compressed.
 	return Common::wrapCompressedReadStream(s);
 }
 
+void ResourceLoader::prefetch(const Common::String &fname, Common::ResourceLoader::Priority priority) {
+	Common::Path path(fname, '/');
+	path.toLowercase();
+	Common::String key(path.toString('/'));
+
+	if (_prefetched.contains(key) || getEntryFromCache(path))
+		return;
+
+	if (_prefetchRequests.contains(key)) {
+		_loader.setPriority(_prefetchRequests[key], priority);
+		return;
+	}
+
+	Common::ResourceLoader::Request request(path, priority, prefetchLoaded, this);
+	request.open = openPrefetch;
+	request.decode = decompressPrefetch;
+	_prefetchRequests[key] = _loader.load(request);
+}
+
+void ResourceLoader::clearPrefetched() {
+	_loader.cancelAll();
+	_loader.update();
+
+	for (Common::HashMap<Common::String, PrefetchedFile>::iterator i = _prefetched.begin(); i != _prefetched.end(); ++i)
+		delete[] i->_value.data;
+	_prefetched.clear();
+}
+
+void ResourceLoader::update() {
+	_loader.update();
+}
+
+byte *ResourceLoader::takePrefetched(const Common::Path &filename, uint32 &len) const {
+	Common::String key(filename.toString('/'));
+
+	if (_prefetchRequests.contains(key))
+		_loader.wait(_prefetchRequests[key]);
+
+	Common::HashMap<Common::String, PrefetchedFile>::iterator i = _prefetched.find(key);
+	if (i == _prefetched.end())
+		return nullptr;
+
+	byte *data = i->_value.data;
+	len = i->_value.len;
+	_prefetched.erase(i);
+	return data;
+}
+
+Common::SeekableReadStream *ResourceLoader::openPrefetch(const Common::Path &path, void *refCon) {
+	return ((ResourceLoader *)refCon)->loadFile(path);
+}
+
+void ResourceLoader::decompressPrefetch(Common::ResourceLoader::Result &result, void *refCon) {
+	// Inflate compressed files on the worker, openNewStreamFile() passes
+	// the data through as is then
+	Common::SeekableReadStream *raw = new Common::MemoryReadStream(result.data, result.size);
+	Common::SeekableReadStream *s = Common::wrapCompressedReadStream(raw);
+	if (s != raw && s->size() >= 0) {
+		uint32 size = s->size();
+		byte *buf = new byte[size];
+		if (s->read(buf, size) == size) {
+			delete[] result.data;
+			result.data = buf;
+			result.size = size;
+		} else {
+			delete[] buf;
+		}
+	}
+	delete s;
+}
+
+void ResourceLoader::prefetchLoaded(Common::ResourceLoader::Result &result, void *refCon) {
+	ResourceLoader *loader = (ResourceLoader *)refCon;
+	Common::String key(result.path.toString('/'));
+	loader->_prefetchRequests.erase(key);
+
+	if (result.status == Common::ResourceLoader::kStatusLoaded) {
+		PrefetchedFile file;
+		file.data = result.data;
+		file.len = result.size;
+		loader->_prefetched[key] = file;
+		result.data = nullptr;
+	}
+}
+
 void ResourceLoader::putIntoCache(const Common::Path &fname, byte *res, uint32 len) const {
 	Common::String sFilename(fname.toString('/'));
 
@@ -24,6 +24,8 @@
 
 #include "common/archive.h"
 #include "common/array.h"
+#include "common/hashmap.h"
+#include "common/resource_loader.h"
 
 #include "engines/grim/object.h"
 
@@ -74,6 +76,16 @@ public:
 	Overlay *loadOverlay(const Common::String &filename);
 	Common::SeekableReadStream *openNewStreamFile(const Common::String &fname, bool cache = false) const;
 
+	/**
+	 * Start reading a file in the background. The next openNewStreamFile()
+	 * for it returns the prefetched data.
+	 */
+	void prefetch(const Common::String &fname, Common::ResourceLoader::Priority priority);
+	/** Cancel pending prefetches and drop the prefetched files nobody opened. */
+	void clearPrefetched();
+	/** Read prefetched files. Called once per frame. */
+	void update();
+
 	ModelPtr getModel(const Common::String &fname, CMap *c);
 	CMapPtr getColormap(const Common::String &fname);
 	KeyframeAnimPtr getKeyframe(const Common::String &fname);
@@ -99,6 +111,11 @@ private:
 	ResourceLoader::ResourceCache *getEntryFromCache(const Common::Path &filename) const;
 	void putIntoCache(const Common::Path &fname, byte *res, uint32 len) const;
 	void uncache(const Common::Path &fname) const;
+	byte *takePrefetched(const Common::Path &filename, uint32 &len) const;
+
+	static Common::SeekableReadStream *openPrefetch(const Common::Path &path, void *refCon);
+	static void decompressPrefetch(Common::ResourceLoader::Result &result, void *refCon);
+	static void prefetchLoaded(Common::ResourceLoader::Result &result, void *refCon);
 
 	mutable Common::Array<ResourceCache> _cache;
 	mutable bool _cacheDirty;
@@ -110,6 +127,15 @@ private:
 	Common::List<KeyframeAnim *> _keyframeAnims;
 	Common::List<LipSync *> _lipsyncs;
 	Common::List<AnimationEmi *> _emiAnims;
+
+	struct PrefetchedFile {
+		byte *data;
+		uint32 len;
+	};
+
+	mutable Common::HashMap<Common::String, Common::ResourceLoader::RequestId> _prefetchRequests;
+	mutable Common::HashMap<Common::String, PrefetchedFile> _prefetched;
+	mutable Common::ResourceLoader _loader;
 };
 
 extern ResourceLoader *g_resourceloader;
@@ -878,6 +878,21 @@ Bitmap::Ptr Set::loadBackground(const char *fileName) {
 	return bg;
 }
 
+static void prefetchBitmap(Bitmap *bitmap, Common::ResourceLoader::Priority priority) {
+	// Bitmaps are only loaded once they are drawn
+	if (bitmap && !bitmap->_data->_loaded)
+		g_resourceloader->prefetch(bitmap->getFilename(), priority);
+}
+
+void Set::prefetchBackgrounds() const {
+	for (int i = 0; i < _numSetups; ++i) {
+		const Common::ResourceLoader::Priority priority = (&_setups[i] == _currSetup) ?
+			Common::ResourceLoader::kPriorityNow : Common::ResourceLoader::kPrioritySpeculative;
+		prefetchBitmap(_setups[i]._bkgndBm, priority);
+		prefetchBitmap(_setups[i]._bkgndZBm, priority);
+	}
+}
+
 void Set::drawBackground() const {
 	if (_currSetup->_bkgndZBm) // Some screens have no zbuffer mask (eg, Alley)
 		_currSetup->_bkgndZBm->draw();
@@ -63,6 +63,11 @@ public:
 
 	static Bitmap::Ptr loadBackground(const char *fileName);
 	void drawBackground() const;
+	/**
+	 * Read the backgrounds of the setups in the background, the one of the
+	 * current setup first.
+	 */
+	void prefetchBackgrounds() const;
 	void drawBitmaps(ObjectState::Position stage);
 	void setupCamera();
 
@@ -260,6 +260,7 @@ void cGame::GameInit(LowLevelGameSetup *apGameSetup, cSetupVarContainer &aVars)
 
 	// Create the logic timer.
 	mpLogicTimer = mpSystem->CreateLogicTimer(aVars.GetInt("LogicUpdateRate", 800));
+	mpLogicTimer->SetMaxUpdateTime(aVars.GetInt("LogicMaxUpdateTime", 100));
 
 	// Init some standard script funcs
 	Log(" Initializing script functions\n");
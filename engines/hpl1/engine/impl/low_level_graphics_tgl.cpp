@@ -761,11 +761,9 @@ void LowLevelGraphicsTGL::FlushRendering() {
 }
 void LowLevelGraphicsTGL::SwapBuffers() {
 	tglFlush();
-	TinyGL::presentBuffer();
-	Graphics::Surface glBuffer;
-	TinyGL::getSurfaceRef(glBuffer);
-	g_system->copyRectToScreen(glBuffer.getPixels(), glBuffer.pitch,
-							   0, 0, glBuffer.w, glBuffer.h);
+	Common::List<Common::Rect> dirtyAreas;
+	TinyGL::presentBuffer(dirtyAreas);
+	TinyGL::copyToScreen(dirtyAreas);
 	g_system->updateScreen();
 }
 
@@ -0,0 +1,180 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "hpl1/engine/impl/occlusion_query_tgl.h"
+
+#ifdef USE_TINYGL
+
+#include "common/util.h"
+#include "graphics/tinygl/tinygl.h"
+
+#include <math.h>
+
+namespace hpl {
+
+OcclusionQueryTGL *OcclusionQueryTGL::mpActiveQuery = nullptr;
+
+//////////////////////////////////////////////////////////////////////////
+// CONSTRUCTORS
+//////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------
+
+OcclusionQueryTGL::OcclusionQueryTGL() {
+	mfNearestDepth = 1.0f;
+	mbEmpty = true;
+	mbDepthTest = true;
+	mbCoversViewport = false;
+	mlSampleCount = 0;
+}
+
+//-----------------------------------------------------------------------
+
+OcclusionQueryTGL::~OcclusionQueryTGL() {
+	if (mpActiveQuery == this)
+		mpActiveQuery = nullptr;
+}
+
+//-----------------------------------------------------------------------
+
+//////////////////////////////////////////////////////////////////////////
+// PUBLIC METHODS
+//////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------
+
+void OcclusionQueryTGL::Begin() {
+	// The matrices are column major, mvp = projection * modelview
+	float vProjection[16], vModelView[16];
+	tglGetFloatv(TGL_PROJECTION_MATRIX, vProjection);
+	tglGetFloatv(TGL_MODELVIEW_MATRIX, vModelView);
+	for (int lCol = 0; lCol < 4; ++lCol) {
+		for (int lRow = 0; lRow < 4; ++lRow) {
+			float fSum = 0;
+			for (int k = 0; k < 4; ++k)
+				fSum += vProjection[k * 4 + lRow] * vModelView[lCol * 4 + k];
+			mvMVP[lCol * 4 + lRow] = fSum;
+		}
+	}
+
+	TGLint lDepthTest = 0, lDepthFunc = 0;
+	tglGetIntegerv(TGL_DEPTH_TEST, &lDepthTest);
+	tglGetIntegerv(TGL_DEPTH_FUNC, &lDepthFunc);
+	mbDepthTest = lDepthTest && lDepthFunc != TGL_ALWAYS;
+
+	// The viewport is bottom up, while the framebuffer rows are top down
+	TGLint vViewport[4];
+	tglGetIntegerv(TGL_VIEWPORT, vViewport);
+	Graphics::Surface surface;
+	TinyGL::getSurfaceRef(surface);
+	mViewport = Common::Rect(vViewport[0], surface.h - vViewport[1] - vViewport[3],
+							 vViewport[0] + vViewport[2], surface.h - vViewport[1]);
+
+	mfNearestDepth = 1.0f;
+	mbEmpty = true;
+	mbCoversViewport = false;
+	mpActiveQuery = this;
+}
+
+//-----------------------------------------------------------------------
+
+void OcclusionQueryTGL::End() {
+	if (mpActiveQuery == this)
+		mpActiveQuery = nullptr;
+}
+
+//-----------------------------------------------------------------------
+
+bool OcclusionQueryTGL::FetchResults() {
+	// Queries are fetched after the frame was presented, so the depth buffer
+	// holds the whole scene the queried geometry was drawn into.
+	if (mbEmpty) {
+		mlSampleCount = 0;
+	} else {
+		Common::Rect rect = mbCoversViewport ? mViewport : mRect;
+		rect.clip(mViewport);
+		float fDepth = mbDepthTest ? mfNearestDepth : -1.0f;
+		mlSampleCount = TinyGL::countDepthSamplesPassed(rect, fDepth);
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------
+
+void OcclusionQueryTGL::AddPositions(const float *apPositions, int alStride, int alCount) {
+	if (mpActiveQuery == nullptr)
+		return;
+
+	for (int i = 0; i < alCount; ++i)
+		mpActiveQuery->AddPosition(apPositions + i * alStride);
+}
+
+//-----------------------------------------------------------------------
+
+//////////////////////////////////////////////////////////////////////////
+// PRIVATE METHODS
+//////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------
+
+void OcclusionQueryTGL::AddPosition(const float *apPos) {
+	if (mbCoversViewport)
+		return;
+
+	float vClip[4];
+	for (int lRow = 0; lRow < 4; ++lRow) {
+		vClip[lRow] = mvMVP[lRow] * apPos[0] + mvMVP[4 + lRow] * apPos[1] +
+					  mvMVP[8 + lRow] * apPos[2] + mvMVP[12 + lRow] * apPos[3];
+	}
+
+	// Geometry reaching behind the eye has no meaningful screen bounds,
+	// test it against the whole viewport at the nearest depth instead.
+	if (vClip[3] <= 0) {
+		mbCoversViewport = true;
+		mbEmpty = false;
+		mfNearestDepth = -1.0f;
+		return;
+	}
+
+	float fInvW = 1.0f / vClip[3];
+	float fX = mViewport.left + (vClip[0] * fInvW + 1.0f) * 0.5f * mViewport.width();
+	float fY = mViewport.top + (1.0f - vClip[1] * fInvW) * 0.5f * mViewport.height();
+	float fZ = vClip[2] * fInvW;
+
+	// Keep far off-screen points within range of the 16-bit rectangle
+	int lX = (int)floor(CLIP<float>(fX, mViewport.left - 1, mViewport.right));
+	int lY = (int)floor(CLIP<float>(fY, mViewport.top - 1, mViewport.bottom));
+	Common::Rect rect(lX, lY, lX + 1, lY + 1);
+	if (mbEmpty) {
+		mRect = rect;
+		mfNearestDepth = fZ;
+		mbEmpty = false;
+	} else {
+		mRect.extend(rect);
+		mfNearestDepth = MIN(mfNearestDepth, fZ);
+	}
+}
+
+//-----------------------------------------------------------------------
+
+} // namespace hpl
+
+#endif // USE_TINYGL
@@ -22,6 +22,7 @@
 #ifndef HPL_OCCLUSION_QUERY_TGL_H
 #define HPL_OCCLUSION_QUERY_TGL_H
 
+#include "common/rect.h"
 #include "common/scummsys.h"
 #include "hpl1/engine/graphics/OcclusionQuery.h"
 
@@ -29,15 +30,40 @@
 
 namespace hpl {
 
+/**
+ * TinyGL has no hardware queries, so the geometry drawn between Begin() and End()
+ * is reduced to its screen bounds and nearest depth. Once the frame has been
+ * presented, the sample count is the number of depth buffer pixels within those
+ * bounds that the nearest point would pass.
+ */
 class OcclusionQueryTGL : public iOcclusionQuery {
 public:
-	OcclusionQueryTGL() {}
-	~OcclusionQueryTGL() {}
+	OcclusionQueryTGL();
+	~OcclusionQueryTGL();
+
+	void Begin() override;
+	void End() override;
+	bool FetchResults() override;
+	unsigned int GetSampleCount() override { return mlSampleCount; }
+
+	/**
+	 * Called by the vertex buffers when they are drawn, adds the positions to the active query if any.
+	 */
+	static void AddPositions(const float *apPositions, int alStride, int alCount);
+
+private:
+	void AddPosition(const float *apPos);
+
+	static OcclusionQueryTGL *mpActiveQuery;
 
-	void Begin() override {}
-	void End() override {}
-	bool FetchResults() override { return true; }
-	unsigned int GetSampleCount() override { return 0; }
+	float mvMVP[16];
+	Common::Rect mViewport;
+	Common::Rect mRect;
+	float mfNearestDepth;
+	bool mbEmpty;
+	bool mbDepthTest;
+	bool mbCoversViewport;
+	unsigned int mlSampleCount;
 };
 
 } // namespace hpl
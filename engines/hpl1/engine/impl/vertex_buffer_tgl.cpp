@@ -20,6 +20,7 @@
  */
 
 #include "hpl1/engine/impl/vertex_buffer_tgl.h"
+#include "hpl1/engine/impl/occlusion_query_tgl.h"
 #include "hpl1/engine/math/Math.h"
 #include "hpl1/engine/system/low_level_system.h"
 
@@ -227,6 +228,7 @@ void VertexBufferTGL::Draw(eVertexBufferDrawType aDrawType) {
 	if (mlElementNum < 0)
 		lSize = GetIndexNum();
 
+	OcclusionQueryTGL::AddPositions(GetArray(eVertexFlag_Position), kvVertexElements[cMath::Log2ToInt(eVertexFlag_Position)], GetVertexNum());
 	tglDrawElements(mode, lSize, TGL_UNSIGNED_INT, &mvIndexArray[0]);
 }
 
@@ -244,6 +246,7 @@ void VertexBufferTGL::DrawIndices(unsigned int *apIndices, int alCount,
 
 	//////////////////////////////////
 	// Bind and draw the buffer
+	OcclusionQueryTGL::AddPositions(GetArray(eVertexFlag_Position), kvVertexElements[cMath::Log2ToInt(eVertexFlag_Position)], GetVertexNum());
 	tglDrawElements(mode, alCount, TGL_UNSIGNED_INT, apIndices);
 }
 
@@ -40,6 +40,10 @@ cLogicTimer::cLogicTimer(int alUpdatesPerSec, LowLevelSystem *apLowLevelSystem)
 	mlMaxUpdates = alUpdatesPerSec;
 	mlUpdateCount = 0;
 
+	mlMaxUpdateTime = 0;
+	mlUpdateLoopStart = 0;
+	mbUpdateTimeExceeded = false;
+
 	mpLowLevelSystem = apLowLevelSystem;
 
 	SetUpdatesPerSec(alUpdatesPerSec);
@@ -68,7 +72,15 @@ bool cLogicTimer::WantUpdate() {
 	if (mlUpdateCount > mlMaxUpdates)
 		return false;
 
-	if (mlLocalTime < (double)GetApplicationTime()) {
+	unsigned long lTime = GetApplicationTime();
+	if (mlUpdateCount == 1) {
+		mlUpdateLoopStart = lTime;
+	} else if (mlMaxUpdateTime > 0 && lTime - mlUpdateLoopStart >= (unsigned long)mlMaxUpdateTime) {
+		mbUpdateTimeExceeded = true;
+		return false;
+	}
+
+	if (mlLocalTime < (double)lTime) {
 		Update();
 		return true;
 	}
@@ -78,11 +90,12 @@ bool cLogicTimer::WantUpdate() {
 //-----------------------------------------------------------------------
 
 void cLogicTimer::EndUpdateLoop() {
-	if (mlUpdateCount > mlMaxUpdates) {
+	if (mlUpdateCount > mlMaxUpdates || mbUpdateTimeExceeded) {
 		Reset();
 	}
 
 	mlUpdateCount = 0;
+	mbUpdateTimeExceeded = false;
 }
 
 //-----------------------------------------------------------------------
@@ -100,6 +113,12 @@ void cLogicTimer::SetMaxUpdates(int alMax) {
 
 //-----------------------------------------------------------------------
 
+void cLogicTimer::SetMaxUpdateTime(int alMaxTime) {
+	mlMaxUpdateTime = alMaxTime;
+}
+
+//-----------------------------------------------------------------------
+
 int cLogicTimer::GetUpdatesPerSec() {
 	return (int)(1000.0 / ((double)mlLocalTimeAdd));
 }
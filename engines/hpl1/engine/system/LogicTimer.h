@@ -70,6 +70,14 @@ public:
 	 */
 	void SetMaxUpdates(int alMax);
 
+	/**
+	 * Sets the maximum time in milliseconds spent on updates in a row.
+	 * When logic falls behind, a frame is drawn once this is reached and the
+	 * time is reset, instead of catching up with every missed update. 0 disables it.
+	 * \param alMaxTime
+	 */
+	void SetMaxUpdateTime(int alMaxTime);
+
 	/**
 	 * Get the number of updates per second.
 	 */
@@ -88,6 +96,10 @@ private:
 	int mlMaxUpdates;
 	int mlUpdateCount;
 
+	int mlMaxUpdateTime;
+	unsigned long mlUpdateLoopStart;
+	bool mbUpdateTimeExceeded;
+
 	LowLevelSystem *mpLowLevelSystem;
 };
 
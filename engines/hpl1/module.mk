@@ -382,6 +382,7 @@ MODULE_OBJS := \
 ifdef USE_TINYGL
 MODULE_OBJS += \
 	engine/impl/low_level_graphics_tgl.o \
+	engine/impl/occlusion_query_tgl.o \
 	engine/impl/texture_tgl.o \
 	engine/impl/vertex_buffer_tgl.o
 endif
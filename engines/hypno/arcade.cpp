@@ -21,6 +21,7 @@
 
 #include "common/tokenizer.h"
 #include "common/events.h"
+#include "common/jobs.h"
 #include "graphics/cursorman.h"
 #include "graphics/framelimiter.h"
 
@@ -31,6 +32,17 @@ namespace Hypno {
 
 extern int parse_arc(const char *);
 
+struct MaskFrame {
+	MVideo *video;
+	const Graphics::Surface *frame;
+};
+
+// Decode the next frame of the mask video, while the background is decoded
+static void decodeMaskFrame(void *refCon) {
+	MaskFrame *mask = (MaskFrame *)refCon;
+	mask->frame = mask->video->decoder->decodeNextFrame();
+}
+
 void HypnoEngine::splitArcadeFile(const Common::String &filename, Common::String &arc, Common::String &list) {
 	debugC(1, kHypnoDebugParser, "Splitting %s", filename.c_str());
 	Common::File file;
@@ -259,7 +271,8 @@ void HypnoEngine::runArcade(ArcadeShooting *arc) {
 	int firstFrame = segments[_segmentIdx].start;
 	if (firstFrame > 1) {
 		_background->decoder->forceSeekToFrame(firstFrame);
-		_masks->decoder->forceSeekToFrame(firstFrame);
+		if (_masks)
+			_masks->decoder->forceSeekToFrame(firstFrame);
 		segments[_segmentIdx].start = 1;
 	}
 
@@ -289,6 +302,8 @@ void HypnoEngine::runArcade(ArcadeShooting *arc) {
 	Graphics::FrameLimiter limiter(g_system, 1000.0 / arc->frameDelay);
 	limiter.startFrame();
 
+	Common::JobSystem *jobSystem = g_system->getJobSystem();
+
 	Common::Event event;
 	while (!shouldQuit()) {
 		if (_timerStarted) {
@@ -366,9 +381,20 @@ void HypnoEngine::runArcade(ArcadeShooting *arc) {
 			getPlayerPosition(true);
 			if (_background->decoder->getCurFrame() > firstFrame)
 				drawScreen();
+
+			// The hit tests only read the mask after both frames are done
+			Common::JobGroup maskGroup;
+			MaskFrame maskFrame = { _masks, nullptr };
+			const bool updateMask = _masks && _masks->decoder->needsUpdate();
+			if (updateMask)
+				jobSystem->submit(decodeMaskFrame, &maskFrame, &maskGroup);
+
 			updateScreen(*_background);
-			if (!arc->maskVideo.empty() && _masks->decoder->needsUpdate())
-				_mask = _masks->decoder->decodeNextFrame();
+
+			if (updateMask) {
+				jobSystem->wait(maskGroup);
+				_mask = maskFrame.frame;
+			}
 			if (_additionalVideo && _additionalVideo->decoder->needsUpdate())
 				_additionalVideo->decoder->decodeNextFrame(); // only audio?
 		}
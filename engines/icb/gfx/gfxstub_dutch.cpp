@@ -27,8 +27,11 @@
 #include "engines/icb/common/px_common.h"
 #include "engines/icb/gfx/gfxstub_dutch.h"
 #include "engines/icb/gfx/gfxstub_rev_dutch.h"
+#include "engines/icb/gfx/gfxstub_simd.h"
 
 #include "common/endian.h"
+#include "common/jobs.h"
+#include "common/system.h"
 
 namespace ICB {
 
@@ -175,9 +178,175 @@ TextureHandle *RegisterTexture(const RevTexture *revInput) {
 
 void ClearProcessorState() { return; }
 
+// Polygons taller than this have their spans drawn by several threads
+#define MIN_THREADED_SPAN_ROWS 32
+
+// Texels are fetched into a small buffer, and then modulated together
+#define TEXEL_CHUNK 64
+
+typedef struct {
+	int32 topy;
+	uint16 z;
+	uint32 colour;
+	SpanColour flatColour;
+	const uint8 *texture;
+	const uint32 *palette;
+	int32 bpp;
+	int32 mipw, miph;
+	const SimdProcs *procs;
+} SpanDrawState;
+
+static void initSpanDrawState(SpanDrawState &state, int32 topy, uint16 z) {
+	state.topy = topy;
+	state.z = z;
+	state.colour = 0;
+	state.flatColour.a = state.flatColour.r = state.flatColour.g = state.flatColour.b = 0;
+	state.flatColour.dr = state.flatColour.dg = state.flatColour.db = 0;
+	state.texture = (const uint8 *)myTexHan.pRGBA[mip_map_level];
+	state.palette = myTexHan.palette;
+	state.bpp = myTexHan.bpp;
+	state.mipw = myTexHan.w >> mip_map_level;
+	state.miph = myTexHan.h >> mip_map_level;
+	state.procs = &getSimdProcs();
+}
+
+static void drawSpans(Common::JobRangeProc proc, int32 topy, int32 bottomy, SpanDrawState &state) {
+	// The rows of the spans don't overlap, so bands of them can be drawn at once
+	g_system->getJobSystem()->parallelFor(bottomy - topy, proc, &state, MIN_THREADED_SPAN_ROWS);
+}
+
+static inline char *rgbPointer(int32 x, int32 y) { return myRenDev.pRGB + (myRenDev.RGBPitch * y) + myRenDev.RGBBytesPerPixel * x; }
+
+static inline uint16 *zPointer(int32 x, int32 y) { return (uint16 *)(myRenDev.pZ + (myRenDev.ZPitch * y) + myRenDev.ZBytesPerPixel * x); }
+
+static inline uint32 fetchTexel(const SpanDrawState &state, int32 u, int32 v) {
+	int32 pu = (u >> (8 + mip_map_level));
+	int32 pv = (v >> (8 + mip_map_level));
+
+	if (pu < 0)
+		pu = 0;
+	if (pu >= state.mipw)
+		pu = state.mipw - 1;
+
+	if (pv < 0)
+		pv = 0;
+	if (pv >= state.miph)
+		pv = state.miph - 1;
+
+	const uint8 *texel = state.texture + (pu + (pv * state.mipw)) * state.bpp;
+
+	// RGB data
+	if (state.bpp > 3)
+		return READ_LE_UINT32(texel);
+
+	// Palette data
+	return state.palette[*texel];
+}
+
+// Draw the textured span of a row, modulated by colour
+static void drawTexturedSpan(const SpanDrawState &state, const span_t *pspan, int32 y, SpanColour &colour) {
+	int32 count = pspan->x1 - pspan->x0;
+	int32 u = (pspan->u0 << 8);
+	int32 v = (pspan->v0 << 8);
+	int32 iuslope = ((pspan->u1 << 8) - u) / count;
+	int32 ivslope = ((pspan->v1 << 8) - v) / count;
+
+	uint8 *left = (uint8 *)rgbPointer(pspan->x0, y);
+	uint16 *zleft = zPointer(pspan->x0, y);
+	uint32 texels[TEXEL_CHUNK];
+	while (count > 0) {
+		int32 n = MIN<int32>(count, TEXEL_CHUNK);
+		for (int32 k = 0; k < n; k++) {
+			texels[k] = fetchTexel(state, u, v);
+			u += iuslope;
+			v += ivslope;
+		}
+
+		state.procs->modulateSpan(left, zleft, texels, n, colour, state.z);
+		left += n * myRenDev.RGBBytesPerPixel;
+		zleft += n;
+		colour.r += n * colour.dr;
+		colour.g += n * colour.dg;
+		colour.b += n * colour.db;
+		count -= n;
+	}
+}
+
+static void drawGouraudTexturedSpans(uint begin, uint end, void *refCon) {
+	const SpanDrawState &state = *(const SpanDrawState *)refCon;
+
+	for (uint n = begin; n < end; n++) {
+		const span_t *pspan = spans + n;
+		int32 count = pspan->x1 - pspan->x0;
+		if (count <= 0)
+			continue;
+
+		SpanColour colour;
+		colour.a = pspan->a0 << 8;
+		colour.r = pspan->r0 << 8;
+		colour.g = pspan->g0 << 8;
+		colour.b = pspan->b0 << 8;
+		colour.dr = ((pspan->r1 << 8) - colour.r) / count;
+		colour.dg = ((pspan->g1 << 8) - colour.g) / count;
+		colour.db = ((pspan->b1 << 8) - colour.b) / count;
+		drawTexturedSpan(state, pspan, state.topy + n, colour);
+	}
+}
+
+static void drawFlatTexturedSpans(uint begin, uint end, void *refCon) {
+	const SpanDrawState &state = *(const SpanDrawState *)refCon;
+
+	for (uint n = begin; n < end; n++) {
+		const span_t *pspan = spans + n;
+		if (pspan->x1 - pspan->x0 <= 0)
+			continue;
+
+		SpanColour colour = state.flatColour;
+		drawTexturedSpan(state, pspan, state.topy + n, colour);
+	}
+}
+
+static void drawFlatUnTexturedSpans(uint begin, uint end, void *refCon) {
+	const SpanDrawState &state = *(const SpanDrawState *)refCon;
+
+	for (uint n = begin; n < end; n++) {
+		const span_t *pspan = spans + n;
+		int32 count = pspan->x1 - pspan->x0;
+		if (count <= 0)
+			continue;
+
+		int32 y = state.topy + n;
+		state.procs->flatSpan((uint8 *)rgbPointer(pspan->x0, y), zPointer(pspan->x0, y), count, state.colour, state.z);
+	}
+}
+
+static void drawGouraudUnTexturedSpans(uint begin, uint end, void *refCon) {
+	const SpanDrawState &state = *(const SpanDrawState *)refCon;
+
+	for (uint n = begin; n < end; n++) {
+		const span_t *pspan = spans + n;
+		int32 count = pspan->x1 - pspan->x0;
+		if (count <= 0)
+			continue;
+
+		// The alpha stays the same along the span
+		SpanColour colour;
+		colour.a = pspan->a0 << 8;
+		colour.r = pspan->r0 << 8;
+		colour.g = pspan->g0 << 8;
+		colour.b = pspan->b0 << 8;
+		colour.dr = ((pspan->r1 << 8) - colour.r) / count;
+		colour.dg = ((pspan->g1 << 8) - colour.g) / count;
+		colour.db = ((pspan->b1 << 8) - colour.b) / count;
+
+		int32 y = state.topy + n;
+		state.procs->gouraudSpan((uint8 *)rgbPointer(pspan->x0, y), zPointer(pspan->x0, y), count, colour, state.z);
+	}
+}
+
 int32 DrawGouraudTexturedPolygon(const vertex2D *verts, int32 nVerts, uint16 z) {
 	int32 i, j, topvert, bottomvert, leftvert, rightvert, nextvert;
-	int32 itopy, ibottomy, spantopy, spanbottomy, count;
+	int32 itopy, ibottomy, spantopy, spanbottomy;
 	int32 x, a, r, g, b, u, v;
 	int32 ixslope, iaslope, irslope, igslope, ibslope, iuslope, ivslope;
 	float topy, bottomy, height, width, prestep;
@@ -351,113 +520,15 @@ int32 DrawGouraudTexturedPolygon(const vertex2D *verts, int32 nVerts, uint16 z)
 	} while (rightvert != bottomvert);
 
 	// Draw the spans
-	pspan = spans;
-
-	int32 mipw = myTexHan.w >> mip_map_level;
-	int32 miph = myTexHan.h >> mip_map_level;
-
-	for (i = itopy; i < ibottomy; i++) {
-		count = pspan->x1 - pspan->x0;
-		if (count > 0) {
-			x = pspan->x0;
-			u = (pspan->u0 << 8);
-			v = (pspan->v0 << 8);
-			a = pspan->a0 << 8;
-			r = pspan->r0 << 8;
-			g = pspan->g0 << 8;
-			b = pspan->b0 << 8;
-
-			iuslope = ((pspan->u1 << 8) - u) / count;
-			ivslope = ((pspan->v1 << 8) - v) / count;
-			iaslope = ((pspan->a1 << 8) - a) / count;
-			irslope = ((pspan->r1 << 8) - r) / count;
-			igslope = ((pspan->g1 << 8) - g) / count;
-			ibslope = ((pspan->b1 << 8) - b) / count;
-
-			char *left = myRenDev.pRGB + (myRenDev.RGBPitch * i) + myRenDev.RGBBytesPerPixel * x;
-			char *zleft = myRenDev.pZ + (myRenDev.ZPitch * i) + myRenDev.ZBytesPerPixel * pspan->x0;
-			do {
-				int32 pu = (u >> (8 + mip_map_level));
-				int32 pv = (v >> (8 + mip_map_level));
-
-				if (pu < 0)
-					pu = 0;
-				if (pu >= mipw)
-					pu = mipw - 1;
-
-				if (pv < 0)
-					pv = 0;
-				if (pv >= miph)
-					pv = miph - 1;
-
-				uint32 toff = (pu + (pv * mipw)) * myTexHan.bpp;
-				uint8 *texel = ((uint8 *)(myTexHan.pRGBA[mip_map_level])) + toff;
-
-				// RGB data
-				int32 ta, tr, tg, tb;
-				if (myTexHan.bpp > 3) {
-					ta = *(texel + 3);
-					tr = *(texel + 2);
-					tg = *(texel + 1);
-					tb = *(texel + 0);
-				} else {
-					// Palette data
-					uint8 index = *texel;
-					uint32 colour = myTexHan.palette[index];
-					ta = ((colour >> 24) & 0xFF);
-					tr = ((colour >> 16) & 0xFF);
-					tg = ((colour >> 8) & 0xFF);
-					tb = ((colour >> 0) & 0xFF);
-				}
-
-				// BGR : 128 = scale of 1.0
-				int32 pr = ((r >> 8) * tr);
-				int32 pg = ((g >> 8) * tg);
-				int32 pb = ((b >> 8) * tb);
-
-				if (pr < 0)
-					pr = 0;
-				if (pg < 0)
-					pg = 0;
-				if (pb < 0)
-					pb = 0;
-
-				pr = pr >> 7;
-				pg = pg >> 7;
-				pb = pb >> 7;
-
-				if (pr > 255)
-					pr = 255;
-				if (pg > 255)
-					pg = 255;
-				if (pb > 255)
-					pb = 255;
-
-				*(left + 0) = (char)pb;
-				*(left + 1) = (char)pg;
-				*(left + 2) = (char)pr;
-				*(left + 3) = (char)ta; // use the texture alpha value
-				*(uint16 *)(zleft + 0) = z;
-
-				left += myRenDev.RGBBytesPerPixel;
-				zleft += myRenDev.ZBytesPerPixel;
-				x++;
-				u += iuslope;
-				v += ivslope;
-				r += irslope;
-				g += igslope;
-				b += ibslope;
-				count--;
-			} while (count > 0);
-		}
-		pspan++;
-	}
+	SpanDrawState state;
+	initSpanDrawState(state, itopy, z);
+	drawSpans(drawGouraudTexturedSpans, itopy, ibottomy, state);
 	return 1;
 }
 
 int32 DrawFlatUnTexturedPolygon(const vertex2D *verts, int32 nVerts, uint16 z) {
 	int32 i, j, topvert, bottomvert, leftvert, rightvert, nextvert;
-	int32 itopy, ibottomy, ixslope, spantopy, spanbottomy, x, count;
+	int32 itopy, ibottomy, ixslope, spantopy, spanbottomy, x;
 	float topy, bottomy, xslope, height, width, prestep;
 	float y;
 	span_t *pspan;
@@ -572,32 +643,16 @@ int32 DrawFlatUnTexturedPolygon(const vertex2D *verts, int32 nVerts, uint16 z) {
 	} while (rightvert != bottomvert);
 
 	// Draw the spans
-	pspan = spans;
-
-	for (i = itopy; i < ibottomy; i++) {
-		count = pspan->x1 - pspan->x0;
-		if (count > 0) {
-			char *left = myRenDev.pRGB + (myRenDev.RGBPitch * i) + myRenDev.RGBBytesPerPixel * pspan->x0;
-			char *zleft = myRenDev.pZ + (myRenDev.ZPitch * i) + myRenDev.ZBytesPerPixel * pspan->x0;
-			do {
-				*(left + 0) = b0;
-				*(left + 1) = g0;
-				*(left + 2) = r0;
-				*(left + 3) = a0;
-				left += myRenDev.RGBBytesPerPixel;
-				*(uint16 *)(zleft + 0) = z;
-				zleft += myRenDev.ZBytesPerPixel;
-				count--;
-			} while (count > 0);
-		}
-		pspan++;
-	}
+	SpanDrawState state;
+	initSpanDrawState(state, itopy, z);
+	state.colour = ((uint32)a0 << 24) | ((uint32)r0 << 16) | ((uint32)g0 << 8) | b0;
+	drawSpans(drawFlatUnTexturedSpans, itopy, ibottomy, state);
 	return 1;
 }
 
 int32 DrawGouraudUnTexturedPolygon(const vertex2D *verts, int32 nVerts, uint16 z) {
 	int32 i, j, topvert, bottomvert, leftvert, rightvert, nextvert;
-	int32 itopy, ibottomy, spantopy, spanbottomy, count;
+	int32 itopy, ibottomy, spantopy, spanbottomy;
 	int32 ixslope, iaslope, irslope, igslope, ibslope;
 	int32 x, a, r, g, b;
 	float topy, bottomy, xslope, aslope, rslope, gslope, bslope;
@@ -748,45 +803,15 @@ int32 DrawGouraudUnTexturedPolygon(const vertex2D *verts, int32 nVerts, uint16 z
 	} while (rightvert != bottomvert);
 
 	// Draw the spans
-	pspan = spans;
-
-	for (i = itopy; i < ibottomy; i++) {
-		count = pspan->x1 - pspan->x0;
-		if (count > 0) {
-			x = pspan->x0;
-			a = pspan->a0 << 8;
-			r = pspan->r0 << 8;
-			g = pspan->g0 << 8;
-			b = pspan->b0 << 8;
-			iaslope = ((pspan->a1 << 8) - a) / count;
-			irslope = ((pspan->r1 << 8) - r) / count;
-			igslope = ((pspan->g1 << 8) - g) / count;
-			ibslope = ((pspan->b1 << 8) - b) / count;
-			char *left = myRenDev.pRGB + (myRenDev.RGBPitch * i) + myRenDev.RGBBytesPerPixel * x;
-			char *zleft = myRenDev.pZ + (myRenDev.ZPitch * i) + myRenDev.ZBytesPerPixel * pspan->x0;
-			do {
-				*(left + 0) = (char)(b >> 8);
-				*(left + 1) = (char)(g >> 8);
-				*(left + 2) = (char)(r >> 8);
-				*(left + 3) = (char)(a >> 8);
-				*(uint16 *)(zleft + 0) = z;
-				zleft += myRenDev.ZBytesPerPixel;
-				left += myRenDev.RGBBytesPerPixel;
-				x++;
-				r += irslope;
-				g += igslope;
-				b += ibslope;
-				count--;
-			} while (count > 0);
-		}
-		pspan++;
-	}
+	SpanDrawState state;
+	initSpanDrawState(state, itopy, z);
+	drawSpans(drawGouraudUnTexturedSpans, itopy, ibottomy, state);
 	return 1;
 }
 
 int32 DrawFlatTexturedPolygon(const vertex2D *verts, int32 nVerts, uint16 z) {
 	int32 i, j, topvert, bottomvert, leftvert, rightvert, nextvert;
-	int32 itopy, ibottomy, spantopy, spanbottomy, count;
+	int32 itopy, ibottomy, spantopy, spanbottomy;
 	int32 x, u, v;
 	int32 ixslope, iuslope, ivslope;
 	float topy, bottomy, height, width, prestep;
@@ -924,100 +949,12 @@ int32 DrawFlatTexturedPolygon(const vertex2D *verts, int32 nVerts, uint16 z) {
 	} while (rightvert != bottomvert);
 
 	// Draw the spans
-	pspan = spans;
-
-	int32 mipw = myTexHan.w >> mip_map_level;
-	int32 miph = myTexHan.h >> mip_map_level;
-
-	for (i = itopy; i < ibottomy; i++) {
-		count = pspan->x1 - pspan->x0;
-		if (count > 0) {
-			x = pspan->x0;
-			u = (pspan->u0 << 8);
-			v = (pspan->v0 << 8);
-
-			iuslope = ((pspan->u1 << 8) - u) / count;
-			ivslope = ((pspan->v1 << 8) - v) / count;
-
-			char *left = myRenDev.pRGB + (myRenDev.RGBPitch * i) + myRenDev.RGBBytesPerPixel * x;
-			char *zleft = myRenDev.pZ + (myRenDev.ZPitch * i) + myRenDev.ZBytesPerPixel * pspan->x0;
-			do {
-				int32 pu = (u >> (8 + mip_map_level));
-				int32 pv = (v >> (8 + mip_map_level));
-
-				if (pu < 0)
-					pu = 0;
-				if (pu >= mipw)
-					pu = mipw - 1;
-
-				if (pv < 0)
-					pv = 0;
-				if (pv >= miph)
-					pv = miph - 1;
-
-				uint32 toff = (pu + (pv * mipw)) * myTexHan.bpp;
-				uint8 *texel = ((uint8 *)(myTexHan.pRGBA[mip_map_level])) + toff;
-
-				// RGB data
-				int32 ta, tr, tg, tb;
-				if (myTexHan.bpp > 3) {
-					ta = *(texel + 3);
-					tr = *(texel + 2);
-					tg = *(texel + 1);
-					tb = *(texel + 0);
-				} else {
-					// Palette data
-					uint8 index = *texel;
-					uint32 colour = myTexHan.palette[index];
-					ta = (uint8)((colour >> 24) & 0xFF);
-					tr = (uint8)((colour >> 16) & 0xFF);
-					tg = (uint8)((colour >> 8) & 0xFF);
-					tb = (uint8)((colour >> 0) & 0xFF);
-				}
-				// BGR : 128 = scale of 1.0
-				// int32 a = a0;
-				int32 r = r0;
-				int32 g = g0;
-				int32 b = b0;
-
-				r = (r * tr);
-				g = (g * tg);
-				b = (b * tb);
-
-				if (r < 0)
-					r = 0;
-				if (g < 0)
-					g = 0;
-				if (b < 0)
-					b = 0;
-
-				r = r >> 7;
-				g = g >> 7;
-				b = b >> 7;
-
-				if (r > 255)
-					r = 255;
-				if (g > 255)
-					g = 255;
-				if (b > 255)
-					b = 255;
-
-				*(left + 0) = (char)b;
-				*(left + 1) = (char)g;
-				*(left + 2) = (char)r;
-				*(left + 3) = (char)ta; // use the texture alpha value
-
-				*(uint16 *)(zleft + 0) = z;
-				left += myRenDev.RGBBytesPerPixel;
-				zleft += myRenDev.ZBytesPerPixel;
-				x++;
-				u += iuslope;
-				v += ivslope;
-				count--;
-			} while (count > 0);
-		}
-		pspan++;
-	}
+	SpanDrawState state;
+	initSpanDrawState(state, itopy, z);
+	state.flatColour.r = r0 << 8;
+	state.flatColour.g = g0 << 8;
+	state.flatColour.b = b0 << 8;
+	drawSpans(drawFlatTexturedSpans, itopy, ibottomy, state);
 	return 1;
 }
 
@@ -0,0 +1,120 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "engines/icb/gfx/gfxstub_simd.h"
+
+#include "common/endian.h"
+#include "common/util.h"
+#include "common/system.h"
+
+namespace ICB {
+
+void flatSpanGeneric(uint8 *rgb, uint16 *zbuf, int32 count, uint32 colour, uint16 z) {
+	for (int32 i = 0; i < count; i++) {
+		WRITE_LE_UINT32(rgb, colour);
+		rgb += 4;
+		*zbuf++ = z;
+	}
+}
+
+void gouraudSpanGeneric(uint8 *rgb, uint16 *zbuf, int32 count, const SpanColour &colour, uint16 z) {
+	uint32 a = ((colour.a >> 8) & 0xFF) << 24;
+	int32 r = colour.r;
+	int32 g = colour.g;
+	int32 b = colour.b;
+
+	for (int32 i = 0; i < count; i++) {
+		WRITE_LE_UINT32(rgb, a | ((r << 8) & 0xFF0000) | (g & 0xFF00) | ((b >> 8) & 0xFF));
+		rgb += 4;
+		*zbuf++ = z;
+		r += colour.dr;
+		g += colour.dg;
+		b += colour.db;
+	}
+}
+
+void modulateSpanGeneric(uint8 *rgb, uint16 *zbuf, const uint32 *texels, int32 count, const SpanColour &colour, uint16 z) {
+	int32 r = colour.r;
+	int32 g = colour.g;
+	int32 b = colour.b;
+
+	for (int32 i = 0; i < count; i++) {
+		uint32 texel = texels[i];
+
+		// BGR : 128 = scale of 1.0
+		int32 pr = (r >> 8) * (int32)((texel >> 16) & 0xFF);
+		int32 pg = (g >> 8) * (int32)((texel >> 8) & 0xFF);
+		int32 pb = (b >> 8) * (int32)(texel & 0xFF);
+
+		pr = CLIP<int32>(MAX<int32>(pr, 0) >> 7, 0, 255);
+		pg = CLIP<int32>(MAX<int32>(pg, 0) >> 7, 0, 255);
+		pb = CLIP<int32>(MAX<int32>(pb, 0) >> 7, 0, 255);
+
+		// use the texture alpha value
+		WRITE_LE_UINT32(rgb, (texel & 0xFF000000) | (pr << 16) | (pg << 8) | pb);
+		rgb += 4;
+		*zbuf++ = z;
+		r += colour.dr;
+		g += colour.dg;
+		b += colour.db;
+	}
+}
+
+void rotTransGeneric(const MATRIXPC *m, const int16 *x, const int16 *y, const int16 *z, int32 *outX, int32 *outY, int32 *outZ, uint32 count) {
+	for (uint32 i = 0; i < count; i++) {
+		// The rotation is scaled by ONE_PC
+		outX[i] = (m->m[0][0] * x[i] + m->m[0][1] * y[i] + m->m[0][2] * z[i]) / 4096 + m->t[0];
+		outY[i] = (m->m[1][0] * x[i] + m->m[1][1] * y[i] + m->m[1][2] * z[i]) / 4096 + m->t[1];
+		outZ[i] = (m->m[2][0] * x[i] + m->m[2][1] * y[i] + m->m[2][2] * z[i]) / 4096 + m->t[2];
+	}
+}
+
+static SimdProcs g_simdProcs = {nullptr, nullptr, nullptr, nullptr};
+
+const SimdProcs &getSimdProcs() {
+	// If no functions have been selected yet, detect and select
+	if (!g_simdProcs.flatSpan) {
+		g_simdProcs.flatSpan = flatSpanGeneric;
+		g_simdProcs.gouraudSpan = gouraudSpanGeneric;
+		g_simdProcs.modulateSpan = modulateSpanGeneric;
+		g_simdProcs.rotTrans = rotTransGeneric;
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) {
+			g_simdProcs.flatSpan = flatSpanNEON;
+			g_simdProcs.gouraudSpan = gouraudSpanNEON;
+			g_simdProcs.modulateSpan = modulateSpanNEON;
+			g_simdProcs.rotTrans = rotTransNEON;
+		}
+#endif
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) {
+			g_simdProcs.flatSpan = flatSpanSSE2;
+			g_simdProcs.gouraudSpan = gouraudSpanSSE2;
+			g_simdProcs.modulateSpan = modulateSpanSSE2;
+			g_simdProcs.rotTrans = rotTransSSE2;
+		}
+#endif
+	}
+
+	return g_simdProcs;
+}
+
+} // End of namespace ICB
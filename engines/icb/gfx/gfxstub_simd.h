@@ -0,0 +1,85 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ICB_GFXSTUB_SIMD_H
+#define ICB_GFXSTUB_SIMD_H
+
+#include "engines/icb/gfx/psx_pcdefines.h"
+
+namespace ICB {
+
+// The inner loops of the software renderer, with SSE2 and NEON versions
+// which give the same output as the generic ones.
+//
+// Pixels are written as B, G, R, alpha (low->high mem) and packed into an
+// uint32 as alpha << 24 | R << 16 | G << 8 | B, Z values are written as is.
+
+// Gouraud colour along a span in 24.8 fixed-point, the alpha is constant
+typedef struct {
+	int32 a, r, g, b;
+	int32 dr, dg, db;
+} SpanColour;
+
+// Fill count pixels with a single colour
+typedef void (*FlatSpanProc)(uint8 *rgb, uint16 *zbuf, int32 count, uint32 colour, uint16 z);
+
+// Fill count pixels with a gouraud shaded colour
+typedef void (*GouraudSpanProc)(uint8 *rgb, uint16 *zbuf, int32 count, const SpanColour &colour, uint16 z);
+
+// Fill count pixels with the given texels modulated by a gouraud shaded
+// colour, where 128 is a scale of 1.0, keeping the alpha of the texels
+typedef void (*ModulateSpanProc)(uint8 *rgb, uint16 *zbuf, const uint32 *texels, int32 count, const SpanColour &colour, uint16 z);
+
+// Transform count vertices, given as separate x, y and z arrays, by the
+// rotation and translation of m, exactly as gte_RotTrans_pc() does
+typedef void (*RotTransProc)(const MATRIXPC *m, const int16 *x, const int16 *y, const int16 *z, int32 *outX, int32 *outY, int32 *outZ, uint32 count);
+
+typedef struct {
+	FlatSpanProc flatSpan;
+	GouraudSpanProc gouraudSpan;
+	ModulateSpanProc modulateSpan;
+	RotTransProc rotTrans;
+} SimdProcs;
+
+void flatSpanGeneric(uint8 *rgb, uint16 *zbuf, int32 count, uint32 colour, uint16 z);
+void gouraudSpanGeneric(uint8 *rgb, uint16 *zbuf, int32 count, const SpanColour &colour, uint16 z);
+void modulateSpanGeneric(uint8 *rgb, uint16 *zbuf, const uint32 *texels, int32 count, const SpanColour &colour, uint16 z);
+void rotTransGeneric(const MATRIXPC *m, const int16 *x, const int16 *y, const int16 *z, int32 *outX, int32 *outY, int32 *outZ, uint32 count);
+
+#ifdef SCUMMVM_NEON
+void flatSpanNEON(uint8 *rgb, uint16 *zbuf, int32 count, uint32 colour, uint16 z);
+void gouraudSpanNEON(uint8 *rgb, uint16 *zbuf, int32 count, const SpanColour &colour, uint16 z);
+void modulateSpanNEON(uint8 *rgb, uint16 *zbuf, const uint32 *texels, int32 count, const SpanColour &colour, uint16 z);
+void rotTransNEON(const MATRIXPC *m, const int16 *x, const int16 *y, const int16 *z, int32 *outX, int32 *outY, int32 *outZ, uint32 count);
+#endif
+#ifdef SCUMMVM_SSE2
+void flatSpanSSE2(uint8 *rgb, uint16 *zbuf, int32 count, uint32 colour, uint16 z);
+void gouraudSpanSSE2(uint8 *rgb, uint16 *zbuf, int32 count, const SpanColour &colour, uint16 z);
+void modulateSpanSSE2(uint8 *rgb, uint16 *zbuf, const uint32 *texels, int32 count, const SpanColour &colour, uint16 z);
+void rotTransSSE2(const MATRIXPC *m, const int16 *x, const int16 *y, const int16 *z, int32 *outX, int32 *outY, int32 *outZ, uint32 count);
+#endif
+
+// Return the fastest versions supported by the CPU
+const SimdProcs &getSimdProcs();
+
+} // End of namespace ICB
+
+#endif // #ifndef ICB_GFXSTUB_SIMD_H
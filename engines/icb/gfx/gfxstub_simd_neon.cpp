@@ -0,0 +1,176 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "engines/icb/gfx/gfxstub_simd.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace ICB {
+
+void flatSpanNEON(uint8 *rgb, uint16 *zbuf, int32 count, uint32 colour, uint16 z) {
+	const uint32x4_t c = vdupq_n_u32(colour);
+	const uint16x4_t zv = vdup_n_u16(z);
+
+	int32 i = 0;
+	for (; i + 4 <= count; i += 4) {
+		vst1q_u8(rgb + i * 4, vreinterpretq_u8_u32(c));
+		vst1_u16(zbuf + i, zv);
+	}
+
+	flatSpanGeneric(rgb + i * 4, zbuf + i, count - i, colour, z);
+}
+
+static inline int32x4_t spanStart(int32 start, int32 step) {
+	const int32 values[4] = {start, start + step, start + 2 * step, start + 3 * step};
+	return vld1q_s32(values);
+}
+
+void gouraudSpanNEON(uint8 *rgb, uint16 *zbuf, int32 count, const SpanColour &colour, uint16 z) {
+	const uint32x4_t a = vdupq_n_u32(((colour.a >> 8) & 0xFF) << 24);
+	const uint32x4_t rMask = vdupq_n_u32(0xFF0000);
+	const uint32x4_t gMask = vdupq_n_u32(0xFF00);
+	const uint32x4_t bMask = vdupq_n_u32(0xFF);
+	const uint16x4_t zv = vdup_n_u16(z);
+
+	int32x4_t r = spanStart(colour.r, colour.dr);
+	int32x4_t g = spanStart(colour.g, colour.dg);
+	int32x4_t b = spanStart(colour.b, colour.db);
+	const int32x4_t dr = vdupq_n_s32(4 * colour.dr);
+	const int32x4_t dg = vdupq_n_s32(4 * colour.dg);
+	const int32x4_t db = vdupq_n_s32(4 * colour.db);
+
+	int32 i = 0;
+	for (; i + 4 <= count; i += 4) {
+		uint32x4_t p = vorrq_u32(a, vandq_u32(vshlq_n_u32(vreinterpretq_u32_s32(r), 8), rMask));
+		p = vorrq_u32(p, vandq_u32(vreinterpretq_u32_s32(g), gMask));
+		p = vorrq_u32(p, vandq_u32(vshrq_n_u32(vreinterpretq_u32_s32(b), 8), bMask));
+		vst1q_u8(rgb + i * 4, vreinterpretq_u8_u32(p));
+		vst1_u16(zbuf + i, zv);
+
+		r = vaddq_s32(r, dr);
+		g = vaddq_s32(g, dg);
+		b = vaddq_s32(b, db);
+	}
+
+	SpanColour rest = colour;
+	rest.r += i * colour.dr;
+	rest.g += i * colour.dg;
+	rest.b += i * colour.db;
+	gouraudSpanGeneric(rgb + i * 4, zbuf + i, count - i, rest, z);
+}
+
+// Scale a texel channel by a colour and clamp it, see modulateSpanGeneric()
+static inline uint32x4_t modulateChannel(int32x4_t colour, uint32x4_t channel) {
+	int32x4_t p = vmulq_s32(vshrq_n_s32(colour, 8), vreinterpretq_s32_u32(channel));
+	p = vmaxq_s32(p, vdupq_n_s32(0));
+	p = vminq_s32(vshrq_n_s32(p, 7), vdupq_n_s32(255));
+	return vreinterpretq_u32_s32(p);
+}
+
+void modulateSpanNEON(uint8 *rgb, uint16 *zbuf, const uint32 *texels, int32 count, const SpanColour &colour, uint16 z) {
+	const uint32x4_t aMask = vdupq_n_u32(0xFF000000);
+	const uint32x4_t mask = vdupq_n_u32(0xFF);
+	const uint16x4_t zv = vdup_n_u16(z);
+
+	int32x4_t r = spanStart(colour.r, colour.dr);
+	int32x4_t g = spanStart(colour.g, colour.dg);
+	int32x4_t b = spanStart(colour.b, colour.db);
+	const int32x4_t dr = vdupq_n_s32(4 * colour.dr);
+	const int32x4_t dg = vdupq_n_s32(4 * colour.dg);
+	const int32x4_t db = vdupq_n_s32(4 * colour.db);
+
+	int32 i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const uint32x4_t t = vld1q_u32(texels + i);
+
+		uint32x4_t p = vandq_u32(t, aMask);
+		p = vorrq_u32(p, vshlq_n_u32(modulateChannel(r, vandq_u32(vshrq_n_u32(t, 16), mask)), 16));
+		p = vorrq_u32(p, vshlq_n_u32(modulateChannel(g, vandq_u32(vshrq_n_u32(t, 8), mask)), 8));
+		p = vorrq_u32(p, modulateChannel(b, vandq_u32(t, mask)));
+		vst1q_u8(rgb + i * 4, vreinterpretq_u8_u32(p));
+		vst1_u16(zbuf + i, zv);
+
+		r = vaddq_s32(r, dr);
+		g = vaddq_s32(g, dg);
+		b = vaddq_s32(b, db);
+	}
+
+	SpanColour rest = colour;
+	rest.r += i * colour.dr;
+	rest.g += i * colour.dg;
+	rest.b += i * colour.db;
+	modulateSpanGeneric(rgb + i * 4, zbuf + i, texels + i, count - i, rest, z);
+}
+
+// Divide by ONE_PC, rounding towards zero, and translate
+static inline int32x4_t scaleTranslate(int32x4_t v, int32 t) {
+	v = vaddq_s32(v, vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(v, 31)), 20)));
+	return vaddq_s32(vshrq_n_s32(v, 12), vdupq_n_s32(t));
+}
+
+void rotTransNEON(const MATRIXPC *m, const int16 *x, const int16 *y, const int16 *z, int32 *outX, int32 *outY, int32 *outZ, uint32 count) {
+	int32 *out[3] = {outX, outY, outZ};
+
+	uint32 i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const int32x4_t vx = vmovl_s16(vld1_s16(x + i));
+		const int32x4_t vy = vmovl_s16(vld1_s16(y + i));
+		const int32x4_t vz = vmovl_s16(vld1_s16(z + i));
+
+		for (int32 row = 0; row < 3; row++) {
+			int32x4_t acc = vmulq_n_s32(vx, m->m[row][0]);
+			acc = vmlaq_n_s32(acc, vy, m->m[row][1]);
+			acc = vmlaq_n_s32(acc, vz, m->m[row][2]);
+			vst1q_s32(out[row] + i, scaleTranslate(acc, m->t[row]));
+		}
+	}
+
+	rotTransGeneric(m, x + i, y + i, z + i, outX + i, outY + i, outZ + i, count - i);
+}
+
+} // End of namespace ICB
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
@@ -0,0 +1,207 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_SSE2
+
+#include "engines/icb/gfx/gfxstub_simd.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace ICB {
+
+void flatSpanSSE2(uint8 *rgb, uint16 *zbuf, int32 count, uint32 colour, uint16 z) {
+	const __m128i c = _mm_set1_epi32((int32)colour);
+	const __m128i zv = _mm_set1_epi16((int16)z);
+
+	int32 i = 0;
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_si128((__m128i *)(rgb + i * 4), c);
+		_mm_storel_epi64((__m128i *)(zbuf + i), zv);
+	}
+
+	flatSpanGeneric(rgb + i * 4, zbuf + i, count - i, colour, z);
+}
+
+void gouraudSpanSSE2(uint8 *rgb, uint16 *zbuf, int32 count, const SpanColour &colour, uint16 z) {
+	const __m128i a = _mm_set1_epi32((int32)(((colour.a >> 8) & 0xFF) << 24));
+	const __m128i rMask = _mm_set1_epi32(0xFF0000);
+	const __m128i gMask = _mm_set1_epi32(0xFF00);
+	const __m128i bMask = _mm_set1_epi32(0xFF);
+	const __m128i zv = _mm_set1_epi16((int16)z);
+
+	__m128i r = _mm_setr_epi32(colour.r, colour.r + colour.dr, colour.r + 2 * colour.dr, colour.r + 3 * colour.dr);
+	__m128i g = _mm_setr_epi32(colour.g, colour.g + colour.dg, colour.g + 2 * colour.dg, colour.g + 3 * colour.dg);
+	__m128i b = _mm_setr_epi32(colour.b, colour.b + colour.db, colour.b + 2 * colour.db, colour.b + 3 * colour.db);
+	const __m128i dr = _mm_set1_epi32(4 * colour.dr);
+	const __m128i dg = _mm_set1_epi32(4 * colour.dg);
+	const __m128i db = _mm_set1_epi32(4 * colour.db);
+
+	int32 i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128i p = _mm_or_si128(a, _mm_and_si128(_mm_slli_epi32(r, 8), rMask));
+		p = _mm_or_si128(p, _mm_and_si128(g, gMask));
+		p = _mm_or_si128(p, _mm_and_si128(_mm_srli_epi32(b, 8), bMask));
+		_mm_storeu_si128((__m128i *)(rgb + i * 4), p);
+		_mm_storel_epi64((__m128i *)(zbuf + i), zv);
+
+		r = _mm_add_epi32(r, dr);
+		g = _mm_add_epi32(g, dg);
+		b = _mm_add_epi32(b, db);
+	}
+
+	SpanColour rest = colour;
+	rest.r += i * colour.dr;
+	rest.g += i * colour.dg;
+	rest.b += i * colour.db;
+	gouraudSpanGeneric(rgb + i * 4, zbuf + i, count - i, rest, z);
+}
+
+// Scale a texel channel by a colour and clamp it, see modulateSpanGeneric().
+// The colours are below 256, so only the low 16 bits of the lanes are needed
+// for _mm_madd_epi16() to give their product with the channel.
+static inline __m128i modulateChannel(__m128i colour, __m128i channel) {
+	const __m128i max = _mm_set1_epi32(255);
+
+	__m128i p = _mm_madd_epi16(_mm_srai_epi32(colour, 8), channel);
+	p = _mm_andnot_si128(_mm_srai_epi32(p, 31), p);
+	p = _mm_srli_epi32(p, 7);
+	const __m128i over = _mm_cmpgt_epi32(p, max);
+	return _mm_or_si128(_mm_andnot_si128(over, p), _mm_and_si128(over, max));
+}
+
+void modulateSpanSSE2(uint8 *rgb, uint16 *zbuf, const uint32 *texels, int32 count, const SpanColour &colour, uint16 z) {
+	const __m128i aMask = _mm_set1_epi32((int32)0xFF000000);
+	const __m128i mask = _mm_set1_epi32(0xFF);
+	const __m128i zv = _mm_set1_epi16((int16)z);
+
+	__m128i r = _mm_setr_epi32(colour.r, colour.r + colour.dr, colour.r + 2 * colour.dr, colour.r + 3 * colour.dr);
+	__m128i g = _mm_setr_epi32(colour.g, colour.g + colour.dg, colour.g + 2 * colour.dg, colour.g + 3 * colour.dg);
+	__m128i b = _mm_setr_epi32(colour.b, colour.b + colour.db, colour.b + 2 * colour.db, colour.b + 3 * colour.db);
+	const __m128i dr = _mm_set1_epi32(4 * colour.dr);
+	const __m128i dg = _mm_set1_epi32(4 * colour.dg);
+	const __m128i db = _mm_set1_epi32(4 * colour.db);
+
+	int32 i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const __m128i t = _mm_loadu_si128((const __m128i *)(texels + i));
+
+		__m128i p = _mm_and_si128(t, aMask);
+		p = _mm_or_si128(p, _mm_slli_epi32(modulateChannel(r, _mm_and_si128(_mm_srli_epi32(t, 16), mask)), 16));
+		p = _mm_or_si128(p, _mm_slli_epi32(modulateChannel(g, _mm_and_si128(_mm_srli_epi32(t, 8), mask)), 8));
+		p = _mm_or_si128(p, modulateChannel(b, _mm_and_si128(t, mask)));
+		_mm_storeu_si128((__m128i *)(rgb + i * 4), p);
+		_mm_storel_epi64((__m128i *)(zbuf + i), zv);
+
+		r = _mm_add_epi32(r, dr);
+		g = _mm_add_epi32(g, dg);
+		b = _mm_add_epi32(b, db);
+	}
+
+	SpanColour rest = colour;
+	rest.r += i * colour.dr;
+	rest.g += i * colour.dg;
+	rest.b += i * colour.db;
+	modulateSpanGeneric(rgb + i * 4, zbuf + i, texels + i, count - i, rest, z);
+}
+
+// A matrix element split into 16-bit halves, so that its product with eight
+// 16-bit values can be made without SSE4.1. The high half is rounded up when
+// the low one is negative as a signed value, and only its low 16 bits matter.
+typedef struct {
+	__m128i lo, hi;
+} SplitElement;
+
+static inline SplitElement splitElement(int32 m) {
+	SplitElement e;
+	e.lo = _mm_set1_epi16((int16)(m & 0xFFFF));
+	e.hi = _mm_set1_epi16((int16)(((uint32)m + 0x8000) >> 16));
+	return e;
+}
+
+// Add the 32-bit products of v and e to acc0 (first four) and acc1 (last four)
+static inline void mulAdd(__m128i &acc0, __m128i &acc1, __m128i v, const SplitElement &e) {
+	const __m128i lo = _mm_mullo_epi16(v, e.lo);
+	const __m128i hi = _mm_add_epi16(_mm_mulhi_epi16(v, e.lo), _mm_mullo_epi16(v, e.hi));
+	acc0 = _mm_add_epi32(acc0, _mm_unpacklo_epi16(lo, hi));
+	acc1 = _mm_add_epi32(acc1, _mm_unpackhi_epi16(lo, hi));
+}
+
+// Divide by ONE_PC, rounding towards zero, and translate
+static inline __m128i scaleTranslate(__m128i v, __m128i t) {
+	v = _mm_add_epi32(v, _mm_srli_epi32(_mm_srai_epi32(v, 31), 20));
+	return _mm_add_epi32(_mm_srai_epi32(v, 12), t);
+}
+
+void rotTransSSE2(const MATRIXPC *m, const int16 *x, const int16 *y, const int16 *z, int32 *outX, int32 *outY, int32 *outZ, uint32 count) {
+	SplitElement e[3][3];
+	for (int32 row = 0; row < 3; row++) {
+		for (int32 col = 0; col < 3; col++)
+			e[row][col] = splitElement(m->m[row][col]);
+	}
+	const __m128i t[3] = {_mm_set1_epi32(m->t[0]), _mm_set1_epi32(m->t[1]), _mm_set1_epi32(m->t[2])};
+	int32 *out[3] = {outX, outY, outZ};
+
+	uint32 i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m128i vx = _mm_loadu_si128((const __m128i *)(x + i));
+		const __m128i vy = _mm_loadu_si128((const __m128i *)(y + i));
+		const __m128i vz = _mm_loadu_si128((const __m128i *)(z + i));
+
+		for (int32 row = 0; row < 3; row++) {
+			__m128i acc0 = _mm_setzero_si128();
+			__m128i acc1 = _mm_setzero_si128();
+			mulAdd(acc0, acc1, vx, e[row][0]);
+			mulAdd(acc0, acc1, vy, e[row][1]);
+			mulAdd(acc0, acc1, vz, e[row][2]);
+			_mm_storeu_si128((__m128i *)(out[row] + i), scaleTranslate(acc0, t[row]));
+			_mm_storeu_si128((__m128i *)(out[row] + i + 4), scaleTranslate(acc1, t[row]));
+		}
+	}
+
+	rotTransGeneric(m, x + i, y + i, z + i, outX + i, outY + i, outZ + i, count - i);
+}
+
+} // End of namespace ICB
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
+
+#endif // SCUMMVM_SSE2
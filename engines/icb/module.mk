@@ -124,6 +124,7 @@ MODULE_OBJS := \
 	gfx/gfxstub.o \
 	gfx/gfxstub_dutch.o \
 	gfx/gfxstub_rev.o \
+	gfx/gfxstub_simd.o \
 	gfx/psx_camera.o \
 	gfx/psx_pcgpu.o \
 	gfx/psx_tman.o \
@@ -134,6 +135,15 @@ MODULE_OBJS := \
 	sound/sound_common.o \
 	sound/speech_manager.o
 
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	gfx/gfxstub_simd_neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	gfx/gfxstub_simd_sse2.o
+endif
+
 # This module can be built as a plugin
 ifeq ($(ENABLE_ICB), DYNAMIC_PLUGIN)
 PLUGIN := 1
@@ -27,11 +27,14 @@
 #include "engines/icb/common/px_common.h"
 #include "engines/icb/softskin_pc.h"
 #include "engines/icb/common/px_capri_maths.h"
+#include "engines/icb/gfx/gfxstub_simd.h"
 
 #include "common/util.h"
 
 namespace ICB {
 
+#define SOFTSKIN_BATCH 64
+
 int32 softskinPC(RapAPI *rap, int32 poseBone, MATRIXPC *lw, SVECTORPC *local, int16 *xminLocal, int16 *xmaxLocal, int16 *yminLocal, int16 *ymaxLocal, int16 *zminLocal,
 			   int16 *zmaxLocal, int32 screenShift) {
 	// step 1 : make all the local-world and local-screen matrices
@@ -80,6 +83,12 @@ int32 softskinPC(RapAPI *rap, int32 poseBone, MATRIXPC *lw, SVECTORPC *local, in
 
 	int32 lvx, lvy, lvz;
 
+	// The pose and single link vertices are transformed in batches
+	RotTransProc rotTrans = getSimdProcs().rotTrans;
+	int16 bx[SOFTSKIN_BATCH], by[SOFTSKIN_BATCH], bz[SOFTSKIN_BATCH];
+	int32 wx[SOFTSKIN_BATCH], wy[SOFTSKIN_BATCH], wz[SOFTSKIN_BATCH];
+	uint32 j, n;
+
 	if (poseBone == -1) {
 		for (i = 0; i < nNone; i++) {
 			vIndex = noneLink->vertId;
@@ -108,34 +117,42 @@ int32 softskinPC(RapAPI *rap, int32 poseBone, MATRIXPC *lw, SVECTORPC *local, in
 		// Do the pose vertices
 		gte_SetRotMatrix_pc(lw + poseBone);
 		gte_SetTransMatrix_pc(lw + poseBone);
-		for (i = 0; i < nNone; i++) {
-			gte_RotTrans_pc((SVECTOR *)&(noneLink->vx), &lvert2, &flag);
-
-			vIndex = noneLink->vertId;
-			plocal = local + vIndex;
-
-			plocal->vx = (int16)(lvert2.vx >> worldScaleShift);
-			plocal->vy = (int16)(lvert2.vy >> worldScaleShift);
-			plocal->vz = (int16)(lvert2.vz >> worldScaleShift);
-
-			lvx = plocal->vx;
-			lvy = plocal->vy;
-			lvz = plocal->vz;
-
-			xmin = MIN(lvx, xmin);
-			ymin = MIN(lvy, ymin);
-			zmin = MIN(lvz, zmin);
-
-			xmax = MAX(lvx, xmax);
-			ymax = MAX(lvy, ymax);
-			zmax = MAX(lvz, zmax);
-
-			noneLink++;
+		for (i = 0; i < nNone; i += n) {
+			n = MIN<uint32>(nNone - i, SOFTSKIN_BATCH);
+			for (j = 0; j < n; j++) {
+				bx[j] = noneLink[j].vx;
+				by[j] = noneLink[j].vy;
+				bz[j] = noneLink[j].vz;
+			}
+			rotTrans(lw + poseBone, bx, by, bz, wx, wy, wz, n);
+
+			for (j = 0; j < n; j++) {
+				vIndex = noneLink->vertId;
+				plocal = local + vIndex;
+
+				plocal->vx = (int16)(wx[j] >> worldScaleShift);
+				plocal->vy = (int16)(wy[j] >> worldScaleShift);
+				plocal->vz = (int16)(wz[j] >> worldScaleShift);
+
+				lvx = plocal->vx;
+				lvy = plocal->vy;
+				lvz = plocal->vz;
+
+				xmin = MIN(lvx, xmin);
+				ymin = MIN(lvy, ymin);
+				zmin = MIN(lvz, zmin);
+
+				xmax = MAX(lvx, xmax);
+				ymax = MAX(lvy, ymax);
+				zmax = MAX(lvz, zmax);
+
+				noneLink++;
+			}
 		}
 		nVertices = nNone;
 	}
 
-	for (i = 0; i < nSingle; i++) {
+	for (i = 0; i < nSingle; i += n) {
 		prim = singleLink->primId; // which co-ordinate system to use
 
 		// Put the correct rot and trans matrix in place
@@ -145,28 +162,40 @@ int32 softskinPC(RapAPI *rap, int32 poseBone, MATRIXPC *lw, SVECTORPC *local, in
 			gte_SetTransMatrix_pc(lw + prim);
 			oldPrim = prim;
 		}
-		gte_RotTrans_pc((SVECTOR *)&(singleLink->vx), &lvert2, &flag);
 
-		plocal = local + singleLink->vertId;
-		if (singleLink->vertId > nVertices)
-			nVertices = singleLink->vertId;
-		plocal->vx = (int16)(lvert2.vx >> worldScaleShift);
-		plocal->vy = (int16)(lvert2.vy >> worldScaleShift);
-		plocal->vz = (int16)(lvert2.vz >> worldScaleShift);
+		// Transform the following vertices in the same co-ordinate system at once
+		n = 1;
+		while ((n < SOFTSKIN_BATCH) && (i + n < nSingle) && ((uint32)singleLink[n].primId == prim))
+			n++;
+		for (j = 0; j < n; j++) {
+			bx[j] = singleLink[j].vx;
+			by[j] = singleLink[j].vy;
+			bz[j] = singleLink[j].vz;
+		}
+		rotTrans(lw + prim, bx, by, bz, wx, wy, wz, n);
+
+		for (j = 0; j < n; j++) {
+			plocal = local + singleLink->vertId;
+			if (singleLink->vertId > nVertices)
+				nVertices = singleLink->vertId;
+			plocal->vx = (int16)(wx[j] >> worldScaleShift);
+			plocal->vy = (int16)(wy[j] >> worldScaleShift);
+			plocal->vz = (int16)(wz[j] >> worldScaleShift);
 
-		lvx = plocal->vx;
-		lvy = plocal->vy;
-		lvz = plocal->vz;
+			lvx = plocal->vx;
+			lvy = plocal->vy;
+			lvz = plocal->vz;
 
-		xmin = MIN(lvx, xmin);
-		ymin = MIN(lvy, ymin);
-		zmin = MIN(lvz, zmin);
+			xmin = MIN(lvx, xmin);
+			ymin = MIN(lvy, ymin);
+			zmin = MIN(lvz, zmin);
 
-		xmax = MAX(lvx, xmax);
-		ymax = MAX(lvy, ymax);
-		zmax = MAX(lvz, zmax);
+			xmax = MAX(lvx, xmax);
+			ymax = MAX(lvy, ymax);
+			zmax = MAX(lvz, zmax);
 
-		singleLink++;
+			singleLink++;
+		}
 	}
 
 	uint32 curVert = multiLink->link.vertId;
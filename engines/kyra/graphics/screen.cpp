@@ -1783,6 +1783,33 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 		return;
 	}
 
+	struct DsFixedLineFunc {
+		DsPlotFunc plot;
+		DsLineFunc upwind;
+		DsLineFunc downwind;
+	};
+
+	static const DsFixedLineFunc dsFixedLineFunc[] = {
+		{ &Screen::drawShapePlotType0, &Screen::drawShapeProcessLineNoScaleUpwindFixed<&Screen::drawShapePlotType0>, &Screen::drawShapeProcessLineNoScaleDownwindFixed<&Screen::drawShapePlotType0> },
+		{ &Screen::drawShapePlotType4, &Screen::drawShapeProcessLineNoScaleUpwindFixed<&Screen::drawShapePlotType4>, &Screen::drawShapeProcessLineNoScaleDownwindFixed<&Screen::drawShapePlotType4> },
+		{ &Screen::drawShapePlotType8, &Screen::drawShapeProcessLineNoScaleUpwindFixed<&Screen::drawShapePlotType8>, &Screen::drawShapeProcessLineNoScaleDownwindFixed<&Screen::drawShapePlotType8> },
+		{ &Screen::drawShapePlotType12, &Screen::drawShapeProcessLineNoScaleUpwindFixed<&Screen::drawShapePlotType12>, &Screen::drawShapeProcessLineNoScaleDownwindFixed<&Screen::drawShapePlotType12> },
+		{ &Screen::drawShapePlotType37, &Screen::drawShapeProcessLineNoScaleUpwindFixed<&Screen::drawShapePlotType37>, &Screen::drawShapeProcessLineNoScaleDownwindFixed<&Screen::drawShapePlotType37> }
+	};
+
+	// Use a line function with the plot inlined when the plot type can't change between lines
+	if (dsPlot2 == dsPlot3) {
+		const bool upwind = (dsProcessLine == &Screen::drawShapeProcessLineNoScaleUpwind);
+		if (upwind || dsProcessLine == &Screen::drawShapeProcessLineNoScaleDownwind) {
+			for (uint i = 0; i < ARRAYSIZE(dsFixedLineFunc); ++i) {
+				if (dsFixedLineFunc[i].plot == dsPlot2) {
+					dsProcessLine = upwind ? dsFixedLineFunc[i].upwind : dsFixedLineFunc[i].downwind;
+					break;
+				}
+			}
+		}
+	}
+
 	int curY = y;
 	const uint8 *src = shapeData;
 	uint8 *dst = _dsDstPage = getPagePtr(pageNum);
@@ -2120,6 +2147,36 @@ void Screen::drawShapeProcessLineNoScaleDownwind(uint8 *&dst, const uint8 *&src,
 	} while (cnt > 0);
 }
 
+template<Screen::DsPlotFunc plot>
+void Screen::drawShapeProcessLineNoScaleUpwindFixed(uint8 *&dst, const uint8 *&src, const DsPlotFunc, int &cnt, int16) {
+	do {
+		uint8 c = *src++;
+		if (c) {
+			(this->*plot)(dst++, c);
+			cnt--;
+		} else {
+			c = *src++;
+			dst += c;
+			cnt -= c;
+		}
+	} while (cnt > 0);
+}
+
+template<Screen::DsPlotFunc plot>
+void Screen::drawShapeProcessLineNoScaleDownwindFixed(uint8 *&dst, const uint8 *&src, const DsPlotFunc, int &cnt, int16) {
+	do {
+		uint8 c = *src++;
+		if (c) {
+			(this->*plot)(dst--, c);
+			cnt--;
+		} else {
+			c = *src++;
+			dst -= c;
+			cnt -= c;
+		}
+	} while (cnt > 0);
+}
+
 void Screen::drawShapeProcessLineScaleUpwind(uint8 *&dst, const uint8 *&src, const DsPlotFunc plot, int &cnt, int16 scaleState) {
 	int c = 0;
 
@@ -3519,10 +3576,26 @@ void Screen::addDirtyRect(int x, int y, int w, int h) {
 
 		// Conversely, if we find rectangles which are contained in
 		// the new one, we can remove them
-		if (r.contains(*it))
+		if (r.contains(*it)) {
 			it = _dirtyRects.erase(it);
-		else
-			++it;
+			continue;
+		}
+
+		// Overlapping rectangles are merged when their bounding box
+		// doesn't cover more than the two of them do on their own. The
+		// grown rectangle may now reach others, so start over.
+		if (r.intersects(*it)) {
+			Common::Rect merged(r);
+			merged.extend(*it);
+			if (merged.width() * merged.height() <= r.width() * r.height() + it->width() * it->height()) {
+				r = merged;
+				_dirtyRects.erase(it);
+				it = _dirtyRects.begin();
+				continue;
+			}
+		}
+
+		++it;
 	}
 
 	// If we got here, we can safely add r to the list of dirty rects.
@@ -915,6 +915,13 @@ protected:
 	void drawShapeProcessLineScaleUpwind(uint8 *&dst, const uint8 *&src, const DsPlotFunc plot, int &cnt, int16 scaleState);
 	void drawShapeProcessLineScaleDownwind(uint8 *&dst, const uint8 *&src, const DsPlotFunc plot, int &cnt, int16 scaleState);
 
+	// Unscaled line variants with the plot function bound at compile time, so the
+	// common plot types are inlined instead of being called once per pixel
+	template<DsPlotFunc plot>
+	void drawShapeProcessLineNoScaleUpwindFixed(uint8 *&dst, const uint8 *&src, const DsPlotFunc, int &cnt, int16);
+	template<DsPlotFunc plot>
+	void drawShapeProcessLineNoScaleDownwindFixed(uint8 *&dst, const uint8 *&src, const DsPlotFunc, int &cnt, int16);
+
 	void drawShapePlotType0(uint8 *dst, uint8 cmd);
 	void drawShapePlotType1(uint8 *dst, uint8 cmd);
 	void drawShapePlotType3_7(uint8 *dst, uint8 cmd);
@@ -24,6 +24,8 @@
 #include "lastexpress/data/sequence.h"
 
 #include "lastexpress/debug.h"
+#include "lastexpress/lastexpress.h"
+#include "lastexpress/resource.h"
 
 #include "common/stream.h"
 
@@ -75,10 +77,13 @@ void FrameInfo::read(Common::SeekableReadStream *in, bool isSequence) {
 
 // AnimFrame
 
-AnimFrame::AnimFrame(Common::SeekableReadStream *in, const FrameInfo &f, bool /* ignoreSubtype */) : _palette(nullptr) {
+AnimFrame::AnimFrame(Common::SeekableReadStream *in, const FrameInfo &f, bool /* ignoreSubtype */) : _image(nullptr), _palette(nullptr) {
 	_palSize = 1;
-	// TODO: use just the needed rectangle
-	_image.create(640, 480, Graphics::PixelFormat::createFormatCLUT8());
+	_start = _end = 0;
+
+	// Frames are decoded to a full screen, of which only the used part is kept
+	byte *p = (byte *)calloc(640 * 480, 1);
+	uint32 end = f.initialSkip / 2;
 
 	//debugC(6, kLastExpressDebugGraphics, "    Offsets: data=%d, unknown=%d, palette=%d", f.dataOffset, f.unknown, f.paletteOffset);
 	//debugC(6, kLastExpressDebugGraphics, "    Position: (%d, %d) - (%d, %d)", f.xPos1, f.yPos1, f.xPos2, f.yPos2);
@@ -98,38 +103,44 @@ AnimFrame::AnimFrame(Common::SeekableReadStream *in, const FrameInfo &f, bool /*
 		// Empty frame
 		break;
 	case 3:
-		decomp3(in, f);
+		end = decomp3(in, f, p);
 		break;
 	case 4:
-		decomp4(in, f);
+		end = decomp4(in, f, p);
 		break;
 	case 5:
-		decomp5(in, f);
+		end = decomp5(in, f, p);
 		break;
 	case 7:
-		decomp7(in, f);
+		end = decomp7(in, f, p);
 		break;
 	case 255:
-		decompFF(in, f);
+		end = decompFF(in, f, p);
 		break;
 	default:
 		error("[AnimFrame::AnimFrame] Unknown frame compression: %d", f.compressionType);
 	}
 
+	_start = MIN<uint32>(f.initialSkip / 2, 640 * 480);
+	_end = CLIP<uint32>(end, _start, 640 * 480);
+	_image = new byte[_end - _start];
+	memcpy(_image, p + _start, _end - _start);
+	free(p);
+
 	readPalette(in, f);
 	_rect = Common::Rect((int16)f.xPos1, (int16)f.yPos1, (int16)f.xPos2, (int16)f.yPos2);
 	//_rect.debugPrint(0, "Frame rect:");
 }
 
 AnimFrame::~AnimFrame() {
-	_image.free();
+	delete[] _image;
 	delete[] _palette;
 }
 
 Common::Rect AnimFrame::draw(Graphics::Surface *s) {
-	byte *inp = (byte *)_image.getPixels();
-	uint16 *outp = (uint16 *)s->getPixels();
-	for (int i = 0; i < 640 * 480; i++, inp++, outp++) {
+	const byte *inp = _image;
+	uint16 *outp = (uint16 *)s->getPixels() + _start;
+	for (uint32 i = _start; i < _end; i++, inp++, outp++) {
 		if (*inp)
 			*outp = _palette[*inp];
 	}
@@ -145,17 +156,15 @@ void AnimFrame::readPalette(Common::SeekableReadStream *in, const FrameInfo &f)
 	}
 }
 
-void AnimFrame::decomp3(Common::SeekableReadStream *in, const FrameInfo &f) {
-	decomp34(in, f, 0x7, 3);
+uint32 AnimFrame::decomp3(Common::SeekableReadStream *in, const FrameInfo &f, byte *p) {
+	return decomp34(in, f, p, 0x7, 3);
 }
 
-void AnimFrame::decomp4(Common::SeekableReadStream *in, const FrameInfo &f) {
-	decomp34(in, f, 0xf, 4);
+uint32 AnimFrame::decomp4(Common::SeekableReadStream *in, const FrameInfo &f, byte *p) {
+	return decomp34(in, f, p, 0xf, 4);
 }
 
-void AnimFrame::decomp34(Common::SeekableReadStream *in, const FrameInfo &f, byte mask, byte shift) {
-	byte *p = (byte *)_image.getPixels();
-
+uint32 AnimFrame::decomp34(Common::SeekableReadStream *in, const FrameInfo &f, byte *p, byte mask, byte shift) {
 	uint32 skip = f.initialSkip / 2;
 	uint32 size = f.decompressedEndOffset / 2;
 	//warning("skip: %d, %d", skip % 640, skip / 640);
@@ -166,7 +175,8 @@ void AnimFrame::decomp34(Common::SeekableReadStream *in, const FrameInfo &f, byt
 	uint32 numBlanks = 640 - (f.xPos2 - f.xPos1);
 
 	in->seek((int)f.dataOffset);
-	for (uint32 out = skip; out < size; ) {
+	uint32 out = skip;
+	while (out < size) {
 		uint16 opcode = in->readByte();
 
 		if (opcode & 0x80) {
@@ -196,11 +206,11 @@ void AnimFrame::decomp34(Common::SeekableReadStream *in, const FrameInfo &f, byt
 			}
 		}
 	}
-}
 
-void AnimFrame::decomp5(Common::SeekableReadStream *in, const FrameInfo &f) {
-	byte *p = (byte *)_image.getPixels();
+	return out;
+}
 
+uint32 AnimFrame::decomp5(Common::SeekableReadStream *in, const FrameInfo &f, byte *p) {
 	uint32 skip = f.initialSkip / 2;
 	uint32 size = f.decompressedEndOffset / 2;
 	//warning("skip: %d, %d", skip % 640, skip / 640);
@@ -209,7 +219,8 @@ void AnimFrame::decomp5(Common::SeekableReadStream *in, const FrameInfo &f) {
 	//assert (f.yPos2 == size / 640);
 
 	in->seek((int)f.dataOffset);
-	for (uint32 out = skip; out < size; ) {
+	uint32 out = skip;
+	while (out < size) {
 		uint16 opcode = in->readByte();
 		if (!(opcode & 0x1f)) {
 			opcode = (uint16)((opcode << 3) + in->readByte());
@@ -231,11 +242,11 @@ void AnimFrame::decomp5(Common::SeekableReadStream *in, const FrameInfo &f) {
 			}
 		}
 	}
-}
 
-void AnimFrame::decomp7(Common::SeekableReadStream *in, const FrameInfo &f) {
-	byte *p = (byte *)_image.getPixels();
+	return out;
+}
 
+uint32 AnimFrame::decomp7(Common::SeekableReadStream *in, const FrameInfo &f, byte *p) {
 	uint32 skip = f.initialSkip / 2;
 	uint32 size = f.decompressedEndOffset / 2;
 	//warning("skip: %d, %d", skip % 640, skip / 640);
@@ -246,7 +257,8 @@ void AnimFrame::decomp7(Common::SeekableReadStream *in, const FrameInfo &f) {
 	uint32 numBlanks = 640 - (f.xPos2 - f.xPos1);
 
 	in->seek((int)f.dataOffset);
-	for (uint32 out = skip; out < size; ) {
+	uint32 out = skip;
+	while (out < size) {
 		uint16 opcode = in->readByte();
 		if (opcode & 0x80) {
 			if (opcode & 0x40) {
@@ -284,16 +296,17 @@ void AnimFrame::decomp7(Common::SeekableReadStream *in, const FrameInfo &f) {
 			out++;
 		}
 	}
-}
 
-void AnimFrame::decompFF(Common::SeekableReadStream *in, const FrameInfo &f) {
-	byte *p = (byte *)_image.getPixels();
+	return out;
+}
 
+uint32 AnimFrame::decompFF(Common::SeekableReadStream *in, const FrameInfo &f, byte *p) {
 	uint32 skip = f.initialSkip / 2;
 	uint32 size = f.decompressedEndOffset / 2;
 
 	in->seek((int)f.dataOffset);
-	for (uint32 out = skip; out < size; ) {
+	uint32 out = skip;
+	while (out < size) {
 		uint16 opcode = in->readByte();
 
 		if (opcode < 0x80) {
@@ -325,6 +338,8 @@ void AnimFrame::decompFF(Common::SeekableReadStream *in, const FrameInfo &f) {
 			}
 		}
 	}
+
+	return out;
 }
 
 
@@ -433,15 +448,11 @@ Common::Rect SequenceFrame::draw(Graphics::Surface *surface) {
 	if (!_sequence || _frame >= _sequence->count())
 		return Common::Rect();
 
-	AnimFrame *f = _sequence->getFrame(_frame);
+	AnimFrame *f = ((LastExpressEngine *)g_engine)->getResourceManager()->getSequenceFrame(_sequence, _frame);
 	if (!f)
 		return Common::Rect();
 
-	Common::Rect rect = f->draw(surface);
-
-	delete f;
-
-	return rect;
+	return f->draw(surface);
 }
 
 bool SequenceFrame::setFrame(uint16 frame) {
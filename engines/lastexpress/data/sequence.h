@@ -133,16 +133,23 @@ public:
 	~AnimFrame() override;
 	Common::Rect draw(Graphics::Surface *s) override;
 
+	/** Memory used by the decoded frame, in bytes. */
+	uint32 getDataSize() const { return _end - _start + _palSize * sizeof(uint16); }
+
 private:
-	void decomp3(Common::SeekableReadStream *in, const FrameInfo &f);
-	void decomp4(Common::SeekableReadStream *in, const FrameInfo &f);
-	void decomp34(Common::SeekableReadStream *in, const FrameInfo &f, byte mask, byte shift);
-	void decomp5(Common::SeekableReadStream *in, const FrameInfo &f);
-	void decomp7(Common::SeekableReadStream *in, const FrameInfo &f);
-	void decompFF(Common::SeekableReadStream *in, const FrameInfo &f);
+	uint32 decomp3(Common::SeekableReadStream *in, const FrameInfo &f, byte *p);
+	uint32 decomp4(Common::SeekableReadStream *in, const FrameInfo &f, byte *p);
+	uint32 decomp34(Common::SeekableReadStream *in, const FrameInfo &f, byte *p, byte mask, byte shift);
+	uint32 decomp5(Common::SeekableReadStream *in, const FrameInfo &f, byte *p);
+	uint32 decomp7(Common::SeekableReadStream *in, const FrameInfo &f, byte *p);
+	uint32 decompFF(Common::SeekableReadStream *in, const FrameInfo &f, byte *p);
 	void readPalette(Common::SeekableReadStream *in, const FrameInfo &f);
 
-	Graphics::Surface _image;
+	// Only the part of the 640x480 screen between the first and
+	// the last decoded pixel is kept
+	byte *_image;
+	uint32 _start;
+	uint32 _end;
 	uint16 _palSize;
 	uint16 *_palette;
 	Common::Rect _rect;
@@ -24,10 +24,12 @@
 #include "lastexpress/data/background.h"
 #include "lastexpress/data/cursor.h"
 #include "lastexpress/data/font.h"
+#include "lastexpress/data/sequence.h"
 
 #include "lastexpress/debug.h"
 #include "lastexpress/helpers.h"
 
+#include "common/config-manager.h"
 #include "common/debug.h"
 #include "common/file.h"
 
@@ -39,7 +41,16 @@ const char *archiveCD1Path = "cd1.hpf";
 const char *archiveCD2Path = "cd2.hpf";
 const char *archiveCD3Path = "cd3.hpf";
 
-ResourceManager::ResourceManager(bool isDemo) : _isDemo(isDemo) {
+// Default size of the decoded frame cache, in KB
+// (ports with little memory can lower it with the "frame_cache_size" setting)
+static const int kFrameCacheDefaultSize = 8 * 1024;
+
+ResourceManager::ResourceManager(bool isDemo) : _isDemo(isDemo), _frameCacheSize(0), _frameCacheUseCounter(0) {
+	int cacheSize = kFrameCacheDefaultSize;
+	if (ConfMan.hasKey("frame_cache_size"))
+		cacheSize = MAX(ConfMan.getInt("frame_cache_size"), 0);
+
+	_frameCacheMaxSize = (uint32)cacheSize * 1024;
 }
 
 ResourceManager::~ResourceManager() {
@@ -111,6 +122,8 @@ void ResourceManager::reset() {
 		SAFE_DELETE(*it);
 
 	_archives.clear();
+
+	clearFrameCache();
 }
 
 bool ResourceManager::loadArchive(const Common::Path &name) {
@@ -245,4 +258,56 @@ Font *ResourceManager::loadFont() const {
 	return f;
 }
 
+//////////////////////////////////////////////////////////////////////////
+// Frame cache
+//////////////////////////////////////////////////////////////////////////
+
+// Get a decoded frame of a sequence
+//  - the same frames are drawn over and over while entities stand or walk
+//    around, so decoded frames are kept until the cache is full
+//  - the frame stays valid until the next call
+AnimFrame *ResourceManager::getSequenceFrame(Sequence *sequence, uint16 index) {
+	Common::String key = Common::String::format("%s:%d", sequence->getName().c_str(), index);
+
+	FrameCache::iterator it = _frameCache.find(key);
+	if (it != _frameCache.end()) {
+		it->_value.lastUse = ++_frameCacheUseCounter;
+		return it->_value.frame;
+	}
+
+	AnimFrame *frame = sequence->getFrame(index);
+	if (!frame)
+		return nullptr;
+
+	uint32 size = frame->getDataSize();
+
+	// Make room for the new frame, dropping the least recently used ones
+	while (!_frameCache.empty() && _frameCacheSize + size > _frameCacheMaxSize) {
+		FrameCache::iterator oldest = _frameCache.begin();
+		for (FrameCache::iterator i = _frameCache.begin(); i != _frameCache.end(); ++i)
+			if (i->_value.lastUse < oldest->_value.lastUse)
+				oldest = i;
+
+		_frameCacheSize -= oldest->_value.frame->getDataSize();
+		delete oldest->_value.frame;
+		_frameCache.erase(oldest);
+	}
+
+	CachedFrame cached;
+	cached.frame = frame;
+	cached.lastUse = ++_frameCacheUseCounter;
+	_frameCache[key] = cached;
+	_frameCacheSize += size;
+
+	return frame;
+}
+
+void ResourceManager::clearFrameCache() {
+	for (FrameCache::iterator it = _frameCache.begin(); it != _frameCache.end(); ++it)
+		delete it->_value.frame;
+
+	_frameCache.clear();
+	_frameCacheSize = 0;
+}
+
 } // End of namespace LastExpress
@@ -26,12 +26,16 @@
 #include "lastexpress/shared.h"
 
 #include "common/array.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
 
 namespace LastExpress {
 
+class AnimFrame;
 class Background;
 class Cursor;
 class Font;
+class Sequence;
 
 class ResourceManager : public Common::Archive {
 public:
@@ -54,9 +58,25 @@ public:
 	Cursor *loadCursor() const;
 	Font *loadFont() const;
 
+	// Decoded sequence frames (owned by the resource manager)
+	AnimFrame *getSequenceFrame(Sequence *sequence, uint16 index);
+	void clearFrameCache();
+
 private:
+	struct CachedFrame {
+		AnimFrame *frame;
+		uint32 lastUse;
+	};
+
+	typedef Common::HashMap<Common::String, CachedFrame> FrameCache;
+
 	bool _isDemo;
 
+	FrameCache _frameCache;
+	uint32 _frameCacheSize;
+	uint32 _frameCacheMaxSize;
+	uint32 _frameCacheUseCounter;
+
 	bool loadArchive(const Common::Path &name);
 	void reset();
 
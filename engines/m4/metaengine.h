@@ -51,6 +51,9 @@ public:
 	const ADExtraGuiOptionsMap *getAdvancedExtraGuiOptions() const override;
 
 	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveListInfos(const char *target, int slot) const override {
+		return querySaveMetaInfos(target, slot);
+	}
 
 	/**
 	 * Convert the current screen contents to a thumbnail. Can be overriden by individual
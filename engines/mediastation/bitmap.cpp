@@ -22,6 +22,7 @@
 #include "mediastation/datum.h"
 #include "mediastation/bitmap.h"
 #include "mediastation/debugchannels.h"
+#include "mediastation/mediastation.h"
 
 namespace MediaStation {
 
@@ -52,7 +53,26 @@ Bitmap::Bitmap(Chunk &chunk, BitmapHeader *bitmapHeader) :
 	// The header must be constructed beforehand.
 	uint16 width = _bitmapHeader->_dimensions->x;
 	uint16 height = _bitmapHeader->_dimensions->y;
-	_surface.create(width, height, Graphics::PixelFormat::createFormatCLUT8());
+
+	// Contexts are read again whenever a screen is revisited, so reuse the
+	// image if it was decoded before. The data is identified by where it is
+	// in the context file.
+	const Graphics::DecodedImageCache::Key key(chunk._sourceName, chunk.pos(), _bitmapHeader->_compressionType);
+	if (!chunk._sourceName.empty())
+		_image = g_engine->_imageCache.get(key);
+	if (_image && _image->w == width && _image->h == height) {
+		_surface.create(*_image, Common::Rect(width, height));
+		_surface.setTransparentColor(0);
+		chunk.skip(chunk.bytesRemaining());
+		return;
+	}
+
+	Graphics::ManagedSurface *image = new Graphics::ManagedSurface(width, height, Graphics::PixelFormat::createFormatCLUT8());
+	if (chunk._sourceName.empty())
+		_image = Graphics::DecodedImageCache::ImagePtr(image);
+	else
+		_image = g_engine->_imageCache.store(key, image);
+	_surface.create(*_image, Common::Rect(width, height));
 	_surface.setTransparentColor(0);
 	uint8 *pixels = (uint8 *)_surface.getPixels();
 	if (_bitmapHeader->isCompressed()) {
@@ -23,6 +23,7 @@
 #define MEDIASTATION_BITMAP_H
 
 #include "common/rect.h"
+#include "graphics/decoded_image_cache.h"
 #include "graphics/managed_surface.h"
 
 #include "mediastation/datafile.h"
@@ -58,9 +59,13 @@ public:
 
 	uint16 width();
 	uint16 height();
+	// Refers to the decoded image, which is shared through the engine's
+	// image cache with the other bitmaps of the same data.
 	Graphics::ManagedSurface _surface;
 
 private:
+	Graphics::DecodedImageCache::ImagePtr _image;
+
 	void decompress(Chunk &chunk);
 };
 
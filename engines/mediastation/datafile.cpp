@@ -24,7 +24,8 @@
 
 namespace MediaStation {
 
-Chunk::Chunk(Common::SeekableReadStream *stream) : _parentStream(stream) {
+Chunk::Chunk(Common::SeekableReadStream *stream, const Common::String &sourceName) :
+	_sourceName(sourceName), _parentStream(stream) {
 	_id = _parentStream->readUint32BE();
 	_length = _parentStream->readUint32LE();
 	_dataStartOffset = pos();
@@ -62,7 +63,8 @@ bool Chunk::seek(int64 offset, int whence) {
 	return true;
 }
 
-Subfile::Subfile(Common::SeekableReadStream *stream) : _stream(stream) {
+Subfile::Subfile(Common::SeekableReadStream *stream, const Common::String &sourceName) :
+	_stream(stream), _sourceName(sourceName) {
 	// Verify file signature.
 	debugC(5, kDebugLoading, "\n*** Subfile::Subfile(): Got new subfile (@0x%llx) ***", static_cast<long long int>(_stream->pos()));
 	_rootChunk = nextChunk();
@@ -91,7 +93,7 @@ Chunk Subfile::nextChunk() {
 	if (_stream->pos() & 1)
 		_stream->skip(1);
 
-	_currentChunk = Chunk(_stream);
+	_currentChunk = Chunk(_stream, _sourceName);
 	return _currentChunk;
 }
 
@@ -107,7 +109,7 @@ Datafile::Datafile(const Common::Path &path) {
 }
 
 Subfile Datafile::getNextSubfile() {
-	return Subfile(_handle);
+	return Subfile(_handle, _name);
 }
 
 } // End of namespace MediaStation
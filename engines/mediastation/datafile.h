@@ -39,12 +39,14 @@ namespace MediaStation {
 class Chunk : public Common::SeekableReadStream {
 public:
 	Chunk() = default;
-	Chunk(Common::SeekableReadStream *stream);
+	Chunk(Common::SeekableReadStream *stream, const Common::String &sourceName = Common::String());
 
 	uint32 bytesRemaining();
 
 	uint32 _id = 0;
 	uint32 _length = 0;
+	// The name of the file this chunk was read from, to identify its data.
+	Common::String _sourceName;
 
 	// ReadStream implementation
 	virtual bool eos() const { return _parentStream->eos(); };
@@ -65,7 +67,7 @@ private:
 class Subfile {
 public:
 	Subfile() = default;
-	Subfile(Common::SeekableReadStream *stream);
+	Subfile(Common::SeekableReadStream *stream, const Common::String &sourceName = Common::String());
 
 	Chunk nextChunk();
 	bool atEnd();
@@ -75,6 +77,7 @@ public:
 
 private:
 	Common::SeekableReadStream *_stream = nullptr;
+	Common::String _sourceName;
 	Chunk _rootChunk;
 };
 
@@ -37,6 +37,7 @@ namespace MediaStation {
 MediaStationEngine *g_engine;
 
 MediaStationEngine::MediaStationEngine(OSystem *syst, const ADGameDescription *gameDesc) : Engine(syst),
+	_imageCache(32 * 1024 * 1024),
 	_gameDescription(gameDesc),
 	_randomSource("MediaStation") {
 	g_engine = this;
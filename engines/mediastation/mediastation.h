@@ -34,6 +34,7 @@
 #include "common/util.h"
 #include "engines/engine.h"
 #include "engines/savestate.h"
+#include "graphics/decoded_image_cache.h"
 #include "graphics/screen.h"
 
 #include "mediastation/detection.h"
@@ -92,6 +93,8 @@ public:
 
 	Graphics::Screen *_screen = nullptr;
 	Context *_currentContext = nullptr;
+	// Decoded bitmaps, kept when their contexts are released.
+	Graphics::DecodedImageCache _imageCache;
 
 	Common::Point _mousePos;
 	Common::Array<Common::Rect> _dirtyRects;
@@ -382,7 +382,9 @@ SaveStateList MetaEngine::listSaves(const char *target) const {
 		int slotNum = atoi(slotStr);
 
 		if (slotNum >= 0 && slotNum <= getMaximumSaveSlot()) {
-			SaveStateDescriptor desc = querySaveMetaInfos(target, slotNum);
+			// Thumbnails are decoded through querySaveMetaInfos for the
+			// items the chooser displays, the list does not need them
+			SaveStateDescriptor desc = querySaveListInfos(target, slotNum);
 			if (desc.getSaveSlot() != -1) {
 				saveList.push_back(desc);
 			}
@@ -449,26 +451,35 @@ bool MetaEngine::removeSaveState(const char *target, int slot) const {
 	return g_system->getSavefileManager()->removeSavefile(getSavegameFile(slot, target));
 }
 
-SaveStateDescriptor MetaEngine::querySaveMetaInfos(const char *target, int slot) const {
-	if (!hasFeature(kSavesUseExtendedFormat))
+static SaveStateDescriptor readExtendedSaveMetaInfos(const MetaEngine *metaEngine, const char *target, int slot, bool skipThumbnail) {
+	if (!metaEngine->hasFeature(MetaEngine::kSavesUseExtendedFormat))
 		return SaveStateDescriptor();
 
 	Common::ScopedPtr<Common::InSaveFile> f(g_system->getSavefileManager()->openForLoading(
-		getSavegameFile(slot, target)));
+		metaEngine->getSavegameFile(slot, target)));
 
 	if (f) {
 		ExtendedSavegameHeader header;
-		if (!readSavegameHeader(f.get(), &header, false)) {
+		if (!MetaEngine::readSavegameHeader(f.get(), &header, skipThumbnail)) {
 			return SaveStateDescriptor();
 		}
 
 		// Create the return descriptor
-		SaveStateDescriptor desc(this, slot, Common::U32String());
-		parseSavegameHeader(&header, &desc);
-		desc.setThumbnail(header.thumbnail);
+		SaveStateDescriptor desc(metaEngine, slot, Common::U32String());
+		MetaEngine::parseSavegameHeader(&header, &desc);
+		if (!skipThumbnail)
+			desc.setThumbnail(header.thumbnail);
 		desc.setAutosave(header.isAutosave);
 		return desc;
 	}
 
 	return SaveStateDescriptor();
 }
+
+SaveStateDescriptor MetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+	return readExtendedSaveMetaInfos(this, target, slot, false);
+}
+
+SaveStateDescriptor MetaEngine::querySaveListInfos(const char *target, int slot) const {
+	return readExtendedSaveMetaInfos(this, target, slot, true);
+}
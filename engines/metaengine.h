@@ -358,6 +358,19 @@ public:
 	 */
 	virtual SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const;
 
+	/**
+	 * Return meta information from the specified save state for the list
+	 * returned by the default listSaves(), which does not need thumbnails.
+	 *
+	 * The default implementation reads the extended savegame header without
+	 * decoding its thumbnail. Engines which override querySaveMetaInfos() to
+	 * add or change information must override this as well.
+	 *
+	 * @param target  Name of a config manager target.
+	 * @param slot    Slot number of the save state.
+	 */
+	virtual SaveStateDescriptor querySaveListInfos(const char *target, int slot) const;
+
 	/**
 	 * Return the name of the save file for the given slot and optional target,
 	 * or a pattern for matching filenames against.
@@ -67,7 +67,7 @@ void MohawkSurface::convertToTrueColor() {
 	_surface = surface;
 }
 
-GraphicsManager::GraphicsManager() {
+GraphicsManager::GraphicsManager() : _cacheUseCounter(0) {
 }
 
 GraphicsManager::~GraphicsManager() {
@@ -75,8 +75,8 @@ GraphicsManager::~GraphicsManager() {
 }
 
 void GraphicsManager::clearCache() {
-	for (Common::HashMap<uint16, MohawkSurface *>::iterator it = _cache.begin(); it != _cache.end(); it++)
-		delete it->_value;
+	for (Common::HashMap<uint16, CachedImage>::iterator it = _cache.begin(); it != _cache.end(); it++)
+		delete it->_value.surface;
 	for (Common::HashMap<uint16, Common::Array<MohawkSurface *> >::iterator it = _subImageCache.begin(); it != _subImageCache.end(); it++) {
 		Common::Array<MohawkSurface *> &array = it->_value;
 		for (uint i = 0; i < array.size(); i++)
@@ -87,16 +87,36 @@ void GraphicsManager::clearCache() {
 	_subImageCache.clear();
 }
 
-MohawkSurface *GraphicsManager::findImage(uint16 id) {
-	if (!_cache.contains(id))
-		_cache[id] = decodeImage(id);
+void GraphicsManager::trimCache(uint32 maxSize) {
+	uint32 size = 0;
+	for (Common::HashMap<uint16, CachedImage>::iterator it = _cache.begin(); it != _cache.end(); it++) {
+		Graphics::Surface *surface = it->_value.surface->getSurface();
+		size += surface->pitch * surface->h;
+	}
+
+	while (size > maxSize) {
+		Common::HashMap<uint16, CachedImage>::iterator oldest = _cache.begin();
+		for (Common::HashMap<uint16, CachedImage>::iterator it = _cache.begin(); it != _cache.end(); it++)
+			if (it->_value.lastUse < oldest->_value.lastUse)
+				oldest = it;
+
+		Graphics::Surface *surface = oldest->_value.surface->getSurface();
+		size -= surface->pitch * surface->h;
+		delete oldest->_value.surface;
+		_cache.erase(oldest);
+	}
+}
 
-	// TODO: Probably would be nice to limit the size of the cache
-	// Currently, this can't get large because it is freed on every
-	// card/stack change in Myst/Riven so I'm not worried about it.
-	// Doesn't mean this shouldn't be done in the future.
+MohawkSurface *GraphicsManager::findImage(uint16 id) {
+	if (!_cache.contains(id)) {
+		CachedImage image;
+		image.surface = decodeImage(id);
+		_cache[id] = image;
+	}
 
-	return _cache[id];
+	CachedImage &image = _cache[id];
+	image.lastUse = ++_cacheUseCounter;
+	return image.surface;
 }
 
 Common::Array<MohawkSurface *> GraphicsManager::decodeImages(uint16 id) {
@@ -226,7 +246,10 @@ void GraphicsManager::addImageToCache(uint16 id, MohawkSurface *surface) {
 	if (_cache.contains(id))
 		error("Image %d already in cache", id);
 
-	_cache[id] = surface;
+	CachedImage image;
+	image.surface = surface;
+	image.lastUse = ++_cacheUseCounter;
+	_cache[id] = image;
 }
 
 } // End of namespace Mohawk
@@ -73,6 +73,10 @@ public:
 	// Free all surfaces in the cache
 	void clearCache();
 
+	// Free the least recently used surfaces until those left in the cache
+	// take at most maxSize bytes
+	void trimCache(uint32 maxSize);
+
 	// findImage will search the cache to find the image.
 	// If not found, it will call decodeImage to get a new one.
 	MohawkSurface *findImage(uint16 id);
@@ -96,8 +100,14 @@ protected:
 	void addImageToCache(uint16 id, MohawkSurface *surface);
 
 private:
-	// An image cache that stores images until clearCache() is called
-	Common::HashMap<uint16, MohawkSurface *> _cache;
+	struct CachedImage {
+		MohawkSurface *surface;
+		uint32 lastUse;
+	};
+
+	// An image cache that stores images until clearCache() or trimCache() is called
+	Common::HashMap<uint16, CachedImage> _cache;
+	uint32 _cacheUseCounter;
 	Common::HashMap<uint16, Common::Array<MohawkSurface *> > _subImageCache;
 };
 
@@ -610,12 +610,15 @@ static const RivenSpecialChange rivenSpecialChange[] = {
 	{ kStackTspit, 0x21b69, kStackOspit,  0x2e76 }  // Dome Linking Book
 };
 
+// Size of the decoded images kept from one card to the next, about 25 full screens
+static const uint32 kImageCacheSize = 24 * 1024 * 1024;
+
 void MohawkEngine_Riven::changeToCard(uint16 dest) {
 	debug (1, "Changing to card %d", dest);
 
-	// Clear the graphics cache (images typically aren't used
-	// on different cards).
-	_gfx->clearCache();
+	// Keep the most recently used images of the stack, as neighboring
+	// cards often show the same ones again when walking back and forth.
+	_gfx->trimCache(kImageCacheSize);
 
 	if (!isGameVariant(GF_DEMO)) {
 		for (byte i = 0; i < ARRAYSIZE(rivenSpecialChange); i++)
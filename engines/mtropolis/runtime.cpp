@@ -6197,6 +6197,7 @@ CORO_BEGIN_DEFINITION(Runtime::SendMessageToStructuralCoroutine)
 	struct Locals {
 		const Common::Array<Common::SharedPtr<Structural> > *childrenArray = nullptr;
 		uint childIndex = 0;
+		Structural *child = nullptr;
 	};
 
 	CORO_BEGIN_FUNCTION
@@ -6222,13 +6223,20 @@ CORO_BEGIN_DEFINITION(Runtime::SendMessageToStructuralCoroutine)
 			CORO_END_IF
 		CORO_END_IF
 
-		// Send to children if cascade
+		// Send to children if cascade.  Loaded leaves which have no modifiers and don't
+		// respond themselves can't do anything with the message, so they are skipped
+		// without starting a coroutine for them.
 		CORO_IF(params->dispatch->isCascade())
 			CORO_FOR((locals->childrenArray = &params->structural->getChildren()), (locals->childIndex < locals->childrenArray->size()), (locals->childIndex++))
-				CORO_CALL(Runtime::SendMessageToStructuralCoroutine, params->runtime, params->isTerminatedPtr, (*locals->childrenArray)[locals->childIndex].get(), params->dispatch);
+				locals->child = (*locals->childrenArray)[locals->childIndex].get();
 
-				CORO_IF (*params->isTerminatedPtr)
-					CORO_RETURN;
+				CORO_IF (locals->child->getSceneLoadState() == Structural::SceneLoadState::kSceneNotLoaded || locals->child->getModifiers().size() > 0
+						|| locals->child->getChildren().size() > 0 || locals->child->respondsToEvent(params->dispatch->getMsg()->getEvent()))
+					CORO_CALL(Runtime::SendMessageToStructuralCoroutine, params->runtime, params->isTerminatedPtr, locals->child, params->dispatch);
+
+					CORO_IF (*params->isTerminatedPtr)
+						CORO_RETURN;
+					CORO_END_IF
 				CORO_END_IF
 			CORO_END_FOR
 		CORO_END_IF
@@ -6239,13 +6247,20 @@ CORO_BEGIN_DEFINITION(Runtime::SendMessageToModifierContainerCoroutine)
 	struct Locals {
 		const Common::Array<Common::SharedPtr<Modifier> > *childrenArray = nullptr;
 		uint childIndex = 0;
+		Modifier *modifier = nullptr;
 	};
 
 	CORO_BEGIN_FUNCTION
 		locals->childrenArray = &params->modifierContainer->getModifiers();
 
 		CORO_FOR((locals->childIndex = 0), (locals->childIndex < locals->childrenArray->size() && !*(params->isTerminatedPtr)), (locals->childIndex++))
-			CORO_CALL(SendMessageToModifierCoroutine, params->runtime, params->isTerminatedPtr, (*locals->childrenArray)[locals->childIndex].get(), params->dispatch);
+			locals->modifier = (*locals->childrenArray)[locals->childIndex].get();
+
+			// Modifiers which neither respond nor pass the message on to children are skipped
+			// without starting a coroutine for them
+			CORO_IF (locals->modifier->getMessagePropagationContainer() || locals->modifier->respondsToEvent(params->dispatch->getMsg()->getEvent()))
+				CORO_CALL(SendMessageToModifierCoroutine, params->runtime, params->isTerminatedPtr, locals->modifier, params->dispatch);
+			CORO_END_IF
 		CORO_END_FOR
 	CORO_END_FUNCTION
 CORO_END_DEFINITION
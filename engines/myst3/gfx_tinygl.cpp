@@ -272,16 +272,7 @@ Graphics::Surface *TinyGLRenderer::getScreenshot() {
 void TinyGLRenderer::flipBuffer() {
 	Common::List<Common::Rect> dirtyAreas;
 	TinyGL::presentBuffer(dirtyAreas);
-
-	Graphics::Surface glBuffer;
-	TinyGL::getSurfaceRef(glBuffer);
-
-	if (!dirtyAreas.empty()) {
-		for (Common::List<Common::Rect>::iterator itRect = dirtyAreas.begin(); itRect != dirtyAreas.end(); ++itRect) {
-			g_system->copyRectToScreen(glBuffer.getBasePtr((*itRect).left, (*itRect).top), glBuffer.pitch,
-			                           (*itRect).left, (*itRect).top, (*itRect).width(), (*itRect).height());
-		}
-	}
+	TinyGL::copyToScreen(dirtyAreas);
 }
 
 } // End of namespace Myst3
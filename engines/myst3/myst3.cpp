@@ -1443,12 +1443,20 @@ Graphics::Surface *Myst3Engine::loadTexture(uint16 id) {
 Graphics::Surface *Myst3Engine::decodeJpeg(const ResourceDescription *jpegDesc) {
 	Common::SeekableReadStream *jpegStream = jpegDesc->getData();
 
+	Graphics::Surface *bitmap = decodeJpeg(jpegStream);
+	if (!bitmap)
+		error("Could not decode Myst III JPEG");
+	delete jpegStream;
+
+	return bitmap;
+}
+
+Graphics::Surface *Myst3Engine::decodeJpeg(Common::SeekableReadStream *jpegStream) {
 	Image::JPEGDecoder jpeg;
 	jpeg.setOutputPixelFormat(Texture::getRGBAPixelFormat());
 
 	if (!jpeg.loadStream(*jpegStream))
-		error("Could not decode Myst III JPEG");
-	delete jpegStream;
+		return nullptr;
 
 	const Graphics::Surface *bitmap = jpeg.getSurface();
 	assert(bitmap->format == Texture::getRGBAPixelFormat());
@@ -133,6 +133,8 @@ public:
 
 	Graphics::Surface *loadTexture(uint16 id);
 	static Graphics::Surface *decodeJpeg(const ResourceDescription *jpegDesc);
+	/** Decode a JPEG image, returns nullptr on failure. Safe to call from a job. */
+	static Graphics::Surface *decodeJpeg(Common::SeekableReadStream *jpegStream);
 
 	void goToNode(uint16 nodeID, TransitionType transition);
 	void loadNode(uint16 nodeID, uint32 roomID = 0, uint32 ageID = 0);
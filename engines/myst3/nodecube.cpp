@@ -24,21 +24,51 @@
 #include "engines/myst3/myst3.h"
 
 #include "common/debug.h"
+#include "common/jobs.h"
+#include "common/system.h"
 
 namespace Myst3 {
 
+struct CubeFacesDecodeJob {
+	Common::SeekableReadStream *streams[6];
+	Graphics::Surface *bitmaps[6];
+};
+
+static void decodeCubeFacesProc(uint begin, uint end, void *refCon) {
+	CubeFacesDecodeJob *job = (CubeFacesDecodeJob *)refCon;
+
+	for (uint i = begin; i < end; i++) {
+		job->bitmaps[i] = Myst3Engine::decodeJpeg(job->streams[i]);
+	}
+}
+
 NodeCube::NodeCube(Myst3Engine *vm, uint16 id) :
 		Node(vm, id) {
 	_is3D = true;
 
+	// The archive is read sequentially, the JPEG decoding of the faces
+	// is then spread over the job system
+	CubeFacesDecodeJob job;
 	for (int i = 0; i < 6; i++) {
 		ResourceDescription jpegDesc = _vm->getFileDescription("", id, i + 1, Archive::kCubeFace);
 
 		if (!jpegDesc.isValid())
 			error("Face %d does not exist", id);
 
+		job.streams[i] = jpegDesc.getData();
+		job.bitmaps[i] = nullptr;
+	}
+
+	g_system->getJobSystem()->parallelFor(6, decodeCubeFacesProc, &job);
+
+	for (int i = 0; i < 6; i++) {
+		delete job.streams[i];
+
+		if (!job.bitmaps[i])
+			error("Could not decode Myst III JPEG");
+
 		_faces[i] = new Face(_vm, true);
-		_faces[i]->setTextureFromJPEG(&jpegDesc);
+		_faces[i]->setTextureFromBitmap(job.bitmaps[i]);
 	}
 }
 
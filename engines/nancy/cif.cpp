@@ -183,6 +183,10 @@ CifTree::CifTree(Common::SeekableReadStream *stream, const Common::Path &name) :
 		_name(name) {}
 
 CifTree::~CifTree() {
+	for (auto &i : _imageCache) {
+		free(i._value.data);
+	}
+
 	delete _stream;
 }
 
@@ -216,8 +220,16 @@ Common::SeekableReadStream *CifTree::createReadStreamForMember(const Common::Pat
 	}
 
 	const CifInfo &info = _fileMap[path];
+	const bool cacheable = info.type == CifInfo::kResTypeImage && info.comp == CifInfo::kResCompression && info.size <= kImageCacheSize / 4;
 	byte *buf = (byte *)malloc(info.size);
 
+	if (cacheable && _imageCache.contains(path)) {
+		CachedImage &cached = _imageCache[path];
+		cached.lastUse = ++_imageCacheUseCounter;
+		memcpy(buf, cached.data, info.size);
+		return new Common::MemoryReadStream(buf, info.size, DisposeAfterUse::YES);
+	}
+
 	bool success = true;
 
 	if (info.comp == CifInfo::kResCompression) {
@@ -244,9 +256,36 @@ Common::SeekableReadStream *CifTree::createReadStreamForMember(const Common::Pat
 		return nullptr;
 	}
 
+	if (cacheable) {
+		addToImageCache(path, buf, info.size);
+	}
+
 	return new Common::MemoryReadStream(buf, info.size, DisposeAfterUse::YES);
 }
 
+void CifTree::addToImageCache(const Common::Path &path, const byte *data, uint32 size) const {
+	// Drop the least recently used images until the new one fits
+	while (!_imageCache.empty() && _imageCacheSize + size > kImageCacheSize) {
+		auto oldest = _imageCache.begin();
+		for (auto i = _imageCache.begin(); i != _imageCache.end(); ++i) {
+			if (i->_value.lastUse < oldest->_value.lastUse) {
+				oldest = i;
+			}
+		}
+
+		_imageCacheSize -= _fileMap[oldest->_key].size;
+		free(oldest->_value.data);
+		_imageCache.erase(oldest);
+	}
+
+	CachedImage cached;
+	cached.data = (byte *)malloc(size);
+	memcpy(cached.data, data, size);
+	cached.lastUse = ++_imageCacheUseCounter;
+	_imageCache[path] = cached;
+	_imageCacheSize += size;
+}
+
 Common::SeekableReadStream *CifTree::createReadStreamRaw(const Common::Path &path) const {
 	if (!hasFile(path)) {
 		return nullptr;
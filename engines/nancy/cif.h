@@ -101,13 +101,27 @@ public:
 	static CifTree *makeCifTreeArchive(const Common::String &name, const Common::String &ext);
 
 private:
+	// Decompressed images are kept until they take more than this, and then the least
+	// recently used ones are dropped. Scenes often show the same backgrounds again.
+	enum { kImageCacheSize = 16 * 1024 * 1024 };
+
+	struct CachedImage {
+		byte *data = nullptr;
+		uint32 lastUse = 0;
+	};
+
 	bool sync(Common::Serializer &ser);
 	Common::SeekableReadStream *createReadStreamRaw(const Common::Path &path) const;
+	void addToImageCache(const Common::Path &path, const byte *data, uint32 size) const;
 
 	Common::Path _name;
 	Common::SeekableReadStream *_stream;
 	Common::HashMap<Common::Path, CifInfo, Common::Path::IgnoreCase_Hash, Common::Path::IgnoreCase_EqualTo> _fileMap;
 	Common::Array<CifInfo> _writeFileMap;
+
+	mutable Common::HashMap<Common::Path, CachedImage, Common::Path::IgnoreCase_Hash, Common::Path::IgnoreCase_EqualTo> _imageCache;
+	mutable uint32 _imageCacheSize = 0;
+	mutable uint32 _imageCacheUseCounter = 0;
 };
 
 // Ciftree that only provides a file if a certain ConfMan flag is true. Used for handling game patches
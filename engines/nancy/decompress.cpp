@@ -28,6 +28,7 @@ namespace Nancy {
 
 Decompressor::Decompressor() :
 	_bufpos(0),
+	_outBufPos(0),
 	_err(false),
 	_val(0),
 	_output(nullptr),
@@ -42,6 +43,7 @@ Decompressor::~Decompressor() {
 void Decompressor::init(Common::SeekableReadStream &input, Common::WriteStream &output) {
 	memset(_buf, ' ', kBufSize);
 	_bufpos = kBufStart;
+	_outBufPos = 0;
 	_err = false;
 	_val = 0;
 
@@ -62,12 +64,40 @@ bool Decompressor::readByte(byte &b) {
 }
 
 bool Decompressor::writeByte(byte b) {
-	_output->writeByte(b);
+	_outBuf[_outBufPos++] = b;
+	if (_outBufPos == kOutBufSize)
+		flush();
+
 	_buf[_bufpos++] = b;
 	_bufpos &= kBufSize - 1;
 	return true;
 }
 
+void Decompressor::copyBytes(uint16 offset, uint16 len) {
+	uint distance = (_bufpos - offset) & (kBufSize - 1);
+
+	// Copy the whole run at once when neither the source nor the destination wraps
+	// around the buffer, and they don't overlap
+	if (offset + len <= kBufSize && _bufpos + len <= kBufSize && _outBufPos + len <= kOutBufSize
+			&& distance >= len && distance <= (uint)(kBufSize - len)) {
+		memcpy(_buf + _bufpos, _buf + offset, len);
+		memcpy(_outBuf + _outBufPos, _buf + offset, len);
+		_bufpos = (_bufpos + len) & (kBufSize - 1);
+		_outBufPos += len;
+		if (_outBufPos == kOutBufSize)
+			flush();
+		return;
+	}
+
+	for (uint i = 0; i < len; i++)
+		writeByte(_buf[(offset + i) & (kBufSize - 1)]);
+}
+
+void Decompressor::flush() {
+	_output->write(_outBuf, _outBufPos);
+	_outBufPos = 0;
+}
+
 bool Decompressor::decompress(Common::SeekableReadStream &input, Common::MemoryWriteStream &output) {
 	init(input, output);
 	uint16 bits = 0;
@@ -104,11 +134,12 @@ bool Decompressor::decompress(Common::SeekableReadStream &input, Common::MemoryW
 			uint16 offset = b | ((b2 & 0xf0) << 4);
 			uint16 len = (b2 & 0xf) + 3;
 
-			for (uint i = 0; i < len; i++)
-				writeByte(_buf[(offset + i) & (kBufSize - 1)]);
+			copyBytes(offset, len);
 		}
 	}
 
+	flush();
+
 	if (output.err() || output.pos() != output.size()) {
 		// Workaround for nancy3 file "SLN RollPanOpn.avf", which outputs 2 bytes less than it should
 		if (output.size() - output.pos() <= 2) {
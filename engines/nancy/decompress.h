@@ -44,15 +44,22 @@ public:
 private:
 	enum {
 		kBufSize = 4096,
-		kBufStart = 4078
+		kBufStart = 4078,
+		kOutBufSize = 4096
 	};
 
 	void init(Common::SeekableReadStream &input, Common::WriteStream &output);
 	bool readByte(byte &b);
 	bool writeByte(byte b);
+	void copyBytes(uint16 offset, uint16 len);
+	void flush();
 
 	byte _buf[kBufSize];
 	uint _bufpos;
+
+	// Output is gathered here and written in blocks, rather than a byte at a time
+	byte _outBuf[kOutBufSize];
+	uint _outBufPos;
 	bool _err;
 	byte _val;
 	Common::WriteStream *_output;
@@ -112,6 +112,9 @@ public:
 
 	int getMaximumSaveSlot() const override;
 	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveListInfos(const char *target, int slot) const override {
+		return querySaveMetaInfos(target, slot);
+	}
 
 	Common::KeymapArray initKeymaps(const char *target) const override;
 
@@ -0,0 +1,167 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/config-manager.h"
+#include "common/file.h"
+#include "common/tokenizer.h"
+#include "common/formats/json.h"
+
+#include "playground3d/playground3d.h"
+
+namespace Playground3d {
+
+struct BenchmarkTest {
+	int id;
+	const char *name;
+	uint32 triangles; // Triangles drawn per frame
+};
+
+static const BenchmarkTest benchmarkTests[] = {
+	{ 1, "cube",          12 },
+	{ 2, "poly_offset",    2 },
+	{ 3, "dim_region",     2 },
+	{ 4, "viewport",       4 },
+	{ 5, "rgba_texture",  10 }
+};
+
+static const BenchmarkTest *findBenchmarkTest(int id) {
+	for (uint i = 0; i < ARRAYSIZE(benchmarkTests); i++) {
+		if (benchmarkTests[i].id == id)
+			return &benchmarkTests[i];
+	}
+	return nullptr;
+}
+
+/**
+ * Run the tests listed in "benchmark_tests" for "benchmark_frames" frames
+ * each, without the frame limiter, and write the timings to the JSON file
+ * set by "benchmark_output".
+ *
+ * The time of each frame is split into submitting the drawing commands,
+ * waiting for them to be rendered, which is the rasterization itself for
+ * TinyGL, and presenting the frame.
+ */
+void Playground3dEngine::runBenchmark() {
+	Common::Array<const BenchmarkTest *> tests;
+	if (ConfMan.hasKey("benchmark_tests")) {
+		Common::StringTokenizer tokenizer(ConfMan.get("benchmark_tests"), " ,");
+		while (!tokenizer.empty()) {
+			Common::String token = tokenizer.nextToken();
+			const BenchmarkTest *test = findBenchmarkTest(atoi(token.c_str()));
+			if (test)
+				tests.push_back(test);
+			else
+				warning("Unknown benchmark test '%s'", token.c_str());
+		}
+	} else {
+		for (uint i = 0; i < ARRAYSIZE(benchmarkTests); i++)
+			tests.push_back(&benchmarkTests[i]);
+	}
+
+	int frames = ConfMan.hasKey("benchmark_frames") ? ConfMan.getInt("benchmark_frames") : 1000;
+	if (frames <= 0)
+		frames = 1000;
+
+	Common::Rect vp = _gfx->viewport();
+
+	Common::JSONArray results;
+	for (uint i = 0; i < tests.size() && !shouldQuit(); i++) {
+		const BenchmarkTest *test = tests[i];
+		setupTest(test->id);
+
+		// Pixels filled or texels uploaded per frame, for the tests which measure them
+		uint64 pixels = 0;
+		if (test->id == 3)
+			pixels = (uint64)vp.width() * vp.height();
+		else if (test->id == 5)
+			pixels = 5 * 120 * 120;
+
+		// Draw a frame first, so that one-time setup isn't measured
+		drawScene(test->id);
+		_gfx->flipBuffer();
+		_gfx->finish();
+		_system->updateScreen();
+
+		uint64 submitTime = 0, renderTime = 0, presentTime = 0;
+		int frame;
+		for (frame = 0; frame < frames && !shouldQuit(); frame++) {
+			processInput();
+
+			uint64 start = _system->getMicros();
+			drawScene(test->id);
+			uint64 submitted = _system->getMicros();
+			_gfx->flipBuffer();
+			_gfx->finish();
+			uint64 rendered = _system->getMicros();
+			_system->updateScreen();
+			uint64 presented = _system->getMicros();
+
+			submitTime += submitted - start;
+			renderTime += rendered - submitted;
+			presentTime += presented - rendered;
+		}
+
+		uint64 totalTime = submitTime + renderTime + presentTime;
+		double seconds = MAX<uint64>(totalTime, 1) / 1000000.0;
+		double drawSeconds = MAX<uint64>(submitTime + renderTime, 1) / 1000000.0;
+
+		Common::JSONObject result;
+		result["id"] = new Common::JSONValue((long long int)test->id);
+		result["name"] = new Common::JSONValue(test->name);
+		result["frames"] = new Common::JSONValue((long long int)frame);
+		result["submit_ms"] = new Common::JSONValue(submitTime / 1000.0);
+		result["render_ms"] = new Common::JSONValue(renderTime / 1000.0);
+		result["present_ms"] = new Common::JSONValue(presentTime / 1000.0);
+		result["fps"] = new Common::JSONValue(frame / seconds);
+		// The rates leave out presenting, as it may wait for vsync
+		result["triangles_per_second"] = new Common::JSONValue(frame * test->triangles / drawSeconds);
+		if (test->id == 3)
+			result["fill_pixels_per_second"] = new Common::JSONValue(frame * pixels / drawSeconds);
+		if (test->id == 5)
+			result["upload_texels_per_second"] = new Common::JSONValue(frame * pixels / drawSeconds);
+		results.push_back(new Common::JSONValue(result));
+
+		debug("Benchmark %s: %d frames, %.3f ms submit, %.3f ms render, %.3f ms present per frame",
+		      test->name, frame, submitTime / 1000.0 / MAX(frame, 1), renderTime / 1000.0 / MAX(frame, 1),
+		      presentTime / 1000.0 / MAX(frame, 1));
+	}
+
+	Common::JSONObject report;
+	report["renderer"] = new Common::JSONValue(_gfx->getName());
+	report["width"] = new Common::JSONValue((long long int)vp.width());
+	report["height"] = new Common::JSONValue((long long int)vp.height());
+	report["tests"] = new Common::JSONValue(results);
+	Common::JSONValue reportValue(report);
+
+	Common::String outputName = ConfMan.hasKey("benchmark_output") ? ConfMan.get("benchmark_output") : "playground3d_benchmark.json";
+	Common::DumpFile out;
+	if (!out.open(Common::Path(outputName, Common::Path::kNativeSeparator))) {
+		warning("Failed to open benchmark output file '%s'", outputName.c_str());
+		return;
+	}
+	out.writeString(reportValue.stringify(true));
+	out.writeByte('\n');
+	out.finalize();
+	out.close();
+}
+
+} // End of namespace Playground3d
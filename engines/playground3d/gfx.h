@@ -48,6 +48,16 @@ public:
 	 */
 	virtual void flipBuffer() { }
 
+	/**
+	 *  Wait until the drawing commands issued so far have completed
+	 */
+	virtual void finish() { }
+
+	/**
+	 *  Get a short name identifying the renderer, used in benchmark reports
+	 */
+	virtual const char *getName() const = 0;
+
 	Common::Rect viewport() const;
 
 	void setupCameraPerspective(float pitch, float heading, float fov);
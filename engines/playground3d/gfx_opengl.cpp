@@ -110,6 +110,10 @@ void OpenGLRenderer::clear(const Math::Vector4d &clearColor) {
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
+void OpenGLRenderer::finish() {
+	glFinish();
+}
+
 void OpenGLRenderer::loadTextureRGBA(Graphics::Surface *texture) {
 	glBindTexture(GL_TEXTURE_2D, _textureRgbaId[0]);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
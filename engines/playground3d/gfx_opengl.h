@@ -40,8 +40,10 @@ public:
 
 	void init() override;
 	void deinit() override;
+	const char *getName() const override { return "opengl"; }
 
 	void clear(const Math::Vector4d &clearColor) override;
+	void finish() override;
 	void loadTextureRGBA(Graphics::Surface *texture) override;
 	void loadTextureRGB(Graphics::Surface *texture) override;
 	void loadTextureRGB565(Graphics::Surface *texture) override;
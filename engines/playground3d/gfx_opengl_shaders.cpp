@@ -125,6 +125,10 @@ void ShaderRenderer::clear(const Math::Vector4d &clearColor) {
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
+void ShaderRenderer::finish() {
+	glFinish();
+}
+
 void ShaderRenderer::loadTextureRGBA(Graphics::Surface *texture) {
 	glBindTexture(GL_TEXTURE_2D, _textureRgbaId[0]);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -40,6 +40,7 @@ public:
 
 	void init() override;
 	void deinit() override;
+	const char *getName() const override { return "tinygl"; }
 
 	void clear(const Math::Vector4d &clearColor) override;
 	void loadTextureRGB(Graphics::Surface *texture) override;
@@ -5,6 +5,7 @@ MODULE_OBJS := \
 	gfx.o \
 	gfx_opengl.o \
 	gfx_opengl_shaders.o \
+	benchmark.o \
 	playground3d.o
 
 ifdef USE_TINYGL
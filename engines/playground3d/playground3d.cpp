@@ -76,12 +76,35 @@ Common::Error Playground3dEngine::run() {
 
 	_system->showMouse(true);
 
+	if (ConfMan.hasKey("benchmark") && ConfMan.getBool("benchmark")) {
+		runBenchmark();
+	} else {
+		int testId = 1;
+		setupTest(testId);
+
+		while (!shouldQuit()) {
+			processInput();
+			drawFrame(testId);
+		}
+	}
+
+	delete _rgbaTexture;
+	delete _rgbTexture;
+	delete _rgb565Texture;
+	delete _rgba5551Texture;
+	delete _rgba4444Texture;
+	_gfx->deinit();
+	_system->showMouse(false);
+
+	return Common::kNoError;
+}
+
+void Playground3dEngine::setupTest(int testId) {
 	// 1 - rotated colorfull cube
 	// 2 - rotated two triangles with depth offset
 	// 3 - fade in/out
 	// 4 - moving filled rectangle in viewport
 	// 5 - drawing RGBA pattern texture to check endian correctness
-	int testId = 1;
 	_fogEnable = false;
 
 	if (_fogEnable) {
@@ -104,6 +127,8 @@ Common::Error Playground3dEngine::run() {
 			break;
 		case 5: {
 			_clearColor = Math::Vector4d(0.5f, 0.5f, 0.5f, 1.0f);
+			if (_rgbaTexture)
+				break;
 #if defined(SCUMM_LITTLE_ENDIAN)
 			Graphics::PixelFormat pixelFormatRGBA(4, 8, 8, 8, 8, 0, 8, 16, 24);
 			Graphics::PixelFormat pixelFormatRGB(3, 8, 8, 8, 0, 0, 8, 16, 0);
@@ -124,21 +149,6 @@ Common::Error Playground3dEngine::run() {
 		default:
 			assert(false);
 	}
-
-	while (!shouldQuit()) {
-		processInput();
-		drawFrame(testId);
-	}
-
-	delete _rgbaTexture;
-	delete _rgbTexture;
-	delete _rgb565Texture;
-	delete _rgba5551Texture;
-	delete _rgba4444Texture;
-	_gfx->deinit();
-	_system->showMouse(false);
-
-	return Common::kNoError;
 }
 
 void Playground3dEngine::processInput() {
@@ -219,6 +229,16 @@ void Playground3dEngine::drawRgbaTexture() {
 }
 
 void Playground3dEngine::drawFrame(int testId) {
+	drawScene(testId);
+
+	_gfx->flipBuffer();
+
+	_frameLimiter->delayBeforeSwap();
+	_system->updateScreen();
+	_frameLimiter->startFrame();
+}
+
+void Playground3dEngine::drawScene(int testId) {
 	_gfx->clear(_clearColor);
 
 	float pitch = 0.0f;
@@ -257,12 +277,6 @@ void Playground3dEngine::drawFrame(int testId) {
 		default:
 			assert(false);
 	}
-
-	_gfx->flipBuffer();
-
-	_frameLimiter->delayBeforeSwap();
-	_system->updateScreen();
-	_frameLimiter->startFrame();
 }
 
 } // End of namespace Playground3d
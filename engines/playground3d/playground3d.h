@@ -44,6 +44,7 @@ public:
 	void processInput();
 
 	void drawFrame(int testId);
+	void runBenchmark();
 
 private:
 	OSystem *_system;
@@ -62,6 +63,8 @@ private:
 
 	float _rotateAngleX, _rotateAngleY, _rotateAngleZ;
 
+	void setupTest(int testId);
+	void drawScene(int testId);
 	Graphics::Surface *generateRgbaTexture(int width, int height, Graphics::PixelFormat format);
 	void drawAndRotateCube();
 	void drawPolyOffsetTest();
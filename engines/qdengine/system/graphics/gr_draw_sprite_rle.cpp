@@ -30,6 +30,46 @@
 
 namespace QDEngine {
 
+// Draw a run of one color. Without alpha, a zero pixel is transparent.
+static inline void drawRun565(uint16 *scr_buf, int dx, int len, uint32 pixel, bool alpha_flag) {
+	const byte *rle_buf = (const byte *)&pixel;
+	uint16 cl = grDispatcher::make_rgb565u(rle_buf[2], rle_buf[1], rle_buf[0]);
+
+	if (!alpha_flag) {
+		if (!pixel)
+			return;
+	} else {
+		uint32 a = rle_buf[3];
+		if (a == 255)
+			return;
+		if (a) {
+			for (int i = 0; i < len; i++, scr_buf += dx)
+				*scr_buf = grDispatcher::alpha_blend_565(cl, *scr_buf, a);
+			return;
+		}
+	}
+
+	for (int i = 0; i < len; i++, scr_buf += dx)
+		*scr_buf = cl;
+}
+
+// Draw a run of different colors
+static inline void drawPixels565(uint16 *scr_buf, int dx, int len, const uint32 *rle_data, bool alpha_flag) {
+	if (!alpha_flag) {
+		for (int i = 0; i < len; i++, scr_buf += dx) {
+			if (rle_data[i]) {
+				const byte *rle_buf = (const byte *)&rle_data[i];
+				*scr_buf = grDispatcher::make_rgb565u(rle_buf[2], rle_buf[1], rle_buf[0]);
+			}
+		}
+	} else {
+		for (int i = 0; i < len; i++, scr_buf += dx) {
+			const byte *rle_buf = (const byte *)&rle_data[i];
+			*scr_buf = grDispatcher::alpha_blend_565(grDispatcher::make_rgb565u(rle_buf[2], rle_buf[1], rle_buf[0]), *scr_buf, rle_buf[3]);
+		}
+	}
+}
+
 void grDispatcher::putSpr_rle(int x, int y, int sx, int sy, const class RLEBuffer *p, int mode, bool alpha_flag) {
 	debugC(4, kDebugGraphics, "grDispatcher::putSpr_rle([%d, %d], [%d, %d], mode: %d, alpha: %d", x, y, sx, sy, mode, alpha_flag);
 
@@ -89,66 +129,21 @@ void grDispatcher::putSpr_rle(int x, int y, int sx, int sy, const class RLEBuffe
 			}
 		}
 
-		if (!alpha_flag) {
-			while (j < psx) {
-				if (count > 0) {
-					while (count && j < psx) {
-						if (*rle_data) {
-							const byte *rle_buf = (const byte *)rle_data;
-							uint32 cl = make_rgb565u(rle_buf[2], rle_buf[1], rle_buf[0]);
-							*scr_buf = cl;
-						}
-						scr_buf += dx;
-						count--;
-						j++;
-					}
-					rle_data++;
-				} else {
-					if (count < 0) {
-						count = -count;
-						while (count && j < psx) {
-							if (*rle_data) {
-								const byte *rle_buf = (const byte *)rle_data;
-								uint32 cl = make_rgb565u(rle_buf[2], rle_buf[1], rle_buf[0]);
-								*scr_buf = cl;
-							}
-							scr_buf += dx;
-							rle_data++;
-							count--;
-							j++;
-						}
-					}
-				}
-				count = *rle_header++;
-			}
-		} else {
-			while (j < psx) {
-				if (count > 0) {
-					while (count && j < psx) {
-						const byte *rle_buf = (const byte *)rle_data;
-						uint32 a = rle_buf[3];
-						*scr_buf = alpha_blend_565(make_rgb565u(rle_buf[2], rle_buf[1], rle_buf[0]), *scr_buf, a);
-						scr_buf += dx;
-						count--;
-						j++;
-					}
-					rle_data++;
-				} else {
-					if (count < 0) {
-						count = -count;
-						while (count && j < psx) {
-							const byte *rle_buf = (const byte *)rle_data;
-							uint32 a = rle_buf[3];
-							*scr_buf = alpha_blend_565(make_rgb565u(rle_buf[2], rle_buf[1], rle_buf[0]), *scr_buf, a);
-							scr_buf += dx;
-							rle_data++;
-							count--;
-							j++;
-						}
-					}
-				}
-				count = *rle_header++;
+		while (j < psx) {
+			if (count > 0) {
+				int len = MIN<int>(count, psx - j);
+				drawRun565(scr_buf, dx, len, *rle_data, alpha_flag);
+				scr_buf += dx * len;
+				j += len;
+				rle_data++;
+			} else if (count < 0) {
+				int len = MIN<int>(-count, psx - j);
+				drawPixels565(scr_buf, dx, len, rle_data, alpha_flag);
+				scr_buf += dx * len;
+				rle_data += len;
+				j += len;
 			}
+			count = *rle_header++;
 		}
 		y += dy;
 	}
@@ -186,19 +181,29 @@ void grDispatcher::putSpr_rle(int x, int y, int sx, int sy, const class RLEBuffe
 		x1 = 0;
 		ix = -1;
 	}
+	// Lines outside of the clip rectangle are neither decoded nor drawn
+	const int left = _clipCoords[GR_LEFT] - x;
+	const int right = _clipCoords[GR_RIGHT] - x;
+
 	if (!alpha_flag) {
 		const byte *line_src = RLEBuffer::get_buffer(0);
 		for (int i = y0; i != y1; i += iy) {
-			p->decode_line(fy >> 16);
+			const int line = fy >> 16;
 
 			fy += dy;
 			fx = (1 << 15);
 
+			if (y + i < _clipCoords[GR_TOP] || y + i >= _clipCoords[GR_BOTTOM])
+				continue;
+
+			p->decode_line(line);
+			uint16 *scr_buf = reinterpret_cast<uint16 *>(_screenBuf->getBasePtr(0, y + i));
+
 			for (int j = x0; j != x1; j += ix) {
-				if (clipCheck(x + j, y + i)) {
+				if (j >= left && j < right) {
 					const byte *src_data = line_src + (fx >> 16) * 3;
 					if (src_data[0] || src_data[1] || src_data[2])
-						setPixelFast(x + j, y + i, make_rgb565u(src_data[2], src_data[1], src_data[0]));
+						scr_buf[x + j] = make_rgb565u(src_data[2], src_data[1], src_data[0]);
 				}
 				fx += dx;
 			}
@@ -206,27 +211,24 @@ void grDispatcher::putSpr_rle(int x, int y, int sx, int sy, const class RLEBuffe
 	} else {
 		const byte *line_src = RLEBuffer::get_buffer(0);
 		for (int i = y0; i != y1; i += iy) {
-			p->decode_line(fy >> 16);
+			const int line = fy >> 16;
 
 			fy += dy;
 			fx = (1 << 15);
 
+			if (y + i < _clipCoords[GR_TOP] || y + i >= _clipCoords[GR_BOTTOM])
+				continue;
+
+			p->decode_line(line);
+			uint16 *scr_buf = reinterpret_cast<uint16 *>(_screenBuf->getBasePtr(0, y + i));
+
 			for (int j = x0; j != x1; j += ix) {
-				if (clipCheck(x + j, y + i)) {
+				if (j >= left && j < right) {
 					const byte *src_data = line_src + ((fx >> 16) << 2);
 
 					uint32 a = src_data[3];
-					if (a != 255) {
-						uint32 cl = make_rgb565u(src_data[2], src_data[1], src_data[0]);
-
-						if (a) {
-							uint16 scl;
-							getPixel(x + j, y + i, scl);
-
-							setPixelFast(x + j, y + i, alpha_blend_565(cl, scl, a));
-						} else
-							setPixelFast(x + j, y + i, cl);
-					}
+					if (a != 255)
+						scr_buf[x + j] = alpha_blend_565(make_rgb565u(src_data[2], src_data[1], src_data[0]), scr_buf[x + j], a);
 				}
 				fx += dx;
 			}
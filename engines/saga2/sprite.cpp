@@ -211,15 +211,11 @@ void DrawCompositeMaskedSprite(
 	for (int i = 0; i < numParts; i++, sc++) {
 		Sprite      *sp = sc->sp;
 
-		//  Create a temp map for the sprite to unpack in
+		//  Use the unpacked sprite as the source map
 
 		sprMap._size = sp->size;
 		if (sprMap._size.x <= 0 || sprMap._size.y <= 0) continue;
-		sprMap._data = (uint8 *)getQuickMem(compMap.bytes());
-
-		//  Unpack the sprite into the temp map
-
-		unpackSprite(&sprMap, sp->data, sp->dataSize);
+		sprMap._data = sp->getPixels();
 
 		//  Blit the temp map onto the composite map
 
@@ -238,7 +234,6 @@ void DrawCompositeMaskedSprite(
 			    org.y + sc->offset.y + sp->offset.y,
 			    sc->colorTable);
 		}
-		freeQuickMem(sprMap._data);
 	}
 
 	//  do terrain masking
@@ -324,12 +319,8 @@ void DrawSprite(
     Sprite          *sp) {                  // sprite pointer
 	gPixelMap       sprMap;                 // sprite map
 
-	//  Create a temp map for the sprite to unpack in
 	sprMap._size = sp->size;
-	sprMap._data = (uint8 *)getQuickMem(sprMap.bytes());
-
-	//  Unpack the sprite into the temp map
-	unpackSprite(&sprMap, sp->data, sp->dataSize);
+	sprMap._data = sp->getPixels();
 
 	//  Blit to the port
 	port.setMode(kDrawModeMatte);
@@ -338,8 +329,6 @@ void DrawSprite(
 	               destPoint.x + sp->offset.x,
 	               destPoint.y + sp->offset.y,
 	               sprMap._size.x, sprMap._size.y);
-
-	freeQuickMem(sprMap._data);
 }
 
 //  Draw a single sprite with no masking, but with color mapping.
@@ -352,15 +341,12 @@ void DrawColorMappedSprite(
 	gPixelMap       sprMap,                 // sprite map
 	                sprReMap;               // remapped sprite map
 
-	//  Create a temp map for the sprite to unpack in
+	//  Create a temp map for the remapped sprite
 	sprMap._size = sp->size;
-	sprMap._data = (uint8 *)getQuickMem(sprMap.bytes());
+	sprMap._data = sp->getPixels();
 	sprReMap._size = sp->size;
 	sprReMap._data = (uint8 *)getQuickMem(sprReMap.bytes());
 
-	//  Unpack the sprite into the temp map
-	unpackSprite(&sprMap, sp->data, sp->dataSize);
-
 	memset(sprReMap._data, 0, sprReMap.bytes());
 
 	//  remap the sprite to the color table given
@@ -380,7 +366,6 @@ void DrawColorMappedSprite(
 	               sprReMap._size.x, sprReMap._size.y);
 
 	freeQuickMem(sprReMap._data);
-	freeQuickMem(sprMap._data);
 }
 
 //  Draw a single sprite with no masking, but with color mapping.
@@ -392,12 +377,8 @@ void ExpandColorMappedSprite(
 	gPixelMap       sprMap,                 // sprite map
 	                sprReMap;               // remapped sprite map
 
-	//  Create a temp map for the sprite to unpack in
 	sprMap._size = sp->size;
-	sprMap._data = (uint8 *)getQuickMem(sprMap.bytes());
-
-	//  Unpack the sprite into the temp map
-	unpackSprite(&sprMap, sp->data, sp->dataSize);
+	sprMap._data = sp->getPixels();
 
 	//  remap the sprite to the color table given
 	compositePixels(
@@ -406,8 +387,6 @@ void ExpandColorMappedSprite(
 	    0,
 	    0,
 	    colorTable);
-
-	freeQuickMem(sprMap._data);
 }
 
 //  Unpacks a sprite for a moment and returns the value of a
@@ -421,12 +400,8 @@ uint8 GetSpritePixel(
 	gPixelMap       sprMap;                 // sprite map
 	uint8           result;
 
-	//  Create a temp map for the sprite to unpack in
 	sprMap._size = sp->size;
-	sprMap._data = (uint8 *)getQuickMem(sprMap.bytes());
-
-	//  Unpack the sprite into the temp map
-	unpackSprite(&sprMap, sp->data, sp->dataSize);
+	sprMap._data = sp->getPixels();
 
 	//  Map the coords to the bitmap and return the pixel
 	if (flipped) {
@@ -435,7 +410,6 @@ uint8 GetSpritePixel(
 	} else {
 		result = sprMap._data[testPoint.y * sprMap._size.x + testPoint.x];
 	}
-	freeQuickMem(sprMap._data);
 
 	return result;
 }
@@ -477,11 +451,8 @@ uint16 visiblePixelsInSprite(
 	compMap._data = (uint8 *)getQuickMem(compBytes = compMap.bytes());
 	memset(compMap._data, 0, compBytes);
 
-	//  Build bitmap in which to unpack the sprite
 	sprMap._size = sp->size;
-	sprMap._data = (uint8 *)getQuickMem(sprMap.bytes());
-
-	unpackSprite(&sprMap, sp->data, sp->dataSize);
+	sprMap._data = sp->getPixels();
 
 	org.x = drawPos.x - xMin;
 	org.y = drawPos.y - yMin;
@@ -518,8 +489,6 @@ uint16 visiblePixelsInSprite(
 	WriteStatusF(8, "Visible pixels = %u", visiblePixels);
 #endif
 
-	freeQuickMem(sprMap._data);
-
 	freeQuickMem(compMap._data);
 
 	return visiblePixels;
@@ -779,10 +748,27 @@ Sprite::Sprite(Common::SeekableReadStream *stream) {
 	dataSize = size.x * size.y;
 	data = (byte *)malloc(dataSize);
 	stream->read(data, dataSize);
+
+	pixels = nullptr;
 }
 
 Sprite::~Sprite() {
 	free(data);
+	delete[] pixels;
+}
+
+uint8 *Sprite::getPixels() {
+	//  Unpack the sprite once and keep the image for as long
+	//  as the sprite itself is loaded
+	if (pixels == nullptr) {
+		gPixelMap       sprMap;
+
+		sprMap._size = size;
+		sprMap._data = pixels = new uint8[sprMap.bytes()]();
+		unpackSprite(&sprMap, data, dataSize);
+	}
+
+	return pixels;
 }
 
 SpriteSet::SpriteSet(Common::SeekableReadStream *stream) {
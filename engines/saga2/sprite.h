@@ -44,10 +44,14 @@ struct Sprite {
 	Point16         offset;                 // sprite origin point
 	byte            *data;
 	uint32			dataSize;
+	uint8           *pixels;                // unpacked image, or nullptr
 
 	Sprite(Common::SeekableReadStream *stream);
 	~Sprite();
 
+	//  Return the unpacked sprite image, unpacking it on first use
+	uint8 *getPixels();
+
 	// sprite data follows.
 };
 
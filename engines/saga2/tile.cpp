@@ -193,6 +193,15 @@ StaticPoint16 fineScroll = {0, 0};
 
 StaticTilePoint viewCenter = {0, 0, 0};             // coordinates of view on map
 
+//  The tiles of the main display as last drawn, reused for as long
+//  as the view doesn't move and no tile changes its appearance
+
+static uint8        *tileLayer;
+static bool         tileLayerValid = false;
+static int16        tileLayerMapNum;
+static uint16       tileLayerRoofID;
+static StaticPoint32 tileLayerScroll;
+
 //  These two variables define which sectors overlap the view rect.
 
 int16               lastMapNum;
@@ -812,6 +821,8 @@ void saveActiveItemStates(Common::OutSaveFile *outS) {
 void loadActiveItemStates(Common::InSaveFile *in) {
 	debugC(2, kDebugSaveload, "Loading ActiveItemStates");
 
+	invalidateTileLayer();
+
 	stateArray = new byte *[worldCount]();
 
 	if (stateArray == nullptr)
@@ -1466,6 +1477,10 @@ void cleanupMaps() {
 
 	delete[] platformCache;
 
+	delete[] tileLayer;
+	tileLayer = nullptr;
+	tileLayerValid = false;
+
 	//  Iterate through each map, dumping the data
 	for (i = 0; i < worldCount; i++) {
 		WorldMapData    *mapData = &mapList[i];
@@ -2765,11 +2780,11 @@ void buildRoofTable() {
 	}
 }
 
-//  Draw all visible metatiles
+//  Compute the metatile at the upper left corner of the view, and
+//  its position relative to the screen
 
-void drawMetaTiles(gPixelMap &drawMap) {
+static TilePoint viewBaseCoords(Point16 &metaPos) {
 	Point32     viewPos;
-	Point16     metaPos;
 	TilePoint   baseCoords;
 
 	//updateHandleRefs(baseCoords);  // viewPoint, &sti );
@@ -2794,9 +2809,6 @@ void drawMetaTiles(gPixelMap &drawMap) {
 
 	debugC(2, kDebugTiles, "baseCoords = (%d,%d,%d)", baseCoords.u, baseCoords.v, baseCoords.z);
 
-	setAreaSound(baseCoords);
-
-	updateHandleRefs(baseCoords);  // viewPoint, &sti );
 	//  coordinates of current metatile (in X,Y), relative to screen
 
 	metaPos.x   = (baseCoords.u - baseCoords.v) * kMetaDX
@@ -2807,6 +2819,19 @@ void drawMetaTiles(gPixelMap &drawMap) {
 
 	debugC(2, kDebugTiles, "metaPos = (%d,%d)", metaPos.x, metaPos.y);
 
+	return baseCoords;
+}
+
+//  Draw all visible metatiles
+
+void drawMetaTiles(gPixelMap &drawMap) {
+	Point16     metaPos;
+	TilePoint   baseCoords = viewBaseCoords(metaPos);
+
+	setAreaSound(baseCoords);
+
+	updateHandleRefs(baseCoords);  // viewPoint, &sti );
+
 	//  Loop through each horizontal row of metatiles
 	//  REM: also account for highest possible platform
 	//      (replace 256 constant with better value)
@@ -4090,6 +4115,7 @@ void cycleTiles(int32 delta) {
 			tcd._currentState++;
 			if (tcd._currentState >= tcd._numStates)
 				tcd._currentState = 0;
+			invalidateTileLayer();
 		}
 	}
 }
@@ -4140,6 +4166,8 @@ void saveTileCyclingStates(Common::OutSaveFile *outS) {
 void loadTileCyclingStates(Common::InSaveFile *in) {
 	debugC(2, kDebugSaveload, "Loading TileCyclingStates");
 
+	invalidateTileLayer();
+
 	initTileCyclingStates();
 
 	for (int i = 0; i < _cycleCount; i++) {
@@ -4411,11 +4439,42 @@ void updateMainDisplay() {
 	cycleTiles(deltaTime);
 }
 
-void drawMainDisplay() {
-
+void invalidateTileLayer() {
+	tileLayerValid = false;
+}
 
-	// draws tiles to g_vm->_tileDrawMap._data
-	drawMetaTiles(g_vm->_tileDrawMap);
+void drawMainDisplay() {
+	gPixelMap       &drawMap = g_vm->_tileDrawMap;
+	int32           scrollX = tileScroll.x & ~kTileDXMask;
+
+	if (tileLayerValid
+	        &&  tileLayerMapNum == g_vm->_currentMapNum
+	        &&  tileLayerRoofID == rippedRoofID
+	        &&  tileLayerScroll.x == scrollX
+	        &&  tileLayerScroll.y == tileScroll.y) {
+		Point16     metaPos;
+		TilePoint   baseCoords = viewBaseCoords(metaPos);
+
+		setAreaSound(baseCoords);
+		updateHandleRefs(baseCoords);
+
+		//  Nothing in the view has changed, restore the tiles
+		//  drawn last time
+		memcpy(drawMap._data, tileLayer, drawMap.bytes());
+	} else {
+		// draws tiles to g_vm->_tileDrawMap._data
+		drawMetaTiles(drawMap);
+
+		if (tileLayer == nullptr)
+			tileLayer = new uint8[drawMap.bytes()];
+		memcpy(tileLayer, drawMap._data, drawMap.bytes());
+
+		tileLayerValid = true;
+		tileLayerMapNum = g_vm->_currentMapNum;
+		tileLayerRoofID = rippedRoofID;
+		tileLayerScroll.x = scrollX;
+		tileLayerScroll.y = tileScroll.y;
+	}
 
 	//  Draw sprites onto back buffer
 	drawDisplayList();
@@ -296,6 +296,7 @@ enum tileRefFlags {
 typedef TileRef *TileRefPtr, **TileRefHandle;
 
 void drawMainDisplay();
+void invalidateTileLayer();
 
 /* ===================================================================== *
    TileCycleData: This structure is used to define continuously cycling
@@ -433,6 +434,7 @@ public:
 	//  Set the state number of this active item instance
 	void setInstanceState(int16 mapNum, uint8 state) {
 		stateArray[mapNum][_data.instance.stateIndex] = state;
+		invalidateTileLayer();
 	}
 
 	uint8 builtInBehavior() {
@@ -21,6 +21,7 @@
 
 #include "sci/engine/gc.h"
 #include "common/array.h"
+#include "common/system.h"
 #include "sci/graphics/ports.h"
 
 #ifdef ENABLE_SCI32
@@ -190,6 +191,9 @@ void run_gc(EngineState *s) {
 	memset(segcount, 0, sizeof(segcount));
 #endif
 
+	const uint32 startTime = g_system->getMillis();
+	segMan->resetAllocationsSinceGC();
+
 	// Compute the set of all segments references currently in use.
 	AddrSet *activeRefs = findAllActiveReferences(s);
 
@@ -225,6 +229,8 @@ void run_gc(EngineState *s) {
 
 	delete activeRefs;
 
+	debugC(kDebugLevelGC, "[GC] Finished in %d ms", g_system->getMillis() - startTime);
+
 #ifdef GC_DEBUG_CODE
 	// Output debug summary of garbage collection
 	debugC(kDebugLevelGC, "[GC] Summary:");
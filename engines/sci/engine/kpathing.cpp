@@ -66,6 +66,12 @@ enum {
 
 #define HUGE_DISTANCE 0xFFFFFFFF
 
+// Number of polygon sets for which the visibility graph is kept
+#define AVOIDPATH_CACHE_SIZE 4
+
+// Polygon sets with more vertices than this are not cached
+#define AVOIDPATH_CACHE_MAX_VERTICES 256
+
 #define VERTEX_HAS_EDGES(V) ((V) != CLIST_NEXT(V))
 
 // Error codes
@@ -116,23 +122,27 @@ struct Vertex {
 	// Previous vertex in shortest path
 	Vertex *path_prev;
 
+	// Order in which the vertex was added to the A* open set, 0 if never
+	uint32 openOrder;
+
+	// Whether the shortest path to the vertex is known
+	bool closed;
+
+	// Index of the vertex in the cached visibility graph, -1 if none
+	int cacheIndex;
+
 public:
 	Vertex(const Common::Point &p) : v(p) {
+		costF = HUGE_DISTANCE;
 		costG = HUGE_DISTANCE;
 		path_prev = nullptr;
+		openOrder = 0;
+		closed = false;
+		cacheIndex = -1;
 	}
 };
 
-class VertexList: public Common::List<Vertex *> {
-public:
-	bool contains(Vertex *v) {
-		for (iterator it = begin(); it != end(); ++it) {
-			if (v == *it)
-				return true;
-		}
-		return false;
-	}
-};
+typedef Common::List<Vertex *> VertexList;
 
 /* Circular list definitions. */
 
@@ -262,6 +272,12 @@ struct PathfindingState {
 	// Screen size
 	int _width, _height;
 
+	// Cached visibility between vertices, see AvoidPathCacheEntry
+	byte *visibility;
+
+	// Number of vertices in the cached visibility graph
+	int cachedVertices;
+
 	PathfindingState(int width, int height) : _width(width), _height(height) {
 		vertex_start = nullptr;
 		vertex_end = nullptr;
@@ -269,6 +285,8 @@ struct PathfindingState {
 		_prependPoint = nullptr;
 		_appendPoint = nullptr;
 		vertices = 0;
+		visibility = nullptr;
+		cachedVertices = 0;
 	}
 
 	~PathfindingState() {
@@ -698,6 +716,39 @@ static int inside(const Common::Point &p, Vertex *vertex) {
 	return 0;
 }
 
+/**
+ * Determines whether a vertex is visible from another vertex
+ * @param s				the pathfinding state
+ * @param vertex_cur	the vertex to look from
+ * @param vertex		the vertex to test
+ * @return true if vertex is visible from vertex_cur, false otherwise
+ */
+static bool vertex_visible(PathfindingState *s, Vertex *vertex_cur, Vertex *vertex) {
+	// Make sure we don't intersect a polygon locally at the vertices
+	if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
+		return false;
+
+	// Check for intersecting edges
+	for (int j = 0; j < s->vertices; j++) {
+		Vertex *edge = s->vertex_index[j];
+		if (VERTEX_HAS_EDGES(edge)) {
+			if (between(vertex_cur->v, vertex->v, edge->v)) {
+				// If we hit a vertex, make sure we can pass through it without intersecting its polygon
+				if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
+					return false;
+
+				// This edge won't properly intersect, so we continue
+				continue;
+			}
+
+			if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
+				return false;
+		}
+	}
+
+	return true;
+}
+
 /**
  * Returns a list of all vertices that are visible from a particular vertex.
  * @param s				the pathfinding state
@@ -709,31 +760,19 @@ static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
 
 	for (int i = 0; i < s->vertices; i++) {
 		Vertex *vertex = s->vertex_index[i];
-
-		// Make sure we don't intersect a polygon locally at the vertices
-		if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
-			continue;
-
-		// Check for intersecting edges
-		int j;
-		for (j = 0; j < s->vertices; j++) {
-			Vertex *edge = s->vertex_index[j];
-			if (VERTEX_HAS_EDGES(edge)) {
-				if (between(vertex_cur->v, vertex->v, edge->v)) {
-					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
-					if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
-						break;
-
-					// This edge won't properly intersect, so we continue
-					continue;
-				}
-
-				if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
-					break;
-			}
+		bool visible;
+
+		if (s->visibility && vertex_cur->cacheIndex >= 0 && vertex->cacheIndex >= 0) {
+			// 0 means not tested yet, 1 visible and 2 not visible
+			byte &cached = s->visibility[vertex_cur->cacheIndex * s->cachedVertices + vertex->cacheIndex];
+			if (!cached)
+				cached = vertex_visible(s, vertex_cur, vertex) ? 1 : 2;
+			visible = (cached == 1);
+		} else {
+			visible = vertex_visible(s, vertex_cur, vertex);
 		}
 
-		if (j == s->vertices)
+		if (visible)
 			visVerts->push_front(vertex);
 	}
 
@@ -1235,6 +1274,54 @@ static void change_polygons_opt_0(PathfindingState *s) {
 	}
 }
 
+/**
+ * Looks up the visibility graph of the current polygon set in the cache, and
+ * adds an empty one if there is none yet. The polygon vertices are numbered
+ * for indexing into the graph.
+ * Parameters: (EngineState *) s: The game state
+ *             (PathfindingState *) pf_s: The pathfinding state
+ */
+static void use_visibility_cache(EngineState *s, PathfindingState *pf_s) {
+	Common::Array<Common::Point> polygons;
+	int count = 0;
+
+	for (PolygonList::iterator it = pf_s->polygons.begin(); it != pf_s->polygons.end(); ++it) {
+		Vertex *vertex;
+
+		CLIST_FOREACH(vertex, &(*it)->vertices) {
+			vertex->cacheIndex = count++;
+			polygons.push_back(vertex->v);
+		}
+
+		polygons.push_back(Common::Point(POLY_LAST_POINT, POLY_LAST_POINT));
+	}
+
+	if (count == 0 || count > AVOIDPATH_CACHE_MAX_VERTICES)
+		return;
+
+	Common::Array<AvoidPathCacheEntry> &cache = s->_avoidPathCache;
+	uint i;
+	for (i = 0; i < cache.size(); i++) {
+		if (cache[i].polygons == polygons)
+			break;
+	}
+
+	if (i == cache.size()) {
+		if (cache.size() == AVOIDPATH_CACHE_SIZE)
+			cache.pop_back();
+
+		AvoidPathCacheEntry entry;
+		entry.polygons = polygons;
+		entry.visibility.resize(count * count, 0);
+		cache.insert_at(0, entry);
+	} else if (i > 0) {
+		cache.insert_at(0, cache.remove_at(i));
+	}
+
+	pf_s->visibility = cache[0].visibility.data();
+	pf_s->cachedVertices = count;
+}
+
 /**
  * Converts the SCI input data for pathfinding
  * Parameters: (EngineState *) s: The game state
@@ -1326,10 +1413,18 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 		}
 	}
 
+	use_visibility_cache(s, pf_s);
+
 	// Merge start and end points into polygon set
 	pf_s->vertex_start = merge_point(pf_s, *new_start);
 	pf_s->vertex_end = merge_point(pf_s, *new_end);
 
+	// A start or end point which splits a polygon edge changes the
+	// visibility between the polygon vertices, so it can't be cached
+	if ((pf_s->vertex_start->cacheIndex < 0 && VERTEX_HAS_EDGES(pf_s->vertex_start)) ||
+		(pf_s->vertex_end->cacheIndex < 0 && VERTEX_HAS_EDGES(pf_s->vertex_end)))
+		pf_s->visibility = nullptr;
+
 	delete new_start;
 	delete new_end;
 
@@ -1352,6 +1447,82 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 	return pf_s;
 }
 
+/**
+ * The A* open set, a binary heap of vertices ordered by their F cost. Of
+ * several vertices with the same cost, the one which was added to the open
+ * set last is returned first. A vertex is pushed again whenever its cost
+ * decreases, and the outdated entries are skipped by pop().
+ */
+class OpenSet {
+public:
+	bool empty() const {
+		return _heap.empty();
+	}
+
+	void push(Vertex *vertex) {
+		Entry entry;
+		entry.costF = vertex->costF;
+		entry.vertex = vertex;
+		_heap.push_back(entry);
+
+		uint i = _heap.size() - 1;
+		while (i > 0) {
+			const uint parent = (i - 1) / 2;
+			if (!before(_heap[i], _heap[parent]))
+				break;
+			SWAP(_heap[i], _heap[parent]);
+			i = parent;
+		}
+	}
+
+	/**
+	 * Removes the vertex with the lowest cost from the open set.
+	 * @return the vertex, or NULL if the open set is empty
+	 */
+	Vertex *pop() {
+		while (!_heap.empty()) {
+			const Entry entry = _heap[0];
+			_heap[0] = _heap.back();
+			_heap.pop_back();
+
+			const uint size = _heap.size();
+			uint i = 0;
+			for (;;) {
+				uint best = i;
+				const uint left = 2 * i + 1;
+				const uint right = left + 1;
+				if (left < size && before(_heap[left], _heap[best]))
+					best = left;
+				if (right < size && before(_heap[right], _heap[best]))
+					best = right;
+				if (best == i)
+					break;
+				SWAP(_heap[i], _heap[best]);
+				i = best;
+			}
+
+			if (!entry.vertex->closed && entry.costF == entry.vertex->costF)
+				return entry.vertex;
+		}
+
+		return nullptr;
+	}
+
+private:
+	struct Entry {
+		uint32 costF;
+		Vertex *vertex;
+	};
+
+	static bool before(const Entry &a, const Entry &b) {
+		if (a.costF != b.costF)
+			return a.costF < b.costF;
+		return a.vertex->openOrder > b.vertex->openOrder;
+	}
+
+	Common::Array<Entry> _heap;
+};
+
 /**
  * Computes a shortest path from vertex_start to vertex_end. The caller can
  * construct the resulting path by following the path_prev links from
@@ -1360,40 +1531,25 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
  * Parameters: (PathfindingState *) s: The pathfinding state
  */
 static void AStar(PathfindingState *s) {
-	// Vertices of which the shortest path is known
-	VertexList closedSet;
-
-	// The remaining vertices
-	VertexList openSet;
+	// The vertices of which the shortest path is not known yet
+	OpenSet openSet;
+	uint32 openOrder = 0;
+	bool reachedEnd = false;
 
-	openSet.push_front(s->vertex_start);
+	s->vertex_start->openOrder = ++openOrder;
 	s->vertex_start->costG = 0;
 	s->vertex_start->costF = (uint32)sqrt((float)s->vertex_start->v.sqrDist(s->vertex_end->v));
+	openSet.push(s->vertex_start);
 
-	while (!openSet.empty()) {
-		// Find vertex in open set with lowest F cost
-		VertexList::iterator vertex_min_it = openSet.end();
-		Vertex *vertex_min = nullptr;
-		uint32 min = HUGE_DISTANCE;
-
-		for (VertexList::iterator it = openSet.begin(); it != openSet.end(); ++it) {
-			Vertex *vertex = *it;
-			if (vertex->costF < min) {
-				vertex_min_it = it;
-				vertex_min = *vertex_min_it;
-				min = vertex->costF;
-			}
-		}
-
-		assert(vertex_min != nullptr);	// the vertex cost should never be bigger than HUGE_DISTANCE
-
+	while (Vertex *vertex_min = openSet.pop()) {
 		// Check if we are done
-		if (vertex_min == s->vertex_end)
+		if (vertex_min == s->vertex_end) {
+			reachedEnd = true;
 			break;
+		}
 
 		// Move vertex from set open to set closed
-		closedSet.push_front(vertex_min);
-		openSet.erase(vertex_min_it);
+		vertex_min->closed = true;
 
 		VertexList *visVerts = visible_vertices(s, vertex_min);
 
@@ -1401,11 +1557,12 @@ static void AStar(PathfindingState *s) {
 			uint32 new_dist;
 			Vertex *vertex = *it;
 
-			if (closedSet.contains(vertex))
+			if (vertex->closed)
 				continue;
 
-			if (!openSet.contains(vertex))
-				openSet.push_front(vertex);
+			const bool newlyOpened = !vertex->openOrder;
+			if (newlyOpened)
+				vertex->openOrder = ++openOrder;
 
 			new_dist = vertex_min->costG + (uint32)sqrt((float)vertex_min->v.sqrDist(vertex->v));
 
@@ -1443,13 +1600,16 @@ static void AStar(PathfindingState *s) {
 				vertex->costG = new_dist;
 				vertex->costF = vertex->costG + (uint32)sqrt((float)vertex->v.sqrDist(s->vertex_end->v));
 				vertex->path_prev = vertex_min;
+				openSet.push(vertex);
+			} else if (newlyOpened) {
+				openSet.push(vertex);
 			}
 		}
 
 		delete visVerts;
 	}
 
-	if (openSet.empty())
+	if (!reachedEnd)
 		debugC(kDebugLevelAvoidPath, "AvoidPath: End point (%i, %i) is unreachable", s->vertex_end->v.x, s->vertex_end->v.y);
 }
 
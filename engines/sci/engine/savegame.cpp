@@ -336,6 +336,8 @@ void SegManager::saveLoadWithSerializer(Common::Serializer &s) {
 #endif
 			}
 		}
+
+		invalidateSelectorCache();
 	}
 }
 
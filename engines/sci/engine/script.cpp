@@ -74,6 +74,9 @@ void Script::freeScript(const bool keepLocalsSegment) {
 	_offsetLookupObjectCount = 0;
 	_offsetLookupStringCount = 0;
 	_offsetLookupSaidCount = 0;
+
+	_decodedIndex.clear();
+	_decodedInstructions.clear();
 }
 
 enum {
@@ -1006,6 +1009,28 @@ void Script::initializeLocals(SegManager *segMan) {
 	}
 }
 
+const DecodedInstruction &Script::decodeInstruction(uint32 offset) {
+	// Only code can be executed, so leave out the SCI1.1 heap
+	if (_decodedIndex.empty())
+		_decodedIndex.resize(_script.size(), 0);
+
+	if (offset >= _decodedIndex.size()) {
+		static DecodedInstruction uncached;
+		uncached.size = readPMachineInstruction(getBuf(offset), uncached.extOpcode, uncached.opparams);
+		return uncached;
+	}
+
+	uint32 &index = _decodedIndex[offset];
+	if (!index) {
+		DecodedInstruction instruction;
+		instruction.size = readPMachineInstruction(getBuf(offset), instruction.extOpcode, instruction.opparams);
+		_decodedInstructions.push_back(instruction);
+		index = _decodedInstructions.size();
+	}
+
+	return _decodedInstructions[index - 1];
+}
+
 void Script::syncLocalsBlock(SegManager *segMan) {
 	_localsBlock = (_localsSegment == 0) ? nullptr : (LocalVariables *)(segMan->getSegment(_localsSegment, SEG_TYPE_LOCALS));
 }
@@ -68,6 +68,13 @@ struct offsetLookupArrayEntry {
 
 typedef Common::Array<offsetLookupArrayEntry> offsetLookupArrayType;
 
+/** A PMachine instruction, as read by readPMachineInstruction(). */
+struct DecodedInstruction {
+	int16 opparams[4];
+	byte extOpcode;
+	uint16 size; ///< Length of the instruction in bytes
+};
+
 class Script : public SegmentObj {
 private:
 	int _nr; /**< Script number */
@@ -101,6 +108,13 @@ private:
 	uint16 _offsetLookupStringCount;
 	uint16 _offsetLookupSaidCount;
 
+	/**
+	 * For every offset inside the script, the index of the instruction
+	 * decoded there plus one, or 0 if none was decoded yet.
+	 */
+	Common::Array<uint32> _decodedIndex;
+	Common::Array<DecodedInstruction> _decodedInstructions;
+
 public:
 	int getLocalsOffset() const { return _localsOffset; }
 	uint16 getLocalsCount() const { return _localsCount; }
@@ -117,6 +131,14 @@ public:
 	}
 
 	const byte *getBuf(uint offset = 0) const { return _buf->getUnsafeDataAt(offset); }
+
+	/**
+	 * Decodes the instruction at the given offset. Code isn't modified once
+	 * a script is loaded and patched, so every instruction is only decoded
+	 * once and cached until the script is freed. The returned reference is
+	 * only valid until the next call.
+	 */
+	const DecodedInstruction &decodeInstruction(uint32 offset);
 	SciSpan<const byte> getSpan(uint offset) const { return _buf->subspan(offset); }
 
 	int getScriptNumber() const { return _nr; }
@@ -47,6 +47,11 @@ SegManager::SegManager(ResourceManager *resMan, ScriptPatcher *scriptPatcher)
 	_bitmapSegId = 0;
 #endif
 
+	for (uint i = 0; i < kSelectorCacheSize; i++)
+		_selectorCache[i].generation = 0;
+	_selectorCacheGeneration = 1;
+	_allocationsSinceGC = 0;
+
 	createClassTable();
 }
 
@@ -76,11 +81,22 @@ void SegManager::resetSegMan() {
 	_bitmapSegId = 0;
 #endif
 
+	invalidateSelectorCache();
+
 	// Reinitialize class table
 	_classTable.clear();
 	createClassTable();
 }
 
+void SegManager::invalidateSelectorCache() {
+	// Generation 0 marks unused entries, so clear them all when wrapping
+	if (++_selectorCacheGeneration == 0) {
+		for (uint i = 0; i < kSelectorCacheSize; i++)
+			_selectorCache[i].generation = 0;
+		_selectorCacheGeneration = 1;
+	}
+}
+
 void SegManager::initSysStrings() {
 	if (getSciVersion() <= SCI_VERSION_1_1) {
 		// We need to allocate system strings in one segment, for compatibility reasons
@@ -180,6 +196,7 @@ void SegManager::deallocate(SegmentId seg) {
 
 	delete mobj;
 	_heap[actualSegment] = nullptr;
+	invalidateSelectorCache();
 }
 
 bool SegManager::isHeapObject(reg_t pos) const {
@@ -459,6 +476,7 @@ reg_t SegManager::allocateHunkEntry(const char *hunk_type, int size) {
 	}
 
 	int offset = table->allocEntry();
+	_allocationsSinceGC++;
 
 	reg_t addr = make_reg(_hunksSegId, offset);
 	Hunk &h = table->at(offset);
@@ -492,6 +510,8 @@ Clone *SegManager::allocateClone(reg_t *addr) {
 	}
 
 	int offset = table->allocEntry();
+	_allocationsSinceGC++;
+	invalidateSelectorCache();
 
 	*addr = make_reg(_clonesSegId, offset);
 	return &table->at(offset);
@@ -508,6 +528,7 @@ List *SegManager::allocateList(reg_t *addr) {
 	}
 
 	int offset = table->allocEntry();
+	_allocationsSinceGC++;
 
 	*addr = make_reg(_listsSegId, offset);
 	return &table->at(offset);
@@ -524,6 +545,7 @@ Node *SegManager::allocateNode(reg_t *addr) {
 	}
 
 	int offset = table->allocEntry();
+	_allocationsSinceGC++;
 
 	*addr = make_reg(_nodesSegId, offset);
 	return &table->at(offset);
@@ -908,6 +930,7 @@ Common::String SegManager::getString(reg_t pointer) {
 byte *SegManager::allocDynmem(int size, const char *descr, reg_t *addr) {
 	DynMem *dynmem = new DynMem();
 	SegmentId segid = allocSegment(dynmem);
+	_allocationsSinceGC++;
 	*addr = make_reg(segid, 0);
 
 	dynmem->_size = size;
@@ -950,6 +973,7 @@ SciArray *SegManager::allocateArray(SciArrayType type, uint16 size, reg_t *addr)
 	}
 
 	int offset = table->allocEntry();
+	_allocationsSinceGC++;
 
 	*addr = make_reg(_arraysSegId, offset);
 
@@ -1006,6 +1030,7 @@ SciBitmap *SegManager::allocateBitmap(reg_t *addr, const int16 width, const int1
 	}
 
 	int offset = table->allocEntry();
+	_allocationsSinceGC++;
 
 	*addr = make_reg(_bitmapSegId, offset);
 	SciBitmap &bitmap = table->at(offset);
@@ -1098,6 +1123,13 @@ int SegManager::instantiateScript(int scriptNum, bool applyScriptPatches) {
 	} else {
 		scr = allocateScript(scriptNum, segmentId);
 	}
+	_allocationsSinceGC++;
+
+	// Games set the new room number before loading the room's script, so
+	// the resources of the room can be decompressed while its script starts
+	const EngineState *s = g_sci->getEngineState();
+	if (s && s->variables[VAR_GLOBAL] && scriptNum == s->currentRoomNumber())
+		_resMan->prefetchRoom(scriptNum);
 
 	scr->load(scriptNum, _resMan, _scriptPatcher, applyScriptPatches);
 	scr->initializeLocals(this);
@@ -1105,6 +1137,7 @@ int SegManager::instantiateScript(int scriptNum, bool applyScriptPatches) {
 #ifdef ENABLE_SCI32
 	g_sci->_guestAdditions->instantiateScriptHook(*scr);
 #endif
+	invalidateSelectorCache();
 
 	return segmentId;
 }
@@ -1136,6 +1169,7 @@ void SegManager::uninstantiateScript(int script_nr) {
 	if (!scr->getLockers()) {
 		// The actual script deletion seems to be done by SCI scripts themselves
 		scr->markDeleted();
+		_allocationsSinceGC++;
 		debugC(kDebugLevelScripts, "Unloaded script 0x%x.", script_nr);
 	}
 }
@@ -261,6 +261,45 @@ public:
 	 */
 	bool freeDynmem(reg_t addr);
 
+	// 10. Selector Lookup Cache
+
+	/**
+	 * The result of a lookupSelector() call, which stays valid until an
+	 * object is created or destroyed.
+	 */
+	struct SelectorCacheEntry {
+		reg_t obj;
+		Selector selector;
+		uint32 generation;
+		SelectorType type;
+		int varIndex;
+		reg_t funcp;
+	};
+
+	/**
+	 * Returns the cache slot for the given object and selector. The slot
+	 * holds a result for them if its generation and key match.
+	 */
+	SelectorCacheEntry &getSelectorCacheEntry(reg_t obj, Selector selector) {
+		const uint32 key = ((uint32)obj.getSegment() << 16 | (obj.getOffset() & 0xFFFF)) ^ (selector * 0x9E3779B1u);
+		return _selectorCache[(key ^ (key >> 15)) & (kSelectorCacheSize - 1)];
+	}
+
+	uint32 getSelectorCacheGeneration() const { return _selectorCacheGeneration; }
+
+	/**
+	 * Returns the number of scripts and heap entries allocated since the
+	 * last garbage collection, which bounds how much garbage there may be.
+	 */
+	uint getAllocationsSinceGC() const { return _allocationsSinceGC; }
+	void resetAllocationsSinceGC() { _allocationsSinceGC = 0; }
+
+	/**
+	 * Forgets all cached selector lookups. Needs to be called whenever
+	 * objects are created or destroyed, as their addresses are reused.
+	 */
+	void invalidateSelectorCache();
+
 
 	// Generic Operations on Segments and Addresses
 
@@ -474,6 +513,15 @@ private:
 	SegmentId _nodesSegId; ///< ID of the (a) node segment
 	SegmentId _hunksSegId; ///< ID of the (a) hunk segment
 
+	enum {
+		kSelectorCacheSize = 1024 ///< Must be a power of two
+	};
+
+	SelectorCacheEntry _selectorCache[kSelectorCacheSize];
+	uint32 _selectorCacheGeneration;
+
+	uint _allocationsSinceGC;
+
 	// Statically allocated memory for system strings
 	reg_t _saveDirPtr;
 	reg_t _parserPtr;
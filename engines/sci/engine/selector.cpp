@@ -323,36 +323,24 @@ void invokeSelector(EngineState *s, reg_t object, int selectorId,
 	run_vm(s); // Start a new vm
 }
 
-SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector selectorId, ObjVarRef *varp, reg_t *fptr) {
+static SelectorType lookupSelectorUncached(SegManager *segMan, reg_t obj_location, Selector selectorId, int &varIndex, reg_t &funcp) {
 	const Object *obj = segMan->getObject(obj_location);
-	bool oldScriptHeader = (getSciVersion() == SCI_VERSION_0_EARLY);
-
-	// Early SCI versions used the LSB in the selector ID as a read/write
-	// toggle, meaning that we must remove it for selector lookup.
-	if (oldScriptHeader)
-		selectorId &= ~1;
 
 	if (!obj) {
 		error("lookupSelector: Attempt to send to non-object or invalid script. Address %04x:%04x", PRINT_REG(obj_location));
 	}
 
-	int index = obj->locateVarSelector(segMan, selectorId);
+	varIndex = obj->locateVarSelector(segMan, selectorId);
 
-	if (index >= 0) {
+	if (varIndex >= 0) {
 		// Found it as a variable
-		if (varp) {
-			varp->obj = obj_location;
-			varp->varindex = index;
-		}
 		return kSelectorVariable;
 	} else {
 		// Check if it's a method, with recursive lookup in superclasses
 		while (obj) {
-			index = obj->funcSelectorPosition(selectorId);
+			const int index = obj->funcSelectorPosition(selectorId);
 			if (index >= 0) {
-				if (fptr)
-					*fptr = obj->getFunction(index);
-
+				funcp = obj->getFunction(index);
 				return kSelectorMethod;
 			} else {
 				obj = segMan->getObject(obj->getSuperClassSelector());
@@ -363,4 +351,37 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 	}
 }
 
+SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector selectorId, ObjVarRef *varp, reg_t *fptr) {
+	bool oldScriptHeader = (getSciVersion() == SCI_VERSION_0_EARLY);
+
+	// Early SCI versions used the LSB in the selector ID as a read/write
+	// toggle, meaning that we must remove it for selector lookup.
+	if (oldScriptHeader)
+		selectorId &= ~1;
+
+	// Scripts send the same selectors to the same objects over and over, so
+	// remember where they were found instead of walking the class chain
+	SegManager::SelectorCacheEntry &entry = segMan->getSelectorCacheEntry(obj_location, selectorId);
+	if (entry.generation != segMan->getSelectorCacheGeneration() || entry.selector != selectorId || entry.obj != obj_location) {
+		entry.varIndex = -1;
+		entry.funcp = NULL_REG;
+		entry.type = lookupSelectorUncached(segMan, obj_location, selectorId, entry.varIndex, entry.funcp);
+		entry.obj = obj_location;
+		entry.selector = selectorId;
+		entry.generation = segMan->getSelectorCacheGeneration();
+	}
+
+	if (entry.type == kSelectorVariable) {
+		if (varp) {
+			varp->obj = obj_location;
+			varp->varindex = entry.varIndex;
+		}
+	} else if (entry.type == kSelectorMethod) {
+		if (fptr)
+			*fptr = entry.funcp;
+	}
+
+	return entry.type;
+}
+
 } // End of namespace Sci
@@ -105,6 +105,8 @@ void EngineState::reset(bool isRestoring) {
 
 	gcCountDown = 0;
 
+	_avoidPathCache.clear();
+
 	_eventCounter = 0;
 	_paletteSetIntensityCounter = 0;
 	_throttleLastTime = 0;
@@ -119,6 +121,7 @@ void EngineState::reset(bool isRestoring) {
 
 	scriptStepCounter = 0;
 	scriptGCInterval = GC_INTERVAL;
+	scriptGCThreshold = GC_ALLOCATION_THRESHOLD;
 }
 
 void EngineState::speedThrottler(uint32 neededSleep) {
@@ -24,6 +24,7 @@
 
 #include "common/scummsys.h"
 #include "common/array.h"
+#include "common/rect.h"
 #include "common/serializer.h"
 #include "common/str-array.h"
 
@@ -63,6 +64,24 @@ enum {
 	SAVEGAMEID_OFFICIALRANGE_END = 199
 };
 
+/**
+ * Visibility between the vertices of a polygon set, which kAvoidPath reuses
+ * for as long as scripts keep passing it the same polygons.
+ */
+struct AvoidPathCacheEntry {
+	/**
+	 * The vertices of all polygons in pathfinding order, with each polygon
+	 * terminated by (POLY_LAST_POINT, POLY_LAST_POINT).
+	 */
+	Common::Array<Common::Point> polygons;
+
+	/**
+	 * For every pair of vertices, whether the second vertex is visible from
+	 * the first one. This is filled in as the pairs are tested.
+	 */
+	Common::Array<byte> visibility;
+};
+
 enum {
 	GAMEISRESTARTING_NONE = 0,
 	GAMEISRESTARTING_RESTART = 1,
@@ -172,6 +191,7 @@ struct EngineState : public Common::Serializable {
 
 	int scriptStepCounter; // Counts the number of steps executed
 	int scriptGCInterval; // Number of steps in between gcs
+	int scriptGCThreshold; // Number of allocations needed for a periodic gc
 
 	uint16 currentRoomNumber() const;
 	void setRoomNumber(uint16 roomNumber);
@@ -189,6 +209,12 @@ struct EngineState : public Common::Serializable {
 
 	int gcCountDown; /**< Number of kernel calls until next gc */
 
+	/**
+	 * Visibility graphs of the most recently used polygon sets, with the most
+	 * recently used one first.
+	 */
+	Common::Array<AvoidPathCacheEntry> _avoidPathCache;
+
 	MessageState *_msgState;
 	void initMessageState();
 
@@ -193,6 +193,14 @@ enum {
 	GC_INTERVAL = 0x8000
 };
 
+/**
+ * Number of heap entries which need to be allocated in between gcs. With
+ * fewer, there can't be enough garbage to be worth the pause.
+ */
+enum {
+	GC_ALLOCATION_THRESHOLD = 64
+};
+
 enum SciOpcodes {
 	op_bnot     = 0x00,	// 000
 	op_add      = 0x01,	// 001
@@ -77,10 +77,35 @@ void CelScaler::buildLookupTable(int *table, const Ratio &ratio, const int size)
 }
 
 const CelScalerTable &CelScaler::getScalerTable(const Ratio &scaleX, const Ratio &scaleY) {
+	for (int i = 0; i < _numPreparedTables; ++i) {
+		if (_preparedTables[i].scaleX == scaleX && _preparedTables[i].scaleY == scaleY) {
+			return _preparedTables[i];
+		}
+	}
+
 	activateScaleTables(scaleX, scaleY);
 	return _scaleTables[_activeIndex];
 }
 
+bool CelScaler::prepareTable(const Ratio &scaleX, const Ratio &scaleY) {
+	for (int i = 0; i < _numPreparedTables; ++i) {
+		if (_preparedTables[i].scaleX == scaleX && _preparedTables[i].scaleY == scaleY) {
+			return true;
+		}
+	}
+
+	if (_numPreparedTables == kMaxPreparedScalerTables) {
+		return false;
+	}
+
+	CelScalerTable &table = _preparedTables[_numPreparedTables++];
+	buildLookupTable(table.valuesX, scaleX, kCelScalerTableSize);
+	buildLookupTable(table.valuesY, scaleY, kCelScalerTableSize);
+	table.scaleX = scaleX;
+	table.scaleY = scaleY;
+	return true;
+}
+
 #pragma mark -
 #pragma mark CelObj
 bool CelObj::_drawBlackLines = false;
@@ -90,7 +115,10 @@ void CelObj::init() {
 	_drawBlackLines = false;
 	_nextCacheId = 1;
 	_scaler = new CelScaler();
-	_cache = new CelCache(100);
+	// SSCI only cached 100 cels, which the high resolution games outgrow
+	// within a single room
+	_cache = new CelCache(1000);
+	_cacheIndex = new CelCacheIndex();
 }
 
 void CelObj::deinit() {
@@ -98,6 +126,8 @@ void CelObj::deinit() {
 	_scaler = nullptr;
 	delete _cache;
 	_cache = nullptr;
+	delete _cacheIndex;
+	_cacheIndex = nullptr;
 }
 
 #pragma mark -
@@ -168,8 +198,10 @@ struct SCALER_Scale {
 	// image and takes precedence over _reader.
 	Common::SharedPtr<Buffer> _sourceBuffer;
 	int16 _x;
-	static int16 _valuesX[kCelScalerTableSize];
-	static int16 _valuesY[kCelScalerTableSize];
+	// These are not static like in SSCI so that several cels can be scaled
+	// at the same time, see GfxFrameout::drawScreenItemListsThreaded
+	int16 _valuesX[kCelScalerTableSize];
+	int16 _valuesY[kCelScalerTableSize];
 
 	SCALER_Scale(const CelObj &celObj, const Common::Rect &targetRect, const Common::Point &scaledPosition, const Ratio scaleX, const Ratio scaleY) :
 	_row(nullptr),
@@ -316,11 +348,6 @@ struct SCALER_Scale {
 	}
 };
 
-template<bool FLIP, typename READER>
-int16 SCALER_Scale<FLIP, READER>::_valuesX[kCelScalerTableSize];
-template<bool FLIP, typename READER>
-int16 SCALER_Scale<FLIP, READER>::_valuesY[kCelScalerTableSize];
-
 #pragma mark -
 #pragma mark CelObj - Resource readers
 
@@ -338,7 +365,7 @@ public:
 	_sourceHeight(celObj._height),
 #endif
 	_sourceWidth(celObj._width) {
-		const SciSpan<const byte> resource = celObj.getResPointer();
+		const SciSpan<const byte> resource = celObj.getDrawResPointer();
 		const uint32 pixelsOffset = resource.getUint32SEAt(celObj._celHeaderOffset + 24);
 		const int32 numPixels = MIN<int32>(resource.size() - pixelsOffset, celObj._width * celObj._height);
 
@@ -374,7 +401,7 @@ private:
 
 public:
 	READER_Compressed(const CelObj &celObj, const int16 maxWidth) :
-	_resource(celObj.getResPointer()),
+	_resource(celObj.getDrawResPointer()),
 	_y(-1),
 	_sourceHeight(celObj._height),
 	_skipColor(celObj._skipColor),
@@ -528,7 +555,11 @@ void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Re
 	const Common::Point &scaledPosition = screenItem._scaledPosition;
 	const Ratio &scaleX = screenItem._ratioX;
 	const Ratio &scaleY = screenItem._ratioY;
-	_drawBlackLines = screenItem._drawBlackLines;
+	// The flag is only written when it is set, so that cels without black
+	// lines can be drawn from several threads at once
+	if (screenItem._drawBlackLines) {
+		_drawBlackLines = true;
+	}
 
 	if (_remap) {
 		// In SSCI, this check was `g_Remap_numActiveRemaps && _remap`, but
@@ -611,7 +642,9 @@ void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Re
 		}
 	}
 
-	_drawBlackLines = false;
+	if (screenItem._drawBlackLines) {
+		_drawBlackLines = false;
+	}
 }
 
 void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect, bool mirrorX) {
@@ -700,22 +733,28 @@ void CelObj::submitPalette() const {
 
 int CelObj::_nextCacheId = 1;
 CelCache *CelObj::_cache = nullptr;
+CelCacheIndex *CelObj::_cacheIndex = nullptr;
 
 int CelObj::searchCache(const CelInfo32 &celInfo, int *const nextInsertIndex) const {
 	*nextInsertIndex = -1;
+
+	CelCacheIndex::const_iterator it = _cacheIndex->find(celInfo);
+	if (it != _cacheIndex->end()) {
+		(*_cache)[it->_value].id = ++_nextCacheId;
+		return it->_value;
+	}
+
+	// Misses have to load the cel from its resource anyway, so there is no
+	// need to keep track of the least recently used entry
 	int oldestId = _nextCacheId + 1;
 	int oldestIndex = 0;
 
 	for (int i = 0, len = _cache->size(); i < len; ++i) {
-		CelCacheEntry &entry = (*_cache)[i];
+		const CelCacheEntry &entry = (*_cache)[i];
 
 		if (entry.celObj == nullptr) {
-			if (*nextInsertIndex == -1) {
-				*nextInsertIndex = i;
-			}
-		} else if (entry.celObj->_info == celInfo) {
-			entry.id = ++_nextCacheId;
-			return i;
+			*nextInsertIndex = i;
+			return -1;
 		} else if (oldestId > entry.id) {
 			oldestId = entry.id;
 			oldestIndex = i;
@@ -735,8 +774,17 @@ void CelObj::putCopyInCache(const int cacheIndex) const {
 	}
 
 	CelCacheEntry &entry = (*_cache)[cacheIndex];
+	if (entry.celObj) {
+		// Views may clamp the loop number after the cache was searched, so
+		// the same cel can be cached twice
+		CelCacheIndex::iterator it = _cacheIndex->find(entry.celObj->_info);
+		if (it != _cacheIndex->end() && it->_value == cacheIndex) {
+			_cacheIndex->erase(it);
+		}
+	}
 	entry.celObj.reset(duplicate());
 	entry.id = ++_nextCacheId;
+	(*_cacheIndex)[entry.celObj->_info] = cacheIndex;
 }
 
 #pragma mark -
@@ -22,6 +22,7 @@
 #ifndef SCI_GRAPHICS_CELOBJ32_H
 #define SCI_GRAPHICS_CELOBJ32_H
 
+#include "common/hashmap.h"
 #include "common/rational.h"
 #include "common/rect.h"
 #include "sci/resource/resource.h"
@@ -105,7 +106,7 @@ struct CelInfo32 {
 
 	// This is the equivalence criteria used by CelObj::searchCache in at least
 	// SSCI SQ6. Notably, it does not check the color field.
-	inline bool operator==(const CelInfo32 &other) {
+	inline bool operator==(const CelInfo32 &other) const {
 		return (
 			type == other.type &&
 			resourceId == other.resourceId &&
@@ -115,7 +116,7 @@ struct CelInfo32 {
 		);
 	}
 
-	inline bool operator!=(const CelInfo32 &other) {
+	inline bool operator!=(const CelInfo32 &other) const {
 		return !(*this == other);
 	}
 
@@ -148,6 +149,20 @@ struct CelCacheEntry {
 
 typedef Common::Array<CelCacheEntry> CelCache;
 
+/**
+ * Hashes the fields of a CelInfo32 which are compared by its equality
+ * operator.
+ */
+struct CelInfo32Hash {
+	uint operator()(const CelInfo32 &info) const {
+		return ((uint)info.type << 28) ^ ((uint)info.resourceId << 12) ^ ((uint16)info.loopNo << 6) ^ (uint16)info.celNo ^
+			((uint)info.bitmap.getSegment() << 16) ^ info.bitmap.getOffset();
+	}
+};
+
+/** Maps the CelInfo32 of every cached cel to its index in the CelCache. */
+typedef Common::HashMap<CelInfo32, int, CelInfo32Hash> CelCacheIndex;
+
 #pragma mark -
 #pragma mark CelScaler
 
@@ -155,7 +170,13 @@ enum {
 	/**
 	 * The maximum size of a row/column of scaled pixel data.
 	 */
-	kCelScalerTableSize = 4096
+	kCelScalerTableSize = 4096,
+
+	/**
+	 * The maximum number of scale tables which can be prepared for drawing
+	 * from several threads.
+	 */
+	kMaxPreparedScalerTables = 8
 };
 
 struct CelScalerTable {
@@ -195,6 +216,13 @@ class CelScaler {
 	 */
 	int _activeIndex;
 
+	/**
+	 * Scale tables which stay available until clearPreparedTables(), see
+	 * prepareTable().
+	 */
+	CelScalerTable *_preparedTables;
+	int _numPreparedTables;
+
 	/**
 	 * Activates a scale table for the given X and Y ratios. If there is no
 	 * table that matches the given ratios, the least most recently used table
@@ -212,7 +240,9 @@ class CelScaler {
 public:
 	CelScaler() :
 		_scaleTables(),
-		_activeIndex(0) {
+		_activeIndex(0),
+		_preparedTables(new CelScalerTable[kMaxPreparedScalerTables]),
+		_numPreparedTables(0) {
 		CelScalerTable &table = _scaleTables[0];
 		table.scaleX = Ratio();
 		table.scaleY = Ratio();
@@ -225,10 +255,28 @@ public:
 		}
 	}
 
+	~CelScaler() {
+		delete[] _preparedTables;
+	}
+
 	/**
 	 * Retrieves scaler tables for the given X and Y ratios.
 	 */
 	const CelScalerTable &getScalerTable(const Ratio &scaleX, const Ratio &scaleY);
+
+	/**
+	 * Builds a table for the given ratios in advance. Prepared tables are
+	 * returned by getScalerTable() without changing the scaler, so cels using
+	 * them can be drawn from several threads at once.
+	 *
+	 * @return False if there is no room for another prepared table.
+	 */
+	bool prepareTable(const Ratio &scaleX, const Ratio &scaleY);
+
+	/**
+	 * Discards all tables built by prepareTable().
+	 */
+	void clearPreparedTables() { _numPreparedTables = 0; }
 };
 
 #pragma mark -
@@ -259,6 +307,12 @@ protected:
 	 */
 	bool _drawMirrored;
 
+	/**
+	 * The resource data which is read when drawing, if it was resolved in
+	 * advance with setDrawResource().
+	 */
+	SciSpan<const byte> _drawResource;
+
 public:
 	static CelScaler *_scaler;
 
@@ -368,6 +422,27 @@ public:
 	 */
 	virtual void draw(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect, const bool mirrorX);
 
+	/**
+	 * Sets whether or not the cel will be mirrored by the const draw methods.
+	 */
+	void setDrawMirrored(const bool mirrorX) { _drawMirrored = mirrorX; }
+
+	/**
+	 * Sets the resource data which is read when drawing, so that the cel can
+	 * be drawn from threads other than the main one without looking up its
+	 * resource. The data must stay valid until the drawing is done, and an
+	 * empty span makes drawing look up the resource again.
+	 */
+	void setDrawResource(const SciSpan<const byte> &resource) { _drawResource = resource; }
+
+	/**
+	 * Retrieves the resource data to draw from, which is the one given to
+	 * setDrawResource() if there is one.
+	 */
+	const SciSpan<const byte> getDrawResPointer() const {
+		return _drawResource.data() ? _drawResource : getResPointer();
+	}
+
 	/**
 	 * Draws the cel to the target buffer using the positioning and mirroring
 	 * information from the provided arguments.
@@ -462,6 +537,12 @@ protected:
 	 */
 	static CelCache *_cache;
 
+	/**
+	 * The index of every entry in `_cache`, so that hits don't need to search
+	 * the whole cache.
+	 */
+	static CelCacheIndex *_cacheIndex;
+
 	/**
 	 * Searches the cel cache for a CelObj matching the provided CelInfo32. If
 	 * not found, -1 is returned. `nextInsertIndex` will receive the index of
@@ -22,6 +22,8 @@
 #include "common/algorithm.h"
 #include "common/config-manager.h"
 #include "common/events.h"
+#include "common/gui_options.h"
+#include "common/jobs.h"
 #include "common/keyboard.h"
 #include "common/list.h"
 #include "common/str.h"
@@ -34,6 +36,7 @@
 
 #include "sci/sci.h"
 #include "sci/console.h"
+#include "sci/detection.h"
 #include "sci/event.h"
 #include "sci/engine/features.h"
 #include "sci/engine/kernel.h"
@@ -513,9 +516,11 @@ void GfxFrameout::frameOut(const bool shouldShowBits, const Common::Rect &eraseR
 
 	_remapOccurred = _palette->updateForFrame();
 
-	for (PlaneList::size_type i = 0; i < _planes.size(); ++i) {
-		drawEraseList(eraseLists[i], *_planes[i]);
-		drawScreenItemList(_screenItemLists[i]);
+	if (!drawListsThreaded(eraseLists, _screenItemLists)) {
+		for (PlaneList::size_type i = 0; i < _planes.size(); ++i) {
+			drawEraseList(eraseLists[i], *_planes[i]);
+			drawScreenItemList(_screenItemLists[i]);
+		}
 	}
 
 	if (robotIsActive) {
@@ -1017,6 +1022,175 @@ void GfxFrameout::drawScreenItemList(const DrawList &screenItemList) {
 	}
 }
 
+namespace {
+
+enum {
+	/**
+	 * The minimum number of pixels which must be drawn in a frame for the
+	 * drawing to be spread across threads.
+	 */
+	kMinThreadedDrawArea = 32000,
+
+	/**
+	 * The minimum height of a band of the screen which is drawn by one thread.
+	 */
+	kMinThreadedDrawRows = 16
+};
+
+struct ThreadedDrawState {
+	Buffer *target;
+	const PlaneList *planes;
+	const EraseListList *eraseLists;
+	const ScreenItemListList *drawLists;
+};
+
+void drawListsBand(uint begin, uint end, void *refCon) {
+	const ThreadedDrawState &state = *static_cast<const ThreadedDrawState *>(refCon);
+	Buffer &target = *state.target;
+	const Common::Rect band(0, begin, target.w, end);
+
+	for (PlaneList::size_type i = 0; i < state.planes->size(); ++i) {
+		const Plane &plane = *(*state.planes)[i];
+		if (plane._type == kPlaneTypeColored) {
+			const RectList &eraseList = (*state.eraseLists)[i];
+			for (RectList::size_type j = 0; j < eraseList.size(); ++j) {
+				const Common::Rect rect = eraseList[j]->findIntersectingRect(band);
+				if (!rect.isEmpty()) {
+					target.fillRect(rect, plane._back);
+				}
+			}
+		}
+
+		const DrawList &drawList = (*state.drawLists)[i];
+		for (DrawList::size_type j = 0; j < drawList.size(); ++j) {
+			const DrawItem &drawItem = *drawList[j];
+			const Common::Rect rect = drawItem.rect.findIntersectingRect(band);
+			if (rect.isEmpty()) {
+				continue;
+			}
+
+			const ScreenItem &screenItem = *drawItem.screenItem;
+			const CelObj &celObj = *screenItem._celObj;
+			if (celObj._info.type == kCelTypeColor) {
+				static_cast<const CelObjColor &>(celObj).draw(target, rect);
+			} else {
+				celObj.draw(target, screenItem, rect);
+			}
+		}
+	}
+}
+
+} // End of anonymous namespace
+
+bool GfxFrameout::drawListsThreaded(const EraseListList &eraseLists, const ScreenItemListList &drawLists) {
+	Common::JobSystem *jobSystem = g_system->getJobSystem();
+	if (jobSystem->getThreadCount() <= 1) {
+		return false;
+	}
+
+	int area = 0;
+	bool hasScaledItems = false;
+	for (PlaneList::size_type i = 0; i < _planes.size(); ++i) {
+		if (_planes[i]->_type == kPlaneTypeColored) {
+			for (RectList::size_type j = 0; j < eraseLists[i].size(); ++j) {
+				area += eraseLists[i][j]->width() * eraseLists[i][j]->height();
+			}
+		}
+
+		for (DrawList::size_type j = 0; j < drawLists[i].size(); ++j) {
+			const DrawItem &drawItem = *drawLists[i][j];
+			const ScreenItem &screenItem = *drawItem.screenItem;
+			// Black lines depend on the row a cel starts drawing from and are
+			// drawn using a static flag, so they cannot be split into bands
+			if (screenItem._drawBlackLines) {
+				return false;
+			}
+			if (!screenItem._ratioX.isOne() || !screenItem._ratioY.isOne()) {
+				hasScaledItems = true;
+			}
+			area += drawItem.rect.width() * drawItem.rect.height();
+		}
+	}
+
+	if (area < kMinThreadedDrawArea) {
+		return false;
+	}
+
+	// LarryScale reads the configuration for every cel it draws
+	if (hasScaledItems && Common::checkGameGUIOption(GAMEOPTION_LARRYSCALE, ConfMan.get("guioptions")) && ConfMan.getBool("enable_larryscale")) {
+		return false;
+	}
+
+	// The scaler normally rebuilds its two tables whenever a cel with a
+	// different ratio is drawn, so build all of the tables up front
+	for (PlaneList::size_type i = 0; i < _planes.size(); ++i) {
+		for (DrawList::size_type j = 0; j < drawLists[i].size(); ++j) {
+			const ScreenItem &screenItem = *drawLists[i][j]->screenItem;
+			if (screenItem._celObj->_info.type != kCelTypeColor &&
+				(!screenItem._ratioX.isOne() || !screenItem._ratioY.isOne()) &&
+				!CelObj::_scaler->prepareTable(screenItem._ratioX, screenItem._ratioY)) {
+				CelObj::_scaler->clearPreparedTables();
+				return false;
+			}
+		}
+	}
+
+	// Everything which changes shared state is done here in drawing order.
+	// The resource manager is not thread-safe, so the resource data of every
+	// cel is looked up here and handed to the cels, which then draw without
+	// going through the resource manager. The resources are locked so that
+	// loading one of them cannot purge another.
+	Common::Array<Resource *> lockedResources;
+	for (PlaneList::size_type i = 0; i < _planes.size(); ++i) {
+		const RectList &eraseList = eraseLists[i];
+		if (_planes[i]->_type == kPlaneTypeColored) {
+			for (RectList::size_type j = 0; j < eraseList.size(); ++j) {
+				mergeToShowList(*eraseList[j], _showList, _overdrawThreshold);
+			}
+		}
+
+		for (DrawList::size_type j = 0; j < drawLists[i].size(); ++j) {
+			const DrawItem &drawItem = *drawLists[i][j];
+			mergeToShowList(drawItem.rect, _showList, _overdrawThreshold);
+
+			const ScreenItem &screenItem = *drawItem.screenItem;
+			CelObj &celObj = *screenItem._celObj;
+			celObj.setDrawMirrored(screenItem._mirrorX ^ celObj._mirrorX);
+
+			Resource *resource = nullptr;
+			if (celObj._info.type == kCelTypeView) {
+				resource = g_sci->getResMan()->findResource(ResourceId(kResourceTypeView, celObj._info.resourceId), true);
+			} else if (celObj._info.type == kCelTypePic) {
+				resource = g_sci->getResMan()->findResource(ResourceId(kResourceTypePic, celObj._info.resourceId), true);
+			}
+			if (resource) {
+				lockedResources.push_back(resource);
+			}
+			if (celObj._info.type != kCelTypeColor) {
+				celObj.setDrawResource(celObj.getResPointer());
+			}
+		}
+	}
+
+	ThreadedDrawState state;
+	state.target = &_currentBuffer;
+	state.planes = &_planes;
+	state.eraseLists = &eraseLists;
+	state.drawLists = &drawLists;
+	jobSystem->parallelFor(_currentBuffer.h, drawListsBand, &state, kMinThreadedDrawRows);
+
+	for (PlaneList::size_type i = 0; i < _planes.size(); ++i) {
+		for (DrawList::size_type j = 0; j < drawLists[i].size(); ++j) {
+			drawLists[i][j]->screenItem->_celObj->setDrawResource(SciSpan<const byte>());
+		}
+	}
+	for (uint i = 0; i < lockedResources.size(); ++i) {
+		g_sci->getResMan()->unlockResource(lockedResources[i]);
+	}
+	CelObj::_scaler->clearPreparedTables();
+	return true;
+}
+
 void GfxFrameout::mergeToShowList(const Common::Rect &drawRect, RectList &showList, const int overdrawThreshold) {
 	RectList mergeList;
 	Common::Rect merged;
@@ -374,6 +374,15 @@ private:
 	 */
 	void drawScreenItemList(const DrawList &screenItemList);
 
+	/**
+	 * Draws the erase lists and draw lists of all planes, splitting the screen
+	 * into horizontal bands which are drawn by the job system's threads.
+	 *
+	 * @returns False if the lists need to be drawn serially instead, in which
+	 * case nothing has been drawn.
+	 */
+	bool drawListsThreaded(const EraseListList &eraseLists, const ScreenItemListList &drawLists);
+
 	/**
 	 * Adds a new rectangle to the list of regions to write out to the hardware.
 	 * The provided rect may be merged into an existing rectangle to reduce the
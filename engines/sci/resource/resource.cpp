@@ -24,7 +24,10 @@
 #include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
+#include "common/jobs.h"
 #include "common/macresman.h"
+#include "common/memtracker.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 #ifdef ENABLE_SCI32
@@ -421,6 +424,10 @@ void ResourceManager::disposeVolumeFileStream(Common::SeekableReadStream *fileSt
 }
 
 void ResourceManager::loadResource(Resource *res) {
+	Prefetch *prefetch = _prefetches.getValOrDefault(res->_id, nullptr);
+	if (prefetch && finishPrefetch(prefetch))
+		return;
+
 	res->_source->loadResource(this, res);
 	if (_patcher) {
 		_patcher->applyPatch(*res);
@@ -598,14 +605,9 @@ Common::SeekableReadStream *ResourceSource::getVolumeFile(ResourceManager *resMa
 	return fileStream;
 }
 
-void ResourceSource::loadResource(ResourceManager *resMan, Resource *res) {
-	Common::SeekableReadStream *fileStream = getVolumeFile(resMan, res);
-	if (!fileStream)
-		return;
-
+ResVersion ResourceSource::getVolVersion(ResourceManager *resMan, Common::SeekableReadStream *fileStream, const Resource *res) const {
 	fileStream->seek(0, SEEK_SET);
 	ResourceType type = resMan->convertResType(fileStream->readByte());
-	ResVersion volVersion = resMan->getVolVersion();
 
 	// FIXME: if resource.msg has different version from SCI, this has to be modified.
 	if (
@@ -614,7 +616,17 @@ void ResourceSource::loadResource(ResourceManager *resMan, Resource *res) {
 			(type == kResourceTypeText && res->getType() == kResourceTypeText)
 		) &&
 		g_sci && g_sci->getLanguage() == Common::KO_KOR)
-		volVersion = kResVersionSci11;
+		return kResVersionSci11;
+
+	return resMan->getVolVersion();
+}
+
+void ResourceSource::loadResource(ResourceManager *resMan, Resource *res) {
+	Common::SeekableReadStream *fileStream = getVolumeFile(resMan, res);
+	if (!fileStream)
+		return;
+
+	ResVersion volVersion = getVolVersion(resMan, fileStream, res);
 	fileStream->seek(res->_fileOffset, SEEK_SET);
 
 	int error = res->decompress(volVersion, fileStream);
@@ -1001,7 +1013,8 @@ void ResourceManager::freeResourceSources() {
 }
 
 ResourceManager::ResourceManager(const bool detectionMode) :
-	_detectionMode(detectionMode) {}
+	_detectionMode(detectionMode),
+	_memoryPrefetch(0) {}
 
 void ResourceManager::init() {
 	_maxMemoryLRU = 256 * 1024; // 256KiB
@@ -1107,6 +1120,9 @@ void ResourceManager::init() {
 }
 
 ResourceManager::~ResourceManager() {
+	cancelPrefetches();
+	MEMORY_TRACK_REMOVE(Common::kMemoryEngineResources, _memoryLRU + _memoryLocked);
+
 	// freeing resources
 	ResourceMap::iterator itr = _resMap.begin();
 	while (itr != _resMap.end()) {
@@ -1129,6 +1145,7 @@ void ResourceManager::removeFromLRU(Resource *res) {
 	}
 	_LRU.remove(res);
 	_memoryLRU -= res->size();
+	MEMORY_TRACK_REMOVE(Common::kMemoryEngineResources, res->size());
 	res->_status = kResStatusAllocated;
 }
 
@@ -1139,6 +1156,7 @@ void ResourceManager::addToLRU(Resource *res) {
 	}
 	_LRU.push_front(res);
 	_memoryLRU += res->size();
+	MEMORY_TRACK_ADD(Common::kMemoryEngineResources, res->size());
 #ifdef SCI_VERBOSE_RESMAN
 	debug("Adding %s (%d bytes) to lru control: %d bytes total",
 	      res->_id.toString().c_str(), res->size,
@@ -1215,6 +1233,7 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 			retval->_status = kResStatusLocked;
 			retval->_lockers = 0;
 			_memoryLocked += retval->_size;
+			MEMORY_TRACK_ADD(Common::kMemoryEngineResources, retval->_size);
 		}
 		retval->_lockers++;
 	} else if (retval->_status != kResStatusLocked) { // Don't lock it
@@ -1230,6 +1249,179 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	}
 }
 
+struct ResourceManager::Prefetch {
+	Common::JobGroup group;
+	Resource *resource;
+	ResourceId id;
+	Decompressor *decompressor;
+	byte *packedData;
+	uint32 packedSize;
+	byte *data;
+	uint32 size;
+	int error;
+};
+
+void ResourceManager::decompressPrefetch(void *refCon) {
+	ResourceManager::Prefetch &prefetch = *(ResourceManager::Prefetch *)refCon;
+	Common::MemoryReadStream stream(prefetch.packedData, prefetch.packedSize);
+	prefetch.data = new byte[prefetch.size];
+	prefetch.error = prefetch.decompressor->unpack(&stream, prefetch.data, prefetch.packedSize, prefetch.size);
+}
+
+static Decompressor *createDecompressor(ResourceCompression compression) {
+	switch (compression) {
+	case kCompNone:
+		return new Decompressor;
+	case kCompHuffman:
+		return new DecompressorHuffman;
+	case kCompLZW:
+	case kCompLZW1:
+	case kCompLZW1View:
+	case kCompLZW1Pic:
+		return new DecompressorLZW(compression);
+	case kCompDCL:
+		return new DecompressorDCL;
+#ifdef ENABLE_SCI32
+	case kCompSTACpack:
+		return new DecompressorLZS;
+#endif
+	default:
+		return nullptr;
+	}
+}
+
+void ResourceManager::prefetchResource(ResourceId id) {
+	if (_detectionMode || g_system->getJobSystem()->getThreadCount() <= 1)
+		return;
+
+	// Finished prefetches are collected here rather than in findResource(),
+	// so that looking up a resource which is already loaded does not change
+	// the LRU or the prefetch queue
+	if (!_prefetches.empty())
+		collectPrefetches();
+
+	// Audio resources are left out, as they can be deleted when the audio
+	// maps change
+	switch (id.getType()) {
+	case kResourceTypeView:
+	case kResourceTypePic:
+	case kResourceTypeScript:
+	case kResourceTypeHeap:
+	case kResourceTypeSound:
+	case kResourceTypeMessage:
+	case kResourceTypePalette:
+		break;
+	default:
+		return;
+	}
+
+	Resource *res = testResource(id);
+	if (!res || res->_status != kResStatusNoMalloc || res->_source->getSourceType() != kSourceVolume || _prefetches.contains(id))
+		return;
+
+	Common::SeekableReadStream *fileStream = getVolumeFile(res->_source);
+	if (!fileStream)
+		return;
+
+	// The volume is read here, as file access is not thread-safe; only the
+	// decompression is done by the job system
+	ResVersion volVersion = res->_source->getVolVersion(this, fileStream, res);
+	fileStream->seek(res->_fileOffset, SEEK_SET);
+
+	uint32 szPacked = 0;
+	ResourceCompression compression = kCompUnknown;
+	Decompressor *dec = nullptr;
+	byte *packedData = nullptr;
+	if (!res->readResourceInfo(volVersion, fileStream, szPacked, compression) &&
+		_memoryLRU + _memoryPrefetch + res->_size + szPacked <= (uint32)_maxMemoryLRU &&
+		(dec = createDecompressor(compression)) != nullptr) {
+		packedData = new byte[szPacked];
+		if (fileStream->read(packedData, szPacked) != szPacked) {
+			delete[] packedData;
+			packedData = nullptr;
+			delete dec;
+		}
+	}
+
+	disposeVolumeFileStream(fileStream, res->_source);
+
+	if (!packedData)
+		return;
+
+	Prefetch *prefetch = new Prefetch();
+	prefetch->resource = res;
+	prefetch->id = id;
+	prefetch->decompressor = dec;
+	prefetch->packedData = packedData;
+	prefetch->packedSize = szPacked;
+	prefetch->data = nullptr;
+	prefetch->size = res->_size;
+	prefetch->error = SCI_ERROR_NONE;
+	_prefetches[id] = prefetch;
+	_memoryPrefetch += prefetch->size + prefetch->packedSize;
+
+	debugC(kDebugLevelResMan, 2, "[resMan] Prefetching %s", id.toString().c_str());
+	g_system->getJobSystem()->submit(decompressPrefetch, prefetch, &prefetch->group);
+}
+
+void ResourceManager::prefetchRoom(uint16 roomNumber) {
+	prefetchResource(ResourceId(kResourceTypePic, roomNumber));
+	prefetchResource(ResourceId(kResourceTypeMessage, roomNumber));
+}
+
+bool ResourceManager::finishPrefetch(Prefetch *prefetch) {
+	g_system->getJobSystem()->wait(prefetch->group);
+
+	_prefetches.erase(prefetch->id);
+	_memoryPrefetch -= prefetch->size + prefetch->packedSize;
+
+	Resource *res = prefetch->resource;
+	bool loaded = false;
+	if (res && res->_status == kResStatusNoMalloc && !prefetch->error) {
+		res->_data = prefetch->data;
+		res->_size = prefetch->size;
+		res->_status = kResStatusAllocated;
+		res->checkAudioHeader();
+		if (_patcher) {
+			_patcher->applyPatch(*res);
+		}
+		loaded = true;
+	} else {
+		delete[] prefetch->data;
+	}
+
+	delete prefetch->decompressor;
+	delete[] prefetch->packedData;
+	delete prefetch;
+	return loaded;
+}
+
+void ResourceManager::collectPrefetches() {
+	Common::Array<Prefetch *> done;
+	for (PrefetchMap::const_iterator it = _prefetches.begin(); it != _prefetches.end(); ++it) {
+		if (it->_value->group.isDone())
+			done.push_back(it->_value);
+	}
+
+	for (uint i = 0; i < done.size(); ++i) {
+		Resource *res = done[i]->resource;
+		if (finishPrefetch(done[i]))
+			addToLRU(res);
+	}
+
+	freeOldResources();
+}
+
+void ResourceManager::cancelPrefetches() {
+	while (!_prefetches.empty()) {
+		Prefetch *prefetch = _prefetches.begin()->_value;
+		// Make sure that the data is discarded instead of being handed to
+		// the resource
+		prefetch->resource = nullptr;
+		finishPrefetch(prefetch);
+	}
+}
+
 void ResourceManager::unlockResource(Resource *res) {
 	assert(res);
 
@@ -1241,6 +1433,7 @@ void ResourceManager::unlockResource(Resource *res) {
 	if (!--res->_lockers) { // No more lockers?
 		res->_status = kResStatusAllocated;
 		_memoryLocked -= res->size();
+		MEMORY_TRACK_REMOVE(Common::kMemoryEngineResources, res->size());
 		addToLRU(res);
 	}
 
@@ -2373,29 +2566,8 @@ int Resource::decompress(ResVersion volVersion, Common::SeekableReadStream *file
 		return errorNum;
 
 	// getting a decompressor
-	Decompressor *dec = nullptr;
-	switch (compression) {
-	case kCompNone:
-		dec = new Decompressor;
-		break;
-	case kCompHuffman:
-		dec = new DecompressorHuffman;
-		break;
-	case kCompLZW:
-	case kCompLZW1:
-	case kCompLZW1View:
-	case kCompLZW1Pic:
-		dec = new DecompressorLZW(compression);
-		break;
-	case kCompDCL:
-		dec = new DecompressorDCL;
-		break;
-#ifdef ENABLE_SCI32
-	case kCompSTACpack:
-		dec = new DecompressorLZS;
-		break;
-#endif
-	default:
+	Decompressor *dec = createDecompressor(compression);
+	if (!dec) {
 		error("Resource %s: Compression method %d not supported", _id.toString().c_str(), compression);
 		return SCI_ERROR_UNKNOWN_COMPRESSION;
 	}
@@ -2407,26 +2579,30 @@ int Resource::decompress(ResVersion volVersion, Common::SeekableReadStream *file
 	if (errorNum) {
 		unalloc();
 	} else {
-		// At least Lighthouse puts sound effects in RESSCI.00n/RESSCI.PAT
-		// instead of using a RESOURCE.SFX
-		if (getType() == kResourceTypeAudio) {
-			const uint8 headerSize = ptr[1];
-			if (headerSize < 11) {
-				error("Unexpected audio header size for %s: should be >= 11, but got %d", _id.toString().c_str(), headerSize);
-			}
-			const uint32 audioSize = READ_LE_UINT32(ptr + 9);
-			const uint32 calculatedTotalSize = audioSize + headerSize + kResourceHeaderSize;
-			if (calculatedTotalSize != _size) {
-				warning("Unexpected audio file size: the size of %s in %s is %d, but the volume says it should be %d", _id.toString().c_str(), _source->getLocationName().toString().c_str(), calculatedTotalSize, _size);
-			}
-			_size = MIN(_size - kResourceHeaderSize, headerSize + audioSize);
-		}
+		checkAudioHeader();
 	}
 
 	delete dec;
 	return errorNum;
 }
 
+void Resource::checkAudioHeader() {
+	// At least Lighthouse puts sound effects in RESSCI.00n/RESSCI.PAT
+	// instead of using a RESOURCE.SFX
+	if (getType() == kResourceTypeAudio) {
+		const uint8 headerSize = _data[1];
+		if (headerSize < 11) {
+			error("Unexpected audio header size for %s: should be >= 11, but got %d", _id.toString().c_str(), headerSize);
+		}
+		const uint32 audioSize = READ_LE_UINT32(_data + 9);
+		const uint32 calculatedTotalSize = audioSize + headerSize + kResourceHeaderSize;
+		if (calculatedTotalSize != _size) {
+			warning("Unexpected audio file size: the size of %s in %s is %d, but the volume says it should be %d", _id.toString().c_str(), _source->getLocationName().toString().c_str(), calculatedTotalSize, _size);
+		}
+		_size = MIN(_size - kResourceHeaderSize, headerSize + audioSize);
+	}
+}
+
 ResourceCompression ResourceManager::getViewCompression() {
 	int viewsTested = 0;
 
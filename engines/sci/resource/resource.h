@@ -319,6 +319,7 @@ protected:
 	bool loadFromAudioVolumeSCI11(Common::SeekableReadStream *file);
 	int decompress(ResVersion volVersion, Common::SeekableReadStream *file);
 	int readResourceInfo(ResVersion volVersion, Common::SeekableReadStream *file, uint32 &szPacked, ResourceCompression &compression);
+	void checkAudioHeader();
 };
 
 typedef Common::HashMap<ResourceId, Resource *, ResourceIdHash> ResourceMap;
@@ -380,6 +381,23 @@ public:
 	 */
 	void unlockResource(Resource *res);
 
+	/**
+	 * Starts decompressing a resource in the background, so that it is
+	 * already in memory once it is needed. Does nothing if the resource is
+	 * loaded already, if it is not stored in a resource volume, or if there
+	 * is not enough room for it in the LRU. Prefetches which have finished
+	 * in the meantime are added to the LRU. Like the rest of the resource
+	 * manager, this must only be called from the main thread.
+	 * @param id	The resource to prefetch
+	 */
+	void prefetchResource(ResourceId id);
+
+	/**
+	 * Prefetches the resources which a room is likely to need right away.
+	 * @param roomNumber	The room which is being entered
+	 */
+	void prefetchRoom(uint16 roomNumber);
+
 	/**
 	 * Tests whether a resource exists.
 	 *
@@ -502,6 +520,11 @@ protected:
 	int _memoryLocked;	///< Amount of resource bytes in locked memory
 	int _memoryLRU;		///< Amount of resource bytes under LRU control
 	Common::List<Resource *> _LRU; ///< Last Resource Used list
+
+	struct Prefetch;
+	typedef Common::HashMap<ResourceId, Prefetch *, ResourceIdHash> PrefetchMap;
+	PrefetchMap _prefetches; ///< Resources being decompressed in the background
+	int _memoryPrefetch;	///< Amount of bytes held by unfinished prefetches
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
@@ -647,6 +670,26 @@ protected:
 	void addToLRU(Resource *res);
 	void removeFromLRU(Resource *res);
 
+	/**
+	 * Waits for a prefetch to complete and hands its data to the resource,
+	 * unless the resource has been loaded in the meantime.
+	 * @return true if the resource has been loaded from the prefetched data
+	 */
+	bool finishPrefetch(Prefetch *prefetch);
+
+	/**
+	 * Finishes all prefetches which have completed, and adds their resources
+	 * to the LRU.
+	 */
+	void collectPrefetches();
+
+	/**
+	 * Waits for and discards all pending prefetches.
+	 */
+	void cancelPrefetches();
+
+	static void decompressPrefetch(void *refCon);
+
 	ResourceCompression getViewCompression();
 	ViewType detectViewType();
 	bool hasSci0Voc999();
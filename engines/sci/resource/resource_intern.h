@@ -66,6 +66,11 @@ public:
 	// Auxiliary method, used by loadResource implementations.
 	Common::SeekableReadStream *getVolumeFile(ResourceManager *resMan, Resource *res);
 
+	/**
+	 * Returns the volume version the given resource has to be read with.
+	 */
+	ResVersion getVolVersion(ResourceManager *resMan, Common::SeekableReadStream *fileStream, const Resource *res) const;
+
 	/**
 	 * TODO: Document this
 	 */
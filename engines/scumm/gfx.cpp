@@ -215,6 +215,8 @@ Gdi::Gdi(ScummEngine *vm) : _vm(vm) {
 	_vertStripNextInc = 0;
 	_zbufferDisabled = false;
 	_objectMode = false;
+	_cacheStrips = false;
+	memset(_stripCachePalette, 0, sizeof(_stripCachePalette));
 	_distaff = false;
 }
 
@@ -285,6 +287,7 @@ void Gdi::init() {
 }
 
 void Gdi::roomChanged(byte *roomptr) {
+	_stripCache.clear();
 }
 
 void GdiNES::roomChanged(byte *roomptr) {
@@ -591,33 +594,60 @@ void ScummEngine::updateDirtyScreen(VirtScreenNumber slot) {
 	if (vs->h == 0)
 		return;
 
-	int i;
-	int w = 8;
-	int start = 0;
-
-	for (i = 0; i < _gdi->_numStrips; i++) {
-		if (vs->bdirty[i]) {
-			const int top = vs->tdirty[i];
-			const int bottom = vs->bdirty[i];
-			vs->tdirty[i] = vs->h;
-			vs->bdirty[i] = 0;
-			if (i != (_gdi->_numStrips - 1) && vs->bdirty[i + 1] == bottom && vs->tdirty[i + 1] == top) {
-				// Simple optimizations: if two or more neighboring strips
-				// form one bigger rectangle, coalesce them.
-				w += 8;
+	// Neighboring dirty strips are blitted as one rectangle, as long as that
+	// doesn't redraw much more than what is actually dirty. Each blit has a
+	// fixed cost in the backend, so a few big ones beat many thin strips.
+	const int maxOverdraw = 2;
+	int start = -1;
+	int top = 0, bottom = 0;
+	int dirtyArea = 0;
+
+	for (int i = 0; i < _gdi->_numStrips; i++) {
+		if (!vs->bdirty[i]) {
+			if (start >= 0)
+				drawDirtyStrips(vs, start, i - start, top, bottom);
+			start = -1;
+			continue;
+		}
+
+		const int stripTop = vs->tdirty[i];
+		const int stripBottom = vs->bdirty[i];
+		const int stripArea = MAX(stripBottom - stripTop, 0) * 8;
+		vs->tdirty[i] = vs->h;
+		vs->bdirty[i] = 0;
+
+		if (start >= 0) {
+			const int mergedTop = MIN(top, stripTop);
+			const int mergedBottom = MAX(bottom, stripBottom);
+			if ((i + 1 - start) * 8 * (mergedBottom - mergedTop) <= (dirtyArea + stripArea) * maxOverdraw) {
+				top = mergedTop;
+				bottom = mergedBottom;
+				dirtyArea += stripArea;
 				continue;
 			}
-#ifndef DISABLE_TOWNS_DUAL_LAYER_MODE
-			if (_game.platform == Common::kPlatformFMTowns && vs->number == kBannerVirtScreen) {
-				int scl = _textSurfaceMultiplier;
-				towns_drawStripToScreen(vs, start * 8 * scl, (vs->topline + top) * scl, start * 8 * scl, top * scl, w * scl, bottom - top);
-			} else
-#endif
-				drawStripToScreen(vs, start * 8, w, top, bottom);
-			w = 8;
+			drawDirtyStrips(vs, start, i - start, top, bottom);
 		}
-		start = i + 1;
+
+		start = i;
+		top = stripTop;
+		bottom = stripBottom;
+		dirtyArea = stripArea;
 	}
+
+	if (start >= 0)
+		drawDirtyStrips(vs, start, _gdi->_numStrips - start, top, bottom);
+}
+
+void ScummEngine::drawDirtyStrips(VirtScreen *vs, int start, int numStrips, int top, int bottom) {
+	const int w = numStrips * 8;
+
+#ifndef DISABLE_TOWNS_DUAL_LAYER_MODE
+	if (_game.platform == Common::kPlatformFMTowns && vs->number == kBannerVirtScreen) {
+		int scl = _textSurfaceMultiplier;
+		towns_drawStripToScreen(vs, start * 8 * scl, (vs->topline + top) * scl, start * 8 * scl, top * scl, w * scl, bottom - top);
+	} else
+#endif
+		drawStripToScreen(vs, start * 8, w, top, bottom);
 }
 
 /**
@@ -1178,7 +1208,9 @@ void ScummEngine::redrawBGStrip(int start, int num) {
 	else
 		room = getResourceAddress(rtRoom, _roomResource);
 
-	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, 0);
+	// HE70+ scripts can draw into the room image, so it can't be cached
+	const byte flag = (_game.heversion >= 70) ? 0 : Gdi::dbCacheStrips;
+	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, flag);
 }
 
 void ScummEngine::restoreBackground(Common::Rect rect, byte backColor) {
@@ -2361,6 +2393,7 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	_vertStripNextInc = height * vs->pitch - 1 * vs->format.bytesPerPixel;
 
 	_objectMode = (flag & dbObjectMode) == dbObjectMode;
+	_cacheStrips = (flag & dbCacheStrips) && !_objectMode;
 	prepareDrawBitmap(ptr, vs, x, y, width, height, stripnr, numstrip);
 
 	sx = x - vs->xstart / 8;
@@ -2517,6 +2550,9 @@ bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width,
 		return result;
 	}
 
+	if (_cacheStrips)
+		return decompressCachedBitmap(dstPtr, vs->pitch, vs->format.bytesPerPixel, stripnr, smap_ptr + offset, height);
+
 	return decompressBitmap(dstPtr, vs->pitch, smap_ptr + offset, height);
 }
 
@@ -2952,6 +2988,53 @@ void Gdi::resetBackground(int top, int bottom, int strip) {
 	}
 }
 
+bool Gdi::decompressCachedBitmap(byte *dst, int dstPitch, int bytesPerPixel, int stripnr, const byte *src, int numLinesToProcess) {
+	const int rowSize = 8 * bytesPerPixel;
+
+	// The decoded colors depend on the room palette, which scripts may change
+	if (memcmp(_stripCachePalette, _roomPalette, sizeof(_stripCachePalette))) {
+		_stripCache.clear();
+		memcpy(_stripCachePalette, _roomPalette, sizeof(_stripCachePalette));
+	}
+
+	if (stripnr < 0)
+		return decompressBitmap(dst, dstPitch, src, numLinesToProcess);
+
+	if ((uint)stripnr < _stripCache.size()) {
+		const CachedStrip &strip = _stripCache[stripnr];
+		if (strip.src == src && strip.height == numLinesToProcess) {
+			const byte *pixels = strip.pixels.data();
+			for (int y = 0; y < numLinesToProcess; y++) {
+				memcpy(dst, pixels, rowSize);
+				dst += dstPitch;
+				pixels += rowSize;
+			}
+			return false;
+		}
+	}
+
+	// Transparent strips depend on what was drawn below them, so only cache
+	// the ones that were fully overwritten
+	if (decompressBitmap(dst, dstPitch, src, numLinesToProcess))
+		return true;
+
+	if ((uint)stripnr >= _stripCache.size())
+		_stripCache.resize(stripnr + 1);
+
+	CachedStrip &strip = _stripCache[stripnr];
+	strip.src = src;
+	strip.height = numLinesToProcess;
+	strip.pixels.resize(rowSize * numLinesToProcess);
+
+	byte *pixels = strip.pixels.data();
+	for (int y = 0; y < numLinesToProcess; y++) {
+		memcpy(pixels, dst, rowSize);
+		dst += dstPitch;
+		pixels += rowSize;
+	}
+	return false;
+}
+
 bool Gdi::decompressBitmap(byte *dst, int dstPitch, const byte *src, int numLinesToProcess) {
 	assert(numLinesToProcess);
 
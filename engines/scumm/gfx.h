@@ -23,6 +23,7 @@
 #define SCUMM_GFX_H
 
 #include "common/system.h"
+#include "common/array.h"
 #include "common/list.h"
 
 #include "graphics/surface.h"
@@ -304,6 +305,24 @@ protected:
 	/** Flag which is true when an object is being rendered, false otherwise. */
 	bool _objectMode;
 
+	/** Flag which is true when the room background is being rendered with dbCacheStrips. */
+	bool _cacheStrips;
+
+	/**
+	 * An opaque, decoded strip of the room background. Strips which scroll
+	 * back into view are copied from here instead of being decoded again.
+	 */
+	struct CachedStrip {
+		const byte *src;
+		int height;
+		Common::Array<byte> pixels;
+
+		CachedStrip() : src(nullptr), height(0) {}
+	};
+
+	Common::Array<CachedStrip> _stripCache;
+	byte _stripCachePalette[256];
+
 public:
 	/** Flag which is true when loading objects or titles for distaff, in PCEngine version of Loom. */
 	bool _distaff;
@@ -315,6 +334,7 @@ public:
 protected:
 	/* Bitmap decompressors */
 	bool decompressBitmap(byte *dst, int dstPitch, const byte *src, int numLinesToProcess);
+	bool decompressCachedBitmap(byte *dst, int dstPitch, int bytesPerPixel, int stripnr, const byte *src, int numLinesToProcess);
 
 	void drawStripEGA(byte *dst, int dstPitch, const byte *src, int height) const;
 
@@ -380,7 +400,8 @@ public:
 	enum DrawBitmapFlags {
 		dbAllowMaskOr   = 1 << 0,
 		dbDrawMaskOnAll = 1 << 1,
-		dbObjectMode    = 2 << 2
+		dbObjectMode    = 2 << 2,
+		dbCacheStrips   = 1 << 4
 	};
 };
 
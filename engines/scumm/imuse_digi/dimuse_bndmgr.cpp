@@ -21,6 +21,7 @@
 
 
 #include "common/scummsys.h"
+#include "common/system.h"
 #include "scumm/scumm.h"
 #include "scumm/util.h"
 #include "scumm/file.h"
@@ -218,6 +219,7 @@ void BundleMgr::close() {
 		_compTable = nullptr;
 		free(_compInputBuff);
 		_compInputBuff = nullptr;
+		cancelDecodeAhead();
 	}
 }
 
@@ -254,9 +256,67 @@ bool BundleMgr::loadCompTable(int32 index) {
 	_compInputBuff = (byte *)malloc(maxSize + 1);
 	assert(_compInputBuff);
 
+	// Decompress the next block in the background, unless there is no
+	// thread to do it on
+	if (_numCompItems > 1 && g_system->getJobSystem()->getThreadCount() > 1) {
+		_decodeAhead = new DecodeAhead();
+		_decodeAhead->block = -1;
+		_decodeAhead->input = (byte *)malloc(maxSize + 1);
+		assert(_decodeAhead->input);
+	}
+
 	return true;
 }
 
+void BundleMgr::decodeAheadProc(void *refCon) {
+	DecodeAhead *ahead = (DecodeAhead *)refCon;
+	ahead->outputSize = BundleCodecs::decompressCodec(ahead->codec, ahead->input, ahead->output, ahead->inputSize);
+}
+
+void BundleMgr::startDecodeAhead(int32 index, int block) {
+	if (!_decodeAhead || block >= _numCompItems || _decodeAhead->block == block)
+		return;
+
+	// Only the decompression runs in the job, the file is read here
+	finishDecodeAhead(-1);
+	_decodeAhead->block = block;
+	_decodeAhead->codec = _compTable[block].codec;
+	_decodeAhead->inputSize = _compTable[block].size;
+	// CMI hack: one more zero byte at the end of input buffer
+	_decodeAhead->input[_compTable[block].size] = 0;
+	_file->seek(_bundleTable[index].offset + _compTable[block].offset, SEEK_SET);
+	_file->read(_decodeAhead->input, _compTable[block].size);
+
+	g_system->getJobSystem()->submit(decodeAheadProc, _decodeAhead, &_decodeAhead->group);
+}
+
+bool BundleMgr::finishDecodeAhead(int block) {
+	if (!_decodeAhead || _decodeAhead->block == -1)
+		return false;
+
+	g_system->getJobSystem()->wait(_decodeAhead->group);
+
+	const bool found = (_decodeAhead->block == block);
+	_decodeAhead->block = -1;
+	if (!found)
+		return false;
+
+	_outputSize = _decodeAhead->outputSize;
+	if (_outputSize > 0 && _outputSize <= DIMUSE_BUN_CHUNK_SIZE)
+		memcpy(_compOutputBuff, _decodeAhead->output, _outputSize);
+	return true;
+}
+
+void BundleMgr::cancelDecodeAhead() {
+	if (!_decodeAhead)
+		return;
+
+	finishDecodeAhead(-1);
+	free(_decodeAhead->input);
+	delete _decodeAhead;
+	_decodeAhead = nullptr;
+}
+
 int32 BundleMgr::seekFile(int32 offset, int mode) {
 	// We don't actually seek the file, but instead try to find that the specified offset exists
 	// within the decompressed blocks, and save that offset in _curDecompressedFilePos
@@ -350,11 +410,13 @@ int32 BundleMgr::readFile(const char *name, int32 size, byte **comp_final, bool
 
 		for (i = firstBlock; i <= lastBlock; i++) {
 			if (_lastBlock != i) {
-				// CMI hack: one more zero byte at the end of input buffer
-				_compInputBuff[_compTable[i].size] = 0;
-				_file->seek(_bundleTable[found->index].offset + _compTable[i].offset, SEEK_SET);
-				_file->read(_compInputBuff, _compTable[i].size);
-				_outputSize = BundleCodecs::decompressCodec(_compTable[i].codec, _compInputBuff, _compOutputBuff, _compTable[i].size);
+				if (!finishDecodeAhead(i)) {
+					// CMI hack: one more zero byte at the end of input buffer
+					_compInputBuff[_compTable[i].size] = 0;
+					_file->seek(_bundleTable[found->index].offset + _compTable[i].offset, SEEK_SET);
+					_file->read(_compInputBuff, _compTable[i].size);
+					_outputSize = BundleCodecs::decompressCodec(_compTable[i].codec, _compInputBuff, _compOutputBuff, _compTable[i].size);
+				}
 
 				if (_outputSize > DIMUSE_BUN_CHUNK_SIZE) {
 					error("_outputSize: %d", _outputSize);
@@ -391,6 +453,9 @@ int32 BundleMgr::readFile(const char *name, int32 size, byte **comp_final, bool
 		}
 		_curDecompressedFilePos += finalSize;
 
+		// Streams are read in order, so the next block is likely needed next
+		startDecodeAhead(found->index, _lastBlock + 1);
+
 		return finalSize;
 	}
 
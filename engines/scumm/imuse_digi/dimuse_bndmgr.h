@@ -24,6 +24,7 @@
 
 #include "common/scummsys.h"
 #include "common/file.h"
+#include "common/jobs.h"
 #include "scumm/imuse_digi/dimuse_defs.h"
 
 namespace Scumm {
@@ -74,6 +75,20 @@ private:
 		int32 codec;
 	};
 
+	/**
+	 * The block following the last one which was read, decompressed by a
+	 * job while the current one is being played.
+	 */
+	struct DecodeAhead {
+		int block; ///< Index of the block being decoded, or -1
+		int32 codec;
+		int32 inputSize;
+		int32 outputSize;
+		byte *input;
+		byte output[DIMUSE_BUN_CHUNK_SIZE];
+		Common::JobGroup group;
+	};
+
 	BundleDirCache *_cache;
 	BundleDirCache::AudioTable *_bundleTable;
 	BundleDirCache::IndexNode *_indexTable = nullptr;
@@ -92,8 +107,14 @@ private:
 	byte *_compInputBuff = nullptr;
 	int _outputSize = 0;
 	int _lastBlock = 0;
+	DecodeAhead *_decodeAhead = nullptr;
 	bool loadCompTable(int32 index);
 
+	void startDecodeAhead(int32 index, int block);
+	bool finishDecodeAhead(int block);
+	void cancelDecodeAhead();
+	static void decodeAheadProc(void *refCon);
+
 public:
 
 	BundleMgr(const ScummEngine *vm, BundleDirCache *_cache);
@@ -645,26 +645,17 @@ void MacV6Gui::updateThumbnail(MacDialogWindow *window, Common::Rect drawArea, i
 
 	Graphics::ColorQuantizer quantizer(245);
 
-	for (int y = yMin; y < yMax; y++) {
-		for (int x = 0; x < thumbnail->w; x++) {
-			uint32 color = thumbnail->getPixel(x, y);
-
-			byte r, g, b;
-			thumbnail->format.colorToRGB(color, r, g, b);
-
-			quantizer.addColor(r, g, b);
-		}
-	}
+	const Graphics::Surface visibleThumbnail = thumbnail->getSubArea(thumbnailRect);
+	quantizer.addSurface(visibleThumbnail);
 
 	Graphics::Palette *palette = quantizer.getPalette();
 	_system->getPaletteManager()->setPalette(*palette);
 	delete palette;
 
-	Graphics::Palette fullPalette = _system->getPaletteManager()->grabPalette(0, 256);
-
-	Graphics::Surface *palettedThumbnail = thumbnail->convertTo(window->innerSurface()->format, nullptr, 0, fullPalette.data(), fullPalette.size());
+	// The quantized palette starts at index 0, so its indexes can be used as is
+	Graphics::Surface *palettedThumbnail = quantizer.convertSurface(visibleThumbnail);
 
-	window->innerSurface()->copyRectToSurface(*palettedThumbnail, drawArea.left, drawArea.top, thumbnailRect);
+	window->innerSurface()->copyRectToSurface(*palettedThumbnail, drawArea.left, drawArea.top, Common::Rect(palettedThumbnail->w, palettedThumbnail->h));
 	window->markRectAsDirty(drawArea);
 
 	palettedThumbnail->free();
@@ -22,6 +22,7 @@
 #include "common/md5.h"
 #include "common/str.h"
 #include "common/memstream.h"
+#include "common/memtracker.h"
 #include "common/macresman.h"
 #ifndef MACOSX
 #include "common/config-manager.h"
@@ -870,6 +871,7 @@ byte *ResourceManager::createResource(ResType type, ResId idx, uint32 size) {
 	}
 
 	_allocatedSize += size;
+	MEMORY_TRACK_ADD(Common::kMemoryEngineResources, size);
 
 	_types[type][idx]._address = ptr;
 	_types[type][idx]._size = size;
@@ -941,6 +943,7 @@ void ResourceManager::nukeResource(ResType type, ResId idx) {
 	if (ptr != nullptr) {
 		debugC(DEBUG_RESOURCE, "nukeResource(%s,%d)", nameOfResType(type), idx);
 		_allocatedSize -= _types[type][idx]._size;
+		MEMORY_TRACK_REMOVE(Common::kMemoryEngineResources, _types[type][idx]._size);
 		_types[type][idx].nuke();
 	}
 }
@@ -1429,6 +1429,7 @@ protected:
 
 	virtual void drawDirtyScreenParts();
 	void updateDirtyScreen(VirtScreenNumber slot);
+	void drawDirtyStrips(VirtScreen *vs, int start, int numStrips, int top, int bottom);
 	void drawStripToScreen(VirtScreen *vs, int x, int width, int top, int bottom);
 
 	void mac_markScreenAsDirty(int x, int y, int w, int h);
@@ -36,6 +36,7 @@
 #include "audio/decoders/flac.h"
 #include "audio/mididrv.h"
 #include "audio/mixer.h"
+#include "audio/prebuffer.h"
 #include "audio/decoders/mp3.h"
 #include "audio/decoders/raw.h"
 #include "audio/decoders/voc.h"
@@ -795,6 +796,11 @@ void Sound::startTalkSound(uint32 offset, uint32 length, int mode, Audio::SoundH
 		}
 
 		if (!_vm->_imuseDigital) {
+			// Decode the start of compressed sounds on a worker thread,
+			// instead of in the first mixer callback playing them
+			if (_soundMode != kVOCMode)
+				input = Audio::makePrebufferedStream(input, 100);
+
 			if (mode == DIGI_SND_MODE_SFX) {
 				_mixer->playStream(Audio::Mixer::kSFXSoundType, handle, input, id);
 			} else {
@@ -84,8 +84,15 @@ Common::SeekableReadStream *Cache::get(const Common::Path &filename) const {
 
 /*----------------------------------------------------------------*/
 
+/**
+ * Maximum size of the decompressed library resources kept around
+ */
+#define DECOMPRESSED_CACHE_SIZE (2 * 1024 * 1024)
+
 Resources::Resources(SherlockEngine *vm) : _vm(vm), _cache(vm) {
 	_resourceIndex = -1;
+	_decompressedSize = 0;
+	_decompressedUse = 0;
 
 	if (_vm->_interactiveFl) {
 		if (!IS_3DO) {
@@ -155,16 +162,28 @@ Common::SeekableReadStream *Resources::load(const Common::Path &filename) {
 	// that has the same name
 	for (LibraryIndexes::iterator i = _indexes.begin(); i != _indexes.end(); ++i) {
 		if (i->_value.contains(filename)) {
-			// Get a stream reference to the given library file
-			Common::SeekableReadStream *stream = load(i->_key);
 			LibraryEntry &entry = i->_value[filename];
 			_resourceIndex = entry._index;
 
-			stream->seek(entry._offset);
-			Common::SeekableReadStream *resStream = stream->readStream(entry._size);
-			decompressIfNecessary(resStream);
+			Common::SeekableReadStream *resStream = getDecompressed(filename);
+			if (resStream)
+				return resStream;
+
+			// Get a stream reference to the given library file
+			Common::SeekableReadStream *stream = load(i->_key);
 
+			stream->seek(entry._offset);
+			resStream = stream->readStream(entry._size);
 			delete stream;
+
+			if (resStream->readUint32BE() == MKTAG('L', 'Z', 'V', 26)) {
+				resStream->seek(-4, SEEK_CUR);
+				decompressIfNecessary(resStream);
+				addDecompressed(filename, *resStream);
+			} else {
+				resStream->seek(-4, SEEK_CUR);
+			}
+
 			return resStream;
 		}
 	}
@@ -181,6 +200,45 @@ Common::SeekableReadStream *Resources::load(const Common::Path &filename) {
 	return stream;
 }
 
+void Resources::addDecompressed(const Common::Path &filename, Common::SeekableReadStream &stream) {
+	uint32 size = stream.size();
+	if (size == 0 || size > DECOMPRESSED_CACHE_SIZE / 4)
+		return;
+
+	// Throw out the least recently used resources until the new one fits
+	while (_decompressedSize + size > DECOMPRESSED_CACHE_SIZE && !_decompressed.empty()) {
+		DecompressedHash::iterator oldest = _decompressed.begin();
+		for (DecompressedHash::iterator i = _decompressed.begin(); i != _decompressed.end(); ++i) {
+			if (i->_value._lastUse < oldest->_value._lastUse)
+				oldest = i;
+		}
+
+		_decompressedSize -= oldest->_value._data.size();
+		_decompressed.erase(oldest);
+	}
+
+	DecompressedEntry &entry = _decompressed[filename];
+	entry._data.resize(size);
+	entry._lastUse = ++_decompressedUse;
+	stream.read(&entry._data[0], size);
+	stream.seek(0);
+	_decompressedSize += size;
+}
+
+Common::SeekableReadStream *Resources::getDecompressed(const Common::Path &filename) {
+	DecompressedHash::iterator i = _decompressed.find(filename);
+	if (i == _decompressed.end())
+		return nullptr;
+
+	// Callers may hold on to the stream, so hand out a copy of the data
+	DecompressedEntry &entry = i->_value;
+	entry._lastUse = ++_decompressedUse;
+
+	byte *data = (byte *)malloc(entry._data.size());
+	memcpy(data, &entry._data[0], entry._data.size());
+	return new Common::MemoryReadStream(data, entry._data.size(), DisposeAfterUse::YES);
+}
+
 void Resources::decompressIfNecessary(Common::SeekableReadStream *&stream) {
 	bool isCompressed = stream->readUint32BE() == MKTAG('L', 'Z', 'V', 26);
 
@@ -48,6 +48,14 @@ struct LibraryEntry {
 typedef Common::HashMap<Common::Path, LibraryEntry, Common::Path::IgnoreCase_Hash, Common::Path::IgnoreCase_EqualTo> LibraryIndex;
 typedef Common::HashMap<Common::Path, LibraryIndex, Common::Path::IgnoreCase_Hash, Common::Path::IgnoreCase_EqualTo> LibraryIndexes;
 
+struct DecompressedEntry {
+	CacheEntry _data;
+	uint32 _lastUse;
+
+	DecompressedEntry() : _lastUse(0) {}
+};
+typedef Common::HashMap<Common::Path, DecompressedEntry, Common::Path::IgnoreCase_Hash, Common::Path::IgnoreCase_EqualTo> DecompressedHash;
+
 class SherlockEngine;
 
 class Cache {
@@ -86,11 +94,25 @@ private:
 	Cache _cache;
 	LibraryIndexes _indexes;
 	int _resourceIndex;
+	DecompressedHash _decompressed;
+	uint32 _decompressedSize;
+	uint32 _decompressedUse;
 
 	/**
 	 * Reads in the index from a library file, and caches its index for later use
 	 */
 	void loadLibraryIndex(const Common::Path &libFilename, Common::SeekableReadStream *stream, bool isNewStyle);
+
+	/**
+	 * Keeps the data of a decompressed library resource, so that images which keep
+	 * being reloaded, such as portraits and interface shapes, are only decompressed once
+	 */
+	void addDecompressed(const Common::Path &filename, Common::SeekableReadStream &stream);
+
+	/**
+	 * Returns a stream for a recently decompressed library resource, or nullptr
+	 */
+	Common::SeekableReadStream *getDecompressed(const Common::Path &filename);
 public:
 	Resources(SherlockEngine *vm);
 
@@ -238,6 +238,7 @@ private:
 	Graphics::Surface *duplicateSurface(Graphics::Surface *surface);
 	void blendColor(Graphics::Surface * surface, uint32 color, Graphics::TSpriteBlendMode mode);
 	Graphics::Surface *applyLightmapToSprite(Graphics::Surface *&blitted, OnScreenPerson *thisPerson, bool mirror, int x, int y, int x1, int y1, int diffX, int diffY);
+	void drawSpriteWithZBuffer(int x1, int y1, int diffX, int diffY, uint8 z, const Graphics::Surface &blitted, bool mirror, uint colorMod);
 
 	// Sprite banks
 	LoadedSpriteBanks _allLoadedBanks;
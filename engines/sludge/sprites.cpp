@@ -430,6 +430,24 @@ Graphics::Surface *GraphicsManager::applyLightmapToSprite(Graphics::Surface *&bl
 	return toDetele;
 }
 
+void GraphicsManager::drawSpriteWithZBuffer(int x1, int y1, int diffX, int diffY, uint8 z, const Graphics::Surface &blitted, bool mirror, uint colorMod) {
+	// Only the part of the render surface the sprite is drawn to
+	// needs to be blended and tested against the zBuffer
+	Common::Rect area(x1, y1, x1 + diffX, y1 + diffY);
+	area.clip(Common::Rect(_renderSurface.w, _renderSurface.h));
+	if (area.isEmpty())
+		return;
+
+	Graphics::ManagedSurface scaled;
+	scaled.copyFrom(_renderSurface.getSubArea(area));
+
+	Graphics::ManagedSurface tmp;
+	tmp.copyFrom(blitted);
+	tmp.blendBlitTo(scaled, x1 - area.left, y1 - area.top, (mirror ? Graphics::FLIP_H : Graphics::FLIP_NONE), nullptr, colorMod, diffX, diffY);
+
+	drawSpriteToZBuffer(area.left, area.top, z, scaled.rawSurface());
+}
+
 bool GraphicsManager::scaleSprite(Sprite &single, const SpritePalette &fontPal, OnScreenPerson *thisPerson, bool mirror) {
 	float x = thisPerson->x;
 	float y = thisPerson->y;
@@ -497,16 +515,13 @@ bool GraphicsManager::scaleSprite(Sprite &single, const SpritePalette &fontPal,
 			ptr = nullptr;
 		}
 	} else {
+		drawSpriteWithZBuffer((int)x1, (int)y1, diffX, diffY, z, *blitted, mirror, MS_ARGB(255 - thisPerson->transparency, 255, 255, 255));
 
-		// TODO: you dont need to copy the whole render surface, just the part to which the sprite may be drawn
-		Graphics::ManagedSurface scaled;
-		scaled.copyFrom(_renderSurface);
-
-		Graphics::ManagedSurface tmp;
-		tmp.copyFrom(*blitted);
-		tmp.blendBlitTo(scaled, x1, y1, (mirror ? Graphics::FLIP_H : Graphics::FLIP_NONE), nullptr, MS_ARGB(255 - thisPerson->transparency, 255, 255, 255), diffX, diffY);
-
-		drawSpriteToZBuffer(0, 0, z, scaled.rawSurface());
+		if (ptr) {
+			ptr->free();
+			delete ptr;
+			ptr = nullptr;
+		}
 	}
 
 	// Are we pointing at the sprite?
@@ -583,15 +598,13 @@ void GraphicsManager::fixScaleSprite(int x, int y, Sprite &single, const SpriteP
 			ptr = nullptr;
 		}
 	} else {
-		Graphics::ManagedSurface scaled;
-		scaled.copyFrom(_renderSurface);
-
-		Graphics::ManagedSurface tmp;
-		tmp.copyFrom(*blitted);
-		tmp.blendBlitTo(scaled, x1, y1, (mirror ? Graphics::FLIP_H : Graphics::FLIP_NONE), nullptr, MS_ARGB(255 - thisPerson->transparency, 255, 255, 255), diffX, diffY);
-
-		drawSpriteToZBuffer(0, 0, z, scaled.rawSurface());
+		drawSpriteWithZBuffer(x1, y1, diffX, diffY, z, *blitted, mirror, MS_ARGB(255 - thisPerson->transparency, 255, 255, 255));
 
+		if (ptr) {
+			ptr->free();
+			delete ptr;
+			ptr = nullptr;
+		}
 	}
 
 	// copy screen to backdrop
@@ -162,26 +162,21 @@ void GraphicsManager::fillZBuffer(uint8 d) {
 }
 
 void GraphicsManager::drawSpriteToZBuffer(int x, int y, uint8 depth, const Graphics::Surface &surface) {
-
-	for (uint y1 = 0; y1 < (uint)surface.h; y1++) {
-		for (uint x1 = 0; x1 < (uint)surface.w; x1++) {
-			if (x1 + x >= _sceneWidth || y1 + y >= _sceneHeight) {
-				continue;
-			}
-
-			byte *target = (byte *)_renderSurface.getBasePtr(x1 + x, y1 + y);
-			const byte *source = (const byte *)surface.getBasePtr(x1, y1);
-
-			if (depth > _zBufferSurface[(y1 + y) * _winWidth + (x1 + x)]) {
-
-				if (source[0] == 0xff) {
-					// Completely opaque, so copy RGB values over
-					target[0] = 0xff;
-					target[1] = source[1];
-					target[2] = source[2];
-					target[3] = source[3];
-
-				}
+	int w = MIN<int>(surface.w, (int)_sceneWidth - x);
+	int h = MIN<int>(surface.h, (int)_sceneHeight - y);
+
+	for (int y1 = 0; y1 < h; y1++) {
+		const byte *source = (const byte *)surface.getBasePtr(0, y1);
+		byte *target = (byte *)_renderSurface.getBasePtr(x, y1 + y);
+		const uint8 *zb = _zBufferSurface + (y1 + y) * _winWidth + x;
+
+		for (int x1 = 0; x1 < w; x1++, source += 4, target += 4) {
+			// Completely opaque and in front, so copy RGB values over
+			if (depth > zb[x1] && source[0] == 0xff) {
+				target[0] = 0xff;
+				target[1] = source[1];
+				target[2] = source[2];
+				target[3] = source[3];
 			}
 		}
 	}
@@ -197,17 +192,14 @@ void GraphicsManager::drawZBuffer(int x, int y, bool upsidedown) {
 	int h = MIN<uint>(_zBuffer->height, _winHeight + y);
 
 	for (int y1 = y; y1 < h; y1++) {
-		for (int x1 = x; x1 < w; x1++) {
-			uint8 z = 0;
+		const uint8 *source = _zBuffer->tex + (upsidedown ? _zBuffer->height - y1 : y1) * _zBuffer->width;
+		uint8 *target = _zBufferSurface + (y1 - y) * _winWidth;
 
-			if (upsidedown) {
-				z = (_zBuffer->tex[(_zBuffer->height - y1) * _zBuffer->width + x1] + 1) * 2;
-			} else {
-				z = (_zBuffer->tex[y1 * _zBuffer->width + x1] + 1) * 2;
-			}
+		for (int x1 = x; x1 < w; x1++) {
+			uint8 z = (source[x1] + 1) * 2;
 
-			if ( z > _zBufferSurface[(y1 - y) * _winWidth + (x1 - x)])
-				_zBufferSurface[(y1 - y) * _winWidth + (x1 - x)] = z;
+			if (z > target[x1 - x])
+				target[x1 - x] = z;
 		}
 	}
 }
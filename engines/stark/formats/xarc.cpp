@@ -27,7 +27,6 @@
 
 #include "common/debug.h"
 #include "common/file.h"
-#include "common/substream.h"
 
 namespace Stark {
 namespace Formats {
@@ -102,14 +101,27 @@ Common::String XARCMember::readString(Common::ReadStream &stream) {
 
 // ARCHIVE
 
+XARCArchive::XARCArchive() :
+		_file(nullptr) {
+}
+
+XARCArchive::~XARCArchive() {
+	delete _file;
+}
+
 bool XARCArchive::open(const Common::Path &filename) {
-	Common::File stream;
-	if (!stream.open(filename)) {
+	Common::File *file = new Common::File();
+	if (!file->open(filename)) {
+		delete file;
 		return false;
 	}
 
+	delete _file;
+	_file = file;
 	_filename = filename;
 
+	Common::SeekableReadStream &stream = *_file;
+
 	// Unknown: always 1? version?
 	uint32 unknown = stream.readUint32LE();
 	debugC(kDebugUnknown, "Stark::XARC: \"%s\" has unknown=%d", _filename.toString(Common::Path::kNativeSeparator).c_str(), unknown);
@@ -205,24 +217,16 @@ Common::SeekableReadStream *XARCArchive::createReadStreamForMember(const Common:
 }
 
 Common::SeekableReadStream *XARCArchive::createReadStreamForMember(const XARCMember *member) const {
-	// Open the xarc file
-	Common::File *f = new Common::File;
-	if (!f)
-		return NULL;
-
-	if (!f->open(_filename)) {
-		delete f;
-		return NULL;
-	}
+	if (!_file)
+		return nullptr;
 
-	// Return the substream that contains the archive member
-	uint32 offset = member->getOffset();
-	uint32 length = member->getLength();
-	return new Common::SeekableSubReadStream(f, offset, offset + length, DisposeAfterUse::YES);
+	// Read the whole member with a single seek and read on the already opened
+	// archive, rather than reopening the file and reading it piece by piece.
+	// The resource parsers issue many small reads, which are then served from memory.
+	if (!_file->seek(member->getOffset()))
+		return nullptr;
 
-	// Different approach: keep the archive open and read full resources to memory
-	//f.seek(member->getOffset());
-	//return f.readStream(member->getLength());
+	return _file->readStream(member->getLength());
 }
 
 } // End of namespace Formats
@@ -32,6 +32,9 @@ class XARCMember;
 
 class XARCArchive : public Common::Archive {
 public:
+	XARCArchive();
+	~XARCArchive() override;
+
 	bool open(const Common::Path &filename);
 	Common::Path getFilename() const;
 
@@ -47,6 +50,9 @@ public:
 private:
 	Common::Path _filename;
 	Common::ArchiveMemberList _members;
+
+	// Kept open while the archive is loaded, members are read from it in one go
+	Common::SeekableReadStream *_file;
 };
 
 } // End of namespace Formats
@@ -151,9 +151,10 @@ Common::Rect VisualActor::getBoundingRect(const Math::Vector3d &position3d, floa
 	verts[6].set(min.x(), max.y(), max.z());
 	verts[7].set(max.x(), max.y(), max.z());
 
+	modelMatrix.transformVectors(verts, 8, true);
+
 	Common::Rect boundingRect;
 	for (int i = 0; i < 8; ++i) {
-		modelMatrix.transform(&verts[i], true);
 		Common::Point point = StarkScene->convertPosition3DToGameScreenOriginal(verts[i]);
 
 		if (i == 0) {
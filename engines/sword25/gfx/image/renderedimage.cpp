@@ -39,7 +39,9 @@
 
 #include "sword25/gfx/renderobjectmanager.h"
 
+#include "common/jobs.h"
 #include "common/system.h"
+#include "graphics/blit.h"
 #include "graphics/thumbnail.h"
 
 namespace Sword25 {
@@ -229,13 +231,67 @@ bool RenderedImage::blit(int posX, int posY, int flipping, Common::Rect *pPartRe
 	int cg = (color >> BS_GSHIFT) & 0xff;
 	int cb = (color >> BS_BSHIFT) & 0xff;
 
-	if (width == -1) width = pPartRect ? pPartRect->width() : _surface.w;
-	if (height == -1) height = pPartRect ? pPartRect->height() : _surface.h;
-	_surface.blendBlitTo(*_backSurface, posX, posY, newFlipping, pPartRect, _surface.format.ARGBToColor(ca, cr, cg, cb), width, height, Graphics::BLEND_NORMAL, _alphaType);
+	const int srcWidth = pPartRect ? pPartRect->width() : _surface.w;
+	const int srcHeight = pPartRect ? pPartRect->height() : _surface.h;
+	if (width == -1) width = srcWidth;
+	if (height == -1) height = srcHeight;
+
+	const uint colorMod = _surface.format.ARGBToColor(ca, cr, cg, cb);
+
+	// Scaled images are blitted whole, as clipping them may move the source
+	// pixels at the clipped edges
+	if (!updateRects || width != srcWidth || height != srcHeight) {
+		_surface.blendBlitTo(*_backSurface, posX, posY, newFlipping, pPartRect, colorMod, width, height, Graphics::BLEND_NORMAL, _alphaType);
+		return true;
+	}
+
+	// Only the update rectangles are copied to the screen, so only draw the
+	// parts of the image inside them
+	BlitJob job;
+	job.image = this;
+	job.posX = posX;
+	job.posY = posY;
+	job.flipping = newFlipping;
+	job.partRect = pPartRect;
+	job.colorMod = colorMod;
+
+	const Common::Rect imageRect = Common::Rect(posX, posY, posX + width, posY + height).findIntersectingRect(Common::Rect(_backSurface->w, _backSurface->h));
+	uint area = 0;
+	for (RectangleList::iterator it = updateRects->begin(); it != updateRects->end(); ++it) {
+		const Common::Rect rect = imageRect.findIntersectingRect(*it);
+		if (!rect.isEmpty()) {
+			job.areas.push_back(rect);
+			area += rect.width() * rect.height();
+		}
+	}
+
+	_backSurface->invalidateConversionCache();
+
+	// The update rectangles don't overlap, so large images can be drawn
+	// into them in parallel
+	Common::JobSystem *jobSystem = g_system->getJobSystem();
+	if (job.areas.size() > 1 && area >= kMinParallelBlitArea && jobSystem->getThreadCount() > 1) {
+		// The blitter has to be selected before the workers use it
+		Graphics::BlendBlit::init();
+		jobSystem->parallelFor(job.areas.size(), blitAreas, &job);
+	} else {
+		blitAreas(0, job.areas.size(), &job);
+	}
 
 	return true;
 }
 
+void RenderedImage::blitAreas(uint begin, uint end, void *refCon) {
+	const BlitJob &job = *(const BlitJob *)refCon;
+
+	for (uint i = begin; i < end; ++i) {
+		const Common::Rect &area = job.areas[i];
+		Graphics::Surface target = job.image->_backSurface->surfacePtr()->getSubArea(area);
+		job.image->_surface.blendBlitTo(target, job.posX - area.left, job.posY - area.top, job.flipping, job.partRect,
+		                                job.colorMod, -1, -1, Graphics::BLEND_NORMAL, job.image->_alphaType);
+	}
+}
+
 void RenderedImage::copyDirectly(int posX, int posY) {
 	byte *data = (byte *)_surface.getPixels();
 	int w = _surface.w;
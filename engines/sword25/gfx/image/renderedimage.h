@@ -108,6 +108,21 @@ public:
 	bool isSolid() const override { return _alphaType == Graphics::ALPHA_OPAQUE; }
 
 private:
+	enum {
+		kMinParallelBlitArea = 64 * 1024
+	};
+
+	struct BlitJob {
+		RenderedImage *image;
+		int posX, posY;
+		int flipping;
+		const Common::Rect *partRect;
+		uint colorMod;
+		Common::Array<Common::Rect> areas;
+	};
+
+	static void blitAreas(uint begin, uint end, void *refCon);
+
 	Graphics::ManagedSurface _surface;
 	Graphics::AlphaType _alphaType;
 	bool _doCleanup;
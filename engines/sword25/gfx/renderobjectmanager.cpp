@@ -46,15 +46,22 @@ namespace Sword25 {
 
 void RenderObjectQueue::add(RenderObject *renderObject) {
 	push_back(RenderObjectQueueItem(renderObject, renderObject->getBbox(), renderObject->getVersion()));
+
+	ItemState &state = _states[renderObject];
+	state._bbox = renderObject->getBbox();
+	state._version = renderObject->getVersion();
 }
 
 bool RenderObjectQueue::exists(const RenderObjectQueueItem &renderObjectQueueItem) {
-	for (RenderObjectQueue::iterator it = begin(); it != end(); ++it)
-		if ((*it)._renderObject == renderObjectQueueItem._renderObject &&
-			(*it)._version == renderObjectQueueItem._version &&
-			(*it)._bbox == renderObjectQueueItem._bbox)
-			return true;
-	return false;
+	Common::HashMap<RenderObject *, ItemState>::const_iterator it = _states.find(renderObjectQueueItem._renderObject);
+	return it != _states.end() &&
+		it->_value._version == renderObjectQueueItem._version &&
+		it->_value._bbox == renderObjectQueueItem._bbox;
+}
+
+void RenderObjectQueue::clear() {
+	Common::List<RenderObjectQueueItem>::clear();
+	_states.clear();
 }
 
 RenderObjectManager::RenderObjectManager(int width, int height, int framebufferCount) :
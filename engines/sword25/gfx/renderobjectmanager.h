@@ -41,6 +41,8 @@
 #ifndef SWORD25_RENDEROBJECTMANAGER_H
 #define SWORD25_RENDEROBJECTMANAGER_H
 
+#include "common/hashmap.h"
+#include "common/hash-ptr.h"
 #include "common/rect.h"
 #include "sword25/kernel/common.h"
 #include "sword25/gfx/renderobjectptr.h"
@@ -67,6 +69,17 @@ class RenderObjectQueue : public Common::List<RenderObjectQueueItem> {
 public:
 	void add(RenderObject *renderObject);
 	bool exists(const RenderObjectQueueItem &renderObjectQueueItem);
+	void clear();
+
+private:
+	struct ItemState {
+		Common::Rect _bbox;
+		int _version;
+	};
+
+	// Every object is queued at most once per frame, so exists() only needs
+	// to look up its state instead of going through the whole queue
+	Common::HashMap<RenderObject *, ItemState> _states;
 };
 
 /**
@@ -30,7 +30,7 @@
 namespace Tetraedge {
 
 TeMesh::TeMesh() : _matrixForced(false), _hasAlpha(false), _initialMaterialIndexCount(0),
-_drawWires(false), _shouldDraw(true) {
+_drawWires(false), _shouldDraw(true), _dataVersion(1) {
 }
 
 
@@ -72,6 +72,7 @@ void TeMesh::destroy() {
 	_materialIndexes.clear();
 	_faceCounts.clear();
 	_matricies.clear();
+	_dataVersion++;
 }
 
 bool TeMesh::hasAlpha(uint idx) {
@@ -116,6 +117,7 @@ void TeMesh::setColor(const TeColor &col) {
 		for (uint i = 0; i < _verticies.size(); i++) {
 			_colors[i] = colnow;
 		}
+		_dataVersion++;
 	}
 }
 
@@ -125,6 +127,7 @@ void TeMesh::setColor(uint idx, const TeColor &col) {
 	}
 	_colors.resize(_verticies.size());
 	_colors[idx] = col;
+	_dataVersion++;
 }
 
 void TeMesh::setConf(uint vertexCount, uint indexCount, enum Mode mode, uint materialCount, uint materialIndexCount) {
@@ -139,20 +142,24 @@ void TeMesh::setConf(uint vertexCount, uint indexCount, enum Mode mode, uint mat
 
 void TeMesh::setIndex(uint idx, uint val) {
 	_indexes[idx] = val;
+	_dataVersion++;
 }
 
 void TeMesh::setNormal(uint idx, const TeVector3f32 &val) {
 	_normals.resize(_verticies.size());
 	_normals[idx] = val;
+	_dataVersion++;
 }
 
 void TeMesh::setTextureUV(uint idx, const TeVector2f32 &val) {
 	_uvs.resize(_verticies.size());
 	_uvs[idx] = val;
+	_dataVersion++;
 }
 
 void TeMesh::setVertex(uint idx, const TeVector3f32 &val) {
 	_verticies[idx] = val;
+	_dataVersion++;
 }
 
 TeVector3f32 TeMesh::vertex(uint idx) const {
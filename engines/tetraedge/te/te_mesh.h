@@ -60,7 +60,7 @@ public:
 	void attachMaterial(uint idx, const TeMaterial &material);
 	void boundingBox(TeVector3f32 &boxmin, TeVector3f32 boxmax);
 	void checkArrays() {};
-	void clearColors() { _colors.clear(); }
+	void clearColors() { _colors.clear(); _dataVersion++; }
 	TeColor color(uint idx) const { return _colors[idx]; }
 	void copy(const TeMesh &other);
 	void create();
@@ -142,6 +142,10 @@ protected:
 	bool _drawWires;
 	bool _shouldDraw;
 
+	// Incremented whenever the vertex data or indexes change, so that
+	// renderers can tell when their copies of them are out of date
+	uint _dataVersion;
+
 };
 
 } // end namespace Tetraedge
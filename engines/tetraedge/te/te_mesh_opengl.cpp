@@ -20,6 +20,7 @@
  */
 
 #include "graphics/opengl/system_headers.h"
+#include "graphics/opengl/context.h"
 
 #include "tetraedge/tetraedge.h"
 #include "tetraedge/te/te_renderer.h"
@@ -29,7 +30,62 @@
 
 namespace Tetraedge {
 
-TeMeshOpenGL::TeMeshOpenGL() : _glMeshMode(GL_POINTS), _gltexEnvMode(GL_MODULATE) {
+TeMeshOpenGL::TeMeshOpenGL() : _glMeshMode(GL_POINTS), _gltexEnvMode(GL_MODULATE),
+_vertexBuffer(0), _indexBuffer(0), _buffersDataVersion(0), _drawnDataVersion(0) {
+}
+
+TeMeshOpenGL::~TeMeshOpenGL() {
+	if (_vertexBuffer) {
+		glDeleteBuffers(1, &_vertexBuffer);
+		glDeleteBuffers(1, &_indexBuffer);
+	}
+}
+
+static const void *bufferOffset(size_t offset) {
+	return (const void *)offset;
+}
+
+bool TeMeshOpenGL::updateBuffers() {
+	// Buffer objects are part of OpenGL 1.5 and OpenGL ES 1.1
+	if (OpenGLContext.type == OpenGL::kContextGL && !OpenGLContext.isGLVersionOrHigher(1, 5))
+		return false;
+
+	// Meshes which changed since their last draw are likely to change again,
+	// so they are drawn from client memory instead of being uploaded once more
+	if (_dataVersion != _drawnDataVersion) {
+		_drawnDataVersion = _dataVersion;
+		return false;
+	}
+
+	if (_buffersDataVersion == _dataVersion)
+		return true;
+
+	if (!_vertexBuffer) {
+		glGenBuffers(1, &_vertexBuffer);
+		glGenBuffers(1, &_indexBuffer);
+	}
+
+	// The arrays are stored one after the other, in the order of draw()
+	const size_t verticiesSize = _verticies.size() * sizeof(TeVector3f32);
+	const size_t normalsSize = _normals.size() * sizeof(TeVector3f32);
+	const size_t uvsSize = _uvs.size() * sizeof(TeVector2f32);
+	const size_t colorsSize = _colors.size() * sizeof(TeColor);
+
+	glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
+	glBufferData(GL_ARRAY_BUFFER, verticiesSize + normalsSize + uvsSize + colorsSize, nullptr, GL_STATIC_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, verticiesSize, _verticies.data());
+	if (normalsSize)
+		glBufferSubData(GL_ARRAY_BUFFER, verticiesSize, normalsSize, _normals.data());
+	if (uvsSize)
+		glBufferSubData(GL_ARRAY_BUFFER, verticiesSize + normalsSize, uvsSize, _uvs.data());
+	if (colorsSize)
+		glBufferSubData(GL_ARRAY_BUFFER, verticiesSize + normalsSize + uvsSize, colorsSize, _colors.data());
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, _indexes.size() * sizeof(unsigned short), _indexes.data(), GL_STATIC_DRAW);
+
+	_buffersDataVersion = _dataVersion;
+	return true;
 }
 
 void TeMeshOpenGL::draw() {
@@ -90,15 +146,36 @@ void TeMeshOpenGL::draw() {
 	if (!_colors.empty())
 		glEnableClientState(GL_COLOR_ARRAY);
 
-	glVertexPointer(3, GL_FLOAT, sizeof(TeVector3f32), verticies.data());
+	// Animated meshes update their verticies and normals for every frame
+	const bool useBuffers = _updatedVerticies.empty() && updateBuffers();
+	const void *verticiesData = verticies.data();
+	const void *normalsData = normals.data();
+	const void *uvsData = _uvs.data();
+	const void *colorsData = _colors.data();
+	const unsigned short *indexesData = _indexes.data();
+	if (useBuffers) {
+		glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
+
+		const size_t verticiesSize = _verticies.size() * sizeof(TeVector3f32);
+		const size_t normalsSize = _normals.size() * sizeof(TeVector3f32);
+		const size_t uvsSize = _uvs.size() * sizeof(TeVector2f32);
+		verticiesData = bufferOffset(0);
+		normalsData = bufferOffset(verticiesSize);
+		uvsData = bufferOffset(verticiesSize + normalsSize);
+		colorsData = bufferOffset(verticiesSize + normalsSize + uvsSize);
+		indexesData = nullptr;
+	}
+
+	glVertexPointer(3, GL_FLOAT, sizeof(TeVector3f32), verticiesData);
 	if (!normals.empty())
-		glNormalPointer(GL_FLOAT, sizeof(TeVector3f32), normals.data());
+		glNormalPointer(GL_FLOAT, sizeof(TeVector3f32), normalsData);
 
 	if (!_uvs.empty() && renderer->shadowMode() != TeRenderer::ShadowModeDrawing)
-		glTexCoordPointer(2, GL_FLOAT, sizeof(TeVector2f32), _uvs.data());
+		glTexCoordPointer(2, GL_FLOAT, sizeof(TeVector2f32), uvsData);
 
 	if (!_colors.empty())
-		glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(TeColor), _colors.data());
+		glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(TeColor), colorsData);
 
 	glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, _gltexEnvMode);
 	if (renderer->scissorEnabled()) {
@@ -114,7 +191,7 @@ void TeMeshOpenGL::draw() {
 		if (!_materials.empty())
 			renderer->applyMaterial(_materials[0]);
 
-		glDrawElements(_glMeshMode, _indexes.size(), GL_UNSIGNED_SHORT, _indexes.data());
+		glDrawElements(_glMeshMode, _indexes.size(), GL_UNSIGNED_SHORT, indexesData);
 		if (!_materials.empty()) {
 			glDisableClientState(GL_TEXTURE_COORD_ARRAY);
 			renderer->disableTexture();
@@ -127,7 +204,7 @@ void TeMeshOpenGL::draw() {
 				continue;
 			if (!hasAlpha(i) || renderer->shadowMode() == TeRenderer::ShadowModeCreating || !_shouldDraw) {
 				renderer->applyMaterial(_materials[i]);
-				glDrawElements(_glMeshMode, _faceCounts[i] * 3, GL_UNSIGNED_SHORT, _indexes.data() + totalFaceCount * 3);
+				glDrawElements(_glMeshMode, _faceCounts[i] * 3, GL_UNSIGNED_SHORT, indexesData + totalFaceCount * 3);
 				glDisableClientState(GL_TEXTURE_COORD_ARRAY);
 				renderer->disableTexture();
 			}
@@ -142,6 +219,10 @@ void TeMeshOpenGL::draw() {
 	glDisableClientState(GL_VERTEX_ARRAY);
 	glDisableClientState(GL_NORMAL_ARRAY);
 	glDisableClientState(GL_COLOR_ARRAY);
+	if (useBuffers) {
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	}
 
 	//renderer->setCurrentColor(renderer->currentColor()); // pointless?
 
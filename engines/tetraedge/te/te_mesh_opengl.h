@@ -31,6 +31,7 @@ namespace Tetraedge {
 class TeMeshOpenGL : public TeMesh {
 public:
 	TeMeshOpenGL();
+	~TeMeshOpenGL() override;
 
 	void copy(const TeMesh &other);
 	void draw() override;
@@ -43,9 +44,18 @@ public:
 	uint32 getTexEnvMode() const override;
 
 private:
+	bool updateBuffers();
+
 	uint _glMeshMode;
 	uint32 _gltexEnvMode;
 
+	// Buffer objects holding the data of meshes which don't change between
+	// frames, and the data versions they and the last draw were made from
+	uint _vertexBuffer;
+	uint _indexBuffer;
+	uint _buffersDataVersion;
+	uint _drawnDataVersion;
+
 };
 
 } // end namespace Tetraedge
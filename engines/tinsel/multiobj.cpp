@@ -393,11 +393,14 @@ void MultiSetZPosition(OBJECT *pMultiObj, int newZ) {
 
 	// for all the objects that make up this multi-part
 	do {
-		// signal a change in the object
-		pMultiObj->flags |= DMA_CHANGED;
+		// movers set their Z position every frame, only
+		// signal a change in the object when it actually moves
+		if (pMultiObj->zPos != newZ) {
+			pMultiObj->flags |= DMA_CHANGED;
 
-		// set the new z position
-		pMultiObj->zPos = newZ;
+			// set the new z position
+			pMultiObj->zPos = newZ;
+		}
 
 		// next obj in list
 		pMultiObj = pMultiObj->pSlave;
@@ -174,7 +174,7 @@ void InsertObject(OBJECT **pObjList, OBJECT *pInsObj) {
 			break;
 		} else if (pInsObj->zPos == pObj->zPos) {
 			// Z values are the same - sort on Y
-			if (fracToDouble(pInsObj->yPos) <= fracToDouble(pObj->yPos)) {
+			if (pInsObj->yPos <= pObj->yPos) {
 				// object Y is lower than or same as list Y - insert here
 				break;
 			}
@@ -271,7 +271,7 @@ void SortObjectList(OBJECT **pObjList) {
 			pObj  = head.pNext;
 		} else if (pObj->zPos == pPrev->zPos) {
 			// Z values are the same - sort on Y
-			if (fracToDouble(pObj->yPos) < fracToDouble(pPrev->yPos)) {
+			if (pObj->yPos < pPrev->yPos) {
 				// object Y is lower than previous Y
 
 				// remove object from list
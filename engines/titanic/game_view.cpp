@@ -78,6 +78,12 @@ void CGameView::drawView() {
 		_surface, &destPos, &srcRect);
 }
 
+bool CGameView::isViewAffected(const Rect &bounds) const {
+	Rect viewRect(0, 0, 600, 340);
+	viewRect.translate(VIEW_OFFSET_X, VIEW_OFFSET_Y);
+	return viewRect.intersects(bounds);
+}
+
 /*------------------------------------------------------------------------*/
 
 CSTGameView::CSTGameView(CMainGameWindow *gameWindow) :
@@ -70,6 +70,11 @@ public:
 	 * Draws the background of a view
 	 */
 	void drawView();
+
+	/**
+	 * Returns true if a changed screen area overlaps the view area
+	 */
+	bool isViewAffected(const Rect &bounds) const;
 };
 
 class CSTGameView: public CGameView {
@@ -185,8 +185,12 @@ void CMainGameWindow::draw() {
 			if (_gameManager->_gameState._petActive)
 				drawPet(scrManager);
 
-			drawView();
-			drawViewContents(scrManager);
+			// When only the PET or the text cursor changed, the view
+			// and its items don't need to be drawn again
+			if (_gameManager->_dragItem || _gameView->isViewAffected(_gameManager->_bounds)) {
+				drawView();
+				drawViewContents(scrManager);
+			}
 			scrManager->drawCursors();
 			break;
 
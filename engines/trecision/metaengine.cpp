@@ -61,6 +61,9 @@ class TrecisionMetaEngine : public AdvancedMetaEngine<ADGameDescription> {
 	Common::Error createInstance(OSystem *syst, Engine **engine, const ADGameDescription *desc) const override;
 	void getSavegameThumbnail(Graphics::Surface &thumb) override;
 	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveListInfos(const char *target, int slot) const override {
+		return querySaveMetaInfos(target, slot);
+	}
 
 	Common::KeymapArray initKeymaps(const char *target) const override;
 };
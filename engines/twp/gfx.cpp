@@ -218,6 +218,7 @@ void Gfx::init() {
 }
 
 void Gfx::clear(const Color &color) {
+	flush();
 	glClearColor(color.rgba.r, color.rgba.g, color.rgba.b, color.rgba.a);
 	glClear(GL_COLOR_BUFFER_BIT);
 }
@@ -243,7 +244,53 @@ void Gfx::drawLinesLoop(Vertex *vertices, int count, const Math::Matrix4 &trsf)
 	drawPrimitives(GL_LINE_LOOP, vertices, count, trsf);
 }
 
+bool Gfx::canBatch(uint32 primitivesType, Texture *texture) {
+	if (primitivesType != GL_TRIANGLES || _shader != &_defaultShader)
+		return false;
+
+	Texture *t = texture ? texture : &_emptyTexture;
+	if (_batchTexture != t) {
+		flush();
+		_batchTexture = t;
+	}
+	return true;
+}
+
+void Gfx::batch(Vertex *vertices, int v_size, uint32 *indices, int i_size, const Math::Matrix4 &trsf) {
+	// the vertices are transformed here, the batch is drawn with the camera transform only
+	const uint32 first = _batchVertices.size();
+	for (int i = 0; i < v_size; i++) {
+		Vertex v(vertices[i]);
+		Math::Vector3d pos(v.pos.getX(), v.pos.getY(), 0.f);
+		trsf.transform(&pos, true);
+		v.pos = Math::Vector2d(pos.x(), pos.y());
+		_batchVertices.push_back(v);
+	}
+	if (indices) {
+		for (int i = 0; i < i_size; i++)
+			_batchIndices.push_back(first + indices[i]);
+	} else {
+		for (int i = 0; i < v_size; i++)
+			_batchIndices.push_back(first + i);
+	}
+}
+
+void Gfx::flush() {
+	if (_batchIndices.empty())
+		return;
+
+	submitPrimitives(GL_TRIANGLES, _batchVertices.data(), _batchVertices.size(), _batchIndices.data(), _batchIndices.size(), Math::Matrix4(), _batchTexture);
+	_batchVertices.clear();
+	_batchIndices.clear();
+}
+
 void Gfx::drawPrimitives(uint32 primitivesType, Vertex *vertices, int v_size, const Math::Matrix4 &trsf, Texture *texture) {
+	if (v_size > 0 && canBatch(primitivesType, texture)) {
+		batch(vertices, v_size, nullptr, 0, trsf);
+		return;
+	}
+
+	flush();
 	if (v_size > 0) {
 		_texture = texture ? texture : &_emptyTexture;
 		GL_CALL(glBindTexture(GL_TEXTURE_2D, _texture->id));
@@ -277,6 +324,16 @@ void Gfx::drawPrimitives(uint32 primitivesType, Vertex *vertices, int v_size, co
 }
 
 void Gfx::drawPrimitives(uint32 primitivesType, Vertex *vertices, int v_size, uint32 *indices, int i_size, const Math::Matrix4 &trsf, Texture *texture) {
+	if (i_size > 0 && canBatch(primitivesType, texture)) {
+		batch(vertices, v_size, indices, i_size, trsf);
+		return;
+	}
+
+	flush();
+	submitPrimitives(primitivesType, vertices, v_size, indices, i_size, trsf, texture);
+}
+
+void Gfx::submitPrimitives(uint32 primitivesType, Vertex *vertices, int v_size, uint32 *indices, int i_size, const Math::Matrix4 &trsf, Texture *texture) {
 	if (i_size > 0) {
 		int num = _shader->getNumTextures();
 		if (num == 0) {
@@ -370,6 +427,7 @@ void Gfx::drawSprite(Texture &texture, const Color &color, const Math::Matrix4 &
 }
 
 void Gfx::camera(const Math::Vector2d &size) {
+	flush();
 	_cameraSize = size;
 	_mvp = ortho(0.f, size.getX(), 0.f, size.getY(), -1.f, 1.f);
 }
@@ -379,10 +437,12 @@ Math::Vector2d Gfx::camera() const {
 }
 
 void Gfx::use(Shader *shader) {
+	flush();
 	_shader = shader ? shader : &_defaultShader;
 }
 
 void Gfx::setRenderTarget(RenderTexture *target) {
+	flush();
 	if (!target) {
 		glBindFramebuffer(GL_FRAMEBUFFER, _oldFbo);
 		int w = g_twp->_system->getWidth();
@@ -184,9 +184,15 @@ public:
 	void drawSprite(const Common::Rect &textRect, Texture &texture, const Color &color = Color(), const Math::Matrix4 &trsf = Math::Matrix4(), bool flipX = false, bool flipY = false);
 	void drawSprite(Texture &texture, const Color &color = Color(), const Math::Matrix4 &trsf = Math::Matrix4(), bool flipX = false, bool flipY = false);
 
+	// Submits the triangles batched so far, this has to be called before presenting the frame
+	void flush();
+
 private:
 	Math::Matrix4 getFinalTransform(const Math::Matrix4 &trsf);
 	void noTexture();
+	bool canBatch(uint32 primitivesType, Texture *texture);
+	void batch(Vertex *vertices, int v_size, uint32 *indices, int i_size, const Math::Matrix4 &trsf);
+	void submitPrimitives(uint32 primitivesType, Vertex *vertices, int v_size, uint32 *indices, int i_size, const Math::Matrix4 &trsf, Texture *texture);
 
 private:
 	Texture _emptyTexture;
@@ -199,6 +205,11 @@ private:
 	Textures _textures;
 	Texture *_texture = nullptr;
 	int _oldFbo = 0;
+	// Triangles drawn with the default shader are accumulated here
+	// and drawn with a single call as long as the texture does not change
+	Common::Array<Vertex> _batchVertices;
+	Common::Array<uint32> _batchIndices;
+	Texture *_batchTexture = nullptr;
 };
 } // namespace Twp
 
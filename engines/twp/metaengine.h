@@ -40,6 +40,9 @@ public:
 	int getMaximumSaveSlot() const override;
 
 	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveListInfos(const char *target, int slot) const override {
+		return querySaveMetaInfos(target, slot);
+	}
 	void registerDefaultSettings(const Common::String &) const override;
 
 	Common::AchievementsPlatform getAchievementsPlatform(const Common::String &target) const override;
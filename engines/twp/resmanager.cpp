@@ -20,6 +20,7 @@
  */
 
 #include "common/config-manager.h"
+#include "common/memstream.h"
 #include "image/png.h"
 #include "twp/twp.h"
 #include "twp/detection.h"
@@ -57,11 +58,70 @@ void ResManager::loadTexture(const Common::String &name) {
 Texture *ResManager::texture(const Common::String &name) {
 	Common::String key(getKey(name.c_str()));
 	if (!_textures.contains(key)) {
-		loadTexture(key.c_str());
+		if (_textureRequests.contains(key))
+			_loader.wait(_textureRequests[key]);
+		if (!_textures.contains(key))
+			loadTexture(key.c_str());
 	}
 	return &_textures[key];
 }
 
+void ResManager::prefetchTexture(const Common::String &name, Common::ResourceLoader::Priority priority) {
+	Common::String key(getKey(name.c_str()));
+	if (_textures.contains(key))
+		return;
+
+	if (_textureRequests.contains(key)) {
+		_loader.setPriority(_textureRequests[key], priority);
+		return;
+	}
+
+	debugC(kDebugRes, "Prefetch texture %s", key.c_str());
+	Common::ResourceLoader::Request request(Common::Path(key), priority, textureLoaded, this);
+	request.open = openEntry;
+	request.decode = decodeTexture;
+	_textureRequests[key] = _loader.load(request);
+}
+
+void ResManager::update() {
+	_loader.update();
+}
+
+Common::SeekableReadStream *ResManager::openEntry(const Common::Path &path, void *refCon) {
+	GGPackEntryReader *reader = new GGPackEntryReader();
+	if (!reader->open(*g_twp->_pack, path.toString())) {
+		delete reader;
+		return nullptr;
+	}
+	return reader;
+}
+
+void ResManager::decodeTexture(Common::ResourceLoader::Result &result, void *refCon) {
+	// Runs on a worker, so only decode the PNG, the texture is uploaded
+	// once the request is delivered
+	Common::MemoryReadStream stream(result.data, result.size);
+	Image::PNGDecoder d;
+	if (d.loadStream(stream) && d.getSurface()) {
+		Graphics::Surface *surface = new Graphics::Surface();
+		surface->copyFrom(*d.getSurface());
+		result.decoded = surface;
+	}
+}
+
+void ResManager::textureLoaded(Common::ResourceLoader::Result &result, void *refCon) {
+	ResManager *resManager = (ResManager *)refCon;
+	const Common::String name(result.path.toString());
+	resManager->_textureRequests.erase(name);
+
+	Graphics::Surface *surface = (Graphics::Surface *)result.decoded;
+	if (surface) {
+		if (result.status == Common::ResourceLoader::kStatusLoaded)
+			resManager->_textures[name].load(*surface);
+		surface->free();
+		delete surface;
+	}
+}
+
 void ResManager::loadSpriteSheet(const Common::String &name) {
 	GGPackEntryReader r;
 	r.open(*g_twp->_pack, name + ".json");
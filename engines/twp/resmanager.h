@@ -24,6 +24,7 @@
 
 #include "common/str.h"
 #include "common/hashmap.h"
+#include "common/resource_loader.h"
 #include "twp/gfx.h"
 #include "twp/spritesheet.h"
 
@@ -55,6 +56,10 @@ private:
 public:
 	static Common::String getKey(const Common::String &path);
 	Texture *texture(const Common::String &name);
+	// Start loading a texture in the background, if it is not loaded yet.
+	void prefetchTexture(const Common::String &name, Common::ResourceLoader::Priority priority);
+	// Deliver the textures loaded in the background.
+	void update();
 	SpriteSheet *spriteSheet(const Common::String &name);
 	Common::SharedPtr<Font> font(const Common::String &name);
 	void resetSaylineFont();
@@ -84,6 +89,10 @@ private:
 	void loadSpriteSheet(const Common::String &name);
 	void loadFont(const Common::String &name);
 
+	static Common::SeekableReadStream *openEntry(const Common::Path &path, void *refCon);
+	static void decodeTexture(Common::ResourceLoader::Result &result, void *refCon);
+	static void textureLoaded(Common::ResourceLoader::Result &result, void *refCon);
+
 public:
 	Common::HashMap<Common::String, Texture> _textures;
 	Common::HashMap<Common::String, SpriteSheet> _spriteSheets;
@@ -99,6 +108,8 @@ private:
 	int _threadId = START_THREADID;
 	int _callbackId = START_CALLBACKID;
 	int _lightId = START_LIGHTID;
+	Common::HashMap<Common::String, Common::ResourceLoader::RequestId> _textureRequests;
+	Common::ResourceLoader _loader;
 };
 } // namespace Twp
 
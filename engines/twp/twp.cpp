@@ -490,6 +490,7 @@ void TwpEngine::update(float elapsed) {
 	_time += elapsed;
 	_frameCounter++;
 
+	_resManager->update();
 	_audio->update(elapsed);
 	_noOverride->update(elapsed);
 	if (_talking)
@@ -819,6 +820,7 @@ void TwpEngine::draw(RenderTexture *outTexture) {
 
 	// imgui render
 	_gfx.use(nullptr);
+	_gfx.flush();
 	_system->updateScreen();
 }
 
@@ -1574,6 +1576,28 @@ Common::SharedPtr<Room> TwpEngine::defineRoom(const Common::String &name, HSQOBJ
 	return result;
 }
 
+static void prefetchRoomTextures(Common::SharedPtr<Room> room) {
+	Common::StringArray sheets;
+	sheets.push_back(room->_sheet);
+	for (size_t i = 0; i < room->_layers.size(); i++) {
+		Common::SharedPtr<Layer> layer = room->_layers[i];
+		for (size_t j = 0; j < layer->_objects.size(); j++) {
+			const Common::String &sheet = layer->_objects[j]->_sheet;
+			if (!sheet.empty() && sheet != "raw" && Common::find(sheets.begin(), sheets.end(), sheet) == sheets.end())
+				sheets.push_back(sheet);
+		}
+	}
+
+	for (size_t i = 0; i < sheets.size(); i++) {
+		if (!sheets[i].empty() && g_twp->_pack->assetExists((sheets[i] + ".json").c_str()))
+			g_twp->_resManager->prefetchTexture(g_twp->_resManager->spriteSheet(sheets[i])->meta.image, Common::ResourceLoader::kPriorityNow);
+	}
+
+	// Read them all now, so that they are decoded in parallel while the
+	// first frame waits for each of them
+	g_twp->_resManager->update();
+}
+
 void TwpEngine::enterRoom(Common::SharedPtr<Room> room, Common::SharedPtr<Object> door) {
 	HSQUIRRELVM v = getVm();
 	// Called when the room is entered.
@@ -1594,6 +1618,7 @@ void TwpEngine::enterRoom(Common::SharedPtr<Room> room, Common::SharedPtr<Object
 		_room->_scene->remove();
 	_room = room;
 	room->_effect = RoomEffect::None;
+	prefetchRoomTextures(room);
 	_scene->addChild(_room->_scene.get());
 	_room->_lights._numLights = 0;
 	_room->setOverlay(Color(0.f, 0.f, 0.f, 0.f));
@@ -30,6 +30,10 @@ namespace Nuvie {
 AStarPath::AStarPath() : final_node(0) {
 }
 
+AStarPath::~AStarPath() {
+	delete_nodes();
+}
+
 void AStarPath::create_path() {
 	astar_node *i = final_node; // iterator through steps, from back
 	delete_path();
@@ -44,56 +48,44 @@ void AStarPath::create_path() {
 		reverse_list.pop_back();
 	}
 	set_path_size(step_count);
-}/* Get a new neighbor to nnode and score it, returning true if it's usable. */
-bool AStarPath::score_to_neighbor(sint8 dir, astar_node *nnode, astar_node *neighbor,
-								  sint32 &nnode_to_neighbor) {
-	sint8 sx = -1, sy = -1;
-	DirFinder::get_adjacent_dir(sx, sy, dir); // sx,sy = neighbor -1,-1 + dir
-	// get neighbor of nnode towards sx,sy, and cost to that neighbor
-	neighbor->loc = nnode->loc.abs_coords(sx, sy);
-	nnode_to_neighbor = step_cost(nnode->loc, neighbor->loc);
-	if (nnode_to_neighbor == -1) {
-		delete neighbor; // this neighbor is blocked
-		return false;
-	}
-	return true;
-}/* Compare a node's score to the start node to already scored neighbors. */
-bool AStarPath::compare_neighbors(astar_node *nnode, astar_node *neighbor,
-								  sint32 nnode_to_neighbor, astar_node *in_open,
-								  astar_node *in_closed) {
-	neighbor->to_start = nnode->to_start + nnode_to_neighbor;
-	// ignore this neighbor if already checked and closer to start
-	if ((in_open && in_open->to_start <= neighbor->to_start)
-	        || (in_closed && in_closed->to_start <= neighbor->to_start)) {
-		delete neighbor;
-		return false;
-	}
-	return true;
-}/* Check all neighbors of a node (location) and save them to the "seen" list. */
+}/* Check all neighbors of a node (location), and add them to the open list or
+ * update them if this node is a shorter way to them. */
 bool AStarPath::search_node_neighbors(astar_node *nnode, const MapCoord &goal,
 									  const uint32 max_score) {
 	for (uint32 dir = 1; dir < 8; dir += 2) {
-		astar_node *neighbor = new astar_node;
-		sint32 nnode_to_neighbor = -1;
-		if (!score_to_neighbor(dir, nnode, neighbor, nnode_to_neighbor))
+		sint8 sx = -1, sy = -1;
+		DirFinder::get_adjacent_dir(sx, sy, dir); // sx,sy = neighbor -1,-1 + dir
+		// get neighbor of nnode towards sx,sy, and cost to that neighbor
+		const MapCoord loc = nnode->loc.abs_coords(sx, sy);
+		const sint32 nnode_to_neighbor = step_cost(nnode->loc, loc);
+		if (nnode_to_neighbor == -1)
 			continue; // this neighbor is blocked
-		astar_node *in_open = find_open_node(neighbor),
-		            *in_closed = find_closed_node(neighbor);
-		if (!compare_neighbors(nnode, neighbor, nnode_to_neighbor, in_open, in_closed))
+		const uint32 to_start = nnode->to_start + nnode_to_neighbor;
+
+		astar_node *neighbor = nodes.getValOrDefault(node_key(loc), nullptr);
+		// ignore this neighbor if already checked and closer to start
+		if (neighbor && neighbor->to_start <= to_start)
 			continue;
+
+		const uint32 to_goal = neighbor ? neighbor->to_goal : path_cost_est(loc, goal);
+		if (to_start + to_goal > max_score)
+			continue; // too far away
+
+		if (!neighbor) {
+			neighbor = new astar_node;
+			neighbor->loc = loc;
+			neighbor->to_goal = to_goal;
+			nodes[node_key(loc)] = neighbor;
+		}
 		neighbor->parent = nnode;
-		neighbor->to_goal = path_cost_est(neighbor->loc, goal);
-		neighbor->score = neighbor->to_start + neighbor->to_goal;
+		neighbor->to_start = to_start;
+		neighbor->score = to_start + to_goal;
 		neighbor->len = nnode->len + 1;
-		if (neighbor->score > max_score) {
-			delete neighbor; // too far away
-			continue;
-		}
-		// take neighbor out of closed list and put into open list
-		if (in_closed)
-			remove_closed_node(in_closed);
-		if (!in_open)
+		// put the neighbor back into the open list, or move it up there
+		if (neighbor->heap_index < 0)
 			push_open_node(neighbor);
+		else
+			sift_up(neighbor->heap_index);
 	}
 	return true;
 }
@@ -106,7 +98,9 @@ bool AStarPath::search_node_neighbors(astar_node *nnode, const MapCoord &goal,
  */
 bool AStarPath::path_search(const MapCoord &start, const MapCoord &goal) {
 	//DEBUG(0,LEVEL_DEBUGGING,"SEARCH: %d: %d,%d -> %d,%d\n",actor->get_actor_num(),start.x,start.y,goal.x,goal.y);
+	delete_nodes();
 	astar_node *start_node = new astar_node;
+	nodes[node_key(start)] = start_node;
 	start_node->loc = start;
 	start_node->to_start = 0;
 	start_node->to_goal = path_cost_est(start, goal);
@@ -115,7 +109,7 @@ bool AStarPath::path_search(const MapCoord &start, const MapCoord &goal) {
 	push_open_node(start_node);
 	const uint32 max_score = get_max_score(start_node->to_goal);
 	const uint32 max_steps = 8 * 2 * 4; // walk up to four screen lengths before searching again
-	while (!open_nodes.empty()) {
+	while (!open_heap.empty()) {
 		astar_node *nnode = pop_open_node(); // next closest
 		if (nnode->loc == goal || nnode->len >= max_steps) {
 			if (nnode->loc != goal)
@@ -128,8 +122,6 @@ bool AStarPath::path_search(const MapCoord &start, const MapCoord &goal) {
 		}
 		// check cardinal neighbors (starting at top going clockwise)
 		search_node_neighbors(nnode, goal, max_score);
-		// node and neighbors checked, put into closed
-		closed_nodes.push_back(nnode);
 	}
 //DEBUG(0,LEVEL_DEBUGGING,"FAIL\n");
 	delete_nodes();
@@ -146,72 +138,82 @@ sint32 AStarPath::step_cost(const MapCoord &c1, const MapCoord &c2) {
 	return 1;
 }
 
-/* Return an item in the list of closed nodes whose location matches `ncmp'.
+/* Return true if `n1' is to be searched before `n2'. Of nodes with the same
+ * score, those closer to the goal are searched first.
  */
-astar_node *AStarPath::find_closed_node(astar_node *ncmp) {
-	for (astar_node *n : closed_nodes)
-		if (n->loc == ncmp->loc)
-			return n;
-	return nullptr;
+bool AStarPath::node_before(const astar_node *n1, const astar_node *n2) const {
+	if (n1->score != n2->score)
+		return n1->score < n2->score;
+	return n1->to_goal < n2->to_goal;
 }
 
-/* Return an item in the list of open nodes whose location matches `ncmp'.
+/* Move the node at `index' in the open heap up until its parent comes first.
  */
-astar_node *AStarPath::find_open_node(astar_node *ncmp) {
-	for (astar_node *n : open_nodes)
-		if (n->loc == ncmp->loc)
-			return n;
-	return nullptr;
+void AStarPath::sift_up(uint32 index) {
+	astar_node *node = open_heap[index];
+	while (index > 0) {
+		uint32 parent = (index - 1) / 2;
+		if (!node_before(node, open_heap[parent]))
+			break;
+		open_heap[index] = open_heap[parent];
+		open_heap[index]->heap_index = index;
+		index = parent;
+	}
+	open_heap[index] = node;
+	node->heap_index = index;
 }
 
-/* Add new node pointer to the list of open nodes (sorting by score).
+/* Move the node at `index' in the open heap down until it comes before its
+ * children.
  */
-void AStarPath::push_open_node(astar_node *node) {
-	if (open_nodes.empty()) {
-		open_nodes.push_front(node);
-		return;
+void AStarPath::sift_down(uint32 index) {
+	astar_node *node = open_heap[index];
+	const uint32 count = open_heap.size();
+	for (;;) {
+		uint32 child = index * 2 + 1;
+		if (child >= count)
+			break;
+		if (child + 1 < count && node_before(open_heap[child + 1], open_heap[child]))
+			child++;
+		if (!node_before(open_heap[child], node))
+			break;
+		open_heap[index] = open_heap[child];
+		open_heap[index]->heap_index = index;
+		index = child;
 	}
+	open_heap[index] = node;
+	node->heap_index = index;
+}
 
-	Std::list<astar_node *>::iterator n = open_nodes.begin();
-	// get to end of list or to a node with equal or greater score
-	while (n != open_nodes.end() && (*n++)->score < node->score);
-	open_nodes.insert(n, node); // and add before that location
+/* Add new node pointer to the list of open nodes (sorting by score).
+ */
+void AStarPath::push_open_node(astar_node *node) {
+	open_heap.push_back(node);
+	sift_up(open_heap.size() - 1);
 }
 
 /* Return pointer to the highest priority node from the list of open nodes, and
- * remove it.
+ * remove it. The node is then closed.
  */
 astar_node *AStarPath::pop_open_node() {
-	astar_node *best = open_nodes.front();
-	open_nodes.pop_front(); // remove it
+	astar_node *best = open_heap.front();
+	astar_node *last = open_heap.back();
+	open_heap.pop_back();
+	if (!open_heap.empty()) {
+		open_heap[0] = last;
+		sift_down(0);
+	}
+	best->heap_index = -1;
 	return best;
 }
 
-/* Find item in the list of closed nodes whose location matched `ncmp', and
- * remove it from the list.
- */
-void AStarPath::remove_closed_node(astar_node *ncmp) {
-	Std::list<astar_node *>::iterator n;
-	for (n = closed_nodes.begin(); n != closed_nodes.end(); n++)
-		if ((*n)->loc == ncmp->loc) {
-			closed_nodes.erase(n);
-			return;
-		}
-}
-
-/* Delete nodes dereferenced from pointers in the lists.
+/* Delete all nodes of the last search.
  */
 void AStarPath::delete_nodes() {
-	while (!open_nodes.empty()) {
-		astar_node *delnode = open_nodes.front();
-		open_nodes.pop_front();
-		delete delnode;
-	}
-	while (!closed_nodes.empty()) {
-		astar_node *delnode = closed_nodes.front();
-		closed_nodes.pop_front();
-		delete delnode;
-	}
+	for (auto &n : nodes)
+		delete n._value;
+	nodes.clear();
+	open_heap.clear();
 }
 
 } // End of namespace Nuvie
@@ -22,6 +22,7 @@
 #ifndef NUVIE_PATHFINDER_ASTAR_PATH_H
 #define NUVIE_PATHFINDER_ASTAR_PATH_H
 
+#include "common/hashmap.h"
 #include "ultima/nuvie/core/map.h"
 #include "ultima/nuvie/pathfinder/path.h"
 
@@ -35,26 +36,23 @@ typedef struct astar_node_s {
 	uint32 score; // node score
 	uint32 len; // number of nodes before this one, regardless of score
 	struct astar_node_s *parent;
+	sint32 heap_index; // position in the open heap, or -1 if closed
 	astar_node_s() : loc(0, 0, 0), to_start(0), to_goal(0), score(0), len(0),
-		parent(nullptr) { }
+		parent(nullptr), heap_index(-1) { }
 } astar_node;
 /* Provides A* search and cost methods for PathFinder and subclasses.
  */class AStarPath: public Path {
 protected:
-	Std::list<astar_node *> open_nodes, closed_nodes; // nodes seen
+	Std::vector<astar_node *> open_heap; // open nodes, lowest score first
+	Common::HashMap<uint32, astar_node *> nodes; // all nodes seen, by location
 	astar_node *final_node; // last node in path search, used by create_path()
 	/* Forms a usable path from results of a search. */
 	void create_path();
 	/* Search routine. */
 	bool search_node_neighbors(astar_node *nnode, const MapCoord &goal, const uint32 max_score);
-	bool compare_neighbors(astar_node *nnode, astar_node *neighbor,
-	                       sint32 nnode_to_neighbor, astar_node *in_open,
-	                       astar_node *in_closed);
-	bool score_to_neighbor(sint8 dir, astar_node *nnode, astar_node *neighbor,
-	                       sint32 &nnode_to_neighbor);
 public:
 	AStarPath();
-	~AStarPath() override { }
+	~AStarPath() override;
 	bool path_search(const MapCoord &start, const MapCoord &goal) override;
 	uint32 path_cost_est(const MapCoord &s, const MapCoord &g) override  {
 		return Path::path_cost_est(s, g);
@@ -67,12 +65,15 @@ public:
 	}
 	sint32 step_cost(const MapCoord &c1, const MapCoord &c2) override;
 protected:
-	/* FIXME: These node functions can be replaced with a priority_queue and a list. */
-	astar_node *find_open_node(astar_node *ncmp);
+	static uint32 node_key(const MapCoord &loc) {
+		return loc.x | (loc.y << 12) | (loc.z << 24);
+	}
+	/* Open list, kept as a binary heap. */
+	bool node_before(const astar_node *n1, const astar_node *n2) const;
+	void sift_up(uint32 index);
+	void sift_down(uint32 index);
 	void push_open_node(astar_node *node);
 	astar_node *pop_open_node();
-	astar_node *find_closed_node(astar_node *ncmp);
-	void remove_closed_node(astar_node *ncmp);
 	void delete_nodes();
 };
 
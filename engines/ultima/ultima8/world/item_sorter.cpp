@@ -19,6 +19,7 @@
  *
  */
 
+#include "common/algorithm.h"
 #include "ultima/ultima.h"
 #include "ultima/ultima8/misc/common_types.h"
 #include "ultima/ultima8/world/item_sorter.h"
@@ -45,10 +46,18 @@ namespace Ultima8 {
 static const uint32 TRANSPARENT_COLOR = TEX32_PACK_RGBA(0x7F, 0x00, 0x00, 0x7F);
 static const uint32 HIGHLIGHT_COLOR = TEX32_PACK_RGBA(0xFF, 0xFF, 0x00, 0x1F);
 
+// Size of the screenspace grid cells used to find overlapping items
+static const int32 GRID_CELL_SIZE = 64;
+
+static bool DisplayLessThan(const SortItem *si1, const SortItem *si2) {
+	return si1->displayLessThan(*si2);
+}
+
 ItemSorter::ItemSorter(int capacity) :
 	_shapes(nullptr), _clipWindow(0, 0, 0, 0), _items(nullptr), _itemsTail(nullptr),
 	_itemsUnused(nullptr), _painted(nullptr), _camSx(0), _camSy(0),
-	_sortLimit(0), _sortLimitChanged(false) {
+	_sortLimit(0), _sortLimitChanged(false), _numItems(0), _sorted(true),
+	_gridWidth(0), _gridHeight(0), _gridStamp(0) {
 	int i = capacity;
 	while (i--) {
 		SortItem *next = _itemsUnused;
@@ -87,6 +96,15 @@ void ItemSorter::BeginDisplayList(const Rect &clipWindow, const Point3 &cam) {
 	_items = nullptr;
 	_itemsTail = nullptr;
 	_painted = nullptr;
+	_numItems = 0;
+	_sorted = true;
+
+	// Reset the grid, keeping the cell storage for the next frame
+	_gridWidth = MAX<int32>(1, (clipWindow.width() + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE);
+	_gridHeight = MAX<int32>(1, (clipWindow.height() + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE);
+	_grid.resize(_gridWidth * _gridHeight);
+	for (uint i = 0; i < _grid.size(); i++)
+		_grid[i].resize(0);
 
 	// Screenspace bounding box bottom x coord (RNB x coord)
 	int32 camSx = (cam.x - cam.y) / 4;
@@ -187,19 +205,11 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 	// are never deleted
 	si->_depends.clear();
 
-	// Iterate the list and compare _shapes
-
-	// Ok,
-	SortItem *addpoint = nullptr;
+#ifdef SORTITEM_OCCLUSION_EXPERIMENTAL
 	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next) {
-		// Get the insert point... which is before the first item that has higher z than us
-		if (!addpoint && si->listLessThan(*si2))
-			addpoint = si2;
-
 		if (si2->_occluded)
 			continue;
 
-#ifdef SORTITEM_OCCLUSION_EXPERIMENTAL
 		// Find adjoining rects for better occlusion
 		if (si->_occl && si2->_occl && si->_z == si2->_z) {
 			// Does this share an edge?
@@ -218,8 +228,34 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 				}
 			}
 		}
+	}
 #endif // SORTITEM_OCCLUSION_EXPERIMENTAL
 
+	// Only items sharing a grid cell can overlap. Check them in the order
+	// of the display list, as it decides which are checked before this
+	// is found to be occluded.
+	int32 x1, y1, x2, y2;
+	GetGridCells(si->_sr, x1, y1, x2, y2);
+
+	_gridStamp++;
+	_overlapping.resize(0);
+	for (int32 y = y1; y <= y2; y++) {
+		for (int32 x = x1; x <= x2; x++) {
+			const Common::Array<SortItem *> &cell = _grid[y * _gridWidth + x];
+			for (uint i = 0; i < cell.size(); i++) {
+				SortItem *si2 = cell[i];
+				if (si2->_gridStamp != _gridStamp && !si2->_occluded) {
+					si2->_gridStamp = _gridStamp;
+					_overlapping.push_back(si2);
+				}
+			}
+		}
+	}
+	Common::sort(_overlapping.begin(), _overlapping.end(), DisplayLessThan);
+
+	for (uint i = 0; i < _overlapping.size(); i++) {
+		SortItem *si2 = _overlapping[i];
+
 		// Attempt to find paint dependency order
 		if (si->overlap(*si2)) {
 			if (si->below(*si2)) {
@@ -246,19 +282,52 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 	// Add it to the list
 	_itemsUnused = _itemsUnused->_next;
 
-	// have a position
-	//addpoint = 0;
-	if (addpoint) {
-		si->_next = addpoint;
-		si->_prev = addpoint->_prev;
-		addpoint->_prev = si;
-		if (si->_prev)
-			si->_prev->_next = si;
-		else
-			_items = si;
+	si->_addIndex = _numItems++;
+	_sorted = false;
+
+	// Add it to the end of the list, it gets sorted before painting
+	if (_itemsTail)
+		_itemsTail->_next = si;
+	if (!_items)
+		_items = si;
+	si->_next = nullptr;
+	si->_prev = _itemsTail;
+	_itemsTail = si;
+
+	// Occluded items are skipped by the checks, so they needn't be found
+	if (!si->_occluded) {
+		for (int32 y = y1; y <= y2; y++) {
+			for (int32 x = x1; x <= x2; x++) {
+				_grid[y * _gridWidth + x].push_back(si);
+			}
+		}
 	}
-	// Add it to the end of the list
-	else {
+}
+
+void ItemSorter::GetGridCells(const Rect &r, int32 &x1, int32 &y1, int32 &x2, int32 &y2) const {
+	// Cells on the edges also hold whatever is beyond the clip window,
+	// so items overlapping outside of it are still found
+	x1 = CLIP<int32>((r.left - _clipWindow.left) / GRID_CELL_SIZE, 0, _gridWidth - 1);
+	y1 = CLIP<int32>((r.top - _clipWindow.top) / GRID_CELL_SIZE, 0, _gridHeight - 1);
+	x2 = CLIP<int32>((MAX(r.left, r.right - 1) - _clipWindow.left) / GRID_CELL_SIZE, 0, _gridWidth - 1);
+	y2 = CLIP<int32>((MAX(r.top, r.bottom - 1) - _clipWindow.top) / GRID_CELL_SIZE, 0, _gridHeight - 1);
+}
+
+void ItemSorter::SortDisplayList() {
+	if (_sorted)
+		return;
+	_sorted = true;
+
+	// Sort into the order of the sorted list insertion this replaces
+	_sortedItems.resize(0);
+	for (SortItem *si = _items; si != nullptr; si = si->_next)
+		_sortedItems.push_back(si);
+	Common::sort(_sortedItems.begin(), _sortedItems.end(), DisplayLessThan);
+
+	_items = nullptr;
+	_itemsTail = nullptr;
+	for (uint i = 0; i < _sortedItems.size(); i++) {
+		SortItem *si = _sortedItems[i];
 		if (_itemsTail)
 			_itemsTail->_next = si;
 		if (!_items)
@@ -275,6 +344,8 @@ void ItemSorter::AddItem(const Item *add) {
 }
 
 void ItemSorter::PaintDisplayList(RenderSurface *surf, bool item_highlight, bool showFootpads) {
+	SortDisplayList();
+
 	if (_sortLimit) {
 		// Clear the surface when debugging the sorter
 		uint32 color = TEX32_PACK_RGB(0, 0, 0);
@@ -507,6 +578,8 @@ uint16 ItemSorter::Trace(int32 x, int32 y, HitFace *face, bool item_highlight) {
 	SortItem *it;
 	SortItem *selected;
 
+	SortDisplayList();
+
 	if (!_painted) { // If no painted item found, we need to sort the items
 		it = _items;
 		_painted = nullptr;
@@ -22,6 +22,7 @@
 #ifndef ULTIMA8_WORLD_ITEMSORTER_H
 #define ULTIMA8_WORLD_ITEMSORTER_H
 
+#include "common/array.h"
 #include "ultima/ultima8/misc/rect.h"
 
 namespace Ultima {
@@ -46,6 +47,17 @@ class ItemSorter {
 	int32       _sortLimit;
 	bool        _sortLimitChanged;
 
+	// Items are added unsorted, and put in paint order on first use
+	uint32      _numItems;
+	bool        _sorted;
+	Common::Array<SortItem *> _sortedItems;
+
+	// Screenspace grid of the items in each cell, to find overlapping items
+	Common::Array<Common::Array<SortItem *> > _grid;
+	int32       _gridWidth, _gridHeight;
+	uint32      _gridStamp;
+	Common::Array<SortItem *> _overlapping;
+
 public:
 	ItemSorter(int capacity);
 	~ItemSorter();
@@ -71,6 +83,9 @@ public:
 
 private:
 	bool PaintSortItem(RenderSurface *surf, SortItem *si, bool showFootpad);
+
+	void GetGridCells(const Rect &r, int32 &x1, int32 &y1, int32 &x2, int32 &y2) const;
+	void SortDisplayList();
 };
 
 } // End of namespace Ultima8
@@ -50,7 +50,7 @@ struct SortItem {
 			_occl(false), _solid(false), _draw(false), _roof(false),
 			_noisy(false), _anim(false), _trans(false), _fixed(false),
 			_land(false), _occluded(false), _sprite(false),
-			_invitem(false) { }
+			_invitem(false), _addIndex(0), _gridStamp(0) { }
 
 	SortItem                *_next;
 	SortItem                *_prev;
@@ -120,6 +120,9 @@ struct SortItem {
 
 	int32   _order;      // Rendering _order. -1 is not yet drawn
 
+	uint32  _addIndex;   // Order in which the item was added to the display list
+	uint32  _gridStamp;  // Last dependency check this was found for in the sorter grid
+
 	// Note that Std::priority_queue could be used here, BUT there is no guarantee that it's implementation
 	// will be friendly to insertions
 	// Alternatively i could use Std::list, BUT there is no guarantee that it will keep won't delete
@@ -263,6 +266,15 @@ struct SortItem {
 		return si1._flat > si2._flat;
 	}
 
+	// Comparison for the display list, equal items are kept in the order they were added
+	inline bool displayLessThan(const SortItem &si2) const {
+		if (listLessThan(si2))
+			return true;
+		if (si2.listLessThan(*this))
+			return false;
+		return _addIndex < si2._addIndex;
+	}
+
 	Common::String dumpInfo() const;
 };
 
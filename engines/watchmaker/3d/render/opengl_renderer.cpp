@@ -33,7 +33,7 @@ namespace Watchmaker {
 
 OpenGLRenderer *g_renderer = nullptr;
 
-void OpenGLRenderer::drawIndexedPrimitivesVBO(PrimitiveType primitiveType, Common::SharedPtr<VertexBuffer> VBO, int firstVertex, int numVertices, Common::Array<uint16> faces, uint32 numFaces) {
+void OpenGLRenderer::drawIndexedPrimitivesVBO(PrimitiveType primitiveType, Common::SharedPtr<VertexBuffer> VBO, int firstVertex, int numVertices, const Common::Array<uint16> &faces, uint32 numFaces) {
 	assert(numFaces <= faces.size());
 
 	assert(primitiveType == PrimitiveType::TRIANGLE);
@@ -60,18 +60,22 @@ void OpenGLRenderer::drawIndexedPrimitivesVBO(PrimitiveType primitiveType, Commo
 
 	glEnable(GL_TEXTURE_2D);
 
-	glBegin(GL_TRIANGLES);
-	for (uint32 i = 0; i < numFaces; i++) {
-		uint16 index = faces[i];
-		assert(index <= VBO->_buffer.size());
-		auto &vertex = VBO->_buffer[index];
-		//warning("%d/%d %d: [%f, %f, %f], [%f, %f], [%f, %f]", i, numFaces, index, vertex.x, vertex.y, vertex.z, vertex.u1, vertex.v1, vertex.u2, vertex.v2);
-		//glColor3f((float)i/numFaces, 1.0, 0.0);
-		glColor3f(1.0f, 1.0f, 1.0f);
-		glTexCoord2f(vertex.u1, vertex.v1);
-		glVertex3f(vertex.x, vertex.y, -vertex.z);
-	}
-	glEnd();
+	for (uint32 i = 0; i < numFaces; i++)
+		assert(faces[i] < VBO->_buffer.size());
+
+	// The vertices are drawn straight from the buffer, flipping Z through
+	// the model view matrix instead of for every vertex
+	glScalef(1.0f, 1.0f, -1.0f);
+	glColor3f(1.0f, 1.0f, 1.0f);
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+	const byte *vertices = (const byte *)VBO->_buffer.data();
+	glVertexPointer(3, GL_FLOAT, sizeof(gVertex), vertices + offsetof(gVertex, x));
+	glTexCoordPointer(2, GL_FLOAT, sizeof(gVertex), vertices + offsetof(gVertex, u1));
+	glDrawElements(GL_TRIANGLES, numFaces, GL_UNSIGNED_SHORT, faces.data());
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
 
 	glFlush();
 	glPopMatrix();
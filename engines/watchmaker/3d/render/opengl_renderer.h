@@ -96,7 +96,7 @@ public:
 
 	void drawPrimitives(PrimitiveType primitiveType, Vertex *vertices, int numPrimitives);
 	void drawIndexedPrimitivesVBO(PrimitiveType primitiveType, int VBO, int firstVertex, int numVertices, uint16 *faces, uint32 numFaces);
-	void drawIndexedPrimitivesVBO(PrimitiveType primitiveType, Common::SharedPtr<VertexBuffer> VBO, int firstVertex, int numVertices, Common::Array<uint16> faces, uint32 numFaces);
+	void drawIndexedPrimitivesVBO(PrimitiveType primitiveType, Common::SharedPtr<VertexBuffer> VBO, int firstVertex, int numVertices, const Common::Array<uint16> &faces, uint32 numFaces);
 	void drawIndexedPrimitivesVBO(PrimitiveType primitiveType, gBatchBlock &bb);
 	bool supportsMultiTexturing() const { // TODO
 		return false;
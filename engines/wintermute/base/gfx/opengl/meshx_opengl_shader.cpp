@@ -42,17 +42,23 @@
 
 namespace Wintermute {
 
+// These must match wme_modelx.vertex
+#define MAX_SKINNING_BONES 24
+#define MAX_BONE_INFLUENCES 4
+
 //////////////////////////////////////////////////////////////////////////
 XMeshOpenGLShader::XMeshOpenGLShader(BaseGame *inGame, OpenGL::Shader *shader) :
 	XMesh(inGame), _shader(shader) {
 	glGenBuffers(1, &_vertexBuffer);
 	glGenBuffers(1, &_indexBuffer);
+	glGenBuffers(1, &_boneBuffer);
 }
 
 //////////////////////////////////////////////////////////////////////////
 XMeshOpenGLShader::~XMeshOpenGLShader() {
 	glDeleteBuffers(1, &_vertexBuffer);
 	glDeleteBuffers(1, &_indexBuffer);
+	glDeleteBuffers(1, &_boneBuffer);
 }
 
 bool XMeshOpenGLShader::loadFromXData(const Common::String &filename, XFileData *xobj) {
@@ -63,8 +69,24 @@ bool XMeshOpenGLShader::loadFromXData(const Common::String &filename, XFileData
 		uint32 vertexSize = DXGetFVFVertexSize(_blendedMesh->getFVF()) / sizeof(float);
 		uint32 vertexCount = _blendedMesh->getNumVertices();
 
+		// Skin on the GPU when the bones fit in the shader uniforms, the
+		// vertex buffer then keeps the mesh in its bind pose
+		if (_skinMesh && _skinMesh->getNumBones() <= MAX_SKINNING_BONES) {
+			float *boneData = new float[2 * MAX_BONE_INFLUENCES * vertexCount];
+			float *boneIndices = boneData;
+			float *boneWeights = boneData + MAX_BONE_INFLUENCES * vertexCount;
+
+			if (_skinMesh->getVertexInfluences(MAX_BONE_INFLUENCES, boneIndices, boneWeights)) {
+				glBindBuffer(GL_ARRAY_BUFFER, _boneBuffer);
+				glBufferData(GL_ARRAY_BUFFER, 4 * 2 * MAX_BONE_INFLUENCES * vertexCount, boneData, GL_STATIC_DRAW);
+				_gpuSkinning = true;
+			}
+
+			delete[] boneData;
+		}
+
 		glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
-		glBufferData(GL_ARRAY_BUFFER, 4 * vertexSize * vertexCount, vertexData, GL_DYNAMIC_DRAW);
+		glBufferData(GL_ARRAY_BUFFER, 4 * vertexSize * vertexCount, vertexData, _gpuSkinning ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW);
 
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
 		glBufferData(GL_ELEMENT_ARRAY_BUFFER, 4 * indexDataSize, indexData, GL_STATIC_DRAW);
@@ -131,6 +153,8 @@ bool XMeshOpenGLShader::render(XModel *model) {
 	_shader->enableVertexAttribute("texcoord", _vertexBuffer, 2, GL_FLOAT, false, 4 * vertexSize, 4 * textureOffset);
 	_shader->enableVertexAttribute("normal", _vertexBuffer, 3, GL_FLOAT, false, 4 * vertexSize, 4 * normalOffset);
 
+	setSkinning(_shader);
+
 	for (uint32 i = 0; i < numAttrs; i++) {
 		Material *mat = _materials[attrs[i]._attribId];
 		if (mat->getSurface()) {
@@ -177,6 +201,8 @@ bool XMeshOpenGLShader::renderFlatShadowModel() {
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
 
 	_flatShadowShader->enableVertexAttribute("position", _vertexBuffer, 3, GL_FLOAT, false, 4 * vertexSize, 4);
+	// The vertex buffer holds the bind pose when skinning on the GPU
+	setSkinning(_flatShadowShader);
 	_flatShadowShader->use(true);
 
 	glDrawElements(GL_TRIANGLES, _blendedMesh->getNumFaces() * 3, GL_UNSIGNED_SHORT, 0);
@@ -190,6 +216,9 @@ bool XMeshOpenGLShader::renderFlatShadowModel() {
 bool XMeshOpenGLShader::update(FrameNode *parentFrame) {
 	XMesh::update(parentFrame);
 
+	if (_gpuSkinning)
+		return true;
+
 	float *vertexData = (float *)_blendedMesh->getVertexBuffer().ptr();
 	uint32 vertexSize = DXGetFVFVertexSize(_blendedMesh->getFVF()) / sizeof(float);
 	uint32 vertexCount = _blendedMesh->getNumVertices();
@@ -200,6 +229,42 @@ bool XMeshOpenGLShader::update(FrameNode *parentFrame) {
 	return true;
 }
 
+void XMeshOpenGLShader::setSkinning(OpenGL::Shader *shader) {
+	if (_gpuSkinning) {
+		uint32 vertexCount = _blendedMesh->getNumVertices();
+		shader->enableVertexAttribute("boneIndices", _boneBuffer, MAX_BONE_INFLUENCES, GL_FLOAT, false, 4 * MAX_BONE_INFLUENCES, 0);
+		shader->enableVertexAttribute("boneWeights", _boneBuffer, MAX_BONE_INFLUENCES, GL_FLOAT, false, 4 * MAX_BONE_INFLUENCES, 4 * MAX_BONE_INFLUENCES * vertexCount);
+		setBoneUniforms(shader);
+	} else {
+		static const float noBones[MAX_BONE_INFLUENCES] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		shader->disableVertexAttribute("boneIndices", MAX_BONE_INFLUENCES, noBones);
+		shader->disableVertexAttribute("boneWeights", MAX_BONE_INFLUENCES, noBones);
+		shader->setUniform("skinned", false);
+	}
+}
+
+void XMeshOpenGLShader::setBoneUniforms(OpenGL::Shader *shader) {
+	// The bone transforms are affine, so only their first three columns are
+	// passed, as the rows of a 3x4 matrix
+	float boneData[MAX_SKINNING_BONES * 12];
+	uint32 numBones = _skinMesh->getNumBones();
+
+	for (uint32 i = 0; i < numBones; i++) {
+		const DXMatrix &m = _boneTransforms[i];
+		for (int row = 0; row < 3; row++) {
+			for (int col = 0; col < 4; col++) {
+				boneData[i * 12 + row * 4 + col] = m._m[col][row];
+			}
+		}
+	}
+
+	shader->setUniform("skinned", true);
+	GLint pos = shader->getUniformLocation("boneMatrices");
+	if (pos != -1) {
+		glUniform4fv(pos, numBones * 3, boneData);
+	}
+}
+
 void XMeshOpenGLShader::renderEffect(Material *material) {
 	Math::Vector4d diffuse(material->_material._diffuse._data);
 	_shader->use(true);
@@ -51,10 +51,13 @@ public:
 
 private:
 	void renderEffect(Material *material);
+	void setSkinning(OpenGL::Shader *shader);
+	void setBoneUniforms(OpenGL::Shader *shader);
 
 protected:
 	GLuint _vertexBuffer;
 	GLuint _indexBuffer;
+	GLuint _boneBuffer;
 
 	OpenGL::Shader *_shader;
 	OpenGL::Shader *_flatShadowShader{};
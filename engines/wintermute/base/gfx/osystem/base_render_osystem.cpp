@@ -35,11 +35,15 @@
 #include "engines/wintermute/base/base_sprite.h"
 #include "engines/util.h"
 
+#include "common/jobs.h"
 #include "common/system.h"
 #include "common/queue.h"
 #include "common/config-manager.h"
 
+#include "graphics/blit.h"
+
 #define DIRTY_RECT_LIMIT 800
+#define DIRTY_RECT_MERGE_LIMIT 16
 
 namespace Wintermute {
 
@@ -57,7 +61,6 @@ BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 
 	_borderLeft = _borderRight = _borderTop = _borderBottom = 0;
 	_ratioX = _ratioY = 1.0f;
-	_dirtyRect = nullptr;
 	_disableDirtyRects = false;
 	if (ConfMan.hasKey("dirty_rects")) {
 		_disableDirtyRects = !ConfMan.getBool("dirty_rects");
@@ -75,8 +78,6 @@ BaseRenderOSystem::~BaseRenderOSystem() {
 		delete ticket;
 	}
 
-	delete _dirtyRect;
-
 	_renderSurface->free();
 	delete _renderSurface;
 	_blankSurface->free();
@@ -158,8 +159,7 @@ bool BaseRenderOSystem::forcedFlip() {
 bool BaseRenderOSystem::flip() {
 	if (_skipThisFrame) {
 		_skipThisFrame = false;
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		g_system->updateScreen();
 		_needsFlip = false;
 
@@ -199,8 +199,7 @@ bool BaseRenderOSystem::flip() {
 			g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, 0, 0, _renderSurface->w, _renderSurface->h);
 		}
 		//  g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		_needsFlip = false;
 	}
 	_lastFrameIter = _renderQueue.end();
@@ -382,12 +381,86 @@ void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket)
 }
 
 void BaseRenderOSystem::addDirtyRect(const Common::Rect &rect) {
-	if (!_dirtyRect) {
-		_dirtyRect = new Common::Rect(rect);
+	Common::Rect r(rect);
+	r.clip(_renderRect);
+	if (!r.isEmpty())
+		_dirtyRects.push_back(r);
+}
+
+void BaseRenderOSystem::mergeDirtyRects() {
+	// Join overlapping rects, as they would be drawn twice, and nearby ones as
+	// long as that doesn't more than double the area drawn.
+	const int maxOverdraw = 2;
+
+	bool merged = true;
+	while (merged) {
+		merged = false;
+		for (uint i = 0; i < _dirtyRects.size(); i++) {
+			for (uint j = i + 1; j < _dirtyRects.size(); j++) {
+				Common::Rect joined(_dirtyRects[i]);
+				joined.extend(_dirtyRects[j]);
+
+				int area = _dirtyRects[i].width() * _dirtyRects[i].height() + _dirtyRects[j].width() * _dirtyRects[j].height();
+				if (!_dirtyRects[i].intersects(_dirtyRects[j]) && joined.width() * joined.height() > area * maxOverdraw)
+					continue;
+
+				_dirtyRects[i] = joined;
+				_dirtyRects.remove_at(j);
+				merged = true;
+				j = i;
+			}
+		}
+	}
+
+	// Past a point, the bookkeeping costs more than drawing a bit more
+	if (_dirtyRects.size() > DIRTY_RECT_MERGE_LIMIT) {
+		Common::Rect joined(_dirtyRects[0]);
+		for (uint i = 1; i < _dirtyRects.size(); i++)
+			joined.extend(_dirtyRects[i]);
+		_dirtyRects.clear();
+		_dirtyRects.push_back(joined);
+	}
+}
+
+void BaseRenderOSystem::drawTicketsInRect(const Common::Rect &rect) {
+	RenderQueueIterator it = _renderQueue.begin();
+	// A special case: If the screen has one giant OPAQUE rect to be drawn, then we skip filling
+	// the background color. Typical use-case: Fullscreen FMVs.
+	// Caveat: The FPS-counter will invalidate this.
+	if (it != _renderQueue.end() && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true) {
+		// If our single opaque rect fills the dirty rect, we can skip filling.
+		if (!(*it)->_dstRect.contains(rect)) {
+			// Apply the clear-color to the dirty rect.
+			_renderSurface->fillRect(rect, _clearColor);
+		}
+		// Otherwise Do NOT fill.
 	} else {
-		_dirtyRect->extend(rect);
+		// Apply the clear-color to the dirty rect.
+		_renderSurface->fillRect(rect, _clearColor);
+	}
+	for (; it != _renderQueue.end(); ++it) {
+		RenderTicket *ticket = *it;
+		if (ticket->_dstRect.intersects(rect)) {
+			// dstClip is the area we want redrawn.
+			Common::Rect dstClip(ticket->_dstRect);
+			// reduce it to the dirty rect
+			dstClip.clip(rect);
+			// we need to keep track of the position to redraw the dirty rect
+			Common::Rect pos(dstClip);
+			int16 offsetX = ticket->_dstRect.left;
+			int16 offsetY = ticket->_dstRect.top;
+			// convert from screen-coords to surface-coords.
+			dstClip.translate(-offsetX, -offsetY);
+
+			drawFromSurface(ticket, &pos, &dstClip);
+		}
 	}
-	_dirtyRect->clip(_renderRect);
+}
+
+void BaseRenderOSystem::drawTicketsInRectsProc(uint begin, uint end, void *refCon) {
+	BaseRenderOSystem *renderer = (BaseRenderOSystem *)refCon;
+	for (uint i = begin; i < end; i++)
+		renderer->drawTicketsInRect(renderer->_dirtyRects[i]);
 }
 
 void BaseRenderOSystem::drawTickets() {
@@ -406,7 +479,7 @@ void BaseRenderOSystem::drawTickets() {
 			++it;
 		}
 	}
-	if (!_dirtyRect || _dirtyRect->width() == 0 || _dirtyRect->height() == 0) {
+	if (_dirtyRects.empty()) {
 		it = _renderQueue.begin();
 		while (it != _renderQueue.end()) {
 			RenderTicket *ticket = *it;
@@ -416,43 +489,35 @@ void BaseRenderOSystem::drawTickets() {
 		return;
 	}
 
-	it = _renderQueue.begin();
 	_lastFrameIter = _renderQueue.end();
-	// A special case: If the screen has one giant OPAQUE rect to be drawn, then we skip filling
-	// the background color. Typical use-case: Fullscreen FMVs.
-	// Caveat: The FPS-counter will invalidate this.
-	if (it != _lastFrameIter && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true) {
-		// If our single opaque rect fills the dirty rect, we can skip filling.
-		if (*_dirtyRect != (*it)->_dstRect) {
-			// Apply the clear-color to the dirty rect.
-			_renderSurface->fillRect(*_dirtyRect, _clearColor);
-		}
-		// Otherwise Do NOT fill.
+	mergeDirtyRects();
+
+	// The merged rects don't overlap, so they can be drawn in parallel. The
+	// blitter is selected beforehand, rather than by the first worker using it.
+	if (_dirtyRects.size() > 1 && g_system->getJobSystem()->getThreadCount() > 1) {
+		Graphics::BlendBlit::init();
+		g_system->getJobSystem()->parallelFor(_dirtyRects.size(), drawTicketsInRectsProc, this, 1);
 	} else {
-		// Apply the clear-color to the dirty rect.
-		_renderSurface->fillRect(*_dirtyRect, _clearColor);
+		drawTicketsInRectsProc(0, _dirtyRects.size(), this);
 	}
-	for (; it != _renderQueue.end(); ++it) {
-		RenderTicket *ticket = *it;
-		if (ticket->_dstRect.intersects(*_dirtyRect)) {
-			// dstClip is the area we want redrawn.
-			Common::Rect dstClip(ticket->_dstRect);
-			// reduce it to the dirty rect
-			dstClip.clip(*_dirtyRect);
-			// we need to keep track of the position to redraw the dirty rect
-			Common::Rect pos(dstClip);
-			int16 offsetX = ticket->_dstRect.left;
-			int16 offsetY = ticket->_dstRect.top;
-			// convert from screen-coords to surface-coords.
-			dstClip.translate(-offsetX, -offsetY);
 
-			drawFromSurface(ticket, &pos, &dstClip);
-			_needsFlip = true;
+	for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
+		RenderTicket *ticket = *it;
+		for (uint i = 0; i < _dirtyRects.size(); i++) {
+			if (ticket->_dstRect.intersects(_dirtyRects[i])) {
+				_needsFlip = true;
+				break;
+			}
 		}
 		// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldn't become clear-color)
 		ticket->_wantsDraw = false;
 	}
-	g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(_dirtyRect->left, _dirtyRect->top), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
+
+	for (uint i = 0; i < _dirtyRects.size(); i++) {
+		const Common::Rect &r = _dirtyRects[i];
+		g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(r.left, r.top), _renderSurface->pitch, r.left, r.top, r.width(), r.height());
+	}
+	_dirtyRects.clear();
 
 	it = _renderQueue.begin();
 	// Clean out the old tickets
@@ -30,6 +30,7 @@
 
 #include "engines/wintermute/base/gfx/base_renderer.h"
 
+#include "common/array.h"
 #include "common/rect.h"
 #include "common/list.h"
 
@@ -121,6 +122,16 @@ private:
 	 * @param rect the region to be marked as dirty
 	 */
 	void addDirtyRect(const Common::Rect &rect);
+	/**
+	 * Join overlapping and nearby dirty rects, so that no area is drawn twice
+	 */
+	void mergeDirtyRects();
+	/**
+	 * Clear the given rect and redraw the tickets intersecting it
+	 * @param rect the region to be redrawn
+	 */
+	void drawTicketsInRect(const Common::Rect &rect);
+	static void drawTicketsInRectsProc(uint begin, uint end, void *refCon);
 	/**
 	 * Traverse the tickets that are dirty, and draw them
 	 */
@@ -129,7 +140,7 @@ private:
 	void drawFromSurface(RenderTicket *ticket);
 	// Dirty-rects:
 	void drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect);
-	Common::Rect *_dirtyRect;
+	Common::Array<Common::Rect> _dirtyRects;
 	Common::List<RenderTicket *> _renderQueue;
 
 	bool _needsFlip;
@@ -45,8 +45,9 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 	        _wantsDraw(true),
 	        _transform(transform) {
 	if (surf) {
-		_surface = new Graphics::Surface();
-		_surface->create((uint16)srcRect->width(), (uint16)srcRect->height(), surf->format);
+		// Keep the copy in a ManagedSurface, so that it can be blitted from
+		// without copying it again every time
+		_surface = new Graphics::ManagedSurface((uint16)srcRect->width(), (uint16)srcRect->height(), surf->format);
 		assert(_surface->format.bytesPerPixel == 4);
 		// Get a clipped copy of the surface
 		for (int i = 0; i < _surface->h; i++) {
@@ -61,17 +62,17 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 		// (Mirroring should most likely be done before rotation. See also
 		// TransformTools.)
 		if (_transform._angle != Graphics::kDefaultAngle) {
-			Graphics::Surface *temp = _surface->rotoscale(transform, owner->_gameRef->getBilinearFiltering());
-			_surface->free();
-			delete _surface;
-			_surface = temp;
+			Graphics::Surface *temp = _surface->rawSurface().rotoscale(transform, owner->_gameRef->getBilinearFiltering());
+			_surface->copyFrom(*temp);
+			temp->free();
+			delete temp;
 		} else if ((dstRect->width() != srcRect->width() ||
 					dstRect->height() != srcRect->height()) &&
 					_transform._numTimesX * _transform._numTimesY == 1) {
-			Graphics::Surface *temp = _surface->scale(dstRect->width(), dstRect->height(), owner->_gameRef->getBilinearFiltering());
-			_surface->free();
-			delete _surface;
-			_surface = temp;
+			Graphics::Surface *temp = _surface->rawSurface().scale(dstRect->width(), dstRect->height(), owner->_gameRef->getBilinearFiltering());
+			_surface->copyFrom(*temp);
+			temp->free();
+			delete temp;
 		}
 	} else {
 		_surface = nullptr;
@@ -79,10 +80,7 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 }
 
 RenderTicket::~RenderTicket() {
-	if (_surface) {
-		_surface->free();
-		delete _surface;
-	}
+	delete _surface;
 }
 
 bool RenderTicket::operator==(const RenderTicket &t) const {
@@ -98,8 +96,7 @@ bool RenderTicket::operator==(const RenderTicket &t) const {
 
 // Replacement for SDL2's SDL_RenderCopy
 void RenderTicket::drawToSurface(Graphics::Surface *_targetSurface) const {
-	Graphics::ManagedSurface src;
-	src.copyFrom(*getSurface());
+	const Graphics::ManagedSurface &src = *_surface;
 
 	Common::Rect clipRect;
 	clipRect.setWidth(getSurface()->w);
@@ -133,8 +130,7 @@ void RenderTicket::drawToSurface(Graphics::Surface *_targetSurface) const {
 }
 
 void RenderTicket::drawToSurface(Graphics::Surface *_targetSurface, Common::Rect *dstRect, Common::Rect *clipRect) const {
-	Graphics::ManagedSurface src;
-	src.copyFrom(*getSurface());
+	const Graphics::ManagedSurface &src = *_surface;
 
 	bool doDelete = false;
 	if (!clipRect) {
@@ -89,4 +89,65 @@ DXMatrix *SkinMeshHelper::getBoneOffsetMatrix(uint32 boneIndex) {
 	return _skinInfo->getBoneOffsetMatrix(boneIndex);
 }
 
+//////////////////////////////////////////////////////////////////////////
+bool SkinMeshHelper::getVertexInfluences(uint32 maxInfluences, float *boneIndices, float *boneWeights) {
+	uint32 numVertices = _mesh->getNumVertices();
+	uint32 *numInfluences = new uint32[numVertices];
+
+	memset(numInfluences, 0, numVertices * sizeof(uint32));
+	memset(boneIndices, 0, numVertices * maxInfluences * sizeof(float));
+	memset(boneWeights, 0, numVertices * maxInfluences * sizeof(float));
+
+	for (uint32 i = 0; i < _skinInfo->getNumBones(); i++) {
+		DXBone *bone = _skinInfo->getBone(i);
+		for (uint32 j = 0; j < bone->_numInfluences; j++) {
+			uint32 vertex = bone->_vertices[j];
+			if (bone->_weights[j] == 0.0f || vertex >= numVertices)
+				continue;
+
+			if (numInfluences[vertex] == maxInfluences) {
+				delete[] numInfluences;
+				return false;
+			}
+
+			uint32 slot = vertex * maxInfluences + numInfluences[vertex]++;
+			boneIndices[slot] = i;
+			boneWeights[slot] = bone->_weights[j];
+		}
+	}
+
+	delete[] numInfluences;
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool SkinMeshHelper::getBoneBoundingBox(uint32 boneIndex, DXVector3 *boxStart, DXVector3 *boxEnd) {
+	DXBone *bone = _skinInfo->getBone(boneIndex);
+	uint32 vertexSize = DXGetFVFVertexSize(_mesh->getFVF());
+	byte *points = _mesh->getVertexBuffer().ptr();
+	bool found = false;
+
+	for (uint32 i = 0; i < bone->_numInfluences; i++) {
+		if (bone->_weights[i] == 0.0f || bone->_vertices[i] >= _mesh->getNumVertices())
+			continue;
+
+		DXVector3 *vect = (DXVector3 *)(points + bone->_vertices[i] * vertexSize);
+		if (!found) {
+			*boxStart = *boxEnd = *vect;
+			found = true;
+			continue;
+		}
+
+		boxStart->_x = MIN(boxStart->_x, vect->_x);
+		boxStart->_y = MIN(boxStart->_y, vect->_y);
+		boxStart->_z = MIN(boxStart->_z, vect->_z);
+
+		boxEnd->_x = MAX(boxEnd->_x, vect->_x);
+		boxEnd->_y = MAX(boxEnd->_y, vect->_y);
+		boxEnd->_z = MAX(boxEnd->_z, vect->_z);
+	}
+
+	return found;
+}
+
 } // namespace Wintermute
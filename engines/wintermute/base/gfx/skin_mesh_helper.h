@@ -54,6 +54,8 @@ public:
 	bool updateSkinnedMesh(const DXMatrix *boneTransforms, DXMesh *mesh);
 	const char *getBoneName(uint32 boneIndex);
 	DXMatrix *getBoneOffsetMatrix(uint32 boneIndex);
+	bool getVertexInfluences(uint32 maxInfluences, float *boneIndices, float *boneWeights);
+	bool getBoneBoundingBox(uint32 boneIndex, DXVector3 *boxStart, DXVector3 *boxEnd);
 
 private:
 	DXMesh *_mesh;
@@ -49,8 +49,13 @@ XMesh::XMesh(Wintermute::BaseGame *inGame) : BaseNamedObject(inGame) {
 	_staticMesh = nullptr;
 
 	_boneMatrices = nullptr;
+	_boneTransforms = nullptr;
 	_adjacency = nullptr;
 
+	_gpuSkinning = false;
+	_blendedMeshOutdated = false;
+	_boneBBoxes = nullptr;
+
 	_BBoxStart = _BBoxEnd = DXVector3(0.0f, 0.0f, 0.0f);
 }
 
@@ -64,6 +69,10 @@ XMesh::~XMesh() {
 
 	delete[] _boneMatrices;
 	_boneMatrices = nullptr;
+	delete[] _boneTransforms;
+	_boneTransforms = nullptr;
+	delete[] _boneBBoxes;
+	_boneBBoxes = nullptr;
 	delete[] _adjacency;
 	_adjacency = nullptr;
 
@@ -97,6 +106,7 @@ bool XMesh::loadFromXData(const Common::String &filename, XFileData *xobj) {
 	if (numBones) {
 		// bones are available
 		_boneMatrices = new DXMatrix*[numBones];
+		_boneTransforms = new DXMatrix[numBones];
 
 		generateMesh();
 	} else {
@@ -195,16 +205,21 @@ bool XMesh::update(FrameNode *parentFrame) {
 	// update skinned mesh
 	if (_skinMesh) {
 		int numBones = _skinMesh->getNumBones();
-		DXMatrix *boneMatrices = new DXMatrix[numBones];
 
 		// prepare final matrices
 		for (int i = 0; i < numBones; i++) {
-			DXMatrixMultiply(&boneMatrices[i], _skinMesh->getBoneOffsetMatrix(i), _boneMatrices[i]);
+			DXMatrixMultiply(&_boneTransforms[i], _skinMesh->getBoneOffsetMatrix(i), _boneMatrices[i]);
+		}
+
+		if (_gpuSkinning) {
+			// the vertices are skinned while rendering
+			_blendedMeshOutdated = true;
+			updateBoneBoundingBox();
+			return true;
 		}
 
 		// generate skinned mesh
-		_skinMesh->updateSkinnedMesh(boneMatrices, _blendedMesh);
-		delete[] boneMatrices;
+		_skinMesh->updateSkinnedMesh(_boneTransforms, _blendedMesh);
 
 		// update mesh bounding box
 		byte *points = _blendedMesh->getVertexBuffer().ptr();
@@ -265,11 +280,71 @@ bool XMesh::update(FrameNode *parentFrame) {
 	return true;
 }
 
+//////////////////////////////////////////////////////////////////////////
+bool XMesh::updateBlendedMesh() {
+	if (!_blendedMeshOutdated)
+		return true;
+
+	_blendedMeshOutdated = false;
+	return _skinMesh->updateSkinnedMesh(_boneTransforms, _blendedMesh);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void XMesh::updateBoneBoundingBox() {
+	uint32 numBones = _skinMesh->getNumBones();
+
+	if (!_boneBBoxes) {
+		_boneBBoxes = new DXVector3[numBones * 2];
+		for (uint32 i = 0; i < numBones; i++) {
+			if (!_skinMesh->getBoneBoundingBox(i, &_boneBBoxes[i * 2], &_boneBBoxes[i * 2 + 1])) {
+				// mark bones without influences as empty
+				_boneBBoxes[i * 2] = DXVector3(1.0f, 1.0f, 1.0f);
+				_boneBBoxes[i * 2 + 1] = DXVector3(-1.0f, -1.0f, -1.0f);
+			}
+		}
+	}
+
+	// The skinned vertices are weighted averages of the vertices transformed
+	// by each bone, so they stay within the transformed boxes of the bones.
+	bool found = false;
+	for (uint32 i = 0; i < numBones; i++) {
+		const DXVector3 &start = _boneBBoxes[i * 2];
+		const DXVector3 &end = _boneBBoxes[i * 2 + 1];
+		if (start._x > end._x)
+			continue;
+
+		for (int j = 0; j < 8; j++) {
+			DXVector3 corner((j & 1) ? end._x : start._x, (j & 2) ? end._y : start._y, (j & 4) ? end._z : start._z);
+			DXVector3 vect;
+			DXVec3TransformCoord(&vect, &corner, &_boneTransforms[i]);
+
+			if (!found) {
+				_BBoxStart = _BBoxEnd = vect;
+				found = true;
+				continue;
+			}
+
+			_BBoxStart._x = MIN(_BBoxStart._x, vect._x);
+			_BBoxStart._y = MIN(_BBoxStart._y, vect._y);
+			_BBoxStart._z = MIN(_BBoxStart._z, vect._z);
+
+			_BBoxEnd._x = MAX(_BBoxEnd._x, vect._x);
+			_BBoxEnd._y = MAX(_BBoxEnd._y, vect._y);
+			_BBoxEnd._z = MAX(_BBoxEnd._z, vect._z);
+		}
+	}
+
+	if (!found)
+		_BBoxStart = _BBoxEnd = DXVector3(0.0f, 0.0f, 0.0f);
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool XMesh::updateShadowVol(ShadowVolume *shadow, DXMatrix *modelMat, DXVector3 *light, float extrusionDepth) {
 	if (!_blendedMesh)
 		return false;
 
+	updateBlendedMesh();
+
 	return shadow->addMesh(_blendedMesh, _adjacency, modelMat, light, extrusionDepth);
 }
 
@@ -278,6 +353,8 @@ bool XMesh::pickPoly(DXVector3 *pickRayOrig, DXVector3 *pickRayDir) {
 	if (!_blendedMesh)
 		return false;
 
+	updateBlendedMesh();
+
 	uint32 fvfSize = DXGetFVFVertexSize(_blendedMesh->getFVF());
 	uint32 numFaces = _blendedMesh->getNumFaces();
 
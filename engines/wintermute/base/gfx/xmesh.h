@@ -73,12 +73,22 @@ public:
 
 protected:
 	bool generateMesh();
+	bool updateBlendedMesh();
+	void updateBoneBoundingBox();
 
 	SkinMeshHelper *_skinMesh;
 	DXMesh *_blendedMesh;
 	DXMesh *_staticMesh;
 
 	DXMatrix **_boneMatrices;
+	DXMatrix *_boneTransforms;
+
+	// Skinning on the GPU only keeps the bone transforms up to date. The
+	// blended mesh is skinned on demand, and the bounding box is derived
+	// from the bind pose bounding boxes of the bones.
+	bool _gpuSkinning;
+	bool _blendedMeshOutdated;
+	DXVector3 *_boneBBoxes;
 
 	uint32 *_adjacency;
 
@@ -30,10 +30,14 @@ namespace ZVision {
 RenderTable::RenderTable(uint numColumns, uint numRows)
 	: _numRows(numRows),
 	  _numColumns(numColumns),
-	  _renderState(FLAT) {
+	  _renderState(FLAT),
+	  _generatedState(FLAT),
+	  _generatedFieldOfView(0.0f),
+	  _generatedLinearScale(0.0f) {
 	assert(numRows != 0 && numColumns != 0);
 
 	_internalBuffer = new Common::Point[numRows * numColumns];
+	_warper.create(numColumns, numRows);
 
 	memset(&_panoramaOptions, 0, sizeof(_panoramaOptions));
 	memset(&_tiltOptions, 0, sizeof(_tiltOptions));
@@ -105,34 +109,30 @@ void RenderTable::mutateImage(uint16 *sourceBuffer, uint16 *destBuffer, uint32 d
 }
 
 void RenderTable::mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf) {
-	uint32 destOffset = 0;
-
-	uint16 *sourceBuffer = (uint16 *)srcBuf->getPixels();
-	uint16 *destBuffer = (uint16 *)dstBuf->getPixels();
-
-	for (int16 y = 0; y < srcBuf->h; ++y) {
-		uint32 sourceOffset = y * _numColumns;
-
-		for (int16 x = 0; x < srcBuf->w; ++x) {
-			uint32 index = sourceOffset + x;
-
-			// RenderTable only stores offsets from the original coordinates
-			uint32 sourceYIndex = y + _internalBuffer[index].y;
-			uint32 sourceXIndex = x + _internalBuffer[index].x;
-
-			destBuffer[destOffset] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
-			destOffset++;
-		}
-	}
+	_warper.warp(*srcBuf, *dstBuf);
 }
 
 void RenderTable::generateRenderTable() {
+	// Scripts regenerate the table on every scene change, mostly with the same parameters
+	float fieldOfView = (_renderState == TILT) ? _tiltOptions.fieldOfView : _panoramaOptions.fieldOfView;
+	float linearScale = (_renderState == TILT) ? _tiltOptions.linearScale : _panoramaOptions.linearScale;
+	if (_renderState == _generatedState && fieldOfView == _generatedFieldOfView && linearScale == _generatedLinearScale)
+		return;
+
+	if (_renderState != FLAT) {
+		_generatedState = _renderState;
+		_generatedFieldOfView = fieldOfView;
+		_generatedLinearScale = linearScale;
+	}
+
 	switch (_renderState) {
 	case ZVision::RenderTable::PANORAMA:
 		generatePanoramaLookupTable();
+		updateWarper();
 		break;
 	case ZVision::RenderTable::TILT:
 		generateTiltLookupTable();
+		updateWarper();
 		break;
 	case ZVision::RenderTable::FLAT:
 		// Intentionally left empty
@@ -143,14 +143,6 @@ void RenderTable::generateRenderTable() {
 }
 
 void RenderTable::generatePanoramaLookupTable() {
-	for (uint y = 0; y < _numRows; y++) {
-		for (uint x = 0; x < _numColumns; x++) {
-			uint32 index = y * _numColumns + x;
-			_internalBuffer[index].x = 0;
-			_internalBuffer[index].y = 0;
-		}
-	}
-
 	float halfWidth = (float)_numColumns / 2.0f;
 	float halfHeight = (float)_numRows / 2.0f;
 
@@ -217,6 +209,17 @@ void RenderTable::generateTiltLookupTable() {
 	}
 }
 
+void RenderTable::updateWarper() {
+	for (uint y = 0; y < _numRows; ++y) {
+		uint32 *entries = _warper.getRow(y);
+		const Common::Point *offsets = _internalBuffer + y * _numColumns;
+
+		// RenderTable only stores offsets from the original coordinates
+		for (uint x = 0; x < _numColumns; ++x)
+			entries[x] = (y + offsets[x].y) * _numColumns + x + offsets[x].x;
+	}
+}
+
 void RenderTable::setPanoramaFoV(float fov) {
 	assert(fov > 0.0f);
 
@@ -23,6 +23,7 @@
 #define ZVISION_RENDER_TABLE_H
 
 #include "common/rect.h"
+#include "graphics/panorama_warper.h"
 #include "graphics/surface.h"
 
 namespace ZVision {
@@ -42,8 +43,14 @@ public:
 private:
 	uint _numColumns, _numRows;
 	Common::Point *_internalBuffer;
+	Graphics::PanoramaWarper _warper;
 	RenderState _renderState;
 
+	// Parameters of the table in _internalBuffer, which is only regenerated when they change
+	RenderState _generatedState;
+	float _generatedFieldOfView;
+	float _generatedLinearScale;
+
 	struct {
 		float fieldOfView;
 		float linearScale;
@@ -89,6 +96,7 @@ public:
 private:
 	void generatePanoramaLookupTable();
 	void generateTiltLookupTable();
+	void updateWarper();
 };
 
 } // End of namespace ZVision
@@ -659,16 +659,17 @@ gradientFill(PixelType *ptr, int width, int x, int y) {
 	} else if (grad == 3 && ox) {
 		colorFill<PixelType>(ptr, ptr + width, _gradCache[curGrad + 1]);
 	} else {
-		for (int j = x; j < x + width; j++, ptr++) {
-			bool oy = ((j & 1) == 1);
-
-			if ((ox && oy) ||
-				((grad == 2 || grad == 3) && ox && !oy) ||
-				(grad == 3 && oy))
-				*ptr = _gradCache[curGrad + 1];
+		// The dithering pattern only depends on the column parity
+		PixelType colors[2];
+		for (int oy = 0; oy < 2; oy++) {
+			if ((ox && oy) || ((grad == 2 || grad == 3) && ox && !oy) || (grad == 3 && oy))
+				colors[oy] = _gradCache[curGrad + 1];
 			else
-				*ptr = _gradCache[curGrad];
+				colors[oy] = _gradCache[curGrad];
 		}
+
+		for (int j = x; j < x + width; j++, ptr++)
+			*ptr = colors[j & 1];
 	}
 }
 
@@ -701,16 +702,18 @@ gradientFillClip(PixelType *ptr, int width, int x, int y, int realX, int realY)
 	} else if (grad == 3 && ox) {
 		colorFillClip<PixelType>(ptr, ptr + width, _gradCache[curGrad + 1], realX, realY, _clippingArea);
 	} else {
+		// The dithering pattern only depends on the column parity
+		PixelType colors[2];
+		for (int oy = 0; oy < 2; oy++) {
+			if ((ox && oy) || ((grad == 2 || grad == 3) && ox && !oy) || (grad == 3 && oy))
+				colors[oy] = _gradCache[curGrad + 1];
+			else
+				colors[oy] = _gradCache[curGrad];
+		}
+
 		for (int j = x; j < x + width; j++, ptr++) {
 			if (realX + j - x < _clippingArea.left || realX + j - x >= _clippingArea.right) continue;
-			bool oy = ((j & 1) == 1);
-
-			if ((ox && oy) ||
-				((grad == 2 || grad == 3) && ox && !oy) ||
-				(grad == 3 && oy))
-				*ptr = _gradCache[curGrad + 1];
-			else
-				*ptr = _gradCache[curGrad];
+			*ptr = colors[j & 1];
 		}
 	}
 }
@@ -890,6 +893,34 @@ blendPixelPtr(PixelType *ptr, PixelType color, uint8 alpha) {
 	}
 }
 
+template<typename PixelType>
+void VectorRendererSpec<PixelType>::
+blendFill(PixelType *first, PixelType *last, PixelType color, uint8 alpha) {
+	if (alpha == 0xff) {
+		colorFill<PixelType>(first, last, color | _alphaMask);
+	} else if (sizeof(PixelType) == 4 && _format.rLoss == 0 && _format.gLoss == 0 && _format.bLoss == 0 &&
+	           !((_format.rShift | _format.gShift | _format.bShift | _format.aShift) & 7)) {
+		// With 8 bits per component, blend two components at a time in 16-bit
+		// lanes. d + (((s - d) * a) >> 8) equals (d * (256 - a) + s * a) >> 8,
+		// so this gives the same result as blendPixelPtr().
+		const uint32 mask = _redMask | _greenMask | _blueMask | _alphaMask;
+		const uint32 src = color | _alphaMask;
+		const uint32 srcLo = (src & 0x00FF00FF) * alpha;
+		const uint32 srcHi = ((src >> 8) & 0x00FF00FF) * alpha;
+		const uint32 invAlpha = 256 - alpha;
+
+		for (; first < last; ++first) {
+			const uint32 dst = *first;
+			const uint32 lo = (((dst & 0x00FF00FF) * invAlpha + srcLo) >> 8) & 0x00FF00FF;
+			const uint32 hi = (((dst >> 8) & 0x00FF00FF) * invAlpha + srcHi) & 0xFF00FF00;
+			*first = (PixelType)((lo | hi) & mask);
+		}
+	} else {
+		while (first < last)
+			blendPixelPtr(first++, color, alpha);
+	}
+}
+
 template<typename PixelType>
 inline void VectorRendererSpec<PixelType>::
 blendPixelPtrClip(PixelType *ptr, PixelType color, uint8 alpha, int x, int y) {
@@ -2009,8 +2040,9 @@ drawBevelSquareAlgClip(int x, int y, int w, int h, int bevel, PixelType top_colo
 		}
 	} else {
 		while (i-- ) {
-			blendFillClip(ptr_left, ptr_left + w, ptr_x, ptr_y, _bgColor, 200);
+			blendFillClip(ptr_left, ptr_left + w, _bgColor, 200, ptr_x, ptr_y);
 			ptr_left += pitch;
+			++ptr_y;
 		}
 	}
 
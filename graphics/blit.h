@@ -30,6 +30,7 @@ struct Point;
 }
 
 class BlendBlitUnfilteredTestSuite;
+class BlendBlitBenchmarkSuite;
 
 namespace Graphics {
 
@@ -283,6 +284,9 @@ private:
 #endif
 #ifdef SCUMMVM_AVX2
 	static void blitAVX2(Args &args, const TSpriteBlendMode &blendMode, const AlphaType &alphaType);
+#endif
+#ifdef SCUMMVM_AVX512
+	static void blitAVX512(Args &args, const TSpriteBlendMode &blendMode, const AlphaType &alphaType);
 #endif
 	static void blitGeneric(Args &args, const TSpriteBlendMode &blendMode, const AlphaType &alphaType);
 	template<class T>
@@ -292,10 +296,12 @@ private:
 	typedef void(*BlitFunc)(Args &, const TSpriteBlendMode &, const AlphaType &);
 	static BlitFunc blitFunc;
 	friend class ::BlendBlitUnfilteredTestSuite;
+	friend class ::BlendBlitBenchmarkSuite;
 	friend class BlendBlitImpl_Default;
 	friend class BlendBlitImpl_NEON;
 	friend class BlendBlitImpl_SSE2;
 	friend class BlendBlitImpl_AVX2;
+	friend class BlendBlitImpl_AVX512;
 
 public:
 	static const int SCALE_THRESHOLD = 0x100;
@@ -338,6 +344,14 @@ public:
 		return PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0);
 	}
 
+	/**
+	 * Select the blit function for the features of the CPU, if not done yet.
+	 *
+	 * blit() does this on its first call. Call this before blitting from
+	 * several threads at once.
+	 */
+	static void init();
+
 	/**
 	 * Optimized version of doBlit to be used with alpha blended blitting
 	 * NOTE: Can only be used with BlendBlit::getSupportedPixelFormat format
@@ -204,10 +204,32 @@ BlendBlit::Args::Args(byte *dst, const byte *src,
 // Initialize this to nullptr at the start
 BlendBlit::BlitFunc BlendBlit::blitFunc = nullptr;
 
+// This way, we can detect at runtime whether or not the cpu has certain SIMD
+// feature enabled or not.
+void BlendBlit::init() {
+	if (blitFunc)
+		return;
+
+	// Get the correct blit function
+	BlitFunc func = blitGeneric;
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) func = blitNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) func = blitSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) func = blitAVX2;
+#endif
+#ifdef SCUMMVM_AVX512
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX512BW)) func = blitAVX512;
+#endif
+	blitFunc = func;
+}
+
 // Only blits to and from 32bpp images
 // So this function is just here to jump to whatever function is in
-// BlendBlit::blitFunc. This way, we can detect at runtime whether or not
-// the cpu has certain SIMD feature enabled or not.
+// BlendBlit::blitFunc.
 void BlendBlit::blit(byte *dst, const byte *src,
 					 const uint dstPitch, const uint srcPitch,
 					 const int posX, const int posY,
@@ -220,20 +242,8 @@ void BlendBlit::blit(byte *dst, const byte *src,
 	if (width == 0 || height == 0) return;
 
 	// If no function has been selected yet, detect and select
-	if (!blitFunc) {
-		// Get the correct blit function
-		blitFunc = blitGeneric;
-#ifdef SCUMMVM_NEON
-		if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) blitFunc = blitNEON;
-#endif
-#ifdef SCUMMVM_SSE2
-		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) blitFunc = blitSSE2;
-#endif
-#ifdef SCUMMVM_AVX2
-		if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) blitFunc = blitAVX2;
-#endif
-	}
-	
+	init();
+
 	Args args(dst, src, dstPitch, srcPitch, posX, posY, width, height, scaleX, scaleY, scaleXsrcOff, scaleYsrcOff, colorMod, flipping);
 	blitFunc(args, blendMode, alphaType);
 }
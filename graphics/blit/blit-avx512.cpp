@@ -0,0 +1,328 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/blit/blit-alpha.h"
+#include "graphics/pixelformat.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx512f,avx512bw"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw")
+#endif
+
+namespace Graphics {
+
+// Comparisons result in mask registers with AVX-512, expand them to lanes
+static inline __m512i avx512_cmpeq(__m512i a, __m512i b) {
+	return _mm512_maskz_mov_epi32(_mm512_cmpeq_epi32_mask(a, b), _mm512_set1_epi32(-1));
+}
+
+class BlendBlitImpl_AVX512 : public BlendBlitImpl_Base {
+	friend class BlendBlit;
+
+template<bool rgbmod, bool alphamod>
+struct AlphaBlend : public BlendBlitImpl_Base::AlphaBlend<rgbmod, alphamod> {
+public:
+	constexpr AlphaBlend(const uint32 color) : BlendBlitImpl_Base::AlphaBlend<rgbmod, alphamod>(color) {}
+
+	inline __m512i simd(__m512i src, __m512i dst) const {
+		__m512i ina;
+		if (alphamod)
+			ina = _mm512_srli_epi32(_mm512_mullo_epi16(_mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kAModMask)), _mm512_set1_epi32(this->ca)), 8);
+		else
+			ina = _mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kAModMask));
+		__m512i alphaMask = avx512_cmpeq(ina, _mm512_setzero_si512());
+	
+		if (rgbmod) {
+			__m512i dstR = _mm512_srli_epi32(_mm512_and_si512(dst, _mm512_set1_epi32(BlendBlit::kRModMask)), BlendBlit::kRModShift);
+			__m512i dstG = _mm512_srli_epi32(_mm512_and_si512(dst, _mm512_set1_epi32(BlendBlit::kGModMask)), BlendBlit::kGModShift);
+			__m512i dstB = _mm512_srli_epi32(_mm512_and_si512(dst, _mm512_set1_epi32(BlendBlit::kBModMask)), BlendBlit::kBModShift);
+			__m512i srcR = _mm512_srli_epi32(_mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kRModMask)), BlendBlit::kRModShift);
+			__m512i srcG = _mm512_srli_epi32(_mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kGModMask)), BlendBlit::kGModShift);
+			__m512i srcB = _mm512_srli_epi32(_mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kBModMask)), BlendBlit::kBModShift);
+
+			dstR = _mm512_slli_epi32(_mm512_mullo_epi16(dstR, _mm512_sub_epi32(_mm512_set1_epi32(255), ina)), BlendBlit::kRModShift - 8);
+			dstG = _mm512_slli_epi32(_mm512_mullo_epi16(dstG, _mm512_sub_epi32(_mm512_set1_epi32(255), ina)), BlendBlit::kGModShift - 8);
+			dstB = _mm512_mullo_epi16(dstB, _mm512_sub_epi32(_mm512_set1_epi32(255), ina));
+			srcR = _mm512_add_epi32(dstR, _mm512_slli_epi32(_mm512_mullo_epi16(_mm512_srli_epi32(_mm512_mullo_epi16(srcR, ina), 8), _mm512_set1_epi32(this->cr)), BlendBlit::kRModShift - 8));
+			srcG = _mm512_add_epi32(dstG, _mm512_slli_epi32(_mm512_mullo_epi16(_mm512_srli_epi32(_mm512_mullo_epi16(srcG, ina), 8), _mm512_set1_epi32(this->cg)), BlendBlit::kGModShift - 8));
+			srcB = _mm512_add_epi32(dstB, _mm512_mullo_epi16(_mm512_srli_epi32(_mm512_mullo_epi16(srcB, ina), 8), _mm512_set1_epi32(this->cb)));
+			src = _mm512_or_si512(_mm512_and_si512(srcB, _mm512_set1_epi32(BlendBlit::kBModMask)), _mm512_set1_epi32(BlendBlit::kAModMask));
+			src = _mm512_or_si512(_mm512_and_si512(srcG, _mm512_set1_epi32(BlendBlit::kGModMask)), src);
+			src = _mm512_or_si512(_mm512_and_si512(srcR, _mm512_set1_epi32(BlendBlit::kRModMask)), src);
+		} else {
+			__m512i dstRB = _mm512_srli_epi32(_mm512_and_si512(dst, _mm512_set1_epi32(BlendBlit::kRModMask | BlendBlit::kBModMask)), BlendBlit::kBModShift);
+			__m512i srcRB = _mm512_srli_epi32(_mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kRModMask | BlendBlit::kBModMask)), BlendBlit::kBModShift);
+			__m512i dstG = _mm512_srli_epi32(_mm512_and_si512(dst, _mm512_set1_epi32(BlendBlit::kGModMask)), BlendBlit::kGModShift);
+			__m512i srcG = _mm512_srli_epi32(_mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kGModMask)), BlendBlit::kGModShift);
+
+			dstRB = _mm512_srli_epi32(_mm512_mullo_epi32(dstRB, _mm512_sub_epi32(_mm512_set1_epi32(255), ina)), 8);
+			dstG = _mm512_srli_epi32(_mm512_mullo_epi16(dstG, _mm512_sub_epi32(_mm512_set1_epi32(255), ina)), 8);
+			srcRB = _mm512_slli_epi32(_mm512_add_epi32(dstRB, _mm512_srli_epi32(_mm512_mullo_epi32(srcRB, ina), 8)), BlendBlit::kBModShift);
+			srcG = _mm512_slli_epi32(_mm512_add_epi32(dstG, _mm512_srli_epi32(_mm512_mullo_epi16(srcG, ina), 8)), BlendBlit::kGModShift);
+			src = _mm512_or_si512(_mm512_and_si512(srcG, _mm512_set1_epi32(BlendBlit::kGModMask)), _mm512_set1_epi32(BlendBlit::kAModMask));
+			src = _mm512_or_si512(_mm512_and_si512(srcRB, _mm512_set1_epi32(BlendBlit::kBModMask | BlendBlit::kRModMask)), src);
+		}
+
+		dst = _mm512_and_si512(alphaMask, dst);
+		src = _mm512_andnot_si512(alphaMask, src);
+		return _mm512_or_si512(dst, src);
+	}
+};
+
+template<bool rgbmod, bool alphamod>
+struct MultiplyBlend : public BlendBlitImpl_Base::MultiplyBlend<rgbmod, alphamod> {
+public:
+	constexpr MultiplyBlend(const uint32 color) : BlendBlitImpl_Base::MultiplyBlend<rgbmod, alphamod>(color) {}
+
+	inline __m512i simd(__m512i src, __m512i dst) const {
+		__m512i ina, alphaMask;
+		if (alphamod) {
+			ina = _mm512_srli_epi32(_mm512_mullo_epi16(_mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kAModMask)), _mm512_set1_epi32(this->ca)), 8);
+			alphaMask = avx512_cmpeq(ina, _mm512_setzero_si512());
+		} else {
+			ina = _mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kAModMask));
+			alphaMask = _mm512_set1_epi32(BlendBlit::kAModMask);
+		}
+
+		if (rgbmod) {
+			__m512i srcB = _mm512_srli_epi32(_mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kBModMask)), BlendBlit::kBModShift);
+			__m512i srcG = _mm512_srli_epi32(_mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kGModMask)), BlendBlit::kGModShift);
+			__m512i srcR = _mm512_srli_epi32(_mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kRModMask)), BlendBlit::kRModShift);
+			__m512i dstB = _mm512_srli_epi32(_mm512_and_si512(dst, _mm512_set1_epi32(BlendBlit::kBModMask)), BlendBlit::kBModShift);
+			__m512i dstG = _mm512_srli_epi32(_mm512_and_si512(dst, _mm512_set1_epi32(BlendBlit::kGModMask)), BlendBlit::kGModShift);
+			__m512i dstR = _mm512_srli_epi32(_mm512_and_si512(dst, _mm512_set1_epi32(BlendBlit::kRModMask)), BlendBlit::kRModShift);
+
+			srcB = _mm512_and_si512(_mm512_slli_epi32(_mm512_mullo_epi32(dstB, _mm512_srli_epi32(_mm512_mullo_epi32(_mm512_mullo_epi16(srcB, _mm512_set1_epi32(this->cb)), ina), 16)), BlendBlit::kBModShift - 8), _mm512_set1_epi32(BlendBlit::kBModMask));
+			srcG = _mm512_and_si512(_mm512_slli_epi32(_mm512_mullo_epi32(dstG, _mm512_srli_epi32(_mm512_mullo_epi32(_mm512_mullo_epi16(srcG, _mm512_set1_epi32(this->cg)), ina), 16)), BlendBlit::kGModShift - 8), _mm512_set1_epi32(BlendBlit::kGModMask));
+			srcR = _mm512_and_si512(_mm512_slli_epi32(_mm512_mullo_epi32(dstR, _mm512_srli_epi32(_mm512_mullo_epi32(_mm512_mullo_epi16(srcR, _mm512_set1_epi32(this->cr)), ina), 16)), BlendBlit::kRModShift - 8), _mm512_set1_epi32(BlendBlit::kRModMask));
+
+			src = _mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kAModMask));
+			src = _mm512_or_si512(src, _mm512_or_si512(srcB, _mm512_or_si512(srcG, srcR)));
+		} else {
+			constexpr uint32 rbMask = BlendBlit::kRModMask | BlendBlit::kBModMask;
+			__m512i dstRB = _mm512_srli_epi32(_mm512_and_si512(dst, _mm512_set1_epi32(BlendBlit::kRModMask | BlendBlit::kBModMask)), BlendBlit::kBModShift);
+			__m512i srcRB = _mm512_srli_epi32(_mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kRModMask | BlendBlit::kBModMask)), BlendBlit::kBModShift);
+			__m512i dstG = _mm512_srli_epi32(_mm512_and_si512(dst, _mm512_set1_epi32(BlendBlit::kGModMask)), BlendBlit::kGModShift);
+			__m512i srcG = _mm512_srli_epi32(_mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kGModMask)), BlendBlit::kGModShift);
+
+			srcG = _mm512_and_si512(_mm512_slli_epi32(_mm512_mullo_epi16(dstG, _mm512_srli_epi32(_mm512_mullo_epi16(srcG, ina), 8)), 8), _mm512_set1_epi32(BlendBlit::kGModMask));
+			srcRB = _mm512_and_si512(_mm512_mullo_epi16(dstRB, _mm512_srli_epi32(_mm512_and_si512(_mm512_mullo_epi32(srcRB, ina), _mm512_set1_epi32(rbMask)), 8)), _mm512_set1_epi32(rbMask));
+			
+			src = _mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kAModMask));
+			src = _mm512_or_si512(src, _mm512_or_si512(srcRB, srcG));
+		}
+
+		dst = _mm512_and_si512(alphaMask, dst);
+		src = _mm512_andnot_si512(alphaMask, src);
+		return _mm512_or_si512(dst, src);
+	}
+};
+
+template<bool rgbmod, bool alphamod>
+struct OpaqueBlend : public BlendBlitImpl_Base::OpaqueBlend<rgbmod, alphamod> {
+public:
+	constexpr OpaqueBlend(const uint32 color) : BlendBlitImpl_Base::OpaqueBlend<rgbmod, alphamod>(color) {}
+
+	inline __m512i simd(__m512i src, __m512i dst) const {
+		return _mm512_or_si512(src, _mm512_set1_epi32(BlendBlit::kAModMask));
+	}
+};
+
+template<bool rgbmod, bool alphamod>
+struct BinaryBlend : public BlendBlitImpl_Base::BinaryBlend<rgbmod, alphamod> {
+public:
+	constexpr BinaryBlend(const uint32 color) : BlendBlitImpl_Base::BinaryBlend<rgbmod, alphamod>(color) {}
+
+	inline __m512i simd(__m512i src, __m512i dst) const {
+		__m512i alphaMask = avx512_cmpeq(_mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kAModMask)), _mm512_setzero_si512());
+		dst = _mm512_and_si512(dst, alphaMask);
+		src = _mm512_andnot_si512(alphaMask, _mm512_or_si512(src, _mm512_set1_epi32(BlendBlit::kAModMask)));
+		return _mm512_or_si512(src, dst);
+	}
+};
+
+template<bool rgbmod, bool alphamod>
+struct AdditiveBlend : public BlendBlitImpl_Base::AdditiveBlend<rgbmod, alphamod> {
+public:
+	constexpr AdditiveBlend(const uint32 color) : BlendBlitImpl_Base::AdditiveBlend<rgbmod, alphamod>(color) {}
+
+	inline __m512i simd(__m512i src, __m512i dst) const {
+		__m512i ina;
+		if (alphamod)
+			ina = _mm512_srli_epi32(_mm512_mullo_epi32(_mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kAModMask)), _mm512_set1_epi32(this->ca)), 8);
+		else
+			ina = _mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kAModMask));
+		__m512i alphaMask = avx512_cmpeq(ina, _mm512_set1_epi32(0));
+
+		if (rgbmod) {
+			__m512i srcb = _mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kBModMask));
+			__m512i srcg = _mm512_srli_epi32(_mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kGModMask)), BlendBlit::kGModShift);
+			__m512i srcr = _mm512_srli_epi32(_mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kRModMask)), BlendBlit::kRModShift);
+			__m512i dstb = _mm512_and_si512(dst, _mm512_set1_epi32(BlendBlit::kBModMask));
+			__m512i dstg = _mm512_srli_epi32(_mm512_and_si512(dst, _mm512_set1_epi32(BlendBlit::kGModMask)), BlendBlit::kGModShift);
+			__m512i dstr = _mm512_srli_epi32(_mm512_and_si512(dst, _mm512_set1_epi32(BlendBlit::kRModMask)), BlendBlit::kRModShift);
+
+			srcb = _mm512_and_si512(_mm512_add_epi32(dstb, _mm512_srli_epi32(_mm512_mullo_epi32(srcb, _mm512_mullo_epi32(_mm512_set1_epi32(this->cb), ina)), 16)), _mm512_set1_epi32(BlendBlit::kBModMask));
+			srcg = _mm512_and_si512(_mm512_add_epi32(dstg, _mm512_mullo_epi32(srcg, _mm512_mullo_epi32(_mm512_set1_epi32(this->cg), ina))), _mm512_set1_epi32(BlendBlit::kGModMask));
+			srcr = _mm512_and_si512(_mm512_add_epi32(dstr, _mm512_srli_epi32(_mm512_mullo_epi32(srcr, _mm512_mullo_epi32(_mm512_set1_epi32(this->cr), ina)), BlendBlit::kRModShift - 16)), _mm512_set1_epi32(BlendBlit::kRModMask));
+
+			src = _mm512_and_si512(dst, _mm512_set1_epi32(BlendBlit::kAModMask));
+			src = _mm512_or_si512(src, _mm512_or_si512(srcb, _mm512_or_si512(srcg, srcb)));
+		} else if (alphamod) {
+			__m512i srcg = _mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kGModMask));
+			__m512i srcrb = _mm512_srli_epi32(_mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kRModMask | BlendBlit::kBModMask)), BlendBlit::kBModShift);
+			__m512i dstg = _mm512_and_si512(dst, _mm512_set1_epi32(BlendBlit::kGModMask));
+			__m512i dstrb = _mm512_srli_epi32(_mm512_and_si512(dst, _mm512_set1_epi32(BlendBlit::kRModMask | BlendBlit::kBModMask)), BlendBlit::kBModShift);
+
+			srcg = _mm512_and_si512(_mm512_add_epi32(dstg, _mm512_srli_epi32(_mm512_mullo_epi32(srcg, ina), 8)), _mm512_set1_epi32(BlendBlit::kGModMask));
+			srcrb = _mm512_and_si512(_mm512_add_epi32(dstrb, _mm512_mullo_epi32(srcrb, ina)), _mm512_set1_epi32(BlendBlit::kRModMask | BlendBlit::kBModMask));
+
+			src = _mm512_and_si512(dst, _mm512_set1_epi32(BlendBlit::kAModMask));
+			src = _mm512_or_si512(src, _mm512_or_si512(srcrb, srcg));
+		} else {
+			__m512i srcg = _mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kGModMask));
+			__m512i srcrb = _mm512_srli_epi32(_mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kRModMask | BlendBlit::kBModMask)), BlendBlit::kBModShift);
+			__m512i dstg = _mm512_and_si512(dst, _mm512_set1_epi32(BlendBlit::kGModMask));
+			__m512i dstrb = _mm512_srli_epi32(_mm512_and_si512(dst, _mm512_set1_epi32(BlendBlit::kRModMask | BlendBlit::kBModMask)), BlendBlit::kBModShift);
+
+			srcg = _mm512_and_si512(_mm512_add_epi32(dstg, srcg), _mm512_set1_epi32(BlendBlit::kGModMask));
+			srcrb = _mm512_and_si512(_mm512_slli_epi32(_mm512_add_epi32(dstrb, srcrb), 8), _mm512_set1_epi32(BlendBlit::kRModMask | BlendBlit::kBModMask));
+
+			src = _mm512_and_si512(dst, _mm512_set1_epi32(BlendBlit::kAModMask));
+			src = _mm512_or_si512(src, _mm512_or_si512(srcrb, srcg));
+		}
+
+		dst = _mm512_and_si512(alphaMask, dst);
+		src = _mm512_andnot_si512(alphaMask, src);
+		return _mm512_or_si512(dst, src);
+	}
+};
+
+template<bool rgbmod, bool alphamod>
+struct SubtractiveBlend : public BlendBlitImpl_Base::SubtractiveBlend<rgbmod, alphamod> {
+public:
+	constexpr SubtractiveBlend(const uint32 color) : BlendBlitImpl_Base::SubtractiveBlend<rgbmod, alphamod>(color) {}
+
+	inline __m512i simd(__m512i src, __m512i dst) const {
+		__m512i ina = _mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kAModMask));
+		__m512i srcb = _mm512_srli_epi32(_mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kBModMask)), BlendBlit::kBModShift);
+		__m512i srcg = _mm512_srli_epi32(_mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kGModMask)), BlendBlit::kGModShift);
+		__m512i srcr = _mm512_srli_epi32(_mm512_and_si512(src, _mm512_set1_epi32(BlendBlit::kRModMask)), BlendBlit::kRModShift);
+		__m512i dstb = _mm512_srli_epi32(_mm512_and_si512(dst, _mm512_set1_epi32(BlendBlit::kBModMask)), BlendBlit::kBModShift);
+		__m512i dstg = _mm512_srli_epi32(_mm512_and_si512(dst, _mm512_set1_epi32(BlendBlit::kGModMask)), BlendBlit::kGModShift);
+		__m512i dstr = _mm512_srli_epi32(_mm512_and_si512(dst, _mm512_set1_epi32(BlendBlit::kRModMask)), BlendBlit::kRModShift);
+
+		srcb = _mm512_and_si512(_mm512_slli_epi32(_mm512_max_epi16(_mm512_sub_epi32(dstb, _mm512_srli_epi32(_mm512_mullo_epi32(_mm512_mullo_epi32(srcb, _mm512_set1_epi32(this->cb)), _mm512_mullo_epi32(dstb, ina)), 24)), _mm512_set1_epi32(0)), BlendBlit::kBModShift), _mm512_set1_epi32(BlendBlit::kBModMask));
+		srcg = _mm512_and_si512(_mm512_slli_epi32(_mm512_max_epi16(_mm512_sub_epi32(dstg, _mm512_srli_epi32(_mm512_mullo_epi32(_mm512_mullo_epi32(srcg, _mm512_set1_epi32(this->cg)), _mm512_mullo_epi32(dstg, ina)), 24)), _mm512_set1_epi32(0)), BlendBlit::kGModShift), _mm512_set1_epi32(BlendBlit::kGModMask));
+		srcr = _mm512_and_si512(_mm512_slli_epi32(_mm512_max_epi16(_mm512_sub_epi32(dstr, _mm512_srli_epi32(_mm512_mullo_epi32(_mm512_mullo_epi32(srcr, _mm512_set1_epi32(this->cr)), _mm512_mullo_epi32(dstr, ina)), 24)), _mm512_set1_epi32(0)), BlendBlit::kRModShift), _mm512_set1_epi32(BlendBlit::kRModMask));
+
+		return _mm512_or_si512(_mm512_set1_epi32(BlendBlit::kAModMask), _mm512_or_si512(srcb, _mm512_or_si512(srcg, srcr)));
+	}
+};
+
+public:
+template<template <bool RGBMOD, bool ALPHAMOD> class PixelFunc, bool doscale, bool rgbmod, bool alphamod>
+static void blitInnerLoop(BlendBlit::Args &args) {
+	const bool loaddst = true; // TODO: Only set this when necessary
+
+	const byte *in;
+	byte *out;
+
+	const PixelFunc<rgbmod, alphamod> pixelFunc(args.color);
+
+	int scaleXCtr, scaleYCtr = args.scaleYoff;
+	const byte *inBase;
+
+	if (!doscale && (args.flipping & FLIP_H)) args.ino -= 4 * 15;
+
+	for (uint32 i = 0; i < args.height; i++) {
+		if (doscale) {
+			inBase = args.ino + scaleYCtr / BlendBlit::SCALE_THRESHOLD * args.inoStep;
+			scaleXCtr = args.scaleXoff;
+		} else {
+			in = args.ino;
+		}
+		out = args.outo;
+
+		uint32 j = 0;
+		for (; j + 16 <= args.width; j += 16) {
+			__m512i dstPixels, srcPixels;
+			if (loaddst) dstPixels = _mm512_loadu_si512((const void *)out);
+			if (!doscale) {
+				srcPixels = _mm512_loadu_si512((const void *)in);
+			} else {
+				uint32 scaled[16];
+				for (int k = 0; k < 16; k++)
+					scaled[k] = *(const uint32 *)(inBase + (ptrdiff_t)(scaleXCtr + args.scaleX * k) / (ptrdiff_t)BlendBlit::SCALE_THRESHOLD * args.inStep);
+				srcPixels = _mm512_loadu_si512((const void *)scaled);
+				scaleXCtr += args.scaleX * 16;
+			}
+			if (!doscale && (args.flipping & FLIP_H)) {
+				srcPixels = _mm512_permutexvar_epi32(_mm512_setr_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0), srcPixels);
+			}
+			{
+				const __m512i res = pixelFunc.simd(srcPixels, dstPixels);
+				_mm512_storeu_si512((void *)out, res);
+			}
+			if (!doscale) in += (ptrdiff_t)args.inStep * 16;
+			out += 4ULL * 16;
+		}
+		if (!doscale && (args.flipping & FLIP_H)) in += 4 * 15;
+		for (; j < args.width; j++) {
+			if (doscale) {
+				in = inBase + scaleXCtr / BlendBlit::SCALE_THRESHOLD * args.inStep;
+			}
+
+			pixelFunc.normal(in, out);
+
+			if (doscale)
+				scaleXCtr += args.scaleX;
+			else
+				in += args.inStep;
+			out += 4;
+		}
+		if (doscale)
+			scaleYCtr += args.scaleY;
+		else
+			args.ino += args.inoStep;
+		args.outo += args.dstPitch;
+	}
+}
+
+}; // end of class BlendBlitImpl_AVX512
+
+void BlendBlit::blitAVX512(Args &args, const TSpriteBlendMode &blendMode, const AlphaType &alphaType) {
+	blitT<BlendBlitImpl_AVX512>(args, blendMode, alphaType);
+}
+
+} // End of namespace Graphics
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
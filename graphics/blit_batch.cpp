@@ -0,0 +1,119 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/blit_batch.h"
+#include "common/textconsole.h"
+
+namespace Graphics {
+
+void BlitBatch::add(const ManagedSurface &src, const Common::Rect &destRect,
+                    const Common::Rect *srcRect, const uint32 colorMod,
+                    const int flipping, const TSpriteBlendMode blend,
+                    const AlphaType alphaType) {
+	if (!ManagedSurface::isBlendBlitPixelFormatSupported(src.format, BlendBlit::getSupportedPixelFormat())) {
+		warning("BlitBatch::add only accepts RGBA32!");
+		return;
+	}
+
+	// Nothing would be drawn, see ManagedSurface::blendBlitTo()
+	if ((colorMod & MS_ARGB(255, 0, 0, 0)) == 0 || destRect.isEmpty())
+		return;
+
+	Item item;
+	item.src = &src;
+	item.srcRect = srcRect ? *srcRect : Common::Rect(0, 0, src.w, src.h);
+	item.destRect = destRect;
+	item.colorMod = colorMod;
+	item.flipping = flipping;
+	item.blend = blend;
+	item.alphaType = alphaType;
+
+	if (item.srcRect.isEmpty())
+		return;
+
+	_items.push_back(item);
+}
+
+void BlitBatch::getDrawOrder(const Common::Rect &bounds, Common::Array<const Item *> &order) const {
+	order.reserve(_items.size());
+
+	for (uint i = 0; i < _items.size(); i++) {
+		const Item &item = _items[i];
+		if (!item.destRect.intersects(bounds))
+			continue;
+
+		// Draw the sprite right after the last one using the same source,
+		// unless something drawn in between would end up below it.
+		uint pos = order.size();
+		if (_reorder) {
+			for (uint j = order.size(); j-- > 0; ) {
+				if (order[j]->src == item.src) {
+					pos = j + 1;
+					break;
+				}
+				if (order[j]->destRect.intersects(item.destRect))
+					break;
+			}
+		}
+
+		order.insert_at(pos, &item);
+	}
+}
+
+Common::Rect BlitBatch::blitTo(Surface &target) const {
+	if (!ManagedSurface::isBlendBlitPixelFormatSupported(BlendBlit::getSupportedPixelFormat(), target.format)) {
+		warning("BlitBatch::blitTo only accepts RGBA32!");
+		return Common::Rect();
+	}
+
+	const Common::Rect bounds(target.w, target.h);
+	Common::Array<const Item *> order;
+	getDrawOrder(bounds, order);
+
+	Common::Rect drawn;
+	for (uint i = 0; i < order.size(); i++) {
+		const Item &item = *order[i];
+		const Common::Rect size = item.src->blendBlitTo(target,
+			item.destRect.left, item.destRect.top, item.flipping, &item.srcRect, item.colorMod,
+			item.destRect.width(), item.destRect.height(), item.blend, item.alphaType);
+
+		if (!size.isEmpty()) {
+			Common::Rect area = item.destRect;
+			area.clip(bounds);
+			if (drawn.isEmpty())
+				drawn = area;
+			else
+				drawn.extend(area);
+		}
+	}
+
+	return drawn;
+}
+
+Common::Rect BlitBatch::blitTo(ManagedSurface &target) const {
+	target.invalidateConversionCache();
+	const Common::Rect drawn = blitTo(*target.surfacePtr());
+	if (!drawn.isEmpty())
+		target.addDirtyRect(drawn);
+	return drawn;
+}
+
+} // End of namespace Graphics
@@ -0,0 +1,130 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_BLIT_BATCH_H
+#define GRAPHICS_BLIT_BATCH_H
+
+#include "common/array.h"
+#include "common/rect.h"
+#include "graphics/managed_surface.h"
+
+namespace Graphics {
+
+/**
+ * @defgroup graphics_blit_batch Blit batches
+ * @ingroup graphics
+ *
+ * @brief Collects sprite blits so they can be drawn in one go.
+ *
+ * @{
+ */
+
+/**
+ * A list of ManagedSurface::blendBlitTo() calls, which are drawn onto a
+ * target surface with a single call to blitTo().
+ *
+ * Unsupported formats and invisible sprites are rejected when they are
+ * added. When drawing, sprites sharing a source are drawn one after the
+ * other where this doesn't change the result: a sprite is never moved past
+ * another one it overlaps with. The result is therefore always the same as
+ * when drawing the sprites in the order they were added.
+ *
+ * The source surfaces must stay alive until the batch has been drawn or
+ * cleared.
+ */
+class BlitBatch {
+public:
+	BlitBatch() : _reorder(true) {}
+
+	/**
+	 * Add a sprite to the batch.
+	 *
+	 * @param src        Surface to draw.
+	 * @param destRect   Area of the target to draw it to. The sprite is
+	 *                   scaled if this differs from the size of @p srcRect.
+	 * @param srcRect    Part of @p src to draw, or nullptr for all of it.
+	 * @param colorMod   Color to multiply with (0xffffffff does nothing).
+	 * @param flipping   Flipping flags (see FLIP_FLAGS).
+	 * @param blend      Blending mode to use.
+	 * @param alphaType  Alpha mode to use.
+	 */
+	void add(const ManagedSurface &src, const Common::Rect &destRect,
+	         const Common::Rect *srcRect = nullptr,
+	         const uint32 colorMod = MS_ARGB(255, 255, 255, 255),
+	         const int flipping = FLIP_NONE,
+	         const TSpriteBlendMode blend = BLEND_NORMAL,
+	         const AlphaType alphaType = ALPHA_FULL);
+
+	/** Add a sprite at its original size. */
+	void add(const ManagedSurface &src, const Common::Point &destPos,
+	         const uint32 colorMod = MS_ARGB(255, 255, 255, 255),
+	         const int flipping = FLIP_NONE,
+	         const TSpriteBlendMode blend = BLEND_NORMAL,
+	         const AlphaType alphaType = ALPHA_FULL) {
+		add(src, Common::Rect(destPos.x, destPos.y, destPos.x + src.w, destPos.y + src.h), nullptr, colorMod, flipping, blend, alphaType);
+	}
+
+	/**
+	 * Draw all sprites onto @p target.
+	 *
+	 * The batch is left untouched, so it can be drawn again.
+	 *
+	 * @return The bounding box of the area drawn to.
+	 */
+	Common::Rect blitTo(Surface &target) const;
+
+	/**
+	 * Draw all sprites onto @p target and mark the area drawn to as dirty.
+	 */
+	Common::Rect blitTo(ManagedSurface &target) const;
+
+	/**
+	 * Allow or forbid changing the order of non-overlapping sprites.
+	 * Reordering is enabled by default.
+	 */
+	void setReorder(bool reorder) { _reorder = reorder; }
+
+	void clear() { _items.clear(); }
+	bool empty() const { return _items.empty(); }
+	uint size() const { return _items.size(); }
+
+private:
+	struct Item {
+		const ManagedSurface *src;
+		Common::Rect srcRect;
+		Common::Rect destRect;
+		uint32 colorMod;
+		int flipping;
+		TSpriteBlendMode blend;
+		AlphaType alphaType;
+	};
+
+	void getDrawOrder(const Common::Rect &bounds, Common::Array<const Item *> &order) const;
+
+	Common::Array<Item> _items;
+	bool _reorder;
+};
+
+/** @} */
+
+} // End of namespace Graphics
+
+#endif
@@ -23,6 +23,7 @@
 
 #include "graphics/color_quantizer.h"
 #include "graphics/palette.h"
+#include "graphics/surface.h"
 
 namespace Graphics {
 
@@ -107,7 +108,7 @@ private:
 		delete node;
 	}
 
-	void insert(OctreeNode **node, byte r, byte g, byte b, uint level) {
+	void insert(OctreeNode **node, byte r, byte g, byte b, uint32 count, uint level) {
 		if (*node == nullptr) {
 			*node = allocateNode(level);
 			if (level != _leafLevel) {
@@ -122,10 +123,10 @@ private:
 		// regular node. But I saw no mention of this in the article.
 
 		if ((*node)->isLeaf) {
-			(*node)->numPixels++;
-			(*node)->sumRed += r;
-			(*node)->sumGreen += g;
-			(*node)->sumBlue += b;
+			(*node)->numPixels += count;
+			(*node)->sumRed += r * count;
+			(*node)->sumGreen += g * count;
+			(*node)->sumBlue += b * count;
 		} else {
 			byte bit = (0x80 >> level);
 			byte rbit = (r & bit) >> (5 - level);
@@ -133,7 +134,7 @@ private:
 			byte bbit = (b & bit) >> (7 - level);
 			int idx = rbit | gbit | bbit;
 
-			insert(&((*node)->child[idx]), r, g, b, level + 1);
+			insert(&((*node)->child[idx]), r, g, b, count, level + 1);
 		}
 
 		// Usually one reduction would be enough, but it's possible
@@ -232,8 +233,8 @@ public:
 		deleteNodeRecursively(_root);
 	}
 
-	void insert(byte r, byte g, byte b) {
-		insert(&_root, r, g, b, 0);
+	void insert(byte r, byte g, byte b, uint32 count) {
+		insert(&_root, r, g, b, count, 0);
 	}
 
 	Palette *getPalette() {
@@ -244,6 +245,11 @@ public:
 
 		return _palette;
 	}
+
+	/** The number of colors in the last palette retrieved */
+	uint getNumColors() const {
+		return _colorIndex;
+	}
 };
 
 ColorQuantizer::ColorQuantizer(int maxColors) {
@@ -252,14 +258,110 @@ ColorQuantizer::ColorQuantizer(int maxColors) {
 
 ColorQuantizer::~ColorQuantizer() {
 	delete _octree;
+	delete _palette;
+	delete[] _lookup;
 }
 
 void ColorQuantizer::addColor(byte r, byte g, byte b) {
-	_octree->insert(r, g, b);
+	_octree->insert(r, g, b, 1);
+}
+
+void ColorQuantizer::addSurface(const Surface &surface) {
+	const PixelFormat &format = surface.format;
+	assert(format.bytesPerPixel > 1 && format.bytesPerPixel <= 4);
+
+	for (int y = 0; y < surface.h; y++) {
+		const byte *src = (const byte *)surface.getBasePtr(0, y);
+		uint32 runColor = 0;
+		uint32 runLength = 0;
+
+		for (int x = 0; x < surface.w; x++) {
+			uint32 color;
+			if (format.bytesPerPixel == 2)
+				color = *(const uint16 *)src;
+			else if (format.bytesPerPixel == 3)
+				color = READ_UINT24(src);
+			else
+				color = *(const uint32 *)src;
+			src += format.bytesPerPixel;
+
+			if (runLength && color == runColor) {
+				runLength++;
+				continue;
+			}
+
+			if (runLength) {
+				byte r, g, b;
+				format.colorToRGB(runColor, r, g, b);
+				_octree->insert(r, g, b, runLength);
+			}
+
+			runColor = color;
+			runLength = 1;
+		}
+
+		if (runLength) {
+			byte r, g, b;
+			format.colorToRGB(runColor, r, g, b);
+			_octree->insert(r, g, b, runLength);
+		}
+	}
 }
 
 Graphics::Palette *ColorQuantizer::getPalette() {
-	return _octree->getPalette();
+	Palette *palette = _octree->getPalette();
+
+	// Keep the colors which are actually used for mapping, as the unused
+	// entries are all black
+	delete _palette;
+	_palette = new Palette(palette->data(), _octree->getNumColors());
+
+	if (!_lookup)
+		_lookup = new uint16[32 * 32 * 32];
+	memset(_lookup, 0xFF, 32 * 32 * 32 * sizeof(uint16));
+
+	return palette;
+}
+
+byte ColorQuantizer::findBestColor(byte r, byte g, byte b) {
+	if (!_lookup || !_palette->size())
+		return 0;
+
+	uint16 &entry = _lookup[(r >> 3) << 10 | (g >> 3) << 5 | (b >> 3)];
+	if (entry == 0xFFFF)
+		entry = _palette->findBestColor((r & 0xF8) | 4, (g & 0xF8) | 4, (b & 0xF8) | 4);
+
+	return entry;
+}
+
+Surface *ColorQuantizer::convertSurface(const Surface &surface) {
+	const PixelFormat &format = surface.format;
+	assert(format.bytesPerPixel > 1 && format.bytesPerPixel <= 4);
+
+	Surface *result = new Surface();
+	result->create(surface.w, surface.h, PixelFormat::createFormatCLUT8());
+
+	for (int y = 0; y < surface.h; y++) {
+		const byte *src = (const byte *)surface.getBasePtr(0, y);
+		byte *dst = (byte *)result->getBasePtr(0, y);
+
+		for (int x = 0; x < surface.w; x++) {
+			uint32 color;
+			if (format.bytesPerPixel == 2)
+				color = *(const uint16 *)src;
+			else if (format.bytesPerPixel == 3)
+				color = READ_UINT24(src);
+			else
+				color = *(const uint32 *)src;
+			src += format.bytesPerPixel;
+
+			byte r, g, b;
+			format.colorToRGB(color, r, g, b);
+			*dst++ = findBestColor(r, g, b);
+		}
+	}
+
+	return result;
 }
 
 } // End of namespace Graphics
@@ -26,6 +26,7 @@ namespace Graphics {
 
 class Octree;
 class Palette;
+struct Surface;
 
 /**
  * @brief Class for selecting a good palette from a large number of colors.
@@ -39,6 +40,11 @@ class ColorQuantizer {
 private:
 	Octree *_octree = nullptr;
 
+	// The colors of the last retrieved palette, and a cube mapping colors
+	// with 5 bits per component to their closest entry in it
+	Palette *_palette = nullptr;
+	uint16 *_lookup = nullptr;
+
 public:
 	/**
 	 * @brief Construct a new ColorQuantizer object
@@ -57,12 +63,41 @@ public:
 	 */
 	void addColor(byte r, byte g, byte b);
 
+	/**
+	 * @brief Add all the pixels of a surface to the quantizer
+	 *
+	 * Runs of the same color are added at once, which is a lot faster
+	 * than adding the pixels one by one.
+	 *
+	 * @param surface   the surface, which must not be paletted
+	 */
+	void addSurface(const Surface &surface);
+
 	/**
 	 * @brief Retrieve the resulting palette from the quantizer.
 	 *
 	 * @return A Palette object with at most maxColor entries.
 	 */
 	Palette *getPalette();
+
+	/**
+	 * @brief Find the closest color in the palette last returned by getPalette()
+	 *
+	 * Lookups are cached with 5 bits per component, so they are cheap
+	 * after the first one of each range of colors.
+	 *
+	 * @return the palette index
+	 */
+	byte findBestColor(byte r, byte g, byte b);
+
+	/**
+	 * @brief Convert a surface to the palette last returned by getPalette()
+	 *
+	 * @param surface   the surface, which must not be paletted
+	 *
+	 * @return A new CLUT8 surface, which the caller must free and delete.
+	 */
+	Surface *convertSurface(const Surface &surface);
 };
 
 } // End of namespace Graphics
@@ -0,0 +1,113 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "graphics/decoded_image_cache.h"
+#include "graphics/managed_surface.h"
+
+namespace Graphics {
+
+DecodedImageCache::DecodedImageCache(uint32 maxSize) :
+	_size(0), _maxSize(maxSize), _accessCounter(0) {
+}
+
+DecodedImageCache::~DecodedImageCache() {
+	clear();
+}
+
+DecodedImageCache::ImagePtr DecodedImageCache::get(const Key &key) {
+	Common::StackLock lock(_mutex);
+
+	EntryMap::iterator it = _entries.find(key);
+	if (it == _entries.end())
+		return ImagePtr();
+
+	it->_value.lastAccess = _accessCounter++;
+	return it->_value.image;
+}
+
+DecodedImageCache::ImagePtr DecodedImageCache::store(const Key &key, ManagedSurface *surface) {
+	if (!surface)
+		return ImagePtr();
+
+	Entry entry;
+	entry.image = ImagePtr(surface, Common::kRefCountThreadSafe);
+	entry.size = surface->pitch * surface->h;
+
+	Common::StackLock lock(_mutex);
+
+	EntryMap::iterator it = _entries.find(key);
+	if (it != _entries.end())
+		remove(it);
+
+	if (entry.size <= _maxSize) {
+		while (_size + entry.size > _maxSize && dropOldest()) {
+		}
+
+		entry.lastAccess = _accessCounter++;
+		_entries[key] = entry;
+		_size += entry.size;
+	}
+
+	return entry.image;
+}
+
+void DecodedImageCache::remove(const Key &key) {
+	Common::StackLock lock(_mutex);
+
+	EntryMap::iterator it = _entries.find(key);
+	if (it != _entries.end())
+		remove(it);
+}
+
+void DecodedImageCache::clear() {
+	Common::StackLock lock(_mutex);
+
+	_entries.clear();
+	_size = 0;
+}
+
+uint32 DecodedImageCache::getSize() const {
+	Common::StackLock lock(_mutex);
+
+	return _size;
+}
+
+void DecodedImageCache::remove(EntryMap::iterator it) {
+	_size -= it->_value.size;
+	_entries.erase(it);
+}
+
+bool DecodedImageCache::dropOldest() {
+	EntryMap::iterator oldest = _entries.end();
+	for (EntryMap::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		if (oldest == _entries.end() || it->_value.lastAccess < oldest->_value.lastAccess)
+			oldest = it;
+	}
+
+	if (oldest == _entries.end())
+		return false;
+
+	remove(oldest);
+	return true;
+}
+
+} // End of namespace Graphics
@@ -0,0 +1,129 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef GRAPHICS_DECODED_IMAGE_CACHE_H
+#define GRAPHICS_DECODED_IMAGE_CACHE_H
+
+#include "common/hashmap.h"
+#include "common/mutex.h"
+#include "common/ptr.h"
+#include "common/str.h"
+
+namespace Graphics {
+
+class ManagedSurface;
+
+/**
+ * Memory-budgeted cache of decoded images.
+ *
+ * Engines decoding compressed bitmaps or sprite cels whenever a scene is
+ * entered would otherwise decode the same resources again each time it is
+ * revisited. The cache keeps the decoded surfaces and hands out shared
+ * handles to them, which must be treated as read-only.
+ *
+ * Images are identified by their source, e.g. the name of the archive or
+ * resource file, their resource id or offset in it and an engine defined
+ * format value, to distinguish different decodings of the same data.
+ *
+ * When the budget is exceeded, the least recently used images are dropped.
+ * Handles to a dropped image stay valid, as they share its surface. The
+ * cache may be used from several threads.
+ */
+class DecodedImageCache {
+public:
+	typedef Common::SharedPtr<ManagedSurface> ImagePtr;
+
+	struct Key {
+		Common::String source;
+		uint32 id;
+		uint32 format;
+
+		Key() : id(0), format(0) {}
+		Key(const Common::String &s, uint32 i, uint32 f = 0) : source(s), id(i), format(f) {}
+
+		bool operator==(const Key &other) const {
+			return id == other.id && format == other.format && source == other.source;
+		}
+	};
+
+	/**
+	 * @param maxSize Maximum number of bytes of pixel data to keep.
+	 */
+	explicit DecodedImageCache(uint32 maxSize);
+	~DecodedImageCache();
+
+	/**
+	 * Return the image cached under the given key.
+	 *
+	 * @return A handle to the image, or an empty handle if it is not cached.
+	 */
+	ImagePtr get(const Key &key);
+
+	/**
+	 * Cache the given image and return a handle to it.
+	 *
+	 * Images larger than the budget are not cached, but still returned.
+	 *
+	 * @param key     Key to cache the image under. Replaces a cached image
+	 *                with the same key.
+	 * @param surface Decoded image. The cache takes ownership of it.
+	 * @return A handle to the image.
+	 */
+	ImagePtr store(const Key &key, ManagedSurface *surface);
+
+	/** Drop the image cached under the given key, if any. */
+	void remove(const Key &key);
+
+	/** Drop all cached images. */
+	void clear();
+
+	/** Return the number of bytes used by the cached images. */
+	uint32 getSize() const;
+
+private:
+	struct Entry {
+		ImagePtr image;
+		uint32 size;
+		uint32 lastAccess;
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const {
+			return key.source.hash() ^ (key.id * 2654435761u) ^ (key.format << 16);
+		}
+	};
+
+	typedef Common::HashMap<Key, Entry, KeyHash> EntryMap;
+
+	void remove(EntryMap::iterator it);
+	bool dropOldest();
+
+	mutable Common::Mutex _mutex;
+	EntryMap _entries;
+	uint32 _size;
+	uint32 _maxSize;
+	uint32 _accessCounter;
+};
+
+} // End of namespace Graphics
+
+#endif
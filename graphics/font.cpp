@@ -511,6 +511,28 @@ int Font::wordWrapText(const Common::U32String &str, int maxWidth, Common::Array
 	return wordWrapTextImpl(*this, str, maxWidth, lines, lineContinuation, initWidth, mode);
 }
 
+int WordWrapCache::wordWrapText(const Font &font, const Common::U32String &str, int maxWidth, Common::Array<Common::U32String> &lines, int initWidth, uint32 mode) {
+	Common::HashMap<Common::U32String, Entry>::iterator i = _entries.find(str);
+	Entry *entry = i != _entries.end() ? &i->_value : nullptr;
+
+	if (!entry || entry->font != &font || entry->maxWidth != maxWidth || entry->initWidth != initWidth || entry->mode != mode) {
+		if (!entry && _entries.size() >= _maxEntries)
+			_entries.clear();
+
+		entry = &_entries[str];
+		entry->font = &font;
+		entry->maxWidth = maxWidth;
+		entry->initWidth = initWidth;
+		entry->mode = mode;
+		entry->lines.clear();
+		entry->width = font.wordWrapText(str, maxWidth, entry->lines, initWidth, mode);
+	}
+
+	// Like Font::wordWrapText(), add to the lines already there
+	lines.push_back(entry->lines);
+	return entry->width;
+}
+
 TextAlign convertTextAlignH(TextAlign alignH, bool rtl) {
 	switch (alignH) {
 	case kTextAlignStart:
@@ -25,6 +25,8 @@
 #include "common/str.h"
 #include "common/ustr.h"
 #include "common/rect.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
 
 namespace Common {
 template<class T> class Array;
@@ -301,6 +303,41 @@ public:
 	void scaleSingleGlyph(Surface *scaleSurface, int *grayScaleMap, int grayScaleMapSize, int width, int height, int xOffset, int yOffset, int grayLevel, int chr, int srcheight, int srcwidth, float scale) const;
 
 };
+
+/**
+ * A cache of recently wrapped texts, for code which wraps the same texts
+ * each time it draws them.
+ *
+ * Entries are keyed by the text, the font and the wrapping parameters. The
+ * cache doesn't own the fonts, so it must be cleared when one of the fonts
+ * it was used with is deleted. It is emptied whenever it grows past its
+ * size limit.
+ */
+class WordWrapCache {
+public:
+	WordWrapCache(uint maxEntries = 256) : _maxEntries(maxEntries) {}
+
+	/**
+	 * Word-wrap a text like Font::wordWrapText(), reusing the lines of a
+	 * previous call with the same parameters.
+	 */
+	int wordWrapText(const Font &font, const Common::U32String &str, int maxWidth, Common::Array<Common::U32String> &lines, int initWidth = 0, uint32 mode = kWordWrapOnExplicitNewLines);
+
+	void clear() { _entries.clear(); }
+
+private:
+	struct Entry {
+		const Font *font;
+		int maxWidth;
+		int initWidth;
+		uint32 mode;
+		int width;
+		Common::Array<Common::U32String> lines;
+	};
+
+	Common::HashMap<Common::U32String, Entry> _entries;
+	uint _maxEntries;
+};
 /** @} */
 } // End of namespace Graphics
 
@@ -216,6 +216,10 @@ private:
 	FT_Render_Mode _renderMode;
 	bool _hasKerning;
 
+	// Kerning offsets keyed by the glyph slots of the pair
+	typedef Common::HashMap<uint64, int> KerningCache;
+	mutable KerningCache _kerning;
+
 	bool _fakeBold;
 	bool _fakeItalic;
 };
@@ -581,8 +585,14 @@ int TTFFont::getKerningOffset(uint32 left, uint32 right) const {
 	if (!leftGlyph || !rightGlyph)
 		return 0;
 
+	const uint64 pair = ((uint64)leftGlyph << 32) | rightGlyph;
+	KerningCache::const_iterator kerningEntry = _kerning.find(pair);
+	if (kerningEntry != _kerning.end())
+		return kerningEntry->_value;
+
 	FT_Vector kerningVector;
 	FT_Get_Kerning(_face, leftGlyph, rightGlyph, FT_KERNING_DEFAULT, &kerningVector);
+	_kerning[pair] = kerningVector.x / 64;
 	return (kerningVector.x / 64);
 }
 
@@ -625,14 +635,23 @@ static void renderGlyph(uint8 *dstPos, const int dstPitch, const uint8 *srcPos,
 					dstFormat.colorToARGB(*rDst, dA, dR, dG, dB);
 				}
 
-				double sAn = (double)sA / 255.0;
-				double dAn = (double)dA / 255.0;
-				double oAn = sAn + dAn * (1.0 - sAn);
-
-				dR = static_cast<uint8>(sR * sAn + dR * dAn * (1.0 - sAn) / oAn);
-				dG = static_cast<uint8>(sG * sAn + dG * dAn * (1.0 - sAn) / oAn);
-				dB = static_cast<uint8>(sB * sAn + dB * dAn * (1.0 - sAn) / oAn);
-				dA = static_cast<uint8>(oAn * 255.0);
+				if (dA == 255) {
+					// The destination is opaque, which is the common case
+					// and does not need the full alpha compositing.
+					const uint iA = 255 - sA;
+					dR = (sR * sA + dR * iA) / 255;
+					dG = (sG * sA + dG * iA) / 255;
+					dB = (sB * sA + dB * iA) / 255;
+				} else {
+					double sAn = (double)sA / 255.0;
+					double dAn = (double)dA / 255.0;
+					double oAn = sAn + dAn * (1.0 - sAn);
+
+					dR = static_cast<uint8>(sR * sAn + dR * dAn * (1.0 - sAn) / oAn);
+					dG = static_cast<uint8>(sG * sAn + dG * dAn * (1.0 - sAn) / oAn);
+					dB = static_cast<uint8>(sB * sAn + dB * dAn * (1.0 - sAn) / oAn);
+					dA = static_cast<uint8>(oAn * 255.0);
+				}
 
 				*rDst = dstFormat.ARGBToColor(dA, dR, dG, dB);
 			}
@@ -935,7 +954,8 @@ Font *loadTTFFontFromArchive(const Common::String &filename, int size, TTFSizeMo
 		return nullptr;
 	}
 
-	// HACK: We currently assume that ZipArchive always loads the whole file into memory, so we can delete the archive here.
+	// The members of a ZipArchive stay readable after the archive is deleted: small
+	// ones are loaded into memory, and large ones keep a reference to the archive stream.
 	delete archive;
 	return font;
 }
@@ -27,14 +27,15 @@ namespace Graphics {
 
 FrameLimiter::FrameLimiter(OSystem *system, const uint framerate, const bool vsync) :
 		_system(system),
-		_speedLimitMs(0),
+		_framePeriodMicros(0),
+		_nextSwapTime(0),
 		_startFrameTime(0),
-		_lastFrameDurationMs(_speedLimitMs) {
+		_lastFrameDurationMs(0) {
 	// The frame limiter is disabled when vsync is enabled.
 	_enabled = !(vsync && _system->getFeatureState(OSystem::kFeatureVSync)) && (framerate != 0);
 
 	if (_enabled) {
-		_speedLimitMs = 1000 / CLIP<uint>(framerate, 0, 100);
+		_framePeriodMicros = 1000000 / CLIP<uint>(framerate, 1, 1000);
 	}
 }
 
@@ -49,18 +50,31 @@ void FrameLimiter::startFrame() {
 }
 
 void FrameLimiter::delayBeforeSwap() {
-	uint endFrameTime = _system->getMillis();
-	uint frameDuration = endFrameTime - _startFrameTime;
+	if (!_enabled)
+		return;
 
-	if (_enabled && frameDuration < _speedLimitMs) {
-		_system->delayMillis(_speedLimitMs - frameDuration);
+	uint64 currentTime = (uint64)_system->getMillis() * 1000;
+
+	// Start over instead of rushing frames when we fell behind by more than
+	// a frame, and when the clock does not match the schedule anymore
+	if (_nextSwapTime == 0 || currentTime > _nextSwapTime + _framePeriodMicros ||
+			_nextSwapTime > currentTime + _framePeriodMicros) {
+		_nextSwapTime = currentTime;
+	} else if (currentTime < _nextSwapTime) {
+		// The sub-millisecond remainder is carried over to the next deadline
+		uint delay = (uint)((_nextSwapTime - currentTime + 500) / 1000);
+		if (delay > 0)
+			_system->delayMillis(delay);
 	}
+
+	_nextSwapTime += _framePeriodMicros;
 }
 
 void FrameLimiter::pause(bool pause) {
 	if (!pause) {
 		// Make sure the frame duration value is consistent when resuming
 		_startFrameTime = 0;
+		_nextSwapTime = 0;
 	}
 }
 
@@ -33,6 +33,10 @@ namespace Graphics {
  * by delaying until all of the timeslot allocated to the frame
  * is consumed.
  * Allows to curb CPU usage and have a stable framerate.
+ *
+ * Frames are scheduled against deadlines spaced by the exact frame
+ * period in microseconds, so rates which do not divide a second into
+ * whole milliseconds (such as 60 fps) are met on average.
  */
 class FrameLimiter {
 public:
@@ -48,7 +52,8 @@ private:
 	OSystem *_system;
 
 	bool _enabled;
-	uint _speedLimitMs;
+	uint _framePeriodMicros;
+	uint64 _nextSwapTime; // in microseconds, 0 when not scheduled yet
 	uint _startFrameTime;
 	uint _lastFrameDurationMs;
 };
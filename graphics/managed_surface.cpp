@@ -24,6 +24,7 @@
 #include "graphics/palette.h"
 #include "graphics/transform_tools.h"
 #include "common/algorithm.h"
+#include "common/profiler.h"
 #include "common/textconsole.h"
 #include "common/endian.h"
 
@@ -34,13 +35,15 @@ const int SCALE_THRESHOLD = 0x100;
 ManagedSurface::ManagedSurface() :
 		w(_innerSurface.w), h(_innerSurface.h), pitch(_innerSurface.pitch), format(_innerSurface.format),
 		_disposeAfterUse(DisposeAfterUse::NO), _owner(nullptr),
-		_transparentColor(0),_transparentColorSet(false), _palette(nullptr) {
+		_transparentColor(0),_transparentColorSet(false), _palette(nullptr),
+		_contentVersion(0), _paletteVersion(0), _conversionCache(nullptr) {
 }
 
 ManagedSurface::ManagedSurface(const ManagedSurface &surf) :
 		w(_innerSurface.w), h(_innerSurface.h), pitch(_innerSurface.pitch), format(_innerSurface.format),
 		_disposeAfterUse(DisposeAfterUse::NO), _owner(nullptr),
-		_transparentColor(0), _transparentColorSet(false), _palette(nullptr) {
+		_transparentColor(0), _transparentColorSet(false), _palette(nullptr),
+		_contentVersion(0), _paletteVersion(0), _conversionCache(nullptr) {
 	*this = surf;
 }
 
@@ -48,7 +51,8 @@ ManagedSurface::ManagedSurface(ManagedSurface &&surf) :
 		w(_innerSurface.w), h(_innerSurface.h), pitch(_innerSurface.pitch), format(_innerSurface.format),
 		_disposeAfterUse(surf._disposeAfterUse), _owner(surf._owner), _offsetFromOwner(surf._offsetFromOwner),
 		_transparentColor(surf._transparentColor), _transparentColorSet(surf._transparentColorSet),
-		_palette(surf._palette) {
+		_palette(surf._palette), _contentVersion(surf._contentVersion), _paletteVersion(surf._paletteVersion),
+		_conversionCache(surf._conversionCache) {
 
 	_innerSurface.setPixels(surf.getPixels());
 	_innerSurface.w = surf.w;
@@ -64,31 +68,36 @@ ManagedSurface::ManagedSurface(ManagedSurface &&surf) :
 	surf._transparentColor = 0;
 	surf._transparentColorSet = false;
 	surf._palette = nullptr;
+	surf._conversionCache = nullptr;
 }
 
 ManagedSurface::ManagedSurface(int width, int height) :
 		w(_innerSurface.w), h(_innerSurface.h), pitch(_innerSurface.pitch), format(_innerSurface.format),
 		_disposeAfterUse(DisposeAfterUse::NO), _owner(nullptr),
-		_transparentColor(0), _transparentColorSet(false), _palette(nullptr) {
+		_transparentColor(0), _transparentColorSet(false), _palette(nullptr),
+		_contentVersion(0), _paletteVersion(0), _conversionCache(nullptr) {
 	create(width, height);
 }
 
 ManagedSurface::ManagedSurface(int width, int height, const Graphics::PixelFormat &pixelFormat) :
 		w(_innerSurface.w), h(_innerSurface.h), pitch(_innerSurface.pitch), format(_innerSurface.format),
 		_disposeAfterUse(DisposeAfterUse::NO), _owner(nullptr),
-		_transparentColor(0), _transparentColorSet(false), _palette(nullptr) {
+		_transparentColor(0), _transparentColorSet(false), _palette(nullptr),
+		_contentVersion(0), _paletteVersion(0), _conversionCache(nullptr) {
 	create(width, height, pixelFormat);
 }
 
 ManagedSurface::ManagedSurface(ManagedSurface &surf, const Common::Rect &bounds) :
 		w(_innerSurface.w), h(_innerSurface.h), pitch(_innerSurface.pitch), format(_innerSurface.format),
 		_disposeAfterUse(DisposeAfterUse::NO), _owner(nullptr),
-		_transparentColor(0), _transparentColorSet(false), _palette(nullptr) {
+		_transparentColor(0), _transparentColorSet(false), _palette(nullptr),
+		_contentVersion(0), _paletteVersion(0), _conversionCache(nullptr) {
 	create(surf, bounds);
 }
 
 ManagedSurface::~ManagedSurface() {
 	free();
+	delete _conversionCache;
 }
 
 ManagedSurface &ManagedSurface::operator=(const ManagedSurface &surf) {
@@ -139,6 +148,12 @@ ManagedSurface &ManagedSurface::operator=(ManagedSurface &&surf) {
 	_transparentColor = surf._transparentColor;
 	_palette = surf._palette;
 
+	// Take over the converted copies, ours were already emptied by free()
+	delete _conversionCache;
+	_conversionCache = surf._conversionCache;
+	_contentVersion = surf._contentVersion;
+	_paletteVersion = surf._paletteVersion;
+
 	// Reset the old surface
 	surf._innerSurface.init(0, 0, 0, NULL, PixelFormat());
 	surf._disposeAfterUse = DisposeAfterUse::NO;
@@ -147,6 +162,7 @@ ManagedSurface &ManagedSurface::operator=(ManagedSurface &&surf) {
 	surf._transparentColor = 0;
 	surf._transparentColorSet = false;
 	surf._palette = nullptr;
+	surf._conversionCache = nullptr;
 
 	return *this;
 }
@@ -206,6 +222,10 @@ void ManagedSurface::free() {
 		delete _palette;
 		_palette = nullptr;
 	}
+
+	freeConversionCache();
+	invalidateConversionCache();
+	_paletteVersion++;
 }
 
 void ManagedSurface::copyFrom(const ManagedSurface &surf) {
@@ -386,7 +406,7 @@ void ManagedSurface::simpleBlitFromInner(const Surface &src, const Common::Rect
 		}
 	}
 
-	addDirtyRect(dstRectC);
+	markDirty(dstRectC);
 }
 
 void ManagedSurface::maskBlitFrom(const Surface &src, const Surface &mask, const Palette *srcPalette) {
@@ -448,7 +468,7 @@ void ManagedSurface::maskBlitFromInner(const Surface &src, const Surface &mask,
 			format, src.format);
 	}
 
-	addDirtyRect(dstRectC);
+	markDirty(dstRectC);
 }
 
 void ManagedSurface::blitFrom(const Surface &src, const Palette *srcPalette) {
@@ -497,6 +517,7 @@ void ManagedSurface::blitFrom(const ManagedSurface &src, const Common::Rect &src
 
 void ManagedSurface::blitFromInner(const Surface &src, const Common::Rect &srcRect,
 		const Common::Rect &destRect, const Palette *srcPalette) {
+	PROFILE_ZONE("ManagedSurface::blitFrom");
 
 	if (destRect.isEmpty())
 		return;
@@ -648,7 +669,7 @@ void ManagedSurface::blitFromInner(const Surface &src, const Common::Rect &srcRe
 		}
 	}
 
-	addDirtyRect(destRect);
+	markDirty(destRect);
 }
 
 void ManagedSurface::transBlitFrom(const Surface &src, uint32 transColor, bool flipped,
@@ -871,6 +892,8 @@ void transBlit(const Surface &src, const Common::Rect &srcRect, ManagedSurface &
 void ManagedSurface::transBlitFromInner(const Surface &src, const Common::Rect &srcRect,
 		const Common::Rect &destRect, uint32 transColor, bool flipped,
 		uint32 srcAlpha, const Palette *srcPalette, const Palette *dstPalette) {
+	PROFILE_ZONE("ManagedSurface::transBlitFrom");
+
 	if (src.w == 0 || src.h == 0 || destRect.width() == 0 || destRect.height() == 0)
 		return;
 
@@ -886,7 +909,7 @@ void ManagedSurface::transBlitFromInner(const Surface &src, const Common::Rect &
 	error("Surface::transBlitFrom: bytesPerPixel must be 1, 2, or 4");
 
 	// Mark the affected area
-	addDirtyRect(destRect);
+	markDirty(destRect);
 }
 
 #undef HANDLE_BLIT
@@ -898,7 +921,8 @@ Common::Rect ManagedSurface::blendBlitTo(ManagedSurface &target,
 										 const uint colorMod,
 										 const int width, const int height,
 										 const TSpriteBlendMode blend,
-										 const AlphaType alphaType) {
+										 const AlphaType alphaType) const {
+	target.invalidateConversionCache();
 	return blendBlitTo(*target.surfacePtr(), posX, posY, flipping, srcRect, colorMod, width, height, blend, alphaType);
 }
 Common::Rect ManagedSurface::blendBlitTo(Surface &target,
@@ -908,7 +932,7 @@ Common::Rect ManagedSurface::blendBlitTo(Surface &target,
 										 const uint colorMod,
 										 const int width, const int height,
 										 const TSpriteBlendMode blend,
-										 const AlphaType alphaType) {
+										 const AlphaType alphaType) const {
 	Common::Rect srcArea = srcRect ? *srcRect : Common::Rect(0, 0, w, h);
 	Common::Rect dstArea(posX, posY, posX + (width == -1 ? srcArea.width() : width), posY + (height == -1 ? srcArea.height() : height));
 	
@@ -978,15 +1002,17 @@ Common::Rect ManagedSurface::blendBlitTo(Surface &target,
 }
 
 void ManagedSurface::markAllDirty() {
-	addDirtyRect(Common::Rect(0, 0, this->w, this->h));
+	markDirty(Common::Rect(0, 0, this->w, this->h));
 }
 
 void ManagedSurface::addDirtyRect(const Common::Rect &r) {
+	invalidateConversionCache();
+
 	if (_owner) {
 		Common::Rect bounds = r;
 		bounds.clip(Common::Rect(0, 0, this->w, this->h));
 		bounds.translate(_offsetFromOwner.x, _offsetFromOwner.y);
-		_owner->addDirtyRect(bounds);
+		_owner->markDirty(bounds);
 	}
 }
 
@@ -1000,6 +1026,7 @@ void ManagedSurface::clearPalette() {
 		delete _palette;
 		_palette = nullptr;
 	}
+	_paletteVersion++;
 }
 
 bool ManagedSurface::hasPalette() const {
@@ -1015,9 +1042,96 @@ void ManagedSurface::setPalette(const byte *colors, uint start, uint num) {
 	if (!_palette)
 		_palette = new Palette(256);
 	_palette->set(colors, start, num);
+	_paletteVersion++;
 
 	if (_owner)
 		_owner->setPalette(colors, start, num);
 }
 
+void ManagedSurface::setConversionCacheEnabled(bool enable) {
+	if (enable && !_conversionCache) {
+		_conversionCache = new Common::Array<ConvertedCopy>();
+	} else if (!enable && _conversionCache) {
+		freeConversionCache();
+		delete _conversionCache;
+		_conversionCache = nullptr;
+	}
+}
+
+void ManagedSurface::freeConversionCache() {
+	if (!_conversionCache)
+		return;
+
+	for (uint i = 0; i < _conversionCache->size(); i++)
+		delete (*_conversionCache)[i].surface;
+	_conversionCache->clear();
+}
+
+const ManagedSurface *ManagedSurface::getConverted(const PixelFormat &fmt) {
+	if (fmt == format)
+		return this;
+
+	if (!_conversionCache || empty() || fmt.isCLUT8() || (format.isCLUT8() && !hasPalette()))
+		return nullptr;
+
+	ConvertedCopy *copy = nullptr;
+	for (uint i = 0; i < _conversionCache->size(); i++) {
+		if ((*_conversionCache)[i].format == fmt) {
+			copy = &(*_conversionCache)[i];
+			break;
+		}
+	}
+
+	if (!copy) {
+		ConvertedCopy newCopy;
+		newCopy.format = fmt;
+		// Outdated from the start, so that it gets built below
+		newCopy.contentVersion = _contentVersion - 1;
+		newCopy.paletteVersion = _paletteVersion;
+		newCopy.surface = new ManagedSurface();
+		_conversionCache->push_back(newCopy);
+		copy = &_conversionCache->back();
+	}
+
+	// The palette only matters for CLUT8 surfaces
+	if (copy->contentVersion == _contentVersion && (!format.isCLUT8() || copy->paletteVersion == _paletteVersion))
+		return copy->surface;
+
+	ManagedSurface *dst = copy->surface;
+	if (dst->w != w || dst->h != h)
+		dst->create(w, h, fmt);
+
+	if (format.isCLUT8()) {
+		uint32 map[256];
+		memset(map, 0, sizeof(map));
+		convertPaletteToMap(map, _palette->data(), MIN<uint>(_palette->size(), 256), fmt);
+
+		dst->clearTransparentColor();
+		if (_transparentColorSet && _transparentColor < 256) {
+			if (fmt.aBits() != 0) {
+				map[_transparentColor] &= ~fmt.ARGBToColor(255, 0, 0, 0);
+			} else {
+				dst->setTransparentColor(map[_transparentColor]);
+			}
+		}
+
+		crossBlitMap((byte *)dst->getPixels(), (const byte *)getPixels(), dst->pitch, pitch, w, h,
+			fmt.bytesPerPixel, map);
+	} else {
+		dst->clearTransparentColor();
+		if (_transparentColorSet) {
+			uint8 a, r, g, b;
+			format.colorToARGB(_transparentColor, a, r, g, b);
+			dst->setTransparentColor(fmt.ARGBToColor(a, r, g, b));
+		}
+
+		crossBlit((byte *)dst->getPixels(), (const byte *)getPixels(), dst->pitch, pitch, w, h,
+			fmt, format);
+	}
+
+	copy->contentVersion = _contentVersion;
+	copy->paletteVersion = _paletteVersion;
+	return dst;
+}
+
 } // End of namespace Graphics
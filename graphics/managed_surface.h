@@ -25,6 +25,7 @@
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 #include "graphics/transform_struct.h"
+#include "common/array.h"
 #include "common/types.h"
 #include "graphics/blit.h"
 
@@ -84,6 +85,42 @@ private:
 	 * Local palette for 8-bit images.
 	 */
 	Palette *_palette;
+
+	/**
+	 * Counters bumped whenever the pixels or the palette change, so that
+	 * outdated converted copies can be detected.
+	 */
+	uint32 _contentVersion;
+	uint32 _paletteVersion;
+
+	/**
+	 * Copy of the surface in another pixel format, built by getConverted().
+	 */
+	struct ConvertedCopy {
+		PixelFormat format;
+		uint32 contentVersion;
+		uint32 paletteVersion;
+		ManagedSurface *surface;
+	};
+
+	/**
+	 * Converted copies of the surface, or nullptr if the conversion cache
+	 * is disabled.
+	 */
+	Common::Array<ConvertedCopy> *_conversionCache;
+
+	/**
+	 * Record a write to the pixels, then hand the area to addDirtyRect().
+	 */
+	void markDirty(const Common::Rect &r) {
+		invalidateConversionCache();
+		addDirtyRect(r);
+	}
+
+	/**
+	 * Delete all the converted copies.
+	 */
+	void freeConversionCache();
 protected:
 	/**
 	 * Inner method for blitting.
@@ -227,6 +264,7 @@ public:
 	 * @param pixel The value of the pixel.
 	 */
 	inline void setPixel(int x, int y, uint32 pixel) {
+		invalidateConversionCache();
 		return _innerSurface.setPixel(x, y, pixel);
 	}
 
@@ -581,7 +619,7 @@ public:
 							 const uint colorMod = MS_ARGB(255, 255, 255, 255),
 							 const int width = -1, const int height = -1,
 							 const TSpriteBlendMode blend = BLEND_NORMAL,
-							 const AlphaType alphaType = ALPHA_FULL);
+							 const AlphaType alphaType = ALPHA_FULL) const;
 	Common::Rect blendBlitTo(Surface &target,
 							 const int posX = 0, const int posY = 0,
 							 const int flipping = FLIP_NONE,
@@ -589,7 +627,7 @@ public:
 							 const uint colorMod = MS_ARGB(255, 255, 255, 255),
 							 const int width = -1, const int height = -1,
 							 const TSpriteBlendMode blend = BLEND_NORMAL,
-							 const AlphaType alphaType = ALPHA_FULL);
+							 const AlphaType alphaType = ALPHA_FULL) const;
 
 	/**
 	 * Clear the entire surface.
@@ -608,7 +646,7 @@ public:
 	 */
 	void copyRectToSurface(const void *buffer, int srcPitch, int destX, int destY, int width, int height) {
 		_innerSurface.copyRectToSurface(buffer, srcPitch, destX, destY, width, height);
-		addDirtyRect(Common::Rect(destX, destY, destX + width, destY + height));
+		markDirty(Common::Rect(destX, destY, destX + width, destY + height));
 	}
 
 	/**
@@ -618,7 +656,7 @@ public:
 	 */
 	void copyRectToSurface(const Graphics::Surface &srcSurface, int destX, int destY, const Common::Rect subRect) {
 		_innerSurface.copyRectToSurface(srcSurface, destX, destY, subRect);
-		addDirtyRect(Common::Rect(destX, destY, destX + subRect.width(), destY + subRect.height()));
+		markDirty(Common::Rect(destX, destY, destX + subRect.width(), destY + subRect.height()));
 	}
 
 	/**
@@ -628,7 +666,7 @@ public:
 	 */
 	void copyRectToSurfaceWithKey(const void *buffer, int srcPitch, int destX, int destY, int width, int height, uint32 key) {
 		_innerSurface.copyRectToSurfaceWithKey(buffer, srcPitch, destX, destY, width, height, key);
-		addDirtyRect(Common::Rect(destX, destY, destX + width, destY + height));
+		markDirty(Common::Rect(destX, destY, destX + width, destY + height));
 	}
 
 	/**
@@ -638,7 +676,7 @@ public:
 	 */
 	void copyRectToSurfaceWithKey(const Graphics::Surface &srcSurface, int destX, int destY, const Common::Rect subRect, uint32 key) {
 		_innerSurface.copyRectToSurfaceWithKey(srcSurface, destX, destY, subRect, key);
-		addDirtyRect(Common::Rect(destX, destY, destX + subRect.width(), destY + subRect.height()));
+		markDirty(Common::Rect(destX, destY, destX + subRect.width(), destY + subRect.height()));
 	}
 
 	/**
@@ -691,7 +729,7 @@ public:
 	 */
 	void drawLine(int x0, int y0, int x1, int y1, uint32 color) {
 		_innerSurface.drawLine(x0, y0, x1, y1, color);
-		addDirtyRect(Common::Rect(MIN(x0, x1), MIN(y0, y1), MAX(x0, x1 + 1), MAX(y0, y1 + 1)));
+		markDirty(Common::Rect(MIN(x0, x1), MIN(y0, y1), MAX(x0, x1 + 1), MAX(y0, y1 + 1)));
 	}
 
 	/**
@@ -699,7 +737,7 @@ public:
 	 */
 	void drawThickLine(int x0, int y0, int x1, int y1, int penX, int penY, uint32 color) {
 		_innerSurface.drawThickLine(x0, y0, x1, y1, penX, penY, color);
-		addDirtyRect(Common::Rect(MIN(x0, x1 + penX), MIN(y0, y1 + penY), MAX(x0, x1 + penX), MAX(y0, y1 + penY)));
+		markDirty(Common::Rect(MIN(x0, x1 + penX), MIN(y0, y1 + penY), MAX(x0, x1 + penX), MAX(y0, y1 + penY)));
 	}
 
 	/**
@@ -707,7 +745,7 @@ public:
 	 */
 	void drawRoundRect(const Common::Rect &rect, int arc, uint32 color, bool filled) {
 		_innerSurface.drawRoundRect(rect, arc, color, filled);
-		addDirtyRect(rect);
+		markDirty(rect);
 	}
 
 	/**
@@ -715,7 +753,7 @@ public:
 	 */
 	void drawPolygonScan(const int *polyX, const int *polyY, int npoints, const Common::Rect &bbox, uint32 color) {
 		_innerSurface.drawPolygonScan(polyX, polyY, npoints, bbox, color);
-		addDirtyRect(bbox);
+		markDirty(bbox);
 	}
 
 	/**
@@ -723,7 +761,7 @@ public:
 	 */
 	void drawEllipse(int x0, int y0, int x1, int y1, uint32 color, bool filled) {
 		_innerSurface.drawEllipse(x0, y0, x1, y1, color, filled);
-		addDirtyRect(Common::Rect(MIN(x0, x1), MIN(y0, y1), MAX(x0, x1 + 1), MAX(y0, y1 + 1)));
+		markDirty(Common::Rect(MIN(x0, x1), MIN(y0, y1), MAX(x0, x1 + 1), MAX(y0, y1 + 1)));
 	}
 
 	/**
@@ -731,7 +769,7 @@ public:
 	 */
 	void hLine(int x, int y, int x2, uint32 color) {
 		_innerSurface.hLine(x, y, x2, color);
-		addDirtyRect(Common::Rect(x, y, x2 + 1, y + 1));
+		markDirty(Common::Rect(x, y, x2 + 1, y + 1));
 	}
 
 	/**
@@ -739,7 +777,7 @@ public:
 	 */
 	void vLine(int x, int y, int y2, uint32 color) {
 		_innerSurface.vLine(x, y, y2, color);
-		addDirtyRect(Common::Rect(x, y, x + 1, y2 + 1));
+		markDirty(Common::Rect(x, y, x + 1, y2 + 1));
 	}
 
 	/**
@@ -747,7 +785,7 @@ public:
 	 */
 	void fillRect(const Common::Rect &r, uint32 color) {
 		_innerSurface.fillRect(r, color);
-		addDirtyRect(r);
+		markDirty(r);
 	}
 
 	/**
@@ -755,7 +793,7 @@ public:
 	 */
 	void frameRect(const Common::Rect &r, uint32 color) {
 		_innerSurface.frameRect(r, color);
-		addDirtyRect(r);
+		markDirty(r);
 	}
 
 	/**
@@ -770,7 +808,7 @@ public:
 	 * for the retrieved area.
 	 */
 	Surface getSubArea(const Common::Rect &area) {
-		addDirtyRect(area);
+		markDirty(area);
 		return _innerSurface.getSubArea(area);
 	}
 
@@ -785,6 +823,7 @@ public:
 	 */
 	void convertToInPlace(const PixelFormat &dstFormat) {
 		_innerSurface.convertToInPlace(dstFormat);
+		invalidateConversionCache();
 	}
 
 	/**
@@ -800,6 +839,7 @@ public:
 	 */
 	void convertToInPlace(const PixelFormat &dstFormat, const byte *palette, uint16 paletteCount) {
 		_innerSurface.convertToInPlace(dstFormat, palette, paletteCount);
+		invalidateConversionCache();
 	}
 
 	/**
@@ -848,6 +888,48 @@ public:
 	 * Set the palette using RGB tuples.
 	 */
 	void setPalette(const byte *colors, uint start, uint num);
+
+	/**
+	 * Enable or disable keeping converted copies of the surface, see
+	 * getConverted(). Disabling the cache frees all the copies.
+	 */
+	void setConversionCacheEnabled(bool enable);
+
+	/**
+	 * Return true if converted copies of the surface are kept.
+	 */
+	bool isConversionCacheEnabled() const { return _conversionCache != nullptr; }
+
+	/**
+	 * Return a copy of the surface in the specified format, e.g. for drawing
+	 * a CLUT8 sprite to a true color screen every frame without converting
+	 * it each time.
+	 *
+	 * A copy is only rebuilt when the surface or its palette have changed
+	 * since it was last requested. Writes through the drawing methods,
+	 * setPixel() and addDirtyRect() are noticed automatically. After writing
+	 * through getPixels() or getBasePtr() without reporting a dirty area,
+	 * call invalidateConversionCache().
+	 *
+	 * If a color key is set, it is converted as well. For CLUT8 surfaces
+	 * converted to a format with alpha, the key becomes fully transparent
+	 * instead.
+	 *
+	 * @param fmt  The desired format.
+	 *
+	 * @return The surface itself if it already has the desired format. The
+	 *         copy, which stays valid until the cache is disabled or the
+	 *         surface is freed. nullptr if the cache is disabled, or if the
+	 *         surface can't be converted to a CLUT8 format or without a
+	 *         palette.
+	 */
+	const ManagedSurface *getConverted(const PixelFormat &fmt);
+
+	/**
+	 * Mark all the converted copies as outdated, so that they get rebuilt
+	 * the next time they are requested.
+	 */
+	void invalidateConversionCache() { _contentVersion++; }
 };
 /** @} */
 } // End of namespace Graphics
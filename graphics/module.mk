@@ -6,8 +6,10 @@ MODULE_OBJS := \
 	blit/blit-alpha.o \
 	blit/blit-generic.o \
 	blit/blit-scale.o \
+	blit_batch.o \
 	color_quantizer.o \
 	cursorman.o \
+	decoded_image_cache.o \
 	font.o \
 	fontman.o \
 	fonts/amigafont.o \
@@ -46,6 +48,7 @@ MODULE_OBJS := \
 	opengl/shader.o \
 	opengl/texture.o \
 	palette.o \
+	panorama_warper.o \
 	pixelformat.o \
 	pm5544.o \
 	primitives.o \
@@ -97,6 +100,15 @@ MODULE_OBJS += \
 	tinygl/ztriangle.o \
 	tinygl/zblit.o \
 	tinygl/zdirtyrect.o
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	tinygl/ztriangle-neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	tinygl/ztriangle-sse2.o
+endif
 endif
 
 ifdef USE_ASPECT
@@ -124,6 +136,15 @@ ifdef USE_HQ_SCALERS
 MODULE_OBJS += \
 	scaler/hq.o
 
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	scaler/hq-neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	scaler/hq-sse2.o
+endif
+
 ifdef USE_NASM
 MODULE_OBJS += \
 	scaler/hq2x_i386.o \
@@ -146,15 +167,22 @@ endif
 
 ifdef SCUMMVM_NEON
 MODULE_OBJS += \
-	blit/blit-neon.o
+	blit/blit-neon.o \
+	yuv_to_rgb-neon.o
 endif
 ifdef SCUMMVM_SSE2
 MODULE_OBJS += \
-	blit/blit-sse2.o
+	blit/blit-sse2.o \
+	yuv_to_rgb-sse2.o
 endif
 ifdef SCUMMVM_AVX2
 MODULE_OBJS += \
-	blit/blit-avx2.o
+	blit/blit-avx2.o \
+	yuv_to_rgb-avx2.o
+endif
+ifdef SCUMMVM_AVX512
+MODULE_OBJS += \
+	blit/blit-avx512.o
 endif
 
 # Include common rules
@@ -73,11 +73,14 @@ void Context::reset() {
 	packedPixelsSupported = false;
 	packedDepthStencilSupported = false;
 	unpackSubImageSupported = false;
+	pixelBufferObjectSupported = false;
+	mapBufferRangeSupported = false;
 	OESDepth24 = false;
 	textureEdgeClampSupported = false;
 	textureBorderClampSupported = false;
 	textureMirrorRepeatSupported = false;
 	textureMaxLevelSupported = false;
+	programBinarySupported = false;
 }
 
 void Context::initialize(ContextType contextType) {
@@ -167,6 +170,7 @@ void Context::initialize(ContextType contextType) {
 
 	bool EXTFramebufferMultisample = false;
 	bool EXTFramebufferBlit = false;
+	bool OESGetProgramBinary = false;
 
 	Common::StringTokenizer tokenizer(extString, " ");
 	while (!tokenizer.empty()) {
@@ -184,6 +188,8 @@ void Context::initialize(ContextType contextType) {
 			packedDepthStencilSupported = true;
 		} else if (token == "GL_EXT_unpack_subimage") {
 			unpackSubImageSupported = true;
+		} else if (token == "GL_ARB_pixel_buffer_object") {
+			pixelBufferObjectSupported = true;
 		} else if (token == "GL_EXT_framebuffer_multisample") {
 			EXTFramebufferMultisample = true;
 		} else if (token == "GL_EXT_framebuffer_blit") {
@@ -199,6 +205,8 @@ void Context::initialize(ContextType contextType) {
 			textureMirrorRepeatSupported = true;
 		} else if (token == "GL_SGIS_texture_lod" || token == "GL_APPLE_texture_max_level") {
 			textureMaxLevelSupported = true;
+		} else if (token == "GL_OES_get_program_binary") {
+			OESGetProgramBinary = true;
 		}
 	}
 
@@ -234,12 +242,23 @@ void Context::initialize(ContextType contextType) {
 			packedDepthStencilSupported = true;
 			textureMaxLevelSupported = true;
 			unpackSubImageSupported = true;
+			pixelBufferObjectSupported = true;
+			mapBufferRangeSupported = true;
 			OESDepth24 = true;
 		}
 		// OpenGL ES 3.2 and later always has texture border clamp support
 		if (isGLVersionOrHigher(3, 2)) {
 			textureBorderClampSupported = true;
 		}
+		// OpenGL ES 3.0 and later can retrieve program binaries, but the
+		// driver may still not offer any format to store them in
+		if (isGLVersionOrHigher(3, 0) || OESGetProgramBinary) {
+#ifdef USE_GLAD
+			GLint binaryFormats = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormats);
+			programBinarySupported = binaryFormats > 0;
+#endif
+		}
 		debug(5, "OpenGL: GLES2 context initialized");
 	} else if (type == kContextGLES) {
 		// GLES doesn't support shaders natively
@@ -280,6 +299,14 @@ void Context::initialize(ContextType contextType) {
 		if (isGLVersionOrHigher(1, 4)) {
 			textureMirrorRepeatSupported = true;
 		}
+		// OpenGL 2.1 adds pixel buffer objects
+		if (isGLVersionOrHigher(2, 1)) {
+			pixelBufferObjectSupported = true;
+		}
+		// OpenGL 3.0 adds mapping buffer ranges
+		if (isGLVersionOrHigher(3, 0)) {
+			mapBufferRangeSupported = true;
+		}
 		debug(5, "OpenGL: GL context initialized");
 	} else {
 		warning("OpenGL: Unknown context initialized");
@@ -309,11 +336,14 @@ void Context::initialize(ContextType contextType) {
 	debug(5, "OpenGL: Packed pixels support: %d", packedPixelsSupported);
 	debug(5, "OpenGL: Packed depth stencil support: %d", packedDepthStencilSupported);
 	debug(5, "OpenGL: Unpack subimage support: %d", unpackSubImageSupported);
+	debug(5, "OpenGL: Pixel buffer object support: %d", pixelBufferObjectSupported);
+	debug(5, "OpenGL: Map buffer range support: %d", mapBufferRangeSupported);
 	debug(5, "OpenGL: OpenGL ES depth 24 support: %d", OESDepth24);
 	debug(5, "OpenGL: Texture edge clamping support: %d", textureEdgeClampSupported);
 	debug(5, "OpenGL: Texture border clamping support: %d", textureBorderClampSupported);
 	debug(5, "OpenGL: Texture mirror repeat support: %d", textureMirrorRepeatSupported);
 	debug(5, "OpenGL: Texture max level support: %d", textureMaxLevelSupported);
+	debug(5, "OpenGL: Program binary support: %d", programBinarySupported);
 }
 
 int Context::getGLSLVersion() const {
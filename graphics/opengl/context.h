@@ -105,6 +105,12 @@ public:
 	/** Whether specifying a pitch when uploading to textures is available or not */
 	bool unpackSubImageSupported;
 
+	/** Whether pixel buffer objects can be used as a texture upload source or not. */
+	bool pixelBufferObjectSupported;
+
+	/** Whether glMapBufferRange is available or not. */
+	bool mapBufferRangeSupported;
+
 	/** Whether depth component 24 is supported or not */
 	bool OESDepth24;
 
@@ -120,6 +126,9 @@ public:
 	/** Whether texture max level is available or not. */
 	bool textureMaxLevelSupported;
 
+	/** Whether linked programs can be retrieved and loaded back as binaries or not. */
+	bool programBinarySupported;
+
 private:
 	/**
 	 * Returns the native GLSL version supported by the driver.
@@ -21,6 +21,9 @@
 
 #include "common/scummsys.h"
 #include "common/config-manager.h"
+#include "common/debug.h"
+#include "common/savefile.h"
+#include "common/system.h"
 
 #include "graphics/opengl/system_headers.h"
 
@@ -216,20 +219,54 @@ GLuint Shader::createCompatShader(const char *shaderSource, GLenum shaderType, c
 	return shader;
 }
 
-GLuint Shader::loadShaderFromFile(const char *base, const char *extension, GLenum shaderType, int compatGLSLVersion) {
-	const Common::String filename = Common::String(base) + "." + extension;
-	const GLchar *shaderSource = readFile(filename);
+/**
+ * Continues a 64-bit FNV-1a hash with the given strings.
+ */
+static uint64 hashStrings(uint64 hash, size_t count, const char *const *strings) {
+	for (size_t i = 0; i < count; ++i) {
+		for (const char *c = strings[i]; c && *c; ++c) {
+			hash ^= (byte)*c;
+			hash *= 1099511628211ULL;
+		}
+	}
+	return hash;
+}
 
-	GLuint shader;
-	if (compatGLSLVersion) {
-		shader = createCompatShader(shaderSource, shaderType, filename, compatGLSLVersion);
-	} else {
-		shader = createDirectShader(1, &shaderSource, shaderType, filename);
+/**
+ * Computes the key under which the binary of a program is cached, or 0 when
+ * program binaries can't be used.
+ *
+ * Binaries are only valid for the driver which created them, so it is part
+ * of the key along with all the sources and the attribute bindings.
+ */
+static uint64 programCacheKey(size_t vertexCount, const char *const *vertex,
+		size_t fragmentCount, const char *const *fragment, const char *const *attributes) {
+	if (!OpenGLContext.programBinarySupported)
+		return 0;
+
+	static const char *const separator = "\xff";
+	const char *const driver[] = {
+		(const char *)glGetString(GL_VENDOR),
+		(const char *)glGetString(GL_RENDERER),
+		(const char *)glGetString(GL_VERSION)
+	};
+
+	uint64 hash = 14695981039346656037ULL;
+	hash = hashStrings(hash, ARRAYSIZE(driver), driver);
+	hash = hashStrings(hash, 1, &separator);
+	hash = hashStrings(hash, vertexCount, vertex);
+	hash = hashStrings(hash, 1, &separator);
+	hash = hashStrings(hash, fragmentCount, fragment);
+	for (int idx = 0; attributes[idx]; ++idx) {
+		hash = hashStrings(hash, 1, &separator);
+		hash = hashStrings(hash, 1, &attributes[idx]);
 	}
 
-	delete[] shaderSource;
+	return hash ? hash : 1;
+}
 
-	return shader;
+static Common::String programCacheFileName(uint64 key) {
+	return Common::String::format("glprogram-%08x%08x.bin", (uint32)(key >> 32), (uint32)key);
 }
 
 /**
@@ -250,7 +287,95 @@ uint32 Shader::previousNumAttributes = 0;
 Shader::Shader() {
 }
 
-bool Shader::loadShader(const Common::String &name, GLuint vertexShader, GLuint fragmentShader, const char *const *attributes) {
+bool Shader::loadCachedProgram(const Common::String &name, uint64 cacheKey, const char *const *attributes) {
+#ifdef USE_GLAD
+	if (!cacheKey)
+		return false;
+
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+	if (!saveFileMan)
+		return false;
+
+	Common::ScopedPtr<Common::InSaveFile> in(saveFileMan->openForLoading(programCacheFileName(cacheKey)));
+	if (!in)
+		return false;
+
+	if (in->readUint32BE() != MKTAG('G', 'L', 'P', 'B') || in->readUint64LE() != cacheKey)
+		return false;
+
+	const GLenum format = in->readUint32LE();
+	const uint32 length = in->readUint32LE();
+	if (in->err() || !length || length > in->size() - in->pos())
+		return false;
+
+	byte *binary = new byte[length];
+	GLuint shaderProgram = 0;
+	GLint status = GL_FALSE;
+	if (in->read(binary, length) == length) {
+		GL_ASSIGN(shaderProgram, glCreateProgram());
+		GL_CALL(glProgramBinary(shaderProgram, format, binary, length));
+		GL_CALL(glGetProgramiv(shaderProgram, GL_LINK_STATUS, &status));
+	}
+	delete[] binary;
+
+	// Binaries made by an earlier driver version are rejected, and the
+	// program is then built from its sources again
+	if (status != GL_TRUE) {
+		if (shaderProgram)
+			GL_CALL(glDeleteProgram(shaderProgram));
+		debug(2, "Shader::loadCachedProgram(): Cached binary of shader %s was rejected", name.c_str());
+		return false;
+	}
+
+	_name = name;
+
+	// Attribute locations are part of the binary
+	for (int idx = 0; attributes[idx]; ++idx) {
+		_attributes.push_back(VertexAttrib(idx, attributes[idx]));
+	}
+
+	_shaderNo = Common::SharedPtr<GLuint>(new GLuint(shaderProgram), SharedPtrProgramDeleter());
+	_uniforms = Common::SharedPtr<UniformsMap>(new UniformsMap());
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+void Shader::saveProgramBinary(GLuint shaderProgram, uint64 cacheKey) {
+#ifdef USE_GLAD
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+	if (!cacheKey || !saveFileMan)
+		return;
+
+	GLint length = 0;
+	GL_CALL(glGetProgramiv(shaderProgram, GL_PROGRAM_BINARY_LENGTH, &length));
+	if (length <= 0)
+		return;
+
+	byte *binary = new byte[length];
+	GLsizei written = 0;
+	GLenum format = 0;
+	GL_CALL(glGetProgramBinary(shaderProgram, length, &written, &format, binary));
+
+	if (written > 0) {
+		Common::ScopedPtr<Common::OutSaveFile> out(saveFileMan->openForSaving(programCacheFileName(cacheKey), false));
+		if (out) {
+			out->writeUint32BE(MKTAG('G', 'L', 'P', 'B'));
+			out->writeUint64LE(cacheKey);
+			out->writeUint32LE(format);
+			out->writeUint32LE(written);
+			out->write(binary, written);
+			out->finalize();
+		}
+	}
+
+	delete[] binary;
+#endif
+}
+
+bool Shader::loadShader(const Common::String &name, GLuint vertexShader, GLuint fragmentShader, const char *const *attributes, uint64 cacheKey) {
 	assert(attributes);
 
 	_name = name;
@@ -279,6 +404,8 @@ bool Shader::loadShader(const Common::String &name, GLuint vertexShader, GLuint
 		return false;
 	}
 
+	saveProgramBinary(shaderProgram, cacheKey);
+
 	GL_CALL(glDetachShader(shaderProgram, vertexShader));
 	GL_CALL(glDetachShader(shaderProgram, fragmentShader));
 
@@ -303,34 +430,59 @@ Shader *Shader::fromStrings(const Common::String &name, const char *vertex, cons
 }
 
 bool Shader::loadFromStrings(const Common::String &name, const char *vertex, const char *fragment, const char *const *attributes, int compatGLSLVersion) {
+	return loadFromSources(name, name + ".vertex", vertex, name + ".fragment", fragment, attributes, compatGLSLVersion);
+}
+
+bool Shader::loadFromSources(const Common::String &name,
+			const Common::String &vertexName, const char *vertex,
+			const Common::String &fragmentName, const char *fragment,
+			const char *const *attributes, int compatGLSLVersion) {
+	uint64 cacheKey;
+	if (compatGLSLVersion) {
+		char version[12];
+		Common::sprintf_s(version, "%d", compatGLSLVersion);
+		const char *const vertexSources[] = { version, compatVertex, compatUniformBool, vertex };
+		const char *const fragmentSources[] = { version, compatFragment, compatUniformBool, fragment };
+		cacheKey = programCacheKey(ARRAYSIZE(vertexSources), vertexSources, ARRAYSIZE(fragmentSources), fragmentSources, attributes);
+	} else {
+		cacheKey = programCacheKey(1, &vertex, 1, &fragment, attributes);
+	}
+
+	if (loadCachedProgram(name, cacheKey, attributes))
+		return true;
+
 	GLuint vertexShader, fragmentShader;
 
 	if (compatGLSLVersion) {
-		vertexShader = createCompatShader(vertex, GL_VERTEX_SHADER, name + ".vertex", compatGLSLVersion);
+		vertexShader = createCompatShader(vertex, GL_VERTEX_SHADER, vertexName, compatGLSLVersion);
 
 		if (!vertexShader)
 			return false;
 
-		fragmentShader = createCompatShader(fragment, GL_FRAGMENT_SHADER, name + ".fragment", compatGLSLVersion);
+		fragmentShader = createCompatShader(fragment, GL_FRAGMENT_SHADER, fragmentName, compatGLSLVersion);
 	} else {
-		vertexShader = createDirectShader(1, &vertex, GL_VERTEX_SHADER, name + ".vertex");
+		vertexShader = createDirectShader(1, &vertex, GL_VERTEX_SHADER, vertexName);
 
 		if (!vertexShader)
 			return false;
 
-		fragmentShader = createDirectShader(1, &fragment, GL_FRAGMENT_SHADER, name + ".fragment");
+		fragmentShader = createDirectShader(1, &fragment, GL_FRAGMENT_SHADER, fragmentName);
 	}
 
 	if (!fragmentShader)
 		return false;
 
-	return loadShader(name, vertexShader, fragmentShader, attributes);
+	return loadShader(name, vertexShader, fragmentShader, attributes, cacheKey);
 }
 
 bool Shader::loadFromStringsArray(const Common::String &name,
 			size_t vertexCount, const char *const *vertex,
 			size_t fragmentCount, const char *const *fragment,
 			const char *const *attributes) {
+	const uint64 cacheKey = programCacheKey(vertexCount, vertex, fragmentCount, fragment, attributes);
+	if (loadCachedProgram(name, cacheKey, attributes))
+		return true;
+
 	GLuint vertexShader, fragmentShader;
 
 	vertexShader = createDirectShader(vertexCount, vertex, GL_VERTEX_SHADER, name + ".vertex");
@@ -343,7 +495,7 @@ bool Shader::loadFromStringsArray(const Common::String &name,
 	if (!fragmentShader)
 		return false;
 
-	return loadShader(name, vertexShader, fragmentShader, attributes);
+	return loadShader(name, vertexShader, fragmentShader, attributes, cacheKey);
 }
 
 Shader *Shader::fromFiles(const char *vertex, const char *fragment, const char *const *attributes, int compatGLSLVersion) {
@@ -358,19 +510,19 @@ Shader *Shader::fromFiles(const char *vertex, const char *fragment, const char *
 }
 
 bool Shader::loadFromFiles(const char *vertex, const char *fragment, const char *const *attributes, int compatGLSLVersion) {
-	GLuint vertexShader = loadShaderFromFile(vertex, "vertex", GL_VERTEX_SHADER, compatGLSLVersion);
-
-	if (!vertexShader)
-		return false;
+	const Common::String vertexName = Common::String(vertex) + ".vertex";
+	const Common::String fragmentName = Common::String(fragment) + ".fragment";
+	const GLchar *vertexSource = readFile(vertexName);
+	const GLchar *fragmentSource = readFile(fragmentName);
 
-	GLuint fragmentShader = loadShaderFromFile(fragment, "fragment", GL_FRAGMENT_SHADER, compatGLSLVersion);
+	Common::String name = Common::String::format("%s/%s", vertex, fragment);
 
-	if (!fragmentShader)
-		return false;
+	bool result = loadFromSources(name, vertexName, vertexSource, fragmentName, fragmentSource, attributes, compatGLSLVersion);
 
-	Common::String name = Common::String::format("%s/%s", vertex, fragment);
+	delete[] vertexSource;
+	delete[] fragmentSource;
 
-	return loadShader(name, vertexShader, fragmentShader, attributes);
+	return result;
 }
 
 void Shader::use(bool forceReload) {
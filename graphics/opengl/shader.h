@@ -243,11 +243,22 @@ public:
 	bool hasError() { return !_error.empty(); }
 
 private:
-	bool loadShader(const Common::String &name, GLuint vertexShader, GLuint fragmentShader, const char *const *attributes);
+	bool loadShader(const Common::String &name, GLuint vertexShader, GLuint fragmentShader, const char *const *attributes, uint64 cacheKey = 0);
+	bool loadFromSources(const Common::String &name,
+			const Common::String &vertexName, const char *vertex,
+			const Common::String &fragmentName, const char *fragment,
+			const char *const *attributes, int compatGLSLVersion);
+
+	/**
+	 * Program binaries are kept in the savefile directory, so that shaders
+	 * don't need to be compiled again every time they are used.
+	 * Nothing is cached when cacheKey is 0.
+	 */
+	bool loadCachedProgram(const Common::String &name, uint64 cacheKey, const char *const *attributes);
+	void saveProgramBinary(GLuint shaderProgram, uint64 cacheKey);
 
 	GLuint createCompatShader(const char *shaderSource, GLenum shaderType, const Common::String &name, int compatGLSLVersion);
 	GLuint createDirectShader(size_t shaderSourcesCount, const char *const *shaderSources, GLenum shaderType, const Common::String &name);
-	GLuint loadShaderFromFile(const char *base, const char *extension, GLenum shaderType, int compatGLSLVersion);
 
 	// Since this class is cloned using the implicit copy constructor,
 	// a reference counting pointer is used to ensure deletion of the OpenGL
@@ -37,13 +37,17 @@ Texture::Texture(GLenum glIntFormat, GLenum glFormat, GLenum glType, bool autoCr
 	: _glIntFormat(glIntFormat), _glFormat(glFormat), _glType(glType),
 	  _width(0), _height(0), _logicalWidth(0), _logicalHeight(0),
 	  _texCoords(), _glFilter(GL_NEAREST),
-	  _glTexture(0) {
+	  _glTexture(0), _streamingUpload(false), _pixelBuffers(),
+	  _pixelBufferSizes(), _currentPixelBuffer(0) {
 	if (autoCreate)
 		create();
 }
 
 Texture::~Texture() {
 	GL_CALL_SAFE(glDeleteTextures, (1, &_glTexture));
+#ifdef GL_PIXEL_UNPACK_BUFFER
+	GL_CALL_SAFE(glDeleteBuffers, (2, _pixelBuffers));
+#endif
 }
 
 void Texture::enableLinearFiltering(bool enable) {
@@ -59,6 +63,14 @@ void Texture::enableLinearFiltering(bool enable) {
 	GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, _glFilter));
 }
 
+void Texture::enableStreamingUpload(bool enable) {
+	_streamingUpload = enable;
+
+	if (!enable) {
+		destroyPixelBuffers();
+	}
+}
+
 void Texture::setWrapMode(WrapMode wrapMode) {
 	GLuint glwrapMode;
 
@@ -106,6 +118,18 @@ void Texture::setWrapMode(WrapMode wrapMode) {
 void Texture::destroy() {
 	GL_CALL(glDeleteTextures(1, &_glTexture));
 	_glTexture = 0;
+
+	destroyPixelBuffers();
+}
+
+void Texture::destroyPixelBuffers() {
+#ifdef GL_PIXEL_UNPACK_BUFFER
+	if (_pixelBuffers[0]) {
+		GL_CALL(glDeleteBuffers(2, _pixelBuffers));
+	}
+#endif
+	_pixelBuffers[0] = _pixelBuffers[1] = 0;
+	_pixelBufferSizes[0] = _pixelBufferSizes[1] = 0;
 }
 
 void Texture::create() {
@@ -192,28 +216,94 @@ void Texture::updateArea(const Common::Rect &area, const Graphics::Surface &src)
 	// Set the texture on the active texture unit.
 	bind();
 
+	if (_streamingUpload && updateAreaStreaming(area, src)) {
+		return;
+	}
+
 	// Update the actual texture.
-	// Although we have the area of the texture buffer we want to update we
-	// cannot take advantage of the left/right boundaries here because it is
-	// not possible to specify a pitch to glTexSubImage2D. To be precise, with
-	// plain OpenGL we could set GL_UNPACK_ROW_LENGTH to achieve this. However,
-	// OpenGL ES 1.0 does not support GL_UNPACK_ROW_LENGTH. Thus, we are left
-	// with the following options:
-	//
-	// 1) (As we do right now) Simply always update the whole texture lines of
-	//    rect changed. This is simplest to implement. In case performance is
-	//    really an issue we can think of switching to another method.
-	//
-	// 2) Copy the dirty rect to a temporary buffer and upload that by using
-	//    glTexSubImage2D. This is what the Android backend does. It is more
-	//    complicated though.
-	//
-	// 3) Use glTexSubImage2D per line changed. This is what the old OpenGL
-	//    graphics manager did but it is much slower! Thus, we do not use it.
+	// When the context allows specifying a pitch, only the area itself is
+	// uploaded. Otherwise (e.g. on OpenGL ES 1.0 and 2.0 without
+	// GL_EXT_unpack_subimage) we upload the whole texture lines of the area
+	// instead of copying the area to a temporary buffer, or doing one
+	// glTexSubImage2D call per line, which is much slower.
+#ifdef GL_UNPACK_ROW_LENGTH
+	if (OpenGLContext.unpackSubImageSupported && area.width() != src.w) {
+		GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, src.pitch / src.format.bytesPerPixel));
+		GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, area.left, area.top, area.width(), area.height(),
+		                        _glFormat, _glType, src.getBasePtr(area.left, area.top)));
+		GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+		return;
+	}
+#endif
+
 	GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, area.top, src.w, area.height(),
 	                       _glFormat, _glType, src.getBasePtr(0, area.top)));
 }
 
+bool Texture::updateAreaStreaming(const Common::Rect &area, const Graphics::Surface &src) {
+#ifdef GL_PIXEL_UNPACK_BUFFER
+	if (!OpenGLContext.pixelBufferObjectSupported) {
+		return false;
+	}
+
+	if (!_pixelBuffers[0]) {
+		GL_CALL(glGenBuffers(2, _pixelBuffers));
+	}
+
+	// Alternate between two buffers, so that we never have to wait for the
+	// upload of the previous frame to finish.
+	_currentPixelBuffer ^= 1;
+
+	const uint bytesPerPixel = src.format.bytesPerPixel;
+	const uint rowSize = area.width() * bytesPerPixel;
+	const uint size = rowSize * area.height();
+
+	GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pixelBuffers[_currentPixelBuffer]));
+
+	// Specifying the data store anew orphans the old one, in case it is
+	// still in use by the GPU.
+	if (size > _pixelBufferSizes[_currentPixelBuffer]) {
+		_pixelBufferSizes[_currentPixelBuffer] = size;
+	}
+	GL_CALL(glBufferData(GL_PIXEL_UNPACK_BUFFER, _pixelBufferSizes[_currentPixelBuffer], nullptr, GL_STREAM_DRAW));
+
+	const byte *srcRow = (const byte *)src.getBasePtr(area.left, area.top);
+	byte *dst = nullptr;
+#ifdef GL_MAP_INVALIDATE_BUFFER_BIT
+	if (OpenGLContext.mapBufferRangeSupported) {
+		GL_ASSIGN(dst, (byte *)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+	}
+#endif
+
+	if (dst) {
+		for (int y = area.top; y < area.bottom; y++) {
+			memcpy(dst, srcRow, rowSize);
+			dst += rowSize;
+			srcRow += src.pitch;
+		}
+
+		GL_CALL(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+	} else if (rowSize == (uint)src.pitch) {
+		GL_CALL(glBufferSubData(GL_PIXEL_UNPACK_BUFFER, 0, size, srcRow));
+	} else {
+		for (int y = 0; y < area.height(); y++) {
+			GL_CALL(glBufferSubData(GL_PIXEL_UNPACK_BUFFER, y * rowSize, rowSize, srcRow));
+			srcRow += src.pitch;
+		}
+	}
+
+	// The area is tightly packed in the buffer, so there is no need for
+	// GL_UNPACK_ROW_LENGTH.
+	GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, area.left, area.top, area.width(), area.height(),
+	                        _glFormat, _glType, nullptr));
+
+	GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+	return true;
+#else
+	return false;
+#endif
+}
+
 const Graphics::PixelFormat Texture::getRGBAPixelFormat() {
 #ifdef SCUMM_BIG_ENDIAN
 	return Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0);
@@ -68,6 +68,18 @@ public:
 	 */
 	bool isLinearFilteringEnabled() const { return (_glFilter == GL_LINEAR); }
 
+	/**
+	 * Enable or disable uploading through pixel buffer objects.
+	 *
+	 * This is meant for textures which are updated every frame. Uploads
+	 * do not stall the pipeline then, at the cost of keeping two buffers
+	 * as big as the largest update around. It has no effect when the
+	 * context has no pixel buffer object support.
+	 *
+	 * @param enable true to enable and false to disable.
+	 */
+	void enableStreamingUpload(bool enable);
+
 	/**
 	 * Enable or disable linear texture filtering.
 	 *
@@ -159,6 +171,14 @@ protected:
 	GLint _glFilter;
 
 	GLuint _glTexture;
+
+	bool _streamingUpload;
+	GLuint _pixelBuffers[2];
+	uint _pixelBufferSizes[2];
+	uint _currentPixelBuffer;
+
+	void destroyPixelBuffers();
+	bool updateAreaStreaming(const Common::Rect &area, const Graphics::Surface &src);
 };
 
 } // End of namespace OpenGL
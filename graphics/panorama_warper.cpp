@@ -0,0 +1,97 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/jobs.h"
+#include "common/system.h"
+#include "graphics/panorama_warper.h"
+
+namespace Graphics {
+
+// Minimum number of rows warped by a single job
+static const uint kMinWarpRows = 32;
+
+template<typename T>
+static void warpRows(const uint32 *table, uint16 tableWidth, const Surface &src, Surface &dst, uint16 width, uint begin, uint end) {
+	const T *srcPixels = (const T *)src.getPixels();
+
+	for (uint y = begin; y < end; ++y) {
+		const uint32 *entries = table + y * tableWidth;
+		T *dstRow = (T *)dst.getBasePtr(0, y);
+
+		for (uint x = 0; x < width; ++x)
+			dstRow[x] = srcPixels[entries[x]];
+	}
+}
+
+void PanoramaWarper::create(uint16 width, uint16 height) {
+	_width = width;
+	_height = height;
+	_table.resize(width * height);
+
+	for (uint i = 0; i < _table.size(); ++i)
+		_table[i] = i;
+}
+
+void PanoramaWarper::warp(const Surface &src, Surface &dst) const {
+	assert(src.format.bytesPerPixel == dst.format.bytesPerPixel);
+
+	WarpJob job;
+	job.warper = this;
+	job.src = &src;
+	job.dst = &dst;
+	job.width = MIN<uint16>(_width, dst.w);
+
+	// Rows are independent, so they are warped in bands in parallel
+	g_system->getJobSystem()->parallelFor(MIN<uint16>(_height, dst.h), warpRowsProc, &job, kMinWarpRows);
+}
+
+void PanoramaWarper::warpRowsProc(uint begin, uint end, void *refCon) {
+	const WarpJob &job = *(const WarpJob *)refCon;
+	const uint32 *table = job.warper->_table.data();
+	const uint16 tableWidth = job.warper->_width;
+
+	switch (job.src->format.bytesPerPixel) {
+	case 1:
+		warpRows<uint8>(table, tableWidth, *job.src, *job.dst, job.width, begin, end);
+		break;
+	case 2:
+		warpRows<uint16>(table, tableWidth, *job.src, *job.dst, job.width, begin, end);
+		break;
+	case 4:
+		warpRows<uint32>(table, tableWidth, *job.src, *job.dst, job.width, begin, end);
+		break;
+	default: {
+		const byte *srcPixels = (const byte *)job.src->getPixels();
+		const uint bpp = job.src->format.bytesPerPixel;
+
+		for (uint y = begin; y < end; ++y) {
+			const uint32 *entries = table + y * tableWidth;
+			byte *dstRow = (byte *)job.dst->getBasePtr(0, y);
+
+			for (uint x = 0; x < job.width; ++x)
+				memcpy(dstRow + x * bpp, srcPixels + entries[x] * bpp, bpp);
+		}
+		break;
+	}
+	}
+}
+
+} // End of namespace Graphics
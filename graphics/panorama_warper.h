@@ -0,0 +1,94 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_PANORAMA_WARPER_H
+#define GRAPHICS_PANORAMA_WARPER_H
+
+#include "common/array.h"
+#include "graphics/surface.h"
+
+namespace Graphics {
+
+/**
+ * @defgroup graphics_panorama_warper Panorama warper
+ * @ingroup graphics
+ *
+ * @brief Projection of panoramas through precomputed remap tables.
+ *
+ * @{
+ */
+
+/**
+ * A table giving, for every pixel of a destination image, the pixel of a
+ * source image it shows.
+ *
+ * Panorama views compute such a table from their projection whenever the
+ * field of view or the tilt changes, and then warp every frame with it,
+ * which is a plain lookup per pixel. Rows are warped in parallel on the
+ * job system.
+ *
+ * Entries are pixel offsets from the start of the source surface, i.e.
+ * srcY * (src.pitch / src.format.bytesPerPixel) + srcX. They are not
+ * checked when warping.
+ */
+class PanoramaWarper {
+public:
+	PanoramaWarper() : _width(0), _height(0) {}
+
+	/**
+	 * Resize the table for a destination of the given size. The table is
+	 * reset to the identity warp of a source which is @p width pixels wide.
+	 */
+	void create(uint16 width, uint16 height);
+
+	uint16 getWidth() const { return _width; }
+	uint16 getHeight() const { return _height; }
+
+	/** Return the entries of a destination row, for filling the table. */
+	uint32 *getRow(uint16 y) { return &_table[y * _width]; }
+	const uint32 *getRow(uint16 y) const { return &_table[y * _width]; }
+
+	/**
+	 * Warp @p src into @p dst. Both surfaces must have the same number of
+	 * bytes per pixel. Only the part of the destination covered by both the
+	 * table and @p dst is written.
+	 */
+	void warp(const Surface &src, Surface &dst) const;
+
+private:
+	struct WarpJob {
+		const PanoramaWarper *warper;
+		const Surface *src;
+		Surface *dst;
+		uint16 width;
+	};
+
+	Common::Array<uint32> _table;
+	uint16 _width, _height;
+
+	static void warpRowsProc(uint begin, uint end, void *refCon);
+};
+
+/** @} */
+
+} // End of namespace Graphics
+
+#endif
@@ -0,0 +1,84 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "graphics/scaler/hq_intern.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+// Same thresholds as diffYUV(), one byte per Y, U and V channel
+static FORCEINLINE uint32x4_t neon_diffYUV(uint8x16_t yuv1, const uint32 *yuv2, uint8x16_t threshold) {
+	const uint8x16_t diff = vabdq_u8(yuv1, vreinterpretq_u8_u32(vld1q_u32(yuv2)));
+	const uint32x4_t above = vreinterpretq_u32_u8(vqsubq_u8(diff, threshold));
+	return vtstq_u32(above, above);
+}
+
+static FORCEINLINE uint16x4_t neon_patterns(const uint32 *yuvAbove, const uint32 *yuv, const uint32 *yuvBelow, uint8x16_t threshold) {
+	const uint8x16_t center = vreinterpretq_u8_u32(vld1q_u32(yuv + 1));
+
+	uint32x4_t pattern = vandq_u32(neon_diffYUV(center, yuvAbove, threshold), vdupq_n_u32(0x01));
+	pattern = vorrq_u32(pattern, vandq_u32(neon_diffYUV(center, yuvAbove + 1, threshold), vdupq_n_u32(0x02)));
+	pattern = vorrq_u32(pattern, vandq_u32(neon_diffYUV(center, yuvAbove + 2, threshold), vdupq_n_u32(0x04)));
+	pattern = vorrq_u32(pattern, vandq_u32(neon_diffYUV(center, yuv, threshold), vdupq_n_u32(0x08)));
+	pattern = vorrq_u32(pattern, vandq_u32(neon_diffYUV(center, yuv + 2, threshold), vdupq_n_u32(0x10)));
+	pattern = vorrq_u32(pattern, vandq_u32(neon_diffYUV(center, yuvBelow, threshold), vdupq_n_u32(0x20)));
+	pattern = vorrq_u32(pattern, vandq_u32(neon_diffYUV(center, yuvBelow + 1, threshold), vdupq_n_u32(0x40)));
+	pattern = vorrq_u32(pattern, vandq_u32(neon_diffYUV(center, yuvBelow + 2, threshold), vdupq_n_u32(0x80)));
+	return vmovn_u32(pattern);
+}
+
+void hqPatternsNEON(const uint32 *yuvAbove, const uint32 *yuv, const uint32 *yuvBelow, uint8 *patterns, int width) {
+	const uint8x16_t threshold = vreinterpretq_u8_u32(vdupq_n_u32(0x00300706));
+
+	int x = 0;
+	for (; x + 8 <= width; x += 8) {
+		const uint16x4_t lo = neon_patterns(yuvAbove + x, yuv + x, yuvBelow + x, threshold);
+		const uint16x4_t hi = neon_patterns(yuvAbove + x + 4, yuv + x + 4, yuvBelow + x + 4, threshold);
+		vst1_u8(patterns + x, vmovn_u16(vcombine_u16(lo, hi)));
+	}
+
+	if (x < width)
+		hqPatternsGeneric(yuvAbove + x, yuv + x, yuvBelow + x, patterns + x, width - x);
+}
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+#endif
+
+#endif // SCUMMVM_NEON
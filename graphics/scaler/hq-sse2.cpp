@@ -0,0 +1,82 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/scaler/hq_intern.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+// Same thresholds as diffYUV(), one byte per Y, U and V channel
+static FORCEINLINE __m128i sse2_diffYUV(__m128i yuv1, __m128i yuv2, __m128i threshold) {
+	const __m128i diff = _mm_or_si128(_mm_subs_epu8(yuv1, yuv2), _mm_subs_epu8(yuv2, yuv1));
+	const __m128i above = _mm_subs_epu8(diff, threshold);
+	return _mm_xor_si128(_mm_cmpeq_epi32(above, _mm_setzero_si128()), _mm_set1_epi32(-1));
+}
+
+static FORCEINLINE __m128i sse2_patterns(const uint32 *yuvAbove, const uint32 *yuv, const uint32 *yuvBelow, __m128i threshold) {
+	const __m128i center = _mm_loadu_si128((const __m128i *)(yuv + 1));
+
+	__m128i pattern = _mm_and_si128(sse2_diffYUV(center, _mm_loadu_si128((const __m128i *)(yuvAbove)), threshold), _mm_set1_epi32(0x01));
+	pattern = _mm_or_si128(pattern, _mm_and_si128(sse2_diffYUV(center, _mm_loadu_si128((const __m128i *)(yuvAbove + 1)), threshold), _mm_set1_epi32(0x02)));
+	pattern = _mm_or_si128(pattern, _mm_and_si128(sse2_diffYUV(center, _mm_loadu_si128((const __m128i *)(yuvAbove + 2)), threshold), _mm_set1_epi32(0x04)));
+	pattern = _mm_or_si128(pattern, _mm_and_si128(sse2_diffYUV(center, _mm_loadu_si128((const __m128i *)(yuv)), threshold), _mm_set1_epi32(0x08)));
+	pattern = _mm_or_si128(pattern, _mm_and_si128(sse2_diffYUV(center, _mm_loadu_si128((const __m128i *)(yuv + 2)), threshold), _mm_set1_epi32(0x10)));
+	pattern = _mm_or_si128(pattern, _mm_and_si128(sse2_diffYUV(center, _mm_loadu_si128((const __m128i *)(yuvBelow)), threshold), _mm_set1_epi32(0x20)));
+	pattern = _mm_or_si128(pattern, _mm_and_si128(sse2_diffYUV(center, _mm_loadu_si128((const __m128i *)(yuvBelow + 1)), threshold), _mm_set1_epi32(0x40)));
+	pattern = _mm_or_si128(pattern, _mm_and_si128(sse2_diffYUV(center, _mm_loadu_si128((const __m128i *)(yuvBelow + 2)), threshold), _mm_set1_epi32(0x80)));
+	return pattern;
+}
+
+void hqPatternsSSE2(const uint32 *yuvAbove, const uint32 *yuv, const uint32 *yuvBelow, uint8 *patterns, int width) {
+	const __m128i threshold = _mm_set1_epi32(0x00300706);
+
+	int x = 0;
+	for (; x + 8 <= width; x += 8) {
+		const __m128i lo = sse2_patterns(yuvAbove + x, yuv + x, yuvBelow + x, threshold);
+		const __m128i hi = sse2_patterns(yuvAbove + x + 4, yuv + x + 4, yuvBelow + x + 4, threshold);
+		// The patterns fit in a byte, so saturation never kicks in
+		const __m128i packed = _mm_packs_epi32(lo, hi);
+		_mm_storel_epi64((__m128i *)(patterns + x), _mm_packus_epi16(packed, packed));
+	}
+
+	if (x < width)
+		hqPatternsGeneric(yuvAbove + x, yuv + x, yuvBelow + x, patterns + x, width - x);
+}
+
+#if !defined(__x86_64__)
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+#endif
@@ -19,8 +19,11 @@
  */
 
 #include "graphics/scaler/hq.h"
+#include "graphics/scaler/hq_intern.h"
 #include "graphics/scaler.h"
 #include "graphics/scaler/intern.h"
+#include "common/array.h"
+#include "common/system.h"
 
 // RGB-to-YUV lookup table
 
@@ -193,13 +196,82 @@ static inline uint32 ConvertYUV(uint32 x, const uint32 *RGBtoYUV) {
 	return RGBtoYUV[r | g | b];
 }
 
+template<typename ColorMask>
+static void convertRowToYUV(const typename ColorMask::PixelType *src, uint32 *dst, int count, const uint32 *RGBtoYUV) {
+	typedef typename ColorMask::PixelType Pixel;
+
+	for (int i = 0; i < count; i++)
+		dst[i] = sizeof(Pixel) == 2 ? RGBtoYUV[src[i]] : ConvertYUV<ColorMask>(src[i], RGBtoYUV);
+}
+
+void hqPatternsGeneric(const uint32 *yuvAbove, const uint32 *yuv, const uint32 *yuvBelow, uint8 *patterns, int width) {
+	for (int x = 0; x < width; x++) {
+		const int yuv5 = yuv[x + 1];
+		int pattern = 0;
+		if (diffYUV(yuv5, yuvAbove[x]))     pattern |= 0x0001;
+		if (diffYUV(yuv5, yuvAbove[x + 1])) pattern |= 0x0002;
+		if (diffYUV(yuv5, yuvAbove[x + 2])) pattern |= 0x0004;
+		if (diffYUV(yuv5, yuv[x]))          pattern |= 0x0008;
+		if (diffYUV(yuv5, yuv[x + 2]))      pattern |= 0x0010;
+		if (diffYUV(yuv5, yuvBelow[x]))     pattern |= 0x0020;
+		if (diffYUV(yuv5, yuvBelow[x + 1])) pattern |= 0x0040;
+		if (diffYUV(yuv5, yuvBelow[x + 2])) pattern |= 0x0080;
+		patterns[x] = pattern;
+	}
+}
+
+/**
+ * Computes the neighbourhood patterns of all pixels in a row ahead of the
+ * interpolation. The YUV values of the three source rows involved are kept
+ * around, so that every source pixel is only converted once.
+ */
+template<typename ColorMask>
+class HQPatternRows {
+	typedef typename ColorMask::PixelType Pixel;
+
+public:
+	HQPatternRows(uint32 *yuvRows, uint8 *patterns, int width, HQPatternFunc computePatterns, const uint32 *RGBtoYUV) :
+		_patterns(patterns), _width(width), _computePatterns(computePatterns), _RGBtoYUV(RGBtoYUV), _first(true) {
+		_yuv[0] = yuvRows;
+		_yuv[1] = yuvRows + (width + 2);
+		_yuv[2] = yuvRows + (width + 2) * 2;
+	}
+
+	/** Compute the patterns of the row at p, which must follow the previous one. */
+	const uint8 *next(const Pixel *p, uint32 nextlineSrc) {
+		if (_first) {
+			convertRowToYUV<ColorMask>(p - 1 - nextlineSrc, _yuv[0], _width + 2, _RGBtoYUV);
+			convertRowToYUV<ColorMask>(p - 1, _yuv[1], _width + 2, _RGBtoYUV);
+			_first = false;
+		} else {
+			uint32 *oldest = _yuv[0];
+			_yuv[0] = _yuv[1];
+			_yuv[1] = _yuv[2];
+			_yuv[2] = oldest;
+		}
+		convertRowToYUV<ColorMask>(p - 1 + nextlineSrc, _yuv[2], _width + 2, _RGBtoYUV);
+
+		_computePatterns(_yuv[0], _yuv[1], _yuv[2], _patterns, _width);
+		return _patterns;
+	}
+
+private:
+	uint32 *_yuv[3];
+	uint8 *_patterns;
+	const int _width;
+	const HQPatternFunc _computePatterns;
+	const uint32 *_RGBtoYUV;
+	bool _first;
+};
+
 /*
  * The HQ2x high quality 2x graphics filter.
  * Original author Maxim Stepin (https://web.archive.org/web/20090204033742/http://www.hiend3d.com/hq2x.html).
  * Adapted for ScummVM to 16 bit output and optimized by Max Horn.
  */
 template<typename ColorMask>
-static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV) {
+static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV,
+		uint32 *yuvRows, uint8 *patternRow, HQPatternFunc computePatterns) {
 	typedef typename ColorMask::PixelType Pixel;
 
 	int w1, w2, w3, w4, w5, w6, w7, w8, w9;
@@ -221,7 +293,11 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 	//	 | w7 | w8 | w9 |
 	//	 +----+----+----+
 
+	HQPatternRows<ColorMask> rows(yuvRows, patternRow, width, computePatterns, RGBtoYUV);
+
 	while (height--) {
+		const uint8 *patterns = rows.next(p, nextlineSrc);
+
 		w1 = *(p - 1 - nextlineSrc);
 		w4 = *(p - 1);
 		w7 = *(p - 1 + nextlineSrc);
@@ -238,16 +314,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			w6 = *(p);
 			w9 = *(p + nextlineSrc);
 
-			int pattern = 0;
-			const int yuv5 = YUV(5);
-			if (w5 != w1 && diffYUV(yuv5, YUV(1))) pattern |= 0x0001;
-			if (w5 != w2 && diffYUV(yuv5, YUV(2))) pattern |= 0x0002;
-			if (w5 != w3 && diffYUV(yuv5, YUV(3))) pattern |= 0x0004;
-			if (w5 != w4 && diffYUV(yuv5, YUV(4))) pattern |= 0x0008;
-			if (w5 != w6 && diffYUV(yuv5, YUV(6))) pattern |= 0x0010;
-			if (w5 != w7 && diffYUV(yuv5, YUV(7))) pattern |= 0x0020;
-			if (w5 != w8 && diffYUV(yuv5, YUV(8))) pattern |= 0x0040;
-			if (w5 != w9 && diffYUV(yuv5, YUV(9))) pattern |= 0x0080;
+			const int pattern = *patterns++;
 
 			switch (pattern) {
 			case 0:
@@ -2116,7 +2183,8 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
  * Adapted for ScummVM to 16 bit output and optimized by Max Horn.
  */
 template<typename ColorMask>
-static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV) {
+static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV,
+		uint32 *yuvRows, uint8 *patternRow, HQPatternFunc computePatterns) {
 	typedef typename ColorMask::PixelType Pixel;
 
 	int  w1, w2, w3, w4, w5, w6, w7, w8, w9;
@@ -2139,7 +2207,11 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 	//	 | w7 | w8 | w9 |
 	//	 +----+----+----+
 
+	HQPatternRows<ColorMask> rows(yuvRows, patternRow, width, computePatterns, RGBtoYUV);
+
 	while (height--) {
+		const uint8 *patterns = rows.next(p, nextlineSrc);
+
 		w1 = *(p - 1 - nextlineSrc);
 		w4 = *(p - 1);
 		w7 = *(p - 1 + nextlineSrc);
@@ -2156,16 +2228,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			w6 = *(p);
 			w9 = *(p + nextlineSrc);
 
-			int pattern = 0;
-			const int yuv5 = YUV(5);
-			if (w5 != w1 && diffYUV(yuv5, YUV(1))) pattern |= 0x0001;
-			if (w5 != w2 && diffYUV(yuv5, YUV(2))) pattern |= 0x0002;
-			if (w5 != w3 && diffYUV(yuv5, YUV(3))) pattern |= 0x0004;
-			if (w5 != w4 && diffYUV(yuv5, YUV(4))) pattern |= 0x0008;
-			if (w5 != w6 && diffYUV(yuv5, YUV(6))) pattern |= 0x0010;
-			if (w5 != w7 && diffYUV(yuv5, YUV(7))) pattern |= 0x0020;
-			if (w5 != w8 && diffYUV(yuv5, YUV(8))) pattern |= 0x0040;
-			if (w5 != w9 && diffYUV(yuv5, YUV(9))) pattern |= 0x0080;
+			const int pattern = *patterns++;
 
 			switch (pattern) {
 			case 0:
@@ -4951,9 +5014,18 @@ HQScaler::HQScaler(const Graphics::PixelFormat &format) : Scaler(format),
 #ifdef USE_NASM
 	_hqx_params(nullptr),
 #endif
-	_RGBtoYUV(nullptr) {
+	_RGBtoYUV(nullptr), _patternFunc(hqPatternsGeneric) {
 	_factor = 2;
 
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		_patternFunc = hqPatternsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		_patternFunc = hqPatternsSSE2;
+#endif
+
 	if (format.bytesPerPixel == 2) {
 		initLUT(format);
 	} else {
@@ -4976,83 +5048,88 @@ HQScaler::~HQScaler() {
 }
 
 #ifdef USE_NASM
-void HQScaler::HQ2x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
+void HQScaler::HQ2x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, uint32 *yuvRows, uint8 *patterns) {
 	hq2x_16(srcPtr, dstPtr, width, height, srcPitch, dstPitch, _hqx_params);
 }
 
-void HQScaler::HQ3x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
+void HQScaler::HQ3x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, uint32 *yuvRows, uint8 *patterns) {
 	hq3x_16(srcPtr, dstPtr, width, height, srcPitch, dstPitch, _hqx_params);
 }
 #else
-void HQScaler::HQ2x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
+void HQScaler::HQ2x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, uint32 *yuvRows, uint8 *patterns) {
 	if (_format.gLoss == 2)
 		HQ2x_implementation<Graphics::ColorMasks<565> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, yuvRows, patterns, _patternFunc);
 	else
 		HQ2x_implementation<Graphics::ColorMasks<555> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, yuvRows, patterns, _patternFunc);
 }
 
-void HQScaler::HQ3x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
+void HQScaler::HQ3x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, uint32 *yuvRows, uint8 *patterns) {
 	if (_format.gLoss == 2)
 		HQ3x_implementation<Graphics::ColorMasks<565> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, yuvRows, patterns, _patternFunc);
 	else
 		HQ3x_implementation<Graphics::ColorMasks<555> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, yuvRows, patterns, _patternFunc);
 }
 #endif
 
-void HQScaler::HQ2x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
+void HQScaler::HQ2x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, uint32 *yuvRows, uint8 *patterns) {
 	if (_format.aLoss == 0) {
 		if (_format.aShift == 0) {
 			HQ2x_implementation<Graphics::ColorMasks<-8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV, yuvRows, patterns, _patternFunc);
 		} else {
 			HQ2x_implementation<Graphics::ColorMasks<8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV, yuvRows, patterns, _patternFunc);
 		}
 	} else {
 		assert((_format.rMax() | _format.gMax() | _format.bMax()) <= 0xffffff);
 		HQ2x_implementation<Graphics::ColorMasks<888> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, yuvRows, patterns, _patternFunc);
 	}
 }
 
-void HQScaler::HQ3x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
+void HQScaler::HQ3x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, uint32 *yuvRows, uint8 *patterns) {
 	if (_format.aLoss == 0) {
 		if (_format.aShift == 0) {
 			HQ3x_implementation<Graphics::ColorMasks<-8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV, yuvRows, patterns, _patternFunc);
 		} else {
 			HQ3x_implementation<Graphics::ColorMasks<8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV, yuvRows, patterns, _patternFunc);
 		}
 	} else {
 		assert((_format.rMax() | _format.gMax() | _format.bMax()) <= 0xffffff);
 		HQ3x_implementation<Graphics::ColorMasks<888> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, yuvRows, patterns, _patternFunc);
 	}
 }
 
 void HQScaler::scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) {
+	// YUV values of three source rows, including the extra pixel on each side.
+	// These are allocated per call, so that bands can be scaled concurrently.
+	Common::Array<uint32> yuvRows((width + 2) * 3);
+	Common::Array<uint8> patterns(width);
+
 	if (_format.bytesPerPixel == 2) {
 		switch (_factor) {
 		case 2:
-			HQ2x16(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+			HQ2x16(srcPtr, srcPitch, dstPtr, dstPitch, width, height, yuvRows.data(), patterns.data());
 			break;
 		case 3:
-			HQ3x16(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+			HQ3x16(srcPtr, srcPitch, dstPtr, dstPitch, width, height, yuvRows.data(), patterns.data());
 			break;
 		}
 	} else {
 		switch (_factor) {
 		case 2:
-			HQ2x32(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+			HQ2x32(srcPtr, srcPitch, dstPtr, dstPitch, width, height, yuvRows.data(), patterns.data());
 			break;
 		case 3:
-			HQ3x32(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+			HQ3x32(srcPtr, srcPitch, dstPtr, dstPitch, width, height, yuvRows.data(), patterns.data());
 			break;
 		}
 	}
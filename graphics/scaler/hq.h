@@ -22,6 +22,7 @@
 #define GRAPHICS_SCALER_HQ_H
 
 #include "graphics/scalerplugin.h"
+#include "graphics/scaler/hq_intern.h"
 
 #ifdef USE_NASM
 struct hqx_parameters;
@@ -33,17 +34,19 @@ public:
 	~HQScaler();
 	uint increaseFactor() override;
 	uint decreaseFactor() override;
+	bool canScaleConcurrently() const override { return true; }
 protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) override;
 
 	void initLUT(Graphics::PixelFormat format);
-	inline void HQ2x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height);
-	inline void HQ3x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height);
-	inline void HQ2x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height);
-	inline void HQ3x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height);
+	inline void HQ2x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, uint32 *yuvRows, uint8 *patterns);
+	inline void HQ3x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, uint32 *yuvRows, uint8 *patterns);
+	inline void HQ2x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, uint32 *yuvRows, uint8 *patterns);
+	inline void HQ3x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, uint32 *yuvRows, uint8 *patterns);
 
 	uint32 *_RGBtoYUV;
+	HQPatternFunc _patternFunc;
 #ifdef USE_NASM
 	hqx_parameters *_hqx_params;
 #endif
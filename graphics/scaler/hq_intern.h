@@ -0,0 +1,45 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_SCALER_HQ_INTERN_H
+#define GRAPHICS_SCALER_HQ_INTERN_H
+
+#include "common/scummsys.h"
+
+/**
+ * Compute the HQ neighbourhood patterns of a row of pixels.
+ *
+ * The three YUV rows hold width + 2 entries each, starting one pixel to the
+ * left of the first destination pixel. Bit n of a pattern is set when the
+ * n-th neighbour (in w1..w9 order, skipping the centre) differs from the
+ * centre pixel according to diffYUV().
+ */
+typedef void (*HQPatternFunc)(const uint32 *yuvAbove, const uint32 *yuv, const uint32 *yuvBelow, uint8 *patterns, int width);
+
+void hqPatternsGeneric(const uint32 *yuvAbove, const uint32 *yuv, const uint32 *yuvBelow, uint8 *patterns, int width);
+#ifdef SCUMMVM_NEON
+void hqPatternsNEON(const uint32 *yuvAbove, const uint32 *yuv, const uint32 *yuvBelow, uint8 *patterns, int width);
+#endif
+#ifdef SCUMMVM_SSE2
+void hqPatternsSSE2(const uint32 *yuvAbove, const uint32 *yuv, const uint32 *yuvBelow, uint8 *patterns, int width);
+#endif
+
+#endif
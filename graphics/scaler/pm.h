@@ -28,6 +28,7 @@ public:
 	PMScaler(const Graphics::PixelFormat &format) : Scaler(format) { _factor = 2; }
 	uint increaseFactor() override;
 	uint decreaseFactor() override;
+	bool canScaleConcurrently() const override { return true; }
 protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) override;
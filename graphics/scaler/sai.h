@@ -28,6 +28,7 @@ public:
 	SAIScaler(const Graphics::PixelFormat &format) : Scaler(format) { _factor = 2; }
 	uint increaseFactor() override;
 	uint decreaseFactor() override;
+	bool canScaleConcurrently() const override { return true; }
 protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) override;
@@ -38,6 +39,7 @@ public:
 	SuperSAIScaler(const Graphics::PixelFormat &format) : Scaler(format) { _factor = 2; }
 	uint increaseFactor() override;
 	uint decreaseFactor() override;
+	bool canScaleConcurrently() const override { return true; }
 protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) override;
@@ -48,6 +50,7 @@ public:
 	SuperEagleScaler(const Graphics::PixelFormat &format) : Scaler(format) { _factor = 2; }
 	uint increaseFactor() override;
 	uint decreaseFactor() override;
+	bool canScaleConcurrently() const override { return true; }
 protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) override;
@@ -20,6 +20,8 @@
 
 #include "graphics/scalerplugin.h"
 
+#include "common/profiler.h"
+
 namespace {
 /**
  * Trivial 'scaler' - in fact it doesn't do any scaling but just copies the
@@ -44,6 +46,8 @@ void Normal1x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPit
 
 void Scaler::scale(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
 	                           uint32 dstPitch, int width, int height, int x, int y) {
+	PROFILE_ZONE("Scaler::scale");
+
 	if (_factor == 1) {
 		if (_format.bytesPerPixel == 1) {
 			Normal1x<uint8>(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
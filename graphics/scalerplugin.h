@@ -94,6 +94,15 @@ public:
 		assert(0);
 	}
 
+	/**
+	 * Whether scale() may be called from several threads at once, as long as
+	 * the calls write to disjoint parts of the destination. This allows
+	 * splitting large rects into bands which are scaled in parallel.
+	 *
+	 * Scalers keeping any state across a call must return false.
+	 */
+	virtual bool canScaleConcurrently() const { return false; }
+
 protected:
 	/**
 	 * @see scale
@@ -26,6 +26,31 @@
 
 namespace Graphics {
 
+/**
+ * Number of dirty rects above which adding a rect merges the list
+ */
+static const uint MAX_DIRTY_RECTS = 64;
+
+/**
+ * Number of rects the dirty areas are combined into for an update
+ */
+static const uint MAX_UPDATE_RECTS = 16;
+
+/**
+ * Returns true if merging two rects doesn't add any area which is not dirty
+ */
+static bool isFreeMerge(const Common::Rect &r1, const Common::Rect &r2) {
+	if (r1.intersects(r2))
+		return true;
+
+	if (r1.left == r2.left && r1.right == r2.right)
+		return r1.bottom == r2.top || r2.bottom == r1.top;
+	if (r1.top == r2.top && r1.bottom == r2.bottom)
+		return r1.right == r2.left || r2.right == r1.left;
+
+	return false;
+}
+
 Screen::Screen(): ManagedSurface() {
 	create(g_system->getWidth(), g_system->getHeight(), g_system->getScreenFormat());
 }
@@ -66,8 +91,25 @@ void Screen::addDirtyRect(const Common::Rect &r) {
 	bounds.clip(getBounds());
 	bounds.translate(getOffsetFromOwner().x, getOffsetFromOwner().y);
 
-	if (bounds.width() > 0 && bounds.height() > 0)
+	if (bounds.width() > 0 && bounds.height() > 0) {
+		// Areas drawn to repeatedly in a frame only need to be listed once
+		uint count = 0;
+		for (Common::List<Common::Rect>::iterator i = _dirtyRects.begin(); i != _dirtyRects.end(); ++count) {
+			if ((*i).contains(bounds))
+				return;
+
+			if (bounds.contains(*i))
+				i = _dirtyRects.erase(i);
+			else
+				++i;
+		}
+
 		_dirtyRects.push_back(bounds);
+
+		// Keep the list short, so that adding rects stays cheap
+		if (count >= MAX_DIRTY_RECTS)
+			mergeDirtyRects();
+	}
 }
 
 void Screen::makeAllDirty() {
@@ -80,18 +122,62 @@ void Screen::mergeDirtyRects() {
 
 	// Process the dirty rect list to find any rects to merge
 	for (rOuter = _dirtyRects.begin(); rOuter != _dirtyRects.end(); ++rOuter) {
-		rInner = rOuter;
-		while (++rInner != _dirtyRects.end()) {
+		rInner = _dirtyRects.begin();
+		while (rInner != _dirtyRects.end()) {
 
-			if ((*rOuter).intersects(*rInner)) {
-				// These two rectangles overlap, so merge them
+			if (rInner != rOuter && isFreeMerge(*rOuter, *rInner)) {
+				// These two rectangles overlap or line up, so merge them
 				unionRectangle(*rOuter, *rOuter, *rInner);
 
 				// remove the inner rect from the list
 				_dirtyRects.erase(rInner);
 
-				// move back to beginning of list
-				rInner = rOuter;
+				// move back to beginning of list, as the grown
+				// rect may now overlap rects already checked
+				rInner = _dirtyRects.begin();
+			} else {
+				++rInner;
+			}
+		}
+	}
+
+	uint count = _dirtyRects.size();
+
+	// Combine the rects which waste the least area when merged, until
+	// few enough remain to be copied to the screen one by one
+	while (count > MAX_UPDATE_RECTS) {
+		Common::List<Common::Rect>::iterator best1, best2 = _dirtyRects.end();
+		int32 bestWaste = 0;
+
+		for (rOuter = _dirtyRects.begin(); rOuter != _dirtyRects.end(); ++rOuter) {
+			const int32 outerArea = (int32)(*rOuter).width() * (*rOuter).height();
+
+			for (rInner = rOuter, ++rInner; rInner != _dirtyRects.end(); ++rInner) {
+				Common::Rect r;
+				unionRectangle(r, *rOuter, *rInner);
+
+				const int32 waste = (int32)r.width() * r.height() - outerArea
+					- (int32)(*rInner).width() * (*rInner).height();
+				if (best2 == _dirtyRects.end() || waste < bestWaste) {
+					bestWaste = waste;
+					best1 = rOuter;
+					best2 = rInner;
+				}
+			}
+		}
+
+		unionRectangle(*best1, *best1, *best2);
+		_dirtyRects.erase(best2);
+		--count;
+
+		// The grown rect may now overlap others
+		for (rInner = _dirtyRects.begin(); rInner != _dirtyRects.end();) {
+			if (rInner != best1 && (*best1).intersects(*rInner)) {
+				unionRectangle(*best1, *best1, *rInner);
+				rInner = _dirtyRects.erase(rInner);
+				--count;
+			} else {
+				++rInner;
 			}
 		}
 	}
@@ -53,7 +53,9 @@ protected:
 	Common::List<Common::Rect> _dirtyRects;
 protected:
 	/**
-	 * Merges together overlapping dirty areas of the screen
+	 * Merges together overlapping and adjoining dirty areas of the screen,
+	 * then combines the remaining ones wasting the least area until only a
+	 * few rects are left to copy to the system
 	 */
 	void mergeDirtyRects();
 
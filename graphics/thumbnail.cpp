@@ -257,28 +257,35 @@ bool saveThumbnail(Common::WriteStream &out, const Graphics::Surface &thumb) {
 	out.writeByte(thumb.format.bShift);
 	out.writeByte(thumb.format.aShift);
 
-	// Serialize the pixel data
+	// Serialize the pixel data, a row at a time
+	const uint rowSize = thumb.w * thumb.format.bytesPerPixel;
+	byte *row = new byte[rowSize];
+
 	for (int y = 0; y < thumb.h; ++y) {
 		switch (thumb.format.bytesPerPixel) {
 		case 2: {
 			const uint16 *pixels = (const uint16 *)thumb.getBasePtr(0, y);
 			for (int x = 0; x < thumb.w; ++x) {
-				out.writeUint16BE(*pixels++);
+				WRITE_BE_UINT16(row + x * 2, *pixels++);
 			}
 			} break;
 
 		case 4: {
 			const uint32 *pixels = (const uint32 *)thumb.getBasePtr(0, y);
 			for (int x = 0; x < thumb.w; ++x) {
-				out.writeUint32BE(*pixels++);
+				WRITE_BE_UINT32(row + x * 4, *pixels++);
 			}
 			} break;
 
 		default:
 			assert(0);
 		}
+
+		out.write(row, rowSize);
 	}
 
+	delete[] row;
+
 	return true;
 }
 
@@ -353,8 +353,8 @@ void GLContext::init(int screenW, int screenH, Graphics::PixelFormat pixelFormat
 	color_mask_red = color_mask_green = color_mask_blue = color_mask_alpha = true;
 
 	_currentAllocatorIndex = 0;
-	_drawCallAllocator[0].initialize(drawCallMemorySize);
-	_drawCallAllocator[1].initialize(drawCallMemorySize);
+	_drawCallAllocator[0].setChunkSize(drawCallMemorySize);
+	_drawCallAllocator[1].setChunkSize(drawCallMemorySize);
 	_debugRectsEnabled = false;
 	_profilingEnabled = false;
 
@@ -371,6 +371,7 @@ void GLContext::deinit() {
 	free_texture(default_texture);
 	endSharedState();
 	gl_free(vertex);
+	disposeRasterizationWorkers();
 	delete fb;
 }
 
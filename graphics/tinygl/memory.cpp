@@ -27,6 +27,8 @@
 
 // Memory allocator for TinyGL
 
+#include "common/memtracker.h"
+
 #include "graphics/tinygl/zgl.h"
 
 namespace TinyGL {
@@ -34,19 +36,22 @@ namespace TinyGL {
 // modify these functions so that they suit your needs
 
 void gl_free(void *p) {
-	free(p);
+	Common::trackedFree(p);
 }
 
 void *gl_malloc(int size) {
-	return malloc(size);
+	return Common::trackedMalloc(size, Common::kMemoryTinyGL);
 }
 
 void *gl_zalloc(int size) {
-	return calloc(1, size);
+	void *p = Common::trackedMalloc(size, Common::kMemoryTinyGL);
+	if (p)
+		memset(p, 0, size);
+	return p;
 }
 
 void *gl_realloc(void *p, int size) {
-	return realloc(p, size);
+	return Common::trackedRealloc(p, size, Common::kMemoryTinyGL);
 }
 
 } // end of namespace TinyGL
@@ -22,6 +22,8 @@
 #ifndef GRAPHICS_TINYGL_H
 #define GRAPHICS_TINYGL_H
 
+#include "common/rect.h"
+
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 #include "graphics/tinygl/gl.h"
@@ -39,8 +41,21 @@ void destroyContext(ContextHandle *handle);
 void setContext(ContextHandle *handle);
 void presentBuffer();
 void presentBuffer(Common::List<Common::Rect> &dirtyAreas);
+/**
+ * Copy the given regions of the frame buffer to the screen through
+ * OSystem::copyRectToScreen, usually the ones returned by presentBuffer.
+ * The caller still has to call OSystem::updateScreen.
+ */
+void copyToScreen(const Common::List<Common::Rect> &dirtyAreas);
 void getSurfaceRef(Graphics::Surface &surface);
 Graphics::Surface *copyFromFrameBuffer(const Graphics::PixelFormat &dstFormat);
+/**
+ * Count the pixels of a framebuffer rectangle whose depth is not nearer than
+ * the given normalized device depth, using the depth buffer left by the last
+ * presentBuffer. It is a conservative stand-in for occlusion queries: the
+ * rectangle bounds the tested geometry and the depth is its nearest point.
+ */
+uint countDepthSamplesPassed(const Common::Rect &rect, float ndcDepth);
 
 } // end of namespace TinyGL
 
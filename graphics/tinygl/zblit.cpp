@@ -111,6 +111,13 @@ public:
 				}
 				srcBuf.shiftBy(surface.w);
 			}
+
+			// No pixel matched the color key, so the image is blitted with tglBlitOpaque.
+			// Store it in the framebuffer format to make that a plain copy of each row
+			// instead of a per pixel conversion every time the image is drawn.
+			if (_opaque) {
+				_surface.convertToInPlace(gl_get_context()->fb->getPixelFormat());
+			}
 		}
 
 		_version++;
@@ -30,6 +30,7 @@
 #include "common/scummsys.h"
 #include "common/endian.h"
 #include "common/memory.h"
+#include "common/system.h"
 
 #include "graphics/tinygl/zbuffer.h"
 #include "graphics/tinygl/zgl.h"
@@ -56,15 +57,47 @@ FrameBuffer::FrameBuffer(int width, int height, const Graphics::PixelFormat &for
 	_currentTexture = nullptr;
 
 	_enableScissor = false;
+	_isView = false;
+
+	_texturedSpanFunc = nullptr;
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		_texturedSpanFunc = drawTexturedSpanNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		_texturedSpanFunc = drawTexturedSpanSSE2;
+#endif
 }
 
 FrameBuffer::~FrameBuffer() {
+	if (_isView)
+		return;
+
 	gl_free(_pbuf);
 	gl_free(_zbuf);
 	if (_sbuf)
 		gl_free(_sbuf);
 }
 
+FrameBuffer *FrameBuffer::createView() const {
+	FrameBuffer *view = new FrameBuffer(*this);
+	view->_isView = true;
+	view->_enableScissor = false;
+	return view;
+}
+
+bool FrameBuffer::canUseTexturedSpanFunc(bool blending) const {
+	if (!_texturedSpanFunc || _pbufBpp != 4)
+		return false;
+	if (_pbufFormat.rLoss != 0 || _pbufFormat.gLoss != 0 || _pbufFormat.bLoss != 0)
+		return false;
+	if (_pbufFormat.aLoss != 0 && _pbufFormat.aLoss != 8)
+		return false;
+
+	return !blending || (_sourceBlendingFactor == TGL_SRC_ALPHA && _destinationBlendingFactor == TGL_ONE_MINUS_SRC_ALPHA);
+}
+
 Buffer *FrameBuffer::genOffscreenBuffer() {
 	Buffer *buf = (Buffer *)gl_malloc(sizeof(Buffer));
 	buf->pbuf = (byte *)gl_zalloc(_pbufHeight * _pbufPitch);
@@ -273,4 +306,30 @@ Graphics::Surface *copyFromFrameBuffer(const Graphics::PixelFormat &dstFormat) {
 	return c->fb->copyFromFrameBuffer(dstFormat);
 }
 
+uint countDepthSamplesPassed(const Common::Rect &rect, float ndcDepth) {
+	GLContext *c = gl_get_context();
+	assert(c->fb);
+
+	Common::Rect clipped(rect);
+	clipped.clip(Common::Rect(c->fb->getPixelBufferWidth(), c->fb->getPixelBufferHeight()));
+	if (clipped.isEmpty())
+		return 0;
+
+	// Same mapping as gl_transform_to_viewport(), larger values are nearer
+	uint z = (uint)(int)(ndcDepth * c->viewport.scale.Z + c->viewport.trans.Z);
+
+	const uint *zbuf = c->fb->getZBuffer();
+	int fbWidth = c->fb->getPixelBufferWidth();
+	uint count = 0;
+	for (int y = clipped.top; y < clipped.bottom; y++) {
+		const uint *line = zbuf + y * fbWidth;
+		for (int x = clipped.left; x < clipped.right; x++) {
+			if (line[x] <= z)
+				count++;
+		}
+	}
+
+	return count;
+}
+
 } // end of namespace TinyGL
@@ -82,6 +82,44 @@ struct Buffer {
 	bool used;
 };
 
+// A block of kTexturedSpanBlockSize pixels of a perspective textured span,
+// as handed to the SIMD rasterizer kernels. The kernels handle 32bpp frame
+// buffers with 8 bits per channel, depth testing and optionally blending
+// with TGL_SRC_ALPHA / TGL_ONE_MINUS_SRC_ALPHA.
+struct TexturedSpanBlock {
+	uint32 *pixels;
+	uint *pz;
+
+	const TexelBuffer *texture;
+	uint wrapS, wrapT;
+	int s, t, dsdx, dtdx;
+
+	uint z;
+	int dzdx;
+	uint r, g, b, a;
+	int drdx, dgdx, dbdx;
+	uint dadx;
+
+	int depthFunc;
+	bool depthWrite;
+	bool blending;
+	bool hasAlpha;
+	byte aShift, rShift, gShift, bShift;
+};
+
+static const int kTexturedSpanBlockSize = 8;
+
+// Draw a textured span block. Returns false if the block has to be drawn
+// by the generic code instead.
+typedef bool (*TexturedSpanFunc)(const TexturedSpanBlock &block);
+
+#ifdef SCUMMVM_SSE2
+bool drawTexturedSpanSSE2(const TexturedSpanBlock &block);
+#endif
+#ifdef SCUMMVM_NEON
+bool drawTexturedSpanNEON(const TexturedSpanBlock &block);
+#endif
+
 struct ZBufferPoint {
 	int x, y, z;      // integer coordinates in the zbuffer
 	int s, t;         // coordinates for the mapping
@@ -107,6 +145,16 @@ struct FrameBuffer {
 	FrameBuffer(int width, int height, const Graphics::PixelFormat &format, bool enableStencilBuffer);
 	~FrameBuffer();
 
+	/**
+	 * Create a frame buffer drawing to the same pixel, depth and stencil
+	 * buffers, but with a rendering state of its own. This allows disjoint
+	 * parts of the buffers to be rasterized concurrently.
+	 *
+	 * The view does not own the buffers and must be deleted before this
+	 * frame buffer.
+	 */
+	FrameBuffer *createView() const;
+
 	Graphics::PixelFormat getPixelFormat() {
 		return _pbufFormat;
 	}
@@ -734,6 +782,8 @@ public:
 
 private:
 
+	bool canUseTexturedSpanFunc(bool blending) const;
+
 	void fillLineFlatZ(ZBufferPoint *p1, ZBufferPoint *p2);
 	void fillLineInterpZ(ZBufferPoint *p1, ZBufferPoint *p2);
 	void fillLineFlat(ZBufferPoint *p1, ZBufferPoint *p2);
@@ -764,6 +814,7 @@ private:
 
 	uint *_zbuf;
 	byte *_sbuf;
+	bool _isView;
 
 	bool _enableStencil;
 	int _textureSize;
@@ -774,6 +825,7 @@ private:
 
 	const TexelBuffer *_currentTexture;
 	uint _wrapS, _wrapT;
+	TexturedSpanFunc _texturedSpanFunc;
 	bool _blendingEnabled;
 	int _sourceBlendingFactor;
 	int _destinationBlendingFactor;
@@ -24,6 +24,8 @@
 #include "graphics/tinygl/gl.h"
 
 #include "common/debug.h"
+#include "common/jobs.h"
+#include "common/system.h"
 
 namespace TinyGL {
 
@@ -187,20 +189,14 @@ void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas)
 	}
 
 	if (!rectangles.empty()) {
+		Common::Array<Common::Rect> clipRectangles;
 		for (RectangleIterator itRect = rectangles.begin(); itRect != rectangles.end(); ++itRect) {
 			dirtyAreas.push_back((*itRect).rectangle);
+			clipRectangles.push_back((*itRect).rectangle);
 		}
 
 		// Execute draw calls.
-		for (DrawCallIterator it = _drawCallsQueue.begin(); it != _drawCallsQueue.end(); ++it) {
-			Common::Rect drawCallRegion = (*it)->getDirtyRegion();
-			for (RectangleIterator itRect = rectangles.begin(); itRect != rectangles.end(); ++itRect) {
-				Common::Rect dirtyRegion = (*itRect).rectangle;
-				if (dirtyRegion.intersects(drawCallRegion)) {
-					(*it)->execute(dirtyRegion, true);
-				}
-			}
-		}
+		executeDrawCalls(&clipRectangles);
 
 		if (_debugRectsEnabled) {
 			// Draw debug rectangles.
@@ -239,8 +235,9 @@ void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
 
 	dirtyAreas.push_back(Common::Rect(fb->getPixelBufferWidth(), fb->getPixelBufferHeight()));
 
+	executeDrawCalls(nullptr);
+
 	for (DrawCallIterator it = _drawCallsQueue.begin(); it != _drawCallsQueue.end(); ++it) {
-		(*it)->execute(true);
 		delete *it;
 	}
 
@@ -251,6 +248,160 @@ void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
 	_drawCallAllocator[_currentAllocatorIndex].reset();
 }
 
+// Per band state for rasterizing a frame on several threads at once. Each band
+// draws to a view of the frame buffer, so that the scissor rectangle and the
+// rasterization state are not shared.
+struct RasterizationWorker {
+	GLContext context;
+	Common::Array<GLVertex> vertices;
+};
+
+struct RasterizationBands {
+	GLContext *c;
+	const Common::Array<DrawCall *> *drawCalls;
+	const Common::Array<Common::Rect> *clipRectangles;
+	int width, height;
+	int bandHeight;
+};
+
+// Bands smaller than this are not worth a job of their own
+static const int kMinRasterizationBandHeight = 16;
+
+static inline void _executeTile(const DrawCall *drawCall, RasterizationWorker *worker, const Common::Rect &tile) {
+	if (drawCall->getType() == DrawCall::DrawCall_Rasterization) {
+		((const RasterizationDrawCall *)drawCall)->executeTile(&worker->context, tile, worker->vertices);
+	} else {
+		((const ClearBufferDrawCall *)drawCall)->executeTile(&worker->context, tile);
+	}
+}
+
+static void _rasterizeBands(uint begin, uint end, void *refCon) {
+	const RasterizationBands *bands = (const RasterizationBands *)refCon;
+	const Common::Array<DrawCall *> &drawCalls = *bands->drawCalls;
+
+	for (uint band = begin; band < end; band++) {
+		RasterizationWorker *worker = bands->c->_rasterizationWorkers[band];
+		const int top = band * bands->bandHeight;
+		const Common::Rect bandRect(0, top, bands->width, MIN(top + bands->bandHeight, bands->height));
+
+		// The draw calls are executed in order within every band, so every pixel
+		// is drawn in exactly the same order as with a single thread.
+		for (uint i = 0; i < drawCalls.size(); i++) {
+			if (!bands->clipRectangles) {
+				_executeTile(drawCalls[i], worker, bandRect);
+				continue;
+			}
+
+			const Common::Rect drawCallRegion = drawCalls[i]->getDirtyRegion();
+			for (uint j = 0; j < bands->clipRectangles->size(); j++) {
+				const Common::Rect &dirtyRegion = (*bands->clipRectangles)[j];
+				if (!dirtyRegion.intersects(drawCallRegion))
+					continue;
+
+				const Common::Rect tile = dirtyRegion.findIntersectingRect(bandRect);
+				if (!tile.isEmpty())
+					_executeTile(drawCalls[i], worker, tile);
+			}
+		}
+	}
+}
+
+void GLContext::rasterizeTiles(const Common::Array<DrawCall *> &drawCalls, const Common::Array<Common::Rect> *clipRectangles) {
+	Common::JobSystem *jobs = g_system->getJobSystem();
+
+	RasterizationBands bands;
+	bands.c = this;
+	bands.drawCalls = &drawCalls;
+	bands.clipRectangles = clipRectangles;
+	bands.width = fb->getPixelBufferWidth();
+	bands.height = fb->getPixelBufferHeight();
+
+	// A couple of bands per thread, so that uneven scenes still balance out
+	const int numBands = CLIP<int>(bands.height / kMinRasterizationBandHeight, 1, jobs->getThreadCount() * 2);
+	bands.bandHeight = (bands.height + numBands - 1) / numBands;
+
+	while (_rasterizationWorkers.size() < (uint)numBands) {
+		RasterizationWorker *worker = new RasterizationWorker();
+		worker->context.fb = fb->createView();
+		_rasterizationWorkers.push_back(worker);
+	}
+
+	// The draw calls carry most of the state, except for the following
+	for (int i = 0; i < numBands; i++) {
+		GLContext &context = _rasterizationWorkers[i]->context;
+		context._textureSize = _textureSize;
+		context.current_cull_face = current_cull_face;
+		context.render_mode = render_mode;
+		context.vertex_n = vertex_n;
+	}
+
+	jobs->parallelFor(numBands, _rasterizeBands, &bands);
+}
+
+void GLContext::executeDrawCall(DrawCall *drawCall, const Common::Array<Common::Rect> *clipRectangles) {
+	if (!clipRectangles) {
+		drawCall->execute(true);
+		return;
+	}
+
+	Common::Rect drawCallRegion = drawCall->getDirtyRegion();
+	for (uint i = 0; i < clipRectangles->size(); i++) {
+		const Common::Rect &dirtyRegion = (*clipRectangles)[i];
+		if (dirtyRegion.intersects(drawCallRegion)) {
+			drawCall->execute(dirtyRegion, true);
+		}
+	}
+}
+
+void GLContext::executeDrawCalls(const Common::Array<Common::Rect> *clipRectangles) {
+	typedef Common::List<DrawCall *>::const_iterator DrawCallIterator;
+
+	// Selection and profiling update shared state, so they stay on this thread
+	Common::JobSystem *jobs = g_system->getJobSystem();
+	const bool tiled = jobs && jobs->getThreadCount() > 1 && render_mode != TGL_SELECT && !_profilingEnabled;
+
+	Common::Array<DrawCall *> batch;
+	bool batchHasRasterization = false;
+
+	DrawCallIterator it = _drawCallsQueue.begin();
+	while (true) {
+		const bool atEnd = (it == _drawCallsQueue.end());
+
+		// Blits go through the global context, so they act as barriers between
+		// the batches of draw calls rasterized in tiles.
+		if (!atEnd && tiled && (*it)->getType() != DrawCall::DrawCall_Blitting) {
+			batchHasRasterization |= (*it)->getType() == DrawCall::DrawCall_Rasterization;
+			batch.push_back(*it);
+			++it;
+			continue;
+		}
+
+		if (batchHasRasterization) {
+			rasterizeTiles(batch, clipRectangles);
+		} else {
+			for (uint i = 0; i < batch.size(); i++) {
+				executeDrawCall(batch[i], clipRectangles);
+			}
+		}
+		batch.clear();
+		batchHasRasterization = false;
+
+		if (atEnd)
+			break;
+
+		executeDrawCall(*it, clipRectangles);
+		++it;
+	}
+}
+
+void GLContext::disposeRasterizationWorkers() {
+	for (uint i = 0; i < _rasterizationWorkers.size(); i++) {
+		delete _rasterizationWorkers[i]->context.fb;
+		delete _rasterizationWorkers[i];
+	}
+	_rasterizationWorkers.clear();
+}
+
 void presentBuffer(Common::List<Common::Rect> &dirtyAreas) {
 	GLContext *c = gl_get_context();
 	if (c->_enableDirtyRectangles) {
@@ -265,6 +416,19 @@ void presentBuffer() {
 	presentBuffer(dirtyAreas);
 }
 
+void copyToScreen(const Common::List<Common::Rect> &dirtyAreas) {
+	GLContext *c = gl_get_context();
+	Graphics::Surface glBuffer;
+	c->fb->getSurfaceRef(glBuffer);
+
+	for (Common::List<Common::Rect>::const_iterator it = dirtyAreas.begin(); it != dirtyAreas.end(); ++it) {
+		if (it->isEmpty())
+			continue;
+		g_system->copyRectToScreen(glBuffer.getBasePtr(it->left, it->top), glBuffer.pitch,
+		                           it->left, it->top, it->width(), it->height());
+	}
+}
+
 bool DrawCall::operator==(const DrawCall &other) const {
 	if (_type == other._type) {
 		switch (_type) {
@@ -293,7 +457,7 @@ RasterizationDrawCall::RasterizationDrawCall() : DrawCall(DrawCall_Rasterization
 	_drawTriangleFront = c->draw_triangle_front;
 	_drawTriangleBack = c->draw_triangle_back;
 	memcpy(_vertex, c->vertex, sizeof(GLVertex) * _vertexCount);
-	_state = captureState();
+	_state = captureState(c);
 	if (c->_enableDirtyRectangles) {
 		computeDirtyRegion();
 	}
@@ -337,14 +501,40 @@ void RasterizationDrawCall::execute(bool restoreState) const {
 
 	RasterizationDrawCall::RasterizationState backupState;
 	if (restoreState) {
-		backupState = captureState();
+		backupState = captureState(c);
 	}
-	applyState(_state);
+	applyState(c, _state);
 
 	GLVertex *prevVertex = c->vertex;
 	int prevVertexCount = c->vertex_cnt;
 
 	c->vertex = _vertex;
+	draw(c);
+
+	c->vertex = prevVertex;
+	c->vertex_cnt = prevVertexCount;
+
+	if (restoreState) {
+		applyState(c, backupState);
+	}
+}
+
+void RasterizationDrawCall::executeTile(GLContext *c, const Common::Rect &clippingRectangle, Common::Array<GLVertex> &scratch) const {
+	if (scratch.size() < (uint)_vertexCount)
+		scratch.resize(_vertexCount);
+	memcpy(scratch.data(), _vertex, sizeof(GLVertex) * _vertexCount);
+
+	applyState(c, _state);
+	c->fb->setScissorRectangle(clippingRectangle);
+
+	c->vertex = scratch.data();
+	draw(c);
+	c->vertex = nullptr;
+
+	c->fb->resetScissorRectangle();
+}
+
+void RasterizationDrawCall::draw(GLContext *c) const {
 	c->vertex_cnt = _vertexCount;
 	c->draw_triangle_front = (gl_draw_triangle_func)_drawTriangleFront;
 	c->draw_triangle_back = (gl_draw_triangle_func)_drawTriangleBack;
@@ -423,18 +613,10 @@ void RasterizationDrawCall::execute(bool restoreState) const {
 	default:
 		error("glBegin: type %x not handled", c->begin_type);
 	}
-
-	c->vertex = prevVertex;
-	c->vertex_cnt = prevVertexCount;
-
-	if (restoreState) {
-		applyState(backupState);
-	}
 }
 
-RasterizationDrawCall::RasterizationState RasterizationDrawCall::captureState() const {
+RasterizationDrawCall::RasterizationState RasterizationDrawCall::captureState(GLContext *c) const {
 	RasterizationState state;
-	GLContext *c = gl_get_context();
 	state.enableBlending = c->blending_enabled;
 	state.sfactor = c->source_blending_factor;
 	state.dfactor = c->destination_blending_factor;
@@ -485,8 +667,7 @@ RasterizationDrawCall::RasterizationState RasterizationDrawCall::captureState()
 	return state;
 }
 
-void RasterizationDrawCall::applyState(const RasterizationDrawCall::RasterizationState &state) const {
-	GLContext *c = gl_get_context();
+void RasterizationDrawCall::applyState(GLContext *c, const RasterizationDrawCall::RasterizationState &state) const {
 	c->fb->enableBlending(state.enableBlending);
 	c->fb->setBlendingFactors(state.sfactor, state.dfactor);
 	c->fb->enableAlphaTest(state.alphaTestEnabled);
@@ -711,6 +892,21 @@ void ClearBufferDrawCall::execute(const Common::Rect &clippingRectangle, bool re
 	                   _clearStencilBuffer, _stencilValue);
 }
 
+void ClearBufferDrawCall::executeTile(GLContext *c, const Common::Rect &clippingRectangle) const {
+	// Without dirty rectangles, the whole buffer is cleared
+	Common::Rect clearRect = getDirtyRegion();
+	if (clearRect.isEmpty())
+		clearRect = Common::Rect(c->fb->getPixelBufferWidth(), c->fb->getPixelBufferHeight());
+
+	clearRect.clip(clippingRectangle);
+	if (clearRect.isEmpty())
+		return;
+
+	c->fb->clearRegion(clearRect.left, clearRect.top, clearRect.width(), clearRect.height(),
+	                   _clearZBuffer, _zValue, _clearColorBuffer, _rValue, _gValue, _bValue,
+	                   _clearStencilBuffer, _stencilValue);
+}
+
 bool ClearBufferDrawCall::operator==(const ClearBufferDrawCall &other) const {
 	return
 		_clearZBuffer == other._clearZBuffer &&
@@ -71,6 +71,9 @@ public:
 	virtual void execute(bool restoreState) const;
 	virtual void execute(const Common::Rect &clippingRectangle, bool restoreState) const;
 
+	// Clear the part of the buffers of a tile rasterization context which lies within the rectangle.
+	void executeTile(GLContext *c, const Common::Rect &clippingRectangle) const;
+
 	void *operator new(size_t size) {
 		return Internal::allocateFrame(size);
 	}
@@ -90,6 +93,11 @@ public:
 	virtual void execute(bool restoreState) const;
 	virtual void execute(const Common::Rect &clippingRectangle, bool restoreState) const;
 
+	// Rasterize the call on a tile rasterization context, clipped to the rectangle.
+	// The vertices are copied to the scratch array first, so that several tiles
+	// can be rasterized concurrently.
+	void executeTile(GLContext *c, const Common::Rect &clippingRectangle, Common::Array<GLVertex> &scratch) const;
+
 	void *operator new(size_t size) {
 		return Internal::allocateFrame(size);
 	}
@@ -97,6 +105,7 @@ public:
 	void operator delete(void *p) { }
 private:
 	void computeDirtyRegion();
+	void draw(GLContext *c) const;
 	typedef void (*gl_draw_triangle_func_ptr)(GLContext *c, TinyGL::GLVertex *p0, TinyGL::GLVertex *p1, TinyGL::GLVertex *p2);
 	int _vertexCount;
 	GLVertex *_vertex;
@@ -152,8 +161,8 @@ private:
 
 	RasterizationState _state;
 
-	RasterizationState captureState() const;
-	void applyState(const RasterizationState &state) const;
+	RasterizationState captureState(GLContext *c) const;
+	void applyState(GLContext *c, const RasterizationState &state) const;
 };
 
 // Encapsulate a blit call: it might execute either a color buffer or z buffer blit.
@@ -0,0 +1,188 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "graphics/tinygl/zbuffer.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace TinyGL {
+
+// Lanes holding base, base + step, base + 2 * step and base + 3 * step
+static FORCEINLINE uint32x4_t neon_ramp(uint base, uint step) {
+	const uint32 values[4] = { base, base + step, base + 2 * step, base + 3 * step };
+	return vld1q_u32(values);
+}
+
+static FORCEINLINE uint32x4_t neon_depthTest(int depthFunc, uint32x4_t zSrc, uint32x4_t zDst) {
+	switch (depthFunc) {
+	case TGL_LESS:
+		return vcltq_u32(zDst, zSrc);
+	case TGL_EQUAL:
+		return vceqq_u32(zDst, zSrc);
+	case TGL_LEQUAL:
+		return vcleq_u32(zDst, zSrc);
+	case TGL_GREATER:
+		return vcgtq_u32(zDst, zSrc);
+	case TGL_NOTEQUAL:
+		return vmvnq_u32(vceqq_u32(zDst, zSrc));
+	case TGL_GEQUAL:
+		return vcgeq_u32(zDst, zSrc);
+	case TGL_ALWAYS:
+		return vdupq_n_u32(0xFFFFFFFF);
+	default:
+		return vdupq_n_u32(0);
+	}
+}
+
+// 16 bit multiplication of the low halves, keeping only the low 16 bits of
+// the product like the SSE2 and generic code do
+static FORCEINLINE uint32x4_t neon_mul16(uint32x4_t a, uint32x4_t b) {
+	return vreinterpretq_u32_u16(vmulq_u16(vreinterpretq_u16_u32(a), vreinterpretq_u16_u32(b)));
+}
+
+// Modulate 8 bit channels by the interpolated 16.8 fixed point colors, keeping
+// the low 8 bits of the result like the generic code does
+static FORCEINLINE uint32x4_t neon_modulate(uint32x4_t channel, uint32x4_t light) {
+	light = vandq_u32(vshrq_n_u32(light, ZB_POINT_RED_BITS - 8), vdupq_n_u32(0xFFFF));
+	return vshrq_n_u32(neon_mul16(channel, light), ZB_POINT_RED_BITS - 8);
+}
+
+bool drawTexturedSpanNEON(const TexturedSpanBlock &block) {
+	uint32x4_t z[2], zDst[2], mask[2];
+	z[0] = neon_ramp(block.z, block.dzdx);
+	z[1] = vaddq_u32(z[0], vdupq_n_u32(block.dzdx * 4u));
+
+	int passed = 0;
+	for (int i = 0; i < 2; i++) {
+		zDst[i] = vld1q_u32(block.pz + i * 4);
+		mask[i] = neon_depthTest(block.depthFunc, z[i], zDst[i]);
+
+		uint32 lanes[4];
+		vst1q_u32(lanes, mask[i]);
+		for (int j = 0; j < 4; j++) {
+			if (lanes[j])
+				passed |= 1 << (i * 4 + j);
+		}
+	}
+
+	if (!passed)
+		return true;
+
+	// Texel lookups can't be vectorized, as they depend on the filtering
+	uint32 texels[kTexturedSpanBlockSize];
+	int s = block.s, t = block.t;
+	for (int i = 0; i < kTexturedSpanBlockSize; i++) {
+		if (passed & (1 << i)) {
+			uint8 a, r, g, b;
+			block.texture->getARGBAt(block.wrapS, block.wrapT, s, t, a, r, g, b);
+			texels[i] = (a << 24) | (r << 16) | (g << 8) | b;
+		} else {
+			texels[i] = 0;
+		}
+		s += block.dsdx;
+		t += block.dtdx;
+	}
+
+	const uint32x4_t byteMask = vdupq_n_u32(0xFF);
+	const int32x4_t aShift = vdupq_n_s32(block.aShift);
+	const int32x4_t rShift = vdupq_n_s32(block.rShift);
+	const int32x4_t gShift = vdupq_n_s32(block.gShift);
+	const int32x4_t bShift = vdupq_n_s32(block.bShift);
+
+	uint32x4_t r = neon_ramp(block.r, block.drdx);
+	uint32x4_t g = neon_ramp(block.g, block.dgdx);
+	uint32x4_t b = neon_ramp(block.b, block.dbdx);
+	uint32x4_t a = neon_ramp(block.a, block.dadx);
+
+	for (int i = 0; i < 2; i++) {
+		const uint32x4_t texel = vld1q_u32(texels + i * 4);
+		const uint32x4_t cA = neon_modulate(vshrq_n_u32(texel, 24), a);
+		const uint32x4_t cR = neon_modulate(vandq_u32(vshrq_n_u32(texel, 16), byteMask), r);
+		const uint32x4_t cG = neon_modulate(vandq_u32(vshrq_n_u32(texel, 8), byteMask), g);
+		const uint32x4_t cB = neon_modulate(vandq_u32(texel, byteMask), b);
+
+		const uint32x4_t dst = vld1q_u32(block.pixels + i * 4);
+		uint32x4_t color;
+		if (!block.blending) {
+			color = vorrq_u32(vorrq_u32(vshlq_u32(cR, rShift), vshlq_u32(cG, gShift)), vshlq_u32(cB, bShift));
+			if (block.hasAlpha)
+				color = vorrq_u32(color, vshlq_u32(cA, aShift));
+		} else {
+			// TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA
+			const uint32x4_t invA = vsubq_u32(byteMask, cA);
+			uint32x4_t dR = vandq_u32(vshlq_u32(dst, vnegq_s32(rShift)), byteMask);
+			uint32x4_t dG = vandq_u32(vshlq_u32(dst, vnegq_s32(gShift)), byteMask);
+			uint32x4_t dB = vandq_u32(vshlq_u32(dst, vnegq_s32(bShift)), byteMask);
+			dR = vaddq_u32(vshrq_n_u32(neon_mul16(dR, invA), 8), vshrq_n_u32(neon_mul16(cR, cA), 8));
+			dG = vaddq_u32(vshrq_n_u32(neon_mul16(dG, invA), 8), vshrq_n_u32(neon_mul16(cG, cA), 8));
+			dB = vaddq_u32(vshrq_n_u32(neon_mul16(dB, invA), 8), vshrq_n_u32(neon_mul16(cB, cA), 8));
+			dR = vminq_u32(dR, byteMask);
+			dG = vminq_u32(dG, byteMask);
+			dB = vminq_u32(dB, byteMask);
+			color = vorrq_u32(vorrq_u32(vshlq_u32(dR, rShift), vshlq_u32(dG, gShift)), vshlq_u32(dB, bShift));
+			if (block.hasAlpha)
+				color = vorrq_u32(color, vshlq_u32(byteMask, aShift));
+		}
+
+		vst1q_u32(block.pixels + i * 4, vbslq_u32(mask[i], color, dst));
+		if (block.depthWrite) {
+			// The generic code stores the depth through a float
+			const uint32x4_t zStore = vcvtq_u32_f32(vcvtq_f32_u32(z[i]));
+			vst1q_u32(block.pz + i * 4, vbslq_u32(mask[i], zStore, zDst[i]));
+		}
+
+		r = vaddq_u32(r, vdupq_n_u32(block.drdx * 4u));
+		g = vaddq_u32(g, vdupq_n_u32(block.dgdx * 4u));
+		b = vaddq_u32(b, vdupq_n_u32(block.dbdx * 4u));
+		a = vaddq_u32(a, vdupq_n_u32(block.dadx * 4u));
+	}
+
+	return true;
+}
+
+} // End of namespace TinyGL
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
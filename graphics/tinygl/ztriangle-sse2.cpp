@@ -0,0 +1,184 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/tinygl/zbuffer.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace TinyGL {
+
+// Lanes holding base, base + step, base + 2 * step and base + 3 * step
+static FORCEINLINE __m128i sse2_ramp(uint base, uint step) {
+	return _mm_set_epi32(base + 3 * step, base + 2 * step, base + step, base);
+}
+
+static FORCEINLINE __m128i sse2_depthTest(int depthFunc, __m128i zSrc, __m128i zDst) {
+	// There are no unsigned comparisons in SSE2
+	const __m128i bias = _mm_set1_epi32((int)0x80000000);
+	const __m128i src = _mm_xor_si128(zSrc, bias);
+	const __m128i dst = _mm_xor_si128(zDst, bias);
+	const __m128i ones = _mm_set1_epi32(-1);
+
+	switch (depthFunc) {
+	case TGL_LESS:
+		return _mm_cmpgt_epi32(src, dst);
+	case TGL_EQUAL:
+		return _mm_cmpeq_epi32(src, dst);
+	case TGL_LEQUAL:
+		return _mm_xor_si128(_mm_cmpgt_epi32(dst, src), ones);
+	case TGL_GREATER:
+		return _mm_cmpgt_epi32(dst, src);
+	case TGL_NOTEQUAL:
+		return _mm_xor_si128(_mm_cmpeq_epi32(src, dst), ones);
+	case TGL_GEQUAL:
+		return _mm_xor_si128(_mm_cmpgt_epi32(src, dst), ones);
+	case TGL_ALWAYS:
+		return ones;
+	default:
+		return _mm_setzero_si128();
+	}
+}
+
+// Modulate 8 bit channels by the interpolated 16.8 fixed point colors, keeping
+// the low 8 bits of the result like the generic code does
+static FORCEINLINE __m128i sse2_modulate(__m128i channel, __m128i light) {
+	light = _mm_and_si128(_mm_srli_epi32(light, ZB_POINT_RED_BITS - 8), _mm_set1_epi32(0xFFFF));
+	return _mm_srli_epi32(_mm_mullo_epi16(channel, light), ZB_POINT_RED_BITS - 8);
+}
+
+static FORCEINLINE __m128i sse2_select(__m128i mask, __m128i a, __m128i b) {
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+bool drawTexturedSpanSSE2(const TexturedSpanBlock &block) {
+	__m128i z[2], zDst[2], mask[2];
+	z[0] = sse2_ramp(block.z, block.dzdx);
+	z[1] = _mm_add_epi32(z[0], _mm_set1_epi32(block.dzdx * 4u));
+
+	int passed = 0;
+	for (int i = 0; i < 2; i++) {
+		zDst[i] = _mm_loadu_si128((const __m128i *)(block.pz + i * 4));
+		mask[i] = sse2_depthTest(block.depthFunc, z[i], zDst[i]);
+		passed |= _mm_movemask_ps(_mm_castsi128_ps(mask[i])) << (i * 4);
+	}
+
+	if (!passed)
+		return true;
+
+	// The generic code stores the depth through a float. Only signed
+	// integers can be converted exactly in SSE2, so leave huge depths to it.
+	if (block.depthWrite && (_mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(mask[0], z[0]))) |
+	                         _mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(mask[1], z[1])))))
+		return false;
+
+	// Texel lookups can't be vectorized, as they depend on the filtering
+	uint32 texels[kTexturedSpanBlockSize];
+	int s = block.s, t = block.t;
+	for (int i = 0; i < kTexturedSpanBlockSize; i++) {
+		if (passed & (1 << i)) {
+			uint8 a, r, g, b;
+			block.texture->getARGBAt(block.wrapS, block.wrapT, s, t, a, r, g, b);
+			texels[i] = (a << 24) | (r << 16) | (g << 8) | b;
+		} else {
+			texels[i] = 0;
+		}
+		s += block.dsdx;
+		t += block.dtdx;
+	}
+
+	const __m128i byteMask = _mm_set1_epi32(0xFF);
+	const __m128i aShift = _mm_cvtsi32_si128(block.aShift);
+	const __m128i rShift = _mm_cvtsi32_si128(block.rShift);
+	const __m128i gShift = _mm_cvtsi32_si128(block.gShift);
+	const __m128i bShift = _mm_cvtsi32_si128(block.bShift);
+
+	__m128i r = sse2_ramp(block.r, block.drdx);
+	__m128i g = sse2_ramp(block.g, block.dgdx);
+	__m128i b = sse2_ramp(block.b, block.dbdx);
+	__m128i a = sse2_ramp(block.a, block.dadx);
+
+	for (int i = 0; i < 2; i++) {
+		const __m128i texel = _mm_loadu_si128((const __m128i *)(texels + i * 4));
+		const __m128i cA = sse2_modulate(_mm_srli_epi32(texel, 24), a);
+		const __m128i cR = sse2_modulate(_mm_and_si128(_mm_srli_epi32(texel, 16), byteMask), r);
+		const __m128i cG = sse2_modulate(_mm_and_si128(_mm_srli_epi32(texel, 8), byteMask), g);
+		const __m128i cB = sse2_modulate(_mm_and_si128(texel, byteMask), b);
+
+		const __m128i dst = _mm_loadu_si128((const __m128i *)(block.pixels + i * 4));
+		__m128i color;
+		if (!block.blending) {
+			color = _mm_or_si128(_mm_or_si128(_mm_sll_epi32(cR, rShift), _mm_sll_epi32(cG, gShift)), _mm_sll_epi32(cB, bShift));
+			if (block.hasAlpha)
+				color = _mm_or_si128(color, _mm_sll_epi32(cA, aShift));
+		} else {
+			// TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA
+			const __m128i invA = _mm_sub_epi32(byteMask, cA);
+			__m128i dR = _mm_and_si128(_mm_srl_epi32(dst, rShift), byteMask);
+			__m128i dG = _mm_and_si128(_mm_srl_epi32(dst, gShift), byteMask);
+			__m128i dB = _mm_and_si128(_mm_srl_epi32(dst, bShift), byteMask);
+			dR = _mm_add_epi32(_mm_srli_epi32(_mm_mullo_epi16(dR, invA), 8), _mm_srli_epi32(_mm_mullo_epi16(cR, cA), 8));
+			dG = _mm_add_epi32(_mm_srli_epi32(_mm_mullo_epi16(dG, invA), 8), _mm_srli_epi32(_mm_mullo_epi16(cG, cA), 8));
+			dB = _mm_add_epi32(_mm_srli_epi32(_mm_mullo_epi16(dB, invA), 8), _mm_srli_epi32(_mm_mullo_epi16(cB, cA), 8));
+			dR = _mm_min_epi16(dR, byteMask);
+			dG = _mm_min_epi16(dG, byteMask);
+			dB = _mm_min_epi16(dB, byteMask);
+			color = _mm_or_si128(_mm_or_si128(_mm_sll_epi32(dR, rShift), _mm_sll_epi32(dG, gShift)), _mm_sll_epi32(dB, bShift));
+			if (block.hasAlpha)
+				color = _mm_or_si128(color, _mm_sll_epi32(byteMask, aShift));
+		}
+
+		_mm_storeu_si128((__m128i *)(block.pixels + i * 4), sse2_select(mask[i], color, dst));
+		if (block.depthWrite) {
+			const __m128i zStore = _mm_cvttps_epi32(_mm_cvtepi32_ps(z[i]));
+			_mm_storeu_si128((__m128i *)(block.pz + i * 4), sse2_select(mask[i], zStore, zDst[i]));
+		}
+
+		r = _mm_add_epi32(r, _mm_set1_epi32(block.drdx * 4u));
+		g = _mm_add_epi32(g, _mm_set1_epi32(block.dgdx * 4u));
+		b = _mm_add_epi32(b, _mm_set1_epi32(block.dbdx * 4u));
+		a = _mm_add_epi32(a, _mm_set1_epi32(block.dadx * 4u));
+	}
+
+	return true;
+}
+
+} // End of namespace TinyGL
+
+#if !defined(__x86_64__)
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+#endif
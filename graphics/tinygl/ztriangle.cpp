@@ -33,6 +33,7 @@
 namespace TinyGL {
 
 static const int NB_INTERP = 8;
+STATIC_ASSERT(NB_INTERP == kTexturedSpanBlockSize, textured_span_blocks_must_match_the_interpolation_steps);
 
 static bool applyStipplePattern(int x, int y, const byte *stipple) {
 
@@ -347,6 +348,31 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 		ndtzdx = NB_INTERP * dtzdx;
 	}
 
+	// The SIMD kernels only cover the most common textured cases
+	const bool kUseSpanFunc = kInterpRGB && kInterpZ && (kInterpST || kInterpSTZ) && kDepthTestEnabled &&
+	                          !kFogMode && !kAlphaTestEnabled && !kStencilEnabled;
+	TexturedSpanBlock spanBlock;
+	bool useSpanFunc = false;
+	if (kUseSpanFunc && canUseTexturedSpanFunc(kBlendingEnabled)) {
+		useSpanFunc = true;
+		spanBlock.texture = _currentTexture;
+		spanBlock.wrapS = _wrapS;
+		spanBlock.wrapT = _wrapT;
+		spanBlock.dzdx = dzdx;
+		spanBlock.drdx = kSmoothMode ? drdx : 0;
+		spanBlock.dgdx = kSmoothMode ? dgdx : 0;
+		spanBlock.dbdx = kSmoothMode ? dbdx : 0;
+		spanBlock.dadx = kSmoothMode ? dadx : 0;
+		spanBlock.depthFunc = _depthFunc;
+		spanBlock.depthWrite = kDepthWrite;
+		spanBlock.blending = kBlendingEnabled;
+		spanBlock.hasAlpha = _pbufFormat.aLoss == 0;
+		spanBlock.aShift = _pbufFormat.aShift;
+		spanBlock.rShift = _pbufFormat.rShift;
+		spanBlock.gShift = _pbufFormat.gShift;
+		spanBlock.bShift = _pbufFormat.bShift;
+	}
+
 	if (fz0 > 0) {
 		l1 = p0;
 		l2 = p2;
@@ -445,129 +471,186 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 
 		// we draw all the scan line of the part
 		while (nb_lines > 0) {
-			int x = x1;
-			if (!kInterpRGB) {
-				int n;
-				uint *pz;
-				byte *ps = nullptr;
-				uint z;
-				n = (x2 >> 16) - x1;
-				if (kInterpZ) {
-					pz = pz1 + x1;
-					z = z1;
-				}
-				if (kStencilEnabled) {
-					ps = ps1 + x1;
-				}
-				while (n >= 3) {
-					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, 0, x, y, z, dzdx);
-					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, 1, x, y, z, dzdx);
-					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, 2, x, y, z, dzdx);
-					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, 3, x, y, z, dzdx);
+			// Rows outside of the scissor rectangle only need the edges to be stepped
+			if (!kEnableScissor || (y >= _clipRectangle.top && y < _clipRectangle.bottom)) {
+				int x = x1;
+				if (!kInterpRGB) {
+					int n;
+					uint *pz;
+					byte *ps = nullptr;
+					uint z;
+					n = (x2 >> 16) - x1;
 					if (kInterpZ) {
-						pz += 4;
+						pz = pz1 + x1;
+						z = z1;
 					}
 					if (kStencilEnabled) {
-						ps += 4;
+						ps = ps1 + x1;
 					}
-					n -= 4;
-					x += 4;
-				}
-				while (n >= 0) {
-					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, 0, x, y, z, dzdx);
-					if (kInterpZ) {
-						pz += 1;
+					while (n >= 3) {
+						putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, 0, x, y, z, dzdx);
+						putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, 1, x, y, z, dzdx);
+						putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, 2, x, y, z, dzdx);
+						putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, 3, x, y, z, dzdx);
+						if (kInterpZ) {
+							pz += 4;
+						}
+						if (kStencilEnabled) {
+							ps += 4;
+						}
+						n -= 4;
+						x += 4;
 					}
-					if (kStencilEnabled) {
-						ps += 1;
+					while (n >= 0) {
+						putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, 0, x, y, z, dzdx);
+						if (kInterpZ) {
+							pz += 1;
+						}
+						if (kStencilEnabled) {
+							ps += 1;
+						}
+						n -= 1;
+						x += 1;
+					}
+				} else if (!(kInterpST || kInterpSTZ)) {
+					uint *pz;
+					byte *ps = nullptr;
+					int pp;
+					uint z, r, g, b, a, fog;
+					int n = (x2 >> 16) - x1;
+					pp = pp1 + x1;
+					r = r1;
+					g = g1;
+					b = b1;
+					a = a1;
+					if (kFogMode) {
+						fog = f1;
 					}
-					n -= 1;
-					x += 1;
-				}
-			} else if (!(kInterpST || kInterpSTZ)) {
-				uint *pz;
-				byte *ps = nullptr;
-				int pp;
-				uint z, r, g, b, a, fog;
-				int n = (x2 >> 16) - x1;
-				pp = pp1 + x1;
-				r = r1;
-				g = g1;
-				b = b1;
-				a = a1;
-				if (kFogMode) {
-					fog = f1;
-				}
-				if (kInterpZ) {
-					pz = pz1 + x1;
-					z = z1;
-				}
-				if (kStencilEnabled) {
-					ps = ps1 + x1;
-				}
-				while (n >= 3) {
-					putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
-					                 (pp, pz, ps, 0, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
-					putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
-					                 (pp, pz, ps, 1, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
-					putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
-					                 (pp, pz, ps, 2, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
-					putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
-					                 (pp, pz, ps, 3, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
-					pp += 4;
 					if (kInterpZ) {
-						pz += 4;
+						pz = pz1 + x1;
+						z = z1;
 					}
 					if (kStencilEnabled) {
-						ps += 4;
+						ps = ps1 + x1;
+					}
+					while (n >= 3) {
+						putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
+						                 (pp, pz, ps, 0, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
+						                 (pp, pz, ps, 1, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
+						                 (pp, pz, ps, 2, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
+						                 (pp, pz, ps, 3, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						pp += 4;
+						if (kInterpZ) {
+							pz += 4;
+						}
+						if (kStencilEnabled) {
+							ps += 4;
+						}
+						n -= 4;
+						x += 4;
+					}
+					while (n >= 0) {
+						putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
+						                 (pp, pz, ps, 0, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						pp += 1;
+						if (kInterpZ) {
+							pz += 1;
+						}
+						if (kStencilEnabled) {
+							ps += 1;
+						}
+						n -= 1;
+						x += 1;
+					}
+				} else if (kInterpST || kInterpSTZ) {
+					uint *pz;
+					byte *ps = nullptr;
+					int s, t;
+					uint z, r, g, b, a, fog;
+					int n, pp;
+					float sz, tz, fz, zinv;
+					int dsdx, dtdx;
+
+					n = (x2 >> 16) - x1;
+					fz = (float)z1;
+					zinv = (float)(1.0 / fz);
+
+					pp = pp1 + x1;
+					if (kFogMode) {
+						fog = f1;
 					}
-					n -= 4;
-					x += 4;
-				}
-				while (n >= 0) {
-					putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
-					                 (pp, pz, ps, 0, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
-					pp += 1;
 					if (kInterpZ) {
-						pz += 1;
+						pz = pz1 + x1;
+						z = z1;
 					}
 					if (kStencilEnabled) {
-						ps += 1;
+						ps = ps1 + x1;
 					}
-					n -= 1;
-					x += 1;
-				}
-			} else if (kInterpST || kInterpSTZ) {
-				uint *pz;
-				byte *ps = nullptr;
-				int s, t;
-				uint z, r, g, b, a, fog;
-				int n, pp;
-				float sz, tz, fz, zinv;
-				int dsdx, dtdx;
-
-				n = (x2 >> 16) - x1;
-				fz = (float)z1;
-				zinv = (float)(1.0 / fz);
-
-				pp = pp1 + x1;
-				if (kFogMode) {
-					fog = f1;
-				}
-				if (kInterpZ) {
-					pz = pz1 + x1;
-					z = z1;
-				}
-				if (kStencilEnabled) {
-					ps = ps1 + x1;
-				}
-				sz = sz1;
-				tz = tz1;
-				r = r1;
-				g = g1;
-				b = b1;
-				a = a1;
-				while (n >= (NB_INTERP - 1)) {
+					sz = sz1;
+					tz = tz1;
+					r = r1;
+					g = g1;
+					b = b1;
+					a = a1;
+					while (n >= (NB_INTERP - 1)) {
+						{
+							float ss, tt;
+							ss = sz * zinv;
+							tt = tz * zinv;
+							s = (int)ss;
+							t = (int)tt;
+							dsdx = (int)((dszdx - ss * fdzdx) * zinv);
+							dtdx = (int)((dtzdx - tt * fdzdx) * zinv);
+							fz += fndzdx;
+							zinv = (float)(1.0 / fz);
+						}
+						bool drawn = false;
+						if (kUseSpanFunc && useSpanFunc && (!kEnableScissor || (x >= _clipRectangle.left && x + NB_INTERP <= _clipRectangle.right))) {
+							spanBlock.pixels = (uint32 *)_pbuf + pp;
+							spanBlock.pz = pz;
+							spanBlock.s = s;
+							spanBlock.t = t;
+							spanBlock.dsdx = dsdx;
+							spanBlock.dtdx = dtdx;
+							spanBlock.z = z;
+							spanBlock.r = r;
+							spanBlock.g = g;
+							spanBlock.b = b;
+							spanBlock.a = a;
+							drawn = _texturedSpanFunc(spanBlock);
+						}
+						if (drawn) {
+							z += (uint)dzdx * NB_INTERP;
+							s += dsdx * NB_INTERP;
+							t += dtdx * NB_INTERP;
+							if (kSmoothMode) {
+								r += (uint)drdx * NB_INTERP;
+								g += (uint)dgdx * NB_INTERP;
+								b += (uint)dbdx * NB_INTERP;
+								a += dadx * NB_INTERP;
+							}
+						} else {
+							for (int _a = 0; _a < NB_INTERP; _a++) {
+								putPixelTexture<kDepthWrite, kInterpRGB, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
+								               (pp, texture, _wrapS, _wrapT, pz, ps, _a, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+							}
+						}
+						pp += NB_INTERP;
+						if (kInterpZ) {
+							pz += NB_INTERP;
+						}
+						if (kStencilEnabled) {
+							ps += NB_INTERP;
+						}
+						sz += ndszdx;
+						tz += ndtzdx;
+						n -= NB_INTERP;
+						x += NB_INTERP;
+					}
+
 					{
 						float ss, tt;
 						ss = sz * zinv;
@@ -576,48 +659,21 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 						t = (int)tt;
 						dsdx = (int)((dszdx - ss * fdzdx) * zinv);
 						dtdx = (int)((dtzdx - tt * fdzdx) * zinv);
-						fz += fndzdx;
-						zinv = (float)(1.0 / fz);
-					}
-					for (int _a = 0; _a < NB_INTERP; _a++) {
-						putPixelTexture<kDepthWrite, kInterpRGB, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
-						               (pp, texture, _wrapS, _wrapT, pz, ps, _a, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
-					}
-					pp += NB_INTERP;
-					if (kInterpZ) {
-						pz += NB_INTERP;
 					}
-					if (kStencilEnabled) {
-						ps += NB_INTERP;
-					}
-					sz += ndszdx;
-					tz += ndtzdx;
-					n -= NB_INTERP;
-					x += NB_INTERP;
-				}
-
-				{
-					float ss, tt;
-					ss = sz * zinv;
-					tt = tz * zinv;
-					s = (int)ss;
-					t = (int)tt;
-					dsdx = (int)((dszdx - ss * fdzdx) * zinv);
-					dtdx = (int)((dtzdx - tt * fdzdx) * zinv);
-				}
 
-				while (n >= 0) {
-					putPixelTexture<kDepthWrite, kInterpRGB, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
-					               (pp, texture, _wrapS, _wrapT, pz, ps, 0, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
-					pp += 1;
-					if (kInterpZ) {
-						pz += 1;
-					}
-					if (kStencilEnabled) {
-						ps += 1;
+					while (n >= 0) {
+						putPixelTexture<kDepthWrite, kInterpRGB, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
+						               (pp, texture, _wrapS, _wrapT, pz, ps, 0, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						pp += 1;
+						if (kInterpZ) {
+							pz += 1;
+						}
+						if (kStencilEnabled) {
+							ps += 1;
+						}
+						n -= 1;
+						x += 1;
 					}
-					n -= 1;
-					x += 1;
 				}
 			}
 
@@ -0,0 +1,123 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace Graphics {
+
+// Multiply chroma values in 16 bit lanes by one of the fixed point factors,
+// truncating towards zero like the lookup tables
+static FORCEINLINE __m256i avx2_scaleChroma(__m256i c, int factor) {
+	const __m256i x = _mm256_sub_epi16(c, _mm256_set1_epi16(128));
+	const __m256i product = _mm256_mulhi_epu16(_mm256_slli_epi16(_mm256_abs_epi16(x), 1), _mm256_set1_epi16((int16)factor));
+	return _mm256_sign_epi16(product, x);
+}
+
+static FORCEINLINE __m256i avx2_clipLuminance(__m256i c, bool itu, __m128i loss) {
+	if (itu) {
+		c = _mm256_min_epi16(_mm256_max_epi16(c, _mm256_set1_epi16(16)), _mm256_set1_epi16(235));
+		c = _mm256_mulhi_epu16(_mm256_slli_epi16(_mm256_sub_epi16(c, _mm256_set1_epi16(16)), 3), _mm256_set1_epi16((int16)kYUVToRGBITUScale));
+	} else {
+		c = _mm256_min_epi16(_mm256_max_epi16(c, _mm256_setzero_si256()), _mm256_set1_epi16(255));
+	}
+	return _mm256_srl_epi16(c, loss);
+}
+
+static FORCEINLINE __m256i avx2_shiftChannel32(__m256i c, bool high, __m128i shift) {
+	const __m256i wide = _mm256_cvtepu16_epi32(high ? _mm256_extracti128_si256(c, 1) : _mm256_castsi256_si128(c));
+	return _mm256_sll_epi32(wide, shift);
+}
+
+// Convert sixteen pixels, with one chroma sample each
+static FORCEINLINE void avx2_convert16(byte *dst, __m128i y8, __m128i u8, __m128i v8, const YUVToRGBRowFormat &format) {
+	const __m256i y = _mm256_cvtepu8_epi16(y8);
+	const __m256i u = _mm256_cvtepu8_epi16(u8);
+	const __m256i v = _mm256_cvtepu8_epi16(v8);
+
+	const __m256i r = avx2_clipLuminance(_mm256_add_epi16(y, avx2_scaleChroma(v, kYUVToRGBCrR)), format.itu, _mm_cvtsi32_si128(format.rLoss));
+	const __m256i g = avx2_clipLuminance(_mm256_sub_epi16(_mm256_sub_epi16(y, avx2_scaleChroma(v, kYUVToRGBCrG)), avx2_scaleChroma(u, kYUVToRGBCbG)), format.itu, _mm_cvtsi32_si128(format.gLoss));
+	const __m256i b = avx2_clipLuminance(_mm256_add_epi16(y, avx2_scaleChroma(u, kYUVToRGBCbB)), format.itu, _mm_cvtsi32_si128(format.bLoss));
+
+	const __m128i rShift = _mm_cvtsi32_si128(format.rShift);
+	const __m128i gShift = _mm_cvtsi32_si128(format.gShift);
+	const __m128i bShift = _mm_cvtsi32_si128(format.bShift);
+
+	if (format.bytesPerPixel == 2) {
+		const __m256i pixels = _mm256_or_si256(_mm256_or_si256(_mm256_sll_epi16(r, rShift), _mm256_sll_epi16(g, gShift)),
+		                                       _mm256_or_si256(_mm256_sll_epi16(b, bShift), _mm256_set1_epi16((int16)format.aMask)));
+		_mm256_storeu_si256((__m256i *)dst, pixels);
+	} else {
+		const __m256i aMask = _mm256_set1_epi32(format.aMask);
+		for (int i = 0; i < 2; i++) {
+			const __m256i pixels = _mm256_or_si256(_mm256_or_si256(avx2_shiftChannel32(r, i, rShift), avx2_shiftChannel32(g, i, gShift)),
+			                                       _mm256_or_si256(avx2_shiftChannel32(b, i, bShift), aMask));
+			_mm256_storeu_si256((__m256i *)(dst + i * 32), pixels);
+		}
+	}
+}
+
+void convertYUVToRGBRowAVX2(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, int chromaShift, const YUVToRGBRowFormat &format) {
+	int x = 0;
+	for (; x + 32 <= width; x += 32) {
+		// Bring the chroma to one sample per pixel
+		__m128i u[2], v[2];
+		if (chromaShift) {
+			const __m128i uHalf = _mm_loadu_si128((const __m128i *)(uSrc + x / 2));
+			const __m128i vHalf = _mm_loadu_si128((const __m128i *)(vSrc + x / 2));
+			u[0] = _mm_unpacklo_epi8(uHalf, uHalf);
+			u[1] = _mm_unpackhi_epi8(uHalf, uHalf);
+			v[0] = _mm_unpacklo_epi8(vHalf, vHalf);
+			v[1] = _mm_unpackhi_epi8(vHalf, vHalf);
+		} else {
+			for (int i = 0; i < 2; i++) {
+				u[i] = _mm_loadu_si128((const __m128i *)(uSrc + x + i * 16));
+				v[i] = _mm_loadu_si128((const __m128i *)(vSrc + x + i * 16));
+			}
+		}
+
+		for (int i = 0; i < 2; i++) {
+			const __m128i y = _mm_loadu_si128((const __m128i *)(ySrc + x + i * 16));
+			avx2_convert16(dst + (x + i * 16) * format.bytesPerPixel, y, u[i], v[i], format);
+		}
+	}
+
+	if (x < width)
+		convertYUVToRGBRowGeneric(dst + x * format.bytesPerPixel, ySrc + x, uSrc + (x >> chromaShift), vSrc + (x >> chromaShift), width - x, chromaShift, format);
+}
+
+} // End of namespace Graphics
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
@@ -0,0 +1,141 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Graphics {
+
+static inline uint16x8_t neon_mulhi(uint16x8_t a, uint16_t b) {
+	const uint32x4_t lo = vmull_n_u16(vget_low_u16(a), b);
+	const uint32x4_t hi = vmull_n_u16(vget_high_u16(a), b);
+	return vcombine_u16(vshrn_n_u32(lo, 16), vshrn_n_u32(hi, 16));
+}
+
+// Multiply chroma values by one of the fixed point factors, truncating
+// towards zero like the lookup tables
+static inline int16x8_t neon_scaleChroma(uint16x8_t c, int factor) {
+	const int16x8_t x = vsubq_s16(vreinterpretq_s16_u16(c), vdupq_n_s16(128));
+	const uint16x8_t absX = vreinterpretq_u16_s16(vabsq_s16(x));
+	const int16x8_t product = vreinterpretq_s16_u16(neon_mulhi(vshlq_n_u16(absX, 1), factor));
+	return vbslq_s16(vcltq_s16(x, vdupq_n_s16(0)), vnegq_s16(product), product);
+}
+
+static inline uint16x8_t neon_clipLuminance(int16x8_t c, bool itu, byte loss) {
+	uint16x8_t clipped;
+	if (itu) {
+		c = vminq_s16(vmaxq_s16(c, vdupq_n_s16(16)), vdupq_n_s16(235));
+		clipped = vreinterpretq_u16_s16(vsubq_s16(c, vdupq_n_s16(16)));
+		clipped = neon_mulhi(vshlq_n_u16(clipped, 3), kYUVToRGBITUScale);
+	} else {
+		clipped = vreinterpretq_u16_s16(vminq_s16(vmaxq_s16(c, vdupq_n_s16(0)), vdupq_n_s16(255)));
+	}
+	return vshlq_u16(clipped, vdupq_n_s16(-loss));
+}
+
+// Convert eight pixels, with one chroma sample each
+static inline void neon_convert8(byte *dst, uint8x8_t y8, uint8x8_t u8, uint8x8_t v8, const YUVToRGBRowFormat &format) {
+	const int16x8_t y = vreinterpretq_s16_u16(vmovl_u8(y8));
+	const uint16x8_t u = vmovl_u8(u8);
+	const uint16x8_t v = vmovl_u8(v8);
+
+	const uint16x8_t r = neon_clipLuminance(vaddq_s16(y, neon_scaleChroma(v, kYUVToRGBCrR)), format.itu, format.rLoss);
+	const uint16x8_t g = neon_clipLuminance(vsubq_s16(vsubq_s16(y, neon_scaleChroma(v, kYUVToRGBCrG)), neon_scaleChroma(u, kYUVToRGBCbG)), format.itu, format.gLoss);
+	const uint16x8_t b = neon_clipLuminance(vaddq_s16(y, neon_scaleChroma(u, kYUVToRGBCbB)), format.itu, format.bLoss);
+
+	if (format.bytesPerPixel == 2) {
+		uint16x8_t pixels = vorrq_u16(vshlq_u16(r, vdupq_n_s16(format.rShift)), vshlq_u16(g, vdupq_n_s16(format.gShift)));
+		pixels = vorrq_u16(pixels, vorrq_u16(vshlq_u16(b, vdupq_n_s16(format.bShift)), vdupq_n_u16(format.aMask)));
+		vst1q_u16((uint16 *)dst, pixels);
+	} else {
+		const int32x4_t rShift = vdupq_n_s32(format.rShift);
+		const int32x4_t gShift = vdupq_n_s32(format.gShift);
+		const int32x4_t bShift = vdupq_n_s32(format.bShift);
+		const uint32x4_t aMask = vdupq_n_u32(format.aMask);
+
+		uint32x4_t lo = vorrq_u32(vshlq_u32(vmovl_u16(vget_low_u16(r)), rShift), vshlq_u32(vmovl_u16(vget_low_u16(g)), gShift));
+		lo = vorrq_u32(lo, vorrq_u32(vshlq_u32(vmovl_u16(vget_low_u16(b)), bShift), aMask));
+		uint32x4_t hi = vorrq_u32(vshlq_u32(vmovl_u16(vget_high_u16(r)), rShift), vshlq_u32(vmovl_u16(vget_high_u16(g)), gShift));
+		hi = vorrq_u32(hi, vorrq_u32(vshlq_u32(vmovl_u16(vget_high_u16(b)), bShift), aMask));
+
+		vst1q_u32((uint32 *)dst, lo);
+		vst1q_u32((uint32 *)(dst + 16), hi);
+	}
+}
+
+void convertYUVToRGBRowNEON(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, int chromaShift, const YUVToRGBRowFormat &format) {
+	int x = 0;
+	for (; x + 16 <= width; x += 16) {
+		// Bring the chroma to one sample per pixel
+		uint8x8x2_t u, v;
+		if (chromaShift) {
+			const uint8x8_t uHalf = vld1_u8(uSrc + x / 2);
+			const uint8x8_t vHalf = vld1_u8(vSrc + x / 2);
+			u = vzip_u8(uHalf, uHalf);
+			v = vzip_u8(vHalf, vHalf);
+		} else {
+			const uint8x16_t uFull = vld1q_u8(uSrc + x);
+			const uint8x16_t vFull = vld1q_u8(vSrc + x);
+			u.val[0] = vget_low_u8(uFull);
+			u.val[1] = vget_high_u8(uFull);
+			v.val[0] = vget_low_u8(vFull);
+			v.val[1] = vget_high_u8(vFull);
+		}
+		const uint8x16_t y = vld1q_u8(ySrc + x);
+
+		byte *out = dst + x * format.bytesPerPixel;
+		neon_convert8(out, vget_low_u8(y), u.val[0], v.val[0], format);
+		neon_convert8(out + 8 * format.bytesPerPixel, vget_high_u8(y), u.val[1], v.val[1], format);
+	}
+
+	if (x < width)
+		convertYUVToRGBRowGeneric(dst + x * format.bytesPerPixel, ySrc + x, uSrc + (x >> chromaShift), vSrc + (x >> chromaShift), width - x, chromaShift, format);
+}
+
+} // End of namespace Graphics
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
@@ -0,0 +1,125 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Graphics {
+
+// Multiply chroma values in 16 bit lanes by one of the fixed point factors,
+// truncating towards zero like the lookup tables
+static FORCEINLINE __m128i sse2_scaleChroma(__m128i c, int factor) {
+	const __m128i x = _mm_sub_epi16(c, _mm_set1_epi16(128));
+	const __m128i sign = _mm_srai_epi16(x, 15);
+	const __m128i absX = _mm_sub_epi16(_mm_xor_si128(x, sign), sign);
+	const __m128i product = _mm_mulhi_epu16(_mm_slli_epi16(absX, 1), _mm_set1_epi16((int16)factor));
+	return _mm_sub_epi16(_mm_xor_si128(product, sign), sign);
+}
+
+static FORCEINLINE __m128i sse2_clipLuminance(__m128i c, bool itu, __m128i loss) {
+	if (itu) {
+		c = _mm_min_epi16(_mm_max_epi16(c, _mm_set1_epi16(16)), _mm_set1_epi16(235));
+		c = _mm_mulhi_epu16(_mm_slli_epi16(_mm_sub_epi16(c, _mm_set1_epi16(16)), 3), _mm_set1_epi16((int16)kYUVToRGBITUScale));
+	} else {
+		c = _mm_min_epi16(_mm_max_epi16(c, _mm_setzero_si128()), _mm_set1_epi16(255));
+	}
+	return _mm_srl_epi16(c, loss);
+}
+
+static FORCEINLINE __m128i sse2_shiftChannel32(__m128i c, bool high, __m128i shift) {
+	const __m128i wide = high ? _mm_unpackhi_epi16(c, _mm_setzero_si128()) : _mm_unpacklo_epi16(c, _mm_setzero_si128());
+	return _mm_sll_epi32(wide, shift);
+}
+
+// Convert eight pixels, with one chroma sample each
+static FORCEINLINE void sse2_convert8(byte *dst, __m128i y, __m128i u, __m128i v, const YUVToRGBRowFormat &format) {
+	const __m128i r = sse2_clipLuminance(_mm_add_epi16(y, sse2_scaleChroma(v, kYUVToRGBCrR)), format.itu, _mm_cvtsi32_si128(format.rLoss));
+	const __m128i g = sse2_clipLuminance(_mm_sub_epi16(_mm_sub_epi16(y, sse2_scaleChroma(v, kYUVToRGBCrG)), sse2_scaleChroma(u, kYUVToRGBCbG)), format.itu, _mm_cvtsi32_si128(format.gLoss));
+	const __m128i b = sse2_clipLuminance(_mm_add_epi16(y, sse2_scaleChroma(u, kYUVToRGBCbB)), format.itu, _mm_cvtsi32_si128(format.bLoss));
+
+	const __m128i rShift = _mm_cvtsi32_si128(format.rShift);
+	const __m128i gShift = _mm_cvtsi32_si128(format.gShift);
+	const __m128i bShift = _mm_cvtsi32_si128(format.bShift);
+
+	if (format.bytesPerPixel == 2) {
+		const __m128i pixels = _mm_or_si128(_mm_or_si128(_mm_sll_epi16(r, rShift), _mm_sll_epi16(g, gShift)),
+		                                    _mm_or_si128(_mm_sll_epi16(b, bShift), _mm_set1_epi16((int16)format.aMask)));
+		_mm_storeu_si128((__m128i *)dst, pixels);
+	} else {
+		const __m128i aMask = _mm_set1_epi32(format.aMask);
+		for (int i = 0; i < 2; i++) {
+			const __m128i pixels = _mm_or_si128(_mm_or_si128(sse2_shiftChannel32(r, i, rShift), sse2_shiftChannel32(g, i, gShift)),
+			                                    _mm_or_si128(sse2_shiftChannel32(b, i, bShift), aMask));
+			_mm_storeu_si128((__m128i *)(dst + i * 16), pixels);
+		}
+	}
+}
+
+void convertYUVToRGBRowSSE2(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, int chromaShift, const YUVToRGBRowFormat &format) {
+	const __m128i zero = _mm_setzero_si128();
+
+	int x = 0;
+	for (; x + 16 <= width; x += 16) {
+		// Bring the chroma to one sample per pixel
+		__m128i u, v;
+		if (chromaShift) {
+			u = _mm_loadl_epi64((const __m128i *)(uSrc + x / 2));
+			v = _mm_loadl_epi64((const __m128i *)(vSrc + x / 2));
+			u = _mm_unpacklo_epi8(u, u);
+			v = _mm_unpacklo_epi8(v, v);
+		} else {
+			u = _mm_loadu_si128((const __m128i *)(uSrc + x));
+			v = _mm_loadu_si128((const __m128i *)(vSrc + x));
+		}
+		const __m128i y = _mm_loadu_si128((const __m128i *)(ySrc + x));
+
+		byte *out = dst + x * format.bytesPerPixel;
+		sse2_convert8(out, _mm_unpacklo_epi8(y, zero), _mm_unpacklo_epi8(u, zero), _mm_unpacklo_epi8(v, zero), format);
+		sse2_convert8(out + 8 * format.bytesPerPixel, _mm_unpackhi_epi8(y, zero), _mm_unpackhi_epi8(u, zero), _mm_unpackhi_epi8(v, zero), format);
+	}
+
+	if (x < width)
+		convertYUVToRGBRowGeneric(dst + x * format.bytesPerPixel, ySrc + x, uSrc + (x >> chromaShift), vSrc + (x >> chromaShift), width - x, chromaShift, format);
+}
+
+} // End of namespace Graphics
+
+#if !defined(__x86_64__)
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+#endif
@@ -82,8 +82,10 @@
 // BASIS, AND BROWN UNIVERSITY HAS NO OBLIGATION TO PROVIDE MAINTENANCE,
 // SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
+#include "common/system.h"
 #include "graphics/surface.h"
 #include "graphics/yuv_to_rgb.h"
+#include "graphics/yuv_to_rgb_intern.h"
 
 namespace Common {
 DECLARE_SINGLETON(Graphics::YUVToRGBManager);
@@ -198,6 +200,88 @@ const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, Y
 	return _lookup;
 }
 
+static inline int scaleChroma(int c, int factor) {
+	const int x = c - 128;
+	return x < 0 ? -((-x * factor) >> 15) : (x * factor) >> 15;
+}
+
+static inline uint32 clipLuminance(int c, bool itu) {
+	if (itu)
+		return (((CLIP(c, 16, 235) - 16) << 3) * kYUVToRGBITUScale) >> 16;
+	return CLIP(c, 0, 255);
+}
+
+template<typename PixelInt>
+static void convertYUVToRGBRow(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, int chromaShift, const YUVToRGBRowFormat &format) {
+	for (int i = 0; i < width; i++) {
+		const int u = uSrc[i >> chromaShift];
+		const int v = vSrc[i >> chromaShift];
+		const int y = ySrc[i];
+
+		const uint32 r = clipLuminance(y + scaleChroma(v, kYUVToRGBCrR), format.itu);
+		const uint32 g = clipLuminance(y - scaleChroma(v, kYUVToRGBCrG) - scaleChroma(u, kYUVToRGBCbG), format.itu);
+		const uint32 b = clipLuminance(y + scaleChroma(u, kYUVToRGBCbB), format.itu);
+
+		((PixelInt *)dst)[i] = ((r >> format.rLoss) << format.rShift) | ((g >> format.gLoss) << format.gShift) |
+		                       ((b >> format.bLoss) << format.bShift) | format.aMask;
+	}
+}
+
+void convertYUVToRGBRowGeneric(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, int chromaShift, const YUVToRGBRowFormat &format) {
+	if (format.bytesPerPixel == 2)
+		convertYUVToRGBRow<uint16>(dst, ySrc, uSrc, vSrc, width, chromaShift, format);
+	else
+		convertYUVToRGBRow<uint32>(dst, ySrc, uSrc, vSrc, width, chromaShift, format);
+}
+
+// Initialize this to nullptr at the start
+YUVToRGBRowFunc g_yuvToRGBRowFunc = nullptr;
+
+YUVToRGBRowFunc getYUVToRGBRowFunc() {
+	// If no function has been selected yet, detect and select
+	if (!g_yuvToRGBRowFunc) {
+		g_yuvToRGBRowFunc = convertYUVToRGBRowGeneric;
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) g_yuvToRGBRowFunc = convertYUVToRGBRowNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) g_yuvToRGBRowFunc = convertYUVToRGBRowSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+		if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) g_yuvToRGBRowFunc = convertYUVToRGBRowAVX2;
+#endif
+	}
+
+	return g_yuvToRGBRowFunc;
+}
+
+static YUVToRGBRowFormat getRowFormat(const Graphics::PixelFormat &format, YUVToRGBManager::LuminanceScale scale) {
+	YUVToRGBRowFormat rowFormat;
+	rowFormat.itu = (scale == YUVToRGBManager::kScaleITU);
+	rowFormat.bytesPerPixel = format.bytesPerPixel;
+	rowFormat.rLoss = format.rLoss;
+	rowFormat.gLoss = format.gLoss;
+	rowFormat.bLoss = format.bLoss;
+	rowFormat.rShift = format.rShift;
+	rowFormat.gShift = format.gShift;
+	rowFormat.bShift = format.bShift;
+	rowFormat.aMask = (0xFF >> format.aLoss) << format.aShift;
+	return rowFormat;
+}
+
+/**
+ * Convert a 444, 422 or 420 image row by row. The chroma planes are
+ * subsampled horizontally by (1 << xShift) and vertically by (1 << yShift).
+ */
+static void convertRows(YUVToRGBRowFunc rowFunc, Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch, int xShift, int yShift) {
+	const YUVToRGBRowFormat format = getRowFormat(dst->format, scale);
+
+	for (int h = 0; h < yHeight; h++) {
+		const int uvOffset = (h >> yShift) * uvPitch;
+		rowFunc((byte *)dst->getBasePtr(0, h), ySrc + h * yPitch, uSrc + uvOffset, vSrc + uvOffset, yWidth, xShift, format);
+	}
+}
+
 #define PUT_PIXEL(s, d) \
 	L = &clipTable[(s)]; \
 	*((PixelInt *)(d)) = ((L[cr_r] << r_shift) | (L[crb_g] << g_shift) | (L[cb_b] << b_shift) | a_mask)
@@ -244,6 +328,12 @@ void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
 	assert(ySrc && uSrc && vSrc);
 
+	const YUVToRGBRowFunc rowFunc = getYUVToRGBRowFunc();
+	if (rowFunc != convertYUVToRGBRowGeneric) {
+		convertRows(rowFunc, dst, scale, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch, 0, 0);
+		return;
+	}
+
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
 	// Use a templated function to avoid an if check on every pixel
@@ -301,6 +391,12 @@ void YUVToRGBManager::convert422(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert(ySrc && uSrc && vSrc);
 	assert((yWidth & 1) == 0);
 
+	const YUVToRGBRowFunc rowFunc = getYUVToRGBRowFunc();
+	if (rowFunc != convertYUVToRGBRowGeneric) {
+		convertRows(rowFunc, dst, scale, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch, 1, 0);
+		return;
+	}
+
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
 	// Use a templated function to avoid an if check on every pixel
@@ -362,6 +458,12 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert((yWidth & 1) == 0);
 	assert((yHeight & 1) == 0);
 
+	const YUVToRGBRowFunc rowFunc = getYUVToRGBRowFunc();
+	if (rowFunc != convertYUVToRGBRowGeneric) {
+		convertRows(rowFunc, dst, scale, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch, 1, 1);
+		return;
+	}
+
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
 	// Use a templated function to avoid an if check on every pixel
@@ -371,6 +473,17 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 		convertYUV420ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 }
 
+void YUVToRGBManager::convert(Graphics::Surface *dst, const YUVImage &image) {
+	assert(image.chromaShiftX <= 1 && image.chromaShiftY <= image.chromaShiftX);
+
+	if (image.chromaShiftY)
+		convert420(dst, image.scale, image.y, image.u, image.v, image.width, image.height, image.yPitch, image.uvPitch);
+	else if (image.chromaShiftX)
+		convert422(dst, image.scale, image.y, image.u, image.v, image.width, image.height, image.yPitch, image.uvPitch);
+	else
+		convert444(dst, image.scale, image.y, image.u, image.v, image.width, image.height, image.yPitch, image.uvPitch);
+}
+
 #define PUT_PIXELA(s, a, d) \
 	L = &clipTable[(s)]; \
 	*((PixelInt *)(d)) = ((L[cr_r] << r_shift) | (L[crb_g] << g_shift) | (L[cb_b] << b_shift) | ((a >> a_loss) << a_shift))
@@ -513,6 +626,45 @@ void convertYUV410ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 #undef DO_INTERPOLATION
 #undef DO_YUV410_PIXEL
 
+static void convertRows410(YUVToRGBRowFunc rowFunc, Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	const YUVToRGBRowFormat format = getRowFormat(dst->format, scale);
+
+	// The chroma is interpolated into these in chunks, so that the row
+	// function can convert it like a 444 image
+	enum { kChunkWidth = 256 };
+	byte uRow[kChunkWidth], vRow[kChunkWidth];
+
+	for (int y = 0; y < yHeight; y++) {
+		const int yDiff = y & 3;
+		const byte *uTop = uSrc + (y >> 2) * uvPitch;
+		const byte *vTop = vSrc + (y >> 2) * uvPitch;
+		byte *dstRow = (byte *)dst->getBasePtr(0, y);
+
+		for (int x = 0; x < yWidth; x += kChunkWidth) {
+			const int width = MIN<int>(kChunkWidth, yWidth - x);
+
+			// Same bilinear interpolation as DO_INTERPOLATION, but blending
+			// the rows first. That gives the same sums.
+			for (int i = 0; i < width; i += 4) {
+				const int index = (x + i) >> 2;
+				const int uLeft = uTop[index] * (4 - yDiff) + uTop[index + uvPitch] * yDiff;
+				const int uRight = uTop[index + 1] * (4 - yDiff) + uTop[index + uvPitch + 1] * yDiff;
+				const int vLeft = vTop[index] * (4 - yDiff) + vTop[index + uvPitch] * yDiff;
+				const int vRight = vTop[index + 1] * (4 - yDiff) + vTop[index + uvPitch + 1] * yDiff;
+
+				for (int xDiff = 0; xDiff < 4; xDiff++) {
+					uRow[i + xDiff] = (uLeft * (4 - xDiff) + uRight * xDiff) >> 4;
+					vRow[i + xDiff] = (vLeft * (4 - xDiff) + vRight * xDiff) >> 4;
+				}
+			}
+
+			rowFunc(dstRow + x * format.bytesPerPixel, ySrc + x, uRow, vRow, width, 0, format);
+		}
+
+		ySrc += yPitch;
+	}
+}
+
 void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Sanity checks
 	assert(dst && dst->getPixels());
@@ -521,6 +673,12 @@ void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert((yWidth & 3) == 0);
 	assert((yHeight & 3) == 0);
 
+	const YUVToRGBRowFunc rowFunc = getYUVToRGBRowFunc();
+	if (rowFunc != convertYUVToRGBRowGeneric) {
+		convertRows410(rowFunc, dst, scale, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		return;
+	}
+
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
 	// Use a templated function to avoid an if check on every pixel
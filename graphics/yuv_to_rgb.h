@@ -45,6 +45,8 @@ namespace Graphics {
 
 class YUVToRGBLookup;
 
+struct YUVImage;
+
 class YUVToRGBManager : public Common::Singleton<YUVToRGBManager> {
 public:
 	/** The scale of the luminance values */
@@ -135,6 +137,14 @@ public:
 	 */
 	void convert410(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
 
+	/**
+	 * Convert a 444, 422 or 420 YUVImage to an RGB surface
+	 *
+	 * @param dst     the destination surface
+	 * @param image   the image to convert
+	 */
+	void convert(Graphics::Surface *dst, const YUVImage &image);
+
 private:
 	friend class Common::Singleton<SingletonBaseType>;
 	YUVToRGBManager();
@@ -144,6 +154,36 @@ private:
 
 	YUVToRGBLookup *_lookup;
 };
+
+/**
+ * Planes of a YUV image which are owned by someone else, e.g. a video
+ * decoder.
+ *
+ * @see OSystem::showYUVOverlay
+ */
+struct YUVImage {
+	YUVImage() : y(nullptr), u(nullptr), v(nullptr), yPitch(0), uvPitch(0), width(0), height(0),
+	             chromaShiftX(1), chromaShiftY(1), scale(YUVToRGBManager::kScaleITU) {}
+
+	const byte *y; ///< The y component
+	const byte *u; ///< The u component
+	const byte *v; ///< The v component
+
+	int yPitch;  ///< The pitch of the y plane
+	int uvPitch; ///< The pitch of the u and v planes
+
+	int width;  ///< The width of the y plane, and of the image
+	int height; ///< The height of the y plane, and of the image
+
+	/**
+	 * The subsampling of the chroma planes, as a shift of the luminance
+	 * coordinates. 1 and 1 for YUV420, 1 and 0 for YUV422, 0 and 0 for YUV444.
+	 */
+	byte chromaShiftX, chromaShiftY;
+
+	/** The scale of the luminance values */
+	YUVToRGBManager::LuminanceScale scale;
+};
  /** @} */
 } // End of namespace Graphics
 
@@ -0,0 +1,88 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_YUV_TO_RGB_INTERN_H
+#define GRAPHICS_YUV_TO_RGB_INTERN_H
+
+#include "common/scummsys.h"
+
+namespace Graphics {
+
+/**
+ * Fixed point chroma factors, with 15 fractional bits. They are rounded so
+ * that (|c - 128| * factor) >> 15 equals the truncated entries of the
+ * YUVToRGBLookup color table for every chroma value.
+ */
+enum {
+	kYUVToRGBCrR = 45919, ///< 0.419 / 0.299
+	kYUVToRGBCrG = 23383, ///< 0.299 / 0.419
+	kYUVToRGBCbG = 11285, ///< 0.114 / 0.331
+	kYUVToRGBCbB = 58111, ///< 0.587 / 0.331
+
+	/**
+	 * Scales ITU-R luminance values from [0, 219] to [0, 255] like the
+	 * lookup tables do, when multiplied with the value shifted left by 3
+	 * and keeping the high 16 bits.
+	 */
+	kYUVToRGBITUScale = 9539
+};
+
+/** The destination format of a row conversion. */
+struct YUVToRGBRowFormat {
+	bool itu;             ///< Whether the luminance values range from [16, 235]
+	byte bytesPerPixel;   ///< 2 or 4
+	byte rLoss, gLoss, bLoss;
+	byte rShift, gShift, bShift;
+	uint32 aMask;         ///< Set in every pixel
+};
+
+/**
+ * Convert one row of YUV pixels to RGB. There is one sample in @p uSrc and
+ * @p vSrc per (1 << @p chromaShift) pixels, with @p chromaShift being 0 or 1.
+ */
+typedef void (*YUVToRGBRowFunc)(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, int chromaShift, const YUVToRGBRowFormat &format);
+
+void convertYUVToRGBRowGeneric(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, int chromaShift, const YUVToRGBRowFormat &format);
+#ifdef SCUMMVM_NEON
+void convertYUVToRGBRowNEON(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, int chromaShift, const YUVToRGBRowFormat &format);
+#endif
+#ifdef SCUMMVM_SSE2
+void convertYUVToRGBRowSSE2(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, int chromaShift, const YUVToRGBRowFormat &format);
+#endif
+#ifdef SCUMMVM_AVX2
+void convertYUVToRGBRowAVX2(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, int chromaShift, const YUVToRGBRowFormat &format);
+#endif
+
+/** The routine picked by getYUVToRGBRowFunc(), or nullptr if none was picked yet. */
+extern YUVToRGBRowFunc g_yuvToRGBRowFunc;
+
+/**
+ * Return the fastest row conversion routine supported by the CPU. All of
+ * them produce exactly the same output as the lookup tables.
+ *
+ * YUVToRGBManager keeps using the lookup tables when this returns the
+ * generic routine, since they are faster than the scalar arithmetic.
+ */
+YUVToRGBRowFunc getYUVToRGBRowFunc();
+
+} // End of namespace Graphics
+
+#endif
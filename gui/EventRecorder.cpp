@@ -28,17 +28,21 @@ namespace Common {
 DECLARE_SINGLETON(GUI::EventRecorder);
 }
 
+#include "common/algorithm.h"
 #include "common/debug-channels.h"
 #include "backends/timer/sdl/sdl-timer.h"
 #include "backends/mixer/mixer.h"
 #include "common/config-manager.h"
+#include "common/crc.h"
 #include "common/md5.h"
+#include "common/profiler.h"
 #include "gui/gui-manager.h"
 #include "gui/widget.h"
 #include "gui/onscreendialog.h"
 #include "common/random.h"
 #include "common/savefile.h"
 #include "common/textconsole.h"
+#include "graphics/paletteman.h"
 #include "graphics/thumbnail.h"
 #include "graphics/surface.h"
 #include "graphics/scaler.h"
@@ -78,6 +82,8 @@ EventRecorder::EventRecorder() {
 	_screenshotPeriod = 0;
 	_playbackFile = nullptr;
 	_recordFile = nullptr;
+	_trace = false;
+	_traceLastFrame = 0;
 }
 
 EventRecorder::~EventRecorder() {
@@ -89,6 +95,7 @@ void EventRecorder::deinit() {
 		return;
 	}
 	setFileHeader();
+	finishTrace();
 	_needRedraw = false;
 	_initialized = false;
 	_recordMode = kPassthrough;
@@ -161,7 +168,7 @@ void EventRecorder::processTimeAndDate(TimeDate &td, bool skipRecord) {
 			_recordFile->writeEvent(timeDateEvent);
 		}
 
-		_nextEvent = _playbackFile->getNextEvent();
+		_nextEvent = readNextEvent();
 	}
 	if (_recordMode == kRecorderPlaybackPause)
 		td = _lastTimeDate;
@@ -218,7 +225,7 @@ void EventRecorder::processMillis(uint32 &millis, bool skipRecord) {
 			_recordFile->writeEvent(timerEvent);
 		}
 		updateSubsystems();
-		_nextEvent = _playbackFile->getNextEvent();
+		_nextEvent = readNextEvent();
 		_timerManager->handler();
 		_controlPanel->setReplayedTime(_fakeTimer);
 		_processingMillis = false;
@@ -260,7 +267,7 @@ void EventRecorder::processScreenUpdate() {
 		if (_nextEvent.recordedtype != Common::kRecorderEventTypeScreenUpdate) {
 			int numSkipped = 0;
 			while (true) {
-				_nextEvent = _playbackFile->getNextEvent();
+				_nextEvent = readNextEvent();
 				numSkipped += 1;
 				if (_nextEvent.recordedtype == Common::kRecorderEventTypeScreenUpdate) {
 					warning("Skipped %d events to get to the next screen update at %d", numSkipped, _nextEvent.time);
@@ -270,8 +277,10 @@ void EventRecorder::processScreenUpdate() {
 		}
 		_processingMillis = true;
 		_fakeTimer = _nextEvent.time;
+		if (_trace)
+			traceFrame();
 		updateSubsystems();
-		_nextEvent = _playbackFile->getNextEvent();
+		_nextEvent = readNextEvent();
 		if (_recordMode == kRecorderUpdate) {
 			// write event to the updated file and update screenshot if necessary
 			screenUpdateEvent.recordedtype = Common::kRecorderEventTypeScreenUpdate;
@@ -308,7 +317,7 @@ bool EventRecorder::pollEvent(Common::Event &ev) {
 	}
 
 	ev = _nextEvent;
-	_nextEvent = _playbackFile->getNextEvent();
+	_nextEvent = readNextEvent();
 	switch (ev.type) {
 	case Common::EVENT_MOUSEMOVE:
 	case Common::EVENT_LBUTTONDOWN:
@@ -380,7 +389,7 @@ Common::String EventRecorder::generateRecordFileName(const Common::String &targe
 }
 
 
-void EventRecorder::init(const Common::String &recordFileName, RecordMode mode) {
+void EventRecorder::init(const Common::String &recordFileName, RecordMode mode, bool trace) {
 	_fakeMixerManager = new NullMixerManager();
 	_fakeMixerManager->init();
 	_fakeMixerManager->suspendAudio();
@@ -415,7 +424,21 @@ void EventRecorder::init(const Common::String &recordFileName, RecordMode mode)
 	}
 	if ((_recordMode == kRecorderPlayback) || (_recordMode == kRecorderUpdate)) {
 		applyPlaybackSettings();
-		_nextEvent = _playbackFile->getNextEvent();
+		_nextEvent = readNextEvent();
+	}
+	_trace = trace && (_recordMode == kRecorderPlayback);
+	if (_trace) {
+		// Frames are timed as they run, without waiting for the recorded delays
+		_fastPlayback = true;
+		_traceFileName = ConfMan.get("record_trace_file");
+		if (_traceFileName.empty())
+			_traceFileName = recordFileName + ".trace";
+		_traceFrames.clear();
+		_traceLastFrame = g_system->getMicros();
+#ifdef USE_PROFILER
+		Common::Profiler::instance().clear();
+		Common::Profiler::instance().setEnabled(true);
+#endif
 	}
 	if ((_recordMode == kRecorderRecord) || (_recordMode == kRecorderUpdate)) {
 		getConfig();
@@ -661,6 +684,169 @@ void EventRecorder::takeScreenshot() {
 	}
 }
 
+Common::RecorderEvent EventRecorder::readNextEvent() {
+	// The playback quits once the recording runs out, so this is the last
+	// chance to write the trace
+	if (_trace && !_playbackFile->hasNextEvent())
+		finishTrace();
+	return _playbackFile->getNextEvent();
+}
+
+void EventRecorder::traceFrame() {
+	TraceFrame frame;
+	frame.time = _fakeTimer;
+	frame.duration = (uint32)(g_system->getMicros() - _traceLastFrame);
+
+	if (!computeScreenHash(frame.hash))
+		frame.hash = 0;
+	_traceFrames.push_back(frame);
+
+	// Hashing the screen doesn't count towards the next frame
+	_traceLastFrame = g_system->getMicros();
+}
+
+/**
+ * Hash the game screen as it is, with its palette, instead of converting it
+ * like screenshots do. That is cheap enough for every frame, and any change
+ * to a pixel shows.
+ */
+bool EventRecorder::computeScreenHash(uint32 &hash) {
+	Graphics::Surface *screen = g_system->lockScreen();
+	if (!screen)
+		return false;
+
+	// The rows are hashed separately, so that the pitch doesn't matter
+	const Common::CRC32 crc;
+	const int rowSize = screen->w * screen->format.bytesPerPixel;
+	Common::Array<byte> hashes((screen->h + 1) * 4);
+	for (int y = 0; y < screen->h; ++y)
+		WRITE_LE_UINT32(&hashes[y * 4], crc.crcFast((const byte *)screen->getBasePtr(0, y), rowSize));
+	const bool paletted = screen->format.isCLUT8();
+	g_system->unlockScreen();
+
+	uint32 paletteHash = 0;
+	if (paletted) {
+		byte palette[256 * 3];
+		g_system->getPaletteManager()->grabPalette(palette, 0, 256);
+		paletteHash = crc.crcFast(palette, sizeof(palette));
+	}
+	WRITE_LE_UINT32(&hashes[screen->h * 4], paletteHash);
+
+	hash = crc.crcFast(hashes.data(), hashes.size());
+	return true;
+}
+
+void EventRecorder::finishTrace() {
+	if (!_trace)
+		return;
+	_trace = false;
+
+#ifdef USE_PROFILER
+	Common::Profiler::instance().setEnabled(false);
+#endif
+
+	Common::Array<uint32> durations;
+	uint64 totalTime = 0;
+	for (uint i = 0; i < _traceFrames.size(); ++i) {
+		durations.push_back(_traceFrames[i].duration);
+		totalTime += _traceFrames[i].duration;
+	}
+	Common::sort(durations.begin(), durations.end());
+
+	uint32 p50 = 0, p95 = 0, maxDuration = 0;
+	if (!durations.empty()) {
+		p50 = durations[(durations.size() - 1) * 50 / 100];
+		p95 = durations[(durations.size() - 1) * 95 / 100];
+		maxDuration = durations.back();
+	}
+	debug("trace:frames=%u time_us=%llu p50_us=%u p95_us=%u max_us=%u file=%s", _traceFrames.size(),
+	      (unsigned long long)totalTime, p50, p95, maxDuration, _traceFileName.c_str());
+
+	if (!_realSaveManager) {
+		warning("No save file manager to write the trace to");
+		_traceFrames.clear();
+		return;
+	}
+
+	Common::OutSaveFile *file = _realSaveManager->openForSaving(_traceFileName, false);
+	if (file) {
+		file->writeString(Common::String::format("# frames=%u time_us=%llu p50_us=%u p95_us=%u max_us=%u\n", _traceFrames.size(),
+		                                         (unsigned long long)totalTime, p50, p95, maxDuration));
+		file->writeString("# frame time_ms duration_us hash\n");
+		for (uint i = 0; i < _traceFrames.size(); ++i) {
+			const TraceFrame &frame = _traceFrames[i];
+			file->writeString(Common::String::format("%u %u %u %08x\n", i, frame.time, frame.duration, frame.hash));
+		}
+		file->finalize();
+		if (file->err())
+			warning("Writing the trace %s failed", _traceFileName.c_str());
+		delete file;
+	} else {
+		warning("Can't open the trace %s for writing", _traceFileName.c_str());
+	}
+
+#ifdef USE_PROFILER
+	Common::OutSaveFile *profile = _realSaveManager->openForSaving(_traceFileName + ".json", false);
+	if (profile) {
+		Common::Profiler::instance().exportChromeTrace(*profile);
+		profile->finalize();
+		delete profile;
+	}
+#endif
+
+	const Common::String referenceFileName = ConfMan.get("record_trace_reference");
+	if (!referenceFileName.empty()) {
+		Common::InSaveFile *reference = _realSaveManager->openForLoading(referenceFileName);
+		if (reference) {
+			compareTrace(*reference, totalTime);
+			delete reference;
+		} else {
+			warning("Can't open the reference trace %s", referenceFileName.c_str());
+		}
+	}
+
+	_traceFrames.clear();
+}
+
+void EventRecorder::compareTrace(Common::SeekableReadStream &reference, uint64 totalTime) {
+	uint referenceFrames = 0, differentFrames = 0;
+	int firstDifference = -1;
+	uint64 referenceTime = 0;
+
+	while (!reference.eos() && !reference.err()) {
+		const Common::String line = reference.readLine();
+		if (line.empty() || line[0] == '#')
+			continue;
+
+		uint index, time, duration, hash;
+		if (sscanf(line.c_str(), "%u %u %u %x", &index, &time, &duration, &hash) != 4) {
+			warning("Malformed line in the reference trace: %s", line.c_str());
+			continue;
+		}
+
+		++referenceFrames;
+		referenceTime += duration;
+
+		// A frame which ran at another time or drew something else means the
+		// two runs didn't behave the same
+		if (index >= _traceFrames.size() || _traceFrames[index].time != time || _traceFrames[index].hash != hash) {
+			++differentFrames;
+			if (firstDifference < 0)
+				firstDifference = index;
+		}
+	}
+
+	if (referenceFrames < _traceFrames.size()) {
+		differentFrames += _traceFrames.size() - referenceFrames;
+		if (firstDifference < 0)
+			firstDifference = referenceFrames;
+	}
+
+	debug("trace:action=compare frames=%u reference_frames=%u time_us=%llu reference_time_us=%llu speedup=%.3f different_frames=%u first_difference=%d",
+	      _traceFrames.size(), referenceFrames, (unsigned long long)totalTime, (unsigned long long)referenceTime,
+	      totalTime ? (double)referenceTime / totalTime : 0.0, differentFrames, firstDifference);
+}
+
 bool EventRecorder::grabScreenAndComputeMD5(Graphics::Surface &screen, uint8 md5[16]) {
 	if (!createScreenShot(screen)) {
 		warning("Can't save screenshot");
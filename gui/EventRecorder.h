@@ -77,7 +77,15 @@ public:
 		kRecorderUpdate = 4			/**< kRecorderUpdate, playback existing recording and update all hashes */
 	};
 
-	void init(const Common::String &recordFileName, RecordMode mode);
+	/**
+	 * Start recording or playing back.
+	 *
+	 * With @p trace set, a playback runs without delays and writes a timing
+	 * trace: the real time spent on each frame, and a hash of its screen.
+	 * The trace goes to the save file named by the record_trace_file setting,
+	 * and is compared to the one named by record_trace_reference, if any.
+	 */
+	void init(const Common::String &recordFileName, RecordMode mode, bool trace = false);
 	void deinit();
 	bool processDelayMillis();
 	uint32 getRandomSeed(const Common::String &name);
@@ -240,6 +248,24 @@ private:
 	Common::PlaybackFile *_playbackFile;
 	Common::PlaybackFile *_recordFile;
 
+	/** A frame of a timing trace. */
+	struct TraceFrame {
+		uint32 time;     ///< Recorded time of the frame, in milliseconds
+		uint32 duration; ///< Real time spent on the frame, in microseconds
+		uint32 hash;     ///< Hash of the game screen, see computeScreenHash()
+	};
+
+	bool _trace;
+	uint64 _traceLastFrame;
+	Common::String _traceFileName;
+	Common::Array<TraceFrame> _traceFrames;
+
+	void traceFrame();
+	bool computeScreenHash(uint32 &hash);
+	void finishTrace();
+	void compareTrace(Common::SeekableReadStream &reference, uint64 totalTime);
+	Common::RecorderEvent readNextEvent();
+
 	void saveScreenShot();
 	void checkRecordedMD5();
 	void deleteTemporarySave();
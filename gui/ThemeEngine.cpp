@@ -390,6 +390,7 @@ void ThemeEngine::refresh() {
 			}
 		}
 		_bitmaps.clear();
+		_pendingBitmaps.clear();
 
 		_needScaleRefresh = false;
 	}
@@ -454,6 +455,8 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	uint32 width = _system->getOverlayWidth();
 	uint32 height = _system->getOverlayHeight();
 
+	clearDrawDataCache();
+
 	_backBuffer.free();
 	_backBuffer.create(width, height, _overlayFormat);
 
@@ -544,6 +547,7 @@ bool ThemeEngine::addFont(TextData textId, const Common::String &language, const
 	if (_texts[textId] != nullptr)
 		delete _texts[textId];
 
+	_wordWrapCache.clear();
 	_texts[textId] = new TextDrawData;
 
 	if (file == "default") {
@@ -647,24 +651,52 @@ bool ThemeEngine::addTextColor(TextColor colorId, int r, int g, int b) {
 
 bool ThemeEngine::addBitmap(const Common::String &filename, const Common::String &scalablefile, int width, int height) {
 	// Nothing has to be done if the bitmap already has been loaded.
-	Graphics::ManagedSurface *surf = _bitmaps[filename];
-	if (surf) {
+	if (_bitmaps.getValOrDefault(filename, nullptr) || _pendingBitmaps.contains(filename)) {
 		return true;
 	}
 
+	// Only check that the file exists, it is decoded the first time it is used
+	Common::ArchiveMemberList members;
+	_themeFiles.listMatchingMembers(members, Common::Path(scalablefile.empty() ? filename : scalablefile, '/'));
+	if (members.empty())
+		return false;
+
+	PendingBitmap &pending = _pendingBitmaps[filename];
+	pending.scalableFile = scalablefile;
+	pending.width = width;
+	pending.height = height;
+
+	return true;
+}
+
+Graphics::ManagedSurface *ThemeEngine::getImageSurface(const Common::String &name) {
+	PendingImagesMap::iterator pending = _pendingBitmaps.find(name);
+	if (pending != _pendingBitmaps.end()) {
+		const PendingBitmap bitmap = pending->_value;
+		_pendingBitmaps.erase(pending);
+		_bitmaps[name] = loadBitmap(name, bitmap.scalableFile, bitmap.width, bitmap.height);
+	}
+
+	return _bitmaps.getValOrDefault(name, nullptr);
+}
+
+Graphics::ManagedSurface *ThemeEngine::loadBitmap(const Common::String &filename, const Common::String &scalablefile, int width, int height) {
+	Graphics::ManagedSurface *surf = nullptr;
+
 	if (!scalablefile.empty()) {
 		Common::ArchiveMemberList members;
 		_themeFiles.listMatchingMembers(members, Common::Path(scalablefile, '/'));
 		for (Common::ArchiveMemberList::const_iterator i = members.begin(), end = members.end(); i != end; ++i) {
 			Common::SeekableReadStream *stream = (*i)->createReadStream();
 			if (stream) {
-				_bitmaps[filename] = new Graphics::SVGBitmap(stream, width * _scaleFactor, height * _scaleFactor);
+				surf = new Graphics::SVGBitmap(stream, width * _scaleFactor, height * _scaleFactor);
 				delete stream;
-				return true;
+				return surf;
 			}
 		}
 
-		return false;
+		warning("Failed to load bitmap '%s'", scalablefile.c_str());
+		return nullptr;
 	}
 
 	const Graphics::Surface *srcSurface = nullptr;
@@ -673,6 +705,8 @@ bool ThemeEngine::addBitmap(const Common::String &filename, const Common::String
 		// Maybe it is PNG?
 #ifdef USE_PNG
 		Image::PNGDecoder decoder;
+		// Decode straight to the overlay format, so that no conversion is needed
+		decoder.setOutputPixelFormat(_overlayFormat);
 		Common::ArchiveMemberList members;
 		_themeFiles.listMatchingMembers(members, Common::Path(filename, '/'));
 		for (Common::ArchiveMemberList::const_iterator i = members.begin(), end = members.end(); i != end; ++i) {
@@ -731,10 +765,11 @@ bool ThemeEngine::addBitmap(const Common::String &filename, const Common::String
 
 		surf = surf2;
 	}
-	// Store the surface into our hashmap (attention, may store NULL entries!)
-	_bitmaps[filename] = surf;
 
-	return surf != nullptr;
+	if (!surf)
+		warning("Failed to load bitmap '%s'", filename.c_str());
+
+	return surf;
 }
 
 bool ThemeEngine::addDrawData(const Common::String &data, bool cached) {
@@ -786,6 +821,10 @@ void ThemeEngine::loadTheme(const Common::String &themeId) {
 }
 
 void ThemeEngine::unloadTheme() {
+	clearDrawDataCache();
+	_bidiCache.clear();
+	_wordWrapCache.clear();
+
 	if (!_themeOk)
 		return;
 
@@ -935,7 +974,14 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 		extendedRect.bottom += drawData->_shadowOffset - drawData->_backgroundOffset;
 	}
 
+	// Only cache elements which are entirely visible and not too large,
+	// their rendering then only depends on their size and the background
+	bool cacheable = area == r && Common::Rect(_screen.w, _screen.h).contains(extendedRect) &&
+		(int)extendedRect.width() * extendedRect.height() <= kDrawDataCacheMaxPixels;
+
 	if (!_clip.isEmpty()) {
+		if (!_clip.contains(extendedRect))
+			cacheable = false;
 		extendedRect.clip(_clip);
 	}
 
@@ -948,15 +994,95 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 		restoreBackground(extendedRect);
 
 	if (drawData->_layer == _layerToDraw) {
+		if (cacheable && drawCachedDD(type, area, extendedRect, dynamic)) {
+			addDirtyRect(extendedRect);
+			return;
+		}
+
+		Graphics::Surface before;
+		if (cacheable)
+			before.copyFrom(_vectorRenderer->getActiveSurface()->rawSurface().getSubArea(extendedRect));
+
 		Common::List<Graphics::DrawStep>::const_iterator step;
 		for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
 			_vectorRenderer->drawStep(area, _clip, *step, dynamic);
 		}
 
+		if (cacheable)
+			cacheDD(type, area, extendedRect, dynamic, before);
+
 		addDirtyRect(extendedRect);
 	}
 }
 
+void ThemeEngine::clearDrawDataCache() {
+	for (DrawDataCache::iterator i = _drawDataCache.begin(); i != _drawDataCache.end(); ++i) {
+		(*i)->before.free();
+		(*i)->after.free();
+		delete *i;
+	}
+	_drawDataCache.clear();
+}
+
+bool ThemeEngine::drawCachedDD(DrawData type, const Common::Rect &area, const Common::Rect &extendedRect, uint32 dynamic) {
+	Graphics::Surface *surface = _vectorRenderer->getActiveSurface()->surfacePtr();
+
+	for (DrawDataCache::iterator i = _drawDataCache.begin(); i != _drawDataCache.end(); ++i) {
+		DrawDataCacheEntry *entry = *i;
+		if (entry->type != type || entry->dynamic != dynamic || entry->width != area.width() || entry->height != area.height())
+			continue;
+
+		const uint rowSize = extendedRect.width() * surface->format.bytesPerPixel;
+		for (int y = 0; y < entry->before.h; ++y) {
+			if (memcmp(entry->before.getBasePtr(0, y), surface->getBasePtr(extendedRect.left, extendedRect.top + y), rowSize))
+				return false;
+		}
+
+		surface->copyRectToSurface(entry->after, extendedRect.left, extendedRect.top, Common::Rect(entry->after.w, entry->after.h));
+
+		// Keep the most recently used entries first
+		_drawDataCache.erase(i);
+		_drawDataCache.push_front(entry);
+		return true;
+	}
+
+	return false;
+}
+
+void ThemeEngine::cacheDD(DrawData type, const Common::Rect &area, const Common::Rect &extendedRect, uint32 dynamic, const Graphics::Surface &before) {
+	DrawDataCacheEntry *entry = nullptr;
+
+	// Reuse the entry of the same element drawn over a different background
+	for (DrawDataCache::iterator i = _drawDataCache.begin(); i != _drawDataCache.end(); ++i) {
+		if ((*i)->type == type && (*i)->dynamic == dynamic && (*i)->width == area.width() && (*i)->height == area.height()) {
+			entry = *i;
+			_drawDataCache.erase(i);
+			entry->before.free();
+			entry->after.free();
+			break;
+		}
+	}
+
+	if (!entry) {
+		if (_drawDataCache.size() >= kDrawDataCacheSize) {
+			entry = _drawDataCache.back();
+			_drawDataCache.pop_back();
+			entry->before.free();
+			entry->after.free();
+		} else {
+			entry = new DrawDataCacheEntry();
+		}
+	}
+
+	entry->type = type;
+	entry->dynamic = dynamic;
+	entry->width = area.width();
+	entry->height = area.height();
+	entry->before.copyFrom(before);
+	entry->after.copyFrom(_vectorRenderer->getActiveSurface()->rawSurface().getSubArea(extendedRect));
+	_drawDataCache.push_front(entry);
+}
+
 void ThemeEngine::drawDDText(TextData type, TextColor color, const Common::Rect &r, const Common::U32String &text,
 	bool restoreBg, bool ellipsis, Graphics::TextAlign alignH, TextAlignVertical alignV,
 	int deltax, const Common::Rect &drawableTextArea) {
@@ -983,7 +1109,7 @@ void ThemeEngine::drawDDText(TextData type, TextColor color, const Common::Rect
 
 	_vectorRenderer->setFgColor(_textColors[color]->r, _textColors[color]->g, _textColors[color]->b);
 #ifdef USE_FRIBIDI
-	_vectorRenderer->drawString(_texts[type]->_fontPtr, Common::convertBiDiU32String(text), area, alignH, alignV, deltax, ellipsis, dirty);
+	_vectorRenderer->drawString(_texts[type]->_fontPtr, _bidiCache.convert(text), area, alignH, alignV, deltax, ellipsis, dirty);
 #else
 	_vectorRenderer->drawString(_texts[type]->_fontPtr, text, area, alignH, alignV, deltax, ellipsis, dirty);
 #endif
@@ -1581,7 +1707,7 @@ void ThemeEngine::applyScreenShading(ShadingStyle style) {
 
 bool ThemeEngine::createCursor(const Common::String &filename, int hotspotX, int hotspotY) {
 	// Try to locate the specified file among all loaded bitmaps
-	const Graphics::ManagedSurface *cursor = _bitmaps[filename];
+	const Graphics::ManagedSurface *cursor = getImageSurface(filename);
 	if (!cursor)
 		return false;
 
@@ -1698,6 +1824,10 @@ int ThemeEngine::getStringWidth(const Common::U32String &str, FontStyle font) co
 	return ready() ? _texts[fontStyleToData(font)]->_fontPtr->getStringWidth(str) : 0;
 }
 
+int ThemeEngine::wordWrapText(const Common::U32String &str, int maxWidth, Common::Array<Common::U32String> &lines, FontStyle font) {
+	return ready() ? _wordWrapCache.wordWrapText(*_texts[fontStyleToData(font)]->_fontPtr, str, maxWidth, lines) : 0;
+}
+
 int ThemeEngine::getCharWidth(uint32 c, FontStyle font) const {
 	return ready() ? _texts[fontStyleToData(font)]->_fontPtr->getCharWidth(c) : 0;
 }
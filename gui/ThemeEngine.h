@@ -30,6 +30,7 @@
 #include "common/list.h"
 #include "common/str.h"
 #include "common/rect.h"
+#include "common/unicode-bidi.h"
 
 #include "graphics/managed_surface.h"
 #include "graphics/font.h"
@@ -210,6 +211,13 @@ class ThemeEngine {
 protected:
 	typedef Common::HashMap<Common::String, Graphics::ManagedSurface *> ImagesMap;
 
+	/** A bitmap referenced by the theme which has not been decoded yet */
+	struct PendingBitmap {
+		Common::String scalableFile;
+		int width, height;
+	};
+	typedef Common::HashMap<Common::String, PendingBitmap> PendingImagesMap;
+
 	friend class GUI::Dialog;
 	friend class GUI::GuiObject;
 
@@ -340,6 +348,10 @@ public:
 	/** Constant value to expand dirty rectangles, to make sure they are fully copied */
 	static const int kDirtyRectangleThreshold = 1;
 
+	/** Number of rendered DrawData elements kept, and the largest size cached */
+	static const int kDrawDataCacheSize = 16;
+	static const int kDrawDataCacheMaxPixels = 128 * 1024;
+
 	struct Renderer {
 		const char *name;
 		const char *shortname;
@@ -435,6 +447,12 @@ public:
 
 	int getStringWidth(const Common::U32String &str, FontStyle font = kFontStyleBold) const;
 
+	/**
+	 * Word-wrap a text with one of the theme fonts, like Font::wordWrapText().
+	 * The result is cached until the fonts change.
+	 */
+	int wordWrapText(const Common::U32String &str, int maxWidth, Common::Array<Common::U32String> &lines, FontStyle font = kFontStyleBold);
+
 	int getCharWidth(uint32 c, FontStyle font = kFontStyleBold) const;
 
 	int getKerningOffset(uint32 left, uint32 right, FontStyle font = kFontStyleBold) const;
@@ -597,8 +615,9 @@ public:
 
 
 	/**
-	 * Interface for the ThemeParser class: Loads a bitmap file to use on the GUI.
-	 * The filename is also used as its identifier.
+	 * Interface for the ThemeParser class: Registers a bitmap file to use on the GUI.
+	 * The filename is also used as its identifier. The file is only decoded once
+	 * it is requested through getImageSurface().
 	 *
 	 * @param filename Name of the bitmap file.
 	 * @param filename Name of the scalable (SVG) file, could be empty
@@ -606,6 +625,9 @@ public:
 	 */
 	bool addBitmap(const Common::String &filename, const Common::String &scalablefile, int widht, int height);
 
+	/** Decodes a bitmap registered by addBitmap(), returns nullptr on failure */
+	Graphics::ManagedSurface *loadBitmap(const Common::String &filename, const Common::String &scalablefile, int width, int height);
+
 	/**
 	 * Adds a new TextStep from the ThemeParser. This will be deprecated/removed once the
 	 * new Font API is in place. FIXME: Is that so ???
@@ -639,9 +661,8 @@ public:
 	inline bool supportsImages() const { return true; }
 	inline bool ownCursor() const { return _useCursor; }
 
-	Graphics::ManagedSurface *getImageSurface(const Common::String &name) const {
-		return _bitmaps.contains(name) ? _bitmaps[name] : 0;
-	}
+	/** Returns the given theme bitmap, decoding it if this is its first use. */
+	Graphics::ManagedSurface *getImageSurface(const Common::String &name);
 
 	/**
 	 * Interface for the Theme Parser: Creates a new cursor by loading the given
@@ -789,9 +810,32 @@ protected:
 	 */
 	WidgetDrawData *_widgets[kDrawDataMAX];
 
+	/**
+	 * Recently rendered DrawData elements. Each entry keeps the pixels of the
+	 * drawn rectangle before and after drawing, so that redrawing the same
+	 * element over an unchanged background becomes a copy.
+	 */
+	struct DrawDataCacheEntry {
+		DrawData type;
+		uint32 dynamic;
+		int16 width, height;
+		Graphics::Surface before;
+		Graphics::Surface after;
+	};
+	typedef Common::List<DrawDataCacheEntry *> DrawDataCache;
+	DrawDataCache _drawDataCache;
+
+	void clearDrawDataCache();
+	bool drawCachedDD(DrawData type, const Common::Rect &area, const Common::Rect &extendedRect, uint32 dynamic);
+	void cacheDD(DrawData type, const Common::Rect &area, const Common::Rect &extendedRect, uint32 dynamic, const Graphics::Surface &before);
+
 	/** Array of all the text fonts that can be drawn. */
 	TextDrawData *_texts[kTextDataMAX];
 
+	/** Results of text layout which is repeated on each redraw. */
+	Common::BiDiCache _bidiCache;
+	Graphics::WordWrapCache _wordWrapCache;
+
 	/** Array of all font colors available. */
 	TextColorData *_textColors[kTextColorMAX];
 
@@ -801,6 +845,7 @@ protected:
 	Common::Array<LangExtraFont> _langExtraFonts;
 
 	ImagesMap _bitmaps;
+	PendingImagesMap _pendingBitmaps;
 	Graphics::PixelFormat _overlayFormat;
 	Graphics::PixelFormat _cursorFormat;
 
@@ -119,6 +119,7 @@ AboutDialog::AboutDialog(bool inGame)
 
 	byte sse2Support = 0;
 	byte avx2Support = 0;
+	byte avx512Support = 0;
 	byte neonSupport = 0;
 
 #ifdef SCUMMVM_SSE2
@@ -131,6 +132,11 @@ AboutDialog::AboutDialog(bool inGame)
 	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2))
 		++avx2Support;
 #endif
+#ifdef SCUMMVM_AVX512
+	++avx512Support;
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX512BW))
+		++avx512Support;
+#endif
 #ifdef SCUMMVM_NEON
 	++neonSupport;
 	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
@@ -142,9 +148,10 @@ AboutDialog::AboutDialog(bool inGame)
 	extensionsInfo += _("CPU extensions support:");
 	addLine(extensionsInfo);
 	Common::U32String compiledExtensionsList("C0");
-	compiledExtensionsList += Common::U32String::format("SSE2(%S) AVX2(%S) NEON(%S)",
+	compiledExtensionsList += Common::U32String::format("SSE2(%S) AVX2(%S) AVX-512BW(%S) NEON(%S)",
 		extensionSupportString[sse2Support].c_str(),
 		extensionSupportString[avx2Support].c_str(),
+		extensionSupportString[avx512Support].c_str(),
 		extensionSupportString[neonSupport].c_str());
 
 	addLine(compiledExtensionsList);
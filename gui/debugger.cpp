@@ -29,11 +29,14 @@
 
 #ifndef DISABLE_MD5
 #include "common/md5.h"
+#include "common/memtracker.h"
 #include "common/archive.h"
 #include "common/macresman.h"
 #include "common/stream.h"
 #endif
 
+#include "audio/mixer.h"
+
 #include "engines/engine.h"
 
 #include "gui/debugger.h"
@@ -81,6 +84,10 @@ Debugger::Debugger() {
 	registerCmd("debugflag_list",		WRAP_METHOD(Debugger, cmdDebugFlagsList));
 	registerCmd("debugflag_enable",	WRAP_METHOD(Debugger, cmdDebugFlagEnable));
 	registerCmd("debugflag_disable",	WRAP_METHOD(Debugger, cmdDebugFlagDisable));
+	registerCmd("audio",			WRAP_METHOD(Debugger, cmdAudio));
+#ifdef USE_MEMORY_TRACKING
+	registerCmd("memory",			WRAP_METHOD(Debugger, cmdMemory));
+#endif
 }
 
 Debugger::~Debugger() {
@@ -841,6 +848,69 @@ bool Debugger::cmdExecFile(int argc, const char **argv) {
 	return true;
 }
 
+#ifdef USE_MEMORY_TRACKING
+bool Debugger::cmdMemory(int argc, const char **argv) {
+	if (argc == 2 && !strcmp(argv[1], "reset")) {
+		Common::MemoryTracker::resetPeaks();
+		debugPrintf("Memory peaks reset\n");
+		return true;
+	}
+
+	if (argc == 4 && !strcmp(argv[1], "budget")) {
+		const Common::MemoryTag tag = Common::MemoryTracker::findTag(argv[2]);
+		if (tag == Common::kMemoryTagCount) {
+			debugPrintf("Unknown memory tag '%s'\n", argv[2]);
+			return true;
+		}
+		Common::MemoryTracker::setBudget(tag, (size_t)atoi(argv[3]) * 1024);
+		debugPrintf("Memory budget of %s set to %d KiB\n", Common::MemoryTracker::getTagName(tag), atoi(argv[3]));
+		return true;
+	}
+
+	if (argc != 1) {
+		debugPrintf("Usage: %s [reset | budget <tag> <KiB>]\n", argv[0]);
+		return true;
+	}
+
+	debugPrintf("Tag          In use KiB    Peak KiB  Allocations  Budget KiB\n");
+	debugPrintf("------------------------------------------------------------\n");
+	for (int i = 0; i < Common::kMemoryTagCount; i++) {
+		Common::MemoryTracker::Stats stats;
+		Common::MemoryTracker::getStats((Common::MemoryTag)i, stats);
+
+		debugPrintf("%-10s %12u %11u %12u %11s%s\n", Common::MemoryTracker::getTagName((Common::MemoryTag)i),
+		            (uint)(stats.current / 1024), (uint)(stats.peak / 1024), (uint)stats.allocations,
+		            stats.budget ? Common::String::format("%u", (uint)(stats.budget / 1024)).c_str() : "-",
+		            (stats.budget && stats.peak > stats.budget) ? " (exceeded)" : "");
+	}
+	return true;
+}
+#endif
+
+bool Debugger::cmdAudio(int argc, const char **argv) {
+	Audio::Mixer *mixer = g_system->getMixer();
+
+	if (argc == 2 && !strcmp(argv[1], "reset")) {
+		mixer->resetOutputStats();
+		debugPrintf("Audio statistics reset\n");
+		return true;
+	}
+
+	if (argc != 1) {
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	Audio::Mixer::OutputStats stats;
+	mixer->getOutputStats(stats);
+
+	debugPrintf("Output: %u Hz %s, %u samples per buffer (%u us)\n", mixer->getOutputRate(),
+	            mixer->getOutputStereo() ? "stereo" : "mono", mixer->getOutputBufSize(), stats.bufferTime);
+	debugPrintf("Buffers mixed: %u, underruns: %u\n", stats.callbacks, stats.underruns);
+	debugPrintf("Mix time: %u us last, %u us peak\n", stats.lastMixTime, stats.maxMixTime);
+	return true;
+}
+
 bool Debugger::cmdDebugFlagDisable(int argc, const char **argv) {
 	if (argc < 2) {
 		debugPrintf("debugflag_disable [<flag> | all]\n");
@@ -277,6 +277,10 @@ protected:
 	bool cmdDebugFlagDisable(int argc, const char **argv);
 	bool cmdClearLog(int argc, const char **argv);
 	bool cmdExecFile(int argc, const char **argv);
+	bool cmdAudio(int argc, const char **argv);
+#ifdef USE_MEMORY_TRACKING
+	bool cmdMemory(int argc, const char **argv);
+#endif
 
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 private:
@@ -22,11 +22,14 @@
 #include "gui/integrity-dialog.h"
 
 #include "common/array.h"
+#include "common/atomic.h"
 #include "common/config-manager.h"
 #include "common/debug.h"
 #include "common/file.h"
+#include "common/jobs.h"
 #include "common/macresman.h"
 #include "common/md5.h"
+#include "common/ptr.h"
 #include "common/tokenizer.h"
 #include "common/translation.h"
 
@@ -64,7 +67,7 @@ struct ChecksumDialogState {
 	ProcessState state;
 
 	int totalSize;
-	int calculatedSize;
+	Common::Atomic<int> calculatedSize; // Updated by the checksum jobs
 	uint32 lastUpdate;
 
 	Common::String endpoint;
@@ -77,7 +80,7 @@ struct ChecksumDialogState {
 
 	ChecksumDialogState() {
 		state = kChecksumStateNone;
-		totalSize = calculatedSize = 0;
+		totalSize = 0;
 		lastUpdate = 0;
 		dialog = nullptr;
 	}
@@ -87,7 +90,7 @@ uint32 getCalculationProgress() {
 	if (!g_checksum_state || g_checksum_state->totalSize == 0)
 		return 0;
 
-	uint32 progress = (uint32)(100 * ((double)g_checksum_state->calculatedSize / (double)g_checksum_state->totalSize));
+	uint32 progress = (uint32)(100 * ((double)g_checksum_state->calculatedSize.loadRelaxed() / (double)g_checksum_state->totalSize));
 
 	return progress;
 }
@@ -258,7 +261,7 @@ void IntegrityDialog::reflowLayout() {
 
 Common::U32String IntegrityDialog::getSizeLabelText() {
 	const char *calculatedUnits, *totalUnits;
-	Common::String calculated = Common::getHumanReadableBytes(g_checksum_state->calculatedSize, calculatedUnits);
+	Common::String calculated = Common::getHumanReadableBytes(g_checksum_state->calculatedSize.loadRelaxed(), calculatedUnits);
 	Common::String total = Common::getHumanReadableBytes(g_checksum_state->totalSize, totalUnits);
 	return Common::U32String::format(_("Calculated %s %S / %s %S"), calculated.c_str(), _(calculatedUnits).c_str(), total.c_str(), _(totalUnits).c_str());
 }
@@ -306,6 +309,66 @@ void IntegrityDialog::calculateTotalSize(Common::Path gamePath) {
 	}
 }
 
+static void listFiles(const Common::FSNode &dir, Common::FSList &files) {
+	Common::FSList fileList;
+	if (!dir.getChildren(fileList, Common::FSNode::kListAll))
+		return;
+
+	// Process the files and subdirectories in the current directory recursively
+	for (Common::FSList::const_iterator it = fileList.begin(); it != fileList.end(); it++) {
+		if (it->isDirectory())
+			listFiles(*it, files);
+		else
+			files.push_back(*it);
+	}
+}
+
+static Common::String digestToString(const uint8 digest[16]) {
+	Common::String md5;
+	for (int i = 0; i < 16; i++)
+		md5 += Common::String::format("%02x", (int)digest[i]);
+	return md5;
+}
+
+/**
+ * Append the checksums of all of the stream, of its first 5000 bytes and
+ * first megabyte, and of its last 5000 bytes.
+ */
+static void computeChecksums(Common::SeekableReadStream &stream, Common::StringArray &checksums) {
+	// Various checksizes, in a single pass
+	static const uint32 lengths[3] = {0, 5000, 1024 * 1024};
+	uint8 digests[3][16];
+
+	stream.seek(0);
+	Common::computeStreamMD5s(stream, digests, lengths, 3);
+	for (int i = 0; i < 3; i++)
+		checksums.push_back(digestToString(digests[i]));
+
+	// Tail checksums with checksize 5000
+	stream.seek(MAX<int64>(stream.size() - 5000, 0));
+	checksums.push_back(Common::computeStreamMD5AsString(stream));
+}
+
+void IntegrityDialog::computeFileChecksums(void *refCon) {
+	FileChecksums *file = (FileChecksums *)refCon;
+
+	Common::ScopedPtr<Common::SeekableReadStream> stream(file->node.createReadStream());
+	if (!stream)
+		return;
+
+	file->checksums.push_back(file->node.getPath().toString());
+	computeChecksums(*stream, file->checksums);
+
+	g_checksum_state->calculatedSize.fetchAdd((int)stream->size());
+}
+
+void IntegrityDialog::reportProgress() {
+	if (g_system->getMillis() > g_checksum_state->lastUpdate + 500) {
+		g_checksum_state->lastUpdate = g_system->getMillis();
+		sendCommand(kDownloadProgressCmd, 0);
+	}
+}
+
 Common::Array<Common::StringArray> IntegrityDialog::generateChecksums(Common::Path gamePath, Common::Array<Common::StringArray> &fileChecksums) {
 	const Common::FSNode dir(gamePath);
 
@@ -313,79 +376,64 @@ Common::Array<Common::StringArray> IntegrityDialog::generateChecksums(Common::Pa
 		return {};
 
 	Common::FSList fileList;
-	if (!dir.getChildren(fileList, Common::FSNode::kListAll))
-		return {};
+	listFiles(dir, fileList);
 
 	if (fileList.empty())
 		return {};
 
-	// Process the files and subdirectories in the current directory recursively
-	for (Common::FSList::const_iterator it = fileList.begin(); it != fileList.end(); it++) {
-		const Common::FSNode &entry = *it;
+	// Files are read and hashed in parallel
+	Common::Array<FileChecksums> files;
+	files.resize(fileList.size());
 
-		if (entry.isDirectory())
-			generateChecksums(entry.getPath(), fileChecksums);
-		else {
-			const Common::Path filename(entry.getPath());
-			auto macFile = Common::MacResManager();
-			if (macFile.open(filename)) {
-				auto fileStream = macFile.openFileOrDataFork(filename);
-				Common::SeekableReadStream *dataForkStream;
-				if (macFile.isMacBinary(*fileStream))
-					dataForkStream = macFile.openDataForkFromMacBinary(fileStream);
-				else
-					dataForkStream = fileStream;
-
-				Common::Array<Common::String> fileChecksum = {filename.toString()};
-
-				// Data fork
-				// Various checksizes
-				for (auto size : {0, 5000, 1024 * 1024}) {
-					fileChecksum.push_back(Common::computeStreamMD5AsString(*dataForkStream, size).c_str());
-					dataForkStream->seek(0);
-				}
-				// Tail checksums with checksize 5000
-				dataForkStream->seek(-5000, SEEK_END);
-				fileChecksum.push_back(Common::computeStreamMD5AsString(*dataForkStream).c_str());
-
-				// Resource fork
-				if (macFile.hasResFork()) {
-					// Various checksizes
-					for (auto size : {0, 5000, 1024 * 1024}) {
-						fileChecksum.push_back(macFile.computeResForkMD5AsString(size).c_str());
-					}
-					// Tail checksums with checksize 5000
-					fileChecksum.push_back(macFile.computeResForkMD5AsString(5000, true).c_str());
-					fileChecksums.push_back(fileChecksum);
-				}
-
-				g_checksum_state->calculatedSize += fileStream->size();
-			}
+	Common::JobSystem *jobs = g_system->getJobSystem();
+	Common::JobGroup group;
+	for (uint i = 0; i < files.size(); i++) {
+		files[i].node = fileList[i];
+		jobs->submit(computeFileChecksums, &files[i], &group);
+		reportProgress();
+	}
 
-			Common::File file;
-			if (!file.open(entry))
-				continue;
+	// Meanwhile, resource forks are hashed here, as MacResManager needs SearchMan
+	for (uint i = 0; i < files.size(); i++) {
+		const Common::Path filename(files[i].node.getPath());
+		Common::MacResManager macFile;
+		if (!macFile.open(filename) || !macFile.hasResFork())
+			continue;
 
-			Common::Array<Common::String> fileChecksum = {filename.toString()};
-			// Various checksizes
-			for (auto size : {0, 5000, 1024 * 1024}) {
-				fileChecksum.push_back(Common::computeStreamMD5AsString(file, size).c_str());
-				file.seek(0);
-			}
-			// Tail checksums with checksize 5000
-			file.seek(-5000, SEEK_END);
-			fileChecksum.push_back(Common::computeStreamMD5AsString(file).c_str());
+		Common::ScopedPtr<Common::SeekableReadStream> dataForkStream(Common::MacResManager::openFileOrDataFork(filename));
+		if (dataForkStream && Common::MacResManager::isMacBinary(*dataForkStream))
+			dataForkStream.reset(Common::MacResManager::openDataForkFromMacBinary(dataForkStream.release(), DisposeAfterUse::YES));
+		if (!dataForkStream)
+			continue;
 
-			g_checksum_state->calculatedSize += file.size();
+		Common::StringArray &fileChecksum = files[i].forkChecksums;
+		fileChecksum.push_back(filename.toString());
 
-			if (g_system->getMillis() > g_checksum_state->lastUpdate + 500) {
-				g_checksum_state->lastUpdate = g_system->getMillis();
-				sendCommand(kDownloadProgressCmd, 0);
-			}
+		// Data fork
+		computeChecksums(*dataForkStream, fileChecksum);
 
-			file.close();
-			fileChecksums.push_back(fileChecksum);
+		// Resource fork
+		// Various checksizes
+		for (auto size : {0, 5000, 1024 * 1024}) {
+			fileChecksum.push_back(macFile.computeResForkMD5AsString(size).c_str());
 		}
+		// Tail checksums with checksize 5000
+		fileChecksum.push_back(macFile.computeResForkMD5AsString(5000, true).c_str());
+
+		reportProgress();
+	}
+
+	while (!group.isDone()) {
+		g_system->delayMillis(10);
+		reportProgress();
+	}
+	jobs->wait(group);
+
+	for (uint i = 0; i < files.size(); i++) {
+		if (!files[i].forkChecksums.empty())
+			fileChecksums.push_back(files[i].forkChecksums);
+		if (!files[i].checksums.empty())
+			fileChecksums.push_back(files[i].checksums);
 	}
 
 	setState(kChecksumComplete);
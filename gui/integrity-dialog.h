@@ -26,6 +26,7 @@
 
 #include "common/array.h"
 #include "common/formats/json.h"
+#include "common/fs.h"
 #include "common/str.h"
 
 #include "gui/dialog.h"
@@ -63,8 +64,18 @@ class IntegrityDialog : public Dialog, public CommandSender {
 
 	bool _close;
 
+	/** Checksums of a file, as sent in the request */
+	struct FileChecksums {
+		Common::FSNode node;
+		Common::StringArray checksums;     ///< Of the file
+		Common::StringArray forkChecksums; ///< Of the data and resource forks, if it has a resource fork
+	};
+
 	Common::U32String getSizeLabelText();
 	void refreshWidgets();
+	void reportProgress();
+
+	static void computeFileChecksums(void *refCon);
 
 public:
 	IntegrityDialog(Common::String endpoint, Common::String gameConfig);
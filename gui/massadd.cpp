@@ -46,7 +46,10 @@ enum {
 	// Upper bound (im milliseconds) we want to spend in handleTickle.
 	// Setting this low makes the GUI more responsive but also slows
 	// down the scanning.
-	kMaxScanTime = 50
+	kMaxScanTime = 50,
+
+	// Number of directories that are listed ahead of the detection
+	kMaxPendingDirs = 32
 };
 
 enum {
@@ -109,6 +112,14 @@ MassAddDialog::MassAddDialog(const Common::FSNode &startDir)
 	}
 }
 
+MassAddDialog::~MassAddDialog() {
+	// The listing jobs refer to the pending directories
+	g_system->getJobSystem()->wait(_listingGroup);
+
+	for (Common::List<PendingDir *>::iterator i = _pendingDirs.begin(); i != _pendingDirs.end(); ++i)
+		delete *i;
+}
+
 struct GameTargetLess {
 	bool operator()(const DetectedGame &x, const DetectedGame &y) const {
 		return x.preferredTarget.compareToIgnoreCase(y.preferredTarget) < 0;
@@ -183,100 +194,128 @@ void MassAddDialog::updateGameList() {
 	}
 }
 
-void MassAddDialog::handleTickle() {
-	if (_scanStack.empty())
-		return;	// We have finished scanning
-
-	uint32 t = g_system->getMillis();
-
-	// Perform a breadth-first scan of the filesystem.
-	while (!_scanStack.empty() && (g_system->getMillis() - t) < kMaxScanTime) {
-		Common::FSNode dir = _scanStack.pop();
-
-		Common::FSList files;
-		if (!dir.getChildren(files, Common::FSNode::kListAll)) {
-			continue;
-		}
+void MassAddDialog::scanDirectory(const Common::FSNode &dir, const Common::FSList &files) {
+	// Run the detector on the dir
+	DetectionResults detectionResults = EngineMan.detectGames(files, (ADGF_WARNING | ADGF_UNSUPPORTED), true);
 
-		// Run the detector on the dir
-		DetectionResults detectionResults = EngineMan.detectGames(files, (ADGF_WARNING | ADGF_UNSUPPORTED), true);
+	if (detectionResults.foundUnknownGames()) {
+		Common::U32String report = detectionResults.generateUnknownGameReport(false, 80);
+		g_system->logMessage(LogMessageType::kInfo, report.encode().c_str());
+	}
 
-		if (detectionResults.foundUnknownGames()) {
-			Common::U32String report = detectionResults.generateUnknownGameReport(false, 80);
-			g_system->logMessage(LogMessageType::kInfo, report.encode().c_str());
-		}
+	// Just add all detected games / game variants. If we get more than one,
+	// that either means the directory contains multiple games, or the detector
+	// could not fully determine which game variant it was seeing. In either
+	// case, let the user choose which entries he wants to keep.
+	//
+	// However, we only add games which are not already in the config file.
+	DetectedGames candidates = detectionResults.listRecognizedGames();
+	for (DetectedGames::const_iterator cand = candidates.begin(); cand != candidates.end(); ++cand) {
+		const DetectedGame &result = *cand;
+
+		Common::Path path = dir.getPath();
+		path.removeTrailingSeparators();
 
-		// Just add all detected games / game variants. If we get more than one,
-		// that either means the directory contains multiple games, or the detector
-		// could not fully determine which game variant it was seeing. In either
-		// case, let the user choose which entries he wants to keep.
-		//
-		// However, we only add games which are not already in the config file.
-		DetectedGames candidates = detectionResults.listRecognizedGames();
-		for (DetectedGames::const_iterator cand = candidates.begin(); cand != candidates.end(); ++cand) {
-			const DetectedGame &result = *cand;
-
-			Common::Path path = dir.getPath();
-			path.removeTrailingSeparators();
-
-			// Check for existing config entries for this path/engineid/gameid/lang/platform combination
-			if (_pathToTargets.contains(path)) {
-				Common::String resultPlatformCode = Common::getPlatformCode(result.platform);
-				Common::String resultLanguageCode = Common::getLanguageCode(result.language);
-
-				bool duplicate = false;
-				const Common::StringArray &targets = _pathToTargets[path];
-				for (Common::StringArray::const_iterator iter = targets.begin(); iter != targets.end(); ++iter) {
-					// If the engineid, gameid, platform and language match -> skip it
-					Common::ConfigManager::Domain *dom = ConfMan.getDomain(*iter);
-					assert(dom);
-
-					if ((!dom->contains("engineid") || (*dom)["engineid"] == result.engineId) &&
-						(*dom)["gameid"] == result.gameId &&
-					    dom->getValOrDefault("platform") == resultPlatformCode &&
-						parseLanguage(dom->getValOrDefault("language")) == parseLanguage(resultLanguageCode)) {
-						duplicate = true;
-						break;
-					}
-				}
-				if (duplicate) {
-					_oldGamesCount++;
-					continue;	// Skip duplicates
+		// Check for existing config entries for this path/engineid/gameid/lang/platform combination
+		if (_pathToTargets.contains(path)) {
+			Common::String resultPlatformCode = Common::getPlatformCode(result.platform);
+			Common::String resultLanguageCode = Common::getLanguageCode(result.language);
+
+			bool duplicate = false;
+			const Common::StringArray &targets = _pathToTargets[path];
+			for (Common::StringArray::const_iterator iter = targets.begin(); iter != targets.end(); ++iter) {
+				// If the engineid, gameid, platform and language match -> skip it
+				Common::ConfigManager::Domain *dom = ConfMan.getDomain(*iter);
+				assert(dom);
+
+				if ((!dom->contains("engineid") || (*dom)["engineid"] == result.engineId) &&
+					(*dom)["gameid"] == result.gameId &&
+				    dom->getValOrDefault("platform") == resultPlatformCode &&
+					parseLanguage(dom->getValOrDefault("language")) == parseLanguage(resultLanguageCode)) {
+					duplicate = true;
+					break;
 				}
 			}
-			_games.push_back(result);
-
-			_list->append(result.description);
+			if (duplicate) {
+				_oldGamesCount++;
+				continue;	// Skip duplicates
+			}
 		}
+		_games.push_back(result);
 
-		for (DetectedGame &game : _games) {
-			game.isSelected = true;
-		}
+		_list->append(result.description);
+	}
 
-		updateGameList();
+	for (DetectedGame &game : _games) {
+		game.isSelected = true;
+	}
 
-		// Recurse into all subdirs
-		for (Common::FSList::const_iterator file = files.begin(); file != files.end(); ++file) {
-			if (file->isDirectory()) {
-				_scanStack.push(*file);
+	updateGameList();
 
-				_dirTotal++;
-			}
+	// Recurse into all subdirs
+	for (Common::FSList::const_iterator file = files.begin(); file != files.end(); ++file) {
+		if (file->isDirectory()) {
+			_scanStack.push(*file);
+
+			_dirTotal++;
 		}
+	}
 
-		_dirsScanned++;
+	_dirsScanned++;
 
 #if defined(USE_TASKBAR)
-		g_system->getTaskbarManager()->setProgressValue(_dirsScanned, _dirTotal);
-		g_system->getTaskbarManager()->setCount(_games.size());
+	g_system->getTaskbarManager()->setProgressValue(_dirsScanned, _dirTotal);
+	g_system->getTaskbarManager()->setCount(_games.size());
 #endif
+}
+
+void MassAddDialog::listDirectory(void *refCon) {
+	PendingDir *pending = (PendingDir *)refCon;
+
+	pending->listed = pending->dir.getChildren(pending->files, Common::FSNode::kListAll);
+	pending->done.store(true);
+}
+
+void MassAddDialog::queueListings() {
+	// Listing directories ahead of the detection hides the latency of slow
+	// filesystems, e.g. network shares. Limit how far ahead we get, as the
+	// listings are kept in memory until they are scanned.
+	while (_pendingDirs.size() < kMaxPendingDirs && !_scanStack.empty()) {
+		PendingDir *pending = new PendingDir(_scanStack.pop());
+		_pendingDirs.push_back(pending);
+		g_system->getJobSystem()->submit(listDirectory, pending, &_listingGroup);
+	}
+}
+
+void MassAddDialog::handleTickle() {
+	if (_scanStack.empty() && _pendingDirs.empty())
+		return;	// We have finished scanning
+
+	uint32 t = g_system->getMillis();
+
+	// Perform a breadth-first scan of the filesystem.
+	while ((!_scanStack.empty() || !_pendingDirs.empty()) && (g_system->getMillis() - t) < kMaxScanTime) {
+		queueListings();
+
+		// Wait for the next tickle if the next directory is still being listed
+		PendingDir *pending = _pendingDirs.front();
+		if (!pending->done.load())
+			break;
+
+		_pendingDirs.pop_front();
+		if (pending->listed)
+			scanDirectory(pending->dir, pending->files);
+		delete pending;
 	}
 
 
 	// Update the dialog
 	Common::U32String buf;
 
-	if (_scanStack.empty()) {
+	if (_scanStack.empty() && _pendingDirs.empty()) {
+		// Store the MD5s computed during the scan for the next one
+		ADCacheMan.savePersistentCache();
+
 		// Enable the OK button
 		_okButton->setEnabled(true);
 
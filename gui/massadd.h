@@ -24,8 +24,11 @@
 
 #include "gui/dialog.h"
 #include "gui/widgets/list.h"
+#include "common/atomic.h"
 #include "common/fs.h"
 #include "common/hashmap.h"
+#include "common/jobs.h"
+#include "common/list.h"
 #include "common/stack.h"
 #include "common/str.h"
 
@@ -37,6 +40,7 @@ class MassAddListWidget;
 class MassAddDialog : public Dialog {
 public:
 	MassAddDialog(const Common::FSNode &startDir);
+	~MassAddDialog() override;
 
 	//void open();
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data) override;
@@ -52,6 +56,24 @@ private:
 	Common::Stack<Common::FSNode>  _scanStack;
 	DetectedGames _games;
 
+	/** A directory being listed on the job system, ahead of its detection. */
+	struct PendingDir {
+		PendingDir(const Common::FSNode &d) : dir(d), listed(false), done(false) {}
+
+		Common::FSNode dir;
+		Common::FSList files;
+		bool listed;
+		Common::Atomic<bool> done;
+	};
+
+	/** The directories being listed, in the order they will be scanned. */
+	Common::List<PendingDir *> _pendingDirs;
+	Common::JobGroup _listingGroup;
+
+	static void listDirectory(void *refCon);
+	void queueListings();
+	void scanDirectory(const Common::FSNode &dir, const Common::FSList &files);
+
 	void updateGameList();
 
 	/**
@@ -79,7 +79,7 @@ void GridItemWidget::drawWidget() {
 	int thumbHeight = _grid->getThumbnailHeight();
 	int thumbWidth = _grid->getThumbnailWidth();
 	Common::Array<Common::U32String> titleLines;
-	g_gui.getFont().wordWrapText(_activeEntry->title, thumbWidth, titleLines);
+	g_gui.theme()->wordWrapText(_activeEntry->title, thumbWidth, titleLines);
 
 	// FIXME/HACK: We reserve 1/3 of the space between two items to draw the
 	//			selection border. This can break when the stroke width of
@@ -445,9 +445,12 @@ GridWidget::GridWidget(GuiObject *boss, const Common::String &name)
 
 	_selectedEntry = nullptr;
 	_isGridInvalid = true;
+	_thumbnailsPending = false;
 }
 
 GridWidget::~GridWidget() {
+	if (_thumbnailsPending && ((GUI::Dialog *)_boss)->getTickleWidget() == this)
+		((GUI::Dialog *)_boss)->unSetTickleWidget();
 	unloadSurfaces(_platformIcons);
 	unloadSurfaces(_languageIcons);
 	unloadSurfaces(_extraIcons);
@@ -474,7 +477,7 @@ void GridWidget::unloadSurfaces(Common::HashMap<T, const Graphics::ManagedSurfac
 const Graphics::ManagedSurface *GridWidget::filenameToSurface(const Common::String &name) {
 	if (name.empty())
 		return nullptr;
-	return _loadedSurfaces[name];
+	return _loadedSurfaces.getValOrDefault(name, nullptr);
 }
 
 const Graphics::ManagedSurface *GridWidget::languageToSurface(Common::Language languageCode, Graphics::AlphaType &alphaType) {
@@ -697,47 +700,72 @@ void GridWidget::setGroupHeaderFormat(const Common::U32String &prefix, const Com
 	_groupHeaderSuffix = suffix;
 }
 
-void GridWidget::reloadThumbnails() {
-	const int thumbnailWidth = MAX(_thumbnailWidth - 2 * _thumbnailMargin, 0);
-	const int thumbnailHeight = MAX(_thumbnailHeight - 2 * _thumbnailMargin, 0);
+bool GridWidget::reloadThumbnails(uint32 timeBudget) {
+	// Thumbnails are decoded a few at a time, so that a large library does not
+	// block the GUI. Whatever is left is loaded from handleTickle().
+	const uint32 startTime = g_system->getMillis();
+	bool done = true;
 	for (Common::Array<GridItemInfo *>::iterator iter = _visibleEntryList.begin(); iter != _visibleEntryList.end(); ++iter) {
 		GridItemInfo *entry = *iter;
-		if (entry->thumbPath.empty())
+		if (entry->thumbPath.empty() || _loadedSurfaces.contains(entry->thumbPath))
 			continue;
 
-		if (!_loadedSurfaces.contains(entry->thumbPath)) {
-			_loadedSurfaces[entry->thumbPath] = nullptr;
-			Common::String path = Common::String::format("icons/%s-%s.png", entry->engineid.c_str(), entry->gameid.c_str());
-			Graphics::ManagedSurface *surf = loadSurfaceFromFile(path);
-			if (!surf) {
-				path = Common::String::format("icons/%s.png", entry->engineid.c_str());
-				if (!_loadedSurfaces.contains(path)) {
-					surf = loadSurfaceFromFile(path);
-				} else {
-					const Graphics::ManagedSurface *scSurf = _loadedSurfaces[path];
-					// TODO: Use SharedPtr instead of duplicating the surface
-					Graphics::ManagedSurface *thSurf = new Graphics::ManagedSurface();
-					thSurf->copyFrom(*scSurf);
-					_loadedSurfaces[entry->thumbPath] = thSurf;
-				}
-			}
+		if (g_system->getMillis() - startTime >= timeBudget) {
+			done = false;
+			break;
+		}
+
+		loadThumbnail(entry);
+	}
 
-			if (surf) {
-				const Graphics::ManagedSurface *scSurf(scaleGfx(surf, thumbnailWidth, thumbnailHeight, true));
-				_loadedSurfaces[entry->thumbPath] = scSurf;
+	Dialog *dialog = (GUI::Dialog *)_boss;
+	if (!done && !_thumbnailsPending) {
+		setFlags(WIDGET_WANT_TICKLE);
+		dialog->setTickleWidget(this);
+	} else if (done && _thumbnailsPending) {
+		clearFlags(WIDGET_WANT_TICKLE);
+		if (dialog->getTickleWidget() == this)
+			dialog->unSetTickleWidget();
+	}
+	_thumbnailsPending = !done;
 
-				if (path != entry->thumbPath) {
-					// TODO: Use SharedPtr instead of duplicating the surface
-					Graphics::ManagedSurface *thSurf = new Graphics::ManagedSurface();
-					thSurf->copyFrom(*scSurf);
-					_loadedSurfaces[path] = thSurf;
-				}
+	return done;
+}
 
-				if (surf != scSurf) {
-					surf->free();
-					delete surf;
-				}
-			}
+void GridWidget::loadThumbnail(const GridItemInfo *entry) {
+	const int thumbnailWidth = MAX(_thumbnailWidth - 2 * _thumbnailMargin, 0);
+	const int thumbnailHeight = MAX(_thumbnailHeight - 2 * _thumbnailMargin, 0);
+
+	_loadedSurfaces[entry->thumbPath] = nullptr;
+	Common::String path = Common::String::format("icons/%s-%s.png", entry->engineid.c_str(), entry->gameid.c_str());
+	Graphics::ManagedSurface *surf = loadSurfaceFromFile(path);
+	if (!surf) {
+		path = Common::String::format("icons/%s.png", entry->engineid.c_str());
+		if (!_loadedSurfaces.contains(path)) {
+			surf = loadSurfaceFromFile(path);
+		} else {
+			const Graphics::ManagedSurface *scSurf = _loadedSurfaces[path];
+			// TODO: Use SharedPtr instead of duplicating the surface
+			Graphics::ManagedSurface *thSurf = new Graphics::ManagedSurface();
+			thSurf->copyFrom(*scSurf);
+			_loadedSurfaces[entry->thumbPath] = thSurf;
+		}
+	}
+
+	if (surf) {
+		const Graphics::ManagedSurface *scSurf(scaleGfx(surf, thumbnailWidth, thumbnailHeight, true));
+		_loadedSurfaces[entry->thumbPath] = scSurf;
+
+		if (path != entry->thumbPath) {
+			// TODO: Use SharedPtr instead of duplicating the surface
+			Graphics::ManagedSurface *thSurf = new Graphics::ManagedSurface();
+			thSurf->copyFrom(*scSurf);
+			_loadedSurfaces[path] = thSurf;
+		}
+
+		if (surf != scSurf) {
+			surf->free();
+			delete surf;
 		}
 	}
 }
@@ -924,6 +952,26 @@ int GridWidget::getNewSel(int index) {
 	}
 }
 
+void GridWidget::handleTickle() {
+	if (!_thumbnailsPending)
+		return;
+
+	Common::Array<uint> waitingItems;
+	for (uint k = 0; k < _gridItems.size() && k < _visibleEntryList.size(); ++k) {
+		const Common::String &thumbPath = _visibleEntryList[k]->thumbPath;
+		if (!thumbPath.empty() && !_loadedSurfaces.contains(thumbPath))
+			waitingItems.push_back(k);
+	}
+
+	reloadThumbnails();
+
+	// Show the thumbnails that got loaded
+	for (uint i = 0; i < waitingItems.size(); ++i) {
+		if (_loadedSurfaces.contains(_visibleEntryList[waitingItems[i]]->thumbPath))
+			_gridItems[waitingItems[i]]->update();
+	}
+}
+
 void GridWidget::handleMouseWheel(int x, int y, int direction) {
 	_scrollBar->handleMouseWheel(x, y, direction);
 	_scrollPos = _scrollBar->_currentPos;
@@ -1017,7 +1065,7 @@ void GridWidget::calcEntrySizes() {
 			int titleRows;
 			if (_isTitlesVisible) {
 				Common::Array<Common::U32String> titleLines;
-				g_gui.getFont().wordWrapText(entry->title, _gridItemWidth, titleLines);
+				g_gui.theme()->wordWrapText(entry->title, _gridItemWidth, titleLines);
 				titleRows = MIN(2U, titleLines.size());
 			} else {
 				titleRows = 0;
@@ -46,6 +46,10 @@ enum {
 	kItemSizeCmd = 'SIZE'
 };
 
+enum {
+	kThumbnailLoadTimeBudget = 20	///< Milliseconds spent loading thumbnails at a time
+};
+
 /* GridItemInfo */
 struct GridItemInfo {
 	bool		isHeader, validEntry;
@@ -149,6 +153,7 @@ protected:
 	int				_firstVisibleItem;
 	int				_lastVisibleItem;
 	bool			_isGridInvalid;
+	bool			_thumbnailsPending;
 
 	int				_scrollWindowPaddingX;
 	int				_scrollWindowPaddingY;
@@ -197,7 +202,10 @@ public:
 	void loadClosedGroups(const Common::U32String &groupName);
 	void saveClosedGroups(const Common::U32String &groupName);
 
-	void reloadThumbnails();
+	/// Load the missing thumbnails of the visible entries, returns false if
+	/// the time budget ran out and some are left to load.
+	bool reloadThumbnails(uint32 timeBudget = kThumbnailLoadTimeBudget);
+	void loadThumbnail(const GridItemInfo *entry);
 	void loadFlagIcons();
 	void loadPlatformIcons();
 	void loadExtraIcons();
@@ -219,6 +227,7 @@ public:
 
 	void handleMouseWheel(int x, int y, int direction) override;
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data) override;
+	void handleTickle() override;
 	void reflowLayout() override;
 
 	bool wantsFocus() override { return true; }
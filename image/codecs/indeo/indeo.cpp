@@ -27,6 +27,7 @@
 #include "image/codecs/indeo/indeo_dsp.h"
 #include "image/codecs/indeo/mem.h"
 #include "graphics/yuv_to_rgb.h"
+#include "common/jobs.h"
 #include "common/system.h"
 #include "common/algorithm.h"
 #include "common/rect.h"
@@ -463,7 +464,7 @@ IVI45DecContext::IVI45DecContext() : _gb(nullptr), _frameNum(0), _frameType(0),
 
 /*------------------------------------------------------------------------*/
 
-IndeoDecoderBase::IndeoDecoderBase(uint16 width, uint16 height, uint bitsPerPixel) : Codec(), _surface(nullptr) {
+IndeoDecoderBase::IndeoDecoderBase(uint16 width, uint16 height, uint bitsPerPixel) : Codec(), _convertFrame(nullptr), _surface(nullptr) {
 	_width = width;
 	_height = height;
 	_bitsPerPixel = bitsPerPixel;
@@ -491,6 +492,26 @@ IndeoDecoderBase::~IndeoDecoderBase() {
 	delete _ctx._pFrame;
 }
 
+void IndeoDecoderBase::convertBands(uint begin, uint end, void *refCon) {
+	// Skip the band already converted by decodeIndeoFrame()
+	((IndeoDecoderBase *)refCon)->convertRows(begin + kConvertBandQuads, end + kConvertBandQuads);
+}
+
+void IndeoDecoderBase::convertRows(uint beginQuad, uint endQuad) {
+	const AVFrame *frame = _convertFrame;
+	const uint y = beginQuad * 4;
+	const uint height = (endQuad - beginQuad) * 4;
+
+	Graphics::Surface band;
+	band.init(_surface->w, height, _surface->pitch, _surface->getBasePtr(0, y), _surface->format);
+
+	// The luma and chroma planes share the same pitch
+	YUVToRGBMan.convert410(&band, Graphics::YUVToRGBManager::kScaleITU,
+		frame->_data[0] + y * frame->_width, frame->_data[1] + beginQuad * frame->_width,
+		frame->_data[2] + beginQuad * frame->_width, frame->_width, height,
+		frame->_width, frame->_width);
+}
+
 int IndeoDecoderBase::decodeIndeoFrame() {
 	int result;
 	AVFrame frameData;
@@ -577,10 +598,17 @@ int IndeoDecoderBase::decodeIndeoFrame() {
 	outputPlane(&_ctx._planes[2], frame->_data[1], frame->_linesize[1]);
 	outputPlane(&_ctx._planes[1], frame->_data[2], frame->_linesize[2]);
 
-	// Merge the planes into the final surface
-	YUVToRGBMan.convert410(_surface, Graphics::YUVToRGBManager::kScaleITU,
-		frame->_data[0], frame->_data[1], frame->_data[2], frame->_width, frame->_height,
-		frame->_width, frame->_width);
+	// Merge the planes into the final surface, in bands of rows on the job
+	// system. The first band also sets up the conversion tables, which must
+	// not happen concurrently.
+	const uint quads = frame->_height / 4;
+	const uint firstBand = MIN<uint>(quads, kConvertBandQuads);
+
+	_convertFrame = frame;
+	convertRows(0, firstBand);
+	if (firstBand < quads)
+		g_system->getJobSystem()->parallelFor(quads - firstBand, convertBands, this, kConvertBandQuads);
+	_convertFrame = nullptr;
 
 	if (_ctx._hasTransp)
 		decodeTransparency();
@@ -516,6 +516,20 @@ private:
 
 	int iviDcTransform(IVIBandDesc *band, int32 *prevDc, int bufOffs,
 		int blkSize);
+
+	/**
+	 * Number of 4 row groups merged into the surface by each job
+	 */
+	static const uint kConvertBandQuads = 8;
+
+	/**
+	 * Merge the planes of the frame being output into the surface, for
+	 * the 4 row groups from beginQuad to endQuad
+	 */
+	void convertRows(uint beginQuad, uint endQuad);
+	static void convertBands(uint begin, uint end, void *refCon);
+
+	const AVFrame *_convertFrame;
 protected:
 	IVI45DecContext _ctx;
 	uint16 _width;
@@ -0,0 +1,159 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "image/codecs/indeo/indeo_dsp.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Image {
+namespace Indeo {
+
+static inline void neon_transpose(int32x4_t &r0, int32x4_t &r1, int32x4_t &r2, int32x4_t &r3) {
+	const int32x4x2_t t01 = vtrnq_s32(r0, r1);
+	const int32x4x2_t t23 = vtrnq_s32(r2, r3);
+	r0 = vcombine_s32(vget_low_s32(t01.val[0]), vget_low_s32(t23.val[0]));
+	r1 = vcombine_s32(vget_low_s32(t01.val[1]), vget_low_s32(t23.val[1]));
+	r2 = vcombine_s32(vget_high_s32(t01.val[0]), vget_high_s32(t23.val[0]));
+	r3 = vcombine_s32(vget_high_s32(t01.val[1]), vget_high_s32(t23.val[1]));
+}
+
+// The same steps as IVI_INV_SLANT8 in indeo_dsp.cpp, for four columns or
+// rows at once. The inputs are in the order the macro takes them.
+template<bool compensate>
+static inline void neon_invSlant8(int32x4_t *v) {
+	const int32x4_t two = vdupq_n_s32(2);
+	const int32x4_t four = vdupq_n_s32(4);
+
+	// IVI_SLANT_PART4(s4, s5, t4, t5)
+	int32x4_t t4 = vaddq_s32(v[3], vshrq_n_s32(vaddq_s32(vsubq_s32(vshlq_n_s32(v[1], 2), v[3]), four), 3));
+	int32x4_t t5 = vaddq_s32(v[1], vshrq_n_s32(vsubq_s32(vsubq_s32(four, v[1]), vshlq_n_s32(v[3], 2)), 3));
+
+	int32x4_t t1 = vaddq_s32(v[0], t5);
+	t5 = vsubq_s32(v[0], t5);
+	int32x4_t t2 = vaddq_s32(v[4], v[5]);
+	int32x4_t t6 = vsubq_s32(v[4], v[5]);
+	int32x4_t t7 = vaddq_s32(v[7], v[6]);
+	int32x4_t t3 = vsubq_s32(v[7], v[6]);
+	int32x4_t t8 = vsubq_s32(t4, v[2]);
+	t4 = vaddq_s32(t4, v[2]);
+
+	int32x4_t t0 = vaddq_s32(t1, t2);
+	t2 = vsubq_s32(t1, t2);
+	t1 = t0;
+
+	// IVI_IREFLECT(t4, t3, t4, t3)
+	t0 = vaddq_s32(vshrq_n_s32(vaddq_s32(vaddq_s32(t4, vshlq_n_s32(t3, 1)), two), 2), t4);
+	t3 = vsubq_s32(vshrq_n_s32(vaddq_s32(vsubq_s32(vshlq_n_s32(t4, 1), t3), two), 2), t3);
+	t4 = t0;
+
+	t0 = vaddq_s32(t5, t6);
+	t6 = vsubq_s32(t5, t6);
+	t5 = t0;
+
+	// IVI_IREFLECT(t8, t7, t8, t7)
+	t0 = vaddq_s32(vshrq_n_s32(vaddq_s32(vaddq_s32(t8, vshlq_n_s32(t7, 1)), two), 2), t8);
+	t7 = vsubq_s32(vshrq_n_s32(vaddq_s32(vsubq_s32(vshlq_n_s32(t8, 1), t7), two), 2), t7);
+	t8 = t0;
+
+	v[0] = vaddq_s32(t1, t4);
+	v[3] = vsubq_s32(t1, t4);
+	v[1] = vaddq_s32(t2, t3);
+	v[2] = vsubq_s32(t2, t3);
+	v[4] = vaddq_s32(t5, t8);
+	v[7] = vsubq_s32(t5, t8);
+	v[5] = vaddq_s32(t6, t7);
+	v[6] = vsubq_s32(t6, t7);
+
+	if (compensate) {
+		const int32x4_t one = vdupq_n_s32(1);
+		for (int i = 0; i < 8; i++)
+			v[i] = vshrq_n_s32(vaddq_s32(v[i], one), 1);
+	}
+}
+
+void IndeoDSP::ffIviInverseSlant8x8NEON(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+	// cols[h][r] holds row r of the columns 4 * h to 4 * h + 3
+	int32x4_t cols[2][8];
+
+	for (int h = 0; h < 2; h++) {
+		for (int r = 0; r < 8; r++)
+			cols[h][r] = vld1q_s32(in + r * 8 + h * 4);
+
+		neon_invSlant8<false>(cols[h]);
+
+		// Empty columns are skipped by the generic code, so clear them
+		const uint32 columnFlags[4] = { flags[h * 4], flags[h * 4 + 1], flags[h * 4 + 2], flags[h * 4 + 3] };
+		const int32x4_t mask = vreinterpretq_s32_u32(vceqq_u32(vld1q_u32(columnFlags), vdupq_n_u32(0)));
+		for (int r = 0; r < 8; r++)
+			cols[h][r] = vbicq_s32(cols[h][r], mask);
+	}
+
+	// Rows which are all zero stay zero in the second pass, so there is no
+	// need to special case them like the generic code does
+	for (int h = 0; h < 2; h++) {
+		// rows[k] holds the coefficients k of the rows 4 * h to 4 * h + 3
+		int32x4_t rows[8];
+		for (int k = 0; k < 4; k++) {
+			rows[k] = cols[0][h * 4 + k];
+			rows[k + 4] = cols[1][h * 4 + k];
+		}
+		neon_transpose(rows[0], rows[1], rows[2], rows[3]);
+		neon_transpose(rows[4], rows[5], rows[6], rows[7]);
+
+		neon_invSlant8<true>(rows);
+
+		// Narrowing wraps to 16 bits like the stores of the generic code do
+		neon_transpose(rows[0], rows[1], rows[2], rows[3]);
+		neon_transpose(rows[4], rows[5], rows[6], rows[7]);
+		for (int r = 0; r < 4; r++)
+			vst1q_s16(out + (h * 4 + r) * pitch, vcombine_s16(vmovn_s32(rows[r]), vmovn_s32(rows[r + 4])));
+	}
+}
+
+} // End of namespace Indeo
+} // End of namespace Image
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
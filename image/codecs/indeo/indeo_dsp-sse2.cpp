@@ -0,0 +1,160 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "image/codecs/indeo/indeo_dsp.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Image {
+namespace Indeo {
+
+static inline void sse2_transpose(__m128i &r0, __m128i &r1, __m128i &r2, __m128i &r3) {
+	const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+	const __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+	const __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+	const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+	r0 = _mm_unpacklo_epi64(t0, t1);
+	r1 = _mm_unpackhi_epi64(t0, t1);
+	r2 = _mm_unpacklo_epi64(t2, t3);
+	r3 = _mm_unpackhi_epi64(t2, t3);
+}
+
+// The same steps as IVI_INV_SLANT8 in indeo_dsp.cpp, for four columns or
+// rows at once. The inputs are in the order the macro takes them.
+template<bool compensate>
+static inline void sse2_invSlant8(__m128i *v) {
+	const __m128i two = _mm_set1_epi32(2);
+	const __m128i four = _mm_set1_epi32(4);
+
+	// IVI_SLANT_PART4(s4, s5, t4, t5)
+	__m128i t4 = _mm_add_epi32(v[3], _mm_srai_epi32(_mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(v[1], 2), v[3]), four), 3));
+	__m128i t5 = _mm_add_epi32(v[1], _mm_srai_epi32(_mm_sub_epi32(_mm_sub_epi32(four, v[1]), _mm_slli_epi32(v[3], 2)), 3));
+
+	__m128i t1 = _mm_add_epi32(v[0], t5);
+	t5 = _mm_sub_epi32(v[0], t5);
+	__m128i t2 = _mm_add_epi32(v[4], v[5]);
+	__m128i t6 = _mm_sub_epi32(v[4], v[5]);
+	__m128i t7 = _mm_add_epi32(v[7], v[6]);
+	__m128i t3 = _mm_sub_epi32(v[7], v[6]);
+	__m128i t8 = _mm_sub_epi32(t4, v[2]);
+	t4 = _mm_add_epi32(t4, v[2]);
+
+	__m128i t0 = _mm_add_epi32(t1, t2);
+	t2 = _mm_sub_epi32(t1, t2);
+	t1 = t0;
+
+	// IVI_IREFLECT(t4, t3, t4, t3)
+	t0 = _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(t4, _mm_slli_epi32(t3, 1)), two), 2), t4);
+	t3 = _mm_sub_epi32(_mm_srai_epi32(_mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(t4, 1), t3), two), 2), t3);
+	t4 = t0;
+
+	t0 = _mm_add_epi32(t5, t6);
+	t6 = _mm_sub_epi32(t5, t6);
+	t5 = t0;
+
+	// IVI_IREFLECT(t8, t7, t8, t7)
+	t0 = _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(t8, _mm_slli_epi32(t7, 1)), two), 2), t8);
+	t7 = _mm_sub_epi32(_mm_srai_epi32(_mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(t8, 1), t7), two), 2), t7);
+	t8 = t0;
+
+	v[0] = _mm_add_epi32(t1, t4);
+	v[3] = _mm_sub_epi32(t1, t4);
+	v[1] = _mm_add_epi32(t2, t3);
+	v[2] = _mm_sub_epi32(t2, t3);
+	v[4] = _mm_add_epi32(t5, t8);
+	v[7] = _mm_sub_epi32(t5, t8);
+	v[5] = _mm_add_epi32(t6, t7);
+	v[6] = _mm_sub_epi32(t6, t7);
+
+	if (compensate) {
+		const __m128i one = _mm_set1_epi32(1);
+		for (int i = 0; i < 8; i++)
+			v[i] = _mm_srai_epi32(_mm_add_epi32(v[i], one), 1);
+	}
+}
+
+// Wrap to 16 bits like the stores of the generic code do
+static inline __m128i sse2_narrow(__m128i lo, __m128i hi) {
+	lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+	hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+	return _mm_packs_epi32(lo, hi);
+}
+
+void IndeoDSP::ffIviInverseSlant8x8SSE2(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+	// cols[h][r] holds row r of the columns 4 * h to 4 * h + 3
+	__m128i cols[2][8];
+
+	for (int h = 0; h < 2; h++) {
+		for (int r = 0; r < 8; r++)
+			cols[h][r] = _mm_loadu_si128((const __m128i *)(in + r * 8 + h * 4));
+
+		sse2_invSlant8<false>(cols[h]);
+
+		// Empty columns are skipped by the generic code, so clear them
+		const __m128i mask = _mm_cmpeq_epi32(_mm_set_epi32(flags[h * 4 + 3], flags[h * 4 + 2], flags[h * 4 + 1], flags[h * 4]), _mm_setzero_si128());
+		for (int r = 0; r < 8; r++)
+			cols[h][r] = _mm_andnot_si128(mask, cols[h][r]);
+	}
+
+	// Rows which are all zero stay zero in the second pass, so there is no
+	// need to special case them like the generic code does
+	for (int h = 0; h < 2; h++) {
+		// rows[k] holds the coefficients k of the rows 4 * h to 4 * h + 3
+		__m128i rows[8];
+		for (int k = 0; k < 4; k++) {
+			rows[k] = cols[0][h * 4 + k];
+			rows[k + 4] = cols[1][h * 4 + k];
+		}
+		sse2_transpose(rows[0], rows[1], rows[2], rows[3]);
+		sse2_transpose(rows[4], rows[5], rows[6], rows[7]);
+
+		sse2_invSlant8<true>(rows);
+
+		sse2_transpose(rows[0], rows[1], rows[2], rows[3]);
+		sse2_transpose(rows[4], rows[5], rows[6], rows[7]);
+		for (int r = 0; r < 4; r++)
+			_mm_storeu_si128((__m128i *)(out + (h * 4 + r) * pitch), sse2_narrow(rows[r], rows[r + 4]));
+	}
+}
+
+} // End of namespace Indeo
+} // End of namespace Image
+
+#if !defined(__x86_64__)
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+#endif
@@ -27,6 +27,8 @@
 
 #include "image/codecs/indeo/indeo_dsp.h"
 
+#include "common/system.h"
+
 namespace Image {
 namespace Indeo {
 
@@ -320,7 +322,24 @@ void IndeoDSP::ffIviDcHaar2d(const int32 *in, int16 *out, uint32 pitch,
 	d3 = COMPENSATE(t3);\
 	d4 = COMPENSATE(t4);}
 
+InvTransformPtr *IndeoDSP::_inverseSlant8x8 = nullptr;
+
 void IndeoDSP::ffIviInverseSlant8x8(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+	// If no function has been selected yet, detect and select
+	if (!_inverseSlant8x8) {
+		_inverseSlant8x8 = ffIviInverseSlant8x8Generic;
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) _inverseSlant8x8 = ffIviInverseSlant8x8NEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) _inverseSlant8x8 = ffIviInverseSlant8x8SSE2;
+#endif
+	}
+
+	_inverseSlant8x8(in, out, pitch, flags);
+}
+
+void IndeoDSP::ffIviInverseSlant8x8Generic(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
 	int32 tmp[64];
 	int t0, t1, t2, t3, t4, t5, t6, t7, t8;
 
@@ -145,6 +145,26 @@ public:
 	static void ffIviInverseSlant8x8(const int32 *in, int16 *out, uint32 pitch,
 		const uint8 *flags);
 
+	/**
+	 *  Implementations of ffIviInverseSlant8x8(), which forwards to the
+	 *  fastest one supported by the CPU
+	 */
+	static void ffIviInverseSlant8x8Generic(const int32 *in, int16 *out, uint32 pitch,
+		const uint8 *flags);
+#ifdef SCUMMVM_NEON
+	static void ffIviInverseSlant8x8NEON(const int32 *in, int16 *out, uint32 pitch,
+		const uint8 *flags);
+#endif
+#ifdef SCUMMVM_SSE2
+	static void ffIviInverseSlant8x8SSE2(const int32 *in, int16 *out, uint32 pitch,
+		const uint8 *flags);
+#endif
+
+	/**
+	 *  The implementation used by ffIviInverseSlant8x8(), selected on first use
+	 */
+	static InvTransformPtr *_inverseSlant8x8;
+
 	/**
 	 *  two-dimensional inverse slant 4x4 transform
 	 *
@@ -22,7 +22,9 @@
 #ifndef IMAGE_CODECS_MJPEG_H
 #define IMAGE_CODECS_MJPEG_H
 
+#include "common/array.h"
 #include "image/codecs/codec.h"
+#include "image/jpeg.h"
 #include "graphics/pixelformat.h"
 
 namespace Common {
@@ -57,8 +59,13 @@ public:
 
 private:
 	Graphics::PixelFormat _pixelFormat;
-	Graphics::Surface *_surface;
 	CodecAccuracy _accuracy;
+
+	/** Reused for every frame, so that its state and surface are only set up once */
+	JPEGDecoder _jpeg;
+
+	/** The frame converted to a JPEG/JFIF image */
+	Common::Array<byte> _data;
 };
 
 } // End of namespace Image
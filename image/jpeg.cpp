@@ -47,12 +47,10 @@ namespace Image {
 JPEGDecoder::JPEGDecoder() :
 		_surface(),
 		_colorSpace(kColorSpaceRGB),
+		_requestedPixelFormat(getByteOrderRgbPixelFormat()),
 		_accuracy(CodecAccuracy::Default),
-		_requestedPixelFormat(getByteOrderRgbPixelFormat()) {
-}
-
-JPEGDecoder::~JPEGDecoder() {
-	destroy();
+		_scaleDenominator(1),
+		_decompressor(nullptr) {
 }
 
 Graphics::PixelFormat JPEGDecoder::getByteOrderRgbPixelFormat() const {
@@ -89,6 +87,11 @@ Graphics::PixelFormat JPEGDecoder::getPixelFormat() const {
 }
 
 #ifdef USE_JPEG
+struct JPEGDecoder::Decompressor {
+	jpeg_decompress_struct cinfo;
+	jpeg_error_mgr jerr;
+};
+
 namespace {
 
 #define JPEG_BUFFER_SIZE 4096
@@ -206,6 +209,10 @@ J_COLOR_SPACE fromScummvmPixelFormat(const Graphics::PixelFormat &format) {
 		{ Graphics::PixelFormat(3, 8, 8, 8, 0, 16,  8,  0,  0), JCS_EXT_RGB,  JCS_EXT_BGR  },
 		{ Graphics::PixelFormat(3, 8, 8, 8, 0,  0,  8, 16,  0), JCS_EXT_BGR,  JCS_EXT_RGB  }
 #endif
+#ifdef LIBJPEG_TURBO_VERSION_NUMBER
+		// Written in native byte order
+		, { Graphics::PixelFormat(2, 5, 6, 5, 0, 11,  5,  0,  0), JCS_RGB565,   JCS_RGB565   }
+#endif
 #if defined(JCS_EXTENSIONS) && defined(JCS_ALPHA_EXTENSIONS)
 		,
 #endif
@@ -234,26 +241,34 @@ J_COLOR_SPACE fromScummvmPixelFormat(const Graphics::PixelFormat &format) {
 } // End of anonymous namespace
 #endif
 
-bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
-#ifdef USE_JPEG
-	// Reset member variables from previous decodings
+JPEGDecoder::~JPEGDecoder() {
 	destroy();
 
-	jpeg_decompress_struct cinfo;
-	jpeg_error_mgr jerr;
-
-	// Initialize error handling callbacks
-	cinfo.err = jpeg_std_error(&jerr);
-	cinfo.err->error_exit = &errorExit;
-	cinfo.err->output_message = &outputMessage;
+#ifdef USE_JPEG
+	if (_decompressor) {
+		jpeg_destroy_decompress(&_decompressor->cinfo);
+		delete _decompressor;
+	}
+#endif
+}
 
-	// Initialize the decompression structure
-	jpeg_create_decompress(&cinfo);
+bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
+#ifdef USE_JPEG
+	// The decompression structure is kept for the next image, which saves
+	// setting up its memory pools and source buffer each time
+	if (!_decompressor) {
+		_decompressor = new Decompressor();
+
+		// Initialize error handling callbacks
+		_decompressor->cinfo.err = jpeg_std_error(&_decompressor->jerr);
+		_decompressor->cinfo.err->error_exit = &errorExit;
+		_decompressor->cinfo.err->output_message = &outputMessage;
+
+		// Initialize the decompression structure
+		jpeg_create_decompress(&_decompressor->cinfo);
+	}
 
-	if (_accuracy <= CodecAccuracy::Fast)
-		cinfo.dct_method = JDCT_FASTEST;
-	else if (_accuracy >= CodecAccuracy::Accurate)
-		cinfo.dct_method = JDCT_ISLOW;
+	jpeg_decompress_struct &cinfo = _decompressor->cinfo;
 
 	// Initialize our buffer handling
 	jpeg_scummvm_src(&cinfo, &stream);
@@ -261,6 +276,17 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	// Read the file header
 	jpeg_read_header(&cinfo, TRUE);
 
+	// The decompression parameters are reset by reading the header
+	if (_accuracy <= CodecAccuracy::Fast) {
+		cinfo.dct_method = JDCT_FASTEST;
+		cinfo.do_fancy_upsampling = FALSE;
+	} else if (_accuracy >= CodecAccuracy::Accurate) {
+		cinfo.dct_method = JDCT_ISLOW;
+	}
+
+	cinfo.scale_num = 1;
+	cinfo.scale_denom = _scaleDenominator;
+
 	// We can request YUV output because Groovie requires it
 	switch (_colorSpace) {
 	case kColorSpaceRGB: {
@@ -291,51 +317,64 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 		cinfo.out_color_space = JCS_CMYK;
 	}
 
+#ifdef LIBJPEG_TURBO_VERSION_NUMBER
+	// Match the result of converting from RGB afterwards
+	if (cinfo.out_color_space == JCS_RGB565)
+		cinfo.dither_mode = JDITHER_NONE;
+#endif
+
 	// Actually start decompressing the image
 	jpeg_start_decompress(&cinfo);
 
 	// Allocate buffers for the output data
+	Graphics::PixelFormat outputPixelFormat;
 	switch (_colorSpace) {
-	case kColorSpaceRGB: {
-		Graphics::PixelFormat outputPixelFormat;
+	case kColorSpaceRGB:
 		if (cinfo.out_color_space == JCS_RGB) {
 			outputPixelFormat = getByteOrderRgbPixelFormat();
 		} else {
 			outputPixelFormat = _requestedPixelFormat;
 		}
-		_surface.create(cinfo.output_width, cinfo.output_height, outputPixelFormat);
 		break;
-	}
 	case kColorSpaceYUV:
 		// We use YUV with 3 bytes per pixel otherwise.
 		// This is pretty ugly since our PixelFormat cannot express YUV...
-		_surface.create(cinfo.output_width, cinfo.output_height, Graphics::PixelFormat(3, 0, 0, 0, 0, 0, 0, 0, 0));
+		outputPixelFormat = Graphics::PixelFormat(3, 0, 0, 0, 0, 0, 0, 0, 0);
 		break;
 	default:
 		break;
 	}
+
+	// Reuse the surface of the previous image when possible, which is
+	// common for video frames
+	if (!_surface.getPixels() || _surface.w != (int16)cinfo.output_width || _surface.h != (int16)cinfo.output_height ||
+	    _surface.format != outputPixelFormat) {
+		destroy();
+		_surface.create(cinfo.output_width, cinfo.output_height, outputPixelFormat);
+	}
+
 	// Size of output pixel must match 4 bytes.
 	if (cinfo.out_color_space == JCS_CMYK) {
 		assert(_surface.format.bytesPerPixel == 4);
 	}
 
-	// Allocate buffer for one scanline
-	JDIMENSION pitch = cinfo.output_width * _surface.format.bytesPerPixel;
-	assert(_surface.pitch >= (int)pitch);
-	JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, pitch, 1);
+	assert(_surface.pitch >= (int)(cinfo.output_width * _surface.format.bytesPerPixel));
 
-	// Go through the image data scanline by scanline
-	while (cinfo.output_scanline < cinfo.output_height) {
-		byte *dst = (byte *)_surface.getBasePtr(0, cinfo.output_scanline);
+	// Decode straight into the surface, several scanlines at a time
+	enum { kMaxScanlines = 16 };
+	JSAMPROW rows[kMaxScanlines];
 
-		jpeg_read_scanlines(&cinfo, buffer, 1);
+	while (cinfo.output_scanline < cinfo.output_height) {
+		const JDIMENSION count = MIN<JDIMENSION>(kMaxScanlines, cinfo.output_height - cinfo.output_scanline);
+		for (JDIMENSION i = 0; i < count; i++)
+			rows[i] = (JSAMPROW)_surface.getBasePtr(0, cinfo.output_scanline + i);
 
-		memcpy(dst, buffer[0], pitch);
+		jpeg_read_scanlines(&cinfo, rows, count);
 	}
 
-	// We are done with decompressing, thus free all the data
+	// We are done with decompressing, the structure is ready for the next
+	// image now
 	jpeg_finish_decompress(&cinfo);
-	jpeg_destroy_decompress(&cinfo);
 
 	if (_colorSpace == kColorSpaceRGB && _surface.format != _requestedPixelFormat) {
 		_surface.convertToInPlace(_requestedPixelFormat); // Slow path
@@ -102,11 +102,28 @@ public:
 	 */
 	void setOutputColorSpace(ColorSpace outSpace) { _colorSpace = outSpace; }
 
+	/**
+	 * Request the image to be scaled down while it is decoded. This is much
+	 * faster than decoding it at full size, e.g. for thumbnails.
+	 *
+	 * The decoder itself defaults to no scaling.
+	 *
+	 * @param denominator The image is scaled by 1 / denominator. Only 1, 2, 4
+	 *                    and 8 are supported by all versions of libjpeg.
+	 */
+	void setOutputScale(uint denominator) { _scaleDenominator = denominator; }
+
 private:
+	struct Decompressor;
+
 	Graphics::Surface _surface;
 	ColorSpace _colorSpace;
 	Graphics::PixelFormat _requestedPixelFormat;
 	CodecAccuracy _accuracy;
+	uint _scaleDenominator;
+
+	/** The libjpeg state, kept around to be reused by the next image */
+	Decompressor *_decompressor;
 
 	Graphics::PixelFormat getByteOrderRgbPixelFormat() const;
 };
@@ -13,6 +13,7 @@ MODULE_OBJS := \
 	pict.o \
 	png.o \
 	scr.o \
+	screenshot.o \
 	tga.o \
 	xbm.o \
 	codecs/bmp_raw.o \
@@ -55,6 +56,15 @@ MODULE_OBJS += \
 	codecs/indeo/indeo_dsp.o \
 	codecs/indeo/mem.o \
 	codecs/indeo/vlc.o
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	codecs/indeo/indeo_dsp-neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	codecs/indeo/indeo_dsp-sse2.o
+endif
 endif
 
 ifdef USE_HNM
@@ -30,12 +30,16 @@
 
 #include "image/png.h"
 
+#include "graphics/blit.h"
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
+#include "common/atomic.h"
 #include "common/debug.h"
 #include "common/array.h"
+#include "common/jobs.h"
 #include "common/stream.h"
+#include "common/system.h"
 
 namespace Image {
 
@@ -45,7 +49,11 @@ PNGDecoder::PNGDecoder() :
 		_skipSignature(false),
 		_keepTransparencyPaletted(false),
 		_hasTransparentColor(false),
-		_transparentColor(0) {
+		_transparentColor(0),
+		_destSurface(nullptr),
+		_rowCallback(nullptr),
+		_rowCallbackRefCon(nullptr),
+		_ownsOutputSurface(true) {
 }
 
 PNGDecoder::~PNGDecoder() {
@@ -54,7 +62,8 @@ PNGDecoder::~PNGDecoder() {
 
 void PNGDecoder::destroy() {
 	if (_outputSurface) {
-		_outputSurface->free();
+		if (_ownsOutputSurface)
+			_outputSurface->free();
 		delete _outputSurface;
 		_outputSurface = 0;
 	}
@@ -100,6 +109,73 @@ void pngFlushStream(png_structp pngPtr) {
 }
 #endif
 
+#ifdef USE_PNG
+namespace {
+
+/**
+ * Find the libpng transformations which output rows in the given format.
+ *
+ * @return False if libpng can't output the format, which means the rows
+ *         have to be converted.
+ */
+bool getFormatTransforms(const Graphics::PixelFormat &format, bool &bgr, bool &alphaFirst) {
+	if (format.bytesPerPixel != 4 || format.rLoss || format.gLoss || format.bLoss || (format.aLoss && format.aLoss != 8))
+		return false;
+	if ((format.rShift | format.gShift | format.bShift | format.aShift) & 7)
+		return false;
+
+	// The position of each channel in memory
+#ifdef SCUMM_BIG_ENDIAN
+	const int r = 3 - format.rShift / 8, g = 3 - format.gShift / 8, b = 3 - format.bShift / 8;
+#else
+	const int r = format.rShift / 8, g = format.gShift / 8, b = format.bShift / 8;
+#endif
+	// Without alpha, the filler goes into the remaining byte
+	const int a = format.aLoss ? 6 - r - g - b :
+#ifdef SCUMM_BIG_ENDIAN
+		3 - format.aShift / 8;
+#else
+		format.aShift / 8;
+#endif
+
+	if (r == 0 && g == 1 && b == 2 && a == 3) {
+		bgr = false;
+		alphaFirst = false;
+	} else if (r == 2 && g == 1 && b == 0 && a == 3) {
+		bgr = true;
+		alphaFirst = false;
+	} else if (r == 1 && g == 2 && b == 3 && a == 0) {
+		bgr = false;
+		alphaFirst = true;
+	} else if (r == 3 && g == 2 && b == 1 && a == 0) {
+		bgr = true;
+		alphaFirst = true;
+	} else {
+		return false;
+	}
+
+	return true;
+}
+
+} // End of anonymous namespace
+#endif
+
+void PNGDecoder::finishRow(int y, const byte *src, const uint32 *rgbaPalette, const Graphics::PixelFormat &srcFormat) {
+	byte *dst = (byte *)_outputSurface->getBasePtr(0, y);
+
+	if (rgbaPalette) {
+		uint32 *destRowP = (uint32 *)dst;
+		for (int xp = 0; xp < _outputSurface->w; ++xp)
+			destRowP[xp] = rgbaPalette[src[xp]];
+	} else if (src) {
+		Graphics::crossBlit(dst, src, _outputSurface->pitch, _outputSurface->w * srcFormat.bytesPerPixel,
+		                    _outputSurface->w, 1, _outputSurface->format, srcFormat);
+	}
+
+	if (_rowCallback)
+		_rowCallback(*_outputSurface, y, _rowCallbackRefCon);
+}
+
 /*
  * This code is based on Broken Sword 2.5 engine
  *
@@ -158,13 +234,21 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	width = w;
 	height = h;
 
-	// Allocate memory for the final image data.
-	// To keep memory framentation low this happens before allocating memory for temporary image data.
-	_outputSurface = new Graphics::Surface();
+	if (_destSurface && (width > _destSurface->w || height > _destSurface->h)) {
+		warning("PNGDecoder::loadStream(): %dx%d image doesn't fit the output surface", width, height);
+		png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
+		return false;
+	}
+
+	// The format of the output surface, or none to pick one for the image
+	Graphics::PixelFormat outputFormat = _destSurface ? _destSurface->format : _requestedPixelFormat;
+	// The format libpng outputs the rows in
+	Graphics::PixelFormat decodeFormat;
 
 	// Images of all color formats except PNG_COLOR_TYPE_PALETTE
-	// will be transformed into ARGB images
-	if (colorType == PNG_COLOR_TYPE_PALETTE && (_keepTransparencyPaletted || !png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS))) {
+	// will be transformed into ARGB images, unless another format is requested
+	if (colorType == PNG_COLOR_TYPE_PALETTE && outputFormat.bytesPerPixel <= 1 &&
+	    (_keepTransparencyPaletted || !png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS))) {
 		int numPalette = 0;
 		png_colorp palette = NULL;
 		png_bytep trans = nullptr;
@@ -198,8 +282,16 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 			}
 		}
 
-		_outputSurface->create(width, height,
-			hasRgbaPalette ? getByteOrderRgbaPixelFormat(true) : Graphics::PixelFormat::createFormatCLUT8());
+		decodeFormat = Graphics::PixelFormat::createFormatCLUT8();
+		if (!hasRgbaPalette) {
+			outputFormat = decodeFormat;
+		} else if (outputFormat.bytesPerPixel == 0) {
+			outputFormat = getByteOrderRgbaPixelFormat(true);
+		} else {
+			warning("PNGDecoder::loadStream(): Image with transparent palette can't be output in CLUT8");
+			png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
+			return false;
+		}
 		png_set_packing(pngPtr);
 
 		if (hasRgbaPalette) {
@@ -207,7 +299,7 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 			Common::fill(&rgbaPalette[0], &rgbaPalette[256], 0);
 			for (int i = 0; i < numPalette; ++i) {
 				byte a = (i < numTrans) ? trans[i] : 0xff;
-				rgbaPalette[i] = _outputSurface->format.ARGBToColor(
+				rgbaPalette[i] = outputFormat.ARGBToColor(
 					a, palette[i].red, palette[i].green, palette[i].blue);
 			}
 
@@ -215,16 +307,20 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 			_palette.clear();
 		}
 	} else {
- 		bool isAlpha = (colorType & PNG_COLOR_MASK_ALPHA);
+		if (outputFormat.isCLUT8()) {
+			warning("PNGDecoder::loadStream(): Image can't be output in CLUT8");
+			png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
+			return false;
+		}
+
+		bool isAlpha = (colorType & PNG_COLOR_MASK_ALPHA);
+		if (colorType == PNG_COLOR_TYPE_PALETTE)
+			png_set_palette_to_rgb(pngPtr);
 		if (png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS)) {
- 			isAlpha = true;
+			isAlpha = true;
 			png_set_expand(pngPtr);
 		}
 
-		_outputSurface->create(width, height, getByteOrderRgbaPixelFormat(isAlpha));
-		if (!_outputSurface->getPixels()) {
-			error("Could not allocate memory for output image.");
-		}
 		if (bitDepth == 16)
 			png_set_strip_16(pngPtr);
 		if (bitDepth < 8)
@@ -233,8 +329,40 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 			colorType == PNG_COLOR_TYPE_GRAY_ALPHA)
 			png_set_gray_to_rgb(pngPtr);
 
-		if (colorType != PNG_COLOR_TYPE_RGB_ALPHA)
-			png_set_filler(pngPtr, 0xff, PNG_FILLER_AFTER);
+		// Let libpng order the channels for the requested format, if it can
+		bool bgr = false, alphaFirst = false;
+		if (outputFormat.bytesPerPixel == 0) {
+			outputFormat = decodeFormat = getByteOrderRgbaPixelFormat(isAlpha);
+		} else if (getFormatTransforms(outputFormat, bgr, alphaFirst)) {
+			decodeFormat = outputFormat;
+			if (isAlpha && outputFormat.aBits() == 0) {
+				png_set_strip_alpha(pngPtr);
+				isAlpha = false;
+			}
+		} else {
+			decodeFormat = getByteOrderRgbaPixelFormat(isAlpha);
+		}
+
+		if (bgr)
+			png_set_bgr(pngPtr);
+		if (alphaFirst)
+			png_set_swap_alpha(pngPtr);
+		if (colorType != PNG_COLOR_TYPE_RGB_ALPHA || !isAlpha)
+			png_set_filler(pngPtr, 0xff, alphaFirst ? PNG_FILLER_BEFORE : PNG_FILLER_AFTER);
+	}
+
+	// Allocate memory for the final image data.
+	// To keep memory framentation low this happens before allocating memory for temporary image data.
+	_outputSurface = new Graphics::Surface();
+	if (_destSurface) {
+		*_outputSurface = _destSurface->getSubArea(Common::Rect(width, height));
+		_ownsOutputSurface = false;
+	} else {
+		_outputSurface->create(width, height, outputFormat);
+		if (!_outputSurface->getPixels()) {
+			error("Could not allocate memory for output image.");
+		}
+		_ownsOutputSurface = true;
 	}
 
 	// After the transformations have been registered, the image data is read again.
@@ -244,45 +372,43 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	width = w;
 	height = h;
 
-	if (hasRgbaPalette) {
-		// Build up the RGBA surface from paletted rows
-		png_bytep rowPtr = new byte[width];
-		if (!rowPtr)
-			error("Could not allocate memory for row.");
+	// Rows which still need to be converted are decoded into the row buffer
+	const bool direct = !hasRgbaPalette && decodeFormat == outputFormat;
+	const uint decodePitch = width * decodeFormat.bytesPerPixel;
+	const uint32 *rowPalette = hasRgbaPalette ? rgbaPalette : nullptr;
 
-		for (int yp = 0; yp < height; ++yp) {
-			png_read_row(pngPtr, rowPtr, nullptr);
-			uint32 *destRowP = (uint32 *)_outputSurface->getBasePtr(0, yp);
-
-			for (int xp = 0; xp < width; ++xp)
-				destRowP[xp] = rgbaPalette[rowPtr[xp]];
-		}
-
-		delete[] rowPtr;
-	} else  if (interlaceType == PNG_INTERLACE_NONE) {
+	if (interlaceType == PNG_INTERLACE_NONE) {
 		// PNGs without interlacing can simply be read row by row.
+		if (!direct)
+			_rowBuffer.resize(decodePitch);
+
 		for (int i = 0; i < height; i++) {
-			png_read_row(pngPtr, (png_bytep)_outputSurface->getBasePtr(0, i), NULL);
+			if (direct) {
+				png_read_row(pngPtr, (png_bytep)_outputSurface->getBasePtr(0, i), NULL);
+				finishRow(i, nullptr, nullptr, decodeFormat);
+			} else {
+				png_read_row(pngPtr, _rowBuffer.data(), NULL);
+				finishRow(i, _rowBuffer.data(), rowPalette, decodeFormat);
+			}
 		}
 	} else {
 		// PNGs with interlacing require us to allocate an auxiliary
-		// buffer with pointers to all row starts.
-
-		// Allocate row pointer buffer
-		png_bytep *rowPtr = new png_bytep[height];
-		if (!rowPtr) {
-			error("Could not allocate memory for row pointers.");
-		}
+		// buffer with pointers to all row starts, and the whole image
+		// has to be decoded before converting it.
+		if (!direct)
+			_rowBuffer.resize(decodePitch * height);
 
 		// Initialize row pointers
+		Common::Array<png_bytep> rowPtr;
+		rowPtr.resize(height);
 		for (int i = 0; i < height; i++)
-			rowPtr[i] = (png_bytep)_outputSurface->getBasePtr(0, i);
+			rowPtr[i] = direct ? (png_bytep)_outputSurface->getBasePtr(0, i) : &_rowBuffer[i * decodePitch];
 
 		// Read image data
-		png_read_image(pngPtr, rowPtr);
+		png_read_image(pngPtr, rowPtr.data());
 
-		// Free row pointer buffer
-		delete[] rowPtr;
+		for (int i = 0; i < height; i++)
+			finishRow(i, direct ? nullptr : rowPtr[i], rowPalette, decodeFormat);
 	}
 
 	// Read additional data at the end.
@@ -297,6 +423,34 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 #endif
 }
 
+namespace {
+
+struct LoadPNGStreamsState {
+	PNGDecoder *const *decoders;
+	Common::SeekableReadStream *const *streams;
+	Common::Atomic<uint32> failures;
+};
+
+void loadPNGStreamRange(uint begin, uint end, void *refCon) {
+	LoadPNGStreamsState *state = (LoadPNGStreamsState *)refCon;
+
+	for (uint i = begin; i < end; i++) {
+		if (!state->decoders[i]->loadStream(*state->streams[i]))
+			state->failures.fetchAdd(1);
+	}
+}
+
+} // End of anonymous namespace
+
+bool loadPNGStreams(PNGDecoder *const *decoders, Common::SeekableReadStream *const *streams, uint count) {
+	LoadPNGStreamsState state;
+	state.decoders = decoders;
+	state.streams = streams;
+
+	g_system->getJobSystem()->parallelFor(count, loadPNGStreamRange, &state, 1);
+	return state.failures.load() == 0;
+}
+
 bool writePNG(Common::WriteStream &out, const Graphics::Surface &input, const byte *palette) {
 #ifdef USE_PNG
 #ifdef SCUMM_LITTLE_ENDIAN
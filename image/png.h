@@ -23,6 +23,7 @@
 #define IMAGE_PNG_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/textconsole.h"
 #include "graphics/palette.h"
 #include "graphics/pixelformat.h"
@@ -56,6 +57,15 @@ namespace Image {
 
 class PNGDecoder : public ImageDecoder {
 public:
+	/**
+	 * Function called once a row of the output surface is complete.
+	 *
+	 * @param surface The output surface, only rows up to y are decoded yet.
+	 * @param y       The row which was just completed.
+	 * @param refCon  The pointer passed to setRowCallback().
+	 */
+	typedef void (*RowCallback)(const Graphics::Surface &surface, uint y, void *refCon);
+
 	PNGDecoder();
 	~PNGDecoder();
 
@@ -68,8 +78,50 @@ public:
 	uint32 getTransparentColor() const override { return _transparentColor; }
 	void setSkipSignature(bool skip) { _skipSignature = skip; }
 	void setKeepTransparencyPaletted(bool keep) { _keepTransparencyPaletted = keep; }
+
+	/**
+	 * Request the image to be output in the given format. This is done
+	 * while decoding, which is faster than converting the surface afterwards.
+	 * Paletted images are expanded to this format as well.
+	 *
+	 * By default, paletted images stay paletted and the others are output
+	 * in byte order RGB(A).
+	 *
+	 * @return False for CLUT8, which is not supported.
+	 */
+	bool setOutputPixelFormat(const Graphics::PixelFormat &format) {
+		if (format.isCLUT8())
+			return false;
+		_requestedPixelFormat = format;
+		return true;
+	}
+
+	/**
+	 * Decode into the top left corner of a surface of the caller, in the
+	 * format of that surface, instead of allocating a new one. getSurface()
+	 * then returns a view of the decoded area.
+	 *
+	 * Loading fails if an image doesn't fit, or if it isn't paletted and the
+	 * surface is CLUT8. The surface must stay valid while it is in use.
+	 *
+	 * @param surface The surface to decode into, or nullptr to allocate
+	 *                surfaces again.
+	 */
+	void setOutputSurface(Graphics::Surface *surface) { _destSurface = surface; }
+
+	/**
+	 * Set a function to call whenever a row of the output is complete, e.g.
+	 * to show or upload the image while it is being decoded. The rows of
+	 * interlaced images are only complete once the whole image is decoded.
+	 */
+	void setRowCallback(RowCallback callback, void *refCon) {
+		_rowCallback = callback;
+		_rowCallbackRefCon = refCon;
+	}
+
 private:
 	Graphics::PixelFormat getByteOrderRgbaPixelFormat(bool isAlpha) const;
+	void finishRow(int y, const byte *src, const uint32 *rgbaPalette, const Graphics::PixelFormat &srcFormat);
 
 	Graphics::Palette _palette;
 
@@ -81,9 +133,33 @@ private:
 	bool _hasTransparentColor;
 	uint32 _transparentColor;
 
+	Graphics::PixelFormat _requestedPixelFormat;
+	Graphics::Surface *_destSurface;
+	RowCallback _rowCallback;
+	void *_rowCallbackRefCon;
+
 	Graphics::Surface *_outputSurface;
+	bool _ownsOutputSurface;
+
+	/** Rows decoded before being converted, kept for the next image */
+	Common::Array<byte> _rowBuffer;
 };
 
+/**
+ * Load several PNG images at once, spread over the threads of the job
+ * system. Each decoder is set up beforehand as usual, and its row callback
+ * is called from the thread decoding its image.
+ *
+ * The streams must be independent of each other, e.g. memory streams or
+ * separately opened files.
+ *
+ * @param decoders The decoders to load the images with.
+ * @param streams  The stream of each image.
+ * @param count    The number of images.
+ * @return True if all the images could be loaded.
+ */
+bool loadPNGStreams(PNGDecoder *const *decoders, Common::SeekableReadStream *const *streams, uint count);
+
 /**
  * Outputs a compressed PNG stream of the given input surface.
   *
@@ -0,0 +1,110 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "image/screenshot.h"
+
+#include "common/file.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+#include "image/bmp.h"
+#include "image/png.h"
+
+namespace Image {
+
+ScreenshotWriter::~ScreenshotWriter() {
+	// Do not lose screenshots which are still being written on shutdown
+	wait();
+}
+
+bool ScreenshotWriter::encode(Common::WriteStream &out, const Graphics::Surface &surface, const byte *palette) {
+#ifdef USE_PNG
+	return writePNG(out, surface, palette);
+#else
+	return writeBMP(out, surface, palette);
+#endif
+}
+
+bool ScreenshotWriter::write(const Common::Path &filename, const Graphics::Surface &surface, const byte *palette) {
+	reapFinished();
+
+	Common::DumpFile *out = new Common::DumpFile();
+	if (!out->open(filename)) {
+		delete out;
+		return false;
+	}
+
+	Common::JobSystem *jobSystem = g_system->getJobSystem();
+	if (!jobSystem || jobSystem->getThreadCount() <= 1) {
+		bool success = encode(*out, surface, palette);
+		delete out;
+		return success;
+	}
+
+	// Only copy the screen here, and leave encoding to a worker
+	PendingScreenshot *screenshot = new PendingScreenshot();
+	screenshot->filename = filename;
+	screenshot->stream = out;
+	screenshot->surface.copyFrom(surface);
+	screenshot->hasPalette = palette != nullptr;
+	if (palette)
+		memcpy(screenshot->palette, palette, sizeof(screenshot->palette));
+	screenshot->failed = false;
+	_pending.push_back(screenshot);
+
+	jobSystem->submit(writePending, screenshot, &_group);
+	return true;
+}
+
+void ScreenshotWriter::writePending(void *refCon) {
+	PendingScreenshot *screenshot = (PendingScreenshot *)refCon;
+
+	// This runs on a worker thread, so only touch the screenshot itself
+	screenshot->failed = !encode(*screenshot->stream, screenshot->surface,
+		screenshot->hasPalette ? screenshot->palette : nullptr);
+	screenshot->stream->finalize();
+	screenshot->failed = screenshot->failed || screenshot->stream->err();
+
+	delete screenshot->stream;
+	screenshot->stream = nullptr;
+	screenshot->surface.free();
+}
+
+void ScreenshotWriter::wait() {
+	if (_pending.empty())
+		return;
+
+	g_system->getJobSystem()->wait(_group);
+	reapFinished();
+}
+
+void ScreenshotWriter::reapFinished() {
+	if (_pending.empty() || !_group.isDone())
+		return;
+
+	for (uint i = 0; i < _pending.size(); ++i) {
+		if (_pending[i]->failed)
+			warning("Failed to write screenshot '%s'", _pending[i]->filename.toString(Common::Path::kNativeSeparator).c_str());
+		delete _pending[i];
+	}
+	_pending.clear();
+}
+
+} // End of namespace Image
@@ -0,0 +1,91 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef IMAGE_SCREENSHOT_H
+#define IMAGE_SCREENSHOT_H
+
+#include "common/array.h"
+#include "common/jobs.h"
+#include "common/path.h"
+#include "graphics/surface.h"
+
+namespace Image {
+
+/**
+ * @defgroup image_screenshot Screenshot writer
+ * @ingroup image
+ *
+ * @brief Writes screenshots to PNG files, or BMP files without PNG support.
+ * @{
+ */
+
+/**
+ * Writes screenshots to files. If the backend provides worker threads,
+ * encoding and writing the file is left to a worker, so that taking a
+ * screenshot does not stall the game. The destructor waits for pending
+ * screenshots, so writers must be destroyed before the job system.
+ */
+class ScreenshotWriter {
+public:
+	ScreenshotWriter() {}
+	~ScreenshotWriter();
+
+	/**
+	 * Write a copy of the given surface to a file.
+	 *
+	 * @param filename Name of the file to create.
+	 * @param surface  The screen contents.
+	 * @param palette  The palette (in RGB888), if the surface has a bpp of 1.
+	 * @return False if the file could not be created, or if the screenshot
+	 *         was written right away and encoding it failed. Failures on a
+	 *         worker are reported as warnings.
+	 */
+	bool write(const Common::Path &filename, const Graphics::Surface &surface, const byte *palette = nullptr);
+
+	/**
+	 * Wait until all screenshots handed over to worker threads are written.
+	 */
+	void wait();
+
+private:
+	struct PendingScreenshot {
+		Common::Path filename;
+		Common::WriteStream *stream;
+		Graphics::Surface surface;
+		byte palette[256 * 3];
+		bool hasPalette;
+		bool failed;
+	};
+
+	static bool encode(Common::WriteStream &out, const Graphics::Surface &surface, const byte *palette);
+	static void writePending(void *refCon);
+
+	void reapFinished();
+
+	Common::Array<PendingScreenshot *> _pending;
+	Common::JobGroup _group;
+};
+
+/** @} */
+
+} // End of namespace Image
+
+#endif
@@ -0,0 +1,104 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_AVX2
+
+#include "math/fft_intern.h"
+#include "math/utils.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace Math {
+
+// Splitting eight points into their real and imaginary parts within each
+// 128-bit lane orders them as 0, 1, 4, 5, 2, 3, 6, 7
+static FORCEINLINE __m256 avx2_laneOrder(__m256 v) {
+	return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(v), _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+static FORCEINLINE void avx2_load(const Complex *z, __m256 &re, __m256 &im) {
+	const __m256 lo = _mm256_loadu_ps(&z[0].re);
+	const __m256 hi = _mm256_loadu_ps(&z[4].re);
+	re = _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+	im = _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+static FORCEINLINE void avx2_store(Complex *z, __m256 re, __m256 im) {
+	_mm256_storeu_ps(&z[0].re, _mm256_unpacklo_ps(re, im));
+	_mm256_storeu_ps(&z[4].re, _mm256_unpackhi_ps(re, im));
+}
+
+// Eight TRANSFORMs of the generic pass at once, see fftPassSSE2()
+void fftPassAVX2(Complex *z, const float *wre, unsigned int n) {
+	const unsigned int o1 = 2 * n;
+	const unsigned int o2 = 4 * n;
+	const unsigned int o3 = 6 * n;
+
+	for (unsigned int k = 0; k < o1; k += 8) {
+		const __m256 wr = avx2_laneOrder(_mm256_loadu_ps(wre + k));
+		__m256 wi = _mm256_loadu_ps(wre + o1 - k - 7);
+		wi = _mm256_permute2f128_ps(wi, wi, 0x01);
+		wi = avx2_laneOrder(_mm256_shuffle_ps(wi, wi, _MM_SHUFFLE(0, 1, 2, 3)));
+		// The first point has no twiddle, like TRANSFORM_ZERO
+		if (k == 0)
+			wi = _mm256_blend_ps(wi, _mm256_setzero_ps(), 0x01);
+
+		__m256 r0, i0, r1, i1, r2, i2, r3, i3;
+		avx2_load(z + k, r0, i0);
+		avx2_load(z + o1 + k, r1, i1);
+		avx2_load(z + o2 + k, r2, i2);
+		avx2_load(z + o3 + k, r3, i3);
+
+		const __m256 t1 = _mm256_add_ps(_mm256_mul_ps(r2, wr), _mm256_mul_ps(i2, wi));
+		const __m256 t2 = _mm256_sub_ps(_mm256_mul_ps(i2, wr), _mm256_mul_ps(r2, wi));
+		const __m256 t5 = _mm256_sub_ps(_mm256_mul_ps(r3, wr), _mm256_mul_ps(i3, wi));
+		const __m256 t6 = _mm256_add_ps(_mm256_mul_ps(i3, wr), _mm256_mul_ps(r3, wi));
+
+		const __m256 sumRe = _mm256_add_ps(t5, t1);
+		const __m256 diffRe = _mm256_sub_ps(t5, t1);
+		const __m256 sumIm = _mm256_add_ps(t2, t6);
+		const __m256 diffIm = _mm256_sub_ps(t2, t6);
+
+		avx2_store(z + k, _mm256_add_ps(r0, sumRe), _mm256_add_ps(i0, sumIm));
+		avx2_store(z + o1 + k, _mm256_add_ps(r1, diffIm), _mm256_add_ps(i1, diffRe));
+		avx2_store(z + o2 + k, _mm256_sub_ps(r0, sumRe), _mm256_sub_ps(i0, sumIm));
+		avx2_store(z + o3 + k, _mm256_sub_ps(r1, diffIm), _mm256_sub_ps(i1, diffRe));
+	}
+}
+
+} // End of namespace Math
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // SCUMMVM_AVX2
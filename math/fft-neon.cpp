@@ -0,0 +1,101 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "math/fft_intern.h"
+#include "math/utils.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Math {
+
+// Four TRANSFORMs of the generic pass at once, see fftPassSSE2()
+void fftPassNEON(Complex *z, const float *wre, unsigned int n) {
+	const unsigned int o1 = 2 * n;
+	const unsigned int o2 = 4 * n;
+	const unsigned int o3 = 6 * n;
+
+	for (unsigned int k = 0; k < o1; k += 4) {
+		const float32x4_t wr = vld1q_f32(wre + k);
+		float32x4_t wi = vrev64q_f32(vld1q_f32(wre + o1 - k - 3));
+		wi = vcombine_f32(vget_high_f32(wi), vget_low_f32(wi));
+		// The first point has no twiddle, like TRANSFORM_ZERO
+		if (k == 0)
+			wi = vsetq_lane_f32(0.0f, wi, 0);
+
+		const float32x4x2_t a0 = vld2q_f32(&z[k].re);
+		const float32x4x2_t a1 = vld2q_f32(&z[o1 + k].re);
+		const float32x4x2_t a2 = vld2q_f32(&z[o2 + k].re);
+		const float32x4x2_t a3 = vld2q_f32(&z[o3 + k].re);
+
+		const float32x4_t t1 = vaddq_f32(vmulq_f32(a2.val[0], wr), vmulq_f32(a2.val[1], wi));
+		const float32x4_t t2 = vsubq_f32(vmulq_f32(a2.val[1], wr), vmulq_f32(a2.val[0], wi));
+		const float32x4_t t5 = vsubq_f32(vmulq_f32(a3.val[0], wr), vmulq_f32(a3.val[1], wi));
+		const float32x4_t t6 = vaddq_f32(vmulq_f32(a3.val[1], wr), vmulq_f32(a3.val[0], wi));
+
+		const float32x4_t sumRe = vaddq_f32(t5, t1);
+		const float32x4_t diffRe = vsubq_f32(t5, t1);
+		const float32x4_t sumIm = vaddq_f32(t2, t6);
+		const float32x4_t diffIm = vsubq_f32(t2, t6);
+
+		float32x4x2_t out;
+		out.val[0] = vaddq_f32(a0.val[0], sumRe);
+		out.val[1] = vaddq_f32(a0.val[1], sumIm);
+		vst2q_f32(&z[k].re, out);
+		out.val[0] = vaddq_f32(a1.val[0], diffIm);
+		out.val[1] = vaddq_f32(a1.val[1], diffRe);
+		vst2q_f32(&z[o1 + k].re, out);
+		out.val[0] = vsubq_f32(a0.val[0], sumRe);
+		out.val[1] = vsubq_f32(a0.val[1], sumIm);
+		vst2q_f32(&z[o2 + k].re, out);
+		out.val[0] = vsubq_f32(a1.val[0], diffIm);
+		out.val[1] = vsubq_f32(a1.val[1], diffRe);
+		vst2q_f32(&z[o3 + k].re, out);
+	}
+}
+
+} // End of namespace Math
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
@@ -0,0 +1,105 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_SSE2
+
+#include "math/fft_intern.h"
+#include "math/utils.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Math {
+
+static FORCEINLINE void sse2_load(const Complex *z, __m128 &re, __m128 &im) {
+	const __m128 lo = _mm_loadu_ps(&z[0].re);
+	const __m128 hi = _mm_loadu_ps(&z[2].re);
+	re = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+	im = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+static FORCEINLINE void sse2_store(Complex *z, __m128 re, __m128 im) {
+	_mm_storeu_ps(&z[0].re, _mm_unpacklo_ps(re, im));
+	_mm_storeu_ps(&z[2].re, _mm_unpackhi_ps(re, im));
+}
+
+// Four TRANSFORMs of the generic pass at once, on the real and imaginary
+// parts of four consecutive points of each quarter
+void fftPassSSE2(Complex *z, const float *wre, unsigned int n) {
+	const unsigned int o1 = 2 * n;
+	const unsigned int o2 = 4 * n;
+	const unsigned int o3 = 6 * n;
+
+	for (unsigned int k = 0; k < o1; k += 4) {
+		__m128 wr = _mm_loadu_ps(wre + k);
+		__m128 wi = _mm_shuffle_ps(_mm_loadu_ps(wre + o1 - k - 3), _mm_loadu_ps(wre + o1 - k - 3), _MM_SHUFFLE(0, 1, 2, 3));
+		// The first point has no twiddle, like TRANSFORM_ZERO
+		if (k == 0)
+			wi = _mm_move_ss(wi, _mm_setzero_ps());
+
+		__m128 r0, i0, r1, i1, r2, i2, r3, i3;
+		sse2_load(z + k, r0, i0);
+		sse2_load(z + o1 + k, r1, i1);
+		sse2_load(z + o2 + k, r2, i2);
+		sse2_load(z + o3 + k, r3, i3);
+
+		const __m128 t1 = _mm_add_ps(_mm_mul_ps(r2, wr), _mm_mul_ps(i2, wi));
+		const __m128 t2 = _mm_sub_ps(_mm_mul_ps(i2, wr), _mm_mul_ps(r2, wi));
+		const __m128 t5 = _mm_sub_ps(_mm_mul_ps(r3, wr), _mm_mul_ps(i3, wi));
+		const __m128 t6 = _mm_add_ps(_mm_mul_ps(i3, wr), _mm_mul_ps(r3, wi));
+
+		const __m128 sumRe = _mm_add_ps(t5, t1);
+		const __m128 diffRe = _mm_sub_ps(t5, t1);
+		const __m128 sumIm = _mm_add_ps(t2, t6);
+		const __m128 diffIm = _mm_sub_ps(t2, t6);
+
+		sse2_store(z + k, _mm_add_ps(r0, sumRe), _mm_add_ps(i0, sumIm));
+		sse2_store(z + o1 + k, _mm_add_ps(r1, diffIm), _mm_add_ps(i1, diffRe));
+		sse2_store(z + o2 + k, _mm_sub_ps(r0, sumRe), _mm_sub_ps(i0, sumIm));
+		sse2_store(z + o3 + k, _mm_sub_ps(r1, diffIm), _mm_sub_ps(i1, diffRe));
+	}
+}
+
+} // End of namespace Math
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
+
+#endif // SCUMMVM_SSE2
@@ -26,43 +26,114 @@
 // Partly based on libdjbfft by D. J. Bernstein
 
 #include "math/fft.h"
+#include "math/fft_intern.h"
 #include "math/cosinetables.h"
 #include "math/utils.h"
+#include "common/mutex.h"
+#include "common/system.h"
 #include "common/util.h"
 
 namespace Math {
 
+namespace {
+
+/**
+ * Tables which only depend on the size of a transform, shared by all FFTs
+ * of that size. Decoders set up their transforms for every stream they
+ * play, so computing them once saves the setup time and the memory of the
+ * duplicates.
+ */
+struct SharedRevTab {
+	uint16 *table;
+	int refCount;
+};
+
+struct SharedCosineTable {
+	CosineTable *table;
+	int refCount;
+};
+
+SharedRevTab g_revTabs[2][17];
+SharedCosineTable g_cosTables[13];
+Common::Mutex *g_tablesMutex = nullptr;
+
+// Decoders may be set up on the mixer thread. Like the String memory
+// pool, the mutex can only be created once the backend is initialized.
+void lockTables() {
+	if (!g_system || !g_system->backendInitialized())
+		return;
+	if (!g_tablesMutex)
+		g_tablesMutex = new Common::Mutex();
+	g_tablesMutex->lock();
+}
+
+void unlockTables() {
+	if (g_tablesMutex)
+		g_tablesMutex->unlock();
+}
+
+} // End of anonymous namespace
+
 FFT::FFT(int bits, int inverse) : _bits(bits), _inverse(inverse) {
 	assert((_bits >= 2) && (_bits <= 16));
 
 	int n = 1 << bits;
-	int nPoints;
 
 	_tmpBuf = new Complex[n];
 	_expTab = new Complex[n / 2];
-	_revTab = new uint16[n];
 
 	_splitRadix = 1;
 
-	for (int i = 0; i < n; i++)
-		_revTab[-splitRadixPermutation(i, n, _inverse) & (n - 1)] = i;
+	_pass = getFFTPassFunc();
+
+	lockTables();
+
+	SharedRevTab &revTab = g_revTabs[_inverse != 0][_bits];
+	if (!revTab.refCount) {
+		revTab.table = new uint16[n];
+		for (int i = 0; i < n; i++)
+			revTab.table[-splitRadixPermutation(i, n, _inverse) & (n - 1)] = i;
+	}
+	revTab.refCount++;
+	_revTab = revTab.table;
 
 	for (int i = 0; i < ARRAYSIZE(_cosTables); i++) {
 		if (i + 4 <= _bits) {
-			nPoints = 1 << (i + 4);
-			_cosTables[i] = new CosineTable(nPoints);
+			SharedCosineTable &cosTable = g_cosTables[i];
+			if (!cosTable.refCount)
+				cosTable.table = new CosineTable(1 << (i + 4));
+			cosTable.refCount++;
+			_cosTables[i] = cosTable.table;
 		}
 		else
 			_cosTables[i] = nullptr;
 	}
+
+	unlockTables();
 }
 
 FFT::~FFT() {
+	lockTables();
+
 	for (int i = 0; i < ARRAYSIZE(_cosTables); i++) {
-		delete _cosTables[i];
+		if (!_cosTables[i])
+			continue;
+
+		SharedCosineTable &cosTable = g_cosTables[i];
+		if (!--cosTable.refCount) {
+			delete cosTable.table;
+			cosTable.table = nullptr;
+		}
+	}
+
+	SharedRevTab &revTab = g_revTabs[_inverse != 0][_bits];
+	if (!--revTab.refCount) {
+		delete[] revTab.table;
+		revTab.table = nullptr;
 	}
 
-	delete[] _revTab;
+	unlockTables();
+
 	delete[] _expTab;
 	delete[] _tmpBuf;
 }
@@ -180,6 +251,33 @@ PASS(pass)
 #define BUTTERFLIES BUTTERFLIES_BIG
 PASS(pass_big)
 
+void fftPassGeneric(Complex *z, const float *wre, unsigned int n) {
+	if (n > 128)
+		pass_big(z, wre, n);
+	else
+		pass(z, wre, n);
+}
+
+static FFTPassFunc g_fftPassFunc = nullptr;
+
+FFTPassFunc getFFTPassFunc() {
+	// If no function has been selected yet, detect and select
+	if (!g_fftPassFunc) {
+		g_fftPassFunc = fftPassGeneric;
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) g_fftPassFunc = fftPassNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) g_fftPassFunc = fftPassSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+		if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) g_fftPassFunc = fftPassAVX2;
+#endif
+	}
+
+	return g_fftPassFunc;
+}
+
 void FFT::fft4(Complex *z) {
 	float t1, t2, t3, t4, t5, t6, t7, t8;
 
@@ -244,10 +342,7 @@ void FFT::fft(int n, int logn, Complex *z) {
 		fft((n / 4), logn - 2, z + (n / 4) * 2);
 		fft((n / 4), logn - 2, z + (n / 4) * 3);
 		assert(_cosTables[logn - 4]);
-		if (n > 1024)
-			pass_big(z, _cosTables[logn - 4]->getTable(), (n / 4) / 2);
-		else
-			pass(z, _cosTables[logn - 4]->getTable(), (n / 4) / 2);
+		_pass(z, _cosTables[logn - 4]->getTable(), (n / 4) / 2);
 	}
 }
 
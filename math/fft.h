@@ -71,7 +71,7 @@ private:
 	int _bits;
 	int _inverse;
 
-	uint16 *_revTab;
+	const uint16 *_revTab;
 
 	Complex *_expTab;
 	Complex *_tmpBuf;
@@ -80,8 +80,11 @@ private:
 
 	static int splitRadixPermutation(int i, int n, int inverse);
 
+	/** Twiddle factors, shared with all other FFTs using the same sizes. */
 	CosineTable *_cosTables[13];
 
+	void (*_pass)(Complex *z, const float *wre, unsigned int n);
+
 	void fft4(Complex *z);
 	void fft8(Complex *z);
 	void fft16(Complex *z);
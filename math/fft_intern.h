@@ -0,0 +1,54 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef MATH_FFT_INTERN_H
+#define MATH_FFT_INTERN_H
+
+#include "common/scummsys.h"
+
+namespace Math {
+
+struct Complex;
+
+/**
+ * Combine the three sub-transforms of a split-radix FFT of 8 * @p n points
+ * stored in @p z, using the twiddle factors @p wre of a CosineTable of that
+ * size.
+ */
+typedef void (*FFTPassFunc)(Complex *z, const float *wre, unsigned int n);
+
+void fftPassGeneric(Complex *z, const float *wre, unsigned int n);
+#ifdef SCUMMVM_NEON
+void fftPassNEON(Complex *z, const float *wre, unsigned int n);
+#endif
+#ifdef SCUMMVM_SSE2
+void fftPassSSE2(Complex *z, const float *wre, unsigned int n);
+#endif
+#ifdef SCUMMVM_AVX2
+void fftPassAVX2(Complex *z, const float *wre, unsigned int n);
+#endif
+
+/** Return the fastest pass function supported by the CPU. */
+FFTPassFunc getFFTPassFunc();
+
+} // End of namespace Math
+
+#endif // MATH_FFT_INTERN_H
@@ -34,15 +34,53 @@ Matrix<4, 4>::Matrix(const MatrixBase<4, 4> &m) :
 }
 
 void Matrix<4, 4>::transform(Vector3d *v, bool trans) const {
-	Vector4d m;
-	m(0, 0) = v->x();
-	m(1, 0) = v->y();
-	m(2, 0) = v->z();
-	m(3, 0) = (trans ? 1.f : 0.f);
+	const float *m = getData();
+	const float x = v->x();
+	const float y = v->y();
+	const float z = v->z();
+	const float w = (trans ? 1.f : 0.f);
 
-	m = *this * m;
+	v->set(m[0] * x + m[1] * y + m[2] * z + m[3] * w,
+	       m[4] * x + m[5] * y + m[6] * z + m[7] * w,
+	       m[8] * x + m[9] * y + m[10] * z + m[11] * w);
+}
+
+void Matrix<4, 4>::transformVectors(Vector3d *vectors, uint count, bool trans) const {
+#if defined(MATH_MATRIX4_SSE2)
+	__m128 col0 = _mm_loadu_ps(getData() + 0);
+	__m128 col1 = _mm_loadu_ps(getData() + 4);
+	__m128 col2 = _mm_loadu_ps(getData() + 8);
+	__m128 col3 = _mm_loadu_ps(getData() + 12);
+	_MM_TRANSPOSE4_PS(col0, col1, col2, col3);
+	if (!trans)
+		col3 = _mm_setzero_ps();
+
+	for (uint i = 0; i < count; i++) {
+		float *v = vectors[i].getData();
+		__m128 sum = _mm_mul_ps(col0, _mm_set1_ps(v[0]));
+		sum = _mm_add_ps(sum, _mm_mul_ps(col1, _mm_set1_ps(v[1])));
+		sum = _mm_add_ps(sum, _mm_mul_ps(col2, _mm_set1_ps(v[2])));
+		sum = _mm_add_ps(sum, col3);
+		_mm_storel_pi((__m64 *)v, sum);
+		_mm_store_ss(v + 2, _mm_movehl_ps(sum, sum));
+	}
+#elif defined(MATH_MATRIX4_NEON)
+	const float32x4x4_t cols = vld4q_f32(getData());
+	const float32x4_t col3 = trans ? cols.val[3] : vdupq_n_f32(0.f);
 
-	v->set(m(0, 0), m(1, 0), m(2, 0));
+	for (uint i = 0; i < count; i++) {
+		float *v = vectors[i].getData();
+		float32x4_t sum = vmulq_n_f32(cols.val[0], v[0]);
+		sum = vaddq_f32(sum, vmulq_n_f32(cols.val[1], v[1]));
+		sum = vaddq_f32(sum, vmulq_n_f32(cols.val[2], v[2]));
+		sum = vaddq_f32(sum, col3);
+		vst1_f32(v, vget_low_f32(sum));
+		vst1q_lane_f32(v + 2, sum, 2);
+	}
+#else
+	for (uint i = 0; i < count; i++)
+		transform(&vectors[i], trans);
+#endif
 }
 
 Vector3d Matrix<4, 4>::getPosition() const {
@@ -114,6 +152,255 @@ void Matrix<4, 4>::invertAffineOrthonormal() {
 	setPosition(position);
 }
 
+bool Matrix<4, 4>::inverse() {
+#if defined(MATH_MATRIX4_SSE2) || defined(MATH_MATRIX4_NEON)
+	// Cramer's rule on 2x2 sub-determinants, after Intel's "Streaming SIMD
+	// Extensions - Inverse of 4x4 Matrix". The shuffles swap the elements
+	// of each pair (SWAP_PAIRS) and the two halves (SWAP_HALVES).
+	float *m = getData();
+
+#if defined(MATH_MATRIX4_SSE2)
+	typedef __m128 Vec;
+#define LOAD(p) _mm_loadu_ps(p)
+#define STORE(p, v) _mm_storeu_ps(p, v)
+#define ADD(a, b) _mm_add_ps(a, b)
+#define SUB(a, b) _mm_sub_ps(a, b)
+#define MUL(a, b) _mm_mul_ps(a, b)
+#define SCALE(v, f) _mm_mul_ps(v, _mm_set1_ps(f))
+#define SWAP_PAIRS(v) _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1))
+#define SWAP_HALVES(v) _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2))
+
+	Vec row0 = LOAD(m + 0);
+	Vec row1 = LOAD(m + 4);
+	Vec row2 = LOAD(m + 8);
+	Vec row3 = LOAD(m + 12);
+	_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+#else
+	typedef float32x4_t Vec;
+#define LOAD(p) vld1q_f32(p)
+#define STORE(p, v) vst1q_f32(p, v)
+#define ADD(a, b) vaddq_f32(a, b)
+#define SUB(a, b) vsubq_f32(a, b)
+#define MUL(a, b) vmulq_f32(a, b)
+#define SCALE(v, f) vmulq_n_f32(v, f)
+#define SWAP_PAIRS(v) vrev64q_f32(v)
+#define SWAP_HALVES(v) vextq_f32(v, v, 2)
+
+	const float32x4x4_t cols = vld4q_f32(m);
+	Vec row0 = cols.val[0];
+	Vec row1 = cols.val[1];
+	Vec row2 = cols.val[2];
+	Vec row3 = cols.val[3];
+#endif
+
+	row1 = SWAP_HALVES(row1);
+	row3 = SWAP_HALVES(row3);
+
+	Vec tmp, minor0, minor1, minor2, minor3;
+
+	tmp = SWAP_PAIRS(MUL(row2, row3));
+	minor0 = MUL(row1, tmp);
+	minor1 = MUL(row0, tmp);
+	tmp = SWAP_HALVES(tmp);
+	minor0 = SUB(MUL(row1, tmp), minor0);
+	minor1 = SUB(MUL(row0, tmp), minor1);
+	minor1 = SWAP_HALVES(minor1);
+
+	tmp = SWAP_PAIRS(MUL(row1, row2));
+	minor0 = ADD(MUL(row3, tmp), minor0);
+	minor3 = MUL(row0, tmp);
+	tmp = SWAP_HALVES(tmp);
+	minor0 = SUB(minor0, MUL(row3, tmp));
+	minor3 = SUB(MUL(row0, tmp), minor3);
+	minor3 = SWAP_HALVES(minor3);
+
+	tmp = SWAP_PAIRS(MUL(SWAP_HALVES(row1), row3));
+	row2 = SWAP_HALVES(row2);
+	minor0 = ADD(MUL(row2, tmp), minor0);
+	minor2 = MUL(row0, tmp);
+	tmp = SWAP_HALVES(tmp);
+	minor0 = SUB(minor0, MUL(row2, tmp));
+	minor2 = SUB(MUL(row0, tmp), minor2);
+	minor2 = SWAP_HALVES(minor2);
+
+	tmp = SWAP_PAIRS(MUL(row0, row1));
+	minor2 = ADD(MUL(row3, tmp), minor2);
+	minor3 = SUB(MUL(row2, tmp), minor3);
+	tmp = SWAP_HALVES(tmp);
+	minor2 = SUB(MUL(row3, tmp), minor2);
+	minor3 = SUB(minor3, MUL(row2, tmp));
+
+	tmp = SWAP_PAIRS(MUL(row0, row3));
+	minor1 = SUB(minor1, MUL(row2, tmp));
+	minor2 = ADD(MUL(row1, tmp), minor2);
+	tmp = SWAP_HALVES(tmp);
+	minor1 = ADD(MUL(row2, tmp), minor1);
+	minor2 = SUB(minor2, MUL(row1, tmp));
+
+	tmp = SWAP_PAIRS(MUL(row0, row2));
+	minor1 = ADD(MUL(row3, tmp), minor1);
+	minor3 = SUB(minor3, MUL(row1, tmp));
+	tmp = SWAP_HALVES(tmp);
+	minor1 = SUB(minor1, MUL(row3, tmp));
+	minor3 = ADD(MUL(row1, tmp), minor3);
+
+	float products[4];
+	STORE(products, MUL(row0, minor0));
+	float det = products[0] + products[1] + products[2] + products[3];
+
+	if (det == 0)
+		return false;
+
+	det = 1.0 / det;
+
+	STORE(m + 0, SCALE(minor0, det));
+	STORE(m + 4, SCALE(minor1, det));
+	STORE(m + 8, SCALE(minor2, det));
+	STORE(m + 12, SCALE(minor3, det));
+
+#undef LOAD
+#undef STORE
+#undef ADD
+#undef SUB
+#undef MUL
+#undef SCALE
+#undef SWAP_PAIRS
+#undef SWAP_HALVES
+
+	return true;
+#else
+
+	Matrix<4, 4> invMatrix;
+	float *inv = invMatrix.getData();
+	float *m = getData();
+
+	inv[0] = m[5]  * m[10] * m[15] -
+	         m[5]  * m[11] * m[14] -
+	         m[9]  * m[6]  * m[15] +
+	         m[9]  * m[7]  * m[14] +
+	         m[13] * m[6]  * m[11] -
+	         m[13] * m[7]  * m[10];
+
+	inv[4] = -m[4]  * m[10] * m[15] +
+	          m[4]  * m[11] * m[14] +
+	          m[8]  * m[6]  * m[15] -
+	          m[8]  * m[7]  * m[14] -
+	          m[12] * m[6]  * m[11] +
+	          m[12] * m[7]  * m[10];
+
+	inv[8] = m[4]  * m[9]  * m[15] -
+	         m[4]  * m[11] * m[13] -
+	         m[8]  * m[5]  * m[15] +
+	         m[8]  * m[7]  * m[13] +
+	         m[12] * m[5]  * m[11] -
+	         m[12] * m[7]  * m[9];
+
+	inv[12] = -m[4]  * m[9]  * m[14] +
+	           m[4]  * m[10] * m[13] +
+	           m[8]  * m[5]  * m[14] -
+	           m[8]  * m[6]  * m[13] -
+	           m[12] * m[5]  * m[10] +
+	           m[12] * m[6]  * m[9];
+
+	inv[1] = -m[1]  * m[10] * m[15] +
+	          m[1]  * m[11] * m[14] +
+	          m[9]  * m[2]  * m[15] -
+	          m[9]  * m[3]  * m[14] -
+	          m[13] * m[2]  * m[11] +
+	          m[13] * m[3]  * m[10];
+
+	inv[5] = m[0]  * m[10] * m[15] -
+	         m[0]  * m[11] * m[14] -
+	         m[8]  * m[2]  * m[15] +
+	         m[8]  * m[3]  * m[14] +
+	         m[12] * m[2]  * m[11] -
+	         m[12] * m[3]  * m[10];
+
+	inv[9] = -m[0]  * m[9]  * m[15] +
+	          m[0]  * m[11] * m[13] +
+	          m[8]  * m[1]  * m[15] -
+	          m[8]  * m[3]  * m[13] -
+	          m[12] * m[1]  * m[11] +
+	          m[12] * m[3]  * m[9];
+
+	inv[13] = m[0]  * m[9]  * m[14] -
+	          m[0]  * m[10] * m[13] -
+	          m[8]  * m[1]  * m[14] +
+	          m[8]  * m[2]  * m[13] +
+	          m[12] * m[1]  * m[10] -
+	          m[12] * m[2]  * m[9];
+
+	inv[2] = m[1]  * m[6] * m[15] -
+	         m[1]  * m[7] * m[14] -
+	         m[5]  * m[2] * m[15] +
+	         m[5]  * m[3] * m[14] +
+	         m[13] * m[2] * m[7] -
+	         m[13] * m[3] * m[6];
+
+	inv[6] = -m[0]  * m[6] * m[15] +
+	          m[0]  * m[7] * m[14] +
+	          m[4]  * m[2] * m[15] -
+	          m[4]  * m[3] * m[14] -
+	          m[12] * m[2] * m[7] +
+	          m[12] * m[3] * m[6];
+
+	inv[10] = m[0]  * m[5] * m[15] -
+	          m[0]  * m[7] * m[13] -
+	          m[4]  * m[1] * m[15] +
+	          m[4]  * m[3] * m[13] +
+	          m[12] * m[1] * m[7] -
+	          m[12] * m[3] * m[5];
+
+	inv[14] = -m[0]  * m[5] * m[14] +
+	           m[0]  * m[6] * m[13] +
+	           m[4]  * m[1] * m[14] -
+	           m[4]  * m[2] * m[13] -
+	           m[12] * m[1] * m[6] +
+	           m[12] * m[2] * m[5];
+
+	inv[3] = -m[1] * m[6] * m[11] +
+	          m[1] * m[7] * m[10] +
+	          m[5] * m[2] * m[11] -
+	          m[5] * m[3] * m[10] -
+	          m[9] * m[2] * m[7] +
+	          m[9] * m[3] * m[6];
+
+	inv[7] = m[0] * m[6] * m[11] -
+	         m[0] * m[7] * m[10] -
+	         m[4] * m[2] * m[11] +
+	         m[4] * m[3] * m[10] +
+	         m[8] * m[2] * m[7] -
+	         m[8] * m[3] * m[6];
+
+	inv[11] = -m[0] * m[5] * m[11] +
+	           m[0] * m[7] * m[9] +
+	           m[4] * m[1] * m[11] -
+	           m[4] * m[3] * m[9] -
+	           m[8] * m[1] * m[7] +
+	           m[8] * m[3] * m[5];
+
+	inv[15] = m[0] * m[5] * m[10] -
+	          m[0] * m[6] * m[9] -
+	          m[4] * m[1] * m[10] +
+	          m[4] * m[2] * m[9] +
+	          m[8] * m[1] * m[6] -
+	          m[8] * m[2] * m[5];
+
+	float det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+
+	if (det == 0)
+		return false;
+
+	det = 1.0 / det;
+
+	for (int i = 0; i < 16; i++) {
+		m[i] = inv[i] * det;
+	}
+
+	return true;
+#endif
+}
+
 void swap(float &a, float &b);
 
 void Matrix<4, 4>::transpose() {
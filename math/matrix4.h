@@ -28,6 +28,14 @@
 #include "math/vector4d.h"
 #include "math/matrix3.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATH_MATRIX4_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#define MATH_MATRIX4_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Math {
 
 // matrix 4 is a rotation matrix + position
@@ -80,163 +88,54 @@ public:
 		const float *d2 = m2.getData();
 		float *r = result.getData();
 
-		for (int i = 0; i < 16; i += 4) {
-			for (int j = 0; j < 4; ++j) {
-				r[i + j] = (d1[i + 0] * d2[j + 0]) +
-				           (d1[i + 1] * d2[j + 4]) +
-				           (d1[i + 2] * d2[j + 8]) +
-				           (d1[i + 3] * d2[j + 12]);
-			}
-		}
+		// Each row of the result combines the rows of m2
+		for (int i = 0; i < 16; i += 4)
+			sumWeightedRows(d2, d1 + i, r + i);
 
 		return result;
 	}
 
 	inline Vector4d transform(const Vector4d &v) const {
 		Vector4d result;
-		const float *d1 = getData();
-		const float *d2 = v.getData();
-		float *r = result.getData();
-
-		for (int i = 0; i < 4; i++) {
-			r[i] = d2[0] * d1[0 * 4 + i] +
-			       d2[1] * d1[1 * 4 + i] +
-			       d2[2] * d1[2 * 4 + i] +
-			       d2[3] * d1[3 * 4 + i];
-		}
-
+		sumWeightedRows(getData(), v.getData(), result.getData());
 		return result;
 	}
 
-	inline bool inverse() {
-		Matrix<4, 4> invMatrix;
-		float *inv = invMatrix.getData();
-		float *m = getData();
-
-		inv[0] = m[5]  * m[10] * m[15] -
-		         m[5]  * m[11] * m[14] -
-		         m[9]  * m[6]  * m[15] +
-		         m[9]  * m[7]  * m[14] +
-		         m[13] * m[6]  * m[11] -
-		         m[13] * m[7]  * m[10];
-
-		inv[4] = -m[4]  * m[10] * m[15] +
-		          m[4]  * m[11] * m[14] +
-		          m[8]  * m[6]  * m[15] -
-		          m[8]  * m[7]  * m[14] -
-		          m[12] * m[6]  * m[11] +
-		          m[12] * m[7]  * m[10];
-
-		inv[8] = m[4]  * m[9]  * m[15] -
-		         m[4]  * m[11] * m[13] -
-		         m[8]  * m[5]  * m[15] +
-		         m[8]  * m[7]  * m[13] +
-		         m[12] * m[5]  * m[11] -
-		         m[12] * m[7]  * m[9];
-
-		inv[12] = -m[4]  * m[9]  * m[14] +
-		           m[4]  * m[10] * m[13] +
-		           m[8]  * m[5]  * m[14] -
-		           m[8]  * m[6]  * m[13] -
-		           m[12] * m[5]  * m[10] +
-		           m[12] * m[6]  * m[9];
-
-		inv[1] = -m[1]  * m[10] * m[15] +
-		          m[1]  * m[11] * m[14] +
-		          m[9]  * m[2]  * m[15] -
-		          m[9]  * m[3]  * m[14] -
-		          m[13] * m[2]  * m[11] +
-		          m[13] * m[3]  * m[10];
-
-		inv[5] = m[0]  * m[10] * m[15] -
-		         m[0]  * m[11] * m[14] -
-		         m[8]  * m[2]  * m[15] +
-		         m[8]  * m[3]  * m[14] +
-		         m[12] * m[2]  * m[11] -
-		         m[12] * m[3]  * m[10];
-
-		inv[9] = -m[0]  * m[9]  * m[15] +
-		          m[0]  * m[11] * m[13] +
-		          m[8]  * m[1]  * m[15] -
-		          m[8]  * m[3]  * m[13] -
-		          m[12] * m[1]  * m[11] +
-		          m[12] * m[3]  * m[9];
-
-		inv[13] = m[0]  * m[9]  * m[14] -
-		          m[0]  * m[10] * m[13] -
-		          m[8]  * m[1]  * m[14] +
-		          m[8]  * m[2]  * m[13] +
-		          m[12] * m[1]  * m[10] -
-		          m[12] * m[2]  * m[9];
-
-		inv[2] = m[1]  * m[6] * m[15] -
-		         m[1]  * m[7] * m[14] -
-		         m[5]  * m[2] * m[15] +
-		         m[5]  * m[3] * m[14] +
-		         m[13] * m[2] * m[7] -
-		         m[13] * m[3] * m[6];
-
-		inv[6] = -m[0]  * m[6] * m[15] +
-		          m[0]  * m[7] * m[14] +
-		          m[4]  * m[2] * m[15] -
-		          m[4]  * m[3] * m[14] -
-		          m[12] * m[2] * m[7] +
-		          m[12] * m[3] * m[6];
-
-		inv[10] = m[0]  * m[5] * m[15] -
-		          m[0]  * m[7] * m[13] -
-		          m[4]  * m[1] * m[15] +
-		          m[4]  * m[3] * m[13] +
-		          m[12] * m[1] * m[7] -
-		          m[12] * m[3] * m[5];
-
-		inv[14] = -m[0]  * m[5] * m[14] +
-		           m[0]  * m[6] * m[13] +
-		           m[4]  * m[1] * m[14] -
-		           m[4]  * m[2] * m[13] -
-		           m[12] * m[1] * m[6] +
-		           m[12] * m[2] * m[5];
-
-		inv[3] = -m[1] * m[6] * m[11] +
-		          m[1] * m[7] * m[10] +
-		          m[5] * m[2] * m[11] -
-		          m[5] * m[3] * m[10] -
-		          m[9] * m[2] * m[7] +
-		          m[9] * m[3] * m[6];
-
-		inv[7] = m[0] * m[6] * m[11] -
-		         m[0] * m[7] * m[10] -
-		         m[4] * m[2] * m[11] +
-		         m[4] * m[3] * m[10] +
-		         m[8] * m[2] * m[7] -
-		         m[8] * m[3] * m[6];
-
-		inv[11] = -m[0] * m[5] * m[11] +
-		           m[0] * m[7] * m[9] +
-		           m[4] * m[1] * m[11] -
-		           m[4] * m[3] * m[9] -
-		           m[8] * m[1] * m[7] +
-		           m[8] * m[3] * m[5];
-
-		inv[15] = m[0] * m[5] * m[10] -
-		          m[0] * m[6] * m[9] -
-		          m[4] * m[1] * m[10] +
-		          m[4] * m[2] * m[9] +
-		          m[8] * m[1] * m[6] -
-		          m[8] * m[2] * m[5];
-
-		float det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
-
-		if (det == 0)
-			return false;
-
-		det = 1.0 / det;
-
-		for (int i = 0; i < 16; i++) {
-			m[i] = inv[i] * det;
-		}
+	/**
+	 * Inverts a matrix in place.
+	 * Returns false and leaves the matrix untouched if it isn't invertible.
+	 */
+	bool inverse();
 
-		return true;
+	/**
+	 * Transforms an array of vectors in place, like calling transform() on
+	 * each of them but with the matrix only loaded once.
+	 */
+	void transformVectors(Vector3d *vectors, uint count, bool translate) const;
+
+private:
+	/** Store the sum of the four rows in @p rows weighted by @p factors in @p result. */
+	static inline void sumWeightedRows(const float *rows, const float *factors, float *result) {
+#if defined(MATH_MATRIX4_SSE2)
+		__m128 sum = _mm_mul_ps(_mm_set1_ps(factors[0]), _mm_loadu_ps(rows + 0));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(factors[1]), _mm_loadu_ps(rows + 4)));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(factors[2]), _mm_loadu_ps(rows + 8)));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(factors[3]), _mm_loadu_ps(rows + 12)));
+		_mm_storeu_ps(result, sum);
+#elif defined(MATH_MATRIX4_NEON)
+		float32x4_t sum = vmulq_n_f32(vld1q_f32(rows + 0), factors[0]);
+		sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(rows + 4), factors[1]));
+		sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(rows + 8), factors[2]));
+		sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(rows + 12), factors[3]));
+		vst1q_f32(result, sum);
+#else
+		for (int i = 0; i < 4; i++) {
+			result[i] = factors[0] * rows[0 * 4 + i] +
+			            factors[1] * rows[1 * 4 + i] +
+			            factors[2] * rows[2 * 4 + i] +
+			            factors[3] * rows[3 * 4 + i];
+		}
+#endif
 	}
 };
 
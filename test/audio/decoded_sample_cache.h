@@ -0,0 +1,93 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/decoded_sample_cache.h"
+
+#include "common/memstream.h"
+
+#include "helper.h"
+#include "../null_osystem.h"
+
+// The cache relies on OSystem for its mutex
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define TEST_SAMPLE_CACHE 1
+#else
+#define TEST_SAMPLE_CACHE 0
+#endif
+
+class DecodedSampleCacheTestSuite : public CxxTest::TestSuite {
+public:
+	void test_store_and_lookup() {
+#if TEST_SAMPLE_CACHE
+		Common::install_null_g_system();
+
+		Audio::DecodedSampleCache cache(1024 * 1024);
+		const Audio::DecodedSampleCache::Key key("sounds.res", 1234, 1);
+
+		TS_ASSERT(!cache.createStream(key));
+
+		int16 *sine = nullptr;
+		Audio::SeekableAudioStream *stream = cache.decodeAndStore(key, createSineStream<int16>(11025, 1, &sine, false, true));
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(cache.getSize(), 11025u * 2 * 2);
+
+		Audio::SeekableAudioStream *cached = cache.createStream(key);
+		TS_ASSERT(cached);
+		TS_ASSERT(cached->isStereo());
+		TS_ASSERT_EQUALS(cached->getRate(), 11025);
+
+		// Different formats of the same data are separate sounds
+		TS_ASSERT(!cache.createStream(Audio::DecodedSampleCache::Key("sounds.res", 1234, 2)));
+
+		int16 *buffer = new int16[11025 * 2];
+		TS_ASSERT_EQUALS(stream->readBuffer(buffer, 11025 * 2), 11025 * 2);
+		TS_ASSERT_EQUALS(memcmp(buffer, sine, 11025 * 2 * sizeof(int16)), 0);
+
+		// Streams keep playing after their sound has been dropped
+		cache.clear();
+		TS_ASSERT_EQUALS(cache.getSize(), 0u);
+		TS_ASSERT(!cache.createStream(key));
+		TS_ASSERT_EQUALS(cached->readBuffer(buffer, 11025 * 2), 11025 * 2);
+		TS_ASSERT_EQUALS(memcmp(buffer, sine, 11025 * 2 * sizeof(int16)), 0);
+		TS_ASSERT(cached->endOfData());
+
+		delete[] buffer;
+		delete[] sine;
+		delete cached;
+		delete stream;
+#endif
+	}
+
+	void test_budget() {
+#if TEST_SAMPLE_CACHE
+		Common::install_null_g_system();
+
+		// Room for two one second mono sounds
+		Audio::DecodedSampleCache cache(11025 * 2 * 2);
+		const Audio::DecodedSampleCache::Key first("a", 0), second("b", 0), third("c", 0);
+
+		delete cache.decodeAndStore(first, createSineStream<int16>(11025, 1, nullptr, false, false));
+		delete cache.decodeAndStore(second, createSineStream<int16>(11025, 1, nullptr, false, false));
+
+		// Looking up the first sound makes the second one the oldest
+		delete cache.createStream(first);
+		delete cache.decodeAndStore(third, createSineStream<int16>(11025, 1, nullptr, false, false));
+
+		TS_ASSERT_EQUALS(cache.getSize(), 11025u * 2 * 2);
+		Audio::SeekableAudioStream *stream = cache.createStream(first);
+		TS_ASSERT(stream);
+		delete stream;
+		TS_ASSERT(!cache.createStream(second));
+		stream = cache.createStream(third);
+		TS_ASSERT(stream);
+		delete stream;
+
+		// Sounds over budget are returned, but not kept
+		stream = cache.decodeAndStore(Audio::DecodedSampleCache::Key("d", 0), createSineStream<int16>(11025, 3, nullptr, false, false));
+		TS_ASSERT(stream);
+		delete stream;
+		TS_ASSERT(!cache.createStream(Audio::DecodedSampleCache::Key("d", 0)));
+		TS_ASSERT_EQUALS(cache.getSize(), 11025u * 2 * 2);
+#endif
+	}
+};
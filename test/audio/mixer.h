@@ -0,0 +1,133 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mixer_intern.h"
+#include "audio/rate_intern.h"
+
+#include "helper.h"
+#include "../null_osystem.h"
+
+// The mixer relies on OSystem for its mutexes and timing
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define TEST_MIXER 1
+#else
+#define TEST_MIXER 0
+#endif
+
+class MixerTestSuite : public CxxTest::TestSuite {
+public:
+	void test_channel_control() {
+#if TEST_MIXER
+		Common::install_null_g_system();
+		// Avoid querying the CPU features from OSystem
+		Audio::g_stereoMixFunc = Audio::mixStereoGeneric;
+		Audio::g_stereoBusMixFunc = Audio::mixStereoBusGeneric;
+		Audio::g_mixBusClampFunc = Audio::clampMixBusGeneric;
+
+		Audio::MixerImpl mixer(22050);
+		mixer.setReady(true);
+
+		Audio::SoundHandle handle;
+		Audio::SeekableAudioStream *stream = createSineStream<int16>(22050, 1, nullptr, false, true);
+		mixer.playStream(Audio::Mixer::kSFXSoundType, &handle, stream, 42, 200, -10, DisposeAfterUse::YES, false, false);
+
+		TS_ASSERT(mixer.isSoundHandleActive(handle));
+		TS_ASSERT(mixer.isSoundIDActive(42));
+		TS_ASSERT(!mixer.isSoundIDActive(43));
+		TS_ASSERT_EQUALS(mixer.getSoundID(handle), 42);
+		TS_ASSERT(mixer.hasActiveChannelOfType(Audio::Mixer::kSFXSoundType));
+		TS_ASSERT(!mixer.hasActiveChannelOfType(Audio::Mixer::kMusicSoundType));
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 200);
+		TS_ASSERT_EQUALS(mixer.getChannelBalance(handle), -10);
+		TS_ASSERT_EQUALS(mixer.getChannelRate(handle), 22050u);
+
+		// Requested settings can be read back before the mixer applied them
+		mixer.setChannelVolume(handle, 100);
+		mixer.setChannelRate(handle, 11025);
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 100);
+		TS_ASSERT_EQUALS(mixer.getChannelRate(handle), 11025u);
+		mixer.resetChannelRate(handle);
+		TS_ASSERT_EQUALS(mixer.getChannelRate(handle), 22050u);
+
+		// Flooding the command queue must not lose any request
+		for (int i = 0; i < 1000; i++)
+			mixer.setChannelBalance(handle, i % 128);
+		TS_ASSERT_EQUALS(mixer.getChannelBalance(handle), 999 % 128);
+
+		int16 buffer[256 * 2];
+		TS_ASSERT_EQUALS(mixer.mixCallback((byte *)buffer, sizeof(buffer)), 256);
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 100);
+
+		// Paused channels are skipped
+		mixer.pauseHandle(handle, true);
+		TS_ASSERT_EQUALS(mixer.mixCallback((byte *)buffer, sizeof(buffer)), 0);
+		mixer.pauseHandle(handle, false);
+		TS_ASSERT_EQUALS(mixer.mixCallback((byte *)buffer, sizeof(buffer)), 256);
+
+		Audio::Mixer::OutputStats stats;
+		mixer.getOutputStats(stats);
+		TS_ASSERT_EQUALS(stats.callbacks, 3u);
+		TS_ASSERT_EQUALS(stats.bufferTime, 256u * 1000000 / 22050);
+		mixer.resetOutputStats();
+		mixer.getOutputStats(stats);
+		TS_ASSERT_EQUALS(stats.callbacks, 0u);
+		TS_ASSERT_EQUALS(stats.underruns, 0u);
+
+		mixer.stopHandle(handle);
+		TS_ASSERT(!mixer.isSoundHandleActive(handle));
+		TS_ASSERT(!mixer.isSoundIDActive(42));
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 0);
+
+		// Commands for stopped channels are ignored
+		mixer.setChannelVolume(handle, 50);
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 0);
+
+		Audio::g_stereoMixFunc = nullptr;
+		Audio::g_stereoBusMixFunc = nullptr;
+		Audio::g_mixBusClampFunc = nullptr;
+#endif
+	}
+
+	void test_queued_pause() {
+#if TEST_MIXER
+		Common::install_null_g_system();
+		Audio::g_stereoMixFunc = Audio::mixStereoGeneric;
+		Audio::g_stereoBusMixFunc = Audio::mixStereoBusGeneric;
+		Audio::g_mixBusClampFunc = Audio::clampMixBusGeneric;
+
+		Audio::MixerImpl mixer(22050);
+		mixer.setReady(true);
+
+		int16 buffer[256 * 2];
+
+		// Pausing everything does not pause sounds started afterwards
+		mixer.pauseAll(true);
+		Audio::SoundHandle handle;
+		mixer.playStream(Audio::Mixer::kSFXSoundType, &handle, createSineStream<int16>(22050, 1, nullptr, false, true), 42, 255, 0, DisposeAfterUse::YES, false, false);
+		TS_ASSERT(mixer.isSoundHandleActive(handle));
+		TS_ASSERT_EQUALS(mixer.mixCallback((byte *)buffer, sizeof(buffer)), 256);
+
+		// Unpausing everything does not unpause sounds paused afterwards
+		mixer.pauseAll(false);
+		mixer.stopAll();
+		mixer.playStream(Audio::Mixer::kSFXSoundType, &handle, createSineStream<int16>(22050, 1, nullptr, false, true), 42, 255, 0, DisposeAfterUse::YES, false, false);
+		mixer.pauseHandle(handle, true);
+		TS_ASSERT(mixer.isSoundHandleActive(handle));
+		TS_ASSERT_EQUALS(mixer.mixCallback((byte *)buffer, sizeof(buffer)), 0);
+
+		// Pausing an id does not pause a later sound with the same id
+		mixer.stopAll();
+		mixer.playStream(Audio::Mixer::kSFXSoundType, &handle, createSineStream<int16>(22050, 1, nullptr, false, true), 42, 255, 0, DisposeAfterUse::YES, false, false);
+		mixer.pauseID(42, true);
+		mixer.stopID(42);
+		mixer.playStream(Audio::Mixer::kSFXSoundType, &handle, createSineStream<int16>(22050, 1, nullptr, false, true), 42, 255, 0, DisposeAfterUse::YES, false, false);
+		TS_ASSERT(mixer.isSoundIDActive(42));
+		TS_ASSERT_EQUALS(mixer.mixCallback((byte *)buffer, sizeof(buffer)), 256);
+
+		mixer.stopAll();
+
+		Audio::g_stereoMixFunc = nullptr;
+		Audio::g_stereoBusMixFunc = nullptr;
+		Audio::g_mixBusClampFunc = nullptr;
+#endif
+	}
+};
@@ -0,0 +1,225 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mixer.h"
+#include "audio/rate.h"
+#include "audio/rate_intern.h"
+
+#include "helper.h"
+
+class RateTestSuite : public CxxTest::TestSuite {
+	static void fillSamples(int16 *samples, int count, uint32 seed) {
+		for (int i = 0; i < count; i++) {
+			seed = seed * 1103515245 + 12345;
+			samples[i] = (int16)(seed >> 16);
+		}
+	}
+
+	static void checkMixFunc(Audio::StereoMixFunc mixFunc) {
+		// Odd frame count to also cover the scalar tail
+		const int frames = 37;
+		int16 src[frames * 2], expected[frames * 2], actual[frames * 2];
+
+		const Audio::st_volume_t volumes[] = { 0, 1, 127, 255, Audio::Mixer::kMaxMixerVolume };
+
+		for (int l = 0; l < ARRAYSIZE(volumes); l++) {
+			for (int r = 0; r < ARRAYSIZE(volumes); r++) {
+				fillSamples(src, frames * 2, l * 10 + r);
+				fillSamples(expected, frames * 2, l * 10 + r + 1000);
+				memcpy(actual, expected, sizeof(actual));
+
+				Audio::mixStereoGeneric(expected, src, frames, volumes[l], volumes[r]);
+				mixFunc(actual, src, frames, volumes[l], volumes[r]);
+
+				TS_ASSERT_SAME_DATA(expected, actual, sizeof(actual));
+			}
+		}
+	}
+
+	static void checkBusMixFunc(Audio::StereoBusMixFunc mixFunc) {
+		const int frames = 37;
+		int16 src[frames * 2];
+		int32 expected[frames * 2], actual[frames * 2];
+
+		const Audio::st_volume_t volumes[] = { 0, 1, 127, 255, Audio::Mixer::kMaxMixerVolume };
+
+		for (int l = 0; l < ARRAYSIZE(volumes); l++) {
+			for (int r = 0; r < ARRAYSIZE(volumes); r++) {
+				fillSamples(src, frames * 2, l * 10 + r);
+				for (int i = 0; i < frames * 2; i++)
+					expected[i] = actual[i] = (i * 7919) - 200000;
+
+				Audio::mixStereoBusGeneric(expected, src, frames, volumes[l], volumes[r]);
+				mixFunc(actual, src, frames, volumes[l], volumes[r]);
+
+				TS_ASSERT_SAME_DATA(expected, actual, sizeof(actual));
+			}
+		}
+	}
+
+	static void checkClampFunc(Audio::MixBusClampFunc clampFunc) {
+		const int count = 37;
+		int32 src[count];
+		int16 expected[count], actual[count];
+
+		for (int i = 0; i < count; i++)
+			src[i] = (i - count / 2) * 3001;
+
+		Audio::clampMixBusGeneric(expected, src, count);
+		clampFunc(actual, src, count);
+
+		TS_ASSERT_SAME_DATA(expected, actual, sizeof(actual));
+	}
+
+public:
+	void test_mix_generic() {
+		int16 src[4] = { 1000, -1000, 32767, -32768 };
+		int16 dst[4] = { 0, 0, 32000, -32000 };
+
+		Audio::mixStereoGeneric(dst, src, 2, 128, Audio::Mixer::kMaxMixerVolume);
+
+		TS_ASSERT_EQUALS(dst[0], 500);
+		TS_ASSERT_EQUALS(dst[1], -1000);
+		// Saturated
+		TS_ASSERT_EQUALS(dst[2], 32767);
+		TS_ASSERT_EQUALS(dst[3], -32768);
+	}
+
+	void test_mix_simd() {
+#ifdef SCUMMVM_NEON
+		checkMixFunc(Audio::mixStereoNEON);
+#endif
+#ifdef SCUMMVM_SSE2
+		checkMixFunc(Audio::mixStereoSSE2);
+#endif
+	}
+
+	void test_mix_bus_generic() {
+		int16 src[4] = { 1000, -1000, 32767, -32768 };
+		int32 bus[4] = { 0, 0, 32000, -32000 };
+
+		Audio::mixStereoBusGeneric(bus, src, 2, 128, Audio::Mixer::kMaxMixerVolume);
+
+		TS_ASSERT_EQUALS(bus[0], 500);
+		TS_ASSERT_EQUALS(bus[1], -1000);
+		// Not saturated until the bus is clamped
+		TS_ASSERT_EQUALS(bus[2], 32000 + 16383);
+		TS_ASSERT_EQUALS(bus[3], -32000 - 32768);
+
+		int16 out[4];
+		Audio::clampMixBusGeneric(out, bus, 4);
+
+		TS_ASSERT_EQUALS(out[0], 500);
+		TS_ASSERT_EQUALS(out[1], -1000);
+		TS_ASSERT_EQUALS(out[2], 32767);
+		TS_ASSERT_EQUALS(out[3], -32768);
+	}
+
+	void test_mix_bus_simd() {
+#ifdef SCUMMVM_NEON
+		checkBusMixFunc(Audio::mixStereoBusNEON);
+		checkClampFunc(Audio::clampMixBusNEON);
+#endif
+#ifdef SCUMMVM_SSE2
+		checkBusMixFunc(Audio::mixStereoBusSSE2);
+		checkClampFunc(Audio::clampMixBusSSE2);
+#endif
+	}
+
+	void test_copy_convert() {
+		// Avoid querying the CPU features from OSystem
+		Audio::g_stereoMixFunc = Audio::mixStereoGeneric;
+		Audio::g_stereoBusMixFunc = Audio::mixStereoBusGeneric;
+
+		int16 *comp = nullptr;
+		Audio::SeekableAudioStream *stream = createSineStream<int16>(22050, 1, &comp, false, true);
+		Audio::RateConverter *converter = Audio::makeRateConverter(22050, 22050, true, true, true);
+
+		int16 out[1000 * 2];
+		memset(out, 0, sizeof(out));
+
+		TS_ASSERT_EQUALS(converter->convert(*stream, out, 1000, Audio::Mixer::kMaxMixerVolume, 128), 1000);
+
+		for (int i = 0; i < 1000; i++) {
+			// Reversed stereo: the right output channel gets the left input
+			TS_ASSERT_EQUALS(out[i * 2 + 1], comp[i * 2]);
+			TS_ASSERT_EQUALS(out[i * 2], comp[i * 2 + 1] / 2);
+		}
+
+		delete converter;
+		delete stream;
+		delete[] comp;
+		Audio::g_stereoMixFunc = nullptr;
+		Audio::g_stereoBusMixFunc = nullptr;
+	}
+
+	void test_dot_product() {
+		int16 a[64], b[64];
+		fillSamples(a, 64, 1);
+		fillSamples(b, 64, 2);
+
+		// Keep the sum small enough not to overflow
+		for (int i = 0; i < 64; i++)
+			b[i] >>= 4;
+		const int32 expected = Audio::dotProductGeneric(a, b, 64);
+
+#ifdef SCUMMVM_NEON
+		TS_ASSERT_EQUALS(Audio::dotProductNEON(a, b, 64), expected);
+#endif
+#ifdef SCUMMVM_SSE2
+		TS_ASSERT_EQUALS(Audio::dotProductSSE2(a, b, 64), expected);
+#endif
+	}
+
+	void test_sinc_filter_bank() {
+		Audio::SincFilterCache cache;
+		const Audio::SincFilterBank *up = cache.getFilterBank(11025, 44100);
+		const Audio::SincFilterBank *down = cache.getFilterBank(44100, 11025);
+
+		TS_ASSERT_EQUALS(cache.getFilterBank(11025, 44100), up);
+		TS_ASSERT_EQUALS(up->getTaps(), (uint)Audio::SincFilterBank::kBaseTaps);
+		TS_ASSERT(down->getTaps() > up->getTaps());
+		TS_ASSERT_EQUALS(down->getTaps() % 8, 0u);
+
+		// Every phase has unity gain
+		for (uint phase = 0; phase < Audio::SincFilterBank::kPhases; phase++) {
+			const int16 *coeffs = down->getPhase(phase);
+			int sum = 0;
+			for (uint i = 0; i < down->getTaps(); i++)
+				sum += coeffs[i];
+			TS_ASSERT_EQUALS(sum, 1 << Audio::SincFilterBank::kCoeffBits);
+		}
+	}
+
+	void test_sinc_convert() {
+		// Avoid querying the CPU features from OSystem
+		Audio::g_stereoMixFunc = Audio::mixStereoGeneric;
+		Audio::g_stereoBusMixFunc = Audio::mixStereoBusGeneric;
+		Audio::g_dotProductFunc = Audio::dotProductGeneric;
+
+		const int inFrames = 2000;
+		int16 *in = (int16 *)malloc(inFrames * sizeof(int16));
+		for (int i = 0; i < inFrames; i++)
+			WRITE_LE_UINT16(&in[i], 10000);
+
+		Audio::SeekableAudioStream *stream = Audio::makeRawStream((const byte *)in, inFrames * sizeof(int16), 22050,
+		                                                          Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN, DisposeAfterUse::YES);
+		Audio::SincFilterCache cache;
+		Audio::RateConverter *converter = Audio::makeRateConverter(22050, 48000, false, true, false, Audio::kRateConverterSinc, &cache);
+
+		int16 out[1000 * 2];
+		memset(out, 0, sizeof(out));
+		TS_ASSERT_EQUALS(converter->convert(*stream, out, 1000, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume), 1000);
+
+		// Once the filter is filled, a constant signal is passed unchanged
+		for (int i = 100; i < 1000; i++) {
+			TS_ASSERT_EQUALS(out[i * 2], 10000);
+			TS_ASSERT_EQUALS(out[i * 2 + 1], 10000);
+		}
+
+		delete converter;
+		delete stream;
+		Audio::g_stereoMixFunc = nullptr;
+		Audio::g_stereoBusMixFunc = nullptr;
+		Audio::g_dotProductFunc = nullptr;
+	}
+};
@@ -0,0 +1,256 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// The allocation counters replace the global operator new and delete, and
+// the report is printed with stdio.
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include <new>
+#include <stdlib.h>
+#include <stdio.h>
+#ifdef POSIX
+#include <sys/resource.h>
+#endif
+
+#define USE_NULL_DRIVER 1
+#define NULL_DRIVER_USE_FOR_BENCH 1
+#include "../../backends/platform/null/null.cpp"
+
+#include "common/algorithm.h"
+#include "common/atomic.h"
+#include "common/events.h"
+#ifdef ENABLE_EVENTRECORDER
+#include "gui/EventRecorder.h"
+#endif
+
+/*
+ * scummvm-bench runs games on the null backend as fast as possible, for
+ * measuring the performance of engines and of the code they use. Delays are
+ * skipped, while getMillis() still advances by the time skipped, so games
+ * run their logic at full speed. Input comes from EventRecorder recordings,
+ * given with the usual --record-mode=playback options.
+ *
+ * Options, in addition to the ones of scummvm:
+ *  --bench-frames=N  Quit after N screen updates.
+ *
+ * At exit, the number of frames, frames per second, frame time percentiles,
+ * C++ allocations and the peak resident set size are printed.
+ */
+
+namespace {
+
+uint64 g_allocations = 0;
+
+} // End of anonymous namespace
+
+void *operator new(size_t size) {
+	Common::atomicFetchAdd<uint64>(&g_allocations, 1);
+	void *ptr = malloc(size ? size : 1);
+	if (!ptr) {
+		// Exceptions are disabled
+		fputs("scummvm-bench: out of memory\n", stderr);
+		abort();
+	}
+	return ptr;
+}
+
+void *operator new[](size_t size) {
+	return operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+	Common::atomicFetchAdd<uint64>(&g_allocations, 1);
+	return malloc(size ? size : 1);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &tag) noexcept {
+	return operator new(size, tag);
+}
+
+void operator delete(void *ptr) noexcept {
+	free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+	free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+	free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept {
+	free(ptr);
+}
+
+namespace {
+
+class BenchStats {
+public:
+	BenchStats() : _maxFrames(0), _started(false), _startTime(0), _lastFrame(0), _startAllocations(0) {}
+
+	void setMaxFrames(uint maxFrames) { _maxFrames = maxFrames; }
+
+	void start(uint64 now) {
+		_started = true;
+		_startTime = _lastFrame = now;
+		_startAllocations = Common::atomicLoad(&g_allocations);
+	}
+
+	/** Record a screen update. Returns true once the requested number of frames are done. */
+	bool addFrame(uint64 now) {
+		_frameTimes.push_back((uint32)(now - _lastFrame));
+		_lastFrame = now;
+		return _maxFrames && _frameTimes.size() >= _maxFrames;
+	}
+
+	/** Print the results, unless no game was run. */
+	void report(uint64 now) {
+		if (!_started)
+			return;
+
+		const uint64 elapsed = now - _startTime;
+		const uint frames = _frameTimes.size();
+
+		printf("Frames:          %u\n", frames);
+		printf("Time:            %.3f s\n", elapsed / 1000000.0);
+		if (elapsed)
+			printf("Frames/s:        %.1f\n", frames * 1000000.0 / elapsed);
+
+		if (frames) {
+			Common::sort(_frameTimes.begin(), _frameTimes.end());
+			printf("Frame time p50:  %.3f ms\n", percentile(50) / 1000.0);
+			printf("Frame time p90:  %.3f ms\n", percentile(90) / 1000.0);
+			printf("Frame time p99:  %.3f ms\n", percentile(99) / 1000.0);
+			printf("Frame time max:  %.3f ms\n", _frameTimes.back() / 1000.0);
+		}
+
+		printf("Allocations:     %llu\n", (unsigned long long)(Common::atomicLoad(&g_allocations) - _startAllocations));
+
+#ifdef POSIX
+		struct rusage usage;
+		if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef MACOSX
+			// Reported in bytes instead of kilobytes
+			usage.ru_maxrss /= 1024;
+#endif
+			printf("Peak RSS:        %ld KB\n", (long)usage.ru_maxrss);
+		}
+#endif
+		fflush(stdout);
+	}
+
+private:
+	uint32 percentile(uint percent) const {
+		return _frameTimes[(_frameTimes.size() - 1) * percent / 100];
+	}
+
+	uint _maxFrames;
+	bool _started;
+	Common::Array<uint32> _frameTimes;
+	uint64 _startTime;
+	uint64 _lastFrame;
+	uint64 _startAllocations;
+};
+
+class BenchGraphicsManager : public NullGraphicsManager {
+public:
+	explicit BenchGraphicsManager(BenchStats &stats) : _stats(stats), _quitSent(false) {}
+
+	void updateScreen() override {
+		if (_stats.addFrame(g_system->getMicros()) && !_quitSent) {
+			Common::Event event;
+			event.type = Common::EVENT_QUIT;
+			g_system->getEventManager()->pushEvent(event);
+			_quitSent = true;
+		}
+	}
+
+private:
+	BenchStats &_stats;
+	bool _quitSent;
+};
+
+class OSystem_Bench : public OSystem_NULL {
+public:
+	OSystem_Bench() : OSystem_NULL(false), _skippedMillis(0) {}
+
+	BenchStats &getStats() { return _stats; }
+
+	void initBackend() override {
+		OSystem_NULL::initBackend();
+
+		delete _graphicsManager;
+		_graphicsManager = new BenchGraphicsManager(_stats);
+	}
+
+	void engineInit() override {
+		OSystem_NULL::engineInit();
+		_stats.start(getMicros());
+	}
+
+	uint32 getMillis(bool skipRecord) override {
+		uint32 millis = OSystem_NULL::getMillis(skipRecord) + _skippedMillis;
+
+#ifdef ENABLE_EVENTRECORDER
+		g_eventRec.processMillis(millis, skipRecord);
+#endif
+
+		return millis;
+	}
+
+	void delayMillis(uint msecs) override {
+		// Let the time pass without waiting for it
+		_skippedMillis += msecs;
+	}
+
+	void quit() override {
+		_stats.report(getMicros());
+		exit(0);
+	}
+
+private:
+	BenchStats _stats;
+	uint32 _skippedMillis;
+};
+
+} // End of anonymous namespace
+
+int main(int argc, char *argv[]) {
+	OSystem_Bench *system = new OSystem_Bench();
+	g_system = system;
+
+	// Take out the options of the benchmark before passing the others on
+	int scummvmArgc = 0;
+	for (int i = 0; i < argc; i++) {
+		if (!strncmp(argv[i], "--bench-frames=", 15))
+			system->getStats().setMaxFrames(atoi(argv[i] + 15));
+		else
+			argv[scummvmArgc++] = argv[i];
+	}
+	argv[scummvmArgc] = nullptr;
+
+	int res = scummvm_main(scummvmArgc, argv);
+	system->getStats().report(system->getMicros());
+
+	g_system->destroy();
+	return res;
+}
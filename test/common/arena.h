@@ -0,0 +1,113 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/arena.h"
+#include "common/str.h"
+
+namespace {
+
+struct DestructorCounter {
+	explicit DestructorCounter(int &counter, int value = 0) : _counter(counter), _value(value) {}
+	~DestructorCounter() { _counter++; }
+
+	int &_counter;
+	int _value;
+};
+
+} // End of anonymous namespace
+
+class ArenaTestSuite : public CxxTest::TestSuite {
+public:
+	void test_alignment() {
+		Common::Arena arena(256);
+
+		for (size_t alignment = 1; alignment <= 128; alignment *= 2) {
+			byte *a = (byte *)arena.allocate(3, 1);
+			byte *b = (byte *)arena.allocate(5, alignment);
+			TS_ASSERT_EQUALS((uintptr)b % alignment, 0u);
+			TS_ASSERT(a != b);
+			memset(b, 0xAA, 5);
+		}
+
+		// The defaults match the type
+		double *d = arena.allocateArray<double>(4);
+		TS_ASSERT_EQUALS((uintptr)d % alignof(double), 0u);
+	}
+
+	void test_chunk_reuse() {
+		Common::Arena arena(1024);
+
+		for (int frame = 0; frame < 3; frame++) {
+			for (int i = 0; i < 100; i++)
+				memset(arena.allocate(100), i, 100);
+			arena.reset();
+		}
+		const size_t capacity = arena.getCapacity();
+		TS_ASSERT(capacity >= 100 * 100);
+
+		for (int i = 0; i < 100; i++)
+			memset(arena.allocate(100), i, 100);
+		TS_ASSERT_EQUALS(arena.getCapacity(), capacity);
+
+		// Allocations larger than a chunk get their own
+		byte *large = (byte *)arena.allocate(10000);
+		memset(large, 0, 10000);
+		TS_ASSERT(arena.getCapacity() >= capacity + 10000);
+
+		arena.release();
+		TS_ASSERT_EQUALS(arena.getCapacity(), 0u);
+	}
+
+	void test_create() {
+		int destructed = 0;
+		Common::Arena arena;
+
+		DestructorCounter *first = arena.create<DestructorCounter>(destructed, 1);
+		TS_ASSERT_EQUALS(first->_value, 1);
+
+		Common::Arena::Marker marker = arena.getMarker();
+		void *afterMarker = arena.allocate(16);
+		arena.create<DestructorCounter>(destructed);
+		arena.create<DestructorCounter>(destructed);
+
+		arena.rewind(marker);
+		TS_ASSERT_EQUALS(destructed, 2);
+		// The memory after the marker is handed out again
+		TS_ASSERT_EQUALS(arena.allocate(16), afterMarker);
+
+		{
+			Common::ArenaScope scope(arena);
+			arena.create<DestructorCounter>(destructed);
+		}
+		TS_ASSERT_EQUALS(destructed, 3);
+
+		arena.reset();
+		TS_ASSERT_EQUALS(destructed, 4);
+	}
+
+	void test_copy_string() {
+		Common::Arena arena;
+		const char *a = arena.copyString("hello");
+		const char *b = arena.copyString(Common::String("world"));
+		TS_ASSERT_EQUALS(Common::String(a), "hello");
+		TS_ASSERT_EQUALS(Common::String(b), "world");
+	}
+
+	void test_allocator() {
+		Common::Arena arena;
+		Common::ArenaAllocator<int> intAllocator(arena);
+		Common::ArenaAllocator<int>::rebind<double>::other doubleAllocator(intAllocator);
+
+		TS_ASSERT(intAllocator == doubleAllocator);
+		TS_ASSERT_EQUALS(&doubleAllocator.getArena(), &arena);
+
+		int *ints = intAllocator.allocate(10);
+		double *doubles = doubleAllocator.allocate(10);
+		for (int i = 0; i < 10; i++) {
+			ints[i] = i;
+			doubles[i] = i;
+		}
+		TS_ASSERT_EQUALS(ints[9], 9);
+		TS_ASSERT_EQUALS(doubles[9], 9.0);
+		intAllocator.deallocate(ints, 10);
+	}
+};
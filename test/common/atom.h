@@ -0,0 +1,77 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/atom.h"
+
+class AtomTestSuite : public CxxTest::TestSuite {
+public:
+	void test_intern() {
+		Common::AtomTable table;
+		TS_ASSERT_EQUALS(table.size(), 0u);
+
+		const Common::Atom a = table.intern("property");
+		const Common::Atom b = table.intern(Common::String("property"));
+		const Common::Atom c = table.intern("property list", 8);
+		const Common::Atom d = table.intern("selector");
+
+		TS_ASSERT(a == b);
+		TS_ASSERT(a == c);
+		TS_ASSERT(a != d);
+		TS_ASSERT_EQUALS(table.size(), 2u);
+
+		TS_ASSERT_EQUALS(a.size(), 8u);
+		TS_ASSERT(a.equals("property"));
+		TS_ASSERT_EQUALS(Common::String(c.c_str()), "property");
+		TS_ASSERT_EQUALS(d.toString(), "selector");
+		TS_ASSERT_EQUALS(a.hash(), Common::String("property").hash());
+
+		// Interning is case-sensitive
+		TS_ASSERT(table.intern("Property") != a);
+	}
+
+	void test_empty() {
+		Common::AtomTable table;
+		const Common::Atom empty;
+
+		TS_ASSERT(empty.empty());
+		TS_ASSERT_EQUALS(empty.c_str()[0], 0);
+		TS_ASSERT_EQUALS(empty.hash(), Common::String().hash());
+		TS_ASSERT(table.intern("") == empty);
+		TS_ASSERT(Common::Atom("") == empty);
+		TS_ASSERT_EQUALS(table.size(), 0u);
+	}
+
+	void test_find() {
+		Common::AtomTable table;
+		const Common::Atom a = table.intern("name");
+
+		Common::Atom found;
+		TS_ASSERT(table.find("name", found));
+		TS_ASSERT(found == a);
+		TS_ASSERT(!table.find("other", found));
+		TS_ASSERT_EQUALS(table.size(), 1u);
+
+		table.clear();
+		TS_ASSERT_EQUALS(table.size(), 0u);
+		TS_ASSERT(!table.find("name", found));
+	}
+
+	void test_global_table() {
+		const Common::Atom a("common atom");
+		const Common::Atom b(Common::String("common atom"));
+
+		TS_ASSERT(a == b);
+		TS_ASSERT(Common::AtomTable::getGlobal().intern("common atom") == a);
+	}
+
+	void test_hashmap() {
+		Common::AtomTable table;
+		Common::HashMap<Common::Atom, int> map;
+
+		for (int i = 0; i < 100; i++)
+			map[table.intern(Common::String::format("key%d", i))] = i;
+
+		TS_ASSERT_EQUALS(map.size(), 100u);
+		for (int i = 0; i < 100; i++)
+			TS_ASSERT_EQUALS(map[table.intern(Common::String::format("key%d", i))], i);
+	}
+};
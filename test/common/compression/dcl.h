@@ -0,0 +1,156 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/compression/dcl.h"
+
+/**
+ * The streams are built bit by bit from the format description, as there is
+ * no DCL compressor in the tree.
+ */
+class DCLTestSuite : public CxxTest::TestSuite {
+	// Packs bits starting with the least significant bit of each byte
+	class BitWriter {
+	public:
+		BitWriter() : _bitPos(0) {}
+
+		void putBit(uint bit) {
+			if (!(_bitPos & 7))
+				_data.push_back(0);
+			if (bit)
+				_data.back() |= 1 << (_bitPos & 7);
+			_bitPos++;
+		}
+
+		void putBits(uint32 value, int count) {
+			for (int i = 0; i < count; i++)
+				putBit((value >> i) & 1);
+		}
+
+		// Huffman codes are given as strings of the bits in stream order
+		void putCode(const char *code) {
+			for (; *code; code++)
+				putBit(*code == '1');
+		}
+
+		void putLiteral(byte literal) {
+			putBit(0);
+			putBits(literal, 8);
+		}
+
+		// Matches of 2 to 5 bytes at distances of up to 16 bytes, with a
+		// dictionary of 1 KiB
+		void putMatch(uint32 length, uint32 distance) {
+			static const char *const lengthCodes[] = { "101", "11", "100", "011" };
+
+			putBit(1);
+			putCode(lengthCodes[length - 2]);
+			putCode("11");
+			putBits(distance - 1, length == 2 ? 2 : 4);
+		}
+
+		void putEnd() {
+			putBit(1);
+			putBits(0, 7);
+			putBits(0xFF, 8);
+		}
+
+		const Common::Array<byte> &getData() const { return _data; }
+
+	private:
+		Common::Array<byte> _data;
+		uint32 _bitPos;
+	};
+
+	static bool decompress(const Common::Array<byte> &packed, const char *expected, uint32 size) {
+		Common::MemoryReadStream stream(packed.data(), packed.size());
+		Common::Array<byte> unpacked(size);
+		if (!Common::decompressDCL(&stream, unpacked.data(), packed.size(), size))
+			return false;
+		return memcmp(unpacked.data(), expected, size) == 0;
+	}
+
+public:
+	void test_binary() {
+		BitWriter bits;
+		bits.putBits(0, 8); // Binary mode
+		bits.putBits(4, 8); // 1 KiB dictionary
+		bits.putLiteral('A');
+		bits.putLiteral(0xFF);
+		bits.putLiteral(0x00);
+		bits.putMatch(5, 3);
+		bits.putLiteral('D');
+		bits.putMatch(2, 2);
+		bits.putMatch(4, 1);
+		bits.putEnd();
+
+		static const char expected[] = "A\xFF\x00" "A\xFF\x00" "A\xFF" "D" "\xFF" "D" "DDDD";
+		TS_ASSERT(decompress(bits.getData(), expected, sizeof(expected) - 1));
+	}
+
+	void test_ascii() {
+		BitWriter bits;
+		bits.putBits(1, 8); // ASCII mode
+		bits.putBits(4, 8);
+		bits.putBit(0);
+		bits.putCode("10100"); // t
+		bits.putBit(0);
+		bits.putCode("010100"); // h
+		bits.putBit(0);
+		bits.putCode("11011"); // e
+		bits.putBit(0);
+		bits.putCode("1111"); // Space
+		bits.putMatch(3, 4);
+		bits.putBit(0);
+		bits.putCode("0011110"); // .
+		bits.putBit(0);
+		bits.putCode("000010111"); // X
+		bits.putBit(0);
+		bits.putCode("0000001001000"); // 0x80, with the longest code
+		bits.putBit(0);
+		bits.putCode("0100011"); // Newline
+		bits.putEnd();
+
+		static const char expected[] = "the the.X\x80\n";
+		TS_ASSERT(decompress(bits.getData(), expected, sizeof(expected) - 1));
+	}
+
+	void test_unknown_size() {
+		BitWriter bits;
+		bits.putBits(0, 8);
+		bits.putBits(4, 8);
+		for (const char *c = "abcd"; *c; c++)
+			bits.putLiteral(*c);
+		// Long enough to need several output buffer reallocations
+		for (int i = 0; i < 1000; i++)
+			bits.putMatch(4, 4);
+		bits.putEnd();
+
+		const Common::Array<byte> &packed = bits.getData();
+		Common::MemoryReadStream stream(packed.data(), packed.size());
+		Common::ScopedPtr<Common::SeekableReadStream> unpacked(Common::decompressDCL(&stream));
+		TS_ASSERT(unpacked);
+		if (!unpacked)
+			return;
+
+		TS_ASSERT_EQUALS(unpacked->size(), 4 + 4 * 1000);
+		bool matches = true;
+		for (uint i = 0; i < 4 + 4 * 1000; i++)
+			matches = matches && (unpacked->readByte() == (byte)('a' + i % 4));
+		TS_ASSERT(matches);
+	}
+
+	void test_truncated() {
+		BitWriter bits;
+		bits.putBits(0, 8);
+		bits.putBits(4, 8);
+		bits.putLiteral('A');
+		bits.putMatch(5, 1);
+		bits.putEnd();
+
+		// More output is requested than there is in the stream
+		static const char expected[] = "AAAAAAAAAA";
+		TS_ASSERT(!decompress(bits.getData(), expected, sizeof(expected) - 1));
+	}
+};
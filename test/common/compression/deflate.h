@@ -0,0 +1,105 @@
+#include <cxxtest/TestSuite.h>
+#include "common/compression/deflate.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+
+/**
+ * A test suite for the seekable raw deflate stream in
+ * common/compression/deflate.h.
+ * The raw deflate data is cut out of a gzip stream compressed at runtime.
+ */
+class DeflateTestSuite : public CxxTest::TestSuite {
+	enum {
+		kDataSize = 1024 * 1024 + 12345,
+		kGzipHeaderSize = 10,
+		kGzipTrailerSize = 8
+	};
+
+	byte *_data;
+	byte *_compressed;
+	uint32 _compressedSize;
+
+	Common::SeekableReadStream *createStream(uint32 checkpointInterval) {
+		Common::SeekableReadStream *raw = new Common::MemoryReadStream(_compressed + kGzipHeaderSize,
+			_compressedSize - kGzipHeaderSize - kGzipTrailerSize);
+		return Common::wrapSeekableDeflateReadStream(raw, DisposeAfterUse::YES, kDataSize, checkpointInterval);
+	}
+
+	void checkRead(Common::SeekableReadStream &stream, uint32 pos, uint32 size) {
+		byte buf[1000];
+		TS_ASSERT(stream.seek(pos));
+		TS_ASSERT_EQUALS(stream.pos(), pos);
+		TS_ASSERT_EQUALS(stream.read(buf, size), size);
+		TS_ASSERT_EQUALS(memcmp(buf, _data + pos, size), 0);
+	}
+
+	void checkStream(uint32 checkpointInterval) {
+		Common::ScopedPtr<Common::SeekableReadStream> stream(createStream(checkpointInterval));
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->size(), kDataSize);
+
+		// Read it all in odd sized chunks
+		byte *buf = new byte[kDataSize];
+		uint32 pos = 0;
+		while (pos < kDataSize) {
+			uint32 count = stream->read(buf + pos, MIN<uint32>(7777, kDataSize - pos));
+			if (count == 0)
+				break;
+			pos += count;
+		}
+		TS_ASSERT_EQUALS(pos, kDataSize);
+		TS_ASSERT_EQUALS(memcmp(buf, _data, kDataSize), 0);
+		delete[] buf;
+
+		TS_ASSERT_EQUALS(stream->read(buf, 1), 0u);
+		TS_ASSERT(stream->eos());
+		TS_ASSERT(!stream->err());
+
+		// Seek all over the place
+		checkRead(*stream, 0, 1000);
+		checkRead(*stream, kDataSize - 1000, 1000);
+		checkRead(*stream, 500000, 1000);
+		checkRead(*stream, 499500, 1000);
+		checkRead(*stream, 100, 1000);
+		checkRead(*stream, 900000, 1000);
+		checkRead(*stream, 300000, 1000);
+		TS_ASSERT(!stream->eos());
+	}
+
+public:
+	void setUp() {
+		// Compressible, but not trivially so, to get many deflate blocks
+		_data = new byte[kDataSize];
+		uint32 seed = 1;
+		for (uint32 i = 0; i < kDataSize; ++i) {
+			seed = seed * 1103515245 + 12345;
+			_data[i] = 'a' + ((seed >> 16) % 16);
+		}
+
+		// The data is kept when the compressing stream deletes this one
+		Common::MemoryWriteStreamDynamic *out = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::WriteStream *gzip = Common::wrapCompressedWriteStream(out);
+		gzip->write(_data, kDataSize);
+		gzip->finalize();
+		_compressed = out->getData();
+		_compressedSize = out->size();
+		delete gzip;
+	}
+
+	void tearDown() {
+		delete[] _data;
+		free(_compressed);
+	}
+
+	void test_seekable_deflate_checkpoints() {
+#ifdef USE_ZLIB
+		checkStream(64 * 1024);
+#endif
+	}
+
+	void test_seekable_deflate_no_checkpoints() {
+#ifdef USE_ZLIB
+		checkStream(0);
+#endif
+	}
+};
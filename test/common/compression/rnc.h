@@ -0,0 +1,155 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/endian.h"
+#include "common/util.h"
+#include "common/compression/rnc_deco.h"
+
+/**
+ * The streams are built bit by bit from the format description, as there is
+ * no RNC compressor in the tree.
+ */
+class RncTestSuite : public CxxTest::TestSuite {
+	// RNC method 1 packs its bits into 16-bit little endian words. Literal runs
+	// are stored as plain bytes right after the word holding the current bits.
+	class Rnc1Writer {
+	public:
+		Rnc1Writer() : _wordPos(0), _bitsLeft(0) {}
+
+		void putBit(uint bit) {
+			if (!_bitsLeft) {
+				_wordPos = _data.size();
+				_data.push_back(0);
+				_data.push_back(0);
+				_bitsLeft = 16;
+			}
+			if (bit)
+				WRITE_LE_UINT16(&_data[_wordPos], READ_LE_UINT16(&_data[_wordPos]) | (1 << (16 - _bitsLeft)));
+			_bitsLeft--;
+		}
+
+		void putBits(uint32 value, int count) {
+			for (int i = 0; i < count; i++)
+				putBit((value >> i) & 1);
+		}
+
+		// The tables either use 16 codes of 4 bits, so the code of a symbol is the
+		// symbol itself, or a unary code of symbol + 1 bits, up to 15 bits
+		void putValue(uint32 value, bool unary = false) {
+			uint32 symbol = 0;
+			while ((value >> symbol) > 1)
+				symbol++;
+			symbol = value < 2 ? value : symbol + 1;
+
+			if (unary) {
+				for (uint32 i = 0; i < symbol; i++)
+					putBit(1);
+				if (symbol < 15)
+					putBit(0);
+			} else {
+				for (int i = 3; i >= 0; i--)
+					putBit((symbol >> i) & 1);
+			}
+			if (symbol >= 2)
+				putBits(value - (1 << (symbol - 1)), symbol - 1);
+		}
+
+		void putLiterals(const char *literals, uint32 count) {
+			putValue(count);
+			for (uint32 i = 0; i < count; i++)
+				_data.push_back(literals[i]);
+		}
+
+		// The distances use the unary code, so that long codes are needed
+		void putMatch(uint32 distance, uint32 length) {
+			putValue(distance - 1, true);
+			putValue(length - 2);
+		}
+
+		const Common::Array<byte> &getData() const { return _data; }
+
+	private:
+		Common::Array<byte> _data;
+		uint32 _wordPos;
+		int _bitsLeft;
+	};
+
+	static uint16 crc(const byte *data, uint32 size) {
+		uint16 value = 0;
+		for (uint32 i = 0; i < size; i++) {
+			value ^= data[i];
+			for (int bit = 0; bit < 8; bit++)
+				value = (value & 1) ? (value >> 1) ^ 0xA001 : (value >> 1);
+		}
+		return value;
+	}
+
+	static void startStream(Rnc1Writer &writer, uint16 tokens) {
+		// Skipped by the decompressor
+		writer.putBits(0, 2);
+		for (int table = 0; table < 3; table++) {
+			writer.putBits(16, 5);
+			for (int i = 0; i < 16; i++)
+				writer.putBits(table == 1 ? MIN(i + 1, 15) : 4, 4);
+		}
+		writer.putBits(tokens, 16);
+	}
+
+	static Common::Array<byte> makePacked(const Rnc1Writer &writer, const Common::Array<byte> &unpacked) {
+		const Common::Array<byte> &data = writer.getData();
+		Common::Array<byte> packed(18);
+		WRITE_BE_UINT32(&packed[0], Common::RncDecoder::kRnc1Signature);
+		WRITE_BE_UINT32(&packed[4], unpacked.size());
+		WRITE_BE_UINT32(&packed[8], data.size());
+		WRITE_BE_UINT16(&packed[12], crc(unpacked.data(), unpacked.size()));
+		WRITE_BE_UINT16(&packed[14], crc(data.data(), data.size()));
+		packed[16] = 0;
+		packed[17] = 1;
+		packed.push_back(data);
+		return packed;
+	}
+
+public:
+	void test_method1() {
+		Common::Array<byte> expected(1101, 'a');
+		for (const char *c = "xyzaaaaend"; *c; c++)
+			expected.push_back(*c);
+
+		Rnc1Writer writer;
+		startStream(writer, 3);
+		writer.putLiterals("a", 1);
+		writer.putMatch(1, 1100);
+		writer.putLiterals("xyz", 3);
+		// Distance code of 12 bits, longer than the lookup tables
+		writer.putMatch(1103, 4);
+		// The last token has no match
+		writer.putLiterals("end", 3);
+
+		const Common::Array<byte> packed = makePacked(writer, expected);
+		Common::Array<byte> unpacked(expected.size());
+
+		Common::RncDecoder rnc;
+		TS_ASSERT_EQUALS(rnc.unpackM1(packed.data(), packed.size(), unpacked.data()), (int32)expected.size());
+		TS_ASSERT(unpacked == expected);
+	}
+
+	void test_method1_truncated() {
+		Common::Array<byte> expected;
+		for (const char *c = "abcdefghij"; *c; c++)
+			expected.push_back(*c);
+
+		Rnc1Writer writer;
+		startStream(writer, 1);
+		// Only 3 of the 10 literals are present
+		writer.putValue(10);
+		Common::Array<byte> input = makePacked(writer, expected);
+		for (const char *c = "abc"; *c; c++)
+			input.push_back(*c);
+		WRITE_BE_UINT32(&input[8], input.size() - 18);
+		WRITE_BE_UINT16(&input[14], crc(&input[18], input.size() - 18));
+
+		Common::Array<byte> unpacked(expected.size());
+		Common::RncDecoder rnc;
+		TS_ASSERT_EQUALS(rnc.unpackM1(input.data(), input.size(), unpacked.data()), 0);
+	}
+};
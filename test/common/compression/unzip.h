@@ -0,0 +1,109 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/array.h"
+#include "common/crc.h"
+#include "common/endian.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/compression/unzip.h"
+
+#include "../../null_osystem.h"
+
+/**
+ * The archives are built at runtime, with a single stored member.
+ */
+class UnzipTestSuite : public CxxTest::TestSuite {
+	static void putUint16(Common::Array<byte> &data, uint16 value) {
+		data.push_back(value & 0xFF);
+		data.push_back(value >> 8);
+	}
+
+	static void putUint32(Common::Array<byte> &data, uint32 value) {
+		putUint16(data, value & 0xFFFF);
+		putUint16(data, value >> 16);
+	}
+
+	// The fields shared by the local and the central headers, from the
+	// version needed to extract to the length of the extra field
+	static void putFileInfo(Common::Array<byte> &data, const char *name, const Common::Array<byte> &contents) {
+		Common::CRC32 crc;
+		putUint16(data, 10);
+		putUint16(data, 0);
+		// Stored
+		putUint16(data, 0);
+		putUint16(data, 0);
+		putUint16(data, 0x21);
+		putUint32(data, crc.crcFast(contents.data(), contents.size()));
+		putUint32(data, contents.size());
+		putUint32(data, contents.size());
+		putUint16(data, strlen(name));
+		putUint16(data, 0);
+	}
+
+	static Common::SeekableReadStream *makeZip(const char *name, const Common::Array<byte> &contents) {
+		Common::Array<byte> data;
+		putUint32(data, 0x04034B50);
+		putFileInfo(data, name, contents);
+		data.push_back(Common::Array<byte>((const byte *)name, strlen(name)));
+		data.push_back(contents);
+
+		const uint32 centralDirOffset = data.size();
+		putUint32(data, 0x02014B50);
+		putUint16(data, 10);
+		putFileInfo(data, name, contents);
+		// Comment length, disk number, internal and external attributes
+		putUint16(data, 0);
+		putUint16(data, 0);
+		putUint16(data, 0);
+		putUint32(data, 0);
+		// Offset of the local header
+		putUint32(data, 0);
+		data.push_back(Common::Array<byte>((const byte *)name, strlen(name)));
+		const uint32 centralDirSize = data.size() - centralDirOffset;
+
+		putUint32(data, 0x06054B50);
+		putUint16(data, 0);
+		putUint16(data, 0);
+		putUint16(data, 1);
+		putUint16(data, 1);
+		putUint32(data, centralDirSize);
+		putUint32(data, centralDirOffset);
+		putUint16(data, 0);
+
+		byte *buffer = (byte *)malloc(data.size());
+		memcpy(buffer, data.data(), data.size());
+		return new Common::MemoryReadStream(buffer, data.size(), DisposeAfterUse::YES);
+	}
+
+public:
+	void test_streamed_member_outlives_archive() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Array<byte> contents;
+		for (uint i = 0; i < 5000; i++)
+			contents.push_back(i * 7);
+
+		// A threshold of 1 byte makes the member be streamed from the archive
+		Common::Archive *archive = Common::makeZipArchive(makeZip("member.bin", contents), false, 1);
+		TS_ASSERT(archive);
+		if (!archive)
+			return;
+
+		Common::ScopedPtr<Common::SeekableReadStream> member(archive->createReadStreamForMember("member.bin"));
+		delete archive;
+		TS_ASSERT(member);
+		if (!member)
+			return;
+
+		TS_ASSERT_EQUALS(member->size(), (int64)contents.size());
+		Common::Array<byte> read(contents.size());
+		TS_ASSERT(member->seek(1000));
+		TS_ASSERT_EQUALS(member->read(read.data() + 1000, contents.size() - 1000), contents.size() - 1000);
+		TS_ASSERT(member->seek(0));
+		TS_ASSERT_EQUALS(member->read(read.data(), 1000), 1000u);
+		TS_ASSERT(read == contents);
+#endif
+	}
+};
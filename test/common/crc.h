@@ -51,6 +51,30 @@ public:
 		TS_ASSERT_EQUALS(crc.finalize(running), 0xf0c8U);
 	}
 
+	void test_crc_reflected_lengths() {
+		// Every length and alignment, against the bytewise CRC
+		byte message[70];
+		for (int i = 0; i < 70; i++)
+			message[i] = (byte)(i * 37 + 11);
+
+		Common::CRC32 crc32;
+		Common::CRC16 crc16;
+		bool same = true;
+		for (int offset = 0; offset < 4; offset++) {
+			for (int len = 0; len + offset <= 70; len++) {
+				uint32 running32 = crc32.getInitRemainder();
+				uint16 running16 = crc16.getInitRemainder();
+				for (int i = 0; i < len; i++) {
+					running32 = crc32.processByte(message[offset + i], running32);
+					running16 = crc16.processByte(message[offset + i], running16);
+				}
+				same = same && crc32.crcFast(message + offset, len) == crc32.finalize(running32);
+				same = same && crc16.crcFast(message + offset, len) == crc16.finalize(running16);
+			}
+		}
+		TS_ASSERT(same);
+	}
+
 	void test_crc32_slow() {
 		Common::CRC32_Slow crc;
 		TS_ASSERT_EQUALS(crc.crcSlow(testStringCRC, testLenCRC), 0x414fa339U);
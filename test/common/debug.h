@@ -0,0 +1,54 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/debug.h"
+#include "common/debug-channels.h"
+
+class DebugTestSuite : public CxxTest::TestSuite {
+	static int _evaluations;
+
+	static const char *countEvaluation() {
+		_evaluations++;
+		return "";
+	}
+
+public:
+	void test_channel_active() {
+		const int oldLevel = gDebugLevel;
+		gDebugLevel = 2;
+
+		TS_ASSERT(!debugChannelActive(1, 5));
+		TS_ASSERT(!debugChannelActive(5));
+
+		DebugMan.enableDebugChannel(5);
+		TS_ASSERT(debugChannelActive(1, 5));
+		TS_ASSERT(debugChannelActive(2, 5));
+		TS_ASSERT(!debugChannelActive(3, 5));
+		TS_ASSERT(debugChannelActive(5));
+
+		// Channels sharing a bit of the filter are still told apart
+		TS_ASSERT(!debugChannelActive(1, 5 + 64));
+		TS_ASSERT(!debugChannelActive(5 + 64));
+
+		DebugMan.disableDebugChannel(5);
+		TS_ASSERT(!debugChannelActive(1, 5));
+		TS_ASSERT_EQUALS(gDebugChannelFilter & (1 << 5), 0u);
+
+		gDebugLevel = oldLevel;
+	}
+
+	void test_macros_skip_arguments() {
+		const int oldLevel = gDebugLevel;
+		gDebugLevel = 2;
+		_evaluations = 0;
+
+		DEBUG_C(1, 6, "%s", countEvaluation());
+		DEBUG_CN(1, 6, "%s", countEvaluation());
+		DEBUG_C_CHANNEL(6, "%s", countEvaluation());
+		DEBUG_CN_CHANNEL(6, "%s", countEvaluation());
+		TS_ASSERT_EQUALS(_evaluations, 0);
+
+		gDebugLevel = oldLevel;
+	}
+};
+
+int DebugTestSuite::_evaluations = 0;
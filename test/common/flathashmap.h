@@ -0,0 +1,238 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/debug.h"
+#include "common/flathashmap.h"
+#include "common/hash-str.h"
+#include "common/system.h"
+
+#include "../null_osystem.h"
+
+class FlatHashMapTestSuite : public CxxTest::TestSuite
+{
+	typedef Common::FlatHashMap<Common::String, Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> FlatStringMap;
+
+	static uint32 nextRandom(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return seed >> 8;
+	}
+
+	template<class Map>
+	static uint32 benchmarkIntMap(int count, int rounds) {
+		uint32 sum = 0;
+		for (int round = 0; round < rounds; round++) {
+			Map map;
+			for (int i = 0; i < count; i++)
+				map[i * 7919] = i;
+			for (int i = 0; i < count * 4; i++)
+				sum += map.getValOrDefault((i % count) * 7919 + (i & 1), 0);
+			for (int i = 0; i < count; i += 2)
+				map.erase(i * 7919);
+		}
+		return sum;
+	}
+
+	template<class Map>
+	static uint32 benchmarkStringMap(const Common::Array<Common::String> &keys, int rounds) {
+		uint32 sum = 0;
+		Map map;
+		for (uint i = 0; i < keys.size(); i++)
+			map[keys[i]] = i;
+		for (int round = 0; round < rounds; round++) {
+			for (uint i = 0; i < keys.size(); i++)
+				sum += map.getValOrDefault(keys[i], 0);
+		}
+		return sum;
+	}
+
+	public:
+	void test_empty_clear() {
+		Common::FlatHashMap<int, int> container;
+		TS_ASSERT(container.empty());
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(!container.empty());
+		container.clear();
+		TS_ASSERT(container.empty());
+
+		FlatStringMap container2;
+		TS_ASSERT(container2.empty());
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(!container2.empty());
+		container2.clear(true);
+		TS_ASSERT(container2.empty());
+		TS_ASSERT_EQUALS(container2.begin(), container2.end());
+	}
+
+	void test_contains() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(container.contains(0));
+		TS_ASSERT(container.contains(1));
+		TS_ASSERT(!container.contains(17));
+		TS_ASSERT(!container.contains(-1));
+
+		FlatStringMap container2;
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(container2.contains("foo"));
+		TS_ASSERT(container2.contains("QUUX"));
+		TS_ASSERT(!container2.contains("bar"));
+		TS_ASSERT(!container2.contains("asdf"));
+	}
+
+	void test_add_remove() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		TS_ASSERT(container.contains(1));
+		container.erase(1);
+		TS_ASSERT(!container.contains(1));
+		container[1] = 42;
+		TS_ASSERT_EQUALS(container[1], 42);
+		container.erase(container.find(0));
+		container.erase(container.find(1));
+		TS_ASSERT_EQUALS(container.size(), 1u);
+		container.erase(2);
+		TS_ASSERT(container.empty());
+		// Erasing a missing key is fine
+		container.erase(2);
+		TS_ASSERT(container.empty());
+	}
+
+	void test_lookup_with_default() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container.setVal(1, -1);
+
+		const Common::FlatHashMap<int, int> &containerRef = container;
+
+		TS_ASSERT_EQUALS(containerRef[1], -1);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(0), 17);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(17), 0);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(17, -10), -10);
+
+		int val = 0;
+		TS_ASSERT(containerRef.tryGetVal(0, val));
+		TS_ASSERT_EQUALS(val, 17);
+		TS_ASSERT(!containerRef.tryGetVal(2, val));
+		TS_ASSERT_EQUALS(containerRef.find(2), containerRef.end());
+	}
+
+	void test_copy() {
+		FlatStringMap map1, map2;
+		for (int i = 0; i < 100; i++)
+			map1[Common::String::format("key%d", i)] = Common::String::format("value%d", i);
+
+		map2 = map1;
+		FlatStringMap map3(map1);
+		map1.clear();
+
+		TS_ASSERT_EQUALS(map2.size(), 100u);
+		TS_ASSERT_EQUALS(map3.size(), 100u);
+		for (int i = 0; i < 100; i++) {
+			TS_ASSERT_EQUALS(map2[Common::String::format("KEY%d", i)], Common::String::format("value%d", i));
+			TS_ASSERT_EQUALS(map3[Common::String::format("key%d", i)], Common::String::format("value%d", i));
+		}
+	}
+
+	void test_iterator() {
+		Common::FlatHashMap<int, int> container;
+		for (int i = 0; i < 5; i++)
+			container[i] = i * 10;
+		container.erase(1);
+		container[1] = 42;
+		container.erase(0);
+		container.erase(1);
+
+		int found = 0;
+		for (Common::FlatHashMap<int, int>::const_iterator i = container.begin(); i != container.end(); ++i) {
+			int key = i->_key;
+			TS_ASSERT(key >= 0 && key <= 4);
+			TS_ASSERT(!(found & (1 << key)));
+			TS_ASSERT_EQUALS(i->_value, key * 10);
+			found |= 1 << key;
+		}
+		TS_ASSERT(found == 16+8+4);
+
+		// Erasing while iterating leaves the other entries in place
+		for (Common::FlatHashMap<int, int>::iterator i = container.begin(); i != container.end(); ++i) {
+			if (i->_key != 3)
+				container.erase(i);
+		}
+		TS_ASSERT_EQUALS(container.size(), 1u);
+		TS_ASSERT(container.contains(3));
+	}
+
+	void test_against_hashmap() {
+		// Random insertions and erasures, with keys colliding in the low
+		// bits, to cover rehashing and the reuse of deleted slots
+		Common::FlatHashMap<uint, uint> flat;
+		Common::HashMap<uint, uint> reference;
+		uint32 seed = 1;
+
+		for (int i = 0; i < 20000; i++) {
+			const uint key = (nextRandom(seed) % 500) << 8;
+			if (nextRandom(seed) % 3 == 0) {
+				flat.erase(key);
+				reference.erase(key);
+			} else {
+				flat[key] = i;
+				reference[key] = i;
+			}
+
+			if (i == 10000)
+				flat.reserve(2000);
+		}
+
+		TS_ASSERT_EQUALS(flat.size(), reference.size());
+		for (Common::HashMap<uint, uint>::const_iterator i = reference.begin(); i != reference.end(); ++i)
+			TS_ASSERT_EQUALS(flat.getValOrDefault(i->_key, (uint)-1), i->_value);
+
+		uint count = 0;
+		for (Common::FlatHashMap<uint, uint>::const_iterator i = flat.begin(); i != flat.end(); ++i, ++count)
+			TS_ASSERT(reference.contains(i->_key));
+		TS_ASSERT_EQUALS(count, reference.size());
+	}
+
+	void test_benchmark() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+#ifdef SLOW_TESTS
+		const int rounds = 200;
+#else
+		const int rounds = 1;
+#endif
+		Common::Array<Common::String> keys;
+		for (int i = 0; i < 5000; i++)
+			keys.push_back(Common::String::format("selector_%d", i * 31));
+
+		uint32 start = g_system->getMillis();
+		const uint32 oldInt = benchmarkIntMap<Common::HashMap<int, int> >(5000, rounds);
+		const uint32 oldIntTime = g_system->getMillis() - start;
+
+		start = g_system->getMillis();
+		const uint32 newInt = benchmarkIntMap<Common::FlatHashMap<int, int> >(5000, rounds);
+		const uint32 newIntTime = g_system->getMillis() - start;
+
+		start = g_system->getMillis();
+		const uint32 oldString = benchmarkStringMap<Common::HashMap<Common::String, int> >(keys, rounds);
+		const uint32 oldStringTime = g_system->getMillis() - start;
+
+		start = g_system->getMillis();
+		const uint32 newString = benchmarkStringMap<Common::FlatHashMap<Common::String, int> >(keys, rounds);
+		const uint32 newStringTime = g_system->getMillis() - start;
+
+		TS_ASSERT_EQUALS(oldInt, newInt);
+		TS_ASSERT_EQUALS(oldString, newString);
+
+		debug("HashMap<int> %d rounds (in milliseconds): %d\n", rounds, oldIntTime);
+		debug("FlatHashMap<int> %d rounds (in milliseconds): %d\n", rounds, newIntTime);
+		debug("HashMap<String> %d rounds (in milliseconds): %d\n", rounds, oldStringTime);
+		debug("FlatHashMap<String> %d rounds (in milliseconds): %d\n", rounds, newStringTime);
+#endif
+	}
+};
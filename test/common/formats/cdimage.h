@@ -0,0 +1,166 @@
+#include <cxxtest/TestSuite.h>
+#include "common/archive.h"
+#include "common/endian.h"
+#include "common/memstream.h"
+#include "common/formats/cdimage.h"
+#include "../../null_osystem.h"
+
+/**
+ * Tests for reading the ISO 9660 file system of CD images,
+ * built at runtime in cooked and in raw sectors.
+ */
+class CDImageTestSuite : public CxxTest::TestSuite {
+	enum {
+		kSectors = 64,
+		kRootLBA = 20,
+		kDirLBA = 21,
+		kFileLBA = 22,
+		kFileSize = 5000,
+		kNestedLBA = 25,
+		kNestedSize = 70000
+	};
+
+	byte *_image;
+
+	static void writeBoth32(byte *p, uint32 value) {
+		WRITE_LE_UINT32(p, value);
+		WRITE_BE_UINT32(p + 4, value);
+	}
+
+	static uint32 writeRecord(byte *p, uint32 lba, uint32 size, byte flags, const char *name, byte nameSize) {
+		const byte recordSize = (33 + nameSize + 1) & ~1;
+		memset(p, 0, recordSize);
+		p[0] = recordSize;
+		writeBoth32(p + 2, lba);
+		writeBoth32(p + 10, size);
+		p[25] = flags;
+		p[32] = nameSize;
+		memcpy(p + 33, name, nameSize);
+		return recordSize;
+	}
+
+	static byte fileByte(uint32 lba, uint32 pos) {
+		return (byte)(lba * 31 + pos * 7 + (pos >> 9));
+	}
+
+	byte *sector(uint32 lba) {
+		return _image + lba * Common::CDImage::kSectorSize;
+	}
+
+	Common::SeekableReadStream *createRawImage() {
+		static const byte syncPattern[12] = { 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00 };
+
+		byte *raw = (byte *)malloc(kSectors * Common::CDImage::kRawSectorSize);
+		for (uint32 lba = 0; lba < kSectors; ++lba) {
+			byte *p = raw + lba * Common::CDImage::kRawSectorSize;
+			memcpy(p, syncPattern, sizeof(syncPattern));
+			p[12] = p[13] = p[14] = 0;
+			p[15] = 1;
+			memcpy(p + 16, sector(lba), Common::CDImage::kSectorSize);
+			memset(p + 16 + Common::CDImage::kSectorSize, 0xEC, Common::CDImage::kRawSectorSize - 16 - Common::CDImage::kSectorSize);
+		}
+
+		return new Common::MemoryReadStream(raw, kSectors * Common::CDImage::kRawSectorSize, DisposeAfterUse::YES);
+	}
+
+	void checkFile(Common::Archive &archive, const char *name, uint32 lba, uint32 size) {
+		Common::ScopedPtr<Common::SeekableReadStream> stream(archive.createReadStreamForMember(Common::Path(name)));
+		TS_ASSERT(stream);
+		if (!stream)
+			return;
+
+		TS_ASSERT_EQUALS(stream->size(), size);
+
+		byte *data = (byte *)malloc(size + 1);
+		TS_ASSERT_EQUALS(stream->read(data, size + 1), size);
+		TS_ASSERT(stream->eos());
+		bool same = true;
+		for (uint32 i = 0; i < size; ++i)
+			same = same && data[i] == fileByte(lba, i);
+		TS_ASSERT(same);
+
+		// Read across the end of a cache block
+		const uint32 pos = MIN<uint32>(size - 100, 32768 - 50);
+		TS_ASSERT(stream->seek(pos));
+		TS_ASSERT_EQUALS(stream->read(data, 100), 100u);
+		TS_ASSERT_EQUALS(data[0], fileByte(lba, pos));
+		TS_ASSERT_EQUALS(data[99], fileByte(lba, pos + 99));
+		free(data);
+	}
+
+	void checkArchive(Common::SeekableReadStream *imageStream) {
+		Common::SharedPtr<Common::CDImage> image(new Common::CDImage());
+		TS_ASSERT(image->open(imageStream));
+		TS_ASSERT_EQUALS(image->getDataSectorCount(), (uint32)kSectors);
+
+		Common::ScopedPtr<Common::Archive> archive(Common::makeISO9660Archive(image));
+		TS_ASSERT(archive);
+		if (!archive)
+			return;
+
+		// Versions and trailing dots are dropped, names are matched without case
+		TS_ASSERT(archive->hasFile(Common::Path("file.txt")));
+		TS_ASSERT(archive->hasFile(Common::Path("DIR/NESTED")));
+		TS_ASSERT(!archive->hasFile(Common::Path("FILE.TXT;1")));
+		TS_ASSERT(!archive->hasFile(Common::Path("DIR")));
+
+		Common::ArchiveMemberList list;
+		TS_ASSERT_EQUALS(archive->listMembers(list), 2);
+
+		checkFile(*archive, "FILE.TXT", kFileLBA, kFileSize);
+		checkFile(*archive, "dir/nested", kNestedLBA, kNestedSize);
+	}
+
+public:
+	void setUp() {
+		Common::install_null_g_system();
+
+		_image = (byte *)calloc(kSectors, Common::CDImage::kSectorSize);
+
+		// Primary volume descriptor, and terminator
+		byte *pvd = sector(16);
+		pvd[0] = 1;
+		memcpy(pvd + 1, "CD001", 5);
+		pvd[6] = 1;
+		writeRecord(pvd + 156, kRootLBA, Common::CDImage::kSectorSize, 2, "\0", 1);
+
+		byte *terminator = sector(17);
+		terminator[0] = 255;
+		memcpy(terminator + 1, "CD001", 5);
+
+		byte *p = sector(kRootLBA);
+		p += writeRecord(p, kRootLBA, Common::CDImage::kSectorSize, 2, "\0", 1);
+		p += writeRecord(p, kRootLBA, Common::CDImage::kSectorSize, 2, "\1", 1);
+		p += writeRecord(p, kDirLBA, Common::CDImage::kSectorSize, 2, "DIR", 3);
+		p += writeRecord(p, kFileLBA, kFileSize, 0, "FILE.TXT;1", 10);
+
+		p = sector(kDirLBA);
+		p += writeRecord(p, kDirLBA, Common::CDImage::kSectorSize, 2, "\0", 1);
+		p += writeRecord(p, kRootLBA, Common::CDImage::kSectorSize, 2, "\1", 1);
+		p += writeRecord(p, kNestedLBA, kNestedSize, 0, "NESTED.;1", 9);
+
+		for (uint32 i = 0; i < kFileSize; ++i)
+			sector(kFileLBA)[i] = fileByte(kFileLBA, i);
+		for (uint32 i = 0; i < kNestedSize; ++i)
+			sector(kNestedLBA)[i] = fileByte(kNestedLBA, i);
+	}
+
+	void tearDown() {
+		free(_image);
+	}
+
+	void test_cooked_image() {
+		checkArchive(new Common::MemoryReadStream(_image, kSectors * Common::CDImage::kSectorSize));
+	}
+
+	void test_raw_image() {
+		checkArchive(createRawImage());
+	}
+
+	void test_not_an_image() {
+		Common::SharedPtr<Common::CDImage> image(new Common::CDImage());
+		memset(sector(16), 0, Common::CDImage::kSectorSize);
+		TS_ASSERT(image->open(new Common::MemoryReadStream(_image, kSectors * Common::CDImage::kSectorSize)));
+		TS_ASSERT(!Common::makeISO9660Archive(image));
+	}
+};
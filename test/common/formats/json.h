@@ -0,0 +1,117 @@
+#include <cxxtest/TestSuite.h>
+#include "common/formats/json.h"
+
+class JSONTestSuite : public CxxTest::TestSuite {
+	static const char *listing() {
+		return
+			"{ \"cursor\": \"abc\\\"d\",\n"
+			"  \"skipped\": { \"a\": [1, 2.5e3, {\"b\": \"]}\"}], \"c\": null },\n"
+			"  \"entries\": [\n"
+			"    { \"name\": \"first\", \"size\": 10 },\n"
+			"    { \"name\": \"sec\\u00f6nd\", \"size\": -2, \"folder\": {} },\n"
+			"    []\n"
+			"  ],\n"
+			"  \"has_more\": true\n"
+			"}\n";
+	}
+
+public:
+	void test_tree() {
+		Common::JSONValue *value = Common::JSON::parse(listing());
+		TS_ASSERT(value);
+		if (!value)
+			return;
+
+		TS_ASSERT(value->isObject());
+		TS_ASSERT_EQUALS(value->child("cursor")->asString(), "abc\"d");
+		TS_ASSERT_EQUALS(value->child("entries")->countChildren(), 3u);
+		TS_ASSERT_EQUALS(value->child("entries")->child((size_t)1)->child("size")->asIntegerNumber(), -2);
+		TS_ASSERT(value->child("has_more")->asBool());
+		delete value;
+
+		// Duplicate keys keep the last value
+		value = Common::JSON::parse("{\"a\": [1], \"a\": 2}");
+		TS_ASSERT(value);
+		if (value)
+			TS_ASSERT_EQUALS(value->child("a")->asIntegerNumber(), 2);
+		delete value;
+
+		TS_ASSERT(!Common::JSON::parse("{\"a\": [1, 2}"));
+		TS_ASSERT(!Common::JSON::parse("[{\"a\": 1}, {\"b\": }]"));
+	}
+
+	void test_reader() {
+		Common::JSONReader reader(listing());
+		Common::String key, cursor, names;
+		bool hasMore = false;
+		int sizes = 0;
+
+		TS_ASSERT_EQUALS(reader.peekType(), Common::JSONType_Object);
+		TS_ASSERT(reader.enterObject());
+		while (reader.nextKey(key)) {
+			if (key == "cursor") {
+				TS_ASSERT(reader.readString(cursor));
+			} else if (key == "entries") {
+				TS_ASSERT(reader.enterArray());
+				while (reader.nextElement()) {
+					if (reader.peekType() != Common::JSONType_Object) {
+						TS_ASSERT(reader.skipValue());
+						continue;
+					}
+
+					Common::JSONValue *entry = reader.readValue();
+					TS_ASSERT(entry);
+					if (!entry)
+						break;
+					names += entry->child("name")->asString() + ";";
+					sizes += entry->child("size")->asIntegerNumber();
+					delete entry;
+				}
+			} else if (key == "has_more") {
+				Common::JSONValue *value = reader.readValue();
+				TS_ASSERT(value && value->isBool());
+				hasMore = value && value->asBool();
+				delete value;
+			} else {
+				TS_ASSERT(reader.skipValue());
+			}
+		}
+
+		TS_ASSERT(!reader.hasError());
+		TS_ASSERT(reader.isAtEnd());
+		TS_ASSERT_EQUALS(cursor, "abc\"d");
+		TS_ASSERT_EQUALS(names, "first;sec\xc3\xb6nd;");
+		TS_ASSERT_EQUALS(sizes, 8);
+		TS_ASSERT(hasMore);
+	}
+
+	void test_reader_errors() {
+		Common::String key;
+
+		Common::JSONReader missingComma("{\"a\": 1 \"b\": 2}");
+		TS_ASSERT(missingComma.enterObject());
+		TS_ASSERT(missingComma.nextKey(key));
+		TS_ASSERT(missingComma.skipValue());
+		TS_ASSERT(!missingComma.nextKey(key));
+		TS_ASSERT(missingComma.hasError());
+
+		Common::JSONReader notAnArray("{\"a\": 1}");
+		TS_ASSERT(!notAnArray.enterArray());
+		TS_ASSERT(notAnArray.hasError());
+		TS_ASSERT(!notAnArray.isAtEnd());
+
+		Common::JSONReader truncated("[1, \"abc");
+		TS_ASSERT(truncated.enterArray());
+		TS_ASSERT(truncated.nextElement());
+		TS_ASSERT(truncated.skipValue());
+		TS_ASSERT(truncated.nextElement());
+		TS_ASSERT(!truncated.skipValue());
+		TS_ASSERT(truncated.hasError());
+
+		Common::JSONReader trailing("{} x");
+		TS_ASSERT(trailing.enterObject());
+		TS_ASSERT(!trailing.nextKey(key));
+		TS_ASSERT(!trailing.hasError());
+		TS_ASSERT(!trailing.isAtEnd());
+	}
+};
@@ -0,0 +1,131 @@
+#include <cxxtest/TestSuite.h>
+#include "common/formats/xmlparser.h"
+#include "common/memstream.h"
+#include "../../null_osystem.h"
+
+/**
+ * A small parser of scenes with objects, which records what it was given.
+ */
+class TestSceneParser : public Common::XMLParser {
+public:
+	Common::String _log;
+
+protected:
+	CUSTOM_XML_PARSER(TestSceneParser) {
+		XML_KEY(scene)
+			XML_PROP(name, true)
+			XML_KEY(object)
+				XML_PROP(id, true)
+				XML_PROP(skip, false)
+				XML_KEY_RECURSIVE(object)
+			KEY_END()
+		KEY_END()
+	} PARSER_END()
+
+	bool parserCallback_scene(ParserNode *node) {
+		_log += "scene:" + node->values["name"] + ";";
+		return true;
+	}
+
+	bool parserCallback_object(ParserNode *node) {
+		_log += "object:" + node->values["id"] + ";";
+		if (node->values.contains("skip"))
+			node->ignore = true;
+		return true;
+	}
+
+	bool closedKeyCallback(ParserNode *node) override {
+		_log += "/" + node->name + ";";
+		return true;
+	}
+
+	bool textCallback(const Common::String &val) override {
+		_log += "text:" + val + ";";
+		return true;
+	}
+};
+
+class XMLParserTestSuite : public CxxTest::TestSuite {
+	bool parseBuffer(TestSceneParser &parser, const char *text) {
+		parser.loadBuffer((const byte *)text, strlen(text));
+		return parser.parse();
+	}
+
+	bool parseStream(TestSceneParser &parser, const char *text) {
+		parser.loadStream(new Common::MemoryReadStream((const byte *)text, strlen(text)));
+		return parser.parse();
+	}
+
+public:
+	void setUp() {
+		Common::install_null_g_system();
+	}
+
+	void test_parse() {
+		static const char *text =
+			"<?xml version = '1.0'?>\n"
+			"<!-- A comment - with a hyphen -->\n"
+			"<scene name=\"The Room\">\n"
+			"\t<object id=a/>\n"
+			"\t<object id=\"b\" ><object id='c'></object></object>\n"
+			"</scene>\n";
+
+		TestSceneParser bufferParser;
+		TS_ASSERT(parseBuffer(bufferParser, text));
+		TS_ASSERT_EQUALS(bufferParser._log, "/xml;scene:The Room;object:a;/object;object:b;object:c;/object;/object;/scene;");
+
+		TestSceneParser streamParser;
+		TS_ASSERT(parseStream(streamParser, text));
+		TS_ASSERT_EQUALS(streamParser._log, bufferParser._log);
+
+		// Parsing again gives the same result
+		streamParser._log.clear();
+		TS_ASSERT(streamParser.parse());
+		TS_ASSERT_EQUALS(streamParser._log, bufferParser._log);
+	}
+
+	void test_ignored_keys() {
+		// Children of ignored keys are neither handled nor verified
+		TestSceneParser parser;
+		TS_ASSERT(parseBuffer(parser,
+			"<?xml version='1.0'?>"
+			"<scene name='s'>"
+			"<object id='a' skip='1'><object id='b'><object unknown='x'/></object></object>"
+			"<object id='c'/>"
+			"</scene>"));
+		TS_ASSERT_EQUALS(parser._log, "/xml;scene:s;object:a;object:c;/object;/scene;");
+	}
+
+	void test_text() {
+		TestSceneParser parser;
+		parser.setAllowText();
+		TS_ASSERT(parseBuffer(parser, "<?xml version='1.0'?><scene name='s'>Some text</scene>"));
+		TS_ASSERT_EQUALS(parser._log, "/xml;scene:s;text:Some text;/scene;");
+	}
+
+	void test_errors() {
+		TestSceneParser missingProperty;
+		TS_ASSERT(!parseBuffer(missingProperty, "<?xml version='1.0'?><scene></scene>"));
+
+		TestSceneParser unhandledProperty;
+		TS_ASSERT(!parseBuffer(unhandledProperty, "<?xml version='1.0'?><scene name='s' size='1'></scene>"));
+
+		TestSceneParser duplicateProperty;
+		TS_ASSERT(!parseBuffer(duplicateProperty, "<?xml version='1.0'?><scene name='s' name='t'></scene>"));
+
+		TestSceneParser unknownKey;
+		TS_ASSERT(!parseBuffer(unknownKey, "<?xml version='1.0'?><scene name='s'><door/></scene>"));
+
+		TestSceneParser badClosure;
+		TS_ASSERT(!parseBuffer(badClosure, "<?xml version='1.0'?><scene name='s'></object>"));
+
+		TestSceneParser badComment;
+		TS_ASSERT(!parseBuffer(badComment, "<?xml version='1.0'?><!- no -><scene name='s'></scene>"));
+
+		TestSceneParser unterminated;
+		TS_ASSERT(!parseBuffer(unterminated, "<?xml version='1.0'?><scene name='s"));
+
+		TestSceneParser truncated;
+		TS_ASSERT(!parseBuffer(truncated, "<?xml version='1.0'?><scene name='s'>"));
+	}
+};
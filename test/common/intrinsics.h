@@ -15,4 +15,14 @@ class IntrinsicsTestSuite : public CxxTest::TestSuite
 		// Some simple test for 2^10
 		TS_ASSERT_EQUALS(Common::intLog2(1024), 10);
 	}
+
+	void test_countZeros() {
+		TS_ASSERT_EQUALS(Common::countTrailingZeros(1), 0);
+		TS_ASSERT_EQUALS(Common::countTrailingZeros(0x80000000), 31);
+		TS_ASSERT_EQUALS(Common::countTrailingZeros(0x50), 4);
+
+		TS_ASSERT_EQUALS(Common::countLeadingZeros(1), 31);
+		TS_ASSERT_EQUALS(Common::countLeadingZeros(0x80000000), 0);
+		TS_ASSERT_EQUALS(Common::countLeadingZeros(0x50), 25);
+	}
 };
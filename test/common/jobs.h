@@ -0,0 +1,112 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/jobs.h"
+#include "../null_osystem.h"
+
+// Job groups and queues rely on OSystem for their mutexes
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define TEST_JOBS 1
+#else
+#define TEST_JOBS 0
+#endif
+
+namespace {
+
+void incrementJob(void *refCon) {
+	(*(int *)refCon)++;
+}
+
+void fillRange(uint begin, uint end, void *refCon) {
+	int *values = (int *)refCon;
+	for (uint i = begin; i < end; i++)
+		values[i] += i;
+}
+
+/**
+ * Threaded job system without any threads, so that all jobs end up being
+ * stolen from the worker queues by the waiting thread.
+ */
+class ThreadlessJobSystem : public Common::ThreadedJobSystem {
+public:
+	explicit ThreadlessJobSystem(uint numWorkers) : ThreadedJobSystem(numWorkers), notifications(0) {}
+	~ThreadlessJobSystem() override { stopWorkers(); }
+
+	uint notifications;
+
+protected:
+	void notifyWorkers(uint count) override { notifications += count; }
+	void waitForWork() override {}
+	void yield() override {}
+};
+
+} // End of anonymous namespace
+
+class JobSystemTestSuite : public CxxTest::TestSuite {
+public:
+	void test_inline_submit() {
+#if TEST_JOBS
+		Common::install_null_g_system();
+
+		Common::JobSystem jobs;
+		TS_ASSERT_EQUALS(jobs.getThreadCount(), 1u);
+
+		int counter = 0;
+		Common::JobGroup group;
+		TS_ASSERT(group.isDone());
+
+		jobs.submit(incrementJob, &counter, &group);
+		jobs.submit(incrementJob, &counter);
+
+		// Inline jobs have already run by now
+		TS_ASSERT(group.isDone());
+		TS_ASSERT_EQUALS(counter, 2);
+
+		jobs.wait(group);
+		TS_ASSERT_EQUALS(counter, 2);
+#endif
+	}
+
+	void test_threaded_queues() {
+#if TEST_JOBS
+		Common::install_null_g_system();
+
+		ThreadlessJobSystem jobs(3);
+		TS_ASSERT_EQUALS(jobs.getThreadCount(), 4u);
+
+		int counter = 0;
+		Common::JobGroup group;
+		for (int i = 0; i < 10; i++)
+			jobs.submit(incrementJob, &counter, &group);
+
+		TS_ASSERT(!group.isDone());
+		TS_ASSERT_EQUALS(counter, 0);
+		TS_ASSERT_EQUALS(jobs.notifications, 10u);
+
+		jobs.wait(group);
+		TS_ASSERT(group.isDone());
+		TS_ASSERT_EQUALS(counter, 10);
+#endif
+	}
+
+	void test_parallel_for() {
+#if TEST_JOBS
+		Common::install_null_g_system();
+
+		int values[100];
+		for (int i = 0; i < 100; i++)
+			values[i] = 0;
+
+		Common::JobSystem inlineJobs;
+		inlineJobs.parallelFor(100, fillRange, values);
+
+		ThreadlessJobSystem threadedJobs(2);
+		threadedJobs.parallelFor(100, fillRange, values, 7);
+		threadedJobs.parallelFor(3, fillRange, values, 16);
+		threadedJobs.parallelFor(0, fillRange, values);
+
+		// Every item must have been visited exactly once per call
+		for (int i = 0; i < 100; i++)
+			TS_ASSERT_EQUALS(values[i], i < 3 ? 3 * i : 2 * i);
+#endif
+	}
+};
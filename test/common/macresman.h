@@ -0,0 +1,179 @@
+#include <cxxtest/TestSuite.h>
+#include "common/archive.h"
+#include "common/endian.h"
+#include "common/macresman.h"
+#include "common/memstream.h"
+#include "../null_osystem.h"
+
+/**
+ * An archive of a file with a raw resource fork next to it, which counts
+ * how often its members are looked up.
+ */
+class ResForkArchive : public Common::Archive {
+public:
+	Common::Array<byte> _fork;
+	mutable int _memberLookups;
+
+	ResForkArchive() : _memberLookups(0) {}
+
+	bool hasFile(const Common::Path &path) const override {
+		return path == Common::Path("Data") || path == Common::Path("Data.rsrc");
+	}
+
+	int listMembers(Common::ArchiveMemberList &list) const override {
+		list.push_back(getMember(Common::Path("Data")));
+		list.push_back(getMember(Common::Path("Data.rsrc")));
+		return 2;
+	}
+
+	const Common::ArchiveMemberPtr getMember(const Common::Path &path) const override {
+		++_memberLookups;
+		if (!hasFile(path))
+			return Common::ArchiveMemberPtr();
+		return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(path, *this));
+	}
+
+	Common::SeekableReadStream *createReadStreamForMember(const Common::Path &path) const override {
+		static const byte data[4] = { 'd', 'a', 't', 'a' };
+		if (path == Common::Path("Data"))
+			return new Common::MemoryReadStream(data, sizeof(data));
+		if (path == Common::Path("Data.rsrc"))
+			return new Common::MemoryReadStream(_fork.data(), _fork.size());
+		return nullptr;
+	}
+};
+
+class MacResManagerTestSuite : public CxxTest::TestSuite {
+	enum {
+		kDataOffset = 256,
+		kMapOffset = 320
+	};
+
+	static void writeResource(Common::Array<byte> &fork, uint32 &dataPos, uint32 refPos, uint16 id, int16 nameOffset, const char *contents) {
+		WRITE_BE_UINT16(&fork[refPos], id);
+		WRITE_BE_INT16(&fork[refPos + 2], nameOffset);
+		WRITE_BE_UINT32(&fork[refPos + 4], dataPos);
+
+		const uint32 size = strlen(contents);
+		WRITE_BE_UINT32(&fork[kDataOffset + dataPos], size);
+		memcpy(&fork[kDataOffset + dataPos + 4], contents, size);
+		dataPos += 4 + size;
+	}
+
+	/**
+	 * Build a raw fork with two 'TEXT' resources, the first one named, and
+	 * one 'PICT' resource.
+	 */
+	static void buildFork(Common::Array<byte> &fork, const char *pictContents) {
+		const uint32 typeList = 28;
+		const uint32 refList = typeList + 2 + 2 * 8;
+		const uint32 nameList = refList + 3 * 12;
+		const uint32 mapLength = nameList + 6;
+
+		fork.clear();
+		fork.resize(kMapOffset + mapLength);
+
+		byte *map = &fork[kMapOffset];
+		WRITE_BE_UINT16(map + 24, typeList);
+		WRITE_BE_UINT16(map + 26, nameList);
+
+		WRITE_BE_UINT16(map + typeList, 1);
+		WRITE_BE_UINT32(map + typeList + 2, MKTAG('T', 'E', 'X', 'T'));
+		WRITE_BE_UINT16(map + typeList + 6, 1);
+		WRITE_BE_UINT16(map + typeList + 8, refList - typeList);
+		WRITE_BE_UINT32(map + typeList + 10, MKTAG('P', 'I', 'C', 'T'));
+		WRITE_BE_UINT16(map + typeList + 14, 0);
+		WRITE_BE_UINT16(map + typeList + 16, refList + 24 - typeList);
+
+		map[nameList] = 5;
+		memcpy(map + nameList + 1, "Hello", 5);
+
+		uint32 dataPos = 0;
+		writeResource(fork, dataPos, kMapOffset + refList, 128, 0, "abc");
+		writeResource(fork, dataPos, kMapOffset + refList + 12, 129, -1, "de");
+		writeResource(fork, dataPos, kMapOffset + refList + 24, 128, -1, pictContents);
+
+		WRITE_BE_UINT32(&fork[0], kDataOffset);
+		WRITE_BE_UINT32(&fork[4], kMapOffset);
+		WRITE_BE_UINT32(&fork[8], dataPos);
+		WRITE_BE_UINT32(&fork[12], mapLength);
+	}
+
+	static Common::String readResource(Common::SeekableReadStream *stream) {
+		Common::String result;
+		if (stream) {
+			while (!stream->eos()) {
+				byte b = stream->readByte();
+				if (!stream->eos())
+					result += (char)b;
+			}
+		}
+		delete stream;
+		return result;
+	}
+
+public:
+	void setUp() {
+		Common::install_null_g_system();
+		Common::MacResManager::clearForkCache();
+	}
+
+	void tearDown() {
+		Common::MacResManager::clearForkCache();
+	}
+
+	void test_lookup() {
+		ResForkArchive archive;
+		buildFork(archive._fork, "f");
+
+		Common::MacResManager resMan;
+		TS_ASSERT(resMan.open(Common::Path("Data"), archive));
+		TS_ASSERT(resMan.hasResFork());
+		TS_ASSERT_EQUALS(resMan.getResTagArray().size(), 2u);
+
+		Common::MacResIDArray ids = resMan.getResIDArray(MKTAG('T', 'E', 'X', 'T'));
+		TS_ASSERT_EQUALS(ids.size(), 2u);
+		if (ids.size() == 2) {
+			TS_ASSERT_EQUALS(ids[0], 128);
+			TS_ASSERT_EQUALS(ids[1], 129);
+		}
+		TS_ASSERT(resMan.getResIDArray(MKTAG('S', 'N', 'D', ' ')).empty());
+
+		TS_ASSERT_EQUALS(resMan.getResName(MKTAG('T', 'E', 'X', 'T'), 128), "Hello");
+		TS_ASSERT_EQUALS(resMan.getResName(MKTAG('T', 'E', 'X', 'T'), 129), "");
+		TS_ASSERT_EQUALS(readResource(resMan.getResource(MKTAG('T', 'E', 'X', 'T'), 129)), "de");
+		TS_ASSERT_EQUALS(readResource(resMan.getResource(MKTAG('P', 'I', 'C', 'T'), 128)), "f");
+		TS_ASSERT_EQUALS(readResource(resMan.getResource("hello")), "abc");
+		TS_ASSERT_EQUALS(readResource(resMan.getResource(MKTAG('T', 'E', 'X', 'T'), "HELLO")), "abc");
+		TS_ASSERT(!resMan.getResource(MKTAG('P', 'I', 'C', 'T'), "Hello"));
+		TS_ASSERT(!resMan.getResource(MKTAG('P', 'I', 'C', 'T'), 129));
+		TS_ASSERT_EQUALS(resMan.getResLength(MKTAG('T', 'E', 'X', 'T'), 128), 3u);
+	}
+
+	void test_fork_cache() {
+		ResForkArchive archive;
+		buildFork(archive._fork, "f");
+
+		Common::MacResManager first;
+		TS_ASSERT(first.open(Common::Path("Data"), archive));
+		const int lookups = archive._memberLookups;
+		TS_ASSERT(lookups > 0);
+
+		// The fork is opened where it was found, without probing again
+		Common::MacResManager second;
+		TS_ASSERT(second.open(Common::Path("Data"), archive));
+		TS_ASSERT_EQUALS(archive._memberLookups, lookups);
+		TS_ASSERT_EQUALS(second.getBaseFileName(), Common::Path("Data"));
+		TS_ASSERT_EQUALS(readResource(second.getResource(MKTAG('T', 'E', 'X', 'T'), 129)), "de");
+
+		// Managers share the map, which outlives the one which read it
+		first.close();
+		TS_ASSERT_EQUALS(second.getResName(MKTAG('T', 'E', 'X', 'T'), 128), "Hello");
+
+		// A changed fork is read again
+		buildFork(archive._fork, "ghij");
+		TS_ASSERT(second.open(Common::Path("Data"), archive));
+		TS_ASSERT(archive._memberLookups > lookups);
+		TS_ASSERT_EQUALS(readResource(second.getResource(MKTAG('P', 'I', 'C', 'T'), 128)), "ghij");
+	}
+};
@@ -1,6 +1,7 @@
 #include <cxxtest/TestSuite.h>
 
 #include "common/md5.h"
+#include "common/memstream.h"
 #include "common/stream.h"
 
 /*
@@ -47,4 +48,28 @@ class MD5TestSuite : public CxxTest::TestSuite {
 		}
 	}
 
+	void test_computeStreamMD5s() {
+		// Leading parts in any order, computed in one pass
+		const char *text = md5_test_string[6];
+		const uint32 lengths[4] = { 3, 0, 26, 1000 };
+		uint8 digests[4][16];
+		uint8 digest[16];
+
+		Common::MemoryReadStream stream((const byte *)text, strlen(text));
+		TS_ASSERT(Common::computeStreamMD5s(stream, digests, lengths, 4));
+
+		for (int i = 0; i < 4; i++) {
+			Common::MemoryReadStream single((const byte *)text, strlen(text));
+			Common::computeStreamMD5(single, digest, lengths[i]);
+			TS_ASSERT_EQUALS(memcmp(digest, digests[i], 16), 0);
+		}
+
+		// Lengths beyond the end of the stream cover all of it
+		TS_ASSERT_EQUALS(memcmp(digests[1], digests[3], 16), 0);
+
+		char output[33];
+		for (int j = 0; j < 16; j++)
+			snprintf(output + j * 2, 3, "%02x", digests[1][j]);
+		TS_ASSERT_EQUALS(Common::String(output), md5_test_digest[6]);
+	}
 };
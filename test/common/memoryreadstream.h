@@ -2,6 +2,19 @@
 
 #include "common/memstream.h"
 
+namespace {
+
+class TestFileMapping : public Common::FileMapping {
+public:
+	TestFileMapping(const byte *data, uint32 size, bool *released) : FileMapping(data, size), _released(released) {}
+	~TestFileMapping() override { *_released = true; }
+
+private:
+	bool *_released;
+};
+
+} // End of anonymous namespace
+
 class MemoryReadStreamTestSuite : public CxxTest::TestSuite {
 	public:
 	void test_seek_set() {
@@ -104,4 +117,28 @@ class MemoryReadStreamTestSuite : public CxxTest::TestSuite {
 		ms.seek(0, SEEK_SET);
 		TS_ASSERT(!ms.eos());
 	}
+
+	void test_mapped_sub_view() {
+		byte contents[] = { 1, 2, 3, 4, 5, 6, 7 };
+		bool released = false;
+
+		Common::MappedReadStream *ms = new Common::MappedReadStream(Common::SharedPtr<Common::FileMapping>(new TestFileMapping(contents, sizeof(contents), &released)), 1, 5);
+		TS_ASSERT_EQUALS(ms->size(), 5);
+		TS_ASSERT_EQUALS(ms->getMappedData(), contents + 1);
+		TS_ASSERT_EQUALS(ms->readByte(), 2);
+
+		Common::MappedReadStream *view = ms->createSubView(2, 3);
+		TS_ASSERT(view);
+		TS_ASSERT_EQUALS(ms->createSubView(3, 3), (Common::MappedReadStream *)nullptr);
+
+		// The sub-view keeps the mapping alive
+		delete ms;
+		TS_ASSERT(!released);
+		TS_ASSERT_EQUALS(view->getMappedData(), contents + 3);
+		TS_ASSERT_EQUALS(view->size(), 3);
+		TS_ASSERT_EQUALS(view->readByte(), 4);
+
+		delete view;
+		TS_ASSERT(released);
+	}
 };
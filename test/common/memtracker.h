@@ -0,0 +1,55 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memtracker.h"
+
+class MemoryTrackerTestSuite : public CxxTest::TestSuite {
+public:
+	void test_tracked_malloc() {
+		byte *ptr = (byte *)Common::trackedMalloc(100, Common::kMemoryAudio);
+		TS_ASSERT(ptr);
+		memset(ptr, 0x55, 100);
+
+		ptr = (byte *)Common::trackedRealloc(ptr, 200, Common::kMemoryAudio);
+		TS_ASSERT(ptr);
+		TS_ASSERT_EQUALS(ptr[99], 0x55);
+		Common::trackedFree(ptr);
+		Common::trackedFree(nullptr);
+	}
+
+	void test_counters() {
+#ifdef USE_MEMORY_TRACKING
+		Common::MemoryTracker::Stats before, stats;
+		Common::MemoryTracker::getStats(Common::kMemoryVideo, before);
+
+		void *ptr = Common::trackedMalloc(1000, Common::kMemoryVideo);
+		MEMORY_TRACK_ADD(Common::kMemoryVideo, 500);
+		Common::MemoryTracker::getStats(Common::kMemoryVideo, stats);
+		TS_ASSERT_EQUALS(stats.current, before.current + 1500);
+		TS_ASSERT(stats.peak >= stats.current);
+		TS_ASSERT_EQUALS(stats.allocations, before.allocations + 2);
+
+		ptr = Common::trackedRealloc(ptr, 100, Common::kMemoryVideo);
+		Common::MemoryTracker::getStats(Common::kMemoryVideo, stats);
+		TS_ASSERT_EQUALS(stats.current, before.current + 600);
+
+		Common::trackedFree(ptr);
+		MEMORY_TRACK_REMOVE(Common::kMemoryVideo, 500);
+		Common::MemoryTracker::getStats(Common::kMemoryVideo, stats);
+		TS_ASSERT_EQUALS(stats.current, before.current);
+		TS_ASSERT(stats.peak >= before.current + 1500);
+
+		Common::MemoryTracker::resetPeaks();
+		Common::MemoryTracker::getStats(Common::kMemoryVideo, stats);
+		TS_ASSERT_EQUALS(stats.peak, stats.current);
+#endif
+	}
+
+	void test_tag_names() {
+#ifdef USE_MEMORY_TRACKING
+		TS_ASSERT_EQUALS(Common::MemoryTracker::findTag("TinyGL"), Common::kMemoryTinyGL);
+		TS_ASSERT_EQUALS(Common::MemoryTracker::findTag("nonexistent"), Common::kMemoryTagCount);
+		for (int tag = 0; tag < Common::kMemoryTagCount; tag++)
+			TS_ASSERT_EQUALS(Common::MemoryTracker::findTag(Common::MemoryTracker::getTagName((Common::MemoryTag)tag)), tag);
+#endif
+	}
+};
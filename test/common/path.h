@@ -477,6 +477,46 @@ class PathTestSuite : public CxxTest::TestSuite
 		TS_ASSERT_DIFFERS(p3.hash(), p4.hash());
 	}
 
+	void test_cachedhashes() {
+		Common::Path p("parent/dir");
+		p.hash();
+		p.hashIgnoreCase();
+		p.hashIgnoreCaseAndMac();
+
+		// The hashes follow the changes of the path
+		Common::Path p2(p);
+		p2.joinInPlace("File.txt");
+		TS_ASSERT_EQUALS(p2.hash(), Common::Path("parent/dir/File.txt").hash());
+		TS_ASSERT_EQUALS(p2.hashIgnoreCaseAndMac(), Common::Path("parent/dir/File.txt").hashIgnoreCaseAndMac());
+		TS_ASSERT(p2 != p);
+
+		Common::Path p3 = p.appendComponent("sub");
+		TS_ASSERT_EQUALS(p3.hashIgnoreCase(), Common::Path("parent/dir/sub").hashIgnoreCase());
+
+		p2.toUppercase();
+		TS_ASSERT_EQUALS(p2.hash(), Common::Path("PARENT/DIR/FILE.TXT").hash());
+
+		Common::Path p4("parent/dir//");
+		p4.hash();
+		p4.removeTrailingSeparators();
+		TS_ASSERT_EQUALS(p4.hash(), p.hash());
+		TS_ASSERT_EQUALS(p4, p);
+
+		p4 = "other";
+		TS_ASSERT_EQUALS(p4.hash(), Common::Path("other").hash());
+		p4.clear();
+		TS_ASSERT_EQUALS(p4.hash(), Common::Path().hash());
+
+		// Paths with different hashes still compare through the escaping
+		Common::Path p5("parent:dir:Sound Manager 3.1 / SoundLib:Sound", ':');
+		Common::Path p6("parent/dir/xn--Sound Manager 3.1  SoundLib-lba84k/Sound");
+		p5.hash();
+		p6.hash();
+		TS_ASSERT(p5.equalsIgnoreCaseAndMac(p6));
+		TS_ASSERT_EQUALS(p5.hashIgnoreCaseAndMac(), p6.hashIgnoreCaseAndMac());
+		TS_ASSERT(p5.equalsIgnoreCaseAndMac(p6));
+	}
+
 	void test_matchString() {
 		TS_ASSERT(Common::Path("").matchPattern(""));
 		TS_ASSERT(Common::Path("a").matchPattern("*"));
@@ -0,0 +1,136 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/profiler.h"
+#include "../null_osystem.h"
+
+// The profiler needs OSystem for its mutex and timer
+#if defined(USE_PROFILER) && NULL_OSYSTEM_IS_AVAILABLE
+#define TEST_PROFILER 1
+#else
+#define TEST_PROFILER 0
+#endif
+
+class ProfilerTestSuite : public CxxTest::TestSuite {
+public:
+	void test_record() {
+#if TEST_PROFILER
+		Common::install_null_g_system();
+		Common::Profiler &profiler = Common::Profiler::instance();
+		profiler.clear();
+
+		const Common::ProfilerZone outer = { "outer", __FILE__, __LINE__ };
+		const Common::ProfilerZone inner = { "inner", __FILE__, __LINE__ };
+
+		// Nothing is recorded until enabled
+		{
+			PROFILE_ZONE("disabled");
+		}
+		Common::Array<Common::Profiler::Event> events;
+		profiler.getEvents(events);
+		TS_ASSERT(events.empty());
+
+		profiler.setEnabled(true);
+		profiler.record(inner, 10, 20);
+		profiler.record(inner, 30, 35);
+		profiler.record(outer, 5, 50);
+		profiler.setEnabled(false);
+
+		profiler.getEvents(events);
+		TS_ASSERT_EQUALS(events.size(), 3u);
+		TS_ASSERT_EQUALS(events[2].zone, &outer);
+
+		Common::Array<Common::Profiler::ZoneStats> stats;
+		profiler.getZoneStats(stats, 0);
+		TS_ASSERT_EQUALS(stats.size(), 2u);
+		TS_ASSERT_EQUALS(stats[0].zone, &outer);
+		TS_ASSERT_EQUALS(stats[0].totalTime, 45u);
+		TS_ASSERT_EQUALS(stats[1].count, 2u);
+		TS_ASSERT_EQUALS(stats[1].totalTime, 15u);
+		TS_ASSERT_EQUALS(stats[1].maxTime, 10u);
+
+		// Only events ending after the given time are counted
+		profiler.getZoneStats(stats, 25);
+		TS_ASSERT_EQUALS(stats.size(), 2u);
+		TS_ASSERT_EQUALS(stats[1].count, 1u);
+
+		profiler.clear();
+		events.clear();
+		profiler.getEvents(events);
+		TS_ASSERT(events.empty());
+#endif
+	}
+
+	void test_ring_buffer() {
+#if TEST_PROFILER
+		Common::install_null_g_system();
+		Common::Profiler &profiler = Common::Profiler::instance();
+		profiler.clear();
+
+		const Common::ProfilerZone zone = { "zone", __FILE__, __LINE__ };
+		for (uint i = 0; i < Common::Profiler::kEventsPerThread + 10; i++)
+			profiler.record(zone, i, i + 1);
+
+		// The oldest events have been overwritten
+		Common::Array<Common::Profiler::Event> events;
+		profiler.getEvents(events);
+		TS_ASSERT_EQUALS(events.size(), (uint)Common::Profiler::kEventsPerThread);
+		TS_ASSERT_EQUALS(events[0].start, 10u);
+
+		profiler.clear();
+#endif
+	}
+
+	void test_thread_stats() {
+#if TEST_PROFILER
+		Common::install_null_g_system();
+		Common::Profiler &profiler = Common::Profiler::instance();
+		profiler.clear();
+
+		const Common::ProfilerZone zone = { "zone", __FILE__, __LINE__ };
+		profiler.record(zone, 15, 30);
+		profiler.record(zone, 10, 20);
+		profiler.record(zone, 12, 14);
+		profiler.record(zone, 40, 50);
+
+		// Overlapping zones are counted once
+		Common::Array<Common::Profiler::ThreadStats> stats;
+		profiler.getThreadStats(stats, 0);
+		uint64 busyTime = 0;
+		for (uint i = 0; i < stats.size(); i++)
+			busyTime += stats[i].busyTime;
+		TS_ASSERT_EQUALS(busyTime, 30u);
+
+		// Time before the given one doesn't count
+		profiler.getThreadStats(stats, 25);
+		busyTime = 0;
+		for (uint i = 0; i < stats.size(); i++)
+			busyTime += stats[i].busyTime;
+		TS_ASSERT_EQUALS(busyTime, 15u);
+
+		profiler.clear();
+#endif
+	}
+
+	void test_chrome_trace() {
+#if TEST_PROFILER
+		Common::install_null_g_system();
+		Common::Profiler &profiler = Common::Profiler::instance();
+		profiler.clear();
+
+		const Common::ProfilerZone zone = { "a \"zone\"", "file.cpp", 12 };
+		profiler.record(zone, 100, 250);
+
+		Common::MemoryWriteStreamDynamic stream(DisposeAfterUse::YES);
+		TS_ASSERT(profiler.exportChromeTrace(stream));
+
+		const Common::String json((const char *)stream.getData(), stream.size());
+		TS_ASSERT(json.hasPrefix("{\"traceEvents\":["));
+		TS_ASSERT(json.contains("\"ph\":\"M\""));
+		TS_ASSERT(json.contains("{\"name\":\"a \\\"zone\\\"\",\"ph\":\"X\",\"ts\":100,\"dur\":150,"));
+		TS_ASSERT(json.contains("\"args\":{\"file\":\"file.cpp\",\"line\":12}"));
+
+		profiler.clear();
+#endif
+	}
+};
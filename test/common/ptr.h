@@ -166,6 +166,43 @@ class PtrTestSuite : public CxxTest::TestSuite {
 		TS_ASSERT(a.expired());
 		TS_ASSERT(!a.lock());
 	}
+
+	void test_thread_safe() {
+		TS_ASSERT_EQUALS(InstanceCountingClass::count, 0);
+		{
+			Common::SharedPtr<InstanceCountingClass> p1(new InstanceCountingClass(), Common::kRefCountThreadSafe);
+			TS_ASSERT(p1.isThreadSafe());
+
+			// Copies and casts keep sharing the atomic counts
+			Common::SharedPtr<InstanceCountingClass> p2 = p1;
+			Common::WeakPtr<InstanceCountingClass> w(p1);
+			TS_ASSERT(p2.isThreadSafe());
+			TS_ASSERT_EQUALS(p1.refCount(), 2);
+
+			p1.reset();
+			TS_ASSERT_EQUALS(w.lock().refCount(), 2);
+			TS_ASSERT_EQUALS(InstanceCountingClass::count, 1);
+
+			p2.reset();
+			TS_ASSERT(w.expired());
+			TS_ASSERT(!w.lock());
+			TS_ASSERT_EQUALS(InstanceCountingClass::count, 0);
+		}
+
+		Deleter<int> myDeleter;
+		bool test = false;
+		myDeleter.test = &test;
+		{
+			Common::SharedPtr<int> p(new int(1), myDeleter, Common::kRefCountThreadSafe);
+			TS_ASSERT(p.isThreadSafe());
+		}
+		TS_ASSERT_EQUALS(test, true);
+
+		Common::SharedPtr<int> p(new int(1));
+		TS_ASSERT(!p.isThreadSafe());
+		p.reset(new int(2), Common::kRefCountThreadSafe);
+		TS_ASSERT(p.isThreadSafe());
+	}
 };
 
 int PtrTestSuite::InstanceCountingClass::count = 0;
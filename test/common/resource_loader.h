@@ -0,0 +1,167 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/resource_loader.h"
+#include "../null_osystem.h"
+
+// Job groups rely on OSystem for their mutexes
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define TEST_RESOURCE_LOADER 1
+#else
+#define TEST_RESOURCE_LOADER 0
+#endif
+
+namespace {
+
+/**
+ * Serves resources named after their size, which are filled with their
+ * size's lowest byte, and records the completed requests.
+ */
+struct LoaderLog {
+	Common::String log;
+	int opened;
+
+	LoaderLog() : opened(0) {}
+};
+
+Common::SeekableReadStream *openResource(const Common::Path &path, void *refCon) {
+	LoaderLog *log = (LoaderLog *)refCon;
+	log->opened++;
+
+	const uint size = atoi(path.toString().c_str());
+	if (!size)
+		return nullptr;
+
+	byte *data = (byte *)malloc(size);
+	memset(data, size & 0xFF, size);
+	return new Common::MemoryReadStream(data, size, DisposeAfterUse::YES);
+}
+
+void sumResource(Common::ResourceLoader::Result &result, void *refCon) {
+	uint32 *sum = new uint32(0);
+	for (uint32 i = 0; i < result.size; i++)
+		*sum += result.data[i];
+	result.decoded = sum;
+}
+
+void completeResource(Common::ResourceLoader::Result &result, void *refCon) {
+	LoaderLog *log = (LoaderLog *)refCon;
+
+	static const char *const statuses[] = { "loaded", "failed", "cancelled" };
+	log->log += Common::String::format("%s:%s", result.path.toString().c_str(), statuses[result.status]);
+	if (result.decoded) {
+		log->log += Common::String::format(":%u", *(uint32 *)result.decoded);
+		delete (uint32 *)result.decoded;
+	}
+	log->log += ";";
+}
+
+Common::ResourceLoader::RequestId queue(Common::ResourceLoader &loader, LoaderLog &log, const char *name,
+		Common::ResourceLoader::Priority priority, bool decode = false) {
+	Common::ResourceLoader::Request request(Common::Path(name), priority, completeResource, &log);
+	request.open = openResource;
+	if (decode)
+		request.decode = sumResource;
+	return loader.load(request);
+}
+
+} // End of anonymous namespace
+
+class ResourceLoaderTestSuite : public CxxTest::TestSuite {
+public:
+	void test_priorities() {
+#if TEST_RESOURCE_LOADER
+		Common::install_null_g_system();
+
+		Common::JobSystem jobs;
+		LoaderLog log;
+		Common::ResourceLoader loader(&jobs);
+		loader.setReadBudget(100);
+
+		queue(loader, log, "150", Common::ResourceLoader::kPrioritySpeculative);
+		queue(loader, log, "60", Common::ResourceLoader::kPriorityNextRoom, true);
+		queue(loader, log, "0", Common::ResourceLoader::kPriorityNextRoom);
+		queue(loader, log, "1000", Common::ResourceLoader::kPriorityNow);
+		TS_ASSERT_EQUALS(loader.getPendingCount(), 4u);
+
+		// Urgent requests are read completely, the others within the budget
+		loader.update();
+		TS_ASSERT_EQUALS(log.log, "1000:loaded;60:loaded:3600;0:failed;");
+		TS_ASSERT_EQUALS(loader.getPendingCount(), 1u);
+		TS_ASSERT_EQUALS(loader.getMemoryUsage(), 150u);
+
+		loader.update();
+		TS_ASSERT_EQUALS(loader.getPendingCount(), 1u);
+		loader.update();
+		TS_ASSERT_EQUALS(log.log, "1000:loaded;60:loaded:3600;0:failed;150:loaded;");
+		TS_ASSERT_EQUALS(loader.getPendingCount(), 0u);
+		TS_ASSERT_EQUALS(loader.getMemoryUsage(), 0u);
+#endif
+	}
+
+	void test_memory_budget() {
+#if TEST_RESOURCE_LOADER
+		Common::install_null_g_system();
+
+		Common::JobSystem jobs;
+		LoaderLog log;
+		Common::ResourceLoader loader(&jobs);
+		loader.setMemoryBudget(100);
+
+		queue(loader, log, "80", Common::ResourceLoader::kPriorityNextRoom);
+		queue(loader, log, "50", Common::ResourceLoader::kPriorityNextRoom);
+
+		// The second request waits until the first one has been delivered
+		loader.update();
+		TS_ASSERT_EQUALS(log.log, "80:loaded;");
+		TS_ASSERT_EQUALS(log.opened, 2);
+		TS_ASSERT_EQUALS(loader.getPendingCount(), 1u);
+		TS_ASSERT_EQUALS(loader.getMemoryUsage(), 0u);
+
+		loader.update();
+		TS_ASSERT_EQUALS(log.log, "80:loaded;50:loaded;");
+		TS_ASSERT_EQUALS(loader.getPendingCount(), 0u);
+#endif
+	}
+
+	void test_cancel_and_wait() {
+#if TEST_RESOURCE_LOADER
+		Common::install_null_g_system();
+
+		Common::JobSystem jobs;
+		LoaderLog log;
+		{
+			Common::ResourceLoader loader(&jobs);
+			loader.setReadBudget(10);
+
+			Common::ResourceLoader::RequestId first = queue(loader, log, "20", Common::ResourceLoader::kPrioritySpeculative);
+			Common::ResourceLoader::RequestId second = queue(loader, log, "30", Common::ResourceLoader::kPrioritySpeculative, true);
+			queue(loader, log, "40", Common::ResourceLoader::kPriorityNextRoom);
+			queue(loader, log, "50", Common::ResourceLoader::kPrioritySpeculative);
+
+			// Waiting completes a request right away
+			TS_ASSERT(loader.wait(second));
+			TS_ASSERT(!loader.isPending(second));
+			TS_ASSERT_EQUALS(log.log, "30:loaded:900;");
+
+			// Cancellations are delivered from the next update
+			loader.update();
+			TS_ASSERT(loader.cancel(first));
+			TS_ASSERT(!loader.cancel(second));
+			TS_ASSERT_EQUALS(log.log, "30:loaded:900;");
+			loader.update();
+			TS_ASSERT_EQUALS(log.log, "30:loaded:900;20:cancelled;");
+
+			// A promoted request is read before the others
+			TS_ASSERT(loader.setPriority(loader.load(Common::ResourceLoader::Request()), Common::ResourceLoader::kPriorityNow));
+			loader.cancelAll(Common::ResourceLoader::kPrioritySpeculative);
+			loader.update();
+			TS_ASSERT_EQUALS(log.log, "30:loaded:900;20:cancelled;50:cancelled;");
+			TS_ASSERT_EQUALS(loader.getPendingCount(), 1u);
+		}
+
+		// Destroying the loader cancels the remaining requests
+		TS_ASSERT_EQUALS(log.log, "30:loaded:900;20:cancelled;50:cancelled;40:cancelled;");
+#endif
+	}
+};
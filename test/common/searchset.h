@@ -0,0 +1,80 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+
+namespace {
+
+/** Archive holding a single empty file, which records the prefetch hints it gets. */
+class SingleFileArchive : public Common::Archive {
+public:
+	explicit SingleFileArchive(const char *name) : _name(name) {}
+
+	bool hasFile(const Common::Path &path) const override { return path == _name; }
+	int listMembers(Common::ArchiveMemberList &list) const override { return 0; }
+	const Common::ArchiveMemberPtr getMember(const Common::Path &path) const override { return Common::ArchiveMemberPtr(); }
+
+	Common::SeekableReadStream *createReadStreamForMember(const Common::Path &path) const override {
+		if (!hasFile(path))
+			return nullptr;
+		return new Common::MemoryReadStream(nullptr, 0);
+	}
+
+	void prefetchMembers(const Common::Array<Common::Path> &paths) const override {
+		for (uint i = 0; i < paths.size(); i++)
+			prefetched.push_back(paths[i]);
+	}
+
+	mutable Common::Array<Common::Path> prefetched;
+
+private:
+	Common::Path _name;
+};
+
+} // End of anonymous namespace
+
+class SearchSetTestSuite : public CxxTest::TestSuite {
+public:
+	void test_request_read_stream() {
+		Common::SearchSet set;
+		set.add("a", new SingleFileArchive("a.dat"));
+		set.add("b", new SingleFileArchive("b.dat"));
+
+		Common::ArchiveReadRequest *request = set.requestReadStream("b.dat");
+		TS_ASSERT(request->isReady());
+
+		Common::SeekableReadStream *stream = request->getStream();
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(request->getStream(), (Common::SeekableReadStream *)nullptr);
+		delete stream;
+		delete request;
+
+		request = set.requestReadStream("c.dat");
+		TS_ASSERT_EQUALS(request->getStream(), (Common::SeekableReadStream *)nullptr);
+		delete request;
+	}
+
+	void test_prefetch_routing() {
+		SingleFileArchive *a = new SingleFileArchive("a.dat");
+		SingleFileArchive *b = new SingleFileArchive("b.dat");
+		SingleFileArchive *shadowed = new SingleFileArchive("a.dat");
+
+		Common::SearchSet set;
+		set.add("a", a, 1);
+		set.add("b", b);
+		set.add("shadowed", shadowed);
+
+		Common::Array<Common::Path> paths;
+		paths.push_back("b.dat");
+		paths.push_back("a.dat");
+		paths.push_back("c.dat");
+		set.prefetchMembers(paths);
+
+		// Each name only goes to the archive it would be opened from
+		TS_ASSERT_EQUALS(a->prefetched.size(), 1u);
+		TS_ASSERT_EQUALS(a->prefetched[0], Common::Path("a.dat"));
+		TS_ASSERT_EQUALS(b->prefetched.size(), 1u);
+		TS_ASSERT_EQUALS(b->prefetched[0], Common::Path("b.dat"));
+		TS_ASSERT(shadowed->prefetched.empty());
+	}
+};
@@ -1,5 +1,6 @@
 #include <cxxtest/TestSuite.h>
 
+#include "common/memstream.h"
 #include "common/serializer.h"
 #include "common/stream.h"
 
@@ -108,4 +109,31 @@ public:
 	void test_read_v2_as_v2() {
 		readVersioned_v2(_inStreamV2, 2);
 	}
+
+	void test_sync_array() {
+		const uint16 values[4] = { 0x0102, 0x0304, 0x0506, 0x0708 };
+		uint16 tmp[4];
+
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+		Common::Serializer save(nullptr, &out);
+		memcpy(tmp, values, sizeof(tmp));
+		save.syncArrayLE(tmp, 4);
+		save.syncArrayBE(tmp, 4);
+		// Not synced, as the version is too old
+		save.syncArrayBE(tmp, 4, Common::Serializer::Version(1));
+		TS_ASSERT_EQUALS(save.bytesSynced(), 16u);
+		TS_ASSERT_EQUALS(out.size(), 16);
+		TS_ASSERT_EQUALS(READ_LE_UINT16(out.getData() + 2), 0x0304);
+		TS_ASSERT_EQUALS(READ_BE_UINT16(out.getData() + 10), 0x0304);
+
+		Common::MemoryReadStream in(out.getData(), out.size());
+		Common::Serializer load(&in, nullptr);
+		memset(tmp, 0, sizeof(tmp));
+		load.syncArrayLE(tmp, 4);
+		TS_ASSERT_SAME_DATA(tmp, values, sizeof(tmp));
+		memset(tmp, 0, sizeof(tmp));
+		load.syncArrayBE(tmp, 4);
+		TS_ASSERT_SAME_DATA(tmp, values, sizeof(tmp));
+		TS_ASSERT_EQUALS(load.bytesSynced(), 16u);
+	}
 };
@@ -0,0 +1,113 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/smallarray.h"
+#include "common/str.h"
+
+class SmallArrayTestSuite : public CxxTest::TestSuite {
+	typedef Common::SmallArray<int, 4> IntArray;
+
+public:
+	void test_inline_until_full() {
+		IntArray array;
+		TS_ASSERT(array.empty());
+		TS_ASSERT(array.isInline());
+		TS_ASSERT_EQUALS(array.capacity(), 4u);
+
+		for (int i = 0; i < 4; i++)
+			array.push_back(i);
+		TS_ASSERT(array.isInline());
+
+		array.push_back(4);
+		TS_ASSERT(!array.isInline());
+		TS_ASSERT_EQUALS(array.size(), 5u);
+		for (int i = 0; i < 5; i++)
+			TS_ASSERT_EQUALS(array[i], i);
+
+		array.clear();
+		TS_ASSERT(array.empty());
+		TS_ASSERT(array.isInline());
+	}
+
+	void test_insert_erase() {
+		IntArray array = {1, 3};
+		array.insert_at(1, 2);
+		array.insert(array.begin(), 0);
+		array.insert_at(4, 4);
+
+		TS_ASSERT_EQUALS(array.size(), 5u);
+		for (int i = 0; i < 5; i++)
+			TS_ASSERT_EQUALS(array[i], i);
+
+		TS_ASSERT_EQUALS(array.remove_at(1), 1);
+		TS_ASSERT_EQUALS(*array.erase(array.begin() + 1, array.begin() + 3), 4);
+		TS_ASSERT_EQUALS(array.size(), 2u);
+		TS_ASSERT_EQUALS(array.front(), 0);
+		TS_ASSERT_EQUALS(array.back(), 4);
+
+		array.pop_back();
+		TS_ASSERT_EQUALS(array.size(), 1u);
+	}
+
+	void test_insert_self_reference() {
+		IntArray array = {1, 2, 3, 4};
+		// Inserting an element of the array while it moves to the heap
+		array.insert_at(0, array[3]);
+		TS_ASSERT_EQUALS(array[0], 4);
+		TS_ASSERT_EQUALS(array[4], 4);
+
+		array.push_back(array[1]);
+		TS_ASSERT_EQUALS(array.back(), 1);
+	}
+
+	void test_copy_move() {
+		typedef Common::SmallArray<Common::String, 2> StringArray;
+
+		StringArray small;
+		small.push_back("a string long enough for the heap");
+		StringArray big = {"one", "two", "three"};
+
+		StringArray copy(small);
+		TS_ASSERT(copy == small);
+		copy = big;
+		TS_ASSERT(copy == big);
+		TS_ASSERT(copy != small);
+
+		// Inline elements are moved one by one
+		StringArray movedSmall(Common::move(small));
+		TS_ASSERT(small.empty());
+		TS_ASSERT(movedSmall.isInline());
+		TS_ASSERT_EQUALS(movedSmall[0], "a string long enough for the heap");
+
+		// Heap storage is taken over
+		const Common::String *data = big.data();
+		StringArray movedBig;
+		movedBig = Common::move(big);
+		TS_ASSERT(big.empty());
+		TS_ASSERT(big.isInline());
+		TS_ASSERT_EQUALS(movedBig.data(), data);
+		TS_ASSERT_EQUALS(movedBig[2], "three");
+
+		movedSmall.swap(movedBig);
+		TS_ASSERT_EQUALS(movedSmall.size(), 3u);
+		TS_ASSERT_EQUALS(movedBig.size(), 1u);
+		TS_ASSERT_EQUALS(movedBig[0], "a string long enough for the heap");
+	}
+
+	void test_resize() {
+		IntArray array(2, 7);
+		array.resize(6);
+		TS_ASSERT_EQUALS(array.size(), 6u);
+		TS_ASSERT_EQUALS(array[1], 7);
+		TS_ASSERT_EQUALS(array[5], 0);
+
+		array.resize(1);
+		TS_ASSERT_EQUALS(array.size(), 1u);
+		TS_ASSERT_EQUALS(array[0], 7);
+		// Shrinking keeps the heap storage
+		TS_ASSERT(!array.isInline());
+
+		array.reserve(100);
+		TS_ASSERT(array.capacity() >= 100u);
+		TS_ASSERT_EQUALS(array[0], 7);
+	}
+};
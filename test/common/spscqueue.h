@@ -0,0 +1,45 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/spscqueue.h"
+
+class SPSCQueueTestSuite : public CxxTest::TestSuite {
+public:
+	void test_push_pop() {
+		Common::SPSCQueue<int, 4> queue;
+		TS_ASSERT(queue.empty());
+		TS_ASSERT_EQUALS(queue.capacity(), 4u);
+
+		TS_ASSERT(queue.push(1));
+		TS_ASSERT(queue.push(2));
+		TS_ASSERT(!queue.empty());
+		TS_ASSERT_EQUALS(queue.size(), 2u);
+
+		int value = 0;
+		TS_ASSERT(queue.pop(value));
+		TS_ASSERT_EQUALS(value, 1);
+		TS_ASSERT(queue.pop(value));
+		TS_ASSERT_EQUALS(value, 2);
+		TS_ASSERT(!queue.pop(value));
+		TS_ASSERT(queue.empty());
+	}
+
+	void test_full_wrap() {
+		Common::SPSCQueue<int, 4> queue;
+
+		// Go around the ring a few times
+		int next = 0, expected = 0;
+		for (int round = 0; round < 5; round++) {
+			while (queue.push(next))
+				next++;
+			TS_ASSERT_EQUALS(queue.size(), 4u);
+
+			int value;
+			for (int i = 0; i < 3; i++) {
+				TS_ASSERT(queue.pop(value));
+				TS_ASSERT_EQUALS(value, expected++);
+			}
+		}
+
+		TS_ASSERT_EQUALS(queue.size(), 1u);
+	}
+};
@@ -0,0 +1,102 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/str-builder.h"
+
+class StringBuilderTestSuite : public CxxTest::TestSuite {
+public:
+	void test_append() {
+		Common::StringBuilder sb;
+		TS_ASSERT(sb.empty());
+		TS_ASSERT_EQUALS(Common::String(sb.c_str()), "");
+
+		sb.append("Hello").append(',').append(Common::String(" world"));
+		sb.append("!!!", 1);
+		TS_ASSERT_EQUALS(sb.toString(), "Hello, world!");
+		TS_ASSERT_EQUALS(sb.size(), 13u);
+
+		sb.clear();
+		TS_ASSERT(sb.empty());
+		TS_ASSERT_EQUALS(sb.toString(), "");
+	}
+
+	void test_grow() {
+		Common::StringBuilder sb;
+		Common::String expected;
+		for (int i = 0; i < 200; i++) {
+			sb.append("text ");
+			expected += "text ";
+		}
+		TS_ASSERT_EQUALS(sb.toString(), expected);
+		TS_ASSERT_EQUALS(sb.size(), 1000u);
+	}
+
+	void test_integers() {
+		Common::StringBuilder sb;
+
+		const int64 values[] = { 0, 7, -7, 42, -12345, 2147483647, -2147483647 - 1 };
+		for (int i = 0; i < ARRAYSIZE(values); i++) {
+			sb.clear();
+			sb.appendInt(values[i]);
+			TS_ASSERT_EQUALS(sb.toString(), Common::String::format("%d", (int)values[i]));
+
+			sb.clear();
+			sb.appendInt(values[i], 6);
+			TS_ASSERT_EQUALS(sb.toString(), Common::String::format("%6d", (int)values[i]));
+
+			sb.clear();
+			sb.appendInt(values[i], 6, '0');
+			TS_ASSERT_EQUALS(sb.toString(), Common::String::format("%06d", (int)values[i]));
+		}
+
+		sb.clear();
+		sb.appendInt(-0x7FFFFFFFFFFFFFFFLL - 1);
+		TS_ASSERT_EQUALS(sb.toString(), "-9223372036854775808");
+
+		sb.clear();
+		sb.appendUint(0xFFFFFFFFFFFFFFFFULL);
+		TS_ASSERT_EQUALS(sb.toString(), "18446744073709551615");
+
+		sb.clear();
+		sb.appendUint(5, 3, '0').append(' ').appendUint(5, 3);
+		TS_ASSERT_EQUALS(sb.toString(), "005   5");
+
+		sb.clear();
+		sb.appendHex(0).append(' ').appendHex(0xBEEF).append(' ').appendHex(0xBEEF, 8, true);
+		TS_ASSERT_EQUALS(sb.toString(), "0 beef 0000BEEF");
+	}
+
+	void test_floats() {
+		Common::StringBuilder sb;
+
+		const double values[] = { 0.0, 1.0, -1.0, 3.14159265, -2.71828, 0.0001, 1234567.875, -0.004 };
+		for (int i = 0; i < ARRAYSIZE(values); i++) {
+			for (uint precision = 0; precision < 5; precision++) {
+				sb.clear();
+				sb.appendFloat(values[i], precision);
+				TS_ASSERT_EQUALS(sb.toString(), Common::String::format("%.*f", (int)precision, values[i]));
+			}
+
+			sb.clear();
+			sb.appendFloat(values[i]);
+			TS_ASSERT_EQUALS(sb.toString(), Common::String::format("%f", values[i]));
+		}
+
+		// Through vsnprintf()
+		sb.clear();
+		sb.appendFloat(1.0e30, 2);
+		TS_ASSERT_EQUALS(sb.toString(), Common::String::format("%.2f", 1.0e30));
+	}
+
+	void test_format() {
+		Common::StringBuilder sb;
+		sb.append("Score: ").appendFormat("%s %d", "points", 12);
+		TS_ASSERT_EQUALS(sb.toString(), "Score: points 12");
+
+		// Longer than what is left of the inline buffer
+		Common::String longText('x');
+		for (int i = 0; i < 9; i++)
+			longText += longText;
+		sb.appendFormat("[%s]", longText.c_str());
+		TS_ASSERT_EQUALS(sb.toString(), "Score: points 12[" + longText + "]");
+	}
+};
@@ -390,6 +390,33 @@ class StringTestSuite : public CxxTest::TestSuite
 		TS_ASSERT_EQUALS(s.size(), 7U);
 	}
 
+	void test_string_formatTo() {
+		Common::String s = Common::String::format("Some %s to make this string longer than the default built-in %s", "text", "capacity");
+		const char *storage = s.c_str();
+
+		// The storage is reused while the text fits
+		Common::String::formatTo(s, "%s %d", "score", 42);
+		TS_ASSERT_EQUALS(s, "score 42");
+		TS_ASSERT_EQUALS(s.c_str(), storage);
+
+		Common::String::formatTo(s, "Some %s to make this string even longer than the previous capacity, %d", "more text", 123456);
+		TS_ASSERT_EQUALS(s, "Some more text to make this string even longer than the previous capacity, 123456");
+
+		// A shared storage is left alone
+		Common::String copy(s);
+		Common::String::formatTo(s, "%d", 7);
+		TS_ASSERT_EQUALS(s, "7");
+		TS_ASSERT_EQUALS(copy, "Some more text to make this string even longer than the previous capacity, 123456");
+
+		// The arguments may point into the output
+		Common::String::formatTo(copy, "%s, %s", copy.c_str() + 5, "again");
+		TS_ASSERT_EQUALS(copy, "more text to make this string even longer than the previous capacity, 123456, again");
+		Common::String::formatTo(s, "%s%s%s%s", copy.c_str(), copy.c_str(), copy.c_str(), copy.c_str());
+		Common::String::formatTo(s, "%s%s", s.c_str(), s.c_str());
+		TS_ASSERT_EQUALS(s.size(), copy.size() * 8);
+		TS_ASSERT(s.hasPrefix(copy + copy));
+	}
+
 	void test_ustring_printf() {
 		//Ideally should be the same as above (make String template?)
 		TS_ASSERT_EQUALS( Common::U32String::format(" ").encode(), " " );
@@ -43,4 +43,49 @@ class ReadLineStreamTestSuite : public CxxTest::TestSuite {
 
 		TS_ASSERT(ms.eos());
 	}
+
+	void test_read_array() {
+		byte contents[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09 };
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+
+		uint16 le[2];
+		TS_ASSERT_EQUALS(ms.readArrayLE(le, 2), 2u);
+		TS_ASSERT_EQUALS(le[0], 0x0201);
+		TS_ASSERT_EQUALS(le[1], 0x0403);
+
+		ms.seek(0);
+		uint32 be[2];
+		TS_ASSERT_EQUALS(ms.readArrayBE(be, 2), 2u);
+		TS_ASSERT_EQUALS(be[0], 0x01020304u);
+		TS_ASSERT_EQUALS(be[1], 0x05060708u);
+
+		// Only complete elements are counted
+		ms.seek(4);
+		int16 partial[3];
+		TS_ASSERT_EQUALS(ms.readArrayBE(partial, 3), 2u);
+		TS_ASSERT_EQUALS(partial[0], 0x0506);
+		TS_ASSERT_EQUALS(partial[1], 0x0708);
+		TS_ASSERT(ms.eos());
+	}
+
+	void test_write_array() {
+		// More than the chunks in which the bytes are swapped
+		uint32 values[300];
+		for (uint32 i = 0; i < ARRAYSIZE(values); i++)
+			values[i] = i * 0x01010101;
+
+		Common::MemoryWriteStreamDynamic ws(DisposeAfterUse::YES);
+		TS_ASSERT_EQUALS(ws.writeArrayLE(values, ARRAYSIZE(values)), 300u);
+		TS_ASSERT_EQUALS(ws.writeArrayBE(values, ARRAYSIZE(values)), 300u);
+		TS_ASSERT_EQUALS(ws.size(), (int64)(2 * sizeof(values)));
+
+		const byte *data = ws.getData();
+		for (uint32 i = 0; i < ARRAYSIZE(values); i++) {
+			TS_ASSERT_EQUALS(READ_LE_UINT32(data + i * 4), values[i]);
+			TS_ASSERT_EQUALS(READ_BE_UINT32(data + sizeof(values) + i * 4), values[i]);
+		}
+
+		// The values written are left unchanged
+		TS_ASSERT_EQUALS(values[299], 299u * 0x01010101);
+	}
 };
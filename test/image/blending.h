@@ -39,6 +39,7 @@
 #include "common/rect.h"
 #include "common/textconsole.h"
 #include "graphics/blit.h"
+#include "graphics/blit_batch.h"
 #include "graphics/primitives.h"
 #include "graphics/transform_tools.h"
 
@@ -817,6 +818,11 @@ public:
 		if (instrset_detect() >= 8) {
 			Graphics::BlendBlit::blitFunc = Graphics::BlendBlit::blitAVX2;
 		}
+#endif
+#ifdef SCUMMVM_AVX512
+		if (instrset_detect() >= 10) {
+			Graphics::BlendBlit::blitFunc = Graphics::BlendBlit::blitAVX512;
+		}
 #endif
 		Graphics::ManagedSurface baseSurface, destSurface;
 		baseSurface.create(103, 103, OldTransparentSurface::OldTransparentSurface::getSupportedPixelFormat());
@@ -1024,4 +1030,51 @@ public:
 		(void)areSurfacesEqual;
 #endif
 	}
+
+	void test_blit_batch() {
+		// Avoid querying the CPU features from OSystem
+		Graphics::BlendBlit::BlitFunc oldFunc = Graphics::BlendBlit::blitFunc;
+		Graphics::BlendBlit::blitFunc = Graphics::BlendBlit::blitGeneric;
+
+		const Graphics::PixelFormat format = Graphics::BlendBlit::getSupportedPixelFormat();
+		Graphics::ManagedSurface spriteA, spriteB, sequential, batched;
+		spriteA.create(8, 8, format);
+		spriteB.create(6, 10, format);
+		sequential.create(32, 32, format);
+		batched.create(32, 32, format);
+		for (int y = 0; y < 10; y++) {
+			for (int x = 0; x < 8; x++) {
+				if (y < 8)
+					spriteA.setPixel(x, y, MS_ARGB(x * 32, 255, y * 32, 0));
+				if (x < 6)
+					spriteB.setPixel(x, y, MS_ARGB(128, 0, x * 40, y * 25));
+			}
+		}
+
+		// A and B overlap in the middle, so the last A can't join the first
+		Graphics::BlitBatch batch;
+		batch.add(spriteA, Common::Point(0, 0));
+		batch.add(spriteB, Common::Rect(4, 4, 16, 14), nullptr, MS_ARGB(255, 255, 128, 255), Graphics::FLIP_H);
+		batch.add(spriteA, Common::Point(20, 20), MS_ARGB(128, 255, 255, 255), Graphics::FLIP_NONE, Graphics::BLEND_ADDITIVE);
+		batch.add(spriteA, Common::Point(6, 6), MS_ARGB(255, 255, 255, 255), Graphics::FLIP_V);
+		batch.add(spriteB, Common::Point(28, -4));
+		// Invisible, alpha is zero
+		batch.add(spriteB, Common::Point(0, 0), MS_ARGB(0, 255, 255, 255));
+		TS_ASSERT_EQUALS(batch.size(), 5u);
+
+		sequential.clear(MS_ARGB(255, 20, 40, 60));
+		batched.clear(MS_ARGB(255, 20, 40, 60));
+
+		spriteA.blendBlitTo(sequential, 0, 0);
+		spriteB.blendBlitTo(sequential, 4, 4, Graphics::FLIP_H, nullptr, MS_ARGB(255, 255, 128, 255), 12, 10);
+		spriteA.blendBlitTo(sequential, 20, 20, Graphics::FLIP_NONE, nullptr, MS_ARGB(128, 255, 255, 255), -1, -1, Graphics::BLEND_ADDITIVE);
+		spriteA.blendBlitTo(sequential, 6, 6, Graphics::FLIP_V);
+		spriteB.blendBlitTo(sequential, 28, -4);
+
+		const Common::Rect drawn = batch.blitTo(batched);
+		TS_ASSERT_EQUALS(drawn, Common::Rect(0, 0, 32, 28));
+		TS_ASSERT(areSurfacesEqual(&sequential, &batched));
+
+		Graphics::BlendBlit::blitFunc = oldFunc;
+	}
 };
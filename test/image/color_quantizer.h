@@ -0,0 +1,88 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/color_quantizer.h"
+#include "graphics/palette.h"
+#include "graphics/surface.h"
+
+class ColorQuantizerTestSuite : public CxxTest::TestSuite {
+	static const Graphics::PixelFormat format() {
+		return Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0);
+	}
+
+public:
+	void test_surface() {
+		Graphics::Surface surface;
+		surface.create(16, 4, format());
+
+		// Rows of runs of a few colors
+		const uint32 red = format().RGBToColor(240, 16, 16);
+		const uint32 green = format().RGBToColor(16, 240, 16);
+		const uint32 blue = format().RGBToColor(16, 16, 240);
+		for (int y = 0; y < surface.h; y++) {
+			for (int x = 0; x < surface.w; x++)
+				surface.setPixel(x, y, x < 5 ? red : (x < 12 ? green : blue));
+		}
+
+		Graphics::ColorQuantizer quantizer(4);
+		quantizer.addSurface(surface);
+
+		Graphics::Palette *palette = quantizer.getPalette();
+		TS_ASSERT_EQUALS(palette->size(), 4u);
+
+		Graphics::Surface *converted = quantizer.convertSurface(surface);
+		TS_ASSERT_EQUALS(converted->format, Graphics::PixelFormat::createFormatCLUT8());
+
+		// Each color is kept exactly, and mapped to its entry
+		for (int y = 0; y < surface.h; y++) {
+			for (int x = 0; x < surface.w; x++) {
+				byte r, g, b;
+				palette->get(converted->getPixel(x, y), r, g, b);
+				TS_ASSERT_EQUALS(format().RGBToColor(r, g, b), surface.getPixel(x, y));
+			}
+		}
+
+		// Colors which weren't added map to the closest entry, never to
+		// one of the unused black entries
+		byte r, g, b;
+		palette->get(quantizer.findBestColor(0, 0, 0), r, g, b);
+		TS_ASSERT(r != 0 || g != 0 || b != 0);
+		TS_ASSERT_EQUALS(quantizer.findBestColor(200, 40, 30), quantizer.findBestColor(240, 16, 16));
+
+		converted->free();
+		delete converted;
+		delete palette;
+		surface.free();
+	}
+
+	void test_reduction() {
+		// Runs weigh as much as the pixels they are made of when colors
+		// are merged
+		Graphics::ColorQuantizer single(2), runs(2);
+		for (int i = 0; i < 10; i++)
+			single.addColor(0, 0, 0);
+		single.addColor(40, 40, 40);
+		single.addColor(255, 255, 255);
+
+		Graphics::Surface surface;
+		surface.create(12, 1, format());
+		for (int x = 0; x < 10; x++)
+			surface.setPixel(x, 0, format().RGBToColor(0, 0, 0));
+		surface.setPixel(10, 0, format().RGBToColor(40, 40, 40));
+		surface.setPixel(11, 0, format().RGBToColor(255, 255, 255));
+		runs.addSurface(surface);
+		surface.free();
+
+		Graphics::Palette *singlePalette = single.getPalette();
+		Graphics::Palette *runsPalette = runs.getPalette();
+		TS_ASSERT(*singlePalette == *runsPalette);
+
+		byte r, g, b;
+		runsPalette->get(runs.findBestColor(0, 0, 0), r, g, b);
+		TS_ASSERT_EQUALS(r, 3);
+		runsPalette->get(runs.findBestColor(255, 255, 255), r, g, b);
+		TS_ASSERT_EQUALS(r, 255);
+
+		delete singlePalette;
+		delete runsPalette;
+	}
+};
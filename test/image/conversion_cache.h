@@ -0,0 +1,51 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/managed_surface.h"
+
+class ConversionCacheTestSuite : public CxxTest::TestSuite {
+public:
+	void test_converted_copies() {
+		const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		const Graphics::PixelFormat rgba(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		const byte colors[] = { 0, 0, 0, 255, 0, 0, 0, 255, 0 };
+
+		Graphics::ManagedSurface sprite(4, 2);
+		sprite.setPalette(colors, 0, 3);
+		sprite.clear(1);
+		sprite.setTransparentColor(0);
+
+		TS_ASSERT_EQUALS(sprite.getConverted(sprite.format), &sprite);
+		TS_ASSERT(!sprite.getConverted(rgba));
+
+		sprite.setConversionCacheEnabled(true);
+		const Graphics::ManagedSurface *converted = sprite.getConverted(rgb565);
+		TS_ASSERT(converted);
+		TS_ASSERT_EQUALS(converted->format, rgb565);
+		TS_ASSERT_EQUALS(converted->getPixel(2, 1), rgb565.RGBToColor(255, 0, 0));
+		TS_ASSERT_EQUALS(converted->getTransparentColor(), rgb565.RGBToColor(0, 0, 0));
+
+		// Nothing changed, so the same copy is handed out
+		TS_ASSERT_EQUALS(sprite.getConverted(rgb565), converted);
+
+		// The color key becomes transparent with alpha
+		const Graphics::ManagedSurface *withAlpha = sprite.getConverted(rgba);
+		sprite.setPixel(1, 0, 0);
+		TS_ASSERT_EQUALS(sprite.getConverted(rgba), withAlpha);
+		TS_ASSERT_EQUALS(withAlpha->getPixel(1, 0), rgba.ARGBToColor(0, 0, 0, 0));
+		TS_ASSERT(!withAlpha->hasTransparentColor());
+
+		// Drawing and palette changes update the copies
+		sprite.fillRect(Common::Rect(0, 0, 2, 2), 2);
+		TS_ASSERT_EQUALS(sprite.getConverted(rgb565)->getPixel(0, 1), rgb565.RGBToColor(0, 255, 0));
+		sprite.setPalette(colors, 2, 1);
+		TS_ASSERT_EQUALS(sprite.getConverted(rgb565)->getPixel(0, 1), rgb565.RGBToColor(0, 0, 0));
+
+		// So do writes through sub-surfaces
+		Graphics::ManagedSurface area(sprite, Common::Rect(2, 0, 4, 2));
+		area.fillRect(Common::Rect(0, 0, 1, 1), 1);
+		TS_ASSERT_EQUALS(sprite.getConverted(rgb565)->getPixel(2, 0), rgb565.RGBToColor(255, 0, 0));
+
+		sprite.setConversionCacheEnabled(false);
+		TS_ASSERT(!sprite.getConverted(rgb565));
+	}
+};
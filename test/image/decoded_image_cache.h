@@ -0,0 +1,78 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/decoded_image_cache.h"
+#include "graphics/managed_surface.h"
+
+#include "../null_osystem.h"
+
+// The cache relies on OSystem for its mutex
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define TEST_IMAGE_CACHE 1
+#else
+#define TEST_IMAGE_CACHE 0
+#endif
+
+class DecodedImageCacheTestSuite : public CxxTest::TestSuite {
+	static Graphics::ManagedSurface *createImage(int w, int h, byte color) {
+		Graphics::ManagedSurface *image = new Graphics::ManagedSurface(w, h, Graphics::PixelFormat::createFormatCLUT8());
+		image->clear(color);
+		return image;
+	}
+
+public:
+	void test_store_and_lookup() {
+#if TEST_IMAGE_CACHE
+		Common::install_null_g_system();
+
+		Graphics::DecodedImageCache cache(64 * 1024);
+		const Graphics::DecodedImageCache::Key key("scene.cxt", 0x1234, 1);
+
+		TS_ASSERT(!cache.get(key));
+
+		Graphics::DecodedImageCache::ImagePtr stored = cache.store(key, createImage(64, 32, 7));
+		TS_ASSERT(stored);
+		TS_ASSERT_EQUALS(cache.getSize(), (uint32)(stored->pitch * 32));
+
+		Graphics::DecodedImageCache::ImagePtr cached = cache.get(key);
+		TS_ASSERT_EQUALS(cached.get(), stored.get());
+
+		// Different formats of the same data are separate images
+		TS_ASSERT(!cache.get(Graphics::DecodedImageCache::Key("scene.cxt", 0x1234, 2)));
+
+		// Handles stay valid after their image has been dropped
+		cache.remove(key);
+		TS_ASSERT_EQUALS(cache.getSize(), 0u);
+		TS_ASSERT(!cache.get(key));
+		TS_ASSERT_EQUALS(cached->w, 64);
+		TS_ASSERT_EQUALS(*(const byte *)cached->getBasePtr(63, 31), 7);
+#endif
+	}
+
+	void test_budget() {
+#if TEST_IMAGE_CACHE
+		Common::install_null_g_system();
+
+		Graphics::DecodedImageCache cache(3 * 64 * 64);
+		for (uint32 i = 0; i < 3; ++i)
+			cache.store(Graphics::DecodedImageCache::Key("sprites.bin", i), createImage(64, 64, i));
+		TS_ASSERT_EQUALS(cache.getSize(), 3u * 64 * 64);
+
+		// The least recently used image is dropped first
+		cache.get(Graphics::DecodedImageCache::Key("sprites.bin", 0));
+		cache.store(Graphics::DecodedImageCache::Key("sprites.bin", 3), createImage(64, 64, 3));
+		TS_ASSERT_EQUALS(cache.getSize(), 3u * 64 * 64);
+		TS_ASSERT(cache.get(Graphics::DecodedImageCache::Key("sprites.bin", 0)));
+		TS_ASSERT(!cache.get(Graphics::DecodedImageCache::Key("sprites.bin", 1)));
+		TS_ASSERT(cache.get(Graphics::DecodedImageCache::Key("sprites.bin", 2)));
+
+		// Images larger than the budget are returned, but not kept
+		Graphics::DecodedImageCache::ImagePtr large = cache.store(Graphics::DecodedImageCache::Key("sprites.bin", 4), createImage(256, 64, 4));
+		TS_ASSERT(large);
+		TS_ASSERT(!cache.get(Graphics::DecodedImageCache::Key("sprites.bin", 4)));
+		TS_ASSERT_EQUALS(cache.getSize(), 3u * 64 * 64);
+
+		cache.clear();
+		TS_ASSERT_EQUALS(cache.getSize(), 0u);
+#endif
+	}
+};
@@ -0,0 +1,56 @@
+#include <cxxtest/TestSuite.h>
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "image/codecs/indeo/indeo_dsp.h"
+
+class IndeoDSPTestSuite : public CxxTest::TestSuite {
+#ifdef USE_INDEO45
+	static void checkInverseSlant8x8(Image::Indeo::InvTransformPtr *transform) {
+		const uint8 flagSets[][8] = {
+			{ 1, 1, 1, 1, 1, 1, 1, 1 },
+			{ 1, 0, 1, 0, 0, 1, 1, 0 },
+			{ 0, 0, 0, 0, 0, 0, 0, 0 }
+		};
+
+		uint32 seed = 1;
+		for (int test = 0; test < 64; test++) {
+			int32 in[64];
+			for (int i = 0; i < 64; i++) {
+				seed = seed * 1103515245 + 12345;
+				// Mostly small coefficients, with a few large enough to wrap
+				in[i] = (test & 1) ? (int32)(seed >> 8) : (int32)((seed >> 16) & 0x3FF) - 0x200;
+				// Leave some rows empty
+				if ((test & 2) && (i / 8) == (test / 4) % 8)
+					in[i] = 0;
+			}
+
+			const uint8 *flags = flagSets[test % ARRAYSIZE(flagSets)];
+
+			// Leave padding to catch writes beyond the block
+			int16 expected[8 * 10], actual[8 * 10];
+			memset(expected, 0x55, sizeof(expected));
+			memset(actual, 0x55, sizeof(actual));
+
+			Image::Indeo::IndeoDSP::ffIviInverseSlant8x8Generic(in, expected, 10, flags);
+			transform(in, actual, 10, flags);
+
+			TS_ASSERT_SAME_DATA(expected, actual, sizeof(actual));
+		}
+	}
+#endif
+
+public:
+	void test_inverse_slant_8x8_simd() {
+#ifdef USE_INDEO45
+#ifdef SCUMMVM_NEON
+		checkInverseSlant8x8(Image::Indeo::IndeoDSP::ffIviInverseSlant8x8NEON);
+#endif
+#ifdef SCUMMVM_SSE2
+		checkInverseSlant8x8(Image::Indeo::IndeoDSP::ffIviInverseSlant8x8SSE2);
+#endif
+#endif
+	}
+};
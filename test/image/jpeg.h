@@ -0,0 +1,98 @@
+#include <cxxtest/TestSuite.h>
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "common/memstream.h"
+#include "image/jpeg.h"
+#include "graphics/surface.h"
+
+class JPEGDecoderTestSuite : public CxxTest::TestSuite {
+#ifdef USE_JPEG
+	// 16x16 gradient
+	static const byte *getImage(uint &size) {
+		static const byte jpegBuf[] = {
+			0xff, 0xd8, 0xff, 0xe0, 0x00, 0x10, 0x4a, 0x46, 0x49, 0x46, 0x00,
+			0x01, 0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xff, 0xdb,
+			0x00, 0x43, 0x00, 0x10, 0x0b, 0x0c, 0x0e, 0x0c, 0x0a, 0x10, 0x0e,
+			0x0d, 0x0e, 0x12, 0x11, 0x10, 0x13, 0x18, 0x28, 0x1a, 0x18, 0x16,
+			0x16, 0x18, 0x31, 0x23, 0x25, 0x1d, 0x28, 0x3a, 0x33, 0x3d, 0x3c,
+			0x39, 0x33, 0x38, 0x37, 0x40, 0x48, 0x5c, 0x4e, 0x40, 0x44, 0x57,
+			0x45, 0x37, 0x38, 0x50, 0x6d, 0x51, 0x57, 0x5f, 0x62, 0x67, 0x68,
+			0x67, 0x3e, 0x4d, 0x71, 0x79, 0x70, 0x64, 0x78, 0x5c, 0x65, 0x67,
+			0x63, 0xff, 0xdb, 0x00, 0x43, 0x01, 0x11, 0x12, 0x12, 0x18, 0x15,
+			0x18, 0x2f, 0x1a, 0x1a, 0x2f, 0x63, 0x42, 0x38, 0x42, 0x63, 0x63,
+			0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63,
+			0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63,
+			0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63,
+			0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63,
+			0x63, 0x63, 0x63, 0x63, 0xff, 0xc0, 0x00, 0x11, 0x08, 0x00, 0x10,
+			0x00, 0x10, 0x03, 0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11,
+			0x01, 0xff, 0xc4, 0x00, 0x15, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x05, 0x06, 0xff, 0xc4, 0x00, 0x17, 0x10, 0x01, 0x00, 0x03, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x04, 0x00, 0x21, 0x31, 0xff, 0xc4, 0x00, 0x15, 0x01, 0x01,
+			0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0xc4, 0x00, 0x19, 0x11,
+			0x00, 0x02, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x03, 0x05, 0x21, 0x31,
+			0xff, 0xda, 0x00, 0x0c, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11,
+			0x00, 0x3f, 0x00, 0x9f, 0x38, 0x72, 0xa2, 0x67, 0x0e, 0x54, 0x4c,
+			0xe1, 0xca, 0x89, 0x9c, 0x39, 0x52, 0xa5, 0x6c, 0x57, 0xbd, 0xcd,
+			0x3f, 0xff, 0xd9
+		};
+
+		size = sizeof(jpegBuf);
+		return jpegBuf;
+	}
+#endif
+
+public:
+	void test_scaled_output() {
+#ifdef USE_JPEG
+		uint size;
+		const byte *jpegBuf = getImage(size);
+		Image::JPEGDecoder decoder;
+
+		const uint scales[] = { 1, 2, 4, 8 };
+		for (int i = 0; i < ARRAYSIZE(scales); i++) {
+			Common::MemoryReadStream stream(jpegBuf, size);
+			decoder.setOutputScale(scales[i]);
+			TS_ASSERT(decoder.loadStream(stream));
+
+			const Graphics::Surface *surface = decoder.getSurface();
+			TS_ASSERT_EQUALS(surface->w, (int16)(16 / scales[i]));
+			TS_ASSERT_EQUALS(surface->h, (int16)(16 / scales[i]));
+		}
+#endif
+	}
+
+	void test_direct_output() {
+#ifdef USE_JPEG
+		uint size;
+		const byte *jpegBuf = getImage(size);
+		Image::JPEGDecoder decoder;
+
+		// Converting afterwards must give the same result as decoding
+		// straight into the requested format
+		Common::MemoryReadStream rgbStream(jpegBuf, size);
+		TS_ASSERT(decoder.loadStream(rgbStream));
+		const Graphics::PixelFormat format(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		Graphics::Surface *expected = decoder.getSurface()->convertTo(format);
+
+		Common::MemoryReadStream stream(jpegBuf, size);
+		decoder.setOutputPixelFormat(format);
+		TS_ASSERT(decoder.loadStream(stream));
+
+		const Graphics::Surface *surface = decoder.getSurface();
+		TS_ASSERT_EQUALS(surface->format, format);
+		for (int y = 0; y < 16; y++)
+			TS_ASSERT_SAME_DATA(surface->getBasePtr(0, y), expected->getBasePtr(0, y), 16 * 2);
+
+		expected->free();
+		delete expected;
+#endif
+	}
+};
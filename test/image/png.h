@@ -0,0 +1,117 @@
+#include <cxxtest/TestSuite.h>
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "common/memstream.h"
+#include "image/png.h"
+#include "graphics/surface.h"
+
+class PNGDecoderTestSuite : public CxxTest::TestSuite {
+#ifdef USE_PNG
+	// 4x3 RGBA gradient
+	static const byte *getImage(uint &size) {
+		static const byte pngBuf[] = {
+			0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00,
+			0x0d, 0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00,
+			0x00, 0x03, 0x08, 0x06, 0x00, 0x00, 0x00, 0xb4, 0xf4, 0xae, 0xc6,
+			0x00, 0x00, 0x00, 0x1a, 0x49, 0x44, 0x41, 0x54, 0x08, 0xd7, 0x63,
+			0x64, 0x60, 0x38, 0xf1, 0x3f, 0x80, 0x81, 0xe1, 0x08, 0x0c, 0xb3,
+			0x30, 0x54, 0x30, 0xa0, 0x00, 0x0c, 0x01, 0x00, 0xec, 0x7f, 0x05,
+			0xfd, 0x14, 0xf6, 0xed, 0xb9, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45,
+			0x4e, 0x44, 0xae, 0x42, 0x60, 0x82
+		};
+
+		size = sizeof(pngBuf);
+		return pngBuf;
+	}
+
+	static void countRow(const Graphics::Surface &surface, uint y, void *refCon) {
+		uint *rows = (uint *)refCon;
+		// Rows are completed in order
+		TS_ASSERT_EQUALS(y, *rows);
+		(*rows)++;
+	}
+#endif
+
+public:
+	void test_output_format() {
+#ifdef USE_PNG
+		uint size;
+		const byte *pngBuf = getImage(size);
+
+		Image::PNGDecoder reference;
+		Common::MemoryReadStream referenceStream(pngBuf, size);
+		TS_ASSERT(reference.loadStream(referenceStream));
+
+		// Both formats libpng can output and ones which need converting
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24),
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 4, 4, 4, 4, 8, 4, 0, 12)
+		};
+
+		for (int i = 0; i < ARRAYSIZE(formats); i++) {
+			Graphics::Surface *expected = reference.getSurface()->convertTo(formats[i]);
+
+			Image::PNGDecoder decoder;
+			TS_ASSERT(decoder.setOutputPixelFormat(formats[i]));
+			Common::MemoryReadStream stream(pngBuf, size);
+			TS_ASSERT(decoder.loadStream(stream));
+
+			const Graphics::Surface *surface = decoder.getSurface();
+			TS_ASSERT_EQUALS(surface->format, formats[i]);
+			for (int y = 0; y < 3; y++)
+				TS_ASSERT_SAME_DATA(surface->getBasePtr(0, y), expected->getBasePtr(0, y), 4 * formats[i].bytesPerPixel);
+
+			expected->free();
+			delete expected;
+		}
+#endif
+	}
+
+	void test_output_surface() {
+#ifdef USE_PNG
+		uint size;
+		const byte *pngBuf = getImage(size);
+
+		const Graphics::PixelFormat format(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		Graphics::Surface dest;
+		dest.create(6, 5, format);
+		dest.fillRect(Common::Rect(6, 5), 0x1234);
+
+		Image::PNGDecoder decoder;
+		uint rows = 0;
+		decoder.setOutputSurface(&dest);
+		decoder.setRowCallback(countRow, &rows);
+		Common::MemoryReadStream stream(pngBuf, size);
+		TS_ASSERT(decoder.loadStream(stream));
+		TS_ASSERT_EQUALS(rows, 3u);
+
+		// The image is decoded into the top left corner only
+		const Graphics::Surface *surface = decoder.getSurface();
+		TS_ASSERT_EQUALS(surface->getPixels(), dest.getPixels());
+		TS_ASSERT_EQUALS(surface->w, 4);
+		TS_ASSERT_EQUALS(surface->h, 3);
+		TS_ASSERT_EQUALS(dest.getPixel(0, 0), format.RGBToColor(0, 0, 200));
+		TS_ASSERT_EQUALS(dest.getPixel(4, 0), 0x1234u);
+		TS_ASSERT_EQUALS(dest.getPixel(0, 3), 0x1234u);
+
+		// Freeing the decoder leaves the surface alone
+		decoder.destroy();
+		TS_ASSERT_EQUALS(dest.getPixel(0, 0), format.RGBToColor(0, 0, 200));
+
+		// Images which don't fit are rejected
+		Graphics::Surface small;
+		small.create(3, 3, format);
+		decoder.setOutputSurface(&small);
+		Common::MemoryReadStream stream2(pngBuf, size);
+		TS_ASSERT(!decoder.loadStream(stream2));
+
+		small.free();
+		dest.free();
+#endif
+	}
+};
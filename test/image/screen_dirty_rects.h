@@ -0,0 +1,103 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/screen.h"
+
+/**
+ * A screen which exposes its dirty rects without touching the system.
+ */
+class DirtyRectScreen : public Graphics::Screen {
+public:
+	DirtyRectScreen() : Graphics::Screen(320, 200) {
+		clearDirtyRects();
+	}
+
+	const Common::List<Common::Rect> &dirtyRects() {
+		return _dirtyRects;
+	}
+
+	void merge() {
+		mergeDirtyRects();
+	}
+
+	uint32 dirtyArea() {
+		uint32 area = 0;
+		for (Common::List<Common::Rect>::const_iterator i = _dirtyRects.begin(); i != _dirtyRects.end(); ++i)
+			area += (*i).width() * (*i).height();
+		return area;
+	}
+
+	bool covers(const Common::Rect &r) {
+		for (int y = r.top; y < r.bottom; ++y) {
+			for (int x = r.left; x < r.right; ++x) {
+				bool found = false;
+				for (Common::List<Common::Rect>::const_iterator i = _dirtyRects.begin(); i != _dirtyRects.end() && !found; ++i)
+					found = (*i).contains(x, y);
+				if (!found)
+					return false;
+			}
+		}
+		return true;
+	}
+};
+
+class ScreenDirtyRectsTestSuite : public CxxTest::TestSuite {
+public:
+	void test_contained_rects() {
+		DirtyRectScreen screen;
+		screen.addDirtyRect(Common::Rect(10, 10, 50, 50));
+		screen.addDirtyRect(Common::Rect(20, 20, 30, 30));
+		TS_ASSERT_EQUALS(screen.dirtyRects().size(), 1u);
+
+		// A rect covering earlier ones replaces them
+		screen.addDirtyRect(Common::Rect(100, 100, 110, 110));
+		screen.addDirtyRect(Common::Rect(0, 0, 200, 200));
+		TS_ASSERT_EQUALS(screen.dirtyRects().size(), 1u);
+		TS_ASSERT_EQUALS(screen.dirtyRects().front(), Common::Rect(0, 0, 200, 200));
+
+		// Rects are clipped to the screen
+		screen.addDirtyRect(Common::Rect(300, 190, 400, 300));
+		TS_ASSERT_EQUALS(screen.dirtyRects().back(), Common::Rect(300, 190, 320, 200));
+	}
+
+	void test_free_merges() {
+		DirtyRectScreen screen;
+
+		// Rows of the same span are merged without adding any area
+		for (int y = 0; y < 40; y += 4)
+			screen.addDirtyRect(Common::Rect(8, y, 24, y + 4));
+		screen.addDirtyRect(Common::Rect(100, 100, 120, 110));
+		screen.addDirtyRect(Common::Rect(110, 105, 130, 120));
+		screen.merge();
+
+		TS_ASSERT_EQUALS(screen.dirtyRects().size(), 2u);
+		TS_ASSERT_EQUALS(screen.dirtyRects().front(), Common::Rect(8, 0, 24, 40));
+		TS_ASSERT_EQUALS(screen.dirtyRects().back(), Common::Rect(100, 100, 130, 120));
+	}
+
+	void test_bounded_merges() {
+		DirtyRectScreen screen;
+
+		// Scattered rects are combined into a few, still covering them all
+		for (int i = 0; i < 100; ++i) {
+			const int x = (i * 37) % 300, y = (i * 53) % 190;
+			screen.addDirtyRect(Common::Rect(x, y, x + 3, y + 2));
+			TS_ASSERT(screen.dirtyRects().size() <= 65u);
+		}
+
+		screen.merge();
+		TS_ASSERT(screen.dirtyRects().size() <= 16u);
+		TS_ASSERT(screen.dirtyArea() <= 320u * 200u);
+
+		for (int i = 0; i < 100; ++i) {
+			const int x = (i * 37) % 300, y = (i * 53) % 190;
+			TS_ASSERT(screen.covers(Common::Rect(x, y, x + 3, y + 2)));
+		}
+
+		// The merged rects don't overlap
+		Common::List<Common::Rect>::const_iterator i, j;
+		for (i = screen.dirtyRects().begin(); i != screen.dirtyRects().end(); ++i) {
+			for (j = i, ++j; j != screen.dirtyRects().end(); ++j)
+				TS_ASSERT(!(*i).intersects(*j));
+		}
+	}
+};
@@ -0,0 +1,200 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+#include "graphics/yuv_to_rgb_intern.h"
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite {
+	// Odd sizes to also cover the scalar tails
+	enum {
+		kWidth = 76,
+		kHeight = 8,
+		kPitch = kWidth + 1
+	};
+
+	byte _y[kPitch * kHeight], _u[kPitch * kHeight], _v[kPitch * kHeight];
+
+	void fillPlanes() {
+		uint32 seed = 1;
+		for (int i = 0; i < kPitch * kHeight; i++) {
+			seed = seed * 1103515245 + 12345;
+			_y[i] = seed >> 24;
+			_u[i] = seed >> 16;
+			_v[i] = seed >> 8;
+		}
+
+		// Make sure the extremes show up
+		_y[0] = _u[0] = _v[0] = 0;
+		_y[1] = _u[1] = _v[1] = 255;
+	}
+
+	void convert(Graphics::Surface &surface, int layout, Graphics::YUVToRGBManager::LuminanceScale scale) {
+		memset(surface.getPixels(), 0, surface.pitch * surface.h);
+
+		switch (layout) {
+		case 0:
+			YUVToRGBMan.convert444(&surface, scale, _y, _u, _v, kWidth, kHeight, kPitch, kPitch);
+			break;
+		case 1:
+			YUVToRGBMan.convert422(&surface, scale, _y, _u, _v, kWidth, kHeight, kPitch, kPitch);
+			break;
+		case 2:
+			YUVToRGBMan.convert420(&surface, scale, _y, _u, _v, kWidth, kHeight, kPitch, kPitch);
+			break;
+		default:
+			YUVToRGBMan.convert410(&surface, scale, _y, _u, _v, kWidth, kHeight, kPitch, kPitch);
+			break;
+		}
+	}
+
+	static Graphics::PixelFormat getFormat(int index) {
+		switch (index) {
+		case 0:
+			return Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		case 1:
+			return Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15);
+		case 2:
+			return Graphics::PixelFormat(2, 4, 4, 4, 4, 12, 8, 4, 0);
+		case 3:
+			return Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		case 4:
+			return Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24);
+		default:
+			return Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0);
+		}
+	}
+
+	enum { kFormatCount = 6 };
+
+	/**
+	 * Compare the manager's output with the given row routine to the one
+	 * with the lookup tables. With the generic routine, the rows are
+	 * converted directly instead.
+	 */
+	void checkRowFunc(Graphics::YUVToRGBRowFunc rowFunc) {
+		const Graphics::YUVToRGBManager::LuminanceScale scales[] = {
+			Graphics::YUVToRGBManager::kScaleFull,
+			Graphics::YUVToRGBManager::kScaleITU
+		};
+		const bool direct = (rowFunc == Graphics::convertYUVToRGBRowGeneric);
+
+		fillPlanes();
+
+		for (int f = 0; f < kFormatCount; f++) {
+			const Graphics::PixelFormat format = getFormat(f);
+			Graphics::Surface expected, actual;
+			expected.create(kWidth, kHeight, format);
+			actual.create(kWidth, kHeight, format);
+
+			for (int s = 0; s < ARRAYSIZE(scales); s++) {
+				// 410 is interpolated by the manager, so it can't be converted directly
+				for (int layout = 0; layout < (direct ? 3 : 4); layout++) {
+					// The generic routine makes the manager use the lookup tables
+					Graphics::g_yuvToRGBRowFunc = Graphics::convertYUVToRGBRowGeneric;
+					convert(expected, layout, scales[s]);
+
+					if (direct) {
+						Graphics::YUVToRGBRowFormat rowFormat;
+						rowFormat.itu = (scales[s] == Graphics::YUVToRGBManager::kScaleITU);
+						rowFormat.bytesPerPixel = format.bytesPerPixel;
+						rowFormat.rLoss = format.rLoss;
+						rowFormat.gLoss = format.gLoss;
+						rowFormat.bLoss = format.bLoss;
+						rowFormat.rShift = format.rShift;
+						rowFormat.gShift = format.gShift;
+						rowFormat.bShift = format.bShift;
+						rowFormat.aMask = (0xFF >> format.aLoss) << format.aShift;
+
+						for (int y = 0; y < kHeight; y++) {
+							const int uvOffset = (layout == 2 ? y / 2 : y) * kPitch;
+							rowFunc((byte *)actual.getBasePtr(0, y), _y + y * kPitch, _u + uvOffset, _v + uvOffset, kWidth, layout ? 1 : 0, rowFormat);
+						}
+					} else {
+						Graphics::g_yuvToRGBRowFunc = rowFunc;
+						convert(actual, layout, scales[s]);
+					}
+
+					TS_ASSERT_SAME_DATA(expected.getPixels(), actual.getPixels(), expected.pitch * expected.h);
+				}
+			}
+
+			expected.free();
+			actual.free();
+		}
+
+		Graphics::g_yuvToRGBRowFunc = nullptr;
+	}
+
+public:
+	void test_generic_row() {
+		// Also used for the tails of the SIMD routines
+		checkRowFunc(Graphics::convertYUVToRGBRowGeneric);
+
+		Graphics::YUVToRGBRowFormat format;
+		format.itu = false;
+		format.bytesPerPixel = 4;
+		format.rLoss = format.gLoss = format.bLoss = 0;
+		format.rShift = 16;
+		format.gShift = 8;
+		format.bShift = 0;
+		format.aMask = 0xFF000000;
+
+		const byte y[] = { 0, 255, 128 };
+		const byte chroma[] = { 128, 128, 128 };
+		uint32 pixels[3];
+		Graphics::convertYUVToRGBRowGeneric((byte *)pixels, y, chroma, chroma, 3, 0, format);
+		TS_ASSERT_EQUALS(pixels[0], 0xFF000000u);
+		TS_ASSERT_EQUALS(pixels[1], 0xFFFFFFFFu);
+		TS_ASSERT_EQUALS(pixels[2], 0xFF808080u);
+	}
+
+	void test_convert_image() {
+		// Avoid querying the CPU features from OSystem
+		Graphics::g_yuvToRGBRowFunc = Graphics::convertYUVToRGBRowGeneric;
+
+		fillPlanes();
+
+		Graphics::Surface expected, actual;
+		expected.create(kWidth, kHeight, getFormat(3));
+		actual.create(kWidth, kHeight, getFormat(3));
+
+		Graphics::YUVImage image;
+		image.y = _y;
+		image.u = _u;
+		image.v = _v;
+		image.yPitch = image.uvPitch = kPitch;
+		image.width = kWidth;
+		image.height = kHeight;
+		image.scale = Graphics::YUVToRGBManager::kScaleFull;
+
+		for (int layout = 0; layout < 3; layout++) {
+			image.chromaShiftX = layout ? 1 : 0;
+			image.chromaShiftY = layout == 2 ? 1 : 0;
+
+			convert(expected, layout, image.scale);
+			memset(actual.getPixels(), 0, actual.pitch * actual.h);
+			YUVToRGBMan.convert(&actual, image);
+
+			TS_ASSERT_SAME_DATA(expected.getPixels(), actual.getPixels(), expected.pitch * expected.h);
+		}
+
+		expected.free();
+		actual.free();
+		Graphics::g_yuvToRGBRowFunc = nullptr;
+	}
+
+	void test_simd_rows() {
+#ifdef SCUMMVM_NEON
+		checkRowFunc(Graphics::convertYUVToRGBRowNEON);
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkRowFunc(Graphics::convertYUVToRGBRowSSE2);
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			checkRowFunc(Graphics::convertYUVToRGBRowAVX2);
+#endif
+	}
+};
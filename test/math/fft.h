@@ -0,0 +1,115 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "math/fft.h"
+#include "math/fft_intern.h"
+#include "math/cosinetables.h"
+#include "math/utils.h"
+#include "../null_osystem.h"
+
+class FFTTestSuite : public CxxTest::TestSuite {
+	static void fillPoints(Math::Complex *z, int count, uint32 seed) {
+		for (int i = 0; i < count; i++) {
+			seed = seed * 1103515245 + 12345;
+			z[i].re = (int16)(seed >> 16) / 32768.0f;
+			seed = seed * 1103515245 + 12345;
+			z[i].im = (int16)(seed >> 16) / 32768.0f;
+		}
+	}
+
+	static void checkFFT(Math::FFT &fft, int bits, int inverse) {
+		const int n = 1 << bits;
+		Math::Complex *input = new Math::Complex[n];
+		Math::Complex *output = new Math::Complex[n];
+		fillPoints(input, n, bits);
+		memcpy(output, input, n * sizeof(Math::Complex));
+
+		fft.permute(output);
+		fft.calc(output);
+
+		const double sign = inverse ? 1.0 : -1.0;
+		for (int k = 0; k < n; k++) {
+			double re = 0.0, im = 0.0;
+			for (int j = 0; j < n; j++) {
+				const double angle = sign * 2.0 * M_PI * ((j * k) % n) / n;
+				re += input[j].re * cos(angle) - input[j].im * sin(angle);
+				im += input[j].re * sin(angle) + input[j].im * cos(angle);
+			}
+			TS_ASSERT_DELTA(output[k].re, re, 1e-3);
+			TS_ASSERT_DELTA(output[k].im, im, 1e-3);
+		}
+
+		delete[] input;
+		delete[] output;
+	}
+
+	static void checkPassFunc(Math::FFTPassFunc passFunc) {
+		const unsigned int sizes[] = { 4, 8, 64, 256 };
+
+		for (int i = 0; i < ARRAYSIZE(sizes); i++) {
+			const unsigned int n = sizes[i];
+			Math::CosineTable cosTable(8 * n);
+			Math::Complex *expected = new Math::Complex[8 * n];
+			Math::Complex *actual = new Math::Complex[8 * n];
+			fillPoints(expected, 8 * n, n);
+			memcpy(actual, expected, 8 * n * sizeof(Math::Complex));
+
+			Math::fftPassGeneric(expected, cosTable.getTable(), n);
+			passFunc(actual, cosTable.getTable(), n);
+
+			for (unsigned int j = 0; j < 8 * n; j++) {
+				TS_ASSERT_DELTA(actual[j].re, expected[j].re, 1e-5);
+				TS_ASSERT_DELTA(actual[j].im, expected[j].im, 1e-5);
+			}
+
+			delete[] expected;
+			delete[] actual;
+		}
+	}
+
+public:
+	void setUp() {
+		Common::install_null_g_system();
+	}
+
+	void test_fft() {
+		for (int bits = 2; bits <= 9; bits++) {
+			for (int inverse = 0; inverse <= 1; inverse++) {
+				Math::FFT fft(bits, inverse);
+				checkFFT(fft, bits, inverse);
+			}
+		}
+	}
+
+	void test_shared_tables() {
+		Math::FFT *first = new Math::FFT(8, 0);
+		Math::FFT *forward = new Math::FFT(8, 0);
+		Math::FFT *inverse = new Math::FFT(8, 1);
+		TS_ASSERT_EQUALS(first->getRevTab(), forward->getRevTab());
+		TS_ASSERT_DIFFERS(first->getRevTab(), inverse->getRevTab());
+
+		// The tables outlive the transform which created them
+		delete first;
+		Math::FFT smaller(6, 0);
+		checkFFT(*forward, 8, 0);
+		checkFFT(*inverse, 8, 1);
+		checkFFT(smaller, 6, 0);
+
+		delete forward;
+		delete inverse;
+	}
+
+	void test_pass_funcs() {
+#ifdef SCUMMVM_NEON
+		checkPassFunc(Math::fftPassNEON);
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkPassFunc(Math::fftPassSSE2);
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			checkPassFunc(Math::fftPassAVX2);
+#endif
+	}
+};
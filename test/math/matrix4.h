@@ -0,0 +1,117 @@
+#include <cxxtest/TestSuite.h>
+
+#include "math/matrix4.h"
+
+class Matrix4TestSuite : public CxxTest::TestSuite {
+	static Math::Matrix4 makeMatrix(uint32 seed) {
+		Math::Matrix4 m;
+		float *data = m.getData();
+		for (int i = 0; i < 16; i++) {
+			seed = seed * 1103515245 + 12345;
+			data[i] = (int16)(seed >> 16) / 8192.0f;
+		}
+		return m;
+	}
+
+	// The generic matrix product, which the Matrix4 one must match
+	static Math::Matrix4 multiply(const Math::Matrix4 &m1, const Math::Matrix4 &m2) {
+		Math::Matrix4 result;
+		for (int row = 0; row < 4; row++) {
+			for (int col = 0; col < 4; col++) {
+				float sum = 0.0f;
+				for (int j = 0; j < 4; j++)
+					sum += m1(row, j) * m2(j, col);
+				result(row, col) = sum;
+			}
+		}
+		return result;
+	}
+
+public:
+	void test_multiply() {
+		const Math::Matrix4 m1 = makeMatrix(1);
+		const Math::Matrix4 m2 = makeMatrix(2);
+		const Math::Matrix4 expected = multiply(m1, m2);
+		const Math::Matrix4 actual = m1 * m2;
+
+		for (int row = 0; row < 4; row++) {
+			for (int col = 0; col < 4; col++)
+				TS_ASSERT_DELTA(actual(row, col), expected(row, col), 1e-4);
+		}
+
+		// Transforming a Vector4d multiplies it as a row vector
+		const Math::Vector4d v(1.0f, -2.0f, 0.5f, 3.0f);
+		const Math::Vector4d transformed = m1.transform(v);
+		for (int col = 0; col < 4; col++) {
+			float sum = 0.0f;
+			for (int j = 0; j < 4; j++)
+				sum += v.getValue(j) * m1(j, col);
+			TS_ASSERT_DELTA(transformed.getValue(col), sum, 1e-4);
+		}
+	}
+
+	void test_inverse() {
+		for (uint32 seed = 0; seed < 16; seed++) {
+			const Math::Matrix4 m = makeMatrix(seed);
+			Math::Matrix4 inv = m;
+			TS_ASSERT(inv.inverse());
+
+			const Math::Matrix4 identity = m * inv;
+			for (int row = 0; row < 4; row++) {
+				for (int col = 0; col < 4; col++)
+					TS_ASSERT_DELTA(identity(row, col), row == col ? 1.0f : 0.0f, 1e-3);
+			}
+		}
+
+		Math::Matrix4 translation;
+		translation.setPosition(Math::Vector3d(1.0f, 2.0f, 3.0f));
+		translation(0, 0) = 2.0f;
+		TS_ASSERT(translation.inverse());
+		TS_ASSERT_DELTA(translation(0, 0), 0.5f, 1e-6);
+		TS_ASSERT_DELTA(translation(0, 3), -0.5f, 1e-6);
+		TS_ASSERT_DELTA(translation(1, 3), -2.0f, 1e-6);
+		TS_ASSERT_DELTA(translation(2, 3), -3.0f, 1e-6);
+		TS_ASSERT_DELTA(translation(3, 3), 1.0f, 1e-6);
+
+		// Singular matrices are left untouched
+		Math::Matrix4 singular = makeMatrix(3);
+		for (int col = 0; col < 4; col++)
+			singular(2, col) = 0.0f;
+		const Math::Matrix4 copy = singular;
+		TS_ASSERT(!singular.inverse());
+		TS_ASSERT(singular == copy);
+	}
+
+	void test_transform_vectors() {
+		const Math::Matrix4 m = makeMatrix(4);
+		Math::Vector3d vectors[5];
+		for (int i = 0; i < 5; i++)
+			vectors[i].set(i, 1.0f - i, 0.25f * i);
+
+		for (int translate = 0; translate <= 1; translate++) {
+			Math::Vector3d batch[5];
+			for (int i = 0; i < 5; i++)
+				batch[i] = vectors[i];
+			m.transformVectors(batch, 5, translate);
+
+			for (int i = 0; i < 5; i++) {
+				Math::Vector3d single = vectors[i];
+				m.transform(&single, translate);
+				TS_ASSERT_DELTA(batch[i].x(), single.x(), 1e-4);
+				TS_ASSERT_DELTA(batch[i].y(), single.y(), 1e-4);
+				TS_ASSERT_DELTA(batch[i].z(), single.z(), 1e-4);
+
+				// Which matches the generic product with a column vector
+				Math::Matrix<4, 1> column;
+				column(0, 0) = vectors[i].x();
+				column(1, 0) = vectors[i].y();
+				column(2, 0) = vectors[i].z();
+				column(3, 0) = translate ? 1.0f : 0.0f;
+				const Math::Matrix<4, 1> expected = Math::operator*<4, 1, 4>(m, column);
+				TS_ASSERT_DELTA(single.x(), expected(0, 0), 1e-4);
+				TS_ASSERT_DELTA(single.y(), expected(1, 0), 1e-4);
+				TS_ASSERT_DELTA(single.z(), expected(2, 0), 1e-4);
+			}
+		}
+	}
+};
@@ -0,0 +1,98 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cxxtest/TestSuite.h>
+
+#include "helper.h"
+#include "test/instrset_detect.h"
+
+#include "graphics/blit.h"
+#include "graphics/managed_surface.h"
+
+class BlendBlitBenchmarkSuite : public CxxTest::TestSuite {
+	typedef Graphics::BlendBlit::BlitFunc BlitFunc;
+
+	static void benchmarkImpl(const char *isa, BlitFunc func) {
+		static const char *const blendModes[] = { "normal", "additive", "subtractive", "multiply" };
+		static const char *const alphaTypes[] = { "opaque", "binary", "full" };
+
+		const Graphics::PixelFormat format = Graphics::BlendBlit::getSupportedPixelFormat();
+		Graphics::ManagedSurface src, dst;
+		src.create(256, 256, format);
+		dst.create(320, 256, format);
+		fillMicrobenchData((byte *)src.getPixels(), src.h * src.pitch, 1);
+		fillMicrobenchData((byte *)dst.getPixels(), dst.h * dst.pitch, 2);
+
+		const BlitFunc oldFunc = Graphics::BlendBlit::blitFunc;
+		Graphics::BlendBlit::blitFunc = func;
+
+		for (int mode = 0; mode < Graphics::NUM_BLEND_MODES; mode++) {
+			for (int alpha = 0; alpha < ARRAYSIZE(alphaTypes); alpha++) {
+				for (int colorMod = 0; colorMod < 2; colorMod++) {
+					const Common::String name = Common::String::format("blit/%s/%s/%s%s", isa, blendModes[mode], alphaTypes[alpha], colorMod ? "/tinted" : "");
+					runMicrobench(name, 200, src.h * src.pitch, [&]() {
+						Graphics::BlendBlit::blit((byte *)dst.getBasePtr(32, 0), (const byte *)src.getPixels(),
+						                          dst.pitch, src.pitch, 0, 0, src.w, src.h,
+						                          Graphics::BlendBlit::SCALE_THRESHOLD, Graphics::BlendBlit::SCALE_THRESHOLD,
+						                          0, 0, colorMod ? 0x80C0FFA0 : 0xFFFFFFFF, Graphics::FLIP_NONE,
+						                          (Graphics::TSpriteBlendMode)mode, (Graphics::AlphaType)alpha);
+					});
+				}
+			}
+		}
+
+		// Scaling takes a different path through all implementations
+		runMicrobench(Common::String::format("blit/%s/normal/full/scaled", isa), 200, src.h * src.pitch, [&]() {
+			Graphics::BlendBlit::blit((byte *)dst.getPixels(), (const byte *)src.getPixels(),
+			                          dst.pitch, src.pitch, 0, 0, dst.w, dst.h,
+			                          Graphics::BlendBlit::getScaleFactor(src.w, dst.w), Graphics::BlendBlit::getScaleFactor(src.h, dst.h),
+			                          0, 0, 0xFFFFFFFF, Graphics::FLIP_NONE, Graphics::BLEND_NORMAL, Graphics::ALPHA_FULL);
+		});
+
+		Graphics::BlendBlit::blitFunc = oldFunc;
+		src.free();
+		dst.free();
+	}
+
+public:
+	void test_blend_blit() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		benchmarkImpl("generic", Graphics::BlendBlit::blitGeneric);
+#ifdef SCUMMVM_NEON
+		benchmarkImpl("neon", Graphics::BlendBlit::blitNEON);
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			benchmarkImpl("sse2", Graphics::BlendBlit::blitSSE2);
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			benchmarkImpl("avx2", Graphics::BlendBlit::blitAVX2);
+#endif
+#ifdef SCUMMVM_AVX512
+		if (instrset_detect() >= 10)
+			benchmarkImpl("avx512", Graphics::BlendBlit::blitAVX512);
+#endif
+#endif
+	}
+};
@@ -0,0 +1,610 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cxxtest/TestSuite.h>
+
+#include "helper.h"
+
+#include "common/array.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/util.h"
+#include "common/compression/dcl.h"
+#include "common/compression/deflate.h"
+#include "common/compression/powerpacker.h"
+#include "common/compression/rnc_deco.h"
+
+/**
+ * There are no compressors for most of these formats in the tree, so the
+ * benchmarks decode streams of rng literals and short matches, which are
+ * built directly in the format of each decompressor. The decoded data is
+ * recorded along the way to check the results.
+ */
+class CompressionBenchmarkSuite : public CxxTest::TestSuite {
+	static const uint32 kUnpackedSize = 256 * 1024;
+
+	class Random {
+	public:
+		Random(uint32 seed) : _seed(seed) {}
+		uint32 next() {
+			_seed = _seed * 1103515245 + 12345;
+			return _seed >> 16;
+		}
+	private:
+		uint32 _seed;
+	};
+
+	// Packs bits starting with the least significant bit of each byte
+	class BitWriter {
+	public:
+		BitWriter() : _bitPos(0) {}
+
+		void putBit(uint bit) {
+			if (!(_bitPos & 7))
+				_data.push_back(0);
+			if (bit)
+				_data.back() |= 1 << (_bitPos & 7);
+			_bitPos++;
+		}
+
+		void putBitsLSB(uint32 value, int count) {
+			for (int i = 0; i < count; i++)
+				putBit((value >> i) & 1);
+		}
+
+		void putBitsMSB(uint32 value, int count) {
+			for (int i = count - 1; i >= 0; i--)
+				putBit((value >> i) & 1);
+		}
+
+		const Common::Array<byte> &getData() const { return _data; }
+
+	private:
+		Common::Array<byte> _data;
+		uint32 _bitPos;
+	};
+
+	static void copyMatch(Common::Array<byte> &output, uint32 distance, uint32 length) {
+		while (length--)
+			output.push_back(output[output.size() - distance]);
+	}
+
+	// A few of the ASCII mode literal codes, from 4 up to 13 bits
+	struct AsciiCode {
+		byte literal;
+		const char *code;
+	};
+
+	static const AsciiCode *getAsciiCodes(uint &count) {
+		static const AsciiCode codes[] = {
+			{ ' ', "1111" }, { 'e', "11011" }, { 't', "10100" }, { 'a', "11100" },
+			{ 'o', "10111" }, { 'i', "11010" }, { 'n', "11000" }, { 's', "10101" },
+			{ 'h', "010100" }, { 'r', "10110" }, { 'd', "010111" }, { 'l', "11001" },
+			{ '\n', "0100011" }, { '.', "0011110" }, { 'X', "000010111" }, { 0x80, "0000001001000" }
+		};
+		count = ARRAYSIZE(codes);
+		return codes;
+	}
+
+	// Binary or ASCII mode with a 1 KiB dictionary, using lengths 2 to 5 and the nearest distances
+	static void makeDCL(Common::Array<byte> &packed, Common::Array<byte> &unpacked, bool ascii = false) {
+		static const char *const lengthCodes[] = { "101", "11", "100", "011" };
+
+		uint asciiCount;
+		const AsciiCode *asciiCodes = getAsciiCodes(asciiCount);
+
+		Random rng(1);
+		BitWriter bits;
+		bits.putBitsLSB(ascii ? 1 : 0, 8);
+		bits.putBitsLSB(4, 8);
+
+		while (unpacked.size() < kUnpackedSize) {
+			const uint32 length = 2 + rng.next() % 4;
+			const uint32 distanceBits = (length == 2) ? 2 : 4;
+
+			if ((rng.next() & 1) || unpacked.size() < (1u << distanceBits) || unpacked.size() + length > kUnpackedSize) {
+				bits.putBit(0);
+				if (ascii) {
+					const AsciiCode &literal = asciiCodes[rng.next() % asciiCount];
+					for (const char *code = literal.code; *code; code++)
+						bits.putBit(*code == '1');
+					unpacked.push_back(literal.literal);
+				} else {
+					const byte literal = rng.next();
+					bits.putBitsLSB(literal, 8);
+					unpacked.push_back(literal);
+				}
+			} else {
+				const uint32 distance = rng.next() % (1 << distanceBits);
+				bits.putBit(1);
+				for (const char *code = lengthCodes[length - 2]; *code; code++)
+					bits.putBit(*code == '1');
+				// Distance code 0
+				bits.putBit(1);
+				bits.putBit(1);
+				bits.putBitsLSB(distance, distanceBits);
+				copyMatch(unpacked, distance + 1, length);
+			}
+		}
+
+		// End of stream, for decompressing without a known size
+		bits.putBit(1);
+		bits.putBitsLSB(0, 7);
+		bits.putBitsLSB(0xFF, 8);
+
+		packed = bits.getData();
+	}
+
+	// PowerPacker reads the bits backwards and writes its output from the end to the start
+	static void makePowerPacker(Common::Array<byte> &packed, Common::Array<byte> &unpacked) {
+		static const byte offsetBits[] = { 9, 10, 11, 11 };
+
+		Random rng(2);
+		BitWriter bits;
+		Common::Array<byte> reversed;
+
+		while (reversed.size() < kUnpackedSize) {
+			const bool literals = reversed.empty() || (rng.next() & 1);
+			bits.putBit(!literals);
+
+			if (literals) {
+				uint32 count = MIN<uint32>(1 + rng.next() % 8, kUnpackedSize - reversed.size());
+				// A literal run is always followed by a match of two bytes or more
+				if (kUnpackedSize - reversed.size() - count == 1)
+					count++;
+
+				uint32 todo = count - 1;
+				for (; todo >= 3; todo -= 3)
+					bits.putBitsMSB(3, 2);
+				bits.putBitsMSB(todo, 2);
+
+				for (uint32 i = 0; i < count; i++) {
+					const byte literal = rng.next();
+					bits.putBitsMSB(literal, 8);
+					reversed.push_back(literal);
+				}
+
+				if (reversed.size() == kUnpackedSize)
+					break;
+			}
+
+			const uint32 remaining = kUnpackedSize - reversed.size();
+			uint32 length = MIN<uint32>(2 + rng.next() % 12, remaining);
+			if (remaining - length == 1) {
+				if (length > 2)
+					length--;
+				else
+					length++;
+			}
+
+			const uint32 code = MIN<uint32>(length - 2, 3);
+			bits.putBitsMSB(code, 2);
+			if (code == 3)
+				bits.putBit(1);
+
+			const uint32 offset = rng.next() % MIN<uint32>(reversed.size(), 1 << offsetBits[code]);
+			bits.putBitsMSB(offset, offsetBits[code]);
+
+			if (code == 3) {
+				uint32 extra = length - 5;
+				for (; extra >= 7; extra -= 7)
+					bits.putBitsMSB(7, 3);
+				bits.putBitsMSB(extra, 3);
+			}
+
+			copyMatch(reversed, offset + 1, length);
+		}
+
+		packed.resize(4);
+		WRITE_BE_UINT32(&packed[0], MKTAG('P', 'P', '2', '0'));
+		for (int i = 0; i < ARRAYSIZE(offsetBits); i++)
+			packed.push_back(offsetBits[i]);
+		for (int i = bits.getData().size() - 1; i >= 0; i--)
+			packed.push_back(bits.getData()[i]);
+		packed.push_back((kUnpackedSize >> 16) & 0xFF);
+		packed.push_back((kUnpackedSize >> 8) & 0xFF);
+		packed.push_back(kUnpackedSize & 0xFF);
+		// No bits to skip
+		packed.push_back(0);
+
+		unpacked.resize(reversed.size());
+		for (uint32 i = 0; i < reversed.size(); i++)
+			unpacked[i] = reversed[reversed.size() - 1 - i];
+	}
+
+	static uint16 rncCRC(const byte *data, uint32 size) {
+		uint16 crc = 0;
+		for (uint32 i = 0; i < size; i++) {
+			crc ^= data[i];
+			for (int bit = 0; bit < 8; bit++)
+				crc = (crc & 1) ? (crc >> 1) ^ 0xA001 : (crc >> 1);
+		}
+		return crc;
+	}
+
+	// RNC method 1 packs its bits into 16-bit little endian words. Literal runs
+	// are stored as plain bytes right after the word holding the current bits.
+	class Rnc1Writer {
+	public:
+		Rnc1Writer() : _wordPos(0), _bitsLeft(0) {}
+
+		void putBit(uint bit) {
+			if (!_bitsLeft) {
+				_wordPos = _data.size();
+				_data.push_back(0);
+				_data.push_back(0);
+				_bitsLeft = 16;
+			}
+			if (bit)
+				WRITE_LE_UINT16(&_data[_wordPos], READ_LE_UINT16(&_data[_wordPos]) | (1 << (16 - _bitsLeft)));
+			_bitsLeft--;
+		}
+
+		void putBitsLSB(uint32 value, int count) {
+			for (int i = 0; i < count; i++)
+				putBit((value >> i) & 1);
+		}
+
+		// The tables either use 16 codes of 4 bits, so the code of a symbol is the
+		// symbol itself, or a unary code of symbol + 1 bits, up to 15 bits
+		void putValue(uint32 value, bool unary = false) {
+			uint32 symbol = 0;
+			while ((value >> symbol) > 1)
+				symbol++;
+			symbol = value < 2 ? value : symbol + 1;
+
+			if (unary) {
+				for (uint32 i = 0; i < symbol; i++)
+					putBit(1);
+				if (symbol < 15)
+					putBit(0);
+			} else {
+				for (int i = 3; i >= 0; i--)
+					putBit((symbol >> i) & 1);
+			}
+			if (symbol >= 2)
+				putBitsLSB(value - (1 << (symbol - 1)), symbol - 1);
+		}
+
+		void putByte(byte value) {
+			_data.push_back(value);
+		}
+
+		const Common::Array<byte> &getData() const { return _data; }
+
+	private:
+		Common::Array<byte> _data;
+		uint32 _wordPos;
+		int _bitsLeft;
+	};
+
+	struct Rnc1Token {
+		uint32 literals;
+		uint32 distance;
+		uint32 length;
+	};
+
+	static void makeRNC1(Common::Array<byte> &packed, Common::Array<byte> &unpacked) {
+		Random rng(4);
+		Common::Array<Rnc1Token> tokens;
+		Common::Array<byte> literals;
+
+		while (unpacked.size() < kUnpackedSize) {
+			Rnc1Token token;
+			token.literals = MIN<uint32>(rng.next() % 8, kUnpackedSize - unpacked.size());
+			if (unpacked.empty())
+				token.literals = 1;
+			for (uint32 i = 0; i < token.literals; i++) {
+				const byte literal = rng.next();
+				literals.push_back(literal);
+				unpacked.push_back(literal);
+			}
+
+			token.length = MIN<uint32>(2 + rng.next() % 16, kUnpackedSize - unpacked.size());
+			token.distance = 1 + rng.next() % MIN<uint32>(unpacked.size(), 4096);
+			copyMatch(unpacked, token.distance, token.length);
+			tokens.push_back(token);
+		}
+		// The last token has no match
+		if (tokens.back().length) {
+			Rnc1Token last = { 0, 0, 0 };
+			tokens.push_back(last);
+		}
+
+		Rnc1Writer writer;
+		// Skipped by the decompressor
+		writer.putBitsLSB(0, 2);
+		// The distances use the unary code, for codes longer than 9 bits
+		for (int table = 0; table < 3; table++) {
+			writer.putBitsLSB(16, 5);
+			for (int i = 0; i < 16; i++)
+				writer.putBitsLSB(table == 1 ? MIN(i + 1, 15) : 4, 4);
+		}
+		writer.putBitsLSB(tokens.size(), 16);
+
+		const byte *literal = &literals[0];
+		for (uint32 i = 0; i < tokens.size(); i++) {
+			writer.putValue(tokens[i].literals);
+			for (uint32 j = 0; j < tokens[i].literals; j++)
+				writer.putByte(*literal++);
+			if (i + 1 < tokens.size()) {
+				writer.putValue(tokens[i].distance - 1, true);
+				writer.putValue(tokens[i].length - 2);
+			}
+		}
+
+		const Common::Array<byte> &data = writer.getData();
+		packed.resize(18);
+		WRITE_BE_UINT32(&packed[0], Common::RncDecoder::kRnc1Signature);
+		WRITE_BE_UINT32(&packed[4], unpacked.size());
+		WRITE_BE_UINT32(&packed[8], data.size());
+		WRITE_BE_UINT16(&packed[12], rncCRC(&unpacked[0], unpacked.size()));
+		WRITE_BE_UINT16(&packed[14], rncCRC(&data[0], data.size()));
+		packed[16] = 0;
+		packed[17] = 1;
+		packed.push_back(data);
+	}
+
+	// RNC method 2 interleaves the data bytes with bytes of flag bits, which are read from the most significant bit
+	class RncWriter {
+	public:
+		RncWriter() : _bitByte(0), _bitsLeft(0) {}
+
+		void putBit(uint bit) {
+			if (!_bitsLeft) {
+				_bitByte = _data.size();
+				_data.push_back(0);
+				_bitsLeft = 8;
+			}
+			_bitsLeft--;
+			if (bit)
+				_data[_bitByte] |= 1 << _bitsLeft;
+		}
+
+		void putByte(byte value) {
+			_data.push_back(value);
+		}
+
+		const Common::Array<byte> &getData() const { return _data; }
+
+	private:
+		Common::Array<byte> _data;
+		uint32 _bitByte;
+		int _bitsLeft;
+	};
+
+	static void makeRNC2(Common::Array<byte> &packed, Common::Array<byte> &unpacked) {
+		Random rng(3);
+		RncWriter writer;
+
+		// Skipped by the decompressor
+		writer.putBit(0);
+		writer.putBit(0);
+
+		while (unpacked.size() < kUnpackedSize) {
+			uint32 length = MIN<uint32>(2 + rng.next() % 12, kUnpackedSize - unpacked.size());
+			if ((rng.next() & 1) || unpacked.size() < 256 || length < 2) {
+				const byte literal = rng.next();
+				writer.putBit(0);
+				writer.putByte(literal);
+				unpacked.push_back(literal);
+				continue;
+			}
+
+			const byte distance = rng.next();
+			writer.putBit(1);
+			if (length == 2) {
+				writer.putBit(1);
+				writer.putBit(0);
+			} else {
+				if (length == 3) {
+					writer.putBit(1);
+					writer.putBit(1);
+					writer.putBit(0);
+				} else if (length <= 5) {
+					writer.putBit(0);
+					writer.putBit(length - 4);
+					writer.putBit(0);
+				} else if (length <= 8) {
+					writer.putBit(0);
+					writer.putBit((length - 6) >> 1);
+					writer.putBit(1);
+					writer.putBit((length - 6) & 1);
+				} else {
+					writer.putBit(1);
+					writer.putBit(1);
+					writer.putBit(1);
+					writer.putByte(length - 8);
+				}
+				// The high byte of the distance is 0
+				writer.putBit(0);
+			}
+			writer.putByte(distance);
+			copyMatch(unpacked, distance + 1, length);
+		}
+
+		// End of data
+		writer.putBit(1);
+		writer.putBit(1);
+		writer.putBit(1);
+		writer.putBit(1);
+		writer.putByte(0);
+		writer.putBit(0);
+
+		const Common::Array<byte> &data = writer.getData();
+		packed.resize(18);
+		WRITE_BE_UINT32(&packed[0], Common::RncDecoder::kRnc2Signature);
+		WRITE_BE_UINT32(&packed[4], unpacked.size());
+		WRITE_BE_UINT32(&packed[8], data.size());
+		WRITE_BE_UINT16(&packed[12], rncCRC(&unpacked[0], unpacked.size()));
+		WRITE_BE_UINT16(&packed[14], rncCRC(&data[0], data.size()));
+		packed[16] = 0;
+		packed[17] = 1;
+		packed.push_back(data);
+	}
+
+public:
+	void test_dcl() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Array<byte> packed, unpacked;
+		makeDCL(packed, unpacked);
+
+		byte *output = new byte[kUnpackedSize];
+		runMicrobench("compression/dcl", 20, kUnpackedSize, [&]() {
+			Common::MemoryReadStream stream(&packed[0], packed.size());
+			Common::decompressDCL(&stream, output, packed.size(), kUnpackedSize);
+		});
+
+		TS_ASSERT_SAME_DATA(output, &unpacked[0], kUnpackedSize);
+		delete[] output;
+
+		Common::MemoryReadStream stream(&packed[0], packed.size());
+		Common::ScopedPtr<Common::SeekableReadStream> dynamic;
+		runMicrobench("compression/dcl-unknown-size", 20, kUnpackedSize, [&]() {
+			stream.seek(0);
+			dynamic.reset(Common::decompressDCL(&stream));
+		});
+
+		TS_ASSERT(dynamic);
+		TS_ASSERT_EQUALS(dynamic->size(), kUnpackedSize);
+		byte *dynamicOutput = new byte[kUnpackedSize];
+		dynamic->read(dynamicOutput, kUnpackedSize);
+		TS_ASSERT_SAME_DATA(dynamicOutput, &unpacked[0], kUnpackedSize);
+		delete[] dynamicOutput;
+#endif
+	}
+
+	void test_dcl_ascii() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Array<byte> packed, unpacked;
+		makeDCL(packed, unpacked, true);
+
+		byte *output = new byte[kUnpackedSize];
+		runMicrobench("compression/dcl-ascii", 20, kUnpackedSize, [&]() {
+			Common::MemoryReadStream stream(&packed[0], packed.size());
+			Common::decompressDCL(&stream, output, packed.size(), kUnpackedSize);
+		});
+
+		TS_ASSERT_SAME_DATA(output, &unpacked[0], kUnpackedSize);
+		delete[] output;
+#endif
+	}
+
+	void test_powerpacker() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Array<byte> packed, unpacked;
+		makePowerPacker(packed, unpacked);
+
+		byte *output = nullptr;
+		uint32 outputSize = 0;
+		runMicrobench("compression/powerpacker", 20, kUnpackedSize, [&]() {
+			delete[] output;
+			output = Common::PowerPackerStream::unpackBuffer(&packed[0], packed.size(), outputSize);
+		});
+
+		TS_ASSERT_EQUALS(outputSize, kUnpackedSize);
+		TS_ASSERT_SAME_DATA(output, &unpacked[0], kUnpackedSize);
+		delete[] output;
+#endif
+	}
+
+	void test_rnc1() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Array<byte> packed, unpacked;
+		makeRNC1(packed, unpacked);
+
+		byte *output = new byte[kUnpackedSize];
+		int32 result = 0;
+		runMicrobench("compression/rnc1", 20, kUnpackedSize, [&]() {
+			Common::RncDecoder decoder;
+			result = decoder.unpackM1(&packed[0], packed.size(), output);
+		});
+
+		TS_ASSERT_EQUALS(result, (int32)kUnpackedSize);
+		TS_ASSERT_SAME_DATA(output, &unpacked[0], kUnpackedSize);
+		delete[] output;
+#endif
+	}
+
+	void test_rnc() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Array<byte> packed, unpacked;
+		makeRNC2(packed, unpacked);
+
+		byte *output = new byte[kUnpackedSize];
+		int32 result = 0;
+		runMicrobench("compression/rnc2", 20, kUnpackedSize, [&]() {
+			Common::RncDecoder decoder;
+			result = decoder.unpackM2(&packed[0], output);
+		});
+
+		TS_ASSERT_EQUALS(result, (int32)kUnpackedSize);
+		TS_ASSERT_SAME_DATA(output, &unpacked[0], kUnpackedSize);
+		delete[] output;
+#endif
+	}
+
+	void test_inflate() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(USE_ZLIB)
+		Common::install_null_g_system();
+
+		// Anything compressible will do, so reuse the DCL data
+		Common::Array<byte> dclPacked, unpacked;
+		makeDCL(dclPacked, unpacked);
+
+		Common::MemoryWriteStreamDynamic *gzip = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::WriteStream *compressor = Common::wrapCompressedWriteStream(gzip);
+		compressor->write(&unpacked[0], unpacked.size());
+		compressor->finalize();
+		byte *packed = gzip->getData();
+		const uint32 packedSize = gzip->size();
+		delete compressor;
+
+		byte *output = new byte[kUnpackedSize];
+		// Skip the gzip header and trailer
+		runMicrobench("compression/inflate", 20, kUnpackedSize, [&]() {
+			Common::inflateZlibHeaderless(output, kUnpackedSize, packed + 10, packedSize - 18);
+		});
+		TS_ASSERT_SAME_DATA(output, &unpacked[0], kUnpackedSize);
+
+		memset(output, 0, kUnpackedSize);
+		runMicrobench("compression/gzip-stream", 20, kUnpackedSize, [&]() {
+			Common::SeekableReadStream *stream = Common::wrapCompressedReadStream(new Common::MemoryReadStream(packed, packedSize));
+			stream->read(output, kUnpackedSize);
+			delete stream;
+		});
+		TS_ASSERT_SAME_DATA(output, &unpacked[0], kUnpackedSize);
+
+		delete[] output;
+		free(packed);
+#endif
+	}
+};
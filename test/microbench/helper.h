@@ -0,0 +1,82 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TEST_MICROBENCH_HELPER_H
+#define TEST_MICROBENCH_HELPER_H
+
+// The null OSystem silences the log, so the results go straight to stderr,
+// away from the progress cxxtest prints to stdout. This has to be included
+// before anything else pulls in common/forbidden.h.
+#define FORBIDDEN_SYMBOL_EXCEPTION_fprintf
+#define FORBIDDEN_SYMBOL_EXCEPTION_stderr
+
+#include "common/scummsys.h"
+#include "common/str.h"
+#include "common/system.h"
+
+#include "../null_osystem.h"
+
+/**
+ * Time @p iterations calls of @p func, after one untimed warm-up call, and
+ * print the result as a single line of JSON:
+ *
+ *   {"benchmark":"blit/sse2/normal/full","iterations":200,"total_us":1234,"ns_per_iter":6170,"mb_per_s":42.5}
+ *
+ * The lines are written to stderr, e.g. run
+ *
+ *   ./test/microbench/runner 2> results.jsonl
+ *
+ * The iteration counts are fixed, so the numbers of two runs, releases or
+ * devices can be compared directly.
+ *
+ * @param name       Unique name of the benchmark, with '/' separated components.
+ * @param iterations Number of timed calls.
+ * @param bytes      Amount of data a single call processes, for the throughput.
+ *                   Pass 0 to leave it out.
+ * @param func       The function object to benchmark.
+ */
+template<class Func>
+static void runMicrobench(const Common::String &name, uint iterations, uint64 bytes, Func func) {
+	func();
+
+	const uint64 start = g_system->getMicros();
+	for (uint i = 0; i < iterations; i++)
+		func();
+	uint64 total = g_system->getMicros() - start;
+	if (total == 0)
+		total = 1;
+
+	fprintf(stderr, "{\"benchmark\":\"%s\",\"iterations\":%u,\"total_us\":%llu,\"ns_per_iter\":%llu",
+	       name.c_str(), iterations, (unsigned long long)total, (unsigned long long)(total * 1000 / iterations));
+	if (bytes)
+		fprintf(stderr, ",\"mb_per_s\":%.2f", (double)bytes * iterations / total);
+	fprintf(stderr, "}\n");
+}
+
+/** Fill @p size bytes with reproducible pseudo-random data. */
+static void fillMicrobenchData(byte *data, uint32 size, uint32 seed) {
+	for (uint32 i = 0; i < size; i++) {
+		seed = seed * 1103515245 + 12345;
+		data[i] = (byte)(seed >> 16);
+	}
+}
+
+#endif
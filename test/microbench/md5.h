@@ -0,0 +1,54 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cxxtest/TestSuite.h>
+
+#include "helper.h"
+
+#include "common/md5.h"
+#include "common/memstream.h"
+
+class MD5BenchmarkSuite : public CxxTest::TestSuite {
+public:
+	void test_md5() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		const uint32 size = 1024 * 1024;
+		byte *data = new byte[size];
+		fillMicrobenchData(data, size, 1);
+
+		uint8 digest[16];
+		runMicrobench("md5/1M", 50, size, [&]() {
+			Common::MemoryReadStream stream(data, size);
+			Common::computeStreamMD5(stream, digest);
+		});
+
+		// Detection only hashes the start of the files
+		runMicrobench("md5/5000", 5000, 5000, [&]() {
+			Common::MemoryReadStream stream(data, size);
+			Common::computeStreamMD5(stream, digest, 5000);
+		});
+
+		delete[] data;
+#endif
+	}
+};
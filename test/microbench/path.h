@@ -0,0 +1,76 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cxxtest/TestSuite.h>
+
+#include "helper.h"
+
+#include "common/array.h"
+#include "common/hashmap.h"
+#include "common/path.h"
+
+/**
+ * An index of 100k files spread over four archives, searched the way
+ * SearchSet does: each archive in turn until the file is found.
+ */
+class PathBenchmarkSuite : public CxxTest::TestSuite {
+	static const uint kFileCount = 100000;
+	static const uint kArchiveCount = 4;
+
+	typedef Common::HashMap<Common::Path, uint, Common::Path::IgnoreCaseAndMac_Hash, Common::Path::IgnoreCaseAndMac_EqualTo> Index;
+
+public:
+	void test_path() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Array<Common::Path> paths;
+		paths.reserve(kFileCount);
+		for (uint i = 0; i < kFileCount; i++)
+			paths.push_back(Common::Path(Common::String::format("Data/Chapter %u/Scene%04u/File %u.DAT", i % 7, i % 1000, i)));
+
+		Index index[kArchiveCount];
+		runMicrobench("path/index/build", 5, 0, [&]() {
+			for (uint a = 0; a < kArchiveCount; a++)
+				index[a].clear();
+			for (uint i = 0; i < kFileCount; i++)
+				index[i % kArchiveCount][paths[i]] = i;
+		});
+
+		uint found = 0;
+		runMicrobench("path/index/lookup", 5, 0, [&]() {
+			found = 0;
+			for (uint i = 0; i < kFileCount; i++) {
+				for (uint a = 0; a < kArchiveCount; a++) {
+					if (index[a].contains(paths[i])) {
+						found++;
+						break;
+					}
+				}
+			}
+		});
+
+		TS_ASSERT_EQUALS(found, kFileCount);
+		// Lookups ignore the case
+		TS_ASSERT(index[1].contains(Common::Path("data/chapter 1/scene0001/file 1.dat")));
+#endif
+	}
+};
@@ -0,0 +1,96 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cxxtest/TestSuite.h>
+
+#include "helper.h"
+
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+#include "audio/rate_intern.h"
+#include "audio/decoders/raw.h"
+
+class RateBenchmarkSuite : public CxxTest::TestSuite {
+	static void benchmarkConverter(const char *isa, const char *quality, Audio::RateConverterQuality mode, Audio::SincFilterCache &cache,
+	                               uint inRate, uint outRate, bool inStereo) {
+		// One second of noise, looped forever
+		const uint32 size = inRate * (inStereo ? 4 : 2);
+		byte *samples = (byte *)malloc(size);
+		fillMicrobenchData(samples, size, inRate);
+		Audio::AudioStream *stream = Audio::makeLoopingAudioStream(
+			Audio::makeRawStream(samples, size, inRate, Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN | (inStereo ? Audio::FLAG_STEREO : 0)), 0);
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, inStereo, true, false, mode, &cache);
+
+		// The usual size of a mixer callback
+		const uint frames = 2048;
+		int16 *out = new int16[frames * 2];
+		memset(out, 0, frames * 2 * sizeof(int16));
+
+		const Common::String name = Common::String::format("rate/%s/%s/%u-%u/%s", isa, inRate == outRate ? "copy" : quality,
+		                                                   inRate, outRate, inStereo ? "stereo" : "mono");
+		runMicrobench(name, 500, frames * 2 * sizeof(int16), [&]() {
+			converter->convert(*stream, out, frames, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume / 2);
+		});
+
+		delete[] out;
+		delete converter;
+		delete stream;
+	}
+
+	static void benchmarkImpl(const char *isa, Audio::StereoMixFunc mixFunc, Audio::DotProductFunc dotProductFunc) {
+		Audio::g_stereoMixFunc = mixFunc;
+		Audio::g_stereoBusMixFunc = Audio::mixStereoBusGeneric;
+		Audio::g_dotProductFunc = dotProductFunc;
+
+		static const uint rates[][2] = {
+			{ 44100, 44100 }, { 22050, 44100 }, { 44100, 22050 }, { 11025, 48000 }, { 48000, 44100 }
+		};
+
+		Audio::SincFilterCache cache;
+		for (int i = 0; i < ARRAYSIZE(rates); i++) {
+			for (int stereo = 0; stereo < 2; stereo++) {
+				benchmarkConverter(isa, "linear", Audio::kRateConverterLinear, cache, rates[i][0], rates[i][1], stereo);
+				if (rates[i][0] != rates[i][1])
+					benchmarkConverter(isa, "sinc", Audio::kRateConverterSinc, cache, rates[i][0], rates[i][1], stereo);
+			}
+		}
+
+		Audio::g_stereoMixFunc = nullptr;
+		Audio::g_stereoBusMixFunc = nullptr;
+		Audio::g_dotProductFunc = nullptr;
+	}
+
+public:
+	void test_rate_converters() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		benchmarkImpl("generic", Audio::mixStereoGeneric, Audio::dotProductGeneric);
+#ifdef SCUMMVM_NEON
+		benchmarkImpl("neon", Audio::mixStereoNEON, Audio::dotProductNEON);
+#endif
+#ifdef SCUMMVM_SSE2
+		benchmarkImpl("sse2", Audio::mixStereoSSE2, Audio::dotProductSSE2);
+#endif
+#endif
+	}
+};
@@ -0,0 +1,113 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cxxtest/TestSuite.h>
+
+#include "helper.h"
+
+#include "base/plugins.h"
+#include "graphics/scalerplugin.h"
+
+// The scaler plugins are linked in statically, see REGISTER_PLUGIN_STATIC
+PluginObject *g_NORMAL_getObject();
+#ifdef USE_SCALERS
+PluginObject *g_ADVMAME_getObject();
+PluginObject *g_DOTMATRIX_getObject();
+PluginObject *g_PM_getObject();
+PluginObject *g_SAI_getObject();
+PluginObject *g_SUPERSAI_getObject();
+PluginObject *g_SUPEREAGLE_getObject();
+PluginObject *g_TV_getObject();
+#endif
+#ifdef USE_HQ_SCALERS
+PluginObject *g_HQ_getObject();
+#endif
+#ifdef USE_EDGE_SCALERS
+PluginObject *g_EDGE_getObject();
+#endif
+
+class ScalerBenchmarkSuite : public CxxTest::TestSuite {
+	static void benchmarkPlugin(PluginObject *object) {
+		const ScalerPluginObject *plugin = (const ScalerPluginObject *)object;
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0)
+		};
+
+		// The size of most games, plus the border the scalers may look into
+		const int width = 320, height = 200;
+		const int padding = plugin->extraPixels();
+
+		for (int f = 0; f < ARRAYSIZE(formats); f++) {
+			const Graphics::PixelFormat &format = formats[f];
+			const uint srcPitch = (width + padding * 2) * format.bytesPerPixel;
+			byte *src = new byte[srcPitch * (height + padding * 2)];
+			fillMicrobenchData(src, srcPitch * (height + padding * 2), f + 1);
+			const byte *srcStart = src + padding * srcPitch + padding * format.bytesPerPixel;
+
+			Scaler *scaler = plugin->createInstance(format);
+
+			for (uint i = 0; i < plugin->getFactors().size(); i++) {
+				const uint factor = plugin->getFactors()[i];
+				scaler->setFactor(factor);
+
+				const uint dstPitch = width * factor * format.bytesPerPixel;
+				byte *dst = new byte[dstPitch * height * factor];
+
+				const Common::String name = Common::String::format("scaler/%s/%ux/%dbpp", plugin->getName(), factor, format.bytesPerPixel * 8);
+				runMicrobench(name, 20, width * height * format.bytesPerPixel, [&]() {
+					scaler->scale(srcStart, srcPitch, dst, dstPitch, width, height, 0, 0);
+				});
+
+				delete[] dst;
+			}
+
+			delete scaler;
+			delete[] src;
+		}
+
+		delete object;
+	}
+
+public:
+	void test_scalers() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		benchmarkPlugin(g_NORMAL_getObject());
+#ifdef USE_SCALERS
+		benchmarkPlugin(g_ADVMAME_getObject());
+		benchmarkPlugin(g_DOTMATRIX_getObject());
+		benchmarkPlugin(g_PM_getObject());
+		benchmarkPlugin(g_SAI_getObject());
+		benchmarkPlugin(g_SUPERSAI_getObject());
+		benchmarkPlugin(g_SUPEREAGLE_getObject());
+		benchmarkPlugin(g_TV_getObject());
+#endif
+#ifdef USE_HQ_SCALERS
+		benchmarkPlugin(g_HQ_getObject());
+#endif
+#ifdef USE_EDGE_SCALERS
+		benchmarkPlugin(g_EDGE_getObject());
+#endif
+#endif
+	}
+};
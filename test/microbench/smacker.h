@@ -0,0 +1,353 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cxxtest/TestSuite.h>
+
+#include "helper.h"
+
+#include "common/array.h"
+#include "common/endian.h"
+#include "common/memstream.h"
+#include "graphics/surface.h"
+#include "video/smk_decoder.h"
+
+/**
+ * There is no Smacker encoder in the tree, so the benchmark builds a video of
+ * random blocks directly in the format of the decoder. The Huffman trees have
+ * codes of up to 16 bits, longer than the first level of the lookup tables.
+ * The expected frames are drawn along the way to check the results.
+ *
+ * The test OSystem has no mixer, which the audio tracks need, so the video
+ * has none.
+ */
+class SmackerBenchmarkSuite : public CxxTest::TestSuite {
+	static const uint kWidth = 320;
+	static const uint kHeight = 200;
+	static const uint kFrameCount = 30;
+	// Each comb level adds a complete subtree of four levels
+	static const uint kCombLevels = 12;
+	static const uint kTreeAllocSize = 4096;
+
+	class Random {
+	public:
+		Random(uint32 seed) : _seed(seed) {}
+		uint32 next() {
+			_seed = _seed * 1103515245 + 12345;
+			return _seed >> 16;
+		}
+	private:
+		uint32 _seed;
+	};
+
+	// Packs bits starting with the least significant bit of each byte
+	class BitWriter {
+	public:
+		BitWriter() : _bitPos(0) {}
+
+		void putBit(uint bit) {
+			if (!(_bitPos & 7))
+				_data.push_back(0);
+			if (bit)
+				_data.back() |= 1 << (_bitPos & 7);
+			_bitPos++;
+		}
+
+		void putBitsLSB(uint32 value, int count) {
+			for (int i = 0; i < count; i++)
+				putBit((value >> i) & 1);
+		}
+
+		const Common::Array<byte> &getData() const { return _data; }
+
+	private:
+		Common::Array<byte> _data;
+		uint32 _bitPos;
+	};
+
+	// The code of a leaf, with its first bit in the least significant bit
+	struct Code {
+		uint32 bits;
+		uint length;
+	};
+
+	typedef Common::Array<Code> CodeList;
+
+	// A tree with a leaf for each of its values
+	struct Tree {
+		Common::Array<uint32> values;
+		CodeList codes;
+	};
+
+	static void addLeaf(CodeList &codes, uint32 code, uint length) {
+		Code leaf = { code, length };
+		codes.push_back(leaf);
+	}
+
+	// Write the shape of a complete small tree, with its leaves holding their index
+	static void writeSmallTree(BitWriter &bits, CodeList &codes, uint levels, uint32 code = 0, uint length = 0) {
+		if (!levels) {
+			bits.putBit(0);
+			bits.putBitsLSB(codes.size(), 8);
+			addLeaf(codes, code, length);
+			return;
+		}
+
+		bits.putBit(1);
+		writeSmallTree(bits, codes, levels - 1, code, length + 1);
+		writeSmallTree(bits, codes, levels - 1, code | (1 << length), length + 1);
+	}
+
+	static void writeCode(BitWriter &bits, const Code &code) {
+		bits.putBitsLSB(code.bits, code.length);
+	}
+
+	// The values of big tree leaves are written as codes of the small trees
+	static void writeBigLeaf(BitWriter &bits, Tree &tree, const CodeList &byteCodes, uint32 code, uint length) {
+		const uint32 value = tree.values[tree.codes.size()];
+		bits.putBit(0);
+		writeCode(bits, byteCodes[value & 0xFF]);
+		writeCode(bits, byteCodes[value >> 8]);
+		addLeaf(tree.codes, code, length);
+	}
+
+	static void writeCompleteBigTree(BitWriter &bits, Tree &tree, const CodeList &byteCodes, uint levels, uint32 code, uint length) {
+		if (!levels) {
+			writeBigLeaf(bits, tree, byteCodes, code, length);
+			return;
+		}
+
+		bits.putBit(1);
+		writeCompleteBigTree(bits, tree, byteCodes, levels - 1, code, length + 1);
+		writeCompleteBigTree(bits, tree, byteCodes, levels - 1, code | (1 << length), length + 1);
+	}
+
+	static void writeCombBigTree(BitWriter &bits, Tree &tree, const CodeList &byteCodes, uint combLevels, uint32 code, uint length) {
+		if (!combLevels) {
+			writeCompleteBigTree(bits, tree, byteCodes, 4, code, length);
+			return;
+		}
+
+		bits.putBit(1);
+		writeCompleteBigTree(bits, tree, byteCodes, 4, code, length + 1);
+		writeCombBigTree(bits, tree, byteCodes, combLevels - 1, code | (1 << length), length + 1);
+	}
+
+	static void writeBigTree(BitWriter &bits, Tree &tree) {
+		CodeList byteCodes;
+
+		bits.putBit(1);
+		for (int i = 0; i < 2; i++) {
+			byteCodes.clear();
+			bits.putBit(1);
+			writeSmallTree(bits, byteCodes, 8);
+			bits.putBit(0);
+		}
+
+		// Markers which don't match any value, so the decoded values are
+		// always those of the leaves
+		bits.putBitsLSB(0xFFFF, 16);
+		bits.putBitsLSB(0xFFFE, 16);
+		bits.putBitsLSB(0xFFFD, 16);
+
+		writeCombBigTree(bits, tree, byteCodes, kCombLevels, 0, 0);
+		bits.putBit(0);
+	}
+
+	static void makeTree(Tree &tree, Random &rng, bool types) {
+		const uint leaves = (kCombLevels + 1) * 16;
+		static const uint32 blockTypes[] = { 0, 1, 3, 0, 1, 2 };
+
+		for (uint i = 0; i < leaves; i++) {
+			if (types) {
+				// Runs of up to eight blocks, and a colour for the fill blocks
+				tree.values.push_back(blockTypes[i % ARRAYSIZE(blockTypes)] | ((rng.next() % 8) << 2) | ((rng.next() & 0xFF) << 8));
+			} else {
+				tree.values.push_back(rng.next() % 0xFF00);
+			}
+		}
+	}
+
+	// Write the code of a random leaf, and return its value
+	static void writeValue(BitWriter &bits, const Tree &tree, Random &rng, uint32 &value) {
+		const uint index = rng.next() % tree.values.size();
+		value = tree.values[index];
+		writeCode(bits, tree.codes[index]);
+	}
+
+	static void writeUint32(Common::Array<byte> &data, uint32 value) {
+		byte buffer[4];
+		WRITE_LE_UINT32(buffer, value);
+		for (int i = 0; i < 4; i++)
+			data.push_back(buffer[i]);
+	}
+
+	// Encode a frame of random blocks, and draw them into the expected frame
+	static void makeFrame(BitWriter &bits, Tree *trees, Random &rng, byte *expected) {
+		Tree &mMap = trees[0], &mClr = trees[1], &full = trees[2], &type = trees[3];
+		const uint bw = kWidth / 4, blocks = bw * (kHeight / 4);
+		uint block = 0;
+		uint32 value;
+
+		while (block < blocks) {
+			writeValue(bits, type, rng, value);
+			uint run = ((value >> 2) & 0x3F) + 1;
+			const uint32 blockType = value & 3;
+			const byte fill = value >> 8;
+
+			uint mode = 0;
+			if (blockType == 1) {
+				mode = rng.next() % 3;
+				bits.putBit(mode == 1);
+				if (mode != 1)
+					bits.putBit(mode == 2);
+			}
+
+			for (; run && block < blocks; run--, block++) {
+				byte *out = expected + (block / bw) * kWidth * 4 + (block % bw) * 4;
+				uint32 p[8];
+
+				switch (blockType) {
+				case 0: {
+					uint32 clr, map;
+					writeValue(bits, mClr, rng, clr);
+					writeValue(bits, mMap, rng, map);
+					for (int y = 0; y < 4; y++, map >>= 4) {
+						for (int x = 0; x < 4; x++)
+							out[y * kWidth + x] = (map & (1 << x)) ? (clr >> 8) : (clr & 0xFF);
+					}
+					break;
+				}
+				case 1:
+					for (int i = 0; i < (mode == 1 ? 2 : mode == 2 ? 4 : 8); i++)
+						writeValue(bits, full, rng, p[i]);
+					for (int y = 0; y < 4; y++) {
+						byte *row = out + y * kWidth;
+						if (mode == 0) {
+							row[0] = p[y * 2 + 1] & 0xFF;
+							row[1] = p[y * 2 + 1] >> 8;
+							row[2] = p[y * 2] & 0xFF;
+							row[3] = p[y * 2] >> 8;
+						} else if (mode == 1) {
+							row[0] = row[1] = p[y / 2] & 0xFF;
+							row[2] = row[3] = p[y / 2] >> 8;
+						} else {
+							// The second pixel pair comes first
+							row[0] = p[(y / 2) * 2 + 1] & 0xFF;
+							row[1] = p[(y / 2) * 2 + 1] >> 8;
+							row[2] = p[(y / 2) * 2] & 0xFF;
+							row[3] = p[(y / 2) * 2] >> 8;
+						}
+					}
+					break;
+				case 3:
+					for (int y = 0; y < 4; y++)
+						memset(out + y * kWidth, fill, 4);
+					break;
+				default:
+					break;
+				}
+			}
+		}
+	}
+
+	static void makeSmacker(Common::Array<byte> &video, byte *expected) {
+		Random rng(1);
+		Tree trees[4];
+		for (int i = 0; i < 4; i++)
+			makeTree(trees[i], rng, i == 3);
+
+		BitWriter treeBits;
+		for (int i = 0; i < 4; i++)
+			writeBigTree(treeBits, trees[i]);
+
+		Common::Array<Common::Array<byte> > frames;
+		for (uint i = 0; i < kFrameCount; i++) {
+			BitWriter frameBits;
+			makeFrame(frameBits, trees, rng, expected);
+			frames.push_back(frameBits.getData());
+			// The frame sizes are multiples of four
+			while (frames.back().size() & 3)
+				frames.back().push_back(0);
+		}
+
+		const byte signature[] = { 'S', 'M', 'K', '4' };
+		for (int i = 0; i < 4; i++)
+			video.push_back(signature[i]);
+		writeUint32(video, kWidth);
+		writeUint32(video, kHeight);
+		writeUint32(video, kFrameCount);
+		writeUint32(video, 66);
+		// Flags
+		writeUint32(video, 0);
+		for (int i = 0; i < 7; i++)
+			writeUint32(video, 0);
+		writeUint32(video, treeBits.getData().size());
+		for (int i = 0; i < 4; i++)
+			writeUint32(video, kTreeAllocSize);
+		// No audio tracks
+		for (int i = 0; i < 7; i++)
+			writeUint32(video, 0);
+		writeUint32(video, 0);
+
+		for (uint i = 0; i < kFrameCount; i++)
+			writeUint32(video, frames[i].size());
+		for (uint i = 0; i < kFrameCount; i++)
+			video.push_back(0);
+
+		video.push_back(treeBits.getData());
+		for (uint i = 0; i < kFrameCount; i++)
+			video.push_back(frames[i]);
+	}
+
+public:
+	void test_smacker() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Array<byte> video;
+		byte *expected = new byte[kWidth * kHeight];
+		memset(expected, 0, kWidth * kHeight);
+		makeSmacker(video, expected);
+
+		byte *output = new byte[kWidth * kHeight];
+		bool loaded = true;
+		runMicrobench("video/smacker", 10, kWidth * kHeight * kFrameCount, [&]() {
+			Video::SmackerDecoder decoder;
+			loaded = loaded && decoder.loadStream(new Common::MemoryReadStream(&video[0], video.size()));
+
+			const Graphics::Surface *surface = nullptr;
+			for (uint i = 0; i < kFrameCount; i++)
+				surface = decoder.decodeNextFrame();
+
+			if (surface) {
+				for (uint y = 0; y < kHeight; y++)
+					memcpy(output + y * kWidth, surface->getBasePtr(0, y), kWidth);
+			}
+		});
+
+		TS_ASSERT(loaded);
+		TS_ASSERT_SAME_DATA(output, expected, kWidth * kHeight);
+
+		delete[] output;
+		delete[] expected;
+#endif
+	}
+};
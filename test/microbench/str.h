@@ -0,0 +1,68 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cxxtest/TestSuite.h>
+
+#include "helper.h"
+
+#include "common/str-builder.h"
+
+/**
+ * A line of HUD text, longer than the built-in capacity of String, built
+ * once per iteration the three ways the string code offers.
+ */
+class StringBenchmarkSuite : public CxxTest::TestSuite {
+	static const uint kIterations = 200000;
+
+public:
+	void test_str() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::String formatted;
+		runMicrobench("str/format", kIterations, 0, [&]() {
+			static uint i = 0;
+			i++;
+			formatted = Common::String::format("Score: %06d  Time: %02d:%02d  Speed: %.1f", i * 10, i / 60 % 60, i % 60, i * 0.5);
+		});
+
+		Common::String reused;
+		runMicrobench("str/formatTo", kIterations, 0, [&]() {
+			static uint i = 0;
+			i++;
+			Common::String::formatTo(reused, "Score: %06d  Time: %02d:%02d  Speed: %.1f", i * 10, i / 60 % 60, i % 60, i * 0.5);
+		});
+
+		Common::StringBuilder built;
+		runMicrobench("str/builder", kIterations, 0, [&]() {
+			static uint i = 0;
+			i++;
+			built.clear();
+			built.append("Score: ").appendUint(i * 10, 6, '0');
+			built.append("  Time: ").appendUint(i / 60 % 60, 2, '0').append(':').appendUint(i % 60, 2, '0');
+			built.append("  Speed: ").appendFloat(i * 0.5, 1);
+		});
+
+		TS_ASSERT_EQUALS(formatted, reused);
+		TS_ASSERT_EQUALS(formatted, built.toString());
+#endif
+	}
+};
@@ -0,0 +1,101 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cxxtest/TestSuite.h>
+
+#include "helper.h"
+
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+class YUVToRGBBenchmarkSuite : public CxxTest::TestSuite {
+	enum Subsampling {
+		k444,
+		k422,
+		k420,
+		k410
+	};
+
+	static void benchmarkConversion(Subsampling subsampling, const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale) {
+		static const char *const names[] = { "444", "422", "420", "410" };
+		static const int xShift[] = { 0, 1, 1, 2 };
+		static const int yShift[] = { 0, 0, 1, 2 };
+
+		// A DVD sized frame
+		const int width = 720, height = 480;
+		// The 410 conversion reads an extra row and column of chroma
+		const int uvWidth = (width >> xShift[subsampling]) + 1;
+		const int uvHeight = (height >> yShift[subsampling]) + 1;
+
+		byte *y = new byte[width * height];
+		byte *u = new byte[uvWidth * uvHeight];
+		byte *v = new byte[uvWidth * uvHeight];
+		fillMicrobenchData(y, width * height, 1);
+		fillMicrobenchData(u, uvWidth * uvHeight, 2);
+		fillMicrobenchData(v, uvWidth * uvHeight, 3);
+
+		Graphics::Surface dst;
+		dst.create(width, height, format);
+
+		const Common::String name = Common::String::format("yuv/%s/%dbpp/%s", names[subsampling], format.bytesPerPixel * 8,
+		                                                   scale == Graphics::YUVToRGBManager::kScaleFull ? "full" : "itu");
+		runMicrobench(name, 50, width * height * format.bytesPerPixel, [&]() {
+			switch (subsampling) {
+			case k444:
+				YUVToRGBMan.convert444(&dst, scale, y, u, v, width, height, width, uvWidth);
+				break;
+			case k422:
+				YUVToRGBMan.convert422(&dst, scale, y, u, v, width, height, width, uvWidth);
+				break;
+			case k420:
+				YUVToRGBMan.convert420(&dst, scale, y, u, v, width, height, width, uvWidth);
+				break;
+			case k410:
+				YUVToRGBMan.convert410(&dst, scale, y, u, v, width, height, width, uvWidth);
+				break;
+			}
+		});
+
+		dst.free();
+		delete[] y;
+		delete[] u;
+		delete[] v;
+	}
+
+public:
+	void test_yuv_to_rgb() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0)
+		};
+
+		for (int subsampling = k444; subsampling <= k410; subsampling++) {
+			for (int f = 0; f < ARRAYSIZE(formats); f++) {
+				benchmarkConversion((Subsampling)subsampling, formats[f], Graphics::YUVToRGBManager::kScaleITU);
+				benchmarkConversion((Subsampling)subsampling, formats[f], Graphics::YUVToRGBManager::kScaleFull);
+			}
+		}
+#endif
+	}
+};
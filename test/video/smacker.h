@@ -0,0 +1,321 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/endian.h"
+#include "common/memstream.h"
+#include "graphics/surface.h"
+#include "video/smk_decoder.h"
+
+#include "../null_osystem.h"
+
+/**
+ * There is no Smacker encoder in the tree, so the videos are built directly in
+ * the format of the decoder, and the expected frames are drawn along the way.
+ * The big Huffman trees have codes of up to 16 bits, longer than the 11 bits
+ * of the first level of their lookup tables.
+ *
+ * The test OSystem has no mixer, which the audio tracks need, so the videos
+ * have none.
+ */
+class SmackerTestSuite : public CxxTest::TestSuite {
+	static const uint kWidth = 64;
+	static const uint kHeight = 32;
+	static const uint kBlocks = (kWidth / 4) * (kHeight / 4);
+	// Each comb level adds a complete subtree of four levels
+	static const uint kCombLevels = 12;
+	static const uint kTreeAllocSize = 4096;
+
+	class Random {
+	public:
+		Random(uint32 seed) : _seed(seed) {}
+		uint32 next() {
+			_seed = _seed * 1103515245 + 12345;
+			return _seed >> 16;
+		}
+	private:
+		uint32 _seed;
+	};
+
+	// Packs bits starting with the least significant bit of each byte
+	class BitWriter {
+	public:
+		BitWriter() : _bitPos(0) {}
+
+		void putBit(uint bit) {
+			if (!(_bitPos & 7))
+				_data.push_back(0);
+			if (bit)
+				_data.back() |= 1 << (_bitPos & 7);
+			_bitPos++;
+		}
+
+		void putBitsLSB(uint32 value, int count) {
+			for (int i = 0; i < count; i++)
+				putBit((value >> i) & 1);
+		}
+
+		const Common::Array<byte> &getData() const { return _data; }
+
+	private:
+		Common::Array<byte> _data;
+		uint32 _bitPos;
+	};
+
+	// The code of a leaf, with its first bit in the least significant bit
+	struct Code {
+		uint32 bits;
+		uint length;
+	};
+
+	typedef Common::Array<Code> CodeList;
+
+	// A tree with a leaf for each of its values
+	struct Tree {
+		Common::Array<uint32> values;
+		CodeList codes;
+	};
+
+	static void addLeaf(CodeList &codes, uint32 code, uint length) {
+		Code leaf = { code, length };
+		codes.push_back(leaf);
+	}
+
+	// Write the shape of a complete small tree, with its leaves holding their index
+	static void writeSmallTree(BitWriter &bits, CodeList &codes, uint levels, uint32 code = 0, uint length = 0) {
+		if (!levels) {
+			bits.putBit(0);
+			bits.putBitsLSB(codes.size(), 8);
+			addLeaf(codes, code, length);
+			return;
+		}
+
+		bits.putBit(1);
+		writeSmallTree(bits, codes, levels - 1, code, length + 1);
+		writeSmallTree(bits, codes, levels - 1, code | (1 << length), length + 1);
+	}
+
+	static void writeCode(BitWriter &bits, const Code &code) {
+		bits.putBitsLSB(code.bits, code.length);
+	}
+
+	static void writeCompleteBigTree(BitWriter &bits, Tree &tree, const CodeList &byteCodes, uint levels, uint32 code, uint length) {
+		if (!levels) {
+			// The values of the leaves are written as codes of the small trees
+			const uint32 value = tree.values[tree.codes.size()];
+			bits.putBit(0);
+			writeCode(bits, byteCodes[value & 0xFF]);
+			writeCode(bits, byteCodes[value >> 8]);
+			addLeaf(tree.codes, code, length);
+			return;
+		}
+
+		bits.putBit(1);
+		writeCompleteBigTree(bits, tree, byteCodes, levels - 1, code, length + 1);
+		writeCompleteBigTree(bits, tree, byteCodes, levels - 1, code | (1 << length), length + 1);
+	}
+
+	static void writeCombBigTree(BitWriter &bits, Tree &tree, const CodeList &byteCodes, uint combLevels, uint32 code, uint length) {
+		if (!combLevels) {
+			writeCompleteBigTree(bits, tree, byteCodes, 4, code, length);
+			return;
+		}
+
+		bits.putBit(1);
+		writeCompleteBigTree(bits, tree, byteCodes, 4, code, length + 1);
+		writeCombBigTree(bits, tree, byteCodes, combLevels - 1, code | (1 << length), length + 1);
+	}
+
+	static void writeBigTree(BitWriter &bits, Tree &tree) {
+		CodeList byteCodes;
+
+		bits.putBit(1);
+		for (int i = 0; i < 2; i++) {
+			byteCodes.clear();
+			bits.putBit(1);
+			writeSmallTree(bits, byteCodes, 8);
+			bits.putBit(0);
+		}
+
+		// Markers which don't match any value, so the decoded values are
+		// always those of the leaves
+		bits.putBitsLSB(0xFFFF, 16);
+		bits.putBitsLSB(0xFFFE, 16);
+		bits.putBitsLSB(0xFFFD, 16);
+
+		writeCombBigTree(bits, tree, byteCodes, kCombLevels, 0, 0);
+		bits.putBit(0);
+	}
+
+	static void makeTree(Tree &tree, Random &rng, bool types) {
+		const uint leaves = (kCombLevels + 1) * 16;
+
+		for (uint i = 0; i < leaves; i++) {
+			if (types) {
+				// Alternating mono and fill blocks, in runs of up to eight
+				// blocks, with a colour for the fill blocks
+				tree.values.push_back((i & 1 ? 3 : 0) | ((rng.next() % 8) << 2) | ((rng.next() & 0xFF) << 8));
+			} else {
+				tree.values.push_back(rng.next() % 0xFF00);
+			}
+		}
+	}
+
+	static uint32 writeValue(BitWriter &bits, const Tree &tree, uint index) {
+		writeCode(bits, tree.codes[index]);
+		return tree.values[index];
+	}
+
+	static void drawMonoBlock(byte *expected, uint block, uint32 clr, uint32 map) {
+		byte *out = expected + (block / (kWidth / 4)) * kWidth * 4 + (block % (kWidth / 4)) * 4;
+		for (int y = 0; y < 4; y++, map >>= 4) {
+			for (int x = 0; x < 4; x++)
+				out[y * kWidth + x] = (map & (1 << x)) ? (clr >> 8) : (clr & 0xFF);
+		}
+	}
+
+	static void drawFillBlock(byte *expected, uint block, byte fill) {
+		byte *out = expected + (block / (kWidth / 4)) * kWidth * 4 + (block % (kWidth / 4)) * 4;
+		for (int y = 0; y < 4; y++)
+			memset(out + y * kWidth, fill, 4);
+	}
+
+	/**
+	 * Encode a frame of random blocks, and draw them into the expected frame.
+	 * The data of the frame stops after the given number of blocks, after
+	 * which the decoder reads zero bits, so the codes of the first leaves.
+	 */
+	static void makeFrame(BitWriter &bits, Tree *trees, Random &rng, byte *expected, uint writtenBlocks) {
+		Tree &mMap = trees[0], &mClr = trees[1], &type = trees[3];
+		uint block = 0;
+		// The first codes of each tree are the longest ones
+		bool longestType = true, longestMono = true;
+
+		while (block < kBlocks) {
+			uint index = longestType ? type.values.size() - 1 : rng.next() % type.values.size();
+			longestType = false;
+			const uint32 value = block < writtenBlocks ? writeValue(bits, type, index) : type.values[0];
+			uint run = ((value >> 2) & 0x3F) + 1;
+
+			for (; run && block < kBlocks; run--, block++) {
+				if (value & 3) {
+					drawFillBlock(expected, block, value >> 8);
+					continue;
+				}
+
+				if (block < writtenBlocks) {
+					index = longestMono ? mClr.values.size() - 1 : rng.next() % mClr.values.size();
+					longestMono = false;
+					const uint32 clr = writeValue(bits, mClr, index);
+					const uint32 map = writeValue(bits, mMap, index);
+					drawMonoBlock(expected, block, clr, map);
+				} else {
+					drawMonoBlock(expected, block, mClr.values[0], mMap.values[0]);
+				}
+			}
+		}
+	}
+
+	static void writeUint32(Common::Array<byte> &data, uint32 value) {
+		byte buffer[4];
+		WRITE_LE_UINT32(buffer, value);
+		for (int i = 0; i < 4; i++)
+			data.push_back(buffer[i]);
+	}
+
+	// Build a video with the given number of blocks written for each frame,
+	// and the expected frames one after the other
+	static void makeSmacker(Common::Array<byte> &video, byte *expected, const uint *writtenBlocks, uint frameCount) {
+		Random rng(1);
+		Tree trees[4];
+		for (int i = 0; i < 4; i++)
+			makeTree(trees[i], rng, i == 3);
+
+		BitWriter treeBits;
+		for (int i = 0; i < 4; i++)
+			writeBigTree(treeBits, trees[i]);
+
+		Common::Array<Common::Array<byte> > frames;
+		for (uint i = 0; i < frameCount; i++) {
+			byte *frame = expected + i * kWidth * kHeight;
+			if (i)
+				memcpy(frame, frame - kWidth * kHeight, kWidth * kHeight);
+
+			BitWriter frameBits;
+			makeFrame(frameBits, trees, rng, frame, writtenBlocks[i]);
+			frames.push_back(frameBits.getData());
+			// The frame sizes are multiples of four
+			while (frames.back().size() & 3)
+				frames.back().push_back(0);
+		}
+
+		const byte signature[] = { 'S', 'M', 'K', '4' };
+		for (int i = 0; i < 4; i++)
+			video.push_back(signature[i]);
+		writeUint32(video, kWidth);
+		writeUint32(video, kHeight);
+		writeUint32(video, frameCount);
+		writeUint32(video, 66);
+		// Flags
+		writeUint32(video, 0);
+		for (int i = 0; i < 7; i++)
+			writeUint32(video, 0);
+		writeUint32(video, treeBits.getData().size());
+		for (int i = 0; i < 4; i++)
+			writeUint32(video, kTreeAllocSize);
+		// No audio tracks
+		for (int i = 0; i < 7; i++)
+			writeUint32(video, 0);
+		writeUint32(video, 0);
+
+		for (uint i = 0; i < frameCount; i++)
+			writeUint32(video, frames[i].size());
+		for (uint i = 0; i < frameCount; i++)
+			video.push_back(0);
+
+		video.push_back(treeBits.getData());
+		for (uint i = 0; i < frameCount; i++)
+			video.push_back(frames[i]);
+	}
+
+	static void checkVideo(const uint *writtenBlocks, uint frameCount) {
+		Common::install_null_g_system();
+
+		Common::Array<byte> video;
+		byte *expected = new byte[kWidth * kHeight * frameCount];
+		memset(expected, 0, kWidth * kHeight);
+		makeSmacker(video, expected, writtenBlocks, frameCount);
+
+		Video::SmackerDecoder decoder;
+		TS_ASSERT(decoder.loadStream(new Common::MemoryReadStream(&video[0], video.size())));
+
+		for (uint i = 0; i < frameCount; i++) {
+			const Graphics::Surface *surface = decoder.decodeNextFrame();
+			TS_ASSERT(surface);
+			if (!surface)
+				break;
+
+			bool matches = true;
+			for (uint y = 0; y < kHeight; y++)
+				matches = matches && !memcmp(surface->getBasePtr(0, y), expected + (i * kHeight + y) * kWidth, kWidth);
+			TS_ASSERT(matches);
+		}
+
+		delete[] expected;
+	}
+
+public:
+	void test_frames() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		const uint writtenBlocks[] = { kBlocks, kBlocks, kBlocks };
+		checkVideo(writtenBlocks, ARRAYSIZE(writtenBlocks));
+#endif
+	}
+
+	void test_truncated_frame() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		// The data of the second frame stops halfway through
+		const uint writtenBlocks[] = { kBlocks, kBlocks / 2, kBlocks };
+		checkVideo(writtenBlocks, ARRAYSIZE(writtenBlocks));
+#endif
+	}
+};
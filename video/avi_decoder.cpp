@@ -703,55 +703,26 @@ bool AVIDecoder::seekIntern(const Audio::Timestamp &time) {
 	// Reset any palette, if necessary
 	videoTrack->useInitialPalette();
 
-	int lastKeyFrame = -1;
-	int frameIndex = -1;
-	uint curFrame = 0;
+	// Figure out where we should be
+	const int frameIndex = _indexEntries.findFramePos(videoIndex, frame);
 
-	// Go through and figure out where we should be
-	// If there's a palette, we need to find the palette too
-	for (uint32 i = 0; i < _indexEntries.size(); i++) {
-		const OldIndex &index = _indexEntries[i];
-
-		// We don't care about RECs
-		if (index.id == ID_REC)
-			continue;
-
-		// We're only looking at entries for this track
-		if (getStreamIndex(index.id) != videoIndex)
-			continue;
-
-		uint16 streamType = getStreamType(index.id);
-
-		if (streamType == kStreamTypePaletteChange) {
-			// We need to handle any palette change we see since there's no
-			// flag to tell if this is a "key" palette.
-			// Decode the palette
-			_fileStream->seek(_indexEntries[i].offset + 8);
-			Common::SeekableReadStream *chunk = 0;
-
-			if (_indexEntries[i].size != 0)
-				chunk = _fileStream->readStream(_indexEntries[i].size);
+	if (frameIndex < 0) // This shouldn't happen.
+		return false;
 
-			videoTrack->loadPaletteFromChunk(chunk);
-		} else {
-			// Check to see if this is a keyframe
-			// The first frame has to be a keyframe
-			if ((_indexEntries[i].flags & AVIIF_INDEX) || curFrame == 0)
-				lastKeyFrame = i;
+	// We need to handle any palette change before the frame since there's
+	// no flag to tell if this is a "key" palette.
+	const Common::Array<uint32> &palettes = _indexEntries.getPalettePositions(videoIndex);
+	for (uint32 i = 0; i < palettes.size() && palettes[i] < (uint32)frameIndex; i++) {
+		// Decode the palette
+		_fileStream->seek(_indexEntries[palettes[i]].offset + 8);
+		Common::SeekableReadStream *chunk = 0;
 
-			// Did we find the target frame?
-			if (frame == curFrame) {
-				frameIndex = i;
-				break;
-			}
+		if (_indexEntries[palettes[i]].size != 0)
+			chunk = _fileStream->readStream(_indexEntries[palettes[i]].size);
 
-			curFrame++;
-		}
+		videoTrack->loadPaletteFromChunk(chunk);
 	}
 
-	if (frameIndex < 0) // This shouldn't happen.
-		return false;
-
 	// Update all the audio tracks
 	for (uint32 i = 0; i < _audioTracks.size(); i++) {
 		AVIAudioTrack *audioTrack = (AVIAudioTrack *)_audioTracks[i].track;
@@ -762,25 +733,13 @@ bool AVIDecoder::seekIntern(const Audio::Timestamp &time) {
 		// Set the chunk index for the track
 		audioTrack->setCurChunk(frame);
 
-		uint32 chunksFound = 0;
-		for (uint32 j = 0; j < _indexEntries.size(); j++) {
+		const int j = _indexEntries.findPos(_audioTracks[i].index, frame);
+		if (j >= 0) {
 			const OldIndex &index = _indexEntries[j];
-
-			// Continue ignoring RECs
-			if (index.id == ID_REC)
-				continue;
-
-			if (getStreamIndex(index.id) == _audioTracks[i].index) {
-				if (chunksFound == frame) {
-					_fileStream->seek(index.offset + 8);
-					Common::SeekableReadStream *audioChunk = _fileStream->readStream(index.size);
-					audioTrack->queueSound(audioChunk);
-					_audioTracks[i].chunkSearchOffset = (j == _indexEntries.size() - 1) ? _movieListEnd : _indexEntries[j + 1].offset;
-					break;
-				}
-
-				chunksFound++;
-			}
+			_fileStream->seek(index.offset + 8);
+			Common::SeekableReadStream *audioChunk = _fileStream->readStream(index.size);
+			audioTrack->queueSound(audioChunk);
+			_audioTracks[i].chunkSearchOffset = ((uint32)j == _indexEntries.size() - 1) ? _movieListEnd : _indexEntries[j + 1].offset;
 		}
 
 		// Skip any audio to bring us to the right time
@@ -788,25 +747,15 @@ bool AVIDecoder::seekIntern(const Audio::Timestamp &time) {
 	}
 
 	// Decode from keyFrame to curFrame - 1
-	for (int i = lastKeyFrame; i < frameIndex; i++) {
-		if (_indexEntries[i].id == ID_REC)
-			continue;
-
-		if (getStreamIndex(_indexEntries[i].id) != videoIndex)
-			continue;
-
-		uint16 streamType = getStreamType(_indexEntries[i].id);
-
-		// Ignore palettes, they were already handled
-		if (streamType == kStreamTypePaletteChange)
-			continue;
+	for (uint i = _indexEntries.findKeyFrame(videoIndex, frame); i < frame; i++) {
+		const OldIndex &index = _indexEntries[_indexEntries.findFramePos(videoIndex, i)];
 
 		// Frame, hopefully
-		_fileStream->seek(_indexEntries[i].offset + 8);
+		_fileStream->seek(index.offset + 8);
 		Common::SeekableReadStream *chunk = 0;
 
-		if (_indexEntries[i].size != 0)
-			chunk = _fileStream->readStream(_indexEntries[i].size);
+		if (index.size != 0)
+			chunk = _fileStream->readStream(index.size);
 
 		videoTrack->decodeFrame(chunk);
 	}
@@ -909,6 +858,8 @@ void AVIDecoder::readOldIndex(uint32 size) {
 		_indexEntries.push_back(indexEntry);
 		debugC(7, kDebugLevelGVideo, "Index %d: Tag '%s', Offset = %d, Size = %d (Flags = %d)", i, tag2str(indexEntry.id), indexEntry.offset, indexEntry.size, indexEntry.flags);
 	}
+
+	_indexEntries.buildLookup();
 }
 
 void AVIDecoder::checkTruemotion1() {
@@ -1223,16 +1174,78 @@ void AVIDecoder::AVIAudioTrack::createAudioStream() {
 AVIDecoder::TrackStatus::TrackStatus() : track(0), chunkSearchOffset(0) {
 }
 
-AVIDecoder::OldIndex *AVIDecoder::IndexEntries::find(uint index, uint frameNumber) {
-	for (uint idx = 0, frameCtr = 0; idx < size(); ++idx) {
-		if ((*this)[idx].id != ID_REC &&
-				AVIDecoder::getStreamIndex((*this)[idx].id) == index) {
-			if (frameCtr++ == frameNumber)
-				return &(*this)[idx];
+void AVIDecoder::IndexEntries::buildLookup() {
+	_streams.clear();
+
+	for (uint idx = 0; idx < size(); ++idx) {
+		const OldIndex &entry = (*this)[idx];
+		if (entry.id == ID_REC)
+			continue;
+
+		const uint index = AVIDecoder::getStreamIndex(entry.id);
+		if (index >= _streams.size())
+			_streams.resize(index + 1);
+
+		StreamLookup &stream = _streams[index];
+		stream.entries.push_back(idx);
+
+		if ((entry.id & 0xFFFF) == kStreamTypePaletteChange) {
+			stream.palettes.push_back(idx);
+		} else {
+			// The first frame has to be a keyframe
+			if ((entry.flags & AVIIF_INDEX) || stream.frames.empty())
+				stream.keyFrames.push_back(stream.frames.size());
+
+			stream.frames.push_back(idx);
 		}
 	}
+}
+
+void AVIDecoder::IndexEntries::clear() {
+	Common::Array<OldIndex>::clear();
+	_streams.clear();
+}
+
+AVIDecoder::OldIndex *AVIDecoder::IndexEntries::find(uint index, uint frameNumber) {
+	const int pos = findPos(index, frameNumber);
+	return pos >= 0 ? &(*this)[pos] : nullptr;
+}
+
+int AVIDecoder::IndexEntries::findPos(uint index, uint frameNumber) const {
+	if (index >= _streams.size() || frameNumber >= _streams[index].entries.size())
+		return -1;
+
+	return _streams[index].entries[frameNumber];
+}
+
+int AVIDecoder::IndexEntries::findFramePos(uint index, uint frameNumber) const {
+	if (index >= _streams.size() || frameNumber >= _streams[index].frames.size())
+		return -1;
+
+	return _streams[index].frames[frameNumber];
+}
+
+uint AVIDecoder::IndexEntries::findKeyFrame(uint index, uint frameNumber) const {
+	if (index >= _streams.size())
+		return frameNumber;
+
+	// Binary search for the last key frame not after frameNumber
+	const Common::Array<uint32> &keyFrames = _streams[index].keyFrames;
+	uint low = 0, high = keyFrames.size();
+	while (low < high) {
+		const uint mid = (low + high) / 2;
+		if (keyFrames[mid] <= frameNumber)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+
+	return low ? keyFrames[low - 1] : frameNumber;
+}
 
-	return nullptr;
+const Common::Array<uint32> &AVIDecoder::IndexEntries::getPalettePositions(uint index) const {
+	assert(index < _streams.size());
+	return _streams[index].palettes;
 }
 
 } // End of namespace Video
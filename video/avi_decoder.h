@@ -318,9 +318,40 @@ protected:
 		uint32 chunkSearchOffset;
 	};
 
+	/**
+	 * The entries of the old style index, with per-stream lookup tables so
+	 * seeking doesn't need to walk the whole index.
+	 */
 	class IndexEntries : public Common::Array<OldIndex> {
 	public:
+		/** Set up the lookup tables, once all entries have been added. */
+		void buildLookup();
+		void clear();
+
+		/** Find the frameNumber-th entry of a stream, counting palette changes. */
 		OldIndex *find(uint index, uint frameNumber);
+
+		/** Index of the frameNumber-th entry of a stream, or -1. */
+		int findPos(uint index, uint frameNumber) const;
+
+		/** Index of the frameNumber-th frame of a stream, not counting palette changes, or -1. */
+		int findFramePos(uint index, uint frameNumber) const;
+
+		/** The last key frame of a stream at or before the given frame. */
+		uint findKeyFrame(uint index, uint frameNumber) const;
+
+		/** Indices of the palette changes of a stream with entries, in order. */
+		const Common::Array<uint32> &getPalettePositions(uint index) const;
+
+	private:
+		struct StreamLookup {
+			Common::Array<uint32> entries;   ///< All entries of the stream
+			Common::Array<uint32> frames;    ///< The entries which aren't palette changes
+			Common::Array<uint32> keyFrames; ///< Numbers of the frames which are key frames
+			Common::Array<uint32> palettes;  ///< The palette change entries
+		};
+
+		Common::Array<StreamLookup> _streams;
 	};
 
 	AVIHeader _header;
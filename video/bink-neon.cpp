@@ -0,0 +1,134 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "video/bink_intern.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Video {
+
+static inline void neon_transpose(int32x4_t &r0, int32x4_t &r1, int32x4_t &r2, int32x4_t &r3) {
+	const int32x4x2_t t01 = vtrnq_s32(r0, r1);
+	const int32x4x2_t t23 = vtrnq_s32(r2, r3);
+	r0 = vcombine_s32(vget_low_s32(t01.val[0]), vget_low_s32(t23.val[0]));
+	r1 = vcombine_s32(vget_low_s32(t01.val[1]), vget_low_s32(t23.val[1]));
+	r2 = vcombine_s32(vget_high_s32(t01.val[0]), vget_high_s32(t23.val[0]));
+	r3 = vcombine_s32(vget_high_s32(t01.val[1]), vget_high_s32(t23.val[1]));
+}
+
+// The same butterflies as IDCT_TRANSFORM in bink_decoder.cpp, for four
+// columns at once
+template<bool munge>
+static inline void neon_idct8(int32x4_t *v) {
+	const int32x4_t a0 = vaddq_s32(v[0], v[4]);
+	const int32x4_t a1 = vsubq_s32(v[0], v[4]);
+	const int32x4_t a2 = vaddq_s32(v[2], v[6]);
+	const int32x4_t a3 = vshrq_n_s32(vmulq_n_s32(vsubq_s32(v[2], v[6]), 2896), 11);
+	const int32x4_t a4 = vaddq_s32(v[5], v[3]);
+	const int32x4_t a5 = vsubq_s32(v[5], v[3]);
+	const int32x4_t a6 = vaddq_s32(v[1], v[7]);
+	const int32x4_t a7 = vsubq_s32(v[1], v[7]);
+	const int32x4_t b0 = vaddq_s32(a4, a6);
+	const int32x4_t b1 = vshrq_n_s32(vmulq_n_s32(vaddq_s32(a5, a7), 3784), 11);
+	const int32x4_t b2 = vaddq_s32(vsubq_s32(vshrq_n_s32(vmulq_n_s32(a5, -5352), 11), b0), b1);
+	const int32x4_t b3 = vsubq_s32(vshrq_n_s32(vmulq_n_s32(vsubq_s32(a6, a4), 2896), 11), b2);
+	const int32x4_t b4 = vsubq_s32(vaddq_s32(vshrq_n_s32(vmulq_n_s32(a7, 2217), 11), b3), b1);
+
+	const int32x4_t c0 = vaddq_s32(a0, a2);
+	const int32x4_t c1 = vsubq_s32(vaddq_s32(a1, a3), a2);
+	const int32x4_t c2 = vaddq_s32(vsubq_s32(a1, a3), a2);
+	const int32x4_t c3 = vsubq_s32(a0, a2);
+
+	v[0] = vaddq_s32(c0, b0);
+	v[1] = vaddq_s32(c1, b2);
+	v[2] = vaddq_s32(c2, b3);
+	v[3] = vsubq_s32(c3, b4);
+	v[4] = vaddq_s32(c3, b4);
+	v[5] = vsubq_s32(c2, b3);
+	v[6] = vsubq_s32(c1, b2);
+	v[7] = vsubq_s32(c0, b0);
+
+	if (munge) {
+		const int32x4_t bias = vdupq_n_s32(0x7F);
+		for (int i = 0; i < 8; i++)
+			v[i] = vshrq_n_s32(vaddq_s32(v[i], bias), 8);
+	}
+}
+
+void binkIDCTNEON(int32 *block) {
+	int32x4_t v[8];
+
+	// Columns, four at a time
+	for (int half = 0; half < 2; half++) {
+		for (int i = 0; i < 8; i++)
+			v[i] = vld1q_s32(block + i * 8 + half * 4);
+
+		neon_idct8<false>(v);
+
+		for (int i = 0; i < 8; i++)
+			vst1q_s32(block + i * 8 + half * 4, v[i]);
+	}
+
+	// Rows, transposed so that four rows are transformed at a time
+	for (int half = 0; half < 2; half++) {
+		int32 *rows = block + half * 32;
+		for (int i = 0; i < 8; i++)
+			v[i] = vld1q_s32(rows + (i & 3) * 8 + (i & 4));
+		neon_transpose(v[0], v[1], v[2], v[3]);
+		neon_transpose(v[4], v[5], v[6], v[7]);
+
+		neon_idct8<true>(v);
+
+		neon_transpose(v[0], v[1], v[2], v[3]);
+		neon_transpose(v[4], v[5], v[6], v[7]);
+		for (int i = 0; i < 8; i++)
+			vst1q_s32(rows + (i & 3) * 8 + (i & 4), v[i]);
+	}
+}
+
+} // End of namespace Video
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
@@ -0,0 +1,139 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "video/bink_intern.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Video {
+
+// There is no 32 bit multiplication in SSE2, so multiply the even and odd
+// lanes separately and keep the low halves of the products
+static FORCEINLINE __m128i sse2_mulConst(__m128i a, int c) {
+	const __m128i constant = _mm_set1_epi32(c);
+	const __m128i even = _mm_mul_epu32(a, constant);
+	const __m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), constant);
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+static FORCEINLINE void sse2_transpose(__m128i &r0, __m128i &r1, __m128i &r2, __m128i &r3) {
+	const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+	const __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+	const __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+	const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+	r0 = _mm_unpacklo_epi64(t0, t1);
+	r1 = _mm_unpackhi_epi64(t0, t1);
+	r2 = _mm_unpacklo_epi64(t2, t3);
+	r3 = _mm_unpackhi_epi64(t2, t3);
+}
+
+// The same butterflies as IDCT_TRANSFORM in bink_decoder.cpp, for four
+// columns at once
+template<bool munge>
+static FORCEINLINE void sse2_idct8(__m128i *v) {
+	const __m128i a0 = _mm_add_epi32(v[0], v[4]);
+	const __m128i a1 = _mm_sub_epi32(v[0], v[4]);
+	const __m128i a2 = _mm_add_epi32(v[2], v[6]);
+	const __m128i a3 = _mm_srai_epi32(sse2_mulConst(_mm_sub_epi32(v[2], v[6]), 2896), 11);
+	const __m128i a4 = _mm_add_epi32(v[5], v[3]);
+	const __m128i a5 = _mm_sub_epi32(v[5], v[3]);
+	const __m128i a6 = _mm_add_epi32(v[1], v[7]);
+	const __m128i a7 = _mm_sub_epi32(v[1], v[7]);
+	const __m128i b0 = _mm_add_epi32(a4, a6);
+	const __m128i b1 = _mm_srai_epi32(sse2_mulConst(_mm_add_epi32(a5, a7), 3784), 11);
+	const __m128i b2 = _mm_add_epi32(_mm_sub_epi32(_mm_srai_epi32(sse2_mulConst(a5, -5352), 11), b0), b1);
+	const __m128i b3 = _mm_sub_epi32(_mm_srai_epi32(sse2_mulConst(_mm_sub_epi32(a6, a4), 2896), 11), b2);
+	const __m128i b4 = _mm_sub_epi32(_mm_add_epi32(_mm_srai_epi32(sse2_mulConst(a7, 2217), 11), b3), b1);
+
+	const __m128i c0 = _mm_add_epi32(a0, a2);
+	const __m128i c1 = _mm_sub_epi32(_mm_add_epi32(a1, a3), a2);
+	const __m128i c2 = _mm_add_epi32(_mm_sub_epi32(a1, a3), a2);
+	const __m128i c3 = _mm_sub_epi32(a0, a2);
+
+	v[0] = _mm_add_epi32(c0, b0);
+	v[1] = _mm_add_epi32(c1, b2);
+	v[2] = _mm_add_epi32(c2, b3);
+	v[3] = _mm_sub_epi32(c3, b4);
+	v[4] = _mm_add_epi32(c3, b4);
+	v[5] = _mm_sub_epi32(c2, b3);
+	v[6] = _mm_sub_epi32(c1, b2);
+	v[7] = _mm_sub_epi32(c0, b0);
+
+	if (munge) {
+		const __m128i bias = _mm_set1_epi32(0x7F);
+		for (int i = 0; i < 8; i++)
+			v[i] = _mm_srai_epi32(_mm_add_epi32(v[i], bias), 8);
+	}
+}
+
+void binkIDCTSSE2(int32 *block) {
+	__m128i v[8];
+
+	// Columns, four at a time
+	for (int half = 0; half < 2; half++) {
+		for (int i = 0; i < 8; i++)
+			v[i] = _mm_loadu_si128((const __m128i *)(block + i * 8 + half * 4));
+
+		sse2_idct8<false>(v);
+
+		for (int i = 0; i < 8; i++)
+			_mm_storeu_si128((__m128i *)(block + i * 8 + half * 4), v[i]);
+	}
+
+	// Rows, transposed so that four rows are transformed at a time
+	for (int half = 0; half < 2; half++) {
+		int32 *rows = block + half * 32;
+		for (int i = 0; i < 8; i++)
+			v[i] = _mm_loadu_si128((const __m128i *)(rows + (i & 3) * 8 + (i & 4)));
+		sse2_transpose(v[0], v[1], v[2], v[3]);
+		sse2_transpose(v[4], v[5], v[6], v[7]);
+
+		sse2_idct8<true>(v);
+
+		sse2_transpose(v[0], v[1], v[2], v[3]);
+		sse2_transpose(v[4], v[5], v[6], v[7]);
+		for (int i = 0; i < 8; i++)
+			_mm_storeu_si128((__m128i *)(rows + (i & 3) * 8 + (i & 4)), v[i]);
+	}
+}
+
+} // End of namespace Video
+
+#if !defined(__x86_64__)
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+#endif
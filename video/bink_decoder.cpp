@@ -35,6 +35,7 @@
 #include "common/str.h"
 #include "common/bitstream.h"
 #include "common/compression/huffman.h"
+#include "common/jobs.h"
 #include "common/system.h"
 
 #include "graphics/yuv_to_rgb.h"
@@ -45,6 +46,7 @@
 
 #include "video/binkdata.h"
 #include "video/bink_decoder.h"
+#include "video/bink_intern.h"
 
 static const uint32 kBIKfID = MKTAG('B', 'I', 'K', 'f');
 static const uint32 kBIKgID = MKTAG('B', 'I', 'K', 'g');
@@ -243,9 +245,19 @@ BinkDecoder::AudioInfo::~AudioInfo() {
 }
 
 BinkDecoder::BinkVideoTrack::BinkVideoTrack(uint32 width, uint32 height, uint32 frameCount, const Common::Rational &frameRate, bool swapPlanes, bool hasAlpha, uint32 id) :
-		_frameCount(frameCount), _frameRate(frameRate), _swapPlanes(swapPlanes), _hasAlpha(hasAlpha), _id(id), _surface(nullptr) {
+		_frameCount(frameCount), _frameRate(frameRate), _swapPlanes(swapPlanes), _hasAlpha(hasAlpha), _yuvOutput(false), _id(id), _surface(nullptr),
+		_idct(binkIDCTGeneric), _jobSystem(g_system->getJobSystem()) {
 	_curFrame = -1;
 
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		_idct = binkIDCTNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		_idct = binkIDCTSSE2;
+#endif
+
 	for (int i = 0; i < 16; i++)
 		_huffman[i] = 0;
 
@@ -449,7 +461,7 @@ bool BinkDecoder::BinkVideoTrack::rewind() {
 void BinkDecoder::BinkVideoTrack::decodePacket(VideoFrame &frame) {
 	assert(frame.bits);
 
-	if (!_surface) {
+	if (!_surface && !_yuvOutput) {
 		_surface = new Graphics::Surface();
 		_surface->create(_surfaceWidth, _surfaceHeight, _pixelFormat);
 		// Since we over-allocate to make surfaces even-sized
@@ -478,26 +490,64 @@ void BinkDecoder::BinkVideoTrack::decodePacket(VideoFrame &frame) {
 			break;
 	}
 
-	// Convert the YUV data we have to our format
-	// The width used here is the surface-width, and not the video-width
-	// to allow for odd-sized videos.
-	if (_hasAlpha) {
-		assert(_curPlanes[0] && _curPlanes[1] && _curPlanes[2] && _curPlanes[3]);
-		YUVToRGBMan.convert420Alpha(_surface, Graphics::YUVToRGBManager::kScaleITU, _curPlanes[0], _curPlanes[1], _curPlanes[2], _curPlanes[3],
-				_surfaceWidth, _surfaceHeight, _yBlockWidth * 8, _uvBlockWidth * 8);
-	} else {
-		assert(_curPlanes[0] && _curPlanes[1] && _curPlanes[2]);
-		YUVToRGBMan.convert420(_surface, Graphics::YUVToRGBManager::kScaleITU, _curPlanes[0], _curPlanes[1], _curPlanes[2],
-				_surfaceWidth, _surfaceHeight, _yBlockWidth * 8, _uvBlockWidth * 8);
+	// Convert the YUV data we have to our format, in bands of rows on the
+	// job system. The first band also sets up the conversion tables, which
+	// must not happen concurrently.
+	if (!_yuvOutput) {
+		const uint rowPairs = _surfaceHeight / 2;
+		const uint firstBand = MIN<uint>(rowPairs, kConvertBandRowPairs);
+
+		convertRows(0, firstBand);
+		if (firstBand < rowPairs)
+			_jobSystem->parallelFor(rowPairs - firstBand, convertBands, this, kConvertBandRowPairs);
 	}
 
 	// And swap the planes with the reference planes
 	for (int i = 0; i < 4; i++)
 		SWAP(_curPlanes[i], _oldPlanes[i]);
 
+	// The reference planes are only read while decoding the next frame
+	_yuvImage.y = _oldPlanes[0];
+	_yuvImage.u = _oldPlanes[1];
+	_yuvImage.v = _oldPlanes[2];
+	_yuvImage.yPitch = _yBlockWidth * 8;
+	_yuvImage.uvPitch = _uvBlockWidth * 8;
+	_yuvImage.width = _width;
+	_yuvImage.height = _height;
+
 	_curFrame++;
 }
 
+void BinkDecoder::BinkVideoTrack::convertBands(uint begin, uint end, void *refCon) {
+	// Skip the band already converted by decodePacket()
+	((BinkVideoTrack *)refCon)->convertRows(begin + kConvertBandRowPairs, end + kConvertBandRowPairs);
+}
+
+void BinkDecoder::BinkVideoTrack::convertRows(uint beginPair, uint endPair) {
+	const uint y = beginPair * 2;
+	const uint height = (endPair - beginPair) * 2;
+
+	// The width used here is the surface-width, and not the video-width
+	// to allow for odd-sized videos.
+	Graphics::Surface band;
+	band.init(_surface->w, height, _surface->pitch, _surface->getBasePtr(0, y), _surface->format);
+
+	const uint yPitch = _yBlockWidth * 8;
+	const uint uvPitch = _uvBlockWidth * 8;
+	const uint yOffset = y * yPitch;
+	const uint uvOffset = beginPair * uvPitch;
+
+	if (_hasAlpha) {
+		assert(_curPlanes[0] && _curPlanes[1] && _curPlanes[2] && _curPlanes[3]);
+		YUVToRGBMan.convert420Alpha(&band, Graphics::YUVToRGBManager::kScaleITU, _curPlanes[0] + yOffset, _curPlanes[1] + uvOffset,
+				_curPlanes[2] + uvOffset, _curPlanes[3] + yOffset, _surfaceWidth, height, yPitch, uvPitch);
+	} else {
+		assert(_curPlanes[0] && _curPlanes[1] && _curPlanes[2]);
+		YUVToRGBMan.convert420(&band, Graphics::YUVToRGBManager::kScaleITU, _curPlanes[0] + yOffset, _curPlanes[1] + uvOffset,
+				_curPlanes[2] + uvOffset, _surfaceWidth, height, yPitch, uvPitch);
+	}
+}
+
 void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, int planeIdx, bool isChroma) {
 	uint32 blockWidth  = isChroma ? _uvBlockWidth  : _yBlockWidth;
 	uint32 blockHeight = isChroma ? _uvBlockHeight : _yBlockHeight;
@@ -815,7 +865,7 @@ void BinkDecoder::BinkVideoTrack::blockScaledIntra(DecodeContext &ctx) {
 
 	readDCTCoeffs(*ctx.video, block, true);
 
-	IDCT(block);
+	_idct(block);
 
 	int32 *src   = block;
 	byte  *dest1 = ctx.dest;
@@ -1461,7 +1511,7 @@ static inline void IDCTCol(int32 *dest, const int32 *src) {
 	}
 }
 
-void BinkDecoder::BinkVideoTrack::IDCT(int32 *block) {
+void binkIDCTGeneric(int32 *block) {
 	int i;
 	int32 temp[64];
 
@@ -1475,7 +1525,7 @@ void BinkDecoder::BinkVideoTrack::IDCT(int32 *block) {
 void BinkDecoder::BinkVideoTrack::IDCTAdd(DecodeContext &ctx, int32 *block) {
 	int i, j;
 
-	IDCT(block);
+	_idct(block);
 	byte *dest = ctx.dest;
 	for (i = 0; i < 8; i++, dest += ctx.pitch, block += 8)
 		for (j = 0; j < 8; j++)
@@ -1483,13 +1533,13 @@ void BinkDecoder::BinkVideoTrack::IDCTAdd(DecodeContext &ctx, int32 *block) {
 }
 
 void BinkDecoder::BinkVideoTrack::IDCTPut(DecodeContext &ctx, int32 *block) {
-	int i;
-	int32 temp[64];
-	for (i = 0; i < 8; i++)
-		IDCTCol(&temp[i], &block[i]);
-	for (i = 0; i < 8; i++) {
-		IDCT_ROW( (&ctx.dest[i*ctx.pitch]), (&temp[8*i]) );
-	}
+	int i, j;
+
+	_idct(block);
+	byte *dest = ctx.dest;
+	for (i = 0; i < 8; i++, dest += ctx.pitch, block += 8)
+		for (j = 0; j < 8; j++)
+			dest[j] = block[j];
 }
 
 BinkDecoder::BinkAudioTrack::BinkAudioTrack(BinkDecoder::AudioInfo &audio, Audio::Mixer::SoundType soundType) :
@@ -37,6 +37,7 @@
 #include "video/video_decoder.h"
 
 #include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
 
 namespace Audio {
 class AudioStream;
@@ -78,6 +79,7 @@ public:
 
 protected:
 	void readNextPacket();
+	bool supportsDecodeAhead() const { return true; }
 	bool supportsAudioTrackSwitching() const { return true; }
 	AudioTrack *getAudioTrack(int index);
 	bool seekIntern(const Audio::Timestamp &time);
@@ -160,9 +162,18 @@ private:
 			return true;
 		}
 
+		bool setYUVOutput(bool enable) override {
+			// The alpha plane can't be passed on
+			if (enable && _hasAlpha)
+				return false;
+			_yuvOutput = enable;
+			return true;
+		}
+		const Graphics::YUVImage *getYUVFrame() const override { return _yuvOutput ? &_yuvImage : nullptr; }
+
 		int getCurFrame() const override { return _curFrame; }
 		int getFrameCount() const override { return _frameCount; }
-		const Graphics::Surface *decodeNextFrame() override { return _surface; }
+		const Graphics::Surface *decodeNextFrame() override { return _yuvOutput ? nullptr : _surface; }
 		bool isSeekable() const  override{ return true; }
 		bool seek(const Audio::Timestamp &time) override { return true; }
 		bool rewind() override;
@@ -260,6 +271,9 @@ private:
 		uint32 _id; ///< The BIK FourCC.
 
 		bool _hasAlpha;   ///< Do video frames have alpha?
+		bool _yuvOutput;  ///< Output the planes instead of converting them?
+
+		Graphics::YUVImage _yuvImage; ///< The planes of the last frame, in YUV output mode.
 		bool _swapPlanes; ///< Are the planes ordered (A)YVU instead of (A)YUV?
 
 		Common::Rational _frameRate;
@@ -281,6 +295,9 @@ private:
 		byte *_curPlanes[4]; ///< The 4 color planes, YUVA, current frame.
 		byte *_oldPlanes[4]; ///< The 4 color planes, YUVA, last frame.
 
+		void (*_idct)(int32 *block); ///< IDCT implementation, see BinkIDCTFunc.
+		Common::JobSystem *_jobSystem;
+
 		/** Initialize the bundles. */
 		void initBundles();
 		/** Deinitialize the bundles. */
@@ -338,9 +355,15 @@ private:
 		void readResidue     (VideoFrame &video, int16 *block, int masksCount);
 
 		// Bink video IDCT
-		void IDCT(int32 *block);
 		void IDCTPut(DecodeContext &ctx, int32 *block);
 		void IDCTAdd(DecodeContext &ctx, int32 *block);
+
+		/** Number of row pairs converted to RGB by a job. */
+		static const uint kConvertBandRowPairs = 16;
+
+		/** Convert rows of the decoded planes to RGB. */
+		void convertRows(uint beginPair, uint endPair);
+		static void convertBands(uint begin, uint end, void *refCon);
 	};
 
 	class BinkAudioTrack : public AudioTrack {
@@ -0,0 +1,47 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef VIDEO_BINK_INTERN_H
+#define VIDEO_BINK_INTERN_H
+
+#include "common/scummsys.h"
+
+namespace Video {
+
+/**
+ * Transform an 8x8 block of Bink DCT coefficients in place.
+ *
+ * The results are not clipped, callers truncate them to bytes like the
+ * original decoder does.
+ */
+typedef void (*BinkIDCTFunc)(int32 *block);
+
+void binkIDCTGeneric(int32 *block);
+#ifdef SCUMMVM_NEON
+void binkIDCTNEON(int32 *block);
+#endif
+#ifdef SCUMMVM_SSE2
+void binkIDCTSSE2(int32 *block);
+#endif
+
+} // End of namespace Video
+
+#endif
@@ -0,0 +1,100 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef VIDEO_HARDWARE_DECODER_H
+#define VIDEO_HARDWARE_DECODER_H
+
+#include "common/scummsys.h"
+
+namespace Graphics {
+struct Surface;
+}
+
+namespace Video {
+
+/**
+ * @defgroup video_hardware_decoder Hardware video decoding
+ * @ingroup video
+ *
+ * @brief Interface for video decoders provided by the backend.
+ * @{
+ */
+
+/** The compressed formats which may be decoded by the video hardware. */
+enum HardwareVideoCodec {
+	/** An MPEG-1 or MPEG-2 video elementary stream */
+	kHardwareVideoCodecMPEG2,
+	/** VP8 frames, as stored in Matroska/WebM files */
+	kHardwareVideoCodecVP8
+};
+
+/** Describes the video a hardware decoder is requested for. */
+struct HardwareVideoDecoderDesc {
+	HardwareVideoDecoderDesc(HardwareVideoCodec c, uint16 w, uint16 h) : codec(c), width(w), height(h) {}
+
+	HardwareVideoCodec codec;
+	uint16 width;
+	uint16 height;
+};
+
+/**
+ * A video decoder running on the video hardware of the platform, e.g.
+ * through VA-API, VideoToolbox or MediaCodec. Backends create them with
+ * OSystem::createHardwareVideoDecoder().
+ *
+ * Decoders using it have to keep their software decoder as a fallback,
+ * for when no hardware decoder is available or when it fails.
+ */
+class HardwareVideoDecoder {
+public:
+	virtual ~HardwareVideoDecoder() {}
+
+	/**
+	 * Queue compressed data to be decoded.
+	 *
+	 * For VP8, this is exactly one frame. MPEG video is passed as it is
+	 * read from the elementary stream, which doesn't need to be split at
+	 * frame boundaries.
+	 *
+	 * @return False if the data couldn't be decoded. The caller should not
+	 *         use this decoder anymore, and switch to software decoding.
+	 */
+	virtual bool queueData(const byte *data, uint32 size) = 0;
+
+	/**
+	 * Fetch the next decoded frame, in display order.
+	 *
+	 * The frame is converted into the given surface, which has the size
+	 * of the video and the pixel format the caller wants.
+	 *
+	 * @return False if no more frames are ready yet.
+	 */
+	virtual bool getFrame(Graphics::Surface &dst) = 0;
+
+	/** Drop all queued data and pending frames, e.g. when seeking. */
+	virtual void flush() = 0;
+};
+
+/** @} */
+
+} // End of namespace Video
+
+#endif
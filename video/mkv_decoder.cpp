@@ -20,10 +20,12 @@
  */
 
 #include "video/mkv_decoder.h"
+#include "video/hardware_decoder.h"
 
 #include "audio/audiostream.h"
 #include "audio/decoders/raw.h"
 #include "common/debug.h"
+#include "common/jobs.h"
 #include "common/stream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -327,19 +329,35 @@ MKVDecoder::VPXVideoTrack::VPXVideoTrack(const mkvparser::Track *const pTrack) {
 	_nextFrameStartTime = 0.0;
 	_curFrame = -1;
 
-	_codec = new vpx_codec_ctx_t;
-
-	/* Initialize video codec */
-	if (vpx_codec_dec_init(_codec, &vpx_codec_vp8_dx_algo, NULL, 0))
-		error("Failed to initialize decoder for movie.");
+	// Prefer the video hardware of the backend, libvpx is only set up
+	// when there is none or it fails
+	_hardwareDecoder = g_system->createHardwareVideoDecoder(HardwareVideoDecoderDesc(kHardwareVideoCodecVP8, _width, _height));
+	if (!_hardwareDecoder)
+		initSoftwareDecoder();
 }
 
 MKVDecoder::VPXVideoTrack::~VPXVideoTrack() {
 	// The last frame is not freed in decodeNextFrame(), clear it hear instead.
 	_surface.free();
+	delete _hardwareDecoder;
+	if (_codec)
+		vpx_codec_destroy(_codec);
 	delete _codec;
 }
 
+void MKVDecoder::VPXVideoTrack::initSoftwareDecoder() {
+	_codec = new vpx_codec_ctx_t;
+
+	// Decode on as many threads as the job system has, so that libvpx
+	// doesn't add its threads on top of those for every core
+	vpx_codec_dec_cfg_t config = { 0, 0, 0 };
+	config.threads = g_system->getJobSystem()->getThreadCount();
+
+	/* Initialize video codec */
+	if (vpx_codec_dec_init(_codec, &vpx_codec_vp8_dx_algo, &config, 0))
+		error("Failed to initialize decoder for movie.");
+}
+
 bool MKVDecoder::VPXVideoTrack::endOfTrack() const {
 	if (_endOfVideo && _displayQueue.size())
 		return false;
@@ -359,6 +377,25 @@ bool MKVDecoder::VPXVideoTrack::decodeFrame(byte *frame, long size) {
 
 	//warning("In within decodeFrame");
 
+	if (_hardwareDecoder) {
+		if (_hardwareDecoder->queueData(frame, size)) {
+			Graphics::Surface tmp;
+			tmp.create(getWidth(), getHeight(), getPixelFormat());
+			while (_hardwareDecoder->getFrame(tmp)) {
+				_displayQueue.push(tmp);
+				tmp.create(getWidth(), getHeight(), getPixelFormat());
+			}
+			tmp.free();
+			return false;
+		}
+
+		// libvpx picks up again with the next key frame
+		warning("Hardware video decoding failed, switching to software");
+		delete _hardwareDecoder;
+		_hardwareDecoder = nullptr;
+		initSoftwareDecoder();
+	}
+
 	/* Decode the frame */
 	if (vpx_codec_decode(_codec, frame, size, NULL, 0))
 		error("Failed to decode frame");
@@ -374,12 +411,62 @@ bool MKVDecoder::VPXVideoTrack::decodeFrame(byte *frame, long size) {
 		if (img->fmt != VPX_IMG_FMT_I420)
 			error("Movie error. The movie is not in I420 colour format, which is the only one I can hanlde at the moment.");
 
-		YUVToRGBMan.convert420(&tmp, Graphics::YUVToRGBManager::kScaleITU, img->planes[0], img->planes[1], img->planes[2], img->d_w, img->d_h, img->stride[0], img->stride[1]);
+		// Convert the frame in bands of rows on the job system. The first
+		// band also sets up the conversion tables, which must not happen
+		// concurrently.
+		const uint rowPairs = img->d_h / 2;
+		const uint firstBand = MIN<uint>(rowPairs, kConvertBandRowPairs);
+
+		_convertImage = img;
+		_convertSurface = &tmp;
+		convertRows(0, firstBand);
+		if (firstBand < rowPairs)
+			g_system->getJobSystem()->parallelFor(rowPairs - firstBand, convertBands, this, kConvertBandRowPairs);
+		if (img->d_h & 1)
+			convertLastRow();
+		_convertImage = nullptr;
+		_convertSurface = nullptr;
+
 		_displayQueue.push(tmp);
 	}
 	return false;
 }
 
+void MKVDecoder::VPXVideoTrack::convertBands(uint begin, uint end, void *refCon) {
+	// Skip the band already converted by decodeFrame()
+	((VPXVideoTrack *)refCon)->convertRows(begin + kConvertBandRowPairs, end + kConvertBandRowPairs);
+}
+
+void MKVDecoder::VPXVideoTrack::convertRows(uint beginPair, uint endPair) {
+	const vpx_image_t *img = _convertImage;
+	const int y = beginPair * 2;
+	const int uvY = beginPair;
+	const int height = (endPair - beginPair) * 2;
+
+	Graphics::Surface band;
+	band.init(_convertSurface->w, height, _convertSurface->pitch, _convertSurface->getBasePtr(0, y), _convertSurface->format);
+
+	YUVToRGBMan.convert420(&band, Graphics::YUVToRGBManager::kScaleITU, img->planes[0] + y * img->stride[0], img->planes[1] + uvY * img->stride[1],
+			img->planes[2] + uvY * img->stride[2], img->d_w, height, img->stride[0], img->stride[1]);
+}
+
+void MKVDecoder::VPXVideoTrack::convertLastRow() {
+	const vpx_image_t *img = _convertImage;
+	const int y = img->d_h - 1;
+	const int uvY = y / 2;
+
+	// convert420() only handles pairs of rows, so the row is converted twice,
+	// with a luma pitch of 0, into a separate pair of rows
+	Graphics::Surface pair;
+	pair.create(_convertSurface->w, 2, _convertSurface->format);
+
+	YUVToRGBMan.convert420(&pair, Graphics::YUVToRGBManager::kScaleITU, img->planes[0] + y * img->stride[0], img->planes[1] + uvY * img->stride[1],
+			img->planes[2] + uvY * img->stride[2], img->d_w, 2, 0, img->stride[1]);
+	memcpy(_convertSurface->getBasePtr(0, y), pair.getPixels(), _convertSurface->w * _convertSurface->format.bytesPerPixel);
+
+	pair.free();
+}
+
 MKVDecoder::VorbisAudioTrack::VorbisAudioTrack(const mkvparser::Track *const pTrack) :
 		AudioTrack(Audio::Mixer::kPlainSoundType) {
 
@@ -62,6 +62,7 @@ class Segment;
 
 namespace Video {
 
+class HardwareVideoDecoder;
 class MkvReader;
 
 /**
@@ -121,6 +122,24 @@ private:
 		Common::Queue<Graphics::Surface> _displayQueue;
 
 		vpx_codec_ctx_t *_codec = nullptr;
+
+		/** Used instead of libvpx while it works, if the backend has one */
+		HardwareVideoDecoder *_hardwareDecoder = nullptr;
+
+		void initSoftwareDecoder();
+
+		/** Number of row pairs converted to RGB by a job. */
+		static const uint kConvertBandRowPairs = 16;
+
+		/** The frame being converted by decodeFrame(), and its destination. */
+		const vpx_image_t *_convertImage = nullptr;
+		Graphics::Surface *_convertSurface = nullptr;
+
+		/** Convert rows of the decoded frame to RGB. */
+		void convertRows(uint beginPair, uint endPair);
+		static void convertBands(uint begin, uint end, void *refCon);
+		/** Convert the last row of a frame with an odd height, which has no pair. */
+		void convertLastRow();
 	};
 
 	class VorbisAudioTrack : public AudioTrack {
@@ -30,6 +30,7 @@
 #include "common/system.h"
 #include "common/textconsole.h"
 
+#include "video/hardware_decoder.h"
 #include "video/mpegps_decoder.h"
 #include "image/codecs/mpeg.h"
 
@@ -593,12 +594,18 @@ MPEGPSDecoder::MPEGVideoTrack::MPEGVideoTrack(Common::SeekableReadStream *firstP
 
 	findDimensions(firstPacket);
 
+	// Prefer the video decoder of the backend. The software decoder stays
+	// around in case the hardware gives up on the stream.
+	_hardwareDecoder = g_system->createHardwareVideoDecoder(HardwareVideoDecoderDesc(kHardwareVideoCodecMPEG2, _width, _height));
+
 #ifdef USE_MPEG2
 	_mpegDecoder = new Image::MPEGDecoder();
 #endif
 }
 
 MPEGPSDecoder::MPEGVideoTrack::~MPEGVideoTrack() {
+	delete _hardwareDecoder;
+
 #ifdef USE_MPEG2
 	delete _mpegDecoder;
 #endif
@@ -633,7 +640,6 @@ const Graphics::Surface *MPEGPSDecoder::MPEGVideoTrack::decodeNextFrame() {
 }
 
 bool MPEGPSDecoder::MPEGVideoTrack::sendPacket(Common::SeekableReadStream *packet, uint32 pts, uint32 dts) {
-#ifdef USE_MPEG2
 	if (!_surface) {
 		_surface = new Graphics::Surface();
 		_surface->create(_width, _height, _pixelFormat);
@@ -643,8 +649,21 @@ bool MPEGPSDecoder::MPEGVideoTrack::sendPacket(Common::SeekableReadStream *packe
 		_framePts = pts;
 	}
 
-	uint32 framePeriod;
-	bool foundFrame = _mpegDecoder->decodePacket(*packet, framePeriod, _surface);
+	uint32 framePeriod = 0;
+	bool foundFrame = false;
+	bool decoded = false;
+
+	if (_hardwareDecoder) {
+		foundFrame = decodeHardwarePacket(*packet, framePeriod);
+		decoded = _hardwareDecoder != nullptr;
+	}
+
+#ifdef USE_MPEG2
+	if (!decoded) {
+		foundFrame = _mpegDecoder->decodePacket(*packet, framePeriod, _surface);
+		decoded = true;
+	}
+#endif
 
 	if (foundFrame) {
 		_curFrame++;
@@ -661,15 +680,37 @@ bool MPEGPSDecoder::MPEGVideoTrack::sendPacket(Common::SeekableReadStream *packe
 
 		_framePts = 0xFFFFFFFF;
 	}
-#endif
 
 	delete packet;
 
-#ifdef USE_MPEG2
+	// Without any decoder, just keep on demuxing
+	return decoded ? foundFrame : true;
+}
+
+bool MPEGPSDecoder::MPEGVideoTrack::decodeHardwarePacket(Common::SeekableReadStream &packet, uint32 &framePeriod) {
+	byte buffer[4096];
+	uint32 size;
+
+	while ((size = packet.read(buffer, sizeof(buffer))) > 0) {
+		if (!_hardwareDecoder->queueData(buffer, size)) {
+			warning("MPEGPSDecoder: Hardware video decoding failed, using the software decoder");
+			delete _hardwareDecoder;
+			_hardwareDecoder = nullptr;
+
+			// Hand the whole packet to the software decoder instead
+			packet.seek(0);
+			return false;
+		}
+	}
+
+	// Like libmpeg2, only the last completed frame of the packet is kept
+	bool foundFrame = false;
+	while (_hardwareDecoder->getFrame(*_surface)) {
+		foundFrame = true;
+		framePeriod += _framePeriod;
+	}
+
 	return foundFrame;
-#else
-	return true;
-#endif
 }
 
 void MPEGPSDecoder::MPEGVideoTrack::findDimensions(Common::SeekableReadStream *firstPacket) {
@@ -684,6 +725,17 @@ void MPEGPSDecoder::MPEGVideoTrack::findDimensions(Common::SeekableReadStream *f
 	_height = firstPacket->readByte();
 	_width |= (_height & 0xF0) >> 4;
 	_height = ((_height & 0x0F) << 8) | firstPacket->readByte();
+
+	// 4 bits aspect ratio, 4 bits frame rate code
+	static const uint32 framePeriods[] = {
+		1126125, 1125000, 1080000, 900900, 900000, 540000, 450450, 450000
+	};
+	const byte frameRateCode = firstPacket->readByte() & 0x0F;
+	if (frameRateCode >= 1 && frameRateCode <= ARRAYSIZE(framePeriods))
+		_framePeriod = framePeriods[frameRateCode - 1];
+	else
+		_framePeriod = 900900; // 29.97 fps
+
 	_pixelFormat = g_system->getScreenFormat();
 	if (_pixelFormat.bytesPerPixel == 1)
 		_pixelFormat = Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0);
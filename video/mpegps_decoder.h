@@ -45,6 +45,8 @@ class MPEGDecoder;
 
 namespace Video {
 
+class HardwareVideoDecoder;
+
 /**
  * Decoder for MPEG Program Stream videos.
  * Video decoder used in engines:
@@ -142,9 +144,13 @@ private:
 		uint16 _width;
 		uint16 _height;
 		Graphics::PixelFormat _pixelFormat;
+		uint32 _framePeriod; ///< Duration of a frame in 27 MHz ticks, from the sequence header.
 
 		void findDimensions(Common::SeekableReadStream *firstPacket);
 
+		HardwareVideoDecoder *_hardwareDecoder;
+		bool decodeHardwarePacket(Common::SeekableReadStream &packet, uint32 &framePeriod);
+
 #ifdef USE_MPEG2
 		Image::MPEGDecoder *_mpegDecoder;
 #endif
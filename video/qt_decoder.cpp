@@ -332,6 +332,7 @@ QuickTimeDecoder::VideoTrackHandler::VideoTrackHandler(QuickTimeDecoder *decoder
 
 	_curEdit = 0;
 	_curFrame = -1;
+	_lastDecodedFrame = -1;
 	_delayedFrameToBufferTo = -1;
 	enterNewEditListEntry(true, true); // might set _curFrame
 
@@ -345,6 +346,10 @@ QuickTimeDecoder::VideoTrackHandler::VideoTrackHandler(QuickTimeDecoder *decoder
 	_reversed = false;
 	_ditherTable = 0;
 	_ditherFrame = 0;
+
+	_objectFrameCache = nullptr;
+	_prevObjectFrame = -1;
+	_canPrefetch = true;
 }
 
 // FIXME: This check breaks valid QuickTime movies, such as the KQ6 Mac opening.
@@ -385,6 +390,9 @@ void QuickTimeDecoder::VideoTrackHandler::checkEditListBounds() {
 }
 
 QuickTimeDecoder::VideoTrackHandler::~VideoTrackHandler() {
+	clearObjectFrameCache();
+	delete _objectFrameCache;
+
 	if (_scaledSurface) {
 		_scaledSurface->free();
 		delete _scaledSurface;
@@ -471,9 +479,7 @@ bool QuickTimeDecoder::VideoTrackHandler::seek(const Audio::Timestamp &requested
 		int32 destinationFrame = _curFrame + 1;
 
 		assert(destinationFrame < (int32)_parent->frameCount);
-		_curFrame = findKeyFrame(destinationFrame) - 1;
-		while (_curFrame < destinationFrame - 1)
-			bufferNextFrame();
+		bufferFramesBefore(destinationFrame);
 	}
 
 	return true;
@@ -503,6 +509,8 @@ bool QuickTimeDecoder::VideoTrackHandler::setOutputPixelFormat(const Graphics::P
 	if (_forcedDitherPalette.size() > 0)
 		return false;
 
+	clearObjectFrameCache();
+
 	bool success = true;
 
 	for (uint i = 0; i < _parent->sampleDescs.size(); i++) {
@@ -555,10 +563,7 @@ const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::decodeNextFrame()
 
 		// Decode from the last key frame to the frame before the one we need.
 		// TODO: Probably would be wise to do some caching
-		int targetFrame = _curFrame;
-		_curFrame = findKeyFrame(targetFrame) - 1;
-		while (_curFrame != targetFrame - 1)
-			bufferNextFrame();
+		bufferFramesBefore(_curFrame);
 	}
 
 	// Update the edit list, if applicable
@@ -716,48 +721,18 @@ Common::Rational QuickTimeDecoder::VideoTrackHandler::getScaledHeight() const {
 }
 
 Common::SeekableReadStream *QuickTimeDecoder::VideoTrackHandler::getNextFramePacket(uint32 &descId) {
-	// First, we have to track down which chunk holds the sample and which sample in the chunk contains the frame we are looking for.
-	int32 totalSampleCount = 0;
-	int32 sampleInChunk = 0;
-	int32 actualChunk = -1;
-	uint32 sampleToChunkIndex = 0;
-
-	for (uint32 i = 0; i < _parent->chunkCount; i++) {
-		if (sampleToChunkIndex < _parent->sampleToChunkCount && i >= _parent->sampleToChunk[sampleToChunkIndex].first)
-			sampleToChunkIndex++;
-
-		totalSampleCount += _parent->sampleToChunk[sampleToChunkIndex - 1].count;
-
-		if (totalSampleCount > _curFrame) {
-			actualChunk = i;
-			descId = _parent->sampleToChunk[sampleToChunkIndex - 1].id;
-			sampleInChunk = _parent->sampleToChunk[sampleToChunkIndex - 1].count - totalSampleCount + _curFrame;
-			break;
-		}
-	}
-
-	if (actualChunk < 0)
+	// The parser already resolved where each sample is located
+	if (_curFrame < 0 || (uint32)_curFrame >= _parent->sampleIndex.size())
 		error("Could not find data for frame %d", _curFrame);
 
-	// Next seek to that frame
-	Common::SeekableReadStream *stream = _decoder->_fd;
-	stream->seek(_parent->chunkOffsets[actualChunk]);
+	const Common::QuickTimeParser::SampleIndexEntry &sample = _parent->sampleIndex[_curFrame];
+	descId = sample.descId;
 
-	// Then, if the chunk holds more than one frame, seek to where the frame we want is located
-	for (int32 i = _curFrame - sampleInChunk; i < _curFrame; i++) {
-		if (_parent->sampleSize != 0)
-			stream->skip(_parent->sampleSize);
-		else
-			stream->skip(_parent->sampleSizes[i]);
-	}
+	//debug("Frame Data[%d]: Offset = %d, Size = %d", _curFrame, sample.offset, sample.size);
 
-	// Finally, read in the raw data for the frame
-	//debug("Frame Data[%d]: Offset = %d, Size = %d", _curFrame, stream->pos(), _parent->sampleSizes[_curFrame]);
-
-	if (_parent->sampleSize != 0)
-		return stream->readStream(_parent->sampleSize);
-
-	return stream->readStream(_parent->sampleSizes[_curFrame]);
+	Common::SeekableReadStream *stream = _decoder->_fd;
+	stream->seek(sample.offset);
+	return stream->readStream(sample.size);
 }
 
 uint32 QuickTimeDecoder::VideoTrackHandler::getCurFrameDuration() {
@@ -776,14 +751,37 @@ uint32 QuickTimeDecoder::VideoTrackHandler::getCurFrameDuration() {
 }
 
 uint32 QuickTimeDecoder::VideoTrackHandler::findKeyFrame(uint32 frame) const {
-	for (int i = _parent->keyframeCount - 1; i >= 0; i--)
-		if (_parent->keyframes[i] <= frame)
-			return _parent->keyframes[i];
+	// The sync sample table is sorted, so look for the last key frame not
+	// after the requested one
+	uint32 low = 0, high = _parent->keyframeCount;
+	while (low < high) {
+		uint32 mid = (low + high) / 2;
+		if (_parent->keyframes[mid] <= frame)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+
+	if (low > 0)
+		return _parent->keyframes[low - 1];
 
 	// If none found, we'll assume the requested frame is a key frame
 	return frame;
 }
 
+void QuickTimeDecoder::VideoTrackHandler::bufferFramesBefore(int32 frame) {
+	// When going forward without passing a key frame, e.g. when scrubbing,
+	// the codec can just continue from the last decoded frame
+	const int32 keyFrame = findKeyFrame(frame);
+	if (_lastDecodedFrame >= keyFrame && _lastDecodedFrame < frame)
+		_curFrame = _lastDecodedFrame;
+	else
+		_curFrame = keyFrame - 1;
+
+	while (_curFrame < frame - 1)
+		bufferNextFrame();
+}
+
 bool QuickTimeDecoder::VideoTrackHandler::isEmptyEdit() const {
 	return (_parent->editList[_curEdit].mediaTime == -1);
 }
@@ -831,15 +829,13 @@ void QuickTimeDecoder::VideoTrackHandler::enterNewEditListEntry(bool bufferFrame
 	if (bufferFrames) {
 		// Track down the keyframe
 		// Then decode until the frame before target
-		_curFrame = findKeyFrame(frameNum) - 1;
 		if (initializingTrack) {
 			// We can't decode frames during track initialization,
 			// so delay buffering until the first decode.
+			_curFrame = findKeyFrame(frameNum) - 1;
 			_delayedFrameToBufferTo = (int32)frameNum - 1;
 		} else {
-			while (_curFrame < (int32)frameNum - 1) {
-				bufferNextFrame();
-			}
+			bufferFramesBefore(frameNum);
 		}
 	} else {
 		// Since frameNum is the frame that needs to be displayed
@@ -863,6 +859,11 @@ const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::bufferNextFrame()
 
 	if (_decoder->_qtvrType != QTVRType::OBJECT)
 		_curFrame++;
+	else if (const Graphics::Surface *cachedFrame = bufferCachedObjectFrame())
+		return cachedFrame;
+
+	// The codec state is only known again once the frame was decoded
+	_lastDecodedFrame = -1;
 
 	// Get the next packet
 	uint32 descId;
@@ -884,6 +885,9 @@ const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::bufferNextFrame()
 	const Graphics::Surface *frame = entry->_videoCodec->decodeFrame(*frameData);
 	delete frameData;
 
+	if (_decoder->_qtvrType != QTVRType::OBJECT)
+		_lastDecodedFrame = _curFrame;
+
 	// Update the palette
 	if (entry->_videoCodec->containsPalette()) {
 		// The codec itself contains a palette
@@ -901,6 +905,9 @@ const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::bufferNextFrame()
 		}
 	}
 
+	if (frame && _decoder->_qtvrType == QTVRType::OBJECT)
+		frame = cacheObjectFrame(entry, frame);
+
 	return frame;
 }
 
@@ -968,12 +975,15 @@ bool QuickTimeDecoder::VideoTrackHandler::canDither() const {
 void QuickTimeDecoder::VideoTrackHandler::setDither(const byte *palette) {
 	assert(canDither());
 
+	clearObjectFrameCache();
+
 	for (uint i = 0; i < _parent->sampleDescs.size(); i++) {
 		VideoSampleDesc *desc = (VideoSampleDesc *)_parent->sampleDescs[i];
 
 		if (desc->_videoCodec->canDither(Image::Codec::kDitherTypeQT)) {
 			// Codec dither
 			desc->_videoCodec->setDither(Image::Codec::kDitherTypeQT, palette);
+			_canPrefetch = false;
 		} else {
 			// Forced dither
 			_forcedDitherPalette.resize(256, false);
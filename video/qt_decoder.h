@@ -31,10 +31,13 @@
 #define VIDEO_QT_DECODER_H
 
 #include "audio/decoders/quicktime_intern.h"
+#include "common/jobs.h"
 #include "common/keyboard.h"
 #include "common/scummsys.h"
 
+#include "graphics/decoded_image_cache.h"
 #include "graphics/palette.h"
+#include "graphics/panorama_warper.h"
 #include "graphics/transform_tools.h"
 
 #include "video/video_decoder.h"
@@ -353,6 +356,7 @@ private:
 		Common::QuickTimeParser::Track *_parent;
 		uint32 _curEdit;
 		int32 _curFrame;
+		int32 _lastDecodedFrame;    // frame the codec state belongs to, or -1
 		int32 _delayedFrameToBufferTo;
 		uint32 _nextFrameStartTime; // media time
 		Graphics::Surface *_scaledSurface;
@@ -367,9 +371,33 @@ private:
 		Graphics::Surface *_ditherFrame;
 		const Graphics::Surface *forceDither(const Graphics::Surface &frame);
 
+		// Decoded frames of QTVR object movies, which are revisited while
+		// dragging. The frames next in the drag direction are decoded ahead
+		// on a worker thread, using codecs of their own.
+		struct PrefetchFrame {
+			int32 frame;
+			Image::Codec *codec;
+			Common::SeekableReadStream *packet;
+		};
+
+		Graphics::DecodedImageCache *_objectFrameCache;
+		Graphics::DecodedImageCache::ImagePtr _objectFrame;
+		int32 _prevObjectFrame;
+		bool _canPrefetch;
+		Common::Array<Image::Codec *> _prefetchCodecs;
+		Common::Array<PrefetchFrame> _prefetchFrames;
+		Common::JobGroup _prefetchJobs;
+		const Graphics::Surface *bufferCachedObjectFrame();
+		const Graphics::Surface *cacheObjectFrame(VideoSampleDesc *entry, const Graphics::Surface *frame);
+		void prefetchObjectFrames();
+		void waitForPrefetch();
+		void clearObjectFrameCache();
+		static void decodePrefetchFrames(void *refCon);
+
 		Common::SeekableReadStream *getNextFramePacket(uint32 &descId);
 		uint32 getCurFrameDuration();            // media time
 		uint32 findKeyFrame(uint32 frame) const;
+		void bufferFramesBefore(int32 frame);
 		bool isEmptyEdit() const;
 		void enterNewEditListEntry(bool bufferFrames, bool intializingTrack = false);
 		uint32 getRateAdjustedFrameTime() const; // media time
@@ -421,6 +449,11 @@ private:
 	private:
 		bool _isPanoConstructed;
 
+		// Planar to perspective projection, for the field of view and tilt it was built for
+		Graphics::PanoramaWarper _perspectiveWarper;
+		float _warperFOV;
+		float _warperTiltAngle;
+
 		bool _dirty;
 	};
 };
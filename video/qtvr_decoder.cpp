@@ -46,6 +46,7 @@
 #include "common/compression/unzip.h"
 
 #include "graphics/cursorman.h"
+#include "graphics/managed_surface.h"
 #include "image/icocur.h"
 #include "image/png.h"
 
@@ -470,6 +471,171 @@ void QuickTimeDecoder::goToNode(uint32 nodeID) {
 	((PanoTrackHandler *)getTrack(_panoTrack->targetTrack))->constructPanorama();
 }
 
+/////////////////////////
+// OBJECT frame cache
+////////////////////////
+
+// Enough for a few rows of a typical object movie
+static const uint32 kObjectFrameCacheSize = 16 * 1024 * 1024;
+static const int kObjectPrefetchFrames = 2;
+
+const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::bufferCachedObjectFrame() {
+	if (!_objectFrameCache || _curFrame < 0 || (uint32)_curFrame >= _parent->sampleIndex.size())
+		return nullptr;
+
+	uint32 descId = _parent->sampleIndex[_curFrame].descId;
+	if (!descId || descId > _parent->sampleDescs.size())
+		return nullptr;
+
+	// The frame may be one of those being decoded ahead
+	waitForPrefetch();
+
+	Graphics::DecodedImageCache::ImagePtr frame = _objectFrameCache->get(Graphics::DecodedImageCache::Key(Common::String(), _curFrame));
+	if (!frame)
+		return nullptr;
+
+	// Only frames using the palette of their description are cached
+	const byte *palette = ((VideoSampleDesc *)_parent->sampleDescs[descId - 1])->_palette.data();
+	if (palette != _curPalette) {
+		_curPalette = palette;
+		_dirtyPalette = true;
+	}
+
+	_objectFrame = frame;
+	prefetchObjectFrames();
+
+	return &_objectFrame->rawSurface();
+}
+
+const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::cacheObjectFrame(VideoSampleDesc *entry, const Graphics::Surface *frame) {
+	// The palette of such codecs is only valid for the frame just decoded
+	if (entry->_videoCodec->containsPalette())
+		return frame;
+
+	if (!_objectFrameCache)
+		_objectFrameCache = new Graphics::DecodedImageCache(kObjectFrameCacheSize);
+
+	Graphics::ManagedSurface *copy = new Graphics::ManagedSurface();
+	copy->copyFrom(*frame);
+	_objectFrame = _objectFrameCache->store(Graphics::DecodedImageCache::Key(Common::String(), _curFrame), copy);
+	prefetchObjectFrames();
+
+	return &_objectFrame->rawSurface();
+}
+
+void QuickTimeDecoder::VideoTrackHandler::prefetchObjectFrames() {
+	const int32 prevFrame = _prevObjectFrame;
+	_prevObjectFrame = _curFrame;
+
+	const int columns = _decoder->_nav.columns;
+	if (!_canPrefetch || prevFrame < 0 || prevFrame == _curFrame || columns <= 0)
+		return;
+
+	waitForPrefetch();
+
+	if (_prefetchCodecs.empty()) {
+		// The codecs decoding ahead need their own state, but must produce
+		// the same output as the codecs of the sample descriptions
+		for (uint i = 0; i < _parent->sampleDescs.size(); i++) {
+			VideoSampleDesc *desc = (VideoSampleDesc *)_parent->sampleDescs[i];
+			Image::Codec *codec = nullptr;
+
+			if (desc->_videoCodec && !desc->_videoCodec->containsPalette()) {
+				const Graphics::PixelFormat format = desc->_videoCodec->getPixelFormat();
+
+				codec = Image::createQuickTimeCodec(desc->getCodecTag(), _parent->width, _parent->height, desc->_bitsPerSample);
+				if (codec && codec->getPixelFormat() != format && (!codec->setOutputPixelFormat(format) || codec->getPixelFormat() != format)) {
+					delete codec;
+					codec = nullptr;
+				}
+			}
+
+			_prefetchCodecs.push_back(codec);
+		}
+	}
+
+	// Continue the last move, wrapping around horizontally like dragging does
+	const int rowStep = _curFrame / columns - prevFrame / columns;
+	int columnStep = _curFrame % columns - prevFrame % columns;
+	if (columnStep > columns / 2)
+		columnStep -= columns;
+	else if (columnStep < -columns / 2)
+		columnStep += columns;
+
+	int row = _curFrame / columns;
+	int column = _curFrame % columns;
+
+	for (int i = 0; i < kObjectPrefetchFrames; i++) {
+		row += rowStep;
+		column = ((column + columnStep) % columns + columns) % columns;
+
+		const int32 frame = row * columns + column;
+		if (row < 0 || frame >= getFrameCount() || (uint32)frame >= _parent->sampleIndex.size())
+			break;
+
+		if (_objectFrameCache->get(Graphics::DecodedImageCache::Key(Common::String(), frame)))
+			continue;
+
+		const Common::QuickTimeParser::SampleIndexEntry &sample = _parent->sampleIndex[frame];
+		if (!sample.descId || sample.descId > _prefetchCodecs.size() || !_prefetchCodecs[sample.descId - 1])
+			continue;
+
+		// The file is only read from here, the job just decodes
+		PrefetchFrame prefetch;
+		prefetch.frame = frame;
+		prefetch.codec = _prefetchCodecs[sample.descId - 1];
+		_decoder->_fd->seek(sample.offset);
+		prefetch.packet = _decoder->_fd->readStream(sample.size);
+
+		if (prefetch.packet)
+			_prefetchFrames.push_back(prefetch);
+	}
+
+	if (!_prefetchFrames.empty())
+		g_system->getJobSystem()->submit(decodePrefetchFrames, this, &_prefetchJobs);
+}
+
+void QuickTimeDecoder::VideoTrackHandler::decodePrefetchFrames(void *refCon) {
+	VideoTrackHandler *track = (VideoTrackHandler *)refCon;
+
+	for (uint i = 0; i < track->_prefetchFrames.size(); i++) {
+		const PrefetchFrame &prefetch = track->_prefetchFrames[i];
+
+		const Graphics::Surface *frame = prefetch.codec->decodeFrame(*prefetch.packet);
+		if (!frame)
+			continue;
+
+		Graphics::ManagedSurface *copy = new Graphics::ManagedSurface();
+		copy->copyFrom(*frame);
+		track->_objectFrameCache->store(Graphics::DecodedImageCache::Key(Common::String(), prefetch.frame), copy);
+	}
+}
+
+void QuickTimeDecoder::VideoTrackHandler::waitForPrefetch() {
+	if (_prefetchFrames.empty())
+		return;
+
+	g_system->getJobSystem()->wait(_prefetchJobs);
+
+	for (uint i = 0; i < _prefetchFrames.size(); i++)
+		delete _prefetchFrames[i].packet;
+	_prefetchFrames.clear();
+}
+
+void QuickTimeDecoder::VideoTrackHandler::clearObjectFrameCache() {
+	waitForPrefetch();
+
+	for (uint i = 0; i < _prefetchCodecs.size(); i++)
+		delete _prefetchCodecs[i];
+	_prefetchCodecs.clear();
+
+	if (_objectFrameCache)
+		_objectFrameCache->clear();
+
+	_objectFrame.reset();
+	_prevObjectFrame = -1;
+}
+
 /////////////////////////
 // PANO Track
 ////////////////////////
@@ -485,6 +651,9 @@ QuickTimeDecoder::PanoTrackHandler::PanoTrackHandler(QuickTimeDecoder *decoder,
 	_projectedPano = nullptr;
 	_planarProjection = nullptr;
 
+	_warperFOV = 0.0f;
+	_warperTiltAngle = 0.0f;
+
 	_dirty = true;
 
 	_decoder->updateQTVRCursor(0, 0); // Initialize all things for cursor
@@ -912,25 +1081,34 @@ void QuickTimeDecoder::PanoTrackHandler::projectPanorama() {
 		}
 	}
 
-	// Convert planar projection into perspective projection
-	for (uint16 y = 0; y < h; y++) {
-		float xInterpolator = sideEdgeXYInterpolators[y * 2 + 0];
-		float yInterpolator = sideEdgeXYInterpolators[y * 2 + 1];
-
-		int32 srcY = static_cast<int32>(yInterpolator * (float)h);
-		int32 scanlineWidth = static_cast<int32>(xInterpolator * w) / 2 * 2;
-		int32 startX = (w - scanlineWidth) / 2;
-		//int32 endX = startX + scanlineWidth;
-
-		// It would be better to compute a reciprocal and do this as a multiply instead,
-		// doing divides per pixel is SLOW!
-		for (uint16 x = 0; x < w; x++) {
-			int32 srcX = (2 * x + 1) * scanlineWidth / (2 * w) + startX;
-			uint32 pixel = _planarProjection->getPixel(srcX, srcY);
-			_projectedPano->setPixel(x, y, pixel);
+	// Convert planar projection into perspective projection. This only depends
+	// on the field of view and the tilt, so it is kept as a table while panning
+	if (_perspectiveWarper.getWidth() != w || _perspectiveWarper.getHeight() != h ||
+			_warperFOV != _decoder->_fov || _warperTiltAngle != _decoder->_tiltAngle) {
+		_perspectiveWarper.create(w, h);
+		_warperFOV = _decoder->_fov;
+		_warperTiltAngle = _decoder->_tiltAngle;
+
+		const uint32 planarPitch = _planarProjection->pitch / _planarProjection->format.bytesPerPixel;
+
+		for (uint16 y = 0; y < h; y++) {
+			float xInterpolator = sideEdgeXYInterpolators[y * 2 + 0];
+			float yInterpolator = sideEdgeXYInterpolators[y * 2 + 1];
+
+			int32 srcY = static_cast<int32>(yInterpolator * (float)h);
+			int32 scanlineWidth = static_cast<int32>(xInterpolator * w) / 2 * 2;
+			int32 startX = (w - scanlineWidth) / 2;
+
+			uint32 *entries = _perspectiveWarper.getRow(y);
+			for (uint16 x = 0; x < w; x++) {
+				int32 srcX = (2 * x + 1) * scanlineWidth / (2 * w) + startX;
+				entries[x] = srcY * planarPitch + srcX;
+			}
 		}
 	}
 
+	_perspectiveWarper.warp(*_planarProjection, *_projectedPano);
+
 	_dirty = false;
 }
 
@@ -32,11 +32,11 @@
 
 #include "video/smk_decoder.h"
 
+#include "common/array.h"
 #include "common/endian.h"
 #include "common/util.h"
 #include "common/stream.h"
 #include "common/bitarray.h"
-#include "common/bitstream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 
@@ -53,6 +53,139 @@ enum SmkBlockTypes {
 	SMK_BLOCK_FILL = 3
 };
 
+/*
+ * class SmackerBitStream
+ * Reads the bits of a buffer starting with the least significant bit of
+ * each byte, through a 64-bit bit buffer.
+ */
+
+class SmackerBitStream {
+public:
+	SmackerBitStream(const byte *data, uint32 size)
+		: _data(data), _dataEnd(data + size), _bits(0), _bitsLeft(0) {}
+
+	// Peeking data out of bounds is well-defined and returns 0 bits.
+	// This is for convenience when using speed-up techniques reading
+	// more bits than actually available.
+	uint32 peekBits(uint n) {
+		if (_bitsLeft < n)
+			fillBits();
+		return (uint32)(_bits & ((1ULL << n) - 1));
+	}
+
+	// Only bits which have been peeked can be skipped
+	void skip(uint n) {
+		_bits >>= n;
+		_bitsLeft -= n;
+	}
+
+	uint32 getBits(uint n) {
+		uint32 v = peekBits(n);
+		skip(n);
+		return v;
+	}
+
+	uint getBit() {
+		return getBits(1);
+	}
+
+private:
+	// Fill the bit buffer with at least 56 bits
+	void fillBits() {
+		if (_dataEnd - _data >= 8) {
+			// Load as many whole bytes as fit. Any bits above _bitsLeft
+			// are those of the following bytes, which OR in again
+			// unchanged on the next fill.
+			_bits |= READ_LE_UINT64(_data) << _bitsLeft;
+			_data += (63 - _bitsLeft) >> 3;
+			_bitsLeft |= 56;
+			return;
+		}
+
+		while (_bitsLeft <= 56) {
+			if (_data < _dataEnd)
+				_bits |= ((uint64)*_data++) << _bitsLeft;
+			_bitsLeft += 8;
+		}
+	}
+
+	const byte *_data;
+	const byte *_dataEnd;
+	uint64 _bits;
+	uint _bitsLeft;
+};
+
+/*
+ * Huffman lookup tables
+ *
+ * The trees are decoded through tables indexed by the next bits of the
+ * stream, built when the trees are read. An entry either holds a leaf, as
+ * the index of its tree node and the length of its code within the table,
+ * or points to a sub-table for longer codes, with its offset and the number
+ * of bits indexing it.
+ */
+
+enum {
+	SMK_LOOKUP_SUBTABLE = 0x80000000,
+	SMK_LOOKUP_SUBTABLE_BITS = 6
+};
+
+template<typename T>
+static uint getTreeDepth(const T *tree, uint32 node, T nodeFlag) {
+	if (!(tree[node] & nodeFlag))
+		return 0;
+
+	uint left = getTreeDepth(tree, node + 1, nodeFlag);
+	uint right = getTreeDepth(tree, node + 1 + (tree[node] & (T)~nodeFlag), nodeFlag);
+	return MAX(left, right) + 1;
+}
+
+template<typename T>
+static void fillLookupTable(Common::Array<uint32> &table, uint32 start, uint bits, const T *tree, uint32 node, T nodeFlag, uint32 code, uint length) {
+	if (!(tree[node] & nodeFlag)) { // Leaf
+		for (uint32 i = code; i < (1u << bits); i += (1 << length))
+			table[start + i] = (node << 5) | length;
+		return;
+	}
+
+	if (length == bits) {
+		uint subBits = MIN<uint>(getTreeDepth(tree, node, nodeFlag), SMK_LOOKUP_SUBTABLE_BITS);
+		uint32 subStart = table.size();
+		table.resize(subStart + (1 << subBits));
+		table[start + code] = SMK_LOOKUP_SUBTABLE | (subStart << 5) | subBits;
+		fillLookupTable(table, subStart, subBits, tree, node, nodeFlag, 0, 0);
+		return;
+	}
+
+	// The left branch follows the node, the right one its whole left branch
+	fillLookupTable(table, start, bits, tree, node + 1, nodeFlag, code, length + 1);
+	fillLookupTable(table, start, bits, tree, node + 1 + (tree[node] & (T)~nodeFlag), nodeFlag, code | (1 << length), length + 1);
+}
+
+// Build the table of a tree, and return the number of bits indexing its root
+template<typename T>
+static uint buildLookupTable(Common::Array<uint32> &table, uint rootBits, const T *tree, T nodeFlag) {
+	uint bits = MIN<uint>(getTreeDepth(tree, 0, nodeFlag), rootBits);
+
+	table.clear();
+	table.resize(1 << bits);
+	fillLookupTable(table, 0, bits, tree, 0, nodeFlag, 0, 0);
+	return bits;
+}
+
+// Decode a code, and return the index of its leaf
+static inline uint32 lookupCode(SmackerBitStream &bs, const uint32 *table, uint bits) {
+	uint32 entry = table[bs.peekBits(bits)];
+	while (entry & SMK_LOOKUP_SUBTABLE) {
+		bs.skip(bits);
+		bits = entry & 0x1F;
+		entry = table[((entry & ~SMK_LOOKUP_SUBTABLE) >> 5) + bs.peekBits(bits)];
+	}
+
+	bs.skip(entry & 0x1F);
+	return entry >> 5;
+}
+
 /*
  * class SmallHuffmanTree
  * A Huffman-tree to hold 8-bit values.
@@ -65,49 +198,42 @@ public:
 	uint16 getCode(SmackerBitStream &bs);
 private:
 	enum {
-		SMK_NODE = 0x8000
+		SMK_NODE = 0x8000,
+		SMK_ROOT_BITS = 8
 	};
 
-	uint16 decodeTree(uint32 prefix, int length);
+	uint16 decodeTree();
 
 	uint16 _treeSize;
 	uint16 _tree[511];
 
-	uint16 _prefixtree[256];
-	byte _prefixlength[256];
+	Common::Array<uint32> _table;
+	uint _tableBits;
 
 	SmackerBitStream &_bs;
 	bool _empty;
 };
 
 SmallHuffmanTree::SmallHuffmanTree(SmackerBitStream &bs)
-	: _treeSize(0), _bs(bs), _empty(false) {
+	: _treeSize(0), _tableBits(0), _bs(bs), _empty(false) {
 	if (!_bs.getBit()) {
 		_empty = true;
 		return;
 	}
 
-	for (uint16 i = 0; i < 256; ++i)
-		_prefixtree[i] = _prefixlength[i] = 0;
-
-	decodeTree(0, 0);
+	decodeTree();
 
 	(void)_bs.getBit();
+
+	_tableBits = buildLookupTable<uint16>(_table, SMK_ROOT_BITS, _tree, SMK_NODE);
 }
 
-uint16 SmallHuffmanTree::decodeTree(uint32 prefix, int length) {
+uint16 SmallHuffmanTree::decodeTree() {
 	if (_empty)
 		return 0;
 
 	if (!_bs.getBit()) { // Leaf
-		_tree[_treeSize] = _bs.getBits<8>();
-
-		if (length <= 8) {
-			for (int i = 0; i < 256; i += (1 << length)) {
-				_prefixtree[prefix | i] = _treeSize;
-				_prefixlength[prefix | i] = length;
-			}
-		}
+		_tree[_treeSize] = _bs.getBits(8);
 		++_treeSize;
 
 		return 1;
@@ -115,16 +241,11 @@ uint16 SmallHuffmanTree::decodeTree(uint32 prefix, int length) {
 
 	uint16 t = _treeSize++;
 
-	if (length == 8) {
-		_prefixtree[prefix] = t;
-		_prefixlength[prefix] = 8;
-	}
-
-	uint16 r1 = decodeTree(prefix, length + 1);
+	uint16 r1 = decodeTree();
 
 	_tree[t] = (SMK_NODE | r1);
 
-	uint16 r2 = decodeTree(prefix | (1 << length), length + 1);
+	uint16 r2 = decodeTree();
 
 	return r1+r2+1;
 }
@@ -133,20 +254,7 @@ uint16 SmallHuffmanTree::getCode(SmackerBitStream &bs) {
 	if (_empty)
 		return 0;
 
-	// Peeking data out of bounds is well-defined and returns 0 bits.
-	// This is for convenience when using speed-up techniques reading
-	// more bits than actually available.
-	byte peek = bs.peekBits<8>();
-	uint16 *p = &_tree[_prefixtree[peek]];
-	bs.skip(_prefixlength[peek]);
-
-	while (*p & SMK_NODE) {
-		if (bs.getBit())
-			p += *p & ~SMK_NODE;
-		p++;
-	}
-
-	return *p;
+	return _tree[lookupCode(bs, _table.begin(), _tableBits)];
 }
 
 /*
@@ -163,17 +271,18 @@ public:
 	uint32 getCode(SmackerBitStream &bs);
 private:
 	enum {
-		SMK_NODE = 0x80000000
+		SMK_NODE = 0x80000000,
+		SMK_ROOT_BITS = 11
 	};
 
-	uint32 decodeTree(uint32 prefix, int length);
+	uint32 decodeTree();
 
 	uint32  _treeSize;
 	uint32 *_tree;
 	uint32  _last[3];
 
-	uint32 _prefixtree[256];
-	byte _prefixlength[256];
+	Common::Array<uint32> _table;
+	uint _tableBits;
 
 	/* Used during construction */
 	SmackerBitStream &_bs;
@@ -189,24 +298,22 @@ BigHuffmanTree::BigHuffmanTree(SmackerBitStream &bs, int allocSize)
 		_tree = new uint32[1];
 		_tree[0] = 0;
 		_last[0] = _last[1] = _last[2] = 0;
+		_tableBits = buildLookupTable<uint32>(_table, SMK_ROOT_BITS, _tree, SMK_NODE);
 		return;
 	}
 
-	for (uint32 i = 0; i < 256; ++i)
-		_prefixtree[i] = _prefixlength[i] = 0;
-
 	_loBytes = new SmallHuffmanTree(_bs);
 	_hiBytes = new SmallHuffmanTree(_bs);
 
-	_markers[0] = _bs.getBits<16>();
-	_markers[1] = _bs.getBits<16>();
-	_markers[2] = _bs.getBits<16>();
+	_markers[0] = _bs.getBits(16);
+	_markers[1] = _bs.getBits(16);
+	_markers[2] = _bs.getBits(16);
 
 	_last[0] = _last[1] = _last[2] = 0xffffffff;
 
 	_treeSize = 0;
 	_tree = new uint32[allocSize / 4];
-	decodeTree(0, 0);
+	decodeTree();
 	(void)_bs.getBit();
 
 	for (uint32 i = 0; i < 3; ++i) {
@@ -218,6 +325,8 @@ BigHuffmanTree::BigHuffmanTree(SmackerBitStream &bs, int allocSize)
 
 	delete _loBytes;
 	delete _hiBytes;
+
+	_tableBits = buildLookupTable<uint32>(_table, SMK_ROOT_BITS, _tree, SMK_NODE);
 }
 
 BigHuffmanTree::~BigHuffmanTree() {
@@ -228,7 +337,7 @@ void BigHuffmanTree::reset() {
 	_tree[_last[0]] = _tree[_last[1]] = _tree[_last[2]] = 0;
 }
 
-uint32 BigHuffmanTree::decodeTree(uint32 prefix, int length) {
+uint32 BigHuffmanTree::decodeTree() {
 	uint32 bit = _bs.getBit();
 
 	if (!bit) { // Leaf
@@ -239,13 +348,6 @@ uint32 BigHuffmanTree::decodeTree(uint32 prefix, int length) {
 
 		_tree[_treeSize] = v;
 
-		if (length <= 8) {
-			for (int i = 0; i < 256; i += (1 << length)) {
-				_prefixtree[prefix | i] = _treeSize;
-				_prefixlength[prefix | i] = length;
-			}
-		}
-
 		for (int i = 0; i < 3; ++i) {
 			if (_markers[i] == v) {
 				_last[i] = _treeSize;
@@ -259,34 +361,16 @@ uint32 BigHuffmanTree::decodeTree(uint32 prefix, int length) {
 
 	uint32 t = _treeSize++;
 
-	if (length == 8) {
-		_prefixtree[prefix] = t;
-		_prefixlength[prefix] = 8;
-	}
-
-	uint32 r1 = decodeTree(prefix, length + 1);
+	uint32 r1 = decodeTree();
 
 	_tree[t] = SMK_NODE | r1;
 
-	uint32 r2 = decodeTree(prefix | (1 << length), length + 1);
+	uint32 r2 = decodeTree();
 	return r1+r2+1;
 }
 
 uint32 BigHuffmanTree::getCode(SmackerBitStream &bs) {
-	// Peeking data out of bounds is well-defined and returns 0 bits.
-	// This is for convenience when using speed-up techniques reading
-	// more bits than actually available.
-	byte peek = bs.peekBits<8>();
-	uint32 *p = &_tree[_prefixtree[peek]];
-	bs.skip(_prefixlength[peek]);
-
-	while (*p & SMK_NODE) {
-		if (bs.getBit())
-			p += (*p) & ~SMK_NODE;
-		p++;
-	}
-
-	uint32 v = *p;
+	uint32 v = _tree[lookupCode(bs, _table.begin(), _tableBits)];
 	if (v != _tree[_last[0]]) {
 		_tree[_last[2]] = _tree[_last[1]];
 		_tree[_last[1]] = _tree[_last[0]];
@@ -420,8 +504,9 @@ bool SmackerDecoder::loadStream(Common::SeekableReadStream *stream) {
 	byte *huffmanTrees = (byte *) malloc(_header.treesSize);
 	_fileStream->read(huffmanTrees, _header.treesSize);
 
-	SmackerBitStream bs(new Common::BitStreamMemoryStream(huffmanTrees, _header.treesSize, DisposeAfterUse::YES), DisposeAfterUse::YES);
+	SmackerBitStream bs(huffmanTrees, _header.treesSize);
 	videoTrack->readTrees(bs, _header.mMapSize, _header.mClrSize, _header.fullSize, _header.typeSize);
+	free(huffmanTrees);
 
 	_firstFrameStart = _fileStream->pos();
 
@@ -551,8 +636,9 @@ void SmackerDecoder::readNextPacket() {
 
 	_fileStream->read(frameData, frameDataSize);
 
-	SmackerBitStream bs(new Common::BitStreamMemoryStream(frameData, frameDataSize + 1, DisposeAfterUse::YES), DisposeAfterUse::YES);
+	SmackerBitStream bs(frameData, frameDataSize + 1);
 	videoTrack->decodeFrame(bs);
+	free(frameData);
 
 	_fileStream->seek(startPos + frameSize);
 }
@@ -603,6 +689,7 @@ VideoDecoder::AudioTrack *SmackerDecoder::getAudioTrack(int index) {
 SmackerDecoder::SmackerVideoTrack::SmackerVideoTrack(uint32 width, uint32 height, uint32 frameCount, const Common::Rational &frameRate, uint32 flags, uint32 version) : _palette(256) {
 	_surface = new Graphics::Surface();
 	_surface->create(width, height * ((flags & 6) ? 2 : 1), Graphics::PixelFormat::createFormatCLUT8());
+	_frame = *_surface;
 	_dirtyBlocks.set_size(width * height / 16);
 	_frameCount = frameCount;
 	_frameRate = frameRate;
@@ -635,6 +722,24 @@ Graphics::PixelFormat SmackerDecoder::SmackerVideoTrack::getPixelFormat() const
 	return _surface->format;
 }
 
+bool SmackerDecoder::SmackerVideoTrack::setOutputSurface(Graphics::Surface *surface) {
+	if (!surface)
+		surface = _surface;
+
+	if (surface->w < _surface->w || surface->h < _surface->h || surface->format != _surface->format)
+		return false;
+
+	Graphics::Surface frame;
+	frame.init(_surface->w, _surface->h, surface->pitch, surface->getPixels(), _surface->format);
+
+	// Frames only update the blocks which changed, so keep the current one
+	if (frame.getPixels() != _frame.getPixels())
+		frame.copyRectToSurface(_frame, 0, 0, Common::Rect(_frame.w, _frame.h));
+
+	_frame = frame;
+	return true;
+}
+
 void SmackerDecoder::SmackerVideoTrack::readTrees(SmackerBitStream &bs, uint32 mMapSize, uint32 mClrSize, uint32 fullSize, uint32 typeSize) {
 	_MMapTree = new BigHuffmanTree(bs, mMapSize);
 	_MClrTree = new BigHuffmanTree(bs, mClrSize);
@@ -642,6 +747,15 @@ void SmackerDecoder::SmackerVideoTrack::readTrees(SmackerBitStream &bs, uint32 m
 	_TypeTree = new BigHuffmanTree(bs, typeSize);
 }
 
+// The bytes of a mono block row which take the high colour, for each
+// four bits of its map
+static const uint32 monoMasks[16] = {
+	0x00000000, 0x000000FF, 0x0000FF00, 0x0000FFFF,
+	0x00FF0000, 0x00FF00FF, 0x00FFFF00, 0x00FFFFFF,
+	0xFF000000, 0xFF0000FF, 0xFF00FF00, 0xFF00FFFF,
+	0xFFFF0000, 0xFFFF00FF, 0xFFFFFF00, 0xFFFFFFFF
+};
+
 void SmackerDecoder::SmackerVideoTrack::decodeFrame(SmackerBitStream &bs) {
 	_MMapTree->reset();
 	_MClrTree->reset();
@@ -654,13 +768,13 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(SmackerBitStream &bs) {
 
 	uint bw = getWidth() / 4;
 	uint bh = getHeight() / doubleY / 4;
-	uint stride = getWidth();
+	uint stride = _frame.pitch;
 	uint block = 0, blocks = bw*bh;
 
 	byte *out;
 	uint type, run, j, mode;
-	uint32 p1, p2, clr, map;
-	byte hi, lo;
+	uint32 p1, p2, clr, map, row;
+	uint32 hi, lo;
 	uint i;
 
 	while (block < blocks) {
@@ -672,15 +786,13 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(SmackerBitStream &bs) {
 			while (run-- && block < blocks) {
 				clr = _MClrTree->getCode(bs);
 				map = _MMapTree->getCode(bs);
-				out = (byte *)_surface->getPixels() + (block / bw) * (stride * 4 * doubleY) + (block % bw) * 4;
-				hi = clr >> 8;
-				lo = clr & 0xff;
+				out = (byte *)_frame.getPixels() + (block / bw) * (stride * 4 * doubleY) + (block % bw) * 4;
+				hi = (clr >> 8) * 0x01010101;
+				lo = (clr & 0xff) * 0x01010101;
 				for (i = 0; i < 4; i++) {
+					row = lo ^ ((lo ^ hi) & monoMasks[map & 15]);
 					for (j = 0; j < doubleY; j++) {
-						out[0] = (map & 1) ? hi : lo;
-						out[1] = (map & 2) ? hi : lo;
-						out[2] = (map & 4) ? hi : lo;
-						out[3] = (map & 8) ? hi : lo;
+						WRITE_LE_UINT32(out, row);
 						out += stride;
 					}
 					map >>= 4;
@@ -706,35 +818,31 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(SmackerBitStream &bs) {
 			}
 
 			while (run-- && block < blocks) {
-				out = (byte *)_surface->getPixels() + (block / bw) * (stride * 4 * doubleY) + (block % bw) * 4;
+				out = (byte *)_frame.getPixels() + (block / bw) * (stride * 4 * doubleY) + (block % bw) * 4;
 				switch (mode) {
 					case 0:
 						for (i = 0; i < 4; ++i) {
 							p1 = _FullTree->getCode(bs);
 							p2 = _FullTree->getCode(bs);
+							row = p2 | (p1 << 16);
 							for (j = 0; j < doubleY; ++j) {
-								out[2] = p1 & 0xff;
-								out[3] = p1 >> 8;
-								out[0] = p2 & 0xff;
-								out[1] = p2 >> 8;
+								WRITE_LE_UINT32(out, row);
 								out += stride;
 							}
 						}
 						break;
 					case 1:
 						p1 = _FullTree->getCode(bs);
-						out[0] = out[1] = p1 & 0xFF;
-						out[2] = out[3] = p1 >> 8;
+						row = ((p1 & 0xFF) | ((p1 & 0xFF00) << 8)) * 0x0101;
+						WRITE_LE_UINT32(out, row);
 						out += stride;
-						out[0] = out[1] = p1 & 0xFF;
-						out[2] = out[3] = p1 >> 8;
+						WRITE_LE_UINT32(out, row);
 						out += stride;
 						p2 = _FullTree->getCode(bs);
-						out[0] = out[1] = p2 & 0xFF;
-						out[2] = out[3] = p2 >> 8;
+						row = ((p2 & 0xFF) | ((p2 & 0xFF00) << 8)) * 0x0101;
+						WRITE_LE_UINT32(out, row);
 						out += stride;
-						out[0] = out[1] = p2 & 0xFF;
-						out[2] = out[3] = p2 >> 8;
+						WRITE_LE_UINT32(out, row);
 						out += stride;
 						break;
 					case 2:
@@ -744,18 +852,9 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(SmackerBitStream &bs) {
 							// https://ffmpeg.org/pipermail/ffmpeg-devel/2008-December/044246.html
 							p2 = _FullTree->getCode(bs);
 							p1 = _FullTree->getCode(bs);
-							for (j = 0; j < doubleY; ++j) {
-								out[0] = p1 & 0xff;
-								out[1] = p1 >> 8;
-								out[2] = p2 & 0xff;
-								out[3] = p2 >> 8;
-								out += stride;
-							}
-							for (j = 0; j < doubleY; ++j) {
-								out[0] = p1 & 0xff;
-								out[1] = p1 >> 8;
-								out[2] = p2 & 0xff;
-								out[3] = p2 >> 8;
+							row = p1 | (p2 << 16);
+							for (j = 0; j < 2 * doubleY; ++j) {
+								WRITE_LE_UINT32(out, row);
 								out += stride;
 							}
 						}
@@ -775,10 +874,10 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(SmackerBitStream &bs) {
 			uint32 col;
 			mode = type >> 8;
 			while (run-- && block < blocks) {
-				out = (byte *)_surface->getPixels() + (block / bw) * (stride * 4 * doubleY) + (block % bw) * 4;
+				out = (byte *)_frame.getPixels() + (block / bw) * (stride * 4 * doubleY) + (block % bw) * 4;
 				col = mode * 0x01010101;
 				for (i = 0; i < 4 * doubleY; ++i) {
-					out[0] = out[1] = out[2] = out[3] = col;
+					WRITE_UINT32(out, col);
 					out += stride;
 				}
 				_dirtyBlocks.set(block);
@@ -865,7 +964,7 @@ Audio::AudioStream *SmackerDecoder::SmackerAudioTrack::getAudioStream() const {
 }
 
 void SmackerDecoder::SmackerAudioTrack::queueCompressedBuffer(byte *buffer, uint32 bufferSize, uint32 unpackedSize) {
-	SmackerBitStream audioBS(new Common::BitStreamMemoryStream(buffer, bufferSize), DisposeAfterUse::YES);
+	SmackerBitStream audioBS(buffer, bufferSize);
 	bool dataPresent = audioBS.getBit();
 
 	if (!dataPresent)
@@ -892,16 +991,16 @@ void SmackerDecoder::SmackerAudioTrack::queueCompressedBuffer(byte *buffer, uint
 
 	if (isStereo) {
 		if (is16Bits) {
-			bases[1] = SWAP_BYTES_16(audioBS.getBits<16>());
+			bases[1] = SWAP_BYTES_16(audioBS.getBits(16));
 		} else {
-			bases[1] = audioBS.getBits<8>();
+			bases[1] = audioBS.getBits(8);
 		}
 	}
 
 	if (is16Bits) {
-		bases[0] = SWAP_BYTES_16(audioBS.getBits<16>());
+		bases[0] = SWAP_BYTES_16(audioBS.getBits(16));
 	} else {
-		bases[0] = audioBS.getBits<8>();
+		bases[0] = audioBS.getBits(8);
 	}
 
 	// The bases are the first samples, too
@@ -50,11 +50,7 @@ class SeekableReadStream;
 namespace Video {
 
 class BigHuffmanTree;
-
-// Because the maximum number of bits read from a bitstream is 16, and the data is 8-bit, the container only
-// needs to hold up to 23 bits at any given time. As such, we use a bitstream with a 32-bit container to
-// avoid the overhead of 64-bit maths on systems that don't support it natively.
-typedef Common::BitStreamImpl<Common::BitStreamMemoryStream, uint32, 8, false, false> SmackerBitStream;
+class SmackerBitStream;
 
 /**
  * Decoder for Smacker v2/v4 videos.
@@ -110,7 +106,8 @@ protected:
 		Graphics::PixelFormat getPixelFormat() const;
 		int getCurFrame() const { return _curFrame; }
 		int getFrameCount() const { return _frameCount; }
-		const Graphics::Surface *decodeNextFrame() { return _surface; }
+		const Graphics::Surface *decodeNextFrame() { return &_frame; }
+		bool setOutputSurface(Graphics::Surface *surface);
 		const byte *getPalette() const { _dirtyPalette = false; return _palette.data(); }
 		bool hasDirtyPalette() const { return _dirtyPalette; }
 
@@ -125,6 +122,7 @@ protected:
 
 	protected:
 		Graphics::Surface *_surface;
+		Graphics::Surface _frame; ///< The surface decoded to, either _surface or the one set by setOutputSurface().
 
 	private:
 		Common::Rational _frameRate;
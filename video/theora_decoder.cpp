@@ -37,6 +37,7 @@
 
 #include "audio/audiostream.h"
 #include "audio/decoders/raw.h"
+#include "common/jobs.h"
 #include "common/stream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -287,6 +288,7 @@ TheoraDecoder::TheoraVideoTrack::TheoraVideoTrack(th_info &theoraInfo, th_setup_
 	_curFrame = -1;
 	_surface = nullptr;
 	_displaySurface = nullptr;
+	_convertPlanes = nullptr;
 }
 
 TheoraDecoder::TheoraVideoTrack::~TheoraVideoTrack() {
@@ -362,15 +364,50 @@ void TheoraDecoder::TheoraVideoTrack::translateYUVtoRGBA(th_ycbcr_buffer &YUVBuf
 		                      _surface->getBasePtr(_x, _y), _surface->format);
 	}
 
+	// Convert the frame in bands of rows on the job system, libtheora has
+	// no threads of its own. The first band also sets up the conversion
+	// tables, which must not happen concurrently.
+	const uint rowPairs = YUVBuffer[kBufferY].height / 2;
+	const uint firstBand = MIN<uint>(rowPairs, kConvertBandRowPairs);
+
+	_convertPlanes = YUVBuffer;
+	convertRows(0, firstBand);
+	if (firstBand < rowPairs)
+		g_system->getJobSystem()->parallelFor(rowPairs - firstBand, convertBands, this, kConvertBandRowPairs);
+	_convertPlanes = nullptr;
+}
+
+void TheoraDecoder::TheoraVideoTrack::convertBands(uint begin, uint end, void *refCon) {
+	// Skip the band already converted by translateYUVtoRGBA()
+	((TheoraVideoTrack *)refCon)->convertRows(begin + kConvertBandRowPairs, end + kConvertBandRowPairs);
+}
+
+void TheoraDecoder::TheoraVideoTrack::convertRows(uint beginPair, uint endPair) {
+	const th_img_plane &yPlane = _convertPlanes[kBufferY];
+	const th_img_plane &uPlane = _convertPlanes[kBufferU];
+	const th_img_plane &vPlane = _convertPlanes[kBufferV];
+
+	const int y = beginPair * 2;
+	const int height = (endPair - beginPair) * 2;
+	const int uvY = (uPlane.height == yPlane.height) ? y : y / 2;
+
+	Graphics::Surface band;
+	band.init(_surface->w, height, _surface->pitch, _surface->getBasePtr(0, y), _surface->format);
+
+	// The strides may be negative
+	const byte *ySrc = yPlane.data + y * yPlane.stride;
+	const byte *uSrc = uPlane.data + uvY * uPlane.stride;
+	const byte *vSrc = vPlane.data + uvY * vPlane.stride;
+
 	switch (_theoraPixelFormat) {
 	case TH_PF_420:
-		YUVToRGBMan.convert420(_surface, Graphics::YUVToRGBManager::kScaleITU, YUVBuffer[kBufferY].data, YUVBuffer[kBufferU].data, YUVBuffer[kBufferV].data, YUVBuffer[kBufferY].width, YUVBuffer[kBufferY].height, YUVBuffer[kBufferY].stride, YUVBuffer[kBufferU].stride);
+		YUVToRGBMan.convert420(&band, Graphics::YUVToRGBManager::kScaleITU, ySrc, uSrc, vSrc, yPlane.width, height, yPlane.stride, uPlane.stride);
 		break;
 	case TH_PF_422:
-		YUVToRGBMan.convert422(_surface, Graphics::YUVToRGBManager::kScaleITU, YUVBuffer[kBufferY].data, YUVBuffer[kBufferU].data, YUVBuffer[kBufferV].data, YUVBuffer[kBufferY].width, YUVBuffer[kBufferY].height, YUVBuffer[kBufferY].stride, YUVBuffer[kBufferU].stride);
+		YUVToRGBMan.convert422(&band, Graphics::YUVToRGBManager::kScaleITU, ySrc, uSrc, vSrc, yPlane.width, height, yPlane.stride, uPlane.stride);
 		break;
 	case TH_PF_444:
-		YUVToRGBMan.convert444(_surface, Graphics::YUVToRGBManager::kScaleITU, YUVBuffer[kBufferY].data, YUVBuffer[kBufferU].data, YUVBuffer[kBufferV].data, YUVBuffer[kBufferY].width, YUVBuffer[kBufferY].height, YUVBuffer[kBufferY].stride, YUVBuffer[kBufferU].stride);
+		YUVToRGBMan.convert444(&band, Graphics::YUVToRGBManager::kScaleITU, ySrc, uSrc, vSrc, yPlane.width, height, yPlane.stride, uPlane.stride);
 		break;
 	default:
 		error("Unsupported Theora pixel format");
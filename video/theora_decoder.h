@@ -75,6 +75,7 @@ public:
 
 protected:
 	void readNextPacket();
+	bool supportsDecodeAhead() const { return true; }
 
 private:
 	class TheoraVideoTrack : public VideoTrack {
@@ -121,6 +122,16 @@ private:
 		th_pixel_fmt _theoraPixelFormat;
 
 		void translateYUVtoRGBA(th_ycbcr_buffer &YUVBuffer);
+
+		/** Number of row pairs converted to RGB by a job. */
+		static const uint kConvertBandRowPairs = 16;
+
+		/** The planes being converted by translateYUVtoRGBA(). */
+		const th_img_plane *_convertPlanes;
+
+		/** Convert rows of the decoded planes to RGB. */
+		void convertRows(uint beginPair, uint endPair);
+		static void convertBands(uint begin, uint end, void *refCon);
 	};
 
 	class VorbisAudioTrack : public AudioTrack {
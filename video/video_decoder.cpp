@@ -26,6 +26,7 @@
 
 #include "common/rational.h"
 #include "common/file.h"
+#include "common/profiler.h"
 #include "common/system.h"
 
 namespace Video {
@@ -47,10 +48,27 @@ VideoDecoder::VideoDecoder() {
 	_mainAudioTrack = 0;
 	_canSetDither = true;
 	_canSetDefaultFormat = true;
+	_yuvOutput = false;
+	_yuvFrame = 0;
+	_hasOutputSurface = false;
 	_videoCodecAccuracy = Image::CodecAccuracy::Default;
+	_decodeAheadFrames = 0;
+	_decodeAheadTrack = nullptr;
+	_decodedReadIndex = 0;
+	_decodedWriteIndex = 0;
+	_decodedEnd = false;
+}
+
+VideoDecoder::~VideoDecoder() {
+	discardDecodedFrames();
+
+	for (uint i = 0; i < _decodedFrames.size(); i++)
+		_decodedFrames[i].surface.free();
 }
 
 void VideoDecoder::close() {
+	discardDecodedFrames();
+
 	if (isPlaying())
 		stop();
 
@@ -74,6 +92,13 @@ void VideoDecoder::close() {
 	_mainAudioTrack = 0;
 	_canSetDither = true;
 	_canSetDefaultFormat = true;
+	_yuvOutput = false;
+	_yuvFrame = 0;
+	_hasOutputSurface = false;
+
+	for (uint i = 0; i < _decodedFrames.size(); i++)
+		_decodedFrames[i].surface.free();
+	_decodedFrames.clear();
 }
 
 bool VideoDecoder::loadFile(const Common::Path &filename) {
@@ -121,6 +146,9 @@ void VideoDecoder::delayMillis(uint msecs) {
 }
 
 void VideoDecoder::pauseVideo(bool pause) {
+	// The tracks are paused below
+	stopDecodeAhead();
+
 	if (pause) {
 		_pauseLevel++;
 
@@ -208,9 +236,27 @@ Graphics::PixelFormat VideoDecoder::getPixelFormat() const {
 }
 
 const Graphics::Surface *VideoDecoder::decodeNextFrame() {
+	PROFILE_ZONE("VideoDecoder::decodeNextFrame");
+
 	_needsUpdate = false;
 	_canSetDither = false;
 	_canSetDefaultFormat = false;
+	_yuvFrame = 0;
+
+	if (_decodeAheadTrack && _decodedCount.load() == 0) {
+		// Falling behind, wait for the frame that is being decoded
+		stopDecodeAhead();
+
+		// Nothing left, so the tracks are at the last returned frame again
+		if (_decodedCount.load() == 0)
+			_decodeAheadTrack = nullptr;
+	}
+
+	if (!_decodeAheadTrack && startDecodeAhead())
+		decodeAheadFrame();
+
+	if (_decodeAheadTrack)
+		return decodeNextFrameAhead();
 
 	readNextPacket();
 
@@ -221,6 +267,9 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 
 	const Graphics::Surface *frame = _nextVideoTrack->decodeNextFrame();
 
+	if (_yuvOutput)
+		_yuvFrame = _nextVideoTrack->getYUVFrame();
+
 	if (_nextVideoTrack->hasDirtyPalette()) {
 		_palette = _nextVideoTrack->getPalette();
 		_dirtyPalette = true;
@@ -232,6 +281,140 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	return frame;
 }
 
+void VideoDecoder::setDecodeAhead(uint frames) {
+	// A running queue keeps its size until it is drained
+	_decodeAheadFrames = frames;
+}
+
+void VideoDecoder::discardDecodedFrames() {
+	if (!_decodeAheadTrack)
+		return;
+
+	stopDecodeAhead();
+	_decodedCount.store(0);
+	_decodeAheadTrack = nullptr;
+}
+
+void VideoDecoder::decodeAheadJob(void *refCon) {
+	VideoDecoder *decoder = (VideoDecoder *)refCon;
+
+	// One frame is reserved for the one returned last
+	const uint maxFrames = decoder->_decodedFrames.size() - 1;
+
+	while (!decoder->_stopDecoding.load() && !decoder->_decodedEnd && decoder->_decodedCount.load() < maxFrames)
+		decoder->decodeAheadFrame();
+}
+
+bool VideoDecoder::startDecodeAhead() {
+	if (!_decodeAheadFrames || !supportsDecodeAhead() || !_nextVideoTrack || _nextVideoTrack->isReversed())
+		return false;
+
+	// Only the converted surfaces are queued, in internal buffers
+	if (_yuvOutput || _hasOutputSurface)
+		return false;
+
+	if (g_system->getJobSystem()->getThreadCount() < 2)
+		return false;
+
+	// The status functions only keep track of a single video track
+	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo && *it != _nextVideoTrack)
+			return false;
+
+	if (_decodedFrames.size() != _decodeAheadFrames + 1) {
+		for (uint i = 0; i < _decodedFrames.size(); i++)
+			_decodedFrames[i].surface.free();
+
+		_decodedFrames.clear();
+		_decodedFrames.resize(_decodeAheadFrames + 1);
+	}
+
+	_decodeAheadTrack = _nextVideoTrack;
+	_presentedState.curFrame = _decodeAheadTrack->getCurFrame();
+	_presentedState.endOfTrack = _decodeAheadTrack->endOfTrack();
+	_presentedState.nextFrameStartTime = _decodeAheadTrack->getNextFrameStartTime();
+
+	_decodedReadIndex = 0;
+	_decodedWriteIndex = 0;
+	_decodedEnd = false;
+	_decodedCount.store(0);
+	return true;
+}
+
+void VideoDecoder::stopDecodeAhead() {
+	if (!_decodeAheadTrack)
+		return;
+
+	_stopDecoding.store(true);
+	g_system->getJobSystem()->wait(_decodeAheadGroup);
+	_stopDecoding.store(false);
+}
+
+void VideoDecoder::decodeAheadFrame() {
+	DecodedFrame &decoded = _decodedFrames[_decodedWriteIndex];
+
+	readNextPacket();
+	const Graphics::Surface *frame = _decodeAheadTrack->decodeNextFrame();
+
+	// The track may reuse its surface for the next frame
+	decoded.hasSurface = frame != nullptr;
+	if (frame) {
+		if (decoded.surface.w != frame->w || decoded.surface.h != frame->h || decoded.surface.format != frame->format) {
+			decoded.surface.free();
+			decoded.surface.create(frame->w, frame->h, frame->format);
+		}
+
+		decoded.surface.copyRectToSurface(*frame, 0, 0, Common::Rect(frame->w, frame->h));
+	}
+
+	decoded.dirtyPalette = _decodeAheadTrack->hasDirtyPalette();
+	if (decoded.dirtyPalette)
+		memcpy(decoded.palette, _decodeAheadTrack->getPalette(), sizeof(decoded.palette));
+
+	decoded.state.curFrame = _decodeAheadTrack->getCurFrame();
+	decoded.state.endOfTrack = _decodeAheadTrack->endOfTrack();
+	decoded.state.nextFrameStartTime = _decodeAheadTrack->getNextFrameStartTime();
+	_decodedEnd = decoded.state.endOfTrack || (_endTimeSet && decoded.state.nextFrameStartTime >= (uint)_endTime.msecs());
+
+	_decodedWriteIndex = (_decodedWriteIndex + 1) % _decodedFrames.size();
+	_decodedCount.fetchAdd(1);
+}
+
+const Graphics::Surface *VideoDecoder::decodeNextFrameAhead() {
+	DecodedFrame &decoded = _decodedFrames[_decodedReadIndex];
+	_decodedReadIndex = (_decodedReadIndex + 1) % _decodedFrames.size();
+
+	// The worker never writes to the frame returned last
+	_decodedCount.fetchSub(1);
+
+	_presentedState = decoded.state;
+	_nextVideoTrack = _presentedState.endOfTrack ? nullptr : _decodeAheadTrack;
+
+	if (decoded.dirtyPalette) {
+		memcpy(_decodeAheadPalette, decoded.palette, sizeof(_decodeAheadPalette));
+		_palette = _decodeAheadPalette;
+		_dirtyPalette = true;
+	}
+
+	// Refill the queue, unless it is to be resized or disabled
+	if (_decodeAheadGroup.isDone() && !_decodedEnd && _decodedFrames.size() == _decodeAheadFrames + 1)
+		g_system->getJobSystem()->submit(decodeAheadJob, this, &_decodeAheadGroup);
+
+	return decoded.hasSurface ? &decoded.surface : nullptr;
+}
+
+int VideoDecoder::getPresentedCurFrame(const VideoTrack *track) const {
+	return track == _decodeAheadTrack ? _presentedState.curFrame : track->getCurFrame();
+}
+
+bool VideoDecoder::isPresentedEndOfTrack(const Track *track) const {
+	return track == _decodeAheadTrack ? _presentedState.endOfTrack : track->endOfTrack();
+}
+
+uint32 VideoDecoder::getPresentedNextFrameStartTime(const VideoTrack *track) const {
+	return track == _decodeAheadTrack ? _presentedState.nextFrameStartTime : track->getNextFrameStartTime();
+}
+
 bool VideoDecoder::setReverse(bool reverse) {
 	// Can only reverse video-only videos
 	if (reverse && hasAudio())
@@ -240,6 +423,9 @@ bool VideoDecoder::setReverse(bool reverse) {
 	// Attempt to make sure all the tracks are in the requested direction
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)*it)->isReversed() != reverse) {
+			// Frames are only decoded ahead when playing forward
+			discardDecodedFrames();
+
 			if (!((VideoTrack *)*it)->setReverse(reverse))
 				return false;
 
@@ -261,7 +447,7 @@ int VideoDecoder::getCurFrame() const {
 
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo)
-			frame += ((VideoTrack *)*it)->getCurFrame() + 1;
+			frame += getPresentedCurFrame((VideoTrack *)*it) + 1;
 
 	return frame;
 }
@@ -302,7 +488,7 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 		return 0;
 
 	uint32 currentTime = getTime();
-	uint32 nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
+	uint32 nextFrameStartTime = getPresentedNextFrameStartTime(_nextVideoTrack);
 
 	if (_nextVideoTrack->isReversed()) {
 		// For reversed videos, we need to handle the time difference the opposite way.
@@ -323,8 +509,8 @@ bool VideoDecoder::endOfVideo() const {
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		const Track *track = *it;
 
-		bool videoEndTimeReached = _endTimeSet && track->getTrackType() == Track::kTrackTypeVideo && ((const VideoTrack *)track)->getNextFrameStartTime() >= (uint)_endTime.msecs();
-		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
+		bool videoEndTimeReached = _endTimeSet && track->getTrackType() == Track::kTrackTypeVideo && getPresentedNextFrameStartTime((const VideoTrack *)track) >= (uint)_endTime.msecs();
+		bool endReached = isPresentedEndOfTrack(track) || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
 			return false;
 	}
@@ -347,6 +533,8 @@ bool VideoDecoder::rewind() {
 	if (!isRewindable())
 		return false;
 
+	discardDecodedFrames();
+
 	// Stop all tracks so they can be rewound
 	if (isPlaying())
 		stopAudio();
@@ -381,6 +569,8 @@ bool VideoDecoder::seek(const Audio::Timestamp &time) {
 	if (!isSeekable())
 		return false;
 
+	discardDecodedFrames();
+
 	// Stop all tracks so they can be seek'ed
 	if (isPlaying())
 		stopAudio();
@@ -447,6 +637,9 @@ void VideoDecoder::stop() {
 	if (!isPlaying())
 		return;
 
+	// The tracks are unpaused below
+	stopDecodeAhead();
+
 	// Stop audio here so we don't have it affect getTime()
 	stopAudio();
 
@@ -576,6 +769,45 @@ bool VideoDecoder::setOutputPixelFormats(const Common::List<Graphics::PixelForma
 	return false;
 }
 
+bool VideoDecoder::setYUVOutput(bool enable) {
+	// If a frame was already decoded, we can't set it now.
+	if (!_canSetDefaultFormat)
+		return false;
+
+	bool result = false;
+
+	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo) {
+			if (((VideoTrack *)*it)->setYUVOutput(enable))
+				result = true;
+		}
+	}
+
+	if (result)
+		_yuvOutput = enable;
+
+	return result;
+}
+
+bool VideoDecoder::setOutputSurface(Graphics::Surface *surface) {
+	// The queued frames were decoded into the old surface
+	discardDecodedFrames();
+
+	bool result = false;
+
+	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo) {
+			if (((VideoTrack *)*it)->setOutputSurface(surface))
+				result = true;
+		}
+	}
+
+	if (result)
+		_hasOutputSurface = (surface != 0);
+
+	return result;
+}
+
 void VideoDecoder::setVideoCodecAccuracy(Image::CodecAccuracy accuracy) {
 	_videoCodecAccuracy = accuracy;
 
@@ -901,6 +1133,9 @@ uint VideoDecoder::getAudioTrackCount() const {
 }
 
 void VideoDecoder::setEndTime(const Audio::Timestamp &endTime) {
+	// The worker checks the end time too
+	stopDecodeAhead();
+
 	Audio::Timestamp startTime = 0;
 
 	if (isPlaying()) {
@@ -950,7 +1185,7 @@ void VideoDecoder::setEndFrame(uint frame) {
 
 void VideoDecoder::resetStartTime() {
 	if (_nextVideoTrack) {
-		Audio::Timestamp curTime = _nextVideoTrack->getFrameTime(_nextVideoTrack->getCurFrame());
+		Audio::Timestamp curTime = _nextVideoTrack->getFrameTime(getPresentedCurFrame(_nextVideoTrack));
 		if (isPlaying()) {
 			_startTime = g_system->getMillis() - (curTime.msecs() / _playbackRate).toInt();
 		}
@@ -973,7 +1208,7 @@ const VideoDecoder::Track *VideoDecoder::getTrack(uint track) const {
 
 bool VideoDecoder::endOfVideoTracks() const {
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
-		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !(*it)->endOfTrack())
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !isPresentedEndOfTrack(*it))
 			return false;
 
 	return true;
@@ -984,9 +1219,9 @@ VideoDecoder::VideoTrack *VideoDecoder::findNextVideoTrack() {
 	uint32 bestTime = 0xFFFFFFFF;
 
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
-		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !(*it)->endOfTrack()) {
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !isPresentedEndOfTrack(*it)) {
 			VideoTrack *track = (VideoTrack *)*it;
-			uint32 time = track->getNextFrameStartTime();
+			uint32 time = getPresentedNextFrameStartTime(track);
 
 			if (time < bestTime) {
 				bestTime = time;
@@ -1040,8 +1275,8 @@ bool VideoDecoder::hasFramesLeft() const {
 
 		const VideoTrack *track = (const VideoTrack *)*it;
 
-		bool videoEndTimeReached = _endTimeSet && track->getNextFrameStartTime() >= (uint)_endTime.msecs();
-		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
+		bool videoEndTimeReached = _endTimeSet && getPresentedNextFrameStartTime(track) >= (uint)_endTime.msecs();
+		bool endReached = isPresentedEndOfTrack(track) || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
 			return true;
 	}
@@ -25,10 +25,13 @@
 #include "audio/mixer.h"
 #include "audio/timestamp.h"	// TODO: Move this to common/ ?
 #include "common/array.h"
+#include "common/atomic.h"
+#include "common/jobs.h"
 #include "common/path.h"
 #include "common/rational.h"
 #include "common/str.h"
 #include "graphics/pixelformat.h"
+#include "graphics/surface.h"
 #include "image/codec-options.h"
 
 namespace Audio {
@@ -42,7 +45,7 @@ class SeekableReadStream;
 }
 
 namespace Graphics {
-struct Surface;
+struct YUVImage;
 }
 
 namespace Video {
@@ -53,7 +56,7 @@ namespace Video {
 class VideoDecoder {
 public:
 	VideoDecoder();
-	virtual ~VideoDecoder() {}
+	virtual ~VideoDecoder();
 
 	/////////////////////////////////////////
 	// Opening/Closing a Video
@@ -365,6 +368,32 @@ public:
 	 */
 	virtual const Graphics::Surface *decodeNextFrame();
 
+	/**
+	 * Decode frames ahead of time on a worker thread.
+	 *
+	 * The decoded frames are kept in a queue, from which decodeNextFrame()
+	 * then returns them. This avoids dropping frames when decoding a single
+	 * one sometimes takes longer than it is displayed.
+	 *
+	 * getCurFrame(), getTimeToNextFrame(), needsUpdate() and the other
+	 * status functions still describe the last frame returned by
+	 * decodeNextFrame(). Seeking or rewinding drops the queued frames.
+	 *
+	 * This is only used by decoders supporting it, for videos with a single
+	 * video track played forward, and if the backend's job system has
+	 * threads. Otherwise, frames are decoded on demand as usual.
+	 *
+	 * @param frames Maximum number of frames to decode ahead, 0 to disable
+	 */
+	void setDecodeAhead(uint frames);
+
+	/**
+	 * Get the maximum number of frames decoded ahead of time.
+	 *
+	 * @see setDecodeAhead()
+	 */
+	uint getDecodeAhead() const { return _decodeAheadFrames; }
+
 	/**
 	 * Set the video to decode frames in reverse.
 	 *
@@ -419,6 +448,51 @@ public:
 	 */
 	bool setOutputPixelFormats(const Common::List<Graphics::PixelFormat> &formatList);
 
+	/**
+	 * Output the planes of YUV-based videos instead of converting them.
+	 *
+	 * For the tracks supporting it, decodeNextFrame() then returns 0 and
+	 * getYUVFrame() the decoded frame, which can be handed to
+	 * OSystem::showYUVOverlay() to be converted by the backend. Frames are
+	 * not decoded ahead of time in this mode.
+	 *
+	 * This should be called after loadStream(), but before a decodeNextFrame()
+	 * call. This is enforced.
+	 *
+	 * @param enable Whether to output YUV frames
+	 * @return true on success, false otherwise
+	 */
+	bool setYUVOutput(bool enable);
+
+	/**
+	 * Get the YUV frame decoded by the last decodeNextFrame() call.
+	 *
+	 * @see setYUVOutput()
+	 * @return the frame, or 0 if the last call didn't decode a YUV frame
+	 * @note The planes stay owned by the VideoDecoder and are only valid
+	 *       until the next decodeNextFrame() call.
+	 */
+	const Graphics::YUVImage *getYUVFrame() const { return _yuvFrame; }
+
+	/**
+	 * Decode the frames directly into a surface of the caller, e.g. a part
+	 * of the engine's screen, instead of an internal one.
+	 *
+	 * The surface needs the pixel format of the video and has to be at
+	 * least as large. Its current contents are replaced by the last decoded
+	 * frame. As frames may only update the parts of the previous one which
+	 * changed, the caller must not draw to it while the video is playing.
+	 * decodeNextFrame() then returns a surface pointing into it.
+	 *
+	 * This can be called at any time. Frames are not decoded ahead of time
+	 * while a surface is set.
+	 *
+	 * @param surface The surface to decode to, or 0 to go back to the
+	 *                internal one
+	 * @return true on success, false otherwise
+	 */
+	bool setOutputSurface(Graphics::Surface *surface);
+
 	/**
 	 * Set the accuracy of the video decoder
 	 */
@@ -614,6 +688,26 @@ protected:
 		 */
 		virtual bool setOutputPixelFormat(const Graphics::PixelFormat &format) { return format == getPixelFormat(); }
 
+		/**
+		 * Output the YUV planes instead of RGB surfaces.
+		 *
+		 * @see VideoDecoder::setYUVOutput()
+		 */
+		virtual bool setYUVOutput(bool enable) { return !enable; }
+
+		/**
+		 * Get the YUV frame returned by the last decodeNextFrame() call
+		 * in YUV output mode.
+		 */
+		virtual const Graphics::YUVImage *getYUVFrame() const { return 0; }
+
+		/**
+		 * Decode into the given surface instead of an internal one.
+		 *
+		 * @see VideoDecoder::setOutputSurface()
+		 */
+		virtual bool setOutputSurface(Graphics::Surface *surface) { return !surface; }
+
 		/**
 		 * Set the image codec accuracy
 		 */
@@ -897,6 +991,24 @@ protected:
 	 */
 	virtual void readNextPacket() {}
 
+	/**
+	 * Whether readNextPacket() and the video track may decode frames on
+	 * another thread, see setDecodeAhead().
+	 *
+	 * A subclass returning true must not access the stream or the tracks
+	 * from anywhere but readNextPacket() and the VideoDecoder functions,
+	 * unless it calls discardDecodedFrames() first.
+	 */
+	virtual bool supportsDecodeAhead() const { return false; }
+
+	/**
+	 * Stop decoding frames ahead of time and drop the decoded ones.
+	 *
+	 * Afterwards, the tracks are at the position of the last frame returned
+	 * by decodeNextFrame() again, at least if they were seeked since.
+	 */
+	void discardDecodedFrames();
+
 	/**
 	 * Define a track to be used by this class.
 	 *
@@ -1014,6 +1126,13 @@ private:
 	bool _canSetDither;
 	bool _canSetDefaultFormat;
 
+	// YUV output
+	bool _yuvOutput;
+	const Graphics::YUVImage *_yuvFrame;
+
+	// Whether the frames are decoded into a surface of the caller
+	bool _hasOutputSurface;
+
 protected:
 	// Internal helper functions
 	void stopAudio();
@@ -1038,6 +1157,43 @@ private:
 	Audio::Mixer::SoundType _soundType;
 
 	AudioTrack *_mainAudioTrack;
+
+	// Decoding ahead of time
+	struct VideoTrackState {
+		int curFrame;
+		bool endOfTrack;
+		uint32 nextFrameStartTime;
+	};
+
+	struct DecodedFrame {
+		Graphics::Surface surface;
+		bool hasSurface;
+		bool dirtyPalette;
+		byte palette[256 * 3];
+		VideoTrackState state;
+	};
+
+	static void decodeAheadJob(void *refCon);
+	bool startDecodeAhead();
+	void stopDecodeAhead();
+	void decodeAheadFrame();
+	const Graphics::Surface *decodeNextFrameAhead();
+
+	int getPresentedCurFrame(const VideoTrack *track) const;
+	bool isPresentedEndOfTrack(const Track *track) const;
+	uint32 getPresentedNextFrameStartTime(const VideoTrack *track) const;
+
+	uint _decodeAheadFrames;
+	VideoTrack *_decodeAheadTrack;            ///< The track decoded ahead, or nullptr when not decoding ahead.
+	VideoTrackState _presentedState;          ///< State of _decodeAheadTrack after the last returned frame.
+	Common::Array<DecodedFrame> _decodedFrames;
+	uint _decodedReadIndex;                   ///< Next frame to return, only used by decodeNextFrame().
+	uint _decodedWriteIndex;                  ///< Next frame to decode, only used by the worker.
+	bool _decodedEnd;                         ///< Whether the worker reached the end, only used by the worker.
+	Common::Atomic<uint> _decodedCount;
+	Common::Atomic<bool> _stopDecoding;
+	Common::JobGroup _decodeAheadGroup;
+	byte _decodeAheadPalette[256 * 3];
 };
 
 } // End of namespace Video